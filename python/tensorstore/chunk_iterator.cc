@@ -0,0 +1,302 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+// Other headers must be included after pybind11 to ensure header-order
+// inclusion constraints are satisfied.
+
+// Other headers
+#include <stddef.h>
+
+#include <algorithm>
+#include <deque>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "python/tensorstore/array_type_caster.h"
+#include "python/tensorstore/future.h"
+#include "python/tensorstore/garbage_collection.h"
+#include "python/tensorstore/index.h"
+#include "python/tensorstore/result_type_caster.h"
+#include "python/tensorstore/sequence_parameter.h"
+#include "python/tensorstore/status.h"
+#include "python/tensorstore/tensorstore_class.h"
+#include "python/tensorstore/tensorstore_module_components.h"
+#include "tensorstore/array.h"
+#include "tensorstore/box.h"
+#include "tensorstore/contiguous_layout.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_space/dim_expression.h"
+#include "tensorstore/index_space/index_domain.h"
+#include "tensorstore/internal/global_initializer.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/str_cat.h"
+
+// specializations
+#include "python/tensorstore/index_space.h"
+
+namespace tensorstore {
+namespace internal_python {
+namespace {
+
+namespace py = ::pybind11;
+
+using ChunkIteratorResult = std::pair<IndexDomain<>, SharedArray<void>>;
+
+/// Iterates over a `TensorStore` in fixed-size regions, reading ahead a bounded
+/// number of regions.
+class ChunkIterator {
+ public:
+  ChunkIterator(TensorStore<> store, PythonObjectReferenceManager manager,
+                std::vector<Index> region_shape, ContiguousLayoutOrder order,
+                Index prefetch, std::optional<Index> prefetch_bytes)
+      : store_(std::move(store)),
+        manager_(std::move(manager)),
+        region_shape_(std::move(region_shape)),
+        order_(order),
+        prefetch_(prefetch),
+        prefetch_bytes_(prefetch_bytes) {
+    const auto domain = store_.domain();
+    if (!IsFinite(domain.box())) {
+      throw py::value_error(tensorstore::StrCat(
+          "Cannot iterate over unbounded domain: ", domain));
+    }
+    if (static_cast<DimensionIndex>(region_shape_.size()) != domain.rank()) {
+      throw py::value_error(tensorstore::StrCat(
+          "Length of region_shape (", region_shape_.size(),
+          ") does not match rank of domain (", domain.rank(), ")"));
+    }
+    for (Index size : region_shape_) {
+      if (size <= 0) {
+        throw py::value_error(tensorstore::StrCat(
+            "region_shape must be positive, but received: ",
+            span(region_shape_)));
+      }
+    }
+    if (prefetch_ <= 0) {
+      throw py::value_error("prefetch must be positive");
+    }
+    position_.assign(domain.origin().begin(), domain.origin().end());
+    done_ = domain.num_elements() == 0;
+  }
+
+  /// Returns the next region, or `std::nullopt` if all regions have been
+  /// returned.
+  std::optional<Future<ChunkIteratorResult>> Next() {
+    Fill();
+    if (pending_.empty()) return std::nullopt;
+    auto next = std::move(pending_.front());
+    pending_.pop_front();
+    pending_bytes_ -= next.bytes;
+    // Issue additional reads before the caller waits on this one.
+    Fill();
+    return std::move(next.future);
+  }
+
+  const PythonObjectReferenceManager& reference_manager() const {
+    return manager_;
+  }
+
+ private:
+  struct PendingRead {
+    Future<ChunkIteratorResult> future;
+    Index bytes;
+  };
+
+  /// Returns the box of the next region, and advances `position_`.
+  Box<> NextRegion() {
+    const auto domain = store_.domain().box();
+    const DimensionIndex rank = domain.rank();
+    Box<> region(rank);
+    for (DimensionIndex i = 0; i < rank; ++i) {
+      region[i] = IndexInterval::UncheckedHalfOpen(
+          position_[i],
+          std::min(position_[i] + region_shape_[i], domain[i].exclusive_max()));
+    }
+    // Advance in C order over the grid of regions.
+    done_ = true;
+    for (DimensionIndex i = rank - 1; i >= 0; --i) {
+      position_[i] += region_shape_[i];
+      if (position_[i] < domain[i].exclusive_max()) {
+        done_ = false;
+        break;
+      }
+      position_[i] = domain[i].inclusive_min();
+    }
+    return region;
+  }
+
+  /// Issues reads until `prefetch_` reads are pending, `prefetch_bytes_` would
+  /// be exceeded, or there are no more regions.  At least one read is always
+  /// pending if any regions remain.
+  void Fill() {
+    const Index element_size = store_.dtype().size();
+    while (!done_ && static_cast<Index>(pending_.size()) < prefetch_) {
+      const auto domain = store_.domain().box();
+      Index bytes = element_size;
+      for (DimensionIndex i = 0; i < domain.rank(); ++i) {
+        bytes *= std::min(region_shape_[i],
+                          domain[i].exclusive_max() - position_[i]);
+      }
+      if (prefetch_bytes_ && !pending_.empty() &&
+          pending_bytes_ + bytes > *prefetch_bytes_) {
+        break;
+      }
+      auto region = NextRegion();
+      auto sliced = ValueOrThrow(store_ | AllDims().BoxSlice(region));
+      IndexDomain<> region_domain = sliced.domain();
+      auto future = MapFutureValue(
+          InlineExecutor{},
+          [region_domain = std::move(region_domain)](
+              const SharedArray<void>& array) -> ChunkIteratorResult {
+            return {region_domain, array};
+          },
+          tensorstore::Read<zero_origin>(sliced, order_));
+      pending_.push_back(PendingRead{std::move(future), bytes});
+      pending_bytes_ += bytes;
+    }
+  }
+
+  TensorStore<> store_;
+  PythonObjectReferenceManager manager_;
+  std::vector<Index> region_shape_;
+  ContiguousLayoutOrder order_;
+  Index prefetch_;
+  std::optional<Index> prefetch_bytes_;
+  std::vector<Index> position_;
+  bool done_;
+  std::deque<PendingRead> pending_;
+  Index pending_bytes_ = 0;
+};
+
+using ChunkIteratorCls = py::class_<ChunkIterator>;
+
+auto MakeChunkIteratorClass(py::module m) {
+  return ChunkIteratorCls(m, "ChunkIterator", R"(
+Iterator over the regions of a :py:obj:`TensorStore`, with bounded read-ahead.
+
+Returned by :py:obj:`experimental_iter_chunks`.  Supports both synchronous
+iteration, which releases the GIL while waiting for each read, and asynchronous
+iteration.
+
+Group:
+  Experimental
+)");
+}
+
+void DefineChunkIteratorAttributes(ChunkIteratorCls& cls) {
+  using Self = ChunkIterator;
+  cls.def("__iter__", [](Self& self) -> Self& { return self; },
+          py::return_value_policy::reference_internal);
+  cls.def("__next__", [](Self& self) -> ChunkIteratorResult {
+    auto future = self.Next();
+    if (!future) throw py::stop_iteration();
+    return ValueOrThrow(InterruptibleWait(*future));
+  });
+  cls.def("__aiter__", [](Self& self) -> Self& { return self; },
+          py::return_value_policy::reference_internal);
+  cls.def("__anext__",
+          [](Self& self) -> PythonFutureWrapper<ChunkIteratorResult> {
+            auto future = self.Next();
+            if (!future) {
+              PyErr_SetNone(PyExc_StopAsyncIteration);
+              throw py::error_already_set();
+            }
+            return PythonFutureWrapper<ChunkIteratorResult>(
+                *std::move(future), self.reference_manager());
+          });
+}
+
+void DefineIterChunksFunction(py::module m) {
+  m.def(
+      "experimental_iter_chunks",
+      [](PythonTensorStoreObject& store,
+         SequenceParameter<Index> region_shape, Index prefetch,
+         std::optional<Index> prefetch_bytes,
+         ContiguousLayoutOrder order) -> ChunkIterator {
+        return ChunkIterator(store.value, store.reference_manager(),
+                             std::move(region_shape).value, order, prefetch,
+                             prefetch_bytes);
+      },
+      R"(
+Iterates over a TensorStore in fixed-size regions, reading ahead.
+
+The domain of :python:`store` is partitioned into a grid of regions of shape
+:python:`region_shape`, starting at the origin of the domain; regions at the
+upper bound of the domain are truncated.  The regions are read in C order over
+the grid, and reads of subsequent regions are issued ahead of time, subject to
+the :python:`prefetch` and :python:`prefetch_bytes` limits.
+
+Example:
+
+    >>> store = await ts.open(
+    ...     {
+    ...         'driver': 'zarr',
+    ...         'kvstore': {
+    ...             'driver': 'memory'
+    ...         }
+    ...     },
+    ...     dtype=ts.uint32,
+    ...     shape=[4, 5],
+    ...     create=True)
+    >>> await store.write(np.arange(20, dtype=np.uint32).reshape([4, 5]))
+    >>> for domain, array in ts.experimental_iter_chunks(store, [2, 3]):
+    ...     print(domain.origin, array.tolist())
+    (0, 0) [[0, 1, 2], [5, 6, 7]]
+    (0, 3) [[3, 4], [8, 9]]
+    (2, 0) [[10, 11, 12], [15, 16, 17]]
+    (2, 3) [[13, 14], [18, 19]]
+
+Args:
+  store: Store to read.  Must have a bounded domain.
+  region_shape: Shape of each region.
+  prefetch: Maximum number of regions read ahead, including the region to be
+    returned next.
+  prefetch_bytes: Maximum number of bytes read ahead.  The next region is
+    always read, even if it exceeds this limit.  If not specified, only
+    :python:`prefetch` applies.
+  order: Contiguous layout order of the returned arrays.
+
+Returns:
+  An iterator, which may be used with either :python:`for` or
+  :python:`async for`, that yields :python:`(domain, array)` pairs, where
+  :python:`domain` is the :py:obj:`IndexDomain` of the region and
+  :python:`array` is the data read from that region.
+
+Group:
+  Experimental
+)",
+      py::arg("store"), py::arg("region_shape"), py::kw_only(),
+      py::arg("prefetch") = 2, py::arg("prefetch_bytes") = std::nullopt,
+      py::arg("order") = "C");
+}
+
+void RegisterChunkIteratorBindings(pybind11::module m, Executor defer) {
+  defer([cls = MakeChunkIteratorClass(m), m]() mutable {
+    DefineChunkIteratorAttributes(cls);
+    DefineIterChunksFunction(m);
+  });
+}
+
+TENSORSTORE_GLOBAL_INITIALIZER {
+  RegisterPythonComponent(RegisterChunkIteratorBindings, /*priority=*/-340);
+}
+
+}  // namespace
+}  // namespace internal_python
+}  // namespace tensorstore
@@ -38,6 +38,7 @@
 #include "tensorstore/internal/metrics/collect.h"
 #include "tensorstore/internal/metrics/prometheus.h"
 #include "tensorstore/internal/metrics/registry.h"
+#include "tensorstore/internal/os/fork_detection.h"
 #include "tensorstore/util/executor.h"
 #include "tensorstore/util/future.h"
 #include "tensorstore/util/result.h"
@@ -197,6 +198,24 @@ Parses and initializes internal tensorstore flags from argv.
 Args:
   argv: list of command line argument strings, such as sys.argv.
 
+Group:
+  Experimental
+)");
+
+  m.def("experimental_enable_fork_support",
+        &tensorstore::internal_os::EnableForkSupport, R"(
+Enables the use of tensorstore in child processes created by :py:obj:`os.fork`.
+
+By default, using tensorstore in the child process after a fork aborts the
+process, since its background threads do not exist in the child.  Once fork
+support is enabled, the child process instead starts new threads as needed, and
+retains the contents of the caches of the parent process, such as by
+`multiprocessing` data loaders using the ``fork`` start method.
+
+The parent process must not have any operations in progress when it forks.
+Fork support may also be enabled by setting the ``TENSORSTORE_FORK_SUPPORT``
+environment variable to ``1``.
+
 Group:
   Experimental
 )");
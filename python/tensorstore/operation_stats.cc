@@ -0,0 +1,181 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <pybind11/pybind11.h>
+// Other headers must be included after pybind11 to ensure header-order
+// inclusion constraints are satisfied.
+
+// Other headers
+#include <string>
+
+#include "absl/time/time.h"
+#include "python/tensorstore/tensorstore_module_components.h"
+#include "tensorstore/internal/global_initializer.h"
+#include "tensorstore/operation_stats.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace internal_python {
+namespace {
+
+namespace py = ::pybind11;
+
+using OperationStatsCls = py::class_<OperationStats>;
+
+auto MakeOperationStatsClass(py::module m) {
+  return OperationStatsCls(m, "OperationStats", R"(
+Accumulates I/O statistics for the operations with which it is specified.
+
+Statistics include all work performed on behalf of an operation, including
+metadata reads and decoding.  I/O shared by concurrent operations, e.g. a single
+cache read that satisfies several operations, is attributed to the operation
+that issued it.  The same object may be specified for multiple operations, in
+which case their statistics are combined.
+
+Example:
+
+    >>> store = await ts.open(
+    ...     {
+    ...         'driver': 'zarr',
+    ...         'kvstore': {
+    ...             'driver': 'memory'
+    ...         }
+    ...     },
+    ...     dtype=ts.uint32,
+    ...     shape=[4, 5],
+    ...     chunk_layout=ts.ChunkLayout(read_chunk_shape=[2, 5]),
+    ...     create=True)
+    >>> stats = ts.OperationStats()
+    >>> await store.write(42, operation_stats=stats)
+    >>> stats.kvstore_writes
+    2
+
+Group:
+  Core
+
+Constructors
+============
+
+Accessors
+=========
+
+Operations
+==========
+
+)");
+}
+
+void DefineOperationStatsAttributes(OperationStatsCls& cls) {
+  using Self = OperationStats;
+  cls.def(py::init([]() { return OperationStats::New(); }), R"(
+Creates a new statistics object with all counters equal to zero.
+)");
+  cls.def_property_readonly(
+      "kvstore_reads",
+      [](const Self& self) { return self.Get().kvstore_reads; },
+      R"(
+Number of key-value store read requests issued.
+
+Group:
+  Accessors
+)");
+  cls.def_property_readonly(
+      "kvstore_bytes_read",
+      [](const Self& self) { return self.Get().kvstore_bytes_read; },
+      R"(
+Total size in bytes of the values returned by key-value store reads.
+
+Group:
+  Accessors
+)");
+  cls.def_property_readonly(
+      "kvstore_writes",
+      [](const Self& self) { return self.Get().kvstore_writes; },
+      R"(
+Number of key-value store write requests issued.
+
+Group:
+  Accessors
+)");
+  cls.def_property_readonly(
+      "kvstore_bytes_written",
+      [](const Self& self) { return self.Get().kvstore_bytes_written; },
+      R"(
+Total size in bytes of the values written by key-value store writes.
+
+Group:
+  Accessors
+)");
+  cls.def_property_readonly(
+      "cache_hits", [](const Self& self) { return self.Get().cache_hits; },
+      R"(
+Number of cache reads satisfied by cached data.
+
+Group:
+  Accessors
+)");
+  cls.def_property_readonly(
+      "cache_misses", [](const Self& self) { return self.Get().cache_misses; },
+      R"(
+Number of cache reads that required I/O.
+
+Group:
+  Accessors
+)");
+  cls.def_property_readonly(
+      "decode_time",
+      [](const Self& self) {
+        return absl::ToDoubleSeconds(self.Get().decode_time);
+      },
+      R"(
+Total time in seconds spent decoding chunks.
+
+Group:
+  Accessors
+)");
+  cls.def(
+      "reset", [](Self& self) { self.Reset(); },
+      R"(
+Resets all counters to zero.
+
+Group:
+  Operations
+)");
+  cls.def("__repr__", [](const Self& self) {
+    auto counters = self.Get();
+    return tensorstore::StrCat(
+        "OperationStats(kvstore_reads=", counters.kvstore_reads,
+        ", kvstore_bytes_read=", counters.kvstore_bytes_read,
+        ", kvstore_writes=", counters.kvstore_writes,
+        ", kvstore_bytes_written=", counters.kvstore_bytes_written,
+        ", cache_hits=", counters.cache_hits,
+        ", cache_misses=", counters.cache_misses,
+        ", decode_time=", absl::ToDoubleSeconds(counters.decode_time), ")");
+  });
+}
+
+void RegisterOperationStatsBindings(pybind11::module m, Executor defer) {
+  defer([cls = MakeOperationStatsClass(m)]() mutable {
+    DefineOperationStatsAttributes(cls);
+  });
+}
+
+TENSORSTORE_GLOBAL_INITIALIZER {
+  RegisterPythonComponent(RegisterOperationStatsBindings, /*priority=*/-445);
+}
+
+}  // namespace
+}  // namespace internal_python
+}  // namespace tensorstore
@@ -50,6 +50,10 @@ void InitializePythonImports() {
   i.builtins_timeout_error_class =
       py::object(i.builtins_module.attr("TimeoutError")).release();
 
+  i.numpy_module = py::module_::import("numpy").release();
+  i.numpy_from_dlpack_function =
+      py::object(i.numpy_module.attr("from_dlpack")).release();
+
   i.pickle_module = py::module_::import("pickle").release();
   i.pickle_dumps_function = py::object(i.pickle_module.attr("dumps")).release();
   i.pickle_loads_function = py::object(i.pickle_module.attr("loads")).release();
@@ -17,8 +17,8 @@
 
 /// \file
 ///
-/// Imports of Python builtin and standard library modules/functions that are
-/// required.
+/// Imports of Python builtin and standard library modules/functions, and of
+/// NumPy functions, that are required.
 ///
 /// These imports are resolved once during module initialization for efficiency.
 
@@ -44,6 +44,9 @@ struct PythonImports {
   pybind11::handle builtins_range_function;
   pybind11::handle builtins_timeout_error_class;
 
+  pybind11::handle numpy_module;
+  pybind11::handle numpy_from_dlpack_function;
+
   pybind11::handle pickle_module;
   pybind11::handle pickle_dumps_function;
   pybind11::handle pickle_loads_function;
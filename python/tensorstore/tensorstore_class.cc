@@ -39,6 +39,7 @@
 #include "python/tensorstore/index.h"
 #include "python/tensorstore/index_space.h"
 #include "python/tensorstore/keyword_arguments.h"
+#include "python/tensorstore/python_imports.h"
 #include "python/tensorstore/result_type_caster.h"
 #include "python/tensorstore/sequence_parameter.h"
 #include "python/tensorstore/serialization.h"
@@ -80,6 +81,8 @@
 #include "tensorstore/transaction.h"
 #include "tensorstore/util/executor.h"
 #include "tensorstore/util/future.h"
+#include "tensorstore/util/garbage_collection/std_vector.h"
+#include "tensorstore/util/span.h"
 #include "tensorstore/util/unit.h"
 
 // specializations
@@ -97,7 +100,7 @@ namespace py = ::pybind11;
 namespace {
 
 // Adds a `Batch` option to `WriteOptions` that always results in an error when
-// set.
+// set, and records the `copy` option for the conversion of the source array.
 //
 // This is used by `IssueCopyOrWrite` to support either `CopyOptions` or
 // `WriteOptions` with the same set of compile-time keyword arguments.
@@ -107,26 +110,74 @@ struct WriteOptionsWithBatch : public WriteOptions {
     return absl::InvalidArgumentError(
         "batch can only be specified when copying from a TensorStore source");
   }
+  absl::Status Set(write_setters::WriteSourceCopy copy) {
+    source_copy = copy.value;
+    return absl::OkStatus();
+  }
+  std::optional<bool> source_copy;
+};
+
+// Adds a `copy` option to `CopyOptions` that always results in an error when
+// set.
+struct CopyOptionsWithSourceCopy : public CopyOptions {
+  using CopyOptions::Set;
+  absl::Status Set(write_setters::WriteSourceCopy copy) {
+    return absl::InvalidArgumentError(
+        "copy can only be specified when writing from an array source");
+  }
 };
 
+// Converts the `out` argument of `TensorStore.read` to an array that refers
+// directly to the memory of `out`.
+//
+// Objects that support DLPack but are not NumPy arrays and do not support the
+// buffer protocol (e.g. framework tensors in pinned host memory) are first
+// converted using `numpy.from_dlpack`, which does not copy.
+SharedArray<void> GetReadTargetArray(py::handle out, DataType dtype) {
+  py::object obj = py::reinterpret_borrow<py::object>(out);
+  if (!py::isinstance<py::array>(obj) && !PyObject_CheckBuffer(obj.ptr()) &&
+      py::hasattr(obj, "__dlpack__")) {
+    obj = python_imports.numpy_from_dlpack_function(obj);
+  }
+  SharedArray<void> target;
+  ConvertToArray</*Element=*/void, /*Rank=*/dynamic_rank, /*NoThrow=*/false,
+                 /*AllowCopy=*/false>(obj, &target, dtype);
+  return target;
+}
+
 template <typename... ParamDef>
 WriteFutures IssueCopyOrWrite(
     const TensorStore<>& self,
     std::variant<PythonTensorStoreObject*, ArrayArgumentPlaceholder> source,
     KeywordArgument<ParamDef>&... arg) {
   if (auto* store = std::get_if<PythonTensorStoreObject*>(&source)) {
-    CopyOptions options;
+    CopyOptionsWithSourceCopy options;
     ApplyKeywordArguments<ParamDef...>(options, arg...);
-    return tensorstore::Copy((**store).value, self, std::move(options));
+    return tensorstore::Copy((**store).value, self,
+                             std::move(static_cast<CopyOptions&>(options)));
   } else {
     WriteOptionsWithBatch options;
     ApplyKeywordArguments<ParamDef...>(options, arg...);
     auto& source_obj = std::get_if<ArrayArgumentPlaceholder>(&source)->value;
-    SharedArray<const void> source_array;
-    ConvertToArray<const void, dynamic_rank, /*nothrow=*/false>(
-        source_obj, &source_array, self.dtype(), 0, self.rank());
+    SharedArray<void> source_array;
+    bool source_is_writable;
+    ConvertToArrayImpl(source_obj, source_array, source_is_writable,
+                       self.dtype(), /*min_rank=*/0, /*max_rank=*/self.rank(),
+                       /*writable=*/false, /*no_throw=*/false,
+                       options.source_copy);
+    if (options.source_copy) {
+      // Either `source_array` is a new array that is not referenced elsewhere,
+      // or the caller guarantees that it is not modified.  In both cases the
+      // write may reference it rather than copying it again.
+      options.source_data_reference_restriction =
+          can_reference_source_data_indefinitely;
+      if (!*options.source_copy && source_is_writable &&
+          py::isinstance<py::array>(source_obj)) {
+        source_obj.attr("setflags")(py::arg("write") = false);
+      }
+    }
     return tensorstore::Write(std::move(source_array), self,
-                              std::move(options));
+                              std::move(static_cast<WriteOptions&>(options)));
   }
 }
 
@@ -155,12 +206,13 @@ constexpr auto ForwardSpecRequestSetters = [](auto callback,
 };
 
 constexpr auto ForwardWriteSetters = [](auto callback, auto... other_param) {
-  callback(other_param..., open_setters::SetBatch{},
+  callback(other_param..., open_setters::SetBatch{}, write_setters::SetCopy{},
   // TODO(jbms): Add this option once it is supported.
 #if 0
            write_setters::SetCanReferenceSourceDataUntilCommit{},
 #endif
-           write_setters::SetCanReferenceSourceDataIndefinitely{});
+           write_setters::SetCanReferenceSourceDataIndefinitely{},
+           write_setters::SetOperationStats{});
 };
 
 using TensorStoreCls = py::class_<PythonTensorStoreObject>;
@@ -482,12 +534,32 @@ Group:
 
   cls.def(
       "read",
-      [](Self& self, ContiguousLayoutOrder order,
-         std::optional<Batch> batch) -> PythonFutureWrapper<SharedArray<void>> {
+      [](Self& self, ContiguousLayoutOrder order, std::optional<Batch> batch,
+         std::optional<ArrayArgumentPlaceholder> out,
+         std::optional<OperationStats> operation_stats)
+          -> PythonFutureWrapper<SharedArray<void>> {
+        OperationStats stats =
+            operation_stats ? *std::move(operation_stats) : OperationStats();
+        if (out) {
+          auto target = GetReadTargetArray(out->value, self.value.dtype());
+          return PythonFutureWrapper<SharedArray<void>>(
+              PromiseFuturePair<SharedArray<void>>::LinkValue(
+                  [target](Promise<SharedArray<void>> promise,
+                           ReadyFuture<void> future) {
+                    promise.SetResult(target);
+                  },
+                  tensorstore::Read(self.value, target,
+                                    internal_python::ValidateOptionalBatch(
+                                        std::move(batch)),
+                                    std::move(stats)))
+                  .future,
+              self.reference_manager());
+        }
         return PythonFutureWrapper<SharedArray<void>>(
             tensorstore::Read<zero_origin>(
                 self.value, order,
-                internal_python::ValidateOptionalBatch(std::move(batch))),
+                internal_python::ValidateOptionalBatch(std::move(batch)),
+                std::move(stats)),
             self.reference_manager());
       },
       R"(
@@ -541,8 +613,22 @@ Args:
        ready until the batch is submitted.  Therefore, immediately awaiting the
        returned future will lead to deadlock.
 
+  out: Existing array into which the data is read directly, rather than
+    allocating a new array.  May be a :py:obj:`numpy.ndarray`, any object
+    supporting the Python buffer protocol, or any object supporting
+    ``__dlpack__`` that refers to host memory, such as a pinned (page-locked)
+    staging buffer.  It must be writable, have a data type equal to
+    :python:`self.dtype`, and have a shape
+    :ref:`compatible<index-domain-alignment>` with :python:`self.domain`.
+    The :python:`order` is ignored.  The array must not be modified until the
+    returned future becomes ready.
+  operation_stats: Statistics object that accumulates the I/O performed by the
+    read.
+
 Returns:
-  A future representing the asynchronous read result.
+  A future representing the asynchronous read result.  If :python:`out` is
+  specified, the result is an array that refers to the memory of
+  :python:`out`.
 
 .. tip::
 
@@ -564,7 +650,9 @@ Group:
   I/O
 
 )",
-      py::kw_only(), py::arg("order") = "C", py::arg("batch") = std::nullopt);
+      py::kw_only(), py::arg("order") = "C", py::arg("batch") = std::nullopt,
+      py::arg("out") = std::nullopt,
+      py::arg("operation_stats") = std::nullopt);
 
   ForwardWriteSetters([&](auto... param_def) {
     std::string doc = R"(
@@ -2303,6 +2391,32 @@ Group:
   // pickling.
 }
 
+// Reads from each of `stores` as part of `batch`, and returns the arrays in
+// the same order.
+Future<std::vector<SharedArray<void>>> ReadMany(
+    std::vector<TensorStore<>> stores, ContiguousLayoutOrder order,
+    Batch batch) {
+  std::vector<Future<SharedArray<void>>> futures;
+  futures.reserve(stores.size());
+  for (auto& store : stores) {
+    futures.push_back(tensorstore::Read<zero_origin>(store, order, batch));
+  }
+  auto all_ready = WaitAllFuture(span(futures));
+  return MapFuture(
+      InlineExecutor{},
+      [futures = std::move(futures)](const Result<void>& result)
+          -> Result<std::vector<SharedArray<void>>> {
+        TENSORSTORE_RETURN_IF_ERROR(result);
+        std::vector<SharedArray<void>> arrays;
+        arrays.reserve(futures.size());
+        for (const auto& future : futures) {
+          arrays.push_back(future.value());
+        }
+        return arrays;
+      },
+      std::move(all_ready));
+}
+
 void DefineTensorStoreFunctions(py::module m) {
   m.def(
       "array",
@@ -2363,6 +2477,70 @@ Group:
       py::arg("context") = nullptr, py::arg("copy") = std::nullopt,
       py::arg("write") = std::nullopt);
 
+  m.def(
+      "experimental_read_many",
+      [](SequenceParameter<PythonTensorStoreObject*> python_stores,
+         ContiguousLayoutOrder order, std::optional<Batch> batch)
+          -> PythonFutureWrapper<std::vector<SharedArray<void>>> {
+        std::vector<TensorStore<>> stores(python_stores.size());
+        for (size_t i = 0; i < stores.size(); ++i) {
+          stores[i] = python_stores[i]->value;
+        }
+        PythonObjectReferenceManager reference_manager;
+        reference_manager.Update(stores);
+        Batch read_batch = batch ? ValidateOptionalBatch(std::move(batch))
+                                 : Batch::New();
+        Future<std::vector<SharedArray<void>>> future;
+        {
+          GilScopedRelease gil_release;
+          future = ReadMany(std::move(stores), order, std::move(read_batch));
+        }
+        return PythonFutureWrapper<std::vector<SharedArray<void>>>(
+            std::move(future), std::move(reference_manager));
+      },
+      R"(
+Reads the data within the domain of each of a sequence of TensorStores.
+
+All reads are issued as part of a single :py:obj:`Batch`, without holding the
+GIL, and the result is a single future.  This avoids the per-array overhead of
+reading each TensorStore separately, for example when reading one patch from
+each of many arrays.
+
+Example:
+
+    >>> a = ts.array([1, 2, 3, 4], dtype=ts.uint32)
+    >>> b = ts.array([5, 6, 7, 8], dtype=ts.uint32)
+    >>> await ts.experimental_read_many([a[1:3], b[2:]])
+    [array([2, 3], dtype=uint32), array([7, 8], dtype=uint32)]
+
+Args:
+  stores: TensorStores to read, typically already indexed to the region of
+    interest.
+  order: Contiguous layout order of the returned arrays, as for
+    :py:obj:`TensorStore.read`.
+  batch: Batch to use for the reads.  If not specified, a new batch is used,
+    which is submitted once all reads have been issued.
+
+    .. warning::
+
+       If specified, the returned :py:obj:`Future` will not, in general, become
+       ready until the batch is submitted.  Therefore, immediately awaiting the
+       returned future will lead to deadlock.
+
+Returns:
+  A future that resolves to the list of arrays, in the same order as
+  :python:`stores`, or to the first error encountered.
+
+See also:
+
+  - :py:obj:`TensorStore.read`
+
+Group:
+  I/O
+)",
+      py::arg("stores"), py::kw_only(), py::arg("order") = "C",
+      py::arg("batch") = std::nullopt);
+
   ForwardOpenSetters([&](auto... param_def) {
     std::string doc = R"(
 Opens or creates a :py:class:`TensorStore` from a :py:class:`Spec`.
@@ -37,6 +37,7 @@
 #include "tensorstore/context.h"
 #include "tensorstore/index.h"
 #include "tensorstore/open_mode.h"
+#include "tensorstore/operation_stats.h"
 #include "tensorstore/read_write_options.h"
 #include "tensorstore/tensorstore.h"
 #include "tensorstore/transaction.h"
@@ -159,6 +160,41 @@ key-value store.
 
 namespace write_setters {
 
+/// Specifies whether an array source of `TensorStore.write` may be copied.
+struct WriteSourceCopy {
+  bool value;
+};
+
+struct SetCopy {
+  using type = bool;
+  static constexpr const char* name = "copy";
+  template <typename Self>
+  static absl::Status Apply(Self& self, type value) {
+    return self.Set(WriteSourceCopy{value});
+  }
+  static constexpr const char* doc = R"(
+
+Indicates whether an array :python:`source` may be copied before it is written.
+Only valid if :python:`source` is not a :py:obj:`TensorStore`.
+
+- If `None` (default), :python:`source` is converted to an array, which is a
+  copy only if required, and its data is then copied by the write operation.
+
+- If `True`, :python:`source` is always converted to a new array, which may be
+  referenced by the write operation without an additional copy.
+  :python:`source` may be modified as soon as this function returns.
+
+- If `False`, :python:`source` is never copied, and an error is raised if it is
+  not an existing array with the same data type as :python:`self`.  To avoid the
+  memory and time of copying a large source array, the write operation may
+  retain references to its data indefinitely, as with
+  :py:param:`.can_reference_source_data_indefinitely`.  If :python:`source` is a
+  NumPy array, it is marked read-only; in any case, its data must not be
+  modified afterwards.
+
+)";
+};
+
 #if 0
 // TODO(jbms): Add this option once it is supported.
 struct SetCanReferenceSourceDataUntilCommit {
@@ -198,6 +234,20 @@ released.
 
 )";
 };
+
+struct SetOperationStats {
+  using type = OperationStats;
+  static constexpr const char* name = "operation_stats";
+  static constexpr const char* doc = R"(
+
+Statistics object that accumulates the I/O performed by the operation.
+
+)";
+  template <typename Self>
+  static absl::Status Apply(Self& self, type value) {
+    return self.Set(std::move(value));
+  }
+};
 }  // namespace write_setters
 
 }  // namespace internal_python
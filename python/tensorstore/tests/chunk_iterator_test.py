@@ -0,0 +1,95 @@
+# Copyright 2025 The TensorStore Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Tests for tensorstore.experimental_iter_chunks."""
+
+import numpy as np
+import pytest
+import tensorstore as ts
+
+pytestmark = pytest.mark.asyncio
+
+
+def _make_store():
+  return ts.array(np.arange(20, dtype=np.int32).reshape([4, 5])).translate_to[
+      1, 2
+  ]
+
+
+def test_iter_chunks():
+  store = _make_store()
+  results = list(ts.experimental_iter_chunks(store, [3, 2]))
+  assert [domain for domain, _ in results] == [
+      ts.IndexDomain(inclusive_min=[1, 2], shape=[3, 2]),
+      ts.IndexDomain(inclusive_min=[1, 4], shape=[3, 2]),
+      ts.IndexDomain(inclusive_min=[1, 6], shape=[3, 1]),
+      ts.IndexDomain(inclusive_min=[4, 2], shape=[1, 2]),
+      ts.IndexDomain(inclusive_min=[4, 4], shape=[1, 2]),
+      ts.IndexDomain(inclusive_min=[4, 6], shape=[1, 1]),
+  ]
+  expected = store.read().result()
+  for domain, array in results:
+    np.testing.assert_equal(
+        array,
+        expected[
+            domain[0].inclusive_min - 1 : domain[0].exclusive_max - 1,
+            domain[1].inclusive_min - 2 : domain[1].exclusive_max - 2,
+        ],
+    )
+
+
+@pytest.mark.parametrize(
+    "prefetch,prefetch_bytes", [(1, None), (3, None), (8, 4), (8, 1000)]
+)
+def test_iter_chunks_prefetch(prefetch, prefetch_bytes):
+  store = _make_store()
+  arrays = [
+      array
+      for _, array in ts.experimental_iter_chunks(
+          store, [1, 5], prefetch=prefetch, prefetch_bytes=prefetch_bytes
+      )
+  ]
+  np.testing.assert_equal(np.concatenate(arrays), store.read().result())
+
+
+def test_iter_chunks_order():
+  store = _make_store()
+  for _, array in ts.experimental_iter_chunks(store, [2, 2], order="F"):
+    assert array.flags.f_contiguous
+
+
+async def test_iter_chunks_async():
+  store = _make_store()
+  arrays = []
+  async for _, array in ts.experimental_iter_chunks(store, [4, 1]):
+    arrays.append(array)
+  np.testing.assert_equal(
+      np.concatenate(arrays, axis=1), store.read().result()
+  )
+
+
+def test_iter_chunks_invalid():
+  store = _make_store()
+  with pytest.raises(ValueError, match="region_shape"):
+    ts.experimental_iter_chunks(store, [1])
+  with pytest.raises(ValueError, match="region_shape"):
+    ts.experimental_iter_chunks(store, [1, 0])
+  with pytest.raises(ValueError, match="prefetch"):
+    ts.experimental_iter_chunks(store, [1, 1], prefetch=0)
+  with pytest.raises(ValueError, match="unbounded"):
+    ts.experimental_iter_chunks(
+        ts.virtual_chunked(lambda domain, array, params: None,
+                           dtype=ts.int32,
+                           domain=ts.IndexDomain(rank=1)),
+        [1],
+    )
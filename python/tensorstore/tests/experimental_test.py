@@ -13,6 +13,8 @@
 # limitations under the License.
 """Tests for tensorstore.experimental methods."""
 
+import os
+
 import pytest
 import tensorstore as ts
 
@@ -59,3 +61,25 @@ def test_experimental_update_verbose_logging():
   # check that the function exists.
   assert hasattr(ts, 'experimental_update_verbose_logging')
   ts.experimental_update_verbose_logging('')
+
+
+@pytest.mark.skipif(not hasattr(os, 'fork'), reason='requires os.fork')
+def test_experimental_enable_fork_support():
+  ts.experimental_enable_fork_support()
+  t = ts.open({
+      'driver': 'array',
+      'dtype': 'int32',
+      'array': [1, 2, 3],
+      'rank': 1,
+  }).result()
+  assert t[1].read().result() == 2
+  pid = os.fork()
+  if pid == 0:
+    exit_code = 1
+    try:
+      if t[2].read().result() == 3:
+        exit_code = 0
+    finally:
+      os._exit(exit_code)
+  _, status = os.waitpid(pid, 0)
+  assert os.waitstatus_to_exitcode(status) == 0
@@ -0,0 +1,57 @@
+# Copyright 2025 The TensorStore Authors
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Tests for tensorstore.OperationStats."""
+
+import numpy as np
+import pytest
+import tensorstore as ts
+
+pytestmark = pytest.mark.asyncio
+
+
+async def test_read_write():
+  context = ts.Context({'cache_pool': {'total_bytes_limit': 1000000}})
+  store = await ts.open(
+      {
+          'driver': 'zarr',
+          'kvstore': {'driver': 'memory'},
+          'recheck_cached_data': False,
+      },
+      context=context,
+      dtype=ts.uint32,
+      shape=[4, 6],
+      chunk_layout=ts.ChunkLayout(read_chunk_shape=[2, 3]),
+      create=True,
+  )
+  stats = ts.OperationStats()
+  await store.write(
+      np.arange(24, dtype=np.uint32).reshape([4, 6]), operation_stats=stats
+  )
+  assert stats.kvstore_writes == 4
+  assert stats.kvstore_bytes_written > 0
+
+  stats.reset()
+  assert stats.kvstore_writes == 0
+  await store.read(operation_stats=stats)
+  assert stats.kvstore_writes == 0
+  assert stats.cache_hits + stats.cache_misses >= 4
+  assert stats.decode_time >= 0
+
+
+async def test_repr():
+  stats = ts.OperationStats()
+  assert repr(stats) == (
+      'OperationStats(kvstore_reads=0, kvstore_bytes_read=0, kvstore_writes=0,'
+      ' kvstore_bytes_written=0, cache_hits=0, cache_misses=0, decode_time=0)'
+  )
@@ -61,6 +61,39 @@ async def test_open_array_driver():
     await t.read(order="X")
 
 
+async def test_read_out():
+  t = await ts.open({
+      "driver": "array",
+      "array": [[1, 2, 3], [4, 5, 6]],
+      "dtype": "int32",
+  })
+  out = np.zeros([2, 3], dtype=np.int32)
+  a = await t.read(out=out)
+  np.testing.assert_equal(out, [[1, 2, 3], [4, 5, 6]])
+  assert np.shares_memory(a, out)
+
+  # Reads into a strided view.
+  out = np.zeros([3, 4], dtype=np.int32, order="F")
+  await t[:, 1:].read(out=out[1:, 2:])
+  np.testing.assert_equal(out, [[0, 0, 0, 0], [0, 0, 2, 3], [0, 0, 5, 6]])
+
+  # Reads into an object supporting the buffer protocol.
+  buf = bytearray(8)
+  await t[1, 1:].read(out=memoryview(buf).cast("i"))
+  np.testing.assert_equal(np.frombuffer(buf, dtype=np.int32), [5, 6])
+
+  with pytest.raises(ValueError):
+    await t.read(out=np.zeros([2, 3], dtype=np.int64))
+
+  read_only = np.zeros([2, 3], dtype=np.int32)
+  read_only.flags.writeable = False
+  with pytest.raises(ValueError):
+    await t.read(out=read_only)
+
+  with pytest.raises(ValueError):
+    await t.read(out=np.zeros([2, 4], dtype=np.int32))
+
+
 async def test_resize():
   arr = np.asarray([[1, 2, 3], [4, 5, 6], [7, 8, 9]])
   t = await ts.open(
@@ -612,6 +645,56 @@ async def test_write_batch():
   await write_future
 
 
+async def test_write_copy():
+  store = await ts.open(
+      {"driver": "zarr3", "kvstore": "memory://"},
+      dtype=ts.uint8,
+      shape=[4],
+      create=True,
+  )
+  source = np.arange(4, dtype=np.uint8)
+  await store.write(source, copy=False)
+  assert not source.flags.writeable
+  np.testing.assert_equal(await store.read(), np.arange(4, dtype=np.uint8))
+
+  with pytest.raises(ValueError):
+    await store.write(np.arange(4, dtype=np.int32), copy=False)
+
+  source = np.zeros(4, dtype=np.uint8)
+  write_future = store.write(source, copy=True)
+  source[...] = 7
+  await write_future
+  assert source.flags.writeable
+  np.testing.assert_equal(await store.read(), np.zeros(4, dtype=np.uint8))
+
+  with pytest.raises(ValueError, match=".*copy can only be specified.*"):
+    await store.write(store, copy=False)
+
+
+async def test_experimental_read_many():
+  a = ts.array([1, 2, 3, 4], dtype=ts.uint32)
+  b = await ts.open(
+      {"driver": "zarr3", "kvstore": "memory://"},
+      dtype=ts.uint8,
+      shape=[2, 3],
+      create=True,
+  )
+  await b.write(np.arange(6, dtype=np.uint8).reshape(2, 3))
+  result = await ts.experimental_read_many([a[1:3], b[1:, ::2], b.T])
+  assert len(result) == 3
+  np.testing.assert_equal(result[0], np.array([2, 3], dtype=np.uint32))
+  np.testing.assert_equal(result[1], np.array([[3, 5]], dtype=np.uint8))
+  np.testing.assert_equal(
+      result[2], np.arange(6, dtype=np.uint8).reshape(2, 3).T
+  )
+
+  with ts.Batch() as batch:
+    future = ts.experimental_read_many([a], order="F", batch=batch)
+  np.testing.assert_equal((await future)[0], a.read().result())
+
+  assert await ts.experimental_read_many([]) == []
+
+
 async def test_open_with_open_kvstore():
   kvstore = await ts.KvStore.open("memory://")
   store = await ts.open(
@@ -0,0 +1,102 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/access_recorder.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cassert>
+#include <memory>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/box.h"
+#include "tensorstore/index_space/index_transform.h"
+#include "tensorstore/internal/json_binding/box.h"  // IWYU pragma: keep
+#include "tensorstore/internal/json_binding/json_binding.h"
+
+namespace tensorstore {
+
+namespace jb = tensorstore::internal_json_binding;
+
+struct AccessRecorder::State {
+  explicit State(size_t max_accesses) : max_accesses(max_accesses) {}
+
+  const size_t max_accesses;
+  absl::Mutex mutex;
+  std::vector<Access> accesses ABSL_GUARDED_BY(mutex);
+  int64_t num_dropped ABSL_GUARDED_BY(mutex) = 0;
+};
+
+std::ostream& operator<<(std::ostream& os, const AccessRecorder::Access& a) {
+  return os << "{region=" << a.region << ", is_write=" << a.is_write << "}";
+}
+
+TENSORSTORE_DEFINE_JSON_DEFAULT_BINDER(
+    AccessRecorder::Access,
+    jb::Object(jb::Member("region",
+                          jb::Projection<&AccessRecorder::Access::region>()),
+               jb::Member("write",
+                          jb::Projection<&AccessRecorder::Access::is_write>(
+                              jb::DefaultValue<jb::kNeverIncludeDefaults>(
+                                  [](auto* v) { *v = false; })))))
+
+AccessRecorder AccessRecorder::New(size_t max_accesses) {
+  AccessRecorder recorder;
+  recorder.state_ = std::make_shared<State>(max_accesses);
+  return recorder;
+}
+
+void AccessRecorder::Record(BoxView<> region, bool is_write) const {
+  if (!state_) return;
+  absl::MutexLock lock(&state_->mutex);
+  if (state_->accesses.size() >= state_->max_accesses) {
+    ++state_->num_dropped;
+    return;
+  }
+  state_->accesses.push_back(Access{Box<>(region), is_write});
+}
+
+void AccessRecorder::Record(IndexTransformView<> transform,
+                            bool is_write) const {
+  if (!state_) return;
+  Box<> region(transform.output_rank());
+  if (!GetOutputRange(transform, region).ok()) return;
+  Record(region, is_write);
+}
+
+std::vector<AccessRecorder::Access> AccessRecorder::Get() const {
+  if (!state_) return {};
+  absl::MutexLock lock(&state_->mutex);
+  return state_->accesses;
+}
+
+int64_t AccessRecorder::num_dropped() const {
+  if (!state_) return 0;
+  absl::MutexLock lock(&state_->mutex);
+  return state_->num_dropped;
+}
+
+void AccessRecorder::Reset() {
+  assert(state_);
+  absl::MutexLock lock(&state_->mutex);
+  state_->accesses.clear();
+  state_->num_dropped = 0;
+}
+
+}  // namespace tensorstore
@@ -0,0 +1,119 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_ACCESS_RECORDER_H_
+#define TENSORSTORE_ACCESS_RECORDER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <iosfwd>
+#include <memory>
+#include <vector>
+
+#include "tensorstore/box.h"
+#include "tensorstore/index_space/index_transform.h"
+#include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/json_serialization_options.h"
+
+namespace tensorstore {
+
+/// Records the regions accessed by the operations with which it is specified,
+/// e.g. via `ReadOptions` or `WriteOptions`.
+///
+/// The recorded accesses form a trace of the access pattern of an
+/// application, which may be replayed against candidate chunk layouts to
+/// choose a layout for a new dataset, e.g. using the ``tscli
+/// advise_chunk_layout`` command.
+///
+/// The same object may be specified for multiple operations, in which case
+/// their accesses are combined.
+///
+/// \ingroup core
+class AccessRecorder {
+ public:
+  /// Default maximum number of accesses recorded.
+  constexpr static size_t kDefaultMaxAccesses = 1000000;
+
+  /// A single recorded access.
+  struct Access {
+    /// Bounding box of the positions accessed, in the index space of the
+    /// underlying driver.
+    Box<> region;
+
+    /// Indicates a write rather than a read.
+    bool is_write = false;
+
+    friend bool operator==(const Access& a, const Access& b) {
+      return a.region == b.region && a.is_write == b.is_write;
+    }
+    friend bool operator!=(const Access& a, const Access& b) {
+      return !(a == b);
+    }
+
+    /// Prints a debugging string representation to an `std::ostream`.
+    friend std::ostream& operator<<(std::ostream& os, const Access& a);
+
+    /// JSON representation, e.g.
+    /// ``{"region": {"origin": [0, 0], "shape": [64, 64]}, "write": true}``.
+    TENSORSTORE_DECLARE_JSON_DEFAULT_BINDER(Access, JsonSerializationOptions,
+                                            JsonSerializationOptions)
+  };
+
+  /// Constructs a null object, which does not record accesses.
+  ///
+  /// \id null
+  AccessRecorder() = default;
+
+  /// Returns a new object with no recorded accesses.
+  ///
+  /// Accesses beyond the first `max_accesses` are counted by `num_dropped`
+  /// but not recorded.
+  static AccessRecorder New(size_t max_accesses = kDefaultMaxAccesses);
+
+  /// Returns `true` if this is not null.
+  bool valid() const { return static_cast<bool>(state_); }
+
+  /// Records an access to `region`.
+  ///
+  /// Has no effect if this is null.
+  void Record(BoxView<> region, bool is_write) const;
+
+  /// Records an access to the range of `transform`.
+  ///
+  /// Has no effect if this is null.
+  void Record(IndexTransformView<> transform, bool is_write) const;
+
+  /// Returns the recorded accesses, in the order in which they were recorded.
+  ///
+  /// Returns an empty list if this is null.
+  std::vector<Access> Get() const;
+
+  /// Returns the number of accesses that were not recorded because
+  /// `max_accesses` was exceeded.
+  int64_t num_dropped() const;
+
+  /// Discards all recorded accesses.
+  ///
+  /// \dchecks `valid()`
+  void Reset();
+
+ private:
+  struct State;
+  std::shared_ptr<State> state_;
+};
+
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_ACCESS_RECORDER_H_
@@ -0,0 +1,105 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/access_recorder.h"
+
+#include <stdint.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "tensorstore/array.h"
+#include "tensorstore/box.h"
+#include "tensorstore/context.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_space/dim_expression.h"
+#include "tensorstore/internal/json_binding/gtest.h"
+#include "tensorstore/open.h"
+#include "tensorstore/open_mode.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::AccessRecorder;
+using ::tensorstore::Box;
+using ::tensorstore::Context;
+using ::tensorstore::Dims;
+using ::tensorstore::MakeArray;
+using ::tensorstore::OpenMode;
+using ::testing::ElementsAre;
+
+using Access = AccessRecorder::Access;
+
+auto OpenStore() {
+  return tensorstore::Open<uint16_t, 2>(
+             {{"driver", "n5"},
+              {"kvstore", {{"driver", "memory"}}},
+              {"metadata",
+               {{"compression", {{"type", "raw"}}},
+                {"dataType", "uint16"},
+                {"dimensions", {4, 6}},
+                {"blockSize", {2, 3}}}}},
+             Context::Default(), OpenMode::create)
+      .result();
+}
+
+TEST(AccessRecorderTest, Null) {
+  AccessRecorder recorder;
+  EXPECT_FALSE(recorder.valid());
+  recorder.Record(Box<>({0, 0}, {2, 3}), /*is_write=*/false);
+  EXPECT_THAT(recorder.Get(), ElementsAre());
+  EXPECT_EQ(0, recorder.num_dropped());
+}
+
+TEST(AccessRecorderTest, MaxAccesses) {
+  auto recorder = AccessRecorder::New(/*max_accesses=*/2);
+  EXPECT_TRUE(recorder.valid());
+  recorder.Record(Box<>({0}, {1}), /*is_write=*/false);
+  recorder.Record(Box<>({1}, {1}), /*is_write=*/true);
+  recorder.Record(Box<>({2}, {1}), /*is_write=*/false);
+  EXPECT_THAT(recorder.Get(),
+              ElementsAre(Access{Box<>({0}, {1}), false},
+                          Access{Box<>({1}, {1}), true}));
+  EXPECT_EQ(1, recorder.num_dropped());
+
+  recorder.Reset();
+  EXPECT_THAT(recorder.Get(), ElementsAre());
+  EXPECT_EQ(0, recorder.num_dropped());
+}
+
+TEST(AccessRecorderTest, JsonBinding) {
+  tensorstore::TestJsonBinderRoundTrip<Access>({
+      {Access{Box<>({1, 2}, {3, 4}), false},
+       {{"region", {{"origin", {1, 2}}, {"shape", {3, 4}}}}}},
+      {Access{Box<>({0}, {5}), true},
+       {{"region", {{"origin", {0}}, {"shape", {5}}}}, {"write", true}}},
+  });
+}
+
+TEST(AccessRecorderTest, ReadWrite) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenStore());
+  auto recorder = AccessRecorder::New();
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Write(MakeArray<uint16_t>({{1, 2}, {3, 4}}),
+                         store | Dims(0, 1).SizedInterval({1, 2}, {2, 2}),
+                         recorder)
+          .commit_future.result());
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Read(store | Dims(1).IndexSlice(5), recorder).result());
+  EXPECT_THAT(recorder.Get(),
+              ElementsAre(Access{Box<>({1, 2}, {2, 2}), true},
+                          Access{Box<>({0, 5}, {4, 1}), false}));
+}
+
+}  // namespace
@@ -34,6 +34,7 @@
 #include "tensorstore/index.h"
 #include "tensorstore/internal/element_copy_function.h"
 #include "tensorstore/internal/integer_overflow.h"
+#include "tensorstore/internal/repeated_pattern.h"
 #include "tensorstore/internal/unaligned_data_type_functions.h"
 #include "tensorstore/rank.h"
 #include "tensorstore/serialization/serialization.h"
@@ -51,25 +52,82 @@ namespace tensorstore {
 namespace internal_array {
 
 namespace {
+
+// Checks if values of `dtype` compare equal under `comparison_kind` exactly
+// when their representations are bytewise equal.
+bool IsBytewiseComparable(DataType dtype,
+                          EqualityComparisonKind comparison_kind) {
+  switch (dtype.id()) {
+    case DataTypeId::bool_t:
+    case DataTypeId::char_t:
+    case DataTypeId::byte_t:
+    case DataTypeId::int8_t:
+    case DataTypeId::uint8_t:
+    case DataTypeId::int16_t:
+    case DataTypeId::uint16_t:
+    case DataTypeId::int32_t:
+    case DataTypeId::uint32_t:
+    case DataTypeId::int64_t:
+    case DataTypeId::uint64_t:
+      return true;
+    case DataTypeId::float8_e3m4_t:
+    case DataTypeId::float8_e4m3fn_t:
+    case DataTypeId::float8_e4m3fnuz_t:
+    case DataTypeId::float8_e4m3b11fnuz_t:
+    case DataTypeId::float8_e5m2_t:
+    case DataTypeId::float8_e5m2fnuz_t:
+    case DataTypeId::float16_t:
+    case DataTypeId::bfloat16_t:
+    case DataTypeId::float32_t:
+    case DataTypeId::float64_t:
+    case DataTypeId::complex64_t:
+    case DataTypeId::complex128_t:
+      // `equal` distinguishes neither `0` from `-0` nor NaN payloads.
+      return comparison_kind == EqualityComparisonKind::identical;
+    default:
+      return false;
+  }
+}
+
+// Compares `array` to the broadcast scalar `scalar`.
+//
+// If `array` is contiguous and its elements are bytewise comparable, compares
+// its bytes to repetitions of `scalar` with `memcmp`, which avoids a
+// per-element comparison of, for example, a chunk to its fill value.
+template <ArrayOriginKind OKind>
+bool CompareArrayToScalar(const ArrayView<const void, dynamic_rank, OKind>& a,
+                          const ArrayView<const void, dynamic_rank, OKind>& b,
+                          EqualityComparisonKind comparison_kind) {
+  const Index element_size = a.dtype()->size;
+  if (IsBytewiseComparable(a.dtype(), comparison_kind) &&
+      (IsContiguousLayout(a.layout(), c_order, element_size) ||
+       IsContiguousLayout(a.layout(), fortran_order, element_size))) {
+    return internal::IsRepeatedPattern(
+        a.byte_strided_origin_pointer().get(),
+        static_cast<size_t>(a.num_elements() * element_size),
+        b.byte_strided_origin_pointer().get(), element_size);
+  }
+  const auto& funcs =
+      a.dtype()->compare_equal[static_cast<size_t>(comparison_kind)];
+  return internal::IterateOverArrays(
+      {&funcs.array_scalar, nullptr},
+      /*arg=*/const_cast<void*>(b.byte_strided_origin_pointer().get()),
+      /*constraints=*/skip_repeated_elements, a);
+}
+
 template <ArrayOriginKind OKind>
 bool CompareArraysEqualImpl(const ArrayView<const void, dynamic_rank, OKind>& a,
                             const ArrayView<const void, dynamic_rank, OKind>& b,
                             EqualityComparisonKind comparison_kind) {
   if (a.dtype() != b.dtype()) return false;
-  const auto& funcs =
-      a.dtype()->compare_equal[static_cast<size_t>(comparison_kind)];
   if (IsBroadcastScalar(a)) {
-    return internal::IterateOverArrays(
-        {&funcs.array_scalar, nullptr},
-        /*arg=*/const_cast<void*>(a.byte_strided_origin_pointer().get()),
-        /*constraints=*/skip_repeated_elements, b);
+    return CompareArrayToScalar(b, a, comparison_kind);
   }
   if (IsBroadcastScalar(b)) {
-    return internal::IterateOverArrays(
-        {&funcs.array_scalar, nullptr},
-        /*arg=*/const_cast<void*>(b.byte_strided_origin_pointer().get()),
-        /*constraints=*/skip_repeated_elements, a);
+    return CompareArrayToScalar(a, b, comparison_kind);
   }
+  const auto& funcs =
+      a.dtype()->compare_equal[static_cast<size_t>(comparison_kind)];
   return internal::IterateOverArrays({&funcs.array_array, nullptr},
                                      /*arg=*/nullptr,
                                      /*constraints=*/skip_repeated_elements, a,
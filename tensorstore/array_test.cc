@@ -1061,6 +1061,45 @@ TEST(ArrayTest, Identical) {
           std::numeric_limits<float>::signaling_NaN())));
 }
 
+TEST(ArrayTest, CompareToBroadcastScalar) {
+  auto fill = [](auto value, tensorstore::span<const Index> shape) {
+    return BroadcastArray(MakeScalarArray(value), shape).value();
+  };
+  const Index shape[] = {100, 37};
+  auto int_array = tensorstore::AllocateArray<int>(shape, c_order);
+  std::fill_n(int_array.data(), int_array.num_elements(), 7);
+  EXPECT_EQ(fill(7, shape), int_array);
+  EXPECT_EQ(int_array, fill(7, shape));
+  int_array(99, 36) = 8;
+  EXPECT_NE(fill(7, shape), int_array);
+
+  // Fortran order and non-contiguous arrays.
+  auto fortran_array = tensorstore::AllocateArray<int>(
+      shape, fortran_order, tensorstore::value_init);
+  EXPECT_EQ(fill(0, shape), fortran_array);
+  fortran_array(50, 1) = 1;
+  EXPECT_NE(fill(0, shape), fortran_array);
+  const Index sub_shape[] = {50, 36};
+  EXPECT_EQ(fill(7, sub_shape),
+            ArrayView<int>(int_array.data(), StridedLayout<>(
+                                                 sub_shape,
+                                                 int_array.byte_strides())));
+
+  // `equal` distinguishes neither `0` from `-0` nor NaN payloads, while
+  // `identical` does.
+  auto float_array = tensorstore::AllocateArray<float>(shape, c_order);
+  std::fill_n(float_array.data(), float_array.num_elements(), -0.0f);
+  EXPECT_EQ(fill(0.0f, shape), float_array);
+  EXPECT_FALSE(AreArraysIdenticallyEqual(fill(0.0f, shape), float_array));
+  EXPECT_TRUE(AreArraysIdenticallyEqual(fill(-0.0f, shape), float_array));
+  std::fill_n(float_array.data(), float_array.num_elements(),
+              std::numeric_limits<float>::quiet_NaN());
+  EXPECT_NE(fill(std::numeric_limits<float>::quiet_NaN(), shape),
+            float_array);
+  EXPECT_TRUE(AreArraysIdenticallyEqual(
+      fill(std::numeric_limits<float>::quiet_NaN(), shape), float_array));
+}
+
 TEST(CopyArrayTest, ZeroOrigin) {
   int arr[2][3] = {{1, 2, 3}, {4, 5, 6}};
   auto arr_ref = MakeArrayView(arr);
@@ -26,6 +26,7 @@
 
 #include "absl/base/no_destructor.h"
 #include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
@@ -142,6 +143,11 @@ struct ContextProviderRegistry {
       std::unique_ptr<const ResourceProviderImplBase>, std::string_view,
       &ResourceProviderImplBase::id_>
       providers_ ABSL_GUARDED_BY(mutex_);
+  // Reference to the default resource of each provider, returned by
+  // `DefaultResourceSpec`.  Since a `ResourceReference` is immutable, a single
+  // instance is shared by all specs that use the default.
+  absl::flat_hash_map<std::string_view, ResourceSpecImplPtr> default_references_
+      ABSL_GUARDED_BY(mutex_);
 };
 
 static ContextProviderRegistry& GetRegistry() {
@@ -339,10 +345,39 @@ class ResourceReference : public ResourceSpecImplBase {
   Result<ResourceImplStrongPtr> CreateResource(
       const internal::ContextResourceCreationContext& creation_context)
       override {
-    // Look up referent.
+    ContextImpl* c = creation_context.context_;
+    absl::MutexLock lock(&c->root_->mutex_);
+    if (!key_.empty()) return Resolve(creation_context);
+    // An inline reference always resolves to the same resource within a given
+    // context, since resources are never removed.
+    if (auto it = c->resolved_references_.find(referent_);
+        it != c->resolved_references_.end()) {
+      return it->second;
+    }
+    auto result = Resolve(creation_context);
+    if (result.ok()) c->resolved_references_.emplace(referent_, *result);
+    return result;
+  }
+
+  Result<::nlohmann::json> ToJson(Context::ToJsonOptions options) override {
+    if (referent_.empty()) return nullptr;
+    return referent_;
+  }
+
+  ResourceSpecImplPtr UnbindContext(
+      const internal::ContextSpecBuilder& spec_builder) final {
+    auto& builder_impl = *internal_context::Access::impl(spec_builder);
+    // Ensure the referent is not reused as an identifier for another resource.
+    ++builder_impl.ids_[referent_];
+    return ResourceSpecImplPtr(this);
+  }
+
+ private:
+  // Looks up the referent.  Must be called with the root context mutex held.
+  Result<ResourceImplStrongPtr> Resolve(
+      const internal::ContextResourceCreationContext& creation_context) {
     std::string_view referent = referent_;
     auto* mutex = &creation_context.context_->root_->mutex_;
-    absl::MutexLock lock(mutex);
     ContextImpl* c = creation_context.context_;
     if (referent.empty()) {
       // Refers to default value in parent.  Only valid within a context spec.
@@ -385,19 +420,6 @@ class ResourceReference : public ResourceSpecImplBase {
     }
   }
 
-  Result<::nlohmann::json> ToJson(Context::ToJsonOptions options) override {
-    if (referent_.empty()) return nullptr;
-    return referent_;
-  }
-
-  ResourceSpecImplPtr UnbindContext(
-      const internal::ContextSpecBuilder& spec_builder) final {
-    auto& builder_impl = *internal_context::Access::impl(spec_builder);
-    // Ensure the referent is not reused as an identifier for another resource.
-    ++builder_impl.ids_[referent_];
-    return ResourceSpecImplPtr(this);
-  }
-
   std::string referent_;
 };
 
@@ -406,9 +428,12 @@ void RegisterContextResourceProvider(
   auto& registry = GetRegistry();
   absl::MutexLock lock(&registry.mutex_);
   auto id = provider->id_;
+  ResourceSpecImplPtr default_reference(new ResourceReference(std::string(id)));
+  default_reference->provider_ = provider.get();
   if (!registry.providers_.insert(std::move(provider)).second) {
     ABSL_LOG(FATAL) << "Provider " << QuoteString(id) << " already registered";
   }
+  registry.default_references_.emplace(id, std::move(default_reference));
 }
 
 const ResourceProviderImplBase* GetProvider(std::string_view id) {
@@ -501,8 +526,15 @@ Result<ResourceSpecImplPtr> ResourceSpecFromJson(
 }
 
 ResourceOrSpecPtr DefaultResourceSpec(std::string_view provider_id) {
-  return ToResourceOrSpecPtr(
-      ResourceSpecFromJson(provider_id, std::string(provider_id), {}).value());
+  auto& registry = GetRegistry();
+  absl::ReaderMutexLock lock(&registry.mutex_);
+  auto it = registry.default_references_.find(provider_id);
+  if (it == registry.default_references_.end()) {
+    // Indicates a build configuration problem.
+    ABSL_LOG(FATAL) << "Context resource provider " << QuoteString(provider_id)
+                    << " not registered";
+  }
+  return ToResourceOrSpecPtr(it->second);
 }
 
 }  // namespace internal_context
@@ -89,6 +89,14 @@ class ContextImpl : public internal::AtomicReferenceCount<ContextImpl> {
                                  std::string_view, &ResourceContainer::spec_key>
       resources_;
 
+  // Resources to which inline references to context resources, such as the
+  // default `"cache_pool"` reference of a driver spec, have been resolved,
+  // keyed by the referent.  Binding a spec repeatedly then requires only a
+  // single lookup per resource, rather than a search of the context chain.
+  //
+  // Guarded by `root_->mutex_`.
+  absl::flat_hash_map<std::string, ResourceImplStrongPtr> resolved_references_;
+
   /// Used in conjunction with
   /// `JsonSerializationOptions::preserve_bound_context_resources_` to indicate
   /// that only previously-bound context resources (wrapped in a
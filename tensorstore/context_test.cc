@@ -377,6 +377,36 @@ TEST(IntResourceTest, Inherit) {
   EXPECT_EQ(42, *resource4);
 }
 
+// Tests that repeatedly resolving references gives consistent results, both
+// in the context that defines the referent and in a child context.
+TEST(IntResourceTest, RepeatedReference) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto spec1, Context::Spec::FromJson({{"int_resource", {{"value", 7}}}}));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto spec2,
+      Context::Spec::FromJson({{"int_resource#a", {{"value", 9}}}}));
+  auto context1 = Context(spec1);
+  auto context2 = Context(spec2, context1);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto resource,
+      context2.GetResource(Context::Resource<IntResource>::DefaultSpec()));
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_THAT(
+        context1.GetResource(Context::Resource<IntResource>::DefaultSpec()),
+        ::testing::Optional(resource));
+    EXPECT_THAT(
+        context2.GetResource(Context::Resource<IntResource>::DefaultSpec()),
+        ::testing::Optional(resource));
+    auto reference =
+        Context::Resource<IntResource>::FromJson("int_resource#a").value();
+    EXPECT_THAT(context2.GetResource(reference),
+                ::testing::Optional(::testing::Pointee(9)));
+    EXPECT_THAT(context1.GetResource(reference),
+                MatchesStatus(absl::StatusCode::kInvalidArgument,
+                              "Resource not defined: \"int_resource#a\""));
+  }
+}
+
 TEST(IntResourceTest, Unknown) {
   EXPECT_THAT(Context::Spec::FromJson({
                   {"foo", {{"value", 7}}},
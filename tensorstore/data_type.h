@@ -954,6 +954,62 @@ struct CopyAssignImpl {
     return count;
   }
 #endif  // TENSORSTORE_DATA_TYPE_DISABLE_MEMMOVE_OPTIMIZATION
+
+  // Side length of the square tiles used by `ApplyStrided`.
+  constexpr static Index kTransposeTileSize = 16;
+
+  // Copies a strided block.
+  //
+  // If the source and destination disagree about which dimension has the
+  // smaller stride, as when copying between C-order and Fortran-order arrays,
+  // the block is copied in square tiles so that the source and destination
+  // accesses within each tile touch only a small number of cache lines.
+  template <typename SourceElement, typename DestElement>
+  static std::enable_if_t<std::is_trivially_copyable_v<DestElement>, bool>
+  ApplyStrided(internal::IterationBufferShape shape,
+               internal::IterationBufferPointer source,
+               internal::IterationBufferPointer dest, void*) {
+    using Accessor = internal::IterationBufferAccessor<
+        internal::IterationBufferKind::kStrided>;
+    const auto copy = [&](Index outer_begin, Index outer_end,
+                          Index inner_begin, Index inner_end) {
+      for (Index outer = outer_begin; outer < outer_end; ++outer) {
+        for (Index inner = inner_begin; inner < inner_end; ++inner) {
+          *Accessor::GetPointerAtPosition<DestElement>(dest, outer, inner) =
+              *Accessor::GetPointerAtPosition<SourceElement>(source, outer,
+                                                             inner);
+        }
+      }
+    };
+    const auto abs = [](Index x) { return x < 0 ? -x : x; };
+    if ((abs(source.inner_byte_stride) <= abs(source.outer_byte_stride)) ==
+            (abs(dest.inner_byte_stride) <= abs(dest.outer_byte_stride)) ||
+        shape[0] < kTransposeTileSize || shape[1] < kTransposeTileSize) {
+      copy(0, shape[0], 0, shape[1]);
+      return true;
+    }
+    for (Index outer = 0; outer < shape[0]; outer += kTransposeTileSize) {
+      const Index outer_end = std::min(shape[0], outer + kTransposeTileSize);
+      for (Index inner = 0; inner < shape[1]; inner += kTransposeTileSize) {
+        const Index inner_end = std::min(shape[1], inner + kTransposeTileSize);
+        if (outer_end - outer == kTransposeTileSize &&
+            inner_end - inner == kTransposeTileSize) {
+          // Constant trip counts allow the compiler to fully unroll.
+          for (Index i = 0; i < kTransposeTileSize; ++i) {
+            for (Index j = 0; j < kTransposeTileSize; ++j) {
+              *Accessor::GetPointerAtPosition<DestElement>(dest, outer + i,
+                                                           inner + j) =
+                  *Accessor::GetPointerAtPosition<SourceElement>(
+                      source, outer + i, inner + j);
+            }
+          }
+        } else {
+          copy(outer, outer_end, inner, inner_end);
+        }
+      }
+    }
+    return true;
+  }
 };
 
 // Implementation for `DataTypeOperations::move_assign`.
@@ -23,6 +23,7 @@
 #include <memory>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -212,6 +213,42 @@ TEST(ElementOperationsTest, UnsignedIntCopyAssign) {
   EXPECT_THAT(dest_arr, ::testing::ElementsAre(1, 1, 2, 2, 0xFFFFFFFF));
 }
 
+// Strided copies where the source and destination disagree about the
+// contiguous dimension are performed in tiles.  Includes sizes that are not
+// multiples of the tile size.
+template <typename T>
+void TestTransposedCopyAssign() {
+  DataType r = dtype_v<T>;
+  for (Index outer : {1, 15, 16, 40}) {
+    for (Index inner : {1, 16, 17, 35}) {
+      std::vector<T> source(outer * inner);
+      for (Index i = 0; i < outer * inner; ++i) source[i] = static_cast<T>(i);
+      std::vector<T> dest(outer * inner);
+      EXPECT_TRUE(r->copy_assign[IterationBufferKind::kStrided](
+          nullptr, {outer, inner},
+          IterationBufferPointer{source.data(), Index(sizeof(T) * inner),
+                                 Index(sizeof(T))},
+          IterationBufferPointer{dest.data(), Index(sizeof(T)),
+                                 Index(sizeof(T) * outer)},
+          /*status=*/nullptr));
+      for (Index i = 0; i < outer; ++i) {
+        for (Index j = 0; j < inner; ++j) {
+          ASSERT_EQ(source[i * inner + j], dest[j * outer + i])
+              << "outer=" << outer << ", inner=" << inner << ", i=" << i
+              << ", j=" << j;
+        }
+      }
+    }
+  }
+}
+
+TEST(ElementOperationsTest, TransposedCopyAssign) {
+  TestTransposedCopyAssign<uint8_t>();
+  TestTransposedCopyAssign<uint16_t>();
+  TestTransposedCopyAssign<uint32_t>();
+  TestTransposedCopyAssign<uint64_t>();
+}
+
 TEST(ElementOperationsTest, UnsignedIntMoveAssign) {
   DataType r = dtype_v<unsigned int>;
 
@@ -16,15 +16,21 @@
 
 #include <cassert>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_join.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/batch.h"
 #include "tensorstore/context.h"
+#include "tensorstore/context_resource_provider.h"
 #include "tensorstore/driver/driver_spec.h"
 #include "tensorstore/driver/registry.h"
 #include "tensorstore/driver/url_registry.h"
@@ -55,6 +61,67 @@ namespace {
 
 namespace jb = ::tensorstore::internal_json_binding;
 
+/// Formats detected by the "auto" driver, keyed by the URL of the kvstore in
+/// which they were detected.
+class AutoDetectCache
+    : public internal::AtomicReferenceCount<AutoDetectCache> {
+ public:
+  explicit AutoDetectCache(bool enabled) : enabled_(enabled) {}
+
+  bool enabled() const { return enabled_; }
+
+  std::optional<internal_kvstore::AutoDetectMatch> Find(
+      const std::string& url) {
+    absl::MutexLock lock(&mutex_);
+    auto it = matches_.find(url);
+    if (it == matches_.end()) return std::nullopt;
+    return it->second;
+  }
+
+  void Insert(std::string url, internal_kvstore::AutoDetectMatch match) {
+    absl::MutexLock lock(&mutex_);
+    matches_.insert_or_assign(std::move(url), std::move(match));
+  }
+
+ private:
+  const bool enabled_;
+  absl::Mutex mutex_;
+  absl::flat_hash_map<std::string, internal_kvstore::AutoDetectMatch> matches_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+struct AutoDetectCacheResource
+    : public internal::ContextResourceTraits<AutoDetectCacheResource> {
+  constexpr static char id[] = "auto_detect_cache";
+  struct Spec {
+    bool enabled = true;
+
+    constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+      return f(x.enabled);
+    };
+  };
+  using Resource = internal::IntrusivePtr<AutoDetectCache>;
+  static Spec Default() { return {}; }
+  static constexpr auto JsonBinder() {
+    return jb::Object(
+        jb::Member("enabled", jb::Projection(&Spec::enabled,
+                                             jb::DefaultValue([](auto* v) {
+                                               *v = true;
+                                             }))));
+  }
+  static Result<Resource> Create(
+      Spec spec, internal::ContextResourceCreationContext context) {
+    return Resource(new AutoDetectCache(spec.enabled));
+  }
+  static Spec GetSpec(const Resource& resource,
+                      const internal::ContextSpecBuilder& builder) {
+    return {resource->enabled()};
+  }
+};
+
+const internal::ContextResourceRegistration<AutoDetectCacheResource>
+    auto_detect_cache_registration;
+
 class AutoDriverSpec
     : public internal::RegisteredDriverSpec<AutoDriverSpec,
                                             /*Parent=*/internal::DriverSpec> {
@@ -111,7 +178,13 @@ class AutoDriverSpec
 // Driver handle.
 //
 // 1. Call `internal_kvstore::AutoDetectFormat` on `store` to obtain
-//    auto-detected format candidates.
+//    auto-detected format candidates.  The first call uses the batch from
+//    `driver_open_request`, which is released since the detection reads are
+//    not submitted until all references to the batch are released.
+//
+//    Unless `store` has a transaction, a format previously detected for the
+//    URL of `store` is taken from `cache` instead, and a newly detected format
+//    is added to it.
 //
 // 2. If there is not exactly one candidate, fail with an error.
 //
@@ -132,6 +205,7 @@ struct AutoOpenState {
   KvStore store;
   Executor executor;
   Context context;
+  internal::IntrusivePtr<AutoDetectCache> cache;
   internal::DriverOpenRequest driver_open_request;
   using Ptr = std::unique_ptr<AutoOpenState>;
   using PromiseType = Promise<internal::Driver::Handle>;
@@ -150,11 +224,22 @@ struct AutoOpenState {
   }
 
   static void AutoDetect(Ptr self, PromiseType promise) {
+    std::string cache_key;
+    if (self->cache->enabled() &&
+        self->store.transaction == no_transaction) {
+      if (auto url = self->store.ToUrl(); url.ok()) {
+        cache_key = *std::move(url);
+        if (auto match = self->cache->Find(cache_key)) {
+          ApplyDetectedMatch(std::move(self), std::move(promise), *match);
+          return;
+        }
+      }
+    }
     auto& self_ref = *self;
     LinkValue(
         WithExecutor(
             self_ref.executor,
-            [self = std::move(self)](
+            [self = std::move(self), cache_key = std::move(cache_key)](
                 PromiseType promise,
                 ReadyFuture<std::vector<internal_kvstore::AutoDetectMatch>>
                     matches_future) mutable {
@@ -174,11 +259,16 @@ struct AutoOpenState {
                         absl::StrJoin(matches, ", "))));
                 return;
               }
+              if (!cache_key.empty()) {
+                self->cache->Insert(std::move(cache_key), matches[0]);
+              }
               ApplyDetectedMatch(std::move(self), std::move(promise),
                                  matches[0]);
             }),
         std::move(promise),
-        internal_kvstore::AutoDetectFormat(self_ref.executor, self_ref.store));
+        internal_kvstore::AutoDetectFormat(
+            self_ref.executor, self_ref.store,
+            std::exchange(self_ref.driver_open_request.batch, no_batch)));
   }
 
   static void ApplyDetectedMatch(
@@ -241,6 +331,10 @@ Future<internal::Driver::Handle> AutoDriverSpec::Open(
       all_context_resources.context
           .GetResource<internal::DataCopyConcurrencyResource>());
   state->executor = data_copy_concurrency->executor;
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto auto_detect_cache,
+      all_context_resources.context.GetResource<AutoDetectCacheResource>());
+  state->cache = *auto_detect_cache;
   state->context = all_context_resources.context;
   state->driver_open_request = std::move(request);
 
@@ -114,7 +114,10 @@ TEST(AutoTest, UnbindContextSimple) {
                 {"memory_key_value_store", ::nlohmann::json::object_t()},
                 {"data_copy_concurrency", ::nlohmann::json::object_t()},
                 {"cache_pool", {{"total_bytes_limit", 1000}}},
+                {"file_io_coalescing", ::nlohmann::json::object_t()},
                 {"file_io_concurrency", ::nlohmann::json::object_t()},
+                {"file_io_direct", false},
+                {"file_io_engine", ::nlohmann::json::object_t()},
                 {"file_io_locking", ::nlohmann::json::object_t()},
                 {"file_io_memmap", false},
                 {"file_io_sync", true},
@@ -151,7 +154,10 @@ TEST(AutoTest, UnbindContext1) {
                 {"memory_key_value_store#1", ::nlohmann::json::object_t()},
                 {"data_copy_concurrency", ::nlohmann::json::object_t()},
                 {"cache_pool", {{"total_bytes_limit", 1000}}},
+                {"file_io_coalescing", ::nlohmann::json::object_t()},
                 {"file_io_concurrency", ::nlohmann::json::object_t()},
+                {"file_io_direct", false},
+                {"file_io_engine", ::nlohmann::json::object_t()},
                 {"file_io_locking", ::nlohmann::json::object_t()},
                 {"file_io_memmap", false},
                 {"file_io_sync", true},
@@ -171,6 +177,28 @@ TEST(AutoTest, MemoryZarr3) {
       tensorstore::Open("memory://tmp/dataset.zarr", context).result());
 }
 
+TEST(AutoTest, MemoryZarr3DetectionCache) {
+  for (bool enabled : {true, false}) {
+    SCOPED_TRACE(enabled);
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto context,
+        Context::FromJson({{"auto_detect_cache", {{"enabled", enabled}}}}));
+    TENSORSTORE_ASSERT_OK(tensorstore::Open("memory://tmp/dataset.zarr|zarr3",
+                                            context,
+                                            tensorstore::dtype_v<int32_t>,
+                                            tensorstore::Schema::Shape({5}),
+                                            tensorstore::OpenMode::create)
+                              .result());
+    for (int i = 0; i < 2; ++i) {
+      TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+          auto store,
+          tensorstore::Open("memory://tmp/dataset.zarr", context).result());
+      TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto spec, store.spec());
+      EXPECT_EQ("zarr3", spec.ToJson()->value("driver", ""));
+    }
+  }
+}
+
 TEST(AutoTest, MemoryOcdbtZarr3) {
   auto context = Context::Default();
   TENSORSTORE_ASSERT_OK(
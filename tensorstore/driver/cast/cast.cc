@@ -324,6 +324,8 @@ struct ReadChunkImpl {
     TENSORSTORE_ASSIGN_OR_RETURN(
         auto iterable,
         base(ReadChunk::BeginRead{}, std::move(chunk_transform), arena));
+    // The conversion is applied as the chunk is copied, directly from the
+    // base chunk to the target buffer, without an intermediate buffer.
     return GetConvertedInputNDIterable(std::move(iterable), self->target_dtype_,
                                        self->input_conversion_);
   }
@@ -345,6 +347,7 @@ struct WriteChunkImpl {
     TENSORSTORE_ASSIGN_OR_RETURN(
         auto iterable,
         base(WriteChunk::BeginWrite{}, std::move(chunk_transform), arena));
+    // Likewise, source elements are converted directly into the base chunk.
     return GetConvertedOutputNDIterable(
         std::move(iterable), self->target_dtype_, self->output_conversion_);
   }
@@ -40,6 +40,8 @@ namespace internal {
 ///     `size_t component_index()`, `const ChunkCache *cache()`, and
 ///     `const StalenessBound &data_staleness_bound()`.  The `Derived` type can
 ///     inherit from `ChunkGridSpecificationDriver` to define those methods.
+///     `Derived` must also define `bool fill_missing_data_reads()` and
+///     `StalenessBound missing_data_staleness_bound()`.
 template <typename Derived, typename Parent>
 class ChunkCacheReadWriteDriverMixin : public Parent {
  public:
@@ -48,7 +50,8 @@ class ChunkCacheReadWriteDriverMixin : public Parent {
     static_cast<Derived*>(this)->cache()->Read(
         {std::move(request), static_cast<Derived*>(this)->component_index(),
          static_cast<Derived*>(this)->data_staleness_bound().time,
-         static_cast<Derived*>(this)->fill_missing_data_reads()},
+         static_cast<Derived*>(this)->fill_missing_data_reads(),
+         static_cast<Derived*>(this)->missing_data_staleness_bound().time},
         std::move(receiver));
   }
 
@@ -149,6 +152,7 @@ class ChunkCacheDriver
 
   bool fill_missing_data_reads() const { return true; }
   bool store_data_equal_to_fill_value() const { return false; }
+  StalenessBound missing_data_staleness_bound() const { return {}; }
 };
 
 }  // namespace internal
@@ -14,11 +14,19 @@
 
 #include "tensorstore/driver/copy.h"
 
+#include <stddef.h>
+
 #include <atomic>
+#include <deque>
 #include <memory>
 #include <utility>
+#include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/array.h"
+#include "tensorstore/array_storage_statistics.h"
 #include "tensorstore/batch.h"
 #include "tensorstore/data_type.h"
 #include "tensorstore/data_type_conversion.h"
@@ -31,12 +39,16 @@
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/lock_collection.h"
 #include "tensorstore/internal/nditerable.h"
+#include "tensorstore/internal/nditerable_array.h"
 #include "tensorstore/internal/nditerable_copy.h"
 #include "tensorstore/internal/nditerable_data_type_conversion.h"
 #include "tensorstore/internal/nditerable_util.h"
 #include "tensorstore/internal/tagged_ptr.h"
+#include "tensorstore/internal/tracing/operation_stats.h"
 #include "tensorstore/internal/tracing/operation_trace_span.h"
+#include "tensorstore/internal/tracing/trace_context.h"
 #include "tensorstore/open_mode.h"
+#include "tensorstore/operation_stats.h"
 #include "tensorstore/progress.h"
 #include "tensorstore/read_write_options.h"
 #include "tensorstore/resize_options.h"
@@ -76,6 +88,14 @@ namespace {
 ///    m`CopyReadChunkReceiver` ensures that the read is canceled if
 ///    `copy_promise.result_needed()` becomes `false`.
 ///
+///    With a `CopyWindow`, `CopyWindowState` defers each `WriteChunk` until it
+///    fits within the window.
+///
+///    Unless `unstored_source_regions` is `read_unstored_source_regions`,
+///    `CopyInitiateReadOp` first queries the storage statistics of that portion
+///    of `source_driver`, and `CopyUnstoredSourceOp` handles the portions for
+///    which no data is stored without reading them.
+///
 /// 5. For each `ReadChunk` received, `CopyReadChunkReceiver` invokes
 ///    `CopyChunkOp` using `executor` to copy the data from the appropriate
 ///    portion of the `ReadChunk` to the `WriteChunk`.
@@ -97,6 +117,8 @@ namespace {
 /// 8. Once `CopyState` is destroyed and all `CommitCallback` links are
 ///    completed, the `commit_promise` is marked ready, indicating to the caller
 ///    that all data has been written back (or an error has occurred).
+struct CopyWindowState;
+
 struct CopyState : public internal::AtomicReferenceCount<CopyState> {
   /// CommitState is a separate reference-counted struct (rather than simply
   /// using `CopyState`) in order to ensure the reference to `copy_promise` and
@@ -140,9 +162,12 @@ struct CopyState : public internal::AtomicReferenceCount<CopyState> {
   internal::OpenTransactionPtr target_transaction;
   IndexTransform<> source_transform;
   DomainAlignmentOptions alignment_options;
+  UnstoredSourceRegions unstored_source_regions;
   Promise<void> copy_promise;
   Promise<void> commit_promise;
   IntrusivePtr<CommitState> commit_state{new CommitState};
+  /// Null unless a `CopyWindow` is specified.
+  IntrusivePtr<CopyWindowState> window;
   internal_tracing::OperationTraceSpan tspan{"tensorstore.Copy"};
 
   void SetError(absl::Status error) {
@@ -150,12 +175,122 @@ struct CopyState : public internal::AtomicReferenceCount<CopyState> {
   }
 };
 
+/// Target chunk waiting to fit within the `CopyWindow`.
+struct PendingCopyChunk {
+  IntrusivePtr<CopyState> state;
+  WriteChunk chunk;
+  IndexTransform<> cell_transform;
+  size_t bytes;
+};
+
+/// Starts copying the target chunk `pending`, which has been admitted to the
+/// window.
+void StartCopyChunk(PendingCopyChunk pending, Batch source_batch);
+
+/// Admits target chunks for copying within the limits of a `CopyWindow`.
+///
+/// Unlike `CopyState`, this is retained until the writeback of the copied
+/// chunks completes.  The pending chunks retain the `CopyState`, and are
+/// started, or dropped if the copy is no longer needed, as the chunks in
+/// flight complete.
+struct CopyWindowState
+    : public internal::AtomicReferenceCount<CopyWindowState> {
+  CopyWindow limits;
+  /// Size of the target data type.
+  size_t element_size;
+
+  absl::Mutex mutex;
+  size_t read_bytes ABSL_GUARDED_BY(mutex) = 0;
+  size_t write_bytes ABSL_GUARDED_BY(mutex) = 0;
+  std::deque<PendingCopyChunk> pending ABSL_GUARDED_BY(mutex);
+
+  /// Queues `chunk`, and starts the chunks that fit within the window, reading
+  /// their source regions with `source_batch`.
+  void Enqueue(PendingCopyChunk chunk, const Batch& source_batch) {
+    std::vector<PendingCopyChunk> admitted, dropped;
+    {
+      absl::MutexLock lock(&mutex);
+      pending.push_back(std::move(chunk));
+      TakeAdmitted(admitted, dropped);
+    }
+    for (auto& c : admitted) StartCopyChunk(std::move(c), source_batch);
+  }
+
+  /// Removes `read` and `write` bytes from the window, and starts the chunks
+  /// that then fit within it.
+  void Release(size_t read, size_t write) {
+    std::vector<PendingCopyChunk> admitted, dropped;
+    {
+      absl::MutexLock lock(&mutex);
+      read_bytes -= read;
+      write_bytes -= write;
+      TakeAdmitted(admitted, dropped);
+    }
+    // The batch of the copy may already have been submitted.
+    for (auto& c : admitted) StartCopyChunk(std::move(c), no_batch);
+  }
+
+  /// Accounts for a copied target region of `num_elements` until
+  /// `commit_future` becomes ready, and starts its writeback.
+  void AddWriteBehind(Index num_elements, Future<const void> commit_future) {
+    if (limits.write_behind_bytes == 0) return;
+    const size_t bytes = static_cast<size_t>(num_elements) * element_size;
+    {
+      absl::MutexLock lock(&mutex);
+      write_bytes += bytes;
+    }
+    commit_future.ExecuteWhenReady(
+        [self = IntrusivePtr<CopyWindowState>(this),
+         bytes](ReadyFuture<const void> future) { self->Release(0, bytes); });
+    commit_future.Force();
+  }
+
+  void TakeAdmitted(std::vector<PendingCopyChunk>& admitted,
+                    std::vector<PendingCopyChunk>& dropped)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex) {
+    while (!pending.empty()) {
+      auto& next = pending.front();
+      if (!next.state->copy_promise.result_needed()) {
+        dropped.push_back(std::move(next));
+        pending.pop_front();
+        continue;
+      }
+      if (read_bytes != 0 || write_bytes != 0) {
+        if (limits.read_ahead_bytes != 0 &&
+            read_bytes + next.bytes > limits.read_ahead_bytes) {
+          break;
+        }
+        if (limits.write_behind_bytes != 0 &&
+            write_bytes + next.bytes > limits.write_behind_bytes) {
+          break;
+        }
+      }
+      read_bytes += next.bytes;
+      admitted.push_back(std::move(next));
+      pending.pop_front();
+    }
+  }
+};
+
+/// Holds the read-ahead bytes of an admitted target chunk until its source
+/// region has been read and copied.
+struct CopyReadSlot : public internal::AtomicReferenceCount<CopyReadSlot> {
+  IntrusivePtr<CopyWindowState> window;
+  size_t bytes;
+  ~CopyReadSlot() { window->Release(bytes, 0); }
+};
+
 /// Callback invoked by `CopyWriteChunkReceiver` (using the executor) to copy
 /// data from the relevant portion of a single `ReadChunk` to a `WriteChunk`.
 struct CopyChunkOp {
   IntrusivePtr<CopyState> state;
   ReadChunk read_chunk;
   WriteChunk adjusted_write_chunk;
+  /// If valid, copied in place of `read_chunk`, which is then ignored.  Must
+  /// have a shape of `adjusted_write_chunk.transform.input_shape()`.
+  SharedArray<const void> fill_value;
+  /// Null unless a `CopyWindow` is specified.
+  IntrusivePtr<CopyReadSlot> slot;
   void operator()() {
     DefaultNDIterableArena arena;
 
@@ -164,17 +299,25 @@ struct CopyChunkOp {
     absl::Status copy_status;
     Future<const void> commit_future;
     {
-      TENSORSTORE_ASSIGN_OR_RETURN(auto guard,
-                                   LockChunks(lock_collection, read_chunk.impl,
-                                              adjusted_write_chunk.impl),
-                                   state->SetError(_));
-
       TENSORSTORE_ASSIGN_OR_RETURN(
-          auto source_iterable,
-          read_chunk.impl(ReadChunk::BeginRead{},
-                          std::move(read_chunk.transform), arena),
+          auto guard,
+          fill_value.valid()
+              ? LockChunks(lock_collection, adjusted_write_chunk.impl)
+              : LockChunks(lock_collection, read_chunk.impl,
+                           adjusted_write_chunk.impl),
           state->SetError(_));
 
+      NDIterable::Ptr source_iterable;
+      if (fill_value.valid()) {
+        source_iterable = GetArrayNDIterable(std::move(fill_value), arena);
+      } else {
+        TENSORSTORE_ASSIGN_OR_RETURN(
+            source_iterable,
+            read_chunk.impl(ReadChunk::BeginRead{},
+                            std::move(read_chunk.transform), arena),
+            state->SetError(_));
+      }
+
       TENSORSTORE_ASSIGN_OR_RETURN(
           auto target_iterable,
           adjusted_write_chunk.impl(WriteChunk::BeginWrite{},
@@ -213,6 +356,9 @@ struct CopyChunkOp {
         // For transactional writes, `state->commit_promise` is null.
         LinkValue(CommitCallback{state->commit_state, num_elements},
                   state->commit_promise, commit_future);
+        // Registered after `CommitCallback`, so that the commit is reported
+        // before any further chunk is started.
+        if (slot) slot->window->AddWriteBehind(num_elements, commit_future);
       } else {
         state->commit_state->UpdateCommitProgress(num_elements);
       }
@@ -229,6 +375,7 @@ struct CopyReadChunkReceiver {
   IntrusivePtr<CopyState> state;
   WriteChunk write_chunk;
   FutureCallbackRegistration cancel_registration;
+  IntrusivePtr<CopyReadSlot> slot;
   void set_starting(AnyCancelReceiver cancel) {
     cancel_registration =
         state->copy_promise.ExecuteWhenNotNeeded(std::move(cancel));
@@ -256,7 +403,70 @@ struct CopyReadChunkReceiver {
     //
     // Don't move `state` since `set_value` may be called multiple times.
     state->executor(CopyChunkOp{state, std::move(read_chunk),
-                                std::move(adjusted_write_chunk)});
+                                std::move(adjusted_write_chunk),
+                                /*fill_value=*/{}, slot});
+  }
+};
+
+/// Initiates a read for the portion `read_transform` of the source TensorStore
+/// corresponding to the target `chunk`.
+void InitiateCopyRead(IntrusivePtr<CopyState> state, WriteChunk chunk,
+                      IndexTransform<> read_transform, Batch source_batch,
+                      IntrusivePtr<CopyReadSlot> slot) {
+  Driver::ReadRequest request;
+  request.transaction = state->source_transaction;
+  request.transform = std::move(read_transform);
+  request.batch = std::move(source_batch);
+  Driver& source_driver = *state->source_driver;
+  source_driver.Read(
+      std::move(request),
+      CopyReadChunkReceiver{std::move(state), std::move(chunk),
+                            /*cancel_registration=*/{}, std::move(slot)});
+}
+
+/// Callback invoked (using the executor) with the storage statistics of the
+/// portion `read_transform` of the source TensorStore corresponding to the
+/// target `chunk`.
+struct CopyUnstoredSourceOp {
+  IntrusivePtr<CopyState> state;
+  WriteChunk chunk;
+  IndexTransform<> read_transform;
+  Batch source_batch;
+  IntrusivePtr<CopyReadSlot> slot;
+  void operator()(ReadyFuture<ArrayStorageStatistics> future) {
+    // Errors, including from drivers that do not support storage statistics,
+    // are left to the read to report.
+    const auto& result = future.result();
+    if (!result.ok() || !result->not_stored) {
+      InitiateCopyRead(std::move(state), std::move(chunk),
+                       std::move(read_transform), std::move(source_batch),
+                       std::move(slot));
+      return;
+    }
+    const Index num_elements = read_transform.domain().num_elements();
+    if (state->unstored_source_regions == skip_unstored_source_regions) {
+      auto& commit_state = *state->commit_state;
+      commit_state.UpdateReadProgress(num_elements);
+      commit_state.UpdateCopyProgress(num_elements);
+      commit_state.UpdateCommitProgress(num_elements);
+      return;
+    }
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto fill_value, state->source_driver->GetFillValue(read_transform),
+        state->SetError(_));
+    if (!fill_value.valid()) {
+      InitiateCopyRead(std::move(state), std::move(chunk),
+                       std::move(read_transform), std::move(source_batch),
+                       std::move(slot));
+      return;
+    }
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        fill_value,
+        BroadcastArray(std::move(fill_value), read_transform.input_shape()),
+        state->SetError(_));
+    state->commit_state->UpdateReadProgress(num_elements);
+    CopyChunkOp{std::move(state), ReadChunk{}, std::move(chunk),
+                std::move(fill_value), std::move(slot)}();
   }
 };
 
@@ -268,6 +478,8 @@ struct CopyInitiateReadOp {
   WriteChunk chunk;
   IndexTransform<> cell_transform;
   Batch source_batch;
+  /// Null unless a `CopyWindow` is specified.
+  IntrusivePtr<CopyReadSlot> slot;
   void operator()() {
     // Map the portion of the target TensorStore corresponding to this source
     // `chunk` to the index space expected by `chunk`.
@@ -276,14 +488,27 @@ struct CopyInitiateReadOp {
         ComposeTransforms(state->source_transform, cell_transform),
         state->SetError(_));
 
-    // Initiate a read for the portion of the source TensorStore
-    // corresponding to this target `chunk`.
-    Driver::ReadRequest request;
+    if (state->unstored_source_regions == read_unstored_source_regions) {
+      InitiateCopyRead(std::move(state), std::move(chunk),
+                       std::move(read_transform), std::move(source_batch),
+                       std::move(slot));
+      return;
+    }
+
+    // Determine whether any data is stored for the portion of the source
+    // TensorStore corresponding to this target `chunk` before reading it.
+    Driver::GetStorageStatisticsRequest request;
     request.transaction = state->source_transaction;
-    request.transform = std::move(read_transform);
-    request.batch = std::move(source_batch);
-    state->source_driver->Read(std::move(request),
-                               CopyReadChunkReceiver{state, std::move(chunk)});
+    request.transform = read_transform;
+    request.options.mask = ArrayStorageStatistics::query_not_stored;
+    auto future =
+        state->source_driver->GetStorageStatistics(std::move(request));
+    auto executor = state->executor;
+    std::move(future).ExecuteWhenReady(WithExecutor(
+        std::move(executor),
+        CopyUnstoredSourceOp{std::move(state), std::move(chunk),
+                             std::move(read_transform),
+                             std::move(source_batch), std::move(slot)}));
   }
 };
 
@@ -302,6 +527,15 @@ struct CopyWriteChunkReceiver {
   void set_done() {}
   void set_error(absl::Status error) { state->SetError(std::move(error)); }
   void set_value(WriteChunk chunk, IndexTransform<> cell_transform) {
+    if (state->window) {
+      const size_t bytes =
+          static_cast<size_t>(cell_transform.domain().num_elements()) *
+          state->window->element_size;
+      state->window->Enqueue(
+          {state, std::move(chunk), std::move(cell_transform), bytes},
+          source_batch);
+      return;
+    }
     // Defer actual work to executor.
     //
     // Don't move `state` since `set_value` may be called multiple times.
@@ -312,6 +546,17 @@ struct CopyWriteChunkReceiver {
 
 /// Callback used by `DriverCopy` to initiate the copy operation once the bounds
 /// for the source and target transforms have been resolved.
+void StartCopyChunk(PendingCopyChunk pending, Batch source_batch) {
+  IntrusivePtr<CopyReadSlot> slot(new CopyReadSlot);
+  slot->window = pending.state->window;
+  slot->bytes = pending.bytes;
+  auto executor = pending.state->executor;
+  executor(CopyInitiateReadOp{
+      std::move(pending.state), std::move(pending.chunk),
+      std::move(pending.cell_transform), std::move(source_batch),
+      std::move(slot)});
+}
+
 struct DriverCopyInitiateOp {
   IntrusivePtr<CopyState> state;
   void operator()(Promise<void> promise,
@@ -353,6 +598,10 @@ WriteFutures DriverCopy(Executor executor, DriverHandle source,
       internal::ValidateSupportsRead(source.driver.read_write_mode()));
   TENSORSTORE_RETURN_IF_ERROR(
       internal::ValidateSupportsWrite(target.driver.read_write_mode()));
+  // I/O performed on behalf of the operation, including by asynchronous work
+  // started within this scope, is attributed to `options.operation_stats`.
+  internal_tracing::ScopedOperationStats stats_scope(
+      internal_tracing::OperationStatsAccess::state(options.operation_stats));
   IntrusivePtr<CopyState> state(new CopyState);
   state->executor = executor;
   TENSORSTORE_ASSIGN_OR_RETURN(
@@ -370,6 +619,12 @@ WriteFutures DriverCopy(Executor executor, DriverHandle source,
       state->target_transaction,
       internal::AcquireOpenTransactionPtrOrError(target.transaction));
   state->alignment_options = options.alignment_options;
+  state->unstored_source_regions = options.unstored_source_regions;
+  if (options.window.enabled()) {
+    state->window.reset(new CopyWindowState);
+    state->window->limits = options.window;
+    state->window->element_size = state->target_driver->dtype()->size;
+  }
   state->commit_state->progress_function = std::move(options.progress_function);
   auto copy_pair = PromiseFuturePair<void>::Make(MakeResult());
   PromiseFuturePair<void> commit_pair;
@@ -385,6 +640,7 @@ WriteFutures DriverCopy(Executor executor, DriverHandle source,
   bounds_options.Set(fix_resizable_bounds).IgnoreError();
 
   // Resolve the source and target bounds.
+  internal_tracing::ScopedTraceContext trace_scope(state->tspan.context());
   auto source_transform_future = state->source_driver->ResolveBounds(
       {state->source_transaction, std::move(source.transform), bounds_options});
   auto target_transform_future = state->target_driver->ResolveBounds(
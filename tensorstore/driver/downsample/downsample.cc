@@ -16,16 +16,26 @@
 
 #include <stddef.h>
 
+#include <stdint.h>
+
 #include <algorithm>
 #include <cassert>
+#include <list>
+#include <memory>
 #include <mutex>
+#include <numeric>
+#include <optional>
 #include <utility>
 #include <vector>
 
 #include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/inlined_vector.h"
+#include "absl/functional/function_ref.h"
 #include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "tensorstore/array.h"
 #include "tensorstore/array_storage_statistics.h"
 #include "tensorstore/box.h"
@@ -36,6 +46,7 @@
 #include "tensorstore/data_type.h"
 #include "tensorstore/downsample_method.h"
 #include "tensorstore/driver/chunk.h"
+#include "tensorstore/driver/chunk_receiver_utils.h"
 #include "tensorstore/driver/downsample/downsample_array.h"
 #include "tensorstore/driver/downsample/downsample_method_json_binder.h"  // IWYU pragma: keep
 #include "tensorstore/driver/downsample/downsample_nditerable.h"
@@ -55,11 +66,13 @@
 #include "tensorstore/index_space/index_transform_builder.h"
 #include "tensorstore/index_space/transformed_array.h"
 #include "tensorstore/internal/arena.h"
+#include "tensorstore/internal/grid_partition_iterator.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
 #include "tensorstore/internal/json_binding/std_array.h"
 #include "tensorstore/internal/lock_collection.h"
 #include "tensorstore/internal/nditerable_transformed_array.h"
+#include "tensorstore/internal/regular_grid.h"
 #include "tensorstore/json_serialization_options.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/kvstore/spec.h"
@@ -68,6 +81,8 @@
 #include "tensorstore/rank.h"
 #include "tensorstore/resize_options.h"
 #include "tensorstore/schema.h"
+#include "tensorstore/read_write_options.h"
+#include "tensorstore/serialization/absl_time.h"  // IWYU pragma: keep
 #include "tensorstore/serialization/std_vector.h"  // IWYU pragma: keep
 #include "tensorstore/spec.h"
 #include "tensorstore/transaction.h"
@@ -76,6 +91,7 @@
 #include "tensorstore/util/executor.h"
 #include "tensorstore/util/future.h"
 #include "tensorstore/util/garbage_collection/std_vector.h"  // IWYU pragma: keep
+#include "tensorstore/util/division.h"
 #include "tensorstore/util/iterate.h"
 #include "tensorstore/util/result.h"
 #include "tensorstore/util/span.h"
@@ -163,10 +179,11 @@ class DownsampleDriverSpec
   TransformedDriverSpec base;
   std::vector<Index> downsample_factors;
   DownsampleMethod downsample_method;
+  internal::DownsampleOutputCacheOptions output_cache;
 
   constexpr static auto ApplyMembers = [](auto& x, auto f) {
     return f(internal::BaseCast<internal::DriverSpec>(x), x.base,
-             x.downsample_factors, x.downsample_method);
+             x.downsample_factors, x.downsample_method, x.output_cache);
   };
 
   absl::Status InitializeFromBase() {
@@ -241,6 +258,9 @@ class DownsampleDriverSpec
                 return obj->ValidateDownsampleMethod();
               },
               jb::Projection<&DownsampleDriverSpec::downsample_method>())),
+      jb::Member("output_cache",
+                 jb::Projection<&DownsampleDriverSpec::output_cache>(
+                     jb::DefaultInitializedValue<jb::kNeverIncludeDefaults>())),
       jb::Initialize([](auto* obj) {
         SpecOptions base_options;
         static_cast<Schema&>(base_options) = std::exchange(obj->schema, {});
@@ -328,7 +348,8 @@ class DownsampleDriverSpec
           TENSORSTORE_ASSIGN_OR_RETURN(
               auto downsampled_handle,
               MakeDownsampleDriver(std::move(handle), spec->downsample_factors,
-                                   spec->downsample_method));
+                                   spec->downsample_method,
+                                   spec->output_cache));
           // Validate the domain constraint specified by the schema, if any.
           // All other schema constraints are propagated to the base driver, and
           // therefore aren't checked here.
@@ -345,6 +366,165 @@ class DownsampleDriverSpec
   }
 };
 
+/// Shape of the output cache cells along dimensions for which the base
+/// specifies no read chunk shape.
+constexpr Index kDefaultOutputCacheCellSize = 64;
+
+/// Returns the shape of the output cache cells: the read chunk shape of
+/// `base_transform` divided by `downsample_factors`.
+std::vector<Index> GetOutputCacheCellShape(
+    internal::Driver& base_driver, IndexTransformView<> base_transform,
+    tensorstore::span<const Index> downsample_factors) {
+  const DimensionIndex rank = downsample_factors.size();
+  std::vector<Index> cell_shape(rank, kDefaultOutputCacheCellSize);
+  auto chunk_layout = base_driver.GetChunkLayout(base_transform);
+  if (!chunk_layout.ok()) return cell_shape;
+  auto read_chunk_shape = chunk_layout->read_chunk_shape();
+  if (read_chunk_shape.size() != rank) return cell_shape;
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    if (read_chunk_shape[i] > 0) {
+      cell_shape[i] = CeilOfRatio(read_chunk_shape[i], downsample_factors[i]);
+    }
+  }
+  return cell_shape;
+}
+
+/// Cache of the downsampled output of a `DownsampleDriver`, partitioned into a
+/// regular grid of cells.
+///
+/// Each cell is computed at most once while its entry is valid; concurrent
+/// reads of a cell being computed share the computation.
+class OutputCache : public std::enable_shared_from_this<OutputCache> {
+ public:
+  using CellArray = SharedOffsetArray<const void>;
+  using ComputeFunction =
+      absl::FunctionRef<Future<SharedOffsetArray<void>>()>;
+
+  OutputCache(internal::DownsampleOutputCacheOptions options,
+              std::vector<Index> cell_shape)
+      : options_(options), cell_shape_(std::move(cell_shape)) {}
+
+  const internal::DownsampleOutputCacheOptions& options() const {
+    return options_;
+  }
+
+  tensorstore::span<const Index> cell_shape() const { return cell_shape_; }
+
+  /// Returns the array of the cell with `cell_indices`, whose bounds within
+  /// the downsampled domain are `bounds`.  Calls `compute` unless an entry of
+  /// the cell with the same bounds, and not older than
+  /// `DownsampleOutputCacheOptions::max_age`, exists.
+  Future<const CellArray> GetCell(tensorstore::span<const Index> cell_indices,
+                                  BoxView<> bounds, ComputeFunction compute) {
+    std::vector<Index> key(cell_indices.begin(), cell_indices.end());
+    const absl::Time now = absl::Now();
+    uint64_t id;
+    Promise<CellArray> promise;
+    Future<const CellArray> future;
+    {
+      absl::MutexLock lock(&mutex_);
+      if (auto it = entries_.find(key); it != entries_.end()) {
+        Entry& entry = it->second;
+        if (BoxView<>(entry.bounds) == bounds &&
+            now - entry.time <= options_.max_age) {
+          if (entry.lru) lru_.splice(lru_.begin(), lru_, *entry.lru);
+          return entry.array;
+        }
+        EraseEntry(it);
+      }
+      auto pair = PromiseFuturePair<CellArray>::Make();
+      promise = std::move(pair.promise);
+      future = std::move(pair.future);
+      id = next_id_++;
+      Entry& entry = entries_[key];
+      entry.bounds = bounds;
+      entry.time = now;
+      entry.array = future;
+      entry.id = id;
+    }
+    LinkResult(std::move(promise), compute());
+    future.ExecuteWhenReady(
+        [self = shared_from_this(), key = std::move(key),
+         id](ReadyFuture<const CellArray> future) mutable {
+          self->CellComputed(std::move(key), id, future.result());
+        });
+    return future;
+  }
+
+ private:
+  struct Entry {
+    Box<> bounds;
+    /// Time at which the computation of the cell started.
+    absl::Time time;
+    Future<const CellArray> array;
+    size_t bytes = 0;
+    /// Distinguishes the entry from entries of the same cell that it replaced.
+    uint64_t id;
+    /// Position in `lru_`, once the array is computed.
+    std::optional<std::list<std::vector<Index>>::iterator> lru;
+  };
+
+  using Entries = absl::flat_hash_map<std::vector<Index>, Entry>;
+
+  void CellComputed(std::vector<Index> key, uint64_t id,
+                    const Result<CellArray>& result) {
+    absl::MutexLock lock(&mutex_);
+    auto it = entries_.find(key);
+    // The entry was evicted or replaced while being computed.
+    if (it == entries_.end() || it->second.id != id) return;
+    if (!result.ok()) {
+      entries_.erase(it);
+      return;
+    }
+    Entry& entry = it->second;
+    entry.bytes = result->num_elements() * result->dtype()->size;
+    total_bytes_ += entry.bytes;
+    lru_.push_front(std::move(key));
+    entry.lru = lru_.begin();
+    while (total_bytes_ > options_.total_bytes_limit && !lru_.empty()) {
+      EraseEntry(entries_.find(lru_.back()));
+    }
+  }
+
+  void EraseEntry(Entries::iterator it) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    Entry& entry = it->second;
+    if (entry.lru) {
+      total_bytes_ -= entry.bytes;
+      lru_.erase(*entry.lru);
+    }
+    entries_.erase(it);
+  }
+
+  const internal::DownsampleOutputCacheOptions options_;
+  const std::vector<Index> cell_shape_;
+
+  absl::Mutex mutex_;
+  Entries entries_ ABSL_GUARDED_BY(mutex_);
+  /// Keys of the computed entries, most recently used first.
+  std::list<std::vector<Index>> lru_ ABSL_GUARDED_BY(mutex_);
+  size_t total_bytes_ ABSL_GUARDED_BY(mutex_) = 0;
+  uint64_t next_id_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+/// Implementation of the `ReadChunk::Impl` Poly interface for a cell of the
+/// output cache.
+struct CachedReadChunkImpl {
+  SharedOffsetArray<const void> array;
+
+  absl::Status operator()(LockCollection& lock_collection) const {
+    return absl::OkStatus();
+  }
+
+  Result<NDIterable::Ptr> operator()(ReadChunk::BeginRead,
+                                     IndexTransform<> chunk_transform,
+                                     internal::Arena* arena) const {
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto transformed_array,
+        MakeTransformedArray(array, std::move(chunk_transform)));
+    return GetTransformedArrayNDIterable(std::move(transformed_array), arena);
+  }
+};
+
 class DownsampleDriver
     : public internal::RegisteredDriver<DownsampleDriver,
                                         /*Parent=*/internal::Driver> {
@@ -359,6 +539,7 @@ class DownsampleDriver
         base_driver_->GetBoundSpec(std::move(transaction), base_transform_));
     driver_spec->downsample_factors = downsample_factors_;
     driver_spec->downsample_method = downsample_method_;
+    if (output_cache_) driver_spec->output_cache = output_cache_->options();
     TENSORSTORE_RETURN_IF_ERROR(driver_spec->InitializeFromBase());
     TransformedDriverSpec spec;
     spec.transform = transform;
@@ -432,14 +613,17 @@ class DownsampleDriver
   Future<ArrayStorageStatistics> GetStorageStatistics(
       GetStorageStatisticsRequest request) override;
 
-  explicit DownsampleDriver(DriverPtr base, IndexTransform<> base_transform,
-                            tensorstore::span<const Index> downsample_factors,
-                            DownsampleMethod downsample_method)
+  explicit DownsampleDriver(
+      DriverPtr base, IndexTransform<> base_transform,
+      tensorstore::span<const Index> downsample_factors,
+      DownsampleMethod downsample_method,
+      std::shared_ptr<OutputCache> output_cache = nullptr)
       : base_driver_(std::move(base)),
         base_transform_(std::move(base_transform)),
         downsample_factors_(downsample_factors.begin(),
                             downsample_factors.end()),
-        downsample_method_(downsample_method) {}
+        downsample_method_(downsample_method),
+        output_cache_(std::move(output_cache)) {}
 
   DataType dtype() override { return base_driver_->dtype(); }
   DimensionIndex rank() override { return base_transform_.input_rank(); }
@@ -450,6 +634,9 @@ class DownsampleDriver
 
   void Read(ReadRequest request, ReadChunkReceiver receiver) override;
 
+  /// Reads the cells of `output_cache_` that intersect `request.transform`.
+  void ReadFromOutputCache(ReadRequest request, ReadChunkReceiver receiver);
+
   Result<IndexTransform<>> GetStridedBaseTransform() {
     return base_transform_ | tensorstore::AllDims().Stride(downsample_factors_);
   }
@@ -465,6 +652,9 @@ class DownsampleDriver
   IndexTransform<> base_transform_;
   std::vector<Index> downsample_factors_;
   DownsampleMethod downsample_method_;
+  /// Cache of the downsampled output, or `nullptr` if disabled.  Never used
+  /// with the stride method.
+  std::shared_ptr<OutputCache> output_cache_;
 };
 
 Future<IndexTransform<>> DownsampleDriver::ResolveBounds(
@@ -972,6 +1162,10 @@ void DownsampleDriver::Read(ReadRequest request, ReadChunkReceiver receiver) {
     base_driver_->Read(std::move(request), std::move(receiver));
     return;
   }
+  if (output_cache_ && !request.transaction) {
+    ReadFromOutputCache(std::move(request), std::move(receiver));
+    return;
+  }
   auto base_resolve_future = base_driver_->ResolveBounds(
       {request.transaction, base_transform_, {fix_resizable_bounds}});
   auto state = internal::MakeIntrusivePtr<ReadState>();
@@ -1013,6 +1207,82 @@ void DownsampleDriver::Read(ReadRequest request, ReadChunkReceiver receiver) {
       });
 }
 
+void DownsampleDriver::ReadFromOutputCache(ReadRequest request,
+                                           ReadChunkReceiver receiver) {
+  using ReadOperationState = internal::ChunkOperationState<ReadChunk>;
+  auto state =
+      internal::MakeIntrusivePtr<ReadOperationState>(std::move(receiver));
+  auto base_resolve_future = base_driver_->ResolveBounds(
+      {{}, base_transform_, {fix_resizable_bounds}});
+  LinkValue(
+      [self = IntrusivePtr<DownsampleDriver>(this), state,
+       request = std::move(request)](
+          Promise<void> promise, ReadyFuture<IndexTransform<>> future) {
+        // Cells are clipped to the downsampled domain, so that they do not
+        // depend on base data outside of it.
+        Box<dynamic_rank(internal::kNumInlinedDims)> downsampled_bounds(
+            self->rank());
+        internal_downsample::DownsampleBounds(
+            future.value().domain().box(), downsampled_bounds,
+            self->downsample_factors_, self->downsample_method_);
+        auto& cache = *self->output_cache_;
+        internal_grid_partition::RegularGridRef grid{cache.cell_shape()};
+        std::vector<DimensionIndex> grid_dims(self->rank());
+        std::iota(grid_dims.begin(), grid_dims.end(), DimensionIndex(0));
+        auto status = [&]() -> absl::Status {
+          internal_grid_partition::PartitionIndexTransformIterator iterator(
+              grid_dims, grid, request.transform);
+          TENSORSTORE_RETURN_IF_ERROR(iterator.Init());
+          Box<> cell_bounds(self->rank());
+          while (!iterator.AtEnd()) {
+            if (state->cancelled()) {
+              return absl::CancelledError("");
+            }
+            auto cell_indices = iterator.output_grid_cell_indices();
+            for (DimensionIndex i = 0; i < cell_bounds.rank(); ++i) {
+              cell_bounds[i] =
+                  Intersect(grid.GetCellOutputInterval(i, cell_indices[i]),
+                            downsampled_bounds[i]);
+            }
+            ReadChunk chunk;
+            TENSORSTORE_ASSIGN_OR_RETURN(chunk.transform,
+                                         iterator.GetCellToOutputTransform());
+            auto array_future = cache.GetCell(cell_indices, cell_bounds, [&] {
+              // Computes the whole cell without the cache.
+              internal::DriverHandle handle;
+              handle.driver = internal::MakeReadWritePtr<DownsampleDriver>(
+                  ReadWriteMode::read, self->base_driver_,
+                  self->base_transform_, self->downsample_factors_,
+                  self->downsample_method_);
+              handle.transform = tensorstore::IdentityTransform(cell_bounds);
+              ReadIntoNewArrayOptions options;
+              options.batch = request.batch;
+              return internal::DriverReadIntoNewArray(std::move(handle),
+                                                      std::move(options));
+            });
+            LinkValue(
+                [state, chunk = std::move(chunk),
+                 cell_transform = IndexTransform<>(iterator.cell_transform())](
+                    Promise<void> promise,
+                    ReadyFuture<const SharedOffsetArray<const void>>
+                        future) mutable {
+                  chunk.impl = CachedReadChunkImpl{future.value()};
+                  execution::set_value(state->shared_receiver->receiver,
+                                       std::move(chunk),
+                                       std::move(cell_transform));
+                },
+                state->promise, std::move(array_future));
+            iterator.Advance();
+          }
+          return absl::OkStatus();
+        }();
+        if (!status.ok()) {
+          state->SetError(std::move(status));
+        }
+      },
+      state->promise, std::move(base_resolve_future));
+}
+
 Future<ArrayStorageStatistics> DownsampleDriver::GetStorageStatistics(
     GetStorageStatisticsRequest request) {
   if (downsample_method_ == DownsampleMethod::kStride) {
@@ -1063,7 +1333,8 @@ namespace internal {
 
 Result<Driver::Handle> MakeDownsampleDriver(
     Driver::Handle base, tensorstore::span<const Index> downsample_factors,
-    DownsampleMethod downsample_method) {
+    DownsampleMethod downsample_method,
+    const DownsampleOutputCacheOptions& output_cache) {
   if (downsample_factors.size() != base.transform.input_rank()) {
     return absl::InvalidArgumentError(tensorstore::StrCat(
         "Number of downsample factors (", downsample_factors.size(),
@@ -1084,10 +1355,19 @@ Result<Driver::Handle> MakeDownsampleDriver(
   auto downsampled_domain =
       internal_downsample::GetDownsampledDomainIdentityTransform(
           base.transform.domain(), downsample_factors, downsample_method);
+  std::shared_ptr<internal_downsample::OutputCache> cache;
+  if (output_cache.enabled() &&
+      downsample_method != DownsampleMethod::kStride) {
+    cache = std::make_shared<internal_downsample::OutputCache>(
+        output_cache,
+        internal_downsample::GetOutputCacheCellShape(
+            *base.driver, base.transform, downsample_factors));
+  }
   base.driver =
       internal::MakeReadWritePtr<internal_downsample::DownsampleDriver>(
           ReadWriteMode::read, std::move(base.driver),
-          std::move(base.transform), downsample_factors, downsample_method);
+          std::move(base.transform), downsample_factors, downsample_method,
+          std::move(cache));
   base.transform = std::move(downsampled_domain);
   return base;
 }
@@ -15,17 +15,64 @@
 #ifndef TENSORSTORE_DRIVER_DOWNSAMPLE_DOWNSAMPLE_H_
 #define TENSORSTORE_DRIVER_DOWNSAMPLE_DOWNSAMPLE_H_
 
+#include <stddef.h>
+
+#include "absl/time/time.h"
 #include "tensorstore/downsample_method.h"
 #include "tensorstore/driver/driver.h"
+#include "tensorstore/internal/json_binding/absl_time.h"
+#include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
 #include "tensorstore/util/result.h"
 #include "tensorstore/util/span.h"
 
 namespace tensorstore {
 namespace internal {
 
+/// Specifies the cache of downsampled output held by a `downsample` driver.
+///
+/// The downsampled domain is partitioned into a regular grid of cells, with
+/// the shape of the base read chunks divided by the downsample factors.  Cells
+/// are computed as a whole on first read, and retained, up to
+/// `total_bytes_limit`, in least-recently-used order.
+///
+/// Writes to the base after a cell is computed are not observed until the cell
+/// is older than `max_age`.
+struct DownsampleOutputCacheOptions {
+  /// Bound on the total size of the cached cells.  The cache is disabled if 0.
+  size_t total_bytes_limit = 0;
+
+  /// Cells computed longer ago are recomputed.
+  absl::Duration max_age = absl::InfiniteDuration();
+
+  bool enabled() const { return total_bytes_limit != 0; }
+
+  constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+    return f(x.total_bytes_limit, x.max_age);
+  };
+
+  constexpr static auto default_json_binder = internal_json_binding::Object(
+      internal_json_binding::Member(
+          "total_bytes_limit",
+          internal_json_binding::Projection<
+              &DownsampleOutputCacheOptions::total_bytes_limit>(
+              internal_json_binding::DefaultValue<
+                  internal_json_binding::kNeverIncludeDefaults>(
+                  [](auto* v) { *v = 0; }))),
+      internal_json_binding::Member(
+          "max_age",
+          internal_json_binding::Projection<
+              &DownsampleOutputCacheOptions::max_age>(
+              internal_json_binding::DefaultValue<
+                  internal_json_binding::kNeverIncludeDefaults>(
+                  [](auto* v) { *v = absl::InfiniteDuration(); })))
+      /**/);
+};
+
 Result<Driver::Handle> MakeDownsampleDriver(
     Driver::Handle base, span<const Index> downsample_factors,
-    DownsampleMethod downsample_method);
+    DownsampleMethod downsample_method,
+    const DownsampleOutputCacheOptions& output_cache = {});
 
 }  // namespace internal
 }  // namespace tensorstore
@@ -340,6 +340,44 @@ TEST(DownsampleArrayTest, ModeRank1Partial) {
               Optional(MakeArray<float>({99, 3})));
 }
 
+TEST(DownsampleArrayTest, ModeRank1Tie) {
+  // Ties are resolved in favor of the smallest value, both for small blocks
+  // (counting) and large blocks (sorting).
+  EXPECT_THAT(DownsampleArray(MakeArray<uint64_t>({5, 3, 5, 3}),
+                              span<const Index>({4}), DownsampleMethod::kMode),
+              Optional(MakeArray<uint64_t>({3})));
+  EXPECT_THAT(
+      DownsampleArray(MakeArray<uint64_t>({5, 3, 5, 3, 7, 7, 1, 9, 8, 6}),
+                      span<const Index>({10}), DownsampleMethod::kMode),
+      Optional(MakeArray<uint64_t>({3})));
+}
+
+TEST(DownsampleArrayTest, ModeRank3UniformLabel) {
+  auto array = tensorstore::AllocateArray<uint64_t>({4, 4, 2});
+  for (Index i = 0; i < 4; ++i) {
+    for (Index j = 0; j < 4; ++j) {
+      for (Index k = 0; k < 2; ++k) {
+        array(i, j, k) = (i < 2) ? 42 : 7 + (j + k) % 2;
+      }
+    }
+  }
+  EXPECT_THAT(
+      DownsampleArray(array, span<const Index>({2, 2, 2}),
+                      DownsampleMethod::kMode),
+      Optional(MakeArray<uint64_t>({{{42}, {42}}, {{7}, {7}}})));
+}
+
+TEST(DownsampleArrayTest, MedianRank1Large) {
+  EXPECT_THAT(
+      DownsampleArray(MakeArray<int>({9, 1, 8, 2, 7, 3, 6, 4, 5, 0, 10, 11}),
+                      span<const Index>({12}), DownsampleMethod::kMedian),
+      Optional(MakeArray<int>({5})));
+  EXPECT_THAT(
+      DownsampleArray(MakeArray<int>({4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4}),
+                      span<const Index>({12}), DownsampleMethod::kMedian),
+      Optional(MakeArray<int>({4})));
+}
+
 TEST(DownsampleArrayTest, ModeBool) {
   EXPECT_THAT(DownsampleArray(MakeArray<bool>({0, 0, 1, 1}),
                               span<const Index>({4}), DownsampleMethod::kMode),
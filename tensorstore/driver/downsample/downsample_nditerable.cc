@@ -403,12 +403,46 @@ struct StoreReductionTraitsBase {
   }
 };
 
+/// Maximum number of input elements for which `kMedian` and `kMode` use
+/// quadratic algorithms rather than sorting, e.g. for 2x2x2 blocks.
+constexpr ptrdiff_t kSmallReductionSize = 8;
+
+/// Returns `true` if all elements of `input` are equal.
+///
+/// This is the common case when downsampling segmentation volumes, and allows
+/// `kMedian` and `kMode` to skip sorting.
+template <typename Element>
+bool AllElementsEqual(span<const Element> input) {
+  for (ptrdiff_t i = 1; i < input.size(); ++i) {
+    if (!(input[i] == input[0])) return false;
+  }
+  return true;
+}
+
 template <typename Element>
 struct ReductionTraits<DownsampleMethod::kMedian, Element,
                        std::enable_if_t<IsOrderingSupported<Element>::value>>
     : public StoreReductionTraitsBase<DownsampleMethod::kMedian, Element> {
   static void ComputeOutput(Element& output, span<Element> input) {
-    auto median_it = input.begin() + (input.size() - 1) / 2;
+    if (AllElementsEqual<Element>(input)) {
+      output = input[0];
+      return;
+    }
+    const ptrdiff_t median_i = (input.size() - 1) / 2;
+    if (input.size() <= kSmallReductionSize) {
+      // Insertion sort is faster than `std::nth_element` for small inputs.
+      for (ptrdiff_t i = 1; i < input.size(); ++i) {
+        Element x = input[i];
+        ptrdiff_t j = i;
+        for (; j > 0 && x < input[j - 1]; --j) {
+          input[j] = input[j - 1];
+        }
+        input[j] = x;
+      }
+      output = input[median_i];
+      return;
+    }
+    auto median_it = input.begin() + median_i;
     std::nth_element(input.begin(), median_it, input.end());
     output = *median_it;
   }
@@ -433,9 +467,34 @@ template <typename Element>
 struct ReductionTraits<DownsampleMethod::kMode, Element>
     : public StoreReductionTraitsBase<DownsampleMethod::kMode, Element> {
   static void ComputeOutput(Element& output, span<Element> input) {
+    if (AllElementsEqual<Element>(input)) {
+      output = input[0];
+      return;
+    }
+    CompareForMode<Element> compare;
+    if (input.size() <= kSmallReductionSize) {
+      // Count the occurrences of each value directly.  As in the sort-based
+      // computation below, ties are resolved in favor of the smallest value.
+      ptrdiff_t most_frequent_index = 0;
+      ptrdiff_t most_frequent_count = 0;
+      for (ptrdiff_t i = 0; i < input.size(); ++i) {
+        ptrdiff_t count = 0;
+        for (ptrdiff_t j = 0; j < input.size(); ++j) {
+          count += (input[j] == input[i]);
+        }
+        if (count > most_frequent_count ||
+            (count == most_frequent_count &&
+             compare(input[i], input[most_frequent_index]))) {
+          most_frequent_count = count;
+          most_frequent_index = i;
+        }
+      }
+      output = input[most_frequent_index];
+      return;
+    }
     // Sort in order to determine the number of times each distinct value is
     // repeated.
-    std::sort(input.begin(), input.end(), CompareForMode<Element>{});
+    std::sort(input.begin(), input.end(), compare);
     Index most_frequent_index = 0;
     size_t most_frequent_count = 1;
     size_t cur_count = 1;
@@ -484,6 +543,65 @@ struct DownsampleImpl {
     }
   }
 
+  /// Accumulates `input[0:size]`, a contiguous row of input elements along the
+  /// inner dimension, into `acc`.
+  ///
+  /// The first input element is at position `offset` within the group of
+  /// `factor` input elements that corresponds to `acc[0]`.
+  ///
+  /// This is only valid if `!Traits::kStoreAllElements`, since it does not
+  /// track the position of each input element within its group.
+  static void AccumulateContiguousRow(AccumulateElement* acc,
+                                      const Element* input, Index size,
+                                      Index offset, Index factor) {
+    Index i = 0;
+    if (offset != 0) {
+      for (const Index end = std::min(factor - offset, size); i < end; ++i) {
+        Traits::Accumulate(*acc, input[i]);
+      }
+      ++acc;
+    }
+    const Index num_full_groups = (size - i) / factor;
+    // Use a constant group size for common factors, so that the compiler can
+    // unroll and vectorize the loop.
+    switch (factor) {
+      case 1:
+        AccumulateFullGroups<1>(acc, input + i, num_full_groups);
+        break;
+      case 2:
+        AccumulateFullGroups<2>(acc, input + i, num_full_groups);
+        break;
+      case 4:
+        AccumulateFullGroups<4>(acc, input + i, num_full_groups);
+        break;
+      case 8:
+        AccumulateFullGroups<8>(acc, input + i, num_full_groups);
+        break;
+      default:
+        for (Index j = 0; j < num_full_groups; ++j) {
+          for (Index k = 0; k < factor; ++k) {
+            Traits::Accumulate(acc[j], input[i + j * factor + k]);
+          }
+        }
+        break;
+    }
+    acc += num_full_groups;
+    i += num_full_groups * factor;
+    for (; i < size; ++i) {
+      Traits::Accumulate(*acc, input[i]);
+    }
+  }
+
+  template <Index Factor>
+  static void AccumulateFullGroups(AccumulateElement* acc,
+                                   const Element* input, Index num_groups) {
+    for (Index j = 0; j < num_groups; ++j) {
+      for (Index k = 0; k < Factor; ++k) {
+        Traits::Accumulate(acc[j], input[j * Factor + k]);
+      }
+    }
+  }
+
   /// ElementwiseFunction LoopTemplate implementation for accumulating the
   /// total.
   struct ProcessInput {
@@ -547,6 +665,25 @@ struct DownsampleImpl {
         }
       };
 
+      if constexpr (!Traits::kStoreAllElements &&
+                    ArrayAccessor::buffer_kind ==
+                        IterationBufferKind::kContiguous) {
+        // Fast path: the position of each input element within its group is
+        // not needed, and each input row is contiguous.
+        for_each_source_index(
+            std::integral_constant<Index, 0>{},
+            [&](Index output_outer_i, Index source_outer_i, Index element_i,
+                Index num_source_elements) {
+              AccumulateContiguousRow(
+                  acc + output_outer_i * output_block_shape[1],
+                  ArrayAccessor::template GetPointerAtPosition<Element>(
+                      source_pointer, source_outer_i, 0),
+                  base_block_shape[1], base_block_offset[1],
+                  downsample_factor[1]);
+            });
+        return true;
+      }
+
       const auto process_input_row = [&](Index output_outer_i,
                                          Index source_outer_i,
                                          Index num_outer_elements,
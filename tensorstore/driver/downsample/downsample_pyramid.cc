@@ -0,0 +1,289 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/driver/downsample/downsample_pyramid.h"
+
+#include <stddef.h>
+
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "tensorstore/array.h"
+#include "tensorstore/box.h"
+#include "tensorstore/contiguous_layout.h"
+#include "tensorstore/downsample_method.h"
+#include "tensorstore/driver/downsample/downsample_array.h"
+#include "tensorstore/driver/downsample/downsample_util.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_interval.h"
+#include "tensorstore/index_space/dim_expression.h"
+#include "tensorstore/index_space/transformed_array.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/division.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/iterate.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace internal_downsample {
+namespace {
+
+/// Regular grid over which the blocks of a single level are computed.
+struct BlockGrid {
+  /// Block shape, `0` indicates that blocks are unbounded.
+  std::vector<Index> shape;
+  std::vector<Index> origin;
+};
+
+BlockGrid GetBlockGrid(const TensorStore<>& store) {
+  const DimensionIndex rank = store.rank();
+  BlockGrid grid;
+  grid.shape.resize(rank, 0);
+  grid.origin.resize(rank, 0);
+  auto chunk_layout = store.chunk_layout();
+  if (!chunk_layout.ok()) return grid;
+  auto write_chunk_shape = chunk_layout->write_chunk_shape();
+  auto grid_origin = chunk_layout->grid_origin();
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    if (write_chunk_shape.size() == rank && write_chunk_shape[i] > 0) {
+      grid.shape[i] = write_chunk_shape[i];
+    }
+    if (grid_origin.size() == rank && grid_origin[i] != kImplicit) {
+      grid.origin[i] = grid_origin[i];
+    }
+  }
+  return grid;
+}
+
+class PyramidWriter {
+ public:
+  PyramidWriter(std::vector<TensorStore<>> stores,
+                span<const std::vector<Index>> downsample_factors,
+                DownsampleMethod method, size_t max_pending_writes,
+                Promise<void> promise)
+      : stores_(std::move(stores)),
+        downsample_factors_(downsample_factors),
+        method_(method),
+        max_pending_writes_(max_pending_writes),
+        promise_(std::move(promise)) {
+    for (const auto& store : stores_) {
+      domains_.emplace_back(store.domain().box());
+      grids_.push_back(GetBlockGrid(store));
+    }
+  }
+
+  /// Computes and writes every block of the last level.
+  absl::Status Run() {
+    const size_t level = stores_.size() - 1;
+    return ForEachBlock(level, domains_[level], [&](BoxView<> block) {
+      return ProduceBlock(level, block).status();
+    });
+  }
+
+ private:
+  /// Invokes `func` with the intersection of `region` and each block of the
+  /// grid of `level` that intersects `region`.
+  template <typename Func>
+  absl::Status ForEachBlock(size_t level, BoxView<> region, Func func) {
+    const DimensionIndex rank = region.rank();
+    if (region.is_empty()) return absl::OkStatus();
+    const BlockGrid& grid = grids_[level];
+    std::vector<Index> start(rank), count(rank), position(rank, 0);
+    for (DimensionIndex i = 0; i < rank; ++i) {
+      if (grid.shape[i] == 0) {
+        start[i] = 0;
+        count[i] = 1;
+        continue;
+      }
+      start[i] = FloorOfRatio(region.origin()[i] - grid.origin[i],
+                              grid.shape[i]);
+      count[i] = FloorOfRatio(region[i].inclusive_max() - grid.origin[i],
+                              grid.shape[i]) -
+                 start[i] + 1;
+    }
+    Box<> block(rank);
+    do {
+      for (DimensionIndex i = 0; i < rank; ++i) {
+        if (grid.shape[i] == 0) {
+          block[i] = region[i];
+          continue;
+        }
+        const Index block_start =
+            grid.origin[i] + (start[i] + position[i]) * grid.shape[i];
+        block[i] = Intersect(
+            IndexInterval::UncheckedSized(block_start, grid.shape[i]),
+            region[i]);
+      }
+      TENSORSTORE_RETURN_IF_ERROR(func(BoxView<>(block)));
+    } while (internal::AdvanceIndices(rank, position.data(), count.data()));
+    return absl::OkStatus();
+  }
+
+  /// Returns the data of `level` within `block`, and, for levels other than
+  /// the source, writes it.
+  ///
+  /// \pre `block` is contained within the domain of `level`.
+  Result<SharedOffsetArray<void>> ProduceBlock(size_t level,
+                                               BoxView<> block) {
+    if (level == 0) {
+      return tensorstore::Read(stores_[0] |
+                               tensorstore::AllDims().BoxSlice(block))
+          .result();
+    }
+    const DimensionIndex rank = block.rank();
+    const auto& factors = downsample_factors_[level - 1];
+    const BoxView<> input_domain = domains_[level - 1];
+    Box<> input_block(rank);
+    for (DimensionIndex i = 0; i < rank; ++i) {
+      input_block[i] = Intersect(
+          IndexInterval::UncheckedHalfOpen(
+              block.origin()[i] * factors[i],
+              (block.origin()[i] + block.shape()[i]) * factors[i]),
+          input_domain[i]);
+    }
+
+    SharedOffsetArray<void> input;
+    if (level == 1) {
+      // The source is read directly in units of the blocks of the first level.
+      TENSORSTORE_ASSIGN_OR_RETURN(input, ProduceBlock(0, input_block));
+    } else {
+      TENSORSTORE_RETURN_IF_ERROR(ForEachBlock(
+          level - 1, input_block, [&](BoxView<> sub_block) -> absl::Status {
+            TENSORSTORE_ASSIGN_OR_RETURN(auto sub_array,
+                                         ProduceBlock(level - 1, sub_block));
+            if (sub_block == input_block) {
+              input = std::move(sub_array);
+              return absl::OkStatus();
+            }
+            if (!input.valid()) {
+              input = AllocateArray(input_block, c_order, default_init,
+                                    sub_array.dtype());
+            }
+            return CopyTransformedArray(
+                sub_array, input | tensorstore::AllDims().BoxSlice(sub_block));
+          }));
+    }
+
+    TENSORSTORE_ASSIGN_OR_RETURN(auto output,
+                                 DownsampleArray(input, factors, method_));
+    input = {};
+    auto write_futures = tensorstore::Write(
+        output, stores_[level] | tensorstore::AllDims().BoxSlice(block));
+    LinkError(promise_, write_futures.commit_future);
+    pending_writes_.push_back(std::move(write_futures.commit_future));
+    TENSORSTORE_RETURN_IF_ERROR(WaitForPendingWrites(max_pending_writes_));
+    return output;
+  }
+
+  /// Waits for the oldest pending writes until at most `limit` remain.
+  absl::Status WaitForPendingWrites(size_t limit) {
+    while (pending_writes_.size() > limit) {
+      auto future = std::move(pending_writes_.front());
+      pending_writes_.pop_front();
+      TENSORSTORE_RETURN_IF_ERROR(future.status());
+    }
+    return absl::OkStatus();
+  }
+
+  /// The source followed by each level.
+  std::vector<TensorStore<>> stores_;
+  std::vector<Box<>> domains_;
+  std::vector<BlockGrid> grids_;
+  span<const std::vector<Index>> downsample_factors_;
+  DownsampleMethod method_;
+  size_t max_pending_writes_;
+  /// Commit futures of the block writes in flight, oldest first.
+  std::deque<Future<const void>> pending_writes_;
+  Promise<void> promise_;
+};
+
+}  // namespace
+
+absl::Status WriteDownsamplePyramid(
+    TensorStore<> source, span<const TensorStore<>> levels,
+    span<const std::vector<Index>> downsample_factors,
+    DownsampleMethod method, size_t max_pending_writes) {
+  if (max_pending_writes == 0) {
+    return absl::InvalidArgumentError(
+        "Maximum number of pending writes must be positive");
+  }
+  if (levels.size() != downsample_factors.size()) {
+    return absl::InvalidArgumentError(tensorstore::StrCat(
+        "Number of levels (", levels.size(),
+        ") does not match number of downsample factor vectors (",
+        downsample_factors.size(), ")"));
+  }
+  if (levels.empty()) return absl::OkStatus();
+  const DimensionIndex rank = source.rank();
+  if (!IsFinite(source.domain().box())) {
+    return absl::InvalidArgumentError(tensorstore::StrCat(
+        "Source domain must be finite: ", source.domain()));
+  }
+  std::vector<TensorStore<>> stores;
+  stores.reserve(levels.size() + 1);
+  stores.push_back(std::move(source));
+  Box<> expected_domain(rank);
+  for (size_t level = 0; level < levels.size(); ++level) {
+    const auto& store = levels[level];
+    const auto& factors = downsample_factors[level];
+    if (store.rank() != rank ||
+        factors.size() != static_cast<size_t>(rank)) {
+      return absl::InvalidArgumentError(tensorstore::StrCat(
+          "Level ", level, " has rank ", store.rank(), " and ", factors.size(),
+          " downsample factors, but source has rank ", rank));
+    }
+    for (const Index factor : factors) {
+      if (factor <= 0) {
+        return absl::InvalidArgumentError(tensorstore::StrCat(
+            "Invalid downsample factors for level ", level, ": ",
+            span<const Index>(factors)));
+      }
+    }
+    if (store.dtype() != stores[0].dtype()) {
+      return absl::InvalidArgumentError(tensorstore::StrCat(
+          "Level ", level, " has data type ", store.dtype(),
+          " but source has data type ", stores[0].dtype()));
+    }
+    DownsampleBounds(stores.back().domain().box(), expected_domain, factors,
+                     method);
+    if (store.domain().box() != expected_domain) {
+      return absl::InvalidArgumentError(tensorstore::StrCat(
+          "Level ", level, " has bounds ", store.domain().box(),
+          " but expected downsampled bounds ", expected_domain));
+    }
+    stores.push_back(store);
+  }
+
+  auto [promise, future] = PromiseFuturePair<void>::Make(absl::OkStatus());
+  absl::Status status;
+  {
+    // The writer holds the only reference to `promise`, which is released
+    // when it is destroyed such that `future` becomes ready once all pending
+    // writes have completed.
+    PyramidWriter writer(std::move(stores), downsample_factors, method,
+                         max_pending_writes, std::move(promise));
+    status = writer.Run();
+  }
+  future.Wait();
+  TENSORSTORE_RETURN_IF_ERROR(status);
+  return future.status();
+}
+
+}  // namespace internal_downsample
+}  // namespace tensorstore
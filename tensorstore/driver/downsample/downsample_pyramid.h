@@ -0,0 +1,73 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_DRIVER_DOWNSAMPLE_DOWNSAMPLE_PYRAMID_H_
+#define TENSORSTORE_DRIVER_DOWNSAMPLE_DOWNSAMPLE_PYRAMID_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "absl/status/status.h"
+#include "tensorstore/downsample_method.h"
+#include "tensorstore/index.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal_downsample {
+
+/// Default bound on the number of block writes that `WriteDownsamplePyramid`
+/// leaves in flight.
+constexpr size_t kDefaultMaxPendingWrites = 16;
+
+/// Writes a multi-resolution pyramid of `source` in a single pass.
+///
+/// `levels[i]` receives the result of downsampling the preceding level
+/// (`source` for `i == 0`) by `downsample_factors[i]`, i.e. the same data as
+/// writing `Downsample(levels[i - 1], downsample_factors[i], method)` to
+/// `levels[i]` for each level in turn.  However, `source` is read only once and
+/// the intermediate levels are never read back: the last (coarsest) level is
+/// traversed in units of its write chunks, each of which is computed from the
+/// corresponding region of the preceding level, which is in turn assembled
+/// from blocks computed recursively in units of that level's write chunks.
+/// Each block is written as soon as it has been computed, and only a single
+/// block per level is held in memory at a time (in addition to pending
+/// writes).  Once `max_pending_writes` block writes are in flight, the oldest
+/// is waited for before the next block is computed, which bounds the memory
+/// held by pending writes when the levels are slower to write than the source
+/// is to read.
+///
+/// \param source Base resolution data, must support reading and have a finite
+///     domain.
+/// \param levels Target levels in order of decreasing resolution, must support
+///     writing.  The domain of each level must equal the downsampled domain of
+///     the preceding level.
+/// \param downsample_factors Downsample factors of each level relative to the
+///     preceding level.  Must have the same length as `levels`.
+/// \param method The downsampling method.
+/// \param max_pending_writes Maximum number of block writes in flight, must
+///     be positive.
+/// \error `absl::StatusCode::kInvalidArgument` if `levels` and
+///     `downsample_factors` are incompatible with `source` and each other.
+absl::Status WriteDownsamplePyramid(
+    TensorStore<> source, span<const TensorStore<>> levels,
+    span<const std::vector<Index>> downsample_factors,
+    DownsampleMethod method,
+    size_t max_pending_writes = kDefaultMaxPendingWrites);
+
+}  // namespace internal_downsample
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_DRIVER_DOWNSAMPLE_DOWNSAMPLE_PYRAMID_H_
@@ -0,0 +1,180 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/driver/downsample/downsample_pyramid.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/array.h"
+#include "tensorstore/context.h"
+#include "tensorstore/downsample.h"
+#include "tensorstore/downsample_method.h"
+#include "tensorstore/driver/array/array.h"
+#include "tensorstore/index.h"
+#include "tensorstore/open.h"
+#include "tensorstore/open_mode.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::Context;
+using ::tensorstore::DownsampleMethod;
+using ::tensorstore::Index;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::TensorStore;
+using ::tensorstore::internal_downsample::WriteDownsamplePyramid;
+
+::nlohmann::json LevelSpec(std::string path, std::vector<Index> shape) {
+  return {{"driver", "n5"},
+          {"kvstore", {{"driver", "memory"}, {"path", path}}},
+          {"metadata",
+           {{"dataType", "uint8"},
+            {"dimensions", shape},
+            {"blockSize", {3, 2}},
+            {"compression", {{"type", "raw"}}}}}};
+}
+
+TensorStore<> MakeSource(Context context) {
+  auto array = tensorstore::AllocateArray<uint8_t>({7, 10});
+  for (Index i = 0; i < 7; ++i) {
+    for (Index j = 0; j < 10; ++j) {
+      array(i, j) = static_cast<uint8_t>((i * 37 + j * 11) % 256);
+    }
+  }
+  auto store = tensorstore::Open(LevelSpec("source/", {7, 10}), context,
+                                 tensorstore::OpenMode::create)
+                   .value();
+  TENSORSTORE_CHECK_OK(tensorstore::Write(array, store).commit_future.result());
+  return store;
+}
+
+class DownsamplePyramidTest
+    : public ::testing::TestWithParam<DownsampleMethod> {};
+
+INSTANTIATE_TEST_SUITE_P(Methods, DownsamplePyramidTest,
+                         ::testing::Values(DownsampleMethod::kMean,
+                                           DownsampleMethod::kStride,
+                                           DownsampleMethod::kMax));
+
+TEST_P(DownsamplePyramidTest, MatchesDownsampleDriver) {
+  const DownsampleMethod method = GetParam();
+  auto context = Context::Default();
+  auto source = MakeSource(context);
+  const std::vector<std::vector<Index>> factors{{2, 2}, {2, 1}, {1, 3}};
+  std::vector<TensorStore<>> levels;
+  std::vector<tensorstore::SharedOffsetArray<void>> expected;
+  TensorStore<> prev = source;
+  for (size_t i = 0; i < factors.size(); ++i) {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto downsampled, tensorstore::Downsample(prev, factors[i], method));
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto expected_array,
+                                     tensorstore::Read(downsampled).result());
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto level,
+        tensorstore::Open(
+            LevelSpec(absl::StrCat("level", i, "/"),
+                      std::vector<Index>(expected_array.shape().begin(),
+                                         expected_array.shape().end())),
+            context, tensorstore::OpenMode::create)
+            .result());
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto expected_store, tensorstore::FromArray(expected_array));
+    expected.push_back(expected_array);
+    levels.push_back(level);
+    prev = expected_store;
+  }
+
+  TENSORSTORE_ASSERT_OK(
+      WriteDownsamplePyramid(source, levels, factors, method));
+  for (size_t i = 0; i < levels.size(); ++i) {
+    EXPECT_THAT(tensorstore::Read(levels[i]).result(),
+                ::testing::Optional(expected[i]))
+        << "level=" << i;
+  }
+}
+
+TEST(DownsamplePyramidWriteTest, SinglePendingWrite) {
+  auto context = Context::Default();
+  auto source = MakeSource(context);
+  const std::vector<std::vector<Index>> factors{{2, 2}, {2, 1}};
+  std::vector<TensorStore<>> levels;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto level0, tensorstore::Open(LevelSpec("level0/", {4, 5}), context,
+                                     tensorstore::OpenMode::create)
+                       .result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto level1, tensorstore::Open(LevelSpec("level1/", {2, 5}), context,
+                                     tensorstore::OpenMode::create)
+                       .result());
+  levels.push_back(level0);
+  levels.push_back(level1);
+  TENSORSTORE_ASSERT_OK(WriteDownsamplePyramid(source, levels, factors,
+                                               DownsampleMethod::kMean,
+                                               /*max_pending_writes=*/1));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto expected0,
+      tensorstore::Downsample(source, factors[0], DownsampleMethod::kMean));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto expected1,
+      tensorstore::Downsample(expected0, factors[1], DownsampleMethod::kMean));
+  EXPECT_EQ(tensorstore::Read(expected0).value(),
+            tensorstore::Read(level0).value());
+  EXPECT_EQ(tensorstore::Read(expected1).value(),
+            tensorstore::Read(level1).value());
+}
+
+TEST(DownsamplePyramidErrorTest, ZeroPendingWrites) {
+  auto context = Context::Default();
+  auto source = MakeSource(context);
+  EXPECT_THAT(WriteDownsamplePyramid(source, {}, {}, DownsampleMethod::kMean,
+                                     /*max_pending_writes=*/0),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            "Maximum number of pending writes .*"));
+}
+
+TEST(DownsamplePyramidErrorTest, BoundsMismatch) {
+  auto context = Context::Default();
+  auto source = MakeSource(context);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto level, tensorstore::Open(LevelSpec("level0/", {4, 4}), context,
+                                    tensorstore::OpenMode::create)
+                      .result());
+  const std::vector<std::vector<Index>> factors{{2, 2}};
+  EXPECT_THAT(WriteDownsamplePyramid(source, {&level, 1}, factors,
+                                     DownsampleMethod::kMean),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            "Level 0 has bounds .*"));
+}
+
+TEST(DownsamplePyramidErrorTest, FactorCountMismatch) {
+  auto context = Context::Default();
+  auto source = MakeSource(context);
+  const std::vector<std::vector<Index>> factors{{2, 2}};
+  EXPECT_THAT(
+      WriteDownsamplePyramid(source, {}, factors, DownsampleMethod::kMean),
+      MatchesStatus(absl::StatusCode::kInvalidArgument,
+                    "Number of levels .*"));
+}
+
+}  // namespace
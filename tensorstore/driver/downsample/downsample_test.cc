@@ -153,6 +153,61 @@ TEST(DownsampleTest, Rank1MeanChunked) {
               Optional(MakeArray<uint8_t>({1, 6, 3, 5, 2, 5})));
 }
 
+TEST(DownsampleTest, OutputCache) {
+  ::nlohmann::json base_spec{{"driver", "n5"},
+                             {"kvstore", {{"driver", "memory"}}},
+                             {"metadata",
+                              {{"dataType", "uint8"},
+                               {"dimensions", {11}},
+                               {"blockSize", {3}},
+                               {"compression", {{"type", "raw"}}}}}};
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto base_store,
+      tensorstore::Open(base_spec, context, tensorstore::OpenMode::create)
+          .result());
+  TENSORSTORE_ASSERT_OK(tensorstore::Write(
+      MakeArray<uint8_t>({0, 2, 3, 9, 1, 5, 7, 3, 4, 0, 5}), base_store));
+  ::nlohmann::json downsampled_spec{{"driver", "downsample"},
+                                    {"base", base_spec},
+                                    {"downsample_factors", {2}},
+                                    {"downsample_method", "mean"}};
+  auto cached_spec = downsampled_spec;
+  cached_spec["output_cache"] = {{"total_bytes_limit", 1000000}};
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto cached_store, tensorstore::Open(cached_spec, context).result());
+  EXPECT_THAT(tensorstore::Read(cached_store).result(),
+              Optional(MakeArray<uint8_t>({1, 6, 3, 5, 2, 5})));
+  EXPECT_THAT(tensorstore::Read(cached_store |
+                                tensorstore::Dims(0).SizedInterval(1, 3))
+                  .result(),
+              Optional(MakeOffsetArray<uint8_t>({1}, {6, 3, 5})));
+
+  TENSORSTORE_ASSERT_OK(tensorstore::Write(
+      MakeArray<uint8_t>({2, 2, 3, 3, 3, 3, 3, 3, 3, 3, 3}), base_store));
+
+  // The cached cells are not recomputed.
+  EXPECT_THAT(tensorstore::Read(cached_store).result(),
+              Optional(MakeArray<uint8_t>({1, 6, 3, 5, 2, 5})));
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto uncached_store,
+      tensorstore::Open(downsampled_spec, context).result());
+  EXPECT_THAT(tensorstore::Read(uncached_store).result(),
+              Optional(MakeArray<uint8_t>({2, 3, 3, 3, 3, 3})));
+
+  cached_spec["output_cache"]["max_age"] = "1ms";
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto expiring_store, tensorstore::Open(cached_spec, context).result());
+  EXPECT_THAT(tensorstore::Read(expiring_store).result(),
+              Optional(MakeArray<uint8_t>({2, 3, 3, 3, 3, 3})));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto spec, expiring_store.spec());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto spec_json, spec.ToJson());
+  EXPECT_THAT(spec_json["output_cache"],
+              MatchesJson({{"total_bytes_limit", 1000000},
+                           {"max_age", "1ms"}}));
+}
+
 TEST(DownsampleTest, Rank1MeanChunkedTranslated) {
   ::nlohmann::json base_spec{{"driver", "n5"},
                              {"kvstore", {{"driver", "memory"}}},
@@ -19,6 +19,7 @@
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
@@ -39,6 +40,7 @@
 #include "tensorstore/internal/json_binding/bindable.h"
 #include "tensorstore/internal/tagged_ptr.h"
 #include "tensorstore/internal/tracing/operation_trace_span.h"
+#include "tensorstore/internal/tracing/trace_context.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/open_mode.h"
 #include "tensorstore/open_options.h"
@@ -94,6 +96,11 @@ Future<Driver::Handle> OpenDriver(TransformedDriverSpec bound_spec,
   DriverSpecPtr ptr = bound_spec.driver_spec;
   auto open_span = std::make_unique<internal_tracing::OperationTraceSpan>(
       "tensorstore.Open");
+  Future<Driver::Handle> open_future;
+  {
+    internal_tracing::ScopedTraceContext trace_scope(open_span->context());
+    open_future = ptr->Open(std::move(request));
+  }
   return MapFuture(
       InlineExecutor{},
       [bound_spec = std::move(bound_spec), open_span = std::move(open_span)](
@@ -128,13 +135,14 @@ Future<Driver::Handle> OpenDriver(TransformedDriverSpec bound_spec,
                     /*error_handler=*/
                     ::nlohmann::json::error_handler_t::ignore)));
           }
+          open_span->SetStatus(status);
           return status;
         }
 
         // Move handle out of the `Future`.
         return std::move(handle);
       },
-      ptr->Open(std::move(request)));
+      std::move(open_future));
 }
 
 Driver::~Driver() = default;
@@ -169,6 +177,17 @@ Future<ArrayStorageStatistics> GetStorageStatistics(
   return handle.driver->GetStorageStatistics(std::move(request));
 }
 
+Future<std::vector<IndexTransform<>>> GetChunksInValueRange(
+    const DriverHandle& handle, ValueRange range) {
+  Driver::GetChunksInValueRangeRequest request;
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      request.transaction,
+      internal::AcquireOpenTransactionPtrOrError(handle.transaction));
+  request.transform = handle.transform;
+  request.range = range;
+  return handle.driver->GetChunksInValueRange(std::move(request));
+}
+
 Result<SharedArray<const void>> Driver::GetFillValue(
     IndexTransformView<> transform) {
   return {std::in_place};
@@ -203,6 +222,11 @@ Future<ArrayStorageStatistics> Driver::GetStorageStatistics(
   return absl::UnimplementedError("Storage statistics not supported");
 }
 
+Future<std::vector<IndexTransform<>>> Driver::GetChunksInValueRange(
+    GetChunksInValueRangeRequest request) {
+  return absl::UnimplementedError("Chunk summaries not supported");
+}
+
 Result<ChunkLayout> GetChunkLayout(const Driver::Handle& handle) {
   assert(handle.driver);
   return handle.driver->GetChunkLayout(handle.transform);
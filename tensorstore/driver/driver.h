@@ -41,6 +41,7 @@
 /// `kvstore::DriverPtr`, respectively.
 
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "tensorstore/array.h"
@@ -57,6 +58,7 @@
 #include "tensorstore/index.h"
 #include "tensorstore/index_space/dimension_units.h"
 #include "tensorstore/index_space/index_transform.h"
+#include "tensorstore/internal/cache/chunk_summary.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/tagged_ptr.h"
 #include "tensorstore/kvstore/kvstore.h"
@@ -271,6 +273,24 @@ class Driver : public AtomicReferenceCount<Driver> {
   virtual Future<ArrayStorageStatistics> GetStorageStatistics(
       GetStorageStatisticsRequest request);
 
+  struct GetChunksInValueRangeRequest {
+    OpenTransactionPtr transaction;
+    IndexTransform<> transform;
+    ValueRange range;
+  };
+
+  /// Returns the portions of the output range of `transform` that may contain
+  /// a value in `request.range`, as determined from per-chunk summaries of the
+  /// stored values.
+  ///
+  /// Each returned transform maps a sub-region of the input domain of
+  /// `request.transform` (corresponding to a single chunk) to that input
+  /// domain.  Regions whose chunk has no summary are always returned.
+  ///
+  /// Default implementation fails with `kUnimplemented`.
+  virtual Future<std::vector<IndexTransform<>>> GetChunksInValueRange(
+      GetChunksInValueRangeRequest request);
+
   virtual ~Driver();
 };
 
@@ -317,6 +337,9 @@ Result<DriverHandle> GetBase(const DriverHandle& handle);
 Future<ArrayStorageStatistics> GetStorageStatistics(
     const DriverHandle& handle, GetArrayStorageStatisticsOptions options);
 
+Future<std::vector<IndexTransform<>>> GetChunksInValueRange(
+    const DriverHandle& handle, ValueRange range);
+
 Result<TransformedDriverSpec> GetTransformedDriverSpec(
     const DriverHandle& handle, SpecRequestOptions&& options);
 
@@ -249,6 +249,10 @@ class ImageCache : public internal::KvsBackedCache<ImageCache<Specialization>,
     using DecodeReceiver = typename Base::Entry::DecodeReceiver;
     using EncodeReceiver = typename Base::Entry::EncodeReceiver;
 
+    size_t ComputeReadDataSizeInBytes(const void* read_data) override {
+      return static_cast<const ReadData*>(read_data)->num_elements();
+    }
+
     void DoDecode(std::optional<absl::Cord> value,
                   DecodeReceiver receiver) override {
       if (!value) {
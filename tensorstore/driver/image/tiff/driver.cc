@@ -51,10 +51,10 @@ namespace jb = tensorstore::internal_json_binding;
 
 // NOTE: There are quite a few improvements to be made to the tiff driver,
 // such as:
-// * The driver should allow reading "all" image pages, and
-//   perhaps even listing them. This would require that they
-//   all have the same dimensions and data types.
 // * The driver should expose more than just uint8.
+//
+// All pages of a multi-page file may be read using the "tiff_stack" driver
+// (see stack_driver.cc).
 
 struct TiffReadOptions {
   // The TIFF directory to read.
@@ -0,0 +1,691 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+///
+/// The "tiff_stack" driver exposes every page of a multi-page TIFF file as a
+/// single uint8 array indexed by (page, y, x, channel).
+///
+/// On open, only the image file directories (IFDs) are read, to determine the
+/// byte range occupied by each page.  The resulting page directory is shared by
+/// all opens of the same file generation.  Each page is a separate chunk, which
+/// is read with a single byte-range request and decoded independently, so
+/// reading an arbitrary subset of pages does not require reading the entire
+/// file.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "riegeli/bytes/cord_reader.h"
+#include "tensorstore/array.h"
+#include "tensorstore/box.h"
+#include "tensorstore/chunk_layout.h"
+#include "tensorstore/context.h"
+#include "tensorstore/contiguous_layout.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/driver/chunk_cache_driver.h"
+#include "tensorstore/driver/driver.h"
+#include "tensorstore/driver/driver_handle.h"
+#include "tensorstore/driver/driver_spec.h"
+#include "tensorstore/driver/image/tiff/tiff_directory.h"
+#include "tensorstore/driver/registry.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_space/index_domain.h"
+#include "tensorstore/index_space/index_domain_builder.h"
+#include "tensorstore/index_space/index_transform.h"
+#include "tensorstore/internal/async_write_array.h"
+#include "tensorstore/internal/cache/async_cache.h"
+#include "tensorstore/internal/cache/cache.h"
+#include "tensorstore/internal/cache/cache_pool_resource.h"
+#include "tensorstore/internal/cache/chunk_cache.h"
+#include "tensorstore/internal/cache_key/cache_key.h"
+#include "tensorstore/internal/chunk_grid_specification.h"
+#include "tensorstore/internal/data_copy_concurrency_resource.h"
+#include "tensorstore/internal/image/image_info.h"
+#include "tensorstore/internal/image/tiff_reader.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/internal/json_binding/staleness_bound.h"  // IWYU pragma: keep
+#include "tensorstore/internal/memory.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/driver.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/open_mode.h"
+#include "tensorstore/open_options.h"
+#include "tensorstore/rank.h"
+#include "tensorstore/schema.h"
+#include "tensorstore/serialization/absl_time.h"  // IWYU pragma: keep
+#include "tensorstore/staleness_bound.h"
+#include "tensorstore/transaction.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/garbage_collection/fwd.h"  // IWYU pragma: keep
+#include "tensorstore/util/quote_string.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace internal_image_driver {
+namespace {
+
+namespace jb = tensorstore::internal_json_binding;
+
+using ::tensorstore::internal_image::ImageInfo;
+using ::tensorstore::internal_image::TiffReader;
+
+constexpr DimensionIndex kRank = 4;
+
+/// Size of the initial read, which includes the header and, for small files or
+/// files which store their directories at the start, often every IFD.
+constexpr int64_t kInitialReadSize = 64 * 1024;
+
+/// Minimum size of each subsequent read of an IFD.
+constexpr int64_t kIfdReadSize = 4 * 1024;
+
+/// Pages of a TIFF file, all of which have the same shape.
+struct TiffStackDirectory {
+  TiffHeader header;
+  std::vector<TiffPage> pages;
+
+  /// Generation of the file from which the directory was read.
+  TimestampedStorageGeneration stamp;
+};
+
+class TiffStackCache : public internal::ConcreteChunkCache {
+  using Base = internal::ConcreteChunkCache;
+
+ public:
+  using Base::Base;
+
+  class Entry : public internal::ChunkCache::Entry {
+   public:
+    using OwningCache = TiffStackCache;
+    using internal::ChunkCache::Entry::Entry;
+    void DoRead(AsyncCacheReadRequest request) override;
+  };
+
+  class TransactionNode : public internal::ChunkCache::TransactionNode {
+   public:
+    using OwningCache = TiffStackCache;
+    using internal::ChunkCache::TransactionNode::TransactionNode;
+    void DoRead(AsyncCacheReadRequest request) override {
+      ReadError(absl::UnimplementedError(
+          "\"tiff_stack\" driver does not support transactions"));
+    }
+  };
+
+  Entry* DoAllocateEntry() final { return new Entry; }
+  size_t DoGetSizeofEntry() final { return sizeof(Entry); }
+  TransactionNode* DoAllocateTransactionNode(
+      internal::AsyncCache::Entry& entry) final {
+    return new TransactionNode(static_cast<Entry&>(entry));
+  }
+
+  kvstore::DriverPtr kvstore_driver_;
+  std::string key_;
+  std::shared_ptr<const TiffStackDirectory> directory_;
+  Context::Resource<internal::DataCopyConcurrencyResource>
+      data_copy_concurrency_;
+  Context::Resource<internal::CachePoolResource> cache_pool_;
+};
+
+/// Decodes a single page, given the file data within the page extent starting
+/// at `window_offset`.
+Result<SharedArray<const void>> DecodeTiffPage(const TiffHeader& header,
+                                               const TiffPage& page,
+                                               absl::Cord window,
+                                               uint64_t window_offset,
+                                               span<const Index> chunk_shape) {
+  // Prepend a header referencing the page, so that libtiff reads it as the
+  // first directory.
+  TiffHeader page_header = header;
+  page_header.first_ifd_offset = page.ifd_offset;
+  absl::Cord data(EncodeTiffHeader(page_header));
+  data.Append(std::move(window));
+
+  auto array = AllocateArray<uint8_t>(chunk_shape, c_order, default_init);
+  auto status = [&]() -> absl::Status {
+    riegeli::CordReader<> buffer_reader(&data);
+    TiffReader reader;
+    TENSORSTORE_RETURN_IF_ERROR(
+        reader.Initialize(&buffer_reader, page_header.size(), window_offset));
+    ImageInfo info = reader.GetImageInfo();
+    if (info.dtype != dtype_v<uint8_t> || info.height != chunk_shape[1] ||
+        info.width != chunk_shape[2] || info.num_components != chunk_shape[3]) {
+      return absl::DataLossError(tensorstore::StrCat(
+          "TIFF page at offset ", page.ifd_offset,
+          " does not match the page directory"));
+    }
+    return reader.Decode(tensorstore::span(
+        reinterpret_cast<unsigned char*>(array.data()), array.num_elements()));
+  }();
+  if (!status.ok()) {
+    if (status.code() == absl::StatusCode::kInvalidArgument) {
+      return internal::MaybeConvertStatusTo(std::move(status),
+                                            absl::StatusCode::kDataLoss);
+    }
+    return status;
+  }
+  return array;
+}
+
+void TiffStackCache::Entry::DoRead(AsyncCacheReadRequest request) {
+  auto& cache = GetOwningCache(*this);
+  const auto& directory = *cache.directory_;
+  const auto& page = directory.pages[cell_indices()[0]];
+
+  kvstore::ReadOptions options;
+  options.staleness_bound = request.staleness_bound;
+  options.batch = request.batch;
+  options.generation_conditions.if_equal = directory.stamp.generation;
+  {
+    ReadLock<ReadData> lock{*this};
+    options.generation_conditions.if_not_equal = lock.stamp().generation;
+  }
+  // The header is supplied separately when decoding.
+  const uint64_t window_offset = std::max<uint64_t>(
+      page.extent.inclusive_min, directory.header.size());
+  options.byte_range = OptionalByteRangeRequest::Range(
+      window_offset, page.extent.exclusive_max);
+
+  auto future = cache.kvstore_driver_->Read(cache.key_, std::move(options));
+  future.Force();
+  future.ExecuteWhenReady([this, window_offset](
+                              ReadyFuture<kvstore::ReadResult> ready) {
+    auto& r = ready.result();
+    if (!r.ok()) {
+      ReadError(internal::ConvertInvalidArgumentToFailedPrecondition(
+          r.status()));
+      return;
+    }
+    auto& cache = GetOwningCache(*this);
+    if (r->aborted() &&
+        r->stamp.generation == cache.directory_->stamp.generation) {
+      // Unchanged since the existing data was read.
+      ReadState read_state;
+      {
+        ReadLock<ReadData> lock{*this};
+        read_state = lock.read_state();
+      }
+      read_state.stamp = std::move(r->stamp);
+      ReadSuccess(std::move(read_state));
+      return;
+    }
+    if (!r->has_value()) {
+      ReadError(absl::FailedPreconditionError(tensorstore::StrCat(
+          "TIFF file ", tensorstore::QuoteString(cache.key_),
+          " changed after its page directory was read")));
+      return;
+    }
+    cache.executor()([this, window_offset,
+                      ready = std::move(ready)]() mutable {
+      auto& cache = GetOwningCache(*this);
+      const auto& directory = *cache.directory_;
+      auto& read_result = ready.value();
+      auto array = DecodeTiffPage(
+          directory.header, directory.pages[cell_indices()[0]],
+          std::move(read_result.value), window_offset,
+          cache.grid().components[0].shape());
+      if (!array.ok()) {
+        ReadError(std::move(array).status());
+        return;
+      }
+      auto read_data =
+          tensorstore::internal::make_shared_for_overwrite<ReadData[]>(1);
+      read_data.get()[0] = *std::move(array);
+      ReadSuccess({std::move(read_data), std::move(read_result.stamp)});
+    });
+  });
+}
+
+class TiffStackDriverSpec
+    : public internal::RegisteredDriverSpec<TiffStackDriverSpec,
+                                            /*Parent=*/internal::DriverSpec> {
+ public:
+  constexpr static char id[] = "tiff_stack";
+
+  kvstore::Spec store;
+  Context::Resource<internal::DataCopyConcurrencyResource>
+      data_copy_concurrency;
+  Context::Resource<internal::CachePoolResource> cache_pool;
+  StalenessBound data_staleness;
+
+  constexpr static auto ApplyMembers = [](auto& x, auto f) {
+    return f(internal::BaseCast<internal::DriverSpec>(x), x.store,
+             x.data_copy_concurrency, x.cache_pool, x.data_staleness);
+  };
+
+  static absl::Status ValidateSchema(Schema& schema) {
+    TENSORSTORE_RETURN_IF_ERROR(schema.Set(dtype_v<uint8_t>));
+    TENSORSTORE_RETURN_IF_ERROR(schema.Set(RankConstraint{kRank}));
+    if (schema.codec().valid()) {
+      return absl::InvalidArgumentError(
+          tensorstore::StrCat("codec not supported by \"", id, "\" driver"));
+    }
+    if (schema.fill_value().valid()) {
+      return absl::InvalidArgumentError(tensorstore::StrCat(
+          "fill_value not supported by \"", id, "\" driver"));
+    }
+    if (schema.dimension_units().valid()) {
+      return absl::InvalidArgumentError(tensorstore::StrCat(
+          "dimension_units not supported by \"", id, "\" driver"));
+    }
+    if (auto domain = schema.domain(); domain.valid()) {
+      if (!std::all_of(domain.origin().begin(), domain.origin().end(),
+                       [](auto x) { return x == 0; })) {
+        return absl::InvalidArgumentError("image domain must have 0-origin");
+      }
+    } else {
+      TENSORSTORE_RETURN_IF_ERROR(schema.Set(
+          IndexDomainBuilder<kRank>().origin({0, 0, 0, 0}).Finalize().value()));
+    }
+    return absl::OkStatus();
+  }
+
+  constexpr static auto default_json_binder = jb::Sequence(
+      jb::Initialize([](auto* obj) -> absl::Status {
+        return ValidateSchema(obj->schema);
+      }),
+      jb::Member(internal::DataCopyConcurrencyResource::id,
+                 jb::Projection<&TiffStackDriverSpec::data_copy_concurrency>()),
+      jb::Member(internal::CachePoolResource::id,
+                 jb::Projection<&TiffStackDriverSpec::cache_pool>()),
+      jb::Projection<&TiffStackDriverSpec::store>(
+          jb::KvStoreSpecAndPathJsonBinder),
+      jb::Member("recheck_cached_data",
+                 jb::Projection<&TiffStackDriverSpec::data_staleness>(
+                     jb::DefaultValue([](auto* obj) {
+                       obj->bounded_by_open_time = true;
+                     }))));
+
+  absl::Status ApplyOptions(SpecOptions&& options) override {
+    // The page directory and the data are both read from the same file, so
+    // set the staleness bound to the maximum of requested data and metadata
+    // staleness.
+    if (options.recheck_cached_data.specified()) {
+      data_staleness = StalenessBound(options.recheck_cached_data);
+    }
+    if (options.recheck_cached_metadata.specified()) {
+      StalenessBound bound(options.recheck_cached_metadata);
+      if (!options.recheck_cached_data.specified() ||
+          bound.time > data_staleness.time) {
+        data_staleness = std::move(bound);
+      }
+    }
+    if (options.kvstore.valid()) {
+      if (store.valid()) {
+        return absl::InvalidArgumentError("\"kvstore\" is already specified");
+      }
+      store = std::move(options.kvstore);
+    }
+    return ValidateSchema(options);
+  }
+
+  kvstore::Spec GetKvstore() const override { return store; }
+
+  OpenMode open_mode() const override { return OpenMode::open; }
+
+  Future<internal::Driver::Handle> Open(
+      internal::DriverOpenRequest request) const override;
+};
+
+class TiffStackDriver;
+using TiffStackDriverBase = internal::RegisteredDriver<
+    TiffStackDriver,
+    internal::ChunkGridSpecificationDriver<
+        TiffStackCache, internal::ChunkCacheReadWriteDriverMixin<
+                            TiffStackDriver, internal::Driver>>>;
+
+class TiffStackDriver : public TiffStackDriverBase {
+  using Base = TiffStackDriverBase;
+
+ public:
+  using Base::Base;
+
+  Result<internal::TransformedDriverSpec> GetBoundSpec(
+      internal::OpenTransactionPtr transaction,
+      IndexTransformView<> transform) override {
+    auto driver_spec = internal::DriverSpec::Make<TiffStackDriverSpec>();
+    driver_spec->context_binding_state_ = ContextBindingState::bound;
+    auto& cache = *this->cache();
+    TENSORSTORE_ASSIGN_OR_RETURN(driver_spec->store.driver,
+                                 cache.kvstore_driver_->GetBoundSpec());
+    driver_spec->store.path = cache.key_;
+    driver_spec->data_copy_concurrency = cache.data_copy_concurrency_;
+    driver_spec->cache_pool = cache.cache_pool_;
+    driver_spec->data_staleness = this->data_staleness_bound();
+    TENSORSTORE_RETURN_IF_ERROR(
+        driver_spec->schema.Set(RankConstraint{kRank}));
+    TENSORSTORE_RETURN_IF_ERROR(driver_spec->schema.Set(dtype_v<uint8_t>));
+    internal::TransformedDriverSpec spec;
+    spec.driver_spec = std::move(driver_spec);
+    spec.transform = std::move(transform);
+    return spec;
+  }
+
+  Result<ChunkLayout> GetChunkLayout(IndexTransformView<> transform) override {
+    return internal::GetChunkLayoutFromGrid(cache()->grid().components[0]) |
+           transform;
+  }
+
+  KvStore GetKvstore(const Transaction& transaction) override {
+    auto& cache = *this->cache();
+    return KvStore(cache.kvstore_driver_, cache.key_, transaction);
+  }
+
+  // Not applicable.
+  bool fill_missing_data_reads() const { return true; }
+
+  bool store_data_equal_to_fill_value() const { return false; }
+
+  StalenessBound missing_data_staleness_bound() const { return {}; }
+};
+
+/// Returns an error if the pages of `directory` cannot be represented as a
+/// single array.
+absl::Status ValidateTiffStackDirectory(const TiffStackDirectory& directory) {
+  if (directory.pages.empty()) {
+    return absl::DataLossError("TIFF file contains no pages");
+  }
+  const auto& first = directory.pages.front();
+  for (size_t i = 0; i < directory.pages.size(); ++i) {
+    const auto& page = directory.pages[i];
+    if (page.bits_per_sample != 8 || page.sample_format != 1) {
+      return absl::UnimplementedError(tensorstore::StrCat(
+          "\"", TiffStackDriverSpec::id,
+          "\" driver only supports uint8 images, but page ", i,
+          " has bits_per_sample=", page.bits_per_sample,
+          ", sample_format=", page.sample_format));
+    }
+    if (page.height != first.height || page.width != first.width ||
+        page.samples_per_pixel != first.samples_per_pixel) {
+      return absl::UnimplementedError(tensorstore::StrCat(
+          "\"", TiffStackDriverSpec::id,
+          "\" driver requires all pages to have the same shape, but page 0 "
+          "has shape {",
+          first.height, ", ", first.width, ", ", first.samples_per_pixel,
+          "} and page ", i, " has shape {", page.height, ", ", page.width,
+          ", ", page.samples_per_pixel, "}"));
+    }
+  }
+  return absl::OkStatus();
+}
+
+/// Creates the chunk cache for `directory`, with one chunk per page.
+std::unique_ptr<TiffStackCache> MakeTiffStackCache(
+    std::shared_ptr<const TiffStackDirectory> directory,
+    const Executor& executor) {
+  const auto& first = directory->pages.front();
+  std::vector<Index> chunk_shape{1, static_cast<Index>(first.height),
+                                 static_cast<Index>(first.width),
+                                 static_cast<Index>(first.samples_per_pixel)};
+  std::vector<Index> shape = chunk_shape;
+  shape[0] = static_cast<Index>(directory->pages.size());
+  // The fill value is never visible, since every page exists, but the chunk
+  // cache requires one.
+  auto fill_value =
+      BroadcastArray(AllocateArray(/*shape=*/span<const Index>{}, c_order,
+                                   value_init, dtype_v<uint8_t>),
+                     BoxView<>(kRank))
+          .value();
+  internal::ChunkGridSpecification::ComponentList components;
+  components.emplace_back(
+      internal::AsyncWriteArray::Spec{std::move(fill_value), Box<>(shape)},
+      std::move(chunk_shape));
+  auto cache = std::make_unique<TiffStackCache>(
+      internal::ChunkGridSpecification(std::move(components)), executor);
+  cache->directory_ = std::move(directory);
+  return cache;
+}
+
+/// State of an open operation, which reads the header and then each IFD in
+/// turn, reusing previously read data where possible.
+struct OpenState : public internal::AtomicReferenceCount<OpenState> {
+  internal::IntrusivePtr<const TiffStackDriverSpec> spec_;
+  Promise<internal::Driver::Handle> promise_;
+  kvstore::DriverPtr kvstore_driver_;
+  StalenessBound data_staleness_;
+  kvstore::ReadOptions options_;
+  std::string cache_key_;
+
+  // Most recently read data, starting at `block_offset_`.
+  absl::Cord block_;
+  uint64_t block_offset_ = 0;
+
+  // Byte range requested by the most recent IFD read.
+  ByteRange last_required_range_{0, 0};
+
+  uint64_t next_ifd_offset_ = 0;
+  absl::flat_hash_set<uint64_t> visited_ifds_;
+  TiffStackDirectory directory_;
+
+  const Executor& executor() const {
+    return spec_->data_copy_concurrency->executor;
+  }
+
+  void StartRead(OptionalByteRangeRequest byte_range) {
+    options_.byte_range = byte_range;
+    auto future =
+        kvstore_driver_->Read(std::string(spec_->store.path), options_);
+    future.Force();
+    future.ExecuteWhenReady(
+        [self = internal::IntrusivePtr<OpenState>(this)](
+            ReadyFuture<kvstore::ReadResult> ready) {
+          self->OnRead(std::move(ready));
+        });
+  }
+
+  void OnRead(ReadyFuture<kvstore::ReadResult> ready) {
+    auto& r = ready.result();
+    if (!r.ok()) {
+      if (absl::IsOutOfRange(r.status()) && !options_.byte_range.IsSuffix() &&
+          !options_.byte_range.IsFull()) {
+        // The file ends before the speculative read; retry, reading to the
+        // end of the file.
+        StartRead(options_.byte_range.inclusive_min == 0
+                      ? OptionalByteRangeRequest{}
+                      : OptionalByteRangeRequest::Suffix(
+                            options_.byte_range.inclusive_min));
+        return;
+      }
+      promise_.SetResult(
+          internal::ConvertInvalidArgumentToFailedPrecondition(r.status()));
+      return;
+    }
+    if (r->not_found()) {
+      promise_.SetResult(absl::NotFoundError(
+          tensorstore::StrCat("TIFF file ",
+                              tensorstore::QuoteString(spec_->store.path),
+                              " not found")));
+      return;
+    }
+    if (!r->has_value()) {
+      promise_.SetResult(absl::FailedPreconditionError(
+          tensorstore::StrCat("TIFF file ",
+                              tensorstore::QuoteString(spec_->store.path),
+                              " changed while reading its page directory")));
+      return;
+    }
+    executor()([self = internal::IntrusivePtr<OpenState>(this),
+                ready = std::move(ready)]() mutable {
+      self->OnBlock(ready.value());
+    });
+  }
+
+  void OnBlock(kvstore::ReadResult& read_result) {
+    block_ = std::move(read_result.value);
+    block_offset_ = options_.byte_range.inclusive_min;
+    if (StorageGeneration::IsUnknown(directory_.stamp.generation)) {
+      // First read, which includes the header.
+      auto header = ParseTiffHeader(block_.Flatten());
+      if (!header.ok()) {
+        promise_.SetResult(std::move(header).status());
+        return;
+      }
+      directory_.header = *header;
+      directory_.stamp = std::move(read_result.stamp);
+      options_.generation_conditions.if_equal = directory_.stamp.generation;
+      next_ifd_offset_ = header->first_ifd_offset;
+
+      internal::EncodeCacheKey(&cache_key_, spec_->store.driver,
+                               spec_->store.path, spec_->data_copy_concurrency,
+                               directory_.stamp.generation.value);
+      // Reuse the page directory if this generation has already been indexed.
+      if (auto cache = internal::GetCache<TiffStackCache>(
+              spec_->cache_pool->get(), cache_key_,
+              [] { return std::unique_ptr<TiffStackCache>(); })) {
+        Finish(std::move(cache));
+        return;
+      }
+    }
+    ReadDirectory();
+  }
+
+  void ReadDirectory() {
+    std::string_view block = block_.Flatten();
+    while (next_ifd_offset_ != 0) {
+      if (!visited_ifds_.insert(next_ifd_offset_).second) {
+        promise_.SetResult(absl::DataLossError(tensorstore::StrCat(
+            "TIFF IFD at offset ", next_ifd_offset_, " forms a cycle")));
+        return;
+      }
+      TiffPage page;
+      auto result = TryParseTiffPage(directory_.header, next_ifd_offset_,
+                                     block, block_offset_, page);
+      if (auto* range = std::get_if<ByteRange>(&result)) {
+        visited_ifds_.erase(next_ifd_offset_);
+        if (*range == last_required_range_) {
+          promise_.SetResult(absl::DataLossError(tensorstore::StrCat(
+              "TIFF file is truncated: IFD at offset ", next_ifd_offset_,
+              " requires bytes [", range->inclusive_min, ", ",
+              range->exclusive_max, ")")));
+          return;
+        }
+        last_required_range_ = *range;
+        StartRead(OptionalByteRangeRequest::Range(
+            range->inclusive_min,
+            std::max(range->exclusive_max,
+                     range->inclusive_min + kIfdReadSize)));
+        return;
+      }
+      if (auto& status = std::get<absl::Status>(result); !status.ok()) {
+        promise_.SetResult(std::move(status));
+        return;
+      }
+      directory_.pages.push_back(page);
+      next_ifd_offset_ = page.next_ifd_offset;
+    }
+    if (auto status = ValidateTiffStackDirectory(directory_); !status.ok()) {
+      promise_.SetResult(std::move(status));
+      return;
+    }
+    auto directory =
+        std::make_shared<const TiffStackDirectory>(std::move(directory_));
+    Finish(internal::GetCache<TiffStackCache>(
+        spec_->cache_pool->get(), cache_key_, [&] {
+          auto cache = MakeTiffStackCache(directory, executor());
+          cache->kvstore_driver_ = kvstore_driver_;
+          cache->key_ = spec_->store.path;
+          cache->data_copy_concurrency_ = spec_->data_copy_concurrency;
+          cache->cache_pool_ = spec_->cache_pool;
+          return cache;
+        }));
+  }
+
+  void Finish(internal::CachePtr<TiffStackCache> cache) {
+    const auto& component = cache->grid().components[0];
+    auto transform =
+        IdentityTransform(component.array_spec.valid_data_bounds);
+    if (auto schema_domain = spec_->schema.domain();
+        schema_domain.valid() &&
+        !MergeIndexDomains(schema_domain, transform.domain()).ok()) {
+      promise_.SetResult(absl::InvalidArgumentError(tensorstore::StrCat(
+          "Schema domain ", schema_domain, " does not match image domain ",
+          transform.domain())));
+      return;
+    }
+    internal::Driver::Handle handle;
+    handle.driver = internal::MakeReadWritePtr<TiffStackDriver>(
+        ReadWriteMode::read,
+        TiffStackDriver::Initializer{std::move(cache), /*component_index=*/0,
+                                     data_staleness_});
+    handle.transform = std::move(transform);
+    promise_.SetResult(std::move(handle));
+  }
+};
+
+Future<internal::Driver::Handle> TiffStackDriverSpec::Open(
+    internal::DriverOpenRequest request) const {
+  if ((request.read_write_mode & ReadWriteMode::write) ==
+      ReadWriteMode::write) {
+    return absl::InvalidArgumentError("only reading is supported");
+  }
+  if (request.transaction) {
+    return absl::UnimplementedError(tensorstore::StrCat(
+        "\"", id, "\" driver does not support transactions"));
+  }
+  if (!store.valid()) {
+    return absl::InvalidArgumentError("\"kvstore\" must be specified");
+  }
+  auto state = internal::MakeIntrusivePtr<OpenState>();
+  state->spec_ = internal::IntrusivePtr<const TiffStackDriverSpec>(this);
+  state->data_staleness_ = data_staleness.BoundAtOpen(absl::Now());
+  state->options_.staleness_bound = state->data_staleness_.time;
+  state->options_.batch = std::move(request.batch);
+  return PromiseFuturePair<internal::Driver::Handle>::LinkValue(
+             [state = std::move(state)](
+                 Promise<internal::Driver::Handle> promise,
+                 ReadyFuture<kvstore::DriverPtr> future) {
+               state->promise_ = std::move(promise);
+               state->kvstore_driver_ = std::move(*future.result());
+               state->StartRead(
+                   OptionalByteRangeRequest::Range(0, kInitialReadSize));
+             },
+             kvstore::Open(store.driver))
+      .future;
+}
+
+const internal::DriverRegistration<TiffStackDriverSpec>
+    tiff_stack_driver_registration;
+
+}  // namespace
+}  // namespace internal_image_driver
+
+// Disable garbage collection.
+namespace garbage_collection {
+template <>
+struct GarbageCollection<internal_image_driver::TiffStackDriver> {
+  static constexpr bool required() { return false; }
+};
+}  // namespace garbage_collection
+}  // namespace tensorstore
@@ -0,0 +1,146 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+
+#include <string>
+#include <utility>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/array.h"
+#include "tensorstore/box.h"
+#include "tensorstore/context.h"
+#include "tensorstore/driver/image/tiff/tiff_testutil.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_space/dim_expression.h"
+#include "tensorstore/internal/testing/json_gtest.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/open.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::Context;
+using ::tensorstore::Index;
+using ::tensorstore::MatchesJson;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::internal_image_driver::MakeTiff;
+using ::tensorstore::internal_image_driver::TiffTestSampleValue;
+
+::nlohmann::json GetSpec() {
+  return {
+      {"driver", "tiff_stack"},
+      {"kvstore", {{"driver", "memory"}, {"path", "stack.tiff"}}},
+  };
+}
+
+Context PrepareContext(std::string data) {
+  auto context = Context::Default();
+  auto kvs = tensorstore::kvstore::Open({{"driver", "memory"}}, context)
+                 .result()
+                 .value();
+  TENSORSTORE_CHECK_OK(
+      tensorstore::kvstore::Write(kvs, "stack.tiff",
+                                  absl::Cord(std::move(data)))
+          .result());
+  return context;
+}
+
+TEST(TiffStackDriverTest, OpenAndRead) {
+  auto context = PrepareContext(MakeTiff({{4, 5}, {4, 5}, {4, 5}}));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      (tensorstore::Open<uint8_t, 4>(GetSpec(), context).result()));
+  EXPECT_EQ(tensorstore::BoxView({0, 0, 0, 0}, {3, 4, 5, 1}),
+            store.domain().box());
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto array,
+                                   tensorstore::Read(store).result());
+  for (Index p = 0; p < 3; ++p) {
+    for (Index y = 0; y < 4; ++y) {
+      for (Index x = 0; x < 5; ++x) {
+        EXPECT_EQ(TiffTestSampleValue(p, y * 5 + x), array(p, y, x, 0))
+            << p << ", " << y << ", " << x;
+      }
+    }
+  }
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto page,
+      tensorstore::Read<tensorstore::zero_origin>(
+          store | tensorstore::Dims(0, 1, 2, 3).IndexSlice({2, 3, 4, 0}))
+          .result());
+  EXPECT_EQ(tensorstore::MakeScalarArray<uint8_t>(TiffTestSampleValue(2, 19)),
+            page);
+}
+
+TEST(TiffStackDriverTest, Spec) {
+  auto context = PrepareContext(MakeTiff({{4, 5}, {4, 5}}));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, tensorstore::Open(GetSpec(), context).result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto spec, store.spec());
+  EXPECT_THAT(spec.ToJson(),
+              ::testing::Optional(MatchesJson({
+                  {"driver", "tiff_stack"},
+                  {"dtype", "uint8"},
+                  {"kvstore", {{"driver", "memory"}, {"path", "stack.tiff"}}},
+                  {"transform",
+                   {{"input_inclusive_min", {0, 0, 0, 0}},
+                    {"input_exclusive_max", {2, 4, 5, 1}}}},
+              })));
+}
+
+TEST(TiffStackDriverTest, SchemaDomainMismatch) {
+  auto context = PrepareContext(MakeTiff({{4, 5}, {4, 5}}));
+  auto spec = GetSpec();
+  spec["schema"] = {{"domain", {{"shape", {3, 4, 5, 1}}}}};
+  EXPECT_THAT(tensorstore::Open(spec, context).result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            ".*does not match image domain.*"));
+}
+
+TEST(TiffStackDriverTest, MismatchedPageShapes) {
+  auto context = PrepareContext(MakeTiff({{4, 5}, {4, 6}}));
+  EXPECT_THAT(tensorstore::Open(GetSpec(), context).result(),
+              MatchesStatus(absl::StatusCode::kUnimplemented,
+                            ".*same shape.*"));
+}
+
+TEST(TiffStackDriverTest, NotTiff) {
+  auto context = PrepareContext("not a tiff file");
+  EXPECT_THAT(tensorstore::Open(GetSpec(), context).result(),
+              MatchesStatus(absl::StatusCode::kDataLoss));
+}
+
+TEST(TiffStackDriverTest, Missing) {
+  EXPECT_THAT(tensorstore::Open(GetSpec()).result(),
+              MatchesStatus(absl::StatusCode::kNotFound));
+}
+
+TEST(TiffStackDriverTest, WriteNotSupported) {
+  auto context = PrepareContext(MakeTiff({{4, 5}}));
+  EXPECT_THAT(
+      tensorstore::Open(GetSpec(), context, tensorstore::ReadWriteMode::write)
+          .result(),
+      MatchesStatus(absl::StatusCode::kInvalidArgument,
+                    ".*only reading is supported"));
+}
+
+}  // namespace
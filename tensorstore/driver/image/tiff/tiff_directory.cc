@@ -0,0 +1,337 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/driver/image/tiff/tiff_directory.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_format.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/util/endian.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal_image_driver {
+namespace {
+
+// TIFF tags used to locate the image data.
+// See: https://www.awaresystems.be/imaging/tiff/tifftags/baseline.html
+constexpr uint16_t kImageWidth = 256;
+constexpr uint16_t kImageLength = 257;
+constexpr uint16_t kBitsPerSample = 258;
+constexpr uint16_t kStripOffsets = 273;
+constexpr uint16_t kSamplesPerPixel = 277;
+constexpr uint16_t kStripByteCounts = 279;
+constexpr uint16_t kTileOffsets = 324;
+constexpr uint16_t kTileByteCounts = 325;
+constexpr uint16_t kSampleFormat = 339;
+
+/// Returns the size in bytes of a single value of the TIFF field `type`, or 0
+/// if the type is unknown.
+size_t GetTiffTypeSize(uint16_t type) {
+  switch (type) {
+    case 1:   // BYTE
+    case 2:   // ASCII
+    case 6:   // SBYTE
+    case 7:   // UNDEFINED
+      return 1;
+    case 3:  // SHORT
+    case 8:  // SSHORT
+      return 2;
+    case 4:   // LONG
+    case 9:   // SLONG
+    case 11:  // FLOAT
+    case 13:  // IFD
+      return 4;
+    case 5:   // RATIONAL
+    case 10:  // SRATIONAL
+    case 12:  // DOUBLE
+    case 16:  // LONG8
+    case 17:  // SLONG8
+    case 18:  // IFD8
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+/// Reads unsigned integers of a given byte order from file data.
+class TiffData {
+ public:
+  TiffData(bool big_endian, std::string_view data, uint64_t data_offset)
+      : big_endian_(big_endian), data_(data), data_offset_(data_offset) {}
+
+  /// Returns whether the file byte range `[begin, end)` is available.
+  bool Contains(uint64_t begin, uint64_t end) const {
+    return begin >= data_offset_ && end >= begin &&
+           end - data_offset_ <= data_.size();
+  }
+
+  /// Loads the unsigned integer of `size` bytes at file `offset`.
+  ///
+  /// \dchecks `Contains(offset, offset + size)`
+  uint64_t Load(uint64_t offset, size_t size) const {
+    const char* p = data_.data() + (offset - data_offset_);
+    switch (size) {
+      case 1:
+        return static_cast<unsigned char>(*p);
+      case 2:
+        return big_endian_ ? big_endian::Load16(p) : little_endian::Load16(p);
+      case 4:
+        return big_endian_ ? big_endian::Load32(p) : little_endian::Load32(p);
+      default:
+        return big_endian_ ? big_endian::Load64(p) : little_endian::Load64(p);
+    }
+  }
+
+ private:
+  bool big_endian_;
+  std::string_view data_;
+  uint64_t data_offset_;
+};
+
+struct TiffIfdEntry {
+  uint16_t tag;
+  uint16_t type;
+  uint64_t count;
+  /// File offset of the value, which may be within the IFD entry itself.
+  uint64_t value_offset;
+  /// Size of the value, in bytes.
+  uint64_t value_size;
+};
+
+/// Returns the integer values of `entry`.
+std::vector<uint64_t> GetTiffValues(const TiffData& data,
+                                    const TiffIfdEntry& entry) {
+  const size_t size = GetTiffTypeSize(entry.type);
+  std::vector<uint64_t> values(entry.count);
+  for (uint64_t i = 0; i < entry.count; ++i) {
+    values[i] = data.Load(entry.value_offset + i * size, size);
+  }
+  return values;
+}
+
+bool IsIntegerType(uint16_t type) {
+  return type == 1 || type == 3 || type == 4 || type == 13 || type == 16 ||
+         type == 18;
+}
+
+absl::Status TiffPageError(uint64_t ifd_offset, std::string_view message) {
+  return absl::DataLossError(absl::StrFormat(
+      "Invalid TIFF directory at offset %d: %s", ifd_offset, message));
+}
+
+}  // namespace
+
+Result<TiffHeader> ParseTiffHeader(std::string_view data) {
+  if (data.size() < 8) {
+    return absl::DataLossError("Not a TIFF file");
+  }
+  TiffHeader header;
+  if (data.substr(0, 2) == "MM") {
+    header.big_endian = true;
+  } else if (data.substr(0, 2) != "II") {
+    return absl::DataLossError("Not a TIFF file");
+  }
+  TiffData tiff_data(header.big_endian, data, 0);
+  const uint64_t version = tiff_data.Load(2, 2);
+  if (version == 42) {
+    header.first_ifd_offset = tiff_data.Load(4, 4);
+  } else if (version == 43 && data.size() >= 16 &&
+             tiff_data.Load(4, 2) == 8 && tiff_data.Load(6, 2) == 0) {
+    header.big_tiff = true;
+    header.first_ifd_offset = tiff_data.Load(8, 8);
+  } else {
+    return absl::DataLossError("Not a TIFF file");
+  }
+  return header;
+}
+
+std::string EncodeTiffHeader(const TiffHeader& header) {
+  std::string encoded(header.size(), '\0');
+  char* p = encoded.data();
+  p[0] = p[1] = header.big_endian ? 'M' : 'I';
+  if (header.big_endian) {
+    big_endian::Store16(p + 2, header.big_tiff ? 43 : 42);
+  } else {
+    little_endian::Store16(p + 2, header.big_tiff ? 43 : 42);
+  }
+  if (!header.big_tiff) {
+    const auto offset = static_cast<uint32_t>(header.first_ifd_offset);
+    if (header.big_endian) {
+      big_endian::Store32(p + 4, offset);
+    } else {
+      little_endian::Store32(p + 4, offset);
+    }
+  } else if (header.big_endian) {
+    big_endian::Store16(p + 4, 8);
+    big_endian::Store64(p + 8, header.first_ifd_offset);
+  } else {
+    little_endian::Store16(p + 4, 8);
+    little_endian::Store64(p + 8, header.first_ifd_offset);
+  }
+  return encoded;
+}
+
+std::variant<absl::Status, ByteRange> TryParseTiffPage(
+    const TiffHeader& header, uint64_t ifd_offset, std::string_view data,
+    uint64_t data_offset, TiffPage& page) {
+  constexpr uint64_t kMaxOffset = std::numeric_limits<int64_t>::max();
+  const size_t count_size = header.big_tiff ? 8 : 2;
+  const size_t entry_size = header.big_tiff ? 20 : 12;
+  const size_t offset_size = header.big_tiff ? 8 : 4;
+  const auto range = [](uint64_t begin, uint64_t end) {
+    return ByteRange{static_cast<int64_t>(begin), static_cast<int64_t>(end)};
+  };
+
+  if (ifd_offset < header.size() ||
+      ifd_offset > kMaxOffset - count_size - offset_size) {
+    return TiffPageError(ifd_offset, "offset out of range");
+  }
+  TiffData tiff_data(header.big_endian, data, data_offset);
+  if (!tiff_data.Contains(ifd_offset, ifd_offset + count_size)) {
+    return range(ifd_offset, ifd_offset + count_size);
+  }
+  const uint64_t num_entries = tiff_data.Load(ifd_offset, count_size);
+  if (num_entries == 0 ||
+      num_entries >
+          (kMaxOffset - ifd_offset - count_size - offset_size) / entry_size) {
+    return TiffPageError(ifd_offset, "invalid number of entries");
+  }
+  const uint64_t entries_offset = ifd_offset + count_size;
+  const uint64_t next_offset = entries_offset + num_entries * entry_size;
+  const uint64_t ifd_end = next_offset + offset_size;
+  if (!tiff_data.Contains(ifd_offset, ifd_end)) {
+    return range(ifd_offset, ifd_end);
+  }
+
+  // Parse the entries, and determine the byte range which must be available
+  // to read the values of the fields used below.
+  std::vector<TiffIfdEntry> entries(num_entries);
+  uint64_t extent_begin = ifd_offset;
+  uint64_t extent_end = ifd_end;
+  uint64_t required_begin = ifd_offset;
+  uint64_t required_end = ifd_end;
+  for (uint64_t i = 0; i < num_entries; ++i) {
+    const uint64_t entry_offset = entries_offset + i * entry_size;
+    auto& entry = entries[i];
+    entry.tag = tiff_data.Load(entry_offset, 2);
+    entry.type = tiff_data.Load(entry_offset + 2, 2);
+    entry.count = tiff_data.Load(entry_offset + 4, offset_size);
+    const uint64_t type_size = GetTiffTypeSize(entry.type);
+    if (type_size != 0 && entry.count > kMaxOffset / type_size) {
+      return TiffPageError(ifd_offset, "invalid entry count");
+    }
+    entry.value_size = entry.count * type_size;
+    entry.value_offset = entry_offset + 4 + offset_size;
+    if (entry.value_size <= offset_size) continue;
+    entry.value_offset = tiff_data.Load(entry.value_offset, offset_size);
+    if (entry.value_offset > kMaxOffset - entry.value_size) {
+      return TiffPageError(ifd_offset, "value offset out of range");
+    }
+    const uint64_t value_end = entry.value_offset + entry.value_size;
+    extent_begin = std::min(extent_begin, entry.value_offset);
+    extent_end = std::max(extent_end, value_end);
+    switch (entry.tag) {
+      case kImageWidth:
+      case kImageLength:
+      case kBitsPerSample:
+      case kSamplesPerPixel:
+      case kStripOffsets:
+      case kStripByteCounts:
+      case kTileOffsets:
+      case kTileByteCounts:
+      case kSampleFormat:
+        required_begin = std::min(required_begin, entry.value_offset);
+        required_end = std::max(required_end, value_end);
+        break;
+      default:
+        break;
+    }
+  }
+  if (!tiff_data.Contains(required_begin, required_end)) {
+    return range(required_begin, required_end);
+  }
+
+  page = TiffPage{};
+  page.ifd_offset = ifd_offset;
+  page.next_ifd_offset = tiff_data.Load(next_offset, offset_size);
+  std::vector<uint64_t> data_offsets, data_byte_counts;
+  for (const auto& entry : entries) {
+    if (entry.count == 0 || !IsIntegerType(entry.type)) continue;
+    switch (entry.tag) {
+      case kImageWidth:
+        page.width = tiff_data.Load(entry.value_offset,
+                                    GetTiffTypeSize(entry.type));
+        break;
+      case kImageLength:
+        page.height = tiff_data.Load(entry.value_offset,
+                                     GetTiffTypeSize(entry.type));
+        break;
+      case kSamplesPerPixel:
+        page.samples_per_pixel = tiff_data.Load(entry.value_offset,
+                                                GetTiffTypeSize(entry.type));
+        break;
+      case kBitsPerSample:
+        page.bits_per_sample = tiff_data.Load(entry.value_offset,
+                                              GetTiffTypeSize(entry.type));
+        break;
+      case kSampleFormat:
+        page.sample_format = tiff_data.Load(entry.value_offset,
+                                            GetTiffTypeSize(entry.type));
+        break;
+      case kStripOffsets:
+      case kTileOffsets:
+        data_offsets = GetTiffValues(tiff_data, entry);
+        break;
+      case kStripByteCounts:
+      case kTileByteCounts:
+        data_byte_counts = GetTiffValues(tiff_data, entry);
+        break;
+      default:
+        break;
+    }
+  }
+  if (page.width == 0 || page.height == 0) {
+    return TiffPageError(ifd_offset, "missing image dimensions");
+  }
+  if (data_offsets.empty() || data_offsets.size() != data_byte_counts.size()) {
+    return TiffPageError(ifd_offset, "missing image data location");
+  }
+  for (size_t i = 0; i < data_offsets.size(); ++i) {
+    if (data_byte_counts[i] == 0) continue;
+    if (data_offsets[i] > kMaxOffset - data_byte_counts[i]) {
+      return TiffPageError(ifd_offset, "image data offset out of range");
+    }
+    extent_begin = std::min(extent_begin, data_offsets[i]);
+    extent_end = std::max(extent_end, data_offsets[i] + data_byte_counts[i]);
+  }
+  if (extent_begin < header.size()) {
+    return TiffPageError(ifd_offset, "data overlaps the header");
+  }
+  page.extent = range(extent_begin, extent_end);
+  return absl::OkStatus();
+}
+
+}  // namespace internal_image_driver
+}  // namespace tensorstore
@@ -0,0 +1,94 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_DRIVER_IMAGE_TIFF_TIFF_DIRECTORY_H_
+#define TENSORSTORE_DRIVER_IMAGE_TIFF_TIFF_DIRECTORY_H_
+
+/// \file
+///
+/// Minimal parsing of the TIFF file structure, sufficient to locate each page
+/// (image file directory) of a TIFF file and the byte range it occupies
+/// without reading the entire file.  Decoding of the image data itself is left
+/// to libtiff.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+#include <variant>
+
+#include "absl/status/status.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal_image_driver {
+
+/// Number of bytes which must be read to parse any TIFF header.
+constexpr size_t kTiffMaxHeaderSize = 16;
+
+/// Byte order and offset size of a TIFF file, from its header.
+struct TiffHeader {
+  bool big_endian = false;
+  bool big_tiff = false;
+  uint64_t first_ifd_offset = 0;
+
+  /// Returns the size of the header, in bytes.
+  size_t size() const { return big_tiff ? 16 : 8; }
+};
+
+/// Parses the TIFF header at the start of `data`.
+Result<TiffHeader> ParseTiffHeader(std::string_view data);
+
+/// Returns the encoded representation of `header`.
+std::string EncodeTiffHeader(const TiffHeader& header);
+
+/// Location and image properties of a single TIFF page.
+struct TiffPage {
+  /// Offset of the image file directory (IFD) of this page.
+  uint64_t ifd_offset = 0;
+
+  /// Offset of the IFD of the next page, or 0 if this is the last page.
+  uint64_t next_ifd_offset = 0;
+
+  uint32_t width = 0;
+  uint32_t height = 0;
+  uint16_t samples_per_pixel = 1;
+  uint16_t bits_per_sample = 1;
+  uint16_t sample_format = 1;
+
+  /// Byte range spanning the IFD, all of its out-of-line values, and the image
+  /// data of the page.
+  ByteRange extent{0, 0};
+};
+
+/// Parses the page whose IFD is at `ifd_offset`.
+///
+/// \param header The file header.
+/// \param ifd_offset Offset of the IFD within the file.
+/// \param data File data starting at `data_offset`.
+/// \param data_offset Offset of `data` within the file.
+/// \param page[out] Set to the parsed page on success.
+/// \returns `absl::OkStatus()` on success, an error status if the IFD is
+///     invalid, or the byte range which must be contained in `data` in order
+///     to parse the page.
+std::variant<absl::Status, ByteRange> TryParseTiffPage(
+    const TiffHeader& header, uint64_t ifd_offset, std::string_view data,
+    uint64_t data_offset, TiffPage& page);
+
+}  // namespace internal_image_driver
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_DRIVER_IMAGE_TIFF_TIFF_DIRECTORY_H_
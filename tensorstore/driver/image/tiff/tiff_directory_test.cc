@@ -0,0 +1,185 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/driver/image/tiff/tiff_directory.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "tensorstore/driver/image/tiff/tiff_testutil.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/util/endian.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::ByteRange;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::internal_image_driver::EncodeTiffHeader;
+using ::tensorstore::internal_image_driver::MakeTiff;
+using ::tensorstore::internal_image_driver::ParseTiffHeader;
+using ::tensorstore::internal_image_driver::TiffHeader;
+using ::tensorstore::internal_image_driver::TiffPage;
+using ::tensorstore::internal_image_driver::TiffTestPageLayout;
+using ::tensorstore::internal_image_driver::TryParseTiffPage;
+
+TEST(TiffHeaderTest, Parse) {
+  std::string data = MakeTiff({{2, 3, 1, "page 0"}});
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto header, ParseTiffHeader(data));
+  EXPECT_FALSE(header.big_endian);
+  EXPECT_FALSE(header.big_tiff);
+  EXPECT_EQ(8, header.size());
+  EXPECT_EQ(std::string_view(data).substr(0, 8), EncodeTiffHeader(header));
+}
+
+TEST(TiffHeaderTest, EncodeRoundTrip) {
+  for (bool big_endian : {false, true}) {
+    for (bool big_tiff : {false, true}) {
+      TiffHeader header;
+      header.big_endian = big_endian;
+      header.big_tiff = big_tiff;
+      header.first_ifd_offset = 1234;
+      std::string encoded = EncodeTiffHeader(header);
+      EXPECT_EQ(header.size(), encoded.size());
+      TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto parsed, ParseTiffHeader(encoded));
+      EXPECT_EQ(big_endian, parsed.big_endian);
+      EXPECT_EQ(big_tiff, parsed.big_tiff);
+      EXPECT_EQ(1234, parsed.first_ifd_offset);
+    }
+  }
+}
+
+TEST(TiffHeaderTest, Invalid) {
+  EXPECT_THAT(ParseTiffHeader("II*"),
+              MatchesStatus(absl::StatusCode::kDataLoss));
+  EXPECT_THAT(ParseTiffHeader("\x89PNG\r\n\x1a\n"),
+              MatchesStatus(absl::StatusCode::kDataLoss));
+  EXPECT_THAT(ParseTiffHeader(std::string_view("II\x2b\x00\x04\x00\x00\x00",
+                                               8)),
+              MatchesStatus(absl::StatusCode::kDataLoss));
+}
+
+TEST(TryParseTiffPageTest, Pages) {
+  std::vector<TiffTestPageLayout> layouts;
+  std::string data = MakeTiff(
+      {{2, 3, 1, "page 0"}, {4, 5, 3, "page 1"}, {2, 3, 2, "page 2"}},
+      &layouts);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto header, ParseTiffHeader(data));
+
+  uint64_t ifd_offset = header.first_ifd_offset;
+  std::vector<TiffPage> pages;
+  while (ifd_offset != 0) {
+    TiffPage page;
+    auto result = TryParseTiffPage(header, ifd_offset, data, 0, page);
+    ASSERT_TRUE(std::holds_alternative<absl::Status>(result));
+    TENSORSTORE_ASSERT_OK(std::get<absl::Status>(result));
+    pages.push_back(page);
+    ifd_offset = page.next_ifd_offset;
+  }
+  ASSERT_EQ(3, pages.size());
+
+  EXPECT_EQ(2, pages[0].height);
+  EXPECT_EQ(3, pages[0].width);
+  EXPECT_EQ(1, pages[0].samples_per_pixel);
+  EXPECT_EQ(4, pages[1].height);
+  EXPECT_EQ(5, pages[1].width);
+  EXPECT_EQ(3, pages[1].samples_per_pixel);
+  EXPECT_EQ(2, pages[2].samples_per_pixel);
+  for (size_t i = 0; i < pages.size(); ++i) {
+    SCOPED_TRACE(i);
+    EXPECT_EQ(8, pages[i].bits_per_sample);
+    EXPECT_EQ(1, pages[i].sample_format);
+    EXPECT_EQ(layouts[i].ifd_offset, pages[i].ifd_offset);
+    EXPECT_EQ(layouts[i].extent_begin, pages[i].extent.inclusive_min);
+    EXPECT_EQ(layouts[i].extent_end, pages[i].extent.exclusive_max);
+  }
+}
+
+TEST(TryParseTiffPageTest, PartialData) {
+  std::vector<TiffTestPageLayout> layouts;
+  std::string data =
+      MakeTiff({{2, 3, 1, "page 0"}, {4, 5, 3, "page 1"}}, &layouts);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto header, ParseTiffHeader(data));
+  const uint64_t ifd_offset = layouts[1].ifd_offset;
+  const uint64_t ifd_end = layouts[1].extent_end;
+  TiffPage page;
+
+  // No data: the entry count is required.
+  auto result = TryParseTiffPage(header, ifd_offset, {}, 0, page);
+  ASSERT_TRUE(std::holds_alternative<ByteRange>(result));
+  EXPECT_EQ((ByteRange{static_cast<int64_t>(ifd_offset),
+                       static_cast<int64_t>(ifd_offset + 2)}),
+            std::get<ByteRange>(result));
+
+  // Only the entry count: the entire IFD is required.
+  result = TryParseTiffPage(header, ifd_offset,
+                            std::string_view(data).substr(ifd_offset, 2),
+                            ifd_offset, page);
+  ASSERT_TRUE(std::holds_alternative<ByteRange>(result));
+  EXPECT_EQ((ByteRange{static_cast<int64_t>(ifd_offset),
+                       static_cast<int64_t>(ifd_end)}),
+            std::get<ByteRange>(result));
+
+  // Only the IFD: the out-of-line bits per sample are also required.
+  result = TryParseTiffPage(
+      header, ifd_offset,
+      std::string_view(data).substr(ifd_offset, ifd_end - ifd_offset),
+      ifd_offset, page);
+  ASSERT_TRUE(std::holds_alternative<ByteRange>(result));
+  EXPECT_EQ((ByteRange{static_cast<int64_t>(layouts[1].extent_begin),
+                       static_cast<int64_t>(ifd_end)}),
+            std::get<ByteRange>(result));
+
+  const auto& range = std::get<ByteRange>(result);
+  result = TryParseTiffPage(
+      header, ifd_offset,
+      std::string_view(data).substr(range.inclusive_min, range.size()),
+      range.inclusive_min, page);
+  ASSERT_TRUE(std::holds_alternative<absl::Status>(result));
+  TENSORSTORE_EXPECT_OK(std::get<absl::Status>(result));
+  EXPECT_EQ(3, page.samples_per_pixel);
+  EXPECT_EQ(8, page.bits_per_sample);
+}
+
+TEST(TryParseTiffPageTest, Invalid) {
+  std::string data = MakeTiff({{2, 3, 1, "page 0"}});
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto header, ParseTiffHeader(data));
+  TiffPage page;
+
+  // Offset within the header.
+  auto result = TryParseTiffPage(header, 4, data, 0, page);
+  ASSERT_TRUE(std::holds_alternative<absl::Status>(result));
+  EXPECT_THAT(std::get<absl::Status>(result),
+              MatchesStatus(absl::StatusCode::kDataLoss));
+
+  // Zero entries.
+  std::string empty_ifd = data;
+  tensorstore::little_endian::Store16(&empty_ifd[header.first_ifd_offset], 0);
+  result = TryParseTiffPage(header, header.first_ifd_offset, empty_ifd, 0,
+                            page);
+  ASSERT_TRUE(std::holds_alternative<absl::Status>(result));
+  EXPECT_THAT(std::get<absl::Status>(result),
+              MatchesStatus(absl::StatusCode::kDataLoss,
+                            ".*invalid number of entries"));
+}
+
+}  // namespace
@@ -0,0 +1,119 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/driver/image/tiff/tiff_testutil.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "tensorstore/util/endian.h"
+
+namespace tensorstore {
+namespace internal_image_driver {
+namespace {
+
+void Append16(std::string& out, uint16_t value) {
+  char buffer[2];
+  little_endian::Store16(buffer, value);
+  out.append(buffer, 2);
+}
+
+void Append32(std::string& out, uint32_t value) {
+  char buffer[4];
+  little_endian::Store32(buffer, value);
+  out.append(buffer, 4);
+}
+
+}  // namespace
+
+uint8_t TiffTestSampleValue(size_t page, size_t i) {
+  return static_cast<uint8_t>((page * 31 + i) & 0xff);
+}
+
+std::string MakeTiff(const std::vector<TiffTestPage>& pages,
+                     std::vector<TiffTestPageLayout>* layouts) {
+  std::string out = "II";
+  Append16(out, 42);
+  size_t next_ifd_pointer = out.size();
+  Append32(out, 0);
+  for (size_t p = 0; p < pages.size(); ++p) {
+    const auto& page = pages[p];
+    const uint32_t extent_begin = out.size();
+    const uint32_t bits_offset = out.size();
+    if (page.samples_per_pixel > 2) {
+      for (int i = 0; i < page.samples_per_pixel; ++i) Append16(out, 8);
+    }
+    const uint32_t description_offset = out.size();
+    if (!page.description.empty()) {
+      out += page.description;
+      out.push_back('\0');
+    }
+    const uint32_t data_offset = out.size();
+    const uint32_t data_size =
+        page.height * page.width * page.samples_per_pixel;
+    for (uint32_t i = 0; i < data_size; ++i) {
+      out.push_back(static_cast<char>(TiffTestSampleValue(p, i)));
+    }
+    if (out.size() % 2) out.push_back('\0');
+
+    struct Entry {
+      uint16_t tag, type;
+      uint32_t count, value;
+    };
+    std::vector<Entry> entries{
+        {256, 3, 1, page.width},
+        {257, 3, 1, page.height},
+        {258, 3, page.samples_per_pixel,
+         page.samples_per_pixel > 2 ? bits_offset
+         : page.samples_per_pixel == 2
+             ? 0x00080008u
+             : 8u},
+        {259, 3, 1, 1},
+        {262, 3, 1, page.samples_per_pixel == 3 ? 2u : 1u},
+    };
+    if (!page.description.empty()) {
+      entries.push_back(
+          {270, 2, static_cast<uint32_t>(page.description.size() + 1),
+           description_offset});
+    }
+    entries.insert(entries.end(), {
+                                      {273, 4, 1, data_offset},
+                                      {277, 3, 1, page.samples_per_pixel},
+                                      {278, 4, 1, page.height},
+                                      {279, 4, 1, data_size},
+                                  });
+    const uint32_t ifd_offset = out.size();
+    little_endian::Store32(&out[next_ifd_pointer], ifd_offset);
+    Append16(out, entries.size());
+    for (const auto& entry : entries) {
+      Append16(out, entry.tag);
+      Append16(out, entry.type);
+      Append32(out, entry.count);
+      Append32(out, entry.value);
+    }
+    next_ifd_pointer = out.size();
+    Append32(out, 0);
+    if (layouts) {
+      layouts->push_back(TiffTestPageLayout{
+          ifd_offset, extent_begin, static_cast<uint32_t>(out.size())});
+    }
+  }
+  return out;
+}
+
+}  // namespace internal_image_driver
+}  // namespace tensorstore
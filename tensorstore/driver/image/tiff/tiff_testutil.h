@@ -0,0 +1,60 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_DRIVER_IMAGE_TIFF_TIFF_TESTUTIL_H_
+#define TENSORSTORE_DRIVER_IMAGE_TIFF_TIFF_TESTUTIL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+namespace tensorstore {
+namespace internal_image_driver {
+
+/// Page of a TIFF file generated by `MakeTiff`.
+struct TiffTestPage {
+  uint16_t height;
+  uint16_t width;
+  uint16_t samples_per_pixel = 1;
+  /// Stored as an ImageDescription tag if non-empty.
+  std::string description;
+};
+
+/// Location of a page within a TIFF file generated by `MakeTiff`.
+struct TiffTestPageLayout {
+  /// Offset of the image file directory.
+  uint32_t ifd_offset;
+  /// Byte range containing the directory, its out-of-line values and the
+  /// image data of the page.
+  uint32_t extent_begin;
+  uint32_t extent_end;
+};
+
+/// Returns the value of sample `i`, in row-major order, of page `page` of a
+/// TIFF file generated by `MakeTiff`.
+uint8_t TiffTestSampleValue(size_t page, size_t i);
+
+/// Returns an uncompressed little-endian TIFF file containing `pages` with 8
+/// bits per sample, each preceded by its out-of-line values and image data.
+///
+/// \param layouts If non-null, set to the layout of each page.
+std::string MakeTiff(const std::vector<TiffTestPage>& pages,
+                     std::vector<TiffTestPageLayout>* layouts = nullptr);
+
+}  // namespace internal_image_driver
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_DRIVER_IMAGE_TIFF_TIFF_TESTUTIL_H_
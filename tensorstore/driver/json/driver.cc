@@ -23,8 +23,11 @@
 #include <string_view>
 #include <utility>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/time/clock.h"
 #include <nlohmann/json.hpp>
 #include "tensorstore/chunk_layout.h"
@@ -34,6 +37,7 @@
 #include "tensorstore/driver/driver_handle.h"
 #include "tensorstore/driver/driver_spec.h"
 #include "tensorstore/driver/json/json_change_map.h"
+#include "tensorstore/driver/json/json_scanner.h"
 #include "tensorstore/driver/registry.h"
 #include "tensorstore/driver/url_registry.h"
 #include "tensorstore/index.h"
@@ -47,6 +51,8 @@
 #include "tensorstore/internal/cache/kvs_backed_cache.h"
 #include "tensorstore/internal/cache_key/cache_key.h"
 #include "tensorstore/internal/data_copy_concurrency_resource.h"
+#include "tensorstore/internal/estimate_heap_usage/estimate_heap_usage.h"
+#include "tensorstore/internal/estimate_heap_usage/json.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json/same.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
@@ -85,18 +91,121 @@ namespace {
 
 namespace jb = tensorstore::internal_json_binding;
 
-Result<::nlohmann::json> DecodeJson(const std::optional<absl::Cord>& data) {
-  if (!data) {
-    return ::nlohmann::json(::nlohmann::json::value_t::discarded);
+/// Cached state of a JSON document.
+///
+/// The encoded representation is retained, and parsed only on demand.  Reads
+/// of a sub-value locate it within the encoded representation, and parse just
+/// that portion.
+class JsonDocument {
+ public:
+  /// Constructs a document from its encoded representation, or a missing
+  /// document if `encoded` is `std::nullopt`.
+  explicit JsonDocument(std::optional<absl::Cord> encoded)
+      : encoded_(std::move(encoded)) {
+    if (encoded_) {
+      text_ = encoded_->Flatten();
+    } else {
+      value_ = std::make_shared<const ::nlohmann::json>(
+          ::nlohmann::json::value_t::discarded);
+    }
   }
-  nlohmann::json raw_data =
-      nlohmann::json::parse(absl::Cord(*data).Flatten(), nullptr,
-                            /*allow_exceptions=*/false);
-  if (raw_data.is_discarded()) {
-    return absl::FailedPreconditionError("Invalid JSON");
+
+  /// Constructs a document from its parsed value, which may be `discarded` to
+  /// indicate a missing document.
+  explicit JsonDocument(::nlohmann::json value)
+      : value_(std::make_shared<const ::nlohmann::json>(std::move(value))) {}
+
+  /// Returns the encoded representation, if available.
+  const std::optional<absl::Cord>& encoded() const { return encoded_; }
+
+  /// Returns the flattened encoded representation.
+  ///
+  /// \pre `encoded()` is not `std::nullopt`.
+  std::string_view text() const { return text_; }
+
+  /// Returns the full value, which is `discarded` if the document is missing.
+  ///
+  /// \error `absl::StatusCode::kFailedPrecondition` if the encoded
+  ///     representation is not valid JSON.
+  Result<std::shared_ptr<const ::nlohmann::json>> GetValue() const {
+    absl::MutexLock lock(&mutex_);
+    if (!value_) {
+      assert(encoded_);
+      auto value = ::nlohmann::json::parse(text_, nullptr,
+                                           /*allow_exceptions=*/false);
+      if (value.is_discarded()) {
+        return absl::FailedPreconditionError("Invalid JSON");
+      }
+      value_ = std::make_shared<const ::nlohmann::json>(std::move(value));
+      sub_values_.clear();
+    }
+    return value_;
   }
-  return raw_data;
-}
+
+  /// Returns the sub-value referred to by `json_pointer`.
+  ///
+  /// \error `absl::StatusCode::kFailedPrecondition` if the encoded
+  ///     representation is not valid JSON.
+  /// \error Any error returned by `json_pointer::Dereference`.
+  Result<std::shared_ptr<const ::nlohmann::json>> GetSubValue(
+      std::string_view json_pointer) const {
+    if (!json_pointer.empty() && encoded_) {
+      {
+        absl::MutexLock lock(&mutex_);
+        if (!value_) {
+          if (auto it = sub_values_.find(json_pointer);
+              it != sub_values_.end()) {
+            return it->second;
+          }
+        }
+      }
+      // If the sub-value cannot be located or parsed, fall back to parsing the
+      // full value below in order to report a precise error.
+      if (auto span =
+              internal_json_driver::FindJsonSubValue(text_, json_pointer)) {
+        auto sub_value = ::nlohmann::json::parse(
+            text_.substr(span->begin, span->end - span->begin), nullptr,
+            /*allow_exceptions=*/false);
+        if (!sub_value.is_discarded()) {
+          auto ptr =
+              std::make_shared<const ::nlohmann::json>(std::move(sub_value));
+          absl::MutexLock lock(&mutex_);
+          if (!value_) sub_values_.emplace(json_pointer, ptr);
+          return ptr;
+        }
+      }
+    }
+    TENSORSTORE_ASSIGN_OR_RETURN(auto value, GetValue());
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        const auto* sub_value, json_pointer::Dereference(*value, json_pointer));
+    return std::shared_ptr<const ::nlohmann::json>(std::move(value), sub_value);
+  }
+
+  /// Returns an estimate of the heap memory used by the encoded representation
+  /// and any values parsed so far.
+  size_t EstimateHeapUsage() const {
+    size_t total =
+        encoded_ ? internal::EstimateHeapUsage(*encoded_) : size_t(0);
+    absl::MutexLock lock(&mutex_);
+    total += internal::EstimateHeapUsage(value_);
+    for (const auto& [json_pointer, sub_value] : sub_values_) {
+      total += internal::EstimateHeapUsage(json_pointer) +
+               internal::EstimateHeapUsage(sub_value);
+    }
+    return total;
+  }
+
+ private:
+  std::optional<absl::Cord> encoded_;
+  std::string_view text_;
+  mutable absl::Mutex mutex_;
+  mutable std::shared_ptr<const ::nlohmann::json> value_
+      ABSL_GUARDED_BY(mutex_);
+  // Sub-values parsed individually, used only until `value_` is parsed.
+  mutable absl::flat_hash_map<std::string,
+                              std::shared_ptr<const ::nlohmann::json>>
+      sub_values_ ABSL_GUARDED_BY(mutex_);
+};
 
 class JsonCache
     : public internal::KvsBackedCache<JsonCache, internal::AsyncCache>,
@@ -104,36 +213,42 @@ class JsonCache
   using Base = internal::KvsBackedCache<JsonCache, internal::AsyncCache>;
 
  public:
-  using ReadData = ::nlohmann::json;
+  using ReadData = JsonDocument;
 
   JsonCache() : Base(kvstore::DriverPtr()) {}
 
   class Entry : public Base::Entry {
    public:
     using OwningCache = JsonCache;
+
+    size_t ComputeReadDataSizeInBytes(const void* read_data) override {
+      return static_cast<const ReadData*>(read_data)->EstimateHeapUsage();
+    }
+
     void DoDecode(std::optional<absl::Cord> value,
                   DecodeReceiver receiver) override {
+      // Parsing is deferred until a value is actually requested.
       GetOwningCache(*this).executor()(
           [value = std::move(value), receiver = std::move(receiver)]() mutable {
-            auto decode_result = DecodeJson(value);
-            if (!decode_result.ok()) {
-              execution::set_error(receiver, decode_result.status());
-              return;
-            }
-            execution::set_value(receiver, std::make_shared<::nlohmann::json>(
-                                               *std::move(decode_result)));
+            execution::set_value(
+                receiver, std::make_shared<JsonDocument>(std::move(value)));
           });
     }
     void DoEncode(EncodeOptions options, std::shared_ptr<const ReadData> data,
                   EncodeReceiver receiver) override {
-      const auto& json_value = *data;
-      if (json_value.is_discarded()) {
+      if (const auto& encoded = data->encoded()) {
+        execution::set_value(receiver, *encoded);
+        return;
+      }
+      TENSORSTORE_ASSIGN_OR_RETURN(auto json_value, data->GetValue(),
+                                   execution::set_error(receiver, _));
+      if (json_value->is_discarded()) {
         execution::set_value(receiver, std::nullopt);
         return;
       }
       absl::Cord encoded;
       if (options.encode_mode != EncodeOptions::kValueDiscarded) {
-        encoded = absl::Cord(json_value.dump());
+        encoded = absl::Cord(json_value->dump());
       }
       execution::set_value(receiver, std::move(encoded));
     }
@@ -167,8 +282,27 @@ class JsonCache
         }
 
         if (!unmodified) {
-          auto* existing_json =
-              static_cast<const ::nlohmann::json*>(read_state.data.get());
+          auto* existing =
+              static_cast<const JsonDocument*>(read_state.data.get());
+          // Where possible, patch the encoded representation directly rather
+          // than parsing and re-encoding the entire document.
+          if (existing && existing->encoded()) {
+            if (auto patched = changes_.ApplyToEncoded(existing->text())) {
+              if (*patched != existing->text()) {
+                read_state.stamp.generation.MarkDirty(mutation_id_);
+                read_state.data = std::make_shared<JsonDocument>(
+                    std::optional<absl::Cord>(std::in_place,
+                                              *std::move(patched)));
+              }
+              execution::set_value(receiver, std::move(read_state));
+              return;
+            }
+          }
+          std::shared_ptr<const ::nlohmann::json> existing_json;
+          if (existing) {
+            TENSORSTORE_ASSIGN_OR_RETURN(existing_json, existing->GetValue(),
+                                         execution::set_error(receiver, _));
+          }
           ::nlohmann::json new_json;
           // Apply changes.  If `existing_state` is non-null (equivalent to
           // `unconditional == false`), provide it to `Apply`.  Otherwise,
@@ -190,7 +324,7 @@ class JsonCache
               !internal_json::JsonSame(new_json, *existing_json)) {
             read_state.stamp.generation.MarkDirty(mutation_id_);
             read_state.data =
-                std::make_shared<::nlohmann::json>(std::move(new_json));
+                std::make_shared<JsonDocument>(std::move(new_json));
           }
         }
         execution::set_value(receiver, std::move(read_state));
@@ -438,16 +572,13 @@ struct ReadChunkImpl {
     // Note that this acquires a lock on the entry, not the node, and
     // therefore does not conflict with the lock registered with the
     // `LockCollection`.
-    std::shared_ptr<const ::nlohmann::json> read_value =
+    std::shared_ptr<const JsonDocument> read_value =
         AsyncCache::ReadLock<JsonCache::ReadData>(*entry).shared_data();
     TENSORSTORE_ASSIGN_OR_RETURN(
-        auto* sub_value,
-        json_pointer::Dereference(*read_value, driver->json_pointer_),
+        auto sub_value, read_value->GetSubValue(driver->json_pointer_),
         entry->AnnotateError(_, /*reading=*/true));
-    return GetTransformedArrayNDIterable(
-        std::shared_ptr<const ::nlohmann::json>(std::move(read_value),
-                                                sub_value),
-        std::move(chunk_transform), arena);
+    return GetTransformedArrayNDIterable(std::move(sub_value),
+                                         std::move(chunk_transform), arena);
   }
 };
 
@@ -469,13 +600,16 @@ struct ReadChunkTransactionImpl {
   Result<NDIterable::Ptr> operator()(ReadChunk::BeginRead,
                                      IndexTransform<> chunk_transform,
                                      Arena* arena) {
-    std::shared_ptr<const ::nlohmann::json> existing_value;
+    std::shared_ptr<const JsonDocument> existing_value;
     StorageGeneration read_generation;
     {
       AsyncCache::ReadLock<JsonCache::ReadData> lock(*node);
       existing_value = lock.shared_data();
       read_generation = lock.stamp().generation;
     }
+    const auto annotate_error = [&](const absl::Status& status) {
+      return GetOwningEntry(*node).AnnotateError(status, /*reading=*/true);
+    };
     auto value = std::allocate_shared<::nlohmann::json>(
         ArenaAllocator<::nlohmann::json>(arena));
     {
@@ -487,14 +621,28 @@ struct ReadChunkTransactionImpl {
       }
       assert(existing_value ||
              node->changes_.CanApplyUnconditionally(driver->json_pointer_));
+      if (node->changes_.underlying_map().empty()) {
+        // No changes, only the sub-value needs to be parsed.
+        lock.unlock();
+        TENSORSTORE_ASSIGN_OR_RETURN(
+            auto sub_value, existing_value->GetSubValue(driver->json_pointer_),
+            annotate_error(_));
+        return GetTransformedArrayNDIterable(std::move(sub_value),
+                                             chunk_transform, arena);
+      }
+      std::shared_ptr<const ::nlohmann::json> existing_json;
+      if (existing_value) {
+        TENSORSTORE_ASSIGN_OR_RETURN(existing_json, existing_value->GetValue(),
+                                     annotate_error(_));
+      }
       TENSORSTORE_ASSIGN_OR_RETURN(
           *value,
           node->changes_.Apply(
-              existing_value
-                  ? *existing_value
+              existing_json
+                  ? *existing_json
                   : ::nlohmann::json(::nlohmann::json::value_t::discarded),
               driver->json_pointer_),
-          GetOwningEntry(*node).AnnotateError(_, /*reading=*/true));
+          annotate_error(_));
     }
     return GetTransformedArrayNDIterable(std::move(value), chunk_transform,
                                          arena);
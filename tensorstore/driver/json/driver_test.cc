@@ -228,6 +228,53 @@ TEST(JsonDriverTest, InvalidJson) {
                             "Error reading \"path\\.json\": Invalid JSON"));
 }
 
+TEST(JsonDriverTest, ReadSubValue) {
+  auto context = tensorstore::Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto kvs, tensorstore::kvstore::Open(GetKvstoreSpec(), context).result());
+  TENSORSTORE_EXPECT_OK(kvstore::Write(
+      kvs, GetPath(),
+      absl::Cord(R"({"a": {"b": [1, {"c": 2}]}, "d": [1, 2 x]})")));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store_c, tensorstore::Open(GetSpec("/a/b/1/c"), context).result());
+  EXPECT_THAT(tensorstore::Read(store_c).result(),
+              Optional(MakeScalarArray<::nlohmann::json>(2)));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store_b, tensorstore::Open(GetSpec("/a/b"), context).result());
+  EXPECT_THAT(tensorstore::Read(store_b).result(),
+              Optional(MakeScalarArray<::nlohmann::json>({1, {{"c", 2}}})));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store_d, tensorstore::Open(GetSpec("/d"), context).result());
+  EXPECT_THAT(tensorstore::Read(store_d).result(),
+              MatchesStatus(absl::StatusCode::kFailedPrecondition,
+                            "Error reading \"path\\.json\": Invalid JSON"));
+}
+
+TEST(JsonDriverTest, WritePreservesFormatting) {
+  auto context = tensorstore::Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto kvs, tensorstore::kvstore::Open(GetKvstoreSpec(), context).result());
+  TENSORSTORE_EXPECT_OK(kvstore::Write(
+      kvs, GetPath(), absl::Cord("{\n  \"a\": 1,\n  \"b\": [1, 2]\n}")));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, tensorstore::Open(GetSpec("/b/1"), context).result());
+  // Existing sub-values are replaced in place.
+  TENSORSTORE_EXPECT_OK(
+      tensorstore::Write(MakeScalarArray<::nlohmann::json>(42), store));
+  EXPECT_THAT(
+      GetMap(kvs).value(),
+      testing::ElementsAre(Pair(
+          GetPath(), absl::Cord("{\n  \"a\": 1,\n  \"b\": [1, 42]\n}"))));
+  // Adding a member requires the document to be re-encoded.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store_c, tensorstore::Open(GetSpec("/c"), context).result());
+  TENSORSTORE_EXPECT_OK(
+      tensorstore::Write(MakeScalarArray<::nlohmann::json>(true), store_c));
+  EXPECT_THAT(GetMap(kvs).value(),
+              testing::ElementsAre(Pair(
+                  GetPath(), absl::Cord(R"({"a":1,"b":[1,42],"c":true})"))));
+}
+
 TEST(JsonDriverTest, InvalidSpec) {
   auto json_spec = GetSpec("foo");
   EXPECT_THAT(tensorstore::Spec::FromJson(json_spec),
@@ -14,12 +14,19 @@
 
 #include "tensorstore/driver/json/json_change_map.h"
 
+#include <stddef.h>
+
+#include <algorithm>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include "absl/container/btree_map.h"
 #include <nlohmann/json.hpp>
+#include "tensorstore/driver/json/json_scanner.h"
+#include "tensorstore/internal/json/same.h"
 #include "tensorstore/internal/json_pointer.h"
 #include "tensorstore/util/status.h"
 
@@ -126,6 +133,39 @@ bool JsonChangeMap::CanApplyUnconditionally(
   return false;
 }
 
+std::optional<std::string> JsonChangeMap::ApplyToEncoded(
+    std::string_view existing) const {
+  // The remainder of `existing` is copied verbatim, and must therefore be
+  // validated.  This is still much cheaper than parsing it.
+  if (!::nlohmann::json::accept(existing)) return std::nullopt;
+  std::vector<std::pair<JsonValueSpan, std::string>> replacements;
+  for (const auto& [sub_value_pointer, new_value] : map_) {
+    if (new_value.is_discarded()) return std::nullopt;
+    auto span = FindJsonSubValue(existing, sub_value_pointer);
+    if (!span) return std::nullopt;
+    auto old_value = ::nlohmann::json::parse(
+        existing.substr(span->begin, span->end - span->begin), nullptr,
+        /*allow_exceptions=*/false);
+    if (internal_json::JsonSame(old_value, new_value)) continue;
+    replacements.emplace_back(*span, new_value.dump());
+  }
+  // Changed sub-values are disjoint, since the map is normalized, but are not
+  // necessarily in order of their position within `existing`.
+  std::sort(replacements.begin(), replacements.end(),
+            [](const auto& a, const auto& b) {
+              return a.first.begin < b.first.begin;
+            });
+  std::string result;
+  size_t pos = 0;
+  for (const auto& [span, encoded] : replacements) {
+    result.append(existing.substr(pos, span.begin - pos));
+    result.append(encoded);
+    pos = span.end;
+  }
+  result.append(existing.substr(pos));
+  return result;
+}
+
 absl::Status JsonChangeMap::AddChange(std::string_view sub_value_pointer,
                                       ::nlohmann::json sub_value) {
   auto it = map_.lower_bound(sub_value_pointer);
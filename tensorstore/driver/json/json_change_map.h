@@ -15,6 +15,7 @@
 #ifndef TENSORSTORE_DRIVER_JSON_JSON_CHANGE_MAP_H_
 #define TENSORSTORE_DRIVER_JSON_JSON_CHANGE_MAP_H_
 
+#include <optional>
 #include <string>
 #include <string_view>
 
@@ -76,6 +77,20 @@ class JsonChangeMap {
   /// (e.g. `discarded`) as `existing`.
   bool CanApplyUnconditionally(std::string_view sub_value_pointer) const;
 
+  /// Applies this change map directly to the encoded JSON value `existing`, by
+  /// replacing the encoded representation of each changed sub-value.
+  ///
+  /// This avoids parsing and re-encoding all of `existing` when the changes
+  /// only replace existing sub-values.  Changes that leave a sub-value the same
+  /// (according to `internal_json::JsonSame`) are skipped, such that the
+  /// result is equal to `existing` if the changes have no effect.
+  ///
+  /// \returns The encoded result, or `std::nullopt` if `existing` is not valid
+  ///     JSON or some change does not simply replace an existing sub-value
+  ///     (e.g. it adds or removes a member).  In that case, `Apply` must be
+  ///     used instead.
+  std::optional<std::string> ApplyToEncoded(std::string_view existing) const;
+
   /// Adds a change to the map.
   ///
   /// \param sub_value_pointer JSON Pointer specifying path to modify.
@@ -14,6 +14,8 @@
 
 #include "tensorstore/driver/json/json_change_map.h"
 
+#include <optional>
+#include <string>
 #include <string_view>
 
 #include <gmock/gmock.h>
@@ -198,4 +200,33 @@ TEST(JsonChangeMapTest, CanApplyUnconditionally) {
   EXPECT_TRUE(changes.CanApplyUnconditionally("/a"));
 }
 
+TEST(JsonChangeMapTest, ApplyToEncodedReplacesSubValues) {
+  JsonChangeMap changes;
+  TENSORSTORE_EXPECT_OK(changes.AddChange("/b", {{"x", 1}}));
+  TENSORSTORE_EXPECT_OK(changes.AddChange("/a/1", "new"));
+  // Formatting of unchanged portions is preserved.
+  EXPECT_THAT(changes.ApplyToEncoded(R"({ "b": false,  "a": [1, 2] })"),
+              Optional(std::string(R"({ "b": {"x":1},  "a": [1, "new"] })")));
+}
+
+TEST(JsonChangeMapTest, ApplyToEncodedUnchanged) {
+  JsonChangeMap changes;
+  TENSORSTORE_EXPECT_OK(changes.AddChange("/a", 42));
+  EXPECT_THAT(changes.ApplyToEncoded(R"({"a": 42.0})"),
+              Optional(std::string(R"({"a": 42.0})")));
+}
+
+TEST(JsonChangeMapTest, ApplyToEncodedNotPossible) {
+  JsonChangeMap changes;
+  TENSORSTORE_EXPECT_OK(changes.AddChange("/a", 42));
+  // New member.
+  EXPECT_EQ(std::nullopt, changes.ApplyToEncoded(R"({"b": 1})"));
+  // Invalid JSON.
+  EXPECT_EQ(std::nullopt, changes.ApplyToEncoded(R"({"a": 1} x)"));
+  // Deletion.
+  TENSORSTORE_EXPECT_OK(
+      changes.AddChange("/a", ::nlohmann::json::value_t::discarded));
+  EXPECT_EQ(std::nullopt, changes.ApplyToEncoded(R"({"a": 1})"));
+}
+
 }  // namespace
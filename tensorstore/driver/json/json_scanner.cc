@@ -0,0 +1,210 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/driver/json/json_scanner.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <cassert>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/numbers.h"
+#include <nlohmann/json.hpp>
+
+namespace tensorstore {
+namespace internal_json_driver {
+namespace {
+
+size_t SkipWhitespace(std::string_view text, size_t pos) {
+  while (pos < text.size()) {
+    const char c = text[pos];
+    if (c != ' ' && c != '\t' && c != '\n' && c != '\r') break;
+    ++pos;
+  }
+  return pos;
+}
+
+/// Returns the position just past the string starting at `pos`.
+std::optional<size_t> SkipString(std::string_view text, size_t pos) {
+  assert(text[pos] == '"');
+  for (++pos; pos < text.size(); ++pos) {
+    const char c = text[pos];
+    if (c == '\\') {
+      ++pos;
+    } else if (c == '"') {
+      return pos + 1;
+    }
+  }
+  return std::nullopt;
+}
+
+/// Returns the position just past the value starting at `pos`.
+std::optional<size_t> SkipValue(std::string_view text, size_t pos) {
+  if (pos >= text.size()) return std::nullopt;
+  char c = text[pos];
+  if (c == '"') return SkipString(text, pos);
+  if (c == '{' || c == '[') {
+    // Closing brackets expected for the enclosing objects and arrays.
+    std::string closers;
+    while (pos < text.size()) {
+      c = text[pos];
+      switch (c) {
+        case '"': {
+          auto end = SkipString(text, pos);
+          if (!end) return std::nullopt;
+          pos = *end;
+          continue;
+        }
+        case '{':
+          closers.push_back('}');
+          break;
+        case '[':
+          closers.push_back(']');
+          break;
+        case '}':
+        case ']':
+          if (closers.empty() || closers.back() != c) return std::nullopt;
+          closers.pop_back();
+          if (closers.empty()) return pos + 1;
+          break;
+      }
+      ++pos;
+    }
+    return std::nullopt;
+  }
+  if (c != '-' && !absl::ascii_isdigit(c) && c != 't' && c != 'f' &&
+      c != 'n') {
+    return std::nullopt;
+  }
+  while (pos < text.size()) {
+    c = text[pos];
+    if (c == ',' || c == ']' || c == '}' || c == ' ' || c == '\t' ||
+        c == '\n' || c == '\r') {
+      break;
+    }
+    ++pos;
+  }
+  return pos;
+}
+
+/// Decodes a JSON Pointer reference token, replacing "~1" with "/" and "~0"
+/// with "~".
+void DecodeReferenceToken(std::string_view encoded, std::string& decoded) {
+  decoded.clear();
+  decoded.reserve(encoded.size());
+  for (size_t i = 0; i < encoded.size(); ++i) {
+    const char c = encoded[i];
+    if (c == '~' && i + 1 < encoded.size()) {
+      decoded += (encoded[++i] == '0') ? '~' : '/';
+    } else {
+      decoded += c;
+    }
+  }
+}
+
+/// Returns `true` if the encoded JSON string `quoted` is equal to `key`.
+bool KeyEquals(std::string_view quoted, std::string_view key) {
+  std::string_view raw = quoted.substr(1, quoted.size() - 2);
+  if (raw.find('\\') == std::string_view::npos) return raw == key;
+  auto decoded = ::nlohmann::json::parse(quoted, nullptr,
+                                         /*allow_exceptions=*/false);
+  return decoded.is_string() &&
+         decoded.get_ref<const std::string&>() == key;
+}
+
+/// Returns the position of the value of the last member named `key` of the
+/// object starting at `pos`.
+std::optional<size_t> FindObjectMember(std::string_view text, size_t pos,
+                                       std::string_view key) {
+  std::optional<size_t> found;
+  pos = SkipWhitespace(text, pos + 1);
+  if (pos < text.size() && text[pos] == '}') return std::nullopt;
+  while (true) {
+    if (pos >= text.size() || text[pos] != '"') return std::nullopt;
+    auto key_end = SkipString(text, pos);
+    if (!key_end) return std::nullopt;
+    const bool match = KeyEquals(text.substr(pos, *key_end - pos), key);
+    pos = SkipWhitespace(text, *key_end);
+    if (pos >= text.size() || text[pos] != ':') return std::nullopt;
+    pos = SkipWhitespace(text, pos + 1);
+    if (match) found = pos;
+    auto value_end = SkipValue(text, pos);
+    if (!value_end) return std::nullopt;
+    pos = SkipWhitespace(text, *value_end);
+    if (pos >= text.size()) return std::nullopt;
+    if (text[pos] == '}') return found;
+    if (text[pos] != ',') return std::nullopt;
+    pos = SkipWhitespace(text, pos + 1);
+  }
+}
+
+/// Returns the position of the element at index `token` of the array starting
+/// at `pos`.
+std::optional<size_t> FindArrayElement(std::string_view text, size_t pos,
+                                       std::string_view token) {
+  size_t index;
+  if (token.empty() || (token.size() > 1 && token[0] == '0') ||
+      !std::all_of(token.begin(), token.end(),
+                   [](char c) { return absl::ascii_isdigit(c); }) ||
+      !absl::SimpleAtoi(token, &index)) {
+    return std::nullopt;
+  }
+  pos = SkipWhitespace(text, pos + 1);
+  if (pos < text.size() && text[pos] == ']') return std::nullopt;
+  for (size_t i = 0;; ++i) {
+    if (i == index) return pos;
+    auto value_end = SkipValue(text, pos);
+    if (!value_end) return std::nullopt;
+    pos = SkipWhitespace(text, *value_end);
+    if (pos >= text.size() || text[pos] != ',') return std::nullopt;
+    pos = SkipWhitespace(text, pos + 1);
+  }
+}
+
+}  // namespace
+
+std::optional<JsonValueSpan> FindJsonSubValue(std::string_view text,
+                                              std::string_view json_pointer) {
+  size_t pos = SkipWhitespace(text, 0);
+  std::string token;
+  for (size_t i = 0; i < json_pointer.size();) {
+    assert(json_pointer[i] == '/');
+    size_t token_end = json_pointer.find('/', i + 1);
+    if (token_end == std::string_view::npos) token_end = json_pointer.size();
+    DecodeReferenceToken(json_pointer.substr(i + 1, token_end - i - 1), token);
+    i = token_end;
+    if (pos >= text.size()) return std::nullopt;
+    std::optional<size_t> value_pos;
+    if (text[pos] == '{') {
+      value_pos = FindObjectMember(text, pos, token);
+    } else if (text[pos] == '[') {
+      value_pos = FindArrayElement(text, pos, token);
+    }
+    if (!value_pos) return std::nullopt;
+    pos = *value_pos;
+  }
+  auto end = SkipValue(text, pos);
+  if (!end) return std::nullopt;
+  if (json_pointer.empty() && SkipWhitespace(text, *end) != text.size()) {
+    return std::nullopt;
+  }
+  return JsonValueSpan{pos, *end};
+}
+
+}  // namespace internal_json_driver
+}  // namespace tensorstore
@@ -0,0 +1,65 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_DRIVER_JSON_JSON_SCANNER_H_
+#define TENSORSTORE_DRIVER_JSON_JSON_SCANNER_H_
+
+/// \file
+///
+/// Locates sub-values within encoded JSON text without parsing the entire
+/// document.
+
+#include <stddef.h>
+
+#include <optional>
+#include <string_view>
+
+namespace tensorstore {
+namespace internal_json_driver {
+
+/// Byte range `[begin, end)` of an encoded JSON value.
+struct JsonValueSpan {
+  size_t begin;
+  size_t end;
+
+  friend bool operator==(const JsonValueSpan& a, const JsonValueSpan& b) {
+    return a.begin == b.begin && a.end == b.end;
+  }
+  friend bool operator!=(const JsonValueSpan& a, const JsonValueSpan& b) {
+    return !(a == b);
+  }
+};
+
+/// Returns the byte range within `text` of the sub-value referred to by
+/// `json_pointer`.
+///
+/// Only the structure of the objects and arrays along the path to the
+/// sub-value is examined; values that are skipped over are checked only for
+/// balanced brackets and terminated strings.  Consistent with
+/// `::nlohmann::json::parse`, if an object contains duplicate members the last
+/// one is used.
+///
+/// \param text Encoded JSON document.
+/// \param json_pointer Valid JSON Pointer.
+/// \returns The byte range of the sub-value, or `std::nullopt` if it does not
+///     exist, a reference token is not applicable to the value it refers into,
+///     or malformed JSON is encountered.  In those cases the caller should
+///     parse the whole document in order to obtain a precise error.
+std::optional<JsonValueSpan> FindJsonSubValue(std::string_view text,
+                                              std::string_view json_pointer);
+
+}  // namespace internal_json_driver
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_DRIVER_JSON_JSON_SCANNER_H_
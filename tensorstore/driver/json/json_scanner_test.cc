@@ -0,0 +1,94 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/driver/json/json_scanner.h"
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+using ::tensorstore::internal_json_driver::FindJsonSubValue;
+
+/// Returns the encoded sub-value found by `FindJsonSubValue`.
+std::optional<std::string> Find(std::string_view text,
+                                std::string_view json_pointer) {
+  auto span = FindJsonSubValue(text, json_pointer);
+  if (!span) return std::nullopt;
+  return std::string(text.substr(span->begin, span->end - span->begin));
+}
+
+TEST(FindJsonSubValueTest, Root) {
+  EXPECT_EQ("42", Find(" 42 ", ""));
+  EXPECT_EQ("{\"a\": 1}", Find("\n{\"a\": 1}\n", ""));
+  EXPECT_EQ(std::nullopt, Find("42 x", ""));
+  EXPECT_EQ(std::nullopt, Find("", ""));
+}
+
+TEST(FindJsonSubValueTest, ObjectMembers) {
+  constexpr std::string_view kText =
+      R"({"a": [1, {"x": "}]"}], "b" : {"c": null, "d": -1.5e3},)"
+      R"( "e": "s\"t", "f/g": true, "h~i": false})";
+  EXPECT_EQ(R"([1, {"x": "}]"}])", Find(kText, "/a"));
+  EXPECT_EQ(R"({"c": null, "d": -1.5e3})", Find(kText, "/b"));
+  EXPECT_EQ("null", Find(kText, "/b/c"));
+  EXPECT_EQ("-1.5e3", Find(kText, "/b/d"));
+  EXPECT_EQ(R"("s\"t")", Find(kText, "/e"));
+  EXPECT_EQ("true", Find(kText, "/f~1g"));
+  EXPECT_EQ("false", Find(kText, "/h~0i"));
+  EXPECT_EQ(std::nullopt, Find(kText, "/z"));
+  EXPECT_EQ(std::nullopt, Find(kText, "/b/z"));
+}
+
+TEST(FindJsonSubValueTest, EscapedKey) {
+  EXPECT_EQ("1", Find(R"({"a": 1})", "/a"));
+  EXPECT_EQ("2", Find(R"({"a\"b": 2})", "/a\"b"));
+}
+
+TEST(FindJsonSubValueTest, DuplicateKeys) {
+  // Consistent with `::nlohmann::json::parse`, the last member is used.
+  EXPECT_EQ("2", Find(R"({"a": 1, "a": 2})", "/a"));
+}
+
+TEST(FindJsonSubValueTest, ArrayElements) {
+  constexpr std::string_view kText = R"([10, [20, 21], {"x": 30}])";
+  EXPECT_EQ("10", Find(kText, "/0"));
+  EXPECT_EQ("21", Find(kText, "/1/1"));
+  EXPECT_EQ("30", Find(kText, "/2/x"));
+  EXPECT_EQ(std::nullopt, Find(kText, "/3"));
+  EXPECT_EQ(std::nullopt, Find(kText, "/-"));
+  EXPECT_EQ(std::nullopt, Find(kText, "/01"));
+  EXPECT_EQ(std::nullopt, Find(kText, "/x"));
+  EXPECT_EQ(std::nullopt, Find("[]", "/0"));
+}
+
+TEST(FindJsonSubValueTest, NotApplicable) {
+  EXPECT_EQ(std::nullopt, Find(R"({"a": 5})", "/a/b"));
+  EXPECT_EQ(std::nullopt, Find(R"({"a": "xyz"})", "/a/0"));
+}
+
+TEST(FindJsonSubValueTest, Malformed) {
+  EXPECT_EQ(std::nullopt, Find(R"({"a": [1, 2}, "b": 3})", "/b"));
+  EXPECT_EQ(std::nullopt, Find(R"({"a": "unterminated)", "/a"));
+  EXPECT_EQ(std::nullopt, Find(R"({"a" 1})", "/a"));
+  EXPECT_EQ(std::nullopt, Find(R"({"a": 1 "b": 2})", "/b"));
+  EXPECT_EQ(std::nullopt, Find(R"({"a": 1)", "/a"));
+  EXPECT_EQ(std::nullopt, Find(R"({"a": x})", "/a"));
+}
+
+}  // namespace
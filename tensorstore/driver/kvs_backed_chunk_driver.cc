@@ -25,10 +25,12 @@
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_set.h"
 #include "absl/log/absl_log.h"
 #include "absl/meta/type_traits.h"
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
+#include "absl/strings/strip.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "tensorstore/batch.h"
@@ -40,18 +42,24 @@
 #include "tensorstore/index.h"
 #include "tensorstore/index_interval.h"
 #include "tensorstore/index_space/index_transform.h"
+#include "tensorstore/internal/batch_window.h"
 #include "tensorstore/internal/box_difference.h"
 #include "tensorstore/internal/cache/async_cache.h"
 #include "tensorstore/internal/cache/async_initialized_cache_mixin.h"
 #include "tensorstore/internal/cache/cache.h"
 #include "tensorstore/internal/cache/cache_pool_resource.h"
 #include "tensorstore/internal/cache/chunk_cache.h"
+#include "tensorstore/internal/cache/chunk_summary.h"
+#include "tensorstore/internal/cache/encoded_value_cache.h"
 #include "tensorstore/internal/cache/kvs_backed_chunk_cache.h"
+#include "tensorstore/internal/cache_key/absl_time.h"  // IWYU pragma: keep
 #include "tensorstore/internal/cache_key/cache_key.h"
 #include "tensorstore/internal/cache_key/std_optional.h"  // IWYU pragma: keep
 #include "tensorstore/internal/chunk_grid_specification.h"
 #include "tensorstore/internal/data_copy_concurrency_resource.h"
+#include "tensorstore/internal/grid_partition_iterator.h"
 #include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/json_binding/absl_time.h"
 #include "tensorstore/internal/json_binding/bindable.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
 #include "tensorstore/internal/json_binding/staleness_bound.h"  // IWYU pragma: keep
@@ -59,12 +67,14 @@
 #include "tensorstore/internal/mutex.h"
 #include "tensorstore/internal/open_mode_spec.h"
 #include "tensorstore/internal/path.h"
+#include "tensorstore/internal/regular_grid.h"
 #include "tensorstore/internal/unowned_to_shared.h"
 #include "tensorstore/internal/uri_utils.h"
 #include "tensorstore/kvstore/driver.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/key_range.h"
 #include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/operations.h"
 #include "tensorstore/kvstore/spec.h"
 #include "tensorstore/open_mode.h"
 #include "tensorstore/open_options.h"
@@ -101,6 +111,12 @@ Result<IndexTransform<>> DataCacheBase::GetExternalToInternalTransform(
   return IndexTransform<>();
 }
 
+Future<const void> DataCacheBase::ListStoredChunks() {
+  return MakeReadyFuture();
+}
+
+void DataCacheBase::EnableChunkSummaries() {}
+
 MetadataOpenState::MetadataOpenState(Initializer initializer)
     : PrivateOpenState{std::move(initializer.request.transaction),
                        std::move(initializer.request.batch),
@@ -136,18 +152,53 @@ bool OpenState::DataCacheUsesMetadataCachePool(const void* metadata_ptr) {
 MetadataCache::MetadataCache(Initializer initializer)
     : Base(kvstore::DriverPtr()),
       data_copy_concurrency_(std::move(initializer.data_copy_concurrency)),
-      metadata_cache_pool_(std::move(initializer.cache_pool)) {}
+      metadata_cache_pool_(std::move(initializer.cache_pool)),
+      driver_id_(initializer.driver_id) {}
+
+std::string MetadataCache::DoGetMetricsLabel() {
+  if (driver_id_.empty()) return Base::DoGetMetricsLabel();
+  return tensorstore::StrCat(driver_id_, "/metadata");
+}
 
 DataCacheBase::DataCacheBase(Initializer&& initializer)
     : metadata_cache_entry_(std::move(initializer.metadata_cache_entry)),
       initial_metadata_(std::move(initializer.metadata)),
-      cache_pool_(std::move(initializer.cache_pool)) {}
+      cache_pool_(std::move(initializer.cache_pool)),
+      encoded_cache_pool_(std::move(initializer.encoded_cache_pool)),
+      prefetch_options_(initializer.prefetch),
+      write_combining_options_(initializer.write_combining),
+      chunk_buffer_pool_(std::move(initializer.chunk_buffer_pool)),
+      read_batch_window_(std::move(initializer.read_batch_window)) {}
 
 DataCache::DataCache(Initializer&& initializer,
                      internal::ChunkGridSpecification&& grid)
     : KvsBackedChunkCache(std::move(initializer.store)),
       ChunkedDataCacheBase(std::move(initializer)),
-      grid_(std::move(grid)) {}
+      grid_(std::move(grid)) {
+  if (encoded_cache_pool_) {
+    // Encoded chunks are keyed only by the kvstore, so that data caches for
+    // the same kvstore share encoded values.
+    std::string cache_key;
+    kvstore_driver()->EncodeCacheKey(&cache_key);
+    SetEncodedValueCache(internal::GetCache<internal::EncodedValueCache>(
+        (*encoded_cache_pool_)->get(), cache_key,
+        [] { return std::make_unique<internal::EncodedValueCache>(); }));
+  }
+  SetPrefetchOptions(prefetch_options_);
+  SetWriteCombiningOptions(DataCacheBase::write_combining_options_);
+  if (chunk_buffer_pool_) {
+    for (auto& component : grid_.components) {
+      component.array_spec.buffer_pool = **chunk_buffer_pool_;
+    }
+  }
+}
+
+std::string DataCache::DoGetMetricsLabel() {
+  // Labeled by both the TensorStore driver and the kvstore driver, e.g.
+  // "zarr3/file".
+  return tensorstore::StrCat(metadata_cache()->driver_id(), "/",
+                             KvsBackedChunkCache::DoGetMetricsLabel());
+}
 
 namespace {
 
@@ -425,6 +476,25 @@ Result<ChunkLayout> ChunkedDataCacheBase::GetChunkLayout(
   return GetChunkLayoutFromMetadata(initial_metadata_.get(), component_index);
 }
 
+Future<const void> ChunkedDataCacheBase::DeleteCells(
+    BoxView<> cell_bounds, BoxView<> grid_bounds,
+    internal::OpenTransactionPtr transaction) {
+  auto pair = PromiseFuturePair<void>::Make(MakeResult(absl::Status()));
+  pair.future.Force();
+  IterateOverIndexRange(cell_bounds, [&](span<const Index> cell_indices) {
+    LinkError(pair.promise, DeleteCell(cell_indices, transaction));
+  });
+  return pair.future;
+}
+
+Future<std::vector<IndexTransform<>>>
+ChunkedDataCacheBase::GetChunksInValueRange(IndexTransform<> transform,
+                                            size_t component_index,
+                                            internal::ValueRange range,
+                                            absl::Time staleness_bound) {
+  return absl::UnimplementedError("Chunk summaries not supported");
+}
+
 Future<IndexTransform<>> KvsMetadataDriverBase::ResolveBounds(
     ResolveBoundsRequest request) {
   return ResolveBounds(std::move(request), metadata_staleness_bound_);
@@ -590,9 +660,8 @@ Future<const void> DeleteChunksForResize(
   Box<dynamic_rank(internal::kNumInlinedDims)> part(rank);
   for (Index box_i = 0; box_i < box_difference.num_sub_boxes(); ++box_i) {
     box_difference.GetSubBox(box_i, part);
-    IterateOverIndexRange(part, [&](span<const Index> cell_indices) {
-      LinkError(pair.promise, cache->DeleteCell(cell_indices, transaction));
-    });
+    LinkError(pair.promise,
+              cache->DeleteCells(part, current_grid_bounds, transaction));
   }
   return pair.future;
 }
@@ -702,6 +771,18 @@ Future<IndexTransform<>> KvsChunkedDriverBase::Resize(
   return std::move(pair.future);
 }
 
+Future<std::vector<IndexTransform<>>>
+KvsChunkedDriverBase::GetChunksInValueRange(
+    GetChunksInValueRangeRequest request) {
+  if (request.transaction) {
+    return absl::UnimplementedError(
+        "Chunk summaries not supported with transactions");
+  }
+  return cache()->GetChunksInValueRange(
+      std::move(request.transform), component_index(), request.range,
+      data_staleness_bound().time);
+}
+
 Result<IndexTransform<>> KvsMetadataDriverBase::GetBoundSpecData(
     internal::OpenTransactionPtr transaction, KvsDriverSpec& spec,
     IndexTransformView<> transform_view) {
@@ -716,12 +797,20 @@ Result<IndexTransform<>> KvsMetadataDriverBase::GetBoundSpecData(
   if (spec.cache_pool != metadata_cache->metadata_cache_pool_) {
     spec.metadata_cache_pool = metadata_cache->metadata_cache_pool_;
   }
+  spec.encoded_cache_pool = cache->encoded_cache_pool_;
+  spec.prefetch = cache->prefetch_options_;
+  spec.write_combining = cache->write_combining_options_;
+  spec.chunk_buffer_pool = cache->chunk_buffer_pool_;
+  spec.read_batch_window = cache->read_batch_window_;
   spec.delete_existing = false;
   spec.open = true;
   spec.create = false;
   spec.assume_metadata = assumed_metadata_time_ == absl::InfiniteFuture();
   spec.staleness.metadata = this->metadata_staleness_bound();
   spec.staleness.data = this->data_staleness_bound();
+  spec.missing_data_staleness = this->missing_data_staleness_bound();
+  spec.list_chunks_on_open = list_chunks_on_open_;
+  spec.chunk_summaries = chunk_summaries_;
   spec.schema.Set(RankConstraint{this->rank()}).IgnoreError();
   spec.schema.Set(this->dtype()).IgnoreError();
 
@@ -797,6 +886,12 @@ KvStore KvsMetadataDriverBase::GetKvstore(const Transaction& transaction) {
                  cache->GetBaseKvstorePath(), transaction};
 }
 
+Batch KvsMetadataDriverBase::GetReadBatch(Batch batch) const {
+  const auto& window = this->cache()->read_batch_window_;
+  return internal::GetBatchOrWindow(std::move(batch),
+                                    window ? (*window)->get() : nullptr);
+}
+
 namespace {
 /// Validates that the open request specified by `state` can be applied to
 /// `metadata`.
@@ -841,7 +936,18 @@ Result<internal::Driver::Handle> CreateTensorStoreFromMetadata(
                                // `true`. Note that the metadata cache is
                                // already implicitly part of the key due to the
                                // inclusion of `metadata_cache_entry_`.
-                               state->cache_pool()->get());
+                               state->cache_pool()->get(),
+                               state->encoded_cache_pool()
+                                   ? (*state->encoded_cache_pool())->get()
+                                   : nullptr,
+                               state->prefetch_options(),
+                               state->write_combining_options(),
+                               state->chunk_buffer_pool()
+                                   ? (*state->chunk_buffer_pool())->get()
+                                   : nullptr,
+                               state->read_batch_window()
+                                   ? (*state->read_batch_window())->get()
+                                   : nullptr);
     }
   }
   absl::Status data_key_value_store_status;
@@ -864,6 +970,11 @@ Result<internal::Driver::Handle> CreateTensorStoreFromMetadata(
         initializer.metadata_cache_entry = base.metadata_cache_entry_;
         initializer.metadata = metadata;
         initializer.cache_pool = state->cache_pool();
+        initializer.encoded_cache_pool = state->encoded_cache_pool();
+        initializer.prefetch = state->prefetch_options();
+        initializer.write_combining = state->write_combining_options();
+        initializer.chunk_buffer_pool = state->chunk_buffer_pool();
+        initializer.read_batch_window = state->read_batch_window();
         return state->GetDataCache(std::move(initializer));
       });
   TENSORSTORE_RETURN_IF_ERROR(data_key_value_store_status);
@@ -905,6 +1016,11 @@ Result<internal::Driver::Handle> CreateTensorStoreFromMetadata(
       state->AllocateDriver(std::move(initializer)), read_write_mode);
   driver->metadata_staleness_bound_ =
       base.spec_->staleness.metadata.BoundAtOpen(base.request_time_);
+  driver->missing_data_staleness_bound_ =
+      base.spec_->missing_data_staleness.BoundAtOpen(base.request_time_);
+  driver->list_chunks_on_open_ = base.spec_->list_chunks_on_open;
+  driver->chunk_summaries_ = base.spec_->chunk_summaries;
+  if (driver->chunk_summaries_) data_cache->EnableChunkSummaries();
   driver->fill_value_mode_ = base.spec_->fill_value_mode;
   if (base.spec_->assume_metadata || base.spec_->assume_cached_metadata) {
     driver->assumed_metadata_ = metadata;
@@ -1193,6 +1309,17 @@ std::string MetadataCache::Entry::GetKeyValueStoreKey() {
   return GetOwningCache(*this).GetMetadataStorageKey(this->key());
 }
 
+size_t MetadataCache::Entry::ComputeReadDataSizeInBytes(const void* read_data) {
+  return GetOwningCache(*this).EstimateMetadataHeapUsage(this->key(),
+                                                         read_data);
+}
+
+size_t MetadataCache::EstimateMetadataHeapUsage(std::string_view entry_key,
+                                                const void* metadata) {
+  auto encoded = EncodeMetadata(entry_key, metadata);
+  return encoded.ok() ? encoded->size() : 0;
+}
+
 void MetadataCache::TransactionNode::DoApply(ApplyOptions options,
                                              ApplyReceiver receiver) {
   if (this->pending_writes.empty()) {
@@ -1267,6 +1394,70 @@ Future<const void> DataCache::DeleteCell(
                                           std::move(transaction));
 }
 
+Future<const void> DataCache::ListStoredChunks() {
+  auto range = KeyRange::Prefix(GetBaseKvstorePath());
+  key_presence().BeginListing();
+  const absl::Time time = absl::Now();
+  kvstore::ListOptions options;
+  options.range = range;
+  return MapFutureValue(
+      InlineExecutor{},
+      [self = internal::CachePtr<DataCache>(this), range = std::move(range),
+       time](const std::vector<kvstore::ListEntry>& entries) {
+        absl::flat_hash_set<std::string> keys;
+        keys.reserve(entries.size());
+        for (const auto& entry : entries) {
+          keys.insert(entry.key);
+        }
+        self->key_presence().SetListing(std::move(range), std::move(keys),
+                                        time);
+        return MakeResult();
+      },
+      kvstore::ListFuture(kvstore_driver(), std::move(options)));
+}
+
+std::string DataCache::GetChunkSummaryKey(span<const Index> cell_indices) {
+  const std::string base_path = GetBaseKvstorePath();
+  const std::string chunk_key =
+      static_cast<internal::KvsBackedChunkCache&>(*this).GetChunkStorageKey(
+          cell_indices);
+  std::string_view key_suffix = chunk_key;
+  absl::ConsumePrefix(&key_suffix, base_path);
+  return tensorstore::StrCat(base_path, ".chunk_summary/", key_suffix);
+}
+
+Future<std::vector<IndexTransform<>>> DataCache::GetChunksInValueRange(
+    IndexTransform<> transform, size_t component_index,
+    internal::ValueRange range, absl::Time staleness_bound) {
+  const auto& component = grid_.components[component_index];
+  std::vector<IndexTransform<>> cell_transforms;
+  std::vector<Future<bool>> futures;
+  internal_grid_partition::RegularGridRef regular_grid{grid_.chunk_shape};
+  internal_grid_partition::PartitionIndexTransformIterator iterator(
+      component.chunked_to_cell_dimensions, regular_grid, transform);
+  TENSORSTORE_RETURN_IF_ERROR(iterator.Init());
+  for (; !iterator.AtEnd(); iterator.Advance()) {
+    cell_transforms.emplace_back(iterator.cell_transform());
+    futures.push_back(ChunkMayContainValueInRange(
+        iterator.output_grid_cell_indices(), component_index, range,
+        staleness_bound));
+  }
+  auto all_done = WaitAllFuture(span<const Future<bool>>(futures));
+  return MapFuture(
+      InlineExecutor{},
+      [cell_transforms = std::move(cell_transforms),
+       futures = std::move(futures)](const Result<void>&) mutable
+      -> Result<std::vector<IndexTransform<>>> {
+        std::vector<IndexTransform<>> result;
+        for (size_t i = 0; i < futures.size(); ++i) {
+          TENSORSTORE_ASSIGN_OR_RETURN(bool may_contain, futures[i].result());
+          if (may_contain) result.push_back(std::move(cell_transforms[i]));
+        }
+        return result;
+      },
+      std::move(all_done));
+}
+
 namespace {
 /// Returns the metadata cache for `state`, creating it if it doesn't already
 /// exist.
@@ -1291,7 +1482,8 @@ internal::CachePtr<MetadataCache> GetOrCreateMetadataCache(
         ABSL_LOG_IF(INFO, TENSORSTORE_KVS_DRIVER_DEBUG)
             << "Creating metadata cache: open_state=" << state;
         return state->GetMetadataCache(
-            {base.spec_->data_copy_concurrency, state->metadata_cache_pool()});
+            {base.spec_->data_copy_concurrency, state->metadata_cache_pool(),
+             base.spec_->GetId()});
       },
       [&](Promise<void> initialized,
           internal::CachePtr<MetadataCache> metadata_cache) {
@@ -1325,6 +1517,30 @@ Result<internal::Driver::Handle> OpenState::CreateDriverHandleFromMetadata(
                                        std::move(metadata), component_index);
 }
 
+namespace {
+/// Returns the handle from `future` once the stored chunks have been listed.
+Future<internal::Driver::Handle> ListStoredChunksAfterOpen(
+    Future<internal::Driver::Handle> future) {
+  return PromiseFuturePair<internal::Driver::Handle>::LinkValue(
+             [](Promise<internal::Driver::Handle> promise,
+                ReadyFuture<internal::Driver::Handle> future) {
+               auto handle = future.value();
+               auto* driver = static_cast<KvsMetadataDriverBase*>(
+                   handle.driver.get().get());
+               auto list_future = driver->cache()->ListStoredChunks();
+               LinkValue(
+                   [handle = std::move(handle)](
+                       Promise<internal::Driver::Handle> promise,
+                       ReadyFuture<const void> future) mutable {
+                     promise.SetResult(std::move(handle));
+                   },
+                   std::move(promise), std::move(list_future));
+             },
+             std::move(future))
+      .future;
+}
+}  // namespace
+
 Future<internal::Driver::Handle> OpenDriver(MetadataOpenState::Ptr state) {
   ABSL_LOG_IF(INFO, TENSORSTORE_KVS_DRIVER_DEBUG)
       << "OpenDriver: open_state=" << state.get();
@@ -1340,10 +1556,13 @@ Future<internal::Driver::Handle> OpenDriver(MetadataOpenState::Ptr state) {
   auto metadata_cache = GetOrCreateMetadataCache(state_ptr);
   base.metadata_cache_entry_ =
       GetCacheEntry(metadata_cache, state->GetMetadataCacheEntryKey());
-  return PromiseFuturePair<internal::Driver::Handle>::LinkValue(
-             HandleKeyValueStoreReady{std::move(state)},
-             metadata_cache->initialized_)
-      .future;
+  const bool list_chunks = spec.list_chunks_on_open;
+  auto future = PromiseFuturePair<internal::Driver::Handle>::LinkValue(
+                    HandleKeyValueStoreReady{std::move(state)},
+                    metadata_cache->initialized_)
+                    .future;
+  if (!list_chunks) return future;
+  return ListStoredChunksAfterOpen(std::move(future));
 }
 
 Result<IndexTransform<>> ResolveBoundsFromMetadata(
@@ -1507,6 +1726,30 @@ TENSORSTORE_DEFINE_JSON_BINDER(
                    jb::Projection<&KvsDriverSpec::cache_pool>()),
         jb::Member("metadata_cache_pool",
                    jb::Projection<&KvsDriverSpec::metadata_cache_pool>()),
+        jb::Member("encoded_cache_pool",
+                   jb::Projection<&KvsDriverSpec::encoded_cache_pool>()),
+        jb::Member(
+            "prefetch",
+            jb::Projection<&KvsDriverSpec::prefetch>(
+                jb::DefaultInitializedValue(jb::Object(jb::Member(
+                    "depth",
+                    jb::Projection<&internal::ChunkPrefetchOptions::depth>(
+                        jb::DefaultInitializedValue(
+                            jb::Integer<Index>(0)))))))),
+        jb::Member(
+            "write_combining",
+            jb::Projection<&KvsDriverSpec::write_combining>(
+                jb::DefaultInitializedValue(jb::Object(jb::Member(
+                    "window",
+                    jb::Projection<
+                        &internal::ChunkWriteCombiningOptions::window>(
+                        jb::DefaultValue([](auto* obj) {
+                          *obj = absl::ZeroDuration();
+                        }))))))),
+        jb::Member("chunk_buffer_pool",
+                   jb::Projection<&KvsDriverSpec::chunk_buffer_pool>()),
+        jb::Member("read_batch_window",
+                   jb::Projection<&KvsDriverSpec::read_batch_window>()),
         jb::Projection<&KvsDriverSpec::store>(jb::KvStoreSpecAndPathJsonBinder),
         jb::Initialize([](auto* obj) {
           internal::EnsureDirectoryPath(obj->store.path);
@@ -1521,6 +1764,15 @@ TENSORSTORE_DEFINE_JSON_BINDER(
             jb::Member("recheck_cached_data",
                        jb::Projection(&StalenessBounds::data,
                                       jb::DefaultInitializedValue())))),
+        jb::Member("recheck_cached_missing_data",
+                   jb::Projection<&KvsDriverSpec::missing_data_staleness>(
+                       jb::DefaultInitializedValue())),
+        jb::Member("list_chunks_on_open",
+                   jb::Projection<&KvsDriverSpec::list_chunks_on_open>(
+                       jb::DefaultInitializedValue())),
+        jb::Member("chunk_summaries",
+                   jb::Projection<&KvsDriverSpec::chunk_summaries>(
+                       jb::DefaultInitializedValue())),
         jb::Projection<&KvsDriverSpec::fill_value_mode>(jb::Sequence(
             jb::Member("fill_missing_data_reads",
                        jb::Projection<&FillValueMode::fill_missing_data_reads>(
@@ -29,6 +29,7 @@
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
@@ -44,13 +45,17 @@
 #include "tensorstore/driver/registry.h"
 #include "tensorstore/index.h"
 #include "tensorstore/index_space/index_transform.h"
+#include "tensorstore/internal/batch_window_resource.h"
 #include "tensorstore/internal/cache/aggregate_writeback_cache.h"
 #include "tensorstore/internal/cache/async_cache.h"
 #include "tensorstore/internal/cache/async_initialized_cache_mixin.h"
 #include "tensorstore/internal/cache/cache.h"
 #include "tensorstore/internal/cache/cache_pool_resource.h"
+#include "tensorstore/internal/cache/chunk_cache.h"
+#include "tensorstore/internal/cache/chunk_summary.h"
 #include "tensorstore/internal/cache/kvs_backed_cache.h"
 #include "tensorstore/internal/cache/kvs_backed_chunk_cache.h"
+#include "tensorstore/internal/chunk_buffer_pool_resource.h"
 #include "tensorstore/internal/chunk_grid_specification.h"
 #include "tensorstore/internal/context_binding.h"
 #include "tensorstore/internal/data_copy_concurrency_resource.h"
@@ -102,8 +107,25 @@ struct KvsDriverSpec : public internal::DriverSpec,
   Context::Resource<internal::CachePoolResource> cache_pool;
   std::optional<Context::Resource<internal::CachePoolResource>>
       metadata_cache_pool;
+  std::optional<Context::Resource<internal::CachePoolResource>>
+      encoded_cache_pool;
+  internal::ChunkPrefetchOptions prefetch;
+  internal::ChunkWriteCombiningOptions write_combining;
+  std::optional<Context::Resource<internal::ChunkBufferPoolResource>>
+      chunk_buffer_pool;
+  std::optional<Context::Resource<internal::ReadBatchWindowResource>>
+      read_batch_window;
   StalenessBounds staleness;
+  /// Staleness bound for chunks known to be missing.  The effective bound is
+  /// the earlier of this and `staleness.data`.
+  StalenessBound missing_data_staleness;
   FillValueMode fill_value_mode;
+  /// List the stored chunks when opening, such that reads of chunks that are
+  /// not stored do not require individual requests.
+  bool list_chunks_on_open = false;
+  /// Write a summary of the values of each chunk alongside it, which allows
+  /// `GetChunksInValueRange` to skip chunks.
+  bool chunk_summaries = false;
 
   // Initialize from a URL with the specified base kvstore and
   // optional encoded path.
@@ -113,7 +135,10 @@ struct KvsDriverSpec : public internal::DriverSpec,
     return f(internal::BaseCast<internal::DriverSpec>(x),
              internal::BaseCast<internal::OpenModeSpec>(x), x.store,
              x.data_copy_concurrency, x.cache_pool, x.metadata_cache_pool,
-             x.staleness, x.fill_value_mode);
+             x.encoded_cache_pool, x.prefetch, x.write_combining,
+             x.chunk_buffer_pool, x.read_batch_window, x.staleness,
+             x.missing_data_staleness, x.fill_value_mode,
+             x.list_chunks_on_open, x.chunk_summaries);
   };
 
   kvstore::Spec GetKvstore() const override;
@@ -181,6 +206,9 @@ class MetadataCache
     Context::Resource<internal::DataCopyConcurrencyResource>
         data_copy_concurrency;
     Context::Resource<internal::CachePoolResource> cache_pool;
+    /// Identifier of the TensorStore driver, as returned by
+    /// `internal::DriverSpec::GetId`.  Used to label cache metrics.
+    std::string_view driver_id;
   };
 
   explicit MetadataCache(Initializer initializer);
@@ -209,6 +237,19 @@ class MetadataCache
   virtual Result<absl::Cord> EncodeMetadata(std::string_view entry_key,
                                             const void* metadata) = 0;
 
+  /// Estimates the heap memory used by decoded metadata, for cache size
+  /// accounting.
+  ///
+  /// The default implementation returns the size of the encoded
+  /// representation, which typically underestimates the decoded size by a
+  /// small constant factor.  Drivers with large metadata (e.g. many scales or
+  /// attributes) should override this using `internal::EstimateHeapUsage`.
+  ///
+  /// \param entry_key The metadata cache entry key.
+  /// \param metadata Non-null pointer to the metadata, of type `Metadata`.
+  virtual size_t EstimateMetadataHeapUsage(std::string_view entry_key,
+                                           const void* metadata);
+
   // The members below are implementation details not relevant to derived class
   // driver implementations.
 
@@ -249,6 +290,7 @@ class MetadataCache
     void DoEncode(EncodeOptions options, std::shared_ptr<const void> data,
                   EncodeReceiver receiver) override;
     std::string GetKeyValueStoreKey() override;
+    size_t ComputeReadDataSizeInBytes(const void* read_data) override;
 
     /// Requests an atomic metadata update.
     ///
@@ -306,6 +348,10 @@ class MetadataCache
 
   const Executor& executor() { return data_copy_concurrency_->executor; }
 
+  std::string_view driver_id() const { return driver_id_; }
+
+  std::string DoGetMetricsLabel() override;
+
   /// Key-value store from which `kvstore_driver()` was derived.  Used only by
   /// `GetBoundSpecData`.  A driver implementation may apply some type of
   /// adapter to the `kvstore_driver()` in order to retrieve metadata by
@@ -315,6 +361,7 @@ class MetadataCache
   Context::Resource<internal::DataCopyConcurrencyResource>
       data_copy_concurrency_;
   Context::Resource<internal::CachePoolResource> metadata_cache_pool_;
+  std::string_view driver_id_;
 };
 
 /// Abstract base class for `Cache` types that are used with
@@ -338,6 +385,14 @@ class DataCacheBase {
     internal::PinnedCacheEntry<MetadataCache> metadata_cache_entry;
     MetadataPtr metadata;
     Context::Resource<internal::CachePoolResource> cache_pool;
+    std::optional<Context::Resource<internal::CachePoolResource>>
+        encoded_cache_pool;
+    internal::ChunkPrefetchOptions prefetch;
+    internal::ChunkWriteCombiningOptions write_combining;
+    std::optional<Context::Resource<internal::ChunkBufferPoolResource>>
+        chunk_buffer_pool;
+    std::optional<Context::Resource<internal::ReadBatchWindowResource>>
+        read_batch_window;
   };
 
   explicit DataCacheBase(Initializer&& initializer);
@@ -418,6 +473,18 @@ class DataCacheBase {
   /// Returns the kvstore path to include in the spec.
   virtual std::string GetBaseKvstorePath() = 0;
 
+  /// Lists the chunks stored in the kvstore, such that subsequent reads of
+  /// chunks that are not stored need not be issued individually.
+  ///
+  /// By default, does nothing.
+  virtual Future<const void> ListStoredChunks();
+
+  /// Enables writing a summary of the values of each chunk after the chunk is
+  /// written back.
+  ///
+  /// By default, does nothing.
+  virtual void EnableChunkSummaries();
+
   MetadataCache* metadata_cache() const {
     return &GetOwningCache(*metadata_cache_entry_);
   }
@@ -433,6 +500,24 @@ class DataCacheBase {
   const internal::PinnedCacheEntry<MetadataCache> metadata_cache_entry_;
   const MetadataPtr initial_metadata_;
   Context::Resource<internal::CachePoolResource> cache_pool_;
+
+  /// Cache pool for encoded chunks, if enabled.
+  std::optional<Context::Resource<internal::CachePoolResource>>
+      encoded_cache_pool_;
+
+  /// Read-ahead options for chunks.
+  internal::ChunkPrefetchOptions prefetch_options_;
+
+  /// Options for combining partial writes to the same chunk.
+  internal::ChunkWriteCombiningOptions write_combining_options_;
+
+  /// Pool from which chunk arrays are allocated, if enabled.
+  std::optional<Context::Resource<internal::ChunkBufferPoolResource>>
+      chunk_buffer_pool_;
+
+  /// Window used to batch reads that do not specify a batch, if enabled.
+  std::optional<Context::Resource<internal::ReadBatchWindowResource>>
+      read_batch_window_;
 };
 
 /// Abstract base class for `Cache` types that are used with
@@ -509,6 +594,34 @@ class ChunkedDataCacheBase : public DataCacheBase {
   virtual Future<const void> DeleteCell(
       span<const Index> grid_cell_indices,
       internal::OpenTransactionPtr transaction) = 0;
+
+  /// Deletes all grid cells within `cell_bounds`.
+  ///
+  /// The default implementation calls `DeleteCell` for each cell.  Derived
+  /// classes may override this to delete contiguous ranges of keys at once.
+  ///
+  /// \param cell_bounds Grid cells to delete.
+  /// \param grid_bounds Current bounds of the chunk grid, which contain
+  ///     `cell_bounds`.
+  /// \param transaction Transaction, or null.
+  virtual Future<const void> DeleteCells(
+      BoxView<> cell_bounds, BoxView<> grid_bounds,
+      internal::OpenTransactionPtr transaction);
+
+  /// Returns the cell transforms (as computed by
+  /// `internal_grid_partition::PartitionIndexTransformIterator`) of the grid
+  /// cells intersecting the output range of `transform` whose stored values
+  /// of the specified component may lie within `range`.
+  ///
+  /// By default, fails with `kUnimplemented`.
+  ///
+  /// \param transform Transform to the index space of the component.
+  /// \param component_index The ChunkCache component index.
+  /// \param range The range of values.
+  /// \param staleness_bound Staleness bound for reading the chunk summaries.
+  virtual Future<std::vector<IndexTransform<>>> GetChunksInValueRange(
+      IndexTransform<> transform, size_t component_index,
+      internal::ValueRange range, absl::Time staleness_bound);
 };
 
 struct DataCacheInitializer : public ChunkedDataCacheBase::Initializer {
@@ -534,9 +647,26 @@ class DataCache : public internal::KvsBackedChunkCache,
 
   const internal::ChunkGridSpecification& grid() const final { return grid_; }
 
+  std::string DoGetMetricsLabel() override;
+
   Future<const void> DeleteCell(span<const Index> grid_cell_indices,
                                 internal::OpenTransactionPtr transaction) final;
 
+  /// Lists all keys under `GetBaseKvstorePath()`.
+  Future<const void> ListStoredChunks() override;
+
+  void EnableChunkSummaries() override {
+    internal::KvsBackedChunkCache::EnableChunkSummaries();
+  }
+
+  /// Stores chunk summaries under `GetBaseKvstorePath() + ".chunk_summary/"`,
+  /// which does not conflict with the chunk keys of any of the drivers.
+  std::string GetChunkSummaryKey(span<const Index> cell_indices) override;
+
+  Future<std::vector<IndexTransform<>>> GetChunksInValueRange(
+      IndexTransform<> transform, size_t component_index,
+      internal::ValueRange range, absl::Time staleness_bound) override;
+
   internal::ChunkGridSpecification grid_;
 };
 
@@ -607,6 +737,18 @@ class KvsMetadataDriverBase : public internal::Driver {
 
   virtual const StalenessBound& data_staleness_bound() const = 0;
 
+  /// Staleness bound for chunks known to be missing, which may be older than
+  /// `data_staleness_bound()`.
+  const StalenessBound& missing_data_staleness_bound() const {
+    return missing_data_staleness_bound_;
+  }
+
+  /// Returns the batch to use for a read request that specified `batch`.
+  ///
+  /// If `batch` is `no_batch` and `read_batch_window` was specified, returns
+  /// the batch of the current window.
+  Batch GetReadBatch(Batch batch) const;
+
   // Accessors for use by ChunkCacheReadWriteDriverMixin, if the derived class
   // happens to use it.
   bool fill_missing_data_reads() const {
@@ -620,6 +762,14 @@ class KvsMetadataDriverBase : public internal::Driver {
 
   StalenessBound metadata_staleness_bound_;
 
+  StalenessBound missing_data_staleness_bound_;
+
+  /// Whether the stored chunks were listed when opening.
+  bool list_chunks_on_open_ = false;
+
+  /// Whether chunk summaries were enabled when opening.
+  bool chunk_summaries_ = false;
+
   /// If `OpenMode::assume_metadata` or `OpenMode::assume_cached_metadata` was
   /// specified, set to the assumed metadata.  Otherwise, set to `nullptr`.
   std::shared_ptr<const void> assumed_metadata_;
@@ -644,6 +794,9 @@ class KvsChunkedDriverBase : public KvsMetadataDriverBase {
 
   Future<IndexTransform<>> Resize(
       internal::Driver::ResizeRequest request) override;
+
+  Future<std::vector<IndexTransform<>>> GetChunksInValueRange(
+      GetChunksInValueRangeRequest request) override;
 };
 
 using DriverInitializer = internal::ChunkCacheDriverInitializer<DataCacheBase>;
@@ -759,6 +912,24 @@ class MetadataOpenState
     return spec_->metadata_cache_pool ? *spec_->metadata_cache_pool
                                       : spec_->cache_pool;
   }
+  const std::optional<Context::Resource<internal::CachePoolResource>>&
+  encoded_cache_pool() const {
+    return spec_->encoded_cache_pool;
+  }
+  const internal::ChunkPrefetchOptions& prefetch_options() const {
+    return spec_->prefetch;
+  }
+  const internal::ChunkWriteCombiningOptions& write_combining_options() const {
+    return spec_->write_combining;
+  }
+  const std::optional<Context::Resource<internal::ChunkBufferPoolResource>>&
+  chunk_buffer_pool() const {
+    return spec_->chunk_buffer_pool;
+  }
+  const std::optional<Context::Resource<internal::ReadBatchWindowResource>>&
+  read_batch_window() const {
+    return spec_->read_batch_window;
+  }
 };
 
 /// Extends `MetadataOpenState` with integration with a "data cache"
@@ -942,6 +1113,17 @@ class RegisteredKvsDriver
     }
   };
 
+  /// Assigns reads that do not specify a batch to the current window of
+  /// `read_batch_window`, if specified.
+  ///
+  /// Derived driver types that override `Read` should call `GetReadBatch`
+  /// themselves.
+  void Read(internal::Driver::ReadRequest request,
+            internal::ReadChunkReceiver receiver) override {
+    request.batch = this->GetReadBatch(std::move(request.batch));
+    Base::Read(std::move(request), std::move(receiver));
+  }
+
   Result<internal::TransformedDriverSpec> GetBoundSpec(
       internal::OpenTransactionPtr transaction,
       IndexTransformView<> transform) override {
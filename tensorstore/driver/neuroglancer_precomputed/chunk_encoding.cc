@@ -43,6 +43,7 @@
 #include "tensorstore/internal/image/png_reader.h"
 #include "tensorstore/internal/image/png_writer.h"
 #include "tensorstore/internal/integer_overflow.h"
+#include "tensorstore/internal/riegeli/array_endian_codec.h"
 #include "tensorstore/strided_layout.h"
 #include "tensorstore/util/endian.h"
 #include "tensorstore/util/extents.h"
@@ -67,7 +68,6 @@ Result<SharedArray<const void>> DecodeRawChunk(
         tensorstore::StrCat("Expected chunk length to be ", expected_bytes,
                             ", but received ", buffer.size(), " bytes"));
   }
-  auto flat_buffer = buffer.Flatten();
   if (absl::c_equal(shape, chunk_layout.shape())) {
     // Chunk is full size.  Attempt to decode in place.  Transfer ownership of
     // the existing `buffer` string into `decoded_array`.
@@ -78,8 +78,6 @@ Result<SharedArray<const void>> DecodeRawChunk(
   // Partial chunk, must copy.  It is safe to default initialize because the
   // out-of-bounds positions will never be read, but we use value initialization
   // for simplicity in case resize is supported later.
-  Array<const void, 4> source(
-      {static_cast<const void*>(flat_buffer.data()), dtype}, shape);
   SharedArray<void> full_decoded_array(
       internal::AllocateAndConstructSharedElements(chunk_layout.num_elements(),
                                                    value_init, dtype),
@@ -87,7 +85,18 @@ Result<SharedArray<const void>> DecodeRawChunk(
   ArrayView<void> partial_decoded_array(
       full_decoded_array.element_pointer(),
       StridedLayoutView<>{shape, chunk_layout.byte_strides()});
-  internal::DecodeArray(source, endian::little, partial_decoded_array);
+  if (auto flat_buffer = buffer.TryFlat()) {
+    Array<const void, 4> source(
+        {static_cast<const void*>(flat_buffer->data()), dtype}, shape);
+    internal::DecodeArray(source, endian::little, partial_decoded_array);
+  } else {
+    // Decode directly from the fragments rather than first flattening the
+    // cord, which would copy the data twice (and the flattened copy is not
+    // suitably aligned to be viewed in place).
+    riegeli::CordReader<const absl::Cord*> reader(&buffer);
+    TENSORSTORE_RETURN_IF_ERROR(internal::DecodeArrayEndian(
+        reader, endian::little, c_order, partial_decoded_array));
+  }
   return full_decoded_array;
 }
 
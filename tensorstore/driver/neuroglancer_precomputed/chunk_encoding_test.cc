@@ -32,6 +32,7 @@
 #include "absl/base/optimization.h"
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
+#include "absl/strings/cord_test_helpers.h"
 #include <nlohmann/json_fwd.hpp>
 #include "riegeli/bytes/cord_reader.h"
 #include "tensorstore/array.h"
@@ -148,6 +149,19 @@ TEST_P(ChunkEncodingTest, Roundtrip) {
                        MatchesStatus(absl::StatusCode::kInvalidArgument)));
   }
 
+  {
+    // Decoding must not depend on how the encoded chunk is fragmented.
+    std::vector<std::string> fragments;
+    for (size_t i = 0; i < out.size(); i += 7) {
+      fragments.push_back(std::string(out.Subcord(i, 7)));
+    }
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto fragmented_decode_result,
+        DecodeChunk(chunk_indices, metadata, scale_index, chunk_layout,
+                    absl::MakeFragmentedCord(fragments)));
+    EXPECT_EQ(decode_result, fragmented_decode_result);
+  }
+
   if (double max_rms_error = GetParam().max_root_mean_squared_error) {
     EXPECT_LT(GetRootMeanSquaredError(decode_result, array), max_rms_error)
         << "original=" << array << ", decoded=" << decode_result;
@@ -661,8 +661,30 @@ class ShardedDataCache : public DataCacheBase {
   virtual Future<ArrayStorageStatistics> GetStorageStatistics(
       internal::Driver::GetStorageStatisticsRequest request,
       absl::Time staleness_bound) override {
-    // Not yet implemented for sharded format.
-    return absl::UnimplementedError("");
+    const auto& metadata = this->metadata();
+    const auto& scale = metadata.scales[scale_index_];
+    auto& grid = this->grid();
+    Box<3> grid_bounds;
+    for (DimensionIndex i = 0; i < 3; ++i) {
+      const Index chunk_size = chunk_layout_czyx_.shape()[3 - i];
+      grid_bounds[i] = IndexInterval::UncheckedSized(
+          0, tensorstore::CeilOfRatio(scale.box.shape()[i], chunk_size));
+    }
+    const auto& component = grid.components[0];
+    // Chunk keys are compressed Morton codes, which do not permit listing
+    // ranges of chunks.  Instead, the sharded kvstore determines the presence
+    // of each chunk from the minishard indexes.
+    return internal::GetStorageStatisticsForRegularGridWithUnorderedKeys(
+        KvStore{kvstore::DriverPtr(this->kvstore_driver()),
+                internal::TransactionState::ToTransaction(
+                    std::move(request.transaction))},
+        request.transform, /*grid_output_dimensions=*/
+        component.chunked_to_cell_dimensions,
+        /*chunk_shape=*/grid.chunk_shape, grid_bounds,
+        [&](span<const Index> cell_indices) {
+          return GetChunkStorageKey(cell_indices);
+        },
+        staleness_bound, request.options);
   }
 
   std::array<int, 3> compressed_z_index_bits_;
@@ -777,9 +799,8 @@ class RegularlyShardedDataCache : public ShardedDataCache {
         if (state->cancelled()) {
           return absl::CancelledError("");
         }
-        TENSORSTORE_ASSIGN_OR_RETURN(
-            auto cell_to_source,
-            ComposeTransforms(transform, iterator.cell_transform()));
+        TENSORSTORE_ASSIGN_OR_RETURN(auto cell_to_source,
+                                     iterator.GetCellToOutputTransform());
         callback(std::move(cell_to_source),
                  ForwardingReceiver{state, iterator.cell_transform()});
         iterator.Advance();
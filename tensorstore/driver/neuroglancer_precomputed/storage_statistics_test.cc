@@ -16,6 +16,7 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "tensorstore/array.h"
 #include "tensorstore/context.h"
 #include "tensorstore/data_type.h"
 #include "tensorstore/index_space/dim_expression.h"
@@ -23,6 +24,7 @@
 #include "tensorstore/kvstore/memory/memory_key_value_store.h"
 #include "tensorstore/kvstore/mock_kvstore.h"
 #include "tensorstore/open.h"
+#include "tensorstore/tensorstore.h"
 #include "tensorstore/util/result.h"
 #include "tensorstore/util/status_testutil.h"
 
@@ -33,7 +35,6 @@ using ::tensorstore::ChunkLayout;
 using ::tensorstore::Context;
 using ::tensorstore::dtype_v;
 using ::tensorstore::MatchesJson;
-using ::tensorstore::MatchesStatus;
 using ::tensorstore::Schema;
 
 class StorageStatisticsTest : public ::testing::Test {
@@ -264,11 +265,41 @@ TEST_F(StorageStatisticsTest, Sharded) {
                       .result());
   mock_kvstore->request_log.pop_all();
 
+  auto region = store | tensorstore::Dims(0, 1, 2).HalfOpenInterval(
+                            {8, 8, 8}, {10, 10, 10});
   EXPECT_THAT(tensorstore::GetStorageStatistics(
-                  store | tensorstore::Dims(0).HalfOpenInterval(8, 15),
-                  ArrayStorageStatistics::query_not_stored)
+                  region, ArrayStorageStatistics::query_not_stored,
+                  ArrayStorageStatistics::query_fully_stored)
+                  .result(),
+              ::testing::Optional(ArrayStorageStatistics{
+                  /*.mask=*/ArrayStorageStatistics::query_not_stored |
+                      ArrayStorageStatistics::query_fully_stored,
+                  /*.not_stored=*/true, /*.fully_stored=*/false}));
+
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Write(
+          tensorstore::MakeScalarArray<uint8_t>(42),
+          store | tensorstore::Dims(0, 1, 2).IndexSlice({8, 8, 8}))
+          .result());
+  mock_kvstore->request_log.pop_all();
+
+  EXPECT_THAT(tensorstore::GetStorageStatistics(
+                  region, ArrayStorageStatistics::query_not_stored,
+                  ArrayStorageStatistics::query_fully_stored)
                   .result(),
-              MatchesStatus(absl::StatusCode::kUnimplemented));
+              ::testing::Optional(ArrayStorageStatistics{
+                  /*.mask=*/ArrayStorageStatistics::query_not_stored |
+                      ArrayStorageStatistics::query_fully_stored,
+                  /*.not_stored=*/false, /*.fully_stored=*/false}));
+
+  EXPECT_THAT(
+      tensorstore::GetStorageStatistics(
+          store | tensorstore::Dims(0, 1, 2).IndexSlice({8, 8, 8}),
+          ArrayStorageStatistics::query_fully_stored)
+          .result(),
+      ::testing::Optional(ArrayStorageStatistics{
+          /*.mask=*/ArrayStorageStatistics::query_fully_stored,
+          /*.not_stored=*/false, /*.fully_stored=*/true}));
 }
 
 }  // namespace
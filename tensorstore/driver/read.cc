@@ -20,6 +20,7 @@
 #include <utility>
 
 #include "absl/status/status.h"
+#include "tensorstore/access_recorder.h"
 #include "tensorstore/array.h"
 #include "tensorstore/batch.h"
 #include "tensorstore/box.h"
@@ -34,6 +35,7 @@
 #include "tensorstore/index_space/alignment.h"
 #include "tensorstore/index_space/index_transform.h"
 #include "tensorstore/index_space/transformed_array.h"
+#include "tensorstore/internal/concurrent_arena.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/lock_collection.h"
 #include "tensorstore/internal/meta/type_traits.h"
@@ -43,8 +45,12 @@
 #include "tensorstore/internal/nditerable_transformed_array.h"
 #include "tensorstore/internal/nditerable_util.h"
 #include "tensorstore/internal/tagged_ptr.h"
+#include "tensorstore/internal/thread/task_priority.h"
+#include "tensorstore/internal/tracing/operation_stats.h"
 #include "tensorstore/internal/tracing/operation_trace_span.h"
+#include "tensorstore/internal/tracing/trace_context.h"
 #include "tensorstore/open_mode.h"
+#include "tensorstore/operation_stats.h"
 #include "tensorstore/progress.h"
 #include "tensorstore/rank.h"
 #include "tensorstore/read_write_options.h"
@@ -107,10 +113,13 @@ struct ReadState
   TransformedArray<Shared<void>> target;
   DomainAlignmentOptions alignment_options;
   ReadProgressFunction read_progress_function;
+  AccessRecorder access_recorder;
   Promise<PromiseValue> promise;
   std::atomic<Index> copied_elements{0};
   Index total_elements;
   internal_tracing::OperationTraceSpan tspan{"tensorstore.Read"};
+  /// Holds the `ReadChunkOp` of each chunk until the chunk has been copied.
+  ConcurrentArena chunk_op_arena;
 
   void SetError(absl::Status error) {
     SetDeferredResult(promise, std::move(error));
@@ -139,7 +148,8 @@ struct ReadChunkOp {
         state->SetError(_));
     absl::Status copy_status =
         internal::CopyReadChunk(chunk.impl, std::move(chunk.transform),
-                                state->data_type_conversion, target);
+                                state->data_type_conversion, target,
+                                state->executor);
     if (copy_status.ok()) {
       state->UpdateProgress(ProductOfExtents(target.shape()));
     } else {
@@ -164,8 +174,11 @@ struct ReadChunkReceiver {
   void set_value(ReadChunk chunk, IndexTransform<> cell_transform) {
     // Defer all work to the executor, because we don't know on which thread
     // this may be called.
-    state->executor(ReadChunkOp<PromiseValue>{state, std::move(chunk),
-                                              std::move(cell_transform)});
+    ScopedTaskPriority priority_scope(TaskPriority::kInteractive);
+    state->executor(ArenaTask(state, state->chunk_op_arena,
+                              ReadChunkOp<PromiseValue>{
+                                  state, std::move(chunk),
+                                  std::move(cell_transform)}));
   }
 };
 
@@ -186,6 +199,7 @@ struct DriverReadIntoExistingInitiateOp {
         static_cast<void>(promise.SetResult(_)));
     state->promise = std::move(promise);
     state->total_elements = source_transform.domain().num_elements();
+    state->access_recorder.Record(source_transform, /*is_write=*/false);
 
     // Initiate the read on the driver.
     auto source_driver = std::move(state->source_driver);
@@ -193,6 +207,7 @@ struct DriverReadIntoExistingInitiateOp {
     request.transaction = std::move(state->source_transaction);
     request.batch = std::move(state->source_batch);
     request.transform = std::move(source_transform);
+    ScopedTaskPriority priority_scope(TaskPriority::kInteractive);
     source_driver->Read(std::move(request),
                         ReadChunkReceiver<void>{std::move(state)});
   }
@@ -222,6 +237,7 @@ struct DriverReadIntoNewInitiateOp {
     state->target = *r;
     state->promise = std::move(promise);
     state->total_elements = source_transform.input_domain().num_elements();
+    state->access_recorder.Record(source_transform, /*is_write=*/false);
 
     // Initiate the read on the driver.
     auto source_driver = std::move(state->source_driver);
@@ -229,6 +245,7 @@ struct DriverReadIntoNewInitiateOp {
     request.transaction = std::move(state->source_transaction);
     request.batch = std::move(state->source_batch);
     request.transform = std::move(source_transform);
+    ScopedTaskPriority priority_scope(TaskPriority::kInteractive);
     source_driver->Read(
         std::move(request),
         ReadChunkReceiver<SharedOffsetArray<void>>{std::move(state)});
@@ -242,6 +259,10 @@ Future<void> DriverRead(Executor executor, DriverHandle source,
                         DriverReadOptions options) {
   TENSORSTORE_RETURN_IF_ERROR(
       internal::ValidateSupportsRead(source.driver.read_write_mode()));
+  // I/O performed on behalf of the operation, including by asynchronous work
+  // started within this scope, is attributed to `options.operation_stats`.
+  internal_tracing::ScopedOperationStats stats_scope(
+      internal_tracing::OperationStatsAccess::state(options.operation_stats));
   using State = ReadState<void>;
   IntrusivePtr<State> state(new State);
   state->executor = executor;
@@ -257,9 +278,13 @@ Future<void> DriverRead(Executor executor, DriverHandle source,
   state->target = std::move(target);
   state->alignment_options = options.alignment_options;
   state->read_progress_function = std::move(options.progress_function);
+  state->access_recorder = std::move(options.access_recorder);
   auto pair = PromiseFuturePair<void>::Make(MakeResult());
 
-  // Resolve the bounds for `source.transform`.
+  // Resolve the bounds for `source.transform`.  Reads, including any metadata
+  // reads they require, are scheduled as interactive.
+  ScopedTaskPriority priority_scope(TaskPriority::kInteractive);
+  internal_tracing::ScopedTraceContext trace_scope(state->tspan.context());
   Driver::ResolveBoundsRequest request;
   request.transaction = state->source_transaction;
   request.transform = std::move(source.transform);
@@ -286,6 +311,8 @@ Future<SharedOffsetArray<void>> DriverReadIntoNewArray(
     Executor executor, DriverHandle source, DriverReadIntoNewOptions options) {
   TENSORSTORE_RETURN_IF_ERROR(
       internal::ValidateSupportsRead(source.driver.read_write_mode()));
+  internal_tracing::ScopedOperationStats stats_scope(
+      internal_tracing::OperationStatsAccess::state(options.operation_stats));
   using State = ReadState<SharedOffsetArray<void>>;
   IntrusivePtr<State> state(new State);
   TENSORSTORE_ASSIGN_OR_RETURN(
@@ -299,9 +326,13 @@ Future<SharedOffsetArray<void>> DriverReadIntoNewArray(
       internal::AcquireOpenTransactionPtrOrError(source.transaction));
   state->source_batch = std::move(options.batch);
   state->read_progress_function = std::move(options.progress_function);
+  state->access_recorder = std::move(options.access_recorder);
   auto pair = PromiseFuturePair<SharedOffsetArray<void>>::Make();
 
-  // Resolve the bounds for `source.transform`.
+  // Resolve the bounds for `source.transform`.  Reads, including any metadata
+  // reads they require, are scheduled as interactive.
+  ScopedTaskPriority priority_scope(TaskPriority::kInteractive);
+  internal_tracing::ScopedTraceContext trace_scope(state->tspan.context());
   Driver::ResolveBoundsRequest request;
   request.transaction = state->source_transaction;
   request.transform = std::move(source.transform);
@@ -330,7 +361,8 @@ Future<SharedOffsetArray<void>> DriverReadIntoNewArray(
 absl::Status CopyReadChunk(
     ReadChunk::Impl& chunk, IndexTransform<> chunk_transform,
     const DataTypeConversionLookupResult& chunk_conversion,
-    TransformedArray<void, dynamic_rank, view> target) {
+    TransformedArray<void, dynamic_rank, view> target,
+    const Executor& executor) {
   DefaultNDIterableArena arena;
 
   TENSORSTORE_ASSIGN_OR_RETURN(
@@ -348,9 +380,9 @@ absl::Status CopyReadChunk(
       std::move(source_iterable), target_iterable->dtype(), chunk_conversion);
 
   // Copy the chunk to the relevant portion of the target array.
-  NDIterableCopier copier(*source_iterable, *target_iterable, target.shape(),
-                          arena);
-  return copier.Copy();
+  return NDIterableCopyParallel(*source_iterable, *target_iterable,
+                                target.shape(), skip_repeated_elements, arena,
+                                executor);
 }
 
 absl::Status CopyReadChunk(ReadChunk::Impl& chunk,
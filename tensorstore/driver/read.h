@@ -86,10 +86,14 @@ Future<SharedOffsetArray<void>> DriverReadIntoNewArray(
     DriverHandle source, ReadIntoNewArrayOptions options);
 
 /// Copies `chunk` transformed by `chunk_transform` to `target`.
+///
+/// \param executor If non-null, large copies are split across `executor`, see
+///     `NDIterableCopyParallel`.
 absl::Status CopyReadChunk(
     ReadChunk::Impl& chunk, IndexTransform<> chunk_transform,
     const DataTypeConversionLookupResult& chunk_conversion,
-    TransformedArray<void, dynamic_rank, view> target);
+    TransformedArray<void, dynamic_rank, view> target,
+    const Executor& executor = {});
 
 absl::Status CopyReadChunk(ReadChunk::Impl& chunk,
                            IndexTransform<> chunk_transform,
@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <deque>
 #include <numeric>
 #include <optional>
 #include <string_view>
@@ -28,9 +29,9 @@
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/hash/hash.h"
-#include "absl/log/absl_log.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_format.h"
+#include "absl/synchronization/mutex.h"
 #include "tensorstore/box.h"
 #include "tensorstore/context.h"
 #include "tensorstore/data_type.h"
@@ -49,6 +50,7 @@
 #include "tensorstore/index_space/index_transform.h"
 #include "tensorstore/index_space/internal/propagate_bounds.h"
 #include "tensorstore/index_space/internal/transform_rep.h"
+#include "tensorstore/internal/box_tree.h"
 #include "tensorstore/internal/concurrency_resource.h"
 #include "tensorstore/internal/data_copy_concurrency_resource.h"
 #include "tensorstore/internal/grid_partition_iterator.h"
@@ -149,6 +151,11 @@ struct StackLayer {
 
 namespace jb = tensorstore::internal_json_binding;
 
+/// Maximum number of layers of a single "stack" driver that may be opened
+/// concurrently.  Limits the burst of metadata reads issued when a request
+/// touches many layers that have not yet been opened.
+constexpr size_t kMaxConcurrentLayerOpens = 64;
+
 /// Used to index individual cells
 struct Cell {
   std::vector<Index> points;
@@ -331,6 +338,24 @@ Result<DimensionUnitsVector> GetDimensionUnits(
 
 using internal::TransformAndApplyOptions;
 
+// Returns `true` if `layer` already has the dtype and rank of `schema`, such
+// that applying options that specify only the dtype and rank has no effect.
+//
+// This avoids transforming and applying options separately to each layer when
+// parsing a spec with many layers.
+template <typename Layer>
+bool LayerHasRankAndDtype(const Layer& layer, const Schema& schema) {
+  const auto& layer_schema = layer.driver_spec->schema;
+  if (layer_schema.dtype() != schema.dtype() ||
+      layer_schema.rank() == dynamic_rank) {
+    return false;
+  }
+  const DimensionIndex layer_rank = layer.transform.valid()
+                                        ? layer.transform.input_rank()
+                                        : layer_schema.rank();
+  return layer_rank == schema.rank();
+}
+
 absl::Status TransformAndApplyOptions(StackLayer& layer,
                                       SpecOptions&& options) {
   assert(!layer.is_open());
@@ -382,6 +407,12 @@ absl::Status ApplyLayerOptions(tensorstore::span<Layer> layers, Schema& schema,
         return absl::OkStatus();
       }
     }
+    if (options.open_mode == OpenMode{} &&
+        !options.recheck_cached_data.specified() &&
+        !options.recheck_cached_metadata.specified() && !options.minimal_spec &&
+        LayerHasRankAndDtype(layer, schema)) {
+      return absl::OkStatus();
+    }
     // Filter the options to only those that we wish to pass on to the
     // layers, otherwise we may be passing on nonsensical settings for a
     // layer.
@@ -497,9 +528,29 @@ class StackDriver
 
   void Write(WriteRequest request, WriteChunkReceiver receiver) override;
 
-  absl::Status InitializeGridIndices(
+  absl::Status InitializeLayerIndex(
       tensorstore::span<const IndexDomain<>> domains);
 
+  /// Irregular grid over the layers that intersect a single read or write
+  /// request, along with the layer that backs each grid cell.
+  struct LayerGrid {
+    IrregularGrid grid;
+    absl::flat_hash_map<Cell, size_t, CellHash, CellEq> cell_to_layer;
+  };
+
+  /// Returns the grid formed by the layers that intersect `bounds`.
+  LayerGrid GetLayerGrid(BoxView<> bounds) const;
+
+  /// Opens layer `layer_i`, which must be specified by a `DriverSpec`.
+  ///
+  /// At most `kMaxConcurrentLayerOpens` layers are opened concurrently, and
+  /// additional opens are queued.  Outside of a transaction, the open is shared
+  /// by all subsequent operations on the layer with the same `mode`; a failed
+  /// open is not retained, so that it is retried by the next operation.
+  Future<internal::Driver::Handle> OpenLayer(
+      size_t layer_i, ReadWriteMode mode,
+      internal::OpenTransactionPtr transaction);
+
   constexpr static auto ApplyMembers = [](auto&& x, auto f) {
     // Exclude `context_binding_state_` because it is handled specially.
     return f(x.dtype_, x.data_copy_concurrency_, x.layers_, x.dimension_units_,
@@ -511,9 +562,34 @@ class StackDriver
   std::vector<StackLayer> layers_;
   DimensionUnitsVector dimension_units_;
   IndexDomain<> layer_domain_;
-  IrregularGrid grid_;
 
-  absl::flat_hash_map<Cell, size_t, CellHash, CellEq> grid_to_layer_;
+  // Effective domain of each layer, and a spatial index over them.
+  std::vector<IndexDomain<>> layer_domains_;
+  internal::BoxTree layer_tree_;
+
+ private:
+  struct PendingLayerOpen {
+    size_t layer_i;
+    ReadWriteMode mode;
+    internal::OpenTransactionPtr transaction;
+    Promise<internal::Driver::Handle> promise;
+  };
+
+  static size_t LayerOpenCacheIndex(size_t layer_i, ReadWriteMode mode) {
+    return 2 * layer_i + (mode == ReadWriteMode::write);
+  }
+
+  void StartLayerOpen(PendingLayerOpen op);
+  void FinishLayerOpen(PendingLayerOpen op,
+                       Result<internal::Driver::Handle> result);
+
+  absl::Mutex layer_open_mutex_;
+  size_t num_layer_opens_in_progress_ ABSL_GUARDED_BY(layer_open_mutex_) = 0;
+  std::deque<PendingLayerOpen> pending_layer_opens_
+      ABSL_GUARDED_BY(layer_open_mutex_);
+  // Opens shared outside of a transaction, indexed by `LayerOpenCacheIndex`.
+  std::vector<Future<internal::Driver::Handle>> cached_layer_opens_
+      ABSL_GUARDED_BY(layer_open_mutex_);
 };
 
 Result<internal::Driver::Handle> MakeStackDriverHandle(
@@ -524,7 +600,7 @@ Result<internal::Driver::Handle> MakeStackDriverHandle(
   TENSORSTORE_ASSIGN_OR_RETURN(
       driver->layer_domain_,
       internal_stack::GetCombinedDomain(schema, layer_domains));
-  TENSORSTORE_RETURN_IF_ERROR(driver->InitializeGridIndices(layer_domains));
+  TENSORSTORE_RETURN_IF_ERROR(driver->InitializeLayerIndex(layer_domains));
   auto transform = IdentityTransform(driver->layer_domain_);
   driver->dimension_units_ =
       internal_stack::GetDimensionUnits<StackLayer>(schema, driver->layers_)
@@ -562,49 +638,133 @@ Future<internal::Driver::Handle> StackDriverSpec::Open(
       schema);
 }
 
-/// The mechanism used here is to construct an irregular grid based on
-/// each layer's effective transform, and then, for each of those grid
-/// points, store the layer associated with the bounding rectangle.
-///
-/// If this becomes a problem, we may want to consider constructing
-/// an R-tree variant using the layer MBRs to restrict the query space,
-/// then applying a similar gridding decomposition to the read transforms.
-absl::Status StackDriver::InitializeGridIndices(
+/// Layer lookup is done in two steps: a `BoxTree` over the effective domains
+/// of the layers restricts each request to the layers that it may touch, and
+/// an irregular grid formed from just those layers then partitions the request
+/// by layer.  Building a single grid over all layers up front requires space
+/// proportional to the product of the number of distinct boundaries in each
+/// dimension, which is prohibitive for stacks of many non-aligned layers.
+absl::Status StackDriver::InitializeLayerIndex(
     tensorstore::span<const IndexDomain<>> domains) {
   assert(domains.size() == layers_.size());
-  grid_ =
-      IrregularGrid::Make(layers_.empty() ? tensorstore::span(&layer_domain_, 1)
-                                          : tensorstore::span(domains));
+  layer_domains_.assign(domains.begin(), domains.end());
+  std::vector<Box<>> boxes;
+  boxes.reserve(domains.size());
+  for (const auto& domain : domains) {
+    boxes.emplace_back(domain.box());
+  }
+  layer_tree_ = internal::BoxTree(boxes);
+  return absl::OkStatus();
+}
+
+StackDriver::LayerGrid StackDriver::GetLayerGrid(BoxView<> bounds) const {
+  LayerGrid result;
+  const std::vector<size_t> layer_indices =
+      layer_tree_.FindIntersecting(bounds);
+  if (layer_indices.empty()) {
+    result.grid = IrregularGrid::Make(tensorstore::span(&layer_domain_, 1));
+    return result;
+  }
+  std::vector<IndexDomain<>> domains;
+  domains.reserve(layer_indices.size());
+  for (size_t layer_i : layer_indices) {
+    domains.push_back(layer_domains_[layer_i]);
+  }
+  result.grid = IrregularGrid::Make(domains);
 
   Index start[kMaxRank];
   Index shape[kMaxRank];
-  const DimensionIndex rank = grid_.rank();
-  for (size_t layer_i = 0; layer_i < domains.size(); layer_i++) {
-    auto& d = domains[layer_i];
+  const DimensionIndex rank = result.grid.rank();
+  // `layer_indices` is in increasing order, so later layers take precedence.
+  for (size_t i = 0; i < layer_indices.size(); ++i) {
+    const size_t layer_i = layer_indices[i];
+    auto& d = domains[i];
     for (DimensionIndex dim = 0; dim < rank; dim++) {
-      start[dim] = grid_(dim, d[dim].inclusive_min(), nullptr);
-      shape[dim] = 1 + grid_(dim, d[dim].inclusive_max(), nullptr) - start[dim];
+      start[dim] = result.grid(dim, d[dim].inclusive_min(), nullptr);
+      shape[dim] = 1 + result.grid(dim, d[dim].inclusive_max(), nullptr) -
+                   start[dim];
     }
     // Set the mapping for all irregular grid cell covered by this layer
     // to point to this layer.
     IterateOverIndexRange<>(
         BoxView<>(rank, start, shape),
-        [layer_i, this](tensorstore::span<const Index> key) {
-          grid_to_layer_[key] = layer_i;
+        [layer_i, &result](tensorstore::span<const Index> key) {
+          result.cell_to_layer[key] = layer_i;
         });
   }
+  return result;
+}
 
-#if !defined(NDEBUG)
-  // Log the missing cells.
-  IterateOverIndexRange<>(
-      grid_.shape(), [this](tensorstore::span<const Index> key) {
-        if (auto it = grid_to_layer_.find(key); it == grid_to_layer_.end()) {
-          ABSL_LOG(INFO) << "\"stack\" driver missing grid cell: " << key;
-        }
+Future<internal::Driver::Handle> StackDriver::OpenLayer(
+    size_t layer_i, ReadWriteMode mode,
+    internal::OpenTransactionPtr transaction) {
+  const bool shared = !transaction;
+  PendingLayerOpen op{layer_i, mode, std::move(transaction), {}};
+  Future<internal::Driver::Handle> future;
+  {
+    absl::MutexLock lock(&layer_open_mutex_);
+    if (shared) {
+      cached_layer_opens_.resize(2 * layers_.size());
+      auto& cached = cached_layer_opens_[LayerOpenCacheIndex(layer_i, mode)];
+      if (!cached.null()) return cached;
+      auto pair = PromiseFuturePair<internal::Driver::Handle>::Make();
+      op.promise = std::move(pair.promise);
+      cached = future = std::move(pair.future);
+    } else {
+      auto pair = PromiseFuturePair<internal::Driver::Handle>::Make();
+      op.promise = std::move(pair.promise);
+      future = std::move(pair.future);
+    }
+    if (num_layer_opens_in_progress_ >= kMaxConcurrentLayerOpens) {
+      pending_layer_opens_.push_back(std::move(op));
+      return future;
+    }
+    ++num_layer_opens_in_progress_;
+  }
+  StartLayerOpen(std::move(op));
+  return future;
+}
+
+void StackDriver::StartLayerOpen(PendingLayerOpen op) {
+  internal::DriverOpenRequest request;
+  request.transaction = op.transaction;
+  request.read_write_mode = op.mode;
+  auto future = internal::OpenDriver(
+      layers_[op.layer_i].GetTransformedDriverSpec(), std::move(request));
+  future.ExecuteWhenReady(
+      [self = IntrusivePtr<StackDriver>(this),
+       op = std::move(op)](ReadyFuture<internal::Driver::Handle> f) mutable {
+        self->FinishLayerOpen(std::move(op), f.result());
       });
-#endif
+}
 
-  return absl::OkStatus();
+void StackDriver::FinishLayerOpen(PendingLayerOpen op,
+                                  Result<internal::Driver::Handle> result) {
+  std::optional<PendingLayerOpen> next;
+  {
+    absl::MutexLock lock(&layer_open_mutex_);
+    if (!result.ok() && !op.transaction) {
+      auto& cached =
+          cached_layer_opens_[LayerOpenCacheIndex(op.layer_i, op.mode)];
+      if (HaveSameSharedState(op.promise, cached)) cached = {};
+    }
+    if (pending_layer_opens_.empty()) {
+      --num_layer_opens_in_progress_;
+    } else {
+      next.emplace(std::move(pending_layer_opens_.front()));
+      pending_layer_opens_.pop_front();
+    }
+  }
+  op.promise.SetResult(std::move(result));
+  if (next) {
+    // Start the next open from the executor rather than recursively, since
+    // opens that complete immediately would otherwise nest arbitrarily deep.
+    data_copy_executor()(
+        [self = IntrusivePtr<StackDriver>(this),
+         op = std::move(*next)]() mutable {
+          self->StartLayerOpen(std::move(op));
+        });
+  }
 }
 
 Result<TransformedDriverSpec> StackDriver::GetBoundSpec(
@@ -716,7 +876,7 @@ template <typename StateType>
 struct OpenLayerOp {
   OpenLayerOp(IntrusivePtr<StateType> state)
       : state(std::move(state)),
-        grid_output_dimensions(this->state->self->grid_.rank()) {
+        grid_output_dimensions(this->state->self->rank()) {
     std::iota(grid_output_dimensions.begin(), grid_output_dimensions.end(),
               DimensionIndex{0});
   }
@@ -730,14 +890,21 @@ struct OpenLayerOp {
     absl::flat_hash_map<size_t, std::vector<IndexTransform<>>> layers_to_load;
 
     auto status = [&]() -> absl::Status {
+      // Restrict the grid to the layers which intersect the output range of
+      // the request transform.
+      Box<> bounds(self->rank());
+      TENSORSTORE_RETURN_IF_ERROR(
+          GetOutputRange(state->request.transform, bounds));
+      const auto layer_grid = self->GetLayerGrid(bounds);
+
       internal_grid_partition::PartitionIndexTransformIterator iterator(
-          grid_output_dimensions, self->grid_, state->request.transform);
+          grid_output_dimensions, layer_grid.grid, state->request.transform);
       TENSORSTORE_RETURN_IF_ERROR(iterator.Init());
 
       while (!iterator.AtEnd()) {
-        auto it =
-            self->grid_to_layer_.find(iterator.output_grid_cell_indices());
-        if (it != self->grid_to_layer_.end()) {
+        auto it = layer_grid.cell_to_layer.find(
+            iterator.output_grid_cell_indices());
+        if (it != layer_grid.cell_to_layer.end()) {
           const size_t layer_i = it->second;
           const auto& layer = self->layers_[layer_i];
           if (layer.driver) {
@@ -754,7 +921,7 @@ struct OpenLayerOp {
         } else {
           // This cell is not backed by a layer, so report an error.
           auto origin =
-              self->grid_.cell_origin(iterator.output_grid_cell_indices());
+              layer_grid.grid.cell_origin(iterator.output_grid_cell_indices());
           return absl::InvalidArgumentError(tensorstore::StrCat(
               "Cell with origin=", tensorstore::span(origin),
               " missing layer mapping in \"stack\" driver"));
@@ -772,16 +939,12 @@ struct OpenLayerOp {
     // transforms.
     for (auto& kv : layers_to_load) {
       const size_t layer_i = kv.first;
-      const auto& layer = self->layers_[layer_i];
-      internal::DriverOpenRequest request;
-      request.transaction = state->request.transaction;
-      request.read_write_mode = StateType::kMode;
       Link(WithExecutor(
                self->data_copy_executor(),
                AfterOpenOp<StateType>{state, layer_i, std::move(kv.second)}),
            state->promise,
-           internal::OpenDriver(layer.GetTransformedDriverSpec(),
-                                std::move(request)));
+           self->OpenLayer(layer_i, StateType::kMode,
+                           state->request.transaction));
     }
   }
 };
@@ -264,6 +264,39 @@ TEST(StackDriverTest, ReadSparse) {
   }
 }
 
+TEST(StackDriverTest, ReadManyLayers) {
+  // Overlapping layers, where later layers take precedence.
+  ::nlohmann::json::array_t layers;
+  for (int i = 0; i < 500; ++i) {
+    layers.push_back(GetRank1Length4ArrayDriver(3 * i));
+  }
+  ::nlohmann::json json_spec{
+      {"driver", "stack"},
+      {"layers", std::move(layers)},
+  };
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store,
+                                   tensorstore::Open(json_spec).result());
+
+  {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto array,
+        tensorstore::Read<tensorstore::zero_origin>(
+            store | tensorstore::AllDims().SizedInterval({601}, {7}))
+            .result());
+    EXPECT_THAT(array, MatchesArray<int32_t>({2, 3, 1, 2, 3, 1, 2}));
+  }
+
+  {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto array,
+        tensorstore::Read<tensorstore::zero_origin>(
+            store | tensorstore::AllDims().SizedInterval({1495}, {6}))
+            .result());
+    EXPECT_THAT(array, MatchesArray<int32_t>({2, 3, 1, 2, 3, 4}));
+  }
+}
+
 TEST(StackDriverTest, NoLayers) {
   TENSORSTORE_ASSERT_OK_AND_ASSIGN(
       auto spec, tensorstore::Spec::FromJson(
@@ -375,6 +408,36 @@ TEST(StackDriverTest, ReadWriteNonExistingLayers) {
                             ".*Error opening \"n5\" driver: .*"));
 }
 
+TEST(StackDriverTest, RetryFailedLayerOpen) {
+  auto context = tensorstore::Context::Default();
+  ::nlohmann::json json_spec{
+      {"driver", "stack"},
+      {"layers", ::nlohmann::json::array_t({GetRank1Length4N5Driver(0)})},
+  };
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, tensorstore::Open(json_spec, context).result());
+
+  EXPECT_THAT(tensorstore::Read(store).result(),
+              MatchesStatus(absl::StatusCode::kNotFound,
+                            ".*Error opening \"n5\" driver: .*"));
+
+  // Create the layer; the failed open must not have been retained.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto layer, tensorstore::Open(GetRank1Length4N5Driver(0),
+                                    OpenMode::create, context)
+                      .result());
+  TENSORSTORE_EXPECT_OK(
+      tensorstore::Write(tensorstore::MakeArray<int32_t>({1, 2, 3, 4}), layer)
+          .result());
+
+  // Read twice; the second read reuses the opened layer.
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_THAT(tensorstore::Read(store).result(),
+                ::testing::Optional(MatchesArray<int32_t>({1, 2, 3, 4})));
+  }
+}
+
 TEST(StackDriverTest, Schema_MismatchedDtype) {
   auto a = GetRank1Length4N5Driver(0);
   a["dtype"] = "int64";
@@ -26,6 +26,7 @@
 #include <vector>
 
 #include "absl/base/optimization.h"
+#include "absl/functional/any_invocable.h"
 #include "absl/status/status.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
@@ -56,6 +57,8 @@
 #include "tensorstore/internal/chunk_grid_specification.h"
 #include "tensorstore/internal/data_copy_concurrency_resource.h"
 #include "tensorstore/internal/integer_overflow.h"
+#include "tensorstore/internal/rate_limiter/admission_queue.h"
+#include "tensorstore/internal/rate_limiter/rate_limiter.h"
 #include "tensorstore/internal/memory.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/open_mode.h"
@@ -68,6 +71,7 @@
 #include "tensorstore/transaction.h"
 #include "tensorstore/util/byte_strided_pointer.h"
 #include "tensorstore/util/element_pointer.h"
+#include "tensorstore/util/executor.h"
 #include "tensorstore/util/future.h"
 #include "tensorstore/util/garbage_collection/garbage_collection.h"
 #include "tensorstore/util/garbage_collection/std_optional.h"  // IWYU pragma: keep
@@ -92,6 +96,12 @@ class VirtualChunkedCache : public internal::ConcreteChunkCache {
   template <typename EntryOrNode>
   void DoRead(EntryOrNode& node, AsyncCacheReadRequest request);
 
+  /// Runs `call` on `executor()`, subject to `admission_queue_`.
+  ///
+  /// `call` invokes the `read_function_` or `write_function_` and returns the
+  /// resultant future; the call remains in progress until it becomes ready.
+  void ScheduleCall(absl::AnyInvocable<Future<const void>() &&> call);
+
   class Entry : public internal::ChunkCache::Entry {
    public:
     using OwningCache = VirtualChunkedCache;
@@ -172,8 +182,44 @@ class VirtualChunkedCache : public internal::ConcreteChunkCache {
   Context::Resource<internal::DataCopyConcurrencyResource>
       data_copy_concurrency_;
   Context::Resource<internal::CachePoolResource> cache_pool_;
+
+  // Limits the number of calls in progress, or `nullptr` if unlimited.
+  std::shared_ptr<internal::AdmissionQueue> admission_queue_;
 };
 
+/// Call to the `read_function_` or `write_function_` of a
+/// `VirtualChunkedCache` that is waiting for, or has been granted, admission.
+struct AdmittedCall : public internal::RateLimiterNode {
+  std::shared_ptr<internal::AdmissionQueue> queue;
+  Executor executor;
+  absl::AnyInvocable<Future<const void>() &&> call;
+
+  static void Start(internal::RateLimiterNode* node) {
+    std::unique_ptr<AdmittedCall> self(static_cast<AdmittedCall*>(node));
+    auto executor = self->executor;
+    executor([self = std::move(self)]() mutable {
+      auto future = std::move(self->call)();
+      future.ExecuteWhenReady(
+          [self = std::move(self)](ReadyFuture<const void>) {
+            self->queue->Finish(self.get());
+          });
+    });
+  }
+};
+
+void VirtualChunkedCache::ScheduleCall(
+    absl::AnyInvocable<Future<const void>() &&> call) {
+  if (!admission_queue_) {
+    executor()([call = std::move(call)]() mutable { std::move(call)(); });
+    return;
+  }
+  auto* node = new AdmittedCall;
+  node->queue = admission_queue_;
+  node->executor = executor();
+  node->call = std::move(call);
+  admission_queue_->Admit(node, &AdmittedCall::Start);
+}
+
 /// Sets `partial_array` to refer to the portion of `full_array` (translated to
 /// the chunk origin) that is within bounds for the chunk corresponding to
 /// `entry`.  Also permutes the dimensions according to
@@ -234,10 +280,10 @@ void VirtualChunkedCache::DoRead(EntryOrNode& node,
         "Write-only virtual chunked view requires chunk-aligned writes"));
     return;
   }
-  auto& executor = cache.executor();
   // `node` is guaranteed to remain valid until `ReadSuccess` or `ReadError`
   // is called.  Therefore we don't need to separately hold a reference.
-  executor([&node, staleness_bound = request.staleness_bound] {
+  cache.ScheduleCall([&node, staleness_bound = request.staleness_bound]()
+                         -> Future<const void> {
     auto& entry = GetOwningEntry(node);
     auto& cache = GetOwningCache(entry);
     const auto& component_spec = cache.grid().components.front();
@@ -257,7 +303,7 @@ void VirtualChunkedCache::DoRead(EntryOrNode& node,
       node.ReadSuccess(
           {std::move(read_data),
            {StorageGeneration::NoValue(), absl::InfiniteFuture()}});
-      return;
+      return MakeReadyFuture();
     }
     read_data.get()[0] = full_array;
     ReadParameters read_params;
@@ -293,6 +339,7 @@ void VirtualChunkedCache::DoRead(EntryOrNode& node,
           node.ReadSuccess({std::move(read_data), std::move(*r)});
           return;
         });
+    return read_future;
   });
 }
 
@@ -321,8 +368,9 @@ void VirtualChunkedCache::TransactionNode::InitiateWriteback(
   struct ApplyReceiver {
     TransactionNode& self;
     void set_value(AsyncCache::ReadState update) {
-      GetOwningCache(self).executor()(
-          [node = &self, update = std::move(update)] {
+      GetOwningCache(self).ScheduleCall(
+          [node = &self,
+           update = std::move(update)]() mutable -> Future<const void> {
             auto* read_data = static_cast<const ReadData*>(update.data.get());
             SharedArray<const void> full_array;
 
@@ -341,7 +389,7 @@ void VirtualChunkedCache::TransactionNode::InitiateWriteback(
               node->WritebackSuccess(
                   {std::move(update.data),
                    {StorageGeneration::NoValue(), absl::InfiniteFuture()}});
-              return;
+              return MakeReadyFuture();
             }
             WriteParameters write_params;
             write_params.if_equal_ =
@@ -370,6 +418,7 @@ void VirtualChunkedCache::TransactionNode::InitiateWriteback(
                   update.stamp = std::move(*r);
                   node->WritebackSuccess(std::move(update));
                 });
+            return write_future;
           });
     }
     void set_error(absl::Status error) {
@@ -395,11 +444,12 @@ class VirtualChunkedDriverSpec
       data_copy_concurrency;
   Context::Resource<internal::CachePoolResource> cache_pool;
   StalenessBound data_staleness;
+  size_t concurrency_limit = 0;
 
   constexpr static auto ApplyMembers = [](auto&& x, auto f) {
     return f(internal::BaseCast<internal::DriverSpec>(x), x.read_function,
              x.write_function, x.data_copy_concurrency, x.cache_pool,
-             x.data_staleness);
+             x.data_staleness, x.concurrency_limit);
   };
 
   OpenMode open_mode() const override {
@@ -470,6 +520,8 @@ class VirtualChunkedDriver : public VirtualChunkedDriverBase {
   bool fill_missing_data_reads() const { return true; }
 
   bool store_data_equal_to_fill_value() const { return true; }
+
+  StalenessBound missing_data_staleness_bound() const { return {}; }
 };
 
 Result<internal::TransformedDriverSpec> VirtualChunkedDriver::GetBoundSpec(
@@ -486,6 +538,9 @@ Result<internal::TransformedDriverSpec> VirtualChunkedDriver::GetBoundSpec(
   driver_spec->data_copy_concurrency = cache.data_copy_concurrency_;
   driver_spec->cache_pool = cache.cache_pool_;
   driver_spec->data_staleness = this->data_staleness_bound();
+  if (cache.admission_queue_) {
+    driver_spec->concurrency_limit = cache.admission_queue_->limit();
+  }
   const DimensionIndex rank = this->rank();
   TENSORSTORE_RETURN_IF_ERROR(driver_spec->schema.Set(RankConstraint{rank}));
   TENSORSTORE_RETURN_IF_ERROR(driver_spec->schema.Set(dtype()));
@@ -688,6 +743,10 @@ Result<internal::Driver::Handle> VirtualChunkedDriver::OpenFromSpecData(
             chunk_template.origin().begin(), chunk_template.origin().end());
         cache->cache_pool_ = spec.cache_pool;
         cache->data_copy_concurrency_ = spec.data_copy_concurrency;
+        if (spec.concurrency_limit != 0) {
+          cache->admission_queue_ = std::make_shared<internal::AdmissionQueue>(
+              spec.concurrency_limit);
+        }
         return cache;
       });
   handle.driver = internal::MakeReadWritePtr<VirtualChunkedDriver>(
@@ -736,6 +795,8 @@ Result<internal::Driver::Handle> MakeDriver(
     spec.data_staleness = StalenessBound(options.recheck_cached_data);
   }
 
+  spec.concurrency_limit = options.concurrency_limit.value;
+
   return VirtualChunkedDriver::OpenFromSpecData(std::move(options.transaction),
                                                 spec);
 }
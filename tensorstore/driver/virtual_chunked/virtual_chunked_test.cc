@@ -289,6 +289,38 @@ TEST(VirtualChunkedTest, InnerOrder) {
                         }));
 }
 
+TEST(VirtualChunkedTest, ConcurrencyLimit) {
+  ConcurrentQueue<ReadRequest<int, 1>> requests;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto mock_view,
+      MockView<int, 1>(requests, tensorstore::Schema::Shape({4}),
+                       tensorstore::ChunkLayout::ReadChunkShape({1}),
+                       tensorstore::virtual_chunked::ConcurrencyLimit{2}));
+  auto read_future = tensorstore::Read(mock_view);
+  read_future.Force();
+  auto complete = [](ReadRequest<int, 1> request) {
+    const Index i = request.array.origin()[0];
+    request.array(i) = static_cast<int>(i) + 10;
+    request.promise.SetResult(TimestampedStorageGeneration(
+        StorageGeneration::FromString("abc"), absl::Now()));
+  };
+  auto r0 = requests.pop();
+  auto r1 = requests.pop();
+  // Two calls are in progress, so no other call may start.
+  absl::SleepFor(absl::Milliseconds(10));
+  EXPECT_FALSE(requests.pop_nonblock());
+  complete(std::move(r0));
+  auto r2 = requests.pop();
+  absl::SleepFor(absl::Milliseconds(10));
+  EXPECT_FALSE(requests.pop_nonblock());
+  complete(std::move(r1));
+  complete(requests.pop());
+  complete(std::move(r2));
+  EXPECT_THAT(read_future.result(),
+              ::testing::Optional(
+                  tensorstore::MakeArray<int>({10, 11, 12, 13})));
+}
+
 // Tests that the read_function is not called to validate a cached chunk that
 // has a timestamp in the past, in the case that `RecheckCachedData{false}` is
 // specified.
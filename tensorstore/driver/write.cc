@@ -19,6 +19,7 @@
 #include <utility>
 
 #include "absl/status/status.h"
+#include "tensorstore/access_recorder.h"
 #include "tensorstore/data_type.h"
 #include "tensorstore/data_type_conversion.h"
 #include "tensorstore/driver/chunk.h"
@@ -28,6 +29,7 @@
 #include "tensorstore/index_space/alignment.h"
 #include "tensorstore/index_space/index_transform.h"
 #include "tensorstore/index_space/transformed_array.h"
+#include "tensorstore/internal/concurrent_arena.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/lock_collection.h"
 #include "tensorstore/internal/meta/type_traits.h"
@@ -37,8 +39,11 @@
 #include "tensorstore/internal/nditerable_transformed_array.h"
 #include "tensorstore/internal/nditerable_util.h"
 #include "tensorstore/internal/tagged_ptr.h"
+#include "tensorstore/internal/tracing/operation_stats.h"
 #include "tensorstore/internal/tracing/operation_trace_span.h"
+#include "tensorstore/internal/tracing/trace_context.h"
 #include "tensorstore/open_mode.h"
+#include "tensorstore/operation_stats.h"
 #include "tensorstore/progress.h"
 #include "tensorstore/read_write_options.h"
 #include "tensorstore/resize_options.h"
@@ -124,10 +129,13 @@ struct WriteState : public internal::AtomicReferenceCount<WriteState> {
   DriverPtr target_driver;
   internal::OpenTransactionPtr target_transaction;
   DomainAlignmentOptions alignment_options;
+  AccessRecorder access_recorder;
   Promise<void> copy_promise;
   Promise<void> commit_promise;
   IntrusivePtr<CommitState> commit_state{new CommitState};
   internal_tracing::OperationTraceSpan tspan{"tensorstore.Write"};
+  /// Holds the `WriteChunkOp` of each chunk until the chunk has been copied.
+  ConcurrentArena chunk_op_arena;
 
   void SetError(absl::Status error) {
     SetDeferredResult(copy_promise, std::move(error));
@@ -175,15 +183,16 @@ struct WriteChunkOp {
         copy_status = std::move(write_array_result.copy_status);
         commit_future = std::move(write_array_result.commit_future);
       } else {
-        // Fallback to normal nditerable path.
+        // Fallback to normal nditerable path.  The source iterable is obtained
+        // first, since once `BeginWrite` succeeds, `EndWrite` must be called.
         TENSORSTORE_ASSIGN_OR_RETURN(
-            auto target_iterable,
-            chunk.impl(WriteChunk::BeginWrite{}, chunk.transform, arena),
+            auto source_iterable,
+            GetTransformedArrayNDIterable(std::move(source), arena),
             state->SetError(_));
 
         TENSORSTORE_ASSIGN_OR_RETURN(
-            auto source_iterable,
-            GetTransformedArrayNDIterable(std::move(source), arena),
+            auto target_iterable,
+            chunk.impl(WriteChunk::BeginWrite{}, chunk.transform, arena),
             state->SetError(_));
 
         source_iterable = GetConvertedInputNDIterable(
@@ -243,8 +252,9 @@ struct WriteChunkReceiver {
     // this may be called.
     //
     // Don't move `state` since `set_value` may be called multiple times.
-    state->executor(
-        WriteChunkOp{state, std::move(chunk), std::move(cell_transform)});
+    state->executor(ArenaTask(
+        state, state->chunk_op_arena,
+        WriteChunkOp{state, std::move(chunk), std::move(cell_transform)}));
   }
 };
 
@@ -265,6 +275,7 @@ struct DriverWriteInitiateOp {
     state->commit_state->total_elements =
         target_transform.domain().num_elements();
     state->copy_promise = std::move(promise);
+    state->access_recorder.Record(target_transform, /*is_write=*/true);
 
     // Initiate the write on the driver.
     auto target_driver = std::move(state->target_driver);
@@ -283,6 +294,10 @@ WriteFutures DriverWrite(Executor executor,
                          DriverHandle target, DriverWriteOptions options) {
   TENSORSTORE_RETURN_IF_ERROR(
       internal::ValidateSupportsWrite(target.driver.read_write_mode()));
+  // I/O performed on behalf of the operation, including by asynchronous work
+  // started within this scope, is attributed to `options.operation_stats`.
+  internal_tracing::ScopedOperationStats stats_scope(
+      internal_tracing::OperationStatsAccess::state(options.operation_stats));
   IntrusivePtr<WriteState> state(new WriteState);
   state->executor = executor;
   TENSORSTORE_ASSIGN_OR_RETURN(
@@ -297,6 +312,7 @@ WriteFutures DriverWrite(Executor executor,
   state->source_data_reference_restriction =
       options.source_data_reference_restriction;
   state->alignment_options = options.alignment_options;
+  state->access_recorder = std::move(options.access_recorder);
   state->commit_state->write_progress_function =
       std::move(options.progress_function);
   auto copy_pair = PromiseFuturePair<void>::Make(MakeResult());
@@ -310,6 +326,7 @@ WriteFutures DriverWrite(Executor executor,
   }
 
   // Resolve the bounds for `target.transform`.
+  internal_tracing::ScopedTraceContext trace_scope(state->tspan.context());
   Driver::ResolveBoundsRequest request;
   request.transaction = state->target_transaction;
   request.transform = std::move(target.transform);
@@ -0,0 +1,147 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/driver/zarr/consolidated_metadata.h"
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/batch.h"
+#include "tensorstore/internal/path.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/quote_string.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace internal_zarr {
+
+namespace {
+
+constexpr int kConsolidatedFormat = 1;
+
+bool IsConsolidatedKey(std::string_view key) {
+  std::string_view name = key.substr(key.rfind('/') + 1);
+  return name == ".zarray" || name == ".zgroup" || name == ".zattrs";
+}
+
+struct ConsolidateState {
+  KvStore group;
+  std::vector<std::string> keys;
+  std::vector<Future<kvstore::ReadResult>> reads;
+};
+
+void WriteConsolidated(std::shared_ptr<ConsolidateState> state,
+                       Promise<void> promise) {
+  ::nlohmann::json::object_t metadata;
+  for (size_t i = 0; i < state->keys.size(); ++i) {
+    auto read_result = state->reads[i].value();
+    // Documents deleted since they were listed are skipped.
+    if (!read_result.has_value()) continue;
+    auto j = ::nlohmann::json::parse(read_result.value.Flatten(), nullptr,
+                                     /*allow_exceptions=*/false);
+    if (j.is_discarded()) {
+      promise.SetResult(absl::FailedPreconditionError(tensorstore::StrCat(
+          "Invalid JSON in ", tensorstore::QuoteString(state->keys[i]))));
+      return;
+    }
+    metadata.emplace(state->keys[i], std::move(j));
+  }
+  ::nlohmann::json consolidated{
+      {"metadata", std::move(metadata)},
+      {"zarr_consolidated_format", kConsolidatedFormat},
+  };
+  LinkValue(
+      [](Promise<void> promise,
+         ReadyFuture<TimestampedStorageGeneration> future) {
+        promise.SetResult(absl::OkStatus());
+      },
+      std::move(promise),
+      kvstore::Write(state->group, kConsolidatedMetadataKey,
+                     absl::Cord(consolidated.dump())));
+}
+
+}  // namespace
+
+Result<::nlohmann::json> GetConsolidatedMetadataEntry(absl::Cord encoded,
+                                                      std::string_view key) {
+  auto j = ::nlohmann::json::parse(encoded.Flatten(), nullptr,
+                                   /*allow_exceptions=*/false);
+  if (!j.is_object() ||
+      j.value("zarr_consolidated_format", 0) != kConsolidatedFormat) {
+    return absl::FailedPreconditionError(
+        "Invalid consolidated metadata: expected JSON object with "
+        "\"zarr_consolidated_format\" of 1");
+  }
+  auto metadata = j.find("metadata");
+  if (metadata == j.end() || !metadata->is_object()) {
+    return absl::FailedPreconditionError(
+        "Invalid consolidated metadata: expected \"metadata\" object");
+  }
+  auto entry = metadata->find(key);
+  if (entry == metadata->end()) {
+    return absl::NotFoundError(
+        tensorstore::StrCat("Consolidated metadata has no entry for ",
+                            tensorstore::QuoteString(key)));
+  }
+  return std::move(*entry);
+}
+
+Future<const void> WriteConsolidatedMetadata(KvStore group) {
+  internal::EnsureDirectoryPath(group.path);
+  auto list_future = kvstore::ListFuture(group);
+  return PromiseFuturePair<void>::LinkValue(
+             [group = std::move(group)](
+                 Promise<void> promise,
+                 ReadyFuture<std::vector<kvstore::ListEntry>> future) mutable {
+               auto state = std::make_shared<ConsolidateState>();
+               state->group = std::move(group);
+               {
+                 auto batch = Batch::New();
+                 kvstore::ReadOptions options;
+                 options.batch = batch;
+                 for (auto& entry : future.value()) {
+                   if (!IsConsolidatedKey(entry.key)) continue;
+                   state->reads.push_back(
+                       kvstore::Read(state->group, entry.key, options));
+                   state->keys.push_back(std::move(entry.key));
+                 }
+               }
+               auto all_read = WaitAllFuture(tensorstore::span(state->reads));
+               LinkValue(
+                   [state = std::move(state)](Promise<void> promise,
+                                              ReadyFuture<void> future) {
+                     WriteConsolidated(std::move(state), std::move(promise));
+                   },
+                   std::move(promise), std::move(all_read));
+             },
+             std::move(list_future))
+      .future;
+}
+
+}  // namespace internal_zarr
+}  // namespace tensorstore
@@ -0,0 +1,55 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_DRIVER_ZARR_CONSOLIDATED_METADATA_H_
+#define TENSORSTORE_DRIVER_ZARR_CONSOLIDATED_METADATA_H_
+
+// Support for the consolidated metadata written by zarr-python's
+// `zarr.consolidate_metadata`, which stores the metadata documents of a group
+// and all of its descendants in a single `.zmetadata` document.
+
+#include <string_view>
+
+#include "absl/strings/cord.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal_zarr {
+
+/// Key, relative to the group, of the consolidated metadata document.
+constexpr inline std::string_view kConsolidatedMetadataKey = ".zmetadata";
+
+/// Returns the metadata document stored under `key` (relative to the group,
+/// e.g. "a/b/.zarray") in the encoded consolidated metadata.
+///
+/// \error `absl::StatusCode::kFailedPrecondition` if `encoded` is not valid
+///     consolidated metadata.
+/// \error `absl::StatusCode::kNotFound` if there is no entry for `key`.
+Result<::nlohmann::json> GetConsolidatedMetadataEntry(absl::Cord encoded,
+                                                      std::string_view key);
+
+/// Writes the consolidated metadata for the group at `group.path`.
+///
+/// The consolidated metadata includes the `.zarray`, `.zgroup`, and `.zattrs`
+/// documents of the group and of all of its descendants.  Any existing
+/// consolidated metadata is overwritten.
+Future<const void> WriteConsolidatedMetadata(KvStore group);
+
+}  // namespace internal_zarr
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_DRIVER_ZARR_CONSOLIDATED_METADATA_H_
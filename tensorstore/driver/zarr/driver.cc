@@ -20,6 +20,7 @@
 #include <cassert>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -28,6 +29,7 @@
 #include "absl/container/inlined_vector.h"
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
+#include "absl/strings/match.h"
 #include <nlohmann/json_fwd.hpp>
 #include "tensorstore/array.h"
 #include "tensorstore/array_storage_statistics.h"
@@ -40,6 +42,7 @@
 #include "tensorstore/driver/kvs_backed_chunk_driver.h"
 #include "tensorstore/driver/registry.h"
 #include "tensorstore/driver/url_registry.h"
+#include "tensorstore/driver/zarr/consolidated_metadata.h"
 #include "tensorstore/driver/zarr/driver_impl.h"
 #include "tensorstore/driver/zarr/metadata.h"
 #include "tensorstore/driver/zarr/spec.h"
@@ -52,23 +55,30 @@
 #include "tensorstore/internal/async_write_array.h"
 #include "tensorstore/internal/cache/cache.h"
 #include "tensorstore/internal/cache_key/cache_key.h"
+#include "tensorstore/internal/cache_key/std_optional.h"
 #include "tensorstore/internal/chunk_grid_specification.h"
+#include "tensorstore/internal/grid_chunk_key_ranges.h"
+#include "tensorstore/internal/grid_chunk_key_ranges_base10.h"
 #include "tensorstore/internal/grid_storage_statistics.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json_binding/bindable.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
 #include "tensorstore/internal/uri_utils.h"
 #include "tensorstore/kvstore/auto_detect.h"
+#include "tensorstore/kvstore/driver.h"
+#include "tensorstore/kvstore/key_range.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/kvstore/spec.h"
 #include "tensorstore/open_mode.h"
 #include "tensorstore/open_options.h"
 #include "tensorstore/rank.h"
+#include "tensorstore/serialization/std_optional.h"
 #include "tensorstore/transaction.h"
 #include "tensorstore/util/dimension_set.h"
 #include "tensorstore/util/executor.h"
 #include "tensorstore/util/future.h"
 #include "tensorstore/util/garbage_collection/fwd.h"
+#include "tensorstore/util/quote_string.h"
 #include "tensorstore/util/result.h"
 #include "tensorstore/util/span.h"
 #include "tensorstore/util/status.h"
@@ -129,6 +139,30 @@ Result<absl::Cord> MetadataCache::EncodeMetadata(std::string_view entry_key,
       ::nlohmann::json(*static_cast<const ZarrMetadata*>(metadata)).dump());
 }
 
+std::string ConsolidatedMetadataCache::GetMetadataStorageKey(
+    std::string_view entry_key) {
+  return tensorstore::StrCat(group_path_, kConsolidatedMetadataKey);
+}
+
+Result<MetadataCache::MetadataPtr> ConsolidatedMetadataCache::DecodeMetadata(
+    std::string_view entry_key, absl::Cord encoded_metadata) {
+  assert(absl::StartsWith(entry_key, group_path_));
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto metadata_json,
+      GetConsolidatedMetadataEntry(std::move(encoded_metadata),
+                                   entry_key.substr(group_path_.size())));
+  auto metadata = std::make_shared<ZarrMetadata>();
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      *metadata, ZarrMetadata::FromJson(std::move(metadata_json)));
+  return metadata;
+}
+
+Result<absl::Cord> ConsolidatedMetadataCache::EncodeMetadata(
+    std::string_view entry_key, const void* metadata) {
+  return absl::FailedPreconditionError(
+      "Cannot modify metadata of array opened using consolidated metadata");
+}
+
 absl::Status ZarrDriverSpec::ApplyOptions(SpecOptions&& options) {
   if (options.minimal_spec) {
     partial_metadata = ZarrPartialMetadata{};
@@ -151,6 +185,9 @@ TENSORSTORE_DEFINE_JSON_DEFAULT_BINDER(
                    jb::Projection<&ZarrDriverSpec::metadata_key>(
                        jb::DefaultValue<jb::kNeverIncludeDefaults>(
                            [](auto* obj) { *obj = kDefaultMetadataKey; }))),
+        jb::Member(
+            "consolidated_metadata_group",
+            jb::Projection<&ZarrDriverSpec::consolidated_metadata_group>()),
         // Deprecated `key_encoding` property.
         jb::LoadSave(jb::OptionalMember(
             "key_encoding",
@@ -238,13 +275,15 @@ Result<SharedArray<const void>> ZarrDriverSpec::GetFillValue(
 
 DataCache::DataCache(Initializer&& initializer, std::string key_prefix,
                      DimensionSeparator dimension_separator,
-                     std::string metadata_key)
+                     std::string metadata_key,
+                     std::optional<std::string> consolidated_metadata_group)
     : Base(std::move(initializer),
            GetChunkGridSpecification(
                *static_cast<const ZarrMetadata*>(initializer.metadata.get()))),
       key_prefix_(std::move(key_prefix)),
       dimension_separator_(dimension_separator),
-      metadata_key_(std::move(metadata_key)) {}
+      metadata_key_(std::move(metadata_key)),
+      consolidated_metadata_group_(std::move(consolidated_metadata_group)) {}
 
 absl::Status DataCache::ValidateMetadataCompatibility(
     const void* existing_metadata_ptr, const void* new_metadata_ptr) {
@@ -349,6 +388,37 @@ std::string DataCache::GetChunkStorageKey(span<const Index> cell_indices) {
       key_prefix_, EncodeChunkIndices(cell_indices, dimension_separator_));
 }
 
+Future<const void> DataCache::DeleteCells(
+    BoxView<> cell_bounds, BoxView<> grid_bounds,
+    internal::OpenTransactionPtr transaction) {
+  if (transaction || cell_bounds.rank() == 0 || !IsFinite(grid_bounds)) {
+    return Base::DeleteCells(cell_bounds, grid_bounds, std::move(transaction));
+  }
+  auto pair = PromiseFuturePair<void>::Make(MakeResult(absl::Status()));
+  pair.future.Force();
+  kvstore::Driver* kvstore_driver = this->kvstore_driver();
+  const internal::Base10LexicographicalGridIndexKeyParser key_formatter(
+      cell_bounds.rank(), GetDimensionSeparatorChar(dimension_separator_));
+  auto status =
+      internal::GetChunkKeyRangesForRegularGridWithSemiLexicographicalKeys(
+          cell_bounds, grid_bounds, key_formatter,
+          [&](std::string key, span<const Index> grid_indices) {
+            LinkError(pair.promise,
+                      kvstore_driver->Write(
+                          tensorstore::StrCat(key_prefix_, key), std::nullopt,
+                          {}));
+            return absl::OkStatus();
+          },
+          [&](KeyRange key_range, BoxView<> sub_bounds) {
+            LinkError(pair.promise,
+                      kvstore_driver->DeleteRange(KeyRange::AddPrefix(
+                          key_prefix_, std::move(key_range))));
+            return absl::OkStatus();
+          });
+  if (!status.ok()) pair.promise.SetResult(std::move(status));
+  return pair.future;
+}
+
 absl::Status DataCache::GetBoundSpecData(
     internal_kvs_backed_chunk_driver::KvsDriverSpec& spec_base,
     const void* metadata_ptr, size_t component_index) {
@@ -356,6 +426,7 @@ absl::Status DataCache::GetBoundSpecData(
   const auto& metadata = *static_cast<const ZarrMetadata*>(metadata_ptr);
   spec.selected_field = EncodeSelectedField(component_index, metadata.dtype);
   spec.metadata_key = metadata_key_;
+  spec.consolidated_metadata_group = consolidated_metadata_group_;
   auto& pm = spec.partial_metadata;
   pm.rank = metadata.rank;
   pm.zarr_format = metadata.zarr_format;
@@ -404,6 +475,17 @@ Result<SharedArray<const void>> ZarrDriver::GetFillValue(
 
 Future<internal::Driver::Handle> ZarrDriverSpec::Open(
     DriverOpenRequest request) const {
+  if (consolidated_metadata_group) {
+    const auto& group = *consolidated_metadata_group;
+    if ((!group.empty() && group.back() != '/') ||
+        !absl::StartsWith(store.path, group)) {
+      return absl::InvalidArgumentError(tensorstore::StrCat(
+          "\"consolidated_metadata_group\" must be a directory path that is "
+          "a prefix of the kvstore path ",
+          tensorstore::QuoteString(store.path), ", but received: ",
+          tensorstore::QuoteString(group)));
+    }
+  }
   return ZarrDriver::Open(this, std::move(request));
 }
 
@@ -412,6 +494,10 @@ Result<std::string> ZarrDriverSpec::ToUrl() const {
     return absl::InvalidArgumentError(
         "zarr2 URL syntax not supported with non-default metadata_key");
   }
+  if (consolidated_metadata_group) {
+    return absl::InvalidArgumentError(
+        "zarr2 URL syntax not supported with consolidated_metadata_group");
+  }
   if (!selected_field.empty()) {
     return absl::InvalidArgumentError(
         "zarr2 URL syntax not supported with selected_field specified");
@@ -470,8 +556,18 @@ class ZarrDriver::OpenState : public ZarrDriver::OpenStateBase {
     return tensorstore::StrCat(spec().store.path, spec().metadata_key);
   }
 
+  std::string GetMetadataCacheKey() override {
+    std::string result;
+    internal::EncodeCacheKey(&result, spec().consolidated_metadata_group);
+    return result;
+  }
+
   std::unique_ptr<internal_kvs_backed_chunk_driver::MetadataCache>
   GetMetadataCache(MetadataCache::Initializer initializer) override {
+    if (const auto& group = spec().consolidated_metadata_group) {
+      return std::make_unique<ConsolidatedMetadataCache>(std::move(initializer),
+                                                         *group);
+    }
     return std::make_unique<MetadataCache>(std::move(initializer));
   }
 
@@ -480,6 +576,11 @@ class ZarrDriver::OpenState : public ZarrDriver::OpenStateBase {
     if (existing_metadata) {
       return absl::AlreadyExistsError("");
     }
+    if (spec().consolidated_metadata_group) {
+      return absl::InvalidArgumentError(
+          "Cannot create array with \"consolidated_metadata_group\" "
+          "specified");
+    }
     TENSORSTORE_ASSIGN_OR_RETURN(
         auto metadata,
         internal_zarr::GetNewMetadata(spec().partial_metadata,
@@ -496,7 +597,7 @@ class ZarrDriver::OpenState : public ZarrDriver::OpenStateBase {
     internal::EncodeCacheKey(
         &result, spec.store.path,
         GetDimensionSeparator(spec.partial_metadata, zarr_metadata),
-        zarr_metadata, spec.metadata_key);
+        zarr_metadata, spec.metadata_key, spec.consolidated_metadata_group);
     return result;
   }
 
@@ -507,7 +608,7 @@ class ZarrDriver::OpenState : public ZarrDriver::OpenStateBase {
     return std::make_unique<DataCache>(
         std::move(initializer), spec().store.path,
         GetDimensionSeparator(spec().partial_metadata, metadata),
-        spec().metadata_key);
+        spec().metadata_key, spec().consolidated_metadata_group);
   }
 
   Result<size_t> GetComponentIndex(const void* metadata_ptr,
@@ -17,9 +17,12 @@
 
 #include <stddef.h>
 
+#include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 
+#include "absl/strings/cord.h"
 #include "tensorstore/driver/kvs_backed_chunk_driver.h"
 #include "tensorstore/driver/zarr/metadata.h"
 #include "tensorstore/driver/zarr/spec.h"
@@ -50,6 +53,31 @@ class MetadataCache : public internal_kvs_backed_chunk_driver::MetadataCache {
                                     const void* metadata) override;
 };
 
+/// Metadata cache that obtains the metadata of arrays within a group from the
+/// consolidated metadata of the group, rather than from each array's `.zarray`.
+///
+/// The entries of the cache all correspond to the same kvstore key, which
+/// allows the reads for many arrays to be coalesced when issued in the same
+/// batch.  Modifying the metadata is not supported.
+class ConsolidatedMetadataCache : public MetadataCache {
+ public:
+  explicit ConsolidatedMetadataCache(Initializer initializer,
+                                     std::string group_path)
+      : MetadataCache(std::move(initializer)),
+        group_path_(std::move(group_path)) {}
+
+  std::string GetMetadataStorageKey(std::string_view entry_key) override;
+
+  Result<MetadataPtr> DecodeMetadata(std::string_view entry_key,
+                                     absl::Cord encoded_metadata) override;
+
+  Result<absl::Cord> EncodeMetadata(std::string_view entry_key,
+                                    const void* metadata) override;
+
+ private:
+  std::string group_path_;
+};
+
 class ZarrDriverSpec
     : public internal::RegisteredDriverSpec<
           ZarrDriverSpec,
@@ -64,9 +92,13 @@ class ZarrDriverSpec
   SelectedField selected_field;
   std::string metadata_key;
 
+  /// If specified, kvstore path of the group from whose consolidated metadata
+  /// the array metadata is read.  Must be a prefix of `store.path`.
+  std::optional<std::string> consolidated_metadata_group;
+
   constexpr static auto ApplyMembers = [](auto& x, auto f) {
     return f(internal::BaseCast<KvsDriverSpec>(x), x.partial_metadata,
-             x.selected_field, x.metadata_key);
+             x.selected_field, x.metadata_key, x.consolidated_metadata_group);
   };
   absl::Status ApplyOptions(SpecOptions&& options) override;
 
@@ -98,7 +130,8 @@ class DataCache : public internal_kvs_backed_chunk_driver::DataCache {
  public:
   explicit DataCache(Initializer&& initializer, std::string key_prefix,
                      DimensionSeparator dimension_separator,
-                     std::string metadata_key);
+                     std::string metadata_key,
+                     std::optional<std::string> consolidated_metadata_group);
 
   const ZarrMetadata& metadata() {
     return *static_cast<const ZarrMetadata*>(initial_metadata().get());
@@ -128,6 +161,13 @@ class DataCache : public internal_kvs_backed_chunk_driver::DataCache {
 
   std::string GetChunkStorageKey(span<const Index> cell_indices) override;
 
+  /// Deletes the chunks within `cell_bounds` using the minimal set of key
+  /// ranges implied by the base-10 chunk keys, rather than one request per
+  /// chunk.  Deletes within a transaction use the per-chunk default.
+  Future<const void> DeleteCells(
+      BoxView<> cell_bounds, BoxView<> grid_bounds,
+      internal::OpenTransactionPtr transaction) override;
+
   absl::Status GetBoundSpecData(
       internal_kvs_backed_chunk_driver::KvsDriverSpec& spec_base,
       const void* metadata_ptr, size_t component_index) override;
@@ -140,6 +180,7 @@ class DataCache : public internal_kvs_backed_chunk_driver::DataCache {
   std::string key_prefix_;
   DimensionSeparator dimension_separator_;
   std::string metadata_key_;
+  std::optional<std::string> consolidated_metadata_group_;
 };
 
 class ZarrDriver;
@@ -38,6 +38,7 @@
 #include "tensorstore/contiguous_layout.h"
 #include "tensorstore/data_type.h"
 #include "tensorstore/driver/driver_testutil.h"
+#include "tensorstore/driver/zarr/consolidated_metadata.h"
 #include "tensorstore/driver/zarr/dtype.h"
 #include "tensorstore/index.h"
 #include "tensorstore/index_space/dim_expression.h"
@@ -79,6 +80,8 @@
 namespace {
 
 namespace kvstore = tensorstore::kvstore;
+using ::tensorstore::Box;
+using ::tensorstore::BoxView;
 using ::tensorstore::ChunkLayout;
 using ::tensorstore::Context;
 using ::tensorstore::DimensionIndex;
@@ -1263,6 +1266,147 @@ TEST(ZarrDriverTest, Resize) {
   }
 }
 
+// Tests that shrinking deletes exactly the chunks outside the new bounds when
+// the deleted chunks are grouped into key ranges.
+TEST(ZarrDriverTest, ResizeDeletesKeyRanges) {
+  for (const char* separator : {".", "/"}) {
+    SCOPED_TRACE(StrCat("separator=", separator));
+    auto context = Context::Default();
+    ::nlohmann::json storage_spec{{"driver", "memory"}};
+    ::nlohmann::json zarr_metadata_json = GetBasicResizeMetadata();
+    zarr_metadata_json["shape"] = {36, 2};
+    zarr_metadata_json["dimension_separator"] = separator;
+    ::nlohmann::json json_spec{
+        {"driver", "zarr"},
+        {"kvstore", storage_spec},
+        {"path", "prefix/"},
+        {"metadata", zarr_metadata_json},
+    };
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto store,
+        tensorstore::Open(json_spec, context, tensorstore::OpenMode::create,
+                          tensorstore::ReadWriteMode::read_write)
+            .result());
+    TENSORSTORE_EXPECT_OK(
+        tensorstore::Write(tensorstore::MakeScalarArray<int8_t>(1), store));
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto kvs, kvstore::Open(storage_spec, context).result());
+    EXPECT_THAT(GetMap(kvs).value(), ::testing::SizeIs(13));
+
+    // Keeps chunks 0 and 1, and deletes chunks 2-9 individually and chunks
+    // 10-11 as a key range.
+    TENSORSTORE_ASSERT_OK(
+        Resize(store, tensorstore::span<const Index>({kImplicit, kImplicit}),
+               tensorstore::span<const Index>({6, 2}),
+               tensorstore::shrink_only));
+    EXPECT_THAT(
+        GetMap(kvs).value(),
+        UnorderedElementsAre(Pair("prefix/.zarray", ::testing::_),
+                             Pair(StrCat("prefix/0", separator, "0"),
+                                  Bytes({1, 1, 1, 1, 1, 1})),
+                             Pair(StrCat("prefix/1", separator, "0"),
+                                  Bytes({1, 1, 1, 1, 1, 1}))));
+  }
+}
+
+TEST(ZarrDriverTest, TransactionSpill) {
+  auto context = Context::Default();
+  ::nlohmann::json zarr_metadata_json = GetBasicResizeMetadata();
+  zarr_metadata_json["shape"] = {30, 2};
+  ::nlohmann::json json_spec{
+      {"driver", "zarr"},
+      {"kvstore", {{"driver", "memory"}}},
+      {"metadata", zarr_metadata_json},
+  };
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      tensorstore::Open(json_spec, context, tensorstore::OpenMode::create,
+                        tensorstore::ReadWriteMode::read_write)
+          .result());
+  auto expected = tensorstore::AllocateArray<int8_t>({30, 2});
+  for (Index i = 0; i < 30; ++i) {
+    expected(i, 0) = expected(i, 1) = static_cast<int8_t>(i / 3);
+  }
+  const auto write_chunks = [&](const tensorstore::Transaction& transaction) {
+    for (int i = 0; i < 10; ++i) {
+      TENSORSTORE_EXPECT_OK(tensorstore::Write(
+          tensorstore::MakeScalarArray<int8_t>(i),
+          store | transaction |
+              tensorstore::Dims(0).HalfOpenInterval(i * 3, i * 3 + 3)));
+    }
+  };
+
+  size_t unspilled_bytes;
+  {
+    tensorstore::Transaction transaction(tensorstore::atomic_isolated);
+    write_chunks(transaction);
+    unspilled_bytes = transaction.total_bytes();
+    transaction.Abort();
+  }
+
+  tensorstore::TransactionOptions options;
+  options.spill_threshold_bytes = 1;
+  options.spill_kvstore = "memory://";
+  tensorstore::Transaction transaction(tensorstore::atomic_isolated, options);
+  write_chunks(transaction);
+  // Chunks are spilled in the background once no longer in use.
+  for (int i = 0; i < 1000 && transaction.total_bytes() >= unspilled_bytes;
+       ++i) {
+    absl::SleepFor(absl::Milliseconds(10));
+  }
+  EXPECT_LT(transaction.total_bytes(), unspilled_bytes);
+
+  // Spilled chunks are visible to reads within the transaction.
+  EXPECT_THAT(tensorstore::Read(store | transaction).result(),
+              ::testing::Optional(expected));
+  TENSORSTORE_ASSERT_OK(transaction.CommitAsync().result());
+  EXPECT_THAT(tensorstore::Read(store).result(),
+              ::testing::Optional(expected));
+}
+
+// Tests that resizing to zero deletes all chunks, but not the metadata or other
+// keys of the kvstore.
+TEST(ZarrDriverTest, ResizeToZeroKeepsMetadata) {
+  for (const char* path : {"", "prefix/"}) {
+    SCOPED_TRACE(StrCat("path=", path));
+    auto context = Context::Default();
+    ::nlohmann::json storage_spec{{"driver", "memory"}};
+    ::nlohmann::json zarr_metadata_json = GetBasicResizeMetadata();
+    zarr_metadata_json["shape"] = {36, 2};
+    ::nlohmann::json json_spec{
+        {"driver", "zarr"},
+        {"kvstore", storage_spec},
+        {"path", path},
+        {"metadata", zarr_metadata_json},
+    };
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto store,
+        tensorstore::Open(json_spec, context, tensorstore::OpenMode::create,
+                          tensorstore::ReadWriteMode::read_write)
+            .result());
+    TENSORSTORE_EXPECT_OK(
+        tensorstore::Write(tensorstore::MakeScalarArray<int8_t>(1), store));
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto kvs, kvstore::Open(storage_spec, context).result());
+    TENSORSTORE_ASSERT_OK(kvstore::Write(kvs, "other", absl::Cord("x")));
+    EXPECT_THAT(GetMap(kvs).value(), ::testing::SizeIs(14));
+
+    TENSORSTORE_ASSERT_OK(
+        Resize(store, tensorstore::span<const Index>({kImplicit, kImplicit}),
+               tensorstore::span<const Index>({0, 2}),
+               tensorstore::shrink_only));
+    EXPECT_THAT(
+        GetMap(kvs).value(),
+        UnorderedElementsAre(Pair(StrCat(path, ".zarray"), ::testing::_),
+                             Pair("other", "x")));
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto reopened,
+        tensorstore::Open(json_spec, context, tensorstore::OpenMode::open)
+            .result());
+    EXPECT_EQ(tensorstore::BoxView<>({0, 0}, {0, 2}), reopened.domain().box());
+  }
+}
+
 // Tests that zero-size resizable dimensions are handled correctly.
 //
 // `op...` should be a pack of functions that can be applied to a `TensorStore`,
@@ -3476,4 +3620,237 @@ TEST(DriverTest, UrlSchemeRoundtrip) {
        {"kvstore", {{"driver", "memory"}, {"path", "abc.zarr/def/"}}}});
 }
 
+TEST(DriverTest, ConsolidatedMetadata) {
+  auto context = Context::Default();
+  auto get_spec = [](std::string path) -> ::nlohmann::json {
+    return {{"driver", "zarr"},
+            {"kvstore", {{"driver", "memory"}, {"path", std::move(path)}}}};
+  };
+  auto create_spec = [&](std::string path) {
+    auto spec = get_spec(std::move(path));
+    spec["metadata"] = {{"dtype", "<u2"},
+                        {"shape", {4}},
+                        {"chunks", {2}},
+                        {"compressor", nullptr}};
+    return spec;
+  };
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store_a, tensorstore::Open(create_spec("group/a/"), context,
+                                      tensorstore::OpenMode::create)
+                        .result());
+  TENSORSTORE_ASSERT_OK(tensorstore::Open(create_spec("group/b/c/"), context,
+                                          tensorstore::OpenMode::create)
+                            .result());
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Write(tensorstore::MakeArray<uint16_t>({1, 2, 3, 4}),
+                         store_a)
+          .commit_future.result());
+  kvstore::KvStore group(store_a.kvstore().driver, "group/");
+  TENSORSTORE_ASSERT_OK(
+      kvstore::Write(group, ".zgroup", absl::Cord(R"({"zarr_format":2})"))
+          .result());
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::internal_zarr::WriteConsolidatedMetadata(group).result());
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto consolidated,
+                                   kvstore::Read(group, ".zmetadata").result());
+  ASSERT_TRUE(consolidated.has_value());
+  auto consolidated_json =
+      ::nlohmann::json::parse(std::string(consolidated.value));
+  EXPECT_EQ(1, consolidated_json["zarr_consolidated_format"]);
+  std::vector<std::string> consolidated_keys;
+  for (const auto& [key, value] : consolidated_json["metadata"].items()) {
+    consolidated_keys.push_back(key);
+  }
+  EXPECT_THAT(consolidated_keys, ::testing::UnorderedElementsAre(
+                                     ".zgroup", "a/.zarray", "b/c/.zarray"));
+
+  // The individual metadata documents are not read.
+  TENSORSTORE_ASSERT_OK(kvstore::Delete(group, "a/.zarray").result());
+
+  auto consolidated_spec = get_spec("group/a/");
+  consolidated_spec["consolidated_metadata_group"] = "group/";
+  {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto store, tensorstore::Open(consolidated_spec, context,
+                                      tensorstore::OpenMode::open)
+                        .result());
+    EXPECT_THAT(tensorstore::Read(store).result(),
+                ::testing::Optional(
+                    tensorstore::MakeArray<uint16_t>({1, 2, 3, 4})));
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto spec, store.spec());
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto spec_json, spec.ToJson());
+    EXPECT_EQ("group/", spec_json["consolidated_metadata_group"]);
+    EXPECT_THAT(
+        tensorstore::Resize(store, tensorstore::span<const Index>({kImplicit}),
+                            tensorstore::span<const Index>({6}))
+            .result(),
+        MatchesStatus(absl::StatusCode::kFailedPrecondition));
+  }
+
+  // Array not present in the consolidated metadata.
+  auto missing_spec = get_spec("group/d/");
+  missing_spec["consolidated_metadata_group"] = "group/";
+  EXPECT_THAT(tensorstore::Open(missing_spec, context,
+                                tensorstore::OpenMode::open)
+                  .result(),
+              MatchesStatus(absl::StatusCode::kNotFound));
+
+  // Arrays cannot be created using consolidated metadata.
+  auto missing_create_spec = create_spec("group/d/");
+  missing_create_spec["consolidated_metadata_group"] = "group/";
+  EXPECT_THAT(tensorstore::Open(missing_create_spec, context,
+                                tensorstore::OpenMode::create)
+                  .result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument));
+
+  // Group must contain the array.
+  auto invalid_spec = get_spec("group/a/");
+  invalid_spec["consolidated_metadata_group"] = "other/";
+  EXPECT_THAT(tensorstore::Open(invalid_spec, context,
+                                tensorstore::OpenMode::open)
+                  .result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            ".*must be a directory path that is a prefix.*"));
+}
+
+TEST(ZarrDriverTest, RecheckCachedMissingData) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto context,
+      Context::FromJson({{"cache_pool", {{"total_bytes_limit", 1000000}}}}));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto mock_kvstore_resource,
+      context.GetResource<tensorstore::internal::MockKeyValueStoreResource>());
+  auto mock_kvstore = *mock_kvstore_resource;
+  mock_kvstore->forward_to = tensorstore::GetMemoryKeyValueStore();
+  mock_kvstore->log_requests = true;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      tensorstore::Open({{"driver", "zarr"},
+                         {"kvstore", {{"driver", "mock_key_value_store"}}},
+                         {"recheck_cached_missing_data", "open"}},
+                        tensorstore::OpenMode::create, context,
+                        dtype_v<uint16_t>, Schema::Shape({4, 4}),
+                        ChunkLayout::ChunkShape({2, 2}))
+          .result());
+  TENSORSTORE_ASSERT_OK(tensorstore::Write(
+      tensorstore::MakeScalarArray<uint16_t>(42),
+      store | tensorstore::Dims(0, 1).SizedInterval({0, 0}, {2, 2})));
+  mock_kvstore->request_log.pop_all();
+
+  TENSORSTORE_ASSERT_OK(tensorstore::Read(store));
+  EXPECT_THAT(mock_kvstore->request_log.pop_all(), ::testing::SizeIs(4));
+
+  // Only the chunk that is present is revalidated.
+  TENSORSTORE_ASSERT_OK(tensorstore::Read(store));
+  EXPECT_THAT(mock_kvstore->request_log.pop_all(), ::testing::SizeIs(1));
+}
+
+TEST(ZarrDriverTest, ListChunksOnOpen) {
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto mock_kvstore_resource,
+      context.GetResource<tensorstore::internal::MockKeyValueStoreResource>());
+  auto mock_kvstore = *mock_kvstore_resource;
+  mock_kvstore->forward_to = tensorstore::GetMemoryKeyValueStore();
+  ::nlohmann::json json_spec{
+      {"driver", "zarr"}, {"kvstore", {{"driver", "mock_key_value_store"}}}};
+  {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto store, tensorstore::Open(json_spec, tensorstore::OpenMode::create,
+                                      context, dtype_v<uint16_t>,
+                                      Schema::Shape({4, 4}),
+                                      ChunkLayout::ChunkShape({2, 2}))
+                        .result());
+    TENSORSTORE_ASSERT_OK(tensorstore::Write(
+        tensorstore::MakeScalarArray<uint16_t>(42),
+        store | tensorstore::Dims(0, 1).SizedInterval({0, 0}, {2, 2})));
+  }
+  json_spec["list_chunks_on_open"] = true;
+  json_spec["recheck_cached_missing_data"] = "open";
+  mock_kvstore->log_requests = true;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      tensorstore::Open(json_spec, tensorstore::OpenMode::open, context)
+          .result());
+  EXPECT_THAT(mock_kvstore->request_log.pop_all(),
+              ::testing::Contains(MatchesJson(
+                  {{"type", "list"}, {"range", {"", ""}}})));
+
+  // Chunks absent from the listing are not read.
+  EXPECT_THAT(
+      tensorstore::Read(store).result(),
+      ::testing::Optional(tensorstore::MakeArray<uint16_t>(
+          {{42, 42, 0, 0}, {42, 42, 0, 0}, {0, 0, 0, 0}, {0, 0, 0, 0}})));
+  EXPECT_THAT(mock_kvstore->request_log.pop_all(), ::testing::SizeIs(1));
+
+  // A chunk written after the listing is read.
+  TENSORSTORE_ASSERT_OK(tensorstore::Write(
+      tensorstore::MakeScalarArray<uint16_t>(7),
+      store | tensorstore::Dims(0, 1).SizedInterval({2, 2}, {2, 2})));
+  mock_kvstore->request_log.pop_all();
+  EXPECT_THAT(
+      tensorstore::Read(store).result(),
+      ::testing::Optional(tensorstore::MakeArray<uint16_t>(
+          {{42, 42, 0, 0}, {42, 42, 0, 0}, {0, 0, 7, 7}, {0, 0, 7, 7}})));
+  EXPECT_THAT(mock_kvstore->request_log.pop_all(), ::testing::SizeIs(2));
+}
+
+TEST(ZarrDriverTest, ChunkSummaries) {
+  auto context = Context::Default();
+  ::nlohmann::json json_spec{{"driver", "zarr"},
+                             {"kvstore", {{"driver", "memory"}}},
+                             {"chunk_summaries", true}};
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, tensorstore::Open(json_spec, tensorstore::OpenMode::create,
+                                    context, dtype_v<uint16_t>,
+                                    Schema::Shape({4, 4}),
+                                    ChunkLayout::ChunkShape({2, 2}))
+                      .result());
+  TENSORSTORE_ASSERT_OK(tensorstore::Write(
+      tensorstore::MakeScalarArray<uint16_t>(42),
+      store | tensorstore::Dims(0, 1).SizedInterval({0, 0}, {2, 2})));
+  TENSORSTORE_ASSERT_OK(tensorstore::Write(
+      tensorstore::MakeScalarArray<uint16_t>(7),
+      store | tensorstore::Dims(0, 1).SizedInterval({2, 2}, {1, 1})));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto summary,
+      kvstore::Read(store.kvstore(), ".chunk_summary/0.0")
+          .result());
+  EXPECT_TRUE(summary.has_value());
+
+  const auto get_boxes = [&](double inclusive_min, double inclusive_max) {
+    std::vector<Box<>> boxes;
+    auto regions = tensorstore::GetChunksInValueRange(store, inclusive_min,
+                                                      inclusive_max)
+                       .result();
+    EXPECT_TRUE(regions.ok()) << regions.status();
+    if (regions.ok()) {
+      for (const auto& region : *regions) {
+        boxes.emplace_back(region.domain().box());
+      }
+    }
+    return boxes;
+  };
+
+  // Only the chunk containing 42 can match.
+  EXPECT_THAT(get_boxes(40, 50),
+              ::testing::ElementsAre(BoxView({0, 0}, {2, 2})));
+
+  // The fill value matches, so all chunks but the one that is entirely 42.
+  EXPECT_THAT(get_boxes(0, 0),
+              ::testing::UnorderedElementsAre(BoxView({0, 2}, {2, 2}),
+                                              BoxView({2, 0}, {2, 2}),
+                                              BoxView({2, 2}, {2, 2})));
+
+  EXPECT_THAT(get_boxes(100, 200), ::testing::ElementsAre());
+
+  // A summary that does not match the generation of its chunk is ignored.
+  TENSORSTORE_ASSERT_OK(
+      kvstore::Write(store.kvstore(), "0.0", absl::Cord("x"))
+          .result());
+  EXPECT_THAT(get_boxes(100, 200),
+              ::testing::ElementsAre(BoxView({0, 0}, {2, 2})));
+}
+
 }  // namespace
@@ -39,7 +39,6 @@
 #include <nlohmann/json_fwd.hpp>
 #include "riegeli/bytes/cord_reader.h"
 #include "riegeli/bytes/cord_writer.h"
-#include "riegeli/bytes/read_all.h"
 #include "riegeli/bytes/reader.h"
 #include "riegeli/bytes/write.h"
 #include "riegeli/bytes/writer.h"
@@ -519,12 +518,34 @@ Result<absl::InlinedVector<SharedArray<const void>, 1>> DecodeChunk(
     return field_arrays;
   }
   if (metadata.compressor) {
+    // Decompress directly into a single flat buffer, from which the fields
+    // can be viewed in place or decoded without first flattening a
+    // fragmented `Cord`.
     riegeli::CordReader<absl::Cord> base_reader(std::move(buffer));
     auto compressed_reader = metadata.compressor->GetReader(
         base_reader, metadata.dtype.bytes_per_outer_element);
-    TENSORSTORE_RETURN_IF_ERROR(
-        riegeli::ReadAll(std::move(compressed_reader), buffer));
+    const size_t expected_size = metadata.chunk_layout.bytes_per_chunk;
+    const auto size_mismatch_error = [&](uint64_t size) {
+      return absl::InvalidArgumentError(tensorstore::StrCat(
+          "Uncompressed chunk is ", size, " bytes, but should be ",
+          expected_size, " bytes"));
+    };
+    internal::FlatCordBuilder decompressed(expected_size);
+    size_t length_read = 0;
+    if (!compressed_reader->Read(expected_size, decompressed.data(),
+                                 &length_read)) {
+      if (!compressed_reader->ok()) return compressed_reader->status();
+      return size_mismatch_error(length_read);
+    }
+    if (compressed_reader->Pull()) {
+      // Skip the remaining data to report the full uncompressed size.
+      compressed_reader->Skip(std::numeric_limits<uint64_t>::max());
+      if (!compressed_reader->ok()) return compressed_reader->status();
+      return size_mismatch_error(compressed_reader->pos());
+    }
+    if (!compressed_reader->Close()) return compressed_reader->status();
     if (!base_reader.VerifyEndAndClose()) return base_reader.status();
+    buffer = std::move(decompressed).Build();
   }
   if (static_cast<Index>(buffer.size()) !=
       metadata.chunk_layout.bytes_per_chunk) {
@@ -28,6 +28,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/status/status.h"
+#include "absl/strings/cord.h"
 #include <nlohmann/json.hpp>
 #include "tensorstore/array.h"
 #include "tensorstore/array_testutil.h"
@@ -51,6 +52,7 @@ using ::tensorstore::dtypes::bfloat16_t;
 using ::tensorstore::dtypes::float16_t;
 using ::tensorstore::dtypes::int2_t;
 using ::tensorstore::dtypes::int4_t;
+using ::tensorstore::internal_zarr::DecodeChunk;
 using ::tensorstore::internal_zarr::DimensionSeparator;
 using ::tensorstore::internal_zarr::DimensionSeparatorJsonBinder;
 using ::tensorstore::internal_zarr::EncodeFillValue;
@@ -580,6 +582,41 @@ TEST(EncodeDecodeMetadataTest, ArrayStructured) {
   EXPECT_EQ(j, ::nlohmann::json(metadata));
 }
 
+// Tests that a structured chunk whose uncompressed size does not match the
+// metadata is rejected.
+TEST(DecodeChunkTest, UncompressedSizeMismatch) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto metadata, ZarrMetadata::FromJson(::nlohmann::json::parse(R"(
+{
+        "chunks": [5],
+        "compressor": {"id": "zlib"},
+        "dtype": [["a", "|u1"], ["b", "|u1"]],
+        "fill_value": null,
+        "filters": null,
+        "order": "C",
+        "shape": [100],
+        "zarr_format": 2
+}
+)")));
+  ASSERT_EQ(10, metadata.chunk_layout.bytes_per_chunk);
+  const auto encode = [&](size_t size) {
+    absl::Cord encoded;
+    TENSORSTORE_CHECK_OK(metadata.compressor->Encode(
+        absl::Cord(std::string(size, '\x01')), &encoded,
+        metadata.dtype.bytes_per_outer_element));
+    return encoded;
+  };
+  TENSORSTORE_EXPECT_OK(DecodeChunk(metadata, encode(10)));
+  EXPECT_THAT(DecodeChunk(metadata, encode(8)),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            "Uncompressed chunk is 8 bytes, but should be 10 "
+                            "bytes"));
+  EXPECT_THAT(DecodeChunk(metadata, encode(12)),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            "Uncompressed chunk is 12 bytes, but should be 10 "
+                            "bytes"));
+}
+
 // Corresponds to the zarr test_encode_decode_fill_values_nan test case.
 TEST(EncodeDecodeMetadataTest, FillValuesNan) {
   for (const auto& pair : std::vector<std::pair<double, std::string>>{
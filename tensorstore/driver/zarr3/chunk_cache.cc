@@ -279,9 +279,8 @@ void ShardedReadOrWrite(
       if (state->cancelled()) {
         return absl::CancelledError("");
       }
-      TENSORSTORE_ASSIGN_OR_RETURN(
-          auto cell_to_source,
-          ComposeTransforms(transform, iterator.cell_transform()));
+      TENSORSTORE_ASSIGN_OR_RETURN(auto cell_to_source,
+                                   iterator.GetCellToOutputTransform());
       TENSORSTORE_ASSIGN_OR_RETURN(
           cell_to_source, TranslateCellToSourceTransformForShard(
                               std::move(cell_to_source),
@@ -348,6 +347,23 @@ void ZarrShardedChunkCache::Write(
     ZarrChunkCache::WriteRequest request,
     AnyFlowReceiver<absl::Status, internal::WriteChunk, IndexTransform<>>&&
         receiver) {
+  if (auto* pool = this->pool();
+      !request.transaction && pool && pool->writeback_limit_exceeded()) {
+    // Sub-chunks are written using an implicit transaction per shard, which
+    // `ChunkCache::Write` does not defer, so defer the write here instead.
+    pool->WhenWritebackBelowLimit(
+        [self = internal::CachePtr<ZarrShardedChunkCache>(this),
+         request = std::move(request),
+         receiver = std::move(receiver)]() mutable {
+          auto executor = self->executor();
+          executor([self = std::move(self), request = std::move(request),
+                    receiver = std::move(receiver)]() mutable {
+            self->ZarrShardedChunkCache::Write(std::move(request),
+                                               std::move(receiver));
+          });
+        });
+    return;
+  }
   ShardedReadOrWrite<internal::WriteChunk,
                      &ZarrArrayToArrayCodec::PreparedState::Write>(
       *this, std::move(request.transform), std::move(receiver),
@@ -291,6 +291,12 @@ class ZarrCodecChain : public internal::AtomicReferenceCount<ZarrCodecChain> {
 
     // Decodes a complete array.
     //
+    // The "bytes -> bytes" codecs are composed as streaming readers, and the
+    // "array -> bytes" codec decodes from the composed reader directly into
+    // the returned array.  The "array -> array" codecs (e.g. `transpose`)
+    // then return views of that array, so that no intermediate copies of
+    // the chunk are made.
+    //
     // This is not used if `array_to_bytes` is a sharding codec.
     Result<SharedArray<const void>> DecodeArray(
         span<const Index> decoded_shape, riegeli::Reader& reader) const final;
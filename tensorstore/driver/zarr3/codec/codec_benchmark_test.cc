@@ -0,0 +1,172 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks the throughput of encoding and decoding a chunk with several
+// codec chains.
+//
+// BM_Encode/<chain>/<num_elements>/<data>
+// BM_Decode/<chain>/<num_elements>/<data>
+//
+// chain:
+//   Index into `kChains`.
+//
+// num_elements:
+//   Number of `uint16_t` elements in the chunk, which has shape
+//   `{num_elements / 256, 256}`.
+//
+// data:
+//   0: Data with some redundancy, representative of typical image data.
+//   1: Uniformly random data, which is incompressible.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <iterator>
+#include <string>
+#include <utility>
+
+#include <benchmark/benchmark.h>
+#include "absl/random/random.h"
+#include "absl/strings/cord.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/array.h"
+#include "tensorstore/contiguous_layout.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/driver/zarr3/codec/codec.h"
+#include "tensorstore/driver/zarr3/codec/codec_chain_spec.h"
+#include "tensorstore/driver/zarr3/codec/codec_spec.h"
+#include "tensorstore/index.h"
+#include "tensorstore/internal/data_type_random_generator.h"
+#include "tensorstore/util/result.h"
+
+namespace {
+
+using ::tensorstore::Index;
+using ::tensorstore::internal_zarr3::ArrayCodecResolveParameters;
+using ::tensorstore::internal_zarr3::BytesCodecResolveParameters;
+using ::tensorstore::internal_zarr3::ZarrCodecChain;
+using ::tensorstore::internal_zarr3::ZarrCodecChainSpec;
+
+constexpr const char* kChains[] = {
+    R"([{"name": "bytes", "configuration": {"endian": "little"}}])",
+    R"([{"name": "bytes", "configuration": {"endian": "little"}},
+        {"name": "crc32c"}])",
+    R"([{"name": "bytes", "configuration": {"endian": "little"}},
+        {"name": "lz4", "configuration": {"level": 0}}])",
+    R"([{"name": "bytes", "configuration": {"endian": "little"}},
+        {"name": "zstd", "configuration": {"level": 1}}])",
+    R"([{"name": "bytes", "configuration": {"endian": "little"}},
+        {"name": "zstd", "configuration": {"level": 1}},
+        {"name": "crc32c"}])",
+    R"([{"name": "bytes", "configuration": {"endian": "little"}},
+        {"name": "gzip", "configuration": {"level": 6}}])",
+    R"([{"name": "bytes", "configuration": {"endian": "little"}},
+        {"name": "blosc", "configuration": {"cname": "lz4", "clevel": 5,
+                                            "shuffle": "shuffle",
+                                            "typesize": 2}}])",
+    R"([{"name": "bytes", "configuration": {"endian": "little"}},
+        {"name": "blosc", "configuration": {"cname": "zstd", "clevel": 5,
+                                            "shuffle": "bitshuffle",
+                                            "typesize": 2}}])",
+    R"([{"name": "transpose", "configuration": {"order": [1, 0]}},
+        {"name": "bytes", "configuration": {"endian": "little"}}])",
+    R"([{"name": "bytes", "configuration": {"endian": "big"}}])",
+};
+
+constexpr Index kInnerSize = 256;
+
+ZarrCodecChain::PreparedState::Ptr GetPreparedState(int chain,
+                                                    Index num_elements) {
+  TENSORSTORE_CHECK_OK_AND_ASSIGN(
+      auto codec_chain_spec,
+      ZarrCodecChainSpec::FromJson(::nlohmann::json::parse(kChains[chain])));
+  ArrayCodecResolveParameters decoded_params;
+  decoded_params.rank = 2;
+  decoded_params.dtype = tensorstore::dtype_v<uint16_t>;
+  decoded_params.fill_value = tensorstore::MakeScalarArray<uint16_t>(0);
+  BytesCodecResolveParameters encoded_params;
+  TENSORSTORE_CHECK_OK_AND_ASSIGN(
+      auto codec_chain,
+      codec_chain_spec.Resolve(std::move(decoded_params), encoded_params));
+  const Index shape[] = {num_elements / kInnerSize, kInnerSize};
+  TENSORSTORE_CHECK_OK_AND_ASSIGN(auto prepared_state,
+                                  codec_chain->Prepare(shape));
+  return prepared_state;
+}
+
+tensorstore::SharedArray<const void> GetChunk(Index num_elements, int data) {
+  const Index shape[] = {num_elements / kInnerSize, kInnerSize};
+  if (data == 1) {
+    absl::InsecureBitGen gen;
+    return tensorstore::internal::MakeRandomArray(
+        gen, shape, tensorstore::dtype_v<uint16_t>, tensorstore::c_order);
+  }
+  // Data with some redundancy, so that compression is not trivial.
+  auto array = tensorstore::AllocateArray<uint16_t>(
+      shape, tensorstore::c_order, tensorstore::default_init);
+  uint16_t* data_ptr = array.data();
+  for (Index i = 0; i < num_elements; ++i) {
+    data_ptr[i] = static_cast<uint16_t>((i * 7) % 1000);
+  }
+  return array;
+}
+
+void BM_Encode(benchmark::State& state) {
+  const int chain = state.range(0);
+  const Index num_elements = state.range(1);
+  const int data = state.range(2);
+  auto prepared_state = GetPreparedState(chain, num_elements);
+  auto chunk = GetChunk(num_elements, data);
+  for (auto s : state) {
+    TENSORSTORE_CHECK_OK_AND_ASSIGN(auto encoded,
+                                    prepared_state->EncodeArray(chunk));
+    benchmark::DoNotOptimize(encoded);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          num_elements * sizeof(uint16_t));
+}
+
+void BM_Decode(benchmark::State& state) {
+  const int chain = state.range(0);
+  const Index num_elements = state.range(1);
+  const int data = state.range(2);
+  auto prepared_state = GetPreparedState(chain, num_elements);
+  TENSORSTORE_CHECK_OK_AND_ASSIGN(
+      auto encoded, prepared_state->EncodeArray(GetChunk(num_elements, data)));
+  // Flatten the encoded chunk, as when it is read from a kvstore.
+  absl::Cord flat_encoded(std::string(encoded.Flatten()));
+  const Index shape[] = {num_elements / kInnerSize, kInnerSize};
+  for (auto s : state) {
+    TENSORSTORE_CHECK_OK_AND_ASSIGN(
+        auto decoded, prepared_state->DecodeArray(shape, flat_encoded));
+    benchmark::DoNotOptimize(decoded);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          num_elements * sizeof(uint16_t));
+}
+
+void DefineArgs(benchmark::internal::Benchmark* benchmark) {
+  for (int chain = 0; chain < static_cast<int>(std::size(kChains)); ++chain) {
+    for (Index num_elements : {64 * 1024, 4 * 1024 * 1024}) {
+      for (int data : {0, 1}) {
+        benchmark->Args({chain, num_elements, data});
+      }
+    }
+  }
+}
+
+BENCHMARK(BM_Encode)->Apply(DefineArgs);
+BENCHMARK(BM_Decode)->Apply(DefineArgs);
+
+}  // namespace
@@ -33,6 +33,7 @@
 #include "tensorstore/driver/zarr3/codec/bytes.h"
 #include "tensorstore/driver/zarr3/codec/codec.h"
 #include "tensorstore/driver/zarr3/codec/codec_spec.h"
+#include "tensorstore/driver/zarr3/codec/decode_override.h"
 #include "tensorstore/driver/zarr3/codec/registry.h"
 #include "tensorstore/driver/zarr3/codec/transpose.h"
 #include "tensorstore/driver/zarr3/name_configuration_json_binder.h"
@@ -323,16 +324,30 @@ ZarrCodecChainSpec::Resolve(ArrayCodecResolveParameters&& decoded,
             .dump()));
   }
 
+  const bool has_decode_overrides = HasBytesToBytesDecodeOverrides();
   for (size_t i = 0; i < bytes_to_bytes.size(); ++i) {
     auto& encoded_params = temp_bytes_resolve_params[(i + 1) % 2].emplace();
     const auto& codec_spec = *bytes_to_bytes[i];
+    // The resolved spec is needed to look up a decode override even if the
+    // caller did not request it.
+    ZarrBytesToBytesCodecSpec::Ptr temp_resolved_codec_spec;
+    ZarrBytesToBytesCodecSpec::Ptr* resolved_codec_spec =
+        resolved_spec ? &resolved_spec->bytes_to_bytes.emplace_back()
+        : has_decode_overrides ? &temp_resolved_codec_spec
+                               : nullptr;
     TENSORSTORE_ASSIGN_OR_RETURN(
         auto codec,
         codec_spec.Resolve(std::move(*bytes_decoded_params), encoded_params,
-                           resolved_spec
-                               ? &resolved_spec->bytes_to_bytes.emplace_back()
-                               : nullptr),
+                           resolved_codec_spec),
         CodecResolveError(codec_spec, "resolving codec spec", _));
+    if (has_decode_overrides) {
+      TENSORSTORE_ASSIGN_OR_RETURN(
+          auto codec_json,
+          jb::ToJson(*resolved_codec_spec, ZarrCodecJsonBinder));
+      codec = ApplyBytesToBytesDecodeOverride(
+          std::move(codec), codec_json["name"].get<std::string>(),
+          codec_json.value("configuration", ::nlohmann::json::object()));
+    }
     bytes_decoded_params = &encoded_params;
     chain->bytes_to_bytes.push_back(std::move(codec));
   }
@@ -0,0 +1,135 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/driver/zarr3/codec/decode_override.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "absl/base/no_destructor.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include <nlohmann/json.hpp>
+#include "riegeli/bytes/reader.h"
+#include "riegeli/bytes/writer.h"
+#include "tensorstore/driver/zarr3/codec/codec.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+
+namespace tensorstore {
+namespace internal_zarr3 {
+namespace {
+
+struct DecodeOverrideRegistry {
+  absl::Mutex mutex;
+  absl::flat_hash_map<std::string, ZarrBytesToBytesDecodeOverride> overrides
+      ABSL_GUARDED_BY(mutex);
+  // Allows `ZarrCodecChainSpec::Resolve` to skip the lookup in the common case
+  // that no overrides are registered.
+  std::atomic<bool> any_registered{false};
+};
+
+DecodeOverrideRegistry& GetDecodeOverrideRegistry() {
+  static absl::NoDestructor<DecodeOverrideRegistry> registry;
+  return *registry;
+}
+
+// Wraps a codec, substituting `decoder` for its decode reader.
+class DecodeOverrideCodec : public ZarrBytesToBytesCodec {
+ public:
+  explicit DecodeOverrideCodec(ZarrBytesToBytesCodec::Ptr base,
+                               ZarrDecodeReaderFactory decoder)
+      : base_(std::move(base)), decoder_(std::move(decoder)) {}
+
+  class State : public ZarrBytesToBytesCodec::PreparedState {
+   public:
+    int64_t encoded_size() const final { return base_->encoded_size(); }
+
+    Result<std::unique_ptr<riegeli::Writer>> GetEncodeWriter(
+        riegeli::Writer& encoded_writer) const final {
+      return base_->GetEncodeWriter(encoded_writer);
+    }
+
+    Result<std::unique_ptr<riegeli::Reader>> GetDecodeReader(
+        riegeli::Reader& encoded_reader) const final {
+      return (*decoder_)(encoded_reader, decoded_size_);
+    }
+
+    ZarrBytesToBytesCodec::PreparedState::Ptr base_;
+    const ZarrDecodeReaderFactory* decoder_;
+    int64_t decoded_size_;
+  };
+
+  Result<PreparedState::Ptr> Prepare(int64_t decoded_size) const final {
+    auto state = internal::MakeIntrusivePtr<State>();
+    TENSORSTORE_ASSIGN_OR_RETURN(state->base_, base_->Prepare(decoded_size));
+    state->decoder_ = &decoder_;
+    state->decoded_size_ = decoded_size;
+    return state;
+  }
+
+ private:
+  ZarrBytesToBytesCodec::Ptr base_;
+  ZarrDecodeReaderFactory decoder_;
+};
+
+}  // namespace
+
+void RegisterBytesToBytesDecodeOverride(
+    std::string name, ZarrBytesToBytesDecodeOverride factory) {
+  auto& registry = GetDecodeOverrideRegistry();
+  absl::MutexLock lock(&registry.mutex);
+  registry.overrides[std::move(name)] = std::move(factory);
+  registry.any_registered.store(true, std::memory_order_release);
+}
+
+void UnregisterBytesToBytesDecodeOverride(std::string_view name) {
+  auto& registry = GetDecodeOverrideRegistry();
+  absl::MutexLock lock(&registry.mutex);
+  registry.overrides.erase(name);
+  registry.any_registered.store(!registry.overrides.empty(),
+                                std::memory_order_release);
+}
+
+bool HasBytesToBytesDecodeOverrides() {
+  return GetDecodeOverrideRegistry().any_registered.load(
+      std::memory_order_acquire);
+}
+
+ZarrBytesToBytesCodec::Ptr ApplyBytesToBytesDecodeOverride(
+    ZarrBytesToBytesCodec::Ptr codec, std::string_view name,
+    const ::nlohmann::json& configuration) {
+  ZarrBytesToBytesDecodeOverride factory;
+  {
+    auto& registry = GetDecodeOverrideRegistry();
+    absl::MutexLock lock(&registry.mutex);
+    auto it = registry.overrides.find(name);
+    if (it == registry.overrides.end()) return codec;
+    factory = it->second;
+  }
+  auto decoder = factory(configuration);
+  if (!decoder) return codec;
+  return internal::MakeIntrusivePtr<DecodeOverrideCodec>(std::move(codec),
+                                                         std::move(decoder));
+}
+
+}  // namespace internal_zarr3
+}  // namespace tensorstore
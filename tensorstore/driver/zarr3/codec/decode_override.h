@@ -0,0 +1,80 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_DRIVER_ZARR3_CODEC_DECODE_OVERRIDE_H_
+#define TENSORSTORE_DRIVER_ZARR3_CODEC_DECODE_OVERRIDE_H_
+
+// Extension point for substituting an alternative decoder for a registered
+// "bytes -> bytes" codec, e.g. one backed by a hardware or accelerator
+// decompression library.
+//
+// The override only affects decoding; encoding always uses the built-in codec
+// implementation, so the stored representation is unchanged.
+
+#include <stdint.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <nlohmann/json.hpp>
+#include "riegeli/bytes/reader.h"
+#include "tensorstore/driver/zarr3/codec/codec.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal_zarr3 {
+
+// Returns a reader that returns the decoded representation of
+// `encoded_reader`, with the same contract as
+// `ZarrBytesToBytesCodec::PreparedState::GetDecodeReader`.
+//
+// `decoded_size` is the size of the decoded representation, or `-1` if it may
+// vary.
+using ZarrDecodeReaderFactory =
+    std::function<Result<std::unique_ptr<riegeli::Reader>>(
+        riegeli::Reader& encoded_reader, int64_t decoded_size)>;
+
+// Returns a decoder for a codec with the specified resolved `configuration`,
+// or a null function to use the built-in decoder (e.g. if the configuration
+// is not supported).
+using ZarrBytesToBytesDecodeOverride =
+    std::function<ZarrDecodeReaderFactory(const ::nlohmann::json& configuration)>;
+
+// Registers a decode override for the "bytes -> bytes" codec `name`, replacing
+// any previously registered override for `name`.
+//
+// Only affects codec chains resolved after this call.
+void RegisterBytesToBytesDecodeOverride(std::string name,
+                                        ZarrBytesToBytesDecodeOverride factory);
+
+// Removes the decode override for `name`, if any.
+void UnregisterBytesToBytesDecodeOverride(std::string_view name);
+
+// Returns `true` if any decode override is registered.
+bool HasBytesToBytesDecodeOverrides();
+
+// Returns `codec` with decoding performed by the override registered for
+// `name`, or `codec` unchanged if there is no applicable override.
+//
+// `configuration` is the resolved configuration of `codec`.
+ZarrBytesToBytesCodec::Ptr ApplyBytesToBytesDecodeOverride(
+    ZarrBytesToBytesCodec::Ptr codec, std::string_view name,
+    const ::nlohmann::json& configuration);
+
+}  // namespace internal_zarr3
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_DRIVER_ZARR3_CODEC_DECODE_OVERRIDE_H_
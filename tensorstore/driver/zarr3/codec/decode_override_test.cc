@@ -0,0 +1,86 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/driver/zarr3/codec/decode_override.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include "riegeli/bytes/reader.h"
+#include "riegeli/zlib/zlib_reader.h"
+#include "tensorstore/driver/zarr3/codec/codec_test_util.h"
+#include "tensorstore/internal/testing/json_gtest.h"
+
+namespace {
+
+using ::tensorstore::MatchesJson;
+using ::tensorstore::internal_zarr3::CodecRoundTripTestParams;
+using ::tensorstore::internal_zarr3::GetDefaultBytesCodecJson;
+using ::tensorstore::internal_zarr3::HasBytesToBytesDecodeOverrides;
+using ::tensorstore::internal_zarr3::RegisterBytesToBytesDecodeOverride;
+using ::tensorstore::internal_zarr3::TestCodecRoundTrip;
+using ::tensorstore::internal_zarr3::UnregisterBytesToBytesDecodeOverride;
+using ::tensorstore::internal_zarr3::ZarrDecodeReaderFactory;
+
+CodecRoundTripTestParams GetGzipParams() {
+  CodecRoundTripTestParams p;
+  p.spec = {GetDefaultBytesCodecJson(),
+            {{"name", "gzip"}, {"configuration", {{"level", 3}}}}};
+  return p;
+}
+
+TEST(DecodeOverrideTest, Basic) {
+  std::atomic<int> num_decodes{0};
+  ::nlohmann::json configuration;
+  RegisterBytesToBytesDecodeOverride(
+      "gzip", [&](const ::nlohmann::json& config) -> ZarrDecodeReaderFactory {
+        configuration = config;
+        return [&](riegeli::Reader& encoded_reader, int64_t decoded_size)
+                   -> std::unique_ptr<riegeli::Reader> {
+          ++num_decodes;
+          using Reader = riegeli::ZlibReader<riegeli::Reader*>;
+          return std::make_unique<Reader>(
+              &encoded_reader,
+              Reader::Options().set_header(Reader::Header::kGzip));
+        };
+      });
+  EXPECT_TRUE(HasBytesToBytesDecodeOverrides());
+  TestCodecRoundTrip(GetGzipParams());
+  EXPECT_EQ(1, num_decodes);
+  EXPECT_THAT(configuration, MatchesJson({{"level", 3}}));
+
+  UnregisterBytesToBytesDecodeOverride("gzip");
+  EXPECT_FALSE(HasBytesToBytesDecodeOverrides());
+  TestCodecRoundTrip(GetGzipParams());
+  EXPECT_EQ(1, num_decodes);
+}
+
+TEST(DecodeOverrideTest, Declined) {
+  int num_calls = 0;
+  RegisterBytesToBytesDecodeOverride(
+      "gzip", [&](const ::nlohmann::json& config) -> ZarrDecodeReaderFactory {
+        ++num_calls;
+        return nullptr;
+      });
+  TestCodecRoundTrip(GetGzipParams());
+  EXPECT_EQ(1, num_calls);
+  UnregisterBytesToBytesDecodeOverride("gzip");
+}
+
+}  // namespace
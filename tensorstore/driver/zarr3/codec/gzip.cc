@@ -26,6 +26,7 @@
 #include "tensorstore/driver/zarr3/codec/codec.h"
 #include "tensorstore/driver/zarr3/codec/codec_spec.h"
 #include "tensorstore/driver/zarr3/codec/registry.h"
+#include "tensorstore/internal/compression/compression_context_pool.h"
 #include "tensorstore/internal/global_initializer.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
@@ -50,6 +51,8 @@ class GzipCodec : public ZarrBytesToBytesCodec {
       Writer::Options options;
       options.set_compression_level(level_);
       options.set_header(Writer::Header::kGzip);
+      options.set_recycling_pool_options(
+          internal::CompressionContextPoolOptions());
       return std::make_unique<Writer>(&encoded_writer, options);
     }
 
@@ -58,6 +61,8 @@ class GzipCodec : public ZarrBytesToBytesCodec {
       using Reader = riegeli::ZlibReader<riegeli::Reader*>;
       Reader::Options options;
       options.set_header(Reader::Header::kGzip);
+      options.set_recycling_pool_options(
+          internal::CompressionContextPoolOptions());
       return std::make_unique<Reader>(&encoded_reader, options);
     }
 
@@ -0,0 +1,88 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "tensorstore/driver/zarr3/codec/codec_test_util.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::internal_zarr3::CodecRoundTripTestParams;
+using ::tensorstore::internal_zarr3::CodecSpecRoundTripTestParams;
+using ::tensorstore::internal_zarr3::GetDefaultBytesCodecJson;
+using ::tensorstore::internal_zarr3::TestCodecRoundTrip;
+using ::tensorstore::internal_zarr3::TestCodecSpecResolve;
+using ::tensorstore::internal_zarr3::TestCodecSpecRoundTrip;
+
+TEST(Lz4Test, EndianInferred) {
+  CodecSpecRoundTripTestParams p;
+  p.orig_spec = {
+      {{"name", "lz4"}, {"configuration", {{"level", 7}}}},
+  };
+  p.expected_spec = {
+      GetDefaultBytesCodecJson(),
+      {{"name", "lz4"}, {"configuration", {{"level", 7}}}},
+  };
+  TestCodecSpecRoundTrip(p);
+}
+
+TEST(Lz4Test, DefaultLevel) {
+  CodecSpecRoundTripTestParams p;
+  p.orig_spec = {
+      {{"name", "lz4"}},
+  };
+  p.expected_spec = {
+      GetDefaultBytesCodecJson(),
+      {{"name", "lz4"}, {"configuration", {{"level", 0}}}},
+  };
+  TestCodecSpecRoundTrip(p);
+}
+
+TEST(Lz4Test, LevelRequiredInMetadata) {
+  CodecSpecRoundTripTestParams p;
+  EXPECT_THAT(
+      TestCodecSpecResolve(
+          {
+              GetDefaultBytesCodecJson(),
+              {{"name", "lz4"}},
+          },
+          p.resolve_params, /*constraints=*/false),
+      MatchesStatus(absl::StatusCode::kInvalidArgument, ".*\"level\".*"));
+}
+
+TEST(Lz4Test, InvalidLevel) {
+  CodecSpecRoundTripTestParams p;
+  EXPECT_THAT(
+      TestCodecSpecResolve(
+          {
+              GetDefaultBytesCodecJson(),
+              {{"name", "lz4"}, {"configuration", {{"level", 13}}}},
+          },
+          p.resolve_params, /*constraints=*/false),
+      MatchesStatus(absl::StatusCode::kInvalidArgument, ".*\"level\".*"));
+}
+
+TEST(Lz4Test, RoundTrip) {
+  for (int level : {0, 1, 9}) {
+    CodecRoundTripTestParams p;
+    p.spec = {GetDefaultBytesCodecJson(),
+              {{"name", "lz4"}, {"configuration", {{"level", level}}}}};
+    TestCodecRoundTrip(p);
+  }
+}
+
+}  // namespace
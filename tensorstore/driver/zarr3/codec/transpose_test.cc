@@ -14,10 +14,14 @@
 
 #include <stdint.h>
 
+#include <utility>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/status/status.h"
+#include "tensorstore/array.h"
 #include "tensorstore/data_type.h"
+#include "tensorstore/driver/zarr3/codec/codec.h"
 #include "tensorstore/driver/zarr3/codec/codec_chain_spec.h"
 #include "tensorstore/driver/zarr3/codec/codec_spec.h"
 #include "tensorstore/driver/zarr3/codec/codec_test_util.h"
@@ -27,9 +31,11 @@
 namespace {
 
 using ::tensorstore::dtype_v;
+using ::tensorstore::MakeArray;
 using ::tensorstore::MatchesJson;
 using ::tensorstore::MatchesStatus;
 using ::tensorstore::internal_zarr3::ArrayCodecResolveParameters;
+using ::tensorstore::internal_zarr3::BytesCodecResolveParameters;
 using ::tensorstore::internal_zarr3::CodecRoundTripTestParams;
 using ::tensorstore::internal_zarr3::CodecSpecRoundTripTestParams;
 using ::tensorstore::internal_zarr3::GetDefaultBytesCodecJson;
@@ -150,4 +156,33 @@ TEST(TransposeTest, Merge) {
               MatchesStatus(absl::StatusCode::kFailedPrecondition));
 }
 
+// The transpose codec decodes by permuting the strides of the array decoded by
+// the "array -> bytes" codec, rather than copying it.
+TEST(TransposeTest, DecodeReturnsPermutedView) {
+  ZarrCodecChainSpec::FromJsonOptions from_json_options{/*.constraints=*/true};
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto codec_chain_spec,
+      ZarrCodecChainSpec::FromJson(
+          {{{"name", "transpose"}, {"configuration", {{"order", {1, 0}}}}},
+           GetDefaultBytesCodecJson()},
+          from_json_options));
+  ArrayCodecResolveParameters decoded_params;
+  decoded_params.rank = 2;
+  decoded_params.dtype = dtype_v<uint16_t>;
+  decoded_params.fill_value = tensorstore::MakeScalarArray<uint16_t>(0);
+  BytesCodecResolveParameters encoded_params;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto codec_chain,
+      codec_chain_spec.Resolve(std::move(decoded_params), encoded_params));
+  auto data = MakeArray<uint16_t>({{1, 2, 3}, {4, 5, 6}});
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto prepared_state,
+                                   codec_chain->Prepare(data.shape()));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto encoded,
+                                   prepared_state->EncodeArray(data));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto decoded, prepared_state->DecodeArray(data.shape(), encoded));
+  EXPECT_EQ(data, decoded);
+  EXPECT_THAT(decoded.byte_strides(), ::testing::ElementsAre(2, 4));
+}
+
 }  // namespace
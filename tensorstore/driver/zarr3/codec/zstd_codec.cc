@@ -17,15 +17,21 @@
 #include <stdint.h>
 
 #include <memory>
+#include <string>
+#include <utility>
 
 #include "absl/status/status.h"
+#include "absl/strings/escaping.h"
+#include <nlohmann/json.hpp>
 #include "riegeli/bytes/reader.h"
 #include "riegeli/bytes/writer.h"
+#include "riegeli/zstd/zstd_dictionary.h"
 #include "riegeli/zstd/zstd_reader.h"
 #include "riegeli/zstd/zstd_writer.h"
 #include "tensorstore/driver/zarr3/codec/codec.h"
 #include "tensorstore/driver/zarr3/codec/codec_spec.h"
 #include "tensorstore/driver/zarr3/codec/registry.h"
+#include "tensorstore/internal/compression/compression_context_pool.h"
 #include "tensorstore/internal/global_initializer.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json_binding/bindable.h"
@@ -33,6 +39,7 @@
 #include "tensorstore/internal/json_binding/std_optional.h"  // IWYU pragma: keep
 #include "tensorstore/util/result.h"
 #include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
 
 namespace tensorstore {
 namespace internal_zarr3 {
@@ -42,8 +49,13 @@ using ::riegeli::ZstdWriterBase;
 
 class ZstdCodec : public ZarrBytesToBytesCodec {
  public:
-  explicit ZstdCodec(int level, bool checksum)
-      : level_(level), checksum_(checksum) {}
+  // The `dictionary` is shared by all chunks, so that the prepared
+  // compression and decompression dictionaries are created only once.
+  explicit ZstdCodec(int level, bool checksum,
+                     riegeli::ZstdDictionary dictionary)
+      : level_(level),
+        checksum_(checksum),
+        dictionary_(std::move(dictionary)) {}
 
   class State : public ZarrBytesToBytesCodec::PreparedState {
    public:
@@ -53,6 +65,9 @@ class ZstdCodec : public ZarrBytesToBytesCodec {
       Writer::Options options;
       options.set_compression_level(level_);
       options.set_store_checksum(checksum_);
+      options.set_dictionary(*dictionary_);
+      options.set_recycling_pool_options(
+          internal::CompressionContextPoolOptions());
       if (decoded_size_ != -1) {
         options.set_pledged_size(decoded_size_);
       }
@@ -63,11 +78,15 @@ class ZstdCodec : public ZarrBytesToBytesCodec {
         riegeli::Reader& encoded_reader) const final {
       using Reader = riegeli::ZstdReader<riegeli::Reader*>;
       Reader::Options options;
+      options.set_dictionary(*dictionary_);
+      options.set_recycling_pool_options(
+          internal::CompressionContextPoolOptions());
       return std::make_unique<Reader>(&encoded_reader, options);
     }
 
     int level_;
     bool checksum_;
+    const riegeli::ZstdDictionary* dictionary_;
     int64_t decoded_size_;
   };
 
@@ -75,6 +94,7 @@ class ZstdCodec : public ZarrBytesToBytesCodec {
     auto state = internal::MakeIntrusivePtr<State>();
     state->level_ = level_;
     state->checksum_ = checksum_;
+    state->dictionary_ = &dictionary_;
     state->decoded_size_ = decoded_size;
     return state;
   }
@@ -82,6 +102,23 @@ class ZstdCodec : public ZarrBytesToBytesCodec {
  private:
   int level_;
   bool checksum_;
+  riegeli::ZstdDictionary dictionary_;
+};
+
+// Binds a `std::string` to a base64-encoded JSON string.
+constexpr auto Base64Binder = [](auto is_loading, const auto& options,
+                                 std::string* obj,
+                                 ::nlohmann::json* j) -> absl::Status {
+  if constexpr (is_loading) {
+    const auto* s = j->template get_ptr<const std::string*>();
+    if (!s || !absl::Base64Unescape(*s, obj)) {
+      return absl::InvalidArgumentError(tensorstore::StrCat(
+          "Expected base64-encoded string, but received: ", j->dump()));
+    }
+  } else {
+    *j = absl::Base64Escape(*obj);
+  }
+  return absl::OkStatus();
 };
 
 }  // namespace
@@ -93,6 +130,8 @@ absl::Status ZstdCodecSpec::MergeFrom(const ZarrCodecSpec& other, bool strict) {
       MergeConstraint<&Options::level>("level", options, other_options));
   TENSORSTORE_RETURN_IF_ERROR(
       MergeConstraint<&Options::checksum>("checksum", options, other_options));
+  TENSORSTORE_RETURN_IF_ERROR(MergeConstraint<&Options::dictionary>(
+      "dictionary", options, other_options, Base64Binder));
   return absl::OkStatus();
 }
 
@@ -110,12 +149,16 @@ Result<ZarrBytesToBytesCodec::Ptr> ZstdCodecSpec::Resolve(
     if (options.level && options.checksum) {
       resolved_spec->reset(this);
     } else {
-      resolved_spec->reset(
-          new ZstdCodecSpec(Options{resolved_level, resolved_checksum}));
+      resolved_spec->reset(new ZstdCodecSpec(
+          Options{resolved_level, resolved_checksum, options.dictionary}));
     }
   }
-  return internal::MakeIntrusivePtr<ZstdCodec>(resolved_level,
-                                               resolved_checksum);
+  riegeli::ZstdDictionary dictionary;
+  if (options.dictionary) {
+    dictionary.set_automatic(*options.dictionary);
+  }
+  return internal::MakeIntrusivePtr<ZstdCodec>(
+      resolved_level, resolved_checksum, std::move(dictionary));
 }
 
 TENSORSTORE_GLOBAL_INITIALIZER {
@@ -143,7 +186,9 @@ TENSORSTORE_GLOBAL_INITIALIZER {
                       }
                     }
                     return absl::OkStatus();
-                  })))  //
+                  }))),
+          jb::Member("dictionary", jb::Projection<&Options::dictionary>(
+                                       jb::Optional(Base64Binder)))  //
           )));
 }
 
@@ -16,6 +16,7 @@
 #define TENSORSTORE_DRIVER_ZARR3_CODEC_ZSTD_CODEC_H_
 
 #include <optional>
+#include <string>
 
 #include "absl/status/status.h"
 #include "tensorstore/driver/zarr3/codec/codec.h"
@@ -30,6 +31,10 @@ class ZstdCodecSpec : public ZarrBytesToBytesCodecSpec {
   struct Options {
     std::optional<int> level;
     std::optional<bool> checksum;
+    // Zstd dictionary (either trained by `ZDICT_trainFromBuffer` or raw
+    // content) used for compression and decompression.  Stored in the
+    // metadata as a base64-encoded string.
+    std::optional<std::string> dictionary;
   };
   ZstdCodecSpec() = default;
   explicit ZstdCodecSpec(const Options& options) : options(options) {}
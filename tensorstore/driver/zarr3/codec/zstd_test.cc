@@ -99,4 +99,38 @@ TEST(ZstdTest, RoundTrip) {
   TestCodecRoundTrip(p);
 }
 
+TEST(ZstdTest, Dictionary) {
+  CodecSpecRoundTripTestParams p;
+  p.orig_spec = {
+      {{"name", "zstd"},
+       {"configuration", {{"level", 7}, {"dictionary", "YWJjZGVm"}}}},
+  };
+  p.expected_spec = {
+      GetDefaultBytesCodecJson(),
+      {{"name", "zstd"},
+       {"configuration",
+        {{"level", 7}, {"checksum", false}, {"dictionary", "YWJjZGVm"}}}},
+  };
+  TestCodecSpecRoundTrip(p);
+}
+
+TEST(ZstdTest, InvalidDictionary) {
+  CodecSpecRoundTripTestParams p;
+  EXPECT_THAT(TestCodecSpecResolve(
+                  {{{"name", "zstd"},
+                    {"configuration", {{"dictionary", "not base64!"}}}}},
+                  p.resolve_params),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            ".*Expected base64-encoded string.*"));
+}
+
+TEST(ZstdTest, DictionaryRoundTrip) {
+  CodecRoundTripTestParams p;
+  // Raw-content dictionary consisting of the bytes 0, 1, ..., 31.
+  const char kDictionary[] = "AAECAwQFBgcICQoLDA0ODxAREhMUFRYXGBkaGxwdHh8=";
+  p.spec = {{{"name", "zstd"},
+             {"configuration", {{"level", 3}, {"dictionary", kDictionary}}}}};
+  TestCodecRoundTrip(p);
+}
+
 }  // namespace
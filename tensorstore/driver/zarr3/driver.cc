@@ -489,6 +489,7 @@ class ZarrDriver : public ZarrDriverBase {
   void Read(ReadRequest request,
             AnyFlowReceiver<absl::Status, internal::ReadChunk, IndexTransform<>>
                 receiver) override {
+    request.batch = GetReadBatch(std::move(request.batch));
     return cache()->zarr_chunk_cache().Read(
         {std::move(request), GetCurrentDataStalenessBound(),
          this->fill_value_mode_.fill_missing_data_reads},
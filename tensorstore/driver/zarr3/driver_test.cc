@@ -17,6 +17,7 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <atomic>
 #include <string>
 #include <utility>
 #include <vector>
@@ -1308,6 +1309,48 @@ TEST(ZarrDriverTest, ShardingBatchRead) {
   EXPECT_THAT(mock_kvstore->request_log.pop_all(), ::testing::SizeIs(4));
 }
 
+TEST(ZarrDriverTest, ShardingReadBatchWindow) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto context,
+      Context::FromJson(
+          {{"read_batch_window", {{"duration", "inf"}, {"max_requests", 4}}}}));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto mock_kvstore_resource,
+      context.GetResource<tensorstore::internal::MockKeyValueStoreResource>());
+  auto mock_kvstore = *mock_kvstore_resource;
+  mock_kvstore->forward_to = tensorstore::GetMemoryKeyValueStore();
+  mock_kvstore->log_requests = true;
+  mock_kvstore->handle_batch_requests = true;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      tensorstore::Open({{"driver", "zarr3"},
+                         {"kvstore", {{"driver", "mock_key_value_store"}}},
+                         {"read_batch_window", "read_batch_window"}},
+                        tensorstore::OpenMode::create, context,
+                        dtype_v<uint16_t>, Schema::Shape({8, 8}),
+                        ChunkLayout::ReadChunkShape({2, 2}),
+                        ChunkLayout::WriteChunkShape({4, 4}))
+          .result());
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Write(tensorstore::MakeScalarArray<uint16_t>(42), store));
+  mock_kvstore->request_log.pop_all();
+
+  // Independent reads of the four chunks of a single shard, none of which
+  // specifies a batch, are coalesced by the batch window.
+  std::vector<tensorstore::Future<tensorstore::SharedOffsetArray<void>>> reads;
+  for (Index i : {0, 2}) {
+    for (Index j : {0, 2}) {
+      reads.push_back(tensorstore::Read(
+          store | tensorstore::Dims(0, 1).SizedInterval({i, j}, {2, 2})));
+    }
+  }
+  for (auto& read : reads) {
+    TENSORSTORE_ASSERT_OK(read.result());
+  }
+
+  EXPECT_THAT(mock_kvstore->request_log.pop_all(), ::testing::SizeIs(1));
+}
+
 TEST(ZarrDriverTest, CodecLifetime) {
   tensorstore::internal_testing::ScopedTemporaryDirectory tempdir;
   tensorstore::Future<const void> future;
@@ -1810,6 +1853,113 @@ TEST(DriverTest, WriteCoalescingWhenCopyingFromChunkedTensorStore) {
       }));
 }
 
+TEST(DriverTest, CopyUnstoredSourceRegions) {
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto mock_key_value_store_resource,
+      context.GetResource<tensorstore::internal::MockKeyValueStoreResource>());
+  auto mock_kvstore = *mock_key_value_store_resource;
+  mock_kvstore->forward_to = tensorstore::GetMemoryKeyValueStore();
+  mock_kvstore->log_requests = true;
+  auto open = [&](std::string path) {
+    return tensorstore::Open(
+               {
+                   {"driver", "zarr3"},
+                   {"kvstore",
+                    {{"driver", "mock_key_value_store"}, {"path", path}}},
+               },
+               tensorstore::dtype_v<uint8_t>, tensorstore::Schema::Shape({6}),
+               tensorstore::ChunkLayout::ChunkShape({2}),
+               tensorstore::OpenMode::create, context)
+        .result();
+  };
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto source, open("source/"));
+  TENSORSTORE_ASSERT_OK(tensorstore::Write(
+      tensorstore::MakeArray<uint8_t>({1, 2}),
+      source | tensorstore::Dims(0).SizedInterval(0, 2)));
+
+  {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto dest, open("skip/"));
+    TENSORSTORE_ASSERT_OK(
+        tensorstore::Write(tensorstore::MakeScalarArray<uint8_t>(9), dest));
+    mock_kvstore->request_log.pop_all();
+    TENSORSTORE_ASSERT_OK(tensorstore::Copy(
+                              source, dest,
+                              tensorstore::skip_unstored_source_regions)
+                              .result());
+    // Only the chunk stored in `source` is read and written.  The other
+    // chunks of `source` are only checked for existence.
+    auto requests = mock_kvstore->request_log.pop_all();
+    EXPECT_THAT(requests, ::testing::Contains(JsonSubValuesMatch(
+                              {{"/type", "write"}, {"/key", "skip/c/0"}})));
+    for (const auto& request : requests) {
+      const std::string key = request.value("key", std::string());
+      EXPECT_NE("skip/c/1", key) << request;
+      EXPECT_NE("skip/c/2", key) << request;
+      if (key == "source/c/1") {
+        EXPECT_EQ(0, request.value("byte_range_exclusive_max", -1)) << request;
+      }
+    }
+    EXPECT_THAT(tensorstore::Read(dest).result(),
+                ::testing::Optional(
+                    tensorstore::MakeArray<uint8_t>({1, 2, 9, 9, 9, 9})));
+  }
+
+  {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto dest, open("fill/"));
+    TENSORSTORE_ASSERT_OK(
+        tensorstore::Write(tensorstore::MakeScalarArray<uint8_t>(9), dest));
+    TENSORSTORE_ASSERT_OK(tensorstore::Copy(
+                              source, dest,
+                              tensorstore::fill_unstored_source_regions)
+                              .result());
+    EXPECT_THAT(tensorstore::Read(dest).result(),
+                ::testing::Optional(
+                    tensorstore::MakeArray<uint8_t>({1, 2, 0, 0, 0, 0})));
+  }
+}
+
+TEST(DriverTest, CopyWindow) {
+  auto context = Context::Default();
+  auto open = [&](std::string path) {
+    return tensorstore::Open(
+               {
+                   {"driver", "zarr3"},
+                   {"kvstore", {{"driver", "memory"}, {"path", path}}},
+               },
+               tensorstore::dtype_v<uint8_t>, tensorstore::Schema::Shape({8}),
+               tensorstore::ChunkLayout::ChunkShape({2}),
+               tensorstore::OpenMode::create, context)
+        .result();
+  };
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto source, open("source/"));
+  TENSORSTORE_ASSERT_OK(tensorstore::Write(
+      tensorstore::MakeArray<uint8_t>({1, 2, 3, 4, 5, 6, 7, 8}), source));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto dest, open("dest/"));
+
+  // With windows smaller than a chunk, each chunk is read only once the
+  // previous chunk has been written back.
+  std::atomic<Index> max_in_flight{0};
+  tensorstore::CopyProgressFunction progress{
+      [&](tensorstore::CopyProgress p) {
+        Index in_flight = p.read_elements - p.committed_elements;
+        Index max = max_in_flight.load();
+        while (in_flight > max &&
+               !max_in_flight.compare_exchange_weak(max, in_flight)) {
+        }
+      }};
+  tensorstore::CopyWindow window;
+  window.read_ahead_bytes = 1;
+  window.write_behind_bytes = 1;
+  auto copy_future =
+      tensorstore::Copy(source, dest, window, std::move(progress));
+  TENSORSTORE_ASSERT_OK(copy_future.commit_future.result());
+  EXPECT_EQ(2, max_in_flight);
+  EXPECT_THAT(tensorstore::Read(dest).result(),
+              ::testing::Optional(tensorstore::MakeArray<uint8_t>(
+                  {1, 2, 3, 4, 5, 6, 7, 8})));
+}
+
 TEST(DriverTest, UrlSchemeRoundtrip) {
   TestTensorStoreUrlRoundtrip(
       {{"driver", "zarr3"},
@@ -14,6 +14,9 @@
 
 #include "tensorstore/index_space/index_transform.h"
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <algorithm>
 #include <cassert>
 #include <cstdlib>
@@ -23,19 +26,27 @@
 #include <string_view>
 #include <utility>
 
+#include "absl/container/inlined_vector.h"
 #include "absl/status/status.h"
+#include "riegeli/bytes/writer.h"
+#include "riegeli/varint/varint_reading.h"
+#include "riegeli/varint/varint_writing.h"
+#include "tensorstore/array.h"
 #include "tensorstore/box.h"
 #include "tensorstore/container_kind.h"
+#include "tensorstore/data_type.h"
 #include "tensorstore/index.h"
 #include "tensorstore/index_interval.h"
 #include "tensorstore/index_space/dimension_identifier.h"
 #include "tensorstore/index_space/index_domain.h"
+#include "tensorstore/index_space/index_transform_builder.h"
 #include "tensorstore/index_space/internal/transform_rep.h"
-#include "tensorstore/index_space/json.h"
 #include "tensorstore/index_space/output_index_method.h"
+#include "tensorstore/internal/dimension_labels.h"
+#include "tensorstore/internal/riegeli/delimited.h"
 #include "tensorstore/rank.h"
-#include "tensorstore/serialization/json.h"
 #include "tensorstore/serialization/serialization.h"
+#include "tensorstore/static_cast.h"
 #include "tensorstore/util/dimension_set.h"
 #include "tensorstore/util/result.h"
 #include "tensorstore/util/span.h"
@@ -652,21 +663,240 @@ Result<IndexTransform<>> ComposeOptionalTransforms(IndexTransform<> b_to_c,
 
 namespace internal_index_space {
 
+namespace {
+
+// Index transforms and domains are serialized in a compact binary format,
+// rather than as JSON, to avoid the cost of converting to and parsing JSON:
+//
+//   input_rank (varint)
+//   output_rank (varint, only for transforms)
+//   for each input dimension: inclusive_min, exclusive_max (zigzag varint)
+//   implicit_lower_bounds, implicit_upper_bounds (varint bit sets)
+//   has_labels (bool), followed by each label if `true`
+//   for each output dimension (only for transforms):
+//     method (uint8), offset (zigzag varint)
+//     stride (zigzag varint), unless `method == constant`
+//     input_dimension (varint), if `method == single_input_dimension`
+//     index array, index range bounds, if `method == array`
+
+[[nodiscard]] bool WriteIndex(riegeli::Writer& writer, Index value) {
+  return riegeli::WriteVarint64(
+      (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63),
+      writer);
+}
+
+[[nodiscard]] bool ReadIndex(serialization::DecodeSource& source,
+                             Index& value) {
+  uint64_t encoded;
+  if (!riegeli::ReadVarint64(source.reader(), encoded)) {
+    source.Fail(serialization::DecodeError("Invalid index"));
+    return false;
+  }
+  value = static_cast<Index>(encoded >> 1) ^ -static_cast<Index>(encoded & 1);
+  return true;
+}
+
+[[nodiscard]] bool ReadRank(serialization::DecodeSource& source,
+                            DimensionIndex rank_constraint,
+                            DimensionIndex& rank) {
+  size_t size;
+  if (!serialization::ReadSize(source.reader(), size)) return false;
+  if (size > kMaxRank ||
+      (rank_constraint != dynamic_rank &&
+       static_cast<DimensionIndex>(size) != rank_constraint)) {
+    source.Fail(serialization::DecodeError(
+        tensorstore::StrCat("Invalid rank: ", size)));
+    return false;
+  }
+  rank = static_cast<DimensionIndex>(size);
+  return true;
+}
+
+[[nodiscard]] bool EncodeDomain(serialization::EncodeSink& sink,
+                                IndexDomainView<> domain) {
+  auto& writer = sink.writer();
+  const DimensionIndex rank = domain.rank();
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    const IndexInterval interval = domain.box()[i];
+    if (!WriteIndex(writer, interval.inclusive_min()) ||
+        !WriteIndex(writer, interval.exclusive_max())) {
+      return false;
+    }
+  }
+  if (!serialization::WriteSize(writer,
+                                domain.implicit_lower_bounds().to_uint()) ||
+      !serialization::WriteSize(writer,
+                                domain.implicit_upper_bounds().to_uint())) {
+    return false;
+  }
+  const auto labels = domain.labels();
+  const bool has_labels =
+      std::any_of(labels.begin(), labels.end(),
+                  [](std::string_view label) { return !label.empty(); });
+  if (!serialization::Encode(sink, has_labels)) return false;
+  if (has_labels) {
+    for (std::string_view label : labels) {
+      if (!serialization::WriteDelimited(writer, label)) return false;
+    }
+  }
+  return true;
+}
+
+// Decodes the domain into `rep`, with the exclusive upper bounds stored in
+// `rep.input_shape()`, as expected by `FinalizeDecodedTransformRep`.
+[[nodiscard]] bool DecodeDomain(serialization::DecodeSource& source,
+                                TransformRep& rep) {
+  auto& reader = source.reader();
+  const DimensionIndex rank = rep.input_rank;
+  const auto origin = rep.input_origin();
+  const auto exclusive_max = rep.input_shape();
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    if (!ReadIndex(source, origin[i]) || !ReadIndex(source, exclusive_max[i])) {
+      return false;
+    }
+  }
+  size_t implicit_lower_bounds, implicit_upper_bounds;
+  if (!serialization::ReadSize(reader, implicit_lower_bounds) ||
+      !serialization::ReadSize(reader, implicit_upper_bounds)) {
+    return false;
+  }
+  if (((implicit_lower_bounds | implicit_upper_bounds) >> rank) != 0) {
+    source.Fail(serialization::DecodeError("Invalid implicit bounds"));
+    return false;
+  }
+  rep.implicit_lower_bounds = DimensionSet::FromUint(
+      static_cast<DimensionSet::Uint>(implicit_lower_bounds));
+  rep.implicit_upper_bounds = DimensionSet::FromUint(
+      static_cast<DimensionSet::Uint>(implicit_upper_bounds));
+  bool has_labels;
+  if (!serialization::Decode(source, has_labels)) return false;
+  const auto labels = rep.input_labels();
+  if (has_labels) {
+    for (DimensionIndex i = 0; i < rank; ++i) {
+      if (!serialization::ReadDelimited(reader, labels[i])) return false;
+    }
+  }
+  TENSORSTORE_RETURN_IF_ERROR(
+      internal::ValidateDimensionLabelsAreUnique(labels),
+      (source.Fail(_), false));
+  return true;
+}
+
+// Validates the decoded `rep` and sets the output index maps.
+[[nodiscard]] bool FinalizeDecodedTransformRep(
+    serialization::DecodeSource& source, TransformRep& rep,
+    span<const OutputIndexMapInitializer> output_maps) {
+  TENSORSTORE_RETURN_IF_ERROR(
+      SetOutputIndexMapsAndValidateTransformRep(
+          &rep, output_maps, IntervalForm::half_open,
+          BuilderFlags::kSetLower | BuilderFlags::kSetImplicitLower |
+              BuilderFlags::kSetUpper | BuilderFlags::kSetImplicitUpper),
+      (source.Fail(_), false));
+  return true;
+}
+
+}  // namespace
+
 bool IndexTransformNonNullSerializer::Encode(serialization::EncodeSink& sink,
                                              IndexTransformView<> value) {
-  return serialization::Encode(sink, ::nlohmann::json(value));
+  auto& writer = sink.writer();
+  const DimensionIndex output_rank = value.output_rank();
+  if (!serialization::WriteSize(writer, value.input_rank()) ||
+      !serialization::WriteSize(writer, output_rank) ||
+      !EncodeDomain(sink, value.domain())) {
+    return false;
+  }
+  const auto maps = value.output_index_maps();
+  for (DimensionIndex output_dim = 0; output_dim < output_rank; ++output_dim) {
+    const auto map = maps[output_dim];
+    const OutputIndexMethod method = map.method();
+    if (!serialization::Encode(sink, static_cast<uint8_t>(method)) ||
+        !WriteIndex(writer, map.offset())) {
+      return false;
+    }
+    if (method == OutputIndexMethod::constant) continue;
+    if (!WriteIndex(writer, map.stride())) return false;
+    if (method == OutputIndexMethod::single_input_dimension) {
+      if (!serialization::WriteSize(writer, map.input_dimension())) {
+        return false;
+      }
+      continue;
+    }
+    const auto index_array = map.index_array();
+    const IndexInterval index_range = index_array.index_range();
+    if (!internal_array::EncodeArray(
+            sink,
+            UnbroadcastArrayPreserveRank(
+                UnownedToShared(index_array.array_ref())),
+            offset_origin) ||
+        !WriteIndex(writer, index_range.inclusive_min()) ||
+        !WriteIndex(writer, index_range.inclusive_max())) {
+      return false;
+    }
+  }
+  return true;
 }
 
 bool IndexTransformNonNullSerializer::Decode(
     serialization::DecodeSource& source,
     internal_index_space::TransformRep::Ptr<>& value) const {
-  ::nlohmann::json json;
-  if (!serialization::Decode(source, json)) return false;
-  TENSORSTORE_ASSIGN_OR_RETURN(
-      value,
-      internal_index_space::ParseIndexTransformFromJson(
-          json, input_rank_constraint, output_rank_constraint),
-      (source.Fail(_), false));
+  auto& reader = source.reader();
+  DimensionIndex input_rank, output_rank;
+  if (!ReadRank(source, input_rank_constraint, input_rank) ||
+      !ReadRank(source, output_rank_constraint, output_rank)) {
+    return false;
+  }
+  auto rep = TransformRep::Allocate(input_rank, output_rank);
+  rep->input_rank = input_rank;
+  rep->output_rank = output_rank;
+  if (!DecodeDomain(source, *rep)) return false;
+  absl::InlinedVector<OutputIndexMapInitializer, internal::kNumInlinedDims>
+      output_maps(output_rank);
+  const auto maps = rep->output_index_maps();
+  for (DimensionIndex output_dim = 0; output_dim < output_rank; ++output_dim) {
+    auto& map = maps[output_dim];
+    uint8_t method;
+    if (!serialization::Decode(source, method) ||
+        !ReadIndex(source, map.offset())) {
+      return false;
+    }
+    map.stride() = 0;
+    switch (static_cast<OutputIndexMethod>(method)) {
+      case OutputIndexMethod::constant:
+        continue;
+      case OutputIndexMethod::single_input_dimension: {
+        size_t input_dim;
+        if (!ReadIndex(source, map.stride()) ||
+            !serialization::ReadSize(reader, input_dim)) {
+          return false;
+        }
+        // Out-of-range dimensions are rejected by
+        // `FinalizeDecodedTransformRep`.
+        output_maps[output_dim] = OutputIndexMapInitializer(
+            static_cast<DimensionIndex>(std::min<size_t>(input_dim, kMaxRank)));
+        continue;
+      }
+      case OutputIndexMethod::array: {
+        SharedArray<void, dynamic_rank, offset_origin> index_array;
+        Index inclusive_min, inclusive_max;
+        if (!ReadIndex(source, map.stride()) ||
+            !internal_array::DecodeArray<offset_origin>::Decode(
+                source, index_array, dtype_v<Index>, input_rank) ||
+            !ReadIndex(source, inclusive_min) ||
+            !ReadIndex(source, inclusive_max)) {
+          return false;
+        }
+        output_maps[output_dim] = OutputIndexMapInitializer(
+            StaticDataTypeCast<const Index, unchecked>(std::move(index_array)),
+            IndexInterval::Closed(inclusive_min, inclusive_max));
+        continue;
+      }
+    }
+    source.Fail(serialization::DecodeError("Invalid output index method"));
+    return false;
+  }
+  if (!FinalizeDecodedTransformRep(source, *rep, output_maps)) return false;
+  value = std::move(rep);
   return true;
 }
 
@@ -691,18 +921,31 @@ bool IndexTransformSerializer::Decode(
 
 bool IndexDomainNonNullSerializer::Encode(serialization::EncodeSink& sink,
                                           IndexDomainView<> value) {
-  return serialization::Encode(sink, ::nlohmann::json(value));
+  return serialization::WriteSize(sink.writer(), value.rank()) &&
+         EncodeDomain(sink, value);
 }
 
 bool IndexDomainNonNullSerializer::Decode(
     serialization::DecodeSource& source,
     internal_index_space::TransformRep::Ptr<>& value) const {
-  ::nlohmann::json json;
-  if (!serialization::Decode(source, json)) return false;
-  TENSORSTORE_ASSIGN_OR_RETURN(
-      value,
-      internal_index_space::ParseIndexDomainFromJson(json, rank_constraint),
-      (source.Fail(_), false));
+  DimensionIndex rank;
+  if (!ReadRank(source, rank_constraint, rank)) return false;
+  auto rep = TransformRep::Allocate(rank, rank);
+  rep->input_rank = rank;
+  rep->output_rank = rank;
+  if (!DecodeDomain(source, *rep)) return false;
+  // As for domains parsed from JSON, the output index maps are the identity.
+  absl::InlinedVector<OutputIndexMapInitializer, internal::kNumInlinedDims>
+      output_maps;
+  output_maps.reserve(rank);
+  const auto maps = rep->output_index_maps();
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    maps[i].offset() = 0;
+    maps[i].stride() = 1;
+    output_maps.emplace_back(i);
+  }
+  if (!FinalizeDecodedTransformRep(source, *rep, output_maps)) return false;
+  value = std::move(rep);
   return true;
 }
 
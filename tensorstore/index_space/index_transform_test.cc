@@ -24,6 +24,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/status/status.h"
+#include <nlohmann/json.hpp>
 #include "tensorstore/array.h"
 #include "tensorstore/container_kind.h"
 #include "tensorstore/index.h"
@@ -32,7 +33,10 @@
 #include "tensorstore/index_space/index_domain_builder.h"
 #include "tensorstore/index_space/index_transform_builder.h"
 #include "tensorstore/index_space/internal/transform_rep.h"
+#include "tensorstore/index_space/json.h"
 #include "tensorstore/rank.h"
+#include "tensorstore/serialization/batch.h"
+#include "tensorstore/serialization/json.h"
 #include "tensorstore/serialization/serialization.h"
 #include "tensorstore/serialization/test_util.h"
 #include "tensorstore/static_cast.h"
@@ -1118,10 +1122,58 @@ TEST(IndexTransformSerializationTest, Basic) {
   TestSerializationRoundTrip(tensorstore::IdentityTransform(5));
 }
 
+TEST(IndexTransformSerializationTest, AllOutputIndexMethods) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto transform,
+      IndexTransformBuilder(3, 4)
+          .input_origin({-kInfIndex, 2, -5})
+          .input_shape({kInfIndex + 1, 3, 4})
+          .implicit_lower_bounds({1, 0, 0})
+          .implicit_upper_bounds({1, 0, 1})
+          .input_labels({"x", "", "z"})
+          .output_constant(0, -7)
+          .output_single_input_dimension(1, 100, -3, 2)
+          .output_index_array(2, 5, 2, MakeArray<Index>({{{1, 2, 3, 4}}}),
+                              IndexInterval::Closed(0, 3))
+          .output_single_input_dimension(3, 0)
+          .Finalize());
+  TestSerializationRoundTrip(transform);
+  TestSerializationRoundTrip(IndexTransform<>(
+      IndexTransformBuilder(2, 0).input_shape({2, 3}).Finalize().value()));
+}
+
+TEST(IndexTransformSerializationTest, SmallerThanJson) {
+  auto transform = IdentityTransform(span<const Index>({100, 200, 300}));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto encoded, tensorstore::serialization::EncodeBatch(transform));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto encoded_json, tensorstore::serialization::EncodeBatch(
+                             ::nlohmann::json(transform)));
+  EXPECT_LT(encoded.size(), encoded_json.size() / 2);
+}
+
+TEST(IndexTransformSerializationTest, InvalidRank) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto encoded,
+      tensorstore::serialization::EncodeBatch(IdentityTransform(3)));
+  // The first byte indicates a non-null transform, followed by the input rank.
+  ASSERT_EQ(3, encoded[1]);
+  encoded[1] = tensorstore::kMaxRank + 1;
+  IndexTransform<> decoded;
+  EXPECT_FALSE(tensorstore::serialization::DecodeBatch(encoded, decoded).ok());
+}
+
 TEST(IndexDomainSerializationTest, Basic) {
   TestSerializationRoundTrip(tensorstore::IndexDomain<>());
   TestSerializationRoundTrip(
       tensorstore::IndexDomain<>(tensorstore::IdentityTransform(5).domain()));
+  TestSerializationRoundTrip(IndexDomainBuilder(2)
+                                 .origin({1, -2})
+                                 .shape({3, 4})
+                                 .labels({"a", "b"})
+                                 .implicit_upper_bounds({0, 1})
+                                 .Finalize()
+                                 .value());
 }
 
 TEST(ComputeInputDimensionReferenceCountsTest, Identity) {
@@ -274,6 +274,85 @@ absl::Status InitializeSingleArrayIterationState(
       single_array_state, input_dimension_flags);
 }
 
+void ConvertArithmeticProgressionIndexArrays(
+    DimensionIndex input_rank, const Index* iteration_shape,
+    SingleArrayIterationState* single_array_state,
+    input_dimension_iteration_flags::Bitmask* input_dimension_flags) {
+  namespace flags = input_dimension_iteration_flags;
+  auto& state = *single_array_state;
+  if (state.num_array_indexed_output_dimensions == 0) return;
+  for (DimensionIndex input_dim = 0; input_dim < input_rank; ++input_dim) {
+    // The index arrays must not be accessed if the domain is empty.
+    if (iteration_shape[input_dim] == 0) return;
+  }
+  DimensionIndex num_remaining = 0;
+  for (DimensionIndex j = 0; j < state.num_array_indexed_output_dimensions;
+       ++j) {
+    const Index* byte_strides = state.index_array_byte_strides[j];
+    const auto index_array_pointer = state.index_array_pointers[j];
+    // Input dimension on which the index array depends, or `-1` if it
+    // depends on more than one.
+    DimensionIndex varying_dim = -1;
+    for (DimensionIndex input_dim = 0; input_dim < input_rank; ++input_dim) {
+      if (byte_strides[input_dim] == 0 || iteration_shape[input_dim] == 1) {
+        continue;
+      }
+      if (varying_dim != -1) {
+        varying_dim = -1;
+        break;
+      }
+      varying_dim = input_dim;
+    }
+    if (varying_dim != -1) {
+      // The bounds of the index array have already been validated, so the
+      // differences between consecutive indices cannot overflow.
+      const Index byte_stride = byte_strides[varying_dim];
+      const Index size = iteration_shape[varying_dim];
+      const Index first = index_array_pointer[0];
+      const Index step = index_array_pointer[byte_stride] - first;
+      bool is_progression = true;
+      for (Index i = 2; i < size; ++i) {
+        if (index_array_pointer[i * byte_stride] -
+                index_array_pointer[(i - 1) * byte_stride] !=
+            step) {
+          is_progression = false;
+          break;
+        }
+      }
+      if (is_progression) {
+        const Index output_byte_stride =
+            state.index_array_output_byte_strides[j];
+        state.base_pointer +=
+            internal::wrap_on_overflow::Multiply(output_byte_stride, first);
+        state.input_byte_strides[varying_dim] = internal::wrap_on_overflow::Add(
+            state.input_byte_strides[varying_dim],
+            internal::wrap_on_overflow::Multiply(output_byte_stride, step));
+        if (step != 0) input_dimension_flags[varying_dim] |= flags::strided;
+        continue;
+      }
+    }
+    state.index_array_byte_strides[num_remaining] = byte_strides;
+    state.index_array_pointers[num_remaining] = index_array_pointer;
+    state.index_array_output_byte_strides[num_remaining] =
+        state.index_array_output_byte_strides[j];
+    ++num_remaining;
+  }
+  if (num_remaining == state.num_array_indexed_output_dimensions) return;
+  state.num_array_indexed_output_dimensions = num_remaining;
+  // Recompute the `array_indexed` flags from the remaining index arrays.
+  for (DimensionIndex input_dim = 0; input_dim < input_rank; ++input_dim) {
+    input_dimension_flags[input_dim] &= ~flags::array_indexed;
+  }
+  for (DimensionIndex j = 0; j < num_remaining; ++j) {
+    const Index* byte_strides = state.index_array_byte_strides[j];
+    for (DimensionIndex input_dim = 0; input_dim < input_rank; ++input_dim) {
+      if (byte_strides[input_dim] != 0 && iteration_shape[input_dim] != 1) {
+        input_dimension_flags[input_dim] |= flags::array_indexed;
+      }
+    }
+  }
+}
+
 Index IndirectInnerProduct(span<const Index> indices,
                            const DimensionIndex* dimension_order,
                            const Index* byte_strides) {
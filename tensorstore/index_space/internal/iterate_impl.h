@@ -142,6 +142,27 @@ absl::Status InitializeSingleArrayIterationState(
     SingleArrayIterationState* single_array_state,
     input_dimension_iteration_flags::Bitmask* input_dimension_flags);
 
+/// Replaces index arrays of `single_array_state` that depend on a single input
+/// dimension, and whose values along that dimension form an arithmetic
+/// progression, with the equivalent byte stride.
+///
+/// This allows index arrays produced by, for example, `IndexArraySlice` with a
+/// range of indices to be iterated as strided (and possibly contiguous)
+/// arrays.  The `array_indexed` and `strided` flags of `input_dimension_flags`
+/// are updated accordingly.
+///
+/// \param input_rank The input rank.
+/// \param iteration_shape Non-null pointer to array of length `input_rank`
+///     previously passed to `InitializeSingleArrayIterationState`.
+/// \param single_array_state[in,out] Must be non-null.  Previously initialized
+///     by `InitializeSingleArrayIterationState`.
+/// \param input_dimension_flags[in,out] Non-null pointer to array of length
+///     `input_rank`.
+void ConvertArithmeticProgressionIndexArrays(
+    DimensionIndex input_rank, const Index* iteration_shape,
+    SingleArrayIterationState* single_array_state,
+    input_dimension_iteration_flags::Bitmask* input_dimension_flags);
+
 /// Marks singleton dimensions as skippable.
 ///
 /// Specifically, sets `input_dimension_flags[i] = can_skip` if `input_shape[i]
@@ -14,6 +14,7 @@
 
 #include "tensorstore/index_space/internal/transform_rep.h"
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <algorithm>
@@ -27,6 +28,7 @@
 #include <string_view>
 #include <utility>
 
+#include "absl/base/config.h"
 #include "absl/base/optimization.h"
 #include "absl/log/absl_check.h"
 #include "absl/status/status.h"
@@ -154,19 +156,110 @@ void OutputIndexMap::Assign(DimensionIndex rank, const OutputIndexMap& other) {
   stride_ = other.stride_;
 }
 
-TransformRep::Ptr<> TransformRep::Allocate(
-    DimensionIndex input_rank_capacity, DimensionIndex output_rank_capacity) {
-  ABSL_CHECK(input_rank_capacity >= 0 && output_rank_capacity >= 0 &&
-             input_rank_capacity <= kMaxRank &&
-             output_rank_capacity <= kMaxRank);
-  const size_t total_size =
-      // header size
+namespace {
+
+size_t GetTransformRepAllocationSize(DimensionIndex input_rank_capacity,
+                                     DimensionIndex output_rank_capacity) {
+  return  // header size
       sizeof(TransformRep) +
       // size of OutputIndexMap array
       sizeof(OutputIndexMap) * output_rank_capacity +
       // size of input_origin, input_shape, and input_labels arrays
       input_rank_capacity * (sizeof(Index) * 2 + sizeof(std::string));
-  char* base_ptr = static_cast<char*>(::operator new(total_size));
+}
+
+// Freed representations are retained in a per-thread cache for reuse, as
+// operations such as chunked reads and writes allocate and free several
+// representations per chunk.  Blocks are grouped into size classes that are
+// multiples of `kTransformRepSizeClassBytes`, which covers all capacities up
+// to about rank 13.
+#if defined(ABSL_HAVE_ADDRESS_SANITIZER) || defined(ABSL_HAVE_MEMORY_SANITIZER)
+// Reusing blocks would hide use-after-free errors from the sanitizer.
+constexpr bool kCacheFreedTransformReps = false;
+#else
+constexpr bool kCacheFreedTransformReps = true;
+#endif
+constexpr size_t kTransformRepSizeClassBytes = 64;
+constexpr size_t kNumTransformRepSizeClasses = 16;
+constexpr size_t kMaxCachedTransformRepsPerSizeClass = 32;
+
+struct TransformRepCache {
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  FreeBlock* free_blocks[kNumTransformRepSizeClasses] = {};
+  size_t num_free_blocks[kNumTransformRepSizeClasses] = {};
+
+  ~TransformRepCache();
+};
+
+// Set once the cache of the current thread has been destroyed, after which
+// blocks freed by the exiting thread are returned directly to the heap.
+thread_local bool transform_rep_cache_destroyed = false;
+thread_local TransformRepCache transform_rep_cache;
+
+TransformRepCache::~TransformRepCache() {
+  transform_rep_cache_destroyed = true;
+  for (FreeBlock* block : free_blocks) {
+    while (block) {
+      FreeBlock* next = block->next;
+      ::operator delete(static_cast<void*>(block));
+      block = next;
+    }
+  }
+}
+
+size_t GetTransformRepSizeClass(size_t total_size) {
+  return (total_size - 1) / kTransformRepSizeClassBytes;
+}
+
+void* AllocateTransformRepBlock(size_t total_size) {
+  const size_t size_class = GetTransformRepSizeClass(total_size);
+  if (!kCacheFreedTransformReps ||
+      size_class >= kNumTransformRepSizeClasses) {
+    return ::operator new(total_size);
+  }
+  if (!transform_rep_cache_destroyed) {
+    auto& cache = transform_rep_cache;
+    if (auto* block = cache.free_blocks[size_class]) {
+      cache.free_blocks[size_class] = block->next;
+      --cache.num_free_blocks[size_class];
+      return block;
+    }
+  }
+  // Allocate the full size class so that the block may be reused for any
+  // capacities in the same class.
+  return ::operator new((size_class + 1) * kTransformRepSizeClassBytes);
+}
+
+void FreeTransformRepBlock(void* ptr, size_t total_size) {
+  const size_t size_class = GetTransformRepSizeClass(total_size);
+  if (kCacheFreedTransformReps && size_class < kNumTransformRepSizeClasses &&
+      !transform_rep_cache_destroyed) {
+    auto& cache = transform_rep_cache;
+    if (cache.num_free_blocks[size_class] <
+        kMaxCachedTransformRepsPerSizeClass) {
+      auto* block = static_cast<TransformRepCache::FreeBlock*>(ptr);
+      block->next = cache.free_blocks[size_class];
+      cache.free_blocks[size_class] = block;
+      ++cache.num_free_blocks[size_class];
+      return;
+    }
+  }
+  ::operator delete(ptr);
+}
+
+}  // namespace
+
+TransformRep::Ptr<> TransformRep::Allocate(
+    DimensionIndex input_rank_capacity, DimensionIndex output_rank_capacity) {
+  ABSL_CHECK(input_rank_capacity >= 0 && output_rank_capacity >= 0 &&
+             input_rank_capacity <= kMaxRank &&
+             output_rank_capacity <= kMaxRank);
+  char* base_ptr = static_cast<char*>(AllocateTransformRepBlock(
+      GetTransformRepAllocationSize(input_rank_capacity,
+                                    output_rank_capacity)));
   TransformRep* ptr =  // NOLINT
       new (base_ptr + sizeof(OutputIndexMap) * output_rank_capacity)
           TransformRep;
@@ -188,7 +281,10 @@ void TransformRep::Free(TransformRep* ptr) {
   assert(ptr->reference_count == 0);
   DestroyLabelFields(ptr);
   std::destroy_n(ptr->output_index_maps().begin(), ptr->output_rank_capacity);
-  ::operator delete(static_cast<void*>(ptr->output_index_maps().data()));
+  FreeTransformRepBlock(static_cast<void*>(ptr->output_index_maps().data()),
+                        GetTransformRepAllocationSize(
+                            ptr->input_rank_capacity,
+                            ptr->output_rank_capacity));
 }
 
 void CopyTransformRep(TransformRep* source, TransformRep* dest) {
@@ -189,6 +189,25 @@ TEST(Allocate, Basic) {
   EXPECT_TRUE(ptr->input_labels()[2].empty());
 }
 
+TEST(Allocate, ReuseFreed) {
+  // Freed representations may be reused by subsequent allocations, including
+  // ones with different capacities, which must still be fully initialized.
+  for (int i = 0; i < 2; ++i) {
+    auto ptr = TransformRep::Allocate(3, 2);
+    ptr->input_labels()[0] = "x";
+    ptr->output_index_maps()[1].SetArrayIndexing(3);
+  }
+  auto ptr = TransformRep::Allocate(2, 3);
+  EXPECT_EQ(2, ptr->input_rank_capacity);
+  EXPECT_EQ(3, ptr->output_rank_capacity);
+  for (DimensionIndex i = 0; i < 3; ++i) {
+    EXPECT_EQ(OutputIndexMethod::constant,
+              ptr->output_index_maps()[i].method());
+  }
+  EXPECT_TRUE(ptr->input_labels()[0].empty());
+  EXPECT_TRUE(ptr->input_labels()[1].empty());
+}
+
 TEST(CopyTransformRep, Basic) {
   auto source = TransformRep::Allocate(1, 2);
   source->input_rank = 1;
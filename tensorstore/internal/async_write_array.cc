@@ -33,6 +33,7 @@
 #include "tensorstore/index_space/output_index_method.h"
 #include "tensorstore/index_space/transformed_array.h"
 #include "tensorstore/internal/arena.h"
+#include "tensorstore/internal/chunk_buffer_pool.h"
 #include "tensorstore/internal/integer_overflow.h"
 #include "tensorstore/internal/masked_array.h"
 #include "tensorstore/internal/memory.h"
@@ -94,8 +95,9 @@ Result<NDIterable::Ptr> AsyncWriteArray::Spec::GetReadNDIterable(
 
 SharedArray<void> AsyncWriteArray::Spec::AllocateArray(
     span<const Index> shape) const {
-  return tensorstore::AllocateArray(shape, layout_order(), default_init,
-                                    this->dtype());
+  return internal::AllocateChunkArray(buffer_pool.get(), shape,
+                                     layout_order(), default_init,
+                                     this->dtype());
 }
 
 AsyncWriteArray::MaskedArray::MaskedArray(DimensionIndex rank) : mask(rank) {}
@@ -221,6 +223,7 @@ size_t AsyncWriteArray::MaskedArray::EstimateSizeInBytes(
     const Index num_elements = ProductOfExtents(shape);
     total += num_elements * sizeof(bool);
   }
+  total += mask.boxes.size() * 2 * shape.size() * sizeof(Index);
   return total;
 }
 
@@ -232,12 +235,32 @@ void AsyncWriteArray::MaskedArray::EnsureWritable(const Spec& spec) {
   array_capabilities = kMutableArray;
 }
 
+namespace {
+// Returns `true` if the output range of `chunk_transform` is exactly `domain`,
+// i.e. every position in `domain` is written.
+bool IsDomainFullyCovered(IndexTransformView<> chunk_transform,
+                          BoxView<> domain) {
+  Box<dynamic_rank(kMaxRank)> output_range(domain.rank());
+  auto output_range_exact = GetOutputRange(chunk_transform, output_range);
+  return output_range_exact.ok() && *output_range_exact &&
+         output_range == domain;
+}
+}  // namespace
+
 Result<TransformedSharedArray<void>>
 AsyncWriteArray::MaskedArray::GetWritableTransformedArray(
     const Spec& spec, BoxView<> domain, IndexTransform<> chunk_transform) {
-  // TODO(jbms): Could avoid copies when the output range of `chunk_transform`
-  // is known to fully cover ``domain`.
-  if (!array.valid()) {
+  assert(!overwrite_backup);
+  const bool must_copy = array.valid() ? array_capabilities != kMutableArray
+                                       : IsFullyOverwritten(spec, domain);
+  if (must_copy && IsDomainFullyCovered(chunk_transform, domain)) {
+    // The existing contents would be entirely overwritten, so there is no need
+    // to copy them.
+    overwrite_backup.emplace(
+        OverwriteBackup{std::move(this->array), array_capabilities});
+    this->array = spec.AllocateArray(domain.shape());
+    array_capabilities = kMutableArray;
+  } else if (!array.valid()) {
     this->array = spec.AllocateArray(domain.shape());
     array_capabilities = kMutableArray;
     if (IsFullyOverwritten(spec, domain)) {
@@ -255,9 +278,13 @@ AsyncWriteArray::MaskedArray::GetWritableTransformedArray(
 
   StridedLayoutView<dynamic_rank, offset_origin> data_layout{
       domain, this->array.byte_strides()};
-  TENSORSTORE_ASSIGN_OR_RETURN(
-      chunk_transform,
-      ComposeLayoutAndTransform(data_layout, std::move(chunk_transform)));
+  auto composed_transform =
+      ComposeLayoutAndTransform(data_layout, std::move(chunk_transform));
+  if (!composed_transform.ok()) {
+    AbortWrite();
+    return std::move(composed_transform).status();
+  }
+  chunk_transform = *std::move(composed_transform);
 
   return {std::in_place,
           UnownedToShared(
@@ -272,15 +299,26 @@ Result<NDIterable::Ptr> AsyncWriteArray::MaskedArray::BeginWrite(
   TENSORSTORE_ASSIGN_OR_RETURN(
       auto transformed_array,
       GetWritableTransformedArray(spec, domain, std::move(chunk_transform)));
-  return GetTransformedArrayNDIterable(std::move(transformed_array), arena);
+  auto iterable =
+      GetTransformedArrayNDIterable(std::move(transformed_array), arena);
+  if (!iterable.ok()) AbortWrite();
+  return iterable;
 }
 
 void AsyncWriteArray::MaskedArray::EndWrite(
     const Spec& spec, BoxView<> domain, IndexTransformView<> chunk_transform,
     Arena* arena) {
+  overwrite_backup.reset();
   WriteToMask(&mask, domain, chunk_transform, spec.layout_order(), arena);
 }
 
+void AsyncWriteArray::MaskedArray::AbortWrite() {
+  if (!overwrite_backup) return;
+  array = std::move(overwrite_backup->array);
+  array_capabilities = overwrite_backup->array_capabilities;
+  overwrite_backup.reset();
+}
+
 void AsyncWriteArray::MaskedArray::Clear() {
   mask.Reset();
   array = {};
@@ -503,8 +541,13 @@ absl::Status AsyncWriteArray::WriteArray(
     TENSORSTORE_ASSIGN_OR_RETURN(
         auto dest_transformed_array,
         write_state.GetWritableTransformedArray(spec, domain, chunk_transform));
-    TENSORSTORE_RETURN_IF_ERROR(CopyTransformedArray(
-        std::get<0>(source_array_info), dest_transformed_array));
+    if (auto status = CopyTransformedArray(std::get<0>(source_array_info),
+                                           dest_transformed_array);
+        !status.ok()) {
+      write_state.AbortWrite();
+      return status;
+    }
+    write_state.overwrite_backup.reset();
   } else {
     if (!ZeroCopyToWriteArray(spec, domain, chunk_transform,
                               std::get<0>(source_array_info),
@@ -529,6 +572,7 @@ void AsyncWriteArray::EndWrite(const Spec& spec, BoxView<> domain,
                                IndexTransformView<> chunk_transform,
                                bool success, Arena* arena) {
   if (!success) {
+    write_state.AbortWrite();
     InvalidateReadState();
     return;
   }
@@ -22,6 +22,7 @@
 
 #include <stddef.h>
 
+#include <optional>
 #include <utility>
 
 #include "absl/functional/function_ref.h"
@@ -34,6 +35,8 @@
 #include "tensorstore/index_space/index_transform.h"
 #include "tensorstore/index_space/transformed_array.h"
 #include "tensorstore/internal/arena.h"
+#include "tensorstore/internal/chunk_buffer_pool.h"
+#include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/masked_array.h"
 #include "tensorstore/internal/nditerable.h"
 #include "tensorstore/kvstore/generation.h"
@@ -105,6 +108,10 @@ struct AsyncWriteArray {
     EqualityComparisonKind fill_value_comparison_kind =
         EqualityComparisonKind::identical;
 
+    /// Pool from which new arrays are allocated, or `nullptr` to use the
+    /// default allocator.
+    internal::IntrusivePtr<ChunkBufferPool> buffer_pool;
+
     /// Returns the rank of this array.
     DimensionIndex rank() const { return overall_fill_value.rank(); }
 
@@ -255,6 +262,15 @@ struct AsyncWriteArray {
     void EndWrite(const Spec& spec, BoxView<> domain,
                   IndexTransformView<> chunk_transform, Arena* arena);
 
+    /// Must be called instead of `EndWrite` if writing to the array returned by
+    /// `GetWritableTransformedArray` or the `NDIterable` returned by
+    /// `BeginWrite` fails.
+    ///
+    /// If the write covered the entire domain, the previous contents of
+    /// `array` were not copied to the array being written, and are restored.
+    /// Otherwise, the positions that were written retain their new values.
+    void AbortWrite();
+
     /// Write the fill value.
     ///
     /// \param spec The associated `Spec`.
@@ -290,6 +306,18 @@ struct AsyncWriteArray {
 
     /// Copies `array`, which must already exist.
     void EnsureWritable(const Spec& spec);
+
+    struct OverwriteBackup {
+      SharedArray<void> array;
+      ArrayCapabilities array_capabilities;
+    };
+
+    /// Set by `GetWritableTransformedArray` when the write covers the entire
+    /// domain, in which case a new uninitialized array is allocated rather
+    /// than copying the existing contents (or the fill value).  Holds the
+    /// previous `array` until the write ends, so that it can be restored by
+    /// `AbortWrite`.
+    std::optional<OverwriteBackup> overwrite_backup;
   };
 
   /// Modifications to the read state.
@@ -35,6 +35,7 @@
 #include "tensorstore/index_space/dim_expression.h"
 #include "tensorstore/index_space/index_domain.h"
 #include "tensorstore/index_space/index_transform.h"
+#include "tensorstore/index_space/index_transform_builder.h"
 #include "tensorstore/index_space/index_transform_testutil.h"
 #include "tensorstore/index_space/transformed_array.h"
 #include "tensorstore/internal/arena.h"
@@ -204,17 +205,20 @@ TEST(MaskedArrayTest, Basic) {
   EXPECT_FALSE(write_state.IsUnmodified());
   EXPECT_FALSE(write_state.IsFullyOverwritten(spec, domain));
 
-  // Make write region non-rectangular to force mask allocation.
+  // Make write region non-rectangular.  The mask is the list of the boxes
+  // written rather than a mask array.
   TestWrite(&write_state, spec, domain,
             tensorstore::MakeOffsetArray<int32_t>({0, 0}, {{9}}));
   EXPECT_EQ(MakeArray<int32_t>({{9, 0, 0}, {0, 7, 8}}),
             write_state.shared_array_view(spec));
-  EXPECT_EQ(MakeArray<bool>({{1, 0, 0}, {0, 1, 1}}),
-            write_state.mask.mask_array);
+  EXPECT_FALSE(write_state.mask.mask_array.valid());
+  EXPECT_THAT(write_state.mask.boxes,
+              ::testing::ElementsAre(Box<>({1, 1}, {1, 2}),
+                                     Box<>({0, 0}, {1, 1})));
   EXPECT_FALSE(write_state.IsUnmodified());
   EXPECT_FALSE(write_state.IsFullyOverwritten(spec, domain));
-  // Both data array and mask array have been allocated.
-  EXPECT_EQ(2 * 3 * (sizeof(int32_t) + sizeof(bool)),
+  // The data array and the boxes have been allocated.
+  EXPECT_EQ(2 * 3 * sizeof(int32_t) + 2 * 2 * 2 * sizeof(Index),
             write_state.EstimateSizeInBytes(spec, domain.shape()));
 
   {
@@ -326,6 +330,66 @@ TEST(MaskedArrayTest, PartialChunk) {
   EXPECT_TRUE(write_state.IsFullyOverwritten(spec, domain));
 }
 
+// Tests that a write that covers the entire domain of an array that has been
+// overwritten with the fill value does not require the fill value to be copied,
+// and that `AbortWrite` restores the previous state.
+TEST(MaskedArrayTest, FullOverwrite) {
+  auto overall_fill_value = MakeArray<int32_t>({{1, 2, 3}, {4, 5, 6}});
+  tensorstore::Box<> component_bounds({0, 0}, {2, 3});
+  Spec spec{overall_fill_value, component_bounds};
+  Box<> domain{{0, 0}, {2, 3}};
+  MaskedArray write_state(2);
+  write_state.WriteFillValue(spec, domain);
+  EXPECT_FALSE(write_state.array.valid());
+
+  // Abort a write that covers the entire domain.
+  TENSORSTORE_ASSERT_OK(write_state.GetWritableTransformedArray(
+      spec, domain, tensorstore::IdentityTransform(domain)));
+  EXPECT_TRUE(write_state.array.valid());
+  write_state.AbortWrite();
+  EXPECT_FALSE(write_state.array.valid());
+  EXPECT_TRUE(write_state.IsFullyOverwritten(spec, domain));
+
+  auto source = MakeArray<int32_t>({{7, 8, 9}, {10, 11, 12}});
+  TestWrite(&write_state, spec, domain, source);
+  EXPECT_TRUE(write_state.IsFullyOverwritten(spec, domain));
+  EXPECT_EQ(source, write_state.shared_array_view(spec));
+  {
+    auto writeback_data = write_state.GetArrayForWriteback(
+        spec, domain, /*read_array=*/{},
+        /*read_state_already_integrated=*/false);
+    EXPECT_TRUE(writeback_data.must_store);
+    EXPECT_EQ(source, writeback_data.array);
+  }
+}
+
+// Tests that a write that fails in `BeginWrite` leaves the write state
+// unchanged, so that subsequent writes succeed.
+TEST(MaskedArrayTest, BeginWriteFailingTransform) {
+  auto overall_fill_value = MakeArray<int32_t>({{1, 2, 3}, {4, 5, 6}});
+  tensorstore::Box<> component_bounds({0, 0}, {2, 3});
+  Spec spec{overall_fill_value, component_bounds};
+  Box<> domain{{0, 0}, {2, 3}};
+  MaskedArray write_state(2);
+  write_state.WriteFillValue(spec, domain);
+
+  // Index 5 is outside the domain.
+  auto transform = tensorstore::IndexTransformBuilder<>(1, 2)
+                       .input_origin({0})
+                       .input_shape({2})
+                       .output_index_array(0, 0, 1, MakeArray<Index>({0, 5}))
+                       .output_constant(1, 0)
+                       .Finalize()
+                       .value();
+  Arena arena;
+  EXPECT_FALSE(write_state.BeginWrite(spec, domain, transform, &arena).ok());
+  EXPECT_TRUE(write_state.IsFullyOverwritten(spec, domain));
+
+  auto source = MakeArray<int32_t>({{7, 8, 9}, {10, 11, 12}});
+  TestWrite(&write_state, spec, domain, source);
+  EXPECT_EQ(source, write_state.shared_array_view(spec));
+}
+
 // Tests that `store_if_equal_to_fill_value==true` is correctly handled.
 TEST(MaskedArrayTest, StoreIfEqualToFillValue) {
   auto overall_fill_value = MakeScalarArray<int32_t>(42);
@@ -0,0 +1,115 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/aws/aws_credentials_cache.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/aws/aws_credentials.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace internal_aws {
+
+struct AwsCredentialsCache::State {
+  FetchFunction fetch;
+  std::function<absl::Time()> clock;
+
+  absl::Mutex mutex;
+  bool has_credentials ABSL_GUARDED_BY(mutex) = false;
+  AwsCredentials credentials ABSL_GUARDED_BY(mutex);
+  // Refresh in progress, or null.
+  Future<AwsCredentials> pending ABSL_GUARDED_BY(mutex);
+  absl::Time next_background_refresh ABSL_GUARDED_BY(mutex) =
+      absl::InfinitePast();
+};
+
+namespace {
+
+using State = AwsCredentialsCache::State;
+
+void OnRefreshComplete(State& state, const Result<AwsCredentials>& result) {
+  absl::MutexLock lock(&state.mutex);
+  state.pending = Future<AwsCredentials>();
+  if (result.ok()) {
+    const absl::Time expiration = result->GetExpiration();
+    const absl::Time prior_expiration = state.credentials.GetExpiration();
+    if (!state.has_credentials || expiration >= prior_expiration) {
+      state.has_credentials = true;
+      state.credentials = *result;
+    }
+    if (expiration > prior_expiration) return;
+  }
+  // Sources that cache credentials themselves may return the same credentials
+  // until shortly before they expire.
+  state.next_background_refresh =
+      state.clock() + AwsCredentialsCache::kBackgroundRefreshRetryInterval;
+}
+
+}  // namespace
+
+AwsCredentialsCache::AwsCredentialsCache(AwsCredentialsProvider provider)
+    : AwsCredentialsCache([provider = std::move(provider)] {
+        return GetAwsCredentials(provider.get());
+      }) {}
+
+AwsCredentialsCache::AwsCredentialsCache(FetchFunction fetch,
+                                         std::function<absl::Time()> clock)
+    : state_(std::make_shared<State>()) {
+  state_->fetch = std::move(fetch);
+  state_->clock = clock ? std::move(clock) : &absl::Now;
+}
+
+Future<AwsCredentials> AwsCredentialsCache::GetCredentials() const {
+  if (!state_) return AwsCredentials(nullptr);
+  Future<AwsCredentials> refresh_future;
+  Future<AwsCredentials> result;
+  {
+    auto& state = *state_;
+    absl::MutexLock lock(&state.mutex);
+    const absl::Time now = state.clock();
+    const bool valid =
+        state.has_credentials && now < state.credentials.GetExpiration();
+    if (valid) {
+      result = MakeReadyFuture<AwsCredentials>(state.credentials);
+      if (!state.pending.null() ||
+          now < std::max(state.credentials.GetExpiration() -
+                             kBackgroundRefreshMargin,
+                         state.next_background_refresh)) {
+        return result;
+      }
+    } else if (!state.pending.null()) {
+      return state.pending;
+    }
+    state.pending = refresh_future = state.fetch();
+    if (!valid) result = refresh_future;
+  }
+  // The callback is registered without holding the lock, since it runs
+  // immediately if the credentials were returned synchronously.
+  refresh_future.ExecuteWhenReady(
+      [state = state_](ReadyFuture<AwsCredentials> future) {
+        OnRefreshComplete(*state, future.result());
+      });
+  return result;
+}
+
+}  // namespace internal_aws
+}  // namespace tensorstore
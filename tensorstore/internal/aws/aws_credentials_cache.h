@@ -0,0 +1,73 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_AWS_AWS_CREDENTIALS_CACHE_H_
+#define TENSORSTORE_INTERNAL_AWS_AWS_CREDENTIALS_CACHE_H_
+
+#include <functional>
+#include <memory>
+
+#include "absl/time/time.h"
+#include "tensorstore/internal/aws/aws_credentials.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace internal_aws {
+
+/// Caches AWS credentials, and refreshes them in the background before they
+/// expire.
+///
+/// Once the cached credentials are within `kBackgroundRefreshMargin` of
+/// expiring, `GetCredentials` starts a single refresh but continues to return
+/// the still-valid cached credentials, such that requests do not wait on the
+/// credentials source.  Only once the credentials have expired, or if there
+/// are none, do callers wait for the refresh.
+class AwsCredentialsCache {
+ public:
+  /// Duration before expiration at which credentials are refreshed in the
+  /// background.
+  static constexpr absl::Duration kBackgroundRefreshMargin = absl::Minutes(5);
+
+  /// Minimum interval between background refresh attempts, if a refresh fails
+  /// or does not extend the expiration time.
+  static constexpr absl::Duration kBackgroundRefreshRetryInterval =
+      absl::Seconds(10);
+
+  using FetchFunction = std::function<Future<AwsCredentials>()>;
+
+  AwsCredentialsCache() = default;
+
+  /// Caches credentials obtained from `provider`.
+  explicit AwsCredentialsCache(AwsCredentialsProvider provider);
+
+  /// Caches credentials obtained by calling `fetch`.
+  explicit AwsCredentialsCache(FetchFunction fetch,
+                               std::function<absl::Time()> clock = {});
+
+  /// Returns the cached credentials, or waits for new credentials if the
+  /// cached credentials have expired.
+  ///
+  /// Safe for concurrent use by multiple threads.
+  Future<AwsCredentials> GetCredentials() const;
+
+  struct State;
+
+ private:
+  std::shared_ptr<State> state_;
+};
+
+}  // namespace internal_aws
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_AWS_AWS_CREDENTIALS_CACHE_H_
@@ -0,0 +1,119 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/aws/aws_credentials_cache.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/aws/aws_credentials.h"
+#include "tensorstore/util/future.h"
+
+namespace {
+
+using ::tensorstore::Future;
+using ::tensorstore::Promise;
+using ::tensorstore::PromiseFuturePair;
+using ::tensorstore::internal_aws::AwsCredentials;
+using ::tensorstore::internal_aws::AwsCredentialsCache;
+
+struct TestSource {
+  absl::Time now = absl::FromUnixSeconds(1000000);
+  std::vector<Promise<AwsCredentials>> requests;
+
+  AwsCredentialsCache MakeCache() {
+    return AwsCredentialsCache(
+        [this] {
+          auto pair = PromiseFuturePair<AwsCredentials>::Make();
+          requests.push_back(std::move(pair.promise));
+          return std::move(pair.future);
+        },
+        [this] { return now; });
+  }
+
+  AwsCredentials MakeCredentials(const char* key_id) {
+    return AwsCredentials::Make(key_id, "secret", "session",
+                                now + absl::Hours(1));
+  }
+};
+
+TEST(AwsCredentialsCacheTest, RefreshesInBackgroundBeforeExpiration) {
+  TestSource source;
+  auto cache = source.MakeCache();
+
+  // Initially, callers wait for a single fetch.
+  auto future1 = cache.GetCredentials();
+  auto future2 = cache.GetCredentials();
+  ASSERT_EQ(1, source.requests.size());
+  EXPECT_FALSE(future1.ready());
+  source.requests[0].SetResult(source.MakeCredentials("key1"));
+  ASSERT_TRUE(future1.ready());
+  ASSERT_TRUE(future2.ready());
+  EXPECT_EQ("key1", future1.value().GetAccessKeyId());
+
+  // Cached credentials are returned without fetching.
+  EXPECT_EQ("key1", cache.GetCredentials().value().GetAccessKeyId());
+  EXPECT_EQ(1, source.requests.size());
+
+  // Within the refresh margin, the cached credentials are returned while a
+  // single background fetch is issued.
+  source.now += absl::Hours(1) - AwsCredentialsCache::kBackgroundRefreshMargin;
+  EXPECT_EQ("key1", cache.GetCredentials().value().GetAccessKeyId());
+  EXPECT_EQ("key1", cache.GetCredentials().value().GetAccessKeyId());
+  ASSERT_EQ(2, source.requests.size());
+  source.requests[1].SetResult(source.MakeCredentials("key2"));
+  EXPECT_EQ("key2", cache.GetCredentials().value().GetAccessKeyId());
+  EXPECT_EQ(2, source.requests.size());
+}
+
+TEST(AwsCredentialsCacheTest, RetriesBackgroundRefreshAfterInterval) {
+  TestSource source;
+  auto cache = source.MakeCache();
+  auto future = cache.GetCredentials();
+  ASSERT_EQ(1, source.requests.size());
+  source.requests[0].SetResult(source.MakeCredentials("key1"));
+
+  source.now += absl::Hours(1) - AwsCredentialsCache::kBackgroundRefreshMargin;
+  EXPECT_EQ("key1", cache.GetCredentials().value().GetAccessKeyId());
+  ASSERT_EQ(2, source.requests.size());
+  source.requests[1].SetResult(absl::UnavailableError("failed"));
+
+  // The failure does not affect callers, and the refresh is retried later.
+  EXPECT_EQ("key1", cache.GetCredentials().value().GetAccessKeyId());
+  EXPECT_EQ(2, source.requests.size());
+  source.now += AwsCredentialsCache::kBackgroundRefreshRetryInterval;
+  EXPECT_EQ("key1", cache.GetCredentials().value().GetAccessKeyId());
+  EXPECT_EQ(3, source.requests.size());
+}
+
+TEST(AwsCredentialsCacheTest, WaitsForRefreshAfterExpiration) {
+  TestSource source;
+  auto cache = source.MakeCache();
+  auto future = cache.GetCredentials();
+  ASSERT_EQ(1, source.requests.size());
+  source.requests[0].SetResult(source.MakeCredentials("key1"));
+
+  source.now += absl::Hours(2);
+  future = cache.GetCredentials();
+  ASSERT_EQ(2, source.requests.size());
+  EXPECT_FALSE(future.ready());
+  source.requests[1].SetResult(source.MakeCredentials("key2"));
+  ASSERT_TRUE(future.ready());
+  EXPECT_EQ("key2", future.value().GetAccessKeyId());
+}
+
+}  // namespace
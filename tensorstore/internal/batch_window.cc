@@ -0,0 +1,69 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/batch_window.h"
+
+#include <stdint.h>
+
+#include <utility>
+
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/batch.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/thread/schedule_at.h"
+
+namespace tensorstore {
+namespace internal {
+
+BatchWindow::~BatchWindow() = default;
+
+Batch BatchWindow::GetBatch() {
+  Batch released{no_batch};
+  Batch batch{no_batch};
+  {
+    absl::MutexLock lock(&mutex_);
+    if (!batch_) {
+      batch_ = Batch::New();
+      num_requests_ = 0;
+      const uint64_t generation = ++generation_;
+      if (options_.duration != absl::InfiniteDuration()) {
+        ScheduleAt(absl::Now() + options_.duration,
+                   [self = IntrusivePtr<BatchWindow>(this), generation] {
+                     self->EndWindow(generation);
+                   });
+      }
+    }
+    batch = batch_;
+    if (options_.max_requests && ++num_requests_ >= options_.max_requests) {
+      released = std::exchange(batch_, no_batch);
+    }
+  }
+  return batch;
+}
+
+void BatchWindow::EndWindow(uint64_t generation) {
+  Batch released{no_batch};
+  {
+    absl::MutexLock lock(&mutex_);
+    if (generation != generation_) return;
+    released = std::exchange(batch_, no_batch);
+  }
+  // `released` is destroyed, submitting the batch unless operations are still
+  // being added to it, after `mutex_` is unlocked.
+}
+
+}  // namespace internal
+}  // namespace tensorstore
@@ -0,0 +1,92 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_BATCH_WINDOW_H_
+#define TENSORSTORE_INTERNAL_BATCH_WINDOW_H_
+
+/// \file
+///
+/// Implicit batching of reads issued by independent callers.
+///
+/// A `Batch` only coalesces the operations that are explicitly added to it.
+/// When many independent callers read nearby data at about the same time,
+/// e.g. the request handlers of a server, a `BatchWindow` groups all of the
+/// operations started within a short time window into a single batch, such
+/// that the batch implementations of the underlying kvstores can coalesce
+/// them.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "tensorstore/batch.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+
+namespace tensorstore {
+namespace internal {
+
+class BatchWindow : public AtomicReferenceCount<BatchWindow> {
+ public:
+  struct Options {
+    /// Duration after the first operation of a window at which the batch is
+    /// submitted.  If infinite, windows end only after `max_requests`.
+    absl::Duration duration = absl::Microseconds(200);
+
+    /// If non-zero, the batch is also submitted once this many operations
+    /// have been added to it.
+    size_t max_requests = 0;
+
+    constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+      return f(x.duration, x.max_requests);
+    };
+  };
+
+  explicit BatchWindow(Options options) : options_(options) {}
+  ~BatchWindow();
+
+  const Options& options() const { return options_; }
+
+  /// Returns the batch of the current window, starting a new window if there
+  /// is none.
+  ///
+  /// The batch is submitted once the window ends and all references returned
+  /// by this function have been released.  Callers must therefore release the
+  /// returned batch once they have issued their operations, and must not wait
+  /// on those operations while holding it.
+  Batch GetBatch();
+
+ private:
+  // Ends the window identified by `generation`, if it is still current.
+  void EndWindow(uint64_t generation);
+
+  const Options options_;
+  absl::Mutex mutex_;
+  Batch batch_ ABSL_GUARDED_BY(mutex_){no_batch};
+  size_t num_requests_ ABSL_GUARDED_BY(mutex_) = 0;
+  uint64_t generation_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+/// Returns `batch` if it is not `no_batch`, and otherwise the batch of the
+/// current window of `window`, if not `nullptr`.
+inline Batch GetBatchOrWindow(Batch batch, BatchWindow* window) {
+  if (batch || !window) return batch;
+  return window->GetBatch();
+}
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_BATCH_WINDOW_H_
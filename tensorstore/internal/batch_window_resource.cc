@@ -0,0 +1,74 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/batch_window_resource.h"
+
+#include <stddef.h>
+
+#include "absl/status/status.h"
+#include "absl/time/time.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/context_resource_provider.h"
+#include "tensorstore/internal/batch_window.h"
+#include "tensorstore/internal/cache_key/absl_time.h"  // IWYU pragma: keep
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/json_binding/absl_time.h"  // IWYU pragma: keep
+#include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal {
+namespace {
+
+namespace jb = tensorstore::internal_json_binding;
+
+struct ReadBatchWindowResourceTraits
+    : public ContextResourceTraits<ReadBatchWindowResource> {
+  using Spec = BatchWindow::Options;
+  using Resource = typename ReadBatchWindowResource::Resource;
+  static Spec Default() { return {}; }
+  static constexpr auto JsonBinder() {
+    return jb::Object(
+        jb::Member("duration",
+                   jb::Projection(&Spec::duration,
+                                  jb::DefaultValue([](auto* v) {
+                                    *v = Spec{}.duration;
+                                  }))),
+        jb::Member("max_requests",
+                   jb::Projection(&Spec::max_requests,
+                                  jb::DefaultValue([](auto* v) { *v = 0; }))));
+  }
+  static Result<Resource> Create(const Spec& options,
+                                 ContextResourceCreationContext context) {
+    if (options.duration == absl::InfiniteDuration() &&
+        options.max_requests == 0) {
+      return absl::InvalidArgumentError(
+          "\"max_requests\" must be specified if \"duration\" is infinite");
+    }
+    return MakeIntrusivePtr<BatchWindow>(options);
+  }
+
+  static Spec GetSpec(const Resource& window,
+                      const ContextSpecBuilder& builder) {
+    return window->options();
+  }
+};
+
+const ContextResourceRegistration<ReadBatchWindowResourceTraits> registration;
+
+}  // namespace
+}  // namespace internal
+}  // namespace tensorstore
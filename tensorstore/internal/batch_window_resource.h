@@ -0,0 +1,35 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_BATCH_WINDOW_RESOURCE_H_
+#define TENSORSTORE_INTERNAL_BATCH_WINDOW_RESOURCE_H_
+
+#include "tensorstore/internal/batch_window.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+
+namespace tensorstore {
+namespace internal {
+
+/// Context resource corresponding to a `BatchWindow` used for reads that do
+/// not specify a batch.
+struct ReadBatchWindowResource {
+  static constexpr char id[] = "read_batch_window";
+
+  using Resource = IntrusivePtr<BatchWindow>;
+};
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_BATCH_WINDOW_RESOURCE_H_
@@ -0,0 +1,134 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/batch_window.h"
+
+#include <memory>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/synchronization/notification.h"
+#include "absl/time/time.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/batch.h"
+#include "tensorstore/batch_impl.h"
+#include "tensorstore/context.h"
+#include "tensorstore/internal/batch_window_resource.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::Batch;
+using ::tensorstore::Context;
+using ::tensorstore::internal::BatchWindow;
+using ::tensorstore::internal::GetBatchOrWindow;
+using ::tensorstore::internal::MakeIntrusivePtr;
+using ::tensorstore::internal::ReadBatchWindowResource;
+
+// Batch entry that notifies when the batch is submitted.
+struct NotifyingEntry : public Batch::Impl::Entry {
+  using KeyParam = int;
+
+  explicit NotifyingEntry(absl::Notification& submitted)
+      : Batch::Impl::Entry(/*nesting_depth=*/0), submitted(submitted) {}
+
+  int key() const { return 0; }
+  void Submit(Batch::View batch) override {
+    submitted.Notify();
+    delete this;
+  }
+
+  absl::Notification& submitted;
+};
+
+void NotifyOnSubmit(Batch::View batch, absl::Notification& submitted) {
+  Batch::Impl::From(batch)->GetEntry<NotifyingEntry>(
+      0, [&] { return std::make_unique<NotifyingEntry>(submitted); });
+}
+
+Batch::Impl* GetImpl(Batch::View batch) { return Batch::Impl::From(batch); }
+
+TEST(BatchWindowTest, SameWindow) {
+  auto window = MakeIntrusivePtr<BatchWindow>(
+      BatchWindow::Options{absl::InfiniteDuration(), 0});
+  Batch a = window->GetBatch();
+  Batch b = window->GetBatch();
+  EXPECT_TRUE(a);
+  EXPECT_EQ(GetImpl(a), GetImpl(b));
+}
+
+TEST(BatchWindowTest, Duration) {
+  auto window = MakeIntrusivePtr<BatchWindow>(
+      BatchWindow::Options{absl::Milliseconds(10), 0});
+  absl::Notification submitted;
+  NotifyOnSubmit(window->GetBatch(), submitted);
+  // Submitted once the window ends, even though no further operations are
+  // added.
+  EXPECT_TRUE(submitted.WaitForNotificationWithTimeout(absl::Seconds(10)));
+  // A new window is started.
+  Batch batch = window->GetBatch();
+  EXPECT_TRUE(Batch::View(batch).deferred());
+}
+
+TEST(BatchWindowTest, MaxRequests) {
+  auto window = MakeIntrusivePtr<BatchWindow>(
+      BatchWindow::Options{absl::InfiniteDuration(), 2});
+  absl::Notification submitted;
+  Batch a = window->GetBatch();
+  NotifyOnSubmit(a, submitted);
+  Batch b = window->GetBatch();
+  EXPECT_EQ(GetImpl(a), GetImpl(b));
+  // The window ends after `max_requests`.
+  Batch c = window->GetBatch();
+  EXPECT_NE(GetImpl(a), GetImpl(c));
+  a.Release();
+  EXPECT_FALSE(submitted.HasBeenNotified());
+  b.Release();
+  EXPECT_TRUE(submitted.HasBeenNotified());
+}
+
+TEST(BatchWindowTest, GetBatchOrWindow) {
+  auto window = MakeIntrusivePtr<BatchWindow>(
+      BatchWindow::Options{absl::InfiniteDuration(), 0});
+  Batch explicit_batch = Batch::New();
+  EXPECT_EQ(GetImpl(explicit_batch),
+            GetImpl(GetBatchOrWindow(explicit_batch, window.get())));
+  EXPECT_FALSE(GetBatchOrWindow(Batch::no_batch, nullptr));
+  Batch window_batch = window->GetBatch();
+  EXPECT_EQ(GetImpl(window_batch),
+            GetImpl(GetBatchOrWindow(Batch::no_batch, window.get())));
+}
+
+TEST(BatchWindowTest, Resource) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto spec,
+      Context::Resource<ReadBatchWindowResource>::FromJson(
+          {{"duration", "1ms"}, {"max_requests", 16}}));
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto resource, context.GetResource(spec));
+  EXPECT_EQ(absl::Milliseconds(1), (*resource)->options().duration);
+  EXPECT_EQ(16, (*resource)->options().max_requests);
+}
+
+TEST(BatchWindowTest, ResourceInvalid) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto spec, Context::Resource<ReadBatchWindowResource>::FromJson(
+                     {{"duration", "inf"}}));
+  EXPECT_THAT(Context::Default().GetResource(spec),
+              tensorstore::MatchesStatus(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace
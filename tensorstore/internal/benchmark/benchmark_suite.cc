@@ -0,0 +1,154 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/benchmark/benchmark_suite.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/str_format.h"
+#include "tensorstore/context.h"
+#include "tensorstore/index.h"
+#include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/internal/json_binding/enum.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/internal/json_binding/std_array.h"
+#include "tensorstore/json_serialization_options_base.h"
+#include "tensorstore/spec.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal_benchmark {
+
+namespace jb = ::tensorstore::internal_json_binding;
+
+namespace {
+constexpr auto AccessPatternKindBinder = jb::Enum<AccessPattern::Kind,
+                                                  std::string_view>({
+    {AccessPattern::kSequential, "sequential"},
+    {AccessPattern::kRandomChunk, "random_chunk"},
+    {AccessPattern::kPointGather, "point_gather"},
+    {AccessPattern::kStridedSlice, "strided_slice"},
+});
+}  // namespace
+
+TENSORSTORE_DEFINE_JSON_DEFAULT_BINDER(
+    AccessPattern,
+    jb::Object(
+        jb::Member("kind", jb::Projection<&AccessPattern::kind>(
+                               AccessPatternKindBinder)),
+        jb::Member("count", jb::Projection<&AccessPattern::count>(
+                                jb::DefaultValue([](auto* x) { *x = 100; }))),
+        jb::Member("stride", jb::Projection<&AccessPattern::stride>(
+                                 jb::DefaultInitializedValue()))));
+
+TENSORSTORE_DEFINE_JSON_DEFAULT_BINDER(
+    BenchmarkStore,
+    jb::Object(jb::Member("name", jb::Projection<&BenchmarkStore::name>()),
+               jb::Member("spec", jb::Projection<&BenchmarkStore::spec>())));
+
+TENSORSTORE_DEFINE_JSON_DEFAULT_BINDER(
+    BenchmarkSuite,
+    jb::Object(
+        jb::Member("context", jb::Projection<&BenchmarkSuite::context>(
+                                  jb::DefaultInitializedValue())),
+        jb::Member("repeat", jb::Projection<&BenchmarkSuite::repeat>(
+                                 jb::DefaultValue([](auto* x) { *x = 3; }))),
+        jb::Member("stores", jb::Projection<&BenchmarkSuite::stores>()),
+        jb::Member("patterns", jb::Projection<&BenchmarkSuite::patterns>())));
+
+TENSORSTORE_DEFINE_JSON_DEFAULT_BINDER(
+    BenchmarkCaseResult,
+    jb::Object(
+        jb::Member("name", jb::Projection<&BenchmarkCaseResult::name>()),
+        jb::Member("operations",
+                   jb::Projection<&BenchmarkCaseResult::operations>()),
+        jb::Member("bytes", jb::Projection<&BenchmarkCaseResult::bytes>()),
+        jb::Member("throughput",
+                   jb::Projection<&BenchmarkCaseResult::throughput>()),
+        jb::Member("p50_latency",
+                   jb::Projection<&BenchmarkCaseResult::p50_latency>()),
+        jb::Member("p99_latency",
+                   jb::Projection<&BenchmarkCaseResult::p99_latency>()),
+        jb::Member("cpu_time",
+                   jb::Projection<&BenchmarkCaseResult::cpu_time>()),
+        jb::Member("peak_rss",
+                   jb::Projection<&BenchmarkCaseResult::peak_rss>()),
+        jb::DiscardExtraMembers));
+
+std::string GetBenchmarkCaseName(const BenchmarkStore& store,
+                                 const AccessPattern& pattern) {
+  std::string_view kind;
+  switch (pattern.kind) {
+    case AccessPattern::kSequential:
+      kind = "sequential";
+      break;
+    case AccessPattern::kRandomChunk:
+      kind = "random_chunk";
+      break;
+    case AccessPattern::kPointGather:
+      kind = "point_gather";
+      break;
+    case AccessPattern::kStridedSlice:
+      kind = "strided_slice";
+      break;
+  }
+  return absl::StrFormat("%s/%s", store.name, kind);
+}
+
+double Percentile(span<const double> values, double q) {
+  if (values.empty()) return 0;
+  std::vector<double> sorted(values.begin(), values.end());
+  size_t rank = static_cast<size_t>(std::ceil(q * sorted.size()));
+  rank = std::clamp<size_t>(rank, 1, sorted.size());
+  std::nth_element(sorted.begin(), sorted.begin() + (rank - 1), sorted.end());
+  return sorted[rank - 1];
+}
+
+std::vector<std::string> FindRegressions(
+    span<const BenchmarkCaseResult> results,
+    span<const BenchmarkCaseResult> baseline, double threshold) {
+  absl::flat_hash_map<std::string_view, const BenchmarkCaseResult*>
+      baseline_by_name;
+  for (const auto& result : baseline) {
+    baseline_by_name[result.name] = &result;
+  }
+  std::vector<std::string> regressions;
+  for (const auto& result : results) {
+    auto it = baseline_by_name.find(result.name);
+    if (it == baseline_by_name.end()) continue;
+    const auto& base = *it->second;
+    if (result.throughput < base.throughput * (1 - threshold)) {
+      regressions.push_back(absl::StrFormat(
+          "%s: throughput %.4g B/s is %.1f%% below baseline %.4g B/s",
+          result.name, result.throughput,
+          100 * (1 - result.throughput / base.throughput), base.throughput));
+    }
+    if (result.p99_latency > base.p99_latency * (1 + threshold)) {
+      regressions.push_back(absl::StrFormat(
+          "%s: p99 latency %.4gs is above baseline %.4gs", result.name,
+          result.p99_latency, base.p99_latency));
+    }
+  }
+  return regressions;
+}
+
+}  // namespace internal_benchmark
+}  // namespace tensorstore
@@ -0,0 +1,159 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_BENCHMARK_BENCHMARK_SUITE_H_
+#define TENSORSTORE_INTERNAL_BENCHMARK_BENCHMARK_SUITE_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/index.h"
+#include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/json_serialization_options_base.h"
+#include "tensorstore/spec.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal_benchmark {
+
+/// Access pattern used to read a TensorStore.
+struct AccessPattern {
+  enum Kind {
+    /// Reads each read chunk, in C order.
+    kSequential,
+    /// Reads `count` randomly-chosen read chunks.
+    kRandomChunk,
+    /// Reads `count` randomly-chosen single elements.
+    kPointGather,
+    /// Reads the entire domain, strided by `stride`.
+    kStridedSlice,
+  };
+
+  Kind kind = kSequential;
+
+  /// Number of operations, for `kRandomChunk` and `kPointGather`.
+  int64_t count = 100;
+
+  /// Stride of each dimension, for `kStridedSlice`.
+  std::vector<Index> stride;
+
+  TENSORSTORE_DECLARE_JSON_DEFAULT_BINDER(AccessPattern,
+                                          JsonSerializationOptions,
+                                          JsonSerializationOptions);
+};
+
+/// Named TensorStore spec to benchmark.
+struct BenchmarkStore {
+  std::string name;
+
+  /// Spec used to create the TensorStore.  Must specify the domain, data type
+  /// and chunk layout.
+  Spec spec;
+
+  TENSORSTORE_DECLARE_JSON_DEFAULT_BINDER(BenchmarkStore,
+                                          JsonSerializationOptions,
+                                          JsonSerializationOptions);
+};
+
+/// Declarative benchmark suite.  Each store is benchmarked with each access
+/// pattern.
+///
+/// Example:
+///
+///     {
+///       "context": {"cache_pool": {"total_bytes_limit": 0}},
+///       "repeat": 5,
+///       "stores": [
+///         {"name": "zarr3_raw", "spec": {"driver": "zarr3", ...}},
+///         ...
+///       ],
+///       "patterns": [
+///         {"kind": "sequential"},
+///         {"kind": "random_chunk", "count": 64},
+///         {"kind": "point_gather", "count": 1000},
+///         {"kind": "strided_slice", "stride": [4, 4]}
+///       ]
+///     }
+struct BenchmarkSuite {
+  /// Context used for each store.  A new cache pool is created for each
+  /// repetition, such that reads are not satisfied by the cache.
+  Context::Spec context;
+
+  /// Number of times each case is repeated.
+  int64_t repeat = 3;
+
+  std::vector<BenchmarkStore> stores;
+  std::vector<AccessPattern> patterns;
+
+  TENSORSTORE_DECLARE_JSON_DEFAULT_BINDER(BenchmarkSuite,
+                                          JsonSerializationOptions,
+                                          JsonSerializationOptions);
+};
+
+/// Returns the name of a case, e.g. `"zarr3_raw/random_chunk"`.
+std::string GetBenchmarkCaseName(const BenchmarkStore& store,
+                                 const AccessPattern& pattern);
+
+/// Result of a single benchmark case, accumulated over all repetitions.
+struct BenchmarkCaseResult {
+  std::string name;
+
+  /// Number of read operations.
+  int64_t operations = 0;
+
+  /// Total number of bytes read.
+  int64_t bytes = 0;
+
+  /// Throughput, in bytes per second of wall time.
+  double throughput = 0;
+
+  /// Latency percentiles of individual read operations, in seconds.
+  double p50_latency = 0;
+  double p99_latency = 0;
+
+  /// User and system CPU time, in seconds.
+  double cpu_time = 0;
+
+  /// Peak resident set size of the process, in bytes.
+  int64_t peak_rss = 0;
+
+  TENSORSTORE_DECLARE_JSON_DEFAULT_BINDER(BenchmarkCaseResult,
+                                          JsonSerializationOptions,
+                                          JsonSerializationOptions);
+};
+
+/// Returns the `q` quantile, in `[0, 1]`, of `values` using the nearest-rank
+/// method, or `0` if `values` is empty.
+double Percentile(span<const double> values, double q);
+
+/// Compares `results` to `baseline`, matching cases by name.
+///
+/// A case has regressed if its throughput decreased, or its p99 latency
+/// increased, by more than the fraction `threshold` of the baseline value.
+/// Cases not present in `baseline` are ignored.
+///
+/// Returns a description of each regression.
+std::vector<std::string> FindRegressions(
+    span<const BenchmarkCaseResult> results,
+    span<const BenchmarkCaseResult> baseline, double threshold);
+
+}  // namespace internal_benchmark
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_BENCHMARK_BENCHMARK_SUITE_H_
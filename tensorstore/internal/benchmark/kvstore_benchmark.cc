@@ -38,6 +38,17 @@ bazel run -c opt \
   --repeat_writes=10 \
   --repeat_reads=100
 
+# remote_dram, with an in-process server; the transports are chosen by UCX,
+# for example with UCX_TLS=rc, dc, tcp or shm.  Servers on the same node,
+# including loopback addresses, use the shared-memory transports with
+# UCX_TLS=shm or sm (posix, sysv and cma).
+
+UCX_TLS=rc bazel run -c opt \
+  //tensorstore/internal/benchmark:kvstore_benchmark -- \
+  --server_kvstore_spec='{"driver": "remote_dram", "listen_addr": "0.0.0.0:12345"}' \
+  --kvstore_spec='{"driver": "remote_dram", "remote_addr": "'$(hostname -i)':12345"}' \
+  --repeat_writes=10 --repeat_reads=100
+
 # Quick size reference:
 
 16KB   --chunk_size=16384
@@ -78,6 +89,7 @@ bazel run -c opt \
 #include <nlohmann/json.hpp>
 #include "tensorstore/context.h"
 #include "absl/flags/parse.h"
+#include "tensorstore/internal/benchmark/kvstore_server.h"
 #include "tensorstore/internal/benchmark/metric_utils.h"
 #include "tensorstore/internal/metrics/metadata.h"
 #include "tensorstore/internal/metrics/registry.h"
@@ -394,6 +406,7 @@ void DoKvstoreBenchmark() {
   internal::EnsureDirectoryPath(kvstore_spec.path);
 
   Context context(absl::GetFlag(FLAGS_context_spec).value);
+  auto server = internal::MaybeOpenServer(context);
 
   MaybeCleanExisting(context, kvstore_spec);
 
@@ -21,6 +21,17 @@ bazel run -c opt \
   //tensorstore/internal/benchmark:kvstore_duration -- \
   --context_spec='{"file_io_concurrency": {"limit": 128}}' \
   --kvstore_spec='"file:///tmp/kvstore"' --duration=1m
+
+# remote_dram, with an in-process server; the transports are chosen by UCX,
+# for example with UCX_TLS=rc, dc, tcp or shm.  Servers on the same node,
+# including loopback addresses, use the shared-memory transports with
+# UCX_TLS=shm or sm (posix, sysv and cma).
+
+UCX_TLS=rc bazel run -c opt \
+  //tensorstore/internal/benchmark:kvstore_duration -- \
+  --server_kvstore_spec='{"driver": "remote_dram", "listen_addr": "0.0.0.0:12345"}' \
+  --kvstore_spec='{"driver": "remote_dram", "remote_addr": "'$(hostname -i)':12345"}' \
+  --duration=1m
 */
 
 #include <stddef.h>
@@ -47,6 +58,7 @@ bazel run -c opt \
 #include "absl/time/time.h"
 #include "tensorstore/context.h"
 #include "absl/flags/parse.h"
+#include "tensorstore/internal/benchmark/kvstore_server.h"
 #include "tensorstore/internal/benchmark/metric_utils.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/metrics/metadata.h"
@@ -195,6 +207,7 @@ void Run() {
   internal::EnsureDirectoryPath(kvstore_spec.path);
 
   Context context(absl::GetFlag(FLAGS_context_spec).value);
+  auto server = internal::MaybeOpenServer(context);
 
   DoDurationBenchmark(context, kvstore_spec);
 
@@ -0,0 +1,47 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/benchmark/kvstore_server.h"
+
+#include <iostream>
+#include <optional>
+#include <utility>
+
+#include "absl/flags/flag.h"
+#include "tensorstore/context.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/util/json_absl_flag.h"
+#include "tensorstore/util/status.h"
+
+ABSL_FLAG(tensorstore::JsonAbslFlag<tensorstore::kvstore::Spec>,
+          server_kvstore_spec, {},
+          "KvStore spec opened before the benchmark and kept open until it "
+          "ends, such as a remote_dram server for --kvstore_spec to connect "
+          "to.  See examples at the start of the benchmark source files.");
+
+namespace tensorstore {
+namespace internal {
+
+std::optional<kvstore::KvStore> MaybeOpenServer(Context context) {
+  auto server_spec = absl::GetFlag(FLAGS_server_kvstore_spec).value;
+  if (!server_spec.valid()) return std::nullopt;
+  std::cout << "Opening in-process server." << std::endl;
+  TENSORSTORE_CHECK_OK_AND_ASSIGN(
+      auto server, kvstore::Open(std::move(server_spec), context).result());
+  return server;
+}
+
+}  // namespace internal
+}  // namespace tensorstore
@@ -0,0 +1,34 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_BENCHMARK_KVSTORE_SERVER_H_
+#define TENSORSTORE_INTERNAL_BENCHMARK_KVSTORE_SERVER_H_
+
+#include <optional>
+
+#include "tensorstore/context.h"
+#include "tensorstore/kvstore/kvstore.h"
+
+namespace tensorstore {
+namespace internal {
+
+// Opens --server_kvstore_spec, if specified, so that a server such as a
+// remote_dram listener runs in this process for the benchmark.  The server
+// runs until the returned kvstore is destroyed.
+std::optional<kvstore::KvStore> MaybeOpenServer(Context context);
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_BENCHMARK_KVSTORE_SERVER_H_
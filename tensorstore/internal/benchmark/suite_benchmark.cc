@@ -0,0 +1,395 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Runs a declarative benchmark suite, which reads each store of the suite
+// using each access pattern, and optionally compares the results to a
+// baseline.
+//
+// See `benchmark_suite.h` for the suite format, and `suite/default.json` for
+// an example covering several drivers, codecs and access patterns.
+
+/* Examples
+
+bazel run -c opt \
+  //tensorstore/internal/benchmark:suite_benchmark -- \
+  --suite=$PWD/tensorstore/internal/benchmark/suite/default.json \
+  --output=/tmp/results.json
+
+# Compare to previous results, exiting with a non-zero status on regression.
+
+bazel run -c opt \
+  //tensorstore/internal/benchmark:suite_benchmark -- \
+  --suite=$PWD/tensorstore/internal/benchmark/suite/default.json \
+  --baseline=/tmp/results.json \
+  --regression_threshold=0.1
+
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/log/absl_log.h"
+#include "absl/random/random.h"
+#include "absl/status/status.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_format.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include <nlohmann/json.hpp>
+#include "riegeli/bytes/fd_reader.h"
+#include "riegeli/bytes/fd_writer.h"
+#include "riegeli/bytes/read_all.h"
+#include "riegeli/bytes/write.h"
+#include "tensorstore/array.h"
+#include "tensorstore/box.h"
+#include "tensorstore/context.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_space/dim_expression.h"
+#include "tensorstore/internal/benchmark/benchmark_suite.h"
+#include "tensorstore/internal/data_type_random_generator.h"
+#include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/internal/json_binding/std_array.h"
+#include "tensorstore/open.h"
+#include "tensorstore/open_mode.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status.h"
+
+ABSL_FLAG(std::string, suite, "", "Path to the benchmark suite JSON file.");
+
+ABSL_FLAG(std::string, output, "",
+          "Path to which results are written as JSON.  If empty, results are "
+          "written to stdout.");
+
+ABSL_FLAG(std::string, baseline, "",
+          "Path to results of a previous run to compare against.");
+
+ABSL_FLAG(double, regression_threshold, 0.1,
+          "Fraction by which throughput may decrease, or p99 latency may "
+          "increase, relative to --baseline before a case is considered to "
+          "have regressed.");
+
+ABSL_FLAG(std::string, filter, "",
+          "If non-empty, only cases with names containing this substring are "
+          "run.");
+
+ABSL_FLAG(int64_t, max_in_flight, 64,
+          "Maximum number of concurrent read operations.");
+
+namespace tensorstore {
+namespace internal_benchmark {
+namespace {
+
+namespace jb = ::tensorstore::internal_json_binding;
+
+struct ResourceUsage {
+  double cpu_time;
+  int64_t peak_rss;
+};
+
+ResourceUsage GetResourceUsage() {
+  struct rusage usage;
+  ::getrusage(RUSAGE_SELF, &usage);
+  auto seconds = [](const struct timeval& t) {
+    return t.tv_sec + t.tv_usec * 1e-6;
+  };
+  // `ru_maxrss` is in kilobytes on Linux.
+  return {seconds(usage.ru_utime) + seconds(usage.ru_stime),
+          static_cast<int64_t>(usage.ru_maxrss) * 1024};
+}
+
+Result<::nlohmann::json> ReadJsonFile(const std::string& path) {
+  std::string data;
+  TENSORSTORE_RETURN_IF_ERROR(riegeli::ReadAll(riegeli::FdReader(path), data));
+  auto j = ::nlohmann::json::parse(data, nullptr, false);
+  if (j.is_discarded()) {
+    return absl::InvalidArgumentError(
+        absl::StrFormat("Failed to parse %s as JSON", path));
+  }
+  return j;
+}
+
+/// Returns the read chunk shape of `store`, substituting the extent of the
+/// domain for unconstrained dimensions.
+Result<std::vector<Index>> GetReadChunkShape(const TensorStore<>& store) {
+  TENSORSTORE_ASSIGN_OR_RETURN(auto layout, store.chunk_layout());
+  auto domain = store.domain().box();
+  std::vector<Index> shape(domain.rank());
+  auto read_chunk_shape = layout.read_chunk_shape();
+  for (DimensionIndex i = 0; i < domain.rank(); ++i) {
+    shape[i] = (i < read_chunk_shape.size() && read_chunk_shape[i] > 0)
+                   ? read_chunk_shape[i]
+                   : domain.shape()[i];
+  }
+  return shape;
+}
+
+/// Returns the chunk-aligned region of `domain` with grid cell `cell`.
+Box<> GetChunkRegion(BoxView<> domain, span<const Index> chunk_shape,
+                     span<const Index> cell) {
+  Box<> region(domain.rank());
+  for (DimensionIndex i = 0; i < domain.rank(); ++i) {
+    const Index start = domain.origin()[i] + cell[i] * chunk_shape[i];
+    region[i] = IndexInterval::UncheckedHalfOpen(
+        start, std::min(start + chunk_shape[i], domain[i].exclusive_max()));
+  }
+  return region;
+}
+
+/// Returns the regions read by a single repetition of `pattern`.
+Result<std::vector<Box<>>> GetReadRegions(const TensorStore<>& store,
+                                          const AccessPattern& pattern,
+                                          absl::BitGenRef gen) {
+  auto domain = store.domain().box();
+  const DimensionIndex rank = domain.rank();
+  TENSORSTORE_ASSIGN_OR_RETURN(auto chunk_shape, GetReadChunkShape(store));
+  std::vector<Index> grid_shape(rank);
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    grid_shape[i] = (domain.shape()[i] + chunk_shape[i] - 1) / chunk_shape[i];
+  }
+  std::vector<Box<>> regions;
+  std::vector<Index> cell(rank);
+  switch (pattern.kind) {
+    case AccessPattern::kSequential: {
+      if (domain.num_elements() == 0) break;
+      while (true) {
+        regions.push_back(GetChunkRegion(domain, chunk_shape, cell));
+        DimensionIndex i = rank - 1;
+        for (; i >= 0; --i) {
+          if (++cell[i] < grid_shape[i]) break;
+          cell[i] = 0;
+        }
+        if (i < 0) break;
+      }
+      break;
+    }
+    case AccessPattern::kRandomChunk:
+      for (int64_t n = 0; n < pattern.count; ++n) {
+        for (DimensionIndex i = 0; i < rank; ++i) {
+          cell[i] = absl::Uniform<Index>(gen, 0, grid_shape[i]);
+        }
+        regions.push_back(GetChunkRegion(domain, chunk_shape, cell));
+      }
+      break;
+    case AccessPattern::kPointGather:
+      for (int64_t n = 0; n < pattern.count; ++n) {
+        Box<> region(rank);
+        for (DimensionIndex i = 0; i < rank; ++i) {
+          region[i] = IndexInterval::UncheckedSized(
+              absl::Uniform<Index>(gen, domain[i].inclusive_min(),
+                                   domain[i].exclusive_max()),
+              1);
+        }
+        regions.push_back(std::move(region));
+      }
+      break;
+    case AccessPattern::kStridedSlice:
+      regions.push_back(Box<>(domain));
+      break;
+  }
+  return regions;
+}
+
+/// Returns a child of `base` with a new cache pool, configured as specified by
+/// the suite context.  Other resources, such as the in-memory key-value store,
+/// are shared with `base`.
+Result<Context> GetRepetitionContext(const BenchmarkSuite& suite,
+                                     const Context& base) {
+  TENSORSTORE_ASSIGN_OR_RETURN(auto context_json, suite.context.ToJson());
+  ::nlohmann::json cache_pool = ::nlohmann::json::object_t();
+  if (auto it = context_json.find("cache_pool"); it != context_json.end()) {
+    cache_pool = *it;
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto spec, Context::Spec::FromJson({{"cache_pool", cache_pool}}));
+  return Context(spec, base);
+}
+
+/// Writes random data to the entire domain of `store`.
+absl::Status FillStore(const TensorStore<>& store, absl::BitGenRef gen) {
+  auto data =
+      internal::MakeRandomArray(gen, store.domain().box(), store.dtype());
+  return tensorstore::Write(data, store).commit_future.result().status();
+}
+
+Result<BenchmarkCaseResult> RunCase(const BenchmarkSuite& suite,
+                                    const BenchmarkStore& store_config,
+                                    const AccessPattern& pattern,
+                                    const Context& context,
+                                    absl::BitGenRef gen) {
+  BenchmarkCaseResult result;
+  result.name = GetBenchmarkCaseName(store_config, pattern);
+  std::vector<double> latencies;
+  absl::Mutex latencies_mutex;
+  absl::Duration elapsed;
+  double cpu_time = 0;
+  const int64_t max_in_flight =
+      std::max<int64_t>(1, absl::GetFlag(FLAGS_max_in_flight));
+  for (int64_t repetition = 0; repetition < suite.repeat; ++repetition) {
+    // Open with a new cache pool for each repetition, such that reads are not
+    // satisfied by the cache of a previous repetition.
+    TENSORSTORE_ASSIGN_OR_RETURN(auto repetition_context,
+                                 GetRepetitionContext(suite, context));
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto store, tensorstore::Open(store_config.spec, repetition_context,
+                                      OpenMode::open, ReadWriteMode::read)
+                        .result());
+    TENSORSTORE_ASSIGN_OR_RETURN(auto regions,
+                                 GetReadRegions(store, pattern, gen));
+    const auto start_usage = GetResourceUsage();
+    const auto start_time = absl::Now();
+    std::deque<Future<SharedArray<void>>> in_flight;
+    absl::Status status;
+    auto wait_oldest = [&] {
+      auto& r = in_flight.front().result();
+      if (!r.ok() && status.ok()) status = r.status();
+      in_flight.pop_front();
+    };
+    for (const auto& region : regions) {
+      if (static_cast<int64_t>(in_flight.size()) >= max_in_flight) {
+        wait_oldest();
+      }
+      TENSORSTORE_ASSIGN_OR_RETURN(auto sliced,
+                                   store | AllDims().BoxSlice(region));
+      if (pattern.kind == AccessPattern::kStridedSlice) {
+        TENSORSTORE_ASSIGN_OR_RETURN(
+            sliced, sliced | AllDims().Stride(span<const Index>(
+                                 pattern.stride)));
+      }
+      result.bytes += sliced.domain().num_elements() * sliced.dtype().size();
+      ++result.operations;
+      auto future = tensorstore::Read<zero_origin>(sliced);
+      future.ExecuteWhenReady(
+          [&latencies, &latencies_mutex,
+           issue_time = absl::Now()](ReadyFuture<SharedArray<void>>) {
+            const double latency = absl::ToDoubleSeconds(absl::Now() -
+                                                         issue_time);
+            absl::MutexLock lock(&latencies_mutex);
+            latencies.push_back(latency);
+          });
+      in_flight.push_back(std::move(future));
+    }
+    while (!in_flight.empty()) wait_oldest();
+    elapsed += absl::Now() - start_time;
+    cpu_time += GetResourceUsage().cpu_time - start_usage.cpu_time;
+    TENSORSTORE_RETURN_IF_ERROR(status);
+  }
+  const double seconds = absl::ToDoubleSeconds(elapsed);
+  result.throughput = seconds > 0 ? result.bytes / seconds : 0;
+  absl::MutexLock lock(&latencies_mutex);
+  result.p50_latency = Percentile(latencies, 0.5);
+  result.p99_latency = Percentile(latencies, 0.99);
+  result.cpu_time = cpu_time;
+  result.peak_rss = GetResourceUsage().peak_rss;
+  return result;
+}
+
+absl::Status RunSuite() {
+  TENSORSTORE_ASSIGN_OR_RETURN(auto suite_json,
+                               ReadJsonFile(absl::GetFlag(FLAGS_suite)));
+  TENSORSTORE_ASSIGN_OR_RETURN(auto suite,
+                               BenchmarkSuite::FromJson(suite_json));
+  const std::string filter = absl::GetFlag(FLAGS_filter);
+  absl::InsecureBitGen gen;
+  std::vector<BenchmarkCaseResult> results;
+  for (const auto& store_config : suite.stores) {
+    std::vector<const AccessPattern*> patterns;
+    for (const auto& pattern : suite.patterns) {
+      if (absl::StrContains(GetBenchmarkCaseName(store_config, pattern),
+                            filter)) {
+        patterns.push_back(&pattern);
+      }
+    }
+    if (patterns.empty()) continue;
+    Context context(suite.context);
+    {
+      TENSORSTORE_ASSIGN_OR_RETURN(
+          auto store,
+          tensorstore::Open(store_config.spec, context,
+                            OpenMode::create | OpenMode::delete_existing,
+                            ReadWriteMode::read_write)
+              .result());
+      TENSORSTORE_RETURN_IF_ERROR(FillStore(store, gen));
+    }
+    for (const auto* pattern : patterns) {
+      TENSORSTORE_ASSIGN_OR_RETURN(
+          auto result, RunCase(suite, store_config, *pattern, context, gen),
+          tensorstore::MaybeAnnotateStatus(
+              _, GetBenchmarkCaseName(store_config, *pattern)));
+      ABSL_LOG(INFO) << result.name << ": "
+                     << jb::ToJson(result).value().dump();
+      results.push_back(std::move(result));
+    }
+  }
+
+  ::nlohmann::json results_json;
+  TENSORSTORE_RETURN_IF_ERROR(jb::DefaultBinder<>(
+      std::false_type{}, jb::NoOptions{}, &results, &results_json));
+  const std::string output = absl::GetFlag(FLAGS_output);
+  if (output.empty()) {
+    std::cout << results_json.dump(2) << std::endl;
+  } else {
+    TENSORSTORE_RETURN_IF_ERROR(
+        riegeli::Write(results_json.dump(2), riegeli::FdWriter(output)));
+  }
+
+  if (const std::string baseline_path = absl::GetFlag(FLAGS_baseline);
+      !baseline_path.empty()) {
+    TENSORSTORE_ASSIGN_OR_RETURN(auto baseline_json,
+                                 ReadJsonFile(baseline_path));
+    std::vector<BenchmarkCaseResult> baseline;
+    TENSORSTORE_RETURN_IF_ERROR(jb::DefaultBinder<>(
+        std::true_type{}, jb::NoOptions{}, &baseline, &baseline_json));
+    auto regressions = FindRegressions(
+        results, baseline, absl::GetFlag(FLAGS_regression_threshold));
+    for (const auto& regression : regressions) {
+      ABSL_LOG(ERROR) << "Regression: " << regression;
+    }
+    if (!regressions.empty()) {
+      return absl::FailedPreconditionError(absl::StrFormat(
+          "%d benchmark regressions relative to %s", regressions.size(),
+          baseline_path));
+    }
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+}  // namespace internal_benchmark
+}  // namespace tensorstore
+
+int main(int argc, char** argv) {
+  absl::ParseCommandLine(argc, argv);  // InitTensorstore
+  auto status = tensorstore::internal_benchmark::RunSuite();
+  if (!status.ok()) {
+    ABSL_LOG(ERROR) << status;
+    return 1;
+  }
+  return 0;
+}
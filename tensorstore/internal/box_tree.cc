@@ -0,0 +1,190 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/box_tree.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+#include <vector>
+
+#include "absl/functional/function_ref.h"
+#include "tensorstore/box.h"
+#include "tensorstore/index.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal {
+namespace {
+
+/// Maximum number of items in a leaf node.
+constexpr size_t kMaxLeafSize = 8;
+
+/// Returns twice the center of `[min, max]`, without overflow for infinite
+/// bounds.
+Index DoubledCenter(Index min, Index max) { return min / 2 + max / 2; }
+
+bool Intersects(const Index* bounds, DimensionIndex rank, const Index* min,
+                const Index* max) {
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    if (bounds[i] > max[i] || bounds[rank + i] < min[i]) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+BoxTree::BoxTree(span<const Box<>> boxes) : num_boxes_(boxes.size()) {
+  if (boxes.empty()) return;
+  rank_ = boxes[0].rank();
+  items_.reserve(boxes.size());
+  for (size_t i = 0; i < boxes.size(); ++i) {
+    assert(boxes[i].rank() == rank_);
+    if (boxes[i].is_empty()) continue;
+    items_.push_back(i);
+  }
+  if (items_.empty()) return;
+
+  // Partition the items into tree order by recursively splitting at the
+  // median.
+  std::vector<Index> centers(items_.size() * rank_);
+  for (size_t i = 0; i < items_.size(); ++i) {
+    const auto& box = boxes[items_[i]];
+    for (DimensionIndex dim = 0; dim < rank_; ++dim) {
+      centers[i * rank_ + dim] = DoubledCenter(
+          box[dim].inclusive_min(), box[dim].inclusive_max());
+    }
+  }
+  // `order` holds positions into `items_`/`centers` so that `centers` need not
+  // be permuted.
+  std::vector<size_t> order(items_.size());
+  std::iota(order.begin(), order.end(), size_t{0});
+  struct Range {
+    size_t begin, end;
+  };
+  std::vector<Range> stack{{0, order.size()}};
+  while (!stack.empty()) {
+    const Range range = stack.back();
+    stack.pop_back();
+    if (range.end - range.begin <= kMaxLeafSize) continue;
+    DimensionIndex split_dim = 0;
+    Index max_spread = -1;
+    for (DimensionIndex dim = 0; dim < rank_; ++dim) {
+      Index min_center = kMaxFiniteIndex, max_center = -kMaxFiniteIndex;
+      for (size_t i = range.begin; i < range.end; ++i) {
+        const Index c = centers[order[i] * rank_ + dim];
+        min_center = std::min(min_center, c);
+        max_center = std::max(max_center, c);
+      }
+      if (max_center - min_center > max_spread) {
+        max_spread = max_center - min_center;
+        split_dim = dim;
+      }
+    }
+    const size_t mid = range.begin + (range.end - range.begin) / 2;
+    std::nth_element(order.begin() + range.begin, order.begin() + mid,
+                     order.begin() + range.end, [&](size_t a, size_t b) {
+                       return centers[a * rank_ + split_dim] <
+                              centers[b * rank_ + split_dim];
+                     });
+    stack.push_back({range.begin, mid});
+    stack.push_back({mid, range.end});
+  }
+
+  std::vector<size_t> sorted_items(order.size());
+  item_bounds_.resize(order.size() * 2 * rank_);
+  for (size_t i = 0; i < order.size(); ++i) {
+    const size_t box_i = items_[order[i]];
+    sorted_items[i] = box_i;
+    const auto& box = boxes[box_i];
+    for (DimensionIndex dim = 0; dim < rank_; ++dim) {
+      item_bounds_[i * 2 * rank_ + dim] = box[dim].inclusive_min();
+      item_bounds_[i * 2 * rank_ + rank_ + dim] = box[dim].inclusive_max();
+    }
+  }
+  items_ = std::move(sorted_items);
+  // Node ranges mirror the splits made above, so the same midpoints are used.
+  BuildNode(0, items_.size());
+}
+
+size_t BoxTree::BuildNode(size_t begin, size_t end) {
+  const size_t node_i = nodes_.size();
+  nodes_.push_back(Node{begin, end, 0, 0});
+  node_bounds_.resize(nodes_.size() * 2 * rank_);
+  if (end - begin > kMaxLeafSize) {
+    const size_t mid = begin + (end - begin) / 2;
+    const size_t left = BuildNode(begin, mid);
+    const size_t right = BuildNode(mid, end);
+    nodes_[node_i].left = left;
+    nodes_[node_i].right = right;
+    Index* bounds = &node_bounds_[node_i * 2 * rank_];
+    const Index* left_bounds = node_bounds(left);
+    const Index* right_bounds = node_bounds(right);
+    for (DimensionIndex dim = 0; dim < rank_; ++dim) {
+      bounds[dim] = std::min(left_bounds[dim], right_bounds[dim]);
+      bounds[rank_ + dim] =
+          std::max(left_bounds[rank_ + dim], right_bounds[rank_ + dim]);
+    }
+  } else {
+    Index* bounds = &node_bounds_[node_i * 2 * rank_];
+    std::copy(item_bounds(begin), item_bounds(begin) + 2 * rank_, bounds);
+    for (size_t i = begin + 1; i < end; ++i) {
+      const Index* b = item_bounds(i);
+      for (DimensionIndex dim = 0; dim < rank_; ++dim) {
+        bounds[dim] = std::min(bounds[dim], b[dim]);
+        bounds[rank_ + dim] = std::max(bounds[rank_ + dim], b[rank_ + dim]);
+      }
+    }
+  }
+  return node_i;
+}
+
+void BoxTree::ForEachIntersecting(
+    BoxView<> box, absl::FunctionRef<void(size_t)> callback) const {
+  if (nodes_.empty() || box.is_empty()) return;
+  assert(box.rank() == rank_);
+  Index min[kMaxRank];
+  Index max[kMaxRank];
+  for (DimensionIndex dim = 0; dim < rank_; ++dim) {
+    min[dim] = box[dim].inclusive_min();
+    max[dim] = box[dim].inclusive_max();
+  }
+  std::vector<size_t> stack{0};
+  while (!stack.empty()) {
+    const size_t node_i = stack.back();
+    stack.pop_back();
+    if (!Intersects(node_bounds(node_i), rank_, min, max)) continue;
+    const Node& node = nodes_[node_i];
+    if (node.left != 0) {
+      stack.push_back(node.right);
+      stack.push_back(node.left);
+      continue;
+    }
+    for (size_t i = node.begin; i < node.end; ++i) {
+      if (Intersects(item_bounds(i), rank_, min, max)) callback(items_[i]);
+    }
+  }
+}
+
+std::vector<size_t> BoxTree::FindIntersecting(BoxView<> box) const {
+  std::vector<size_t> result;
+  ForEachIntersecting(box, [&](size_t i) { result.push_back(i); });
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+}  // namespace internal
+}  // namespace tensorstore
@@ -0,0 +1,98 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_BOX_TREE_H_
+#define TENSORSTORE_INTERNAL_BOX_TREE_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "absl/functional/function_ref.h"
+#include "tensorstore/box.h"
+#include "tensorstore/index.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal {
+
+/// Static spatial index over a list of boxes that supports efficiently finding
+/// the boxes that intersect a query box.
+///
+/// This is a bounding volume hierarchy (similar to a bulk-loaded R-tree), built
+/// by recursively splitting the boxes at the median of their centers along the
+/// dimension over which the centers are most spread out.  For boxes that do
+/// not overlap much, such as the tiles of a mosaic, a query takes
+/// `O(log n + k)` time, where `k` is the number of results.
+///
+/// Used by the "stack" driver to find the layers that intersect a read or
+/// write request.
+class BoxTree {
+ public:
+  BoxTree() = default;
+
+  /// Builds the index over `boxes`.
+  ///
+  /// \dchecks All boxes have the same rank.
+  explicit BoxTree(span<const Box<>> boxes);
+
+  /// Returns the number of boxes that were indexed.
+  size_t size() const { return num_boxes_; }
+
+  /// Invokes `callback(i)`, in an unspecified order, for each index `i` such
+  /// that `boxes[i]` intersects `box`.
+  ///
+  /// Empty boxes never intersect any box.
+  ///
+  /// \dchecks `box.rank()` equals the rank of the indexed boxes.
+  void ForEachIntersecting(BoxView<> box,
+                           absl::FunctionRef<void(size_t)> callback) const;
+
+  /// Returns the indices of the boxes that intersect `box`, in increasing
+  /// order.
+  std::vector<size_t> FindIntersecting(BoxView<> box) const;
+
+ private:
+  struct Node {
+    /// Range of `items_` contained in this node.
+    size_t begin, end;
+    /// Index of the children within `nodes_`, or `0` for a leaf node (the
+    /// root node is never a child).
+    size_t left, right;
+  };
+
+  /// Returns the inclusive bounds (`2 * rank_` values: minimums followed by
+  /// maximums) of the given item or node.
+  const Index* item_bounds(size_t i) const {
+    return &item_bounds_[i * 2 * rank_];
+  }
+  const Index* node_bounds(size_t i) const {
+    return &node_bounds_[i * 2 * rank_];
+  }
+
+  size_t BuildNode(size_t begin, size_t end);
+
+  DimensionIndex rank_ = 0;
+  size_t num_boxes_ = 0;
+  /// Original index of each non-empty box, in tree order.
+  std::vector<size_t> items_;
+  std::vector<Index> item_bounds_;
+  std::vector<Node> nodes_;
+  std::vector<Index> node_bounds_;
+};
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_BOX_TREE_H_
@@ -0,0 +1,110 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/box_tree.h"
+
+#include <stddef.h>
+
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/random/random.h"
+#include "tensorstore/box.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_interval.h"
+
+namespace {
+
+using ::tensorstore::Box;
+using ::tensorstore::BoxView;
+using ::tensorstore::Index;
+using ::tensorstore::IndexInterval;
+using ::tensorstore::kInfIndex;
+using ::tensorstore::internal::BoxTree;
+using ::testing::ElementsAre;
+
+TEST(BoxTreeTest, Empty) {
+  BoxTree tree;
+  EXPECT_EQ(0, tree.size());
+  EXPECT_THAT(tree.FindIntersecting(BoxView({0, 0}, {10, 10})),
+              ElementsAre());
+}
+
+TEST(BoxTreeTest, Basic) {
+  std::vector<Box<>> boxes{
+      Box<>({0, 0}, {10, 10}),
+      Box<>({10, 0}, {10, 10}),
+      Box<>({0, 10}, {10, 10}),
+      Box<>({5, 5}, {0, 10}),  // Empty.
+      Box<>({5, 5}, {10, 10}),
+  };
+  BoxTree tree(boxes);
+  EXPECT_EQ(5, tree.size());
+  EXPECT_THAT(tree.FindIntersecting(BoxView({0, 0}, {1, 1})), ElementsAre(0));
+  EXPECT_THAT(tree.FindIntersecting(BoxView({9, 9}, {2, 2})),
+              ElementsAre(0, 1, 2, 4));
+  EXPECT_THAT(tree.FindIntersecting(BoxView({19, 0}, {5, 5})),
+              ElementsAre(1));
+  EXPECT_THAT(tree.FindIntersecting(BoxView({30, 30}, {5, 5})),
+              ElementsAre());
+  EXPECT_THAT(tree.FindIntersecting(BoxView({0, 0}, {0, 5})), ElementsAre());
+}
+
+TEST(BoxTreeTest, InfiniteBounds) {
+  std::vector<Box<>> boxes{
+      Box<>({-kInfIndex, 0}, {kInfIndex + 5, 10}),
+      Box<>({5, 0}, {10, 10}),
+  };
+  BoxTree tree(boxes);
+  Box<> query(2);
+  query[0] = IndexInterval::UncheckedClosed(-100, 4);
+  query[1] = IndexInterval::UncheckedClosed(-kInfIndex, kInfIndex);
+  EXPECT_THAT(tree.FindIntersecting(query), ElementsAre(0));
+}
+
+TEST(BoxTreeTest, RandomMatchesBruteForce) {
+  absl::BitGen gen;
+  constexpr size_t kNumBoxes = 2000;
+  std::vector<Box<>> boxes;
+  for (size_t i = 0; i < kNumBoxes; ++i) {
+    Box<> box(3);
+    for (int dim = 0; dim < 3; ++dim) {
+      box[dim] = IndexInterval::UncheckedSized(
+          absl::Uniform<Index>(gen, -1000, 1000),
+          absl::Uniform<Index>(gen, 0, 50));
+    }
+    boxes.push_back(box);
+  }
+  BoxTree tree(boxes);
+  for (int query_i = 0; query_i < 200; ++query_i) {
+    Box<> query(3);
+    for (int dim = 0; dim < 3; ++dim) {
+      query[dim] = IndexInterval::UncheckedSized(
+          absl::Uniform<Index>(gen, -1100, 1100),
+          absl::Uniform<Index>(gen, 0, 200));
+    }
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < kNumBoxes; ++i) {
+      bool intersects = true;
+      for (int dim = 0; dim < 3; ++dim) {
+        if (Intersect(boxes[i][dim], query[dim]).empty()) intersects = false;
+      }
+      if (intersects) expected.push_back(i);
+    }
+    EXPECT_EQ(expected, tree.FindIntersecting(query)) << query;
+  }
+}
+
+}  // namespace
@@ -40,6 +40,8 @@
 #include "tensorstore/internal/container/intrusive_red_black_tree.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/mutex.h"
+#include "tensorstore/internal/tracing/local_trace_span.h"
+#include "tensorstore/internal/tracing/operation_stats.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/transaction.h"
 #include "tensorstore/util/future.h"
@@ -135,13 +137,19 @@ void EntryOrNodeStartRead(EntryOrNode& entry_or_node,
       std::exchange(request_state.queued_time, absl::InfinitePast());
   request_state.issued = std::move(request_state.queued);
   request_state.queued_request_is_deferred = true;
+  AsyncCache::AsyncCacheReadRequest read_request;
+  read_request.staleness_bound = staleness_bound;
+  read_request.batch = batch;
+  read_request.promise = request_state.issued;
   lock.unlock();
   AcquireReadRequestReference(entry_or_node);
   ABSL_LOG_IF(INFO, TENSORSTORE_ASYNC_CACHE_DEBUG)
       << entry_or_node << "EntryOrNodeStartRead: calling DoRead";
-  AsyncCache::AsyncCacheReadRequest read_request;
-  read_request.staleness_bound = staleness_bound;
-  read_request.batch = batch;
+  // Operations started by `DoRead`, e.g. kvstore reads, are traced as
+  // children of this span.
+  internal_tracing::LocalTraceSpan trace_span(
+      "AsyncCache::Read",
+      {{"cache", static_cast<void*>(&GetOwningCache(entry_or_node))}});
   entry_or_node.DoRead(std::move(read_request));
 }
 
@@ -319,9 +327,13 @@ Future<const void> RequestRead(EntryOrNode& entry_or_node,
       options.staleness_bound = existing_time + kEpsilonDuration;
     } else {
       // `staleness_bound` satisfied by current data.
+      internal_tracing::IncrementOperationStat(
+          &internal_tracing::OperationStatsState::cache_hits);
       return MakeReadyFuture();
     }
   }
+  internal_tracing::IncrementOperationStat(
+      &internal_tracing::OperationStatsState::cache_misses);
 
   auto& request_state = entry_or_node.read_request_state_;
   // `staleness_bound` not satisfied by current data.
@@ -331,8 +343,11 @@ Future<const void> RequestRead(EntryOrNode& entry_or_node,
   if (!request_state.issued.null() &&
       request_state.issued_time >= options.staleness_bound) {
     // Another read is in progress, and `staleness_bound` will be satisfied by
-    // it when it completes.
-    return GetFuture(request_state.issued);
+    // it when it completes.  If its result is no longer needed, it may be
+    // abandoned, in which case the read is queued instead.
+    if (auto future = request_state.issued.future(); !future.null()) {
+      return future;
+    }
   }
 
   auto future = GetFuture(request_state.queued);
@@ -455,6 +470,8 @@ void ResolveIssuedWriteback(AsyncCache::TransactionNode& node,
   // Read must not be in progress.
   assert(entry.read_request_state_.issued.null());
 
+  GetOwningCache(entry).metrics().writeback_queue_size.Decrement();
+
   if (entry.committing_transaction_node_ != &node) {
     intrusive_linked_list::Remove(PendingWritebackQueueAccessor{}, &node);
   } else {
@@ -476,6 +493,17 @@ void ResolveIssuedWriteback(AsyncCache::TransactionNode& node,
   node.CommitDone();
 }
 
+// Accounts for a change in the size of the write state of `node` in the
+// writeback bytes of the cache pool, if `node` is part of an implicit
+// transaction.
+void UpdateWritebackBytes(TransactionNode& node, size_t change) {
+  auto* transaction = node.transaction();
+  if (!transaction || !transaction->implicit_transaction()) return;
+  if (auto* pool = GetOwningCache(GetOwningEntry(node)).pool()) {
+    pool->UpdateWritebackBytes(change);
+  }
+}
+
 }  // namespace
 
 const ReadState& AsyncCache::ReadState::Unknown() {
@@ -558,6 +586,7 @@ void AsyncCache::TransactionNode::PrepareForCommit() {
   auto& entry = GetOwningEntry(*this);
   UniqueWriterLock lock(entry);
   RemoveTransactionFromMap(*this);
+  GetOwningCache(entry).metrics().writeback_queue_size.Increment();
   if (entry.committing_transaction_node_) {
     // Another node is already being committed.  Add this node to the end of the
     // queue.
@@ -747,6 +776,7 @@ void AsyncCache::TransactionNode::WriterUnlock() {
   const size_t change = new_size - std::exchange(write_state_size_, new_size);
   if (change == 0) return;
   this->UpdateSizeInBytes(change);
+  UpdateWritebackBytes(*this, change);
 }
 
 bool AsyncCache::TransactionNode::try_lock() {
@@ -783,6 +813,7 @@ void AsyncCache::TransactionNode::InvalidateReadState() {
 AsyncCache::TransactionNode::~TransactionNode() {
   ABSL_LOG_IF(INFO, TENSORSTORE_ASYNC_CACHE_DEBUG)
       << *this << "~TransactionNode";
+  if (write_state_size_ != 0) UpdateWritebackBytes(*this, -write_state_size_);
   Cache::PinnedEntry(static_cast<Cache::Entry*>(associated_data()),
                      adopt_object_ref);
 }
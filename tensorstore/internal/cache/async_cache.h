@@ -332,6 +332,13 @@ class AsyncCache : public Cache {
 
     /// Batch to use.
     Batch::View batch;
+
+    /// Set by `AsyncCache` when calling `DoRead` to the promise of the issued
+    /// read request; ignored by `Read`.  `DoRead` must not resolve it, but may
+    /// register an `ExecuteWhenNotNeeded` callback that abandons the read by
+    /// calling `ReadError` with an `absl::CancelledError` once no reader needs
+    /// the result.
+    Promise<void> promise;
   };
 
   /// Base Entry class.  `Derived` classes must define a nested `Derived::Entry`
@@ -17,32 +17,53 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <bitset>
 #include <cassert>
+#include <limits>
 #include <memory>
 #include <mutex>  // NOLINT
 #include <string>
 #include <string_view>
+#include <thread>  // NOLINT
 #include <type_traits>
 #include <typeinfo>
 #include <utility>
 #include <vector>
 
 #include "absl/base/call_once.h"
+#include "absl/base/no_destructor.h"
 #include "absl/base/optimization.h"
 #include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/functional/any_invocable.h"
 #include "absl/functional/function_ref.h"
+#include "absl/hash/hash.h"
+#include "absl/log/absl_log.h"
+#include "absl/strings/str_format.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/cache/cache_metrics.h"
 #include "tensorstore/internal/cache/cache_pool_limits.h"
+#include "tensorstore/internal/cache/frequency_sketch.h"
 #include "tensorstore/internal/container/intrusive_linked_list.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/meta/type_traits.h"
 #include "tensorstore/internal/metrics/counter.h"
 #include "tensorstore/internal/metrics/metadata.h"
 #include "tensorstore/internal/mutex.h"
+#include "tensorstore/internal/os/memory_pressure.h"
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#ifndef TENSORSTORE_INTERNAL_CACHE_DEBUG_HEAP_USAGE
+#define TENSORSTORE_INTERNAL_CACHE_DEBUG_HEAP_USAGE 0
+#endif
 
 // A CacheEntry owns a strong reference to the Cache that contains it only
 // if its reference count is > 0.
@@ -74,12 +95,43 @@ inline void DebugAssertMutexHeld(absl::Mutex* mutex) {}
 using LruListAccessor =
     internal::intrusive_linked_list::MemberAccessor<LruListNode>;
 
+// Assumed average entry size, for sizing the frequency sketch of a pool with
+// the TinyLFU policy.
+constexpr size_t kTinyLfuBytesPerKey = 16384;
+
+// Fraction of the memory available to the process used as the limit of a pool
+// with `auto_total_bytes_limit`.
+constexpr double kAutoTotalBytesFraction = 0.5;
+
+namespace {
+void RegisterAutoLimitPool(CachePoolImpl* pool);
+void UnregisterAutoLimitPool(CachePoolImpl* pool);
+}  // namespace
+
 CachePoolImpl::CachePoolImpl(const CachePool::Limits& limits)
     : limits_(limits),
       total_bytes_(0),
+      total_bytes_limit_(limits.total_bytes_limit),
+      next_lru_sequence_(0),
       strong_references_(1),
       weak_references_(1) {
-  Initialize(LruListAccessor{}, &eviction_queue_);
+  for (auto& lru_shard : lru_shards_) {
+    Initialize(LruListAccessor{}, &lru_shard.eviction_queue);
+  }
+  if (limits.policy == CacheEvictionPolicy::kTinyLfu &&
+      limits.total_bytes_limit != 0) {
+    frequency_sketch_ = std::make_unique<FrequencySketch>(
+        limits.total_bytes_limit / kTinyLfuBytesPerKey);
+  }
+  if (limits.auto_total_bytes_limit && limits.total_bytes_limit != 0) {
+    RegisterAutoLimitPool(this);
+  }
+}
+
+CachePoolImpl::~CachePoolImpl() {
+  if (limits_.auto_total_bytes_limit && limits_.total_bytes_limit != 0) {
+    UnregisterAutoLimitPool(this);
+  }
 }
 
 namespace {
@@ -127,25 +179,83 @@ void UnlinkListNode(LruListNode* node) noexcept {
 
 void UnregisterEntryFromPool(CacheEntryImpl* entry,
                              CachePoolImpl* pool) noexcept {
-  DebugAssertMutexHeld(&pool->lru_mutex_);
+  DebugAssertMutexHeld(&pool->LruShardForEntry(entry).mutex);
   UnlinkListNode(entry);
+  entry->reference_count_.fetch_and(~CacheEntryImpl::kInEvictionQueue,
+                                    std::memory_order_relaxed);
   pool->total_bytes_.fetch_sub(entry->num_bytes_, std::memory_order_relaxed);
+  entry->metrics_->bytes.DecrementBy(entry->num_bytes_);
 }
 
+// Moves `entry` to the back of the eviction queue of its LRU shard.
 void AddToEvictionQueue(CachePoolImpl* pool, CacheEntryImpl* entry) noexcept {
-  DebugAssertMutexHeld(&pool->lru_mutex_);
-  auto* eviction_queue = &pool->eviction_queue_;
+  auto& lru_shard = pool->LruShardForEntry(entry);
+  DebugAssertMutexHeld(&lru_shard.mutex);
   if (!OnlyContainsNode(LruListAccessor{}, entry)) {
     Remove(LruListAccessor{}, entry);
   }
-  InsertBefore(LruListAccessor{}, eviction_queue, entry);
+  InsertBefore(LruListAccessor{}, &lru_shard.eviction_queue, entry);
+  entry->lru_sequence_ =
+      pool->next_lru_sequence_.fetch_add(1, std::memory_order_relaxed);
+  entry->accessed_.store(false, std::memory_order_relaxed);
+  entry->reference_count_.fetch_or(CacheEntryImpl::kInEvictionQueue,
+                                   std::memory_order_relaxed);
+}
+
+// Returns the hash identifying `key` of `cache` in the frequency sketch.
+uint64_t GetFrequencySketchHash(const CacheImpl* cache, std::string_view key) {
+  return absl::Hash<std::pair<const CacheImpl*, std::string_view>>{}(
+      {cache, key});
+}
+
+int GetFrequency(CachePoolImpl* pool, const CacheEntryImpl* entry) {
+  return pool->frequency_sketch_->Frequency(
+      GetFrequencySketchHash(entry->cache_, entry->key_));
+}
+
+// Adds `entry`, which has just become unused, to the eviction queue of its LRU
+// shard.
+//
+// With the TinyLFU policy, `entry` is queued at the back only if its key has
+// been accessed more often than that of the next entry to be evicted from the
+// shard; otherwise it is queued at the front, to be evicted first.
+void QueueUnusedEntry(CachePoolImpl* pool, CacheEntryImpl* entry) noexcept {
+  auto* queue = &pool->LruShardForEntry(entry).eviction_queue;
+  auto* front = queue->next;
+  AddToEvictionQueue(pool, entry);
+  if (!pool->frequency_sketch_ || front == queue) return;
+  auto* victim = static_cast<CacheEntryImpl*>(front);
+  if (GetFrequency(pool, entry) > GetFrequency(pool, victim)) return;
+  Remove(LruListAccessor{}, entry);
+  InsertBefore(LruListAccessor{}, front, entry);
+  entry->lru_sequence_ = victim->lru_sequence_;
+}
+
+// Returns the order in which queued entries are evicted, lowest first.
+//
+// This is the order in which they were queued, except that with the TinyLFU
+// policy, entries whose keys have been accessed less often come first.
+uint64_t GetEvictionPriority(CachePoolImpl* pool,
+                             const CacheEntryImpl* entry) {
+  if (!pool->frequency_sketch_) return entry->lru_sequence_;
+  constexpr int kSequenceBits = 60;
+  static_assert(FrequencySketch::kMaxFrequency < (1 << (64 - kSequenceBits)));
+  return (uint64_t(GetFrequency(pool, entry)) << kSequenceBits) |
+         (entry->lru_sequence_ & ((uint64_t{1} << kSequenceBits) - 1));
 }
 
 void DestroyCache(CachePoolImpl* pool, CacheImpl* cache);
 
+// Evicts unused entries until the total size is within the limit.
+//
+// Entries are taken from the front of the LRU shard whose front entry has the
+// lowest eviction priority, which for the LRU policy is the one queued least
+// recently, approximating a single LRU order across the shards.  Entries
+// marked as accessed get another pass through their queue rather than being
+// evicted.
+//
+// Must be called without holding any LRU shard mutex.
 void MaybeEvictEntries(CachePoolImpl* pool) noexcept {
-  DebugAssertMutexHeld(&pool->lru_mutex_);
-
   constexpr size_t kBufferSize = 64;
   std::array<CacheEntryImpl*, kBufferSize> entries_to_delete;
   // Indicates for each entry in `entries_to_delete` whether its cache should
@@ -154,7 +264,6 @@ void MaybeEvictEntries(CachePoolImpl* pool) noexcept {
   size_t num_entries_to_delete = 0;
 
   const auto destroy_entries = [&] {
-    internal::ScopedWriterUnlock unlock(pool->lru_mutex_);
     for (size_t i = 0; i < num_entries_to_delete; ++i) {
       auto* entry = entries_to_delete[i];
       if (should_delete_cache_for_entry[i]) {
@@ -164,63 +273,105 @@ void MaybeEvictEntries(CachePoolImpl* pool) noexcept {
       entry->cache_ = nullptr;
       delete Access::StaticCast<CacheEntry>(entry);
     }
+    num_entries_to_delete = 0;
   };
 
-  while (pool->total_bytes_.load(std::memory_order_acquire) >
-         pool->limits_.total_bytes_limit) {
-    auto* queue = &pool->eviction_queue_;
-    if (queue->next == queue) {
-      // Queue empty.
+  const auto over_limit = [&] {
+    return pool->total_bytes_.load(std::memory_order_acquire) >
+           pool->total_bytes_limit_.load(std::memory_order_relaxed);
+  };
+
+  while (over_limit()) {
+    // Find the shard whose front entry has the lowest eviction priority.
+    // Entries are taken from it up to the priority of the front entry of the
+    // next shard in that order.
+    CachePoolImpl::LruShard* lru_shard = nullptr;
+    uint64_t lowest_priority = std::numeric_limits<uint64_t>::max();
+    uint64_t next_lowest_priority = lowest_priority;
+    for (auto& candidate : pool->lru_shards_) {
+      absl::MutexLock lock(&candidate.mutex);
+      auto* queue = &candidate.eviction_queue;
+      if (queue->next == queue) continue;
+      uint64_t priority = GetEvictionPriority(
+          pool, static_cast<CacheEntryImpl*>(queue->next));
+      if (priority < lowest_priority) {
+        next_lowest_priority = lowest_priority;
+        lowest_priority = priority;
+        lru_shard = &candidate;
+      } else if (priority < next_lowest_priority) {
+        next_lowest_priority = priority;
+      }
+    }
+    if (!lru_shard) {
+      // All queues empty.
       break;
     }
-    auto* entry = static_cast<CacheEntryImpl*>(queue->next);
-    auto* cache = entry->cache_;
-    bool evict = false;
-    bool should_delete_cache = false;
-    auto& shard = cache->ShardForKey(entry->key_);
-    if (absl::MutexLock lock(&shard.mutex);
-        entry->reference_count_.load(std::memory_order_acquire) == 0) {
-      [[maybe_unused]] size_t erase_count = shard.entries.erase(entry);
-      assert(erase_count == 1);
-      if (shard.entries.empty()) {
-        if (DecrementCacheReferenceCount(cache,
-                                         CacheImpl::kNonEmptyShardIncrement)
-                .should_delete()) {
-          should_delete_cache = true;
+
+    {
+      absl::MutexLock lru_lock(&lru_shard->mutex);
+      auto* queue = &lru_shard->eviction_queue;
+      while (queue->next != queue &&
+             num_entries_to_delete < entries_to_delete.size() && over_limit()) {
+        auto* entry = static_cast<CacheEntryImpl*>(queue->next);
+        if (GetEvictionPriority(pool, entry) > next_lowest_priority) break;
+        if (entry->accessed_.load(std::memory_order_relaxed)) {
+          AddToEvictionQueue(pool, entry);
+          continue;
+        }
+        auto* cache = entry->cache_;
+        bool should_delete_cache = false;
+        auto& shard = cache->ShardForKey(entry->key_);
+        {
+          absl::MutexLock lock(&shard.mutex);
+          // The reference count cannot increase from zero while `shard.mutex`
+          // is held.  It may concurrently decrease to zero, though, since
+          // queued entries are released without locking.
+          auto count = entry->reference_count_.load(std::memory_order_acquire);
+          assert(count & CacheEntryImpl::kInEvictionQueue);
+          while (count != CacheEntryImpl::kInEvictionQueue &&
+                 !entry->reference_count_.compare_exchange_weak(
+                     count, count & ~CacheEntryImpl::kInEvictionQueue,
+                     std::memory_order_acq_rel)) {
+          }
+          if (count != CacheEntryImpl::kInEvictionQueue) {
+            // Entry is still in use, remove it from LRU eviction list.  For
+            // efficiency, entries aren't removed from the eviction list when
+            // the reference count increases.  It will be put back on the
+            // eviction list the next time the reference count becomes 0,
+            // which now requires the LRU shard mutex since `kInEvictionQueue`
+            // is cleared.
+            UnlinkListNode(entry);
+            continue;
+          }
+          [[maybe_unused]] size_t erase_count = shard.entries.erase(entry);
+          assert(erase_count == 1);
+          if (shard.entries.empty()) {
+            if (DecrementCacheReferenceCount(cache,
+                                             CacheImpl::kNonEmptyShardIncrement)
+                    .should_delete()) {
+              should_delete_cache = true;
+            }
+          }
         }
+        UnregisterEntryFromPool(entry, pool);
+        evict_count.Increment();
+        entry->metrics_->evict_size_limit_count.Increment();
+        // Enqueue entry to be destroyed with the LRU shard mutex released.
+        should_delete_cache_for_entry[num_entries_to_delete] =
+            should_delete_cache;
+        entries_to_delete[num_entries_to_delete++] = entry;
       }
-      evict = true;
-    }
-    if (!evict) {
-      // Entry is still in use, remove it from LRU eviction list.  For
-      // efficiency, entries aren't removed from the eviction list when the
-      // reference count increases.  It will be put back on the eviction list
-      // the next time the reference count becomes 0.  There is no race
-      // condition here because both `cache->entries_mutex_` and
-      // `pool->lru_mutex_` are held, and the reference count cannot increase
-      // from zero except while holding `cache->entries_mutex_`, and the
-      // reference count cannot decrease to zero except while holding
-      // `pool->lru_mutex_`.
-      UnlinkListNode(entry);
-      continue;
-    }
-    UnregisterEntryFromPool(entry, pool);
-    evict_count.Increment();
-    // Enqueue entry to be destroyed with `pool->lru_mutex_` released.
-    should_delete_cache_for_entry[num_entries_to_delete] = should_delete_cache;
-    entries_to_delete[num_entries_to_delete++] = entry;
-    if (num_entries_to_delete == entries_to_delete.size()) {
-      destroy_entries();
-      num_entries_to_delete = 0;
     }
+    destroy_entries();
   }
-  destroy_entries();
 }
 
 void InitializeNewEntry(CacheEntryImpl* entry, CacheImpl* cache) noexcept {
   entry->cache_ = cache;
   entry->reference_count_.store(2, std::memory_order_relaxed);
   entry->num_bytes_ = 0;
+  entry->metrics_ = cache->pool_ ? cache->metrics_ : nullptr;
+  if (entry->metrics_) entry->metrics_->entries.Increment();
   Initialize(LruListAccessor{}, entry);
 }
 
@@ -239,7 +390,9 @@ void DestroyCache(CachePoolImpl* pool,
       }
     }
     if (HasLruCache(pool)) {
-      absl::MutexLock lru_lock(&pool->lru_mutex_);
+      for (auto& lru_shard : pool->lru_shards_) {
+        lru_shard.mutex.Lock();
+      }
       for (auto& shard : cache->shards_) {
         absl::MutexLock lock(&shard.mutex);
         for (CacheEntryImpl* entry : shard.entries) {
@@ -251,6 +404,9 @@ void DestroyCache(CachePoolImpl* pool,
           UnregisterEntryFromPool(entry, pool);
         }
       }
+      for (auto& lru_shard : pool->lru_shards_) {
+        lru_shard.mutex.Unlock();
+      }
       // At this point, no external references to any entry are possible, and
       // the entries can safely be destroyed without holding any locks.
     } else {
@@ -267,8 +423,8 @@ void DestroyCache(CachePoolImpl* pool,
     for (auto& shard : cache->shards_) {
       // absl::MutexLock lock(&shard.mutex);
       for (CacheEntryImpl* entry : shard.entries) {
-        assert(entry->reference_count_.load() >= 2 &&
-               entry->reference_count_.load() <= 3);
+        assert(entry->LoadReferenceCount() >= 2 &&
+               entry->LoadReferenceCount() <= 3);
         delete Access::StaticCast<Cache::Entry>(entry);
       }
     }
@@ -333,6 +489,48 @@ inline UniqueWriterLock<absl::Mutex> DecrementReferenceCountWithLock(
   return lock;
 }
 
+// Decreases the reference count of `entry`, in a pool with an LRU cache, by
+// `decrease_amount`.
+//
+// An entry that is already in the eviction queue is released without locking
+// and stays where it is in the queue; if it becomes unused, it is marked as
+// accessed instead of being moved to the back.  Otherwise, the reference count
+// only reaches zero while holding the LRU shard mutex, and in that case a lock
+// on it is returned, to be used to add `entry` to the eviction queue.
+//
+// Sets `new_count` to the new reference count, excluding `kInEvictionQueue`.
+UniqueWriterLock<absl::Mutex> DecrementReferenceCountInLruCache(
+    CachePoolImpl* pool, CacheEntryImpl* entry, uint32_t decrease_amount,
+    uint32_t& new_count) {
+  constexpr uint32_t kInEvictionQueue = CacheEntryImpl::kInEvictionQueue;
+  {
+    auto count = entry->reference_count_.load(std::memory_order_relaxed);
+    while (count != decrease_amount) {
+      if (count == (kInEvictionQueue | decrease_amount)) {
+        // Must be marked before the reference is released, since the entry
+        // may be evicted as soon as it is unused.
+        entry->accessed_.store(true, std::memory_order_relaxed);
+      }
+      if (entry->reference_count_.compare_exchange_weak(
+              count, count - decrease_amount, std::memory_order_acq_rel)) {
+        new_count = (count - decrease_amount) & ~kInEvictionQueue;
+        return {};
+      }
+    }
+  }
+
+  UniqueWriterLock lock(pool->LruShardForEntry(entry).mutex);
+  // Reference count may have changed between the time at which we last
+  // checked it and the time at which we acquired the mutex.  It cannot have
+  // been queued, though, since that requires the reference count to reach zero.
+  auto count = entry->reference_count_.fetch_sub(decrease_amount,
+                                                 std::memory_order_acq_rel) -
+               decrease_amount;
+  new_count = count & ~kInEvictionQueue;
+  if (count != 0) return {};
+  return lock;
+}
+
 }  // namespace
 
 void StrongPtrTraitsCacheEntry::decrement_impl(
@@ -365,19 +563,23 @@ void StrongPtrTraitsCacheEntry::decrement_impl(
         // Release lock before invoking entry destructor, as that may be
         // expensive.
         lock = {};
+        entry_impl->metrics_->evict_unreferenced_count.Increment();
         delete entry_impl;
       }
     } else {
-      auto lock = DecrementReferenceCountWithLock(
-          entry_impl->reference_count_,
-          [pool_impl]() -> absl::Mutex& { return pool_impl->lru_mutex_; },
-          new_count,
-          /*decrease_amount=*/2, /*lock_threshold=*/1);
+      auto lock = DecrementReferenceCountInLruCache(pool_impl, entry_impl,
+                                                    /*decrease_amount=*/2,
+                                                    new_count);
       TENSORSTORE_INTERNAL_CACHE_DEBUG_REFCOUNT("CacheEntry:decrement",
                                                 entry_impl, new_count);
-      if (!lock) return;
+      if (new_count > 1) return;
+      if (lock) {
+        QueueUnusedEntry(pool_impl, entry_impl);
+        lock = {};
+      }
       if (new_count == 0) {
-        AddToEvictionQueue(pool_impl, entry_impl);
+        // The strong reference to `cache` released below keeps `pool_impl`
+        // valid.
         MaybeEvictEntries(pool_impl);
       }
     }
@@ -446,6 +648,7 @@ CachePtr<Cache> GetCacheInternal(
   if (!new_cache) return CachePtr<Cache>();
   auto* cache_impl = Access::StaticCast<CacheImpl>(new_cache.get());
   cache_impl->pool_ = pool;
+  cache_impl->metrics_ = &GetCacheMetrics(new_cache->DoGetMetricsLabel());
   // An empty key indicates not to store the Cache in the map.
   if (!pool || cache_key.empty()) {
     if (pool) {
@@ -497,17 +700,21 @@ PinnedCacheEntry<Cache> GetCacheEntryInternal(internal::Cache* cache,
     returned_entry = PinnedCacheEntry<Cache>(
         Access::StaticCast<CacheEntry>(entry_impl), internal::adopt_object_ref);
   } else {
+    if (auto* sketch = cache_impl->pool_->frequency_sketch_.get()) {
+      sketch->Increment(GetFrequencySketchHash(cache_impl, key));
+    }
     auto& shard = cache_impl->ShardForKey(key);
     absl::MutexLock lock(&shard.mutex);
     auto it = shard.entries.find(key);
     if (it != shard.entries.end()) {
       hit_count.Increment();
+      cache_impl->metrics_->hit_count.Increment();
       auto* entry_impl = *it;
       auto old_count =
           entry_impl->reference_count_.fetch_add(2, std::memory_order_acq_rel);
       TENSORSTORE_INTERNAL_CACHE_DEBUG_REFCOUNT("CacheEntry:increment",
                                                 entry_impl, old_count + 2);
-      if (old_count <= 1) {
+      if ((old_count & ~CacheEntryImpl::kInEvictionQueue) <= 1) {
         // When the first strong reference to an entry is acquired, also
         // acquire a strong reference to the cache to be held by the entry.
         // This ensures the Cache object is not destroyed while any of its
@@ -520,6 +727,7 @@ PinnedCacheEntry<Cache> GetCacheEntryInternal(internal::Cache* cache,
                                   internal::adopt_object_ref);
     } else {
       miss_count.Increment();
+      cache_impl->metrics_->miss_count.Increment();
       std::string temp_key(key);  // May throw, done before allocating entry.
       auto* entry_impl =
           Access::StaticCast<CacheEntryImpl>(cache->DoAllocateEntry());
@@ -550,6 +758,7 @@ PinnedCacheEntry<Cache> GetCacheEntryInternal(internal::Cache* cache,
     if (HasLruCache(cache_impl->pool_)) {
       size_t new_size = entry_impl->num_bytes_ =
           cache->DoGetSizeInBytes(returned_entry.get());
+      entry_impl->metrics_->bytes.IncrementBy(new_size);
       UpdateTotalBytes(*cache_impl->pool_, new_size);
     }
   });
@@ -571,7 +780,8 @@ void StrongPtrTraitsCache::decrement_impl(CacheImpl* cache) noexcept {
   }
 }
 
-CacheImpl::CacheImpl() : pool_(nullptr), reference_count_(0) {}
+CacheImpl::CacheImpl()
+    : pool_(nullptr), metrics_(nullptr), reference_count_(0) {}
 CacheImpl::~CacheImpl() = default;
 
 void StrongPtrTraitsCachePool::increment(CachePool* p) noexcept {
@@ -666,26 +876,36 @@ void intrusive_ptr_decrement(CacheEntryWeakState* p)
       }
     }
     entries_lock = {};
+    entry->metrics_->evict_unreferenced_count.Increment();
     delete Access::StaticCast<CacheEntry>(entry);
     if (should_delete_cache) {
       DestroyCache(pool, cache);
     }
     return;
   }
-  auto pool_lock = DecrementReferenceCountWithLock(
-      entry->reference_count_,
-      [pool]() -> absl::Mutex& { return pool->lru_mutex_; }, new_count,
-      /*decrease_amount=*/1,
-      /*lock_threshold=*/0);
+  auto lru_lock = DecrementReferenceCountInLruCache(
+      pool, entry, /*decrease_amount=*/1, new_count);
   TENSORSTORE_INTERNAL_CACHE_DEBUG_REFCOUNT("CacheEntry:decrement", entry,
                                             new_count);
-  if (!pool_lock) return;
+  if (new_count != 0) return;
 
   // There are also no remaining strong references.  Update the entry's queue
   // state if applicable.
+  if (lru_lock) {
+    QueueUnusedEntry(pool, entry);
+    lru_lock = {};
+  }
+  if (pool->total_bytes_.load(std::memory_order_acquire) <=
+      pool->total_bytes_limit_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  // While `weak_lock` is held, `entry` cannot be destroyed, and therefore
+  // neither can `pool`.  Hold a weak reference to `pool` while evicting, which
+  // may destroy `entry`.
+  AcquireWeakReference(pool);
   weak_lock = {};
-  AddToEvictionQueue(pool, entry);
   MaybeEvictEntries(pool);
+  ReleaseWeakReference(pool);
 }
 
 internal::IntrusivePtr<CacheEntryWeakState> AcquireWeakCacheEntryReference(
@@ -724,17 +944,184 @@ internal::IntrusivePtr<CacheEntryWeakState> AcquireWeakCacheEntryReference(
       weak_state, internal::adopt_object_ref);
 }
 
+namespace {
+
+// Returns the number of bytes currently allocated from the heap, as reported
+// by the allocator, or `-1` if not available.
+int64_t GetAllocatorHeapBytes() {
+#if defined(__GLIBC__) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+  const auto info = ::mallinfo2();
+  return static_cast<int64_t>(info.uordblks + info.hblkhd);
+#else
+  return -1;
+#endif
+}
+
+// Logs the bytes accounted by `pool` against those reported by the allocator,
+// each time the accounted size crosses a multiple of `kLogInterval`.  A ratio
+// well above 1 indicates that entry sizes are underestimated (or that memory
+// is held outside of caches).
+void LogHeapUsage(CachePoolImpl& pool, size_t old_total, size_t new_total) {
+  constexpr size_t kLogInterval = size_t(64) << 20;
+  if (old_total / kLogInterval == new_total / kLogInterval) return;
+  const int64_t heap_bytes = GetAllocatorHeapBytes();
+  ABSL_LOG(INFO) << "CachePool " << &pool << ": accounted=" << new_total
+                 << " bytes, limit="
+                 << pool.total_bytes_limit_.load(std::memory_order_relaxed)
+                 << " bytes, allocator in use=" << heap_bytes << " bytes"
+                 << (heap_bytes > 0 && new_total > 0
+                         ? absl::StrFormat(" (ratio %.2f)",
+                                           static_cast<double>(heap_bytes) /
+                                               new_total)
+                         : std::string());
+}
+
+}  // namespace
+
 void UpdateTotalBytes(CachePoolImpl& pool, ptrdiff_t change) {
   assert(HasLruCache(&pool));
-  if (pool.total_bytes_.fetch_add(change, std::memory_order_acq_rel) + change <=
-          pool.limits_.total_bytes_limit ||
+  const size_t old_total =
+      pool.total_bytes_.fetch_add(change, std::memory_order_acq_rel);
+  if constexpr (TENSORSTORE_INTERNAL_CACHE_DEBUG_HEAP_USAGE) {
+    LogHeapUsage(pool, old_total, old_total + change);
+  }
+  if (old_total + change <=
+          pool.total_bytes_limit_.load(std::memory_order_relaxed) ||
       change <= 0) {
     return;
   }
-  absl::MutexLock lock(&pool.lru_mutex_);
   MaybeEvictEntries(&pool);
 }
 
+void SetTotalBytesLimit(CachePoolImpl& pool, size_t limit) {
+  if (!HasLruCache(&pool)) return;
+  // A limit of 0 would disable caching rather than evict all entries.
+  limit = std::max(limit, size_t(1));
+  const size_t old_limit =
+      pool.total_bytes_limit_.exchange(limit, std::memory_order_relaxed);
+  if (limit < old_limit) MaybeEvictEntries(&pool);
+}
+
+namespace {
+
+// Interval at which pools with `auto_total_bytes_limit` are adjusted to the
+// memory pressure.
+constexpr absl::Duration kMemoryPressurePollInterval = absl::Seconds(1);
+
+// Percentage of time stalled waiting for memory above which the system is
+// considered to be under memory pressure.
+constexpr double kMemoryPressureThreshold = 10;
+
+// Under memory pressure, the limit of a pool is reduced on each poll to this
+// fraction of its current size, evicting entries, but not below
+// `kMinAutoLimitFraction` of its configured limit.  Once the pressure
+// subsides, it grows back by `kAutoLimitGrowthFraction` of its configured
+// limit on each poll.
+constexpr double kAutoLimitShrinkFactor = 0.75;
+constexpr double kMinAutoLimitFraction = 0.125;
+constexpr double kAutoLimitGrowthFraction = 0.0625;
+
+// Acquires a weak reference to `pool` unless it is being destroyed.
+bool TryAcquireWeakReference(CachePoolImpl* pool) {
+  size_t count = pool->weak_references_.load(std::memory_order_relaxed);
+  do {
+    if (count == 0) return false;
+  } while (!pool->weak_references_.compare_exchange_weak(
+      count, count + 1, std::memory_order_acq_rel));
+  return true;
+}
+
+void AdjustAutoLimit(CachePoolImpl& pool, bool under_pressure) {
+  const size_t max_limit = pool.limits_.total_bytes_limit;
+  const size_t limit = pool.total_bytes_limit_.load(std::memory_order_relaxed);
+  size_t new_limit;
+  if (under_pressure) {
+    // Shrink relative to the current size, so that entries are evicted even
+    // if the pool is well within its limit.
+    const size_t size =
+        std::min(limit, pool.total_bytes_.load(std::memory_order_relaxed));
+    new_limit =
+        std::max(static_cast<size_t>(size * kAutoLimitShrinkFactor),
+                 static_cast<size_t>(max_limit * kMinAutoLimitFraction));
+  } else {
+    new_limit = std::min(
+        max_limit,
+        limit + static_cast<size_t>(max_limit * kAutoLimitGrowthFraction));
+  }
+  if (new_limit == limit) return;
+  ABSL_LOG_IF(INFO, under_pressure)
+      << "CachePool " << &pool << ": reducing limit from " << limit << " to "
+      << new_limit << " bytes under memory pressure";
+  SetTotalBytesLimit(pool, new_limit);
+}
+
+// Adjusts the limits of the pools with `auto_total_bytes_limit` to the memory
+// pressure, from a thread that runs while there are such pools.
+class MemoryPressureMonitor {
+ public:
+  static MemoryPressureMonitor& Instance() {
+    static absl::NoDestructor<MemoryPressureMonitor> monitor;
+    return *monitor;
+  }
+
+  void Register(CachePoolImpl* pool) {
+    absl::MutexLock lock(&mutex_);
+    pools_.insert(pool);
+    if (running_) return;
+    running_ = true;
+    std::thread([this] { Run(); }).detach();
+  }
+
+  void Unregister(CachePoolImpl* pool) {
+    absl::MutexLock lock(&mutex_);
+    pools_.erase(pool);
+  }
+
+ private:
+  void Run() {
+    uint64_t limit_events = internal_os::GetMemoryPressure().limit_events;
+    while (true) {
+      absl::SleepFor(kMemoryPressurePollInterval);
+      std::vector<CachePoolImpl*> pools;
+      {
+        absl::MutexLock lock(&mutex_);
+        if (pools_.empty()) {
+          running_ = false;
+          return;
+        }
+        // The weak references keep the pools alive while they are adjusted
+        // without holding `mutex_`, which their destructors acquire.
+        for (auto* pool : pools_) {
+          if (TryAcquireWeakReference(pool)) pools.push_back(pool);
+        }
+      }
+      const auto pressure = internal_os::GetMemoryPressure();
+      const bool under_pressure =
+          pressure.some_avg10 >= kMemoryPressureThreshold ||
+          pressure.limit_events != limit_events;
+      limit_events = pressure.limit_events;
+      for (auto* pool : pools) {
+        AdjustAutoLimit(*pool, under_pressure);
+        ReleaseWeakReference(pool);
+      }
+    }
+  }
+
+  absl::Mutex mutex_;
+  absl::flat_hash_set<CachePoolImpl*> pools_ ABSL_GUARDED_BY(mutex_);
+  bool running_ ABSL_GUARDED_BY(mutex_) = false;
+};
+
+void RegisterAutoLimitPool(CachePoolImpl* pool) {
+  MemoryPressureMonitor::Instance().Register(pool);
+}
+
+void UnregisterAutoLimitPool(CachePoolImpl* pool) {
+  MemoryPressureMonitor::Instance().Unregister(pool);
+}
+
+}  // namespace
 }  // namespace internal_cache
 
 namespace internal {
@@ -742,12 +1129,15 @@ namespace internal {
 Cache::Cache() = default;
 Cache::~Cache() = default;
 
+std::string Cache::DoGetMetricsLabel() { return "other"; }
+
 size_t Cache::DoGetSizeInBytes(Cache::Entry* entry) {
   return ((internal_cache::CacheEntryImpl*)entry)->key_.capacity() +
          this->DoGetSizeofEntry();
 }
 
 CacheEntry::~CacheEntry() {
+  if (metrics_) metrics_->entries.Decrement();
   auto* weak_state = this->weak_state_.load(std::memory_order_relaxed);
   if (!weak_state) return;
   {
@@ -785,16 +1175,67 @@ void CacheEntry::WriterUnlock() {
   ptrdiff_t change = new_size - std::exchange(num_bytes_, new_size);
   lock.unlock();
 
+  metrics_->bytes.IncrementBy(change);
+
   internal_cache::UpdateTotalBytes(*pool_impl, change);
 }
 
 CachePool::StrongPtr CachePool::Make(const CachePool::Limits& cache_limits) {
+  Limits limits = cache_limits;
+  if (limits.auto_total_bytes_limit) {
+    limits.total_bytes_limit =
+        static_cast<size_t>(internal_os::GetMemoryLimit() *
+                            internal_cache::kAutoTotalBytesFraction);
+  }
   CachePool::StrongPtr pool;
   internal_cache::Access::StaticCast<internal_cache::CachePoolStrongPtr>(&pool)
-      ->reset(new internal_cache::CachePool(cache_limits), adopt_object_ref);
+      ->reset(new internal_cache::CachePool(limits), adopt_object_ref);
   return pool;
 }
 
+size_t CachePool::total_bytes_limit() const {
+  return total_bytes_limit_.load(std::memory_order_relaxed);
+}
+
+void CachePool::SetTotalBytesLimit(size_t limit) {
+  internal_cache::SetTotalBytesLimit(*this, limit);
+}
+
+size_t CachePool::writeback_bytes() {
+  absl::MutexLock lock(&writeback_mutex_);
+  return writeback_bytes_;
+}
+
+bool CachePool::writeback_limit_exceeded() {
+  if (limits_.writeback_bytes_limit == 0) return false;
+  absl::MutexLock lock(&writeback_mutex_);
+  return writeback_bytes_ > limits_.writeback_bytes_limit;
+}
+
+void CachePool::UpdateWritebackBytes(size_t change) {
+  std::vector<absl::AnyInvocable<void() &&>> waiters;
+  {
+    absl::MutexLock lock(&writeback_mutex_);
+    writeback_bytes_ += change;
+    if (writeback_bytes_ <= limits_.writeback_bytes_limit) {
+      waiters.swap(writeback_waiters_);
+    }
+  }
+  for (auto& waiter : waiters) std::move(waiter)();
+}
+
+void CachePool::WhenWritebackBelowLimit(
+    absl::AnyInvocable<void() &&> callback) {
+  if (limits_.writeback_bytes_limit != 0) {
+    absl::MutexLock lock(&writeback_mutex_);
+    if (writeback_bytes_ > limits_.writeback_bytes_limit) {
+      writeback_waiters_.push_back(std::move(callback));
+      return;
+    }
+  }
+  std::move(callback)();
+}
+
 CachePool::StrongPtr::StrongPtr(const CachePool::WeakPtr& ptr)
     : Base(ptr.get(), adopt_object_ref) {
   if (!ptr) return;
@@ -65,14 +65,17 @@
 
 #include <atomic>
 #include <memory>
+#include <string>
 #include <string_view>
 #include <type_traits>
 #include <typeinfo>
 #include <utility>
 
 #include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
 #include "absl/synchronization/mutex.h"
 #include "tensorstore/internal/cache/cache_impl.h"
+#include "tensorstore/internal/cache/cache_metrics.h"
 #include "tensorstore/internal/cache/cache_pool_limits.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 
@@ -106,6 +109,41 @@ class CachePool : private internal_cache::CachePoolImpl {
   /// Returns the limits of this cache pool.
   const Limits& limits() const { return limits_; }
 
+  /// Returns the current limit on the total size of the entries of the pool.
+  ///
+  /// This is `limits().total_bytes_limit`, unless changed by
+  /// `SetTotalBytesLimit` or, with `limits().auto_total_bytes_limit`, reduced
+  /// under memory pressure.
+  size_t total_bytes_limit() const;
+
+  /// Changes the limit on the total size of the entries of the pool, evicting
+  /// entries if it is exceeded.
+  ///
+  /// Has no effect if `limits().total_bytes_limit` is `0`, in which case
+  /// unused entries are not retained at all.
+  void SetTotalBytesLimit(size_t limit);
+
+  /// Returns the number of bytes of data modified by non-transactional writes
+  /// that has not yet been written back.
+  size_t writeback_bytes();
+
+  /// Returns `true` if `writeback_bytes()` exceeds
+  /// `limits().writeback_bytes_limit`.
+  bool writeback_limit_exceeded();
+
+  /// Adjusts `writeback_bytes()` by `change`, using modular arithmetic such
+  /// that a decrease may be specified by a negated value.
+  ///
+  /// If the limit is no longer exceeded, invokes the callbacks registered by
+  /// `WhenWritebackBelowLimit` from the current thread.
+  void UpdateWritebackBytes(size_t change);
+
+  /// Invokes `callback` once `writeback_limit_exceeded()` is `false`, either
+  /// immediately or from the thread that calls `UpdateWritebackBytes`.
+  /// Since the caller of `UpdateWritebackBytes` may hold locks, `callback`
+  /// should not perform any significant work directly.
+  void WhenWritebackBelowLimit(absl::AnyInvocable<void() &&> callback);
+
   class WeakPtr;
 
   /// Reference-counted pointer to a cache pool that keeps in-use and recently
@@ -231,7 +269,7 @@ class ABSL_LOCKABLE CacheEntry : private internal_cache::CacheEntryImpl {
   ///
   /// This is intended for testing and debugging.
   uint32_t use_count() const {
-    return reference_count_.load(std::memory_order_acquire) / 2;
+    return LoadReferenceCount(std::memory_order_acquire) / 2;
   }
 
   /// Derived classes may use this to protect changes to the "cached data",
@@ -334,6 +372,9 @@ class Cache : private internal_cache::CacheImpl {
   /// pointer to this same cache.
   std::string_view cache_identifier() const { return cache_identifier_; }
 
+  /// Returns the metrics of this cache.
+  internal_cache::CacheMetrics& metrics() const { return *metrics_; }
+
   /// Allocates a new `entry` to be stored in this cache.
   ///
   /// Usually this method can be defined as:
@@ -369,6 +410,13 @@ class Cache : private internal_cache::CacheImpl {
   /// size_t DoGetSizeofEntry() final { return sizeof(Entry); }
   virtual size_t DoGetSizeofEntry() = 0;
 
+  /// Returns the label under which the metrics of this cache are reported,
+  /// e.g. the driver and kvstore kind.
+  ///
+  /// This is called once, by `GetCache`, after the cache is created.  The
+  /// default implementation returns `"other"`.
+  virtual std::string DoGetMetricsLabel();
+
  private:
   friend class internal_cache::Access;
 };
@@ -31,15 +31,18 @@
 #include <typeindex>
 #include <typeinfo>
 #include <utility>
+#include <vector>
 
 #include "absl/base/call_once.h"
 #include "absl/base/optimization.h"
 #include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
 #include "absl/functional/function_ref.h"
 #include "absl/hash/hash.h"
 #include "absl/log/absl_log.h"
 #include "absl/synchronization/mutex.h"
 #include "tensorstore/internal/cache/cache_pool_limits.h"
+#include "tensorstore/internal/cache/frequency_sketch.h"
 #include "tensorstore/internal/container/heterogeneous_container.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 
@@ -53,6 +56,7 @@ namespace internal_cache {
 using internal::Cache;
 using internal::CacheEntry;
 using internal::CachePool;
+using internal::CacheEvictionPolicy;
 using internal::CachePoolLimits;
 
 #define TENSORSTORE_INTERNAL_CACHE_DEBUG_REFCOUNT(method, p, new_count) \
@@ -62,6 +66,7 @@ using internal::CachePoolLimits;
 class Access;
 class CacheImpl;
 class CachePoolImpl;
+struct CacheMetrics;
 
 struct LruListNode {
   LruListNode* next;
@@ -79,8 +84,8 @@ struct CacheEntryWeakState {
   // of `entry->reference_count_` is set to 1.
   std::atomic<size_t> weak_references;
 
-  // Mutex that protects access to `entry`.  If locked along with the cache
-  // pool's mutex, this mutex must be locked first.
+  // Mutex that protects access to `entry`.  If locked along with an LRU shard
+  // mutex of the cache pool, this mutex must be locked first.
   absl::Mutex mutex;
 
   // Pointer to the entry for which this is a weak reference.
@@ -121,15 +126,38 @@ class CacheEntryImpl : public internal_cache::LruListNode {
 
   // Each strong reference adds 2 to the reference count.  The least-significant
   // bit (LSB) indicates if there is at least one weak reference,
-  // `weak_state_.load()->reference_count.load() > 0`.
+  // `weak_state_.load()->reference_count.load() > 0`.  The most-significant
+  // bit is `kInEvictionQueue`.
   //
-  // When the reference count is non-zero, the entry is considered "in-use" and
-  // won't be evicted due to memory pressure.  In particular, `queue_state_` may
-  // be `clean_and_not_in_use` if, and only if, `reference_count_` is 0.
-  // Conversely, `queue_state_` may be `clean_and_in_use` if, and only if,
-  // `reference_count_` is non-zero.
+  // When the reference count (excluding `kInEvictionQueue`) is non-zero, the
+  // entry is considered "in-use" and won't be evicted due to memory pressure.
   std::atomic<uint32_t> reference_count_;
 
+  // Set in `reference_count_` while the entry is linked into the eviction
+  // queue of its LRU shard.  Only changed while holding the LRU shard mutex.
+  //
+  // Keeping it in the same atomic as the reference count allows an entry that
+  // is already queued to be released without locking: the entry stays where it
+  // is in the queue, and the evictor takes it out of the queue if it finds the
+  // entry in use.
+  constexpr static uint32_t kInEvictionQueue = uint32_t{1} << 31;
+
+  // Returns `reference_count_`, excluding `kInEvictionQueue`.
+  uint32_t LoadReferenceCount(
+      std::memory_order order = std::memory_order_seq_cst) const {
+    return reference_count_.load(order) & ~kInEvictionQueue;
+  }
+
+  // Set when the entry becomes unused while already in the eviction queue,
+  // in place of moving it to the back of the queue.  The evictor then moves it
+  // to the back instead of evicting it.
+  std::atomic<bool> accessed_{false};
+
+  // Order in which the entry was last moved to the back of the eviction queue
+  // of its LRU shard, used to choose among the shards when evicting.  Guarded
+  // by the LRU shard mutex.
+  uint64_t lru_sequence_ = 0;
+
   // Guards calls to `DoInitializeEntry`.
   absl::once_flag initialized_;
 
@@ -143,6 +171,10 @@ class CacheEntryImpl : public internal_cache::LruListNode {
   // Set if the return value of `DoGetSizeInBytes` may have changed.
   constexpr static Flags kSizeChanged = 1;
 
+  // Metrics of `cache_`, or `nullptr` if `cache_` has no pool.  Unlike
+  // `cache_`, remains valid in the destructor.
+  CacheMetrics* metrics_;
+
   // Initially set to `nullptr`.  Allocated when the first weak reference is
   // obtained, and remains until the entry is destroyed even if all weak
   // references are released.
@@ -159,6 +191,10 @@ class CacheImpl {
 
   CachePoolImpl* pool_;
 
+  /// Metrics under the label returned by `Cache::DoGetMetricsLabel`.  Set by
+  /// `GetCache`.
+  CacheMetrics* metrics_;
+
   /// Stores the pointer to `this`, cast to the `CacheType` specified in
   /// `GetCache` when this cache was created.  This pointer needs to be stored
   /// because the address may not equal `this` in the case that `CacheType` is a
@@ -218,7 +254,7 @@ class CacheImpl {
   /// If a thread causes the reference count to reach a ``ShouldDelete == true`
   /// state from a `ShouldDelete == false` state, then the thread must destroy
   /// the cache immediately. However, because of the use of multiple mutexes
-  /// (per shard mutexes on the cache entries hash table, `pool_->lru mutex_`,
+  /// (per shard mutexes on the cache entries hash table, the LRU shard mutexes,
   /// `pool_->caches_mutex_`), it is possible for another thread that is
   /// modifying `reference_count` to encounter a cache already in the
   /// `ShouldDelete == true`. In this case, the other thread is NOT responsible
@@ -267,26 +303,65 @@ class CacheImpl {
 class CachePoolImpl {
  public:
   explicit CachePoolImpl(const CachePoolLimits& limits);
+  ~CachePoolImpl();
 
   using CacheKey = CacheImpl::CacheKey;
 
   CachePoolLimits limits_;
   std::atomic<size_t> total_bytes_;
 
-  // Protects access to `eviction_queue_`.  If `lru_mutex_` is held at the same
-  // time as `caches_mutex_`, `caches_mutex_` must be acquired first.  If
-  // `lru_mutex_` is held at the same time as `entries_mutex_`, `lru_mutex_`
-  // must be acquired first.
-  absl::Mutex lru_mutex_;
+  // Limit on `total_bytes_` that entries are evicted to stay within.  Equal to
+  // `limits_.total_bytes_limit` unless changed by `SetTotalBytesLimit`, e.g.
+  // under memory pressure.  Non-zero if, and only if, `HasLruCache`.
+  std::atomic<size_t> total_bytes_limit_;
+
+  constexpr static size_t kNumLruShards = 16;
+
+  // Unused entries are queued for eviction in one of `kNumLruShards` queues,
+  // chosen by entry address, so that releasing entries of unrelated keys does
+  // not contend on a single mutex.
+  struct ABSL_CACHELINE_ALIGNED LruShard {
+    // Protects access to `eviction_queue`.  If held at the same time as
+    // `caches_mutex_`, `caches_mutex_` must be acquired first.  If held at the
+    // same time as a cache shard mutex, this must be acquired first.  Multiple
+    // LRU shard mutexes must be acquired in order of their index.
+    absl::Mutex mutex;
+
+    // next points to the front of the queue, which is the first to be evicted.
+    LruListNode eviction_queue;
+  };
+
+  LruShard lru_shards_[kNumLruShards];
+
+  // Source of `CacheEntryImpl::lru_sequence_`.
+  std::atomic<uint64_t> next_lru_sequence_;
 
-  // next points to the front of the queue, which is the first to be evicted.
-  LruListNode eviction_queue_;
+  // Access frequencies of keys, if `limits_.policy` is
+  // `CacheEvictionPolicy::kTinyLfu`.
+  std::unique_ptr<FrequencySketch> frequency_sketch_;
+
+  LruShard& LruShardForEntry(const CacheEntryImpl* entry) {
+    absl::Hash<const CacheEntryImpl*> h;
+    return lru_shards_[h(entry) % kNumLruShards];
+  }
 
   // Protects access to `caches_`.
   absl::Mutex caches_mutex_;
   internal::HeterogeneousHashSet<CacheImpl*, CacheKey, &CacheImpl::cache_key>
       caches_;
 
+  // Protects the writeback state below.
+  absl::Mutex writeback_mutex_;
+
+  // Bytes of data modified by non-transactional writes that has not yet been
+  // written back.
+  size_t writeback_bytes_ ABSL_GUARDED_BY(writeback_mutex_) = 0;
+
+  // Callbacks waiting for `writeback_bytes_` to be within
+  // `limits_.writeback_bytes_limit`.
+  std::vector<absl::AnyInvocable<void() &&>> writeback_waiters_
+      ABSL_GUARDED_BY(writeback_mutex_);
+
   /// Initial strong reference returned when the cache pool is created.
   std::atomic<size_t> strong_references_;
   /// One weak reference is kept until strong_references_ becomes 0.
@@ -397,6 +472,9 @@ inline bool HasLruCache(CachePoolImpl* pool) {
 
 void UpdateTotalBytes(CachePoolImpl& pool, ptrdiff_t change);
 
+// Sets `pool.total_bytes_limit_`, evicting entries if it is exceeded.
+void SetTotalBytesLimit(CachePoolImpl& pool, size_t limit);
+
 }  // namespace internal_cache
 }  // namespace tensorstore
 
@@ -0,0 +1,93 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/cache/cache_metrics.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "absl/base/no_destructor.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/internal/metrics/counter.h"
+#include "tensorstore/internal/metrics/gauge.h"
+#include "tensorstore/internal/metrics/metadata.h"
+
+using ::tensorstore::internal_metrics::MetricMetadata;
+
+namespace tensorstore {
+namespace internal_cache {
+namespace {
+
+auto& hit_count = CacheLookupCounter::New(
+    "/tensorstore/cache/by_cache/hit_count", "cache",
+    MetricMetadata("Number of cache hits, by cache."));
+
+auto& miss_count = CacheLookupCounter::New(
+    "/tensorstore/cache/by_cache/miss_count", "cache",
+    MetricMetadata("Number of cache misses, by cache."));
+
+auto& evict_count =
+    internal_metrics::Counter<int64_t, std::string, std::string>::New(
+        "/tensorstore/cache/by_cache/evict_count", "cache", "reason",
+        MetricMetadata("Number of evictions from the cache, by cache and "
+                       "reason."));
+
+auto& entries = internal_metrics::Gauge<int64_t, std::string>::New(
+    "/tensorstore/cache/by_cache/entries", "cache",
+    MetricMetadata("Number of entries in a cache pool, by cache."));
+
+auto& bytes = internal_metrics::Gauge<int64_t, std::string>::New(
+    "/tensorstore/cache/by_cache/bytes", "cache",
+    MetricMetadata("Bytes accounted against cache pool limits, by cache.",
+                   internal_metrics::Units::kBytes));
+
+auto& writeback_queue_size =
+    internal_metrics::Gauge<int64_t, std::string>::New(
+        "/tensorstore/cache/by_cache/writeback_queue_size", "cache",
+        MetricMetadata("Number of transaction nodes queued for or undergoing "
+                       "writeback, by cache."));
+
+struct CacheMetricsMap {
+  absl::Mutex mutex;
+  absl::flat_hash_map<std::string, std::unique_ptr<CacheMetrics>> map
+      ABSL_GUARDED_BY(mutex);
+};
+
+}  // namespace
+
+CacheMetrics& GetCacheMetrics(std::string_view label) {
+  static absl::NoDestructor<CacheMetricsMap> metrics_map;
+  absl::MutexLock lock(&metrics_map->mutex);
+  auto& metrics = metrics_map->map[label];
+  if (!metrics) {
+    metrics.reset(new CacheMetrics{
+        hit_count.GetCell(label),
+        miss_count.GetCell(label),
+        evict_count.GetCell(label, "size_limit"),
+        evict_count.GetCell(label, "unreferenced"),
+        entries.GetCell(label),
+        bytes.GetCell(label),
+        writeback_queue_size.GetCell(label),
+    });
+  }
+  return *metrics;
+}
+
+}  // namespace internal_cache
+}  // namespace tensorstore
@@ -0,0 +1,77 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_CACHE_CACHE_METRICS_H_
+#define TENSORSTORE_INTERNAL_CACHE_CACHE_METRICS_H_
+
+/// \file
+///
+/// Metrics of caches, labeled by the kind of cache.
+///
+/// Each cache reports its metrics under the label returned by
+/// `Cache::DoGetMetricsLabel`, such as `"zarr3/file"` for the chunk cache of a
+/// zarr3 array stored on the local filesystem.  The average size of an entry
+/// may be computed as `bytes / entries`.
+
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+
+#include "tensorstore/internal/metrics/counter.h"
+#include "tensorstore/internal/metrics/gauge.h"
+#include "tensorstore/internal/metrics/metric_impl.h"
+
+namespace tensorstore {
+namespace internal_cache {
+
+/// Counter updated on every cache lookup, sharded over threads to avoid
+/// contention between concurrent lookups in the same cache.
+using CacheLookupCounter =
+    internal_metrics::Counter<internal_metrics::Sharded<int64_t>, std::string>;
+
+/// Metric cells for a single cache label.
+struct CacheMetrics {
+  /// Lookups of an existing entry.
+  CacheLookupCounter::Cell& hit_count;
+
+  /// Lookups that allocated a new entry.
+  CacheLookupCounter::Cell& miss_count;
+
+  /// Entries evicted because the pool exceeded its size limit.
+  internal_metrics::CounterCell<int64_t>& evict_size_limit_count;
+
+  /// Entries destroyed as soon as they became unreferenced, because the pool
+  /// retains no unreferenced entries.
+  internal_metrics::CounterCell<int64_t>& evict_unreferenced_count;
+
+  /// Entries that currently exist in a cache pool.
+  internal_metrics::GaugeCell<int64_t>& entries;
+
+  /// Bytes accounted against the limit of a cache pool.
+  internal_metrics::GaugeCell<int64_t>& bytes;
+
+  /// Transaction nodes queued for or undergoing writeback.
+  internal_metrics::GaugeCell<int64_t>& writeback_queue_size;
+};
+
+/// Returns the metrics for `label`.
+///
+/// The returned reference remains valid for the lifetime of the program.
+CacheMetrics& GetCacheMetrics(std::string_view label);
+
+}  // namespace internal_cache
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_CACHE_CACHE_METRICS_H_
@@ -20,12 +20,38 @@
 namespace tensorstore {
 namespace internal {
 
+/// Policy for choosing which unused entries of a cache pool to evict.
+enum class CacheEvictionPolicy {
+  /// Evicts the least recently used entries first.
+  kLru,
+  /// Like `kLru`, but takes into account how often each key has been accessed
+  /// recently, including before it was last evicted.  Entries that are used
+  /// less often than the entries next in line for eviction are evicted before
+  /// them, so that keys that are only read once, as by a large sequential
+  /// scan, do not displace frequently used entries.
+  kTinyLfu,
+};
+
 /// Memory limit parameters for a cache pool.
 struct CachePoolLimits {
   size_t total_bytes_limit = 0;
+  CacheEvictionPolicy policy = CacheEvictionPolicy::kLru;
+
+  /// If `true`, `total_bytes_limit` is instead set by `CachePool::Make` to a
+  /// fraction of the memory available to the process, as determined by its
+  /// cgroup memory limit or else the physical memory of the machine.  While
+  /// the system reports memory pressure, the pool is then shrunk below that
+  /// limit, evicting entries, and grown back once the pressure subsides.
+  bool auto_total_bytes_limit = false;
+
+  /// Limit on the number of bytes of data modified by non-transactional writes
+  /// that has not yet been written back.  New non-transactional writes are
+  /// deferred while the limit is exceeded.  A value of `0` indicates no limit.
+  size_t writeback_bytes_limit = 0;
 
   constexpr static auto ApplyMembers = [](auto&& x, auto f) {
-    return f(x.total_bytes_limit);
+    return f(x.total_bytes_limit, x.policy, x.writeback_bytes_limit,
+             x.auto_total_bytes_limit);
   };
 };
 
@@ -14,12 +14,17 @@
 
 #include "tensorstore/internal/cache/cache_pool_resource.h"
 
+#include <string>
+#include <string_view>
+
 #include <nlohmann/json.hpp>
+#include "absl/status/status.h"
 #include "tensorstore/context.h"
 #include "tensorstore/context_resource_provider.h"
 #include "tensorstore/internal/cache/cache.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/internal/json_binding/enum.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
 #include "tensorstore/util/result.h"
 
@@ -27,16 +32,59 @@ namespace tensorstore {
 namespace internal {
 namespace {
 
+namespace jb = tensorstore::internal_json_binding;
+
+constexpr auto EvictionPolicyJsonBinder = [](auto is_loading,
+                                             const auto& options, auto* obj,
+                                             auto* j) {
+  // This is defined as a lambda that forwards to the function returned by
+  // `jb::Enum` to workaround a constexpr issue on MSVC 14.35.
+  return jb::Enum<CacheEvictionPolicy, std::string_view>({
+      {CacheEvictionPolicy::kLru, "lru"},
+      {CacheEvictionPolicy::kTinyLfu, "tinylfu"},
+  })(is_loading, options, obj, j);
+};
+
+// Binds `total_bytes_limit` to either an integer or `"auto"`, which sets
+// `auto_total_bytes_limit`.
+constexpr auto TotalBytesLimitJsonBinder = [](auto is_loading,
+                                              const auto& options, auto* obj,
+                                              auto* j) -> absl::Status {
+  using Spec = CachePool::Limits;
+  if constexpr (is_loading) {
+    if (j->is_string() && j->template get_ref<const std::string&>() ==
+                              "auto") {
+      obj->auto_total_bytes_limit = true;
+      obj->total_bytes_limit = 0;
+      return absl::OkStatus();
+    }
+    obj->auto_total_bytes_limit = false;
+  } else if (obj->auto_total_bytes_limit) {
+    *j = "auto";
+    return absl::OkStatus();
+  }
+  return jb::Projection(&Spec::total_bytes_limit,
+                        jb::DefaultValue([](auto* v) { *v = 0; }))(
+      is_loading, options, obj, j);
+};
+
 struct CachePoolResourceTraits
     : public ContextResourceTraits<CachePoolResource> {
   using Spec = CachePool::Limits;
   using Resource = typename CachePoolResource::Resource;
   static constexpr Spec Default() { return {}; }
   static constexpr auto JsonBinder() {
-    namespace jb = tensorstore::internal_json_binding;
     return jb::Object(
-        jb::Member("total_bytes_limit",
-                   jb::Projection(&Spec::total_bytes_limit,
+        jb::Member("total_bytes_limit", TotalBytesLimitJsonBinder),
+        jb::Member("policy",
+                   jb::Projection(&Spec::policy,
+                                  jb::DefaultValue(
+                                      [](auto* v) {
+                                        *v = CacheEvictionPolicy::kLru;
+                                      },
+                                      EvictionPolicyJsonBinder))),
+        jb::Member("writeback_bytes_limit",
+                   jb::Projection(&Spec::writeback_bytes_limit,
                                   jb::DefaultValue([](auto* v) { *v = 0; }))));
   }
   static Result<Resource> Create(const Spec& limits,
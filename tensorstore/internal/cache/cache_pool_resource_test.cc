@@ -28,6 +28,7 @@ namespace {
 
 using ::tensorstore::Context;
 using ::tensorstore::MatchesStatus;
+using ::tensorstore::internal::CacheEvictionPolicy;
 using ::tensorstore::internal::CachePoolResource;
 
 TEST(CachePoolResourceTest, Default) {
@@ -50,6 +51,51 @@ TEST(CachePoolResourceTest, TotalBytesLimitOnly) {
                               {{"total_bytes_limit", 100}}));
   auto cache = Context::Default().GetResource(resource_spec).value();
   EXPECT_EQ(100u, (*cache)->limits().total_bytes_limit);
+  EXPECT_EQ(CacheEvictionPolicy::kLru, (*cache)->limits().policy);
+}
+
+TEST(CachePoolResourceTest, Policy) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto resource_spec,
+      Context::Resource<CachePoolResource>::FromJson(
+          {{"total_bytes_limit", 100}, {"policy", "tinylfu"}}));
+  EXPECT_THAT(resource_spec.ToJson(),
+              ::testing::Optional(::nlohmann::json(
+                  {{"total_bytes_limit", 100}, {"policy", "tinylfu"}})));
+  auto cache = Context::Default().GetResource(resource_spec).value();
+  EXPECT_EQ(CacheEvictionPolicy::kTinyLfu, (*cache)->limits().policy);
+}
+
+TEST(CachePoolResourceTest, WritebackBytesLimit) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto resource_spec,
+      Context::Resource<CachePoolResource>::FromJson(
+          {{"total_bytes_limit", 100}, {"writeback_bytes_limit", 50}}));
+  EXPECT_THAT(resource_spec.ToJson(),
+              ::testing::Optional(::nlohmann::json(
+                  {{"total_bytes_limit", 100}, {"writeback_bytes_limit", 50}})));
+  auto cache = Context::Default().GetResource(resource_spec).value();
+  EXPECT_EQ(50u, (*cache)->limits().writeback_bytes_limit);
+}
+
+TEST(CachePoolResourceTest, AutoTotalBytesLimit) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto resource_spec, Context::Resource<CachePoolResource>::FromJson(
+                              {{"total_bytes_limit", "auto"}}));
+  EXPECT_THAT(resource_spec.ToJson(),
+              ::testing::Optional(
+                  ::nlohmann::json({{"total_bytes_limit", "auto"}})));
+  auto cache = Context::Default().GetResource(resource_spec).value();
+  EXPECT_TRUE((*cache)->limits().auto_total_bytes_limit);
+  EXPECT_LE((*cache)->total_bytes_limit(),
+            (*cache)->limits().total_bytes_limit);
+}
+
+TEST(CachePoolResourceTest, InvalidPolicy) {
+  EXPECT_THAT(Context::Resource<CachePoolResource>::FromJson(
+                  {{"total_bytes_limit", 100}, {"policy", "mru"}}),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            "Error parsing object member \"policy\": .*"));
 }
 
 }  // namespace
@@ -22,12 +22,14 @@
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/synchronization/mutex.h"
+#include "tensorstore/internal/cache/cache_metrics.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/mutex.h"
 #include "tensorstore/internal/testing/concurrent.h"
@@ -36,6 +38,7 @@ namespace {
 
 using ::tensorstore::UniqueWriterLock;
 using ::tensorstore::internal::Cache;
+using ::tensorstore::internal::CacheEvictionPolicy;
 using ::tensorstore::internal::CachePool;
 using ::tensorstore::internal::CachePtr;
 using ::tensorstore::internal::GetCache;
@@ -44,6 +47,7 @@ using ::tensorstore::internal::WeakPinnedCacheEntry;
 using ::tensorstore::internal_cache::Access;
 using ::tensorstore::internal_cache::CacheEntryImpl;
 using ::tensorstore::internal_cache::CacheImpl;
+using ::tensorstore::internal_cache::CacheMetrics;
 using ::tensorstore::internal_cache::CachePoolImpl;
 using ::tensorstore::internal_cache::LruListNode;
 using ::tensorstore::internal_testing::TestConcurrent;
@@ -149,11 +153,19 @@ std::pair<std::string, void*> GetEntryIdentifier(CacheEntryImpl* entry) {
   return {entry->key_, entry};
 }
 
-absl::flat_hash_set<EntryIdentifier> GetEntrySet(LruListNode* head) {
+// Returns the entries in the eviction queues of all LRU shards of `pool`.
+absl::flat_hash_set<EntryIdentifier> GetEvictionQueueEntrySet(
+    CachePoolImpl* pool) {
   absl::flat_hash_set<EntryIdentifier> entries;
-  for (LruListNode* node = head->next; node != head; node = node->next) {
-    entries.emplace(
-        GetEntryIdentifier(Access::StaticCast<CacheEntryImpl>(node)));
+  for (auto& lru_shard : pool->lru_shards_) {
+    LruListNode* head = &lru_shard.eviction_queue;
+    for (LruListNode* node = head->next; node != head; node = node->next) {
+      auto* entry = Access::StaticCast<CacheEntryImpl>(node);
+      EXPECT_EQ(&lru_shard, &pool->LruShardForEntry(entry));
+      EXPECT_TRUE(entry->reference_count_.load() &
+                  CacheEntryImpl::kInEvictionQueue);
+      entries.emplace(GetEntryIdentifier(entry));
+    }
   }
   return entries;
 }
@@ -163,7 +175,7 @@ void AssertInvariants(const CachePool::StrongPtr& pool,
                       absl::flat_hash_set<Cache*> expected_caches)
     ABSL_NO_THREAD_SAFETY_ANALYSIS {
   auto* pool_impl = GetPoolImpl(pool);
-  auto eviction_queue_entries = GetEntrySet(&pool_impl->eviction_queue_);
+  auto eviction_queue_entries = GetEvictionQueueEntrySet(pool_impl);
 
   absl::flat_hash_set<EntryIdentifier> expected_eviction_queue_entries;
 
@@ -194,7 +206,7 @@ void AssertInvariants(const CachePool::StrongPtr& pool,
               entry->num_bytes_,
               cache->DoGetSizeInBytes(Access::StaticCast<Cache::Entry>(entry)));
           expected_total_bytes += entry->num_bytes_;
-          if (entry->reference_count_.load() == 0) {
+          if (entry->LoadReferenceCount() == 0) {
             expected_eviction_queue_entries.emplace(GetEntryIdentifier(entry));
           }
         }
@@ -597,6 +609,77 @@ TEST_P(NamedOrAnonymousCacheTest, UpdateSizeNoEvict) {
               UnorderedElementsAre(Pair(cache_key, "a")));  // No change
 }
 
+// Tests that an entry that is used again while in the eviction queue is
+// evicted after entries that were not, even though it is not moved within the
+// queue when released.
+TEST_P(NamedOrAnonymousCacheTest, ReuseQueuedEntryDefersEviction) {
+  CachePool::Limits limits;
+  limits.total_bytes_limit = 10000;
+  auto pool = CachePool::Make(limits);
+  auto test_cache = GetCache(pool);
+  for (const char* key : {"a", "b"}) {
+    auto entry = GetCacheEntry(test_cache, key);
+    entry->data = key;
+    entry->ChangeSize(4000);
+  }
+  // "a" is still queued ahead of "b".
+  EXPECT_EQ("a", GetCacheEntry(test_cache, "a")->data);
+  TENSORSTORE_INTERNAL_ASSERT_CACHE_INVARIANTS(pool, {test_cache.get()});
+  {
+    auto entry = GetCacheEntry(test_cache, "c");
+    entry->data = "c";
+    entry->ChangeSize(4000);
+  }
+  EXPECT_THAT(log->entry_destroy_log, ElementsAre(Pair(cache_key, "b")));
+  TENSORSTORE_INTERNAL_ASSERT_CACHE_INVARIANTS(pool, {test_cache.get()});
+  EXPECT_EQ("a", GetCacheEntry(test_cache, "a")->data);
+  EXPECT_EQ("c", GetCacheEntry(test_cache, "c")->data);
+}
+
+// Reads "a" and "b" several times each, then 20 other keys once each, in a pool
+// with room for 3 entries.  Returns the keys of the destroyed entries.
+std::vector<std::string> GetEvictedKeysAfterScan(CacheEvictionPolicy policy) {
+  auto log = std::make_shared<TestCache::RequestLog>();
+  CachePool::Limits limits;
+  limits.total_bytes_limit = 10000;
+  limits.policy = policy;
+  auto pool = CachePool::Make(limits);
+  auto cache = GetTestCache(pool.get(), "cache", log);
+  const auto read = [&](std::string_view key) {
+    auto entry = GetCacheEntry(cache, key);
+    if (entry->data.empty()) {
+      entry->data = std::string(key);
+      entry->ChangeSize(3000);
+    }
+  };
+  for (int i = 0; i < 5; ++i) {
+    read("a");
+    read("b");
+  }
+  for (int i = 0; i < 20; ++i) {
+    read("scan" + std::to_string(i));
+  }
+  TENSORSTORE_INTERNAL_ASSERT_CACHE_INVARIANTS(pool, {cache.get()});
+  std::vector<std::string> evicted_keys;
+  absl::MutexLock lock(&log->mutex);
+  for (const auto& [cache_key, key] : log->entry_destroy_log) {
+    evicted_keys.push_back(key);
+  }
+  return evicted_keys;
+}
+
+TEST(CacheTest, LruScanEvictsFrequentEntries) {
+  EXPECT_THAT(GetEvictedKeysAfterScan(CacheEvictionPolicy::kLru),
+              ::testing::IsSupersetOf({"a", "b"}));
+}
+
+TEST(CacheTest, TinyLfuScanDoesNotEvictFrequentEntries) {
+  auto evicted_keys = GetEvictedKeysAfterScan(CacheEvictionPolicy::kTinyLfu);
+  EXPECT_THAT(evicted_keys, ::testing::Not(::testing::Contains("a")));
+  EXPECT_THAT(evicted_keys, ::testing::Not(::testing::Contains("b")));
+  EXPECT_EQ(19, evicted_keys.size());
+}
+
 // Tests that having one cache hold a strong pointer to another cache does not
 // lead to a circular reference and memory leak (the actual test is done by the
 // heap leak checker or sanitizer).
@@ -817,6 +900,34 @@ TEST(CacheTest, ConcurrentGetReleaseCacheEntry) {
       concurrent_op, concurrent_op, concurrent_op);
 }
 
+TEST(CacheTest, ConcurrentGetReleaseCacheEntriesWithEviction) {
+  CachePool::Limits limits = {};
+  limits.total_bytes_limit = 3000;
+  auto pool = CachePool::Make(limits);
+  auto cache = GetTestCache(pool.get(), "cache");
+  const auto concurrent_op = [&](std::string_view key) {
+    return [&, key] {
+      for (int i = 0; i < 4; ++i) {
+        auto entry = GetCacheEntry(cache, key);
+        entry->ChangeSize(1000);
+        auto other_entry = GetCacheEntry(cache, "shared");
+      }
+    };
+  };
+  TestConcurrent(
+      kDefaultIterations,
+      /*initialize=*/
+      [&] {},
+      /*finalize=*/
+      [&] {
+        TENSORSTORE_INTERNAL_ASSERT_CACHE_INVARIANTS(pool, {cache.get()});
+        EXPECT_LE(GetPoolImpl(pool)->total_bytes_.load(),
+                  limits.total_bytes_limit);
+      },
+      // Concurrent operations:
+      concurrent_op("a"), concurrent_op("b"), concurrent_op("c"));
+}
+
 TEST(CacheTest, ConcurrentDestroyCacheEvictEntries) {
   CachePool::Limits limits = {};
   limits.total_bytes_limit = 1;
@@ -1127,4 +1238,82 @@ TEST(CacheTest, WeakRefOwnedByEntry) {
                                    Pair("cache2", "c")));
 }
 
+class MetricsTestCache : public Cache {
+ public:
+  class Entry : public Cache::Entry {
+   public:
+    using OwningCache = MetricsTestCache;
+    size_t size = 0;
+  };
+
+  explicit MetricsTestCache(std::string label) : label_(std::move(label)) {}
+
+  Entry* DoAllocateEntry() final { return new Entry; }
+  size_t DoGetSizeofEntry() final { return sizeof(Entry); }
+  size_t DoGetSizeInBytes(Cache::Entry* entry) final {
+    return static_cast<Entry*>(entry)->size;
+  }
+  std::string DoGetMetricsLabel() final { return label_; }
+
+ private:
+  std::string label_;
+};
+
+TEST(CacheTest, MetricsByLabel) {
+#ifdef TENSORSTORE_METRICS_DISABLED
+  GTEST_SKIP() << "metrics disabled";
+#endif
+  CacheMetrics& metrics = tensorstore::internal_cache::GetCacheMetrics(
+      "cache_test/metrics_by_label");
+  auto pool = CachePool::Make(CachePool::Limits{1000});
+  auto cache = GetCache<MetricsTestCache>(pool.get(), "", [] {
+    return std::make_unique<MetricsTestCache>("cache_test/metrics_by_label");
+  });
+  EXPECT_EQ(&metrics, &cache->metrics());
+  {
+    auto entry = GetCacheEntry(cache, "a");
+    UniqueWriterLock lock(*entry);
+    entry->size = 600;
+    entry->NotifySizeChanged();
+  }
+  GetCacheEntry(cache, "a");
+  EXPECT_EQ(1, metrics.hit_count.Get());
+  EXPECT_EQ(1, metrics.miss_count.Get());
+  EXPECT_EQ(1, metrics.entries.Get());
+  EXPECT_EQ(600, metrics.bytes.Get());
+  {
+    auto entry = GetCacheEntry(cache, "b");
+    UniqueWriterLock lock(*entry);
+    entry->size = 600;
+    entry->NotifySizeChanged();
+  }
+  // Entry "a" was evicted to stay within the limit.
+  EXPECT_EQ(1, metrics.evict_size_limit_count.Get());
+  EXPECT_EQ(1, metrics.entries.Get());
+  EXPECT_EQ(600, metrics.bytes.Get());
+  cache = {};
+  pool = {};
+  EXPECT_EQ(0, metrics.entries.Get());
+  EXPECT_EQ(0, metrics.bytes.Get());
+}
+
+TEST(CacheTest, MetricsUnreferenced) {
+#ifdef TENSORSTORE_METRICS_DISABLED
+  GTEST_SKIP() << "metrics disabled";
+#endif
+  CacheMetrics& metrics = tensorstore::internal_cache::GetCacheMetrics(
+      "cache_test/metrics_unreferenced");
+  auto pool = CachePool::Make(CachePool::Limits{});
+  auto cache = GetCache<MetricsTestCache>(pool.get(), "", [] {
+    return std::make_unique<MetricsTestCache>(
+        "cache_test/metrics_unreferenced");
+  });
+  {
+    auto entry = GetCacheEntry(cache, "a");
+    EXPECT_EQ(1, metrics.entries.Get());
+  }
+  EXPECT_EQ(1, metrics.evict_unreferenced_count.Get());
+  EXPECT_EQ(0, metrics.entries.Get());
+}
+
 }  // namespace
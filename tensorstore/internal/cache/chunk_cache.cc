@@ -17,6 +17,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <memory>
@@ -28,6 +29,8 @@
 #include "absl/base/thread_annotations.h"
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "tensorstore/array.h"
 #include "tensorstore/box.h"
 #include "tensorstore/driver/chunk.h"
@@ -39,6 +42,7 @@
 #include "tensorstore/internal/async_write_array.h"
 #include "tensorstore/internal/cache/async_cache.h"
 #include "tensorstore/internal/cache/cache.h"
+#include "tensorstore/internal/cache/chunk_prefetcher.h"
 #include "tensorstore/internal/chunk_grid_specification.h"
 #include "tensorstore/internal/grid_partition_iterator.h"
 #include "tensorstore/internal/intrusive_ptr.h"
@@ -48,7 +52,10 @@
 #include "tensorstore/internal/metrics/metadata.h"
 #include "tensorstore/internal/mutex.h"
 #include "tensorstore/internal/nditerable.h"
+#include "tensorstore/internal/os/memory_region.h"
+#include "tensorstore/internal/os/numa.h"
 #include "tensorstore/internal/regular_grid.h"
+#include "tensorstore/internal/thread/schedule_at.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/rank.h"
 #include "tensorstore/read_write_options.h"
@@ -56,6 +63,7 @@
 #include "tensorstore/util/execution/execution.h"
 #include "tensorstore/util/executor.h"
 #include "tensorstore/util/future.h"
+#include "tensorstore/util/iterate_over_index_range.h"
 #include "tensorstore/util/result.h"
 #include "tensorstore/util/span.h"
 #include "tensorstore/util/status.h"
@@ -76,9 +84,16 @@ auto& num_writes = internal_metrics::Counter<int64_t>::New(
 auto& num_reads = internal_metrics::Counter<int64_t>::New(
     "/tensorstore/cache/chunk_cache/reads",
     MetricMetadata("Number of reads from ChunkCache."));
+auto& num_prefetches = internal_metrics::Counter<int64_t>::New(
+    "/tensorstore/cache/chunk_cache/prefetches",
+    MetricMetadata("Number of chunks prefetched by ChunkCache."));
 
 namespace {
 
+/// Size counted against the cache pool for a component array that views a
+/// memory-mapped file.
+constexpr size_t kMappedComponentSizeInBytes = 4096;
+
 /// Returns `true` if all components of `node` have been fully overwritten.
 ///
 /// \param node Non-null pointer to transaction node.
@@ -98,6 +113,52 @@ bool IsFullyOverwritten(ChunkCache::TransactionNode& node) {
   return true;
 }
 
+/// Returns the implicit transaction to use for a non-transactional write to
+/// `entry` when write combining is enabled.
+///
+/// Joins the existing write-combining transaction of `entry` if its commit has
+/// not yet started, and otherwise creates a new one that is committed once
+/// `options.window` elapses.
+OpenTransactionPtr GetWriteCombiningTransaction(
+    ChunkCache::Entry& entry, const ChunkWriteCombiningOptions& options) {
+  TransactionState::WeakPtr existing;
+  {
+    UniqueWriterLock lock(entry);
+    existing = entry.write_combining_transaction;
+  }
+  if (existing) {
+    if (auto transaction = existing->AcquireImplicitOpenPtr()) {
+      return transaction;
+    }
+  }
+  auto transaction = TransactionState::MakeImplicit();
+  {
+    UniqueWriterLock lock(entry);
+    entry.write_combining_transaction =
+        TransactionState::WeakPtr(transaction.get());
+  }
+  // The `CommitPtr` prevents the transaction from being aborted if the
+  // `commit_future` of every write is released before the window elapses.
+  ScheduleAt(absl::Now() + options.window,
+             [executor = GetOwningCache(entry).executor(),
+              commit = TransactionState::CommitPtr(transaction.get())] {
+               executor([commit] { commit->RequestCommit(); });
+             });
+  return transaction;
+}
+
+/// Returns `true` if `transaction` is the current write-combining transaction
+/// of `entry`.
+bool IsWriteCombiningTransaction(ChunkCache::Entry& entry,
+                                 TransactionState& transaction) {
+  if (GetOwningCache(entry).write_combining_options().window <=
+      absl::ZeroDuration()) {
+    return false;
+  }
+  UniqueWriterLock lock(entry);
+  return entry.write_combining_transaction.get() == &transaction;
+}
+
 /// TensorStore Driver ReadChunk implementation for the chunk cache, for the
 /// case of a non-transactional read.
 ///
@@ -362,6 +423,13 @@ struct WriteChunkImpl {
     node->is_modified = true;
     if (IsFullyOverwritten(*node)) {
       node->SetUnconditional();
+      // Writeback no longer requires a read, so there is no reason to defer
+      // it further to combine writes.  Only applies to the write-combining
+      // transaction of `entry`; other implicit transactions are committed as
+      // usual.
+      if (IsWriteCombiningTransaction(entry, *node->transaction())) {
+        node->transaction()->RequestCommit();
+      }
     }
     return {node->OnModified(), node->transaction()->future()};
   }
@@ -427,6 +495,15 @@ void ChunkCache::Read(ReadRequest request, ReadChunkReceiver receiver) {
   auto state = MakeIntrusivePtr<ReadOperationState>(std::move(receiver));
   internal_grid_partition::RegularGridRef regular_grid{grid().chunk_shape};
 
+  // Bounding box of the grid cells read, for detecting access patterns.
+  const bool prefetch = prefetcher_ && !request.transaction;
+  Box<dynamic_rank(kMaxRank)> cells;
+  if (prefetch) {
+    cells.set_rank(grid().grid_rank());
+    std::fill(cells.origin().begin(), cells.origin().end(), kMaxFiniteIndex);
+    std::fill(cells.shape().begin(), cells.shape().end(), 0);
+  }
+
   auto status = [&]() -> absl::Status {
     internal_grid_partition::PartitionIndexTransformIterator iterator(
         component_spec.chunked_to_cell_dimensions, regular_grid,
@@ -438,11 +515,25 @@ void ChunkCache::Read(ReadRequest request, ReadChunkReceiver receiver) {
         return absl::CancelledError("");
       }
       num_reads.Increment();
-      TENSORSTORE_ASSIGN_OR_RETURN(
-          auto cell_to_source,
-          ComposeTransforms(request.transform, iterator.cell_transform()));
+      if (prefetch) {
+        auto cell_indices = iterator.output_grid_cell_indices();
+        for (DimensionIndex i = 0; i < cells.rank(); ++i) {
+          const Index inclusive_max =
+              cells.shape()[i] == 0 ? cell_indices[i]
+                                    : std::max(cells[i].inclusive_max(),
+                                               cell_indices[i]);
+          const Index inclusive_min =
+              std::min(cells.origin()[i], cell_indices[i]);
+          cells.origin()[i] = inclusive_min;
+          cells.shape()[i] = inclusive_max - inclusive_min + 1;
+        }
+      }
+      TENSORSTORE_ASSIGN_OR_RETURN(auto cell_to_source,
+                                   iterator.GetCellToOutputTransform());
       auto entry =
           GetEntryForGridCell(*this, iterator.output_grid_cell_indices());
+      // Remains valid while `chunk` holds a reference to the entry.
+      Entry* entry_ptr = entry.get();
       // Arrange to call `set_value` on the receiver with a `ReadChunk`
       // corresponding to this grid cell once the read request completes
       // successfully.
@@ -452,6 +543,11 @@ void ChunkCache::Read(ReadRequest request, ReadChunkReceiver receiver) {
       const auto get_cache_read_request = [&] {
         AsyncCache::AsyncCacheReadRequest cache_request;
         cache_request.staleness_bound = request.staleness_bound;
+        if (!request.transaction &&
+            request.missing_staleness_bound < request.staleness_bound &&
+            entry->IsKnownMissing(request.missing_staleness_bound)) {
+          cache_request.staleness_bound = request.missing_staleness_bound;
+        }
         cache_request.batch = request.batch;
         return cache_request;
       };
@@ -471,8 +567,13 @@ void ChunkCache::Read(ReadRequest request, ReadChunkReceiver receiver) {
       }
       LinkValue(
           [state, chunk = std::move(chunk),
-           cell_transform = IndexTransform<>(iterator.cell_transform())](
-              Promise<void> promise, ReadyFuture<const void> future) mutable {
+           cell_transform = IndexTransform<>(iterator.cell_transform()),
+           entry_ptr](Promise<void> promise,
+                      ReadyFuture<const void> future) mutable {
+            // Prefer that the receiver copies the chunk on the NUMA node that
+            // holds its data.
+            internal_os::ScopedPreferredNumaNode numa_scope(
+                entry_ptr->numa_node.load(std::memory_order_relaxed));
             execution::set_value(state->shared_receiver->receiver,
                                  std::move(chunk), std::move(cell_transform));
           },
@@ -483,12 +584,74 @@ void ChunkCache::Read(ReadRequest request, ReadChunkReceiver receiver) {
   }();
   if (!status.ok()) {
     state->SetError(std::move(status));
+    return;
+  }
+  if (prefetch && !cells.is_empty()) {
+    Prefetch(cells, request.staleness_bound);
+  }
+}
+
+void ChunkCache::SetPrefetchOptions(ChunkPrefetchOptions options) {
+  if (options.depth <= 0) {
+    prefetcher_ = nullptr;
+    return;
+  }
+  prefetcher_ = std::make_unique<ChunkPrefetcher>(options);
+}
+
+void ChunkCache::Prefetch(BoxView<> cells, absl::Time staleness_bound) {
+  auto boxes = prefetcher_->RecordRead(cells);
+  if (boxes.empty()) return;
+
+  // Limit the prefetched chunks to half of the cache pool, so that they do
+  // not evict the chunks currently being read.
+  const auto& components = grid().components;
+  size_t chunk_bytes = 0;
+  for (const auto& component_spec : components) {
+    chunk_bytes += component_spec.array_spec.EstimateReadStateSizeInBytes(
+        /*valid=*/true, component_spec.shape());
+  }
+  size_t budget = pool() ? pool()->limits().total_bytes_limit / 2 : 0;
+
+  for (const auto& box : boxes) {
+    bool exhausted = false;
+    IterateOverIndexRange(box, [&](tensorstore::span<const Index> indices) {
+      if (exhausted) return;
+      if (grid().GetValidCellDomain(0, indices).is_empty()) return;
+      if (chunk_bytes > budget) {
+        exhausted = true;
+        return;
+      }
+      budget -= chunk_bytes;
+      num_prefetches.Increment();
+      AsyncCache::AsyncCacheReadRequest cache_request;
+      cache_request.staleness_bound = staleness_bound;
+      prefetcher_->AddPending(
+          GetEntryForGridCell(*this, indices)->Read(cache_request));
+    });
+    if (exhausted) break;
   }
 }
 
 void ChunkCache::Write(WriteRequest request, WriteChunkReceiver receiver) {
   assert(request.component_index >= 0 &&
          request.component_index < grid().components.size());
+  if (auto* pool = this->pool();
+      !request.transaction && pool && pool->writeback_limit_exceeded()) {
+    // Defer the write until enough previously written data has been written
+    // back, in order to bound the memory used by modified chunks.
+    pool->WhenWritebackBelowLimit(
+        [self = internal::CachePtr<ChunkCache>(this),
+         request = std::move(request),
+         receiver = std::move(receiver)]() mutable {
+          auto executor = self->executor();
+          executor([self = std::move(self), request = std::move(request),
+                    receiver = std::move(receiver)]() mutable {
+            self->ChunkCache::Write(std::move(request), std::move(receiver));
+          });
+        });
+    return;
+  }
   // In this implementation, chunks are always available for writing
   // immediately.  The entire stream of chunks is sent to the receiver before
   // this function returns.
@@ -507,9 +670,8 @@ void ChunkCache::Write(WriteRequest request, WriteChunkReceiver receiver) {
       if (cancelled) return absl::CancelledError("");
 
       num_writes.Increment();
-      TENSORSTORE_ASSIGN_OR_RETURN(
-          auto cell_to_dest,
-          ComposeTransforms(request.transform, iterator.cell_transform()));
+      TENSORSTORE_ASSIGN_OR_RETURN(auto cell_to_dest,
+                                   iterator.GetCellToOutputTransform());
       ABSL_LOG_IF(INFO, TENSORSTORE_INTERNAL_CHUNK_CACHE_DEBUG)
           << "grid_cell_indices=" << iterator.output_grid_cell_indices()
           << ", request.transform=" << request.transform
@@ -518,6 +680,11 @@ void ChunkCache::Write(WriteRequest request, WriteChunkReceiver receiver) {
       auto entry =
           GetEntryForGridCell(*this, iterator.output_grid_cell_indices());
       auto transaction_copy = request.transaction;
+      if (!transaction_copy &&
+          write_combining_options_.window > absl::ZeroDuration()) {
+        transaction_copy =
+            GetWriteCombiningTransaction(*entry, write_combining_options_);
+      }
       TENSORSTORE_ASSIGN_OR_RETURN(
           auto node, GetTransactionNode(*entry, transaction_copy));
       execution::set_value(
@@ -594,8 +761,18 @@ size_t ChunkCache::Entry::ComputeReadDataSizeInBytes(const void* read_data) {
        component_index < static_cast<size_t>(component_specs.size());
        ++component_index) {
     auto& component_spec = component_specs[component_index];
+    const auto& component = components[component_index];
+    // Uncompressed chunks read from a memory-mapped file may view the mapping
+    // directly.  Such arrays occupy no anonymous memory, and are accounted for
+    // by the mapped bytes of the file kvstore; only the mapping is counted
+    // here, so that the cache pool still bounds the number of mappings held.
+    if (component.valid() &&
+        internal_os::IsFileMappedMemory(component.data())) {
+      total += kMappedComponentSizeInBytes;
+      continue;
+    }
     total += component_spec.array_spec.EstimateReadStateSizeInBytes(
-        components[component_index].valid(), component_spec.chunk_shape);
+        component.valid(), component_spec.chunk_shape);
   }
   return total;
 }
@@ -718,5 +895,11 @@ std::string ChunkCache::Entry::DescribeChunk() {
   return tensorstore::StrCat("chunk ", this->cell_indices());
 }
 
+bool ChunkCache::Entry::IsKnownMissing(absl::Time staleness_bound) {
+  AsyncCache::ReadLock<ReadData> lock(*this);
+  return !lock.data() && lock.stamp().time >= staleness_bound &&
+         StorageGeneration::IsNoValue(lock.stamp().generation);
+}
+
 }  // namespace internal
 }  // namespace tensorstore
@@ -63,6 +63,7 @@
 #include "tensorstore/internal/async_write_array.h"
 #include "tensorstore/internal/cache/async_cache.h"
 #include "tensorstore/internal/cache/cache.h"
+#include "tensorstore/internal/cache/chunk_prefetcher.h"
 #include "tensorstore/internal/chunk_grid_specification.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/transaction.h"
@@ -73,6 +74,31 @@
 namespace tensorstore {
 namespace internal {
 
+/// Options controlling combining of non-transactional writes by
+/// `ChunkCache::Write`.
+struct ChunkWriteCombiningOptions {
+  /// Maximum time for which writeback of a chunk modified by a
+  /// non-transactional write is deferred, so that subsequent non-transactional
+  /// writes to the same chunk are written back together.  Writeback starts
+  /// early once the chunk is fully overwritten, or if the `commit_future` of
+  /// any of the writes is forced.  A value of `absl::ZeroDuration()` disables
+  /// combining.
+  absl::Duration window = absl::ZeroDuration();
+
+  static constexpr auto ApplyMembers = [](auto& x, auto f) {
+    return f(x.window);
+  };
+
+  friend bool operator==(const ChunkWriteCombiningOptions& a,
+                         const ChunkWriteCombiningOptions& b) {
+    return a.window == b.window;
+  }
+  friend bool operator!=(const ChunkWriteCombiningOptions& a,
+                         const ChunkWriteCombiningOptions& b) {
+    return !(a == b);
+  }
+};
+
 /// Cache for chunked multi-dimensional arrays.
 class ChunkCache : public AsyncCache {
  public:
@@ -106,6 +132,25 @@ class ChunkCache : public AsyncCache {
     size_t ComputeReadDataSizeInBytes(const void* read_data) override;
 
     virtual std::string DescribeChunk();
+
+    /// Returns `true` if the chunk is known not to be stored, as of a time no
+    /// older than `staleness_bound`, without reading it.
+    ///
+    /// By default, only a previous read that found the chunk missing is
+    /// considered.  Derived classes may override this to also consult other
+    /// sources, such as a listing of the stored chunks.
+    virtual bool IsKnownMissing(absl::Time staleness_bound);
+
+    /// Id of the NUMA node on which the read data was last decoded, and which
+    /// therefore likely holds its memory, or `-1` if unknown.  Used as the
+    /// preferred NUMA node for work on the chunk, such as copying the chunk to
+    /// the destination of a read.
+    std::atomic<int> numa_node{-1};
+
+    /// Implicit transaction with which subsequent non-transactional writes
+    /// are combined, if write combining is enabled.  Protected by the entry
+    /// mutex.
+    TransactionState::WeakPtr write_combining_transaction;
   };
 
   class TransactionNode : public AsyncCache::TransactionNode {
@@ -216,6 +261,12 @@ class ChunkCache : public AsyncCache {
     /// Use fill value for missing chunks. If `false`, return an error in the
     /// case of a missing chunk.
     bool fill_missing_data_reads = true;
+
+    /// Chunks known to be missing as of `missing_staleness_bound` are not
+    /// rechecked, even if `staleness_bound` is more recent.  This avoids
+    /// repeated requests for chunks that are never written, such as those of
+    /// sparse arrays.  Ignored for transactional reads.
+    absl::Time missing_staleness_bound = absl::InfiniteFuture();
   };
 
   /// Implements the behavior of `Driver::Read` for a given component array.
@@ -243,6 +294,33 @@ class ChunkCache : public AsyncCache {
   Future<const void> DeleteCell(
       tensorstore::span<const Index> grid_cell_indices,
       internal::OpenTransactionPtr transaction);
+
+  /// Enables read-ahead of chunks by non-transactional reads that follow a
+  /// sequential access pattern over the chunk grid.
+  ///
+  /// Prefetched chunks are limited to half of the `total_bytes_limit` of the
+  /// cache pool.  The caller is responsible for ensuring there are no
+  /// concurrent read operations.
+  void SetPrefetchOptions(ChunkPrefetchOptions options);
+
+  /// Enables combining of non-transactional writes to the same chunk.
+  ///
+  /// Must not be called concurrently with write operations.
+  void SetWriteCombiningOptions(ChunkWriteCombiningOptions options) {
+    write_combining_options_ = options;
+  }
+
+  const ChunkWriteCombiningOptions& write_combining_options() const {
+    return write_combining_options_;
+  }
+
+ private:
+  /// Issues background reads of the chunks predicted to follow a read of
+  /// `cells`.
+  void Prefetch(BoxView<> cells, absl::Time staleness_bound);
+
+  std::unique_ptr<ChunkPrefetcher> prefetcher_;
+  ChunkWriteCombiningOptions write_combining_options_;
 };
 
 class ConcreteChunkCache : public ChunkCache {
@@ -644,6 +644,61 @@ TEST_F(ChunkCacheTest, ReadSingleComponentOneDimensionalExisting) {
   }
 }
 
+// Tests that sequential reads prefetch the following chunks.
+TEST_F(ChunkCacheTest, ReadPrefetchSequential) {
+  // Dimension 0 is chunked with a size of 2.
+  grid = GetSimple1DGrid();
+
+  auto cache = MakeChunkCache();
+  cache->SetPrefetchOptions({/*.depth=*/2});
+
+  const auto read_chunk = [&](Index cell) {
+    return tensorstore::Read(
+        GetTensorStore(cache, absl::InfinitePast()) |
+        tensorstore::Dims(0).TranslateSizedInterval(cell * 2, 2));
+  };
+
+  // The first two reads establish the access pattern.
+  for (Index cell : {0, 1}) {
+    auto read_future = read_chunk(cell);
+    auto r = mock_store->read_requests.pop();
+    EXPECT_THAT(ParseKey(r.key), ElementsAre(cell));
+    r(memory_store);
+    TENSORSTORE_EXPECT_OK(read_future.result());
+  }
+  EXPECT_TRUE(mock_store->read_requests.empty());
+
+  // The third read prefetches chunks 3 and 4.
+  {
+    auto read_future = read_chunk(2);
+    for (Index cell : {2, 3, 4}) {
+      auto r = mock_store->read_requests.pop();
+      EXPECT_THAT(ParseKey(r.key), ElementsAre(cell));
+      r(memory_store);
+    }
+    TENSORSTORE_EXPECT_OK(read_future.result());
+  }
+
+  // Reading chunk 3 is satisfied by the prefetched chunk, and prefetches only
+  // chunk 5.
+  {
+    auto read_future = read_chunk(3);
+    auto r = mock_store->read_requests.pop();
+    EXPECT_THAT(ParseKey(r.key), ElementsAre(5));
+    r(memory_store);
+    EXPECT_THAT(read_future.result(),
+                ::testing::Optional(tensorstore::MakeArray({6, 7})));
+  }
+  EXPECT_TRUE(mock_store->read_requests.empty());
+
+  // Breaking the access pattern does not prefetch.
+  {
+    auto read_future = read_chunk(0);
+    TENSORSTORE_EXPECT_OK(read_future.result());
+  }
+  EXPECT_TRUE(mock_store->read_requests.empty());
+}
+
 // Test reading the fill value from a two-dimensional chunk cache.
 TEST_F(ChunkCacheTest, TwoDimensional) {
   grid = ChunkGridSpecification({ChunkGridSpecification::Component{
@@ -802,6 +857,86 @@ TEST_F(ChunkCacheTest, WriteSingleComponentOneDimensional) {
   TENSORSTORE_EXPECT_OK(write_future);
 }
 
+// Tests that non-transactional writes are deferred while the writeback bytes
+// limit of the cache pool is exceeded.
+TEST_F(ChunkCacheTest, WritebackBytesLimit) {
+  // Dimension 0 is chunked with a size of 2.
+  grid = GetSimple1DGrid();
+  CachePool::Limits limits;
+  limits.total_bytes_limit = 10000000;
+  limits.writeback_bytes_limit = 1;
+  auto cache = MakeChunkCache("", CachePool::Make(limits));
+
+  // Overwrite chunk 1.
+  auto write_future1 =
+      tensorstore::Write(MakeArray<int>({13, 14}),
+                         GetTensorStore(cache) |
+                             tensorstore::Dims(0).TranslateSizedInterval(2, 2));
+  TENSORSTORE_ASSERT_OK(write_future1.copy_future);
+  EXPECT_LT(0, cache->pool()->writeback_bytes());
+
+  // Overwrite chunk 2, which must wait until chunk 1 is written back.
+  auto write_future2 =
+      tensorstore::Write(MakeArray<int>({15, 16}),
+                         GetTensorStore(cache) |
+                             tensorstore::Dims(0).TranslateSizedInterval(4, 2));
+  write_future1.Force();
+  write_future2.Force();
+  {
+    auto r = mock_store->write_requests.pop();
+    EXPECT_THAT(ParseKey(r.key), ElementsAre(1));
+    EXPECT_FALSE(write_future2.copy_future.ready());
+    r(memory_store);
+  }
+  TENSORSTORE_EXPECT_OK(write_future1);
+  {
+    auto r = mock_store->write_requests.pop();
+    EXPECT_THAT(ParseKey(r.key), ElementsAre(2));
+    r(memory_store);
+  }
+  TENSORSTORE_EXPECT_OK(write_future2);
+  EXPECT_THAT(GetChunk({1}), ElementsAre(MakeArray<int>({13, 14})));
+  EXPECT_THAT(GetChunk({2}), ElementsAre(MakeArray<int>({15, 16})));
+}
+
+TEST_F(ChunkCacheTest, WriteCombining) {
+  // Dimension 0 is chunked with a size of 2.
+  grid = GetSimple1DGrid();
+  auto cache = MakeChunkCache();
+  cache->SetWriteCombiningOptions({/*window=*/absl::Hours(1)});
+
+  // Overwrite [2], which partially covers chunk 1.
+  auto write_future1 =
+      tensorstore::Write(MakeArray<int>({13}),
+                         GetTensorStore(cache) |
+                             tensorstore::Dims(0).TranslateSizedInterval(2, 1));
+  TENSORSTORE_ASSERT_OK(write_future1.copy_future);
+  // Writeback is deferred until the window elapses.
+  EXPECT_FALSE(write_future1.commit_future.ready());
+  EXPECT_TRUE(mock_store->read_requests.empty());
+  EXPECT_TRUE(mock_store->write_requests.empty());
+
+  // Overwrite [3], which completes the overwrite of chunk 1 and starts
+  // writeback of both writes without reading the existing chunk.
+  auto write_future2 =
+      tensorstore::Write(MakeArray<int>({14}),
+                         GetTensorStore(cache) |
+                             tensorstore::Dims(0).TranslateSizedInterval(3, 1));
+  TENSORSTORE_ASSERT_OK(write_future2.copy_future);
+  {
+    auto r = mock_store->write_requests.pop();
+    EXPECT_THAT(ParseKey(r.key), ElementsAre(1));
+    EXPECT_EQ(StorageGeneration::Unknown(),
+              r.options.generation_conditions.if_equal);
+    r(memory_store);
+  }
+  TENSORSTORE_EXPECT_OK(write_future1);
+  TENSORSTORE_EXPECT_OK(write_future2);
+  EXPECT_TRUE(mock_store->read_requests.empty());
+  EXPECT_TRUE(mock_store->write_requests.empty());
+  EXPECT_THAT(GetChunk({1}), ElementsAre(MakeArray<int>({13, 14})));
+}
+
 TEST_F(ChunkCacheTest, WriteSingleComponentOneDimensionalCacheDisabled) {
   // Dimension 0 is chunked with a size of 2.
   grid = GetSimple1DGrid();
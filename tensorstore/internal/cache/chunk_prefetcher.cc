@@ -0,0 +1,100 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/cache/chunk_prefetcher.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/box.h"
+#include "tensorstore/index.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace internal {
+
+ChunkAccessPatternDetector::Prediction
+ChunkAccessPatternDetector::RecordAccess(BoxView<> cells) {
+  Prediction prediction;
+  if (last_.rank() == cells.rank() && last_ == cells) {
+    // Repeated access to the same cells, e.g. multiple slices within a single
+    // chunk.
+    return prediction;
+  }
+
+  // Determine the single dimension, if any, along which `cells` is offset
+  // from the previous access.
+  DimensionIndex offset_dim = -1;
+  if (last_.rank() == cells.rank() &&
+      std::equal(last_.shape().begin(), last_.shape().end(),
+                 cells.shape().begin())) {
+    for (DimensionIndex i = 0; i < cells.rank(); ++i) {
+      if (last_.origin()[i] == cells.origin()[i]) continue;
+      if (offset_dim != -1) {
+        offset_dim = -1;
+        break;
+      }
+      offset_dim = i;
+    }
+  }
+
+  if (offset_dim != -1 && offset_dim == stride_dim_ &&
+      cells.origin()[offset_dim] - last_.origin()[offset_dim] == stride_) {
+    // The access pattern continues, and consumed one predicted box.
+    steps_ahead_ = std::max(Index(0), steps_ahead_ - 1);
+    for (Index step = steps_ahead_ + 1; step <= depth_; ++step) {
+      Box<> box(cells);
+      box.origin()[offset_dim] += step * stride_;
+      prediction.prefetch.push_back(std::move(box));
+    }
+    steps_ahead_ = depth_;
+  } else {
+    prediction.cancel = steps_ahead_ > 0;
+    steps_ahead_ = 0;
+    stride_dim_ = offset_dim;
+    stride_ = offset_dim == -1
+                  ? 0
+                  : cells.origin()[offset_dim] - last_.origin()[offset_dim];
+  }
+  last_ = cells;
+  return prediction;
+}
+
+std::vector<Box<>> ChunkPrefetcher::RecordRead(BoxView<> cells) {
+  std::vector<Future<const void>> cancelled;
+  std::vector<Box<>> prefetch;
+  {
+    absl::MutexLock lock(&mutex_);
+    auto prediction = detector_.RecordAccess(cells);
+    if (prediction.cancel) cancelled.swap(pending_);
+    prefetch = std::move(prediction.prefetch);
+  }
+  // `cancelled` is destroyed without holding `mutex_`.
+  return prefetch;
+}
+
+void ChunkPrefetcher::AddPending(Future<const void> future) {
+  if (future.ready()) return;
+  absl::MutexLock lock(&mutex_);
+  pending_.erase(
+      std::remove_if(pending_.begin(), pending_.end(),
+                     [](const Future<const void>& f) { return f.ready(); }),
+      pending_.end());
+  pending_.push_back(std::move(future));
+}
+
+}  // namespace internal
+}  // namespace tensorstore
@@ -0,0 +1,118 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_CACHE_CHUNK_PREFETCHER_H_
+#define TENSORSTORE_INTERNAL_CACHE_CHUNK_PREFETCHER_H_
+
+/// \file
+///
+/// Read-ahead of chunks for sequential access patterns over a chunk grid.
+///
+/// When a `ChunkCache` is read slice by slice along one dimension, each read
+/// otherwise waits for the I/O of the chunks it touches.  The
+/// `ChunkPrefetcher` detects such patterns from the boxes of grid cells
+/// accessed by consecutive reads, and predicts the boxes that will be accessed
+/// next so that they may be read in the background.
+
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/box.h"
+#include "tensorstore/index.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace internal {
+
+/// Options controlling read-ahead by `ChunkCache::Read`.
+struct ChunkPrefetchOptions {
+  /// Number of steps of a detected sequential access pattern to read ahead.
+  /// A value of `0` disables prefetching.
+  Index depth = 0;
+
+  static constexpr auto ApplyMembers = [](auto& x, auto f) {
+    return f(x.depth);
+  };
+
+  friend bool operator==(const ChunkPrefetchOptions& a,
+                         const ChunkPrefetchOptions& b) {
+    return a.depth == b.depth;
+  }
+  friend bool operator!=(const ChunkPrefetchOptions& a,
+                         const ChunkPrefetchOptions& b) {
+    return !(a == b);
+  }
+};
+
+/// Detects sequential access patterns over a chunk grid.
+///
+/// Each access is summarized by the box of grid cells it touches.  An access
+/// pattern is sequential once two consecutive pairs of accesses touch boxes of
+/// the same shape that are offset by the same non-zero stride along a single
+/// grid dimension.  Repeated accesses to the same box do not affect the
+/// pattern.
+class ChunkAccessPatternDetector {
+ public:
+  struct Prediction {
+    /// Boxes newly predicted to be accessed, nearest first.
+    std::vector<Box<>> prefetch;
+
+    /// Indicates that boxes previously predicted are no longer expected to be
+    /// accessed.
+    bool cancel = false;
+  };
+
+  explicit ChunkAccessPatternDetector(Index depth) : depth_(depth) {}
+
+  /// Records an access to `cells`.
+  Prediction RecordAccess(BoxView<> cells);
+
+ private:
+  Index depth_;
+  Box<> last_;
+  DimensionIndex stride_dim_ = -1;
+  Index stride_ = 0;
+  // Number of boxes beyond `last_` that have already been predicted.
+  Index steps_ahead_ = 0;
+};
+
+/// Thread-safe read-ahead state of a single `ChunkCache`.
+class ChunkPrefetcher {
+ public:
+  explicit ChunkPrefetcher(ChunkPrefetchOptions options)
+      : options_(options), detector_(options.depth) {}
+
+  const ChunkPrefetchOptions& options() const { return options_; }
+
+  /// Records a read of `cells` and returns the boxes of cells to prefetch.
+  ///
+  /// If the access pattern changed, outstanding prefetch reads added by
+  /// `AddPending` are released, which cancels those not yet issued.
+  std::vector<Box<>> RecordRead(BoxView<> cells);
+
+  /// Retains `future` until it completes or the access pattern changes.
+  void AddPending(Future<const void> future);
+
+ private:
+  ChunkPrefetchOptions options_;
+  absl::Mutex mutex_;
+  ChunkAccessPatternDetector detector_ ABSL_GUARDED_BY(mutex_);
+  std::vector<Future<const void>> pending_ ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_CACHE_CHUNK_PREFETCHER_H_
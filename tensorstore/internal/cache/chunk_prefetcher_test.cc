@@ -0,0 +1,82 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/cache/chunk_prefetcher.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "tensorstore/box.h"
+
+namespace {
+
+using ::tensorstore::Box;
+using ::tensorstore::internal::ChunkAccessPatternDetector;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+TEST(ChunkAccessPatternDetectorTest, Sequential) {
+  ChunkAccessPatternDetector detector(2);
+  EXPECT_THAT(detector.RecordAccess(Box({0, 0}, {1, 4})).prefetch, IsEmpty());
+  EXPECT_THAT(detector.RecordAccess(Box({1, 0}, {1, 4})).prefetch, IsEmpty());
+  EXPECT_THAT(detector.RecordAccess(Box({2, 0}, {1, 4})).prefetch,
+              ElementsAre(Box({3, 0}, {1, 4}), Box({4, 0}, {1, 4})));
+  // Only the box not already predicted is returned.
+  EXPECT_THAT(detector.RecordAccess(Box({3, 0}, {1, 4})).prefetch,
+              ElementsAre(Box({5, 0}, {1, 4})));
+}
+
+TEST(ChunkAccessPatternDetectorTest, RepeatedAccess) {
+  ChunkAccessPatternDetector detector(1);
+  detector.RecordAccess(Box({0}, {1}));
+  detector.RecordAccess(Box({1}, {1}));
+  EXPECT_THAT(detector.RecordAccess(Box({1}, {1})).prefetch, IsEmpty());
+  EXPECT_THAT(detector.RecordAccess(Box({2}, {1})).prefetch,
+              ElementsAre(Box({3}, {1})));
+  auto prediction = detector.RecordAccess(Box({2}, {1}));
+  EXPECT_THAT(prediction.prefetch, IsEmpty());
+  EXPECT_FALSE(prediction.cancel);
+}
+
+TEST(ChunkAccessPatternDetectorTest, Strided) {
+  ChunkAccessPatternDetector detector(1);
+  detector.RecordAccess(Box({10}, {2}));
+  detector.RecordAccess(Box({7}, {2}));
+  EXPECT_THAT(detector.RecordAccess(Box({4}, {2})).prefetch,
+              ElementsAre(Box({1}, {2})));
+}
+
+TEST(ChunkAccessPatternDetectorTest, PatternBroken) {
+  ChunkAccessPatternDetector detector(2);
+  detector.RecordAccess(Box({0}, {1}));
+  detector.RecordAccess(Box({1}, {1}));
+  EXPECT_THAT(detector.RecordAccess(Box({2}, {1})).prefetch,
+              ElementsAre(Box({3}, {1}), Box({4}, {1})));
+
+  // Change in stride.
+  auto prediction = detector.RecordAccess(Box({4}, {1}));
+  EXPECT_THAT(prediction.prefetch, IsEmpty());
+  EXPECT_TRUE(prediction.cancel);
+
+  // Change in shape.
+  prediction = detector.RecordAccess(Box({6}, {2}));
+  EXPECT_THAT(prediction.prefetch, IsEmpty());
+  EXPECT_FALSE(prediction.cancel);
+
+  // Offset along multiple dimensions.
+  detector.RecordAccess(Box({0, 0}, {1, 1}));
+  detector.RecordAccess(Box({1, 1}, {1, 1}));
+  EXPECT_THAT(detector.RecordAccess(Box({2, 2}, {1, 1})).prefetch, IsEmpty());
+}
+
+}  // namespace
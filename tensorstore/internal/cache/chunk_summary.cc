@@ -0,0 +1,229 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/cache/chunk_summary.h"
+
+#include <stdint.h>
+
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/escaping.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/array.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/index.h"
+#include "tensorstore/internal/json/json.h"
+#include "tensorstore/internal/json/value_as.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/static_cast.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal {
+namespace {
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+template <typename T>
+bool IsFill(T value, T fill) {
+  if constexpr (std::is_floating_point_v<T>) {
+    if (std::isnan(value)) return std::isnan(fill);
+  }
+  return value == fill;
+}
+
+template <typename T>
+ChunkComponentSummary ComputeSummary(ArrayView<const void> array,
+                                     ArrayView<const void> fill_value) {
+  ChunkComponentSummary summary;
+  summary.num_elements = array.num_elements();
+  T min = std::numeric_limits<T>::max();
+  T max = std::numeric_limits<T>::lowest();
+  bool has_value = false;
+  const auto accumulate = [&](const T* value) {
+    ++summary.non_fill_count;
+    if constexpr (std::is_floating_point_v<T>) {
+      if (std::isnan(*value)) return;
+    }
+    has_value = true;
+    if (*value < min) min = *value;
+    if (*value > max) max = *value;
+  };
+  auto typed_array = StaticDataTypeCast<const T, unchecked>(array);
+  if (fill_value.valid()) {
+    IterateOverArrays(
+        [&](const T* value, const T* fill) {
+          if (!IsFill(*value, *fill)) accumulate(value);
+        },
+        /*constraints=*/{}, typed_array,
+        StaticDataTypeCast<const T, unchecked>(fill_value));
+  } else {
+    IterateOverArrays(accumulate, /*constraints=*/{}, typed_array);
+  }
+  if (has_value) {
+    summary.min = static_cast<double>(min);
+    summary.max = static_cast<double>(max);
+    if constexpr (sizeof(T) == 8 && std::is_integral_v<T>) {
+      // 64-bit integers are not exactly representable as `double`.
+      summary.min = std::nextafter(summary.min, -kInfinity);
+      summary.max = std::nextafter(summary.max, kInfinity);
+    }
+  }
+  return summary;
+}
+
+}  // namespace
+
+bool IsChunkSummarySupported(DataType dtype) {
+  if (!dtype.valid()) return false;
+  switch (dtype.id()) {
+    case DataTypeId::int8_t:
+    case DataTypeId::uint8_t:
+    case DataTypeId::int16_t:
+    case DataTypeId::uint16_t:
+    case DataTypeId::int32_t:
+    case DataTypeId::uint32_t:
+    case DataTypeId::int64_t:
+    case DataTypeId::uint64_t:
+    case DataTypeId::float32_t:
+    case DataTypeId::float64_t:
+      return true;
+    default:
+      return false;
+  }
+}
+
+ChunkComponentSummary ComputeChunkComponentSummary(
+    ArrayView<const void> array, ArrayView<const void> fill_value) {
+  switch (array.dtype().id()) {
+#define TENSORSTORE_INTERNAL_DO_COMPUTE_SUMMARY(T) \
+  case DataTypeId::T:                              \
+    return ComputeSummary<::tensorstore::dtypes::T>(array, fill_value);
+    TENSORSTORE_INTERNAL_DO_COMPUTE_SUMMARY(int8_t)
+    TENSORSTORE_INTERNAL_DO_COMPUTE_SUMMARY(uint8_t)
+    TENSORSTORE_INTERNAL_DO_COMPUTE_SUMMARY(int16_t)
+    TENSORSTORE_INTERNAL_DO_COMPUTE_SUMMARY(uint16_t)
+    TENSORSTORE_INTERNAL_DO_COMPUTE_SUMMARY(int32_t)
+    TENSORSTORE_INTERNAL_DO_COMPUTE_SUMMARY(uint32_t)
+    TENSORSTORE_INTERNAL_DO_COMPUTE_SUMMARY(int64_t)
+    TENSORSTORE_INTERNAL_DO_COMPUTE_SUMMARY(uint64_t)
+    TENSORSTORE_INTERNAL_DO_COMPUTE_SUMMARY(float32_t)
+    TENSORSTORE_INTERNAL_DO_COMPUTE_SUMMARY(float64_t)
+#undef TENSORSTORE_INTERNAL_DO_COMPUTE_SUMMARY
+    default:
+      break;
+  }
+  // Unsupported data type: nothing is known about the values.
+  ChunkComponentSummary summary;
+  summary.num_elements = summary.non_fill_count = array.num_elements();
+  summary.min = -kInfinity;
+  summary.max = kInfinity;
+  return summary;
+}
+
+bool IntersectsValueRange(const ChunkComponentSummary& summary,
+                          ValueRange range) {
+  return summary.non_fill_count != 0 && summary.min <= range.inclusive_max &&
+         summary.max >= range.inclusive_min;
+}
+
+bool MayContainValueInRange(const ChunkComponentSummary& summary,
+                            ValueRange range, bool fill_value_in_range) {
+  if (fill_value_in_range && summary.non_fill_count < summary.num_elements) {
+    return true;
+  }
+  return IntersectsValueRange(summary, range);
+}
+
+absl::Cord EncodeChunkSummary(const ChunkSummary& summary) {
+  ::nlohmann::json::array_t components;
+  components.reserve(summary.components.size());
+  for (const auto& component : summary.components) {
+    ::nlohmann::json::object_t j{
+        {"num_elements", component.num_elements},
+        {"non_fill_count", component.non_fill_count},
+    };
+    if (component.non_fill_count != 0) {
+      // Infinite bounds are not representable in JSON, and are omitted.
+      if (std::isfinite(component.min)) j.emplace("min", component.min);
+      if (std::isfinite(component.max)) j.emplace("max", component.max);
+    }
+    components.push_back(std::move(j));
+  }
+  ::nlohmann::json j{
+      {"generation", absl::Base64Escape(summary.generation.value)},
+      {"components", std::move(components)},
+  };
+  return absl::Cord(j.dump());
+}
+
+Result<ChunkSummary> DecodeChunkSummary(const absl::Cord& encoded) {
+  const auto error = [] {
+    return absl::DataLossError("Invalid chunk summary");
+  };
+  ::nlohmann::json j = ParseJson(std::string(encoded));
+  if (!j.is_object()) return error();
+  ChunkSummary summary;
+  auto generation = j.find("generation");
+  auto components = j.find("components");
+  if (generation == j.end() || !generation->is_string() ||
+      !absl::Base64Unescape(generation->get_ref<const std::string&>(),
+                            &summary.generation.value) ||
+      components == j.end() || !components->is_array()) {
+    return error();
+  }
+  for (const auto& c : *components) {
+    if (!c.is_object()) return error();
+    auto& component = summary.components.emplace_back();
+    auto num_elements = c.find("num_elements");
+    auto non_fill_count = c.find("non_fill_count");
+    std::optional<Index> value;
+    if (num_elements == c.end() ||
+        !(value = internal_json::JsonValueAs<int64_t>(*num_elements, true))) {
+      return error();
+    }
+    component.num_elements = *value;
+    if (non_fill_count == c.end() ||
+        !(value =
+              internal_json::JsonValueAs<int64_t>(*non_fill_count, true))) {
+      return error();
+    }
+    component.non_fill_count = *value;
+    if (component.non_fill_count == 0) continue;
+    // A missing bound is unbounded.
+    component.min = -kInfinity;
+    component.max = kInfinity;
+    if (auto it = c.find("min"); it != c.end()) {
+      auto min = internal_json::JsonValueAs<double>(*it, true);
+      if (!min) return error();
+      component.min = *min;
+    }
+    if (auto it = c.find("max"); it != c.end()) {
+      auto max = internal_json::JsonValueAs<double>(*it, true);
+      if (!max) return error();
+      component.max = *max;
+    }
+  }
+  return summary;
+}
+
+}  // namespace internal
+}  // namespace tensorstore
@@ -0,0 +1,110 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_CACHE_CHUNK_SUMMARY_H_
+#define TENSORSTORE_INTERNAL_CACHE_CHUNK_SUMMARY_H_
+
+/// \file
+///
+/// Per-chunk summaries of the stored values, used to skip chunks that cannot
+/// contain values in a given range.
+///
+/// A summary records the range of the values of each component of a chunk
+/// that are not equal to the fill value, along with the generation of the
+/// chunk from which it was computed.  A summary whose generation does not
+/// match the current generation of the chunk is out of date and is ignored.
+
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "absl/strings/cord.h"
+#include "tensorstore/array.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/index.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal {
+
+/// Closed range of values.  Values of all data types are compared as
+/// `double`.
+struct ValueRange {
+  double inclusive_min = -std::numeric_limits<double>::infinity();
+  double inclusive_max = std::numeric_limits<double>::infinity();
+};
+
+/// Summary of the values of one component of a chunk.
+struct ChunkComponentSummary {
+  /// Number of elements.
+  Index num_elements = 0;
+
+  /// Number of elements not equal to the fill value.
+  Index non_fill_count = 0;
+
+  /// Bounds of the elements not equal to the fill value, excluding NaN.
+  /// Values of 64-bit integer types are rounded outwards.  Only meaningful if
+  /// `non_fill_count != 0`.
+  double min = std::numeric_limits<double>::infinity();
+  double max = -std::numeric_limits<double>::infinity();
+};
+
+/// Summary of a stored chunk.
+struct ChunkSummary {
+  /// Generation of the chunk from which the summary was computed.
+  StorageGeneration generation;
+
+  /// Summary of each component.
+  std::vector<ChunkComponentSummary> components;
+};
+
+/// Returns `true` if chunks of the specified data type may be summarized,
+/// i.e. for integer and floating-point types other than 16-bit and 4-bit
+/// floating point and sub-byte integer types.
+bool IsChunkSummarySupported(DataType dtype);
+
+/// Computes the summary of `array`.
+///
+/// \param array The chunk data.
+/// \param fill_value The fill value, of the same shape and data type as
+///     `array`, or a null array to count all elements as not equal to the fill
+///     value.
+/// \pre `IsChunkSummarySupported(array.dtype())`
+ChunkComponentSummary ComputeChunkComponentSummary(
+    ArrayView<const void> array, ArrayView<const void> fill_value = {});
+
+/// Returns `true` if some element not equal to the fill value that is
+/// summarized by `summary` may lie in `range`.
+bool IntersectsValueRange(const ChunkComponentSummary& summary,
+                          ValueRange range);
+
+/// Returns `true` if the chunk component summarized by `summary` may contain a
+/// value in `range`.
+///
+/// \param fill_value_in_range Indicates whether the fill value may lie in
+///     `range`, which matters if the chunk contains any fill values.
+bool MayContainValueInRange(const ChunkComponentSummary& summary,
+                            ValueRange range, bool fill_value_in_range);
+
+/// Encodes a chunk summary as JSON.
+absl::Cord EncodeChunkSummary(const ChunkSummary& summary);
+
+/// Decodes a chunk summary encoded by `EncodeChunkSummary`.
+Result<ChunkSummary> DecodeChunkSummary(const absl::Cord& encoded);
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_CACHE_CHUNK_SUMMARY_H_
@@ -0,0 +1,154 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/cache/chunk_summary.h"
+
+#include <stdint.h>
+
+#include <cmath>
+#include <limits>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "tensorstore/array.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::MakeArray;
+using ::tensorstore::StatusIs;
+using ::tensorstore::StorageGeneration;
+using ::tensorstore::internal::ChunkComponentSummary;
+using ::tensorstore::internal::ChunkSummary;
+using ::tensorstore::internal::ComputeChunkComponentSummary;
+using ::tensorstore::internal::DecodeChunkSummary;
+using ::tensorstore::internal::EncodeChunkSummary;
+using ::tensorstore::internal::IntersectsValueRange;
+using ::tensorstore::internal::IsChunkSummarySupported;
+using ::tensorstore::internal::MayContainValueInRange;
+
+constexpr double kInfinity = std::numeric_limits<double>::infinity();
+
+TEST(IsChunkSummarySupportedTest, Basic) {
+  EXPECT_TRUE(IsChunkSummarySupported(tensorstore::dtype_v<int32_t>));
+  EXPECT_TRUE(IsChunkSummarySupported(tensorstore::dtype_v<double>));
+  EXPECT_FALSE(IsChunkSummarySupported(tensorstore::dtype_v<bool>));
+  EXPECT_FALSE(IsChunkSummarySupported(
+      tensorstore::dtype_v<tensorstore::dtypes::string_t>));
+  EXPECT_FALSE(IsChunkSummarySupported(tensorstore::DataType()));
+}
+
+TEST(ComputeChunkComponentSummaryTest, Integer) {
+  auto array = MakeArray<int32_t>({{0, 5, 0}, {-3, 0, 7}});
+  auto summary = ComputeChunkComponentSummary(
+      array, MakeArray<int32_t>({{0, 0, 0}, {0, 0, 0}}));
+  EXPECT_EQ(6, summary.num_elements);
+  EXPECT_EQ(3, summary.non_fill_count);
+  EXPECT_EQ(-3, summary.min);
+  EXPECT_EQ(7, summary.max);
+
+  summary = ComputeChunkComponentSummary(array);
+  EXPECT_EQ(6, summary.non_fill_count);
+  EXPECT_EQ(-3, summary.min);
+  EXPECT_EQ(7, summary.max);
+}
+
+TEST(ComputeChunkComponentSummaryTest, AllFill) {
+  auto array = MakeArray<uint8_t>({4, 4});
+  auto summary =
+      ComputeChunkComponentSummary(array, MakeArray<uint8_t>({4, 4}));
+  EXPECT_EQ(2, summary.num_elements);
+  EXPECT_EQ(0, summary.non_fill_count);
+  EXPECT_FALSE(IntersectsValueRange(summary, {}));
+}
+
+TEST(ComputeChunkComponentSummaryTest, Int64RoundsOutwards) {
+  const int64_t big = (int64_t{1} << 62) + 1;
+  auto summary = ComputeChunkComponentSummary(MakeArray<int64_t>({big}));
+  EXPECT_LT(summary.min, static_cast<double>(big));
+  EXPECT_GT(summary.max, static_cast<double>(big));
+}
+
+TEST(ComputeChunkComponentSummaryTest, FloatNaN) {
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  auto array = MakeArray<float>({nan, 1.5f, nan, -2.0f});
+  auto summary =
+      ComputeChunkComponentSummary(array, MakeArray<float>({nan, 0, 0, 0}));
+  EXPECT_EQ(3, summary.non_fill_count);
+  EXPECT_EQ(-2.0, summary.min);
+  EXPECT_EQ(1.5, summary.max);
+}
+
+TEST(MayContainValueInRangeTest, Basic) {
+  ChunkComponentSummary summary;
+  summary.num_elements = 10;
+  summary.non_fill_count = 4;
+  summary.min = 2;
+  summary.max = 5;
+  EXPECT_TRUE(MayContainValueInRange(summary, {5, 10}, false));
+  EXPECT_TRUE(MayContainValueInRange(summary, {0, 2}, false));
+  EXPECT_FALSE(MayContainValueInRange(summary, {6, 10}, false));
+  EXPECT_FALSE(MayContainValueInRange(summary, {-kInfinity, 1}, false));
+  // The chunk contains fill values.
+  EXPECT_TRUE(MayContainValueInRange(summary, {6, 10}, true));
+  summary.non_fill_count = 10;
+  EXPECT_FALSE(MayContainValueInRange(summary, {6, 10}, true));
+}
+
+TEST(EncodeChunkSummaryTest, RoundTrip) {
+  ChunkSummary summary;
+  summary.generation = StorageGeneration::FromString("abc");
+  auto& a = summary.components.emplace_back();
+  a.num_elements = 8;
+  a.non_fill_count = 3;
+  a.min = -1.25;
+  a.max = 4;
+  auto& b = summary.components.emplace_back();
+  b.num_elements = 8;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto decoded, DecodeChunkSummary(EncodeChunkSummary(summary)));
+  EXPECT_EQ(summary.generation, decoded.generation);
+  ASSERT_EQ(2, decoded.components.size());
+  EXPECT_EQ(8, decoded.components[0].num_elements);
+  EXPECT_EQ(3, decoded.components[0].non_fill_count);
+  EXPECT_EQ(-1.25, decoded.components[0].min);
+  EXPECT_EQ(4, decoded.components[0].max);
+  EXPECT_EQ(0, decoded.components[1].non_fill_count);
+}
+
+TEST(EncodeChunkSummaryTest, InfiniteBounds) {
+  ChunkSummary summary;
+  auto& a = summary.components.emplace_back();
+  a.num_elements = a.non_fill_count = 1;
+  a.min = -kInfinity;
+  a.max = kInfinity;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto decoded, DecodeChunkSummary(EncodeChunkSummary(summary)));
+  EXPECT_EQ(-kInfinity, decoded.components[0].min);
+  EXPECT_EQ(kInfinity, decoded.components[0].max);
+}
+
+TEST(DecodeChunkSummaryTest, Invalid) {
+  EXPECT_THAT(DecodeChunkSummary(absl::Cord("x")),
+              StatusIs(absl::StatusCode::kDataLoss));
+  EXPECT_THAT(DecodeChunkSummary(absl::Cord(R"({"generation": "", )"
+                                            R"("components": [{}]})")),
+              StatusIs(absl::StatusCode::kDataLoss));
+}
+
+}  // namespace
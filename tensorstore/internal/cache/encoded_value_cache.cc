@@ -0,0 +1,81 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/cache/encoded_value_cache.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/cache/cache.h"
+#include "tensorstore/internal/mutex.h"
+
+namespace tensorstore {
+namespace internal {
+
+std::optional<EncodedValue> EncodedValueCache::Entry::Get() {
+  absl::MutexLock lock(&mutex());
+  return value_;
+}
+
+void EncodedValueCache::Entry::Set(EncodedValue value) {
+  UniqueWriterLock<Cache::Entry> lock(*this);
+  if (value.stamp.time < invalidated_time_ ||
+      (value_ && value_->stamp.time > value.stamp.time)) {
+    return;
+  }
+  value_ = std::move(value);
+  NotifySizeChanged();
+}
+
+void EncodedValueCache::Entry::Invalidate(absl::Time time) {
+  UniqueWriterLock<Cache::Entry> lock(*this);
+  invalidated_time_ = std::max(invalidated_time_, time);
+  if (!value_) return;
+  value_ = std::nullopt;
+  NotifySizeChanged();
+}
+
+size_t EncodedValueCache::DoGetSizeInBytes(Cache::Entry* base_entry) {
+  auto* entry = static_cast<Entry*>(base_entry);
+  size_t size = Cache::DoGetSizeInBytes(entry);
+  if (entry->value_) {
+    size += entry->value_->value.size() +
+            entry->value_->stamp.generation.value.capacity();
+  }
+  return size;
+}
+
+std::optional<EncodedValue> GetEncodedValue(EncodedValueCache& cache,
+                                            std::string_view key) {
+  return GetCacheEntry(&cache, key)->Get();
+}
+
+void SetEncodedValue(EncodedValueCache& cache, std::string_view key,
+                     EncodedValue value) {
+  GetCacheEntry(&cache, key)->Set(std::move(value));
+}
+
+void InvalidateEncodedValue(EncodedValueCache& cache, std::string_view key,
+                            absl::Time time) {
+  GetCacheEntry(&cache, key)->Invalidate(time);
+}
+
+}  // namespace internal
+}  // namespace tensorstore
@@ -0,0 +1,93 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_CACHE_ENCODED_VALUE_CACHE_H_
+#define TENSORSTORE_INTERNAL_CACHE_ENCODED_VALUE_CACHE_H_
+
+/// \file
+///
+/// Cache of encoded values read from a `kvstore::Driver`.
+///
+/// A `KvsBackedCache` holds decoded values, which for compressed formats may
+/// be many times larger than the values stored in the kvstore.  An
+/// `EncodedValueCache`, normally in a separate `CachePool` with its own size
+/// limit, retains the encoded values so that entries evicted from the decoded
+/// cache can be decoded again without re-reading them from the kvstore.
+
+#include <stddef.h>
+
+#include <optional>
+#include <string_view>
+
+#include "absl/strings/cord.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/cache/cache.h"
+#include "tensorstore/kvstore/generation.h"
+
+namespace tensorstore {
+namespace internal {
+
+/// An encoded value along with the generation and time at which it was read.
+struct EncodedValue {
+  absl::Cord value;
+  TimestampedStorageGeneration stamp;
+};
+
+/// Cache of encoded values, keyed by kvstore key.
+class EncodedValueCache : public Cache {
+ public:
+  class Entry : public Cache::Entry {
+   public:
+    using OwningCache = EncodedValueCache;
+
+    /// Returns the cached value, if any.
+    std::optional<EncodedValue> Get();
+
+    /// Sets the cached value.  Values older than the current value, or than
+    /// the last call to `Invalidate`, are ignored.
+    void Set(EncodedValue value);
+
+    /// Removes the cached value, which is known to be out of date as of
+    /// `time`.
+    void Invalidate(absl::Time time);
+
+   private:
+    friend class EncodedValueCache;
+
+    // Protected by `mutex()`.
+    std::optional<EncodedValue> value_;
+    absl::Time invalidated_time_ = absl::InfinitePast();
+  };
+
+  Entry* DoAllocateEntry() final { return new Entry; }
+  size_t DoGetSizeofEntry() final { return sizeof(Entry); }
+  size_t DoGetSizeInBytes(Cache::Entry* base_entry) override;
+};
+
+/// Returns the value of `key` cached in `cache`, if any.
+std::optional<EncodedValue> GetEncodedValue(EncodedValueCache& cache,
+                                            std::string_view key);
+
+/// Caches `value` for `key` in `cache`.
+void SetEncodedValue(EncodedValueCache& cache, std::string_view key,
+                     EncodedValue value);
+
+/// Removes any value of `key` from `cache`, as `key` was modified at `time`.
+void InvalidateEncodedValue(EncodedValueCache& cache, std::string_view key,
+                            absl::Time time);
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_CACHE_ENCODED_VALUE_CACHE_H_
@@ -0,0 +1,96 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/cache/encoded_value_cache.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <gtest/gtest.h>
+#include "absl/strings/cord.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/cache/cache.h"
+#include "tensorstore/kvstore/generation.h"
+
+namespace {
+
+using ::tensorstore::StorageGeneration;
+using ::tensorstore::TimestampedStorageGeneration;
+using ::tensorstore::internal::CachePool;
+using ::tensorstore::internal::EncodedValue;
+using ::tensorstore::internal::EncodedValueCache;
+using ::tensorstore::internal::GetCache;
+using ::tensorstore::internal::GetEncodedValue;
+using ::tensorstore::internal::InvalidateEncodedValue;
+using ::tensorstore::internal::SetEncodedValue;
+
+EncodedValue MakeValue(std::string value, std::string generation,
+                       absl::Time time) {
+  return EncodedValue{
+      absl::Cord(std::move(value)),
+      TimestampedStorageGeneration{
+          StorageGeneration::FromString(generation), time}};
+}
+
+TEST(EncodedValueCacheTest, SetAndGet) {
+  auto pool = CachePool::Make(CachePool::Limits{10000000});
+  auto cache = GetCache<EncodedValueCache>(
+      pool.get(), "", [] { return std::make_unique<EncodedValueCache>(); });
+  EXPECT_EQ(std::nullopt, GetEncodedValue(*cache, "a"));
+
+  const absl::Time t = absl::Now();
+  SetEncodedValue(*cache, "a", MakeValue("abc", "g1", t));
+  auto value = GetEncodedValue(*cache, "a");
+  ASSERT_TRUE(value);
+  EXPECT_EQ("abc", value->value);
+  EXPECT_EQ(StorageGeneration::FromString("g1"), value->stamp.generation);
+
+  // Older values do not replace newer values.
+  SetEncodedValue(*cache, "a", MakeValue("old", "g0", t - absl::Seconds(1)));
+  EXPECT_EQ("abc", GetEncodedValue(*cache, "a")->value);
+
+  SetEncodedValue(*cache, "a", MakeValue("new", "g2", t + absl::Seconds(1)));
+  EXPECT_EQ("new", GetEncodedValue(*cache, "a")->value);
+}
+
+TEST(EncodedValueCacheTest, Invalidate) {
+  auto pool = CachePool::Make(CachePool::Limits{10000000});
+  auto cache = GetCache<EncodedValueCache>(
+      pool.get(), "", [] { return std::make_unique<EncodedValueCache>(); });
+  const absl::Time t = absl::Now();
+  SetEncodedValue(*cache, "a", MakeValue("abc", "g1", t));
+  InvalidateEncodedValue(*cache, "a", t + absl::Seconds(1));
+  EXPECT_EQ(std::nullopt, GetEncodedValue(*cache, "a"));
+
+  // Values read before the invalidation are ignored.
+  SetEncodedValue(*cache, "a", MakeValue("abc", "g1", t));
+  EXPECT_EQ(std::nullopt, GetEncodedValue(*cache, "a"));
+
+  SetEncodedValue(*cache, "a", MakeValue("def", "g2", t + absl::Seconds(2)));
+  EXPECT_EQ("def", GetEncodedValue(*cache, "a")->value);
+}
+
+TEST(EncodedValueCacheTest, EvictedUnderLimit) {
+  auto pool = CachePool::Make(CachePool::Limits{2000});
+  auto cache = GetCache<EncodedValueCache>(
+      pool.get(), "", [] { return std::make_unique<EncodedValueCache>(); });
+  const absl::Time t = absl::Now();
+  SetEncodedValue(*cache, "a", MakeValue(std::string(1200, 'a'), "g", t));
+  SetEncodedValue(*cache, "b", MakeValue(std::string(1200, 'b'), "g", t));
+  EXPECT_EQ(std::nullopt, GetEncodedValue(*cache, "a"));
+  EXPECT_TRUE(GetEncodedValue(*cache, "b"));
+}
+
+}  // namespace
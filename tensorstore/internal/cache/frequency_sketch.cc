@@ -0,0 +1,107 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/cache/frequency_sketch.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include "absl/numeric/bits.h"
+
+namespace tensorstore {
+namespace internal_cache {
+namespace {
+
+constexpr size_t kCountersPerWord = 16;
+
+// The sketch has one word, and therefore 16 counters, per expected key.
+constexpr size_t kMinWords = 64;
+constexpr size_t kMaxWords = size_t{1} << 20;
+
+// Number of accesses recorded, per expected key, between halvings.
+constexpr size_t kSamplesPerWord = 10;
+
+}  // namespace
+
+FrequencySketch::FrequencySketch(size_t expected_keys) {
+  const size_t num_words =
+      absl::bit_ceil(std::clamp(expected_keys, kMinWords, kMaxWords));
+  counter_mask_ = num_words * kCountersPerWord - 1;
+  sample_size_ = num_words * kSamplesPerWord;
+  words_ = std::make_unique<std::atomic<uint64_t>[]>(num_words);
+  for (size_t i = 0; i < num_words; ++i) {
+    words_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+size_t FrequencySketch::CounterIndex(uint64_t hash, int i) const {
+  // Double hashing: the upper half of `hash` (made odd) is the step between
+  // the counters of successive hash functions.
+  const uint64_t step = (hash >> 32) | 1;
+  return static_cast<size_t>(hash + i * step) & counter_mask_;
+}
+
+void FrequencySketch::Increment(uint64_t hash) {
+  bool incremented = false;
+  for (int i = 0; i < kNumHashes; ++i) {
+    const size_t index = CounterIndex(hash, i);
+    auto& word = words_[index / kCountersPerWord];
+    const int shift = (index % kCountersPerWord) * 4;
+    uint64_t value = word.load(std::memory_order_relaxed);
+    while (((value >> shift) & 0xf) != kMaxFrequency) {
+      if (word.compare_exchange_weak(value, value + (uint64_t{1} << shift),
+                                     std::memory_order_relaxed)) {
+        incremented = true;
+        break;
+      }
+    }
+  }
+  if (incremented && num_increments_.fetch_add(1, std::memory_order_relaxed) +
+                             1 ==
+                         sample_size_) {
+    Halve();
+  }
+}
+
+int FrequencySketch::Frequency(uint64_t hash) const {
+  int frequency = kMaxFrequency;
+  for (int i = 0; i < kNumHashes; ++i) {
+    const size_t index = CounterIndex(hash, i);
+    const uint64_t value =
+        words_[index / kCountersPerWord].load(std::memory_order_relaxed);
+    frequency = std::min(
+        frequency,
+        static_cast<int>((value >> ((index % kCountersPerWord) * 4)) & 0xf));
+  }
+  return frequency;
+}
+
+void FrequencySketch::Halve() {
+  constexpr uint64_t kLowBitsCleared = 0x7777777777777777;
+  const size_t num_words = num_counters() / kCountersPerWord;
+  for (size_t i = 0; i < num_words; ++i) {
+    uint64_t value = words_[i].load(std::memory_order_relaxed);
+    while (!words_[i].compare_exchange_weak(
+        value, (value >> 1) & kLowBitsCleared, std::memory_order_relaxed)) {
+    }
+  }
+  num_increments_.fetch_sub(sample_size_ / 2, std::memory_order_relaxed);
+}
+
+}  // namespace internal_cache
+}  // namespace tensorstore
@@ -0,0 +1,68 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_CACHE_FREQUENCY_SKETCH_H_
+#define TENSORSTORE_INTERNAL_CACHE_FREQUENCY_SKETCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+namespace tensorstore {
+namespace internal_cache {
+
+/// Estimates how often keys have been accessed recently, for the admission
+/// filter of the TinyLFU eviction policy.
+///
+/// This is a count-min sketch of 4-bit saturating counters.  Every time the
+/// number of recorded accesses reaches ten times the expected number of keys,
+/// all counters are halved, so that the estimates favor recent accesses.
+///
+/// All methods are thread-safe.  Concurrent updates may occasionally be lost,
+/// which only affects the accuracy of the estimates.
+class FrequencySketch {
+ public:
+  static constexpr int kMaxFrequency = 15;
+
+  /// Constructs a sketch sized for about `expected_keys` distinct keys.
+  explicit FrequencySketch(size_t expected_keys);
+
+  /// Records an access to the key with the specified hash.
+  void Increment(uint64_t hash);
+
+  /// Returns the estimated number of recent accesses to the key with the
+  /// specified hash, at most `kMaxFrequency`.
+  int Frequency(uint64_t hash) const;
+
+  size_t num_counters() const { return counter_mask_ + 1; }
+
+ private:
+  static constexpr int kNumHashes = 4;
+
+  size_t CounterIndex(uint64_t hash, int i) const;
+
+  void Halve();
+
+  size_t counter_mask_;
+  size_t sample_size_;
+  std::unique_ptr<std::atomic<uint64_t>[]> words_;
+  std::atomic<size_t> num_increments_{0};
+};
+
+}  // namespace internal_cache
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_CACHE_FREQUENCY_SKETCH_H_
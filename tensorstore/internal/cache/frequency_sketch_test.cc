@@ -0,0 +1,60 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/cache/frequency_sketch.h"
+
+#include <stdint.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/hash/hash.h"
+
+namespace {
+
+using ::tensorstore::internal_cache::FrequencySketch;
+
+uint64_t KeyHash(int key) { return absl::Hash<int>{}(key); }
+
+TEST(FrequencySketchTest, Size) {
+  EXPECT_EQ(1024, FrequencySketch(0).num_counters());
+  EXPECT_EQ(4096 * 16, FrequencySketch(3000).num_counters());
+}
+
+TEST(FrequencySketchTest, CountsAccesses) {
+  FrequencySketch sketch(1024);
+  EXPECT_EQ(0, sketch.Frequency(KeyHash(1)));
+  for (int i = 0; i < 5; ++i) sketch.Increment(KeyHash(1));
+  sketch.Increment(KeyHash(2));
+  EXPECT_EQ(5, sketch.Frequency(KeyHash(1)));
+  EXPECT_EQ(1, sketch.Frequency(KeyHash(2)));
+}
+
+TEST(FrequencySketchTest, Saturates) {
+  FrequencySketch sketch(1024);
+  for (int i = 0; i < 100; ++i) sketch.Increment(KeyHash(1));
+  EXPECT_EQ(FrequencySketch::kMaxFrequency, sketch.Frequency(KeyHash(1)));
+}
+
+TEST(FrequencySketchTest, AgesCounts) {
+  // 1024 counters, halved every 640 accesses.
+  FrequencySketch sketch(64);
+  // Hashes that are multiples of 4 below 2^32 map to disjoint counters.
+  for (int i = 0; i < 8; ++i) sketch.Increment(0);
+  for (int i = 0; i < 631; ++i) sketch.Increment(4 * (1 + i % 255));
+  EXPECT_EQ(8, sketch.Frequency(0));
+  sketch.Increment(4);
+  EXPECT_EQ(4, sketch.Frequency(0));
+}
+
+}  // namespace
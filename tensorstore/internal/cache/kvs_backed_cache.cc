@@ -16,10 +16,17 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <string>
+#include <string_view>
+#include <utility>
 
+#include "absl/container/flat_hash_set.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
 #include "tensorstore/internal/metrics/counter.h"
 #include "tensorstore/internal/metrics/metadata.h"
+#include "tensorstore/kvstore/key_range.h"
 
 namespace tensorstore {
 namespace internal {
@@ -48,5 +55,43 @@ void KvsBackedCache_IncrementReadErrorMetric() {
   cell.Increment();
 }
 
+void KvsBackedCache_IncrementReadEncodedMetric() {
+  static auto& cell = kvs_cache_read.GetCell("encoded");
+  cell.Increment();
+}
+
+void KvsKeyPresence::SetListing(KeyRange range,
+                                absl::flat_hash_set<std::string> keys,
+                                absl::Time time) {
+  absl::MutexLock lock(&mutex_);
+  if (range_ != range) {
+    // Only a single range is tracked; the most recent listing replaces any
+    // previous listing of a different range.
+    range_ = std::move(range);
+    keys_ = std::move(keys);
+    time_ = time;
+    return;
+  }
+  if (keys_.empty()) {
+    keys_ = std::move(keys);
+  } else {
+    keys_.insert(keys.begin(), keys.end());
+  }
+  time_ = std::max(time_, time);
+}
+
+absl::Time KvsKeyPresence::GetAbsentTime(std::string_view key) {
+  absl::MutexLock lock(&mutex_);
+  if (!Contains(range_, key) || keys_.contains(key)) {
+    return absl::InfinitePast();
+  }
+  return time_;
+}
+
+void KvsKeyPresence::MarkPossiblyPresent(std::string_view key) {
+  absl::MutexLock lock(&mutex_);
+  keys_.emplace(key);
+}
+
 }  // namespace internal
 }  // namespace tensorstore
@@ -21,20 +21,29 @@
 
 #include <stddef.h>
 
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 
 #include "absl/base/optimization.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
 #include "tensorstore/internal/cache/async_cache.h"
+#include "tensorstore/internal/cache/cache.h"
+#include "tensorstore/internal/cache/encoded_value_cache.h"
+#include "tensorstore/internal/tracing/operation_stats.h"
 #include "tensorstore/kvstore/driver.h"
 #include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/key_range.h"
 #include "tensorstore/kvstore/operations.h"
 #include "tensorstore/kvstore/read_modify_write.h"
 #include "tensorstore/kvstore/read_result.h"
@@ -53,6 +62,43 @@ namespace internal {
 void KvsBackedCache_IncrementReadUnchangedMetric();
 void KvsBackedCache_IncrementReadChangedMetric();
 void KvsBackedCache_IncrementReadErrorMetric();
+void KvsBackedCache_IncrementReadEncodedMetric();
+
+/// Set of keys that may be present in a kvstore, as determined by a listing.
+///
+/// Keys within the listed range that are not in the set are known to be
+/// absent as of the time of the listing, which allows reads of them to be
+/// satisfied without a request to the kvstore.
+class KvsKeyPresence {
+ public:
+  /// Must be called before issuing a listing, such that keys written
+  /// concurrently with the listing are recorded by `MarkPossiblyPresent`.
+  void BeginListing() { active_.store(true); }
+
+  /// Returns `true` if `BeginListing` has been called.
+  bool active() const { return active_.load(); }
+
+  /// Records the result of listing `range` as of `time`.
+  ///
+  /// The keys are merged with any keys previously recorded, such that keys
+  /// written concurrently with the listing are never considered absent.
+  void SetListing(KeyRange range, absl::flat_hash_set<std::string> keys,
+                  absl::Time time);
+
+  /// Returns the time as of which `key` is known to be absent, or
+  /// `absl::InfinitePast()` if unknown.
+  absl::Time GetAbsentTime(std::string_view key);
+
+  /// Records that `key` may be present, e.g. because it was written.
+  void MarkPossiblyPresent(std::string_view key);
+
+ private:
+  absl::Mutex mutex_;
+  KeyRange range_ ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_set<std::string> keys_ ABSL_GUARDED_BY(mutex_);
+  absl::Time time_ ABSL_GUARDED_BY(mutex_) = absl::InfinitePast();
+  std::atomic<bool> active_{false};
+};
 
 /// Base class that integrates an `AsyncCache` with a `kvstore::Driver`.
 ///
@@ -143,12 +189,23 @@ class KvsBackedCache : public Parent {
     struct ReadReceiverImpl {
       EntryOrNode* entry_or_node_;
       std::shared_ptr<const void> existing_read_data_;
+      // Encoded value from the `EncodedValueCache` that the read validates
+      // instead of `existing_read_data_`.
+      std::optional<absl::Cord> existing_encoded_value_;
       void set_value(kvstore::ReadResult read_result) {
         if (read_result.aborted()) {
           ABSL_LOG_IF(INFO, TENSORSTORE_ASYNC_CACHE_DEBUG)
               << *entry_or_node_
               << "Value has not changed, stamp=" << read_result.stamp;
           KvsBackedCache_IncrementReadUnchangedMetric();
+          if (existing_encoded_value_) {
+            // The encoded value has not changed, but must be decoded again.
+            GetOwningEntry(*entry_or_node_)
+                .DoDecode(std::move(existing_encoded_value_),
+                          DecodeReceiverImpl<EntryOrNode>{
+                              entry_or_node_, std::move(read_result.stamp)});
+            return;
+          }
           // Value has not changed.
           entry_or_node_->ReadSuccess(AsyncCache::ReadState{
               std::move(existing_read_data_), std::move(read_result.stamp)});
@@ -157,6 +214,21 @@ class KvsBackedCache : public Parent {
         ABSL_LOG_IF(INFO, TENSORSTORE_ASYNC_CACHE_DEBUG)
             << *entry_or_node_ << "DoDecode: " << read_result.stamp;
         KvsBackedCache_IncrementReadChangedMetric();
+        if (read_result.has_value()) {
+          internal_tracing::IncrementOperationStat(
+              &internal_tracing::OperationStatsState::kvstore_bytes_read,
+              read_result.value.size());
+        }
+        if constexpr (std::is_same_v<EntryOrNode, Entry>) {
+          // Transactional reads may observe uncommitted values, which must
+          // not be cached.
+          auto& cache = GetOwningCache(*entry_or_node_);
+          if (cache.encoded_value_cache_ && read_result.has_value()) {
+            SetEncodedValue(*cache.encoded_value_cache_,
+                            entry_or_node_->GetKeyValueStoreKey(),
+                            EncodedValue{read_result.value, read_result.stamp});
+          }
+        }
         GetOwningEntry(*entry_or_node_)
             .DoDecode(std::move(read_result).optional_value(),
                       DecodeReceiverImpl<EntryOrNode>{
@@ -184,11 +256,72 @@ class KvsBackedCache : public Parent {
           std::move(read_state.stamp.generation);
       kvstore_options.batch = request.batch;
       auto& cache = GetOwningCache(*this);
+      if (cache.key_presence_.active()) {
+        if (const absl::Time absent_time = cache.key_presence_.GetAbsentTime(
+                this->GetKeyValueStoreKey());
+            absent_time >= request.staleness_bound) {
+          // Known to be absent from a listing; no need to read.
+          ReadReceiverImpl<Entry>{this, std::move(read_state.data)}.set_value(
+              kvstore::ReadResult::Missing(absent_time));
+          return;
+        }
+      }
+      std::optional<absl::Cord> existing_encoded_value;
+      if (cache.encoded_value_cache_ &&
+          StorageGeneration::IsUnknown(
+              kvstore_options.generation_conditions.if_not_equal)) {
+        // The decoded value is not cached, but the encoded value may be.
+        if (auto encoded = GetEncodedValue(*cache.encoded_value_cache_,
+                                           this->GetKeyValueStoreKey())) {
+          KvsBackedCache_IncrementReadEncodedMetric();
+          if (encoded->stamp.time >= request.staleness_bound) {
+            this->DoDecode(std::move(encoded->value),
+                           DecodeReceiverImpl<Entry>{
+                               this, std::move(encoded->stamp)});
+            return;
+          }
+          kvstore_options.generation_conditions.if_not_equal =
+              std::move(encoded->stamp.generation);
+          existing_encoded_value = std::move(encoded->value);
+        }
+      }
+      internal_tracing::IncrementOperationStat(
+          &internal_tracing::OperationStatsState::kvstore_reads);
       auto future = cache.kvstore_driver_->Read(this->GetKeyValueStoreKey(),
                                                 std::move(kvstore_options));
-      execution::submit(
-          std::move(future),
-          ReadReceiverImpl<Entry>{this, std::move(read_state.data)});
+      if (request.promise.null()) {
+        execution::submit(std::move(future),
+                          ReadReceiverImpl<Entry>{
+                              this, std::move(read_state.data),
+                              std::move(existing_encoded_value)});
+        return;
+      }
+      // If no reader needs the result, abandon the read, which releases
+      // `future` and allows the kvstore to cancel the underlying request.
+      // Exactly one of the two callbacks completes the read.
+      auto done = std::make_shared<std::atomic<bool>>(false);
+      future.Force();
+      FutureCallbackRegistration ready_registration = future.ExecuteWhenReady(
+          [done, receiver = ReadReceiverImpl<Entry>{
+                     this, std::move(read_state.data),
+                     std::move(existing_encoded_value)}](
+              ReadyFuture<kvstore::ReadResult> future) mutable {
+            if (done->exchange(true)) return;
+            auto& result = future.result();
+            if (result.ok()) {
+              receiver.set_value(*result);
+            } else {
+              receiver.set_error(result.status());
+            }
+          });
+      future = {};
+      request.promise.ExecuteWhenNotNeeded(
+          [this, done,
+           ready_registration = std::move(ready_registration)]() mutable {
+            if (done->exchange(true)) return;
+            ready_registration.Unregister();
+            this->ReadError(absl::CancelledError("Read no longer needed"));
+          });
     }
 
     using DecodeReceiver =
@@ -251,6 +384,8 @@ class KvsBackedCache : public Parent {
           std::move(read_state.stamp.generation);
       kvstore_options.staleness_bound = request.staleness_bound;
       kvstore_options.batch = request.batch;
+      internal_tracing::IncrementOperationStat(
+          &internal_tracing::OperationStatsState::kvstore_reads);
       target_->KvsRead(
           std::move(kvstore_options),
           typename Entry::template ReadReceiverImpl<TransactionNode>{
@@ -491,10 +626,17 @@ class KvsBackedCache : public Parent {
     void KvsWritebackSuccess(
         TimestampedStorageGeneration new_stamp,
         const StorageGeneration& orig_generation) override {
-      if (orig_generation.LastMutatedBy(this->mutation_id_) ||
-          (!StorageGeneration::IsUnknown(new_data_generation_) &&
-           StorageGeneration::Condition(new_data_generation_,
-                                        orig_generation) == orig_generation)) {
+      auto& cache = GetOwningCache(*this);
+      if (cache.encoded_value_cache_) {
+        InvalidateEncodedValue(*cache.encoded_value_cache_,
+                               GetOwningEntry(*this).GetKeyValueStoreKey(),
+                               new_stamp.time);
+      }
+      if (cache.key_presence_.active()) {
+        cache.key_presence_.MarkPossiblyPresent(
+            GetOwningEntry(*this).GetKeyValueStoreKey());
+      }
+      if (IsNewDataWritten(orig_generation)) {
         this->WritebackSuccess(
             AsyncCache::ReadState{std::move(new_data_), std::move(new_stamp)});
       } else {
@@ -526,6 +668,22 @@ class KvsBackedCache : public Parent {
       return absl::AbortedError("Generation mismatch");
     }
 
+   protected:
+    /// Returns `true` if the value written back by a successful writeback,
+    /// based on the prior generation `orig_generation`, is `new_data()`, as
+    /// opposed to the writeback having been a no-op or overwritten during
+    /// commit.  Must only be called from `KvsWritebackSuccess`.
+    bool IsNewDataWritten(const StorageGeneration& orig_generation) const {
+      return orig_generation.LastMutatedBy(this->mutation_id_) ||
+             (!StorageGeneration::IsUnknown(new_data_generation_) &&
+              StorageGeneration::Condition(new_data_generation_,
+                                           orig_generation) == orig_generation);
+    }
+
+    /// New data for the cache if the writeback completes successfully.  Must
+    /// only be accessed from `KvsWritebackSuccess`.
+    const std::shared_ptr<const void>& new_data() const { return new_data_; }
+
    private:
     friend class KvsBackedCache;
 
@@ -550,6 +708,16 @@ class KvsBackedCache : public Parent {
   /// Returns the associated `kvstore::Driver`.
   kvstore::Driver* kvstore_driver() { return kvstore_driver_.get(); }
 
+  /// Reports metrics under the identifier of the `kvstore::Driver`.
+  std::string DoGetMetricsLabel() override {
+    if (kvstore_driver_) {
+      if (auto id = kvstore_driver_->driver_id(); !id.empty()) {
+        return std::string(id);
+      }
+    }
+    return Parent::DoGetMetricsLabel();
+  }
+
   /// Sets the `kvstore::Driver`.  The caller is responsible for ensuring
   /// there are no concurrent read or write operations.
   void SetKvStoreDriver(kvstore::DriverPtr driver) {
@@ -559,7 +727,21 @@ class KvsBackedCache : public Parent {
     kvstore_driver_ = std::move(driver);
   }
 
+  /// Sets the cache in which encoded values read from the kvstore are
+  /// retained, so that they may be decoded again after the decoded values are
+  /// evicted.  The caller is responsible for ensuring there are no concurrent
+  /// read or write operations.
+  void SetEncodedValueCache(CachePtr<EncodedValueCache> cache) {
+    encoded_value_cache_ = std::move(cache);
+  }
+
+  /// Returns the keys that may be present in the kvstore, which may be
+  /// populated from a listing to avoid reading absent keys.
+  KvsKeyPresence& key_presence() { return key_presence_; }
+
   kvstore::DriverPtr kvstore_driver_;
+  CachePtr<EncodedValueCache> encoded_value_cache_;
+  KvsKeyPresence key_presence_;
 };
 
 }  // namespace internal
@@ -124,6 +124,23 @@ TEST_F(MockStoreTest, ReadError) {
                             "Error reading \"a\": read error"));
 }
 
+TEST_F(MockStoreTest, ReadCancelled) {
+  auto entry = GetCacheEntry(cache, "a");
+  auto read_future = entry->Read({absl::Now()});
+  auto read_req = mock_store->read_requests.pop();
+  EXPECT_TRUE(read_req.promise.result_needed());
+
+  // Releasing the only reader abandons the kvstore read.
+  read_future = {};
+  EXPECT_FALSE(read_req.promise.result_needed());
+
+  // A subsequent read issues a new kvstore read.
+  auto read_future2 = entry->Read({absl::Now()});
+  auto read_req2 = mock_store->read_requests.pop();
+  read_req2(memory_store);
+  TENSORSTORE_EXPECT_OK(read_future2.result());
+}
+
 TEST_F(MockStoreTest, WriteError) {
   auto entry = GetCacheEntry(cache, "a");
 
@@ -15,8 +15,10 @@
 #include "tensorstore/internal/cache/kvs_backed_chunk_cache.h"
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <memory>
 #include <optional>
@@ -24,19 +26,46 @@
 #include <utility>
 
 #include "absl/base/attributes.h"
+#include "absl/base/no_destructor.h"
+#include "absl/base/optimization.h"
+#include "absl/base/thread_annotations.h"
 #include "absl/container/fixed_array.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/inlined_vector.h"
+#include "absl/log/absl_log.h"
+#include "absl/random/random.h"
+#include "absl/status/status.h"
 #include "absl/strings/cord.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include <nlohmann/json.hpp>
 #include "tensorstore/array.h"
 #include "tensorstore/index.h"
 #include "tensorstore/internal/cache/async_cache.h"
 #include "tensorstore/internal/cache/cache.h"
 #include "tensorstore/internal/cache/chunk_cache.h"
+#include "tensorstore/internal/cache/chunk_summary.h"
+#include "tensorstore/internal/cache/encoded_value_cache.h"
 #include "tensorstore/internal/cache/kvs_backed_cache.h"
+#include "tensorstore/internal/chunk_buffer_pool.h"
 #include "tensorstore/internal/log/verbose_flag.h"
 #include "tensorstore/internal/memory.h"
+#include "tensorstore/internal/mutex.h"
+#include "tensorstore/internal/os/numa.h"
 #include "tensorstore/internal/tracing/logged_trace_span.h"
+#include "tensorstore/internal/tracing/operation_stats.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/driver.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_modify_write.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/transaction.h"
 #include "tensorstore/util/execution/execution.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
 #include "tensorstore/util/result.h"
 #include "tensorstore/util/span.h"
 #include "tensorstore/util/status.h"
@@ -47,6 +76,118 @@ namespace internal {
 namespace {
 ABSL_CONST_INIT internal_log::VerboseFlag verbose_logging(
     "kvs_backed_chunk_cache");
+
+/// Returns the key-value store opened from `url`, which is shared by all
+/// transactions that spill to it.
+Future<kvstore::KvStore> GetSpillKvStore(const std::string& url) {
+  struct SpillKvStores {
+    absl::Mutex mutex;
+    absl::flat_hash_map<std::string, Future<kvstore::KvStore>> stores
+        ABSL_GUARDED_BY(mutex);
+  };
+  static absl::NoDestructor<SpillKvStores> spill_kvstores;
+  absl::MutexLock lock(&spill_kvstores->mutex);
+  auto& future = spill_kvstores->stores[url];
+  if (future.null() || (future.ready() && !future.status().ok())) {
+    future = kvstore::Open(::nlohmann::json(url));
+  }
+  return future;
+}
+
+/// Returns a new key, unique within the process, for a spilled value.
+std::string GetNewSpillKey() {
+  static const uint64_t process_id = [] {
+    absl::BitGen gen;
+    return absl::Uniform<uint64_t>(gen);
+  }();
+  static std::atomic<uint64_t> next_id{0};
+  return absl::StrCat("tensorstore_spill_", absl::Hex(process_id),
+                      "_", next_id.fetch_add(1, std::memory_order_relaxed));
+}
+
+/// Writes the summary of the chunk `components` with the specified
+/// `generation` (or deletes it, if the chunk is deleted).  Errors are ignored,
+/// since a summary that is missing or out of date is not used.
+void WriteChunkSummary(KvsBackedChunkCache& cache,
+                       span<const Index> cell_indices,
+                       const StorageGeneration& generation,
+                       const ChunkCache::ReadData* components) {
+  std::string key = cache.GetChunkSummaryKey(cell_indices);
+  if (key.empty() || StorageGeneration::IsUnknown(generation)) return;
+  kvstore::KvStore store(kvstore::DriverPtr(cache.kvstore_driver()));
+  if (!components || StorageGeneration::IsNoValue(generation)) {
+    kvstore::Delete(store, key).IgnoreFuture();
+    return;
+  }
+  auto& grid = cache.grid();
+  ChunkSummary summary;
+  summary.generation = generation;
+  for (size_t i = 0; i < grid.components.size(); ++i) {
+    auto& component_spec = grid.components[i];
+    if (!IsChunkSummarySupported(component_spec.dtype())) return;
+    auto fill_value = component_spec.array_spec.GetFillValueForDomain(
+        grid.GetCellDomain(i, cell_indices));
+    auto& component_summary = summary.components.emplace_back();
+    if (components[i].valid()) {
+      component_summary =
+          ComputeChunkComponentSummary(components[i], fill_value);
+    } else {
+      component_summary.num_elements = fill_value.num_elements();
+    }
+  }
+  kvstore::Write(store, key, EncodeChunkSummary(summary)).IgnoreFuture();
+}
+
+}  // namespace
+
+std::string KvsBackedChunkCache::GetChunkSummaryKey(
+    span<const Index> cell_indices) {
+  return {};
+}
+
+Future<bool> KvsBackedChunkCache::ChunkMayContainValueInRange(
+    span<const Index> cell_indices, size_t component_index, ValueRange range,
+    absl::Time staleness_bound) {
+  auto& component_spec = grid().components[component_index];
+  // The fill value is not necessarily uniform, and is summarized like a
+  // chunk.
+  const bool fill_value_in_range = IntersectsValueRange(
+      ComputeChunkComponentSummary(
+          component_spec.array_spec.GetFillValueForDomain(
+              grid().GetCellDomain(component_index, cell_indices))),
+      range);
+  std::string summary_key = GetChunkSummaryKey(cell_indices);
+  if (summary_key.empty() ||
+      !IsChunkSummarySupported(component_spec.dtype())) {
+    return MakeReadyFuture<bool>(true);
+  }
+  kvstore::ReadOptions stat_options;
+  stat_options.staleness_bound = staleness_bound;
+  stat_options.byte_range = OptionalByteRangeRequest::Stat();
+  auto chunk_future = kvstore_driver()->Read(GetChunkStorageKey(cell_indices),
+                                             std::move(stat_options));
+  kvstore::ReadOptions summary_options;
+  summary_options.staleness_bound = staleness_bound;
+  auto summary_future = kvstore_driver()->Read(std::move(summary_key),
+                                               std::move(summary_options));
+  return MapFuture(
+      InlineExecutor{},
+      [component_index, range, fill_value_in_range](
+          const Result<kvstore::ReadResult>& chunk,
+          const Result<kvstore::ReadResult>& summary) -> Result<bool> {
+        TENSORSTORE_RETURN_IF_ERROR(chunk);
+        if (!chunk->has_value()) return fill_value_in_range;
+        if (!summary.ok() || !summary->has_value()) return true;
+        auto decoded = DecodeChunkSummary(summary->value);
+        if (!decoded.ok() ||
+            decoded->generation != chunk->stamp.generation ||
+            component_index >= decoded->components.size()) {
+          return true;
+        }
+        return MayContainValueInRange(decoded->components[component_index],
+                                      range, fill_value_in_range);
+      },
+      std::move(chunk_future), std::move(summary_future));
 }
 
 std::string KvsBackedChunkCache::Entry::GetKeyValueStoreKey() {
@@ -54,8 +195,19 @@ std::string KvsBackedChunkCache::Entry::GetKeyValueStoreKey() {
   return cache.GetChunkStorageKey(this->cell_indices());
 }
 
+bool KvsBackedChunkCache::Entry::IsKnownMissing(absl::Time staleness_bound) {
+  if (ChunkCache::Entry::IsKnownMissing(staleness_bound)) return true;
+  auto& cache = GetOwningCache(*this);
+  return cache.key_presence().active() &&
+         cache.key_presence().GetAbsentTime(GetKeyValueStoreKey()) >=
+             staleness_bound;
+}
+
 void KvsBackedChunkCache::Entry::DoDecode(std::optional<absl::Cord> value,
                                           DecodeReceiver receiver) {
+  // Re-decode on the node that holds the previously decoded data, if any.
+  internal_os::ScopedPreferredNumaNode numa_scope(
+      numa_node.load(std::memory_order_relaxed));
   GetOwningCache(*this).executor()([this, value = std::move(value),
                                     receiver = std::move(receiver)]() mutable {
     if (!value) {
@@ -66,8 +218,15 @@ void KvsBackedChunkCache::Entry::DoDecode(std::optional<absl::Cord> value,
     internal_tracing::LoggedTraceSpan trace_span(
         __func__, verbose_logging.Level(2),
         {{"cache", static_cast<void*>(&cache)}});
-    auto decoded_result =
-        cache.DecodeChunk(this->cell_indices(), *std::move(value));
+    // Chunk decoders allocate the decoded arrays from the buffer pool, which
+    // is the same for all components.
+    internal::ScopedChunkBufferPool buffer_pool_scope(
+        this->component_specs()[0].array_spec.buffer_pool.get());
+    auto decoded_result = [&] {
+      internal_tracing::ScopedOperationTimer decode_timer(
+          &internal_tracing::OperationStatsState::decode_nanoseconds);
+      return cache.DecodeChunk(this->cell_indices(), *std::move(value));
+    }();
     if (!decoded_result.ok()) {
       auto status = internal::ConvertInvalidArgumentToFailedPrecondition(
           std::move(decoded_result).status());
@@ -80,6 +239,9 @@ void KvsBackedChunkCache::Entry::DoDecode(std::optional<absl::Cord> value,
         internal::make_shared_for_overwrite<ReadData[]>(num_components);
     assert(decoded_result->size() == num_components);
     std::copy_n(decoded_result->begin(), num_components, new_read_data.get());
+    // The decoded arrays were first touched by this thread.
+    numa_node.store(internal_os::GetCurrentNumaNode(),
+                    std::memory_order_relaxed);
     execution::set_value(
         receiver, std::static_pointer_cast<ReadData>(std::move(new_read_data)));
   });
@@ -136,5 +298,207 @@ std::string KvsBackedChunkCache::Entry::DescribeChunk() {
                                  cache.GetChunkStorageKey(cell_indices)));
 }
 
+KvsBackedChunkCache::TransactionNode::~TransactionNode() {
+  if (!spill_key_.empty()) {
+    kvstore::Delete(spill_kvstore_, spill_key_).IgnoreFuture();
+  }
+}
+
+bool KvsBackedChunkCache::TransactionNode::Spill() {
+  auto& transaction = *this->transaction();
+  if (transaction.spill_kvstore().empty() ||
+      (transaction.mode() & repeatable_read) || transaction.commit_started()) {
+    return false;
+  }
+  {
+    // Waits for any in-progress write.
+    UniqueWriterLock<AsyncCache::TransactionNode> lock(*this);
+    // Only completely overwritten chunks are spilled, since the encoded value
+    // of a partially-written chunk depends on the existing value.
+    if (spilled_.load(std::memory_order_relaxed) || this->IsRevoked() ||
+        !this->IsUnconditional() || !this->is_modified) {
+      return false;
+    }
+  }
+  {
+    // The node may only be spilled if no read or write operation holds a
+    // reference to it; the transaction and the caller each own one.  Holding
+    // the entry lock prevents `GetTransactionNode` from concurrently acquiring
+    // another reference, and once revoked, it never will.
+    UniqueWriterLock lock(GetOwningEntry(*this));
+    if (this->use_count() != 2) return false;
+    this->Revoke();
+  }
+  ABSL_LOG_IF(INFO, verbose_logging)
+      << GetOwningEntry(*this).DescribeChunk() << ": Spilling";
+
+  struct EncodeReceiverImpl {
+    WeakTransactionNodePtr<TransactionNode> self_;
+    TimestampedStorageGeneration stamp_;
+    void set_error(absl::Status error) {
+      ABSL_LOG_IF(INFO, verbose_logging)
+          << GetOwningEntry(*self_).DescribeChunk()
+          << ": Failed to spill: " << error;
+      self_->SpillDone();
+    }
+    void set_cancel() { ABSL_UNREACHABLE(); }  // COV_NF_LINE
+    void set_value(std::optional<absl::Cord> value) {
+      if (!value) {
+        self_->SpillWritten(std::move(stamp_), {}, {});
+        return;
+      }
+      auto* self = self_.get();
+      GetSpillKvStore(self->transaction()->spill_kvstore())
+          .ExecuteWhenReady([receiver = std::move(*this),
+                             value = *std::move(value)](
+                                ReadyFuture<kvstore::KvStore> future) mutable {
+            TENSORSTORE_ASSIGN_OR_RETURN(
+                auto store, future.result(),
+                execution::set_error(receiver, std::move(_)));
+            auto key = GetNewSpillKey();
+            auto write_future = kvstore::Write(store, key, std::move(value));
+            std::move(write_future)
+                .ExecuteWhenReady(
+                    [receiver = std::move(receiver), store = std::move(store),
+                     key = std::move(key)](
+                        ReadyFuture<TimestampedStorageGeneration>
+                            future) mutable {
+                      TENSORSTORE_RETURN_IF_ERROR(
+                          future.status(),
+                          execution::set_error(receiver, std::move(_)));
+                      receiver.self_->SpillWritten(std::move(receiver.stamp_),
+                                                   std::move(store),
+                                                   std::move(key));
+                    });
+          });
+    }
+  };
+
+  struct ApplyReceiverImpl {
+    WeakTransactionNodePtr<TransactionNode> self_;
+    void set_error(absl::Status error) {
+      EncodeReceiverImpl{std::move(self_), {}}.set_error(std::move(error));
+    }
+    void set_cancel() { ABSL_UNREACHABLE(); }  // COV_NF_LINE
+    void set_value(AsyncCache::ReadState update) {
+      auto& entry = GetOwningEntry(*self_);
+      entry.DoEncode(
+          {}, std::static_pointer_cast<const ReadData>(std::move(update.data)),
+          EncodeReceiverImpl{std::move(self_), std::move(update.stamp)});
+    }
+  };
+
+  ApplyOptions apply_options;
+  apply_options.staleness_bound = absl::InfinitePast();
+  apply_options.apply_mode = ApplyOptions::kNormal;
+  this->DoApply(
+      std::move(apply_options),
+      ApplyReceiverImpl{WeakTransactionNodePtr<TransactionNode>(this)});
+  return true;
+}
+
+void KvsBackedChunkCache::TransactionNode::SpillWritten(
+    TimestampedStorageGeneration stamp, kvstore::KvStore store,
+    std::string key) {
+  {
+    UniqueWriterLock<AsyncCache::TransactionNode> lock(*this);
+    spilled_stamp_ = std::move(stamp);
+    spill_kvstore_ = std::move(store);
+    spill_key_ = std::move(key);
+    spilled_.store(true, std::memory_order_release);
+    for (auto& component : this->components()) {
+      component.write_state.Clear();
+    }
+    this->MarkSizeUpdated();
+  }
+  this->SpillDone();
+}
+
+void KvsBackedChunkCache::TransactionNode::KvsWriteback(
+    ReadModifyWriteSource::WritebackOptions options,
+    ReadModifyWriteSource::WritebackReceiver receiver) {
+  if (!spilled_.load(std::memory_order_acquire)) {
+    Base::TransactionNode::KvsWriteback(std::move(options),
+                                        std::move(receiver));
+    return;
+  }
+  if (!StorageGeneration::IsUnknown(
+          options.generation_conditions.if_not_equal) &&
+      options.generation_conditions.if_not_equal ==
+          spilled_stamp_.generation) {
+    execution::set_value(receiver,
+                         kvstore::ReadResult::Unspecified(spilled_stamp_));
+    return;
+  }
+  if (spill_key_.empty()) {
+    execution::set_value(receiver,
+                         kvstore::ReadResult::Missing(spilled_stamp_));
+    return;
+  }
+  switch (options.writeback_mode) {
+    case ReadModifyWriteSource::kValidateOnly:
+    case ReadModifyWriteSource::kValueDiscarded:
+    case ReadModifyWriteSource::kValueDiscardedSpecifyUnchanged:
+      // The value itself is not needed.
+      execution::set_value(
+          receiver, kvstore::ReadResult::Value(absl::Cord(), spilled_stamp_));
+      return;
+    default:
+      break;
+  }
+  kvstore::Read(spill_kvstore_, spill_key_)
+      .ExecuteWhenReady([this, receiver = std::move(receiver)](
+                            ReadyFuture<kvstore::ReadResult> future) mutable {
+        auto& r = future.result();
+        if (!r.ok()) {
+          execution::set_error(receiver, GetOwningEntry(*this).AnnotateError(
+                                             r.status(), /*reading=*/false));
+          return;
+        }
+        if (!r->has_value()) {
+          execution::set_error(
+              receiver, GetOwningEntry(*this).AnnotateError(
+                            absl::DataLossError(tensorstore::StrCat(
+                                "Spilled value ",
+                                spill_kvstore_.driver->DescribeKey(
+                                    spill_kvstore_.path + spill_key_),
+                                " is missing")),
+                            /*reading=*/false));
+          return;
+        }
+        execution::set_value(
+            receiver,
+            kvstore::ReadResult::Value(std::move(r->value), spilled_stamp_));
+      });
+}
+
+void KvsBackedChunkCache::TransactionNode::KvsWritebackSuccess(
+    TimestampedStorageGeneration new_stamp,
+    const StorageGeneration& orig_generation) {
+  if (!spilled_.load(std::memory_order_acquire)) {
+    auto& cache = GetOwningCache(*this);
+    if (cache.chunk_summaries_enabled() &&
+        IsNewDataWritten(orig_generation)) {
+      WriteChunkSummary(
+          cache, GetOwningEntry(*this).cell_indices(), new_stamp.generation,
+          static_cast<const ReadData*>(new_data().get()));
+    }
+    Base::TransactionNode::KvsWritebackSuccess(std::move(new_stamp),
+                                               orig_generation);
+    return;
+  }
+  // The decoded value is no longer in memory, so the cached read state is
+  // simply invalidated.
+  auto& cache = GetOwningCache(*this);
+  const std::string key = GetOwningEntry(*this).GetKeyValueStoreKey();
+  if (cache.encoded_value_cache_) {
+    InvalidateEncodedValue(*cache.encoded_value_cache_, key, new_stamp.time);
+  }
+  if (cache.key_presence().active()) {
+    cache.key_presence().MarkPossiblyPresent(key);
+  }
+  this->WritebackSuccess(AsyncCache::ReadState{});
+}
+
 }  // namespace internal
 }  // namespace tensorstore
@@ -17,17 +17,24 @@
 
 #include <stddef.h>
 
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <string>
 
 #include "absl/container/inlined_vector.h"
 #include "absl/strings/cord.h"
+#include "absl/time/time.h"
 #include "tensorstore/array.h"
 #include "tensorstore/index.h"
 #include "tensorstore/internal/cache/async_cache.h"
 #include "tensorstore/internal/cache/chunk_cache.h"
+#include "tensorstore/internal/cache/chunk_summary.h"
 #include "tensorstore/internal/cache/kvs_backed_cache.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/read_modify_write.h"
+#include "tensorstore/util/future.h"
 #include "tensorstore/util/result.h"
 #include "tensorstore/util/span.h"
 
@@ -48,6 +55,40 @@ class KvsBackedChunkCache
 
   virtual std::string GetChunkStorageKey(span<const Index> cell_indices) = 0;
 
+  /// Returns the key under which the summary of the values of the chunk (see
+  /// `chunk_summary.h`) is stored, or an empty string if chunk summaries are
+  /// not supported.
+  ///
+  /// The default implementation returns an empty string.
+  virtual std::string GetChunkSummaryKey(span<const Index> cell_indices);
+
+  /// Enables writing the summary of each chunk, after the chunk itself has
+  /// been written back.
+  void EnableChunkSummaries() {
+    chunk_summaries_.store(true, std::memory_order_relaxed);
+  }
+
+  /// Returns `true` if `EnableChunkSummaries` has been called.
+  bool chunk_summaries_enabled() const {
+    return chunk_summaries_.load(std::memory_order_relaxed);
+  }
+
+  /// Determines from the stored chunk summary whether the stored chunk may
+  /// contain a value of the specified component within `range`.
+  ///
+  /// Resolves to `true` if the summary is missing or out of date.  Modified
+  /// chunks that have not yet been written back are not taken into account.
+  ///
+  /// \param cell_indices The grid cell indices of the chunk.
+  /// \param component_index The component index.
+  /// \param range The range of values.
+  /// \param staleness_bound Time bound for reading the chunk generation and
+  ///     the summary.
+  Future<bool> ChunkMayContainValueInRange(span<const Index> cell_indices,
+                                           size_t component_index,
+                                           ValueRange range,
+                                           absl::Time staleness_bound);
+
   /// Decodes a data chunk.
   ///
   /// \param data The encoded chunk data.
@@ -79,6 +120,46 @@ class KvsBackedChunkCache
                   EncodeReceiver receiver) override;
     std::string GetKeyValueStoreKey() override;
     std::string DescribeChunk() override;
+    bool IsKnownMissing(absl::Time staleness_bound) override;
+  };
+
+  /// Transaction node that supports spilling completely overwritten chunks to
+  /// the key-value store specified by `TransactionOptions::spill_kvstore`.
+  class TransactionNode : public Base::TransactionNode {
+   public:
+    using OwningCache = KvsBackedChunkCache;
+    using Base::TransactionNode::TransactionNode;
+
+    ~TransactionNode() override;
+
+    bool Spill() override;
+
+    void KvsWriteback(
+        ReadModifyWriteSource::WritebackOptions options,
+        ReadModifyWriteSource::WritebackReceiver receiver) override;
+
+    void KvsWritebackSuccess(
+        TimestampedStorageGeneration new_stamp,
+        const StorageGeneration& orig_generation) override;
+
+   private:
+    /// Records that the encoded value with the specified `stamp` has been
+    /// written to `store` under `key` (or that the chunk is deleted, if `key`
+    /// is empty), and releases the in-memory modifications.
+    void SpillWritten(TimestampedStorageGeneration stamp,
+                      kvstore::KvStore store, std::string key);
+
+    /// Set once the modifications have been spilled, after which the members
+    /// below are not modified.
+    std::atomic<bool> spilled_{false};
+
+    /// Stamp of the spilled value, returned by `KvsWriteback`.
+    TimestampedStorageGeneration spilled_stamp_;
+
+    /// Key-value store and key of the spilled value.  `spill_key_` is empty if
+    /// the chunk is deleted.
+    kvstore::KvStore spill_kvstore_;
+    std::string spill_key_;
   };
 
   Entry* DoAllocateEntry() override { return new Entry; }
@@ -87,6 +168,9 @@ class KvsBackedChunkCache
       AsyncCache::Entry& entry) override {
     return new TransactionNode(static_cast<Entry&>(entry));
   }
+
+ private:
+  std::atomic<bool> chunk_summaries_{false};
 };
 
 }  // namespace internal
@@ -0,0 +1,135 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/chunk_buffer_pool.h"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include <stddef.h>
+
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "absl/numeric/bits.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/util/division.h"
+
+namespace tensorstore {
+namespace internal {
+namespace {
+thread_local ChunkBufferPool* current_chunk_buffer_pool = nullptr;
+}  // namespace
+
+ChunkBufferPool::~ChunkBufferPool() {
+  absl::MutexLock lock(&mutex_);
+  for (auto& [size_class, buffers] : free_buffers_) {
+    const size_t alignment = GetBufferAlignment(size_class);
+    for (void* buffer : buffers) {
+      ::operator delete(buffer, std::align_val_t(alignment));
+    }
+  }
+}
+
+size_t ChunkBufferPool::GetSizeClass(size_t size) {
+  if (size <= kAlignment) return kAlignment;
+  // Round up to a multiple of a quarter of the largest power of two that is
+  // less than `size`.
+  const size_t step = size_t(1) << (absl::bit_width(size - 1) - 3);
+  return RoundUpTo(size, step);
+}
+
+size_t ChunkBufferPool::GetBufferAlignment(size_t size_class) const {
+  return (options_.huge_pages && size_class >= kHugePageSize) ? kHugePageSize
+                                                              : kAlignment;
+}
+
+std::shared_ptr<void> ChunkBufferPool::Allocate(
+    ptrdiff_t n, ElementInitialization initialization, DataType dtype) {
+  assert(n >= 0);
+  assert(static_cast<size_t>(dtype->alignment) <= kAlignment);
+  const size_t size = static_cast<size_t>(n) * dtype->size;
+  size_t size_class = GetSizeClass(size);
+  if (GetBufferAlignment(size_class) == kHugePageSize) {
+    size_class = RoundUpTo(size_class, kHugePageSize);
+  }
+  void* buffer = AllocateBuffer(size_class);
+  if (initialization == value_init) {
+    // As in `AllocateAndConstruct`.
+    std::memset(buffer, 0, size);
+  }
+  dtype->construct(n, buffer);
+  return std::shared_ptr<void>(
+      buffer, [self = IntrusivePtr<ChunkBufferPool>(this), n, dtype,
+               size_class](void* buffer) {
+        dtype->destroy(n, buffer);
+        self->ReleaseBuffer(buffer, size_class);
+      });
+}
+
+void* ChunkBufferPool::AllocateBuffer(size_t size_class) {
+  {
+    absl::MutexLock lock(&mutex_);
+    if (auto it = free_buffers_.find(size_class);
+        it != free_buffers_.end() && !it->second.empty()) {
+      void* buffer = it->second.back();
+      it->second.pop_back();
+      cached_bytes_ -= size_class;
+      return buffer;
+    }
+  }
+  const size_t alignment = GetBufferAlignment(size_class);
+  void* buffer = ::operator new(size_class, std::align_val_t(alignment));
+#ifdef __linux__
+  if (alignment == kHugePageSize) {
+    // Failure is not an error; the buffer just uses regular pages.
+    ::madvise(buffer, size_class, MADV_HUGEPAGE);
+  }
+#endif
+  return buffer;
+}
+
+void ChunkBufferPool::ReleaseBuffer(void* buffer, size_t size_class) {
+  {
+    absl::MutexLock lock(&mutex_);
+    if (cached_bytes_ + size_class <= options_.total_bytes_limit) {
+      free_buffers_[size_class].push_back(buffer);
+      cached_bytes_ += size_class;
+      return;
+    }
+  }
+  ::operator delete(buffer, std::align_val_t(GetBufferAlignment(size_class)));
+}
+
+ChunkBufferPool* GetCurrentChunkBufferPool() {
+  return current_chunk_buffer_pool;
+}
+
+ScopedChunkBufferPool::ScopedChunkBufferPool(ChunkBufferPool* pool)
+    : previous_(current_chunk_buffer_pool) {
+  current_chunk_buffer_pool = pool;
+}
+
+ScopedChunkBufferPool::~ScopedChunkBufferPool() {
+  current_chunk_buffer_pool = previous_;
+}
+
+}  // namespace internal
+}  // namespace tensorstore
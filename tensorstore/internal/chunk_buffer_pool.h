@@ -0,0 +1,149 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_CHUNK_BUFFER_POOL_H_
+#define TENSORSTORE_INTERNAL_CHUNK_BUFFER_POOL_H_
+
+/// \file
+///
+/// Pool of recycled buffers for chunk arrays.
+///
+/// Chunk caches allocate a new array for every chunk that is decoded or
+/// written, and free it when the chunk is evicted.  For streaming workloads,
+/// which allocate and free same-sized chunks at a high rate, the cost of these
+/// allocations, and of the page faults on freshly mapped memory, can dominate.
+/// A `ChunkBufferPool` retains freed buffers, grouped by size class, for reuse
+/// by later allocations.
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/array.h"
+#include "tensorstore/contiguous_layout.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/index.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/strided_layout.h"
+#include "tensorstore/util/element_pointer.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal {
+
+class ChunkBufferPool : public AtomicReferenceCount<ChunkBufferPool> {
+ public:
+  struct Options {
+    /// Limit on the total size of the buffers retained for reuse.  Buffers
+    /// that are freed once the limit is reached are returned to the system.
+    size_t total_bytes_limit = 0;
+
+    /// Allocate buffers of at least 2MiB aligned to, and advised for, huge
+    /// pages.  Only supported on Linux.
+    bool huge_pages = false;
+
+    constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+      return f(x.total_bytes_limit, x.huge_pages);
+    };
+  };
+
+  /// Alignment of all buffers.
+  constexpr static size_t kAlignment = 64;
+
+  /// Minimum buffer size, and alignment, for `Options::huge_pages`.
+  constexpr static size_t kHugePageSize = size_t(2) << 20;
+
+  explicit ChunkBufferPool(Options options) : options_(options) {}
+  ~ChunkBufferPool();
+
+  const Options& options() const { return options_; }
+
+  /// Returns the size of the buffer used for an allocation of `size` bytes.
+  ///
+  /// Sizes are rounded up to one of four classes per power of two, which
+  /// bounds the unused space to 25%.
+  static size_t GetSizeClass(size_t size);
+
+  /// Allocates and constructs `n` elements of `dtype`, like
+  /// `AllocateAndConstructShared`.
+  ///
+  /// When the returned pointer is released, the elements are destroyed and
+  /// the buffer is retained for reuse, subject to `total_bytes_limit`.
+  std::shared_ptr<void> Allocate(ptrdiff_t n,
+                                 ElementInitialization initialization,
+                                 DataType dtype);
+
+  /// Returns the total size of the buffers retained for reuse.
+  size_t cached_bytes() const {
+    absl::MutexLock lock(&mutex_);
+    return cached_bytes_;
+  }
+
+ private:
+  void* AllocateBuffer(size_t size_class);
+  void ReleaseBuffer(void* buffer, size_t size_class);
+  size_t GetBufferAlignment(size_t size_class) const;
+
+  const Options options_;
+  mutable absl::Mutex mutex_;
+  absl::flat_hash_map<size_t, std::vector<void*>> free_buffers_
+      ABSL_GUARDED_BY(mutex_);
+  size_t cached_bytes_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+/// Returns the pool set for the current thread by `ScopedChunkBufferPool`, or
+/// `nullptr`.
+ChunkBufferPool* GetCurrentChunkBufferPool();
+
+/// Sets the pool from which the current thread allocates chunk arrays, for
+/// code such as chunk decoders that does not otherwise have access to it.
+class ScopedChunkBufferPool {
+ public:
+  explicit ScopedChunkBufferPool(ChunkBufferPool* pool);
+  ~ScopedChunkBufferPool();
+
+  ScopedChunkBufferPool(const ScopedChunkBufferPool&) = delete;
+  ScopedChunkBufferPool& operator=(const ScopedChunkBufferPool&) = delete;
+
+ private:
+  ChunkBufferPool* previous_;
+};
+
+/// Allocates a contiguous array like `tensorstore::AllocateArray`, from `pool`
+/// if it is not `nullptr`.
+template <typename LayoutOrder = ContiguousLayoutOrder>
+SharedArray<void> AllocateChunkArray(ChunkBufferPool* pool,
+                                     span<const Index> shape,
+                                     LayoutOrder layout_order,
+                                     ElementInitialization initialization,
+                                     DataType dtype) {
+  if (!pool) {
+    return tensorstore::AllocateArray(shape, layout_order, initialization,
+                                      dtype);
+  }
+  StridedLayout<> layout(layout_order, dtype.size(), shape);
+  return {SharedElementPointer<void>(
+              pool->Allocate(layout.num_elements(), initialization, dtype),
+              dtype),
+          std::move(layout)};
+}
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_CHUNK_BUFFER_POOL_H_
@@ -0,0 +1,62 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/chunk_buffer_pool_resource.h"
+
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/context_resource_provider.h"
+#include "tensorstore/internal/chunk_buffer_pool.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal {
+namespace {
+
+namespace jb = tensorstore::internal_json_binding;
+
+struct ChunkBufferPoolResourceTraits
+    : public ContextResourceTraits<ChunkBufferPoolResource> {
+  using Spec = ChunkBufferPool::Options;
+  using Resource = typename ChunkBufferPoolResource::Resource;
+  static constexpr Spec Default() { return {}; }
+  static constexpr auto JsonBinder() {
+    return jb::Object(
+        jb::Member("total_bytes_limit",
+                   jb::Projection(&Spec::total_bytes_limit,
+                                  jb::DefaultValue([](auto* v) { *v = 0; }))),
+        jb::Member("huge_pages",
+                   jb::Projection(&Spec::huge_pages,
+                                  jb::DefaultValue([](auto* v) {
+                                    *v = false;
+                                  }))));
+  }
+  static Result<Resource> Create(const Spec& options,
+                                 ContextResourceCreationContext context) {
+    return MakeIntrusivePtr<ChunkBufferPool>(options);
+  }
+
+  static Spec GetSpec(const Resource& pool, const ContextSpecBuilder& builder) {
+    return pool->options();
+  }
+};
+
+const ContextResourceRegistration<ChunkBufferPoolResourceTraits> registration;
+
+}  // namespace
+}  // namespace internal
+}  // namespace tensorstore
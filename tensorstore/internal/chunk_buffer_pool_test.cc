@@ -0,0 +1,147 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/chunk_buffer_pool.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include "tensorstore/array.h"
+#include "tensorstore/context.h"
+#include "tensorstore/contiguous_layout.h"
+#include "tensorstore/data_type.h"
+#include "tensorstore/index.h"
+#include "tensorstore/internal/chunk_buffer_pool_resource.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::Context;
+using ::tensorstore::dtype_v;
+using ::tensorstore::Index;
+using ::tensorstore::internal::AllocateChunkArray;
+using ::tensorstore::internal::ChunkBufferPool;
+using ::tensorstore::internal::ChunkBufferPoolResource;
+using ::tensorstore::internal::GetCurrentChunkBufferPool;
+using ::tensorstore::internal::MakeIntrusivePtr;
+using ::tensorstore::internal::ScopedChunkBufferPool;
+
+TEST(ChunkBufferPoolTest, GetSizeClass) {
+  EXPECT_EQ(64, ChunkBufferPool::GetSizeClass(0));
+  EXPECT_EQ(64, ChunkBufferPool::GetSizeClass(64));
+  EXPECT_EQ(80, ChunkBufferPool::GetSizeClass(65));
+  EXPECT_EQ(128, ChunkBufferPool::GetSizeClass(128));
+  EXPECT_EQ(160, ChunkBufferPool::GetSizeClass(129));
+  EXPECT_EQ(1 << 20, ChunkBufferPool::GetSizeClass(1 << 20));
+  EXPECT_EQ(5 << 18, ChunkBufferPool::GetSizeClass((1 << 20) + 1));
+}
+
+TEST(ChunkBufferPoolTest, Reuse) {
+  auto pool = MakeIntrusivePtr<ChunkBufferPool>(
+      ChunkBufferPool::Options{/*total_bytes_limit=*/4096});
+  void* data;
+  {
+    auto buffer = pool->Allocate(100, tensorstore::default_init,
+                                 dtype_v<int32_t>);
+    data = buffer.get();
+    EXPECT_EQ(0,
+              reinterpret_cast<uintptr_t>(data) % ChunkBufferPool::kAlignment);
+  }
+  EXPECT_EQ(448, pool->cached_bytes());
+  // Same size class.
+  auto buffer =
+      pool->Allocate(110, tensorstore::value_init, dtype_v<int32_t>);
+  EXPECT_EQ(data, buffer.get());
+  EXPECT_EQ(0, pool->cached_bytes());
+  EXPECT_EQ(0, static_cast<int32_t*>(buffer.get())[109]);
+}
+
+TEST(ChunkBufferPoolTest, TotalBytesLimit) {
+  auto pool = MakeIntrusivePtr<ChunkBufferPool>(
+      ChunkBufferPool::Options{/*total_bytes_limit=*/1024});
+  auto a = pool->Allocate(1024, tensorstore::default_init, dtype_v<uint8_t>);
+  auto b = pool->Allocate(1024, tensorstore::default_init, dtype_v<uint8_t>);
+  a = nullptr;
+  b = nullptr;
+  EXPECT_EQ(1024, pool->cached_bytes());
+}
+
+TEST(ChunkBufferPoolTest, HugePages) {
+  auto pool = MakeIntrusivePtr<ChunkBufferPool>(ChunkBufferPool::Options{
+      /*total_bytes_limit=*/0, /*huge_pages=*/true});
+  auto buffer = pool->Allocate(ChunkBufferPool::kHugePageSize + 1,
+                               tensorstore::default_init, dtype_v<uint8_t>);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(buffer.get()) %
+                   ChunkBufferPool::kHugePageSize);
+}
+
+TEST(ChunkBufferPoolTest, NonTrivialDataType) {
+  auto pool = MakeIntrusivePtr<ChunkBufferPool>(
+      ChunkBufferPool::Options{/*total_bytes_limit=*/4096});
+  for (int i = 0; i < 2; ++i) {
+    auto array = AllocateChunkArray(pool.get(), {{2, 3}}, tensorstore::c_order,
+                                    tensorstore::value_init,
+                                    dtype_v<std::string>);
+    auto* data = static_cast<std::string*>(array.data());
+    EXPECT_EQ("", data[5]);
+    data[5] = std::string(100, 'x');
+  }
+}
+
+TEST(ChunkBufferPoolTest, AllocateChunkArray) {
+  auto pool = MakeIntrusivePtr<ChunkBufferPool>(
+      ChunkBufferPool::Options{/*total_bytes_limit=*/4096});
+  for (ChunkBufferPool* p :
+       {pool.get(), static_cast<ChunkBufferPool*>(nullptr)}) {
+    auto array = AllocateChunkArray(p, {{2, 3}}, tensorstore::fortran_order,
+                                    tensorstore::value_init, dtype_v<int16_t>);
+    EXPECT_EQ(array, tensorstore::AllocateArray<int16_t>(
+                         {2, 3}, tensorstore::fortran_order,
+                         tensorstore::value_init));
+    EXPECT_THAT(array.byte_strides(), ::testing::ElementsAre(2, 4));
+  }
+}
+
+TEST(ChunkBufferPoolTest, Scoped) {
+  auto pool = MakeIntrusivePtr<ChunkBufferPool>(ChunkBufferPool::Options{});
+  EXPECT_EQ(nullptr, GetCurrentChunkBufferPool());
+  {
+    ScopedChunkBufferPool scope(pool.get());
+    EXPECT_EQ(pool.get(), GetCurrentChunkBufferPool());
+  }
+  EXPECT_EQ(nullptr, GetCurrentChunkBufferPool());
+}
+
+TEST(ChunkBufferPoolResourceTest, Spec) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto resource_spec,
+      Context::Resource<ChunkBufferPoolResource>::FromJson(
+          {{"total_bytes_limit", 100}, {"huge_pages", true}}));
+  EXPECT_THAT(resource_spec.ToJson(),
+              ::testing::Optional(::nlohmann::json(
+                  {{"total_bytes_limit", 100}, {"huge_pages", true}})));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto pool, Context::Default().GetResource(resource_spec));
+  EXPECT_EQ(100, (*pool)->options().total_bytes_limit);
+  EXPECT_TRUE((*pool)->options().huge_pages);
+}
+
+}  // namespace
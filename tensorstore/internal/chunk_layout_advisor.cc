@@ -0,0 +1,379 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/chunk_layout_advisor.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "tensorstore/access_recorder.h"
+#include "tensorstore/box.h"
+#include "tensorstore/chunk_layout.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_interval.h"
+#include "tensorstore/util/division.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace internal {
+namespace {
+
+// Maximum number of shards intersected by a single access for which
+// intersected shards are tracked individually, such that each shard index is
+// only counted once.  Beyond this, each intersected shard is counted.
+constexpr double kMaxTrackedShardsPerAccess = 65536;
+
+// Summary of the chunks of a one-dimensional grid intersected by an interval.
+struct GridIntersection {
+  // Index of the first chunk intersected.
+  Index first;
+  // Number of chunks intersected.
+  Index count;
+  // Number of chunks completely contained in the interval.
+  Index full;
+  // Total extent of the chunks intersected, clipped to the domain.
+  Index covered;
+};
+
+// Computes the intersection of `interval`, which must be non-empty and
+// contained in `domain`, with a grid of chunks of size `chunk_size` aligned
+// to the origin of `domain`.
+GridIntersection IntersectGrid(IndexInterval interval, IndexInterval domain,
+                               Index chunk_size) {
+  const Index origin = domain.inclusive_min();
+  GridIntersection result;
+  result.first = (interval.inclusive_min() - origin) / chunk_size;
+  const Index last = (interval.inclusive_max() - origin) / chunk_size;
+  result.count = last - result.first + 1;
+  const Index start = origin + result.first * chunk_size;
+  const Index end =
+      std::min(origin + (last + 1) * chunk_size, domain.exclusive_max());
+  result.covered = end - start;
+  // Only the first and last chunks may be partially contained.
+  const bool first_full = interval.inclusive_min() == start;
+  const bool last_full = interval.exclusive_max() == end;
+  if (result.count == 1) {
+    result.full = first_full && last_full;
+  } else {
+    result.full = result.count - 2 + first_full + last_full;
+  }
+  return result;
+}
+
+absl::Status ValidateChunkShape(span<const Index> shape, DimensionIndex rank) {
+  if (shape.size() != rank) {
+    return absl::InvalidArgumentError(tensorstore::StrCat(
+        "Chunk shape ", shape, " does not match rank ", rank));
+  }
+  for (Index size : shape) {
+    if (size <= 0) {
+      return absl::InvalidArgumentError(
+          tensorstore::StrCat("Invalid chunk shape: ", shape));
+    }
+  }
+  return absl::OkStatus();
+}
+
+// Returns a shape with approximately `target_elements` elements, with
+// extents proportional to `aspect` and at most `max_shape`.
+std::vector<Index> ScaleShape(span<const double> aspect,
+                              double target_elements,
+                              span<const Index> max_shape) {
+  const size_t rank = aspect.size();
+  std::vector<Index> shape(rank, 1);
+  std::vector<bool> fixed(rank, false);
+  // Dimensions that would exceed their bounds are clamped, and the remaining
+  // elements are distributed over the other dimensions.
+  for (size_t iteration = 0; iteration <= rank; ++iteration) {
+    double remaining = target_elements;
+    double aspect_product = 1;
+    size_t num_free = 0;
+    for (size_t i = 0; i < rank; ++i) {
+      if (fixed[i]) {
+        remaining /= shape[i];
+      } else {
+        aspect_product *= aspect[i];
+        ++num_free;
+      }
+    }
+    if (num_free == 0) break;
+    const double factor =
+        std::pow(std::max(remaining, 1.0) / aspect_product, 1.0 / num_free);
+    bool changed = false;
+    for (size_t i = 0; i < rank; ++i) {
+      if (fixed[i]) continue;
+      const double size = aspect[i] * factor;
+      if (size >= max_shape[i]) {
+        shape[i] = max_shape[i];
+      } else if (size <= 1) {
+        shape[i] = 1;
+      } else {
+        continue;
+      }
+      fixed[i] = true;
+      changed = true;
+    }
+    if (!changed) {
+      for (size_t i = 0; i < rank; ++i) {
+        if (fixed[i]) continue;
+        shape[i] = std::clamp(static_cast<Index>(std::llround(
+                                  aspect[i] * factor)),
+                              Index(1), max_shape[i]);
+      }
+      break;
+    }
+  }
+  return shape;
+}
+
+}  // namespace
+
+Result<ChunkLayout> ChunkLayoutCandidate::ToChunkLayout() const {
+  ChunkLayout layout;
+  TENSORSTORE_RETURN_IF_ERROR(
+      layout.Set(ChunkLayout::ReadChunkShape(read_chunk_shape)));
+  TENSORSTORE_RETURN_IF_ERROR(layout.Set(ChunkLayout::WriteChunkShape(
+      write_chunk_shape.empty() ? read_chunk_shape : write_chunk_shape)));
+  return layout;
+}
+
+Result<AccessCostEstimate> EstimateAccessCost(
+    span<const AccessRecorder::Access> accesses, BoxView<> domain,
+    const ChunkLayoutCandidate& candidate, const AccessCostOptions& options) {
+  const DimensionIndex rank = domain.rank();
+  if (!IsFinite(domain)) {
+    return absl::InvalidArgumentError(
+        tensorstore::StrCat("Domain must be finite: ", domain));
+  }
+  span<const Index> read_shape = candidate.read_chunk_shape;
+  span<const Index> write_shape = candidate.write_chunk_shape.empty()
+                                      ? read_shape
+                                      : span<const Index>(
+                                            candidate.write_chunk_shape);
+  TENSORSTORE_RETURN_IF_ERROR(ValidateChunkShape(read_shape, rank));
+  TENSORSTORE_RETURN_IF_ERROR(ValidateChunkShape(write_shape, rank));
+  double chunks_per_shard = 1;
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    if (write_shape[i] % read_shape[i] != 0) {
+      return absl::InvalidArgumentError(tensorstore::StrCat(
+          "Write chunk shape ", write_shape,
+          " is not a multiple of read chunk shape ", read_shape));
+    }
+    chunks_per_shard *= write_shape[i] / read_shape[i];
+  }
+  const bool sharded = candidate.sharded();
+  const double encoded_bytes_per_element =
+      options.element_size * options.compression_ratio;
+
+  AccessCostEstimate estimate;
+  double requested_bytes = 0;
+  double decoded_bytes_read = 0;
+  double shard_index_reads = 0;
+  absl::flat_hash_set<std::vector<Index>> shards_read;
+  std::vector<GridIntersection> grid(rank);
+  Box<> region(rank);
+  for (const auto& access : accesses) {
+    if (access.region.rank() != rank) {
+      return absl::InvalidArgumentError(tensorstore::StrCat(
+          "Access ", access.region, " does not match rank ", rank));
+    }
+    for (DimensionIndex i = 0; i < rank; ++i) {
+      region[i] = Intersect(access.region[i], domain[i]);
+    }
+    if (region.is_empty()) continue;
+
+    const double region_elements = region.num_elements();
+    span<const Index> chunk_shape = access.is_write ? write_shape : read_shape;
+    double count = 1, full = 1, covered = 1;
+    for (DimensionIndex i = 0; i < rank; ++i) {
+      grid[i] = IntersectGrid(region[i], domain[i], chunk_shape[i]);
+      count *= grid[i].count;
+      full *= grid[i].full;
+      covered *= grid[i].covered;
+    }
+
+    if (access.is_write) {
+      estimate.write_requests += count;
+      estimate.bytes_written += covered * encoded_bytes_per_element;
+      // The existing content of partially-written chunks must be read.
+      const double partial = count - full;
+      estimate.read_requests += partial;
+      estimate.bytes_read +=
+          partial * (covered / count) * encoded_bytes_per_element;
+      continue;
+    }
+
+    requested_bytes += region_elements * options.element_size;
+    decoded_bytes_read += covered * options.element_size;
+    estimate.read_requests += count;
+    estimate.bytes_read += covered * encoded_bytes_per_element;
+    if (!sharded) continue;
+
+    // Count the shard indices that must be read.
+    double num_shards = 1;
+    std::vector<Index> shard_min(rank), shard_max(rank);
+    for (DimensionIndex i = 0; i < rank; ++i) {
+      const Index origin = domain[i].inclusive_min();
+      shard_min[i] = (region[i].inclusive_min() - origin) / write_shape[i];
+      shard_max[i] = (region[i].inclusive_max() - origin) / write_shape[i];
+      num_shards *= shard_max[i] - shard_min[i] + 1;
+    }
+    if (num_shards > kMaxTrackedShardsPerAccess) {
+      shard_index_reads += num_shards;
+      continue;
+    }
+    std::vector<Index> position = shard_min;
+    while (true) {
+      if (shards_read.insert(position).second) ++shard_index_reads;
+      DimensionIndex i = rank - 1;
+      for (; i >= 0; --i) {
+        if (++position[i] <= shard_max[i]) break;
+        position[i] = shard_min[i];
+      }
+      if (i < 0) break;
+    }
+  }
+
+  // Each shard index holds an offset and length for each chunk.
+  estimate.read_requests += shard_index_reads;
+  estimate.bytes_read += shard_index_reads * chunks_per_shard * 16;
+  estimate.read_amplification =
+      requested_bytes == 0 ? 0 : decoded_bytes_read / requested_bytes;
+  estimate.cost =
+      estimate.bytes_read + estimate.bytes_written +
+      options.request_cost_bytes *
+          (estimate.read_requests + estimate.write_requests);
+  return estimate;
+}
+
+Result<std::vector<ChunkLayoutRecommendation>> RecommendChunkLayouts(
+    span<const AccessRecorder::Access> accesses, BoxView<> domain,
+    const ChunkLayoutAdvisorOptions& options) {
+  const DimensionIndex rank = domain.rank();
+  if (!IsFinite(domain)) {
+    return absl::InvalidArgumentError(
+        tensorstore::StrCat("Domain must be finite: ", domain));
+  }
+  if (options.cost.element_size <= 0) {
+    return absl::InvalidArgumentError(tensorstore::StrCat(
+        "Invalid element size: ", options.cost.element_size));
+  }
+  std::vector<Index> domain_shape(domain.shape().begin(),
+                                  domain.shape().end());
+  for (auto& size : domain_shape) size = std::max(size, Index(1));
+
+  // Aspect ratios of the read chunk shapes considered.
+  std::vector<std::pair<std::string, std::vector<double>>> aspects;
+  aspects.emplace_back("isotropic", std::vector<double>(rank, 1));
+  if (!accesses.empty()) {
+    // Median extent of the accesses in each dimension.
+    std::vector<double> median(rank);
+    std::vector<Index> extents;
+    for (DimensionIndex i = 0; i < rank; ++i) {
+      extents.clear();
+      for (const auto& access : accesses) {
+        if (access.region.rank() != rank) continue;
+        extents.push_back(std::max(
+            Index(1), Intersect(access.region[i], domain[i]).size()));
+      }
+      if (extents.empty()) break;
+      auto mid = extents.begin() + extents.size() / 2;
+      std::nth_element(extents.begin(), mid, extents.end());
+      median[i] = *mid;
+    }
+    aspects.emplace_back("access shape", std::move(median));
+  }
+  if (rank > 1) {
+    for (DimensionIndex i = 0; i < rank; ++i) {
+      std::vector<double> aspect(rank, 1);
+      aspect[i] = domain_shape[i];
+      aspects.emplace_back(absl::StrCat("elongated along dimension ", i),
+                           std::move(aspect));
+    }
+  }
+
+  std::vector<ChunkLayoutCandidate> candidates = options.candidates;
+  absl::flat_hash_set<std::pair<std::vector<Index>, std::vector<Index>>> seen;
+  for (const auto& candidate : candidates) {
+    seen.emplace(candidate.read_chunk_shape, candidate.write_chunk_shape);
+  }
+  const auto add_candidate = [&](std::vector<Index> read_shape,
+                                 std::vector<Index> write_shape,
+                                 std::string description) {
+    if (!seen.emplace(read_shape, write_shape).second) return;
+    candidates.push_back(ChunkLayoutCandidate{
+        std::move(read_shape), std::move(write_shape), std::move(description)});
+  };
+  for (int64_t chunk_bytes : options.target_chunk_bytes) {
+    const double chunk_elements =
+        static_cast<double>(chunk_bytes) / options.cost.element_size;
+    for (const auto& [name, aspect] : aspects) {
+      auto read_shape = ScaleShape(aspect, chunk_elements, domain_shape);
+      add_candidate(read_shape, {},
+                    absl::StrCat(name, ", ", chunk_bytes, " byte chunks"));
+      for (int64_t shard_bytes : options.target_shard_bytes) {
+        // Shards are isotropic in units of read chunks.
+        std::vector<Index> max_chunks(rank);
+        double read_chunk_elements = 1;
+        for (DimensionIndex i = 0; i < rank; ++i) {
+          max_chunks[i] = CeilOfRatio(domain_shape[i], read_shape[i]);
+          read_chunk_elements *= read_shape[i];
+        }
+        auto chunks_per_shard = ScaleShape(
+            std::vector<double>(rank, 1),
+            static_cast<double>(shard_bytes) /
+                (read_chunk_elements * options.cost.element_size),
+            max_chunks);
+        std::vector<Index> write_shape(rank);
+        for (DimensionIndex i = 0; i < rank; ++i) {
+          write_shape[i] = read_shape[i] * chunks_per_shard[i];
+        }
+        if (write_shape == read_shape) continue;
+        add_candidate(read_shape, std::move(write_shape),
+                      absl::StrCat(name, ", ", chunk_bytes, " byte chunks, ",
+                                   shard_bytes, " byte shards"));
+      }
+    }
+  }
+
+  std::vector<ChunkLayoutRecommendation> recommendations;
+  recommendations.reserve(candidates.size());
+  for (auto& candidate : candidates) {
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto estimate,
+        EstimateAccessCost(accesses, domain, candidate, options.cost));
+    recommendations.push_back(
+        ChunkLayoutRecommendation{std::move(candidate), estimate});
+  }
+  std::stable_sort(recommendations.begin(), recommendations.end(),
+                   [](const auto& a, const auto& b) {
+                     return a.estimate.cost < b.estimate.cost;
+                   });
+  return recommendations;
+}
+
+}  // namespace internal
+}  // namespace tensorstore
@@ -0,0 +1,154 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_CHUNK_LAYOUT_ADVISOR_H_
+#define TENSORSTORE_INTERNAL_CHUNK_LAYOUT_ADVISOR_H_
+
+/// \file
+/// Estimates the cost of replaying a trace of accesses, as recorded by
+/// `AccessRecorder`, against candidate chunk layouts, and recommends the
+/// layouts with the lowest estimated cost.
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "tensorstore/access_recorder.h"
+#include "tensorstore/box.h"
+#include "tensorstore/chunk_layout.h"
+#include "tensorstore/index.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal {
+
+/// Parameters of the cost model used by `EstimateAccessCost`.
+struct AccessCostOptions {
+  /// Size in bytes of each element.
+  Index element_size = 1;
+
+  /// Ratio of the encoded (e.g. compressed) size of a chunk to its decoded
+  /// size.
+  double compression_ratio = 1;
+
+  /// Cost of each request, as the equivalent number of bytes transferred.
+  /// Accounts for the per-request latency and overhead of the storage system.
+  double request_cost_bytes = 256 * 1024;
+};
+
+/// Read and write chunk shapes evaluated by `EstimateAccessCost`.
+struct ChunkLayoutCandidate {
+  /// Shape of the chunks read.
+  std::vector<Index> read_chunk_shape;
+
+  /// Shape of the chunks written, e.g. shards, which must be a multiple of
+  /// `read_chunk_shape`.  May be empty to indicate `read_chunk_shape`.
+  std::vector<Index> write_chunk_shape;
+
+  /// Description of how the candidate was chosen, e.g. "isotropic".
+  std::string description;
+
+  /// Returns `true` if the write chunk shape differs from the read chunk
+  /// shape.
+  bool sharded() const {
+    return !write_chunk_shape.empty() && write_chunk_shape != read_chunk_shape;
+  }
+
+  /// Returns the equivalent chunk layout.
+  Result<ChunkLayout> ToChunkLayout() const;
+};
+
+/// Estimated cost of replaying a trace against a `ChunkLayoutCandidate`.
+///
+/// Values are estimates, and are represented as `double` to avoid overflow.
+struct AccessCostEstimate {
+  /// Number of read requests, including reads of shard indices and of the
+  /// existing content of partially-written chunks.
+  double read_requests = 0;
+
+  /// Number of encoded bytes read.
+  double bytes_read = 0;
+
+  /// Number of write requests.
+  double write_requests = 0;
+
+  /// Number of encoded bytes written.
+  double bytes_written = 0;
+
+  /// Ratio of the decoded size of the chunks read to the size of the regions
+  /// requested by read accesses.
+  double read_amplification = 0;
+
+  /// Total cost, as the equivalent number of bytes transferred.
+  double cost = 0;
+};
+
+/// Estimates the cost of replaying `accesses` against a dataset with the
+/// specified `domain` and chunk layout.
+///
+/// Chunk grids are aligned to the origin of `domain`, and accesses are
+/// clipped to `domain`.  Each chunk intersected by a read access is assumed
+/// to be read by a separate request, and the index of each shard is assumed
+/// to be read once.  Each write chunk intersected by a write access is
+/// assumed to be written by a separate request, after reading its existing
+/// content if it is not completely overwritten.
+///
+/// \error `absl::StatusCode::kInvalidArgument` if `domain` is not finite, or
+///     the ranks or chunk shapes are invalid.
+Result<AccessCostEstimate> EstimateAccessCost(
+    span<const AccessRecorder::Access> accesses, BoxView<> domain,
+    const ChunkLayoutCandidate& candidate,
+    const AccessCostOptions& options = {});
+
+/// Options for `RecommendChunkLayouts`.
+struct ChunkLayoutAdvisorOptions {
+  /// Parameters of the cost model.
+  AccessCostOptions cost;
+
+  /// Target decoded sizes, in bytes, of the read chunks considered.
+  std::vector<int64_t> target_chunk_bytes = {256 * 1024, 1024 * 1024,
+                                             4 * 1024 * 1024};
+
+  /// Target decoded sizes, in bytes, of the shards considered.  Unsharded
+  /// layouts are always considered.
+  std::vector<int64_t> target_shard_bytes;
+
+  /// Additional candidates to evaluate, e.g. the layout of an existing
+  /// dataset.
+  std::vector<ChunkLayoutCandidate> candidates;
+};
+
+/// A candidate layout along with its estimated cost.
+struct ChunkLayoutRecommendation {
+  ChunkLayoutCandidate candidate;
+  AccessCostEstimate estimate;
+};
+
+/// Evaluates candidate chunk layouts for `domain` against `accesses`, and
+/// returns them in order of increasing estimated cost.
+///
+/// Candidates are generated for each target chunk size with read chunk
+/// shapes that are isotropic, proportional to the median shape of the
+/// accesses, or elongated along a single dimension, and for each target
+/// shard size with shards that are isotropic in units of read chunks.
+Result<std::vector<ChunkLayoutRecommendation>> RecommendChunkLayouts(
+    span<const AccessRecorder::Access> accesses, BoxView<> domain,
+    const ChunkLayoutAdvisorOptions& options = {});
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_CHUNK_LAYOUT_ADVISOR_H_
@@ -0,0 +1,138 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/chunk_layout_advisor.h"
+
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "tensorstore/access_recorder.h"
+#include "tensorstore/box.h"
+#include "tensorstore/index.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::Box;
+using ::tensorstore::Index;
+using ::tensorstore::StatusIs;
+using ::tensorstore::internal::AccessCostOptions;
+using ::tensorstore::internal::ChunkLayoutAdvisorOptions;
+using ::tensorstore::internal::ChunkLayoutCandidate;
+using ::tensorstore::internal::EstimateAccessCost;
+using ::tensorstore::internal::RecommendChunkLayouts;
+using ::testing::ElementsAre;
+
+using Access = ::tensorstore::AccessRecorder::Access;
+
+TEST(EstimateAccessCostTest, AlignedRead) {
+  std::vector<Access> accesses{{Box<>({0, 0}, {10, 10}), false}};
+  AccessCostOptions options;
+  options.element_size = 2;
+  options.compression_ratio = 0.5;
+  options.request_cost_bytes = 1000;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto estimate,
+      EstimateAccessCost(accesses, Box<>({0, 0}, {100, 100}),
+                         ChunkLayoutCandidate{{10, 10}}, options));
+  EXPECT_EQ(1, estimate.read_requests);
+  EXPECT_EQ(100, estimate.bytes_read);
+  EXPECT_EQ(0, estimate.write_requests);
+  EXPECT_EQ(1, estimate.read_amplification);
+  EXPECT_EQ(1100, estimate.cost);
+}
+
+TEST(EstimateAccessCostTest, UnalignedRead) {
+  // Intersects 4 chunks, one of which is clipped by the domain.
+  std::vector<Access> accesses{{Box<>({5, 5}, {10, 10}), false}};
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto estimate,
+      EstimateAccessCost(accesses, Box<>({0, 0}, {100, 15}),
+                         ChunkLayoutCandidate{{10, 10}}));
+  EXPECT_EQ(4, estimate.read_requests);
+  EXPECT_EQ(20 * 15, estimate.bytes_read);
+  EXPECT_EQ(3, estimate.read_amplification);
+}
+
+TEST(EstimateAccessCostTest, PartialWrite) {
+  // Overwrites one chunk completely and one chunk partially.
+  std::vector<Access> accesses{{Box<>({0, 0}, {15, 10}), true}};
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto estimate,
+      EstimateAccessCost(accesses, Box<>({0, 0}, {100, 100}),
+                         ChunkLayoutCandidate{{10, 10}}));
+  EXPECT_EQ(2, estimate.write_requests);
+  EXPECT_EQ(200, estimate.bytes_written);
+  EXPECT_EQ(1, estimate.read_requests);
+  EXPECT_EQ(100, estimate.bytes_read);
+}
+
+TEST(EstimateAccessCostTest, Sharded) {
+  // Both reads are within the same shard, whose index is read once.
+  std::vector<Access> accesses{{Box<>({0, 0}, {10, 10}), false},
+                               {Box<>({10, 10}, {10, 10}), false}};
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto estimate,
+      EstimateAccessCost(accesses, Box<>({0, 0}, {100, 100}),
+                         ChunkLayoutCandidate{{10, 10}, {20, 20}}));
+  EXPECT_EQ(3, estimate.read_requests);
+  EXPECT_EQ(200 + 4 * 16, estimate.bytes_read);
+}
+
+TEST(EstimateAccessCostTest, Errors) {
+  std::vector<Access> accesses;
+  EXPECT_THAT(EstimateAccessCost(accesses, Box<>({0, 0}, {100, 100}),
+                                 ChunkLayoutCandidate{{10, 0}}),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(EstimateAccessCost(accesses, Box<>({0, 0}, {100, 100}),
+                                 ChunkLayoutCandidate{{10}}),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(EstimateAccessCost(accesses, Box<>({0, 0}, {100, 100}),
+                                 ChunkLayoutCandidate{{10, 10}, {15, 20}}),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(EstimateAccessCost(accesses, Box<>(2),
+                                 ChunkLayoutCandidate{{10, 10}}),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(RecommendChunkLayoutsTest, RowAccesses) {
+  std::vector<Access> accesses;
+  for (Index i = 0; i < 100; ++i) {
+    accesses.push_back(Access{Box<>({i, 0}, {1, 1000}), false});
+  }
+  ChunkLayoutAdvisorOptions options;
+  options.target_chunk_bytes = {10000};
+  options.target_shard_bytes = {1000000};
+  options.candidates.push_back(ChunkLayoutCandidate{{100, 100}, {}, "current"});
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto recommendations,
+      RecommendChunkLayouts(accesses, Box<>({0, 0}, {1000, 1000}), options));
+  ASSERT_FALSE(recommendations.empty());
+  const auto& best = recommendations.front();
+  EXPECT_THAT(best.candidate.read_chunk_shape, ElementsAre(10, 1000));
+  EXPECT_FALSE(best.candidate.sharded());
+  EXPECT_EQ(10, best.estimate.read_amplification);
+  for (size_t i = 1; i < recommendations.size(); ++i) {
+    EXPECT_LE(recommendations[i - 1].estimate.cost,
+              recommendations[i].estimate.cost);
+  }
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto layout,
+                                   best.candidate.ToChunkLayout());
+  EXPECT_THAT(layout.read_chunk_shape(), ElementsAre(10, 1000));
+  EXPECT_THAT(layout.write_chunk_shape(), ElementsAre(10, 1000));
+}
+
+}  // namespace
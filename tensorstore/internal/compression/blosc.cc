@@ -16,10 +16,13 @@
 
 #include <stddef.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <limits>
 #include <string>
 #include <string_view>
+#include <thread>  // NOLINT
 #include <utility>
 
 #include "absl/functional/function_ref.h"
@@ -34,6 +37,59 @@
 
 namespace tensorstore {
 namespace blosc {
+namespace {
+
+// Minimum number of decoded bytes per blosc thread.  Smaller chunks are
+// decoded by the calling thread only, since the cost of starting the blosc
+// threads would exceed the benefit.
+constexpr size_t kMinDecodedBytesPerThread = 4 * 1024 * 1024;
+
+// Number of threads, in addition to the calling threads, that may currently be
+// used by `DecodeWithCallback` across all concurrent calls.
+//
+// The total number of threads decoding is bounded by the number of CPU cores,
+// which is also the default `data_copy_concurrency` limit.  When many chunks
+// are decoded concurrently, the budget is exhausted and each chunk is decoded
+// by a single thread.
+std::atomic<int>& ExtraDecodeThreadBudget() {
+  static std::atomic<int> budget{
+      std::max(0, static_cast<int>(std::thread::hardware_concurrency()) - 1)};
+  return budget;
+}
+
+// Borrows up to `desired` threads from `ExtraDecodeThreadBudget()` for the
+// lifetime of this object.
+class ScopedExtraDecodeThreads {
+ public:
+  explicit ScopedExtraDecodeThreads(int desired) {
+    if (desired <= 0) return;
+    auto& budget = ExtraDecodeThreadBudget();
+    int available = budget.load(std::memory_order_relaxed);
+    while (available > 0) {
+      const int n = std::min(available, desired);
+      if (budget.compare_exchange_weak(available, available - n,
+                                       std::memory_order_relaxed)) {
+        count_ = n;
+        break;
+      }
+    }
+  }
+  ~ScopedExtraDecodeThreads() {
+    if (count_) {
+      ExtraDecodeThreadBudget().fetch_add(count_, std::memory_order_relaxed);
+    }
+  }
+  ScopedExtraDecodeThreads(const ScopedExtraDecodeThreads&) = delete;
+  ScopedExtraDecodeThreads& operator=(const ScopedExtraDecodeThreads&) =
+      delete;
+
+  int count() const { return count_; }
+
+ private:
+  int count_ = 0;
+};
+
+}  // namespace
 
 Result<std::string> Encode(std::string_view input, const Options& options) {
   std::string output;
@@ -90,8 +146,14 @@ Result<size_t> DecodeWithCallback(
   char* output_buffer = get_output_buffer(nbytes);
   if (!output_buffer) return 0;
   if (nbytes > 0) {
-    const int n = blosc_decompress_ctx(input.data(), output_buffer, nbytes,
-                                       /*numinternalthreads=*/1);
+    ScopedExtraDecodeThreads extra_threads(
+        static_cast<int>(std::min<size_t>(
+            nbytes / kMinDecodedBytesPerThread,
+            std::numeric_limits<int>::max())) -
+        1);
+    const int n =
+        blosc_decompress_ctx(input.data(), output_buffer, nbytes,
+                             /*numinternalthreads=*/1 + extra_threads.count());
     if (n <= 0) {
       return absl::InvalidArgumentError(
           tensorstore::StrCat("Blosc error: ", n));
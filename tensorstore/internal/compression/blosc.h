@@ -94,6 +94,9 @@ Result<std::string> Decode(std::string_view input);
 // returns the size of the decoded data. If `get_output_buffer` returns
 // `nullptr`, then decoding is skipped and `0` is returned. On success, the
 // decoded size is always equal to the size passed to `get_output_buffer`.
+//
+// Large inputs are decoded using additional blosc threads, borrowed from a
+// process-wide budget bounded by the number of CPU cores.
 Result<size_t> DecodeWithCallback(
     std::string_view input, absl::FunctionRef<char*(size_t)> get_output_buffer);
 
@@ -18,6 +18,7 @@
 
 #include <string>
 #include <string_view>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
@@ -88,6 +89,31 @@ TEST(BloscTest, EncodeDecode) {
   }
 }
 
+// Tests encoding and decoding of inputs large enough to be decoded using
+// multiple threads, including when decoded concurrently.
+TEST(BloscTest, EncodeDecodeLarge) {
+  std::string array(32 * 1024 * 1024, '\0');
+  for (size_t i = 0; i < array.size(); ++i) {
+    array[i] = static_cast<char>((i * 7) % 251);
+  }
+  blosc::Options options{"lz4", 5, BLOSC_SHUFFLE, 0, 2};
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto encoded,
+                                   blosc::Encode(array, options));
+  std::vector<std::thread> threads;
+  std::vector<std::string> decoded(4);
+  for (auto& d : decoded) {
+    threads.emplace_back([&] {
+      if (auto result = blosc::Decode(encoded); result.ok()) {
+        d = *std::move(result);
+      }
+    });
+  }
+  for (auto& t : threads) t.join();
+  for (const auto& d : decoded) {
+    EXPECT_TRUE(d == array);
+  }
+}
+
 // Tests that the compressed data has the expected blosc complib.
 TEST(BloscTest, CheckComplib) {
   const std::string_view array =
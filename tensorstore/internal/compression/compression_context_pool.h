@@ -0,0 +1,47 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_COMPRESSION_COMPRESSION_CONTEXT_POOL_H_
+#define TENSORSTORE_INTERNAL_COMPRESSION_COMPRESSION_CONTEXT_POOL_H_
+
+#include <stddef.h>
+
+#include "riegeli/base/recycling_pool.h"
+
+namespace tensorstore {
+namespace internal {
+
+/// Maximum number of idle compression contexts retained per thread.
+constexpr size_t kCompressionContextPoolSizePerThread = 4;
+
+/// Returns the options for the pools from which riegeli compressing writers
+/// and decompressing readers obtain their zstd, zlib and xz contexts.
+///
+/// Riegeli recycles these contexts through a process-wide pool, which by
+/// default retains only a small number of them shared by all threads.  When
+/// many threads encode or decode small chunks concurrently, that pool is
+/// frequently exhausted, and each chunk pays for allocating and initializing
+/// a fresh context (several MiB for zstd at high compression levels).
+/// Sharding the pool by thread lets each thread reuse its own contexts
+/// without contention.
+inline riegeli::RecyclingPoolOptions CompressionContextPoolOptions() {
+  return riegeli::RecyclingPoolOptions()
+      .set_thread_shards(true)
+      .set_max_size(kCompressionContextPoolSizePerThread);
+}
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_COMPRESSION_COMPRESSION_CONTEXT_POOL_H_
@@ -21,6 +21,7 @@
 #include <cassert>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
@@ -130,15 +131,25 @@ void EncodeBlock(const Label* input, const ptrdiff_t input_shape[3],
 
   output->resize(encoded_value_base_offset + elements_to_write * 4);
   char* output_ptr = output->data() + encoded_value_base_offset;
-  // Write encoded representation.
-  ForEachElement([&](size_t z, size_t y, size_t x, Label value) {
-    uint32_t index = seen_values.at(value);
-    size_t output_offset = x + block_shape[2] * (y + block_shape[1] * z);
-    void* cur_ptr = output_ptr + output_offset * encoded_bits / 32 * 4;
-    little_endian::Store32(cur_ptr,
-                           little_endian::Load32(cur_ptr) |
-                               (index << (output_offset * encoded_bits % 32)));
-  });
+  // Write encoded representation.  With `encoded_bits == 0`, every index is 0
+  // and there is nothing to write.
+  if (encoded_bits != 0) {
+    // As when determining the distinct values, consecutive elements usually
+    // have the same label, in which case the hash table lookup is skipped.
+    Label previous_value = seen_values_inv[0];
+    uint32_t previous_index = 0;
+    ForEachElement([&](size_t z, size_t y, size_t x, Label value) {
+      if (value != previous_value) {
+        previous_value = value;
+        previous_index = seen_values.find(value)->second;
+      }
+      size_t output_offset = x + block_shape[2] * (y + block_shape[1] * z);
+      void* cur_ptr = output_ptr + output_offset * encoded_bits / 32 * 4;
+      little_endian::Store32(
+          cur_ptr, little_endian::Load32(cur_ptr) |
+                       (previous_index << (output_offset * encoded_bits % 32)));
+    });
+  }
 
   // Write table
   if (write_table) {
@@ -227,11 +238,6 @@ bool DecodeBlock(size_t encoded_bits, const char* encoded_input,
                  const ptrdiff_t block_shape[3],
                  const ptrdiff_t output_shape[3],
                  const ptrdiff_t output_byte_strides[3], Label* output) {
-  // TODO(jbms): Consider specializing this function for the value of
-  // `encoded_bits` and whether `table_size` is `< 2**encoded_bits`.  If
-  // `table_size >= 2**encoded_bits`, there is no need to check below that
-  // `index <= table_size`.
-
   // Invokes `callback(label, z, y, x)` for each block position in C order.  If
   // `callback` returns `false`, stops iterating and returns `false`.  Otherwise
   // returns `true` when done.
@@ -273,19 +279,65 @@ bool DecodeBlock(size_t encoded_bits, const char* encoded_input,
         });
   }
 
-  const uint32_t encoded_value_mask = (1U << encoded_bits) - 1;
-  return for_each_position([&](Label& output_label, ptrdiff_t z, ptrdiff_t y,
-                               ptrdiff_t x) {
-    size_t encoded_offset = x + block_shape[2] * (y + block_shape[1] * z);
-    auto index = little_endian::Load32(
-                     encoded_input + encoded_offset * encoded_bits / 32 * 4) >>
-                     (encoded_offset * encoded_bits % 32) &
-                 encoded_value_mask;
-    if (index >= table_size) return false;
-    output_label = read_label(index);
+  // Decodes the indices with `kEncodedBits` known at compile time, so that the
+  // shift and mask amounts are constants.  If `kCheckIndex` is `false`, the
+  // table is known to contain an entry for every possible index.
+  const auto decode = [&](auto encoded_bits_constant, auto check_index) {
+    constexpr size_t kEncodedBits = decltype(encoded_bits_constant)::value;
+    constexpr bool kCheckIndex = decltype(check_index)::value;
+    constexpr uint32_t kEncodedValueMask =
+        static_cast<uint32_t>((uint64_t(1) << kEncodedBits) - 1);
+    auto* output_z = reinterpret_cast<char*>(output);
+    for (ptrdiff_t z = 0; z < output_shape[0]; ++z) {
+      auto* output_y = output_z;
+      for (ptrdiff_t y = 0; y < output_shape[1]; ++y) {
+        auto* output_x = output_y;
+        const size_t row_offset = block_shape[2] * (y + block_shape[1] * z);
+        for (ptrdiff_t x = 0; x < output_shape[2]; ++x) {
+          const size_t encoded_offset = row_offset + x;
+          uint32_t index =
+              little_endian::Load32(encoded_input +
+                                    encoded_offset * kEncodedBits / 32 * 4) >>
+                  (encoded_offset * kEncodedBits % 32) &
+              kEncodedValueMask;
+          if constexpr (kCheckIndex) {
+            if (index >= table_size) return false;
+          }
+          *reinterpret_cast<Label*>(output_x) = read_label(index);
+          output_x += output_byte_strides[2];
+        }
+        output_y += output_byte_strides[1];
+      }
+      output_z += output_byte_strides[0];
+    }
     return true;
-  });
-  return true;
+  };
+
+  const auto decode_with_bits = [&](auto encoded_bits_constant) {
+    constexpr size_t kEncodedBits = decltype(encoded_bits_constant)::value;
+    if (table_size >= (uint64_t(1) << kEncodedBits)) {
+      return decode(encoded_bits_constant, std::false_type{});
+    }
+    return decode(encoded_bits_constant, std::true_type{});
+  };
+
+  switch (encoded_bits) {
+    case 1:
+      return decode_with_bits(std::integral_constant<size_t, 1>{});
+    case 2:
+      return decode_with_bits(std::integral_constant<size_t, 2>{});
+    case 4:
+      return decode_with_bits(std::integral_constant<size_t, 4>{});
+    case 8:
+      return decode_with_bits(std::integral_constant<size_t, 8>{});
+    case 16:
+      return decode_with_bits(std::integral_constant<size_t, 16>{});
+    case 32:
+      return decode_with_bits(std::integral_constant<size_t, 32>{});
+    default:
+      // Not a power of 2 <= 32.
+      return false;
+  }
 }
 
 template <typename Label>
@@ -140,7 +140,8 @@ void EncodeChannels(const Label* input, const ptrdiff_t input_shape[3 + 1],
 ///
 /// \tparam Label Must be `uint32_t` or `uint64_t`.
 /// \param encoded_bits Number of bits used to encode each label (i.e. to
-///     encode index into the table of labels).
+///     encode index into the table of labels).  Must be 0 or a power of 2 no
+///     greater than 32 for decoding to succeed.
 /// \param encoded_input Pointer to encoded block values.
 /// \param table_input Pointer to table of labels.
 /// \param table_size Number of labels in table, used for bounds checking.
@@ -0,0 +1,91 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "absl/log/absl_check.h"
+#include "absl/random/random.h"
+#include "tensorstore/internal/compression/neuroglancer_compressed_segmentation.h"
+
+namespace {
+
+using ::tensorstore::neuroglancer_compressed_segmentation::DecodeChannel;
+using ::tensorstore::neuroglancer_compressed_segmentation::EncodeChannel;
+
+constexpr ptrdiff_t kSize = 64;
+constexpr ptrdiff_t kShape[3] = {kSize, kSize, kSize};
+constexpr ptrdiff_t kBlockShape[3] = {8, 8, 8};
+
+// Returns a `kShape` volume of labels chosen from `num_labels` distinct
+// values, in runs of `kRunLength` along the innermost dimension, as is typical
+// of segmentations.
+template <typename Label>
+std::vector<Label> MakeSegmentation(size_t num_labels) {
+  constexpr size_t kRunLength = 4;
+  absl::BitGen gen;
+  std::vector<Label> labels(kSize * kSize * kSize);
+  Label label = 0;
+  for (size_t i = 0; i < labels.size(); ++i) {
+    if (i % kRunLength == 0) {
+      // Use large label values to exercise the full width of `Label`.
+      label = static_cast<Label>(absl::Uniform<uint64_t>(gen, 0, num_labels) *
+                                 0x9e3779b97f4a7c15);
+    }
+    labels[i] = label;
+  }
+  return labels;
+}
+
+template <typename Label>
+void BM_EncodeChannel(benchmark::State& state) {
+  const auto labels = MakeSegmentation<Label>(state.range(0));
+  const ptrdiff_t byte_strides[3] = {kSize * kSize * sizeof(Label),
+                                     kSize * sizeof(Label), sizeof(Label)};
+  std::string output;
+  for (auto s : state) {
+    output.clear();
+    EncodeChannel(labels.data(), kShape, byte_strides, kBlockShape, &output);
+    benchmark::DoNotOptimize(output);
+  }
+  state.SetBytesProcessed(state.iterations() * labels.size() * sizeof(Label));
+}
+
+template <typename Label>
+void BM_DecodeChannel(benchmark::State& state) {
+  const auto labels = MakeSegmentation<Label>(state.range(0));
+  const ptrdiff_t byte_strides[3] = {kSize * kSize * sizeof(Label),
+                                     kSize * sizeof(Label), sizeof(Label)};
+  std::string encoded;
+  EncodeChannel(labels.data(), kShape, byte_strides, kBlockShape, &encoded);
+  std::vector<Label> output(labels.size());
+  for (auto s : state) {
+    ABSL_CHECK(DecodeChannel(encoded, kBlockShape, kShape, byte_strides,
+                             output.data()));
+    benchmark::DoNotOptimize(output);
+  }
+  ABSL_CHECK(output == labels);
+  state.SetBytesProcessed(state.iterations() * labels.size() * sizeof(Label));
+}
+
+BENCHMARK_TEMPLATE(BM_EncodeChannel, uint32_t)->Range(1, 512);
+BENCHMARK_TEMPLATE(BM_EncodeChannel, uint64_t)->Range(1, 512);
+BENCHMARK_TEMPLATE(BM_DecodeChannel, uint32_t)->Range(1, 512);
+BENCHMARK_TEMPLATE(BM_DecodeChannel, uint64_t)->Range(1, 512);
+
+}  // namespace
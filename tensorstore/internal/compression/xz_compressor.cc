@@ -25,6 +25,7 @@
 #include "riegeli/bytes/writer.h"
 #include "riegeli/xz/xz_reader.h"
 #include "riegeli/xz/xz_writer.h"
+#include "tensorstore/internal/compression/compression_context_pool.h"
 
 namespace tensorstore {
 namespace internal {
@@ -37,6 +38,7 @@ std::unique_ptr<riegeli::Writer> XzCompressor::GetWriter(
   options.set_check(static_cast<Writer::Check>(check));
   options.set_compression_level(level);
   options.set_extreme(extreme);
+  options.set_recycling_pool_options(CompressionContextPoolOptions());
   return std::make_unique<Writer>(&base_writer, options);
 }
 
@@ -46,6 +48,7 @@ std::unique_ptr<riegeli::Reader> XzCompressor::GetReader(
   Reader::Options options;
   options.set_container(Reader::Container::kXzOrLzma);
   options.set_concatenate(true);
+  options.set_recycling_pool_options(CompressionContextPoolOptions());
   return std::make_unique<Reader>(&base_reader, options);
 }
 
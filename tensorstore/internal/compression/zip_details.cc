@@ -32,12 +32,15 @@
 #include "absl/status/status.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_format.h"
+#include "absl/time/civil_time.h"
 #include "absl/time/time.h"
 #include "riegeli/bytes/limiting_reader.h"
 #include "riegeli/bytes/prefix_limiting_reader.h"
 #include "riegeli/bytes/reader.h"
+#include "riegeli/bytes/writer.h"
 #include "riegeli/bzip2/bzip2_reader.h"
 #include "riegeli/endian/endian_reading.h"
+#include "riegeli/endian/endian_writing.h"
 #include "riegeli/xz/xz_reader.h"
 #include "riegeli/zlib/zlib_reader.h"
 #include "riegeli/zstd/zstd_reader.h"
@@ -55,6 +58,9 @@ using ::riegeli::ReadLittleEndian16;
 using ::riegeli::ReadLittleEndian32;
 using ::riegeli::ReadLittleEndian64;
 using ::riegeli::ReadLittleEndianSigned64;
+using ::riegeli::WriteLittleEndian16;
+using ::riegeli::WriteLittleEndian32;
+using ::riegeli::WriteLittleEndian64;
 
 ABSL_CONST_INIT internal_log::VerboseFlag zip_logging("zip_details");
 
@@ -78,6 +84,31 @@ absl::Time MakeMSDOSTime(uint16_t date, uint16_t time) {
   return absl::FromTM(dos_tm, absl::UTCTimeZone());
 }
 
+// Inverse of `MakeMSDOSTime`.  Times before 1980, which are not representable,
+// are clamped to 1980-01-01.
+std::pair<uint16_t, uint16_t> GetMSDOSDateTime(absl::Time t) {
+  const auto cs = absl::ToCivilSecond(t, absl::UTCTimeZone());
+  if (cs.year() < 1980) return {(1 << 5) | 1, 0};
+  const uint16_t date = static_cast<uint16_t>(
+      ((std::min<int64_t>(cs.year(), 2107) - 1980) << 9) | (cs.month() << 5) |
+      cs.day());
+  const uint16_t time = static_cast<uint16_t>(
+      (cs.hour() << 11) | (cs.minute() << 5) | (cs.second() / 2));
+  return {date, time};
+}
+
+constexpr uint32_t kMax32 = std::numeric_limits<uint32_t>::max();
+constexpr uint16_t kMax16 = std::numeric_limits<uint16_t>::max();
+
+// Version needed to extract: 2.0 for deflate, 4.5 for ZIP64.
+uint16_t GetVersionNeeded(bool is_zip64) { return is_zip64 ? 45 : 20; }
+
+absl::Status GetWriterStatus(riegeli::Writer &writer, std::string_view what) {
+  if (writer.ok()) return absl::OkStatus();
+  return MaybeAnnotateStatus(writer.status(),
+                             tensorstore::StrCat("Failed to write ", what));
+}
+
 // These could have different implementations for central headers vs.
 // local headers.
 absl::Status ReadExtraField_Zip64_0001(riegeli::Reader &reader,
@@ -602,6 +633,127 @@ absl::Status ReadLocalEntry(riegeli::Reader &reader, ZipEntry &entry) {
   return absl::OkStatus();
 }
 
+// 4.3.7
+absl::Status WriteLocalEntry(riegeli::Writer &writer, const ZipEntry &entry) {
+  if (entry.filename.size() > kMax16) {
+    return absl::InvalidArgumentError("ZIP entry filename is too long");
+  }
+  // 4.5.3: The local header ZIP64 extra field must include both sizes.
+  const bool is_zip64 =
+      entry.compressed_size >= kMax32 || entry.uncompressed_size >= kMax32;
+  const auto [date, time] = GetMSDOSDateTime(entry.mtime);
+  WriteLittleEndian32(0x04034b50, writer);
+  WriteLittleEndian16(GetVersionNeeded(is_zip64), writer);
+  WriteLittleEndian16(entry.flags & ~kHasDataDescriptor, writer);
+  WriteLittleEndian16(static_cast<uint16_t>(entry.compression_method), writer);
+  WriteLittleEndian16(time, writer);
+  WriteLittleEndian16(date, writer);
+  WriteLittleEndian32(entry.crc, writer);
+  WriteLittleEndian32(is_zip64 ? kMax32 : entry.compressed_size, writer);
+  WriteLittleEndian32(is_zip64 ? kMax32 : entry.uncompressed_size, writer);
+  WriteLittleEndian16(entry.filename.size(), writer);
+  WriteLittleEndian16(is_zip64 ? 20 : 0, writer);
+  writer.Write(entry.filename);
+  if (is_zip64) {
+    WriteLittleEndian16(0x0001, writer);
+    WriteLittleEndian16(16, writer);
+    WriteLittleEndian64(entry.uncompressed_size, writer);
+    WriteLittleEndian64(entry.compressed_size, writer);
+  }
+  return GetWriterStatus(writer, "ZIP Local Entry");
+}
+
+// 4.3.12
+absl::Status WriteCentralDirectoryEntry(riegeli::Writer &writer,
+                                        const ZipEntry &entry) {
+  if (entry.filename.size() > kMax16 || entry.comment.size() > kMax16) {
+    return absl::InvalidArgumentError(
+        "ZIP entry filename or comment is too long");
+  }
+  // Only the fields which do not fit are included in the ZIP64 extra field,
+  // in the order expected by `ReadExtraField_Zip64_0001`.
+  const bool zip64_uncompressed_size = entry.uncompressed_size >= kMax32;
+  const bool zip64_compressed_size = entry.compressed_size >= kMax32;
+  const bool zip64_offset = entry.local_header_offset >= kMax32;
+  const uint16_t zip64_size = 8 * (zip64_uncompressed_size +
+                                   zip64_compressed_size + zip64_offset);
+  const bool is_zip64 = zip64_size > 0;
+  const auto [date, time] = GetMSDOSDateTime(entry.mtime);
+  WriteLittleEndian32(0x02014b50, writer);
+  WriteLittleEndian16(entry.version_madeby, writer);
+  WriteLittleEndian16(GetVersionNeeded(is_zip64), writer);
+  WriteLittleEndian16(entry.flags & ~kHasDataDescriptor, writer);
+  WriteLittleEndian16(static_cast<uint16_t>(entry.compression_method), writer);
+  WriteLittleEndian16(time, writer);
+  WriteLittleEndian16(date, writer);
+  WriteLittleEndian32(entry.crc, writer);
+  WriteLittleEndian32(zip64_compressed_size ? kMax32 : entry.compressed_size,
+                      writer);
+  WriteLittleEndian32(
+      zip64_uncompressed_size ? kMax32 : entry.uncompressed_size, writer);
+  WriteLittleEndian16(entry.filename.size(), writer);
+  WriteLittleEndian16(is_zip64 ? zip64_size + 4 : 0, writer);
+  WriteLittleEndian16(entry.comment.size(), writer);
+  WriteLittleEndian16(0, writer);  // start disk_number
+  WriteLittleEndian16(entry.internal_fa, writer);
+  WriteLittleEndian32(entry.external_fa, writer);
+  WriteLittleEndian32(zip64_offset ? kMax32 : entry.local_header_offset,
+                      writer);
+  writer.Write(entry.filename);
+  if (is_zip64) {
+    WriteLittleEndian16(0x0001, writer);
+    WriteLittleEndian16(zip64_size, writer);
+    if (zip64_uncompressed_size) {
+      WriteLittleEndian64(entry.uncompressed_size, writer);
+    }
+    if (zip64_compressed_size) {
+      WriteLittleEndian64(entry.compressed_size, writer);
+    }
+    if (zip64_offset) WriteLittleEndian64(entry.local_header_offset, writer);
+  }
+  writer.Write(entry.comment);
+  return GetWriterStatus(writer, "ZIP Central Directory Entry");
+}
+
+// 4.3.14, 4.3.15, 4.3.16
+absl::Status WriteEOCD(riegeli::Writer &writer, const ZipEOCD &eocd) {
+  if (eocd.comment.size() > kMax16) {
+    return absl::InvalidArgumentError("ZIP comment is too long");
+  }
+  const bool is_zip64 = eocd.num_entries >= kMax16 ||
+                        eocd.cd_size >= kMax32 || eocd.cd_offset >= kMax32;
+  if (is_zip64) {
+    const uint64_t eocd64_offset = eocd.cd_offset + eocd.cd_size;
+    WriteLittleEndian32(0x06064b50, writer);
+    WriteLittleEndian64(44, writer);  // size of the remaining record
+    WriteLittleEndian16(45, writer);  // version made by
+    WriteLittleEndian16(45, writer);  // version needed
+    WriteLittleEndian32(0, writer);   // disk number
+    WriteLittleEndian32(0, writer);   // disk number with cd
+    WriteLittleEndian64(eocd.num_entries, writer);
+    WriteLittleEndian64(eocd.num_entries, writer);
+    WriteLittleEndian64(eocd.cd_size, writer);
+    WriteLittleEndian64(eocd.cd_offset, writer);
+
+    WriteLittleEndian32(0x07064b50, writer);
+    WriteLittleEndian32(0, writer);  // disk number with eocd64
+    WriteLittleEndian64(eocd64_offset, writer);
+    WriteLittleEndian32(1, writer);  // total number of disks
+  }
+  const uint16_t num_entries =
+      is_zip64 ? kMax16 : static_cast<uint16_t>(eocd.num_entries);
+  WriteLittleEndian32(0x06054b50, writer);
+  WriteLittleEndian16(0, writer);  // disk number
+  WriteLittleEndian16(0, writer);  // disk number with cd
+  WriteLittleEndian16(num_entries, writer);
+  WriteLittleEndian16(num_entries, writer);
+  WriteLittleEndian32(is_zip64 ? kMax32 : eocd.cd_size, writer);
+  WriteLittleEndian32(is_zip64 ? kMax32 : eocd.cd_offset, writer);
+  WriteLittleEndian16(eocd.comment.size(), writer);
+  writer.Write(eocd.comment);
+  return GetWriterStatus(writer, "ZIP End of Central Directory");
+}
+
 /// Returns whether the ZIP entry can be read.
 absl::Status ValidateEntryIsSupported(const ZipEntry &entry) {
   if (entry.flags & 0x01 ||                 // encryption
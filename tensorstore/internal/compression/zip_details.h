@@ -26,6 +26,7 @@
 #include "absl/strings/str_format.h"
 #include "absl/time/time.h"
 #include "riegeli/bytes/reader.h"
+#include "riegeli/bytes/writer.h"
 #include "tensorstore/util/result.h"
 
 // NOTE: Currently tensorstore does not use a third-party zip library such
@@ -224,6 +225,28 @@ tensorstore::Result<std::unique_ptr<riegeli::Reader>> GetRawReader(
 tensorstore::Result<std::unique_ptr<riegeli::Reader>> GetReader(
     riegeli::Reader *reader, ZipEntry &entry);
 
+/// Writes a ZIP Local Entry for `entry` at the current writer position.
+///
+/// The ZIP64 extra field is included when either size of `entry` does not fit
+/// in 32 bits.  The data descriptor flag is not supported, since the sizes and
+/// crc must be known before the entry is written.
+absl::Status WriteLocalEntry(riegeli::Writer &writer, const ZipEntry &entry);
+
+/// Writes a ZIP Central Directory Entry for `entry` at the current writer
+/// position.
+///
+/// The ZIP64 extra field is included when the sizes or `local_header_offset`
+/// of `entry` do not fit in 32 bits.
+absl::Status WriteCentralDirectoryEntry(riegeli::Writer &writer,
+                                        const ZipEntry &entry);
+
+/// Writes the end of central directory record for `eocd` at the current
+/// writer position, which must immediately follow the central directory.
+///
+/// The ZIP64 end of central directory record and locator are written first
+/// when `eocd` does not fit in the 16 and 32-bit fields of the record.
+absl::Status WriteEOCD(riegeli::Writer &writer, const ZipEOCD &eocd);
+
 }  // namespace internal_zip
 }  // namespace tensorstore
 
@@ -22,6 +22,7 @@
 #include "riegeli/bytes/writer.h"
 #include "riegeli/zlib/zlib_reader.h"
 #include "riegeli/zlib/zlib_writer.h"
+#include "tensorstore/internal/compression/compression_context_pool.h"
 
 namespace tensorstore {
 namespace internal {
@@ -33,6 +34,7 @@ std::unique_ptr<riegeli::Writer> ZlibCompressor::GetWriter(
   if (level != -1) options.set_compression_level(level);
   options.set_header(use_gzip_header ? Writer::Header::kGzip
                                      : Writer::Header::kZlib);
+  options.set_recycling_pool_options(CompressionContextPoolOptions());
   return std::make_unique<Writer>(&base_writer, options);
 }
 
@@ -42,6 +44,7 @@ std::unique_ptr<riegeli::Reader> ZlibCompressor::GetReader(
   Reader::Options options;
   options.set_header(use_gzip_header ? Reader::Header::kGzip
                                      : Reader::Header::kZlib);
+  options.set_recycling_pool_options(CompressionContextPoolOptions());
   return std::make_unique<Reader>(&base_reader, options);
 }
 
@@ -22,6 +22,7 @@
 #include "riegeli/bytes/writer.h"
 #include "riegeli/zstd/zstd_reader.h"
 #include "riegeli/zstd/zstd_writer.h"
+#include "tensorstore/internal/compression/compression_context_pool.h"
 
 namespace tensorstore {
 namespace internal {
@@ -31,13 +32,16 @@ std::unique_ptr<riegeli::Writer> ZstdCompressor::GetWriter(
   using Writer = riegeli::ZstdWriter<riegeli::Writer*>;
   Writer::Options options;
   options.set_compression_level(level);
+  options.set_recycling_pool_options(CompressionContextPoolOptions());
   return std::make_unique<Writer>(&base_writer, options);
 }
 
 std::unique_ptr<riegeli::Reader> ZstdCompressor::GetReader(
     riegeli::Reader& base_reader, size_t element_bytes) const {
   using Reader = riegeli::ZstdReader<riegeli::Reader*>;
-  return std::make_unique<Reader>(&base_reader);
+  Reader::Options options;
+  options.set_recycling_pool_options(CompressionContextPoolOptions());
+  return std::make_unique<Reader>(&base_reader, options);
 }
 
 }  // namespace internal
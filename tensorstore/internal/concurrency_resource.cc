@@ -37,9 +37,15 @@ AnyContextResourceJsonBinder<ConcurrencyResource::Spec>
 ConcurrencyResourceTraits::JsonBinder() {
   namespace jb = tensorstore::internal_json_binding;
   return [](auto is_loading, const auto& options, auto* obj, auto* j) {
-    return jb::Object(jb::Member(
-        "limit", jb::DefaultInitializedValue(jb::Optional(
-                     jb::Integer<size_t>(1), [] { return "shared"; }))))(
+    return jb::Object(
+        jb::Member("limit",
+                   jb::Projection<&Spec::limit>(jb::DefaultInitializedValue(
+                       jb::Optional(jb::Integer<size_t>(1),
+                                    [] { return "shared"; })))),
+        jb::Member("work_stealing", jb::Projection<&Spec::work_stealing>(
+                                        jb::DefaultInitializedValue())),
+        jb::Member("numa_pinning", jb::Projection<&Spec::numa_pinning>(
+                                       jb::DefaultInitializedValue())))(
         is_loading, options, obj, j);
   };
 }
@@ -48,13 +54,23 @@ Result<ConcurrencyResource::Resource> ConcurrencyResourceTraits::Create(
     const Spec& spec, ContextResourceCreationContext context) const {
   Resource value;
   value.spec = spec;
-  if (spec) {
-    value.executor = DetachedThreadPool(*spec);
+  const auto make_executor = [&](size_t limit) {
+    if (spec.numa_pinning) return NumaThreadPool(limit, metrics_label_);
+    if (spec.work_stealing) {
+      return WorkStealingThreadPool(limit, metrics_label_);
+    }
+    return DetachedThreadPool(limit, metrics_label_);
+  };
+  if (spec.limit) {
+    value.executor = make_executor(*spec.limit);
   } else {
-    absl::call_once(shared_executor_once_, [&] {
-      shared_executor_ = DetachedThreadPool(shared_limit_);
+    const SharedExecutorKind kind = spec.numa_pinning    ? kNuma
+                                    : spec.work_stealing ? kWorkStealing
+                                                         : kDetached;
+    absl::call_once(shared_executor_once_[kind], [&] {
+      shared_executor_[kind] = make_executor(shared_limit_);
     });
-    value.executor = shared_executor_;
+    value.executor = shared_executor_[kind];
   }
   return value;
 }
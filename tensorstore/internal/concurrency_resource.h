@@ -50,9 +50,23 @@ namespace internal {
 ///
 /// 3. Register the `Traits` type using a `ContextResourceRegistration` object.
 struct ConcurrencyResource {
-  using Spec = std::optional<size_t>;
-  struct Resource {
+  struct Spec {
     // If equal to `nullopt`, indicates that the shared executor is used.
+    std::optional<size_t> limit;
+
+    // Indicates that the executor is a `WorkStealingThreadPool` rather than a
+    // `DetachedThreadPool`.
+    bool work_stealing = false;
+
+    // Indicates that the executor is a `NumaThreadPool`, with work-stealing
+    // threads pinned to each NUMA node.
+    bool numa_pinning = false;
+
+    constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+      return f(x.limit, x.work_stealing, x.numa_pinning);
+    };
+  };
+  struct Resource {
     Spec spec;
     Executor executor;
   };
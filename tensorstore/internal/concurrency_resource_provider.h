@@ -15,7 +15,10 @@
 #ifndef TENSORSTORE_INTERNAL_CONCURRENCY_RESOURCE_PROVIDER_H_
 #define TENSORSTORE_INTERNAL_CONCURRENCY_RESOURCE_PROVIDER_H_
 
+#include <stddef.h>
+
 #include <optional>
+#include <string_view>
 
 #include "absl/base/call_once.h"
 #include <nlohmann/json.hpp>
@@ -37,10 +40,14 @@ class ConcurrencyResourceTraits {
  public:
   using Spec = typename ConcurrencyResource::Spec;
   using Resource = typename ConcurrencyResource::Resource;
-  ConcurrencyResourceTraits(size_t shared_limit)
-      : shared_limit_(shared_limit) {}
+  /// \param shared_limit Size of the thread pool shared by resources without
+  ///     an explicit `limit`.
+  /// \param metrics_label Label under which the metrics of the thread pools
+  ///     are reported, normally the resource id.
+  ConcurrencyResourceTraits(size_t shared_limit, std::string_view metrics_label)
+      : shared_limit_(shared_limit), metrics_label_(metrics_label) {}
 
-  static Spec Default() { return std::nullopt; }
+  static Spec Default() { return Spec{std::nullopt}; }
 
   static AnyContextResourceJsonBinder<Spec> JsonBinder();
 
@@ -51,11 +58,21 @@ class ConcurrencyResourceTraits {
  private:
   /// Size of thread pool referenced by `shared_executor_`.
   size_t shared_limit_;
+  /// Label of the metrics of the thread pools.
+  std::string_view metrics_label_;
+  /// Kinds of thread pool, used to index `shared_executor_once_` and
+  /// `shared_executor_`.
+  enum SharedExecutorKind {
+    kDetached,
+    kWorkStealing,
+    kNuma,
+    kNumSharedExecutorKinds
+  };
   /// Protects initialization of `shared_executor_`.
-  mutable absl::once_flag shared_executor_once_;
-  /// Lazily-initialization shared thread pool used in the case of a default
-  /// resource specification.
-  mutable Executor shared_executor_;
+  mutable absl::once_flag shared_executor_once_[kNumSharedExecutorKinds];
+  /// Lazily-initialization shared thread pools used in the case of a resource
+  /// specification without a `limit`.
+  mutable Executor shared_executor_[kNumSharedExecutorKinds];
 };
 
 }  // namespace internal
@@ -0,0 +1,121 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/concurrent_arena.h"
+
+#include <stddef.h>
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+
+#include "absl/synchronization/mutex.h"
+
+namespace tensorstore {
+namespace internal {
+namespace {
+
+// Each allocation is preceded by a pointer to its block, padded such that the
+// allocation retains the alignment of the block data.
+constexpr size_t kPrefixSize = alignof(std::max_align_t);
+
+// Assigns shards to threads round-robin as they first allocate.
+size_t GetThreadShardIndex() {
+  static std::atomic<size_t> next_index{0};
+  thread_local const size_t index =
+      next_index.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+}  // namespace
+
+struct alignas(std::max_align_t) ConcurrentArena::Block {
+  // Number of live allocations, plus one while the block is the current block
+  // of a shard.
+  std::atomic<size_t> references{1};
+  ConcurrentArena* arena;
+  // Size of the data following the block header.
+  size_t size;
+
+  unsigned char* data() { return reinterpret_cast<unsigned char*>(this + 1); }
+};
+
+ConcurrentArena::~ConcurrentArena() {
+  for (auto& shard : shards_) {
+    absl::MutexLock lock(&shard.mutex);
+    if (shard.block) ReleaseBlock(shard.block);
+  }
+  assert(allocated_bytes() == 0);
+}
+
+ConcurrentArena::Block* ConcurrentArena::NewBlock(size_t size) {
+  auto* block = new (::operator new(sizeof(Block) + size,
+                                    std::align_val_t(alignof(Block)))) Block;
+  block->arena = this;
+  block->size = size;
+  allocated_bytes_.fetch_add(size, std::memory_order_relaxed);
+  return block;
+}
+
+void ConcurrentArena::ReleaseBlock(Block* block) {
+  if (block->references.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+  block->arena->allocated_bytes_.fetch_sub(block->size,
+                                           std::memory_order_relaxed);
+  block->~Block();
+  ::operator delete(block, std::align_val_t(alignof(Block)));
+}
+
+void* ConcurrentArena::allocate(size_t num_bytes, size_t alignment) {
+  assert(alignment <= alignof(std::max_align_t));
+  const size_t total_bytes = num_bytes + kPrefixSize;
+  Block* block;
+  unsigned char* ptr;
+  if (total_bytes > block_size_ / 4) {
+    // The reference of a dedicated block is held by the allocation.
+    block = NewBlock(total_bytes);
+    ptr = block->data();
+  } else {
+    Block* retired_block = nullptr;
+    {
+      auto& shard = shards_[GetThreadShardIndex() % kNumShards];
+      absl::MutexLock lock(&shard.mutex);
+      void* next = shard.next;
+      if (!std::align(alignment, total_bytes, next, shard.remaining_bytes)) {
+        retired_block = shard.block;
+        shard.block = NewBlock(block_size_);
+        next = shard.block->data();
+        shard.remaining_bytes = block_size_;
+      }
+      block = shard.block;
+      block->references.fetch_add(1, std::memory_order_relaxed);
+      ptr = static_cast<unsigned char*>(next);
+      shard.next = ptr + total_bytes;
+      shard.remaining_bytes -= total_bytes;
+    }
+    // The retired block is freed once its remaining allocations are.
+    if (retired_block) ReleaseBlock(retired_block);
+  }
+  ptr += kPrefixSize;
+  reinterpret_cast<Block**>(ptr)[-1] = block;
+  return ptr;
+}
+
+void ConcurrentArena::deallocate(void* ptr) {
+  ReleaseBlock(reinterpret_cast<Block**>(ptr)[-1]);
+}
+
+}  // namespace internal
+}  // namespace tensorstore
@@ -0,0 +1,143 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_CONCURRENT_ARENA_H_
+#define TENSORSTORE_INTERNAL_CONCURRENT_ARENA_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+
+namespace tensorstore {
+namespace internal {
+
+/// Thread-safe memory allocation arena for the transient state of a single
+/// operation.
+///
+/// Memory is allocated from blocks of `block_size` bytes.  Each block counts
+/// its live allocations and is freed as soon as all of them have been passed
+/// to `deallocate` and it is no longer used for new allocations, so that the
+/// memory held by the arena is bounded by the state that is still in use
+/// rather than by the total number of allocations.
+///
+/// To avoid contention, allocations are served from one of several shards,
+/// each with its own current block and mutex, selected by the calling thread.
+///
+/// This is intended for per-chunk state of an operation that touches many
+/// chunks, which is created and destroyed concurrently from multiple threads.
+class ConcurrentArena {
+ public:
+  constexpr static size_t kDefaultBlockSize = 16 * 1024;
+
+  explicit ConcurrentArena(size_t block_size = kDefaultBlockSize)
+      : block_size_(block_size) {}
+
+  ConcurrentArena(const ConcurrentArena&) = delete;
+  ConcurrentArena& operator=(const ConcurrentArena&) = delete;
+
+  /// Requires that all allocations have been deallocated.
+  ~ConcurrentArena();
+
+  /// Allocates `num_bytes` with the specified alignment, which must not exceed
+  /// `alignof(std::max_align_t)`.
+  ///
+  /// Allocations larger than a quarter of the block size are given their own
+  /// block.
+  void* allocate(size_t num_bytes, size_t alignment);
+
+  /// Deallocates memory returned by `allocate` on any `ConcurrentArena`.
+  ///
+  /// The block containing `ptr` is freed once all of its allocations have been
+  /// deallocated.
+  static void deallocate(void* ptr);
+
+  /// Total bytes of the blocks currently allocated.
+  size_t allocated_bytes() const {
+    return allocated_bytes_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Block;
+
+  struct alignas(64) Shard {
+    absl::Mutex mutex;
+    Block* block ABSL_GUARDED_BY(mutex) = nullptr;
+    unsigned char* next ABSL_GUARDED_BY(mutex) = nullptr;
+    size_t remaining_bytes ABSL_GUARDED_BY(mutex) = 0;
+  };
+
+  constexpr static size_t kNumShards = 8;
+
+  Block* NewBlock(size_t size);
+  static void ReleaseBlock(Block* block);
+
+  const size_t block_size_;
+  std::atomic<size_t> allocated_bytes_{0};
+  Shard shards_[kNumShards];
+};
+
+/// Executor task that invokes an `Op` constructed in a `ConcurrentArena`.
+///
+/// The task itself holds only `OwnerPtr`, a smart pointer to the object that
+/// owns the arena, and a pointer to the `Op`, and therefore fits in the inline
+/// storage of an `ExecutorTask`.  The `Op` is destroyed and deallocated once it
+/// has been invoked or the task is discarded, after which the reference to the
+/// owner is released.
+template <typename OwnerPtr, typename Op>
+class ArenaTask {
+ public:
+  ArenaTask(OwnerPtr owner, ConcurrentArena& arena, Op op)
+      : owner_(std::move(owner)),
+        op_(new (arena.allocate(sizeof(Op), alignof(Op))) Op(std::move(op))) {}
+
+  ArenaTask(ArenaTask&& other) noexcept
+      : owner_(std::move(other.owner_)),
+        op_(std::exchange(other.op_, nullptr)) {}
+
+  ArenaTask& operator=(ArenaTask&& other) = delete;
+
+  ~ArenaTask() {
+    if (op_) Destroy(op_);
+  }
+
+  void operator()() && {
+    Op* op = std::exchange(op_, nullptr);
+    (*op)();
+    Destroy(op);
+  }
+
+ private:
+  static void Destroy(Op* op) {
+    op->~Op();
+    ConcurrentArena::deallocate(op);
+  }
+
+  OwnerPtr owner_;
+  Op* op_;
+};
+
+template <typename OwnerPtr, typename Op>
+ArenaTask(OwnerPtr owner, ConcurrentArena& arena, Op op)
+    -> ArenaTask<OwnerPtr, Op>;
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_CONCURRENT_ARENA_H_
@@ -0,0 +1,122 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/concurrent_arena.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cstring>
+#include <memory>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "tensorstore/util/executor.h"
+
+namespace {
+
+using ::tensorstore::ExecutorTask;
+using ::tensorstore::internal::ArenaTask;
+using ::tensorstore::internal::ConcurrentArena;
+
+TEST(ConcurrentArenaTest, Allocate) {
+  ConcurrentArena arena(1024);
+  EXPECT_EQ(0, arena.allocated_bytes());
+  void* ptr1 = arena.allocate(1, 1);
+  void* ptr2 = arena.allocate(8, 8);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(ptr2) % 8);
+  EXPECT_NE(ptr1, ptr2);
+  EXPECT_EQ(1024, arena.allocated_bytes());
+  ConcurrentArena::deallocate(ptr1);
+  ConcurrentArena::deallocate(ptr2);
+  // The current block is retained for subsequent allocations.
+  EXPECT_EQ(1024, arena.allocated_bytes());
+}
+
+TEST(ConcurrentArenaTest, LargeAllocation) {
+  ConcurrentArena arena(1024);
+  // Large allocations get their own block, which is freed on deallocation.
+  void* ptr = arena.allocate(2000, 8);
+  EXPECT_LE(2000, arena.allocated_bytes());
+  ConcurrentArena::deallocate(ptr);
+  EXPECT_EQ(0, arena.allocated_bytes());
+}
+
+TEST(ConcurrentArenaTest, FreesRetiredBlocks) {
+  ConcurrentArena arena(1024);
+  // Allocations that do not fit in the current block start a new one.
+  std::vector<void*> ptrs;
+  while (arena.allocated_bytes() <= 1024) {
+    ptrs.push_back(arena.allocate(128, 8));
+  }
+  EXPECT_EQ(2048, arena.allocated_bytes());
+  void* last = ptrs.back();
+  ptrs.pop_back();
+
+  // The first block is freed once all of its allocations are deallocated.
+  for (void* ptr : ptrs) ConcurrentArena::deallocate(ptr);
+  EXPECT_EQ(1024, arena.allocated_bytes());
+  ConcurrentArena::deallocate(last);
+}
+
+TEST(ConcurrentArenaTest, Concurrent) {
+  ConcurrentArena arena(1024);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&] {
+      for (int j = 0; j < 1000; ++j) {
+        void* ptr = arena.allocate(100, 8);
+        std::memset(ptr, j, 100);
+        ConcurrentArena::deallocate(ptr);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  // At most the current block of each thread's shard is retained.
+  EXPECT_LE(arena.allocated_bytes(), 4 * 1024);
+}
+
+struct CountingOp {
+  std::shared_ptr<int> calls;
+  void operator()() { ++*calls; }
+};
+
+TEST(ArenaTaskTest, InvokeAndDestroy) {
+  auto owner = std::make_shared<ConcurrentArena>();
+  auto calls = std::make_shared<int>(0);
+  {
+    ExecutorTask task = ArenaTask(owner, *owner, CountingOp{calls});
+    EXPECT_EQ(2, calls.use_count());
+    EXPECT_EQ(2, owner.use_count());
+    std::move(task)();
+    EXPECT_EQ(1, *calls);
+    // The op is destroyed once invoked.
+    EXPECT_EQ(1, calls.use_count());
+  }
+  EXPECT_EQ(1, owner.use_count());
+
+  // The op is destroyed if the task is discarded without being invoked.
+  {
+    ExecutorTask task = ArenaTask(owner, *owner, CountingOp{calls});
+    EXPECT_EQ(2, calls.use_count());
+  }
+  EXPECT_EQ(1, calls.use_count());
+  EXPECT_EQ(1, *calls);
+  EXPECT_EQ(1, owner.use_count());
+}
+
+}  // namespace
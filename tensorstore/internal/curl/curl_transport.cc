@@ -31,7 +31,11 @@
 #include <utility>
 #include <vector>
 
+#include "absl/base/call_once.h"
+#include "absl/base/no_destructor.h"
+#include "absl/base/thread_annotations.h"
 #include "absl/flags/flag.h"
+#include "absl/hash/hash.h"
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
@@ -54,6 +58,8 @@
 #include "tensorstore/internal/metrics/gauge.h"
 #include "tensorstore/internal/metrics/histogram.h"
 #include "tensorstore/internal/metrics/metadata.h"
+#include "tensorstore/internal/os/fork_detection.h"
+#include "tensorstore/internal/thread/fork_registry.h"
 #include "tensorstore/internal/thread/thread.h"
 
 ABSL_FLAG(std::optional<uint32_t>, tensorstore_http_threads, std::nullopt,
@@ -88,6 +94,11 @@ auto& http_request_header_bytes =
         MetricMetadata("HTTP request bytes transmitted",
                        internal_metrics::Units::kBytes));
 
+auto& http_request_cancelled = internal_metrics::Counter<int64_t>::New(
+    "/tensorstore/http/request_cancelled",
+    MetricMetadata("HTTP requests aborted because the response was no longer "
+                   "needed"));
+
 auto& http_response_codes = internal_metrics::Counter<int64_t, int>::New(
     "/tensorstore/http/response_codes", "code",
     MetricMetadata("HTTP response status code counts"));
@@ -158,7 +169,13 @@ struct CurlRequestState {
     handle_.SetOption(CURLOPT_HEADERFUNCTION,
                       &CurlRequestState::CurlHeaderCallback);
 
-    // Consider: CURLOPT_XFERINFOFUNCTION for increased logging.
+    // The progress callback aborts transfers whose response is no longer
+    // needed.  It is invoked as data is transferred, and about once per second
+    // otherwise.
+    handle_.SetOption(CURLOPT_NOPROGRESS, 0L);
+    handle_.SetOption(CURLOPT_XFERINFODATA, this);
+    handle_.SetOption(CURLOPT_XFERINFOFUNCTION,
+                      &CurlRequestState::CurlXferInfoCallback);
   }
 
   ~CurlRequestState() {
@@ -170,6 +187,9 @@ struct CurlRequestState {
     handle_.SetOption(CURLOPT_SEEKFUNCTION, nullptr);
     handle_.SetOption(CURLOPT_HEADERDATA, nullptr);
     handle_.SetOption(CURLOPT_HEADERFUNCTION, nullptr);
+    handle_.SetOption(CURLOPT_XFERINFODATA, nullptr);
+    handle_.SetOption(CURLOPT_XFERINFOFUNCTION, nullptr);
+    handle_.SetOption(CURLOPT_NOPROGRESS, 1L);
     handle_.SetOption(CURLOPT_ERRORBUFFER, nullptr);
     CurlHandle::Cleanup(*factory_, std::move(handle_));
   }
@@ -324,6 +344,15 @@ struct CurlRequestState {
     return n;
   }
 
+  static int CurlXferInfoCallback(void* userdata, curl_off_t dltotal,
+                                  curl_off_t dlnow, curl_off_t ultotal,
+                                  curl_off_t ulnow) {
+    auto* self = static_cast<CurlRequestState*>(userdata);
+    // A non-zero return value aborts the transfer with
+    // CURLE_ABORTED_BY_CALLBACK.
+    return self->response_handler_->IsCancelled() ? 1 : 0;
+  }
+
   static int CurlSeekCallback(void* userdata, curl_off_t offset, int origin) {
     if (origin != SEEK_SET) {
       // According to the documentation:
@@ -344,10 +373,33 @@ struct CurlRequestState {
   }
 };
 
+// Returns the host (and port) of `url`.
+std::string_view GetUrlHost(std::string_view url) {
+  if (auto pos = url.find("://"); pos != std::string_view::npos) {
+    url.remove_prefix(pos + 3);
+  }
+  return url.substr(0, url.find_first_of("/?#"));
+}
+
+// Handles the response to a pre-warming request, which is discarded.
+class PrewarmResponseHandler : public HttpResponseHandler {
+ public:
+  void OnFailure(absl::Status status) override {
+    ABSL_LOG_FIRST_N(INFO, 10) << "Failed to pre-warm connection: " << status;
+    delete this;
+  }
+  void OnStatus(int32_t status_code) override {}
+  void OnResponseHeader(std::string_view field_name,
+                        std::string_view field_value) override {}
+  void OnHeaderBlockDone() override {}
+  void OnResponseBody(std::string_view data) override {}
+  void OnComplete() override { delete this; }
+};
+
 class MultiTransportImpl {
  public:
   MultiTransportImpl(std::shared_ptr<CurlHandleFactory> factory,
-                     size_t nthreads);
+                     size_t nthreads, bool shard_by_host);
 
   ~MultiTransportImpl();
 
@@ -356,6 +408,13 @@ class MultiTransportImpl {
 
   void FinishRequest(std::unique_ptr<CurlRequestState> state, CURLcode code);
 
+  // Fork handlers, see `internal_thread_impl::ForkRegistry`.  `PrepareFork`
+  // locks the request queues until `ParentAfterFork`, or until
+  // `ChildAfterFork` replaces the threads and multi handles.
+  void PrepareFork() ABSL_NO_THREAD_SAFETY_ANALYSIS;
+  void ParentAfterFork() ABSL_NO_THREAD_SAFETY_ANALYSIS;
+  void ChildAfterFork();
+
  private:
   struct ThreadData {
     std::atomic<int64_t> count = 0;
@@ -365,6 +424,9 @@ class MultiTransportImpl {
     bool done = false;
   };
 
+  // Creates the multi handles and starts the threads.
+  void StartThreads(size_t nthreads);
+
   // Runs the thread loop.
   void Run(ThreadData& thread_data);
 
@@ -372,16 +434,39 @@ class MultiTransportImpl {
   void RemoveCompletedTransfers(ThreadData& thread_data);
 
   std::shared_ptr<CurlHandleFactory> factory_;
+  const bool shard_by_host_;
   std::atomic<bool> done_{false};
 
   std::unique_ptr<ThreadData[]> thread_data_;
   std::vector<internal::Thread> threads_;
 };
 
+internal_thread_impl::ForkRegistry<MultiTransportImpl>&
+GetMultiTransportForkRegistry() {
+  static absl::NoDestructor<
+      internal_thread_impl::ForkRegistry<MultiTransportImpl>>
+      registry;
+  return *registry;
+}
+
 MultiTransportImpl::MultiTransportImpl(
-    std::shared_ptr<CurlHandleFactory> factory, size_t nthreads)
-    : factory_(std::move(factory)) {
+    std::shared_ptr<CurlHandleFactory> factory, size_t nthreads,
+    bool shard_by_host)
+    : factory_(std::move(factory)), shard_by_host_(shard_by_host) {
   assert(factory_);
+  StartThreads(nthreads);
+  static absl::once_flag once;
+  absl::call_once(once, [] {
+    internal_os::RegisterForkHandlers({
+        /*prepare=*/+[] { GetMultiTransportForkRegistry().PrepareFork(); },
+        /*parent=*/+[] { GetMultiTransportForkRegistry().ParentAfterFork(); },
+        /*child=*/+[] { GetMultiTransportForkRegistry().ChildAfterFork(); },
+    });
+  });
+  GetMultiTransportForkRegistry().Add(this);
+}
+
+void MultiTransportImpl::StartThreads(size_t nthreads) {
   threads_.reserve(nthreads);
   thread_data_ = std::make_unique<ThreadData[]>(nthreads);
   for (size_t i = 0; i < nthreads; ++i) {
@@ -392,7 +477,32 @@ MultiTransportImpl::MultiTransportImpl(
   }
 }
 
+void MultiTransportImpl::PrepareFork() {
+  for (size_t i = 0; i < threads_.size(); ++i) {
+    thread_data_[i].mutex.Lock();
+  }
+}
+
+void MultiTransportImpl::ParentAfterFork() {
+  for (size_t i = 0; i < threads_.size(); ++i) {
+    thread_data_[i].mutex.Unlock();
+  }
+}
+
+void MultiTransportImpl::ChildAfterFork() {
+  // The threads do not exist in the child process.  Their state, including the
+  // multi handles, is leaked rather than cleaned up, since cleaning up would
+  // shut down the connections that the parent process still uses.  New
+  // connections are established by the new multi handles as needed.
+  const size_t nthreads = threads_.size();
+  (void)thread_data_.release();
+  new std::vector<internal::Thread>(std::move(threads_));
+  threads_.clear();
+  StartThreads(nthreads);
+}
+
 MultiTransportImpl::~MultiTransportImpl() {
+  GetMultiTransportForkRegistry().Remove(this);
   done_ = true;
 
   // Wake everything...
@@ -423,12 +533,17 @@ void MultiTransportImpl::EnqueueRequest(const HttpRequest& request,
   state->response_handler_ = response_handler;
   state->Prepare(request, std::move(options));
 
-  // Select the thread with the fewest active connections, and then enqueue
-  // the request on that thread.
+  // Select the thread with the fewest active connections, or, when sharding
+  // by host, the thread for the host, and then enqueue the request on that
+  // thread.
   size_t selected_index = 0;
-  for (size_t i = 1; i < threads_.size(); ++i) {
-    if (thread_data_[i].count < thread_data_[selected_index].count) {
-      selected_index = i;
+  if (shard_by_host_) {
+    selected_index = absl::HashOf(GetUrlHost(request.url)) % threads_.size();
+  } else {
+    for (size_t i = 1; i < threads_.size(); ++i) {
+      if (thread_data_[i].count < thread_data_[selected_index].count) {
+        selected_index = i;
+      }
     }
   }
 
@@ -468,6 +583,14 @@ void MultiTransportImpl::FinishRequest(std::unique_ptr<CurlRequestState> state,
     http_total_time_ms.Observe(total_time_us / 1000);
   }
 
+  if (code == CURLE_ABORTED_BY_CALLBACK &&
+      state->response_handler_->IsCancelled()) {
+    http_request_cancelled.Increment();
+    state->response_handler_->OnFailure(
+        absl::CancelledError("HTTP request cancelled"));
+    return;
+  }
+
   if (code != CURLE_OK) {
     // Transfer failed; set the status
     state->response_handler_->OnFailure(
@@ -534,13 +657,21 @@ void MultiTransportImpl::Run(ThreadData& thread_data) {
 }
 
 void MultiTransportImpl::MaybeAddPendingTransfers(ThreadData& thread_data) {
-  absl::MutexLock l(&thread_data.mutex);
+  // Requests whose response is no longer needed are not started; they are
+  // failed once the mutex is released, as OnFailure may enqueue requests.
+  std::vector<std::unique_ptr<CurlRequestState>> cancelled;
+  absl::ReleasableMutexLock l(&thread_data.mutex);
   while (!thread_data.pending.empty()) {
     std::unique_ptr<CurlRequestState> state =
         std::move(thread_data.pending.front());
     thread_data.pending.pop_front();
 
     assert(state != nullptr);
+    if (state->response_handler_->IsCancelled()) {
+      thread_data.count--;
+      cancelled.push_back(std::move(state));
+      continue;
+    }
     // Add state to multi handle.
     // Set the CURLINFO_PRIVATE data to take pointer ownership.
     state->handle_.SetOption(CURLOPT_PRIVATE, state.get());
@@ -558,6 +689,12 @@ void MultiTransportImpl::MaybeAddPendingTransfers(ThreadData& thread_data) {
           CurlMCodeToStatus(mcode, "in curl_multi_add_handle"));
     }
   };
+  l.Release();
+  for (auto& state : cancelled) {
+    http_request_cancelled.Increment();
+    state->response_handler_->OnFailure(
+        absl::CancelledError("HTTP request cancelled"));
+  }
 }
 
 void MultiTransportImpl::RemoveCompletedTransfers(ThreadData& thread_data) {
@@ -590,9 +727,12 @@ class CurlTransport::Impl : public MultiTransportImpl {
   using MultiTransportImpl::MultiTransportImpl;
 };
 
-CurlTransport::CurlTransport(std::shared_ptr<CurlHandleFactory> factory)
-    : impl_(std::make_unique<Impl>(std::move(factory),
-                                   /*nthreads=*/GetHttpThreads())) {}
+CurlTransport::CurlTransport(std::shared_ptr<CurlHandleFactory> factory,
+                             CurlTransportOptions options)
+    : impl_(std::make_unique<Impl>(
+          std::move(factory),
+          /*nthreads=*/options.threads > 0 ? options.threads : GetHttpThreads(),
+          options.shard_by_host)) {}
 
 CurlTransport::~CurlTransport() = default;
 
@@ -604,6 +744,25 @@ void CurlTransport::IssueRequestWithHandler(
   impl_->EnqueueRequest(request, std::move(options), response_handler);
 }
 
+void CurlTransport::PrewarmConnections(std::string_view url, size_t count) {
+  assert(impl_);
+  std::string_view scheme;
+  if (auto pos = url.find("://"); pos != std::string_view::npos) {
+    scheme = url.substr(0, pos + 3);
+  }
+  std::string root_url = absl::StrCat(scheme, GetUrlHost(url), "/");
+
+  // The requests are issued concurrently so that each uses a new connection;
+  // once complete, the connections remain in the connection pool. Only the
+  // connection, and not the response, is of interest.
+  for (size_t i = 0; i < count; ++i) {
+    HttpRequest request;
+    request.method = "HEAD";
+    request.url = root_url;
+    impl_->EnqueueRequest(request, {}, new PrewarmResponseHandler);
+  }
+}
+
 std::shared_ptr<HttpTransport> GetDefaultCurlTransport() {
   static std::shared_ptr<HttpTransport> transport =
       std::make_shared<CurlTransport>(GetDefaultCurlHandleFactory());
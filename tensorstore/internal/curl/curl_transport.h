@@ -15,7 +15,10 @@
 #ifndef TENSORSTORE_INTERNAL_CURL_CURL_TRANSPORT_H_
 #define TENSORSTORE_INTERNAL_CURL_CURL_TRANSPORT_H_
 
+#include <stddef.h>
+
 #include <memory>
+#include <string_view>
 
 #include "tensorstore/internal/curl/curl_factory.h"
 #include "tensorstore/internal/curl/curl_handle.h"
@@ -29,11 +32,24 @@ namespace internal_http {
 /// definition can be overridden to set options such as certificate paths.
 void InitializeCurlHandle(CURL* handle);
 
+/// Options for a CurlTransport.
+struct CurlTransportOptions {
+  /// Number of curl_multi threads.  If 0, defaults to
+  /// `TENSORSTORE_HTTP_THREADS`, or 4.
+  size_t threads = 0;
+
+  /// When set, all requests to the same host are issued by the same thread,
+  /// so that they share one connection pool.  Otherwise requests are issued
+  /// by the thread with the fewest active requests.
+  bool shard_by_host = false;
+};
+
 /// Implementation of HttpTransport which uses libcurl via the curl_multi
 /// interface.
 class CurlTransport : public HttpTransport {
  public:
-  explicit CurlTransport(std::shared_ptr<CurlHandleFactory> factory);
+  explicit CurlTransport(std::shared_ptr<CurlHandleFactory> factory,
+                         CurlTransportOptions options = {});
 
   ~CurlTransport() override;
 
@@ -43,6 +59,10 @@ class CurlTransport : public HttpTransport {
                                IssueRequestOptions options,
                                HttpResponseHandler* response_handler) override;
 
+  /// Issues `count` concurrent HEAD requests to the root of the host of
+  /// `url`, leaving the connections in the connection pool for reuse.
+  void PrewarmConnections(std::string_view url, size_t count) override;
+
  private:
   class Impl;
   std::shared_ptr<Impl> impl_;
@@ -19,22 +19,29 @@
 
 #include "tensorstore/internal/curl/curl_transport.h"
 
+#include <stdint.h>
+
+#include <atomic>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
+#include "absl/status/status.h"
 #include "absl/strings/cord.h"
 #include "absl/strings/str_cat.h"
+#include "absl/synchronization/notification.h"
 #include "tensorstore/internal/http/http_request.h"
 #include "tensorstore/internal/http/http_transport.h"
 #include "tensorstore/internal/http/transport_test_utils.h"
 #include "tensorstore/internal/thread/thread.h"
 
 using ::tensorstore::internal_http::HttpRequestBuilder;
+using ::tensorstore::internal_http::HttpResponseHandler;
 using ::tensorstore::internal_http::IssueRequestOptions;
 using ::tensorstore::transport_test_utils::AcceptNonBlocking;
 using ::tensorstore::transport_test_utils::AssertSend;
@@ -211,4 +218,106 @@ TEST_F(CurlTransportTest, Http1Resend) {
   }
 }
 
+TEST_F(CurlTransportTest, PrewarmConnections) {
+  auto transport = ::tensorstore::internal_http::GetDefaultCurlTransport();
+
+  auto socket = CreateBoundSocket();
+  ABSL_CHECK(socket.has_value());
+
+  auto hostport = FormatSocketAddress(*socket);
+  ABSL_CHECK(!hostport.empty());
+
+  static constexpr char kResponse[] =  //
+      "HTTP/1.1 200 OK\r\n"
+      "Content-Length: 0\r\n"
+      "\r\n";
+
+  // The pre-warming request is issued to the root of the host.
+  std::string initial_request;
+  tensorstore::internal::Thread serve_thread({"serve_thread"}, [&] {
+    auto client_fd = AcceptNonBlocking(*socket);
+    ABSL_CHECK(client_fd.has_value());
+    while (initial_request.empty()) {
+      initial_request = ReceiveAvailable(*client_fd);
+    }
+    AssertSend(*client_fd, kResponse);
+    CloseSocket(*client_fd);
+  });
+
+  transport->PrewarmConnections(
+      absl::StrCat("http://", hostport, "/bucket/key?query"), 1);
+
+  serve_thread.Join();
+  CloseSocket(*socket);
+
+  EXPECT_THAT(initial_request, HasSubstr("HEAD / HTTP/1.1\r\n"));
+  EXPECT_THAT(initial_request,
+              HasSubstr(absl::StrCat("Host: ", hostport, "\r\n")));
+}
+
+// Response handler that reports when the request fails.
+class CancellableResponseHandler : public HttpResponseHandler {
+ public:
+  void OnFailure(absl::Status status) override {
+    status_ = std::move(status);
+    done_.Notify();
+  }
+  void OnStatus(int32_t status_code) override {}
+  void OnResponseHeader(std::string_view field_name,
+                        std::string_view field_value) override {}
+  void OnHeaderBlockDone() override {}
+  void OnResponseBody(std::string_view data) override { received_.Notify(); }
+  void OnComplete() override { done_.Notify(); }
+  bool IsCancelled() override { return cancelled_; }
+
+  std::atomic<bool> cancelled_{false};
+  absl::Notification received_;
+  absl::Notification done_;
+  absl::Status status_;
+};
+
+TEST_F(CurlTransportTest, CancelledRequestIsAborted) {
+  auto transport = ::tensorstore::internal_http::GetDefaultCurlTransport();
+
+  auto socket = CreateBoundSocket();
+  ABSL_CHECK(socket.has_value());
+
+  auto hostport = FormatSocketAddress(*socket);
+  ABSL_CHECK(!hostport.empty());
+
+  // The response is never completed.
+  static constexpr char kResponse[] =  //
+      "HTTP/1.1 200 OK\r\n"
+      "Content-Length: 1000\r\n"
+      "\r\n"
+      "partial";
+
+  CancellableResponseHandler handler;
+  tensorstore::internal::Thread serve_thread({"serve_thread"}, [&] {
+    auto client_fd = AcceptNonBlocking(*socket);
+    ABSL_CHECK(client_fd.has_value());
+    std::string request;
+    while (request.empty()) {
+      request = ReceiveAvailable(*client_fd);
+    }
+    AssertSend(*client_fd, kResponse);
+    handler.done_.WaitForNotification();
+    CloseSocket(*client_fd);
+  });
+
+  transport->IssueRequestWithHandler(
+      HttpRequestBuilder("GET", absl::StrCat("http://", hostport, "/"))
+          .BuildRequest(),
+      IssueRequestOptions(), &handler);
+
+  handler.received_.WaitForNotification();
+  handler.cancelled_ = true;
+  handler.done_.WaitForNotification();
+
+  serve_thread.Join();
+  CloseSocket(*socket);
+
+  EXPECT_EQ(absl::StatusCode::kCancelled, handler.status_.code());
+}
+
 }  // namespace
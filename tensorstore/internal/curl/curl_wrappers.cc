@@ -66,6 +66,7 @@ int CurlLogToAbseil(CURL* handle, curl_infotype type, char* data, size_t size,
 void CurlPtrCleanup::operator()(CURL* c) { curl_easy_cleanup(c); }
 void CurlMultiCleanup::operator()(CURLM* m) { curl_multi_cleanup(m); }
 void CurlSlistCleanup::operator()(curl_slist* s) { curl_slist_free_all(s); }
+void CurlShareCleanup::operator()(CURLSH* s) { curl_share_cleanup(s); }
 
 /// Returns the default CurlUserAgent.
 std::string GetCurlUserAgentSuffix() {
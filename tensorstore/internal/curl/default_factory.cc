@@ -22,9 +22,11 @@
 #include <string>
 
 #include "absl/base/attributes.h"
+#include "absl/base/thread_annotations.h"
 #include "absl/flags/flag.h"
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
+#include "absl/synchronization/mutex.h"
 #include <curl/curl.h>  // IWYU pragma: keep
 #include "tensorstore/internal/curl/curl_factory.h"
 #include "tensorstore/internal/curl/curl_wrappers.h"
@@ -53,6 +55,11 @@ ABSL_FLAG(std::optional<std::string>, tensorstore_ca_bundle, std::nullopt,
           "CA Bundle used with http connections. "
           "Overrides TENSORSTORE_CA_BUNDLE.");
 
+ABSL_FLAG(std::optional<int64_t>, tensorstore_curl_dns_cache_timeout_seconds,
+          std::nullopt,
+          "Time for which resolved host names are cached; -1 caches forever. "
+          "Overrides TENSORSTORE_CURL_DNS_CACHE_TIMEOUT_SECONDS.");
+
 ABSL_FLAG(std::optional<uint32_t>, tensorstore_http2_max_concurrent_streams,
           std::nullopt,
           "Maximum concurrent streams for http2 connections. "
@@ -81,6 +88,51 @@ ABSL_CONST_INIT internal_log::VerboseFlag curl_logging("curl");
 
 }  // namespace
 
+/// The DNS and TLS session caches shared by the handles of a factory.
+///
+/// libcurl requires a lock callback for data shared between handles used
+/// concurrently by different threads.
+struct DefaultCurlHandleFactory::SharedCache {
+  SharedCache() : share(curl_share_init()) {
+    ABSL_CHECK(share != nullptr);
+    ABSL_CHECK_EQ(CURLSHE_OK, curl_share_setopt(share.get(), CURLSHOPT_SHARE,
+                                                CURL_LOCK_DATA_DNS));
+    ABSL_CHECK_EQ(CURLSHE_OK, curl_share_setopt(share.get(), CURLSHOPT_SHARE,
+                                                CURL_LOCK_DATA_SSL_SESSION));
+    ABSL_CHECK_EQ(CURLSHE_OK,
+                  curl_share_setopt(share.get(), CURLSHOPT_LOCKFUNC, &Lock));
+    ABSL_CHECK_EQ(CURLSHE_OK, curl_share_setopt(share.get(),
+                                                CURLSHOPT_UNLOCKFUNC, &Unlock));
+    ABSL_CHECK_EQ(CURLSHE_OK,
+                  curl_share_setopt(share.get(), CURLSHOPT_USERDATA, this));
+  }
+
+  static void Lock(CURL*, curl_lock_data data, curl_lock_access, void* userp)
+      ABSL_NO_THREAD_SAFETY_ANALYSIS {
+    static_cast<SharedCache*>(userp)->mutex[data].Lock();
+  }
+
+  static void Unlock(CURL*, curl_lock_data data, void* userp)
+      ABSL_NO_THREAD_SAFETY_ANALYSIS {
+    static_cast<SharedCache*>(userp)->mutex[data].Unlock();
+  }
+
+  absl::Mutex mutex[CURL_LOCK_DATA_LAST];
+  CurlShare share;
+};
+
+DefaultCurlHandleFactory::DefaultCurlHandleFactory(Config config)
+    : config_(std::move(config)) {
+  CurlInit();
+  if (config_.share_dns_and_tls_sessions) {
+    shared_cache_ = std::make_unique<SharedCache>();
+  }
+}
+
+// All handles have been cleaned up by the time the factory is destroyed, as
+// each request holds a reference to the factory.
+DefaultCurlHandleFactory::~DefaultCurlHandleFactory() = default;
+
 /* static */
 DefaultCurlHandleFactory::Config DefaultCurlHandleFactory::DefaultConfig() {
   Config config;
@@ -93,6 +145,16 @@ DefaultCurlHandleFactory::Config DefaultCurlHandleFactory::DefaultConfig() {
                         "TENSORSTORE_CURL_LOW_SPEED_LIMIT_BYTES")
           .value_or(0);
   config.max_http2_concurrent_streams = GetMaxHttp2ConcurrentStreams();
+  config.max_host_connections = 0;
+  config.max_total_connections = 0;
+  config.max_connects = 0;
+  config.tcp_keepalive_idle_seconds = 0;
+  config.max_connection_idle_seconds = 0;
+  config.dns_cache_timeout_seconds =
+      GetFlagOrEnvValue(FLAGS_tensorstore_curl_dns_cache_timeout_seconds,
+                        "TENSORSTORE_CURL_DNS_CACHE_TIMEOUT_SECONDS")
+          .value_or(0);
+  config.share_dns_and_tls_sessions = true;
   config.ca_path =
       GetFlagOrEnvValue(FLAGS_tensorstore_ca_path, "TENSORSTORE_CA_PATH");
   config.ca_bundle =
@@ -154,6 +216,36 @@ CurlPtr DefaultCurlHandleFactory::CreateHandle() {
                     curl_easy_setopt(handle.get(), CURLOPT_CAINFO, x->c_str()));
     }
   }
+  // Enable keep-alive probes, so that idle pooled connections are not dropped
+  // by intermediaries.
+  if (config_.tcp_keepalive_idle_seconds > 0) {
+    const long seconds = config_.tcp_keepalive_idle_seconds;
+    ABSL_CHECK_EQ(CURLE_OK,
+                  curl_easy_setopt(handle.get(), CURLOPT_TCP_KEEPALIVE, 1L));
+    ABSL_CHECK_EQ(CURLE_OK, curl_easy_setopt(handle.get(),
+                                             CURLOPT_TCP_KEEPIDLE, seconds));
+    ABSL_CHECK_EQ(CURLE_OK, curl_easy_setopt(handle.get(),
+                                             CURLOPT_TCP_KEEPINTVL, seconds));
+  }
+  if (config_.max_connection_idle_seconds > 0) {
+    const long seconds = config_.max_connection_idle_seconds;
+    ABSL_CHECK_EQ(CURLE_OK,
+                  curl_easy_setopt(handle.get(), CURLOPT_MAXAGE_CONN, seconds));
+  }
+
+  if (config_.dns_cache_timeout_seconds != 0) {
+    const long seconds = config_.dns_cache_timeout_seconds;
+    ABSL_CHECK_EQ(CURLE_OK, curl_easy_setopt(handle.get(),
+                                             CURLOPT_DNS_CACHE_TIMEOUT,
+                                             seconds));
+  }
+  // Share resolved host names and TLS sessions, which allows new connections
+  // to resume an earlier TLS session rather than perform a full handshake.
+  if (shared_cache_) {
+    ABSL_CHECK_EQ(CURLE_OK, curl_easy_setopt(handle.get(), CURLOPT_SHARE,
+                                             shared_cache_->share.get()));
+  }
+
   // Disable host verification if requested.
   if (!config_.verify_host) {
     ABSL_CHECK_EQ(CURLE_OK,
@@ -176,6 +268,27 @@ CurlMulti DefaultCurlHandleFactory::CreateMultiHandle() {
   ABSL_CHECK_EQ(CURLM_OK,
                 curl_multi_setopt(handle.get(), CURLMOPT_MAX_CONCURRENT_STREAMS,
                                   config_.max_http2_concurrent_streams));
+
+  // Limit the number of connections, so that requests to the same host are
+  // multiplexed over HTTP/2 connections or queued, rather than opening a new
+  // connection for each concurrent request.
+  if (config_.max_host_connections > 0) {
+    const long n = config_.max_host_connections;
+    ABSL_CHECK_EQ(CURLM_OK,
+                  curl_multi_setopt(handle.get(),
+                                    CURLMOPT_MAX_HOST_CONNECTIONS, n));
+  }
+  if (config_.max_total_connections > 0) {
+    const long n = config_.max_total_connections;
+    ABSL_CHECK_EQ(CURLM_OK,
+                  curl_multi_setopt(handle.get(),
+                                    CURLMOPT_MAX_TOTAL_CONNECTIONS, n));
+  }
+  if (config_.max_connects > 0) {
+    const long n = config_.max_connects;
+    ABSL_CHECK_EQ(CURLM_OK,
+                  curl_multi_setopt(handle.get(), CURLMOPT_MAXCONNECTS, n));
+  }
   return handle;
 }
 
@@ -38,6 +38,24 @@ class DefaultCurlHandleFactory : public CurlHandleFactory {
     int64_t low_speed_time_seconds;
     int64_t low_speed_limit_bytes;
     int32_t max_http2_concurrent_streams;
+    /// Limits on the number of connections of each curl_multi handle; 0 means
+    /// unlimited, or, for `max_connects`, the libcurl default.
+    int64_t max_host_connections;
+    int64_t max_total_connections;
+    int64_t max_connects;
+    /// Idle time after which TCP keep-alive probes are sent; 0 disables
+    /// keep-alive probes.
+    int64_t tcp_keepalive_idle_seconds;
+    /// Maximum idle time of a connection that is reused; 0 means the libcurl
+    /// default.
+    int64_t max_connection_idle_seconds;
+    /// Time for which resolved host names are cached; 0 means the libcurl
+    /// default, and -1 caches them forever.
+    int64_t dns_cache_timeout_seconds;
+    /// When set, all handles created by the factory share one DNS cache and
+    /// one TLS session cache, so that name resolution and full TLS handshakes
+    /// are not repeated for each connection to a host.
+    bool share_dns_and_tls_sessions;
     std::optional<std::string> ca_path;
     std::optional<std::string> ca_bundle;
     bool verbose;
@@ -45,10 +63,8 @@ class DefaultCurlHandleFactory : public CurlHandleFactory {
   };
   static Config DefaultConfig();
 
-  explicit DefaultCurlHandleFactory(Config config)
-      : config_(std::move(config)) {
-    CurlInit();
-  }
+  explicit DefaultCurlHandleFactory(Config config);
+  ~DefaultCurlHandleFactory() override;
 
   CurlPtr CreateHandle() override;
   void CleanupHandle(CurlPtr&& h) override { h.reset(); }
@@ -57,7 +73,10 @@ class DefaultCurlHandleFactory : public CurlHandleFactory {
   void CleanupMultiHandle(CurlMulti&& m) override { m.reset(); }
 
  private:
+  struct SharedCache;
+
   Config config_;
+  std::unique_ptr<SharedCache> shared_cache_;
 };
 
 /// Returns the default CurlHandleFactory.
@@ -35,7 +35,8 @@ struct DataCopyConcurrencyResourceTraits
             // Always use at least 1 thread in case
             // `std::thread::hardware_concurrency()` returns 0 (due to being
             // unable to determine number of cpu cores).
-            std::max(size_t(1), size_t(std::thread::hardware_concurrency()))) {}
+            std::max(size_t(1), size_t(std::thread::hardware_concurrency())),
+            DataCopyConcurrencyResource::id) {}
 };
 
 const ContextResourceRegistration<DataCopyConcurrencyResourceTraits>
@@ -21,6 +21,7 @@
 #include "absl/status/status.h"
 #include "tensorstore/array.h"
 #include "tensorstore/data_type.h"
+#include "tensorstore/internal/chunk_buffer_pool.h"
 #include "tensorstore/internal/elementwise_function.h"
 #include "tensorstore/internal/unaligned_data_type_functions.h"
 #include "tensorstore/strided_layout.h"
@@ -132,9 +133,14 @@ void DecodeArray(SharedArrayView<void>* source, endian source_endian,
 SharedArrayView<void> CopyAndDecodeArray(ArrayView<const void> source,
                                          endian source_endian,
                                          StridedLayoutView<> decoded_layout) {
+  auto* pool = internal::GetCurrentChunkBufferPool();
   SharedArrayView<void> target(
-      internal::AllocateAndConstructSharedElements(
-          decoded_layout.num_elements(), default_init, source.dtype()),
+      pool ? SharedElementPointer<void>(
+                 pool->Allocate(decoded_layout.num_elements(), default_init,
+                                source.dtype()),
+                 source.dtype())
+           : internal::AllocateAndConstructSharedElements(
+                 decoded_layout.num_elements(), default_init, source.dtype()),
       decoded_layout);
   DecodeArray(source, source_endian, target);
   return target;
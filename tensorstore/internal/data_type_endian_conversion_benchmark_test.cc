@@ -0,0 +1,80 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+
+#include <complex>
+
+#include <benchmark/benchmark.h>
+#include "tensorstore/array.h"
+#include "tensorstore/contiguous_layout.h"
+#include "tensorstore/index.h"
+#include "tensorstore/internal/data_type_endian_conversion.h"
+#include "tensorstore/util/endian.h"
+
+namespace {
+
+using ::tensorstore::endian;
+using ::tensorstore::Index;
+
+constexpr endian kNonNativeEndian =
+    endian::native == endian::little ? endian::big : endian::little;
+
+// Decodes a non-native-endian array into a separate array.
+template <typename T>
+void BM_DecodeArray(benchmark::State& state) {
+  const Index size = state.range(0);
+  auto source = tensorstore::AllocateArray<T>({size}, tensorstore::c_order,
+                                              tensorstore::value_init);
+  auto target = tensorstore::AllocateArray<T>({size}, tensorstore::c_order,
+                                              tensorstore::value_init);
+  for (auto s : state) {
+    tensorstore::internal::DecodeArray(source, kNonNativeEndian, target);
+    benchmark::DoNotOptimize(target.data());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * size *
+                          sizeof(T));
+}
+
+// Decodes a non-native-endian array in place.
+template <typename T>
+void BM_DecodeArrayInplace(benchmark::State& state) {
+  const Index size = state.range(0);
+  tensorstore::SharedArrayView<void> source = tensorstore::AllocateArray<T>(
+      {size}, tensorstore::c_order, tensorstore::value_init);
+  for (auto s : state) {
+    tensorstore::internal::DecodeArray(&source, kNonNativeEndian,
+                                       source.layout());
+    benchmark::DoNotOptimize(source.data());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * size *
+                          sizeof(T));
+}
+
+template <typename Bench>
+void DefineArgs(Bench* benchmark) {
+  benchmark->Arg(4096);
+  benchmark->Arg(1024 * 1024);
+}
+
+BENCHMARK(BM_DecodeArray<uint16_t>)->Apply(DefineArgs);
+BENCHMARK(BM_DecodeArray<uint32_t>)->Apply(DefineArgs);
+BENCHMARK(BM_DecodeArray<uint64_t>)->Apply(DefineArgs);
+BENCHMARK(BM_DecodeArray<std::complex<float>>)->Apply(DefineArgs);
+BENCHMARK(BM_DecodeArrayInplace<uint16_t>)->Apply(DefineArgs);
+BENCHMARK(BM_DecodeArrayInplace<uint32_t>)->Apply(DefineArgs);
+BENCHMARK(BM_DecodeArrayInplace<uint64_t>)->Apply(DefineArgs);
+BENCHMARK(BM_DecodeArrayInplace<std::complex<float>>)->Apply(DefineArgs);
+
+}  // namespace
@@ -346,6 +346,19 @@ constexpr inline bool HasApplyContiguous<
         std::declval<ExtraArg>()...))>,
     ExtraArg...> = true;
 
+template <typename, typename SFINAE, typename...>
+constexpr inline bool HasApplyStrided = false;
+
+template <typename Func, typename... Element, typename... ExtraArg>
+constexpr inline bool HasApplyStrided<
+    Func(Element...),
+    std::void_t<decltype(std::declval<Func>().template ApplyStrided<Element...>(
+        std::declval<internal::IterationBufferShape>(),
+        std::declval<internal::FirstType<internal::IterationBufferPointer,
+                                         Element>>()...,
+        std::declval<ExtraArg>()...))>,
+    ExtraArg...> = true;
+
 template <typename, typename...>
 struct SimpleLoopTemplate;
 
@@ -397,11 +410,29 @@ struct SimpleLoopTemplate<Func(Element...), ExtraArg...> {
                   HasApplyContiguous<Func(Element...), /*SFINAE=*/void,
                                      ExtraArg...>) {
       return &FastLoop<ArrayAccessor>;
+    } else if constexpr (ArrayAccessor::buffer_kind ==
+                             internal::IterationBufferKind::kStrided &&
+                         !StatelessTraits<Func>::is_stateless &&
+                         HasApplyStrided<Func(Element...), /*SFINAE=*/void,
+                                         ExtraArg...>) {
+      return &StridedLoop;
     } else {
       return &Loop<ArrayAccessor>;
     }
   }
 
+  /// Invokes `Func::ApplyStrided` on the entire block, for functions that
+  /// handle strided buffers more efficiently than element by element.
+  static bool StridedLoop(
+      void* context, internal::IterationBufferShape shape,
+      internal::FirstType<internal::IterationBufferPointer, Element>... pointer,
+      ExtraArg... extra_arg) {
+    internal::PossiblyEmptyObjectGetter<Func> func_helper;
+    Func& func = func_helper.get(static_cast<Func*>(context));
+    return func.template ApplyStrided<Element...>(shape, pointer...,
+                                                  extra_arg...);
+  }
+
   /// \tparam ArrayAccessor The ArrayAccessor type.
   template <typename ArrayAccessor>
   static bool FastLoop(
@@ -58,6 +58,19 @@ struct SwapEndianUnalignedLoopImpl {
     SwapEndianUnaligned<SubElementSize, NumSubElements>(source, target);
   }
 
+  Index ApplyContiguous(Index count, UnalignedValue* value, void* arg) const {
+    SwapEndianUnalignedArray<SubElementSize>(value, value,
+                                             count * NumSubElements);
+    return count;
+  }
+
+  Index ApplyContiguous(Index count, const UnalignedValue* source,
+                        UnalignedValue* target, void* arg) const {
+    SwapEndianUnalignedArray<SubElementSize>(source, target,
+                                             count * NumSubElements);
+    return count;
+  }
+
   using InplaceLoopImpl = internal_elementwise_function::SimpleLoopTemplate<
       SwapEndianUnalignedLoopImpl<SubElementSize, NumSubElements>(
           UnalignedValue),
@@ -264,14 +277,12 @@ struct WriteSwapEndianLoopTemplate {
         const Index end_element_i = std::min(
             shape[1], static_cast<Index>(
                           element_i + (writer.available() / sizeof(Element))));
-        char* cursor = writer.cursor();
-        for (; element_i < end_element_i; ++element_i) {
-          SwapEndianUnaligned<SubElementSize, NumSubElements>(input, cursor);
-          input++;
-          cursor += sizeof(Element);
-        }
+        const Index count = end_element_i - element_i;
+        SwapEndianUnalignedArray<SubElementSize>(input, writer.cursor(),
+                                                 count * NumSubElements);
+        input += count;
         element_i = end_element_i;
-        writer.set_cursor(cursor);
+        writer.move_cursor(count * sizeof(Element));
       }
     }
     return true;
@@ -402,14 +413,12 @@ struct ReadSwapEndianLoopTemplate {
         const Index end_element_i = std::min(
             shape[1], static_cast<Index>(
                           element_i + (reader.available() / sizeof(Element))));
-        const char* cursor = reader.cursor();
-        for (; element_i < end_element_i; ++element_i) {
-          SwapEndianUnaligned<SubElementSize, NumSubElements>(cursor, output);
-          cursor += sizeof(Element);
-          output++;
-        }
+        const Index count = end_element_i - element_i;
+        SwapEndianUnalignedArray<SubElementSize>(reader.cursor(), output,
+                                                 count * NumSubElements);
+        output += count;
         element_i = end_element_i;
-        reader.set_cursor(cursor);
+        reader.move_cursor(count * sizeof(Element));
       }
     }
     return true;
@@ -21,6 +21,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/strings/cord.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/internal/estimate_heap_usage/json.h"
 #include "tensorstore/internal/estimate_heap_usage/std_optional.h"
 #include "tensorstore/internal/estimate_heap_usage/std_variant.h"
 #include "tensorstore/internal/estimate_heap_usage/std_vector.h"
@@ -129,4 +131,16 @@ TEST(EstimateHeapUsageTest, Variant) {
   EXPECT_EQ(capacity, EstimateHeapUsage(Variant(std::move(s))));
 }
 
+TEST(EstimateHeapUsageTest, Json) {
+  EXPECT_EQ(0, EstimateHeapUsage(::nlohmann::json(5)));
+  EXPECT_EQ(0, EstimateHeapUsage(::nlohmann::json(nullptr)));
+  ::nlohmann::json s = std::string(1000, 'x');
+  EXPECT_LE(1000, EstimateHeapUsage(s));
+  ::nlohmann::json obj = {{"a", s}, {"b", {1, 2, 3}}};
+  EXPECT_LT(EstimateHeapUsage(s) + 3 * sizeof(::nlohmann::json),
+            EstimateHeapUsage(obj));
+  // With `max_depth=0`, only the top-level object is counted.
+  EXPECT_GT(EstimateHeapUsage(s), EstimateHeapUsage(obj, /*max_depth=*/0));
+}
+
 }  // namespace
@@ -0,0 +1,76 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_ESTIMATE_HEAP_USAGE_JSON_H_
+#define TENSORSTORE_INTERNAL_ESTIMATE_HEAP_USAGE_JSON_H_
+
+#include <stddef.h>
+
+#include <string>
+
+#include <nlohmann/json.hpp>
+#include "tensorstore/internal/estimate_heap_usage/estimate_heap_usage.h"
+
+namespace tensorstore {
+namespace internal {
+
+template <>
+struct HeapUsageEstimator<::nlohmann::json> {
+  // Approximate per-node overhead of the `std::map` used for objects.
+  constexpr static size_t kObjectNodeOverhead = 32;
+
+  static size_t EstimateHeapUsage(const ::nlohmann::json& j,
+                                  size_t max_depth) {
+    // Objects, arrays, strings and binary values are stored out of line.
+    switch (j.type()) {
+      case ::nlohmann::json::value_t::object: {
+        const auto& obj = j.get_ref<const ::nlohmann::json::object_t&>();
+        size_t total = sizeof(obj);
+        for (const auto& [key, value] : obj) {
+          total += kObjectNodeOverhead + sizeof(key) + sizeof(value) +
+                   internal::EstimateHeapUsage(key);
+          if (max_depth > 0) {
+            total += EstimateHeapUsage(value, max_depth - 1);
+          }
+        }
+        return total;
+      }
+      case ::nlohmann::json::value_t::array: {
+        const auto& arr = j.get_ref<const ::nlohmann::json::array_t&>();
+        size_t total = sizeof(arr) + arr.capacity() * sizeof(::nlohmann::json);
+        if (max_depth > 0) {
+          for (const auto& value : arr) {
+            total += EstimateHeapUsage(value, max_depth - 1);
+          }
+        }
+        return total;
+      }
+      case ::nlohmann::json::value_t::string: {
+        const auto& str = j.get_ref<const std::string&>();
+        return sizeof(str) + internal::EstimateHeapUsage(str);
+      }
+      case ::nlohmann::json::value_t::binary: {
+        const auto& bin = j.get_ref<const ::nlohmann::json::binary_t&>();
+        return sizeof(bin) + bin.capacity();
+      }
+      default:
+        return 0;
+    }
+  }
+};
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_ESTIMATE_HEAP_USAGE_JSON_H_
@@ -30,7 +30,8 @@ struct FileIoConcurrencyResourceTraits
   // TODO(jbms): use better method of picking concurrency limit
   FileIoConcurrencyResourceTraits()
       : ConcurrencyResourceTraits(
-            std::max(size_t(4), size_t(std::thread::hardware_concurrency()))) {}
+            std::max(size_t(4), size_t(std::thread::hardware_concurrency())),
+            FileIoConcurrencyResource::id) {}
 };
 
 const ContextResourceRegistration<FileIoConcurrencyResourceTraits> registration;
@@ -34,64 +34,32 @@
 namespace tensorstore {
 namespace internal {
 
-absl::Status GetChunkKeyRangesForRegularGridWithSemiLexicographicalKeys(
-    const internal_grid_partition::IndexTransformGridPartition& grid_partition,
-    IndexTransformView<> transform,
-    tensorstore::span<const DimensionIndex> grid_output_dimensions,
-    internal::OutputToGridCellFn output_to_grid_cell, BoxView<> grid_bounds,
-    const LexicographicalGridIndexKeyFormatter& key_formatter,
-    absl::FunctionRef<absl::Status(std::string key,
-                                   tensorstore::span<const Index> grid_indices)>
-        handle_key,
-    absl::FunctionRef<absl::Status(KeyRange key_range, BoxView<> grid_bounds)>
-        handle_key_range) {
-  Box<dynamic_rank(kMaxRank)> grid_bounds_copy(grid_bounds);
-  assert(grid_output_dimensions.size() == grid_bounds.rank());
-
-  // Cache of last computed value for
-  // `min_grid_index_for_lexicographical_order`.  In practice will only be
-  // computed for a single dimension.
-  DimensionIndex cached_min_grid_index_for_lexicographical_order_dim = -1;
-  Index cached_min_grid_index_for_lexicographical_order;
-
-  const auto get_min_grid_index_for_lexicographical_order =
-      [&](DimensionIndex dim) {
-        if (dim == cached_min_grid_index_for_lexicographical_order_dim) {
-          return cached_min_grid_index_for_lexicographical_order;
-        }
-        cached_min_grid_index_for_lexicographical_order_dim = dim;
-        return cached_min_grid_index_for_lexicographical_order =
-                   key_formatter.MinGridIndexForLexicographicalOrder(
-                       dim, grid_bounds[dim]);
-      };
-
-  const auto forward_bounds =
-      [&](BoxView<> bounds, DimensionIndex outer_prefix_rank) -> absl::Status {
-    if (bounds.num_elements() == 1) {
-      return handle_key(key_formatter.FormatKey(bounds.origin()),
-                        bounds.origin());
-    }
-    assert(outer_prefix_rank < bounds.rank());
-    if (bounds[outer_prefix_rank] == grid_bounds[outer_prefix_rank]) {
-      // Use prefix as key range.
-      return handle_key_range(KeyRange::Prefix(key_formatter.FormatKey(
-                                  bounds.origin().first(outer_prefix_rank))),
-                              bounds);
-    }
-    DimensionIndex key_dims = outer_prefix_rank + 1;
-    Index inclusive_max_indices[kMaxRank];
-    for (DimensionIndex i = 0; i < key_dims; ++i) {
-      inclusive_max_indices[i] = bounds[i].inclusive_max();
-    }
-    return handle_key_range(
-        KeyRange(key_formatter.FormatKey(bounds.origin().first(key_dims)),
-                 KeyRange::PrefixExclusiveMax(
-                     key_formatter.FormatKey(tensorstore::span<const Index>(
-                         &inclusive_max_indices[0], key_dims)))),
-        bounds);
-  };
-
-  const auto handle_interval = [&](BoxView<> bounds) -> absl::Status {
+namespace {
+
+/// Emits the keys and key ranges for boxes of grid cells of the form
+/// required by `HandleInterval`.
+class ChunkKeyRangeEmitter {
+ public:
+  ChunkKeyRangeEmitter(
+      BoxView<> grid_bounds,
+      const LexicographicalGridIndexKeyFormatter& key_formatter,
+      absl::FunctionRef<absl::Status(
+          std::string key, tensorstore::span<const Index> grid_indices)>
+          handle_key,
+      absl::FunctionRef<absl::Status(KeyRange key_range,
+                                     BoxView<> grid_bounds)>
+          handle_key_range,
+      bool bound_first_dimension = false)
+      : grid_bounds_(grid_bounds),
+        key_formatter_(key_formatter),
+        handle_key_(handle_key),
+        handle_key_range_(handle_key_range),
+        bound_first_dimension_(bound_first_dimension) {}
+
+  /// Handles `bounds`, which must consist of a prefix of dimensions of size
+  /// 1, followed by at most one dimension of arbitrary size, followed by
+  /// dimensions equal to `grid_bounds`.
+  absl::Status HandleInterval(BoxView<> bounds) {
     // Find first dimension of `bounds` where size is not 1.
     DimensionIndex outer_prefix_rank = 0;
     while (outer_prefix_rank < bounds.rank() &&
@@ -101,8 +69,9 @@ absl::Status GetChunkKeyRangesForRegularGridWithSemiLexicographicalKeys(
 
     // Check if `outer_prefix_rank` dimension is unconstrained.
     if (outer_prefix_rank == bounds.rank() ||
-        bounds[outer_prefix_rank] == grid_bounds[outer_prefix_rank]) {
-      return forward_bounds(bounds, outer_prefix_rank);
+        (bounds[outer_prefix_rank] == grid_bounds_[outer_prefix_rank] &&
+         !IsBoundedDimension(outer_prefix_rank))) {
+      return ForwardBounds(bounds, outer_prefix_rank);
     }
 
     // Keys must be restricted by `inner_interval`.
@@ -110,12 +79,12 @@ absl::Status GetChunkKeyRangesForRegularGridWithSemiLexicographicalKeys(
     // Check if a portion of the indices in `inner_interval` need to be split
     // off individually due to lexicographical order / numerical order mismatch.
     const Index min_index_for_lexicographical_order =
-        get_min_grid_index_for_lexicographical_order(outer_prefix_rank);
+        GetMinGridIndexForLexicographicalOrder(outer_prefix_rank);
 
     if (min_index_for_lexicographical_order <=
         bounds.origin()[outer_prefix_rank]) {
       // Entire box is a single lexicographical range.
-      return forward_bounds(bounds, outer_prefix_rank);
+      return ForwardBounds(bounds, outer_prefix_rank);
     }
 
     Box<dynamic_rank(kMaxRank)> new_bounds(bounds);
@@ -127,7 +96,7 @@ absl::Status GetChunkKeyRangesForRegularGridWithSemiLexicographicalKeys(
       new_bounds[outer_prefix_rank] =
           IndexInterval::UncheckedSized(inner_interval.inclusive_min(), 1);
       TENSORSTORE_RETURN_IF_ERROR(
-          forward_bounds(new_bounds, outer_prefix_rank + 1));
+          ForwardBounds(new_bounds, outer_prefix_rank + 1));
       inner_interval = IndexInterval::UncheckedClosed(
           inner_interval.inclusive_min() + 1, inner_interval.inclusive_max());
     }
@@ -137,14 +106,130 @@ absl::Status GetChunkKeyRangesForRegularGridWithSemiLexicographicalKeys(
     // `min_index_for_lexicographical_order`, and therefore it can be handled
     // with a single key range.
     new_bounds[outer_prefix_rank] = inner_interval;
-    return forward_bounds(new_bounds, inner_interval.size() == 1
-                                          ? outer_prefix_rank + 1
-                                          : outer_prefix_rank);
-  };
+    return ForwardBounds(new_bounds, inner_interval.size() == 1
+                                         ? outer_prefix_rank + 1
+                                         : outer_prefix_rank);
+  }
+
+ private:
+  // Returns `true` if the key ranges for `dim` must be bounded explicitly,
+  // rather than by the prefix of the keys of the outer dimensions.  For the
+  // first dimension that prefix is empty, and the range would also include
+  // keys other than chunk keys, such as metadata.
+  bool IsBoundedDimension(DimensionIndex dim) const {
+    return bound_first_dimension_ && dim == 0;
+  }
+
+  Index GetMinGridIndexForLexicographicalOrder(DimensionIndex dim) {
+    // In practice will only be computed for a single dimension.
+    if (dim == cached_dim_) return cached_min_grid_index_;
+    cached_dim_ = dim;
+    return cached_min_grid_index_ =
+               key_formatter_.MinGridIndexForLexicographicalOrder(
+                   dim, grid_bounds_[dim]);
+  }
+
+  absl::Status ForwardBounds(BoxView<> bounds,
+                             DimensionIndex outer_prefix_rank) {
+    if (bounds.num_elements() == 1) {
+      return handle_key_(key_formatter_.FormatKey(bounds.origin()),
+                         bounds.origin());
+    }
+    assert(outer_prefix_rank < bounds.rank());
+    if (bounds[outer_prefix_rank] == grid_bounds_[outer_prefix_rank] &&
+        !IsBoundedDimension(outer_prefix_rank)) {
+      // Use prefix as key range.
+      return handle_key_range_(KeyRange::Prefix(key_formatter_.FormatKey(
+                                   bounds.origin().first(outer_prefix_rank))),
+                               bounds);
+    }
+    DimensionIndex key_dims = outer_prefix_rank + 1;
+    Index inclusive_max_indices[kMaxRank];
+    for (DimensionIndex i = 0; i < key_dims; ++i) {
+      inclusive_max_indices[i] = bounds[i].inclusive_max();
+    }
+    return handle_key_range_(
+        KeyRange(key_formatter_.FormatKey(bounds.origin().first(key_dims)),
+                 KeyRange::PrefixExclusiveMax(
+                     key_formatter_.FormatKey(tensorstore::span<const Index>(
+                         &inclusive_max_indices[0], key_dims)))),
+        bounds);
+  }
+
+  BoxView<> grid_bounds_;
+  const LexicographicalGridIndexKeyFormatter& key_formatter_;
+  absl::FunctionRef<absl::Status(std::string key,
+                                 tensorstore::span<const Index> grid_indices)>
+      handle_key_;
+  absl::FunctionRef<absl::Status(KeyRange key_range, BoxView<> grid_bounds)>
+      handle_key_range_;
+  bool bound_first_dimension_;
+  DimensionIndex cached_dim_ = -1;
+  Index cached_min_grid_index_;
+};
+
+}  // namespace
 
+absl::Status GetChunkKeyRangesForRegularGridWithSemiLexicographicalKeys(
+    const internal_grid_partition::IndexTransformGridPartition& grid_partition,
+    IndexTransformView<> transform,
+    tensorstore::span<const DimensionIndex> grid_output_dimensions,
+    internal::OutputToGridCellFn output_to_grid_cell, BoxView<> grid_bounds,
+    const LexicographicalGridIndexKeyFormatter& key_formatter,
+    absl::FunctionRef<absl::Status(std::string key,
+                                   tensorstore::span<const Index> grid_indices)>
+        handle_key,
+    absl::FunctionRef<absl::Status(KeyRange key_range, BoxView<> grid_bounds)>
+        handle_key_range) {
+  assert(grid_output_dimensions.size() == grid_bounds.rank());
+  ChunkKeyRangeEmitter emitter(grid_bounds, key_formatter, handle_key,
+                               handle_key_range);
   return internal_grid_partition::GetGridCellRanges(
       grid_partition, grid_output_dimensions, grid_bounds, output_to_grid_cell,
-      transform, handle_interval);
+      transform,
+      [&](BoxView<> bounds) { return emitter.HandleInterval(bounds); });
+}
+
+absl::Status GetChunkKeyRangesForRegularGridWithSemiLexicographicalKeys(
+    BoxView<> cell_bounds, BoxView<> grid_bounds,
+    const LexicographicalGridIndexKeyFormatter& key_formatter,
+    absl::FunctionRef<absl::Status(std::string key,
+                                   tensorstore::span<const Index> grid_indices)>
+        handle_key,
+    absl::FunctionRef<absl::Status(KeyRange key_range, BoxView<> grid_bounds)>
+        handle_key_range) {
+  const DimensionIndex rank = cell_bounds.rank();
+  assert(grid_bounds.rank() == rank);
+  if (cell_bounds.is_empty()) return absl::OkStatus();
+  ChunkKeyRangeEmitter emitter(grid_bounds, key_formatter, handle_key,
+                               handle_key_range,
+                               /*bound_first_dimension=*/true);
+  // Dimensions `[interval_dim + 1, rank)` span `grid_bounds`, and are covered
+  // by key prefixes.  Dimensions `[0, interval_dim)` are iterated over
+  // individually.
+  DimensionIndex interval_dim = rank - 1;
+  while (interval_dim >= 0 &&
+         cell_bounds[interval_dim] == grid_bounds[interval_dim]) {
+    --interval_dim;
+  }
+  if (interval_dim <= 0) return emitter.HandleInterval(cell_bounds);
+  Box<dynamic_rank(kMaxRank)> sub_bounds(cell_bounds);
+  for (DimensionIndex i = 0; i < interval_dim; ++i) {
+    sub_bounds[i] = IndexInterval::UncheckedSized(cell_bounds.origin()[i], 1);
+  }
+  while (true) {
+    TENSORSTORE_RETURN_IF_ERROR(emitter.HandleInterval(sub_bounds));
+    DimensionIndex i = interval_dim - 1;
+    for (; i >= 0; --i) {
+      const Index next = sub_bounds.origin()[i] + 1;
+      if (next <= cell_bounds[i].inclusive_max()) {
+        sub_bounds[i] = IndexInterval::UncheckedSized(next, 1);
+        break;
+      }
+      sub_bounds[i] = IndexInterval::UncheckedSized(cell_bounds.origin()[i], 1);
+    }
+    if (i < 0) return absl::OkStatus();
+  }
 }
 
 }  // namespace internal
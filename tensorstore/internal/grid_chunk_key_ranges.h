@@ -75,6 +75,28 @@ absl::Status GetChunkKeyRangesForRegularGridWithSemiLexicographicalKeys(
     absl::FunctionRef<absl::Status(KeyRange key_range, BoxView<> grid_bounds)>
         handle_key_range);
 
+/// Same as above, but computes the keys and key ranges specifying the grid
+/// cells in `cell_bounds`.
+///
+/// Unlike the overload above, the key ranges never extend beyond the keys of
+/// the grid cells, even if `cell_bounds` is equal to `grid_bounds`: the first
+/// dimension is always bounded explicitly rather than by an empty key prefix,
+/// so that the key ranges may safely be deleted from a key space that also
+/// contains other keys.
+///
+/// \param cell_bounds Range of grid indices to cover, must be contained in
+///     `grid_bounds`.
+/// \param grid_bounds Range of grid indices along each grid dimension.  Must be
+///     the same rank as `cell_bounds`.
+absl::Status GetChunkKeyRangesForRegularGridWithSemiLexicographicalKeys(
+    BoxView<> cell_bounds, BoxView<> grid_bounds,
+    const LexicographicalGridIndexKeyFormatter& key_formatter,
+    absl::FunctionRef<absl::Status(std::string key,
+                                   tensorstore::span<const Index> grid_indices)>
+        handle_key,
+    absl::FunctionRef<absl::Status(KeyRange key_range, BoxView<> grid_bounds)>
+        handle_key_range);
+
 }  // namespace internal
 }  // namespace tensorstore
 
@@ -264,4 +264,101 @@ TEST(ChunkKeyRangesTest, Rank2ConstrainedSecondDimOnly) {
                         Box<>{{4, 1}, {1, 7}}})));
 }
 
+Result<std::vector<R>> GetRangesForCells(BoxView<> cell_bounds,
+                                         BoxView<> grid_bounds,
+                                         char dimension_separator) {
+  std::vector<R> ranges;
+  const auto handle_key =
+      [&](std::string key,
+          tensorstore::span<const Index> grid_indices) -> absl::Status {
+    ranges.emplace_back(
+        KeyRange::Singleton(key),
+        Box<>(grid_indices, std::vector<Index>(grid_indices.size(), 1)));
+    return absl::OkStatus();
+  };
+  const auto handle_key_range = [&](KeyRange key_range,
+                                    BoxView<> grid_bounds) -> absl::Status {
+    ranges.emplace_back(std::move(key_range), grid_bounds);
+    return absl::OkStatus();
+  };
+  TENSORSTORE_RETURN_IF_ERROR(
+      GetChunkKeyRangesForRegularGridWithSemiLexicographicalKeys(
+          cell_bounds, grid_bounds,
+          Base10LexicographicalGridIndexKeyParser{cell_bounds.rank(),
+                                                  dimension_separator},
+          handle_key, handle_key_range));
+  return ranges;
+}
+
+TEST(ChunkKeyRangesTest, CellBoundsFullTrailingDimension) {
+  // Grid bounds: [0, 20) x [0, 3)
+  // Cell bounds: [12, 20) x [0, 3)
+  EXPECT_THAT(
+      GetRangesForCells(Box<>({12, 0}, {8, 3}), Box<>({0, 0}, {20, 3}), '.'),
+      Optional(ElementsAre(R{KeyRange("12.", KeyRange::PrefixExclusiveMax(
+                                                 "19.")),
+                             Box<>({12, 0}, {8, 3})})));
+}
+
+TEST(ChunkKeyRangesTest, CellBoundsSplitDigits) {
+  // Grid bounds: [0, 12) x [0, 2)
+  // Cell bounds: [8, 12) x [0, 2)
+  EXPECT_THAT(
+      GetRangesForCells(Box<>({8, 0}, {4, 2}), Box<>({0, 0}, {12, 2}), '/'),
+      Optional(ElementsAre(
+          R{KeyRange::Prefix("8/"), Box<>({8, 0}, {1, 2})},
+          R{KeyRange::Prefix("9/"), Box<>({9, 0}, {1, 2})},
+          R{KeyRange("10/", KeyRange::PrefixExclusiveMax("11/")),
+            Box<>({10, 0}, {2, 2})})));
+}
+
+TEST(ChunkKeyRangesTest, CellBoundsEqualGridBounds) {
+  // Grid bounds: [0, 12) x [0, 2)
+  // Cell bounds: [0, 12) x [0, 2)
+  //
+  // The first dimension is bounded explicitly rather than by the empty prefix.
+  EXPECT_THAT(
+      GetRangesForCells(Box<>({0, 0}, {12, 2}), Box<>({0, 0}, {12, 2}), '.'),
+      Optional(ElementsAre(
+          R{KeyRange::Prefix("0."), Box<>({0, 0}, {1, 2})},
+          R{KeyRange::Prefix("1."), Box<>({1, 0}, {1, 2})},
+          R{KeyRange::Prefix("2."), Box<>({2, 0}, {1, 2})},
+          R{KeyRange::Prefix("3."), Box<>({3, 0}, {1, 2})},
+          R{KeyRange::Prefix("4."), Box<>({4, 0}, {1, 2})},
+          R{KeyRange::Prefix("5."), Box<>({5, 0}, {1, 2})},
+          R{KeyRange::Prefix("6."), Box<>({6, 0}, {1, 2})},
+          R{KeyRange::Prefix("7."), Box<>({7, 0}, {1, 2})},
+          R{KeyRange::Prefix("8."), Box<>({8, 0}, {1, 2})},
+          R{KeyRange::Prefix("9."), Box<>({9, 0}, {1, 2})},
+          R{KeyRange("10.", KeyRange::PrefixExclusiveMax("11.")),
+            Box<>({10, 0}, {2, 2})})));
+
+  // Grid bounds: [0, 5) x [0, 2)
+  // Cell bounds: [0, 5) x [0, 2)
+  EXPECT_THAT(
+      GetRangesForCells(Box<>({0, 0}, {5, 2}), Box<>({0, 0}, {5, 2}), '/'),
+      Optional(ElementsAre(R{
+          KeyRange("0/", KeyRange::PrefixExclusiveMax("4/")),
+          Box<>({0, 0}, {5, 2})})));
+
+  // Grid bounds: [0, 3)
+  // Cell bounds: [0, 3)
+  EXPECT_THAT(GetRangesForCells(Box<>({0}, {3}), Box<>({0}, {3}), '.'),
+              Optional(ElementsAre(R{
+                  KeyRange("0", KeyRange::PrefixExclusiveMax("2")),
+                  Box<>({0}, {3})})));
+}
+
+TEST(ChunkKeyRangesTest, CellBoundsInnerInterval) {
+  // Grid bounds: [0, 2) x [0, 20)
+  // Cell bounds: [0, 2) x [15, 20)
+  EXPECT_THAT(
+      GetRangesForCells(Box<>({0, 15}, {2, 5}), Box<>({0, 0}, {2, 20}), '.'),
+      Optional(ElementsAre(
+          R{KeyRange("0.15", KeyRange::PrefixExclusiveMax("0.19")),
+            Box<>({0, 15}, {1, 5})},
+          R{KeyRange("1.15", KeyRange::PrefixExclusiveMax("1.19")),
+            Box<>({1, 15}, {1, 5})})));
+}
+
 }  // namespace
@@ -0,0 +1,80 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+
+#include <random>
+
+#include <benchmark/benchmark.h>
+#include "tensorstore/array.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_space/index_transform.h"
+#include "tensorstore/index_space/index_transform_builder.h"
+#include "tensorstore/internal/grid_partition_impl.h"
+#include "tensorstore/internal/regular_grid.h"
+#include "tensorstore/util/status.h"
+
+namespace {
+
+using ::tensorstore::DimensionIndex;
+using ::tensorstore::Index;
+using ::tensorstore::IndexTransform;
+using ::tensorstore::IndexTransformBuilder;
+using ::tensorstore::internal_grid_partition::IndexTransformGridPartition;
+using ::tensorstore::internal_grid_partition::
+    PrePartitionIndexTransformOverGrid;
+using ::tensorstore::internal_grid_partition::RegularGridRef;
+
+// Returns a transform that gathers `num_points` random points from a
+// `extent^3` volume, as used for point-sampled reads.
+IndexTransform<> MakePointGatherTransform(Index num_points, Index extent) {
+  std::minstd_rand gen(num_points);
+  std::uniform_int_distribution<Index> dist(0, extent - 1);
+  IndexTransformBuilder<> builder(1, 3);
+  builder.input_shape({num_points});
+  for (DimensionIndex output_dim = 0; output_dim < 3; ++output_dim) {
+    auto index_array = tensorstore::AllocateArray<Index>({num_points});
+    for (Index i = 0; i < num_points; ++i) {
+      index_array(i) = dist(gen);
+    }
+    builder.output_index_array(output_dim, 0, 1, index_array);
+  }
+  return builder.Finalize().value();
+}
+
+// Partitions a random point gather over a regular grid of 64^3 chunks.  The
+// second argument determines the number of grid cells that are touched.
+void BM_PrePartitionPointGather(benchmark::State& state) {
+  const Index num_points = state.range(0);
+  const Index extent = state.range(1);
+  auto transform = MakePointGatherTransform(num_points, extent);
+  const DimensionIndex grid_output_dimensions[] = {0, 1, 2};
+  const Index grid_cell_shape[] = {64, 64, 64};
+  for (auto s : state) {
+    IndexTransformGridPartition partition;
+    TENSORSTORE_CHECK_OK(PrePartitionIndexTransformOverGrid(
+        transform, grid_output_dimensions, RegularGridRef{grid_cell_shape},
+        partition));
+    benchmark::DoNotOptimize(partition);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          num_points);
+}
+
+BENCHMARK(BM_PrePartitionPointGather)
+    ->Args({1024, 1024})
+    ->Args({1024 * 1024, 1024})
+    ->Args({1024 * 1024, 65536});
+
+}  // namespace
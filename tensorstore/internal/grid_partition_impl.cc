@@ -694,24 +694,126 @@ IndirectVectorMap PartitionIndexArraySetGridCellIndexVectors(
   return cells;
 }
 
+/// Same as `PartitionIndexArraySetGridCellIndexVectors`, but uses a counting
+/// sort over the bounding box of the partial grid cell index vectors rather
+/// than a hash map.
+///
+/// This avoids hashing each position twice, and is used when the bounding box
+/// is small relative to `num_positions`, as is typically the case when many
+/// points are gathered from a regular grid.
+///
+/// \param temp_cell_indices Non-null pointer to row-major array of shape
+///     `{num_positions, num_grid_dims}` specifying partial grid cell index
+///     vectors, which may be non-unique and ordered arbitrarily.
+/// \param num_positions First dimension of the `temp_cell_indices` array.
+/// \param num_grid_dims Number of dimensions in the partial grid cell index
+///     vectors.
+/// \param grid_cell_indices[out] Same as for
+///     `PartitionIndexArraySetGridCellIndexVectors`.
+/// \param grid_cell_partition_offsets[out] Same as for
+///     `PartitionIndexArraySetGridCellIndexVectors`.
+/// \param position_offsets[out] Non-null pointer to vector to be resized to a
+///     length of `num_positions`, where `(*position_offsets)[position_i]` will
+///     be set to the offset in the sorted array of position `position_i`.
+///     Positions with equal partial grid cell index vectors retain their
+///     relative order.
+/// \returns `false` (leaving the output vectors in an unspecified state) if
+///     the bounding box is too large for a counting sort to be efficient.
+bool PartitionIndexArraySetGridCellIndexVectorsByCountingSort(
+    const Index* temp_cell_indices, Index num_positions, Index num_grid_dims,
+    std::vector<Index>* grid_cell_indices,
+    std::vector<Index>* grid_cell_partition_offsets,
+    std::vector<Index>* position_offsets) {
+  // Compute the bounding box of the partial grid cell index vectors.
+  Index min_cell[kMaxRank];
+  Index max_cell[kMaxRank];
+  std::copy_n(temp_cell_indices, num_grid_dims, min_cell);
+  std::copy_n(temp_cell_indices, num_grid_dims, max_cell);
+  for (Index position_i = 1; position_i < num_positions; ++position_i) {
+    const Index* cell = temp_cell_indices + position_i * num_grid_dims;
+    for (Index grid_i = 0; grid_i < num_grid_dims; ++grid_i) {
+      min_cell[grid_i] = std::min(min_cell[grid_i], cell[grid_i]);
+      max_cell[grid_i] = std::max(max_cell[grid_i], cell[grid_i]);
+    }
+  }
+  // Limit the size of the temporary count array to a small multiple of the
+  // number of positions.
+  const Index max_num_cells = 2 * num_positions;
+  Index extent[kMaxRank];
+  Index num_cells = 1;
+  for (Index grid_i = 0; grid_i < num_grid_dims; ++grid_i) {
+    if (internal::SubOverflow(max_cell[grid_i], min_cell[grid_i],
+                              &extent[grid_i]) ||
+        internal::AddOverflow(extent[grid_i], Index(1), &extent[grid_i]) ||
+        internal::MulOverflow(num_cells, extent[grid_i], &num_cells) ||
+        num_cells > max_num_cells) {
+      return false;
+    }
+  }
+
+  // Compute the row-major linear index of each partial grid cell index vector
+  // within the bounding box, which orders the vectors lexicographically.
+  position_offsets->resize(num_positions);
+  std::vector<Index> counts(num_cells);
+  for (Index position_i = 0; position_i < num_positions; ++position_i) {
+    const Index* cell = temp_cell_indices + position_i * num_grid_dims;
+    Index linear_index = 0;
+    for (Index grid_i = 0; grid_i < num_grid_dims; ++grid_i) {
+      linear_index =
+          linear_index * extent[grid_i] + (cell[grid_i] - min_cell[grid_i]);
+    }
+    (*position_offsets)[position_i] = linear_index;
+    ++counts[linear_index];
+  }
+
+  // Convert the counts into offsets, and fill `grid_cell_indices` and
+  // `grid_cell_partition_offsets` in lexicographical order.
+  grid_cell_indices->clear();
+  grid_cell_partition_offsets->clear();
+  Index offset = 0;
+  for (Index linear_index = 0; linear_index < num_cells; ++linear_index) {
+    Index& count_or_offset = counts[linear_index];
+    const Index count = count_or_offset;
+    if (count == 0) continue;
+    count_or_offset = offset;
+    grid_cell_partition_offsets->push_back(offset);
+    offset += count;
+    const size_t cell_offset = grid_cell_indices->size();
+    grid_cell_indices->resize(cell_offset + num_grid_dims);
+    Index remainder = linear_index;
+    for (Index grid_i = num_grid_dims - 1; grid_i >= 0; --grid_i) {
+      (*grid_cell_indices)[cell_offset + grid_i] =
+          min_cell[grid_i] + remainder % extent[grid_i];
+      remainder /= extent[grid_i];
+    }
+  }
+
+  // Assign each position its offset in the sorted array.
+  for (Index& linear_index_or_offset : *position_offsets) {
+    linear_index_or_offset = counts[linear_index_or_offset]++;
+  }
+  return true;
+}
+
 /// Computes the partial input index vectors within the domain subset of
 /// `full_input_domain` specified by `input_dims`, and writes them to an array
-/// in a partitioned way according to the `cells` map.
+/// in a partitioned way according to `get_partitioned_offset`.
 ///
 /// \param input_dims The list of distinct input dimensions in the subset, each
 ///     in the range `[0, full_input_domain.rank())`.
 /// \param full_input_domain The full input domain.  Only values at indices in
 ///     `input_dims` are used.
-/// \param cells An IndirectVectorMap that maps each partial grid cell,
-///     identified by a flat input position index, to the starting offset in the
-///     output array at which to write the partial input index vectors.
+/// \param get_partitioned_offset Called once, in order, for each flat input
+///     position index, and returns the offset in the output array at which to
+///     write the corresponding partial input index vector.
 /// \param num_positions The product of `input_shape[d]` for `d` in
 ///     `input_dims`.
 /// \returns A newly allocated array of shape
 ///     `{num_positions, input_dims.count()}` containing the
 SharedArray<Index, 2> GenerateIndexArraySetPartitionedInputIndices(
     DimensionSet input_dims, BoxView<> full_input_domain,
-    IndirectVectorMap cells, Index num_positions) {
+    absl::FunctionRef<Index(Index position_i)> get_partitioned_offset,
+    Index num_positions) {
   const DimensionIndex num_input_dims = input_dims.count();
   Box<dynamic_rank(internal::kNumInlinedDims)> partial_input_domain(
       num_input_dims);
@@ -728,12 +830,9 @@ SharedArray<Index, 2> GenerateIndexArraySetPartitionedInputIndices(
   Index position_i = 0;
   IterateOverIndexRange(
       partial_input_domain, [&](tensorstore::span<const Index> indices) {
-        auto it = cells.find(position_i);
-        assert(it != cells.end());
-        auto& offset = it->second;
+        const Index offset = get_partitioned_offset(position_i);
         std::copy(indices.begin(), indices.end(),
                   partitioned_input_indices.data() + offset * num_input_dims);
-        ++offset;
         ++position_i;
       });
   return partitioned_input_indices;
@@ -799,10 +898,26 @@ absl::Status FillIndexArraySetData(
   // distinct index vectors in `temp_cell_indices`, and
   // `index_array_set.grid_cell_partition_offsets`, which specifies the
   // corresponding offsets, for each of those distinct index vectors, into the
-  // `partitioned_input_indices` array that will be generated.  Also compute a
-  // map `cells` that is used to partition the partial input index vectors
-  // corresponding to each partial grid cell index vector in
-  // `temp_cell_indices`.
+  // `partitioned_input_indices` array that will be generated.  Also compute
+  // the offset of each position in `temp_cell_indices`, which is used to
+  // partition the partial input index vectors.
+  //
+  // When the grid cells lie within a small bounding box, a counting sort is
+  // used; otherwise, the grid cells are grouped using a hash map.
+  std::vector<Index> position_offsets;
+  if (PartitionIndexArraySetGridCellIndexVectorsByCountingSort(
+          temp_cell_indices.data(), num_positions,
+          index_array_set.grid_dimensions.count(),
+          &index_array_set.grid_cell_indices,
+          &index_array_set.grid_cell_partition_offsets, &position_offsets)) {
+    index_array_set.partitioned_input_indices =
+        GenerateIndexArraySetPartitionedInputIndices(
+            index_array_set.input_dimensions, index_transform.domain().box(),
+            [&](Index position_i) { return position_offsets[position_i]; },
+            num_positions);
+    return absl::OkStatus();
+  }
+
   IndirectVectorMap cells = PartitionIndexArraySetGridCellIndexVectors(
       temp_cell_indices.data(), num_positions,
       index_array_set.grid_dimensions.count(),
@@ -815,7 +930,12 @@ absl::Status FillIndexArraySetData(
   index_array_set.partitioned_input_indices =
       GenerateIndexArraySetPartitionedInputIndices(
           index_array_set.input_dimensions, index_transform.domain().box(),
-          std::move(cells), num_positions);
+          [&](Index position_i) {
+            auto it = cells.find(position_i);
+            assert(it != cells.end());
+            return it->second++;
+          },
+          num_positions);
   return absl::OkStatus();
 }
 
@@ -297,6 +297,34 @@ TEST(PrePartitionIndexTransformOverRegularGridTest, SingleIndexArrayDimension) {
   EXPECT_THAT(partitioned.strided_sets(), ElementsAre());
 }
 
+// Tests that grid cells spread over a large range, which are grouped using a
+// hash map rather than a counting sort, are partitioned in the same way.
+TEST(PrePartitionIndexTransformOverRegularGridTest, SparseIndexArrayCells) {
+  auto transform =
+      tensorstore::IndexTransformBuilder<>(1, 1)
+          .input_origin({0})
+          .input_shape({4})
+          .output_index_array(0, 0, 1,
+                              MakeArray<Index>({0, 1000000, 8, 1000001}))
+          .Finalize()
+          .value();
+  const DimensionIndex grid_output_dimensions[] = {0};
+  const Index grid_cell_shape[] = {4};
+  IndexTransformGridPartition partitioned;
+  TENSORSTORE_CHECK_OK(PrePartitionIndexTransformOverGrid(
+      transform, grid_output_dimensions, RegularGridRef{grid_cell_shape},
+      partitioned));
+  EXPECT_THAT(
+      partitioned.index_array_sets(),
+      ElementsAre(IndexTransformGridPartition::IndexArraySet{
+          /*.grid_dimensions=*/DimensionSet::FromIndices({0}),
+          /*.input_dimensions=*/DimensionSet::FromIndices({0}),
+          /*.grid_cell_indices=*/{0, 2, 250000},
+          /*.partitioned_input_indices=*/MakeArray<Index>({{0}, {2}, {1}, {3}}),
+          /*.grid_cell_partition_offsets=*/{0, 1, 2}}));
+  EXPECT_THAT(partitioned.strided_sets(), ElementsAre());
+}
+
 // Tests that two output dimensions (included in grid_output_dimensions), where
 // one depends on the single input dimension using a `single_input_dimension`
 // output index map, and the other depends on the single input dimension using
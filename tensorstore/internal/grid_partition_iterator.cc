@@ -30,6 +30,7 @@
 #include "tensorstore/index_space/output_index_map.h"
 #include "tensorstore/index_space/output_index_method.h"
 #include "tensorstore/internal/grid_partition_impl.h"
+#include "tensorstore/util/result.h"
 #include "tensorstore/util/span.h"
 #include "tensorstore/util/status.h"
 
@@ -38,6 +39,8 @@ namespace internal_grid_partition {
 
 using IndexArraySet = IndexTransformGridPartition::IndexArraySet;
 using StridedSet = IndexTransformGridPartition::StridedSet;
+using ::tensorstore::internal_index_space::OutputIndexMap;
+using ::tensorstore::internal_index_space::TransformRep;
 
 PartitionIndexTransformIterator::PartitionIndexTransformIterator(
     tensorstore::span<const DimensionIndex> grid_output_dimensions,
@@ -47,6 +50,7 @@ PartitionIndexTransformIterator::PartitionIndexTransformIterator(
       output_to_grid_cell_(std::move(output_to_grid_cell)),
       transform_(std::move(transform)),
       at_end_(true),
+      has_index_array_maps_(false),
       output_grid_cell_indices_(grid_output_dimensions_.size()),
       position_(0),
       upper_bound_(0),
@@ -57,10 +61,60 @@ absl::Status PartitionIndexTransformIterator::Init() {
       transform_, grid_output_dimensions_, output_to_grid_cell_,
       partition_info_));
   cell_transform_ = InitializeCellTransform(partition_info_, transform_);
+  for (DimensionIndex output_dim = 0; output_dim < transform_.output_rank();
+       ++output_dim) {
+    if (transform_.output_index_map(output_dim).method() ==
+        OutputIndexMethod::array) {
+      has_index_array_maps_ = true;
+      break;
+    }
+  }
   InitializePositions();
   return absl::OkStatus();
 }
 
+Result<IndexTransform<>>
+PartitionIndexTransformIterator::GetCellToOutputTransform() {
+  if (has_index_array_maps_) {
+    return ComposeTransforms(transform_, cell_transform());
+  }
+  // Without index array maps there are no index array connected sets, so each
+  // input dimension of `transform_` is mapped by a `single_input_dimension`
+  // map of the cell transform with an offset of 0 and stride of 1.  The
+  // composed transform therefore has the cell domain, and each output index
+  // map of `transform_` applies unchanged to the corresponding cell input
+  // dimension.
+  TransformRep* cell_rep = cell_transform_.get();
+  TransformRep* full_rep =
+      internal_index_space::TransformAccess::rep(transform_);
+  const DimensionIndex output_rank = full_rep->output_rank;
+  auto result = TransformRep::Allocate(cell_rep->input_rank, output_rank);
+  internal_index_space::CopyTransformRepDomain(cell_rep, result.get());
+  result->output_rank = output_rank;
+  const auto cell_maps = cell_rep->output_index_maps();
+  const auto full_maps = full_rep->output_index_maps().first(output_rank);
+  const auto result_maps = result->output_index_maps().first(output_rank);
+  for (DimensionIndex output_dim = 0; output_dim < output_rank;
+       ++output_dim) {
+    const OutputIndexMap& full_map = full_maps[output_dim];
+    OutputIndexMap& result_map = result_maps[output_dim];
+    result_map.offset() = full_map.offset();
+    if (full_map.method() == OutputIndexMethod::constant ||
+        full_map.stride() == 0) {
+      result_map.SetConstant();
+      result_map.stride() = 0;
+      continue;
+    }
+    const OutputIndexMap& cell_map = cell_maps[full_map.input_dimension()];
+    ABSL_DCHECK(cell_map.method() == OutputIndexMethod::single_input_dimension);
+    result_map.SetSingleInputDimension(cell_map.input_dimension());
+    result_map.stride() = full_map.stride();
+  }
+  internal_index_space::DebugCheckInvariants(result.get());
+  return internal_index_space::TransformAccess::Make<IndexTransform<>>(
+      std::move(result));
+}
+
 void PartitionIndexTransformIterator::InitializePositions() {
   at_end_ = false;
   position_.resize(rank());
@@ -30,6 +30,7 @@
 #include "tensorstore/index_space/internal/transform_rep.h"
 #include "tensorstore/internal/grid_partition_impl.h"
 #include "tensorstore/util/iterate.h"
+#include "tensorstore/util/result.h"
 #include "tensorstore/util/span.h"
 
 namespace tensorstore {
@@ -70,6 +71,14 @@ class PartitionIndexTransformIterator {
         cell_transform_.get());
   }
 
+  /// Returns the composition of `transform` with the current cell transform,
+  /// which maps the cell domain to the output space of `transform`.
+  ///
+  /// Equivalent to `ComposeTransforms(transform, cell_transform())`, but
+  /// computed directly, without bounds propagation, when `transform` has no
+  /// index array output index maps.
+  Result<IndexTransform<>> GetCellToOutputTransform();
+
   /// Indicates whether iteration has completed.
   /// When false, both cell_transform() and output_grid_cell_indices() are
   /// valid.
@@ -120,6 +129,10 @@ class PartitionIndexTransformIterator {
   IndexTransformView<> transform_;
   bool at_end_;
 
+  // Whether `transform_` has any index array output index maps, in which case
+  // `GetCellToOutputTransform` must use general transform composition.
+  bool has_index_array_maps_;
+
   // This stores the current value of `cell_transform[h]`, as defined in
   // grid_partition.h, for `h = grid_cell_indices_`.  This is modified in
   // place while iterating over all values for grid_cell_indices_.
@@ -30,6 +30,8 @@
 #include "tensorstore/internal/regular_grid.h"
 #include "tensorstore/util/span.h"
 #include "tensorstore/util/status.h"
+#include "tensorstore/util/status_testutil.h"
+#include "tensorstore/util/str_cat.h"
 
 namespace {
 
@@ -86,6 +88,10 @@ absl::Status PartitionIndexTransformOverGrid(
   TENSORSTORE_RETURN_IF_ERROR(iterator.Init());
 
   while (!iterator.AtEnd()) {
+    // The direct computation must agree with general composition.
+    EXPECT_EQ(
+        tensorstore::ComposeTransforms(transform, iterator.cell_transform()),
+        iterator.GetCellToOutputTransform());
     TENSORSTORE_RETURN_IF_ERROR(
         func(iterator.output_grid_cell_indices(), iterator.cell_transform()));
     iterator.Advance();
@@ -739,4 +745,48 @@ TEST(PartitionIndexTransformOverRegularGrid,
                 .value()}));
 }
 
+TEST(PartitionIndexTransformIteratorTest, GetCellToOutputTransform) {
+  const std::vector<DimensionIndex> grid_output_dimensions{0, 2};
+  const std::vector<Index> grid_cell_shape{4, 3};
+  RegularGridRef grid{grid_cell_shape};
+  for (const auto& transform : {
+           // Strided maps only, with labels, a constant map, a map to a
+           // non-grid output dimension, and an input dimension that does not
+           // affect the grid.
+           IndexTransformBuilder<>(4, 4)
+               .input_origin({0, 5, -2, 1})
+               .input_shape({7, 3, 4, 2})
+               .input_labels({"x", "y", "z", "w"})
+               .output_single_input_dimension(0, 3, 2, 1)
+               .output_constant(1, 7)
+               .output_single_input_dimension(2, 1, -1, 0)
+               .output_single_input_dimension(3, 0, 1, 2)
+               .Finalize()
+               .value(),
+           // Index array map to a non-grid output dimension.
+           IndexTransformBuilder<>(2, 3)
+               .input_origin({0, 0})
+               .input_shape({5, 3})
+               .output_single_input_dimension(0, 0)
+               .output_index_array(1, 0, 1, MakeArray<Index>({{4, 2, 9}}))
+               .output_single_input_dimension(2, 1)
+               .Finalize()
+               .value(),
+       }) {
+    SCOPED_TRACE(tensorstore::StrCat("transform=", transform));
+    PartitionIndexTransformIterator iterator(grid_output_dimensions, grid,
+                                             transform);
+    TENSORSTORE_ASSERT_OK(iterator.Init());
+    Index num_cells = 0;
+    for (; !iterator.AtEnd(); iterator.Advance(), ++num_cells) {
+      TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto cell_to_output,
+                                       iterator.GetCellToOutputTransform());
+      EXPECT_EQ(
+          tensorstore::ComposeTransforms(transform, iterator.cell_transform()),
+          cell_to_output);
+    }
+    EXPECT_LT(1, num_cells);
+  }
+}
+
 }  // namespace
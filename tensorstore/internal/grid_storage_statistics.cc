@@ -24,16 +24,19 @@
 #include <utility>
 #include <vector>
 
+#include "absl/functional/function_ref.h"
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
 #include "absl/time/time.h"
 #include "tensorstore/array_storage_statistics.h"
+#include "tensorstore/batch.h"
 #include "tensorstore/box.h"
 #include "tensorstore/index.h"
 #include "tensorstore/index_interval.h"
 #include "tensorstore/index_space/index_transform.h"
 #include "tensorstore/internal/grid_chunk_key_ranges.h"
 #include "tensorstore/internal/grid_chunk_key_ranges_base10.h"
+#include "tensorstore/internal/grid_partition.h"
 #include "tensorstore/internal/grid_partition_impl.h"
 #include "tensorstore/internal/integer_overflow.h"
 #include "tensorstore/internal/intrusive_ptr.h"
@@ -48,6 +51,7 @@
 #include "tensorstore/rank.h"
 #include "tensorstore/util/division.h"
 #include "tensorstore/util/future.h"
+#include "tensorstore/util/iterate_over_index_range.h"
 #include "tensorstore/util/quote_string.h"
 #include "tensorstore/util/span.h"
 #include "tensorstore/util/status.h"
@@ -112,6 +116,40 @@ struct ListReceiver {
   }
 };
 
+// Determines whether the chunk `grid_indices` is present by issuing a
+// `Stat` read of `key` as part of `batch`.
+//
+// Batching allows sharded kvstores to determine presence from their shard
+// indexes, rather than with a separate request per chunk.
+void CheckChunkPresent(
+    const internal::IntrusivePtr<GridStorageStatisticsChunkHandler>& handler,
+    const KvStore& kvs, std::string key,
+    tensorstore::span<const Index> grid_indices, absl::Time staleness_bound,
+    const Batch& batch) {
+  kvstore::ReadOptions read_options;
+  read_options.byte_range = OptionalByteRangeRequest::Stat();
+  read_options.staleness_bound = staleness_bound;
+  read_options.batch = batch;
+  LinkValue(
+      [handler, grid_indices = std::vector<Index>(grid_indices.begin(),
+                                                  grid_indices.end())](
+          Promise<ArrayStorageStatistics> promise,
+          ReadyFuture<kvstore::ReadResult> future) {
+        auto& read_result = future.value();
+        if (!read_result.has_value()) {
+          handler->state->ChunkMissing();
+        } else {
+          handler->ChunkPresent(grid_indices);
+        }
+      },
+      handler->state->promise,
+      kvstore::Read(kvs, std::move(key), std::move(read_options)));
+}
+
+// Returned by key and key range callbacks to stop enumerating chunks once the
+// result is known, which for large sparse grids may save most of the work.
+absl::Status StopEarly() { return absl::CancelledError(); }
+
 }  // namespace
 
 GridStorageStatisticsChunkHandler::~GridStorageStatisticsChunkHandler() =
@@ -175,32 +213,23 @@ void GetStorageStatisticsForRegularGridWithSemiLexicographicalKeys(
   // operations.
 
   int64_t total_chunks = 0;
+  Batch batch = Batch::New();
+  bool stopped_early = false;
 
   const auto handle_key = [&](std::string key,
                               tensorstore::span<const Index> grid_indices) {
     ABSL_LOG_IF(INFO, TENSORSTORE_INTERNAL_GRID_STORAGE_STATISTICS_DEBUG)
         << "key: " << tensorstore::QuoteString(key);
+    if (!handler->state->promise.result_needed()) {
+      stopped_early = true;
+      return StopEarly();
+    }
     if (internal::AddOverflow<Index>(total_chunks, 1, &total_chunks)) {
       return absl::OutOfRangeError(
           "Integer overflow computing number of chunks");
     }
-    kvstore::ReadOptions read_options;
-    read_options.byte_range = OptionalByteRangeRequest::Stat();
-    read_options.staleness_bound = staleness_bound;
-    LinkValue(
-        [handler, grid_indices = std::vector<Index>(grid_indices.begin(),
-                                                    grid_indices.end())](
-            Promise<ArrayStorageStatistics> promise,
-            ReadyFuture<kvstore::ReadResult> future) {
-          auto& read_result = future.value();
-          if (!read_result.has_value()) {
-            handler->state->ChunkMissing();
-          } else {
-            handler->ChunkPresent(grid_indices);
-          }
-        },
-        handler->state->promise,
-        kvstore::Read(kvs, std::move(key), std::move(read_options)));
+    CheckChunkPresent(handler, kvs, std::move(key), grid_indices,
+                      staleness_bound, batch);
     return absl::OkStatus();
   };
 
@@ -208,6 +237,10 @@ void GetStorageStatisticsForRegularGridWithSemiLexicographicalKeys(
                                     BoxView<> grid_bounds) -> absl::Status {
     ABSL_LOG_IF(INFO, TENSORSTORE_INTERNAL_GRID_STORAGE_STATISTICS_DEBUG)
         << "key_range: " << key_range << ", grid_bounds=" << grid_bounds;
+    if (!handler->state->promise.result_needed()) {
+      stopped_early = true;
+      return StopEarly();
+    }
     Index cur_total_chunks = grid_bounds.num_elements();
     if (cur_total_chunks == std::numeric_limits<Index>::max()) {
       return absl::OutOfRangeError(tensorstore::StrCat(
@@ -234,16 +267,78 @@ void GetStorageStatisticsForRegularGridWithSemiLexicographicalKeys(
           output_to_grid_cell, handler->grid_partition),
       handler->state->SetError(_));
 
-  TENSORSTORE_RETURN_IF_ERROR(
+  absl::Status status =
       internal::GetChunkKeyRangesForRegularGridWithSemiLexicographicalKeys(
           handler->grid_partition, handler->full_transform,
           handler->grid_output_dimensions, output_to_grid_cell, grid_bounds,
-          *handler->key_formatter, handle_key, handle_key_range),
-      handler->state->SetError(_));
+          *handler->key_formatter, handle_key, handle_key_range);
+  if (!status.ok() && !stopped_early) {
+    handler->state->SetError(std::move(status));
+    return;
+  }
 
   handler->state->total_chunks += total_chunks;
 }
 
+Future<ArrayStorageStatistics>
+GetStorageStatisticsForRegularGridWithUnorderedKeys(
+    const KvStore& kvs, IndexTransformView<> transform,
+    tensorstore::span<const DimensionIndex> grid_output_dimensions,
+    tensorstore::span<const Index> chunk_shape, BoxView<> grid_bounds,
+    absl::FunctionRef<std::string(tensorstore::span<const Index>)> get_key,
+    absl::Time staleness_bound, GetArrayStorageStatisticsOptions options) {
+  Future<ArrayStorageStatistics> future;
+  auto handler =
+      internal::MakeIntrusivePtr<GridStorageStatisticsChunkHandler>();
+  // Note: `future` is a output parameter.
+  handler->state =
+      internal::MakeIntrusivePtr<GetStorageStatisticsAsyncOperationState>(
+          future, options);
+  handler->full_transform = transform;
+  handler->grid_output_dimensions = grid_output_dimensions;
+  handler->chunk_shape = chunk_shape;
+  handler->key_formatter = nullptr;
+
+  internal_grid_partition::RegularGridRef output_to_grid_cell{chunk_shape};
+  TENSORSTORE_RETURN_IF_ERROR(
+      internal_grid_partition::PrePartitionIndexTransformOverGrid(
+          handler->full_transform, grid_output_dimensions,
+          output_to_grid_cell, handler->grid_partition),
+      (handler->state->SetError(_), future));
+
+  int64_t total_chunks = 0;
+  Batch batch = Batch::New();
+  bool stopped_early = false;
+  absl::Status status = internal_grid_partition::GetGridCellRanges(
+      handler->grid_partition, grid_output_dimensions, grid_bounds,
+      output_to_grid_cell, handler->full_transform,
+      [&](BoxView<> bounds) -> absl::Status {
+        if (internal::AddOverflow<Index>(total_chunks, bounds.num_elements(),
+                                         &total_chunks)) {
+          return absl::OutOfRangeError(
+              "Integer overflow computing number of chunks");
+        }
+        const bool completed = IterateOverIndexRange(
+            bounds, [&](tensorstore::span<const Index> grid_indices) {
+              if (!handler->state->promise.result_needed()) return false;
+              CheckChunkPresent(handler, kvs, get_key(grid_indices),
+                                grid_indices, staleness_bound, batch);
+              return true;
+            });
+        if (!completed) {
+          stopped_early = true;
+          return StopEarly();
+        }
+        return absl::OkStatus();
+      });
+  if (!status.ok() && !stopped_early) {
+    handler->state->SetError(std::move(status));
+    return future;
+  }
+  handler->state->total_chunks += total_chunks;
+  return future;
+}
+
 Future<ArrayStorageStatistics> GetStorageStatisticsForRegularGridWithBase10Keys(
     const KvStore& kvs, IndexTransformView<> transform,
     tensorstore::span<const DimensionIndex> grid_output_dimensions,
@@ -16,7 +16,9 @@
 #define TENSORSTORE_INTERNAL_GRID_STORAGE_STATISTICS_H_
 
 #include <memory>
+#include <string>
 
+#include "absl/functional/function_ref.h"
 #include "absl/time/time.h"
 #include "tensorstore/array_storage_statistics.h"
 #include "tensorstore/box.h"
@@ -70,6 +72,36 @@ Future<ArrayStorageStatistics> GetStorageStatisticsForRegularGridWithBase10Keys(
     tensorstore::span<const Index> shape, char dimension_separator,
     absl::Time staleness_bound, GetArrayStorageStatisticsOptions options);
 
+// Computes array storage statistics for drivers that map each chunk to a
+// separate key, where the keys are not ordered such that chunk ranges can be
+// determined by listing.
+//
+// The presence of each chunk is determined by a `Stat` read of its key.  All
+// reads are issued as part of a single batch, such that kvstores that store
+// multiple chunks per object (e.g. `neuroglancer_uint64_sharded`) can answer
+// them from a small number of index lookups.  Enumeration of chunks stops
+// early once the requested statistics are known.
+//
+// Args:
+//   kvs: Key-value store.
+//   transform: Index transform.
+//   grid_output_dimensions: Output dimensions of `transform` corresponding to
+//     each grid dimension.
+//   chunk_shape: Chunk size along each grid dimension.  Must be the same length
+//     as `grid_output_dimensions`.
+//   grid_bounds: Range of grid indices along each grid dimension.  Must be the
+//     same rank as `grid_output_dimensions`.
+//   get_key: Returns the key for the specified grid cell indices.
+//   staleness_bound: Staleness bound to use for kvstore operations.
+//   options: Specifies which statistics to compute.
+Future<ArrayStorageStatistics>
+GetStorageStatisticsForRegularGridWithUnorderedKeys(
+    const KvStore& kvs, IndexTransformView<> transform,
+    tensorstore::span<const DimensionIndex> grid_output_dimensions,
+    tensorstore::span<const Index> chunk_shape, BoxView<> grid_bounds,
+    absl::FunctionRef<std::string(tensorstore::span<const Index>)> get_key,
+    absl::Time staleness_bound, GetArrayStorageStatisticsOptions options);
+
 struct GridStorageStatisticsChunkHandler
     : public internal::AtomicReferenceCount<GridStorageStatisticsChunkHandler> {
   internal::IntrusivePtr<GetStorageStatisticsAsyncOperationState> state;
@@ -19,6 +19,8 @@
 #include <stdint.h>
 
 #include <cassert>
+#include <functional>
+#include <string>
 #include <string_view>
 #include <utility>
 
@@ -27,11 +29,14 @@
 #include "absl/log/check.h"
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
+#include "absl/strings/str_format.h"
 #include "riegeli/bytes/cord_writer.h"
 #include "tensorstore/internal/http/http_header.h"
 #include "tensorstore/internal/http/http_request.h"
 #include "tensorstore/internal/http/http_response.h"
 #include "tensorstore/internal/log/verbose_flag.h"
+#include "tensorstore/internal/tracing/operation_trace_span.h"
+#include "tensorstore/internal/tracing/trace_context.h"
 #include "tensorstore/util/future.h"
 
 namespace tensorstore {
@@ -40,10 +45,19 @@ namespace {
 
 ABSL_CONST_INIT internal_log::VerboseFlag verbose("http_transport");
 
+// Returns the W3C Trace Context `traceparent` header value for `context`.
+std::string FormatTraceParentHeader(
+    const internal_tracing::SpanContext& context) {
+  return absl::StrFormat("00-%016x%016x-%016x-01", context.trace_id_high,
+                         context.trace_id_low, context.span_id);
+}
+
 // Adapts the IssueRequestWithHandler api to IssueRequest.
 class LegacyHttpResponseHandler : public HttpResponseHandler {
  public:
-  LegacyHttpResponseHandler(Promise<HttpResponse> p);
+  LegacyHttpResponseHandler(
+      Promise<HttpResponse> p,
+      std::function<void(size_t)> response_body_callback);
 
   ~LegacyHttpResponseHandler() override = default;
 
@@ -55,17 +69,23 @@ class LegacyHttpResponseHandler : public HttpResponseHandler {
   void OnHeaderBlockDone() override;
   void OnResponseBody(std::string_view data) override;
   void OnComplete() override;
+  bool IsCancelled() override { return !promise_.result_needed(); }
 
  private:
   Promise<HttpResponse> promise_;
+  std::function<void(size_t)> response_body_callback_;
   absl::Cord data_;
   riegeli::CordWriter<absl::Cord*> writer_;
   int32_t status_code_ = 0;
   HeaderMap headers_;
 };
 
-LegacyHttpResponseHandler::LegacyHttpResponseHandler(Promise<HttpResponse> p)
-    : promise_(std::move(p)), writer_(&data_) {}
+LegacyHttpResponseHandler::LegacyHttpResponseHandler(
+    Promise<HttpResponse> p,
+    std::function<void(size_t)> response_body_callback)
+    : promise_(std::move(p)),
+      response_body_callback_(std::move(response_body_callback)),
+      writer_(&data_) {}
 
 void LegacyHttpResponseHandler::OnStatus(int32_t status_code) {
   status_code_ = status_code;
@@ -84,6 +104,7 @@ void LegacyHttpResponseHandler::OnHeaderBlockDone() {
 }
 
 void LegacyHttpResponseHandler::OnResponseBody(std::string_view data) {
+  if (response_body_callback_) response_body_callback_(data.size());
   writer_.Write(data);
 }
 
@@ -107,9 +128,31 @@ Future<HttpResponse> HttpTransport::IssueRequest(const HttpRequest& request,
                                                  IssueRequestOptions options) {
   auto pair = PromiseFuturePair<HttpResponse>::Make();
   ABSL_LOG_IF(INFO, verbose.Level(1)) << request;
-  IssueRequestWithHandler(
-      request, std::move(options),
-      new LegacyHttpResponseHandler(std::move(pair.promise)));
+  internal_tracing::OperationTraceSpan span(
+      "HttpRequest",
+      {{"http.request.method", request.method}, {"url.full", request.url}},
+      /*start_trace=*/false);
+  auto* handler = new LegacyHttpResponseHandler(
+      std::move(pair.promise), std::move(options.response_body_callback));
+  if (!span.recording()) {
+    IssueRequestWithHandler(request, std::move(options), handler);
+    return std::move(pair.future);
+  }
+  // Propagate the trace to the server.
+  HttpRequest traced_request = request;
+  traced_request.headers.SetHeader(
+      "traceparent", FormatTraceParentHeader(*span.context().span_context));
+  internal_tracing::ScopedTraceContext scope(span.context());
+  pair.future.ExecuteWhenReady(
+      [span = std::move(span)](ReadyFuture<HttpResponse> future) mutable {
+        auto& result = future.result();
+        if (result.ok()) {
+          span.AddAttribute({"http.response.status_code", result->status_code});
+        } else {
+          span.SetStatus(result.status());
+        }
+      });
+  IssueRequestWithHandler(traced_request, std::move(options), handler);
   return std::move(pair.future);
 }
 
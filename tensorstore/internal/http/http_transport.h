@@ -15,8 +15,10 @@
 #ifndef TENSORSTORE_INTERNAL_HTTP_HTTP_TRANSPORT_H_
 #define TENSORSTORE_INTERNAL_HTTP_HTTP_TRANSPORT_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include <functional>
 #include <string_view>
 #include <utility>
 
@@ -59,11 +61,20 @@ struct IssueRequestOptions {
     this->connect_timeout = connect_timeout;
     return std::move(*this);
   }
+  IssueRequestOptions&& SetResponseBodyCallback(
+      std::function<void(size_t)> response_body_callback) && {
+    this->response_body_callback = std::move(response_body_callback);
+    return std::move(*this);
+  }
 
   absl::Cord payload;
   absl::Duration request_timeout = absl::ZeroDuration();
   absl::Duration connect_timeout = absl::ZeroDuration();
   HttpVersion http_version = HttpVersion::kDefault;
+
+  // If set, called by `HttpTransport::IssueRequest` with the size of each part
+  // of the response body as it is received, e.g. to account for bandwidth.
+  std::function<void(size_t)> response_body_callback;
 };
 
 /// Interface used by the HTTP transport to signal data to caller.
@@ -86,7 +97,10 @@ class HttpResponseHandler {
   virtual void OnResponseBody(std::string_view data) = 0;
   // Request has completed with the provided http status code.
   virtual void OnComplete() = 0;
-  // TODO: GetStopToken()
+  // Returns true if the response is no longer needed, in which case the
+  // transport may abort the request and invoke OnFailure.  May be called
+  // from any thread.
+  virtual bool IsCancelled() { return false; }
 };
 
 /// HttpTransport is an interface class for making http requests.
@@ -106,6 +120,13 @@ class HttpTransport {
   virtual void IssueRequestWithHandler(
       const HttpRequest& request, IssueRequestOptions options,
       HttpResponseHandler* response_handler) = 0;
+
+  /// Opens up to `count` connections to the host of `url` in the background,
+  /// so that the first requests to the host do not incur the latency of name
+  /// resolution, connection setup, and the TLS handshake.
+  ///
+  /// The default implementation does nothing.
+  virtual void PrewarmConnections(std::string_view url, size_t count) {}
 };
 
 }  // namespace internal_http
@@ -0,0 +1,98 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/http/http_transport_resource.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+#include "absl/time/time.h"
+#include "tensorstore/context.h"
+#include "tensorstore/context_resource_provider.h"
+#include "tensorstore/internal/curl/curl_transport.h"
+#include "tensorstore/internal/curl/default_factory.h"
+#include "tensorstore/internal/http/default_transport.h"
+#include "tensorstore/internal/http/http_transport.h"
+#include "tensorstore/util/result.h"
+
+/// specializations
+#include "tensorstore/internal/cache_key/absl_time.h"
+#include "tensorstore/internal/cache_key/std_optional.h"
+
+namespace tensorstore {
+namespace internal_http {
+namespace {
+
+const internal::ContextResourceRegistration<HttpTransportResource>
+    http_transport_registration;
+
+}  // namespace
+
+std::shared_ptr<HttpTransport> HttpTransportResource::Resource::GetTransport()
+    const {
+  return transport ? transport : GetDefaultHttpTransport();
+}
+
+void HttpTransportResource::Resource::PrewarmConnections(
+    std::string_view url) const {
+  if (!spec.prewarm_connections || *spec.prewarm_connections == 0) return;
+  GetTransport()->PrewarmConnections(url, *spec.prewarm_connections);
+}
+
+Result<HttpTransportResource::Resource> HttpTransportResource::Create(
+    const Spec& spec, internal::ContextResourceCreationContext context) {
+  Resource resource{spec, nullptr};
+  if (!spec.threads && !spec.shard_by_host && !spec.max_concurrent_streams &&
+      !spec.max_host_connections && !spec.max_total_connections &&
+      !spec.connection_cache_size && !spec.tcp_keepalive &&
+      !spec.max_connection_idle && !spec.dns_cache_ttl) {
+    return resource;
+  }
+
+  auto config = DefaultCurlHandleFactory::DefaultConfig();
+  if (spec.max_concurrent_streams) {
+    config.max_http2_concurrent_streams = *spec.max_concurrent_streams;
+  }
+  config.max_host_connections = spec.max_host_connections.value_or(0);
+  config.max_total_connections = spec.max_total_connections.value_or(0);
+  config.max_connects = spec.connection_cache_size.value_or(0);
+  if (spec.tcp_keepalive) {
+    config.tcp_keepalive_idle_seconds =
+        absl::ToInt64Seconds(*spec.tcp_keepalive);
+  }
+  if (spec.max_connection_idle) {
+    config.max_connection_idle_seconds =
+        absl::ToInt64Seconds(*spec.max_connection_idle);
+  }
+  if (spec.dns_cache_ttl) {
+    config.dns_cache_timeout_seconds =
+        *spec.dns_cache_ttl == absl::InfiniteDuration()
+            ? -1
+            : std::max<int64_t>(1, absl::ToInt64Seconds(*spec.dns_cache_ttl));
+  }
+
+  CurlTransportOptions options;
+  options.threads = spec.threads.value_or(0);
+  options.shard_by_host = spec.shard_by_host.value_or(false);
+  resource.transport = std::make_shared<CurlTransport>(
+      std::make_shared<DefaultCurlHandleFactory>(std::move(config)), options);
+  return resource;
+}
+
+}  // namespace internal_http
+}  // namespace tensorstore
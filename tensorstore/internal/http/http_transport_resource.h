@@ -0,0 +1,144 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_HTTP_HTTP_TRANSPORT_RESOURCE_H_
+#define TENSORSTORE_INTERNAL_HTTP_HTTP_TRANSPORT_RESOURCE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <optional>
+#include <string_view>
+
+#include "absl/time/time.h"
+#include "tensorstore/context.h"
+#include "tensorstore/context_resource_provider.h"
+#include "tensorstore/internal/http/http_transport.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/util/result.h"
+
+/// specializations
+#include "tensorstore/internal/json_binding/absl_time.h"
+#include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/internal/json_binding/std_optional.h"
+
+namespace tensorstore {
+namespace internal_http {
+
+/// Specifies the HTTP transport, and its connection pool, as a context object.
+///
+/// Key-value stores that share the same `http_transport` share connections.
+/// Unset members use the same values as the default transport; if all members
+/// are unset, the default transport itself is used.
+struct HttpTransportResource
+    : public internal::ContextResourceTraits<HttpTransportResource> {
+  static constexpr char id[] = "http_transport";
+
+  struct Spec {
+    /// Number of threads issuing requests.
+    std::optional<size_t> threads;
+
+    /// Whether all requests to a host are issued by the same thread, so that
+    /// they share one connection pool.
+    std::optional<bool> shard_by_host;
+
+    /// Maximum number of concurrent HTTP/2 streams per connection.
+    std::optional<int32_t> max_concurrent_streams;
+
+    /// Maximum number of connections per host, per thread.
+    std::optional<int64_t> max_host_connections;
+
+    /// Maximum number of connections, per thread.
+    std::optional<int64_t> max_total_connections;
+
+    /// Maximum number of idle connections kept for reuse, per thread.
+    std::optional<int64_t> connection_cache_size;
+
+    /// Idle time after which TCP keep-alive probes are sent.
+    std::optional<absl::Duration> tcp_keepalive;
+
+    /// Maximum idle time of a connection that is reused.
+    std::optional<absl::Duration> max_connection_idle;
+
+    /// Time for which resolved host names are cached.
+    std::optional<absl::Duration> dns_cache_ttl;
+
+    /// Number of connections opened to the host of a key-value store when it
+    /// is opened, ahead of the first request.
+    std::optional<size_t> prewarm_connections;
+
+    constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+      return f(x.threads, x.shard_by_host, x.max_concurrent_streams,
+               x.max_host_connections, x.max_total_connections,
+               x.connection_cache_size, x.tcp_keepalive,
+               x.max_connection_idle, x.dns_cache_ttl, x.prewarm_connections);
+    };
+  };
+
+  struct Resource {
+    Spec spec;
+
+    /// Null if the default transport is used.
+    std::shared_ptr<HttpTransport> transport;
+
+    /// Returns `transport`, or the default transport.
+    std::shared_ptr<HttpTransport> GetTransport() const;
+
+    /// Opens `spec.prewarm_connections` connections to the host of `url`.
+    void PrewarmConnections(std::string_view url) const;
+  };
+
+  static Spec Default() { return Spec{}; }
+
+  static constexpr auto JsonBinder() {
+    namespace jb = tensorstore::internal_json_binding;
+    return jb::Object(
+        jb::Member("threads", jb::Projection<&Spec::threads>(jb::Optional(
+                                  jb::Integer<size_t>(1, 1024)))),
+        jb::Member("shard_by_host", jb::Projection<&Spec::shard_by_host>()),
+        jb::Member("max_concurrent_streams",
+                   jb::Projection<&Spec::max_concurrent_streams>(
+                       jb::Optional(jb::Integer<int32_t>(1, 1000)))),
+        jb::Member("max_host_connections",
+                   jb::Projection<&Spec::max_host_connections>(
+                       jb::Optional(jb::Integer<int64_t>(1)))),
+        jb::Member("max_total_connections",
+                   jb::Projection<&Spec::max_total_connections>(
+                       jb::Optional(jb::Integer<int64_t>(1)))),
+        jb::Member("connection_cache_size",
+                   jb::Projection<&Spec::connection_cache_size>(
+                       jb::Optional(jb::Integer<int64_t>(1)))),
+        jb::Member("tcp_keepalive", jb::Projection<&Spec::tcp_keepalive>()),
+        jb::Member("max_connection_idle",
+                   jb::Projection<&Spec::max_connection_idle>()),
+        jb::Member("dns_cache_ttl", jb::Projection<&Spec::dns_cache_ttl>()),
+        jb::Member("prewarm_connections",
+                   jb::Projection<&Spec::prewarm_connections>(
+                       jb::Optional(jb::Integer<size_t>(0, 64)))));
+  }
+
+  static Result<Resource> Create(
+      const Spec& spec, internal::ContextResourceCreationContext context);
+
+  static Spec GetSpec(const Resource& resource,
+                      const internal::ContextSpecBuilder& builder) {
+    return resource.spec;
+  }
+};
+
+}  // namespace internal_http
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_HTTP_HTTP_TRANSPORT_RESOURCE_H_
@@ -0,0 +1,92 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/http/http_transport_resource.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/internal/http/default_transport.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::Context;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::internal_http::GetDefaultHttpTransport;
+using ::tensorstore::internal_http::HttpTransportResource;
+
+TEST(HttpTransportResourceTest, Default) {
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto resource_spec,
+      Context::Resource<HttpTransportResource>::FromJson("http_transport"));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto resource,
+                                   context.GetResource(resource_spec));
+  EXPECT_EQ(nullptr, resource->transport);
+  EXPECT_EQ(GetDefaultHttpTransport(), resource->GetTransport());
+}
+
+TEST(HttpTransportResourceTest, Configured) {
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto resource_spec,
+      Context::Resource<HttpTransportResource>::FromJson({
+          {"threads", 2},
+          {"shard_by_host", true},
+          {"max_concurrent_streams", 100},
+          {"max_host_connections", 4},
+          {"tcp_keepalive", "60s"},
+          {"dns_cache_ttl", "300s"},
+      }));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto resource,
+                                   context.GetResource(resource_spec));
+  ASSERT_NE(nullptr, resource->transport);
+  EXPECT_EQ(resource->transport, resource->GetTransport());
+  EXPECT_EQ(2, resource->spec.threads);
+
+  // The transport is shared by users of the same context resource.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto resource2,
+                                   context.GetResource(resource_spec));
+  EXPECT_EQ(resource->transport, resource2->transport);
+}
+
+TEST(HttpTransportResourceTest, PrewarmConnectionsUsesDefaultTransport) {
+  auto context = Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto resource_spec, Context::Resource<HttpTransportResource>::FromJson(
+                              {{"prewarm_connections", 2}}));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto resource,
+                                   context.GetResource(resource_spec));
+  EXPECT_EQ(nullptr, resource->transport);
+  EXPECT_EQ(2, resource->spec.prewarm_connections);
+}
+
+TEST(HttpTransportResourceTest, InvalidSpec) {
+  EXPECT_THAT(Context::Resource<HttpTransportResource>::FromJson(
+                  {{"max_concurrent_streams", 0}}),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            ".*max_concurrent_streams.*"));
+  EXPECT_THAT(
+      Context::Resource<HttpTransportResource>::FromJson({{"threads", "x"}}),
+      MatchesStatus(absl::StatusCode::kInvalidArgument, ".*threads.*"));
+  EXPECT_THAT(Context::Resource<HttpTransportResource>::FromJson(
+                  {{"prewarm_connections", 1000}}),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            ".*prewarm_connections.*"));
+}
+
+}  // namespace
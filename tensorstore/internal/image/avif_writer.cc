@@ -294,6 +294,10 @@ absl::Status AvifWriter::InitializeImpl(riegeli::Writer* writer,
         "AVIF speed must be in the range [", AVIF_SPEED_SLOWEST, "..",
         AVIF_SPEED_FASTEST, "] "));
   }
+  if (options.max_threads < 1) {
+    return absl::InvalidArgumentError(
+        "AVIF max_threads option must be at least 1");
+  }
 
   /// Test for the AOM codec for lossless encoding.
   const bool lossless = (options.quantizer == 0);
@@ -307,6 +311,7 @@ absl::Status AvifWriter::InitializeImpl(riegeli::Writer* writer,
 
   std::unique_ptr<avifEncoder, AvifDeleter> encoder(avifEncoderCreate());
   encoder->speed = options.speed;
+  encoder->maxThreads = options.max_threads;
   if (lossless) {
     /// Use the AOM reference codec. While others may be available, the aom
     /// codec is the only codec which supports lossless encoding.
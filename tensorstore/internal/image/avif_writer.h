@@ -59,6 +59,9 @@ struct AvifWriterOptions {
 
   /// AVIF stores images as YUV(A); it can convert from RGB(A) when necessary.
   bool input_is_rgb = true;
+
+  /// Maximum number of threads the encoder may use for a single image.
+  int max_threads = 1;
 };
 
 class AvifWriter : public ImageWriter {
@@ -41,5 +41,18 @@ size_t ImageRequiredBytes(const ImageInfo& a) {
          a.dtype.size();
 }
 
+bool IsValidImageRegion(const ImageInfo& info, const ImageRegion& region) {
+  return region.y >= 0 && region.x >= 0 && region.height > 0 &&
+         region.width > 0 && region.height <= info.height - region.y &&
+         region.width <= info.width - region.x;
+}
+
+ImageInfo GetRegionImageInfo(const ImageInfo& info, const ImageRegion& region) {
+  ImageInfo region_info = info;
+  region_info.height = region.height;
+  region_info.width = region.width;
+  return region_info;
+}
+
 }  // namespace internal_image
 }  // namespace tensorstore
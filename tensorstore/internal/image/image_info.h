@@ -16,6 +16,7 @@
 #define TENSORSTORE_INTERNAL_IMAGE_IMAGE_INFO_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <iosfwd>
 
@@ -45,6 +46,21 @@ struct ImageInfo {
 /// described by ImageInfo.
 size_t ImageRequiredBytes(const ImageInfo& a);
 
+/// Describes a rectangular region of an image, in pixels.
+struct ImageRegion {
+  int32_t y = 0;
+  int32_t x = 0;
+  int32_t height = 0;
+  int32_t width = 0;
+};
+
+/// Returns whether `region` is non-empty and contained within the image
+/// described by `info`.
+bool IsValidImageRegion(const ImageInfo& info, const ImageRegion& region);
+
+/// Returns the ImageInfo describing `region` of the image described by `info`.
+ImageInfo GetRegionImageInfo(const ImageInfo& info, const ImageRegion& region);
+
 }  // namespace internal_image
 }  // namespace tensorstore
 
@@ -250,7 +250,9 @@ INSTANTIATE_TEST_SUITE_P(
         TestParam{AvifWriterOptions{}, ImageInfo{33, 100, 1}, 0},
         TestParam{AvifWriterOptions{}, ImageInfo{33, 100, 2}, 0},
         TestParam{AvifWriterOptions{}, ImageInfo{33, 100, 3}, 0},
-        TestParam{AvifWriterOptions{}, ImageInfo{33, 100, 4}, 0}));
+        TestParam{AvifWriterOptions{}, ImageInfo{33, 100, 4}, 0},
+        TestParam{AvifWriterOptions{0, 6, true, 4}, ImageInfo{33, 100, 4},
+                  0}));
 
 // Quality varies based on the available encoders.
 INSTANTIATE_TEST_SUITE_P(
@@ -299,12 +301,16 @@ INSTANTIATE_TEST_SUITE_P(
     WebPLossless, WriterTest,
     ::testing::Values(  //
         TestParam{WebPWriterOptions{true}, ImageInfo{33, 100, 3}, 0},
-        TestParam{WebPWriterOptions{true}, ImageInfo{33, 100, 4}, 0}));
+        TestParam{WebPWriterOptions{true}, ImageInfo{33, 100, 4}, 0},
+        TestParam{WebPWriterOptions{true, 95, true}, ImageInfo{33, 100, 4},
+                  0}));
 
 INSTANTIATE_TEST_SUITE_P(
     WebPLossy, WriterTest,
     ::testing::Values(  //
         TestParam{WebPWriterOptions{false}, ImageInfo{33, 100, 3}, 47},
-        TestParam{WebPWriterOptions{false}, ImageInfo{33, 100, 4}, 44}));
+        TestParam{WebPWriterOptions{false}, ImageInfo{33, 100, 4}, 44},
+        TestParam{WebPWriterOptions{false, 95, true}, ImageInfo{33, 100, 4},
+                  44}));
 
 }  // namespace
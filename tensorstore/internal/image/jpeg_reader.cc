@@ -16,6 +16,7 @@
 
 #include <cassert>
 #include <csetjmp>
+#include <cstring>
 #include <memory>
 
 #include "absl/log/absl_check.h"
@@ -23,6 +24,7 @@
 #include "absl/strings/str_format.h"
 #include "riegeli/bytes/reader.h"
 #include "tensorstore/data_type.h"
+#include "tensorstore/internal/image/image_info.h"
 #include "tensorstore/internal/image/image_view.h"
 #include "tensorstore/util/status.h"
 
@@ -251,9 +253,27 @@ absl::Status JpegReader::Context::Decode(tensorstore::span<unsigned char> dest,
 
   // Validate the image is compatible.
   auto info = GetJpegImageInfo(&cinfo_);
-  ABSL_CHECK_EQ(dest.size(), ImageRequiredBytes(info));
+  ImageRegion region{0, 0, info.height, info.width};
+  if (options.region) {
+    if (!IsValidImageRegion(info, *options.region)) {
+      return absl::InvalidArgumentError(
+          "Failed to decode JPEG: region is not within the image");
+    }
+    region = *options.region;
+  }
+  ABSL_CHECK_EQ(dest.size(),
+                ImageRequiredBytes(GetRegionImageInfo(info, region)));
+
+  // Scanlines are decoded into `row_buffer` when only some columns are
+  // required; the cropped width may be widened by libjpeg to an iMCU
+  // boundary.
+  const bool full_width = region.x == 0 && region.width == info.width;
+  std::unique_ptr<JSAMPLE[]> row_buffer;
+  if (!full_width) {
+    row_buffer.reset(new JSAMPLE[info.width * info.num_components]);
+  }
 
-  ImageView dest_view(info, dest);
+  ImageView dest_view(GetRegionImageInfo(info, region), dest);
   bool ok = [&]() {
     // Setjump is problematic with C++; by convention we put it in a
     // lambda which has no variables requiring cleanup.
@@ -265,16 +285,34 @@ absl::Status JpegReader::Context::Decode(tensorstore::span<unsigned char> dest,
     ::jpeg_start_decompress(&cinfo_);
     started_ = true;
 
+    // Restrict decoding to the region; rows after the region are never read,
+    // and the destructor aborts the decompression.
+    JDIMENSION crop_x = region.x;
+    JDIMENSION crop_width = region.width;
+    if (!full_width) {
+      ::jpeg_crop_scanline(&cinfo_, &crop_x, &crop_width);
+    }
+    if (region.y > 0) {
+      ::jpeg_skip_scanlines(&cinfo_, region.y);
+    }
+    const size_t crop_offset = (region.x - crop_x) * info.num_components;
+    const size_t row_bytes = dest_view.row_stride_bytes();
+
     // ... then read each scanline
-    while (cinfo_.output_scanline < cinfo_.output_height) {
-      auto* output_line = reinterpret_cast<JSAMPLE*>(
-          dest_view.data_row(cinfo_.output_scanline).data());
+    for (int32_t y = 0; y < region.height; ++y) {
+      auto* output_line = full_width ? reinterpret_cast<JSAMPLE*>(
+                                           dest_view.data_row(y).data())
+                                     : row_buffer.get();
       if (::jpeg_read_scanlines(&cinfo_, &output_line, 1) != 1) {
         error_.last_error.Update(absl::DataLossError(absl::StrFormat(
             "Cannot read JPEG; data ended after %d/%d scan lines",
             cinfo_.output_scanline, cinfo_.output_height)));
         return false;
       }
+      if (!full_width) {
+        memcpy(dest_view.data_row(y).data(), row_buffer.get() + crop_offset,
+               row_bytes);
+      }
     }
     return true;
   }();
@@ -15,6 +15,8 @@
 #ifndef TENSORSTORE_INTERNAL_IMAGE_JPEG_READER_H_
 #define TENSORSTORE_INTERNAL_IMAGE_JPEG_READER_H_
 
+#include <optional>
+
 #include "riegeli/bytes/reader.h"
 #include "tensorstore/internal/image/image_info.h"
 #include "tensorstore/internal/image/image_reader.h"
@@ -23,7 +25,12 @@
 namespace tensorstore {
 namespace internal_image {
 
-struct JpegReaderOptions {};
+struct JpegReaderOptions {
+  /// When set, only the specified region of the image is decoded into `dest`,
+  /// which must then be sized for the region.  Scanlines above the region are
+  /// skipped and those below it are not decoded.
+  std::optional<ImageRegion> region;
+};
 
 class JpegReader : public ImageReader {
  public:
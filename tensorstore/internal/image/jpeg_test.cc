@@ -33,8 +33,11 @@
 namespace {
 
 using ::tensorstore::internal_image::ImageInfo;
+using ::tensorstore::internal_image::ImageRegion;
 using ::tensorstore::internal_image::JpegReader;
+using ::tensorstore::internal_image::JpegReaderOptions;
 using ::tensorstore::internal_image::JpegWriter;
+using ::tensorstore::internal_image::JpegWriterOptions;
 
 TEST(JpegTest, Decode) {
   // Started the same as the png image, but very much the worse for wear after
@@ -255,6 +258,88 @@ TEST(JpegTest, EncodeDecode) {
   }
 }
 
+TEST(JpegTest, EncodeRepeatedly) {
+  // The compressor reused for successive images on a thread must not carry
+  // state over from one image to the next.
+  auto encode = [](const ImageInfo& info,
+                   tensorstore::span<const unsigned char> pixels, int quality) {
+    absl::Cord encoded;
+    JpegWriter encoder;
+    riegeli::CordWriter cord_writer(&encoded);
+    JpegWriterOptions options;
+    options.quality = quality;
+    EXPECT_THAT(encoder.Initialize(&cord_writer, options),
+                ::tensorstore::IsOk());
+    EXPECT_THAT(encoder.Encode(info, pixels), ::tensorstore::IsOk());
+    EXPECT_THAT(encoder.Done(), ::tensorstore::IsOk());
+    return encoded;
+  };
+  std::vector<unsigned char> rgb(16 * 8 * 3);
+  for (size_t i = 0; i < rgb.size(); ++i) rgb[i] = i * 7;
+  uint8_t gray[1] = {};
+
+  auto expected = encode(ImageInfo{8, 16, 3}, rgb, 90);
+  EXPECT_NE(expected, encode(ImageInfo{8, 16, 3}, rgb, 50));
+  encode(ImageInfo{1, 1, 1}, gray, 75);
+  EXPECT_EQ(expected, encode(ImageInfo{8, 16, 3}, rgb, 90));
+}
+
+TEST(JpegTest, DecodeRegion) {
+  // A single-component image is not upsampled, so a region decode matches the
+  // corresponding pixels of the full decode exactly.
+  const ImageInfo info{48, 64, 1};
+  std::vector<unsigned char> pixels(ImageRequiredBytes(info));
+  for (size_t i = 0; i < pixels.size(); i++) {
+    pixels[i] = static_cast<unsigned char>((i * 7) % 251);
+  }
+  absl::Cord encoded;
+  {
+    JpegWriter encoder;
+    riegeli::CordWriter cord_writer(&encoded);
+    ASSERT_THAT(encoder.Initialize(&cord_writer), ::tensorstore::IsOk());
+    ASSERT_THAT(encoder.Encode(info, pixels), ::tensorstore::IsOk());
+    ASSERT_THAT(encoder.Done(), ::tensorstore::IsOk());
+  }
+
+  std::vector<unsigned char> image(ImageRequiredBytes(info));
+  {
+    JpegReader decoder;
+    riegeli::CordReader cord_reader(&encoded);
+    ASSERT_THAT(decoder.Initialize(&cord_reader), ::tensorstore::IsOk());
+    ASSERT_THAT(decoder.Decode(image), ::tensorstore::IsOk());
+  }
+
+  for (const ImageRegion& region :
+       {ImageRegion{13, 21, 20, 30}, ImageRegion{0, 0, 1, 64},
+        ImageRegion{47, 63, 1, 1}}) {
+    SCOPED_TRACE(::testing::Message() << region.y << "," << region.x << " "
+                                      << region.height << "x"
+                                      << region.width);
+    JpegReader decoder;
+    riegeli::CordReader cord_reader(&encoded);
+    ASSERT_THAT(decoder.Initialize(&cord_reader), ::tensorstore::IsOk());
+    std::vector<unsigned char> region_image(region.height * region.width);
+    ASSERT_THAT(decoder.Decode(region_image, JpegReaderOptions{region}),
+                ::tensorstore::IsOk());
+    for (int32_t y = 0; y < region.height; y++) {
+      for (int32_t x = 0; x < region.width; x++) {
+        EXPECT_EQ(image[(region.y + y) * info.width + region.x + x],
+                  region_image[y * region.width + x])
+            << y << "," << x;
+      }
+    }
+  }
+
+  {
+    JpegReader decoder;
+    riegeli::CordReader cord_reader(&encoded);
+    ASSERT_THAT(decoder.Initialize(&cord_reader), ::tensorstore::IsOk());
+    EXPECT_THAT(decoder.Decode(tensorstore::span<unsigned char>(),
+                               JpegReaderOptions{ImageRegion{40, 0, 9, 1}}),
+                tensorstore::MatchesStatus(absl::StatusCode::kInvalidArgument));
+  }
+}
+
 TEST(JpegTest, NotAJpeg) {
   static constexpr unsigned char data[] = {
       0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a,  // sig
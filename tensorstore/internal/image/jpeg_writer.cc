@@ -16,6 +16,7 @@
 
 #include <cassert>
 #include <csetjmp>
+#include <memory>
 #include <utility>
 
 #include "absl/log/absl_check.h"
@@ -37,6 +38,8 @@ namespace tensorstore {
 namespace internal_image {
 namespace {
 
+/// Compressor state, which is reused by each thread for successive images
+/// rather than being created and destroyed for each image.
 struct EncodeState {
   ::jpeg_compress_struct cinfo_;
   JpegError error_;
@@ -44,15 +47,23 @@ struct EncodeState {
 
   std::jmp_buf jmpbuf;
   absl::Status status_;
-  riegeli::Writer* writer;
+  riegeli::Writer* writer = nullptr;
   bool started_ = false;
 
-  EncodeState(riegeli::Writer* writer);
+  EncodeState();
   ~EncodeState();
 
+  /// Returns the compressor to its initial state, retaining its allocations.
+  void Reset();
+
   absl::Status EncodeImpl();
 };
 
+/// Returns an `EncodeState` for exclusive use by the caller, which should be
+/// returned by `ReleaseEncodeState` once the image is encoded.
+std::unique_ptr<EncodeState> AcquireEncodeState(riegeli::Writer* writer);
+void ReleaseEncodeState(std::unique_ptr<EncodeState> state);
+
 void InitDestination(::jpeg_compress_struct* cinfo) {
   /*
   init_destination (j_compress_ptr cinfo)
@@ -113,7 +124,7 @@ void SetDestHandlers(::jpeg_destination_mgr* jdest) {
   jdest->term_destination = &TermDestination;
 }
 
-EncodeState::EncodeState(riegeli::Writer* writer) : writer(writer) {
+EncodeState::EncodeState() {
   // Set up error handler.
   error_.Construct(reinterpret_cast<::jpeg_common_struct*>(&cinfo_));
 
@@ -134,6 +145,30 @@ EncodeState::~EncodeState() {
   jpeg_destroy_compress(&cinfo_);
 }
 
+void EncodeState::Reset() {
+  if (started_) {
+    jpeg_abort_compress(&cinfo_);
+    started_ = false;
+  }
+  cinfo_.err->num_warnings = 0;
+  error_.last_error = absl::OkStatus();
+  writer = nullptr;
+}
+
+thread_local std::unique_ptr<EncodeState> cached_encode_state;
+
+std::unique_ptr<EncodeState> AcquireEncodeState(riegeli::Writer* writer) {
+  auto state = std::move(cached_encode_state);
+  if (!state) state = std::make_unique<EncodeState>();
+  state->writer = writer;
+  return state;
+}
+
+void ReleaseEncodeState(std::unique_ptr<EncodeState> state) {
+  state->Reset();
+  cached_encode_state = std::move(state);
+}
+
 }  // namespace
 
 JpegWriter::JpegWriter() = default;
@@ -176,7 +211,8 @@ absl::Status JpegWriter::Encode(const ImageInfo& info,
   TENSORSTORE_RETURN_IF_ERROR(IsSupported(info));
   ABSL_CHECK(source.size() == ImageRequiredBytes(info));
 
-  EncodeState state(writer_);
+  auto state_ptr = AcquireEncodeState(writer_);
+  EncodeState& state = *state_ptr;
   ImageView source_view = MakeWriteImageView(info, source);
 
   state.cinfo_.image_width = info.width;
@@ -210,13 +246,13 @@ absl::Status JpegWriter::Encode(const ImageInfo& info,
   // On failure, clear the writer.
   absl::Status status;
   if (!ok) {
-    absl::Status status = internal::MaybeConvertStatusTo(
+    status = internal::MaybeConvertStatusTo(
         state.writer->ok() ? state.error_.last_error : state.writer->status(),
         absl::StatusCode::kDataLoss);
     writer_ = nullptr;
-    return status;
   }
-  return absl::OkStatus();
+  ReleaseEncodeState(std::move(state_ptr));
+  return status;
 }
 
 absl::Status JpegWriter::Done() {
@@ -52,12 +52,29 @@ struct TiffReader::Context : public LibTiffErrorBase {
   riegeli::Reader* reader_ = nullptr;  // unowned
   TIFF* tiff_ = nullptr;
 
+  // When only part of the file is available, `reader_` holds the
+  // `header_size_` bytes of the header followed by the file bytes starting at
+  // `window_offset_`.
+  uint64_t header_size_ = 0;
+  uint64_t window_offset_ = 0;
+
+  // Maps between file positions and `reader_` positions.
+  std::optional<uint64_t> ToReaderPosition(uint64_t pos) const {
+    if (pos < header_size_) return pos;
+    if (pos < window_offset_) return std::nullopt;
+    return pos - window_offset_ + header_size_;
+  }
+  uint64_t ToFilePosition(uint64_t pos) const {
+    return pos < header_size_ ? pos : pos - header_size_ + window_offset_;
+  }
+
   Context(riegeli::Reader* reader);
   ~Context();
   absl::Status ExtractErrors(absl::Status in);
 
   absl::Status Open();
-  absl::Status DefaultDecode(tensorstore::span<unsigned char> data);
+  absl::Status DefaultDecode(tensorstore::span<unsigned char> data,
+                             const TiffReaderOptions& options);
 };
 
 namespace {
@@ -84,13 +101,19 @@ tmsize_t NoWriteProc(thandle_t data, void* buf, tmsize_t len) {
 
 toff_t SeekProc(thandle_t data, toff_t pos, int whence) {
   assert(data != nullptr);
-  auto* reader = static_cast<TiffReader::Context*>(data)->reader_;
+  auto* context = static_cast<TiffReader::Context*>(data);
+  auto* reader = context->reader_;
   assert(reader != nullptr);
 
   switch (whence) {
     case SEEK_SET:
       // ABSL_LOG(INFO) << "tiff seek " << pos;
-      reader->Seek(pos);
+      if (auto reader_pos = context->ToReaderPosition(pos); reader_pos) {
+        reader->Seek(*reader_pos);
+      } else {
+        // Outside of the available part of the file.
+        return -1;
+      }
       break;
     case SEEK_CUR:
       // ABSL_LOG(INFO) << "tiff skip "<< reader->pos()<< " "<< pos;
@@ -109,7 +132,9 @@ toff_t SeekProc(thandle_t data, toff_t pos, int whence) {
     default:
       return -1;
   }
-  return reader->ok() ? static_cast<toff_t>(reader->pos()) : -1;
+  return reader->ok() ? static_cast<toff_t>(context->ToFilePosition(
+                            reader->pos()))
+                      : -1;
 }
 
 int CloseProc(thandle_t data) {
@@ -119,10 +144,10 @@ int CloseProc(thandle_t data) {
 
 toff_t SizeProc(thandle_t data) {
   assert(data != nullptr);
-  auto* reader = static_cast<TiffReader::Context*>(data)->reader_;
-  assert(reader != nullptr);
-  auto size = reader->Size();
-  return size ? static_cast<toff_t>(*size) : -1;
+  auto* context = static_cast<TiffReader::Context*>(data);
+  assert(context->reader_ != nullptr);
+  auto size = context->reader_->Size();
+  return size ? static_cast<toff_t>(context->ToFilePosition(*size)) : -1;
 }
 
 /// Mapping function to convert bits-per-sample to byte arrays.
@@ -259,121 +284,147 @@ absl::Status GetTIFFImageInfo(TIFF* tiff, TiffImageInfo& info) {
   return absl::OkStatus();
 }
 
+/// Copies the pixels of a decoded TIFF row which lie within a region into
+/// the corresponding row of the output, expanding 1, 2 and 4 bits per sample
+/// to bytes.
+class RowCopier {
+ public:
+  RowCopier(const TiffImageInfo& info, const ImageRegion& region,
+            size_t max_source_width)
+      : region_(region),
+        samples_per_pixel_(info.num_components),
+        pixel_bytes_(info.num_components * info.dtype.size()) {
+    if (info.bits_per_sample_ == 1) {
+      mapping_ = TranslateBits<1>(trstride_);
+    } else if (info.bits_per_sample_ == 2) {
+      mapping_ = TranslateBits<2>(trstride_);
+    } else if (info.bits_per_sample_ == 4) {
+      mapping_ = TranslateBits<4>(trstride_);
+    }
+    if (mapping_) {
+      expanded_.reset(
+          new unsigned char[max_source_width * samples_per_pixel_]);
+    }
+  }
+
+  bool is_packed() const { return mapping_ != nullptr; }
+
+  /// Copies `source_row`, which holds the `source_width` pixels of an image
+  /// row starting at column `source_x`, into `dest_row`, which holds the
+  /// region columns of the same row.
+  void Copy(const unsigned char* source_row, size_t source_x,
+            size_t source_width, unsigned char* dest_row) {
+    const size_t region_x = region_.x;
+    const size_t begin = std::max(source_x, region_x);
+    const size_t end =
+        std::min(source_x + source_width, region_x + region_.width);
+    if (begin >= end) return;
+    if (mapping_) {
+      const size_t n = source_width * samples_per_pixel_;
+      unsigned char* expanded = expanded_.get();
+      for (size_t i = 0; i < n; i += trstride_, ++source_row) {
+        memcpy(expanded + i, mapping_ + (*source_row * trstride_),
+               std::min(static_cast<size_t>(trstride_), n - i));
+      }
+      source_row = expanded;
+    }
+    memcpy(dest_row + (begin - region_x) * pixel_bytes_,
+           source_row + (begin - source_x) * pixel_bytes_,
+           (end - begin) * pixel_bytes_);
+  }
+
+ private:
+  ImageRegion region_;
+  size_t samples_per_pixel_;
+  size_t pixel_bytes_;
+  const unsigned char* mapping_ = nullptr;
+  ptrdiff_t trstride_ = 1;
+  std::unique_ptr<unsigned char[]> expanded_;
+};
+
 absl::Status ReadStripImpl(TIFF* tiff, TiffImageInfo& info,
+                           const ImageRegion& region,
                            tensorstore::span<unsigned char> data) {
-  ImageView dest_view(info, data);
-
-  // Translate 1,2,4 bits per sample to 8-bpp images.
-  const unsigned char* mapping = nullptr;
-  ptrdiff_t trstride = 1;
-  if (info.bits_per_sample_ == 1) {
-    mapping = TranslateBits<1>(trstride);
-  } else if (info.bits_per_sample_ == 2) {
-    mapping = TranslateBits<2>(trstride);
-  } else if (info.bits_per_sample_ == 4) {
-    mapping = TranslateBits<4>(trstride);
-  }
+  ImageView dest_view(GetRegionImageInfo(info, region), data);
+  RowCopier copier(info, region, info.width);
 
-  const int strip_bytes = TIFFStripSize(tiff);
+  const tmsize_t strip_bytes = TIFFStripSize(tiff);
+  const tmsize_t scanline_bytes = TIFFScanlineSize(tiff);
   uint32_t rows_per_strip = 1;
   TIFFGetFieldDefaulted(tiff, TIFFTAG_ROWSPERSTRIP, &rows_per_strip);
 
-  if (!mapping &&
-      strip_bytes == rows_per_strip * dest_view.row_stride_bytes()) {
-    /// No extra data && no mapping means that the TIFF can be read directly
-    /// into the output buffer.
-    for (size_t y = 0; y < info.height; y += rows_per_strip) {
-      // Read the strip.
-      if (TIFFReadEncodedStrip(tiff, TIFFComputeStrip(tiff, y, 0),
-                               dest_view.data_row(y).data(),
+  const size_t region_end = region.y + region.height;
+  const bool full_width = region.x == 0 && region.width == info.width;
+  std::unique_ptr<unsigned char[]> buffer;
+
+  // Only the strips which intersect the region are read.
+  for (size_t y = (region.y / rows_per_strip) * rows_per_strip;
+       y < region_end; y += rows_per_strip) {
+    const size_t strip_end =
+        std::min<size_t>(y + rows_per_strip, info.height);
+    const tstrip_t strip = TIFFComputeStrip(tiff, y, 0);
+
+    if (!copier.is_packed() && full_width && y >= region.y &&
+        strip_end <= region_end &&
+        scanline_bytes == dest_view.row_stride_bytes()) {
+      /// A strip entirely within the region with no extra data and no
+      /// mapping can be read directly into the output buffer.
+      if (TIFFReadEncodedStrip(tiff, strip,
+                               dest_view.data_row(y - region.y).data(),
                                strip_bytes) == -1) {
         return absl::DataLossError("TIFF read strip failed");
       }
+      continue;
     }
-    return absl::OkStatus();
-  }
 
-  std::unique_ptr<unsigned char[]> buffer(new unsigned char[strip_bytes]);
-  uint32_t line_bytes =
-      info.width * (info.bits_per_sample_ / 8) * info.num_components;
-
-  for (size_t y = 0; y < info.height; y += rows_per_strip) {
-    // Read the strip.
-    if (TIFFReadEncodedStrip(tiff, TIFFComputeStrip(tiff, y, 0), buffer.get(),
-                             strip_bytes) == -1) {
+    if (!buffer) buffer.reset(new unsigned char[strip_bytes]);
+    // Rows after the end of the region need not be decoded.
+    const size_t last_row = std::min(strip_end, region_end);
+    if (TIFFReadEncodedStrip(tiff, strip, buffer.get(),
+                             static_cast<tmsize_t>(last_row - y) *
+                                 scanline_bytes) == -1) {
       return absl::DataLossError("TIFF read strip failed");
     }
-
-    unsigned char* source_row = buffer.get();
-    for (size_t r = 0; r < rows_per_strip; r++) {
-      if (y + r >= info.height) break;
-      auto target_row = dest_view.data_row(y + r);
-
-      if (info.bits_per_sample_ >= 8) {
-        assert(line_bytes == dest_view.row_stride_bytes());
-        memcpy(target_row.data(), source_row, line_bytes);
-        source_row += line_bytes;
-      } else {
-        while (!target_row.empty()) {
-          size_t n = std::min(trstride, target_row.size());
-          memcpy(target_row.data(), mapping + (*source_row * trstride), n);
-          target_row = target_row.subspan(n);
-          source_row++;
-        }
-      }
+    for (size_t r = std::max<size_t>(y, region.y); r < last_row; r++) {
+      copier.Copy(buffer.get() + (r - y) * scanline_bytes, 0, info.width,
+                  dest_view.data_row(r - region.y).data());
     }
   }
   return absl::OkStatus();
 }
 
 absl::Status ReadTiledImpl(TIFF* tiff, TiffImageInfo& info,
+                           const ImageRegion& region,
                            tensorstore::span<unsigned char> data) {
-  ImageView dest_view(info, data);
-
-  // Translate 1,2,4 bits per sample to 8-bpp images.
-  const unsigned char* mapping = nullptr;
-  ptrdiff_t trstride = 1;
-  if (info.bits_per_sample_ == 1) {
-    mapping = TranslateBits<1>(trstride);
-  } else if (info.bits_per_sample_ == 2) {
-    mapping = TranslateBits<2>(trstride);
-  } else if (info.bits_per_sample_ == 4) {
-    mapping = TranslateBits<4>(trstride);
-  }
+  ImageView dest_view(GetRegionImageInfo(info, region), data);
 
   uint32_t tile_width, tile_height;
   TIFFGetField(tiff, TIFFTAG_TILEWIDTH, &tile_width);
   TIFFGetField(tiff, TIFFTAG_TILELENGTH, &tile_height);
+  RowCopier copier(info, region, tile_width);
 
-  const int tile_bytes = TIFFTileSize(tiff);
+  const tmsize_t tile_bytes = TIFFTileSize(tiff);
+  const tmsize_t tile_row_bytes = TIFFTileRowSize(tiff);
   std::unique_ptr<unsigned char[]> tile_buffer(new unsigned char[tile_bytes]);
-  ImageView tile_view(ImageInfo{/*.height=*/static_cast<int32_t>(tile_height),
-                                /*.width=*/static_cast<int32_t>(tile_width),
-                                /*.num_components=*/info.num_components},
-                      {tile_buffer.get(), tile_bytes});
 
-  for (size_t y = 0; y < info.height; y += tile_height) {
-    for (size_t x = 0; x < info.width; x += tile_width) {
+  const size_t region_y_end = region.y + region.height;
+  const size_t region_x_end = region.x + region.width;
+
+  // Only the tiles which intersect the region are read.
+  for (size_t y = (region.y / tile_height) * tile_height; y < region_y_end;
+       y += tile_height) {
+    const size_t row_begin = std::max<size_t>(y, region.y);
+    const size_t row_end = std::min<size_t>(y + tile_height, region_y_end);
+    for (size_t x = (region.x / tile_width) * tile_width; x < region_x_end;
+         x += tile_width) {
       if (TIFFReadTile(tiff, tile_buffer.get(), x, y, 0, 0) == -1) {
         return absl::DataLossError("TIFF read tile failed");
       }
-      for (size_t y1 = 0; y1 < tile_height; y1++) {
-        if ((y + y1) >= info.height) break;
-        auto target_row = dest_view.data_row(y + y1, x);
-        auto tile_row = tile_view.data_row(y1);
-        if (info.bits_per_sample_ >= 8) {
-          memcpy(target_row.data(), tile_row.data(),
-                 std::min(target_row.size(), tile_row.size()));
-        } else {
-          unsigned char* packed = tile_row.data();
-          while (!target_row.empty()) {
-            size_t n = std::min(trstride, target_row.size());
-            memcpy(target_row.data(), mapping + (*packed * trstride), n);
-            target_row = target_row.subspan(n);
-            packed++;
-          }
-          assert(packed <= tile_row.data() + tile_row.size());
-        }
+      const size_t source_width =
+          std::min<size_t>(tile_width, info.width - x);
+      for (size_t r = row_begin; r < row_end; r++) {
+        copier.Copy(tile_buffer.get() + (r - y) * tile_row_bytes, x,
+                    source_width, dest_view.data_row(r - region.y).data());
       }
     }
   }
@@ -425,10 +476,19 @@ absl::Status TiffReader::Context::Open() {
 }
 
 absl::Status TiffReader::Context::DefaultDecode(
-    tensorstore::span<unsigned char> data) {
+    tensorstore::span<unsigned char> data, const TiffReaderOptions& options) {
   TiffImageInfo info;
   TENSORSTORE_RETURN_IF_ERROR(GetTIFFImageInfo(tiff_, info));
-  ABSL_CHECK_EQ(data.size(), ImageRequiredBytes(info));
+  ImageRegion region{0, 0, info.height, info.width};
+  if (options.region) {
+    if (!IsValidImageRegion(info, *options.region)) {
+      return absl::InvalidArgumentError(
+          "TIFF read failed: region is not within the image");
+    }
+    region = *options.region;
+  }
+  ABSL_CHECK_EQ(data.size(),
+                ImageRequiredBytes(GetRegionImageInfo(info, region)));
 
   // Additional fields checks (beyond the info)
   uint32_t compress_tag = 0;
@@ -477,9 +537,9 @@ absl::Status TiffReader::Context::DefaultDecode(
 
   absl::Status status;
   if (TIFFIsTiled(tiff_)) {
-    status = ReadTiledImpl(tiff_, info, data);
+    status = ReadTiledImpl(tiff_, info, region, data);
   } else {
-    status = ReadStripImpl(tiff_, info, data);
+    status = ReadStripImpl(tiff_, info, region, data);
   }
 
   return ExtractErrors(status);
@@ -500,6 +560,21 @@ absl::Status TiffReader::Initialize(riegeli::Reader* reader) {
   return absl::OkStatus();
 }
 
+absl::Status TiffReader::Initialize(riegeli::Reader* reader,
+                                    size_t header_size,
+                                    uint64_t window_offset) {
+  ABSL_CHECK(reader != nullptr);
+  ABSL_CHECK_LE(header_size, window_offset);
+  context_ = nullptr;
+
+  auto context = std::make_unique<TiffReader::Context>(reader);
+  context->header_size_ = header_size;
+  context->window_offset_ = window_offset;
+  TENSORSTORE_RETURN_IF_ERROR(context->Open());
+  context_ = std::move(context);
+  return absl::OkStatus();
+}
+
 // Returns the number of frames that can be decoded.
 int TiffReader::GetFrameCount() const {
   if (!context_) return 0;
@@ -535,7 +610,7 @@ absl::Status TiffReader::DecodeImpl(tensorstore::span<unsigned char> dest,
   if (!context_) {
     return absl::InternalError("No TIFF file to decode");
   }
-  return context_->DefaultDecode(dest);
+  return context_->DefaultDecode(dest, options);
 }
 
 bool TiffReader::CheckSignature(std::string_view signature) {
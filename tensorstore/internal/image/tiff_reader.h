@@ -15,7 +15,11 @@
 #ifndef TENSORSTORE_INTERNAL_IMAGE_TIFF_READER_H_
 #define TENSORSTORE_INTERNAL_IMAGE_TIFF_READER_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <memory>
+#include <optional>
 
 #include "absl/status/status.h"
 #include "riegeli/bytes/reader.h"
@@ -26,7 +30,12 @@
 namespace tensorstore {
 namespace internal_image {
 
-struct TiffReaderOptions {};
+struct TiffReaderOptions {
+  /// When set, only the specified region of the image is decoded into `dest`,
+  /// which must then be sized for the region.  Only the strips or tiles which
+  /// intersect the region are read.
+  std::optional<ImageRegion> region;
+};
 
 class TiffReader : public ImageReader {
  public:
@@ -42,6 +51,13 @@ class TiffReader : public ImageReader {
   // Initialize the decoder.
   absl::Status Initialize(riegeli::Reader* reader) override;
 
+  // Initialize the decoder from a reader which holds only part of a TIFF file:
+  // the `header_size` bytes of the file header, followed by the file bytes
+  // starting at `window_offset`.  The first directory referenced by the header,
+  // and all of the data it references, must lie within the window.
+  absl::Status Initialize(riegeli::Reader* reader, size_t header_size,
+                          uint64_t window_offset);
+
   // Returns the number of TIFF directory entries (or pages).
   int GetFrameCount() const;
 
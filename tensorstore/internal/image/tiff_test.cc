@@ -42,7 +42,9 @@ ABSL_FLAG(std::string, tensorstore_test_data_dir, ".",
 namespace {
 
 using ::tensorstore::internal_image::ImageInfo;
+using ::tensorstore::internal_image::ImageRegion;
 using ::tensorstore::internal_image::TiffReader;
+using ::tensorstore::internal_image::TiffReaderOptions;
 using ::tensorstore::internal_image::TiffWriter;
 using ::tensorstore::internal_image::TiffWriterOptions;
 
@@ -195,6 +197,76 @@ TEST_F(TiffTest, ReadMultiPage) {
   }
 }
 
+TEST_F(TiffTest, DecodeRegion) {
+  for (const char* name :
+       {"tiff/D75_01b.tiff", "tiff/D75_08b.tiff", "tiff/D75_08b_tiled.tiff",
+        "tiff/D75_08b_scanline.tiff", "tiff/D75_08b_lzw.tiff",
+        "tiff/D75_16b_grey.tiff"}) {
+    SCOPED_TRACE(name);
+    absl::Cord file_data;
+    {
+      std::string filename = tensorstore::internal::JoinPath(
+          absl::GetFlag(FLAGS_tensorstore_test_data_dir), name);
+      TENSORSTORE_ASSERT_OK(
+          riegeli::ReadAll(riegeli::FdReader(filename), file_data));
+    }
+
+    // Decode the entire image.
+    riegeli::CordReader cord_reader(&file_data);
+    TiffReader decoder;
+    ASSERT_THAT(decoder.Initialize(&cord_reader), ::tensorstore::IsOk());
+    const ImageInfo info = decoder.GetImageInfo();
+    const size_t image_bytes = ImageRequiredBytes(info);
+    std::unique_ptr<unsigned char[]> image(new unsigned char[image_bytes]());
+    ASSERT_THAT(decoder.Decode(tensorstore::span(image.get(), image_bytes)),
+                ::tensorstore::IsOk());
+
+    for (const ImageRegion& region :
+         {ImageRegion{37, 51, 90, 101}, ImageRegion{0, 0, 1, info.width},
+          ImageRegion{info.height - 5, info.width - 3, 5, 3}}) {
+      SCOPED_TRACE(::testing::Message() << region.y << "," << region.x << " "
+                                        << region.height << "x"
+                                        << region.width);
+      riegeli::CordReader region_reader(&file_data);
+      TiffReader region_decoder;
+      ASSERT_THAT(region_decoder.Initialize(&region_reader),
+                  ::tensorstore::IsOk());
+      const size_t region_bytes =
+          ImageRequiredBytes(GetRegionImageInfo(info, region));
+      std::unique_ptr<unsigned char[]> region_image(
+          new unsigned char[region_bytes]());
+      ASSERT_THAT(region_decoder.Decode(
+                      tensorstore::span(region_image.get(), region_bytes),
+                      TiffReaderOptions{region}),
+                  ::tensorstore::IsOk());
+
+      // Each row of the region matches the corresponding part of the image.
+      const size_t pixel_bytes = info.num_components * info.dtype.size();
+      const size_t row_bytes = region.width * pixel_bytes;
+      for (int32_t y = 0; y < region.height; y++) {
+        const unsigned char* expected =
+            image.get() + ((region.y + y) * info.width + region.x) *
+                              pixel_bytes;
+        EXPECT_EQ(std::string_view(reinterpret_cast<const char*>(expected),
+                                   row_bytes),
+                  std::string_view(reinterpret_cast<const char*>(
+                                       region_image.get() + y * row_bytes),
+                                   row_bytes))
+            << "row " << y;
+      }
+    }
+
+    riegeli::CordReader invalid_reader(&file_data);
+    TiffReader invalid_decoder;
+    ASSERT_THAT(invalid_decoder.Initialize(&invalid_reader),
+                ::tensorstore::IsOk());
+    EXPECT_THAT(invalid_decoder.Decode(
+                    tensorstore::span<unsigned char>(),
+                    TiffReaderOptions{ImageRegion{0, info.width, 1, 1}}),
+                tensorstore::MatchesStatus(absl::StatusCode::kInvalidArgument));
+  }
+}
+
 TEST_F(TiffTest, CorruptData) {
   static constexpr unsigned char data[] = {
       0x49, 0x49, 0x2a, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0b, 0x00,
@@ -56,6 +56,7 @@ absl::Status EncodeWebP(riegeli::Writer* writer,
   config.quality = options.quality;
   config.method = 6;
   config.exact = (info.num_components == 4) ? 1 : 0;  // Keep alpha channel.
+  config.thread_level = options.use_threads ? 1 : 0;
   ABSL_CHECK(WebPValidateConfig(&config));
 
   WebPPicture pic;
@@ -34,6 +34,9 @@ struct WebPWriterOptions {
   /// Quality ia a value between [0..100] and reflects cpu cost for compression
   /// (in lossless), or a relative perceptual loss (lossy).
   int quality = 95;
+
+  /// Whether the encoder may use an additional thread for a single image.
+  bool use_threads = false;
 };
 
 class WebPWriter : public ImageWriter {
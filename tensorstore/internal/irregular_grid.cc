@@ -18,10 +18,12 @@
 
 #include <algorithm>
 #include <cassert>
+#include <numeric>
 #include <utility>
 #include <vector>
 
 #include "absl/container/inlined_vector.h"
+#include "absl/numeric/bits.h"
 #include "tensorstore/index.h"
 #include "tensorstore/index_interval.h"
 #include "tensorstore/index_space/index_domain.h"
@@ -29,10 +31,30 @@
 
 namespace tensorstore {
 namespace internal {
+namespace {
+
+// Stores the sorted `points`, and their positions, into `eytzinger` in
+// Eytzinger order, where the children of the node at position `k` are at
+// positions `2 * k` and `2 * k + 1`.
+size_t BuildEytzinger(tensorstore::span<const Index> points,
+                      std::vector<Index>& eytzinger,
+                      std::vector<Index>& positions, size_t i = 0,
+                      size_t k = 1) {
+  if (k < eytzinger.size()) {
+    i = BuildEytzinger(points, eytzinger, positions, i, 2 * k);
+    eytzinger[k] = points[i];
+    positions[k] = i++;
+    i = BuildEytzinger(points, eytzinger, positions, i, 2 * k + 1);
+  }
+  return i;
+}
+
+}  // namespace
 
 IrregularGrid::IrregularGrid(std::vector<std::vector<Index>> inclusive_mins)
     : shape_(inclusive_mins.size(), 0),
-      inclusive_mins_(std::move(inclusive_mins)) {
+      inclusive_mins_(std::move(inclusive_mins)),
+      eytzinger_(inclusive_mins_.size()) {
   // Sort and remove duplicate grid points.
   for (size_t i = 0; i < inclusive_mins_.size(); i++) {
     std::sort(inclusive_mins_[i].begin(), inclusive_mins_[i].end());
@@ -41,14 +63,32 @@ IrregularGrid::IrregularGrid(std::vector<std::vector<Index>> inclusive_mins)
     inclusive_mins_[i].resize(
         std::distance(inclusive_mins_[i].begin(), new_it));
     shape_[i] = inclusive_mins_[i].size() - 1;
+    auto& eytzinger = eytzinger_[i];
+    eytzinger.points.resize(inclusive_mins_[i].size() + 1);
+    eytzinger.positions.resize(inclusive_mins_[i].size() + 1);
+    BuildEytzinger(inclusive_mins_[i], eytzinger.points, eytzinger.positions);
   }
 }
 
+Index IrregularGrid::CountPointsNotAfter(DimensionIndex dim,
+                                         Index output_index) const {
+  const auto& points = eytzinger_[dim].points;
+  const size_t n = points.size() - 1;
+  // Descend to a leaf, then recover the first point greater than
+  // `output_index`, which is at the last node at which the descent went left.
+  size_t k = 1;
+  while (k <= n) {
+    k = 2 * k + (points[k] <= output_index);
+  }
+  k >>= absl::countr_one(k) + 1;
+  // `k == 0` if all points are less than or equal to `output_index`.
+  return k == 0 ? n : eytzinger_[dim].positions[k];
+}
+
 Index IrregularGrid::operator()(DimensionIndex dim, Index output_index,
                                 IndexInterval* cell_bounds) const {
   auto points = inclusive_min(dim);
-  auto it = std::upper_bound(points.begin(), points.end(), output_index);
-  Index cell = std::distance(points.begin(), it) - 1;
+  Index cell = CountPointsNotAfter(dim, output_index) - 1;
   if (cell_bounds) {
     if (cell < 0) {
       *cell_bounds = IndexInterval::UncheckedHalfOpen(-kInfIndex, points[0]);
@@ -62,6 +102,39 @@ Index IrregularGrid::operator()(DimensionIndex dim, Index output_index,
   return cell;
 }
 
+void IrregularGrid::GetCellIndices(
+    DimensionIndex dim, tensorstore::span<const Index> output_indices,
+    tensorstore::span<Index> cell_indices) const {
+  assert(output_indices.size() == cell_indices.size());
+  const size_t num_indices = output_indices.size();
+  auto points = inclusive_min(dim);
+  // For a few indices, sorting costs more than it saves.
+  if (num_indices < 16) {
+    for (size_t i = 0; i < num_indices; ++i) {
+      cell_indices[i] = CountPointsNotAfter(dim, output_indices[i]) - 1;
+    }
+    return;
+  }
+  // Visit the indices in sorted order, merging them against the grid points.
+  std::vector<size_t> order(num_indices);
+  std::iota(order.begin(), order.end(), size_t{0});
+  if (!std::is_sorted(output_indices.begin(), output_indices.end())) {
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      return output_indices[a] < output_indices[b];
+    });
+  }
+  // Consecutive indices usually fall in the same cell, which requires just
+  // one comparison; otherwise only the remaining points are searched.
+  auto next_point = points.begin();
+  for (size_t i : order) {
+    const Index output_index = output_indices[i];
+    if (next_point != points.end() && *next_point <= output_index) {
+      next_point = std::upper_bound(next_point + 1, points.end(), output_index);
+    }
+    cell_indices[i] = (next_point - points.begin()) - 1;
+  }
+}
+
 /*static*/
 IrregularGrid IrregularGrid::Make(
     tensorstore::span<const IndexDomain<>> domains) {
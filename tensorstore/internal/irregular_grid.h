@@ -46,6 +46,17 @@ class IrregularGrid {
   Index operator()(DimensionIndex dim, Index output_index,
                    IndexInterval* cell_bounds) const;
 
+  /// Converts each of `output_indices` to a grid index along `dim`, as by
+  /// `operator()`, and stores it in the corresponding element of
+  /// `cell_indices`.
+  ///
+  /// Rather than searching for each index separately, the indices are
+  /// visited in sorted order and merged against the grid points, which is
+  /// faster for large sets of indices such as those of an index array.
+  void GetCellIndices(DimensionIndex dim,
+                      tensorstore::span<const Index> output_indices,
+                      tensorstore::span<Index> cell_indices) const;
+
   /// The rank of the grid.
   DimensionIndex rank() const { return shape_.size(); }
 
@@ -78,8 +89,22 @@ class IrregularGrid {
   }
 
  private:
+  /// Returns the number of grid points along `dim` that are less than or
+  /// equal to `output_index`.
+  Index CountPointsNotAfter(DimensionIndex dim, Index output_index) const;
+
   std::vector<Index> shape_;
   std::vector<std::vector<Index>> inclusive_mins_;
+
+  /// Grid points along a dimension in Eytzinger (breadth-first binary tree)
+  /// order, starting at position 1, so that the positions visited by a search
+  /// are clustered at the start of the array rather than spread across it.
+  struct EytzingerPoints {
+    std::vector<Index> points;
+    /// Position of each point in `inclusive_mins_`.
+    std::vector<Index> positions;
+  };
+  std::vector<EytzingerPoints> eytzinger_;
 };
 
 }  // namespace internal
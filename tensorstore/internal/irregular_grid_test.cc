@@ -14,10 +14,12 @@
 
 #include "tensorstore/internal/irregular_grid.h"
 
+#include <algorithm>
 #include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/random/random.h"
 #include "tensorstore/box.h"
 #include "tensorstore/index.h"
 #include "tensorstore/index_interval.h"
@@ -122,6 +124,50 @@ TEST(IrregularGridTest, IndexDomain) {
   EXPECT_EQ(grid_cell, IndexInterval::UncheckedClosed(45, kInfIndex));
 }
 
+TEST(IrregularGridTest, MatchesUpperBound) {
+  absl::BitGen gen;
+  for (size_t num_points : {1, 2, 3, 7, 8, 100}) {
+    SCOPED_TRACE(num_points);
+    std::vector<Index> dimension0;
+    for (size_t i = 0; i < num_points; ++i) {
+      dimension0.push_back(absl::Uniform<Index>(gen, -1000, 1000));
+    }
+    auto grid = IrregularGrid({dimension0});
+    auto points = grid.inclusive_min(0);
+    std::vector<Index> output_indices;
+    for (Index i = -1010; i <= 1010; ++i) output_indices.push_back(i);
+    std::shuffle(output_indices.begin(), output_indices.end(), gen);
+    std::vector<Index> expected;
+    for (Index output_index : output_indices) {
+      Index cell = std::upper_bound(points.begin(), points.end(),
+                                    output_index) -
+                   points.begin() - 1;
+      EXPECT_EQ(cell, grid(0, output_index, nullptr)) << output_index;
+      expected.push_back(cell);
+    }
+    std::vector<Index> cell_indices(output_indices.size());
+    grid.GetCellIndices(0, output_indices, cell_indices);
+    EXPECT_EQ(expected, cell_indices);
+  }
+}
+
+TEST(IrregularGridTest, GetCellIndices) {
+  auto grid = IrregularGrid({{2, 0, -3}});
+  std::vector<Index> cell_indices(4);
+  grid.GetCellIndices(0, {{3, -4, 0, -2}}, cell_indices);
+  EXPECT_THAT(cell_indices, ElementsAre(2, -1, 1, 0));
+
+  // Enough indices to be merged against the grid points.
+  std::vector<Index> output_indices;
+  for (Index i = 0; i < 20; ++i) output_indices.push_back(i % 5 - 3);
+  cell_indices.resize(output_indices.size());
+  grid.GetCellIndices(0, output_indices, cell_indices);
+  EXPECT_THAT(tensorstore::span(cell_indices).first(5),
+              ElementsAre(0, 0, 0, 1, 1));
+  EXPECT_THAT(tensorstore::span(cell_indices).last(5),
+              ElementsAre(0, 0, 0, 1, 1));
+}
+
 TEST(IrregularGridTest, Rank0) {
   std::vector<std::vector<Index>> inclusive_mins;
   auto grid = IrregularGrid(inclusive_mins);
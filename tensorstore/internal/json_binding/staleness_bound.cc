@@ -20,6 +20,7 @@
 #include "tensorstore/internal/json/value_as.h"
 #include "tensorstore/internal/json_binding/bindable.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/util/status.h"
 
 namespace tensorstore {
 namespace internal {
@@ -37,13 +38,29 @@ TENSORSTORE_DEFINE_JSON_BINDER(
         } else if (*j == "open") {
           obj->time = absl::InfiniteFuture();
           obj->bounded_by_open_time = true;
+          obj->max_age = absl::ZeroDuration();
+        } else if (const auto* m =
+                       j->get_ptr<const ::nlohmann::json::object_t*>();
+                   m && m->size() == 1 && m->count("max_age")) {
+          double max_age;
+          TENSORSTORE_RETURN_IF_ERROR(internal_json::JsonRequireValueAs(
+              m->at("max_age"), &max_age, [](double x) { return x >= 0; },
+              /*strict=*/true));
+          obj->time = absl::InfiniteFuture();
+          obj->bounded_by_open_time = true;
+          obj->max_age = absl::Seconds(max_age);
         } else {
-          return internal_json::ExpectedError(*j,
-                                              "boolean, number, or \"open\"");
+          return internal_json::ExpectedError(
+              *j, "boolean, number, \"open\", or {\"max_age\": number}");
         }
       } else {
         if (obj->bounded_by_open_time) {
-          *j = "open";
+          if (obj->max_age == absl::ZeroDuration()) {
+            *j = "open";
+          } else {
+            *j = ::nlohmann::json::object_t{
+                {"max_age", absl::ToDoubleSeconds(obj->max_age)}};
+          }
         } else {
           const absl::Time& t = obj->time;
           if (t == absl::InfiniteFuture()) {
@@ -20,6 +20,7 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/status/status.h"
 #include "absl/time/time.h"
 #include <nlohmann/json.hpp>
 #include "tensorstore/internal/json_binding/bindable.h"
@@ -27,8 +28,10 @@
 #include "tensorstore/internal/testing/json_gtest.h"
 #include "tensorstore/json_serialization_options_base.h"
 #include "tensorstore/staleness_bound.h"
+#include "tensorstore/util/status_testutil.h"
 
 using ::tensorstore::MatchesJson;
+using ::tensorstore::MatchesStatus;
 using ::tensorstore::StalenessBound;
 using ::testing::Optional;
 
@@ -39,6 +42,9 @@ TEST(StalenessBoundJsonBinderTest, RoundTrip) {
       {StalenessBound{absl::InfinitePast()}, Optional(MatchesJson(false))},
       {StalenessBound{absl::InfiniteFuture()}, Optional(MatchesJson(true))},
       {StalenessBound::BoundedByOpen(), Optional(MatchesJson("open"))},
+      {StalenessBound(tensorstore::RecheckCacheOption::AtOpen(
+           absl::Seconds(30))),
+       Optional(MatchesJson(::nlohmann::json{{"max_age", 30}}))},
       {StalenessBound{absl::UnixEpoch()}, Optional(MatchesJson(0))},
       {StalenessBound{absl::UnixEpoch() + absl::Seconds(1)},
        Optional(MatchesJson(1))},
@@ -77,4 +83,28 @@ TEST(StalenessBoundJsonBinderTest, FromJson) {
   });
 }
 
+TEST(StalenessBoundJsonBinderTest, MaxAge) {
+  tensorstore::TestJsonBinderFromJson<StalenessBound>({
+      {::nlohmann::json{{"max_age", 1.5}},
+       ::testing::Optional(::testing::AllOf(
+           ::testing::Field(&StalenessBound::bounded_by_open_time, true),
+           ::testing::Field(&StalenessBound::max_age,
+                            absl::Milliseconds(1500))))},
+      {::nlohmann::json{{"max_age", -1}},
+       MatchesStatus(absl::StatusCode::kInvalidArgument)},
+      {::nlohmann::json{{"max_age", 1}, {"extra", 1}},
+       MatchesStatus(absl::StatusCode::kInvalidArgument)},
+  });
+}
+
+TEST(StalenessBoundTest, BoundAtOpenWithMaxAge) {
+  const absl::Time open_time = absl::UnixEpoch() + absl::Seconds(100);
+  StalenessBound bound(
+      tensorstore::RecheckCachedMetadata::AtOpen(absl::Seconds(30)));
+  EXPECT_EQ(absl::UnixEpoch() + absl::Seconds(70),
+            bound.BoundAtOpen(open_time).time);
+  EXPECT_EQ(open_time,
+            StalenessBound::BoundedByOpen().BoundAtOpen(open_time).time);
+}
+
 }  // namespace
@@ -18,6 +18,7 @@
 #include <cassert>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "tensorstore/array.h"
@@ -122,6 +123,128 @@ void RemoveMaskArrayIfNotNeeded(MaskData* mask) {
     mask->mask_array.element_pointer() = {};
   }
 }
+
+/// Returns `true` if `a` and `b` have a non-empty intersection.
+bool Intersects(BoxView<> a, BoxView<> b) {
+  const DimensionIndex rank = a.rank();
+  assert(b.rank() == rank);
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    if (Intersect(a[i], b[i]).empty()) return false;
+  }
+  return true;
+}
+
+/// Appends to `out` disjoint boxes whose union is `a` minus `b`.
+void SubtractBox(BoxView<> a, BoxView<> b, std::vector<Box<>>& out) {
+  const DimensionIndex rank = a.rank();
+  assert(b.rank() == rank);
+  if (!Intersects(a, b)) {
+    out.emplace_back(a);
+    return;
+  }
+  // Peels off the parts of `remaining` below and above `b` in each dimension
+  // in turn, leaving the intersection of `a` and `b`.
+  Box<> remaining(a);
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    const IndexInterval r = remaining[i];
+    const IndexInterval bi = b[i];
+    if (r.inclusive_min() < bi.inclusive_min()) {
+      Box<>& piece = out.emplace_back(remaining);
+      piece[i] = IndexInterval::UncheckedClosed(r.inclusive_min(),
+                                                bi.inclusive_min() - 1);
+    }
+    if (r.inclusive_max() > bi.inclusive_max()) {
+      Box<>& piece = out.emplace_back(remaining);
+      piece[i] = IndexInterval::UncheckedClosed(bi.inclusive_max() + 1,
+                                                r.inclusive_max());
+    }
+    remaining[i] = Intersect(r, bi);
+  }
+}
+
+/// Returns the boxes whose union is `mask`, which must not have a mask array.
+std::vector<Box<>> GetMaskBoxes(const MaskData& mask) {
+  assert(!mask.mask_array.valid());
+  if (!mask.boxes.empty()) return mask.boxes;
+  std::vector<Box<>> boxes;
+  if (mask.num_masked_elements != 0) boxes.emplace_back(mask.region);
+  return boxes;
+}
+
+/// Adds `new_boxes` to `*mask`, which must not have a mask array, without
+/// allocating one.  Returns `false`, leaving `*mask` unchanged, if that would
+/// take more than `kMaxMaskBoxes` boxes.
+bool AddBoxesToMask(const std::vector<Box<>>& new_boxes, MaskData* mask) {
+  std::vector<Box<>> boxes = GetMaskBoxes(*mask);
+  for (const Box<>& new_box : new_boxes) {
+    if (new_box.is_empty()) continue;
+    // Boxes covered by `new_box` are replaced by it; the part of `new_box`
+    // not covered by the others is added in disjoint pieces.
+    boxes.erase(std::remove_if(boxes.begin(), boxes.end(),
+                               [&](const Box<>& box) {
+                                 return Contains(new_box, box);
+                               }),
+                boxes.end());
+    std::vector<Box<>> pieces{new_box};
+    for (const Box<>& box : boxes) {
+      if (!Intersects(new_box, box)) continue;
+      std::vector<Box<>> remaining;
+      for (const Box<>& piece : pieces) {
+        SubtractBox(piece, box, remaining);
+      }
+      pieces = std::move(remaining);
+      // Each subtraction may split every piece into up to `2 * rank` pieces.
+      // Rather than subtracting the remaining boxes from an ever larger set of
+      // pieces, fall back to a mask array as soon as there are too many.
+      if (pieces.size() > kMaxMaskBoxes) return false;
+    }
+    if (boxes.size() + pieces.size() > kMaxMaskBoxes) return false;
+    boxes.insert(boxes.end(), std::make_move_iterator(pieces.begin()),
+                 std::make_move_iterator(pieces.end()));
+  }
+  if (boxes.empty()) return true;
+  Index num_masked_elements = 0;
+  Box<> region = boxes.front();
+  for (const Box<>& box : boxes) {
+    num_masked_elements += box.num_elements();
+    Hull(region, box, region);
+  }
+  mask->num_masked_elements = num_masked_elements;
+  mask->region = std::move(region);
+  if (num_masked_elements == mask->region.num_elements()) {
+    // The boxes tile their hull.
+    boxes.clear();
+  }
+  mask->boxes = std::move(boxes);
+  return true;
+}
+
+/// Sets the elements of `mask_array`, which has the domain `box`, that are
+/// within `region` to `true`.
+void FillMaskRegion(BoxView<> box, const SharedArray<bool>& mask_array,
+                    BoxView<> region) {
+  ByteStridedPointer<bool> start = mask_array.data();
+  start += GetRelativeOffset(box.origin(), region.origin(),
+                             mask_array.byte_strides());
+  internal::IterateOverArrays(
+      internal::SimpleElementwiseFunction<SetMask(bool), void*>{},
+      /*arg=*/nullptr,
+      /*constraints=*/skip_repeated_elements,
+      ArrayView<bool>(start.get(), StridedLayoutView<>(
+                                       region.shape(),
+                                       mask_array.byte_strides())));
+}
+
+/// Returns the part within `part` of `array`, which has the domain `box`.
+template <typename T>
+ArrayView<T> GetSubArrayView(BoxView<> box, ArrayView<T> array,
+                             BoxView<> part) {
+  ByteStridedPointer<T> start = array.data();
+  start += GetRelativeOffset(box.origin(), part.origin(), array.byte_strides());
+  return ArrayView<T>(
+      ElementPointer<T>(start.get(), array.dtype()),
+      StridedLayoutView<>(part.shape(), array.byte_strides()));
+}
 }  // namespace
 
 MaskData::MaskData(DimensionIndex rank) : region(rank) {
@@ -131,23 +254,24 @@ MaskData::MaskData(DimensionIndex rank) : region(rank) {
 SharedArray<bool> CreateMaskArray(BoxView<> box, BoxView<> mask_region,
                                   ContiguousLayoutPermutation<> layout_order) {
   auto array = AllocateArray<bool>(box.shape(), layout_order, value_init);
-  ByteStridedPointer<bool> start = array.data();
-  start += GetRelativeOffset(box.origin(), mask_region.origin(),
-                             array.byte_strides());
-  internal::IterateOverArrays(
-      internal::SimpleElementwiseFunction<SetMask(bool), void*>{},
-      /*arg=*/nullptr,
-      /*constraints=*/skip_repeated_elements,
-      ArrayView<bool>(start.get(), StridedLayoutView<>(mask_region.shape(),
-                                                       array.byte_strides())));
+  FillMaskRegion(box, array, mask_region);
   return array;
 }
 
 void CreateMaskArrayFromRegion(BoxView<> box, MaskData* mask,
                                ContiguousLayoutPermutation<> layout_order) {
-  assert(mask->num_masked_elements == mask->region.num_elements());
   assert(layout_order.size() == mask->region.rank());
-  mask->mask_array = CreateMaskArray(box, mask->region, layout_order);
+  if (mask->boxes.empty()) {
+    assert(mask->num_masked_elements == mask->region.num_elements());
+    mask->mask_array = CreateMaskArray(box, mask->region, layout_order);
+    return;
+  }
+  mask->mask_array =
+      AllocateArray<bool>(box.shape(), layout_order, value_init);
+  for (const Box<>& masked : mask->boxes) {
+    FillMaskRegion(box, mask->mask_array, masked);
+  }
+  mask->boxes.clear();
 }
 
 void UnionMasks(BoxView<> box, MaskData* mask_a, MaskData* mask_b,
@@ -178,12 +302,14 @@ void UnionMasks(BoxView<> box, MaskData* mask_a, MaskData* mask_b,
   }
 
   if (!mask_a->mask_array.valid() && !mask_b->mask_array.valid()) {
-    if (IsHullEqualToUnion(mask_a->region, mask_b->region)) {
+    if (mask_a->boxes.empty() && mask_b->boxes.empty() &&
+        IsHullEqualToUnion(mask_a->region, mask_b->region)) {
       // The combined mask can be specified by the region alone.
       Hull(mask_a->region, mask_b->region, mask_a->region);
       mask_a->num_masked_elements = mask_a->region.num_elements();
       return;
     }
+    if (AddBoxesToMask(GetMaskBoxes(*mask_b), mask_a)) return;
   } else if (!mask_a->mask_array.valid()) {
     std::swap(*mask_a, *mask_b);
   }
@@ -193,18 +319,21 @@ void UnionMasks(BoxView<> box, MaskData* mask_a, MaskData* mask_b,
   }
 
   // Copy in mask_b.
-  ByteStridedPointer<bool> start = mask_a->mask_array.data();
-  start += GetRelativeOffset(box.origin(), mask_b->region.origin(),
-                             mask_a->mask_array.byte_strides());
-  IterateOverArrays(
-      [&](bool* ptr) {
-        if (!*ptr) ++mask_a->num_masked_elements;
-        *ptr = true;
-      },
-      /*constraints=*/{},
-      ArrayView<bool>(start.get(),
-                      StridedLayoutView<>(mask_b->region.shape(),
-                                          mask_a->mask_array.byte_strides())));
+  for (const Box<>& masked : GetMaskBoxes(*mask_b)) {
+    ByteStridedPointer<bool> start = mask_a->mask_array.data();
+    start += GetRelativeOffset(box.origin(), masked.origin(),
+                               mask_a->mask_array.byte_strides());
+    IterateOverArrays(
+        [&](bool* ptr) {
+          if (!*ptr) ++mask_a->num_masked_elements;
+          *ptr = true;
+        },
+        /*constraints=*/{},
+        ArrayView<bool>(start.get(),
+                        StridedLayoutView<>(
+                            masked.shape(),
+                            mask_a->mask_array.byte_strides())));
+  }
   Hull(mask_a->region, mask_b->region, mask_a->region);
   RemoveMaskArrayIfNotNeeded(mask_a);
 }
@@ -225,23 +354,30 @@ void RebaseMaskedArray(BoxView<> box, ArrayView<const void> source,
     return;
   }
 
-  // Materialize mask array.
-  ArrayView<bool> mask_array_view;
-  SharedArray<bool> mask_array;
-  if (mask.mask_array.valid()) {
-    mask_array_view = mask.mask_array;
-  } else {
-    DimensionIndex layout_order[kMaxRank];
-    tensorstore::span<DimensionIndex> layout_order_span(layout_order,
-                                                        dest.rank());
-    SetPermutationFromStrides(dest.byte_strides(), layout_order_span);
-    mask_array = CreateMaskArray(
-        box, mask.region, ContiguousLayoutPermutation<>(layout_order_span));
-    mask_array_view = mask_array;
+  if (!mask.mask_array.valid()) {
+    // Copy the boxes that make up the complement of the mask, which requires
+    // no mask array.
+    std::vector<Box<>> unmasked{Box<>(box)};
+    for (const Box<>& masked : GetMaskBoxes(mask)) {
+      std::vector<Box<>> remaining;
+      for (const Box<>& part : unmasked) {
+        SubtractBox(part, masked, remaining);
+      }
+      unmasked = std::move(remaining);
+    }
+    for (const Box<>& part : unmasked) {
+      [[maybe_unused]] const auto success = internal::IterateOverArrays(
+          {&dtype->copy_assign, /*context=*/nullptr},
+          /*arg=*/nullptr, skip_repeated_elements,
+          GetSubArrayView(box, source, part), GetSubArrayView(box, dest, part));
+      assert(success);
+    }
+    return;
   }
   [[maybe_unused]] const auto success = internal::IterateOverArrays(
       {&dtype->copy_assign_unmasked, /*context=*/nullptr},
-      /*arg=*/nullptr, skip_repeated_elements, source, dest, mask_array_view);
+      /*arg=*/nullptr, skip_repeated_elements, source, dest,
+      ArrayView<bool>(mask.mask_array));
   assert(success);
 }
 
@@ -261,10 +397,27 @@ void WriteToMask(MaskData* mask, BoxView<> output_box,
       GetOutputRange(input_to_output, output_range).value();
   Intersect(output_range, output_box, output_range);
 
+  if (range_is_exact && output_range == output_box) {
+    // All elements are masked, and any existing mask array is no longer
+    // needed.
+    mask->mask_array.element_pointer() = {};
+    mask->boxes.clear();
+    mask->region = output_box;
+    mask->num_masked_elements = output_box.num_elements();
+    return;
+  }
+
+  if (range_is_exact && output_box.rank() != 0 &&
+      !mask->mask_array.valid() &&
+      mask->num_masked_elements != output_box.num_elements() &&
+      AddBoxesToMask({Box<>(output_range)}, mask)) {
+    return;
+  }
+
   const bool use_mask_array =
       output_box.rank() != 0 &&
       mask->num_masked_elements != output_box.num_elements() &&
-      (mask->mask_array.valid() ||
+      (mask->mask_array.valid() || !mask->boxes.empty() ||
        (!Contains(mask->region, output_range) &&
         (!range_is_exact || !IsHullEqualToUnion(mask->region, output_range))));
   if (use_mask_array && !mask->mask_array.valid()) {
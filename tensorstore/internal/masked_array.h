@@ -19,8 +19,11 @@
 /// Functions for tracking modifications to an array using a mask array or
 /// bounding box.
 
+#include <stddef.h>
+
 #include <algorithm>
 #include <memory>
+#include <vector>
 
 #include "tensorstore/array.h"
 #include "tensorstore/box.h"
@@ -42,11 +45,13 @@ namespace internal {
 /// The actual hyperrectangle `mask_box` over which the mask is defined is
 /// stored separately.
 ///
-/// There are two possible representations of the mask:
+/// There are three possible representations of the mask:
 ///
 /// If the region of the mask set to `true` happens to be a hyperrectangle, it
-/// is represented simply as a `Box`.  Otherwise, it is represented using a
-/// `bool` array.
+/// is represented simply as a `Box`.  If it is the union of at most
+/// `kMaxMaskBoxes` disjoint hyperrectangles, as when a chunk is written in a
+/// few separate strips, it is represented as a list of them.  Otherwise, it is
+/// represented using a `bool` array.
 struct MaskData {
   /// Initializes a mask in which no elements are included in the mask.
   explicit MaskData(DimensionIndex rank);
@@ -54,24 +59,37 @@ struct MaskData {
   void Reset() {
     num_masked_elements = 0;
     mask_array.element_pointer() = {};
+    boxes.clear();
     region.Fill(IndexInterval::UncheckedSized(0, 0));
   }
 
   /// If `mask_array.valid()`, stores a mask array of size `mask_box.shape()`,
-  /// where all elements outside `region` are `false`. If `!mask_array.valid()`,
-  /// indicates that all elements within `region` are masked.
+  /// where all elements outside `region` are `false`. If `!mask_array.valid()`
+  /// and `boxes` is empty, indicates that all elements within `region` are
+  /// masked.
   SharedArray<bool> mask_array;
 
-  /// Number of `true` values in `mask_array`, or `region.num_elements()` if
-  /// `!mask_array.valid()`.  As a special case, if `region.rank() == 0`,
-  /// `num_masked_elements` may equal `0` even if `!mask_array.valid()` to
-  /// indicate that the singleton element is not included in the mask.
+  /// If non-empty, the mask is the union of these disjoint boxes, and
+  /// `mask_array` is not valid.  Never holds a single box, since that is
+  /// represented by `region` alone.
+  std::vector<Box<>> boxes;
+
+  /// Number of `true` values in `mask_array`, the total size of `boxes`, or
+  /// otherwise `region.num_elements()`.  As a special case, if
+  /// `region.rank() == 0`, `num_masked_elements` may equal `0` even if
+  /// `!mask_array.valid()` to indicate that the singleton element is not
+  /// included in the mask.
   Index num_masked_elements = 0;
 
-  /// Subregion of `mask_box` for which the mask is `true`.
+  /// Subregion of `mask_box` for which the mask is `true`, or the bounding box
+  /// of the masked elements if `mask_array.valid()` or `boxes` is non-empty.
   Box<> region;
 };
 
+/// Maximum number of boxes in `MaskData::boxes`.  A mask that would need more
+/// is converted to a `bool` array.
+constexpr size_t kMaxMaskBoxes = 16;
+
 /// Updates `*mask` to include all positions within the range of
 /// `input_to_output`.
 ///
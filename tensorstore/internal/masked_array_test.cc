@@ -14,6 +14,7 @@
 
 #include "tensorstore/internal/masked_array.h"
 
+#include <algorithm>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -63,6 +64,7 @@ using ::tensorstore::TransformedArray;
 using ::tensorstore::internal::ElementCopyFunction;
 using ::tensorstore::internal::MaskData;
 using ::tensorstore::internal::SimpleElementwiseFunction;
+using ::testing::ElementsAre;
 
 /// Stores a MaskData object along with a Box representing its associated domain
 /// and a StridedLayout representing the mask array layout.
@@ -304,13 +306,9 @@ TEST(WriteToMaskedArrayTest, RankTwo) {
       })));
   EXPECT_EQ(13, tester.num_masked_elements());
   EXPECT_EQ(BoxView({2, 2}, {3, 5}), tester.mask_region());
-  EXPECT_EQ(MakeArray<bool>({
-                {0, 0, 0, 0, 0},
-                {1, 1, 1, 0, 0},
-                {1, 1, 1, 1, 1},
-                {1, 1, 1, 1, 1},
-            }),
-            tester.mask_array());
+  EXPECT_FALSE(tester.mask_array().valid());
+  EXPECT_THAT(tester.mask().boxes,
+              ElementsAre(Box<>({2, 2}, {3, 3}), Box<>({3, 5}, {2, 2})));
   EXPECT_EQ(MakeArray({
                 {0, 0, 0, 0, 0},
                 {7, 8, 2, 0, 0},
@@ -320,6 +318,88 @@ TEST(WriteToMaskedArrayTest, RankTwo) {
             tester.dest_array());
 }
 
+TEST(WriteToMaskedArrayTest, RankTwoOverlappingBoxes) {
+  MaskedArrayWriteTester<int> tester{BoxView({0, 0}, {4, 4})};
+  TENSORSTORE_EXPECT_OK(tester.Write(
+      (tester.transform() | Dims(0, 1).TranslateSizedInterval({0, 0}, {2, 2}))
+          .value(),
+      MakeArray({{1, 1}, {1, 1}})));
+  TENSORSTORE_EXPECT_OK(tester.Write(
+      (tester.transform() | Dims(0, 1).TranslateSizedInterval({1, 1}, {2, 2}))
+          .value(),
+      MakeArray({{2, 2}, {2, 2}})));
+  // Only the part of the second box not already masked is added.
+  EXPECT_EQ(7, tester.num_masked_elements());
+  EXPECT_EQ(BoxView({0, 0}, {3, 3}), tester.mask_region());
+  EXPECT_FALSE(tester.mask_array().valid());
+  EXPECT_THAT(tester.mask().boxes,
+              ElementsAre(Box<>({0, 0}, {2, 2}), Box<>({2, 1}, {1, 2}),
+                          Box<>({1, 2}, {1, 1})));
+
+  // A box covering an earlier one replaces it.
+  TENSORSTORE_EXPECT_OK(tester.Write(
+      (tester.transform() | Dims(0, 1).TranslateSizedInterval({0, 0}, {3, 2}))
+          .value(),
+      MakeArray({{3, 3}, {3, 3}, {3, 3}})));
+  EXPECT_EQ(8, tester.num_masked_elements());
+  EXPECT_FALSE(tester.mask_array().valid());
+  EXPECT_EQ(MakeArray({
+                {3, 3, 0, 0},
+                {3, 3, 2, 0},
+                {3, 3, 2, 0},
+                {0, 0, 0, 0},
+            }),
+            tester.dest_array());
+}
+
+TEST(WriteToMaskedArrayTest, ManyBoxesUseMaskArray) {
+  constexpr Index kMaxBoxes = tensorstore::internal::kMaxMaskBoxes;
+  MaskedArrayWriteTester<int> tester{BoxView({0}, {2 * kMaxBoxes + 2})};
+  // Each write adds a separate box, until there are too many.
+  for (Index i = 0; i <= kMaxBoxes; ++i) {
+    TENSORSTORE_EXPECT_OK(tester.Write(
+        (tester.transform() | Dims(0).TranslateSizedInterval(2 * i, 1))
+            .value(),
+        MakeArray({1})));
+    EXPECT_EQ(i == kMaxBoxes, tester.mask_array().valid());
+  }
+  EXPECT_EQ(kMaxBoxes + 1, tester.num_masked_elements());
+  EXPECT_TRUE(tester.mask().boxes.empty());
+  EXPECT_TRUE(tester.mask_array()(0));
+  EXPECT_FALSE(tester.mask_array()(1));
+  EXPECT_TRUE(tester.mask_array()(2 * kMaxBoxes));
+}
+
+TEST(WriteToMaskedArrayTest, BoxSplitIntoManyPiecesUsesMaskArray) {
+  MaskedArrayWriteTester<int> tester{BoxView({0, 0}, {16, 4})};
+  // Disjoint boxes along the first dimension, each overlapping the top edge of
+  // the box written below.
+  for (Index i = 0; i < 8; ++i) {
+    TENSORSTORE_EXPECT_OK(tester.Write(
+        (tester.transform() |
+         Dims(0, 1).TranslateSizedInterval({2 * i, 0}, {1, 2}))
+            .value(),
+        MakeArray({{1, 1}})));
+  }
+  EXPECT_EQ(8, tester.mask().boxes.size());
+  // Subtracting the existing boxes splits this box into too many pieces.
+  auto source = tensorstore::AllocateArray<int>({16, 3});
+  std::fill_n(source.data(), source.num_elements(), 2);
+  TENSORSTORE_EXPECT_OK(tester.Write(
+      (tester.transform() |
+       Dims(0, 1).TranslateSizedInterval({0, 1}, {16, 3}))
+          .value(),
+      source));
+  EXPECT_TRUE(tester.mask_array().valid());
+  EXPECT_TRUE(tester.mask().boxes.empty());
+  EXPECT_EQ(8 + 16 * 3, tester.num_masked_elements());
+  EXPECT_TRUE(tester.mask_array()(0, 0));
+  EXPECT_FALSE(tester.mask_array()(1, 0));
+  EXPECT_TRUE(tester.mask_array()(1, 1));
+  EXPECT_EQ(1, tester.dest_array()(2, 0));
+  EXPECT_EQ(2, tester.dest_array()(2, 1));
+}
+
 TEST(WriteToMaskedArrayTest, RankTwoNonExactContainedInExistingMaskRegion) {
   MaskedArrayWriteTester<int> tester{BoxView({1, 2}, {4, 5})};
   // Copy a rectangular region
@@ -637,6 +717,34 @@ TEST(RebaseMaskedArrayTest, MaskArray) {
             tester.mask_array());
 }
 
+TEST(RebaseMaskedArrayTest, Boxes) {
+  MaskedArrayWriteTester<int> tester{BoxView({1, 2}, {3, 3})};
+  TENSORSTORE_EXPECT_OK(tester.Write(
+      (tester.transform() | Dims(0, 1).TranslateSizedInterval({1, 2}, {1, 2}))
+          .value(),
+      MakeArray({{1, 2}})));
+  TENSORSTORE_EXPECT_OK(tester.Write(
+      (tester.transform() | Dims(0, 1).TranslateSizedInterval({2, 3}, {2, 2}))
+          .value(),
+      MakeArray({{3, 4}, {5, 6}})));
+  EXPECT_EQ(6, tester.num_masked_elements());
+  EXPECT_FALSE(tester.mask_array().valid());
+  EXPECT_EQ(2, tester.mask().boxes.size());
+
+  tester.Rebase(MakeArray({
+      {7, 7, 7},
+      {7, 7, 7},
+      {7, 7, 7},
+  }));
+  EXPECT_EQ(MakeArray({
+                {1, 2, 7},
+                {7, 3, 4},
+                {7, 5, 6},
+            }),
+            tester.dest_array());
+  EXPECT_FALSE(tester.mask_array().valid());
+}
+
 TEST(UnionMasksTest, FirstEmpty) {
   MaskedArrayTester tester{BoxView({1}, {5})};
   MaskedArrayWriteTester<int> tester_b{BoxView({1}, {5})};
@@ -726,7 +834,7 @@ TEST(UnionMasksTest, NoMaskArrayAndNoMaskArrayEqualsNoMaskArray) {
   EXPECT_FALSE(tester.mask_array().valid());
 }
 
-TEST(UnionMasksTest, NoMaskArrayAndNoMaskArrayEqualsMaskArray) {
+TEST(UnionMasksTest, NoMaskArrayAndNoMaskArrayEqualsBoxes) {
   MaskedArrayWriteTester<int> tester{BoxView({1}, {5})};
   MaskedArrayWriteTester<int> tester_b{BoxView({1}, {5})};
 
@@ -740,7 +848,32 @@ TEST(UnionMasksTest, NoMaskArrayAndNoMaskArrayEqualsMaskArray) {
 
   EXPECT_EQ(4, tester.num_masked_elements());
   EXPECT_EQ(BoxView({1}, {5}), tester.mask_region());
-  EXPECT_EQ(MakeArray<bool>({1, 1, 0, 1, 1}), tester.mask_array());
+  EXPECT_FALSE(tester.mask_array().valid());
+  EXPECT_THAT(tester.mask().boxes,
+              ElementsAre(Box<>({1}, {2}), Box<>({4}, {2})));
+}
+
+TEST(UnionMasksTest, BoxesAndMaskArrayEqualsMaskArray) {
+  MaskedArrayWriteTester<int> tester{BoxView({1}, {6})};
+  MaskedArrayWriteTester<int> tester_b{BoxView({1}, {6})};
+
+  TENSORSTORE_EXPECT_OK(tester.Write(
+      (tester.transform() | Dims(0).TranslateSizedInterval(1, 1)).value(),
+      MakeArray({1})));
+  TENSORSTORE_EXPECT_OK(tester.Write(
+      (tester.transform() | Dims(0).TranslateSizedInterval(6, 1)).value(),
+      MakeArray({1})));
+  EXPECT_EQ(2, tester.mask().boxes.size());
+  TENSORSTORE_EXPECT_OK(tester_b.Write(
+      (tester_b.transform() | Dims(0).TranslateSizedInterval(2, 2, 2)).value(),
+      MakeArray({1, 2})));
+  EXPECT_TRUE(tester_b.mask_array().valid());
+  tester.Combine(std::move(tester_b));
+
+  EXPECT_EQ(4, tester.num_masked_elements());
+  EXPECT_EQ(BoxView({1}, {6}), tester.mask_region());
+  EXPECT_EQ(MakeArray<bool>({1, 1, 0, 1, 0, 1}), tester.mask_array());
+  EXPECT_TRUE(tester.mask().boxes.empty());
 }
 
 TEST(UnionMasksTest, MaskArrayAndNoMaskArrayEqualsMaskArray) {
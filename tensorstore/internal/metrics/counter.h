@@ -15,6 +15,7 @@
 #ifndef TENSORSTORE_INTERNAL_METRICS_COUNTER_H_
 #define TENSORSTORE_INTERNAL_METRICS_COUNTER_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <atomic>
@@ -45,11 +46,17 @@ namespace internal_metrics {
 template <typename T>
 class CounterCell;
 
+/// ShardedCounterCell holds a "counter" metric value split over `NumShards`
+/// CounterCells.
+template <typename T, size_t NumShards>
+class ShardedCounterCell;
+
 /// A Counter metric represents a monotonically increasing value.
 /// Do not use a counter to expose a value that can decrease - instead use a
 /// Gauge.
 ///
-/// Counter is parameterized by the type, int64_t or double.
+/// Counter is parameterized by the type, int64_t or double, optionally wrapped
+/// in `Sharded` to reduce contention between threads updating the same Cell.
 /// Each counter has one or more Cells, which are described by Fields...,
 /// which may be int, string, or bool.
 ///
@@ -64,13 +71,20 @@ class CounterCell;
 ///
 template <typename T, typename... Fields>
 class ABSL_CACHELINE_ALIGNED Counter {
-  static_assert(std::is_same_v<T, int64_t> || std::is_same_v<T, double>);
-  using Cell = std::conditional_t<std::is_same_v<T, int64_t>,
-                                  CounterCell<int64_t>, CounterCell<double>>;
+  using Value = typename ShardedTraits<T>::type;
+  static constexpr size_t kNumShards = ShardedTraits<T>::kNumShards;
+  static_assert(std::is_same_v<Value, int64_t> ||
+                std::is_same_v<Value, double>);
+
+ public:
+  using value_type = Value;
+  using Cell = std::conditional_t<kNumShards == 1, CounterCell<Value>,
+                                  ShardedCounterCell<Value, kNumShards>>;
+
+ private:
   using Impl = AbstractMetric<Cell, true, Fields...>;
 
  public:
-  using value_type = T;
 
   static std::unique_ptr<Counter> Allocate(
       std::string_view metric_name,
@@ -216,6 +230,37 @@ class ABSL_CACHELINE_ALIGNED CounterCell<int64_t> : public CounterTag {
   std::atomic<int64_t> value_{0};
 };
 
+template <typename T, size_t NumShards>
+class ShardedCounterCell : public CounterTag {
+ public:
+  using value_type = T;
+  ShardedCounterCell() = default;
+
+  void IncrementBy(T value) {
+    if (value <= 0) return;
+    shards_[GetMetricShard<NumShards>()].IncrementBy(value);
+  }
+
+  void Increment() { IncrementBy(1); }
+
+  T Get() const {
+    T value = 0;
+    for (const auto& shard : shards_) value += shard.Get();
+    return value;
+  }
+
+  void Reset() {
+    for (auto& shard : shards_) shard.Reset();
+  }
+
+  void Combine(ShardedCounterCell& other) const {
+    for (size_t i = 0; i < NumShards; ++i) shards_[i].Combine(other.shards_[i]);
+  }
+
+ private:
+  CounterCell<T> shards_[NumShards];
+};
+
 #else
 template <typename T>
 struct CounterCell {
@@ -225,8 +270,8 @@ struct CounterCell {
 template <typename T, typename... Fields>
 class Counter {
  public:
-  using value_type = T;
-  using Cell = CounterCell<T>;
+  using value_type = typename ShardedTraits<T>::type;
+  using Cell = CounterCell<value_type>;
 
   static Counter& New(
       std::string_view metric_name,
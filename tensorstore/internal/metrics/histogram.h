@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <cassert>
 #include <cmath>
 #include <memory>
 #include <string>
@@ -29,9 +30,11 @@
 #include <utility>
 #include <vector>
 
+#include "absl/base/no_destructor.h"
 #include "absl/base/optimization.h"
 #include "absl/debugging/leak_check.h"
 #include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
 #include "tensorstore/internal/meta/type_traits.h"
 #include "tensorstore/internal/metrics/collect.h"
 #include "tensorstore/internal/metrics/metadata.h"
@@ -80,12 +83,89 @@ struct DefaultBucketer {
   static void SetHistogramLabels(std::vector<std::string_view>& labels);
 };
 
+/// LogLinearBucketer buckets with bounded relative error, similar to
+/// HdrHistogram: each power-of-2 interval [2^e, 2^(e+1)) for
+/// kMinExponent <= e < kMaxExponent is divided into 2^kSubBucketBits buckets
+/// of equal width.
+///  n<0: bucket 0
+///  0<=n<2^kMinExponent: bucket 1
+///  n>=2^kMaxExponent: bucket Max-1
+template <int kMinExponent, int kMaxExponent, int kSubBucketBits>
+struct LogLinearBucketer {
+  static_assert(kMinExponent < kMaxExponent);
+  static_assert(kSubBucketBits >= 0 && kSubBucketBits <= 8);
+
+  /// Name of Bucketer.
+  static constexpr const char kTag[] = "log_linear_histogram";
+
+  static constexpr size_t kSubBuckets = size_t{1} << kSubBucketBits;
+
+  /// Number of buckets.
+  static constexpr size_t Max =
+      3 + static_cast<size_t>(kMaxExponent - kMinExponent) * kSubBuckets;
+  static constexpr size_t UnderflowBucket = 0;
+  static constexpr size_t OverflowBucket = Max - 1;
+
+  /// Mapping from value to bucket in the range [0 .. Max-1].
+  static size_t BucketForValue(double value) {
+    if (!std::isfinite(value)) return UnderflowBucket;
+    if (value < 0) return UnderflowBucket;
+    if (value == 0) return 1;
+    int exp = 0;
+    // value = fraction * 2^exp, where fraction is in [0.5, 1).
+    double fraction = std::frexp(value, &exp);
+    --exp;
+    if (exp < kMinExponent) return 1;
+    if (exp >= kMaxExponent) return OverflowBucket;
+    size_t sub_bucket = static_cast<size_t>((fraction * 2 - 1) * kSubBuckets);
+    return 2 + static_cast<size_t>(exp - kMinExponent) * kSubBuckets +
+           sub_bucket;
+  }
+
+  /// Upper-bound label for the bucket.
+  /// OverflowBucket returns "Inf".
+  static std::string_view LabelForBucket(size_t b) {
+    assert(b < Max);
+    return Labels()[b];
+  }
+
+  // Fills in the labels for the histogram.
+  static void SetHistogramLabels(std::vector<std::string_view>& labels) {
+    const auto& all_labels = Labels();
+    labels.assign(all_labels.begin(), all_labels.end());
+  }
+
+ private:
+  static const std::vector<std::string>& Labels() {
+    static const absl::NoDestructor<std::vector<std::string>> labels([] {
+      std::vector<std::string> labels;
+      labels.reserve(Max);
+      labels.push_back("0");
+      labels.push_back(absl::StrCat(std::ldexp(1.0, kMinExponent)));
+      for (int exp = kMinExponent; exp < kMaxExponent; ++exp) {
+        for (size_t i = 1; i <= kSubBuckets; ++i) {
+          labels.push_back(absl::StrCat(std::ldexp(
+              1.0 + static_cast<double>(i) / kSubBuckets, exp)));
+        }
+      }
+      labels.push_back("Inf");
+      return labels;
+    }());
+    return *labels;
+  }
+};
+
+/// Bucketer for latencies measured in milliseconds, from 1us to ~17min with a
+/// relative error of at most 25%.
+using LatencyBucketer = LogLinearBucketer<-10, 20, 2>;
+
 /// A Histogram metric records a distribution value.
 ///
 /// A Histogram Cell is described by a Bucketer and a set of Fields.
 /// The Bucketer maps a value to one of a fixed set of buckets (as in
-/// DefaultBucketer). The set of Fields... for each Cell may be int, string, or
-/// bool.
+/// DefaultBucketer), and may be wrapped in `Sharded` to reduce contention
+/// between threads updating the same Cell. The set of Fields... for each Cell
+/// may be int, string, or bool.
 ///
 /// Example:
 ///   namespace {
@@ -170,7 +250,7 @@ class ABSL_CACHELINE_ALIGNED Histogram {
           fields));
     });
     if (!result.histograms.empty()) {
-      Bucketer::SetHistogramLabels(result.histogram_labels);
+      Cell::SetHistogramLabels(result.histogram_labels);
     }
     return result;
   }
@@ -286,8 +366,77 @@ class ABSL_CACHELINE_ALIGNED HistogramCell : public Bucketer {
   std::array<std::atomic<int64_t>, Max> buckets_{};
 };
 
+/// HistogramCell which splits observations over `NumShards` HistogramCells.
+template <typename Bucketer, size_t NumShards>
+class HistogramCell<Sharded<Bucketer, NumShards>> : public Bucketer {
+ public:
+  using value_type = double;
+  using count_type = int64_t;
+  using Bucketer::Max;
+
+  HistogramCell() = default;
+
+  void Observe(double value) {
+    shards_[GetMetricShard<NumShards>()].Observe(value);
+  }
+
+  double GetMean() const {
+    int64_t count = 0;
+    double mean = 0;
+    for (const auto& shard : shards_) {
+      int64_t shard_count = shard.GetCount();
+      if (shard_count == 0) continue;
+      count += shard_count;
+      mean += (shard.GetMean() - mean) * shard_count / count;
+    }
+    return mean;
+  }
+
+  int64_t GetCount() const {
+    int64_t count = 0;
+    for (const auto& shard : shards_) count += shard.GetCount();
+    return count;
+  }
+
+  int64_t GetBucket(size_t idx) const {
+    int64_t count = 0;
+    for (const auto& shard : shards_) count += shard.GetBucket(idx);
+    return count;
+  }
+
+  void Reset() {
+    for (auto& shard : shards_) shard.Reset();
+  }
+
+  /// Combines the shards using the parallel variant of Welford's algorithm.
+  CollectedMetric::Histogram Collect(std::vector<std::string> fields) const {
+    CollectedMetric::Histogram result = shards_[0].Collect(std::move(fields));
+    for (size_t i = 1; i < NumShards; ++i) {
+      CollectedMetric::Histogram shard = shards_[i].Collect({});
+      if (shard.count == 0) continue;
+      int64_t count = result.count + shard.count;
+      double delta = shard.mean - result.mean;
+      result.mean += delta * shard.count / count;
+      result.sum_of_squared_deviation +=
+          shard.sum_of_squared_deviation +
+          delta * delta * result.count * shard.count / count;
+      result.count = count;
+      for (size_t b = 0; b < result.buckets.size(); ++b) {
+        result.buckets[b] += shard.buckets[b];
+      }
+    }
+    return result;
+  }
+
+ private:
+  std::array<HistogramCell<Bucketer>, NumShards> shards_;
+};
+
 #else
 struct DefaultBucketer;
+template <int kMinExponent, int kMaxExponent, int kSubBucketBits>
+struct LogLinearBucketer;
+using LatencyBucketer = LogLinearBucketer<-10, 20, 2>;
 template <typename Bucketer>
 struct HistogramCell {
   using value_type = double;
@@ -39,6 +39,40 @@ namespace internal_metrics {
 
 size_t MetricThreadCounter();
 
+/// Selects a metric cell which is sharded over `NumShards` cache lines, where
+/// each thread updates a single shard and the shards are combined when the
+/// metric is read or collected.  This avoids contention on frequently updated
+/// metrics, at the cost of additional memory per cell.
+///
+/// `T` is the counter value type or histogram bucketer, for example:
+///
+///   Counter<Sharded<int64_t>, std::string>
+///   Histogram<Sharded<LatencyBucketer>>
+///
+/// Counters without fields are always sharded.
+template <typename T, size_t NumShards = 4>
+struct Sharded {};
+
+template <typename T>
+struct ShardedTraits {
+  using type = T;
+  static constexpr size_t kNumShards = 1;
+};
+
+template <typename T, size_t NumShards>
+struct ShardedTraits<Sharded<T, NumShards>> {
+  static_assert(NumShards > 0);
+  using type = T;
+  static constexpr size_t kNumShards = NumShards;
+};
+
+/// Returns the shard in `[0, NumShards)` updated by the current thread.
+template <size_t NumShards>
+size_t GetMetricShard() {
+  thread_local size_t id = MetricThreadCounter();
+  return id % NumShards;
+}
+
 // Metrics include an optional set of labels of type {int, string, bool}.
 template <typename K>
 struct FieldTraits;
@@ -275,10 +309,7 @@ class AbstractMetric<Cell, true> : public AbstractMetricBase<0> {
   }
 
  private:
-  size_t get_id() const {
-    thread_local size_t id = MetricThreadCounter() & 3;
-    return id;
-  }
+  size_t get_id() const { return GetMetricShard<4>(); }
 
   Cell cells_[4];
   static_assert(sizeof(cells_) == 4 * ABSL_CACHELINE_SIZE);
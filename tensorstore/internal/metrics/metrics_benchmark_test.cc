@@ -17,9 +17,12 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <string>
+
 #include <benchmark/benchmark.h>
 #include "absl/synchronization/blocking_counter.h"
 #include "tensorstore/internal/metrics/counter.h"
+#include "tensorstore/internal/metrics/histogram.h"
 #include "tensorstore/internal/metrics/metadata.h"
 #include "tensorstore/internal/metrics/registry.h"
 #include "tensorstore/internal/thread/thread_pool.h"
@@ -30,7 +33,10 @@ namespace {
 using ::tensorstore::Executor;
 using ::tensorstore::internal_metrics::Counter;
 using ::tensorstore::internal_metrics::GetMetricRegistry;
+using ::tensorstore::internal_metrics::Histogram;
+using ::tensorstore::internal_metrics::LatencyBucketer;
 using ::tensorstore::internal_metrics::MetricMetadata;
+using ::tensorstore::internal_metrics::Sharded;
 
 Executor SetupThreadPoolTestEnv(size_t num_threads) {
   GetMetricRegistry().Reset();
@@ -80,6 +86,80 @@ BENCHMARK(BM_Metric_Counter)  //
     ->Args({256})             //
     ->UseRealTime();
 
+static auto& benchmark_counter_fields = Counter<int64_t, std::string>::New(
+    "/tensorstore/benchmark/counter_fields", "field",
+    MetricMetadata("A metric"));
+
+static auto& benchmark_sharded_counter_fields =
+    Counter<Sharded<int64_t>, std::string>::New(
+        "/tensorstore/benchmark/sharded_counter_fields", "field",
+        MetricMetadata("A metric"));
+
+static auto& benchmark_histogram = Histogram<LatencyBucketer>::New(
+    "/tensorstore/benchmark/histogram", MetricMetadata("A metric"));
+
+static auto& benchmark_sharded_histogram =
+    Histogram<Sharded<LatencyBucketer>>::New(
+        "/tensorstore/benchmark/sharded_histogram", MetricMetadata("A metric"));
+
+// Updates a single cell of a metric from `state.range(0)` threads; the cell is
+// looked up once per thread.
+template <typename GetCell, typename Update>
+void RunContendedBenchmark(benchmark::State& state, GetCell get_cell,
+                           Update update) {
+  const size_t ops = 16 * 1024 * 1024;
+  const size_t num_threads = state.range(0) ? state.range(0) : 1;
+  const size_t iters = ops / num_threads;
+
+  auto executor = SetupThreadPoolTestEnv(state.range(0));
+
+  for (auto s : state) {
+    absl::BlockingCounter done(num_threads);
+    for (size_t i = 0; i < num_threads; i++) {
+      executor([&done, &get_cell, &update, iters] {
+        auto& cell = get_cell();
+        for (size_t j = 0; j < iters; j++) {
+          update(cell, j);
+        }
+        done.DecrementCount();
+      });
+    }
+    done.Wait();
+  }
+
+  state.SetItemsProcessed(state.iterations() * iters * num_threads);
+}
+
+static void BM_Metric_CounterFields(benchmark::State& state) {
+  RunContendedBenchmark(
+      state, []() -> auto& { return benchmark_counter_fields.GetCell("a"); },
+      [](auto& cell, size_t j) { cell.Increment(); });
+}
+
+static void BM_Metric_ShardedCounterFields(benchmark::State& state) {
+  RunContendedBenchmark(
+      state,
+      []() -> auto& { return benchmark_sharded_counter_fields.GetCell("a"); },
+      [](auto& cell, size_t j) { cell.Increment(); });
+}
+
+static void BM_Metric_Histogram(benchmark::State& state) {
+  RunContendedBenchmark(
+      state, []() -> auto& { return benchmark_histogram.GetCell(); },
+      [](auto& cell, size_t j) { cell.Observe(j & 1023); });
+}
+
+static void BM_Metric_ShardedHistogram(benchmark::State& state) {
+  RunContendedBenchmark(
+      state, []() -> auto& { return benchmark_sharded_histogram.GetCell(); },
+      [](auto& cell, size_t j) { cell.Observe(j & 1023); });
+}
+
+BENCHMARK(BM_Metric_CounterFields)->Args({0})->Args({8})->UseRealTime();
+BENCHMARK(BM_Metric_ShardedCounterFields)->Args({0})->Args({8})->UseRealTime();
+BENCHMARK(BM_Metric_Histogram)->Args({0})->Args({8})->UseRealTime();
+BENCHMARK(BM_Metric_ShardedHistogram)->Args({0})->Args({8})->UseRealTime();
+
 }  // namespace
 
 #endif  // !defined(TENSORSTORE_METRICS_DISABLED)
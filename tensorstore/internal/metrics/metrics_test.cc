@@ -21,6 +21,8 @@
 
 #include <algorithm>
 #include <string>
+#include <string_view>
+#include <thread>  // NOLINT
 #include <variant>
 #include <vector>
 
@@ -41,8 +43,11 @@ using ::tensorstore::internal_metrics::DefaultBucketer;
 using ::tensorstore::internal_metrics::Gauge;
 using ::tensorstore::internal_metrics::GetMetricRegistry;
 using ::tensorstore::internal_metrics::Histogram;
+using ::tensorstore::internal_metrics::LatencyBucketer;
+using ::tensorstore::internal_metrics::LogLinearBucketer;
 using ::tensorstore::internal_metrics::MaxGauge;
 using ::tensorstore::internal_metrics::MetricMetadata;
+using ::tensorstore::internal_metrics::Sharded;
 using ::tensorstore::internal_metrics::Value;
 
 TEST(MetricTest, CounterInt) {
@@ -111,6 +116,37 @@ TEST(MetricTest, CounterIntFields) {
   EXPECT_EQ(2, std::get<int64_t>(metric.values[1].value));
 }
 
+TEST(MetricTest, ShardedCounterFields) {
+  auto& counter = Counter<Sharded<int64_t>, std::string>::New(
+      "/tensorstore/sharded_counter", "field1", MetricMetadata("A metric"));
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back([&] {
+      for (int j = 0; j < 100; ++j) {
+        counter.Increment("a");
+        counter.IncrementBy(2, "b");
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  EXPECT_EQ(800, counter.Get("a"));
+  EXPECT_EQ(1600, counter.Get("b"));
+
+  auto metric = counter.Collect();
+  ASSERT_EQ(2, metric.values.size());
+  std::sort(metric.values.begin(), metric.values.end(),
+            [](auto& a, auto& b) { return a.fields < b.fields; });
+
+  EXPECT_THAT(metric.values[0].fields, ::testing::ElementsAre("a"));
+  EXPECT_EQ(800, std::get<int64_t>(metric.values[0].value));
+  EXPECT_THAT(metric.values[1].fields, ::testing::ElementsAre("b"));
+  EXPECT_EQ(1600, std::get<int64_t>(metric.values[1].value));
+
+  counter.Reset();
+  EXPECT_EQ(0, counter.Get("a"));
+}
+
 TEST(MetricTest, CounterDoubleFields) {
   auto& counter = Counter<double, int>::New("/tensorstore/counter4", "field1",
                                             MetricMetadata("A metric"));
@@ -263,6 +299,33 @@ TEST(MetricTest, DefaultBucketer) {
             DefaultBucketer::LabelForBucket(DefaultBucketer::OverflowBucket));
 }
 
+TEST(MetricTest, LogLinearBucketer) {
+  using Bucketer = LogLinearBucketer<0, 2, 1>;
+  static_assert(Bucketer::Max == 7);
+
+  EXPECT_EQ(Bucketer::UnderflowBucket, Bucketer::BucketForValue(-1));
+  EXPECT_EQ(1, Bucketer::BucketForValue(0));
+  EXPECT_EQ(1, Bucketer::BucketForValue(0.99));
+  EXPECT_EQ(2, Bucketer::BucketForValue(1));
+  EXPECT_EQ(2, Bucketer::BucketForValue(1.49));
+  EXPECT_EQ(3, Bucketer::BucketForValue(1.5));
+  EXPECT_EQ(4, Bucketer::BucketForValue(2));
+  EXPECT_EQ(5, Bucketer::BucketForValue(3));
+  EXPECT_EQ(5, Bucketer::BucketForValue(std::nextafter(4.0, 0)));
+  EXPECT_EQ(Bucketer::OverflowBucket, Bucketer::BucketForValue(4));
+
+  std::vector<std::string_view> labels;
+  Bucketer::SetHistogramLabels(labels);
+  EXPECT_THAT(labels,
+              ::testing::ElementsAre("0", "1", "1.5", "2", "3", "4", "Inf"));
+  EXPECT_EQ("Inf", Bucketer::LabelForBucket(Bucketer::OverflowBucket));
+
+  // Sub-millisecond latencies are distinguished.
+  EXPECT_NE(LatencyBucketer::BucketForValue(0.01),
+            LatencyBucketer::BucketForValue(0.015));
+  EXPECT_EQ(1, LatencyBucketer::BucketForValue(0.0009));
+}
+
 TEST(MetricTest, Histogram) {
   auto& histogram = Histogram<DefaultBucketer>::New("/tensorstore/hist1",
                                                     MetricMetadata("A metric"));
@@ -314,6 +377,32 @@ TEST(MetricTest, HistogramFields) {
   EXPECT_EQ(1, metric.histograms[3].buckets[3]);  // <4
 }
 
+TEST(MetricTest, ShardedHistogram) {
+  auto& histogram = Histogram<Sharded<LogLinearBucketer<0, 2, 1>>>::New(
+      "/tensorstore/sharded_hist", MetricMetadata("A metric"));
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back([&, i] {
+      histogram.Observe(i % 2 ? 1 : 3);
+      histogram.Observe(i % 2 ? 1 : 3);
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  EXPECT_EQ(16, histogram.GetCount());
+  EXPECT_NEAR(2, histogram.GetMean(), 0.001);
+
+  auto metric = histogram.Collect();
+  EXPECT_EQ("log_linear_histogram", metric.tag);
+  EXPECT_EQ(7, metric.histogram_labels.size());
+  ASSERT_EQ(1, metric.histograms.size());
+  EXPECT_EQ(16, metric.histograms[0].count);
+  EXPECT_NEAR(2, metric.histograms[0].mean, 0.001);
+  EXPECT_NEAR(16, metric.histograms[0].sum_of_squared_deviation, 0.001);
+  EXPECT_THAT(metric.histograms[0].buckets,
+              ::testing::ElementsAre(0, 0, 8, 0, 0, 8, 0));
+}
+
 TEST(MetricTest, ValueInt) {
   auto& value =
       Value<int64_t>::New("/tensorstore/value1", MetricMetadata("A metric"));
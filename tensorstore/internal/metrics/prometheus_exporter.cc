@@ -0,0 +1,136 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/metrics/prometheus_exporter.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "absl/base/no_destructor.h"
+#include "absl/log/absl_log.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/env.h"
+#include "tensorstore/internal/global_initializer.h"
+#include "tensorstore/internal/http/default_transport.h"
+#include "tensorstore/internal/http/http_request.h"
+#include "tensorstore/internal/http/http_response.h"
+#include "tensorstore/internal/http/http_transport.h"
+#include "tensorstore/internal/metrics/collect.h"
+#include "tensorstore/internal/metrics/prometheus.h"
+#include "tensorstore/internal/metrics/registry.h"
+#include "tensorstore/internal/thread/schedule_at.h"
+#include "tensorstore/internal/thread/thread_pool.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal_metrics {
+
+std::string FormatPrometheusMetrics(MetricRegistry& registry,
+                                    std::string_view prefix) {
+  std::string body;
+  for (std::string_view name : registry.GetMetricNames(prefix)) {
+    std::optional<CollectedMetric> metric = registry.Collect(name);
+    if (!metric) continue;
+    PrometheusExpositionFormat(*metric, [&](std::string line) {
+      absl::StrAppend(&body, line, "\n");
+    });
+  }
+  return body;
+}
+
+PrometheusPushExporter::PrometheusPushExporter(
+    PrometheusPushExporterOptions options)
+    : options_(std::move(options)),
+      executor_(internal::DetachedThreadPool(1)) {
+  if (!options_.registry) options_.registry = &GetMetricRegistry();
+}
+
+Future<const void> PrometheusPushExporter::Push() {
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto request, BuildPrometheusPushRequest(options_.push_gateway));
+  request.headers.SetHeader("content-type", "text/plain; version=0.0.4");
+  auto body = FormatPrometheusMetrics(*options_.registry, options_.prefix);
+  auto transport = options_.transport;
+  if (!transport) transport = internal_http::GetDefaultHttpTransport();
+  return MapFuture(
+      InlineExecutor{},
+      [](const Result<internal_http::HttpResponse>& response) -> Result<void> {
+        absl::Status status =
+            response.ok() ? internal_http::HttpResponseCodeToStatus(*response)
+                          : response.status();
+        if (!status.ok()) {
+          ABSL_LOG_FIRST_N(WARNING, 10)
+              << "Failed to push metrics to Prometheus: " << status;
+        }
+        return MakeResult(std::move(status));
+      },
+      transport->IssueRequest(
+          request,
+          internal_http::IssueRequestOptions(absl::Cord(std::move(body)))));
+}
+
+void PrometheusPushExporter::Start() { ScheduleNextPush(); }
+
+void PrometheusPushExporter::ScheduleNextPush() {
+  internal::ScheduleAt(
+      absl::Now() + options_.push_interval,
+      [exporter = weak_from_this()] {
+        auto self = exporter.lock();
+        if (!self) return;
+        self->executor_([self] {
+          self->Push().ExecuteWhenReady(
+              [self](ReadyFuture<const void>) { self->ScheduleNextPush(); });
+        });
+      });
+}
+
+TENSORSTORE_GLOBAL_INITIALIZER {
+  auto host = internal::GetEnv("TENSORSTORE_PROMETHEUS_PUSHGATEWAY");
+  if (!host || host->empty()) return;
+  PrometheusPushExporterOptions options;
+  options.push_gateway.host = *std::move(host);
+  options.push_gateway.job = "tensorstore";
+  if (auto job = internal::GetEnv("TENSORSTORE_PROMETHEUS_JOB")) {
+    options.push_gateway.job = *std::move(job);
+  }
+  if (auto instance = internal::GetEnv("TENSORSTORE_PROMETHEUS_INSTANCE")) {
+    options.push_gateway.instance = *std::move(instance);
+  }
+  if (auto interval =
+          internal::GetEnv("TENSORSTORE_PROMETHEUS_PUSH_INTERVAL")) {
+    absl::Duration d;
+    if (absl::ParseDuration(*interval, &d) && d > absl::ZeroDuration()) {
+      options.push_interval = d;
+    } else {
+      ABSL_LOG(WARNING) << "Invalid TENSORSTORE_PROMETHEUS_PUSH_INTERVAL: "
+                        << *interval;
+    }
+  }
+  // Pushes continue for the lifetime of the process.
+  static absl::NoDestructor<std::shared_ptr<PrometheusPushExporter>> exporter(
+      std::make_shared<PrometheusPushExporter>(std::move(options)));
+  (*exporter)->Start();
+}
+
+}  // namespace internal_metrics
+}  // namespace tensorstore
@@ -0,0 +1,96 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_METRICS_PROMETHEUS_EXPORTER_H_
+#define TENSORSTORE_INTERNAL_METRICS_PROMETHEUS_EXPORTER_H_
+
+/// \file
+/// Periodically pushes metrics to a Prometheus push gateway.
+///
+/// If the `TENSORSTORE_PROMETHEUS_PUSHGATEWAY` environment variable is set,
+/// e.g. to `http://localhost:9091`, an exporter to that push gateway is started
+/// at startup.  The following environment variables are also supported:
+///
+/// - `TENSORSTORE_PROMETHEUS_JOB`: job label, defaults to `tensorstore`.
+/// - `TENSORSTORE_PROMETHEUS_INSTANCE`: instance label, defaults to none.
+/// - `TENSORSTORE_PROMETHEUS_PUSH_INTERVAL`: push interval, in the format
+///   accepted by `absl::ParseDuration`, defaults to `60s`.
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "absl/time/time.h"
+#include "tensorstore/internal/http/http_transport.h"
+#include "tensorstore/internal/metrics/prometheus.h"
+#include "tensorstore/internal/metrics/registry.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace internal_metrics {
+
+struct PrometheusPushExporterOptions {
+  PushGatewayConfig push_gateway;
+
+  /// Only metrics with names that begin with this prefix are pushed.
+  std::string prefix = "/tensorstore/";
+
+  /// Interval between pushes started by `Start`.
+  absl::Duration push_interval = absl::Seconds(60);
+
+  /// Registry from which metrics are collected.  If `nullptr`, the global
+  /// registry is used.
+  MetricRegistry* registry = nullptr;
+
+  /// Transport used to push metrics.  If `nullptr`, the default HTTP transport
+  /// is used.
+  std::shared_ptr<internal_http::HttpTransport> transport;
+};
+
+/// Formats the metrics in `registry` with names beginning with `prefix` in the
+/// Prometheus exposition format.
+///
+/// Metrics are collected one at a time, such that the registry lock, and the
+/// lock of each metric, are held only briefly.
+std::string FormatPrometheusMetrics(MetricRegistry& registry,
+                                    std::string_view prefix);
+
+/// Pushes metrics to a Prometheus push gateway.
+class PrometheusPushExporter
+    : public std::enable_shared_from_this<PrometheusPushExporter> {
+ public:
+  explicit PrometheusPushExporter(PrometheusPushExporterOptions options);
+
+  /// Collects and pushes all metrics.  The returned future becomes ready once
+  /// the request completes.
+  Future<const void> Push();
+
+  /// Pushes metrics every `push_interval`, until this object is destroyed.
+  ///
+  /// Collection is performed on a dedicated thread rather than on the thread
+  /// that services timers.
+  void Start();
+
+ private:
+  void ScheduleNextPush();
+
+  PrometheusPushExporterOptions options_;
+  Executor executor_;
+};
+
+}  // namespace internal_metrics
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_METRICS_PROMETHEUS_EXPORTER_H_
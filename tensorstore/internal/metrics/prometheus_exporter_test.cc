@@ -0,0 +1,126 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/metrics/prometheus_exporter.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/cord.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/internal/http/http_request.h"
+#include "tensorstore/internal/http/http_response.h"
+#include "tensorstore/internal/http/http_transport.h"
+#include "tensorstore/internal/http/mock_http_transport.h"
+#include "tensorstore/internal/metrics/counter.h"
+#include "tensorstore/internal/metrics/metadata.h"
+#include "tensorstore/internal/metrics/registry.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::internal_http::HttpRequest;
+using ::tensorstore::internal_http::HttpResponse;
+using ::tensorstore::internal_http::HttpResponseHandler;
+using ::tensorstore::internal_http::IssueRequestOptions;
+using ::tensorstore::internal_metrics::Counter;
+using ::tensorstore::internal_metrics::FormatPrometheusMetrics;
+using ::tensorstore::internal_metrics::MetricMetadata;
+using ::tensorstore::internal_metrics::MetricRegistry;
+using ::tensorstore::internal_metrics::PrometheusPushExporter;
+using ::tensorstore::internal_metrics::PrometheusPushExporterOptions;
+
+/// Records each request and its payload, and responds with `200 OK`.
+class CapturingTransport : public tensorstore::internal_http::HttpTransport {
+ public:
+  struct CapturedRequest {
+    HttpRequest request;
+    std::string payload;
+  };
+
+  void IssueRequestWithHandler(const HttpRequest& request,
+                               IssueRequestOptions options,
+                               HttpResponseHandler* handler) override {
+    {
+      absl::MutexLock lock(&mutex_);
+      requests_.push_back({request, std::string(options.payload)});
+    }
+    tensorstore::internal_http::ApplyResponseToHandler(
+        HttpResponse{200, absl::Cord()}, handler);
+  }
+
+  std::vector<CapturedRequest> requests() {
+    absl::MutexLock lock(&mutex_);
+    return requests_;
+  }
+
+ private:
+  absl::Mutex mutex_;
+  std::vector<CapturedRequest> requests_;
+};
+
+TEST(FormatPrometheusMetricsTest, Basic) {
+  MetricRegistry registry;
+  auto a =
+      Counter<int64_t>::Allocate("/tensorstore/test/a", MetricMetadata("A"));
+  auto b = Counter<int64_t>::Allocate("/other/b", MetricMetadata("B"));
+  registry.Add(a.get());
+  registry.Add(b.get());
+  a->IncrementBy(3);
+  b->Increment();
+  EXPECT_EQ(
+      "# HELP tensorstore_test_a A\n"
+      "tensorstore_test_a 3\n",
+      FormatPrometheusMetrics(registry, "/tensorstore/"));
+}
+
+TEST(PrometheusPushExporterTest, Push) {
+  MetricRegistry registry;
+  auto counter = Counter<int64_t>::Allocate("/tensorstore/test/pushed",
+                                            MetricMetadata("Pushed"));
+  registry.Add(counter.get());
+  counter->Increment();
+
+  auto transport = std::make_shared<CapturingTransport>();
+  PrometheusPushExporterOptions options;
+  options.push_gateway.host = "http://gateway:9091";
+  options.push_gateway.job = "job";
+  options.registry = &registry;
+  options.transport = transport;
+  auto exporter = std::make_shared<PrometheusPushExporter>(options);
+  TENSORSTORE_ASSERT_OK(exporter->Push());
+
+  auto requests = transport->requests();
+  ASSERT_EQ(1, requests.size());
+  EXPECT_EQ("PUT", requests[0].request.method);
+  EXPECT_EQ("http://gateway:9091/metrics/job/job", requests[0].request.url);
+  EXPECT_THAT(requests[0].payload,
+              ::testing::HasSubstr("tensorstore_test_pushed 1\n"));
+}
+
+TEST(PrometheusPushExporterTest, InvalidConfig) {
+  PrometheusPushExporterOptions options;
+  options.push_gateway.host = "gateway";
+  options.push_gateway.job = "job";
+  options.transport = std::make_shared<CapturingTransport>();
+  auto exporter = std::make_shared<PrometheusPushExporter>(options);
+  EXPECT_FALSE(exporter->Push().result().ok());
+}
+
+}  // namespace
@@ -14,6 +14,7 @@
 
 #include "tensorstore/internal/metrics/registry.h"
 
+#include <algorithm>
 #include <cassert>
 #include <memory>
 #include <optional>
@@ -63,6 +64,21 @@ std::vector<CollectedMetric> MetricRegistry::CollectWithPrefix(
   return all;
 }
 
+std::vector<std::string_view> MetricRegistry::GetMetricNames(
+    std::string_view prefix) {
+  std::vector<std::string_view> names;
+  {
+    absl::MutexLock l(&mu_);
+    for (auto& kv : entries_) {
+      if (prefix.empty() || absl::StartsWith(kv.first, prefix)) {
+        names.push_back(kv.first);
+      }
+    }
+  }
+  std::sort(names.begin(), names.end());
+  return names;
+}
+
 std::optional<CollectedMetric> MetricRegistry::Collect(std::string_view name) {
   absl::MutexLock l(&mu_);
   auto it = entries_.find(name);
@@ -89,6 +89,12 @@ class MetricRegistry {
   /// The result is not ordered.
   std::vector<CollectedMetric> CollectWithPrefix(std::string_view prefix);
 
+  /// Returns the sorted names of the metrics that begin with the specified
+  /// prefix.  Combined with `Collect`, this allows metrics to be collected
+  /// incrementally without holding the registry lock for the entire
+  /// collection.  Collect hooks are not invoked.
+  std::vector<std::string_view> GetMetricNames(std::string_view prefix);
+
   // Reset all the metrics in the registry
   void Reset();
 
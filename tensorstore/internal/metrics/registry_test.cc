@@ -50,4 +50,18 @@ TEST(RegistryTest, Arbitrary) {
   EXPECT_EQ(2, all.size());
 }
 
+TEST(RegistryTest, GetMetricNames) {
+  MetricRegistry registry;
+  for (std::string_view name : {"/my/b", "/my/a", "/other/c"}) {
+    registry.AddGeneric(name, [name] {
+      CollectedMetric metric;
+      metric.metric_name = name;
+      return metric;
+    });
+  }
+  EXPECT_EQ((std::vector<std::string_view>{"/my/a", "/my/b"}),
+            registry.GetMetricNames("/my/"));
+  EXPECT_EQ(3, registry.GetMetricNames("").size());
+}
+
 }  // namespace
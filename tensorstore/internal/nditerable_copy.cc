@@ -18,11 +18,17 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <memory>
+#include <optional>
+#include <thread>  // NOLINT
 #include <utility>
+#include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
 #include "tensorstore/data_type.h"
 #include "tensorstore/index.h"
 #include "tensorstore/internal/arena.h"
@@ -31,11 +37,122 @@
 #include "tensorstore/internal/nditerable.h"
 #include "tensorstore/internal/nditerable_buffer_management.h"
 #include "tensorstore/internal/nditerable_util.h"
+#include "tensorstore/rank.h"
+#include "tensorstore/util/executor.h"
 #include "tensorstore/util/iterate.h"
 #include "tensorstore/util/span.h"
 
 namespace tensorstore {
 namespace internal {
+namespace {
+
+// Copies the positions of `iteration_shape` whose index in `partition_dim` is
+// in `[begin, end)`.
+//
+// On failure, leaves `position` at one past the last position copied.
+absl::Status CopyPartition(NDIteratorCopyManager& iterator_copy_manager,
+                           tensorstore::span<const Index> iteration_shape,
+                           IterationBufferShape block_shape,
+                           DimensionIndex partition_dim, Index begin, Index end,
+                           Index* position) {
+  const DimensionIndex rank = iteration_shape.size();
+  Index sub_shape_storage[kMaxRank];
+  std::copy(iteration_shape.begin(), iteration_shape.end(), sub_shape_storage);
+  sub_shape_storage[partition_dim] = end - begin;
+  tensorstore::span<const Index> sub_shape(sub_shape_storage, rank);
+  block_shape[0] = std::min(block_shape[0], sub_shape[rank - 2]);
+  block_shape[1] = std::min(block_shape[1], sub_shape[rank - 1]);
+  std::fill_n(position, rank, static_cast<Index>(0));
+  absl::Status copy_status;
+  const auto copy_block = [&](IterationBufferShape block) {
+    position[partition_dim] += begin;
+    bool ok = iterator_copy_manager.Copy(
+        tensorstore::span<const Index>(position, rank), block, &copy_status);
+    if (ok) position[partition_dim] -= begin;
+    return ok;
+  };
+  if (Index inner_block_size = block_shape[1];
+      inner_block_size != sub_shape.back()) {
+    // Block shape is 1d, need to iterate over all dimensions including
+    // innermost dimension.
+    assert(block_shape[0] == 1);
+    for (Index block_size = inner_block_size; block_size;) {
+      if (!copy_block({1, block_size})) {
+        return GetElementCopyErrorStatus(std::move(copy_status));
+      }
+      block_size = StepBufferPositionForward(sub_shape, block_size,
+                                             inner_block_size, position);
+    }
+  } else {
+    // Block shape is 2d, exclude innermost dimension from iteration.
+    const Index outer_block_size = block_shape[0];
+    for (Index block_size = outer_block_size; block_size;) {
+      if (!copy_block({block_size, inner_block_size})) {
+        return GetElementCopyErrorStatus(std::move(copy_status));
+      }
+      block_size = StepBufferPositionForward(sub_shape.first(rank - 1),
+                                             block_size, outer_block_size,
+                                             position);
+    }
+  }
+  return absl::OkStatus();
+}
+
+// State shared by the threads participating in `NDIterableCopyParallel`.
+//
+// The pointer members refer to objects owned by the calling thread, and are
+// only dereferenced after successfully claiming a partition, which is
+// guaranteed to happen before `NDIterableCopyParallel` returns.
+struct ParallelCopyState {
+  // One iterator copy manager per participating thread.  These are
+  // constructed by the calling thread, since iterators are allocated from the
+  // (non-thread-safe) arena of their iterable.
+  std::optional<NDIteratorCopyManager>* iterator_copy_managers;
+  const Index* iteration_shape;
+  DimensionIndex rank;
+  IterationBufferShape block_shape;
+  DimensionIndex partition_dim;
+  Index num_partitions;
+
+  std::atomic<Index> next_worker{0};
+  std::atomic<Index> next_partition{0};
+  std::atomic<bool> failed{false};
+
+  absl::Mutex mutex;
+  Index num_completed ABSL_GUARDED_BY(mutex) = 0;
+  absl::Status status ABSL_GUARDED_BY(mutex);
+
+  // Claims and copies partitions until none remain.
+  void Run() {
+    const Index worker = next_worker.fetch_add(1, std::memory_order_relaxed);
+    Index position[kMaxRank];
+    while (true) {
+      const Index i = next_partition.fetch_add(1, std::memory_order_relaxed);
+      if (i >= num_partitions) return;
+      absl::Status partition_status;
+      if (!failed.load(std::memory_order_relaxed)) {
+        const Index size = iteration_shape[partition_dim];
+        partition_status = CopyPartition(
+            *iterator_copy_managers[worker],
+            tensorstore::span<const Index>(iteration_shape, rank), block_shape,
+            partition_dim, size * i / num_partitions,
+            size * (i + 1) / num_partitions, position);
+      }
+      absl::MutexLock lock(&mutex);
+      if (!partition_status.ok() && status.ok()) {
+        status = std::move(partition_status);
+        failed.store(true, std::memory_order_relaxed);
+      }
+      ++num_completed;
+    }
+  }
+
+  bool Done() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex) {
+    return num_completed == num_partitions;
+  }
+};
+
+}  // namespace
 
 // Note: `NDIterableCopyManager` has some similarity to
 // `NDIterablesWithManagedBuffers`, but differs in that different
@@ -211,36 +328,85 @@ absl::Status NDIterableCopier::Copy() {
   if (layout_info_.empty) {
     return absl::OkStatus();
   }
-  absl::Status copy_status;
-  if (Index inner_block_size = block_shape_[1];
-      inner_block_size != iteration_shape.back()) {
-    // Block shape is 1d, need to iterate over all dimensions including
-    // innermost dimension.
-    assert(block_shape_[0] == 1);
-    for (Index block_size = inner_block_size; block_size;) {
-      if (!iterator_copy_manager_.Copy(
-              tensorstore::span<const Index>(position_, iteration_shape.size()),
-              {1, block_size}, &copy_status)) {
-        return GetElementCopyErrorStatus(std::move(copy_status));
+  return CopyPartition(iterator_copy_manager_, iteration_shape, block_shape_,
+                       /*partition_dim=*/0, 0, iteration_shape[0], position_);
+}
+
+absl::Status NDIterableCopyParallel(const NDIterable& input,
+                                    const NDIterable& output,
+                                    tensorstore::span<const Index> shape,
+                                    IterationConstraints constraints,
+                                    Arena* arena, const Executor& executor) {
+  NDIterableCopyManager iterable_copy_manager(&input, &output);
+  NDIterationLayoutInfo<> layout_info(iterable_copy_manager, shape,
+                                      constraints);
+  if (layout_info.empty) return absl::OkStatus();
+  tensorstore::span<const Index> iteration_shape = layout_info.iteration_shape;
+  const IterationBufferShape block_shape = GetNDIterationBlockShape(
+      iterable_copy_manager.GetWorkingMemoryBytesPerElement(
+          layout_info.layout_view()),
+      iteration_shape);
+
+  // Partition the outermost dimension with sufficient extent, or else the
+  // dimension with the largest extent.  Note that contiguous dimensions have
+  // been combined, so this is often the innermost dimension.
+  DimensionIndex partition_dim = 0;
+  Index num_partitions = 1;
+  if (executor) {
+    Index num_elements = 1;
+    for (Index size : iteration_shape) num_elements *= size;
+    num_partitions = num_elements * static_cast<Index>(input.dtype()->size) /
+                     kMinParallelCopyBytesPerPartition;
+    for (DimensionIndex i = 0; i < iteration_shape.size(); ++i) {
+      if (iteration_shape[i] > iteration_shape[partition_dim]) {
+        partition_dim = i;
       }
-      block_size = StepBufferPositionForward(iteration_shape, block_size,
-                                             inner_block_size, position_);
-    }
-  } else {
-    // Block shape is 2d, exclude innermost dimension from iteration.
-    const Index outer_block_size = block_shape_[0];
-    for (Index block_size = outer_block_size; block_size;) {
-      if (!iterator_copy_manager_.Copy(
-              tensorstore::span<const Index>(position_, iteration_shape.size()),
-              {block_size, inner_block_size}, &copy_status)) {
-        return GetElementCopyErrorStatus(std::move(copy_status));
+      if (iteration_shape[i] >= num_partitions) {
+        partition_dim = i;
+        break;
       }
-      block_size = StepBufferPositionForward(
-          iteration_shape.first(iteration_shape.size() - 1), block_size,
-          outer_block_size, position_);
     }
+    num_partitions = std::min(num_partitions, iteration_shape[partition_dim]);
   }
-  return absl::OkStatus();
+  if (num_partitions <= 1) {
+    NDIteratorCopyManager iterator_copy_manager(
+        iterable_copy_manager, {layout_info.layout_view(), block_shape},
+        arena);
+    Index position[kMaxRank];
+    return CopyPartition(iterator_copy_manager, iteration_shape, block_shape,
+                         /*partition_dim=*/0, 0, iteration_shape[0], position);
+  }
+
+  // There may be more partitions than threads, which balances the load.
+  const Index num_workers = std::min(
+      num_partitions,
+      std::max(Index(1),
+               static_cast<Index>(std::thread::hardware_concurrency())));
+  std::vector<std::optional<NDIteratorCopyManager>> iterator_copy_managers(
+      num_workers);
+  for (auto& iterator_copy_manager : iterator_copy_managers) {
+    iterator_copy_manager.emplace(
+        iterable_copy_manager,
+        NDIterable::IterationBufferLayoutView{layout_info.layout_view(),
+                                              block_shape},
+        arena);
+  }
+
+  auto state = std::make_shared<ParallelCopyState>();
+  state->iterator_copy_managers = iterator_copy_managers.data();
+  state->iteration_shape = iteration_shape.data();
+  state->rank = iteration_shape.size();
+  state->block_shape = block_shape;
+  state->partition_dim = partition_dim;
+  state->num_partitions = num_partitions;
+  for (Index i = 1; i < num_workers; ++i) {
+    executor([state] { state->Run(); });
+  }
+  state->Run();
+
+  absl::MutexLock lock(
+      &state->mutex, absl::Condition(state.get(), &ParallelCopyState::Done));
+  return state->status;
 }
 
 }  // namespace internal
@@ -19,7 +19,8 @@
 /// Utilities for efficiently copying from one `NDIterable` to another.
 ///
 /// The high-level interface is `NDIterableCopier`, which copies one
-/// `NDIterable` to another in entirety.  The lower-level
+/// `NDIterable` to another in entirety, and `NDIterableCopyParallel`, which
+/// does the same but splits large copies across an executor.  The lower-level
 /// `NDIterableCopyManager` and `NDIteratorCopyManager` classes can be used for
 /// to perform partial copies or for greater control over the iteration order.
 
@@ -35,6 +36,7 @@
 #include "tensorstore/internal/nditerable_buffer_management.h"
 #include "tensorstore/internal/nditerable_util.h"
 #include "tensorstore/rank.h"
+#include "tensorstore/util/executor.h"
 #include "tensorstore/util/iterate.h"
 #include "tensorstore/util/span.h"
 
@@ -220,6 +222,38 @@ struct NDIterableCopier {
   NDIteratorCopyManager iterator_copy_manager_;
 };
 
+/// Minimum number of bytes copied by each partition of
+/// `NDIterableCopyParallel`.  Copies smaller than twice this size are
+/// performed entirely on the calling thread.
+constexpr Index kMinParallelCopyBytesPerPartition = 4 * 1024 * 1024;
+
+/// Copies from `input` to `output`, like `NDIterableCopier::Copy`, but
+/// partitions large copies along one iteration dimension and copies
+/// the partitions concurrently using `executor`.
+///
+/// Partitions are claimed dynamically by the calling thread and by the tasks
+/// submitted to `executor`; the calling thread copies any partition that no
+/// task has claimed, and waits only for the partitions claimed by tasks.
+/// Consequently, the copy completes even if none of the submitted tasks runs,
+/// and it is safe to call this function from a task running on `executor`.
+///
+/// All iterators are obtained on the calling thread, but distinct iterators
+/// obtained from `input` and `output` are then used concurrently.
+///
+/// \param input The input (source) iterable.
+/// \param output The output (destination) iterable.
+/// \param shape The implicitly-associated shape of both `input` and `output`.
+/// \param constraints Constraints on the iteration order.
+/// \param arena Arena to use for memory allocation.  Must be non-null.
+/// \param executor Executor used to copy additional partitions.  If null, the
+///     copy is performed entirely on the calling thread.
+/// \dchecks `input.dtype() == output.dtype()`.
+absl::Status NDIterableCopyParallel(const NDIterable& input,
+                                    const NDIterable& output,
+                                    tensorstore::span<const Index> shape,
+                                    IterationConstraints constraints,
+                                    Arena* arena, const Executor& executor);
+
 }  // namespace internal
 }  // namespace tensorstore
 
@@ -23,6 +23,7 @@
 #include "tensorstore/array.h"
 #include "tensorstore/contiguous_layout.h"
 #include "tensorstore/data_type.h"
+#include "tensorstore/index.h"
 #include "tensorstore/index_space/dim_expression.h"
 #include "tensorstore/index_space/transformed_array.h"
 #include "tensorstore/internal/arena.h"
@@ -30,6 +31,8 @@
 #include "tensorstore/internal/nditerable_array.h"
 #include "tensorstore/internal/nditerable_copy.h"
 #include "tensorstore/internal/nditerable_transformed_array.h"
+#include "tensorstore/internal/thread/thread_pool.h"
+#include "tensorstore/util/executor.h"
 #include "tensorstore/util/result.h"
 #include "tensorstore/util/status.h"
 
@@ -233,4 +236,63 @@ BENCHMARK(BM_Copy<kSimpleRestrict>)->Apply(DefineArgs);
 BENCHMARK(BM_Copy<kSimpleRestrictNoBuiltin>)->Apply(DefineArgs);
 BENCHMARK(BM_Copy<kDataType>)->Apply(DefineArgs);
 
+// Copies a C-order array to a Fortran-order array of the same shape.
+template <typename T>
+void BM_CopyTransposed(benchmark::State& state) {
+  const tensorstore::Index size = state.range(0);
+  auto source_array = tensorstore::AllocateArray<T>(
+      {size, size}, tensorstore::c_order, tensorstore::value_init);
+  auto target_array = tensorstore::AllocateArray<T>(
+      {size, size}, tensorstore::fortran_order, tensorstore::value_init);
+  for (auto s : state) {
+    tensorstore::internal::Arena arena;
+    auto source_iterable = GetArrayNDIterable(source_array, &arena);
+    auto target_iterable = GetArrayNDIterable(target_array, &arena);
+    tensorstore::internal::NDIterableCopier copier(
+        *source_iterable, *target_iterable, source_array.shape(),
+        tensorstore::skip_repeated_elements, &arena);
+    TENSORSTORE_CHECK_OK(copier.Copy());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * size *
+                          size * sizeof(T));
+}
+
+BENCHMARK(BM_CopyTransposed<uint8_t>)->Arg(256)->Arg(2000);
+BENCHMARK(BM_CopyTransposed<uint16_t>)->Arg(256)->Arg(2000);
+BENCHMARK(BM_CopyTransposed<uint32_t>)->Arg(256)->Arg(2000);
+BENCHMARK(BM_CopyTransposed<uint64_t>)->Arg(256)->Arg(2000);
+
+// Copies a 64 MiB array with `NDIterableCopyParallel` using a thread pool with
+// `state.range(0)` threads (or the calling thread only, if 0).
+void BM_CopyParallel(benchmark::State& state) {
+  const int num_threads = state.range(0);
+  const int64_t outer = 256, inner = 256 * 1024;
+  auto source_array = tensorstore::AllocateArray<uint8_t>(
+      {outer, inner}, tensorstore::c_order, tensorstore::value_init);
+  auto target_array = tensorstore::AllocateArray<uint8_t>(
+      {outer, inner}, tensorstore::c_order, tensorstore::value_init);
+  tensorstore::Executor executor;
+  if (num_threads > 0) {
+    executor = tensorstore::internal::DetachedThreadPool(num_threads);
+  }
+  for (auto s : state) {
+    tensorstore::internal::Arena arena;
+    auto source_iterable = GetArrayNDIterable(source_array, &arena);
+    auto target_iterable = GetArrayNDIterable(target_array, &arena);
+    TENSORSTORE_CHECK_OK(tensorstore::internal::NDIterableCopyParallel(
+        *source_iterable, *target_iterable, source_array.shape(),
+        tensorstore::c_order, &arena, executor));
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * outer *
+                          inner);
+}
+
+BENCHMARK(BM_CopyParallel)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
+
 }  // namespace
@@ -19,6 +19,8 @@
 #include <memory>
 #include <new>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -37,8 +39,10 @@
 #include "tensorstore/internal/nditerable_elementwise_output_transform.h"
 #include "tensorstore/internal/nditerable_transformed_array.h"
 #include "tensorstore/internal/nditerable_util.h"
+#include "tensorstore/internal/thread/thread_pool.h"
 #include "tensorstore/rank.h"
 #include "tensorstore/util/element_pointer.h"
+#include "tensorstore/util/executor.h"
 #include "tensorstore/util/iterate.h"
 #include "tensorstore/util/result.h"
 #include "tensorstore/util/span.h"
@@ -216,4 +220,88 @@ TEST_P(MaybeUnitBlockSizeTest, InnerIndexArray) {
   EXPECT_EQ(expected, dest);
 }
 
+// Parallel copy of a transposed array large enough to be partitioned.
+void TestCopyParallel(const tensorstore::Executor& executor) {
+  auto source = tensorstore::AllocateArray<int32_t>({512, 8, 1024});
+  for (Index i = 0; i < source.num_elements(); ++i) {
+    source.data()[i] = static_cast<int32_t>(i);
+  }
+  auto dest = tensorstore::AllocateArray<int32_t>(
+      {1024, 8, 512}, tensorstore::c_order, tensorstore::value_init);
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      tensorstore::TransformedArray<Shared<int32_t>> tdest,
+      dest | tensorstore::Dims(2, 1, 0).Transpose());
+
+  tensorstore::internal::Arena arena;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto source_iterable, GetTransformedArrayNDIterable(source, &arena));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto dest_iterable, GetTransformedArrayNDIterable(tdest, &arena));
+  TENSORSTORE_ASSERT_OK(tensorstore::internal::NDIterableCopyParallel(
+      *source_iterable, *dest_iterable, source.shape(),
+      tensorstore::skip_repeated_elements, &arena, executor));
+  for (Index i = 0; i < 512; ++i) {
+    for (Index j = 0; j < 8; ++j) {
+      for (Index k = 0; k < 1024; ++k) {
+        ASSERT_EQ(source(i, j, k), dest(k, j, i))
+            << i << ", " << j << ", " << k;
+      }
+    }
+  }
+}
+
+TEST(NDIterableCopyParallelTest, ThreadPool) {
+  TestCopyParallel(tensorstore::internal::DetachedThreadPool(4));
+}
+
+TEST(NDIterableCopyParallelTest, InlineExecutor) {
+  TestCopyParallel(tensorstore::InlineExecutor{});
+}
+
+TEST(NDIterableCopyParallelTest, NullExecutor) {
+  TestCopyParallel(tensorstore::Executor{});
+}
+
+// Tasks that never run do not prevent the copy from completing.
+TEST(NDIterableCopyParallelTest, TasksNotRun) {
+  std::vector<tensorstore::ExecutorTask> tasks;
+  TestCopyParallel([&](tensorstore::ExecutorTask task) {
+    tasks.push_back(std::move(task));
+  });
+  for (auto& task : tasks) std::move(task)();
+}
+
+TEST(NDIterableCopyParallelTest, Error) {
+  auto source = tensorstore::AllocateArray<int>({1024, 4096});
+  for (Index i = 0; i < source.num_elements(); ++i) {
+    source.data()[i] = static_cast<int>(i);
+  }
+  auto dest = tensorstore::AllocateArray<int>(
+      {1024, 4096}, tensorstore::c_order, tensorstore::value_init);
+  auto dest_element_transform = [](const int* source, int* dest, void* arg) {
+    auto* status = static_cast<absl::Status*>(arg);
+    if (*source == 3000000) {
+      *status = absl::UnknownError("3000000");
+      return false;
+    }
+    *dest = *source;
+    return true;
+  };
+  tensorstore::internal::ElementwiseClosure<2, void*> dest_closure =
+      tensorstore::internal::SimpleElementwiseFunction<
+          decltype(dest_element_transform)(const int, int),
+          void*>::Closure(&dest_element_transform);
+
+  tensorstore::internal::Arena arena;
+  auto source_iterable = GetTransformedArrayNDIterable(source, &arena).value();
+  auto dest_iterable = GetElementwiseOutputTransformNDIterable(
+      GetTransformedArrayNDIterable(dest, &arena).value(), dtype_v<int>,
+      dest_closure, &arena);
+  EXPECT_EQ(absl::UnknownError("3000000"),
+            tensorstore::internal::NDIterableCopyParallel(
+                *source_iterable, *dest_iterable, dest.shape(),
+                tensorstore::c_order, &arena,
+                tensorstore::internal::DetachedThreadPool(4)));
+}
+
 }  // namespace
@@ -95,6 +95,36 @@ INSTANTIATE_TEST_SUITE_P(GetConvertedOutputNDIterable,
                          NDIterableDataTypeConversionTest,
                          ::testing::Values(false));
 
+// The conversion is applied as part of the copy, directly between the source
+// and target arrays, without an intermediate buffer.
+TEST_P(NDIterableDataTypeConversionTest, NoIntermediateBuffer) {
+  tensorstore::internal::Arena arena;
+  auto source = MakeArray<uint16_t>({{1, 2, 3}, {4, 5, 6}});
+  auto target = tensorstore::AllocateArray<float>(source.shape());
+  auto source_iterable =
+      tensorstore::internal::GetArrayNDIterable(source, &arena);
+  auto target_iterable =
+      tensorstore::internal::GetArrayNDIterable(target, &arena);
+  auto converter =
+      GetDataTypeConverter(dtype_v<uint16_t>, dtype_v<float>);
+  if (GetParam()) {
+    source_iterable = GetConvertedInputNDIterable(
+        std::move(source_iterable), dtype_v<float>, converter);
+  } else {
+    target_iterable = GetConvertedOutputNDIterable(
+        std::move(target_iterable), dtype_v<uint16_t>, converter);
+  }
+  tensorstore::internal::NDIterableCopier copier(
+      *source_iterable, *target_iterable, target.shape(), tensorstore::c_order,
+      &arena);
+  tensorstore::internal::NDIterableCopyManager copy_manager(
+      source_iterable.get(), target_iterable.get());
+  EXPECT_EQ(0, copy_manager.GetWorkingMemoryBytesPerElement(
+                   copier.layout_info().layout_view()));
+  TENSORSTORE_EXPECT_OK(copier.Copy());
+  EXPECT_EQ(MakeArray<float>({{1, 2, 3}, {4, 5, 6}}), target);
+}
+
 TEST_P(NDIterableDataTypeConversionTest, Int32ToInt32) {
   EXPECT_THAT(Convert(MakeArray<int32_t>({1, 2, 3}), dtype_v<int32_t>),
               Pair(absl::OkStatus(), MakeArray<int32_t>({1, 2, 3})));
@@ -439,6 +439,12 @@ class IterableImpl : public NDIterable::Base<IterableImpl> {
 
 Result<NDIterable::Ptr> MaybeConvertToArrayNDIterable(
     std::unique_ptr<IterableImpl, VirtualDestroyDeleter> impl, Arena* arena) {
+  // Index arrays that are arithmetic progressions (e.g. the result of
+  // indexing by a range) are equivalent to strided maps, and may permit
+  // conversion to a strided array below.
+  internal_index_space::ConvertArithmeticProgressionIndexArrays(
+      impl->transform_.input_rank(), impl->transform_.input_shape().data(),
+      &impl->state_, impl->input_dimension_flags_.data());
   if (impl->state_.num_array_indexed_output_dimensions == 0) {
     return GetArrayNDIterable(
         SharedOffsetArrayView<const void>(
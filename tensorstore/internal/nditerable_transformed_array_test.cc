@@ -286,15 +286,16 @@ TEST(NDIterableTransformedArrayTest,
 TEST(NDIterableTransformedArrayTest,
      TwoStridedOneIndexedDimensionIndexedBuffer) {
   Arena arena;
-  auto a = AllocateArray<int>({2, 3, 2});
+  auto a = AllocateArray<int>({3, 3, 2});
   auto ta = (a | tensorstore::Dims(1).OuterIndexArraySlice(
                      MakeArray<Index>({0, 2, 1, 1})))
                 .value();
-  auto tb =
-      (a | tensorstore::Dims(0).OuterIndexArraySlice(MakeArray<Index>({0, 1})) |
-       tensorstore::Dims(1).OuterIndexArraySlice(
-           MakeArray<Index>({0, 2, 1, 1})))
-          .value();
+  auto tb = (a |
+             tensorstore::Dims(0).OuterIndexArraySlice(
+                 MakeArray<Index>({0, 2, 1})) |
+             tensorstore::Dims(1).OuterIndexArraySlice(
+                 MakeArray<Index>({0, 2, 1, 1})))
+                .value();
 
   auto iterable1 = GetTransformedArrayNDIterable(ta, &arena).value();
   auto iterable2 = GetTransformedArrayNDIterable(tb, &arena).value();
@@ -302,18 +303,59 @@ TEST(NDIterableTransformedArrayTest,
       ta.shape(), skip_repeated_elements, {{iterable1.get(), iterable2.get()}},
       &arena);
   EXPECT_THAT(multi_iterator.iteration_dimensions, ElementsAre(1, 0, 2));
-  EXPECT_THAT(multi_iterator.iteration_shape, ElementsAre(4, 2, 2));
+  EXPECT_THAT(multi_iterator.iteration_shape, ElementsAre(4, 3, 2));
   EXPECT_EQ(IterationBufferKind::kIndexed, multi_iterator.buffer_kind);
-  auto element_matcher = ElementsAreArray(  //
-      {
-          &a(0, 0, 0), &a(0, 0, 1), &a(1, 0, 0), &a(1, 0, 1),  //
-          &a(0, 2, 0), &a(0, 2, 1), &a(1, 2, 0), &a(1, 2, 1),  //
-          &a(0, 1, 0), &a(0, 1, 1), &a(1, 1, 0), &a(1, 1, 1),  //
-          &a(0, 1, 0), &a(0, 1, 1), &a(1, 1, 0), &a(1, 1, 1)   //
-      });
+  const Index dim0_indices[] = {0, 2, 1};
+  IterationTrace expected_a, expected_b;
+  for (Index j : {0, 2, 1, 1}) {
+    for (Index i = 0; i < 3; ++i) {
+      for (Index k = 0; k < 2; ++k) {
+        expected_a.push_back(&a(i, j, k));
+        expected_b.push_back(&a(dim0_indices[i], j, k));
+      }
+    }
+  }
   EXPECT_THAT(
       (GetIterationTrace<int, int>(&multi_iterator)),
-      Pair(ElementsAre(element_matcher, element_matcher), absl::OkStatus()));
+      Pair(ElementsAre(ElementsAreArray(expected_a),
+                       ElementsAreArray(expected_b)),
+           absl::OkStatus()));
+}
+
+// Tests that an index array whose values form an arithmetic progression is
+// iterated as a strided dimension.
+TEST(NDIterableTransformedArrayTest, ArithmeticProgressionIndexArray) {
+  Arena arena;
+  auto a = AllocateArray<int>({2, 7});
+  auto ta = (a | tensorstore::Dims(1).OuterIndexArraySlice(
+                     MakeArray<Index>({5, 3, 1})))
+                .value();
+
+  auto iterable = GetTransformedArrayNDIterable(ta, &arena).value();
+  MultiNDIterator<1, /*Full=*/true> multi_iterator(
+      ta.shape(), skip_repeated_elements, {{iterable.get()}}, &arena);
+  EXPECT_THAT(multi_iterator.iteration_dimensions, ElementsAre(0, 1));
+  EXPECT_THAT(multi_iterator.directions, ElementsAre(1, -1));
+  EXPECT_EQ(IterationBufferKind::kStrided, multi_iterator.buffer_kind);
+  EXPECT_THAT(GetIterationTrace<int>(&multi_iterator),
+              Pair(ElementsAre(ElementsAre(&a(0, 1), &a(0, 3), &a(0, 5),
+                                           &a(1, 1), &a(1, 3), &a(1, 5))),
+                   absl::OkStatus()));
+}
+
+// Tests that an index array that depends on more than one input dimension is
+// iterated as an index array.
+TEST(NDIterableTransformedArrayTest, TwoDimensionalIndexArrayNotConverted) {
+  Arena arena;
+  auto a = AllocateArray<int>({2, 6});
+  auto ta = (a | tensorstore::Dims(1).OuterIndexArraySlice(
+                     MakeArray<Index>({{0, 1, 2}, {3, 4, 5}})))
+                .value();
+
+  auto iterable = GetTransformedArrayNDIterable(ta, &arena).value();
+  MultiNDIterator<1, /*Full=*/true> multi_iterator(
+      ta.shape(), skip_repeated_elements, {{iterable.get()}}, &arena);
+  EXPECT_EQ(IterationBufferKind::kIndexed, multi_iterator.buffer_kind);
 }
 
 // Test the case of an array with both an index array input dimension and a
@@ -409,12 +451,12 @@ TEST(NDIterableTransformedArrayTest, IndexedCombineBothReversed) {
 // dimension to come first.
 TEST(NDIterableTransformedArrayTest, IndexedVsStrided) {
   Arena arena;
-  auto a = AllocateArray<int>({2, 2});
-  auto b = AllocateArray<int>({2, 3});
+  auto a = AllocateArray<int>({2, 3});
+  auto b = AllocateArray<int>({2, 4});
 
-  auto tb =
-      (b | tensorstore::Dims(1).OuterIndexArraySlice(MakeArray<Index>({0, 2})))
-          .value();
+  auto tb = (b | tensorstore::Dims(1).OuterIndexArraySlice(
+                     MakeArray<Index>({0, 3, 1})))
+                .value();
 
   auto iterable_a = GetTransformedArrayNDIterable(a, &arena).value();
   auto iterable_b = GetTransformedArrayNDIterable(tb, &arena).value();
@@ -424,8 +466,10 @@ TEST(NDIterableTransformedArrayTest, IndexedVsStrided) {
   EXPECT_THAT(multi_iterator.iteration_dimensions, ElementsAre(1, 0));
   EXPECT_THAT(
       (GetIterationTrace<int, int>(&multi_iterator)),
-      Pair(ElementsAre(ElementsAre(&a(0, 0), &a(1, 0), &a(0, 1), &a(1, 1)),
-                       ElementsAre(&b(0, 0), &b(1, 0), &b(0, 2), &b(1, 2))),
+      Pair(ElementsAre(ElementsAre(&a(0, 0), &a(1, 0), &a(0, 1), &a(1, 1),
+                                   &a(0, 2), &a(1, 2)),
+                       ElementsAre(&b(0, 0), &b(1, 0), &b(0, 3), &b(1, 3),
+                                   &b(0, 1), &b(1, 1))),
            absl::OkStatus()));
 }
 
@@ -717,10 +761,11 @@ TEST(NDIterableTransformedArrayTest, BlockTraceThreeStridedDimensions) {
 TEST(NDIterableTransformedArrayTest,
      InnermostBlockSizeLessThanInnermostIterationSize) {
   Arena arena;
-  auto a = AllocateArray<int>({2, 32768}, tensorstore::c_order,
+  auto a = AllocateArray<int>({3, 32768}, tensorstore::c_order,
                               tensorstore::value_init);
-  auto ta = (a | tensorstore::Dims(0).IndexArraySlice(MakeArray<Index>({0, 1})))
-                .value();
+  auto ta =
+      (a | tensorstore::Dims(0).IndexArraySlice(MakeArray<Index>({0, 2, 1})))
+          .value();
   auto iterable = GetTransformedArrayNDIterable(ta, &arena).value();
 
   struct IncrementValue {
@@ -15,6 +15,7 @@
 #ifndef TENSORSTORE_INTERNAL_OAUTH2_AUTH_PROVIDER_H_
 #define TENSORSTORE_INTERNAL_OAUTH2_AUTH_PROVIDER_H_
 
+#include <memory>
 #include <string>
 
 #include "absl/time/time.h"
@@ -24,7 +25,7 @@
 namespace tensorstore {
 namespace internal_oauth2 {
 
-class AuthProvider {
+class AuthProvider : public std::enable_shared_from_this<AuthProvider> {
  public:
   virtual ~AuthProvider();
 
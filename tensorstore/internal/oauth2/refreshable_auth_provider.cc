@@ -15,12 +15,15 @@
 #include "tensorstore/internal/oauth2/refreshable_auth_provider.h"
 
 #include <functional>
+#include <memory>
 #include <utility>
 
 #include "absl/synchronization/mutex.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
+#include "tensorstore/internal/oauth2/auth_provider.h"
 #include "tensorstore/internal/oauth2/bearer_token.h"
+#include "tensorstore/internal/thread/thread.h"
 #include "tensorstore/util/result.h"
 
 namespace tensorstore {
@@ -31,17 +34,70 @@ RefreshableAuthProvider::RefreshableAuthProvider(
     : clock_(clock ? std::move(clock) : &absl::Now) {}
 
 Result<BearerTokenWithExpiration> RefreshableAuthProvider::GetToken() {
-  absl::MutexLock lock(&mutex_);
-  if (IsValidInternal()) {
-    return token_;
+  {
+    absl::MutexLock lock(&mutex_);
+    if (IsValidInternal()) {
+      MaybeStartBackgroundRefreshInternal();
+      return token_;
+    }
   }
 
+  absl::MutexLock refresh_lock(&refresh_mutex_);
+  {
+    // Another thread may have refreshed the token while waiting.
+    absl::MutexLock lock(&mutex_);
+    if (IsValidInternal()) return token_;
+  }
   auto token_result = Refresh();
   if (token_result.ok()) {
+    absl::MutexLock lock(&mutex_);
     token_ = token_result.value();
   }
   return token_result;
 }
 
+bool RefreshableAuthProvider::ShouldRefreshInBackgroundInternal() {
+  const absl::Time now = clock_();
+  return now >= token_.expiration - kBackgroundRefreshMargin &&
+         now >= next_background_refresh_;
+}
+
+void RefreshableAuthProvider::MaybeStartBackgroundRefreshInternal() {
+  if (background_refresh_in_progress_ || !ShouldRefreshInBackgroundInternal()) {
+    return;
+  }
+  // The background thread keeps the provider alive.
+  std::shared_ptr<AuthProvider> self = weak_from_this().lock();
+  if (!self) return;
+  background_refresh_in_progress_ = true;
+  internal::Thread::StartDetached(
+      {"tensorstore_auth_refresh"}, [self = std::move(self)] {
+        static_cast<RefreshableAuthProvider*>(self.get())->BackgroundRefresh();
+      });
+}
+
+void RefreshableAuthProvider::BackgroundRefresh() {
+  absl::MutexLock refresh_lock(&refresh_mutex_);
+  {
+    // A synchronous refresh may have already replaced the token.
+    absl::MutexLock lock(&mutex_);
+    if (!ShouldRefreshInBackgroundInternal()) {
+      background_refresh_in_progress_ = false;
+      return;
+    }
+  }
+  auto token_result = Refresh();
+  absl::MutexLock lock(&mutex_);
+  background_refresh_in_progress_ = false;
+  if (token_result.ok() && token_result->expiration > token_.expiration) {
+    token_ = *std::move(token_result);
+    return;
+  }
+  // Continue to use the current token, which remains valid, and retry later.
+  // The refresh may return the same token if the issuer has not yet rotated
+  // it.
+  next_background_refresh_ = clock_() + kBackgroundRefreshRetryInterval;
+}
+
 }  // namespace internal_oauth2
 }  // namespace tensorstore
@@ -28,15 +28,30 @@ namespace tensorstore {
 namespace internal_oauth2 {
 
 /// Base class for auth providers that support refreshing.
+///
+/// Once the token is within `kBackgroundRefreshMargin` of expiring, it is
+/// refreshed on a background thread while `GetToken` continues to return the
+/// still-valid token.  Background refresh requires that the provider is owned
+/// by a `std::shared_ptr`; otherwise, the token is only refreshed
+/// synchronously once it expires.
 class RefreshableAuthProvider : public AuthProvider {
  public:
+  /// Duration before expiration at which the token is refreshed in the
+  /// background.
+  static constexpr absl::Duration kBackgroundRefreshMargin = absl::Minutes(5);
+
+  /// Minimum interval between background refresh attempts, if a refresh fails
+  /// or does not extend the expiration time.
+  static constexpr absl::Duration kBackgroundRefreshRetryInterval =
+      absl::Seconds(10);
+
   explicit RefreshableAuthProvider(std::function<absl::Time()> clock = {});
 
   /// Returns the short-term authentication bearer token.
   ///
   /// Safe for concurrent use by multiple threads.
   Result<BearerTokenWithExpiration> GetToken()
-      ABSL_LOCKS_EXCLUDED(mutex_) override;
+      ABSL_LOCKS_EXCLUDED(mutex_, refresh_mutex_) override;
 
   /// Checks if the token is valid.
   bool IsValid() ABSL_LOCKS_EXCLUDED(mutex_) {
@@ -52,9 +67,9 @@ class RefreshableAuthProvider : public AuthProvider {
 
  protected:
   // Generate a new BearerTokenWithExpiration.
-  // Guaranteed to be called under lock.
+  // Guaranteed to be called under lock; calls are never concurrent.
   virtual Result<BearerTokenWithExpiration> Refresh()
-      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) = 0;
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(refresh_mutex_) = 0;
 
   bool IsExpiredInternal() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
     return clock_() > (token_.expiration - kExpirationMargin);
@@ -67,11 +82,23 @@ class RefreshableAuthProvider : public AuthProvider {
   absl::Time GetCurrentTime() { return clock_(); }
 
  private:
+  bool ShouldRefreshInBackgroundInternal()
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void MaybeStartBackgroundRefreshInternal()
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void BackgroundRefresh() ABSL_LOCKS_EXCLUDED(mutex_, refresh_mutex_);
+
   std::function<absl::Time()> clock_;  // mock time.
 
+  // Serializes calls to `Refresh`, such that `mutex_` need not be held while
+  // refreshing.
+  absl::Mutex refresh_mutex_ ABSL_ACQUIRED_BEFORE(mutex_);
   absl::Mutex mutex_;
   BearerTokenWithExpiration token_ ABSL_GUARDED_BY(mutex_) = {
       {}, absl::InfinitePast()};
+  bool background_refresh_in_progress_ ABSL_GUARDED_BY(mutex_) = false;
+  absl::Time next_background_refresh_ ABSL_GUARDED_BY(mutex_) =
+      absl::InfinitePast();
 };
 
 }  // namespace internal_oauth2
@@ -0,0 +1,108 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/oauth2/refreshable_auth_provider.h"
+
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/oauth2/bearer_token.h"
+#include "tensorstore/util/result.h"
+
+namespace {
+
+using ::tensorstore::Result;
+using ::tensorstore::internal_oauth2::BearerTokenWithExpiration;
+using ::tensorstore::internal_oauth2::RefreshableAuthProvider;
+
+class TestAuthProvider : public RefreshableAuthProvider {
+ public:
+  TestAuthProvider()
+      : RefreshableAuthProvider([this] { return GetTime(); }),
+        time_(absl::Now()) {}
+
+  absl::Time GetTime() {
+    absl::MutexLock lock(&mutex_);
+    return time_;
+  }
+
+  void AdvanceTime(absl::Duration duration) {
+    absl::MutexLock lock(&mutex_);
+    time_ += duration;
+  }
+
+  int num_refreshes() {
+    absl::MutexLock lock(&mutex_);
+    return num_refreshes_;
+  }
+
+  std::string GetTokenString() {
+    auto result = GetToken();
+    EXPECT_TRUE(result.ok()) << result.status();
+    return result.ok() ? result->token : std::string();
+  }
+
+ protected:
+  Result<BearerTokenWithExpiration> Refresh() override {
+    absl::MutexLock lock(&mutex_);
+    ++num_refreshes_;
+    return BearerTokenWithExpiration{absl::StrCat("token", num_refreshes_),
+                                     time_ + absl::Hours(1)};
+  }
+
+ private:
+  absl::Mutex mutex_;
+  absl::Time time_ ABSL_GUARDED_BY(mutex_);
+  int num_refreshes_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+TEST(RefreshableAuthProviderTest, RefreshesInBackgroundBeforeExpiration) {
+  auto auth = std::make_shared<TestAuthProvider>();
+  EXPECT_EQ("token1", auth->GetTokenString());
+  EXPECT_EQ("token1", auth->GetTokenString());
+  EXPECT_EQ(1, auth->num_refreshes());
+
+  // Within the background refresh margin, the current token is returned while
+  // a new token is obtained in the background.
+  auth->AdvanceTime(absl::Hours(1) -
+                    RefreshableAuthProvider::kBackgroundRefreshMargin);
+  EXPECT_EQ("token1", auth->GetTokenString());
+  for (int i = 0; i < 10000 && auth->GetTokenString() != "token2"; ++i) {
+    absl::SleepFor(absl::Milliseconds(1));
+  }
+  EXPECT_EQ("token2", auth->GetTokenString());
+  EXPECT_EQ(2, auth->num_refreshes());
+}
+
+TEST(RefreshableAuthProviderTest, RefreshesSynchronouslyWithoutSharedOwner) {
+  TestAuthProvider auth;
+  EXPECT_EQ("token1", auth.GetTokenString());
+
+  auth.AdvanceTime(absl::Hours(1) -
+                   RefreshableAuthProvider::kBackgroundRefreshMargin);
+  EXPECT_EQ("token1", auth.GetTokenString());
+  EXPECT_EQ(1, auth.num_refreshes());
+
+  auth.AdvanceTime(RefreshableAuthProvider::kBackgroundRefreshMargin);
+  EXPECT_EQ("token2", auth.GetTokenString());
+  EXPECT_EQ(2, auth.num_refreshes());
+}
+
+}  // namespace
@@ -23,6 +23,7 @@
 
 #include "absl/functional/function_ref.h"
 #include "absl/status/status.h"
+#include "tensorstore/util/executor.h"
 
 namespace tensorstore {
 namespace internal_os {
@@ -65,6 +66,27 @@ absl::Status RecursiveFileList(
     absl::FunctionRef<bool(std::string_view)> recurse_into,
     absl::FunctionRef<absl::Status(ListerEntry)> on_item);
 
+/// Iterates over the non-directory entries within `root_directory`, listing
+/// separate subdirectories concurrently.
+///
+/// Directories are listed by the calling thread and by up to `parallelism - 1`
+/// additional tasks submitted to `executor`.  Since the calling thread lists
+/// any directories not claimed by another task, this completes even if no
+/// task submitted to `executor` runs before it returns.
+///
+/// `recurse_into` is called for each directory, including `root_directory`,
+/// before it is listed; it is not listed if `recurse_into` returns `false`.
+///
+/// `on_item` is called for each non-directory entry, in no particular order.
+///
+/// Both `recurse_into` and `on_item` may be called concurrently from multiple
+/// threads, but no calls are made after this returns.  If `on_item` returns an
+/// error, no further calls are started and that error is returned.
+absl::Status ParallelFileList(
+    std::string root_directory, const Executor& executor, size_t parallelism,
+    absl::FunctionRef<bool(std::string_view)> recurse_into,
+    absl::FunctionRef<absl::Status(ListerEntry)> on_item);
+
 }  // namespace internal_os
 }  // namespace tensorstore
 
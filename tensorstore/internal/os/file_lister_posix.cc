@@ -26,23 +26,34 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cerrno>
 #include <cstring>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/functional/function_ref.h"
 #include "absl/status/status.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
 #include "tensorstore/internal/os/error_code.h"
 #include "tensorstore/internal/os/potentially_blocking_region.h"
+#include "tensorstore/util/executor.h"
 #include "tensorstore/util/quote_string.h"
 #include "tensorstore/util/status.h"
 
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 // Include system headers last to reduce impact of macros.
 #include "tensorstore/internal/os/file_util.h"
 
@@ -233,5 +244,276 @@ absl::Status RecursiveFileList(
   return status;
 }
 
+namespace {
+
+// Size of the buffer into which each thread reads directory entries.  Large
+// directories are read with few system calls.
+constexpr size_t kDirectoryBufferSize = 256 * 1024;
+
+std::string JoinPath(std::string_view path, std::string_view component) {
+  return absl::StrCat(
+      path, (path.empty() || absl::EndsWith(path, "/")) ? "" : "/", component);
+}
+
+#if defined(__linux__)
+// Record layout returned by the `getdents64` system call.
+struct LinuxDirent64 {
+  uint64_t d_ino;
+  int64_t d_off;
+  unsigned short d_reclen;
+  unsigned char d_type;
+  char d_name[];
+};
+#endif
+
+// Calls `callback` with the NUL-terminated name and `d_type` of each entry of
+// the open directory `fd`, other than "." and "..".
+absl::Status ReadDirectory(
+    int fd, const std::string& path, char* buffer,
+    absl::FunctionRef<absl::Status(const char*, unsigned char)> callback) {
+#if defined(__linux__)
+  while (true) {
+    long n;
+    {
+      PotentiallyBlockingRegion region;
+      n = ::syscall(SYS_getdents64, fd, buffer, kDirectoryBufferSize);
+    }
+    if (n == -1) {
+      if (errno == EINTR) continue;
+      return StatusFromOsError(errno,
+                               "Failed while listing: ", QuoteString(path));
+    }
+    if (n == 0) return absl::OkStatus();
+    for (long pos = 0; pos < n;) {
+      const auto* e = reinterpret_cast<const LinuxDirent64*>(buffer + pos);
+      pos += e->d_reclen;
+      if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0) {
+        continue;
+      }
+      TENSORSTORE_RETURN_IF_ERROR(callback(e->d_name, e->d_type));
+    }
+  }
+#else
+  // `closedir` closes the duplicated descriptor.
+  DIR* dir = nullptr;
+  if (int dup_fd = ::dup(fd); dup_fd != -1) {
+    dir = ::fdopendir(dup_fd);
+    if (dir == nullptr) ::close(dup_fd);
+  }
+  if (dir == nullptr) {
+    return StatusFromOsError(errno,
+                             "Failed while listing: ", QuoteString(path));
+  }
+  absl::Status status;
+  while (status.ok()) {
+    struct dirent* e;
+    {
+      PotentiallyBlockingRegion region;
+      e = ::readdir(dir);
+    }
+    if (e == nullptr) break;
+    if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0) {
+      continue;
+    }
+    status = callback(e->d_name, e->d_type);
+  }
+  ::closedir(dir);
+  return status;
+#endif
+}
+
+// State shared by the threads of a `ParallelFileList` call.
+struct ParallelListState {
+  ParallelListState(const Executor& executor, size_t parallelism,
+                    absl::FunctionRef<bool(std::string_view)> recurse_into,
+                    absl::FunctionRef<absl::Status(ListerEntry)> on_item)
+      : executor(executor),
+        parallelism(parallelism),
+        recurse_into(recurse_into),
+        on_item(on_item) {}
+
+  Executor executor;
+  size_t parallelism;
+  // Only called while `active != 0`, i.e. before `ParallelFileList` returns.
+  absl::FunctionRef<bool(std::string_view)> recurse_into;
+  absl::FunctionRef<absl::Status(ListerEntry)> on_item;
+
+  // Set once `status` is an error, to stop listing early.
+  std::atomic<bool> failed{false};
+
+  absl::Mutex mutex;
+  // Directories that remain to be listed.
+  std::vector<std::string> pending ABSL_GUARDED_BY(mutex);
+  // Number of directories being listed.
+  size_t active ABSL_GUARDED_BY(mutex) = 0;
+  // Number of tasks submitted to `executor` that have not finished.
+  size_t helpers ABSL_GUARDED_BY(mutex) = 0;
+  // First error encountered.
+  absl::Status status ABSL_GUARDED_BY(mutex);
+};
+
+// Lists the directory `path`, reporting its files to `state.on_item` and
+// appending the subdirectories to list to `subdirs`.
+absl::Status ListDirectory(ParallelListState& state, const std::string& path,
+                           bool is_root, char* buffer,
+                           std::vector<std::string>& subdirs) {
+  int fd;
+  do {
+    PotentiallyBlockingRegion region;
+    fd = ::openat(
+        AT_FDCWD, path.empty() ? "." : path.c_str(),
+        O_CLOEXEC | O_RDONLY | O_DIRECTORY | (is_root ? 0 : O_NOFOLLOW));
+  } while (fd == -1 && (errno == EINTR || errno == EAGAIN));
+  if (fd == -1) {
+    // The directory was removed or replaced after its parent was read.
+    if (errno == ENOENT || errno == ENOTDIR) return absl::OkStatus();
+    return StatusFromOsError(errno,
+                             "Failed while listing: ", QuoteString(path));
+  }
+  auto status = ReadDirectory(
+      fd, path, buffer,
+      [&](const char* name, unsigned char type) -> absl::Status {
+        if (state.failed.load(std::memory_order_relaxed)) {
+          return absl::CancelledError();
+        }
+        bool is_directory = (type == DT_DIR);
+        if (type == DT_UNKNOWN) {
+          struct ::stat st;
+          if (::fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+            if (errno == ENOENT) return absl::OkStatus();
+            return StatusFromOsError(errno, "Failed to stat: ",
+                                     QuoteString(JoinPath(path, name)));
+          }
+          is_directory = S_ISDIR(st.st_mode);
+        }
+        std::string full_path = JoinPath(path, name);
+        if (is_directory) {
+          if (state.recurse_into(full_path)) {
+            subdirs.push_back(std::move(full_path));
+          }
+          return absl::OkStatus();
+        }
+        ListerEntry::Impl impl{fd, full_path, name, false};
+        return state.on_item(ListerEntry(&impl));
+      });
+  ::close(fd);
+  return status;
+}
+
+void RunListHelper(const std::shared_ptr<ParallelListState>& state);
+
+// Records the result of listing a directory, and submits helper tasks to list
+// any newly discovered subdirectories.
+void CompleteDirectory(const std::shared_ptr<ParallelListState>& state,
+                       absl::Status status, std::vector<std::string> subdirs) {
+  size_t new_helpers = 0;
+  {
+    absl::MutexLock lock(&state->mutex);
+    --state->active;
+    if (!status.ok()) {
+      if (state->status.ok()) {
+        state->status = std::move(status);
+        state->failed.store(true, std::memory_order_relaxed);
+      }
+      return;
+    }
+    if (!state->status.ok()) return;
+    for (auto& subdir : subdirs) {
+      state->pending.push_back(std::move(subdir));
+    }
+    // The thread that calls `ParallelFileList` is also a worker.
+    while (state->helpers + 1 < state->parallelism &&
+           state->helpers < state->pending.size()) {
+      ++state->helpers;
+      ++new_helpers;
+    }
+  }
+  for (size_t i = 0; i < new_helpers; ++i) {
+    state->executor([state] { RunListHelper(state); });
+  }
+}
+
+// Lists pending directories until none remain.
+void RunListHelper(const std::shared_ptr<ParallelListState>& state) {
+  std::unique_ptr<char[]> buffer;
+  state->mutex.Lock();
+  while (state->status.ok() && !state->pending.empty()) {
+    std::string path = std::move(state->pending.back());
+    state->pending.pop_back();
+    ++state->active;
+    state->mutex.Unlock();
+    if (!buffer) buffer.reset(new char[kDirectoryBufferSize]);
+    std::vector<std::string> subdirs;
+    auto status =
+        ListDirectory(*state, path, /*is_root=*/false, buffer.get(), subdirs);
+    CompleteDirectory(state, std::move(status), std::move(subdirs));
+    state->mutex.Lock();
+  }
+  --state->helpers;
+  state->mutex.Unlock();
+}
+
+}  // namespace
+
+absl::Status ParallelFileList(
+    std::string root_directory, const Executor& executor, size_t parallelism,
+    absl::FunctionRef<bool(std::string_view)> recurse_into,
+    absl::FunctionRef<absl::Status(ListerEntry)> on_item) {
+  // root_directory must be a directory.
+  struct ::stat dir_stat;
+  if (::fstatat(AT_FDCWD, root_directory.empty() ? "." : root_directory.c_str(),
+                &dir_stat, 0) != 0) {
+    if (errno == ENOENT) return absl::OkStatus();
+    return StatusFromOsError(errno,
+                             "Failed to stat: ", QuoteString(root_directory));
+  }
+  if (!S_ISDIR(dir_stat.st_mode)) {
+    return absl::NotFoundError(absl::StrCat("Cannot list non-directory: ",
+                                            QuoteString(root_directory)));
+  }
+  if (!recurse_into(root_directory)) return absl::OkStatus();
+
+  auto state = std::make_shared<ParallelListState>(
+      executor, std::max(parallelism, size_t{1}), recurse_into, on_item);
+  std::unique_ptr<char[]> buffer(new char[kDirectoryBufferSize]);
+  {
+    state->mutex.Lock();
+    ++state->active;
+    state->mutex.Unlock();
+    std::vector<std::string> subdirs;
+    auto status = ListDirectory(*state, root_directory, /*is_root=*/true,
+                                buffer.get(), subdirs);
+    CompleteDirectory(state, std::move(status), std::move(subdirs));
+  }
+
+  // List pending directories alongside the helpers, then wait for the helpers
+  // to finish listing.
+  absl::MutexLock lock(&state->mutex);
+  while (true) {
+    state->mutex.Await(absl::Condition(
+        +[](ParallelListState* state) {
+          return !state->pending.empty() || state->active == 0 ||
+                 !state->status.ok();
+        },
+        state.get()));
+    if (!state->status.ok() || state->pending.empty()) break;
+    std::string path = std::move(state->pending.back());
+    state->pending.pop_back();
+    ++state->active;
+    state->mutex.Unlock();
+    std::vector<std::string> subdirs;
+    auto status =
+        ListDirectory(*state, path, /*is_root=*/false, buffer.get(), subdirs);
+    CompleteDirectory(state, std::move(status), std::move(subdirs));
+    state->mutex.Lock();
+  }
+  state->mutex.Await(absl::Condition(
+      +[](ParallelListState* state) { return state->active == 0; },
+      state.get()));
+  auto status = state->status;
+  MaybeAddSourceLocation(status);
+  return status;
+}
+
 }  // namespace internal_os
 }  // namespace tensorstore
@@ -25,8 +25,11 @@
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
 #include "tensorstore/internal/os/file_util.h"
 #include "tensorstore/internal/testing/scoped_directory.h"
+#include "tensorstore/internal/thread/thread_pool.h"
+#include "tensorstore/util/executor.h"
 #include "tensorstore/util/result.h"
 #include "tensorstore/util/span.h"
 #include "tensorstore/util/status.h"
@@ -42,6 +45,7 @@ using ::tensorstore::internal_os::MakeDirectory;
 using ::tensorstore::internal_os::OpenDirectoryDescriptor;
 using ::tensorstore::internal_os::OpenFileWrapper;
 using ::tensorstore::internal_os::OpenFlags;
+using ::tensorstore::internal_os::ParallelFileList;
 using ::tensorstore::internal_os::PReadFromFile;
 using ::tensorstore::internal_os::RecursiveFileList;
 using ::tensorstore::internal_os::WriteToFile;
@@ -177,6 +181,60 @@ TEST_F(RecursiveFileListTest, NonRecursive) {
                                               "<dir>zzq", "<dir>xyz", "<dir>"));
 }
 
+TEST_F(RecursiveFileListTest, ParallelFullDirectory) {
+  for (const auto& executor :
+       {tensorstore::Executor(tensorstore::InlineExecutor{}),
+        tensorstore::internal::DetachedThreadPool(4)}) {
+    absl::Mutex mutex;
+    std::vector<std::string> files;
+    EXPECT_THAT(
+        ParallelFileList(
+            "", executor, /*parallelism=*/4,
+            /*recurse_into=*/[](std::string_view path) { return true; },
+            /*on_item=*/
+            [&](auto entry) {
+              absl::MutexLock lock(&mutex);
+              files.push_back(absl::StrCat(entry.IsDirectory() ? "<dir>" : "",
+                                           entry.GetFullPath()));
+              return absl::OkStatus();
+            }),
+        IsOk());
+    EXPECT_THAT(files, ::testing::UnorderedElementsAre(
+                           "a.txt", "b.txt", "c.txt", "xyz/a.txt", "xyz/b.txt",
+                           "xyz/c.txt"));
+  }
+}
+
+TEST_F(RecursiveFileListTest, ParallelNonRecursive) {
+  absl::Mutex mutex;
+  std::vector<std::string> files;
+  EXPECT_THAT(ParallelFileList(
+                  "", tensorstore::internal::DetachedThreadPool(4),
+                  /*parallelism=*/4,
+                  /*recurse_into=*/
+                  [](std::string_view path) { return path.empty(); },
+                  /*on_item=*/
+                  [&](auto entry) {
+                    absl::MutexLock lock(&mutex);
+                    files.push_back(entry.GetFullPath());
+                    return absl::OkStatus();
+                  }),
+              IsOk());
+  EXPECT_THAT(files,
+              ::testing::UnorderedElementsAre("a.txt", "b.txt", "c.txt"));
+}
+
+TEST_F(RecursiveFileListTest, ParallelError) {
+  EXPECT_THAT(
+      ParallelFileList(
+          g_scoped_dir->path(), tensorstore::internal::DetachedThreadPool(4),
+          /*parallelism=*/4,
+          /*recurse_into=*/[](std::string_view path) { return true; },
+          /*on_item=*/
+          [](auto entry) { return absl::CancelledError(""); }),
+      ::testing::Not(IsOk()));
+}
+
 TEST(RecursiveFileListEntryTest, DeleteWithOpenFile) {
   // List the subdirectory (relative path)
   ScopedTemporaryDirectory tmpdir;
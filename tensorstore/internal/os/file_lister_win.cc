@@ -35,6 +35,7 @@
 #include "absl/strings/str_cat.h"
 #include "tensorstore/internal/os/error_code.h"
 #include "tensorstore/internal/os/wstring.h"
+#include "tensorstore/util/executor.h"
 #include "tensorstore/util/quote_string.h"
 #include "tensorstore/util/status.h"
 
@@ -266,5 +267,17 @@ absl::Status RecursiveFileList(
   return status;
 }
 
+absl::Status ParallelFileList(
+    std::string root_directory, const Executor& executor, size_t parallelism,
+    absl::FunctionRef<bool(std::string_view)> recurse_into,
+    absl::FunctionRef<absl::Status(ListerEntry)> on_item) {
+  // Directories are listed sequentially by the calling thread.
+  return RecursiveFileList(std::move(root_directory), recurse_into,
+                           [&](ListerEntry entry) -> absl::Status {
+                             if (entry.IsDirectory()) return absl::OkStatus();
+                             return on_item(entry);
+                           });
+}
+
 }  // namespace internal_os
 }  // namespace tensorstore
@@ -90,6 +90,14 @@ enum class OpenFlags : int {
   CloseOnExec = O_CLOEXEC,
   ReadWriteMask = O_RDONLY | O_WRONLY | O_RDWR,
 
+  // Bypass the page cache.  Reads must use buffers, offsets, and sizes that
+  // are multiples of `kDirectIoAlignment`.  Ignored where unsupported.
+#ifdef O_DIRECT
+  Direct = O_DIRECT,
+#else
+  Direct = 0,
+#endif
+
   DefaultRead = O_RDONLY | O_CLOEXEC,
   DefaultWrite = O_CREAT | O_WRONLY | O_CLOEXEC,
 };
@@ -181,6 +189,14 @@ absl::Status DeleteFile(const std::string& path);
 /// \returns `absl::OkStatus` on success, or a failure absl::Status code.
 absl::Status FsyncFile(FileDescriptor fd);
 
+/// Syncs the contents of an open file descriptor, and the metadata required to
+/// read them, but not other metadata such as the modification time.
+///
+/// Equivalent to `FsyncFile` where `fdatasync` is not supported.
+///
+/// \returns `absl::OkStatus` on success, or a failure absl::Status code.
+absl::Status DataSyncFile(FileDescriptor fd);
+
 /// Acquires a lock on an open file descriptor.
 ///
 /// \returns An unlock function on success, or an error status.
@@ -120,6 +120,10 @@ auto& mmap_active = internal_metrics::Gauge<int64_t>::New(
     "/tensorstore/file/mmap_active",
     internal_metrics::MetricMetadata("Count of active mmap files"));
 
+auto& mmap_active_bytes = internal_metrics::Gauge<int64_t>::New(
+    "/tensorstore/file/mmap_active_bytes",
+    internal_metrics::MetricMetadata("Count of active mmap bytes"));
+
 ABSL_CONST_INIT internal_log::VerboseFlag detail_logging("file_detail");
 
 #if defined(F_OFD_SETLKW)
@@ -421,6 +425,8 @@ void UnmapFilePosix(char* data, size_t size) {
     ABSL_LOG(FATAL) << StatusFromOsError(errno, "Failed to unmap file");
   }
   mmap_active.Decrement();
+  mmap_active_bytes.DecrementBy(size);
+  UnregisterFileMapping(data);
 }
 }  // namespace
 
@@ -464,6 +470,8 @@ Result<MemoryRegion> MemmapFileReadOnly(FileDescriptor fd, size_t offset,
   mmap_count.Increment();
   mmap_bytes.IncrementBy(size);
   mmap_active.Increment();
+  mmap_active_bytes.IncrementBy(size);
+  RegisterFileMapping(static_cast<const char*>(address), size);
   return MemoryRegion(static_cast<char*>(address), size, UnmapFilePosix);
 #else
   return absl::UnimplementedError("::mmap not supported");
@@ -480,6 +488,22 @@ absl::Status FsyncFile(FileDescriptor fd) {
   return std::move(tspan).EndWithStatus(std::move(status));
 }
 
+absl::Status DataSyncFile(FileDescriptor fd) {
+  LoggedTraceSpan tspan(__func__, detail_logging.Level(1), {{"fd", fd}});
+  PotentiallyBlockingRegion region;
+#if defined(__linux__)
+  if (::fdatasync(fd) == 0) {
+    return absl::OkStatus();
+  }
+#else
+  if (::fsync(fd) == 0) {
+    return absl::OkStatus();
+  }
+#endif
+  auto status = StatusFromOsError(errno, "Failed to fdatasync file");
+  return std::move(tspan).EndWithStatus(std::move(status));
+}
+
 absl::Status AwaitReadablePipe(FileDescriptor fd, absl::Time deadline) {
   if (deadline == absl::InfiniteFuture()) return absl::OkStatus();
 
@@ -39,6 +39,7 @@ namespace {
 using ::tensorstore::IsOk;
 using ::tensorstore::IsOkAndHolds;
 using ::tensorstore::StatusIs;
+using ::tensorstore::internal_os::DataSyncFile;
 using ::tensorstore::internal_os::DeleteFile;
 using ::tensorstore::internal_os::DeleteOpenFile;
 using ::tensorstore::internal_os::FileInfo;
@@ -86,6 +87,7 @@ TEST(FileUtilTest, Basics) {
     EXPECT_THAT(WriteCordToFile(f->get(), absl::Cord("foo")), IsOkAndHolds(3));
     EXPECT_THAT(WriteToFile(f->get(), "bar", 3), IsOkAndHolds(3));
     EXPECT_THAT(FsyncFile(f->get()), IsOk());
+    EXPECT_THAT(DataSyncFile(f->get()), IsOk());
   }
 
   EXPECT_THAT(ReadAllToString(foo_txt), IsOkAndHolds(std::string("foobar")));
@@ -128,6 +128,10 @@ auto& mmap_active = internal_metrics::Gauge<int64_t>::New(
     "/tensorstore/file/mmap_active",
     internal_metrics::MetricMetadata("Count of active mmap files"));
 
+auto& mmap_active_bytes = internal_metrics::Gauge<int64_t>::New(
+    "/tensorstore/file/mmap_active_bytes",
+    internal_metrics::MetricMetadata("Count of active mmap bytes"));
+
 ABSL_CONST_INIT internal_log::VerboseFlag detail_logging("file_detail");
 
 // Maximum length of Windows path, including terminating NUL.
@@ -495,6 +499,8 @@ void UnmapFileWin32(char* data, size_t size) {
                                          "Failed in UnmapViewOfFile");
   }
   mmap_active.Decrement();
+  mmap_active_bytes.DecrementBy(size);
+  UnregisterFileMapping(data);
 }
 }  // namespace
 
@@ -549,6 +555,8 @@ Result<MemoryRegion> MemmapFileReadOnly(FileDescriptor fd, size_t offset,
   mmap_count.Increment();
   mmap_bytes.IncrementBy(size);
   mmap_active.Increment();
+  mmap_active_bytes.IncrementBy(size);
+  RegisterFileMapping(static_cast<const char*>(address), size);
   return MemoryRegion(static_cast<char*>(address), size, UnmapFileWin32);
 }
 
@@ -562,6 +570,8 @@ absl::Status FsyncFile(FileDescriptor fd) {
   return std::move(tspan).EndWithStatus(std::move(status));
 }
 
+absl::Status DataSyncFile(FileDescriptor fd) { return FsyncFile(fd); }
+
 absl::Status AwaitReadablePipe(FileDescriptor fd, absl::Time deadline) {
   if (deadline == absl::InfiniteFuture()) return absl::OkStatus();
 
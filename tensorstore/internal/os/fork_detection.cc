@@ -21,8 +21,14 @@
 #include <atomic>
 #include <cstdio>
 #include <cstdlib>
+#include <new>
+#include <vector>
 
 #include "absl/base/call_once.h"
+#include "absl/base/no_destructor.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/numbers.h"
+#include "absl/synchronization/mutex.h"
 
 namespace tensorstore {
 namespace internal_os {
@@ -36,13 +42,93 @@ namespace {
 
 absl::once_flag g_once;
 
-void PthreadZeroOnFork() { g_fork_detected.store(true); }
+std::atomic<bool> g_fork_support_enabled{false};
+
+struct ForkHandlerRegistry {
+  absl::Mutex mutex;
+  std::vector<ForkHandlers> handlers ABSL_GUARDED_BY(mutex);
+  // Indicates whether fork support was enabled when the current fork was
+  // prepared.
+  bool fork_supported ABSL_GUARDED_BY(mutex) = false;
+};
+
+ForkHandlerRegistry& GetForkHandlerRegistry() {
+  static absl::NoDestructor<ForkHandlerRegistry> registry;
+  return *registry;
+}
+
+// The registry mutex is held from `PthreadPrepareFork` until the handlers
+// have run after the fork, so that the same handlers run before and after.
+void PthreadPrepareFork() ABSL_NO_THREAD_SAFETY_ANALYSIS {
+  auto& registry = GetForkHandlerRegistry();
+  registry.mutex.Lock();
+  registry.fork_supported = g_fork_support_enabled.load();
+  if (!registry.fork_supported) return;
+  for (auto it = registry.handlers.rbegin(); it != registry.handlers.rend();
+       ++it) {
+    if (it->prepare) it->prepare();
+  }
+}
+
+void PthreadParentAfterFork() ABSL_NO_THREAD_SAFETY_ANALYSIS {
+  auto& registry = GetForkHandlerRegistry();
+  if (registry.fork_supported) {
+    for (const auto& handlers : registry.handlers) {
+      if (handlers.parent) handlers.parent();
+    }
+  }
+  registry.mutex.Unlock();
+}
+
+void PthreadChildAfterFork() ABSL_NO_THREAD_SAFETY_ANALYSIS {
+  auto& registry = GetForkHandlerRegistry();
+  if (registry.fork_supported) {
+    for (const auto& handlers : registry.handlers) {
+      if (handlers.child) handlers.child();
+    }
+  } else {
+    g_fork_detected.store(true);
+  }
+  // Only the forking thread exists in the child process, so the mutex, which
+  // may still list other threads as waiters, is reinitialized rather than
+  // unlocked.
+  new (&registry.mutex) absl::Mutex;
+}
+
+void DoSetupForkDetection() {
+  if (const char* env = std::getenv("TENSORSTORE_FORK_SUPPORT")) {
+    bool enabled;
+    if (absl::SimpleAtob(env, &enabled) && enabled) {
+      g_fork_support_enabled.store(true);
+    }
+  }
+  GetForkHandlerRegistry();
+  pthread_atfork(PthreadPrepareFork, PthreadParentAfterFork,
+                 PthreadChildAfterFork);
+}
 
 }  // namespace
 
 void SetupForkDetection() {
   // InitializeForkDetection sets up the fork detection memory region.
-  absl::call_once(g_once, &pthread_atfork, nullptr, nullptr, PthreadZeroOnFork);
+  absl::call_once(g_once, DoSetupForkDetection);
+}
+
+void EnableForkSupport() {
+  SetupForkDetection();
+  g_fork_support_enabled.store(true);
+}
+
+bool IsForkSupportEnabled() {
+  SetupForkDetection();
+  return g_fork_support_enabled.load(std::memory_order_relaxed);
+}
+
+void RegisterForkHandlers(ForkHandlers handlers) {
+  SetupForkDetection();
+  auto& registry = GetForkHandlerRegistry();
+  absl::MutexLock lock(&registry.mutex);
+  registry.handlers.push_back(handlers);
 }
 
 void AbortIfForkDetectedImpl() {
@@ -61,6 +147,9 @@ namespace tensorstore {
 namespace internal_os {
 
 void SetupForkDetection() {}
+void EnableForkSupport() {}
+bool IsForkSupportEnabled() { return false; }
+void RegisterForkHandlers(ForkHandlers handlers) {}
 
 }  // namespace internal_os
 }  // namespace tensorstore
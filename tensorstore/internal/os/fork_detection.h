@@ -18,6 +18,7 @@
 #include <stdint.h>
 
 #include <atomic>
+
 namespace tensorstore {
 namespace internal_os {
 
@@ -30,9 +31,41 @@ void AbortIfForkDetectedImpl();
 
 /// Sets up fork detection.
 ///
-/// Forks detection sets the g_fork_detected atomic to true via pthread_atfork.
+/// Forks detection sets the g_fork_detected atomic to true via pthread_atfork,
+/// unless fork support is enabled.
 void SetupForkDetection();
 
+/// Enables support for using tensorstore in the child process after `fork()`,
+/// as by multiprocessing data loaders.
+///
+/// When enabled, the components registered with `RegisterForkHandlers` reset
+/// their state in the child process, e.g. restarting their threads, which
+/// otherwise do not exist in the child.  Cached data is inherited by the child
+/// as is.  The process must not have operations in progress when it forks.
+///
+/// Fork support is also enabled by setting the `TENSORSTORE_FORK_SUPPORT`
+/// environment variable to `1`.
+void EnableForkSupport();
+
+/// Returns `true` if fork support is enabled.
+bool IsForkSupportEnabled();
+
+/// Functions called around `fork()` when fork support is enabled.
+///
+/// As with `pthread_atfork`, the `prepare` functions are called in the
+/// reverse order of registration before the fork, typically to acquire locks,
+/// and the `parent` and `child` functions are called in the order of
+/// registration after the fork in the parent and child process, respectively.
+/// Any of the functions may be null.
+struct ForkHandlers {
+  void (*prepare)() = nullptr;
+  void (*parent)() = nullptr;
+  void (*child)() = nullptr;
+};
+
+/// Registers functions to be called around `fork()`.
+void RegisterForkHandlers(ForkHandlers handlers);
+
 /// Aborts the process if a fork() call has been detected.
 inline void AbortIfForkDetected() {
 #if !defined(_WIN32)
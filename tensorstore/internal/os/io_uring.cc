@@ -0,0 +1,331 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/os/io_uring.h"
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/log/absl_check.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/internal/os/error_code.h"
+#include "tensorstore/internal/os/file_descriptor.h"
+#include "tensorstore/internal/thread/thread.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal_os {
+
+using ::tensorstore::internal::GetLastErrorCode;
+using ::tensorstore::internal::OsErrorCode;
+using ::tensorstore::internal::StatusFromOsError;
+
+struct IoUring::Operation {
+  Callback callback;
+};
+
+#if defined(__linux__) && defined(__NR_io_uring_setup) && \
+    defined(__NR_io_uring_enter)
+
+namespace {
+
+int IoUringSetup(uint32_t entries, io_uring_params* params) {
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int IoUringEnter(int ring_fd, uint32_t to_submit, uint32_t min_complete,
+                 uint32_t flags) {
+  return static_cast<int>(::syscall(__NR_io_uring_enter, ring_fd, to_submit,
+                                    min_complete, flags, nullptr, 0));
+}
+
+template <typename T>
+T* RingPointer(void* ring, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+// `user_data` of the entry queued by the destructor to stop the completion
+// thread.
+constexpr uint64_t kShutdownUserData = 0;
+
+}  // namespace
+
+Result<std::unique_ptr<IoUring>> IoUring::Make(const Options& options) {
+  io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+  if (options.sqpoll) {
+    params.flags |= IORING_SETUP_SQPOLL;
+    params.sq_thread_idle = 100;  // milliseconds
+  }
+  int ring_fd =
+      IoUringSetup(std::max<uint32_t>(options.queue_depth, 1), &params);
+  if (ring_fd < 0) {
+    return StatusFromOsError(GetLastErrorCode(), "Failed to create io_uring");
+  }
+  std::unique_ptr<IoUring> ring(new IoUring);
+  ring->ring_fd_ = ring_fd;
+  ring->sqpoll_ = options.sqpoll;
+
+  ring->sq_ring_size_ =
+      params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  ring->cq_ring_size_ =
+      params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+  if (single_mmap) {
+    ring->sq_ring_size_ = ring->cq_ring_size_ =
+        std::max(ring->sq_ring_size_, ring->cq_ring_size_);
+  }
+  void* sq_ring = ::mmap(nullptr, ring->sq_ring_size_, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, ring_fd,
+                         IORING_OFF_SQ_RING);
+  if (sq_ring == MAP_FAILED) {
+    return StatusFromOsError(GetLastErrorCode(),
+                             "Failed to map io_uring submission queue");
+  }
+  ring->sq_ring_ = sq_ring;
+  if (single_mmap) {
+    ring->cq_ring_ = sq_ring;
+  } else {
+    void* cq_ring =
+        ::mmap(nullptr, ring->cq_ring_size_, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+    if (cq_ring == MAP_FAILED) {
+      return StatusFromOsError(GetLastErrorCode(),
+                               "Failed to map io_uring completion queue");
+    }
+    ring->cq_ring_ = cq_ring;
+  }
+  ring->sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  void* sqes = ::mmap(nullptr, ring->sqes_size_, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    return StatusFromOsError(GetLastErrorCode(),
+                             "Failed to map io_uring submission entries");
+  }
+  ring->sqes_ = sqes;
+
+  void* sq = ring->sq_ring_;
+  ring->sq_head_ = RingPointer<std::atomic<uint32_t>>(sq, params.sq_off.head);
+  ring->sq_tail_ = RingPointer<std::atomic<uint32_t>>(sq, params.sq_off.tail);
+  ring->sq_flags_ =
+      RingPointer<std::atomic<uint32_t>>(sq, params.sq_off.flags);
+  ring->sq_array_ = RingPointer<uint32_t>(sq, params.sq_off.array);
+  ring->sq_mask_ = *RingPointer<uint32_t>(sq, params.sq_off.ring_mask);
+  ring->sq_entries_ = params.sq_entries;
+  void* cq = ring->cq_ring_;
+  ring->cq_head_ = RingPointer<std::atomic<uint32_t>>(cq, params.cq_off.head);
+  ring->cq_tail_ = RingPointer<std::atomic<uint32_t>>(cq, params.cq_off.tail);
+  ring->cqes_ = RingPointer<void>(cq, params.cq_off.cqes);
+  ring->cq_mask_ = *RingPointer<uint32_t>(cq, params.cq_off.ring_mask);
+  ring->cq_entries_ = params.cq_entries;
+
+  ring->completion_thread_ = internal::Thread(
+      {"ts_io_uring"}, [r = ring.get()] { r->CompletionLoop(); });
+  return ring;
+}
+
+IoUring::~IoUring() {
+  if (ring_fd_ != -1 && sqes_ != nullptr) {
+    {
+      absl::MutexLock lock(&mutex_);
+      QueueEntry(IORING_OP_NOP, kShutdownUserData, -1, nullptr, 0, 0);
+      SubmitLocked();
+    }
+    completion_thread_.Join();
+  }
+  if (sqes_) ::munmap(sqes_, sqes_size_);
+  if (cq_ring_ && cq_ring_ != sq_ring_) ::munmap(cq_ring_, cq_ring_size_);
+  if (sq_ring_) ::munmap(sq_ring_, sq_ring_size_);
+  if (ring_fd_ != -1) ::close(ring_fd_);
+}
+
+void IoUring::QueueEntry(uint8_t opcode, uint64_t user_data,
+                         FileDescriptor fd, void* addr, uint32_t len,
+                         int64_t offset) {
+  // Bound the operations in flight by the completion queue capacity, so that
+  // completions are never dropped.  Entries queued by this thread must be
+  // submitted before waiting for them to complete.
+  if (in_flight_ >= cq_entries_) SubmitLocked();
+  mutex_.Await(absl::Condition(
+      +[](IoUring* self) ABSL_EXCLUSIVE_LOCKS_REQUIRED(self->mutex_) {
+        return self->in_flight_ < self->cq_entries_;
+      },
+      this));
+  while (sq_tail_->load(std::memory_order_relaxed) -
+             sq_head_->load(std::memory_order_acquire) >=
+         sq_entries_) {
+    // The submission queue is full of entries that the kernel has not yet
+    // consumed.  Without SQPOLL, submitting consumes all of them.
+    SubmitLocked();
+    if (sq_tail_->load(std::memory_order_relaxed) -
+            sq_head_->load(std::memory_order_acquire) <
+        sq_entries_) {
+      break;
+    }
+    mutex_.Unlock();
+    std::this_thread::yield();
+    mutex_.Lock();
+  }
+  const uint32_t tail = sq_tail_->load(std::memory_order_relaxed);
+  const uint32_t index = tail & sq_mask_;
+  auto* sqe = static_cast<io_uring_sqe*>(sqes_) + index;
+  std::memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = opcode;
+  sqe->user_data = user_data;
+  sqe->fd = fd;
+  sqe->addr = reinterpret_cast<uintptr_t>(addr);
+  sqe->len = len;
+  sqe->off = static_cast<uint64_t>(offset);
+  sq_array_[index] = index;
+  // Publishes the entry to the kernel.
+  sq_tail_->store(tail + 1, std::memory_order_release);
+  ++unsubmitted_;
+  ++in_flight_;
+}
+
+void IoUring::Read(FileDescriptor fd, tensorstore::span<char> buffer,
+                   int64_t offset, Callback callback) {
+  auto* op = new Operation{std::move(callback)};
+  absl::MutexLock lock(&mutex_);
+  QueueEntry(IORING_OP_READ, reinterpret_cast<uintptr_t>(op), fd,
+             buffer.data(), static_cast<uint32_t>(buffer.size()), offset);
+}
+
+void IoUring::Submit() {
+  absl::MutexLock lock(&mutex_);
+  SubmitLocked();
+}
+
+void IoUring::SubmitLocked() {
+  if (unsubmitted_ == 0) return;
+  if (sqpoll_) {
+    // The kernel thread consumes the entries; the system call is only
+    // required to wake it once it has gone idle.
+    unsubmitted_ = 0;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sq_flags_->load(std::memory_order_relaxed) & IORING_SQ_NEED_WAKEUP) {
+      IoUringEnter(ring_fd_, 0, 0, IORING_ENTER_SQ_WAKEUP);
+    }
+    return;
+  }
+  while (unsubmitted_ > 0) {
+    int submitted = IoUringEnter(ring_fd_, unsubmitted_, 0, 0);
+    if (submitted < 0) {
+      // EAGAIN and EBUSY indicate a transient lack of resources; other errors
+      // indicate a bug.
+      const int error = errno;
+      ABSL_CHECK(error == EINTR || error == EAGAIN || error == EBUSY)
+          << "io_uring_enter failed: " << error;
+      mutex_.Unlock();
+      std::this_thread::yield();
+      mutex_.Lock();
+      continue;
+    }
+    unsubmitted_ -= std::min<uint32_t>(submitted, unsubmitted_);
+  }
+}
+
+void IoUring::CompletionLoop() {
+  std::vector<std::pair<Operation*, int32_t>> completions;
+  while (true) {
+    uint32_t head = cq_head_->load(std::memory_order_relaxed);
+    uint32_t tail = cq_tail_->load(std::memory_order_acquire);
+    if (head == tail) {
+      if (IoUringEnter(ring_fd_, 0, 1, IORING_ENTER_GETEVENTS) < 0) {
+        ABSL_CHECK(errno == EINTR || errno == EAGAIN || errno == EBUSY)
+            << "io_uring_enter failed: " << errno;
+      }
+      continue;
+    }
+    // Collect the completions and release the entries, and the in-flight
+    // slots, before running the callbacks, which may queue more operations.
+    bool shutdown = false;
+    uint32_t completed = 0;
+    completions.clear();
+    for (; head != tail; ++head) {
+      const auto& cqe =
+          static_cast<const io_uring_cqe*>(cqes_)[head & cq_mask_];
+      ++completed;
+      if (cqe.user_data == kShutdownUserData) {
+        shutdown = true;
+        continue;
+      }
+      completions.emplace_back(reinterpret_cast<Operation*>(cqe.user_data),
+                               cqe.res);
+    }
+    cq_head_->store(head, std::memory_order_release);
+    {
+      absl::MutexLock lock(&mutex_);
+      in_flight_ -= completed;
+    }
+    for (auto& [op_ptr, res] : completions) {
+      std::unique_ptr<Operation> op(op_ptr);
+      Result<size_t> result = static_cast<size_t>(res);
+      if (res < 0) {
+        result = StatusFromOsError(static_cast<OsErrorCode>(-res),
+                                   "io_uring operation failed");
+      }
+      std::move(op->callback)(std::move(result));
+    }
+    if (shutdown) return;
+  }
+}
+
+#else  // !__linux__
+
+Result<std::unique_ptr<IoUring>> IoUring::Make(const Options& options) {
+  return absl::UnimplementedError("io_uring is only supported on Linux");
+}
+
+IoUring::~IoUring() = default;
+
+void IoUring::QueueEntry(uint8_t opcode, uint64_t user_data,
+                         FileDescriptor fd, void* addr, uint32_t len,
+                         int64_t offset) {}
+
+void IoUring::Read(FileDescriptor fd, tensorstore::span<char> buffer,
+                   int64_t offset, Callback callback) {
+  std::move(callback)(absl::UnimplementedError("io_uring is not supported"));
+}
+
+void IoUring::Submit() {}
+
+void IoUring::SubmitLocked() {}
+
+void IoUring::CompletionLoop() {}
+
+#endif  // !__linux__
+
+}  // namespace internal_os
+}  // namespace tensorstore
@@ -0,0 +1,122 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_OS_IO_URING_H_
+#define TENSORSTORE_INTERNAL_OS_IO_URING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/internal/os/file_descriptor.h"
+#include "tensorstore/internal/thread/thread.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal_os {
+
+/// Asynchronous file I/O using a Linux io_uring.
+///
+/// Operations are queued by `Read` and passed to the kernel in batches by
+/// `Submit`, so that many operations may be in flight without a thread
+/// blocked on each.  Completion callbacks run on a dedicated thread, and must
+/// not block; typically they forward the result to an executor.
+///
+/// An `IoUring` must not be destroyed while operations are in flight.
+class IoUring {
+ public:
+  struct Options {
+    /// Number of submission queue entries, which also bounds the number of
+    /// operations in flight.
+    uint32_t queue_depth = 256;
+
+    /// Use a kernel thread to poll the submission queue, which avoids the
+    /// system call in `Submit` while the kernel thread is active.
+    bool sqpoll = false;
+  };
+
+  /// Receives the number of bytes transferred, or an error.
+  using Callback = absl::AnyInvocable<void(Result<size_t>) &&>;
+
+  /// Creates an io_uring.
+  ///
+  /// Returns an error if io_uring is not supported by the platform or kernel,
+  /// or is not permitted.
+  static Result<std::unique_ptr<IoUring>> Make(const Options& options);
+
+  ~IoUring();
+
+  /// Queues a read of up to `buffer.size()` bytes from `fd` at `offset`.
+  ///
+  /// `fd` and `buffer` must remain valid until `callback` is invoked.  Blocks
+  /// while the maximum number of operations is in flight.
+  void Read(FileDescriptor fd, tensorstore::span<char> buffer, int64_t offset,
+            Callback callback);
+
+  /// Passes all queued operations to the kernel.
+  void Submit();
+
+ private:
+  struct Operation;
+  IoUring() = default;
+
+  // Queues a submission queue entry, which is submitted on the next `Submit`.
+  // Blocks while the queue is full.
+  void QueueEntry(uint8_t opcode, uint64_t user_data, FileDescriptor fd,
+                  void* addr, uint32_t len, int64_t offset)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void SubmitLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void CompletionLoop();
+
+  int ring_fd_ = -1;
+  bool sqpoll_ = false;
+
+  // Memory mapped rings shared with the kernel.
+  void* sq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  void* cq_ring_ = nullptr;
+  size_t cq_ring_size_ = 0;
+  void* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+  std::atomic<uint32_t>* sq_head_;
+  std::atomic<uint32_t>* sq_tail_;
+  std::atomic<uint32_t>* sq_flags_;
+  uint32_t* sq_array_;
+  uint32_t sq_mask_;
+  uint32_t sq_entries_;
+  std::atomic<uint32_t>* cq_head_;
+  std::atomic<uint32_t>* cq_tail_;
+  void* cqes_;
+  uint32_t cq_mask_;
+  uint32_t cq_entries_;
+
+  absl::Mutex mutex_;
+  // Number of queued but not yet submitted entries.
+  uint32_t unsubmitted_ ABSL_GUARDED_BY(mutex_) = 0;
+  // Number of operations which have not yet completed.
+  uint32_t in_flight_ ABSL_GUARDED_BY(mutex_) = 0;
+
+  internal::Thread completion_thread_;
+};
+
+}  // namespace internal_os
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_OS_IO_URING_H_
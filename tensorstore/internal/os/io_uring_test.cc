@@ -0,0 +1,118 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/os/io_uring.h"
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/synchronization/blocking_counter.h"
+#include "tensorstore/internal/os/file_util.h"
+#include "tensorstore/internal/testing/scoped_directory.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::IsOkAndHolds;
+using ::tensorstore::Result;
+using ::tensorstore::internal_os::IoUring;
+using ::tensorstore::internal_os::OpenFileWrapper;
+using ::tensorstore::internal_os::OpenFlags;
+using ::tensorstore::internal_os::WriteToFile;
+using ::tensorstore::internal_testing::ScopedTemporaryDirectory;
+
+// Returns a path to a file containing `size` bytes of known content.
+std::string WriteTestFile(const ScopedTemporaryDirectory& tempdir,
+                          size_t size) {
+  std::string path = tempdir.path() + "/data";
+  std::string data(size, '\0');
+  for (size_t i = 0; i < size; ++i) data[i] = static_cast<char>(i % 251);
+  auto f = OpenFileWrapper(path, OpenFlags::DefaultWrite);
+  TENSORSTORE_CHECK_OK(f);
+  TENSORSTORE_CHECK_OK(WriteToFile(f->get(), data.data(), data.size()));
+  return path;
+}
+
+void TestConcurrentReads(IoUring::Options options) {
+  auto ring = IoUring::Make(options);
+  if (!ring.ok()) {
+    GTEST_SKIP() << ring.status();
+  }
+  ScopedTemporaryDirectory tempdir;
+  constexpr size_t kBlockSize = 4096;
+  constexpr size_t kNumBlocks = 100;
+  auto path = WriteTestFile(tempdir, kBlockSize * kNumBlocks);
+  auto f = OpenFileWrapper(path, OpenFlags::DefaultRead);
+  TENSORSTORE_CHECK_OK(f);
+
+  // More reads than the queue depth, to exercise the in-flight limit.
+  std::vector<std::string> buffers(kNumBlocks, std::string(kBlockSize, '\0'));
+  std::vector<Result<size_t>> results(kNumBlocks);
+  absl::BlockingCounter done(kNumBlocks);
+  for (size_t i = 0; i < kNumBlocks; ++i) {
+    (*ring)->Read(f->get(), tensorstore::span(buffers[i]), i * kBlockSize,
+                  [&, i](Result<size_t> result) {
+                    results[i] = std::move(result);
+                    done.DecrementCount();
+                  });
+  }
+  (*ring)->Submit();
+  done.Wait();
+  for (size_t i = 0; i < kNumBlocks; ++i) {
+    EXPECT_THAT(results[i], IsOkAndHolds(kBlockSize)) << i;
+    EXPECT_EQ(static_cast<char>((i * kBlockSize) % 251), buffers[i][0]) << i;
+    EXPECT_EQ(static_cast<char>((i * kBlockSize + kBlockSize - 1) % 251),
+              buffers[i].back())
+        << i;
+  }
+}
+
+TEST(IoUringTest, ConcurrentReads) {
+  TestConcurrentReads({/*.queue_depth=*/16, /*.sqpoll=*/false});
+}
+
+TEST(IoUringTest, ConcurrentReadsSqpoll) {
+  TestConcurrentReads({/*.queue_depth=*/16, /*.sqpoll=*/true});
+}
+
+TEST(IoUringTest, ReadPastEnd) {
+  auto ring = IoUring::Make({});
+  if (!ring.ok()) {
+    GTEST_SKIP() << ring.status();
+  }
+  ScopedTemporaryDirectory tempdir;
+  auto path = WriteTestFile(tempdir, 10);
+  auto f = OpenFileWrapper(path, OpenFlags::DefaultRead);
+  TENSORSTORE_CHECK_OK(f);
+  std::string buffer(100, '\0');
+  Result<size_t> result;
+  absl::BlockingCounter done(1);
+  (*ring)->Read(f->get(), tensorstore::span(buffer), 5,
+                [&](Result<size_t> r) {
+                  result = std::move(r);
+                  done.DecrementCount();
+                });
+  (*ring)->Submit();
+  done.Wait();
+  EXPECT_THAT(result, IsOkAndHolds(5));
+}
+
+}  // namespace
@@ -0,0 +1,182 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/os/memory_pressure.h"
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <fstream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "absl/base/no_destructor.h"
+#include "absl/status/status.h"
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/strip.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal_os {
+namespace {
+
+#ifdef __linux__
+constexpr const char kCgroupRoot[] = "/sys/fs/cgroup";
+
+std::optional<std::string> ReadFile(const std::string& path) {
+  std::ifstream file(path);
+  if (!file.is_open()) return std::nullopt;
+  std::stringstream contents;
+  contents << file.rdbuf();
+  return std::move(contents).str();
+}
+
+// Returns the cgroup v2 directory of the process.  Inside a container with a
+// cgroup namespace, this is normally the root of the cgroup filesystem.
+std::string DetectCgroupDir() {
+  if (auto contents = ReadFile("/proc/self/cgroup")) {
+    for (std::string_view line : absl::StrSplit(*contents, '\n')) {
+      if (!absl::ConsumePrefix(&line, "0::")) continue;
+      std::string dir = absl::StrCat(kCgroupRoot, line);
+      if (ReadFile(absl::StrCat(dir, "/memory.max"))) return dir;
+      break;
+    }
+  }
+  return kCgroupRoot;
+}
+
+const std::string& GetCgroupDir() {
+  static absl::NoDestructor<std::string> dir(DetectCgroupDir());
+  return *dir;
+}
+
+uint64_t GetPhysicalMemory() {
+  const long pages = ::sysconf(_SC_PHYS_PAGES);
+  const long page_size = ::sysconf(_SC_PAGE_SIZE);
+  if (pages <= 0 || page_size <= 0) return 0;
+  return static_cast<uint64_t>(pages) * static_cast<uint64_t>(page_size);
+}
+
+std::optional<uint64_t> GetCgroupMemoryLimit() {
+  // cgroup v2, then cgroup v1.
+  for (const std::string& path :
+       {absl::StrCat(GetCgroupDir(), "/memory.max"),
+        absl::StrCat(kCgroupRoot, "/memory/memory.limit_in_bytes")}) {
+    if (auto contents = ReadFile(path)) {
+      auto limit = ParseCgroupMemoryLimit(*contents);
+      if (limit.ok()) return *limit;
+    }
+  }
+  return std::nullopt;
+}
+#endif
+
+}  // namespace
+
+Result<std::optional<uint64_t>> ParseCgroupMemoryLimit(
+    std::string_view contents) {
+  contents = absl::StripAsciiWhitespace(contents);
+  if (contents == "max") return std::nullopt;
+  uint64_t limit;
+  if (!absl::SimpleAtoi(contents, &limit)) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Invalid cgroup memory limit: \"", contents, "\""));
+  }
+  return limit;
+}
+
+Result<double> ParsePressureSomeAvg10(std::string_view contents) {
+  for (std::string_view line : absl::StrSplit(contents, '\n')) {
+    if (!absl::ConsumePrefix(&line, "some ")) continue;
+    for (std::string_view field : absl::StrSplit(line, ' ')) {
+      double value;
+      if (absl::ConsumePrefix(&field, "avg10=") &&
+          absl::SimpleAtod(field, &value)) {
+        return value;
+      }
+    }
+    break;
+  }
+  return absl::InvalidArgumentError(
+      absl::StrCat("Invalid pressure stall information: \"", contents, "\""));
+}
+
+Result<uint64_t> ParseCgroupMemoryEvents(std::string_view contents) {
+  uint64_t total = 0;
+  for (std::string_view line :
+       absl::StrSplit(contents, '\n', absl::SkipWhitespace())) {
+    std::pair<std::string_view, std::string_view> entry =
+        absl::StrSplit(line, absl::MaxSplits(' ', 1));
+    uint64_t count;
+    if (!absl::SimpleAtoi(entry.second, &count)) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Invalid cgroup memory events: \"", contents, "\""));
+    }
+    if (entry.first == "high" || entry.first == "max" ||
+        entry.first == "oom") {
+      total += count;
+    }
+  }
+  return total;
+}
+
+uint64_t GetMemoryLimit() {
+#ifdef __linux__
+  const uint64_t physical = GetPhysicalMemory();
+  // A cgroup v1 without a limit reports a value near the maximum of `int64_t`.
+  if (auto limit = GetCgroupMemoryLimit();
+      limit && (physical == 0 || *limit < physical)) {
+    return *limit;
+  }
+  return physical;
+#else
+  return 0;
+#endif
+}
+
+MemoryPressure GetMemoryPressure() {
+  MemoryPressure pressure;
+#ifdef __linux__
+  const std::string& dir = GetCgroupDir();
+  for (const std::string& path :
+       {absl::StrCat(dir, "/memory.pressure"),
+        std::string("/proc/pressure/memory")}) {
+    if (auto contents = ReadFile(path)) {
+      if (auto avg10 = ParsePressureSomeAvg10(*contents); avg10.ok()) {
+        pressure.some_avg10 = *avg10;
+        break;
+      }
+    }
+  }
+  if (auto contents = ReadFile(absl::StrCat(dir, "/memory.events"))) {
+    if (auto events = ParseCgroupMemoryEvents(*contents); events.ok()) {
+      pressure.limit_events = *events;
+    }
+  }
+#endif
+  return pressure;
+}
+
+}  // namespace internal_os
+}  // namespace tensorstore
@@ -0,0 +1,66 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_OS_MEMORY_PRESSURE_H_
+#define TENSORSTORE_INTERNAL_OS_MEMORY_PRESSURE_H_
+
+#include <stdint.h>
+
+#include <optional>
+#include <string_view>
+
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal_os {
+
+/// Parses a cgroup memory limit, as in the cgroup v2 `memory.max` file or the
+/// cgroup v1 `memory.limit_in_bytes` file.  Returns `std::nullopt` for
+/// `"max"`, which indicates no limit.
+Result<std::optional<uint64_t>> ParseCgroupMemoryLimit(
+    std::string_view contents);
+
+/// Parses the `avg10` value of the `some` line of a pressure stall
+/// information file, such as `/proc/pressure/memory` or the cgroup v2
+/// `memory.pressure` file.
+Result<double> ParsePressureSomeAvg10(std::string_view contents);
+
+/// Parses a cgroup v2 `memory.events` file, returning the sum of the `high`,
+/// `max` and `oom` counters.
+Result<uint64_t> ParseCgroupMemoryEvents(std::string_view contents);
+
+/// Returns the number of bytes of memory available to the process: the
+/// memory limit of its cgroup, if any and smaller than the physical memory of
+/// the machine, and otherwise the physical memory.  Returns `0` if unknown.
+uint64_t GetMemoryLimit();
+
+/// Memory pressure of the cgroup of the process, or of the system.
+struct MemoryPressure {
+  /// Percentage of the last 10 seconds in which some tasks were stalled
+  /// waiting for memory, or `-1` if unknown.
+  double some_avg10 = -1;
+
+  /// Number of times the cgroup has reached its `high` or `max` memory limit
+  /// or invoked the OOM killer.  Only increases over time.
+  uint64_t limit_events = 0;
+};
+
+/// Returns the current memory pressure.  Unknown values are left at their
+/// defaults, e.g. on platforms other than Linux.
+MemoryPressure GetMemoryPressure();
+
+}  // namespace internal_os
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_OS_MEMORY_PRESSURE_H_
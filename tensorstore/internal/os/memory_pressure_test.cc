@@ -0,0 +1,74 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/os/memory_pressure.h"
+
+#include <stdint.h>
+
+#include <optional>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::IsOkAndHolds;
+using ::tensorstore::StatusIs;
+using ::tensorstore::internal_os::GetMemoryLimit;
+using ::tensorstore::internal_os::GetMemoryPressure;
+using ::tensorstore::internal_os::ParseCgroupMemoryEvents;
+using ::tensorstore::internal_os::ParseCgroupMemoryLimit;
+using ::tensorstore::internal_os::ParsePressureSomeAvg10;
+using ::testing::Optional;
+
+TEST(ParseCgroupMemoryLimitTest, Basic) {
+  EXPECT_THAT(ParseCgroupMemoryLimit("max\n"),
+              IsOkAndHolds(std::optional<uint64_t>()));
+  EXPECT_THAT(ParseCgroupMemoryLimit("4294967296\n"),
+              IsOkAndHolds(Optional(uint64_t(4294967296))));
+  EXPECT_THAT(ParseCgroupMemoryLimit("-1"),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(ParsePressureSomeAvg10Test, Basic) {
+  EXPECT_THAT(
+      ParsePressureSomeAvg10(
+          "some avg10=12.50 avg60=3.00 avg300=0.50 total=123456\n"
+          "full avg10=1.00 avg60=0.50 avg300=0.00 total=2345\n"),
+      IsOkAndHolds(12.5));
+  EXPECT_THAT(ParsePressureSomeAvg10("full avg10=1.00\n"),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(ParseCgroupMemoryEventsTest, Basic) {
+  EXPECT_THAT(ParseCgroupMemoryEvents("low 7\n"
+                                      "high 3\n"
+                                      "max 2\n"
+                                      "oom 1\n"
+                                      "oom_kill 1\n"),
+              IsOkAndHolds(6));
+  EXPECT_THAT(ParseCgroupMemoryEvents("high x\n"),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(MemoryPressureTest, Current) {
+  // The values depend on the environment, but must be consistent.
+  [[maybe_unused]] const uint64_t limit = GetMemoryLimit();
+  const auto pressure = GetMemoryPressure();
+  EXPECT_TRUE(pressure.some_avg10 == -1 || pressure.some_avg10 >= 0);
+}
+
+}  // namespace
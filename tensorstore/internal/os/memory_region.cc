@@ -18,10 +18,17 @@
 #include <stdint.h>
 
 #include <cstdlib>
+#include <new>
 #include <string_view>
+#include <vector>
 
+#include "absl/base/no_destructor.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/container/btree_map.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/log/absl_log.h"
 #include "absl/strings/cord.h"
+#include "absl/synchronization/mutex.h"
 
 namespace tensorstore {
 namespace internal_os {
@@ -29,8 +36,83 @@ namespace {
 
 void FreeHeap(char* data, size_t size) { ::free(data); }
 
+// Limit on the total size of the released regions retained by
+// `AlignedRegionPool`.
+constexpr size_t kAlignedRegionPoolBytesLimit = size_t(64) << 20;
+
+// Released aligned regions, by size.  Unbuffered reads of equally sized
+// chunks allocate and release regions of the same few sizes.
+struct AlignedRegionPool {
+  absl::Mutex mutex;
+  absl::flat_hash_map<size_t, std::vector<char*>> free_regions
+      ABSL_GUARDED_BY(mutex);
+  size_t cached_bytes ABSL_GUARDED_BY(mutex) = 0;
+};
+
+AlignedRegionPool& GetAlignedRegionPool() {
+  static absl::NoDestructor<AlignedRegionPool> pool;
+  return *pool;
+}
+
+void ReleaseAlignedHeap(char* data, size_t size) {
+  auto& pool = GetAlignedRegionPool();
+  {
+    absl::MutexLock lock(&pool.mutex);
+    if (pool.cached_bytes + size <= kAlignedRegionPoolBytesLimit) {
+      pool.free_regions[size].push_back(data);
+      pool.cached_bytes += size;
+      return;
+    }
+  }
+  ::operator delete(data, std::align_val_t(kDirectIoAlignment));
+}
+
+// Regions mapped by `MemmapFileReadOnly`, by start address.
+struct FileMappings {
+  absl::Mutex mutex;
+  absl::btree_map<uintptr_t, size_t> regions ABSL_GUARDED_BY(mutex);
+  size_t total_bytes ABSL_GUARDED_BY(mutex) = 0;
+};
+
+FileMappings& GetFileMappings() {
+  static absl::NoDestructor<FileMappings> mappings;
+  return *mappings;
+}
+
 }  // namespace
 
+void RegisterFileMapping(const char* data, size_t size) {
+  auto& mappings = GetFileMappings();
+  absl::MutexLock lock(&mappings.mutex);
+  mappings.regions.emplace(reinterpret_cast<uintptr_t>(data), size);
+  mappings.total_bytes += size;
+}
+
+void UnregisterFileMapping(const char* data) {
+  auto& mappings = GetFileMappings();
+  absl::MutexLock lock(&mappings.mutex);
+  auto it = mappings.regions.find(reinterpret_cast<uintptr_t>(data));
+  if (it == mappings.regions.end()) return;
+  mappings.total_bytes -= it->second;
+  mappings.regions.erase(it);
+}
+
+bool IsFileMappedMemory(const void* data) {
+  const uintptr_t address = reinterpret_cast<uintptr_t>(data);
+  auto& mappings = GetFileMappings();
+  absl::MutexLock lock(&mappings.mutex);
+  auto it = mappings.regions.upper_bound(address);
+  if (it == mappings.regions.begin()) return false;
+  --it;
+  return address - it->first < it->second;
+}
+
+size_t GetFileMappedBytes() {
+  auto& mappings = GetFileMappings();
+  absl::MutexLock lock(&mappings.mutex);
+  return mappings.total_bytes;
+}
+
 absl::Cord MemoryRegion::as_cord() && {
   std::string_view string_view = as_string_view();
   data_ = nullptr;
@@ -52,5 +134,28 @@ MemoryRegion AllocateHeapRegion(size_t size) {
   return MemoryRegion(static_cast<char*>(p), size, FreeHeap);
 }
 
+MemoryRegion AllocateAlignedHeapRegion(size_t size) {
+  if (size == 0) {
+    return MemoryRegion(nullptr, 0, ReleaseAlignedHeap);
+  }
+  {
+    auto& pool = GetAlignedRegionPool();
+    absl::MutexLock lock(&pool.mutex);
+    if (auto it = pool.free_regions.find(size);
+        it != pool.free_regions.end() && !it->second.empty()) {
+      char* data = it->second.back();
+      it->second.pop_back();
+      pool.cached_bytes -= size;
+      return MemoryRegion(data, size, ReleaseAlignedHeap);
+    }
+  }
+  void* p = ::operator new(size, std::align_val_t(kDirectIoAlignment),
+                           std::nothrow);
+  if (p == nullptr) {
+    ABSL_LOG(FATAL) << "Failed to allocate memory " << size;
+  }
+  return MemoryRegion(static_cast<char*>(p), size, ReleaseAlignedHeap);
+}
+
 }  // namespace internal_os
 }  // namespace tensorstore
@@ -73,6 +73,7 @@ class MemoryRegion {
   friend Result<MemoryRegion> MemmapFileReadOnly(void*, size_t, size_t);
   friend Result<MemoryRegion> MemmapFileReadOnly(int, size_t, size_t);
   friend MemoryRegion AllocateHeapRegion(size_t);
+  friend MemoryRegion AllocateAlignedHeapRegion(size_t);
 
   char* data_;
   size_t size_;
@@ -82,6 +83,32 @@ class MemoryRegion {
 /// Try to allocate a region of memory backed the heap.
 MemoryRegion AllocateHeapRegion(size_t size);
 
+/// Alignment of regions returned by `AllocateAlignedHeapRegion`, which
+/// satisfies the buffer alignment required for unbuffered (`O_DIRECT`) I/O.
+constexpr size_t kDirectIoAlignment = 4096;
+
+/// Allocates a region of memory backed by the heap, aligned to
+/// `kDirectIoAlignment`.
+///
+/// Released regions are retained, up to a limited total size, for reuse by
+/// later allocations of the same size.
+MemoryRegion AllocateAlignedHeapRegion(size_t size);
+
+/// Returns `true` if `data` points into a region returned by
+/// `MemmapFileReadOnly` that is still mapped.
+///
+/// Arrays that view such a region occupy no anonymous memory, which allows
+/// caches to account for them separately.
+bool IsFileMappedMemory(const void* data);
+
+/// Returns the total size of the regions returned by `MemmapFileReadOnly` that
+/// are still mapped.
+size_t GetFileMappedBytes();
+
+/// Records the mapping of a region by `MemmapFileReadOnly`, or its unmapping.
+void RegisterFileMapping(const char* data, size_t size);
+void UnregisterFileMapping(const char* data);
+
 }  // namespace internal_os
 }  // namespace tensorstore
 
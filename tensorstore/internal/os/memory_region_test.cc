@@ -15,13 +15,20 @@
 #include "tensorstore/internal/os/memory_region.h"
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <utility>
 
 #include <gtest/gtest.h>
 #include "absl/strings/cord.h"
 
+using ::tensorstore::internal_os::AllocateAlignedHeapRegion;
 using ::tensorstore::internal_os::AllocateHeapRegion;
+using ::tensorstore::internal_os::GetFileMappedBytes;
+using ::tensorstore::internal_os::IsFileMappedMemory;
+using ::tensorstore::internal_os::kDirectIoAlignment;
+using ::tensorstore::internal_os::RegisterFileMapping;
+using ::tensorstore::internal_os::UnregisterFileMapping;
 
 namespace {
 
@@ -47,4 +54,38 @@ TEST(MemoryRegionTest, AllocateHeapRegion) {
   absl::Cord a = std::move(region).as_cord();
 }
 
+TEST(MemoryRegionTest, AllocateAlignedHeapRegion) {
+  EXPECT_EQ(AllocateAlignedHeapRegion(0).size(), 0);
+
+  auto region = AllocateAlignedHeapRegion(4 * kDirectIoAlignment);
+  EXPECT_EQ(region.size(), 4 * kDirectIoAlignment);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(region.data()) % kDirectIoAlignment,
+            0);
+
+  // A released region is reused by the next allocation of the same size.
+  const char* data = region.data();
+  {
+    absl::Cord a = std::move(region).as_cord();
+  }
+  region = AllocateAlignedHeapRegion(4 * kDirectIoAlignment);
+  EXPECT_EQ(region.data(), data);
+}
+
+TEST(MemoryRegionTest, FileMappings) {
+  char buffer[64];
+  const size_t initial_bytes = GetFileMappedBytes();
+  EXPECT_FALSE(IsFileMappedMemory(buffer + 16));
+
+  RegisterFileMapping(buffer + 16, 32);
+  EXPECT_EQ(initial_bytes + 32, GetFileMappedBytes());
+  EXPECT_FALSE(IsFileMappedMemory(buffer + 15));
+  EXPECT_TRUE(IsFileMappedMemory(buffer + 16));
+  EXPECT_TRUE(IsFileMappedMemory(buffer + 47));
+  EXPECT_FALSE(IsFileMappedMemory(buffer + 48));
+
+  UnregisterFileMapping(buffer + 16);
+  EXPECT_EQ(initial_bytes, GetFileMappedBytes());
+  EXPECT_FALSE(IsFileMappedMemory(buffer + 16));
+}
+
 }  // namespace
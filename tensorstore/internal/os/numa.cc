@@ -0,0 +1,164 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/os/numa.h"
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/base/no_destructor.h"
+#include "absl/log/absl_log.h"
+#include "absl/status/status.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/strip.h"
+#include "tensorstore/internal/os/error_code.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+
+namespace tensorstore {
+namespace internal_os {
+namespace {
+
+thread_local int preferred_numa_node = -1;
+
+struct NumaTopology {
+  std::vector<NumaNode> nodes;
+  // Maps each cpu to the id of its node, or -1.
+  std::vector<int> cpu_to_node;
+};
+
+#ifdef __linux__
+constexpr const char kSysfsNodeDir[] = "/sys/devices/system/node";
+
+Result<std::vector<int>> ReadCpuListFile(const std::string& path) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    return absl::NotFoundError(absl::StrCat("unable to open file ", path));
+  }
+  std::string contents;
+  std::getline(file, contents);
+  return ParseCpuList(contents);
+}
+
+NumaTopology DetectNumaTopology() {
+  NumaTopology topology;
+  // The "online" file lists node ids in the same format as a cpu list.
+  auto node_ids = ReadCpuListFile(absl::StrCat(kSysfsNodeDir, "/online"));
+  if (!node_ids.ok()) return topology;
+  for (int id : *node_ids) {
+    auto cpus =
+        ReadCpuListFile(absl::StrCat(kSysfsNodeDir, "/node", id, "/cpulist"));
+    if (!cpus.ok()) {
+      ABSL_LOG(WARNING) << "Failed to read NUMA topology: " << cpus.status();
+      return NumaTopology{};
+    }
+    // Memory-only nodes are not useful for scheduling.
+    if (cpus->empty()) continue;
+    topology.nodes.push_back(NumaNode{id, *std::move(cpus)});
+  }
+  for (const auto& node : topology.nodes) {
+    const int max_cpu = node.cpus.back();
+    if (static_cast<size_t>(max_cpu) >= topology.cpu_to_node.size()) {
+      topology.cpu_to_node.resize(max_cpu + 1, -1);
+    }
+    for (int cpu : node.cpus) topology.cpu_to_node[cpu] = node.id;
+  }
+  return topology;
+}
+#else
+NumaTopology DetectNumaTopology() { return NumaTopology{}; }
+#endif
+
+const NumaTopology& GetNumaTopology() {
+  static absl::NoDestructor<NumaTopology> topology(DetectNumaTopology());
+  return *topology;
+}
+
+}  // namespace
+
+Result<std::vector<int>> ParseCpuList(std::string_view cpu_list) {
+  std::vector<int> cpus;
+  cpu_list = absl::StripAsciiWhitespace(cpu_list);
+  if (cpu_list.empty()) return cpus;
+  for (std::string_view range : absl::StrSplit(cpu_list, ',')) {
+    std::pair<std::string_view, std::string_view> bounds =
+        absl::StrSplit(range, absl::MaxSplits('-', 1));
+    int first, last;
+    if (!absl::SimpleAtoi(bounds.first, &first) || first < 0 ||
+        !absl::SimpleAtoi(bounds.second.empty() ? bounds.first : bounds.second,
+                          &last) ||
+        last < first) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Invalid cpu list: \"", cpu_list, "\""));
+    }
+    for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+  }
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+  return cpus;
+}
+
+const std::vector<NumaNode>& GetNumaNodes() { return GetNumaTopology().nodes; }
+
+int GetCurrentNumaNode() {
+#ifdef __linux__
+  const auto& cpu_to_node = GetNumaTopology().cpu_to_node;
+  const int cpu = ::sched_getcpu();
+  if (cpu < 0 || static_cast<size_t>(cpu) >= cpu_to_node.size()) return -1;
+  return cpu_to_node[cpu];
+#else
+  return -1;
+#endif
+}
+
+absl::Status SetCurrentThreadNumaNode(const NumaNode& node) {
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (int cpu : node.cpus) {
+    if (cpu < CPU_SETSIZE) CPU_SET(cpu, &cpu_set);
+  }
+  if (::sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+    return internal::StatusFromOsError(
+        errno, "Failed to set affinity to NUMA node ", node.id);
+  }
+  return absl::OkStatus();
+#else
+  return absl::UnimplementedError("Not implemented on this platform.");
+#endif
+}
+
+int GetPreferredNumaNode() { return preferred_numa_node; }
+
+ScopedPreferredNumaNode::ScopedPreferredNumaNode(int node_id)
+    : previous_(preferred_numa_node) {
+  if (node_id != -1) preferred_numa_node = node_id;
+}
+
+ScopedPreferredNumaNode::~ScopedPreferredNumaNode() {
+  preferred_numa_node = previous_;
+}
+
+}  // namespace internal_os
+}  // namespace tensorstore
@@ -0,0 +1,80 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_OS_NUMA_H_
+#define TENSORSTORE_INTERNAL_OS_NUMA_H_
+
+#include <string_view>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal_os {
+
+/// NUMA node of the machine.
+struct NumaNode {
+  /// Node number assigned by the operating system.
+  int id;
+
+  /// CPUs that belong to the node, in increasing order.
+  std::vector<int> cpus;
+};
+
+/// Parses a Linux cpu list, such as `"0-3,8,10-11"`, as used by
+/// `/sys/devices/system/node/node<N>/cpulist`.
+Result<std::vector<int>> ParseCpuList(std::string_view cpu_list);
+
+/// Returns the NUMA nodes of the machine that have CPUs.
+///
+/// The topology is detected on first use.  Returns an empty vector if the
+/// topology is not available, e.g. on platforms other than Linux.
+const std::vector<NumaNode>& GetNumaNodes();
+
+/// Returns the id of the NUMA node of the CPU currently running this thread, or
+/// `-1` if unknown.
+int GetCurrentNumaNode();
+
+/// Restricts the current thread to run on the CPUs of `node`.
+///
+/// Memory first touched by the thread is then normally allocated on `node`.
+absl::Status SetCurrentThreadNumaNode(const NumaNode& node);
+
+/// Returns the id of the NUMA node on which work submitted by the current
+/// thread should preferably run, as set by `ScopedPreferredNumaNode`, or `-1`
+/// if there is no preference.
+///
+/// This is a hint for NUMA-aware executors; other executors ignore it.
+int GetPreferredNumaNode();
+
+/// Sets the value returned by `GetPreferredNumaNode` for the current thread
+/// while in scope.  A `node_id` of `-1` leaves the current preference
+/// unchanged.
+class ScopedPreferredNumaNode {
+ public:
+  explicit ScopedPreferredNumaNode(int node_id);
+  ~ScopedPreferredNumaNode();
+
+  ScopedPreferredNumaNode(const ScopedPreferredNumaNode&) = delete;
+  ScopedPreferredNumaNode& operator=(const ScopedPreferredNumaNode&) = delete;
+
+ private:
+  int previous_;
+};
+
+}  // namespace internal_os
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_OS_NUMA_H_
@@ -0,0 +1,100 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/os/numa.h"
+
+#include <thread>  // NOLINT
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::IsOk;
+using ::tensorstore::IsOkAndHolds;
+using ::tensorstore::StatusIs;
+using ::tensorstore::internal_os::GetCurrentNumaNode;
+using ::tensorstore::internal_os::GetNumaNodes;
+using ::tensorstore::internal_os::GetPreferredNumaNode;
+using ::tensorstore::internal_os::ParseCpuList;
+using ::tensorstore::internal_os::ScopedPreferredNumaNode;
+using ::tensorstore::internal_os::SetCurrentThreadNumaNode;
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::Not;
+
+TEST(ParseCpuListTest, Valid) {
+  EXPECT_THAT(ParseCpuList(""), IsOkAndHolds(IsEmpty()));
+  EXPECT_THAT(ParseCpuList("0\n"), IsOkAndHolds(ElementsAre(0)));
+  EXPECT_THAT(ParseCpuList("0-3"), IsOkAndHolds(ElementsAre(0, 1, 2, 3)));
+  EXPECT_THAT(ParseCpuList("8,0-1,10-11"),
+              IsOkAndHolds(ElementsAre(0, 1, 8, 10, 11)));
+}
+
+TEST(ParseCpuListTest, Invalid) {
+  EXPECT_THAT(ParseCpuList("a"),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(ParseCpuList("3-1"),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(ParseCpuList("1,,2"),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(ParseCpuList("-1"),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(NumaTest, Topology) {
+  const auto& nodes = GetNumaNodes();
+  for (const auto& node : nodes) {
+    EXPECT_THAT(node.cpus, Not(IsEmpty()));
+  }
+  const int current = GetCurrentNumaNode();
+  if (nodes.empty()) {
+    EXPECT_EQ(-1, current);
+  } else {
+    EXPECT_GE(current, nodes.front().id);
+    EXPECT_LE(current, nodes.back().id);
+  }
+}
+
+TEST(NumaTest, SetCurrentThreadNumaNode) {
+  const auto& nodes = GetNumaNodes();
+  if (nodes.empty()) GTEST_SKIP() << "NUMA topology not available";
+  std::thread thread([&] {
+    EXPECT_THAT(SetCurrentThreadNumaNode(nodes.back()), IsOk());
+    EXPECT_EQ(nodes.back().id, GetCurrentNumaNode());
+  });
+  thread.join();
+}
+
+TEST(NumaTest, ScopedPreferredNumaNode) {
+  EXPECT_EQ(-1, GetPreferredNumaNode());
+  {
+    ScopedPreferredNumaNode outer(1);
+    EXPECT_EQ(1, GetPreferredNumaNode());
+    {
+      ScopedPreferredNumaNode inner(-1);
+      EXPECT_EQ(1, GetPreferredNumaNode());
+    }
+    {
+      ScopedPreferredNumaNode inner(2);
+      EXPECT_EQ(2, GetPreferredNumaNode());
+    }
+    EXPECT_EQ(1, GetPreferredNumaNode());
+  }
+  EXPECT_EQ(-1, GetPreferredNumaNode());
+}
+
+}  // namespace
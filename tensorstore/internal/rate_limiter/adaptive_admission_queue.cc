@@ -0,0 +1,75 @@
+// Copyright 2022 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/rate_limiter/adaptive_admission_queue.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/rate_limiter/admission_queue.h"
+#include "tensorstore/internal/rate_limiter/rate_limiter.h"
+
+namespace tensorstore {
+namespace internal {
+
+AdaptiveAdmissionQueue::AdaptiveAdmissionQueue(
+    const AdaptiveConcurrencyOptions& options, size_t max_limit)
+    : AdaptiveAdmissionQueue(options, max_limit, &absl::Now) {}
+
+AdaptiveAdmissionQueue::AdaptiveAdmissionQueue(
+    const AdaptiveConcurrencyOptions& options, size_t max_limit,
+    std::function<absl::Time()> clock)
+    : AdmissionQueue(std::clamp(options.initial_limit, options.min_limit,
+                                std::max(options.min_limit, max_limit))),
+      min_limit_(options.min_limit),
+      max_limit_(std::max(options.min_limit, max_limit)),
+      clock_(std::move(clock)),
+      window_(static_cast<double>(limit())) {}
+
+void AdaptiveAdmissionQueue::Finish(RateLimiterNode* node) {
+  AdmissionQueue::Finish(node);
+
+  size_t new_limit;
+  {
+    absl::MutexLock lock(&window_mutex_);
+    const size_t old_limit = static_cast<size_t>(window_);
+    window_ = std::min(window_ + 1.0 / window_,
+                       static_cast<double>(max_limit_));
+    new_limit = static_cast<size_t>(window_);
+    if (new_limit == old_limit) return;
+  }
+  SetLimit(new_limit);
+}
+
+void AdaptiveAdmissionQueue::OnThrottled() {
+  size_t new_limit;
+  {
+    absl::MutexLock lock(&window_mutex_);
+    const absl::Time now = clock_();
+    if (now - last_decrease_ < kDecreaseInterval) return;
+    last_decrease_ = now;
+    window_ = std::max(window_ / 2, static_cast<double>(min_limit_));
+    new_limit = static_cast<size_t>(window_);
+  }
+  SetLimit(new_limit);
+}
+
+}  // namespace internal
+}  // namespace tensorstore
@@ -0,0 +1,135 @@
+// Copyright 2022 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_RATE_LIMITER_ADAPTIVE_ADMISSION_QUEUE_H_
+#define TENSORSTORE_INTERNAL_RATE_LIMITER_ADAPTIVE_ADMISSION_QUEUE_H_
+
+#include <stddef.h>
+
+#include <functional>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/internal/rate_limiter/admission_queue.h"
+#include "tensorstore/internal/rate_limiter/rate_limiter.h"
+
+namespace tensorstore {
+namespace internal {
+
+/// Specifies an adaptive concurrency limit.
+struct AdaptiveConcurrencyOptions {
+  /// Whether the concurrency limit adapts to throttling responses.
+  bool enabled = false;
+
+  /// Initial concurrency limit.
+  size_t initial_limit = 8;
+
+  /// Lower bound of the concurrency limit.
+  size_t min_limit = 1;
+
+  constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+    return f(x.enabled, x.initial_limit, x.min_limit);
+  };
+
+  constexpr static auto default_json_binder = internal_json_binding::Object(
+      internal_json_binding::Member(
+          "enabled",
+          internal_json_binding::Projection<
+              &AdaptiveConcurrencyOptions::enabled>(
+              internal_json_binding::DefaultValue<
+                  internal_json_binding::kNeverIncludeDefaults>(
+                  [](auto* v) { *v = false; }))),
+      internal_json_binding::Member(
+          "initial_limit",
+          internal_json_binding::Projection<
+              &AdaptiveConcurrencyOptions::initial_limit>(
+              internal_json_binding::DefaultValue<
+                  internal_json_binding::kNeverIncludeDefaults>(
+                  [](auto* v) { *v = 8; },
+                  internal_json_binding::Integer<size_t>(1)))),
+      internal_json_binding::Member(
+          "min_limit",
+          internal_json_binding::Projection<
+              &AdaptiveConcurrencyOptions::min_limit>(
+              internal_json_binding::DefaultValue<
+                  internal_json_binding::kNeverIncludeDefaults>(
+                  [](auto* v) { *v = 1; },
+                  internal_json_binding::Integer<size_t>(1)))),
+      internal_json_binding::Initialize(
+          [](AdaptiveConcurrencyOptions* x) {
+            if (x->min_limit > x->initial_limit) {
+              return absl::InvalidArgumentError(
+                  "Expected min_limit <= initial_limit");
+            }
+            return absl::OkStatus();
+          }));
+};
+
+/// AdaptiveAdmissionQueue is an `AdmissionQueue` whose limit is adjusted by
+/// additive-increase/multiplicative-decrease (AIMD): each completed operation
+/// raises the limit by `1 / limit`, i.e. by about one per round trip, while
+/// each throttling signal (e.g. HTTP 429 or 503) halves it.  Decreases are
+/// applied at most once per `kDecreaseInterval`, so that a burst of throttling
+/// responses to requests issued under the previous limit counts once.
+///
+/// Since throughput is bounded by concurrency / latency, lowering the limit
+/// also lowers the request rate.
+class AdaptiveAdmissionQueue : public AdmissionQueue {
+ public:
+  constexpr static absl::Duration kDecreaseInterval = absl::Seconds(1);
+
+  /// Constructs an AdaptiveAdmissionQueue with a limit of
+  /// `options.initial_limit` which is kept within
+  /// `[options.min_limit, max_limit]`.
+  AdaptiveAdmissionQueue(const AdaptiveConcurrencyOptions& options,
+                         size_t max_limit);
+
+  // Test constructor.
+  AdaptiveAdmissionQueue(const AdaptiveConcurrencyOptions& options,
+                         size_t max_limit, std::function<absl::Time()> clock);
+
+  ~AdaptiveAdmissionQueue() override = default;
+
+  /// Marks a task node for completion, and raises the limit.
+  void Finish(RateLimiterNode* node) override;
+
+  /// Signals that a request was throttled, which lowers the limit.
+  void OnThrottled();
+
+ private:
+  const size_t min_limit_;
+  const size_t max_limit_;
+  const std::function<absl::Time()> clock_;
+
+  absl::Mutex window_mutex_;
+  double window_ ABSL_GUARDED_BY(window_mutex_);
+  absl::Time last_decrease_ ABSL_GUARDED_BY(window_mutex_) =
+      absl::InfinitePast();
+};
+
+/// Returns whether `status` indicates that a request was throttled by the
+/// server, as with HTTP 429 or 503.
+inline bool IsThrottled(const absl::Status& status) {
+  return status.code() == absl::StatusCode::kResourceExhausted ||
+         status.code() == absl::StatusCode::kUnavailable;
+}
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_RATE_LIMITER_ADAPTIVE_ADMISSION_QUEUE_H_
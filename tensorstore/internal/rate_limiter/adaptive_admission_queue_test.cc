@@ -0,0 +1,139 @@
+// Copyright 2022 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/rate_limiter/adaptive_admission_queue.h"
+
+#include <stddef.h>
+
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/json_binding/gtest.h"
+#include "tensorstore/internal/rate_limiter/rate_limiter.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::internal::adopt_object_ref;
+using ::tensorstore::internal::AdaptiveAdmissionQueue;
+using ::tensorstore::internal::AdaptiveConcurrencyOptions;
+using ::tensorstore::internal::AtomicReferenceCount;
+using ::tensorstore::internal::IntrusivePtr;
+using ::tensorstore::internal::MakeIntrusivePtr;
+using ::tensorstore::internal::RateLimiter;
+using ::tensorstore::internal::RateLimiterNode;
+
+struct Node : public RateLimiterNode, public AtomicReferenceCount<Node> {
+  RateLimiter* queue_;
+  bool started_ = false;
+
+  explicit Node(RateLimiter* queue) : queue_(queue) {}
+
+  ~Node() { queue_->Finish(this); }
+
+  static void Start(RateLimiterNode* task) {
+    static_cast<Node*>(task)->started_ = true;
+  }
+};
+
+AdaptiveConcurrencyOptions Options(size_t initial_limit, size_t min_limit) {
+  AdaptiveConcurrencyOptions options;
+  options.enabled = true;
+  options.initial_limit = initial_limit;
+  options.min_limit = min_limit;
+  return options;
+}
+
+TEST(AdaptiveAdmissionQueueTest, AdditiveIncrease) {
+  AdaptiveAdmissionQueue queue(Options(2, 1), 3);
+  EXPECT_EQ(2, queue.limit());
+
+  // About `limit` completions raise the limit by one.
+  for (int i = 0; i < 3; ++i) {
+    auto node = MakeIntrusivePtr<Node>(&queue);
+    queue.Admit(node.get(), &Node::Start);
+    EXPECT_TRUE(node->started_);
+  }
+  EXPECT_EQ(3, queue.limit());
+
+  // The limit does not exceed the maximum.
+  for (int i = 0; i < 10; ++i) {
+    auto node = MakeIntrusivePtr<Node>(&queue);
+    queue.Admit(node.get(), &Node::Start);
+  }
+  EXPECT_EQ(3, queue.limit());
+}
+
+TEST(AdaptiveAdmissionQueueTest, MultiplicativeDecrease) {
+  absl::Time now = absl::Now();
+  AdaptiveAdmissionQueue queue(Options(8, 3), 32, [&now] { return now; });
+  EXPECT_EQ(8, queue.limit());
+
+  queue.OnThrottled();
+  EXPECT_EQ(4, queue.limit());
+
+  // Further signals within the decrease interval are ignored.
+  queue.OnThrottled();
+  EXPECT_EQ(4, queue.limit());
+
+  now += AdaptiveAdmissionQueue::kDecreaseInterval;
+  queue.OnThrottled();
+  EXPECT_EQ(3, queue.limit());
+}
+
+TEST(AdaptiveAdmissionQueueTest, QueuedUntilIncrease) {
+  absl::Time now = absl::Now();
+  AdaptiveAdmissionQueue queue(Options(2, 1), 2, [&now] { return now; });
+  queue.OnThrottled();
+  EXPECT_EQ(1, queue.limit());
+
+  std::vector<IntrusivePtr<Node>> nodes;
+  for (int i = 0; i < 3; ++i) {
+    nodes.push_back(MakeIntrusivePtr<Node>(&queue));
+    queue.Admit(nodes.back().get(), &Node::Start);
+  }
+  EXPECT_TRUE(nodes[0]->started_);
+  EXPECT_FALSE(nodes[1]->started_);
+  EXPECT_FALSE(nodes[2]->started_);
+
+  // Completing the first node raises the limit to 2, which starts both.
+  nodes[0].reset();
+  EXPECT_EQ(2, queue.limit());
+  EXPECT_TRUE(nodes[1]->started_);
+  EXPECT_TRUE(nodes[2]->started_);
+  nodes.clear();
+}
+
+TEST(AdaptiveConcurrencyOptionsTest, JsonBinding) {
+  tensorstore::TestJsonBinderRoundTripJsonOnly<AdaptiveConcurrencyOptions>({
+      ::nlohmann::json::object_t(),
+      {{"enabled", true}},
+      {{"enabled", true}, {"initial_limit", 16}, {"min_limit", 2}},
+  });
+  tensorstore::TestJsonBinderFromJson<AdaptiveConcurrencyOptions>({
+      {{{"initial_limit", 2}, {"min_limit", 4}},
+       MatchesStatus(absl::StatusCode::kInvalidArgument,
+                     ".*min_limit <= initial_limit.*")},
+  });
+}
+
+}  // namespace
@@ -15,26 +15,30 @@
 #include "tensorstore/internal/rate_limiter/admission_queue.h"
 
 #include <stddef.h>
+#include <stdint.h>
 
+#include <algorithm>
 #include <cassert>
 #include <limits>
+#include <memory>
 
 #include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
 #include "tensorstore/internal/container/intrusive_linked_list.h"
 #include "tensorstore/internal/rate_limiter/rate_limiter.h"
+#include "tensorstore/internal/thread/task_priority.h"
 
 namespace tensorstore {
 namespace internal {
 
 AdmissionQueue::AdmissionQueue(size_t limit)
-    : limit_(limit == 0 ? std::numeric_limits<size_t>::max() : limit) {
-  internal::intrusive_linked_list::Initialize(RateLimiterNodeAccessor{},
-                                              &head_);
-}
+    : limit_(limit == 0 ? std::numeric_limits<size_t>::max() : limit) {}
 
 AdmissionQueue::~AdmissionQueue() {
   absl::MutexLock l(&mutex_);
-  assert(head_.next_ == &head_);
+  for (auto& queue : queues_) {
+    assert(queue.tenants.empty());
+  }
 }
 
 void AdmissionQueue::Admit(RateLimiterNode* node, RateLimiterNode::StartFn fn) {
@@ -46,8 +50,20 @@ void AdmissionQueue::Admit(RateLimiterNode* node, RateLimiterNode::StartFn fn) {
   {
     absl::MutexLock lock(&mutex_);
     if (in_flight_ + 1 > limit_) {
-      internal::intrusive_linked_list::InsertBefore(RateLimiterNodeAccessor{},
-                                                    &head_, node);
+      node->enqueue_nanos_ = absl::GetCurrentTimeNanos();
+      auto& queue = queues_[static_cast<size_t>(node->priority_)];
+      auto& tenant_queue = queue.tenants[node->tenant_.id];
+      if (!tenant_queue) {
+        // A tenant with no pending operations starts at the current virtual
+        // time, without credit for the time that it was idle.
+        tenant_queue = std::make_unique<TenantQueue>();
+        internal::intrusive_linked_list::Initialize(RateLimiterNodeAccessor{},
+                                                    &tenant_queue->head);
+        tenant_queue->virtual_time = queue.virtual_time;
+        queue.order.emplace(queue.virtual_time, node->tenant_.id);
+      }
+      internal::intrusive_linked_list::InsertBefore(
+          RateLimiterNodeAccessor{}, &tenant_queue->head, node);
       return;
     }
     in_flight_++;
@@ -61,17 +77,59 @@ void AdmissionQueue::Finish(RateLimiterNode* node) {
 
   absl::MutexLock lock(&mutex_);
   in_flight_--;
+  StartQueued();
+}
 
+void AdmissionQueue::SetLimit(size_t limit) {
+  absl::MutexLock lock(&mutex_);
+  limit_ = limit == 0 ? std::numeric_limits<size_t>::max() : limit;
+  StartQueued();
+}
+
+void AdmissionQueue::StartQueued() {
   // Typically this loop will admit only a single node at a time.
   RateLimiterNode* next_node = nullptr;
   while (true) {
-    next_node = head_.next_;
-    if (next_node == &head_) return;
     if (in_flight_ + 1 > limit_) return;
+    // Select the front node of the tenant with the earliest virtual time, of
+    // the queue with the highest effective priority.
+    next_node = nullptr;
+    PriorityQueue* next_queue = nullptr;
+    int64_t next_priority = -1;
+    int64_t now_nanos = 0;
+    for (size_t i = kNumTaskPriorities; i-- > 0;) {
+      auto& queue = queues_[i];
+      if (queue.order.empty()) continue;
+      RateLimiterNode* front =
+          queue.tenants.find(queue.order.begin()->second)->second->head.next_;
+      if (now_nanos == 0) now_nanos = absl::GetCurrentTimeNanos();
+      const int64_t priority = GetEffectiveTaskPriority(
+          front->priority_, front->enqueue_nanos_, now_nanos);
+      if (priority > next_priority) {
+        next_node = front;
+        next_queue = &queue;
+        next_priority = priority;
+      }
+    }
+    if (next_node == nullptr) return;
     in_flight_++;
     internal::intrusive_linked_list::Remove(RateLimiterNodeAccessor{},
                                             next_node);
 
+    // Advance the virtual time of the tenant by the inverse of its weight.
+    auto [virtual_time, tenant] = *next_queue->order.begin();
+    next_queue->order.erase(next_queue->order.begin());
+    next_queue->virtual_time = virtual_time;
+    auto it = next_queue->tenants.find(tenant);
+    TenantQueue& tenant_queue = *it->second;
+    if (tenant_queue.head.next_ == &tenant_queue.head) {
+      next_queue->tenants.erase(it);
+    } else {
+      tenant_queue.virtual_time +=
+          1.0 / std::max<uint32_t>(1, next_node->tenant_.weight);
+      next_queue->order.emplace(tenant_queue.virtual_time, tenant);
+    }
+
     // Next node gets a chance to run after clearing admission queue state.
     mutex_.Unlock();
     RunStartFunction(next_node);
@@ -16,10 +16,17 @@
 #define TENSORSTORE_INTERNAL_RATE_LIMITER_ADMISSION_QUEUE_H_
 
 #include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <utility>
 
 #include "absl/base/thread_annotations.h"
+#include "absl/container/btree_set.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/synchronization/mutex.h"
 #include "tensorstore/internal/rate_limiter/rate_limiter.h"
+#include "tensorstore/internal/thread/task_priority.h"
 
 namespace tensorstore {
 namespace internal {
@@ -34,13 +41,27 @@ namespace internal {
 /// be called when an operation starts, and `Finish` must be called when an
 /// operation completes. Operations are enqueued if limit is reached, to be
 /// started once the number of parallel operations are below limit.
+///
+/// Queued operations are started in order of their `TaskPriority`, with aging,
+/// so that interactive operations are not delayed behind a backlog of
+/// background operations.
+///
+/// Among queued operations of the same priority, the capacity is shared
+/// between tenants, as identified by the `TaskTenant` of each operation, in
+/// proportion to their weights (start-time fair queuing), so that a backlog of
+/// operations of one tenant does not delay the operations of other tenants.
+/// The operations of each tenant are started in the order in which they were
+/// queued.
 class AdmissionQueue : public RateLimiter {
  public:
   /// Construct an AdmissionQueue with `limit` parallelism.
   AdmissionQueue(size_t limit);
   ~AdmissionQueue() override;
 
-  size_t limit() const { return limit_; }
+  size_t limit() const {
+    absl::MutexLock l(&mutex_);
+    return limit_;
+  }
   size_t in_flight() const {
     absl::MutexLock l(&mutex_);
     return in_flight_;
@@ -56,11 +77,35 @@ class AdmissionQueue : public RateLimiter {
   /// queued node will have it's start function invoked.
   void Finish(RateLimiterNode* node) override;
 
+  /// Changes the parallelism limit.  When the limit is raised, queued nodes
+  /// are started; when it is lowered, in-flight operations are not affected.
+  void SetLimit(size_t limit);
+
  private:
-  const size_t limit_;
+  /// Starts queued nodes while the limit permits.
+  void StartQueued() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  /// Pending operations of one tenant at one priority.
+  struct TenantQueue {
+    RateLimiterNode head;
+    /// Virtual time at which the front operation starts.
+    double virtual_time;
+  };
+
+  /// Pending operations at one priority.
+  struct PriorityQueue {
+    /// Queues of the tenants with pending operations.
+    absl::flat_hash_map<uint64_t, std::unique_ptr<TenantQueue>> tenants;
+    /// Tenants with pending operations, ordered by virtual time.
+    absl::btree_set<std::pair<double, uint64_t>> order;
+    /// Virtual time of the most recently started operation.
+    double virtual_time = 0;
+  };
 
   mutable absl::Mutex mutex_;
-  RateLimiterNode head_ ABSL_GUARDED_BY(mutex_);
+  size_t limit_ ABSL_GUARDED_BY(mutex_);
+  // One queue of pending operations per `TaskPriority`.
+  PriorityQueue queues_[kNumTaskPriorities] ABSL_GUARDED_BY(mutex_);
   size_t in_flight_ ABSL_GUARDED_BY(mutex_) = 0;
 };
 
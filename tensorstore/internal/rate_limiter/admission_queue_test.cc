@@ -18,10 +18,13 @@
 
 #include <atomic>
 #include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/rate_limiter/rate_limiter.h"
+#include "tensorstore/internal/thread/task_priority.h"
+#include "tensorstore/internal/thread/task_tenant.h"
 #include "tensorstore/util/executor.h"
 
 namespace {
@@ -33,6 +36,10 @@ using ::tensorstore::internal::IntrusivePtr;
 using ::tensorstore::internal::MakeIntrusivePtr;
 using ::tensorstore::internal::RateLimiter;
 using ::tensorstore::internal::RateLimiterNode;
+using ::tensorstore::internal::ScopedTaskPriority;
+using ::tensorstore::internal::ScopedTaskTenant;
+using ::tensorstore::internal::TaskPriority;
+using ::tensorstore::internal::TaskTenant;
 
 /// This class holds a reference count on itself while held by a RateLimiter,
 /// and upon start will call the `task_` function.
@@ -77,4 +84,76 @@ TEST(AdmissionQueueTest, Basic) {
   EXPECT_EQ(100, done);
 }
 
+TEST(AdmissionQueueTest, Priority) {
+  AdmissionQueue queue(1);
+  std::vector<int> order;
+
+  // The first task holds the only slot until it is released.
+  auto first = MakeIntrusivePtr<Task>(&queue, [] {});
+  first->Admit();
+  EXPECT_EQ(1, queue.in_flight());
+
+  auto add_task = [&](TaskPriority priority, int id) {
+    ScopedTaskPriority scope(priority);
+    auto task = MakeIntrusivePtr<Task>(&queue, [&order, id] {
+      order.push_back(id);
+    });
+    task->Admit();
+  };
+  add_task(TaskPriority::kBackground, 0);
+  add_task(TaskPriority::kNormal, 1);
+  add_task(TaskPriority::kInteractive, 2);
+  add_task(TaskPriority::kBackground, 3);
+  add_task(TaskPriority::kInteractive, 4);
+  EXPECT_TRUE(order.empty());
+
+  first.reset();
+  EXPECT_EQ(order, (std::vector<int>{2, 4, 1, 0, 3}));
+}
+
+TEST(AdmissionQueueTest, FairShare) {
+  AdmissionQueue queue(1);
+  std::vector<int> order;
+
+  auto first = MakeIntrusivePtr<Task>(&queue, [] {});
+  first->Admit();
+
+  auto add_task = [&](TaskTenant tenant, int id) {
+    ScopedTaskTenant scope(tenant);
+    auto task = MakeIntrusivePtr<Task>(&queue, [&order, id] {
+      order.push_back(id);
+    });
+    task->Admit();
+  };
+  // Tenant 1 queues a backlog before tenant 2 queues any operations.
+  for (int id : {10, 11, 12, 13}) add_task({/*.id=*/1}, id);
+  for (int id : {20, 21}) add_task({/*.id=*/2}, id);
+  EXPECT_TRUE(order.empty());
+
+  first.reset();
+  EXPECT_EQ(order, (std::vector<int>{10, 20, 11, 21, 12, 13}));
+}
+
+TEST(AdmissionQueueTest, WeightedFairShare) {
+  AdmissionQueue queue(1);
+  std::vector<int> order;
+
+  auto first = MakeIntrusivePtr<Task>(&queue, [] {});
+  first->Admit();
+
+  auto add_task = [&](TaskTenant tenant, int id) {
+    ScopedTaskTenant scope(tenant);
+    auto task = MakeIntrusivePtr<Task>(&queue, [&order, id] {
+      order.push_back(id);
+    });
+    task->Admit();
+  };
+  // Tenant 1 has twice the share of tenant 2.
+  for (int id : {10, 11, 12, 13}) add_task({/*.id=*/1, /*.weight=*/2}, id);
+  for (int id : {20, 21, 22, 23}) add_task({/*.id=*/2}, id);
+
+  first.reset();
+  EXPECT_EQ(order, (std::vector<int>{10, 20, 11, 12, 21, 13, 22, 23}));
+}
+
 }  // namespace
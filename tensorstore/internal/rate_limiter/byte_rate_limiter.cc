@@ -0,0 +1,95 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/rate_limiter/byte_rate_limiter.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/log/absl_check.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/rate_limiter/rate_limiter.h"
+#include "tensorstore/internal/rate_limiter/token_bucket_rate_limiter.h"
+
+namespace tensorstore {
+namespace internal {
+namespace {
+
+double GetMaxBurstBytes(double bytes_per_second, double max_burst_bytes) {
+  // At least one token is needed to admit a node.
+  return std::max(1.0, max_burst_bytes > 0 ? max_burst_bytes
+                                           : bytes_per_second);
+}
+
+}  // namespace
+
+ByteRateLimiter::ByteRateLimiter(double bytes_per_second,
+                                 double max_burst_bytes)
+    : TokenBucketRateLimiter(
+          GetMaxBurstBytes(bytes_per_second, max_burst_bytes)),
+      bytes_per_second_(bytes_per_second) {
+  ABSL_CHECK_GT(bytes_per_second, std::numeric_limits<double>::min());
+  absl::MutexLock lock(&mutex_);
+  available_ = max_tokens_;
+}
+
+ByteRateLimiter::ByteRateLimiter(double bytes_per_second,
+                                 double max_burst_bytes,
+                                 std::function<absl::Time()> clock)
+    : TokenBucketRateLimiter(
+          GetMaxBurstBytes(bytes_per_second, max_burst_bytes),
+          std::move(clock)),
+      bytes_per_second_(bytes_per_second) {
+  ABSL_CHECK_GT(bytes_per_second, std::numeric_limits<double>::min());
+  absl::MutexLock lock(&mutex_);
+  available_ = max_tokens_;
+}
+
+void ByteRateLimiter::Charge(size_t bytes) {
+  if (bytes == 0) return;
+  absl::MutexLock lock(&mutex_);
+  available_ -= static_cast<double>(bytes);
+}
+
+double ByteRateLimiter::TokensToAdd(absl::Time current,
+                                    absl::Time previous) const {
+  return bytes_per_second_ * absl::ToDoubleSeconds(current - previous);
+}
+
+absl::Duration ByteRateLimiter::GetSchedulerDelay() const
+    ABSL_NO_THREAD_SAFETY_ANALYSIS {
+  // Called by `PerformWorkLocked` with `mutex_` held.
+  const double deficit = 1.0 - available_;
+  return std::max(absl::Seconds(deficit / bytes_per_second_),
+                  absl::Milliseconds(1));
+}
+
+void ByteRateLimiter::MaybeAdmit(ByteRateLimiter* limiter,
+                                 RateLimiterNode* node,
+                                 RateLimiterNode::StartFn fn) {
+  if (limiter) {
+    limiter->Admit(node, fn);
+  } else {
+    fn(node);
+  }
+}
+
+}  // namespace internal
+}  // namespace tensorstore
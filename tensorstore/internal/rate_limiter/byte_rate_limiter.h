@@ -0,0 +1,79 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_RATE_LIMITER_BYTE_RATE_LIMITER_H_
+#define TENSORSTORE_INTERNAL_RATE_LIMITER_BYTE_RATE_LIMITER_H_
+
+#include <stddef.h>
+
+#include <functional>
+
+#include "absl/time/time.h"
+#include "tensorstore/internal/rate_limiter/rate_limiter.h"
+#include "tensorstore/internal/rate_limiter/token_bucket_rate_limiter.h"
+
+namespace tensorstore {
+namespace internal {
+
+/// ByteRateLimiter implements a token-bucket rate-limiter of bytes per second,
+/// e.g. to keep a few large reads from saturating the network bandwidth shared
+/// with small, latency-sensitive requests.
+///
+/// Unlike the request rate-limiters, the tokens are bytes, which requests
+/// consume by calling `Charge` once their size is known, possibly in several
+/// parts as data is transferred.  The bucket may thereby go into debt, and
+/// nodes are only admitted while it is not in debt, so that later requests are
+/// delayed until the bytes already transferred have been paid for.
+///
+/// A `ByteRateLimiter` is typically used in addition to a request
+/// rate-limiter and an `AdmissionQueue`, with each node passing through all of
+/// them in turn.
+class ByteRateLimiter : public TokenBucketRateLimiter {
+ public:
+  /// Constructs a ByteRateLimiter which allows `bytes_per_second` on average,
+  /// and bursts of up to `max_burst_bytes`, which defaults to one second's
+  /// worth.  The bucket is initially full.
+  explicit ByteRateLimiter(double bytes_per_second,
+                           double max_burst_bytes = 0);
+
+  // Test constructor.
+  ByteRateLimiter(double bytes_per_second, double max_burst_bytes,
+                  std::function<absl::Time()> clock);
+
+  ~ByteRateLimiter() override = default;
+
+  /// Accessors.
+  double bytes_per_second() const { return bytes_per_second_; }
+
+  /// Consumes `bytes` from the bucket.
+  void Charge(size_t bytes);
+
+  double TokensToAdd(absl::Time current, absl::Time previous) const override;
+
+  // Returns the delay until the bucket is expected to be out of debt.
+  absl::Duration GetSchedulerDelay() const override;
+
+  /// Admits `node` to `limiter`, or starts it immediately if `limiter` is
+  /// null.
+  static void MaybeAdmit(ByteRateLimiter* limiter, RateLimiterNode* node,
+                         RateLimiterNode::StartFn fn);
+
+ private:
+  const double bytes_per_second_;
+};
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_RATE_LIMITER_BYTE_RATE_LIMITER_H_
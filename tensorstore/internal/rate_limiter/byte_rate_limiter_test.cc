@@ -0,0 +1,104 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/rate_limiter/byte_rate_limiter.h"
+
+#include <stddef.h>
+
+#include <utility>
+
+#include <gtest/gtest.h>
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/rate_limiter/rate_limiter.h"
+#include "tensorstore/util/executor.h"
+
+namespace {
+
+using ::tensorstore::ExecutorTask;
+using ::tensorstore::internal::adopt_object_ref;
+using ::tensorstore::internal::AtomicReferenceCount;
+using ::tensorstore::internal::ByteRateLimiter;
+using ::tensorstore::internal::IntrusivePtr;
+using ::tensorstore::internal::MakeIntrusivePtr;
+using ::tensorstore::internal::NoRateLimiter;
+using ::tensorstore::internal::RateLimiter;
+using ::tensorstore::internal::RateLimiterNode;
+
+struct Node : public RateLimiterNode, public AtomicReferenceCount<Node> {
+  RateLimiter* queue_;
+  ExecutorTask task_;
+
+  Node(RateLimiter* queue, ExecutorTask task)
+      : queue_(queue), task_(std::move(task)) {}
+
+  ~Node() { queue_->Finish(this); }
+
+  static void Start(RateLimiterNode* task) {
+    IntrusivePtr<Node> self(static_cast<Node*>(task), adopt_object_ref);
+    std::move(self->task_)();
+  }
+};
+
+TEST(ByteRateLimiterTest, Basic) {
+  absl::Time now = absl::Now();
+  ByteRateLimiter limiter(1000, 2000, [&now]() { return now; });
+
+  EXPECT_EQ(1000, limiter.bytes_per_second());
+  EXPECT_EQ(2000, limiter.available());
+  EXPECT_EQ(500, limiter.TokensToAdd(now + absl::Milliseconds(500), now));
+
+  size_t done = 0;
+  auto admit = [&] {
+    auto node = MakeIntrusivePtr<Node>(&limiter, [&done] { done++; });
+    intrusive_ptr_increment(node.get());  // adopted by Node::Start.
+    limiter.Admit(node.get(), &Node::Start);
+  };
+
+  // Nodes are admitted while the bucket is not in debt.
+  admit();
+  EXPECT_EQ(1, done);
+  limiter.Charge(5000);
+  EXPECT_EQ(-3001, limiter.available());
+  admit();
+  EXPECT_EQ(1, done);
+
+  now += absl::Seconds(2);
+  limiter.PeriodicCallForTesting();
+  EXPECT_EQ(1, done);
+
+  // The debt is paid off after 3 seconds.
+  now += absl::Seconds(2);
+  limiter.PeriodicCallForTesting();
+  EXPECT_EQ(2, done);
+  EXPECT_EQ(998, limiter.available());
+
+  // The bucket does not fill beyond the maximum burst.
+  now += absl::Seconds(10);
+  admit();
+  EXPECT_EQ(3, done);
+  EXPECT_EQ(1999, limiter.available());
+}
+
+TEST(ByteRateLimiterTest, MaybeAdmitWithoutLimiter) {
+  NoRateLimiter no_limiter;
+  size_t done = 0;
+  auto node = MakeIntrusivePtr<Node>(&no_limiter, [&done] { done++; });
+  intrusive_ptr_increment(node.get());  // adopted by Node::Start.
+  ByteRateLimiter::MaybeAdmit(nullptr, node.get(), &Node::Start);
+  EXPECT_EQ(1, done);
+}
+
+}  // namespace
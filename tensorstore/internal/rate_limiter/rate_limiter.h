@@ -15,7 +15,11 @@
 #ifndef TENSORSTORE_INTERNAL_RATE_LIMITER_RATE_LIMITER_H_
 #define TENSORSTORE_INTERNAL_RATE_LIMITER_RATE_LIMITER_H_
 
+#include <stdint.h>
+
 #include "tensorstore/internal/container/intrusive_linked_list.h"
+#include "tensorstore/internal/thread/task_priority.h"
+#include "tensorstore/internal/thread/task_tenant.h"
 
 namespace tensorstore {
 namespace internal {
@@ -27,12 +31,18 @@ namespace internal {
 /// Generally, a RateLimiterNode will also be reference counted, however neither
 /// the RateLimiterNode nor the RateLimiter class manage any reference counts.
 /// Callers should manage reference counts externally.
+///
+/// A node records the `TaskPriority` and `TaskTenant` of the thread that
+/// creates it, which rate limiters may use to order pending operations.
 struct RateLimiterNode {
   using StartFn = void (*)(RateLimiterNode*);
 
   RateLimiterNode* next_ = nullptr;
   RateLimiterNode* prev_ = nullptr;
   StartFn start_fn_ = nullptr;
+  TaskPriority priority_ = GetCurrentTaskPriority();
+  TaskTenant tenant_ = GetCurrentTaskTenant();
+  int64_t enqueue_nanos_ = 0;
 };
 
 using RateLimiterNodeAccessor = internal::intrusive_linked_list::MemberAccessor<
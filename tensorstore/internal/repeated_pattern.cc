@@ -0,0 +1,58 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/repeated_pattern.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace tensorstore {
+namespace internal {
+namespace {
+
+// Size of the prefix of `data` against which the remainder is compared.
+// Large enough to amortize the `memcmp` calls, and small enough to remain
+// in L1 cache.
+constexpr size_t kMaxPrefixSize = 4096;
+
+}  // namespace
+
+bool IsRepeatedPattern(const void* data, size_t size, const void* pattern,
+                       size_t pattern_size) {
+  assert(pattern_size > 0);
+  assert(size % pattern_size == 0);
+  if (size == 0) return true;
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  if (std::memcmp(bytes, pattern, pattern_size) != 0) return false;
+  // Double the checked prefix until it reaches `kMaxPrefixSize`.  The prefix
+  // remains a multiple of `pattern_size`.
+  size_t prefix_size = pattern_size;
+  while (prefix_size < size) {
+    const size_t n = std::min(prefix_size, size - prefix_size);
+    if (std::memcmp(bytes + prefix_size, bytes, n) != 0) return false;
+    prefix_size += n;
+    if (prefix_size >= kMaxPrefixSize) break;
+  }
+  for (size_t offset = prefix_size; offset < size; offset += prefix_size) {
+    const size_t n = std::min(prefix_size, size - offset);
+    if (std::memcmp(bytes + offset, bytes, n) != 0) return false;
+  }
+  return true;
+}
+
+}  // namespace internal
+}  // namespace tensorstore
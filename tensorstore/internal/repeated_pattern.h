@@ -0,0 +1,37 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_REPEATED_PATTERN_H_
+#define TENSORSTORE_INTERNAL_REPEATED_PATTERN_H_
+
+#include <stddef.h>
+
+namespace tensorstore {
+namespace internal {
+
+/// Checks if the `size` bytes at `data` consist of repetitions of the
+/// `pattern_size` bytes at `pattern`.
+///
+/// `size` must be a multiple of `pattern_size`, which must be non-zero.
+///
+/// Once a prefix of `data` has been checked against `pattern`, the remainder
+/// is compared against that prefix using `memcmp`, which is vectorized,
+/// rather than one repetition at a time.
+bool IsRepeatedPattern(const void* data, size_t size, const void* pattern,
+                       size_t pattern_size);
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_REPEATED_PATTERN_H_
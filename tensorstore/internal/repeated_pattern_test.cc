@@ -0,0 +1,62 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/repeated_pattern.h"
+
+#include <stddef.h>
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+using ::tensorstore::internal::IsRepeatedPattern;
+
+std::string Repeat(const std::string& pattern, size_t count) {
+  std::string result;
+  for (size_t i = 0; i < count; ++i) result += pattern;
+  return result;
+}
+
+TEST(IsRepeatedPatternTest, Empty) {
+  EXPECT_TRUE(IsRepeatedPattern(nullptr, 0, "abc", 3));
+}
+
+TEST(IsRepeatedPatternTest, Basic) {
+  EXPECT_TRUE(IsRepeatedPattern("abc", 3, "abc", 3));
+  EXPECT_FALSE(IsRepeatedPattern("abd", 3, "abc", 3));
+  EXPECT_TRUE(IsRepeatedPattern("abcabc", 6, "abc", 3));
+  EXPECT_FALSE(IsRepeatedPattern("abcabd", 6, "abc", 3));
+  EXPECT_FALSE(IsRepeatedPattern("abcbbc", 6, "abc", 3));
+}
+
+TEST(IsRepeatedPatternTest, Large) {
+  // Sizes that exercise both the doubling of the prefix and the comparison
+  // of the remainder against it, including a partial final block.
+  for (size_t count : {1, 2, 3, 7, 1365, 1366, 1367, 5000}) {
+    SCOPED_TRACE(count);
+    std::string data = Repeat("xyz", count);
+    EXPECT_TRUE(IsRepeatedPattern(data.data(), data.size(), "xyz", 3));
+    for (size_t i : {size_t{0}, data.size() / 2, data.size() - 1}) {
+      SCOPED_TRACE(i);
+      std::string modified = data;
+      modified[i] = 'w';
+      EXPECT_FALSE(
+          IsRepeatedPattern(modified.data(), modified.size(), "xyz", 3));
+    }
+  }
+}
+
+}  // namespace
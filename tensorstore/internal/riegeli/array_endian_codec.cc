@@ -34,6 +34,7 @@
 #include "tensorstore/contiguous_layout.h"
 #include "tensorstore/data_type.h"
 #include "tensorstore/index.h"
+#include "tensorstore/internal/chunk_buffer_pool.h"
 #include "tensorstore/internal/elementwise_function.h"
 #include "tensorstore/internal/metrics/counter.h"
 #include "tensorstore/internal/metrics/metadata.h"
@@ -212,7 +213,8 @@ Result<SharedArray<const void>> DecodeArrayEndian(
 
   // Copying (and possibly endian conversion) is required.
   auto decoded =
-      tensorstore::AllocateArray(decoded_shape, order, default_init, dtype);
+      internal::AllocateChunkArray(internal::GetCurrentChunkBufferPool(),
+                                   decoded_shape, order, default_init, dtype);
 
   TENSORSTORE_RETURN_IF_ERROR(
       DecodeArrayEndian(reader, encoded_endian, order, decoded));
@@ -0,0 +1,77 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_THREAD_FORK_REGISTRY_H_
+#define TENSORSTORE_INTERNAL_THREAD_FORK_REGISTRY_H_
+
+#include <algorithm>
+#include <new>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+
+namespace tensorstore {
+namespace internal_thread_impl {
+
+/// Set of the live instances of `T`, whose threads must be restarted in the
+/// child process after `fork()` when fork support is enabled.
+///
+/// `T` must define `PrepareFork`, `ParentAfterFork` and `ChildAfterFork`
+/// methods, which are called on each instance by the corresponding methods of
+/// the registry from the handlers registered with
+/// `internal_os::RegisterForkHandlers`.  The registry remains locked from
+/// `PrepareFork` until after the fork, so that instances are neither added nor
+/// removed in the meantime.
+template <typename T>
+class ForkRegistry {
+ public:
+  void Add(T* instance) {
+    absl::MutexLock lock(&mutex_);
+    instances_.push_back(instance);
+  }
+
+  void Remove(T* instance) {
+    absl::MutexLock lock(&mutex_);
+    instances_.erase(
+        std::find(instances_.begin(), instances_.end(), instance));
+  }
+
+  void PrepareFork() ABSL_NO_THREAD_SAFETY_ANALYSIS {
+    mutex_.Lock();
+    for (T* instance : instances_) instance->PrepareFork();
+  }
+
+  void ParentAfterFork() ABSL_NO_THREAD_SAFETY_ANALYSIS {
+    for (T* instance : instances_) instance->ParentAfterFork();
+    mutex_.Unlock();
+  }
+
+  void ChildAfterFork() ABSL_NO_THREAD_SAFETY_ANALYSIS {
+    for (T* instance : instances_) instance->ChildAfterFork();
+    // Only the forking thread exists in the child process, so the mutex,
+    // which may still list other threads as waiters, is reinitialized rather
+    // than unlocked.
+    new (&mutex_) absl::Mutex;
+  }
+
+ private:
+  absl::Mutex mutex_;
+  std::vector<T*> instances_ ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace internal_thread_impl
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_THREAD_FORK_REGISTRY_H_
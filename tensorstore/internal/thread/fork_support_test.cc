@@ -0,0 +1,80 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#if !defined(_WIN32)
+#define TENSORSTORE_INTERNAL_ENABLE_FORK_TEST 1
+#endif
+
+#if defined(TENSORSTORE_INTERNAL_ENABLE_FORK_TEST)
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/synchronization/notification.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/os/fork_detection.h"
+#include "tensorstore/internal/thread/schedule_at.h"
+#include "tensorstore/internal/thread/thread_pool.h"
+#include "tensorstore/util/executor.h"
+
+namespace {
+
+using ::tensorstore::Executor;
+using ::tensorstore::internal::DetachedThreadPool;
+using ::tensorstore::internal::ScheduleAt;
+using ::tensorstore::internal::WorkStealingThreadPool;
+using ::tensorstore::internal_os::EnableForkSupport;
+
+// Runs a task on each of `executors`, and one with `ScheduleAt`.  Returns
+// `true` if all of them complete.
+bool RunTasks(const std::vector<Executor>& executors) {
+  for (const auto& executor : executors) {
+    absl::Notification done;
+    executor([&] { done.Notify(); });
+    if (!done.WaitForNotificationWithTimeout(absl::Seconds(10))) return false;
+  }
+  absl::Notification done;
+  ScheduleAt(absl::Now() + absl::Milliseconds(1), [&] { done.Notify(); });
+  return done.WaitForNotificationWithTimeout(absl::Seconds(10));
+}
+
+TEST(ForkSupportTest, ChildRunsTasks) {
+  EnableForkSupport();
+  std::vector<Executor> executors{DetachedThreadPool(4),
+                                  WorkStealingThreadPool(4)};
+
+  // Start the threads in the parent process.
+  ASSERT_TRUE(RunTasks(executors));
+
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    _exit(RunTasks(executors) ? 0 : 1);
+  }
+  int status = 0;
+  ASSERT_EQ(pid, waitpid(pid, &status, 0));
+  ASSERT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(0, WEXITSTATUS(status));
+
+  // The parent process is unaffected.
+  EXPECT_TRUE(RunTasks(executors));
+}
+
+}  // namespace
+
+#endif  // TENSORSTORE_INTERNAL_ENABLE_FORK_TEST
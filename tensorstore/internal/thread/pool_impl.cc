@@ -19,9 +19,11 @@
 
 #include <algorithm>
 #include <cassert>
+#include <new>
 #include <utility>
 
 #include "absl/base/attributes.h"
+#include "absl/base/no_destructor.h"
 #include "absl/base/thread_annotations.h"
 #include "absl/log/absl_log.h"
 #include "absl/synchronization/mutex.h"
@@ -32,6 +34,7 @@
 #include "tensorstore/internal/metrics/counter.h"
 #include "tensorstore/internal/metrics/gauge.h"
 #include "tensorstore/internal/metrics/metadata.h"
+#include "tensorstore/internal/thread/fork_registry.h"
 #include "tensorstore/internal/thread/task_provider.h"
 #include "tensorstore/internal/thread/thread.h"
 
@@ -54,6 +57,11 @@ auto& thread_pool_active = internal_metrics::Gauge<int64_t>::New(
     "/tensorstore/thread_pool/active",
     MetricMetadata("Active threads managed by SharedThreadPool"));
 
+auto& thread_pool_idle = internal_metrics::Gauge<int64_t>::New(
+    "/tensorstore/thread_pool/idle",
+    MetricMetadata("Idle threads managed by SharedThreadPool, which are "
+                   "waiting for a TaskProvider"));
+
 auto& thread_pool_task_providers = internal_metrics::Gauge<int64_t>::New(
     "/tensorstore/thread_pool/task_providers",
     MetricMetadata("TaskProviders requesting threads from SharedThreadPool"));
@@ -64,6 +72,36 @@ ABSL_CONST_INIT internal_log::VerboseFlag thread_pool_logging("thread_pool");
 
 SharedThreadPool::SharedThreadPool() : waiting_(128) {
   ABSL_LOG_IF(INFO, thread_pool_logging) << "SharedThreadPool: " << this;
+  fork_registry().Add(this);
+}
+
+SharedThreadPool::~SharedThreadPool() { fork_registry().Remove(this); }
+
+ForkRegistry<SharedThreadPool>& SharedThreadPool::fork_registry() {
+  static absl::NoDestructor<ForkRegistry<SharedThreadPool>> registry;
+  return *registry;
+}
+
+void SharedThreadPool::PrepareFork() { mutex_.Lock(); }
+
+void SharedThreadPool::ParentAfterFork() { mutex_.Unlock(); }
+
+void SharedThreadPool::ChildAfterFork() ABSL_NO_THREAD_SAFETY_ANALYSIS {
+  // Only the forking thread exists in the child process, so the mutex and
+  // condition variable, which may still list the other threads as waiters,
+  // are reinitialized rather than unlocked.  The waiting task providers are
+  // retained and are assigned to new threads once they notify the pool.
+  new (&mutex_) absl::Mutex;
+  new (&overseer_condvar_) absl::CondVar;
+  absl::MutexLock lock(&mutex_);
+  worker_threads_ = 0;
+  idle_threads_ = 0;
+  overseer_running_ = false;
+  last_thread_start_time_ = absl::InfinitePast();
+  last_thread_exit_time_ = absl::InfinitePast();
+  queue_assignment_time_ = absl::InfinitePast();
+  thread_pool_active.Set(0);
+  thread_pool_idle.Set(0);
 }
 
 void SharedThreadPool::NotifyWorkAvailable(
@@ -189,8 +227,14 @@ void SharedThreadPool::Worker::operator()() const {
 void SharedThreadPool::Worker::WorkerBody() {
   struct ScopedIncDec {
     size_t& x_;
-    ScopedIncDec(size_t& x) : x_(x) { x_++; }
-    ~ScopedIncDec() { x_--; }
+    ScopedIncDec(size_t& x) : x_(x) {
+      x_++;
+      thread_pool_idle.Increment();
+    }
+    ~ScopedIncDec() {
+      x_--;
+      thread_pool_idle.Decrement();
+    }
   };
 
   thread_pool_active.Increment();
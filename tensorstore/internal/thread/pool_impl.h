@@ -25,6 +25,7 @@
 #include "absl/time/time.h"
 #include "tensorstore/internal/container/circular_queue.h"
 #include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/thread/fork_registry.h"
 #include "tensorstore/internal/thread/task_provider.h"
 
 namespace tensorstore {
@@ -39,10 +40,14 @@ namespace internal_thread_impl {
 /// Both worker threads and the overseer thread automatically terminate after
 /// they are idle for longer than `kThreadIdleBeforeExit` or
 /// `kOverseerIdleBeforeExit`, respectively.
+///
+/// When fork support is enabled, the pool forgets its threads in the child
+/// process after `fork()`, and starts new threads as needed.
 class SharedThreadPool
     : public internal::AtomicReferenceCount<SharedThreadPool> {
  public:
   SharedThreadPool();
+  ~SharedThreadPool();
 
   /// TaskProviderMethod:  Notify that there is work available.
   /// If the task provider identified by the token is not in the waiting_
@@ -50,6 +55,15 @@ class SharedThreadPool
   void NotifyWorkAvailable(internal::IntrusivePtr<TaskProvider>)
       ABSL_LOCKS_EXCLUDED(mutex_);
 
+  /// Live pools, see `ForkRegistry`.
+  static ForkRegistry<SharedThreadPool>& fork_registry();
+
+  /// Fork handlers: `PrepareFork` locks the pool until `ParentAfterFork`, or
+  /// until `ChildAfterFork` resets the thread state of the pool.
+  void PrepareFork() ABSL_EXCLUSIVE_LOCK_FUNCTION(mutex_);
+  void ParentAfterFork() ABSL_UNLOCK_FUNCTION(mutex_);
+  void ChildAfterFork() ABSL_UNLOCK_FUNCTION(mutex_);
+
  private:
   struct Overseer;
   struct Worker;
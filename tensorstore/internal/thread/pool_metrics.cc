@@ -0,0 +1,83 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/thread/pool_metrics.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "absl/base/no_destructor.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/internal/metrics/gauge.h"
+#include "tensorstore/internal/metrics/histogram.h"
+#include "tensorstore/internal/metrics/metadata.h"
+
+using ::tensorstore::internal_metrics::MetricMetadata;
+
+namespace tensorstore {
+namespace internal_thread_impl {
+namespace {
+
+auto& queued_tasks = internal_metrics::Gauge<int64_t, std::string>::New(
+    "/tensorstore/thread_pool/by_pool/queued_tasks", "pool",
+    MetricMetadata("Tasks submitted to a thread pool but not yet started, by "
+                   "pool."));
+
+auto& busy_threads = internal_metrics::Gauge<int64_t, std::string>::New(
+    "/tensorstore/thread_pool/by_pool/busy_threads", "pool",
+    MetricMetadata("Threads running a task, by pool."));
+
+auto& queue_delay_us = internal_metrics::Histogram<
+    internal_metrics::DefaultBucketer, std::string>::
+    New("/tensorstore/thread_pool/by_pool/queue_delay_us", "pool",
+        MetricMetadata("Histogram of the delay from submitting a task to "
+                       "starting it (us), by pool.",
+                       internal_metrics::Units::kMicroseconds));
+
+auto& run_time_us = internal_metrics::Histogram<
+    internal_metrics::DefaultBucketer, std::string>::
+    New("/tensorstore/thread_pool/by_pool/run_time_us", "pool",
+        MetricMetadata("Histogram of task run times (us), by pool.",
+                       internal_metrics::Units::kMicroseconds));
+
+struct ThreadPoolMetricsMap {
+  absl::Mutex mutex;
+  absl::flat_hash_map<std::string, std::unique_ptr<ThreadPoolMetrics>> map
+      ABSL_GUARDED_BY(mutex);
+};
+
+}  // namespace
+
+ThreadPoolMetrics& GetThreadPoolMetrics(std::string_view label) {
+  static absl::NoDestructor<ThreadPoolMetricsMap> metrics_map;
+  absl::MutexLock lock(&metrics_map->mutex);
+  auto& metrics = metrics_map->map[label];
+  if (!metrics) {
+    metrics.reset(new ThreadPoolMetrics{
+        queued_tasks.GetCell(label),
+        busy_threads.GetCell(label),
+        queue_delay_us.GetCell(label),
+        run_time_us.GetCell(label),
+    });
+  }
+  return *metrics;
+}
+
+}  // namespace internal_thread_impl
+}  // namespace tensorstore
@@ -0,0 +1,79 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_THREAD_POOL_METRICS_H_
+#define TENSORSTORE_INTERNAL_THREAD_POOL_METRICS_H_
+
+/// \file
+///
+/// Metrics of thread pools, labeled by the concurrency resource that owns the
+/// pool, such as `"data_copy_concurrency"` or `"file_io_concurrency"`.
+///
+/// A pool is saturated while `busy_threads` is at its thread limit and
+/// `queued_tasks` is nonzero, in which case `queue_delay_us` grows.
+
+#include <stdint.h>
+
+#include <string_view>
+
+#include "tensorstore/internal/metrics/gauge.h"
+#include "tensorstore/internal/metrics/histogram.h"
+
+namespace tensorstore {
+namespace internal_thread_impl {
+
+/// Label of thread pools not created for a concurrency resource.
+constexpr std::string_view kDefaultThreadPoolMetricsLabel = "default";
+
+/// Metric cells for the thread pools of a single label.
+struct ThreadPoolMetrics {
+  /// Tasks that have been submitted but have not yet started.
+  internal_metrics::GaugeCell<int64_t>& queued_tasks;
+
+  /// Threads currently running a task.
+  internal_metrics::GaugeCell<int64_t>& busy_threads;
+
+  /// Time from submitting a task to starting it, in microseconds.
+  internal_metrics::HistogramCell<internal_metrics::DefaultBucketer>&
+      queue_delay_us;
+
+  /// Time spent running a task, in microseconds.
+  internal_metrics::HistogramCell<internal_metrics::DefaultBucketer>&
+      run_time_us;
+};
+
+/// Records that a task submitted at `submit_nanos` started at `start_nanos`.
+inline void RecordTaskStart(ThreadPoolMetrics& metrics, int64_t submit_nanos,
+                            int64_t start_nanos) {
+  metrics.queued_tasks.Decrement();
+  metrics.busy_threads.Increment();
+  metrics.queue_delay_us.Observe((start_nanos - submit_nanos) / 1000);
+}
+
+/// Records that a task started at `start_nanos` finished at `stop_nanos`.
+inline void RecordTaskStop(ThreadPoolMetrics& metrics, int64_t start_nanos,
+                           int64_t stop_nanos) {
+  metrics.busy_threads.Decrement();
+  metrics.run_time_us.Observe((stop_nanos - start_nanos) / 1000);
+}
+
+/// Returns the metrics for `label`.
+///
+/// The returned reference remains valid for the lifetime of the program.
+ThreadPoolMetrics& GetThreadPoolMetrics(std::string_view label);
+
+}  // namespace internal_thread_impl
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_THREAD_POOL_METRICS_H_
@@ -0,0 +1,50 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/thread/pool_metrics.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+using ::tensorstore::internal_thread_impl::GetThreadPoolMetrics;
+using ::tensorstore::internal_thread_impl::RecordTaskStart;
+using ::tensorstore::internal_thread_impl::RecordTaskStop;
+
+TEST(ThreadPoolMetricsTest, SameLabel) {
+  EXPECT_EQ(&GetThreadPoolMetrics("pool_metrics_test_a"),
+            &GetThreadPoolMetrics("pool_metrics_test_a"));
+  EXPECT_NE(&GetThreadPoolMetrics("pool_metrics_test_a"),
+            &GetThreadPoolMetrics("pool_metrics_test_b"));
+}
+
+TEST(ThreadPoolMetricsTest, RecordTask) {
+  auto& metrics = GetThreadPoolMetrics("pool_metrics_test_record");
+  metrics.queued_tasks.Increment();
+  EXPECT_EQ(1, metrics.queued_tasks.Get());
+
+  RecordTaskStart(metrics, /*submit_nanos=*/1000, /*start_nanos=*/5000);
+  EXPECT_EQ(0, metrics.queued_tasks.Get());
+  EXPECT_EQ(1, metrics.busy_threads.Get());
+  EXPECT_EQ(1, metrics.queue_delay_us.GetCount());
+  EXPECT_EQ(4, metrics.queue_delay_us.GetMean());
+
+  RecordTaskStop(metrics, /*start_nanos=*/5000, /*stop_nanos=*/15000);
+  EXPECT_EQ(0, metrics.busy_threads.Get());
+  EXPECT_EQ(1, metrics.run_time_us.GetCount());
+  EXPECT_EQ(10, metrics.run_time_us.GetMean());
+}
+
+}  // namespace
@@ -14,19 +14,22 @@
 
 #include "tensorstore/internal/thread/schedule_at.h"
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include <algorithm>
 #include <atomic>
 #include <iterator>
 #include <memory>
+#include <new>
+#include <thread>  // NOLINT
 #include <utility>
 
 #include "absl/base/attributes.h"
-#include "absl/base/no_destructor.h"
 #include "absl/base/optimization.h"
 #include "absl/base/thread_annotations.h"
 #include "absl/functional/any_invocable.h"
+#include "absl/numeric/bits.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
@@ -64,6 +67,31 @@ auto& schedule_at_insert_histogram_ms =
         MetricMetadata("Histogram of schedule_at insert delays (ms)",
                        internal_metrics::Units::kMilliseconds));
 
+// Deadlines more than a few milliseconds away are kept in a hierarchical
+// timer wheel, which supports constant-time insertion and removal, rather than
+// in the red-black tree.  Deadlines are tracked by the wheel with a resolution
+// of one tick (1ms).  The tree holds the deadlines in the block of
+// `kWheelSlots` ticks containing the current tick, and orders them exactly.
+// Level `i` of the wheel holds the deadlines in the same block of
+// `kWheelSlots**(i + 2)` ticks as the current tick, but not in the same block
+// of `kWheelSlots**(i + 1)` ticks, in slots of `kWheelSlots**(i + 1)` ticks.
+// Later deadlines are held in an overflow list.
+//
+// Once the start of a slot is reached, its deadlines are moved to a lower
+// level or to the tree, and so every deadline is in the tree before it is due.
+constexpr int kWheelBits = 6;
+constexpr int kWheelSlots = 1 << kWheelBits;
+constexpr int kWheelLevels = 4;
+
+// Number of bits of a tick that identify the slot of a deadline at `level`.
+constexpr int SlotShift(int level) { return kWheelBits * (level + 1); }
+
+// Number of bits of a tick that identify the block spanned by `level`.
+constexpr int BlockShift(int level) { return kWheelBits * (level + 2); }
+
+int64_t ToTick(absl::Time t) { return absl::ToUnixMillis(t); }
+absl::Time FromTick(int64_t tick) { return absl::FromUnixMillis(tick); }
+
 class DeadlineTaskQueue;
 
 using TaggedQueuePointer = TaggedPtr<DeadlineTaskQueue, 1>;
@@ -107,15 +135,68 @@ struct DeadlineTaskNode : public DeadlineTaskTree::NodeBase {
   // non-null, then it is removed from the queue directly.
   std::atomic<TaggedQueuePointer> queue;
   StopCallback<DeadlineTaskStopCallback> stop_callback;
+
+  // Level of the timer wheel that holds the node, or `kWheelLevels` for the
+  // overflow list, or -1 if the node is in the tree or in the list of tasks to
+  // run immediately.  Guarded by the mutex of the queue.
+  int8_t wheel_level = -1;
+  // Slot within `wheel_level`.
+  uint8_t wheel_slot = 0;
 };
 
 using RunImmediatelyQueueAccessor =
     intrusive_red_black_tree::LinkedListAccessor<DeadlineTaskNode>;
 
+// The lists of tasks to run immediately and of tasks in a slot of the timer
+// wheel are linked through the tree node pointers, and referenced by their
+// first node.  The `next` pointer of the last node is null, and the `prev`
+// pointer of the first node points to the last node.
+
+void PushBack(DeadlineTaskNode*& head, DeadlineTaskNode* node) {
+  RunImmediatelyQueueAccessor accessor;
+  accessor.SetNext(node, nullptr);
+  if (head) {
+    auto* last = accessor.GetPrev(head);
+    accessor.SetNext(last, node);
+    accessor.SetPrev(node, last);
+    accessor.SetPrev(head, node);
+  } else {
+    head = node;
+    accessor.SetPrev(node, node);
+  }
+}
+
+void Append(DeadlineTaskNode*& head, DeadlineTaskNode* other) {
+  RunImmediatelyQueueAccessor accessor;
+  if (!other) return;
+  if (!head) {
+    head = other;
+    return;
+  }
+  auto* last = accessor.GetPrev(head);
+  accessor.SetPrev(head, accessor.GetPrev(other));
+  accessor.SetNext(last, other);
+  accessor.SetPrev(other, last);
+}
+
+void Unlink(DeadlineTaskNode*& head, DeadlineTaskNode* node) {
+  RunImmediatelyQueueAccessor accessor;
+  auto* prev = accessor.GetPrev(node);
+  auto* next = accessor.GetNext(node);
+  if (node == head) {
+    head = next;
+    if (next) accessor.SetPrev(next, prev);
+    return;
+  }
+  accessor.SetNext(prev, next);
+  accessor.SetPrev(next ? next : head, prev);
+}
+
 class DeadlineTaskQueue {
  public:
   explicit DeadlineTaskQueue()
       : run_immediately_queue_(nullptr),
+        wheel_tick_(ToTick(absl::Now())),
         next_wakeup_(absl::InfinitePast()),
         woken_up_(absl::InfinitePast()),
         thread_({"TensorstoreScheduleAt"}, &DeadlineTaskQueue::Run, this) {}
@@ -127,6 +208,13 @@ class DeadlineTaskQueue {
 
   void Run();
 
+  // Fork handlers, see `internal_os::RegisterForkHandlers`.  `PrepareFork`
+  // locks the queue until `ParentAfterFork`, or until `ChildAfterFork`
+  // restarts the thread, which does not exist in the child process.
+  void PrepareFork() ABSL_EXCLUSIVE_LOCK_FUNCTION(mutex_);
+  void ParentAfterFork() ABSL_UNLOCK_FUNCTION(mutex_);
+  void ChildAfterFork() ABSL_UNLOCK_FUNCTION(mutex_);
+
  private:
   friend struct DeadlineTaskNode;
   friend struct DeadlineTaskStopCallback;
@@ -140,13 +228,47 @@ class DeadlineTaskQueue {
   // concurrently running stop callback completes.
   void TryRemove(DeadlineTaskNode& node);
 
+  // Adds `node` to the tree or to the timer wheel, and returns the time by
+  // which the thread must wake up to handle it.
+  absl::Time Insert(DeadlineTaskNode* node)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Returns the earliest deadline in the tree, or start of an occupied slot
+  // of the timer wheel.
+  absl::Time NextDeadline() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Moves the deadlines of the slots of the timer wheel that start no later
+  // than `time` to a lower level or to the tree.
+  void AdvanceWheel(absl::Time time) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Returns the first tick after the blocks spanned by the timer wheel.
+  int64_t OverflowStart() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    constexpr int shift = BlockShift(kWheelLevels - 1);
+    return ((wheel_tick_ >> shift) + 1) << shift;
+  }
+
+  DeadlineTaskNode*& WheelSlot(int level, int slot)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return level == kWheelLevels ? overflow_ : wheel_[level].slots[slot];
+  }
+
   absl::Mutex mutex_;
   absl::CondVar cond_var_;
   DeadlineTaskTree tree_ ABSL_GUARDED_BY(mutex_);
 
-  // Additional circular linked list of tasks to run immediately.
+  // Additional linked list of tasks to run immediately.
   DeadlineTaskNode* run_immediately_queue_ ABSL_GUARDED_BY(mutex_);
 
+  struct WheelLevel {
+    // Bit `i` is set if `slots[i]` is non-empty.
+    uint64_t occupied = 0;
+    DeadlineTaskNode* slots[kWheelSlots] = {};
+  };
+  WheelLevel wheel_[kWheelLevels] ABSL_GUARDED_BY(mutex_);
+  DeadlineTaskNode* overflow_ ABSL_GUARDED_BY(mutex_) = nullptr;
+  // Tick relative to which deadlines were assigned to the timer wheel.
+  int64_t wheel_tick_ ABSL_GUARDED_BY(mutex_);
+
   absl::Time next_wakeup_ ABSL_GUARDED_BY(mutex_);
   absl::Time woken_up_ ABSL_GUARDED_BY(mutex_);
   Thread thread_;
@@ -176,16 +298,7 @@ void DeadlineTaskQueue::ScheduleAt(absl::Time target_time, ScheduleAtTask task,
   }
   if (target_time <= woken_up_) {
     // Target time is in the past, schedule to run immediately.
-    RunImmediatelyQueueAccessor{}.SetNext(node.get(), nullptr);
-    if (run_immediately_queue_) {
-      RunImmediatelyQueueAccessor{}.SetNext(
-          RunImmediatelyQueueAccessor{}.GetPrev(run_immediately_queue_),
-          node.get());
-      RunImmediatelyQueueAccessor{}.SetPrev(run_immediately_queue_, node.get());
-    } else {
-      run_immediately_queue_ = node.get();
-      RunImmediatelyQueueAccessor{}.SetPrev(node.get(), node.get());
-    }
+    PushBack(run_immediately_queue_, node.get());
     if (next_wakeup_ != absl::InfinitePast()) {
       next_wakeup_ = absl::InfinitePast();
       // Wake up thread immediately due to earlier deadline.
@@ -196,19 +309,89 @@ void DeadlineTaskQueue::ScheduleAt(absl::Time target_time, ScheduleAtTask task,
   }
 
   // Schedule to run normally.
-  tree_.FindOrInsert(
-      [&](DeadlineTaskNode& other) {
-        return target_time < other.deadline ? absl::weak_ordering::less
-                                            : absl::weak_ordering::greater;
-      },
-      [&] { return node.release(); });
-  if (target_time < next_wakeup_) {
-    next_wakeup_ = target_time;
+  absl::Time wakeup = Insert(node.release());
+  if (wakeup < next_wakeup_) {
+    next_wakeup_ = wakeup;
     // Wake up thread immediately due to earlier deadline.
     cond_var_.Signal();
   }
 }
 
+absl::Time DeadlineTaskQueue::Insert(DeadlineTaskNode* node) {
+  const absl::Time deadline = node->deadline;
+  const int64_t tick = ToTick(deadline);
+  if ((tick >> kWheelBits) <= (wheel_tick_ >> kWheelBits)) {
+    node->wheel_level = -1;
+    tree_.FindOrInsert(
+        [&](DeadlineTaskNode& other) {
+          return deadline < other.deadline ? absl::weak_ordering::less
+                                           : absl::weak_ordering::greater;
+        },
+        [&] { return node; });
+    return deadline;
+  }
+  int level = 0;
+  while (level < kWheelLevels &&
+         (tick >> BlockShift(level)) != (wheel_tick_ >> BlockShift(level))) {
+    ++level;
+  }
+  node->wheel_level = level;
+  if (level == kWheelLevels) {
+    node->wheel_slot = 0;
+    PushBack(overflow_, node);
+    return FromTick(OverflowStart());
+  }
+  const int slot = (tick >> SlotShift(level)) & (kWheelSlots - 1);
+  node->wheel_slot = slot;
+  wheel_[level].occupied |= uint64_t{1} << slot;
+  PushBack(wheel_[level].slots[slot], node);
+  return FromTick((tick >> SlotShift(level)) << SlotShift(level));
+}
+
+absl::Time DeadlineTaskQueue::NextDeadline() {
+  absl::Time next =
+      tree_.empty() ? absl::InfiniteFuture() : tree_.begin()->deadline;
+  // The slots of a lower level all start before those of a higher level.
+  for (int level = 0; level < kWheelLevels; ++level) {
+    const uint64_t occupied = wheel_[level].occupied;
+    if (!occupied) continue;
+    const int64_t start =
+        ((wheel_tick_ >> BlockShift(level)) << BlockShift(level)) +
+        (int64_t{absl::countr_zero(occupied)} << SlotShift(level));
+    return std::min(next, FromTick(start));
+  }
+  if (overflow_) next = std::min(next, FromTick(OverflowStart()));
+  return next;
+}
+
+void DeadlineTaskQueue::AdvanceWheel(absl::Time time) {
+  const int64_t tick = ToTick(time);
+  if (tick <= wheel_tick_) return;
+  DeadlineTaskNode* reached = nullptr;
+  for (int level = 0; level < kWheelLevels; ++level) {
+    auto& wheel_level = wheel_[level];
+    const int64_t base = (wheel_tick_ >> BlockShift(level))
+                         << BlockShift(level);
+    while (wheel_level.occupied) {
+      const int slot = absl::countr_zero(wheel_level.occupied);
+      if (base + (int64_t{slot} << SlotShift(level)) > tick) break;
+      wheel_level.occupied &= ~(uint64_t{1} << slot);
+      Append(reached, std::exchange(wheel_level.slots[slot], nullptr));
+    }
+  }
+  if (overflow_ && OverflowStart() <= tick) {
+    Append(reached, std::exchange(overflow_, nullptr));
+  }
+  // Any deadlines remaining in a level are in the same block as `tick`, since
+  // all of the slots of a level start no later than the end of its block.
+  wheel_tick_ = tick;
+  while (reached) {
+    auto* next = RunImmediatelyQueueAccessor::GetNext(reached);
+    Insert(reached);
+    reached = next;
+  }
+}
+
 void DeadlineTaskQueue::Run() {
   while (true) {
     DeadlineTaskTree runnable;
@@ -219,8 +402,7 @@ void DeadlineTaskQueue::Run() {
         run_immediately = std::exchange(run_immediately_queue_, nullptr);
 
         if (!run_immediately) {
-          next_wakeup_ =
-              tree_.empty() ? absl::InfiniteFuture() : tree_.begin()->deadline;
+          next_wakeup_ = NextDeadline();
 
           // Sleep until our next deadline.
           schedule_at_next_event.Set(next_wakeup_);
@@ -229,6 +411,7 @@ void DeadlineTaskQueue::Run() {
 
         // Consume the queue.
         auto woken_up = woken_up_ = std::max(woken_up_, absl::Now());
+        AdvanceWheel(woken_up);
 
         auto split_result = tree_.FindSplit([&](DeadlineTaskNode& node) {
           return node.deadline <= woken_up ? absl::weak_ordering::greater
@@ -266,6 +449,24 @@ void DeadlineTaskQueue::Run() {
   }
 }
 
+void DeadlineTaskQueue::PrepareFork() { mutex_.Lock(); }
+
+void DeadlineTaskQueue::ParentAfterFork() { mutex_.Unlock(); }
+
+void DeadlineTaskQueue::ChildAfterFork() ABSL_NO_THREAD_SAFETY_ANALYSIS {
+  // The mutex and condition variable may still list the thread of the parent
+  // process as a waiter, so they are reinitialized rather than unlocked.  The
+  // `Thread` of the parent process is overwritten without being joined.
+  new (&mutex_) absl::Mutex;
+  new (&cond_var_) absl::CondVar;
+  {
+    absl::MutexLock l(&mutex_);
+    next_wakeup_ = absl::InfinitePast();
+  }
+  new (&thread_)
+      Thread({"TensorstoreScheduleAt"}, &DeadlineTaskQueue::Run, this);
+}
+
 void DeadlineTaskNode::RunAndDelete() {
   schedule_at_queued_ops.Decrement();
   if (queue.load(std::memory_order_relaxed).tag()) {
@@ -297,7 +498,15 @@ void DeadlineTaskQueue::TryRemove(DeadlineTaskNode& node) {
       // Task is being executed now.  Too late to cancel.
       return;
     }
-    tree_.Remove(node);
+    if (node.wheel_level < 0) {
+      tree_.Remove(node);
+    } else {
+      auto& head = WheelSlot(node.wheel_level, node.wheel_slot);
+      Unlink(head, &node);
+      if (!head && node.wheel_level < kWheelLevels) {
+        wheel_[node.wheel_level].occupied &= ~(uint64_t{1} << node.wheel_slot);
+      }
+    }
     // No need to recompute `queue_ptr->next_wakeup_` here, since it can only
     // get later.
   }
@@ -305,12 +514,55 @@ void DeadlineTaskQueue::TryRemove(DeadlineTaskNode& node) {
   schedule_at_queued_ops.Decrement();
 }
 
+size_t NumDeadlineTaskQueues() {
+  static const size_t num_queues = std::clamp<size_t>(
+      std::thread::hardware_concurrency() / 16, 1, 8);
+  return num_queues;
+}
+
+DeadlineTaskQueue* GetDeadlineTaskQueues();
+
+template <void (DeadlineTaskQueue::*Method)()>
+void ForEachDeadlineTaskQueue() {
+  DeadlineTaskQueue* queues = GetDeadlineTaskQueues();
+  for (size_t i = 0; i < NumDeadlineTaskQueues(); ++i) {
+    (queues[i].*Method)();
+  }
+}
+
+DeadlineTaskQueue* GetDeadlineTaskQueues() {
+  static DeadlineTaskQueue* const queues = [] {
+    auto* queues = new DeadlineTaskQueue[NumDeadlineTaskQueues()];
+    internal_os::RegisterForkHandlers({
+        &ForEachDeadlineTaskQueue<&DeadlineTaskQueue::PrepareFork>,
+        &ForEachDeadlineTaskQueue<&DeadlineTaskQueue::ParentAfterFork>,
+        &ForEachDeadlineTaskQueue<&DeadlineTaskQueue::ChildAfterFork>,
+    });
+    return queues;
+  }();
+  return queues;
+}
+
+// Returns the queue used by the current thread.
+//
+// Tasks are distributed over several queues, each with its own thread, on
+// machines with many cores, to reduce contention between the threads that
+// schedule tasks.  A thread always uses the same queue, so the tasks that it
+// schedules run in the order of their deadlines.
+DeadlineTaskQueue& GetDeadlineTaskQueue() {
+  static std::atomic<size_t> next_queue{0};
+  thread_local const size_t queue_index =
+      next_queue.fetch_add(1, std::memory_order_relaxed) %
+      NumDeadlineTaskQueues();
+  return GetDeadlineTaskQueues()[queue_index];
+}
+
 }  // namespace
 
 void ScheduleAt(absl::Time target_time, ScheduleAtTask task,
                 const StopToken& stop_token) {
-  static absl::NoDestructor<DeadlineTaskQueue> g_queue;
-  g_queue->ScheduleAt(std::move(target_time), std::move(task), stop_token);
+  GetDeadlineTaskQueue().ScheduleAt(std::move(target_time), std::move(task),
+                                    stop_token);
 }
 
 }  // namespace internal
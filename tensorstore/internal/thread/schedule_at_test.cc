@@ -14,11 +14,15 @@
 
 #include "tensorstore/internal/thread/schedule_at.h"
 
+#include <algorithm>
 #include <memory>
 #include <thread>  // NOLINT
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/synchronization/blocking_counter.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/synchronization/notification.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
@@ -113,4 +117,43 @@ TEST(ScheduleAtTest, CancelWhileRunning) {
   EXPECT_EQ(1, notification2.use_count());
 }
 
+// Tests that tasks scheduled by a thread run in the order of their deadlines,
+// including deadlines that are initially held by the timer wheel.
+TEST(ScheduleAtTest, Order) {
+  constexpr int kNumTasks = 100;
+  absl::Mutex mutex;
+  std::vector<int> order;
+  absl::BlockingCounter counter(kNumTasks);
+  auto now = absl::Now();
+  for (int i = 0; i < kNumTasks; ++i) {
+    // Schedule the tasks in an order unrelated to their deadlines, which span
+    // about 300ms.
+    int j = (i * 37) % kNumTasks;
+    ScheduleAt(now + absl::Milliseconds(3 * j + 1), [&, j] {
+      {
+        absl::MutexLock lock(&mutex);
+        order.push_back(j);
+      }
+      counter.DecrementCount();
+    });
+  }
+  counter.Wait();
+  EXPECT_TRUE(std::is_sorted(order.begin(), order.end()));
+}
+
+TEST(ScheduleAtTest, CancelFarFuture) {
+  auto notification = std::make_shared<absl::Notification>();
+  StopSource stop_source;
+  ScheduleAt(
+      absl::Now() + absl::Hours(1), [notification] { notification->Notify(); },
+      stop_source.get_token());
+  ScheduleAt(
+      absl::Now() + absl::Hours(24 * 30),
+      [notification] { notification->Notify(); }, stop_source.get_token());
+  EXPECT_EQ(3, notification.use_count());
+  stop_source.request_stop();
+  EXPECT_EQ(1, notification.use_count());
+  EXPECT_FALSE(notification->HasBeenNotified());
+}
+
 }  // namespace
@@ -22,6 +22,8 @@
 #include "absl/base/attributes.h"
 #include "absl/functional/any_invocable.h"
 #include "absl/time/clock.h"
+#include "tensorstore/internal/thread/task_priority.h"
+#include "tensorstore/internal/thread/task_tenant.h"
 #include "tensorstore/internal/tracing/trace_context.h"
 
 namespace tensorstore {
@@ -33,9 +35,13 @@ struct InFlightTask {
                internal_tracing::TraceContext tc)
       : callback_(std::move(callback)),
         tc_(std::move(tc)),
-        start_nanos(absl::GetCurrentTimeNanos()) {}
+        start_nanos(absl::GetCurrentTimeNanos()),
+        priority(internal::GetCurrentTaskPriority()),
+        tenant(internal::GetCurrentTaskTenant()) {}
 
   void Run() {
+    internal::ScopedTaskPriority priority_scope(priority);
+    internal::ScopedTaskTenant tenant_scope(tenant);
     internal_tracing::SwapCurrentTraceContext(&tc_);
     std::move(callback_)();
     callback_ = {};
@@ -45,6 +51,10 @@ struct InFlightTask {
   absl::AnyInvocable<void() &&> callback_;
   ABSL_ATTRIBUTE_NO_UNIQUE_ADDRESS internal_tracing::TraceContext tc_;
   int64_t start_nanos;
+  // Priority of the thread that created the task, with which the task runs.
+  internal::TaskPriority priority;
+  // Tenant of the thread that created the task, with which the task runs.
+  internal::TaskTenant tenant;
 };
 
 }  // namespace internal_thread_impl
@@ -21,8 +21,11 @@
 #include <atomic>
 #include <cassert>
 #include <memory>
+#include <new>
 #include <utility>
 
+#include "absl/base/call_once.h"
+#include "absl/base/no_destructor.h"
 #include "absl/base/optimization.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/time/clock.h"
@@ -32,8 +35,11 @@
 #include "tensorstore/internal/metrics/gauge.h"
 #include "tensorstore/internal/metrics/metadata.h"
 #include "tensorstore/internal/os/fork_detection.h"
+#include "tensorstore/internal/thread/fork_registry.h"
 #include "tensorstore/internal/thread/pool_impl.h"
+#include "tensorstore/internal/thread/pool_metrics.h"
 #include "tensorstore/internal/thread/task.h"
+#include "tensorstore/internal/thread/task_priority.h"
 #include "tensorstore/internal/thread/task_provider.h"
 #include "tensorstore/util/span.h"
 
@@ -79,9 +85,36 @@ inline size_t ItemsToSelfAssign(size_t default_assign, size_t available) {
   return (std::min)(default_assign, available >> 3);
 }
 
-// ThreadMetrics is used to batch-update the tensorstore metrics.
+// Registers the fork handlers of the `SharedThreadPool` and `TaskGroup`
+// instances, in the order of their locks.
+void RegisterTaskGroupForkHandlers() {
+  static absl::once_flag once;
+  absl::call_once(once, [] {
+    internal_os::RegisterForkHandlers({
+        /*prepare=*/+[] {
+          SharedThreadPool::fork_registry().PrepareFork();
+          TaskGroup::fork_registry().PrepareFork();
+        },
+        /*parent=*/+[] {
+          TaskGroup::fork_registry().ParentAfterFork();
+          SharedThreadPool::fork_registry().ParentAfterFork();
+        },
+        /*child=*/+[] {
+          SharedThreadPool::fork_registry().ChildAfterFork();
+          TaskGroup::fork_registry().ChildAfterFork();
+        },
+    });
+  });
+}
+
+// ThreadMetrics is used to batch-update the tensorstore metrics.  The
+// per-pool metrics are updated for every task.
 struct ThreadMetrics {
   constexpr static int64_t kUpdateAfterNS = 100000000;  // 100ms
+  explicit ThreadMetrics(ThreadPoolMetrics& pool_metrics)
+      : pool_metrics(pool_metrics) {}
+
+  ThreadPoolMetrics& pool_metrics;
   int64_t total_queue_time_ns = 0;
   int64_t max_delay_ns = 0;
   int64_t work_time_ns = 0;
@@ -107,14 +140,16 @@ struct ThreadMetrics {
   void OnStart(int64_t task_queue_ns) {
     start_time_ns_ = absl::GetCurrentTimeNanos();
     task_queue_ns_ = task_queue_ns;
+    RecordTaskStart(pool_metrics, task_queue_ns_, start_time_ns_);
   }
 
   int64_t OnStop() {
     int64_t stop_time_ns = absl::GetCurrentTimeNanos();
+    RecordTaskStop(pool_metrics, start_time_ns_, stop_time_ns);
     int64_t delay_ns = start_time_ns_ - task_queue_ns_;
     total_queue_time_ns += delay_ns;
     max_delay_ns = std::max(max_delay_ns, delay_ns);
-    work_time_ns = stop_time_ns - start_time_ns_;
+    work_time_ns += stop_time_ns - start_time_ns_;
     if (total_queue_time_ns > kUpdateAfterNS) {
       Update();
     }
@@ -132,16 +167,51 @@ struct TaskGroup::PerThreadData {
 };
 
 TaskGroup::TaskGroup(private_t, internal::IntrusivePtr<SharedThreadPool> pool,
-                     size_t thread_limit)
+                     size_t thread_limit, ThreadPoolMetrics& metrics)
     : pool_(std::move(pool)),
       thread_limit_(thread_limit),
+      metrics_(metrics),
       threads_blocked_(0),
       threads_in_use_(0),
-      steal_index_(0) {}
+      steal_index_(0) {
+  RegisterTaskGroupForkHandlers();
+  fork_registry().Add(this);
+}
 
 TaskGroup::~TaskGroup() {
   assert(threads_in_use_.load(std::memory_order_relaxed) == 0);
-  assert(queue_.empty());
+  assert(queue_size_ == 0);
+  fork_registry().Remove(this);
+}
+
+ForkRegistry<TaskGroup>& TaskGroup::fork_registry() {
+  static absl::NoDestructor<ForkRegistry<TaskGroup>> registry;
+  return *registry;
+}
+
+void TaskGroup::PrepareFork() { mutex_.Lock(); }
+
+void TaskGroup::ParentAfterFork() { mutex_.Unlock(); }
+
+void TaskGroup::ChildAfterFork() ABSL_NO_THREAD_SAFETY_ANALYSIS {
+  // As in `SharedThreadPool::ChildAfterFork`, the mutex is reinitialized
+  // rather than unlocked.  The per-thread data remains owned by the worker
+  // threads of the parent process, and is leaked.
+  new (&mutex_) absl::Mutex;
+  {
+    absl::MutexLock lock(&mutex_);
+    for (auto* data : thread_queues_) {
+      while (auto* t = data->queue.try_pop()) {
+        PushGlobal(std::unique_ptr<InFlightTask>(t));
+      }
+    }
+    thread_queues_.clear();
+    steal_index_ = 0;
+    threads_in_use_.store(0, std::memory_order_relaxed);
+    threads_blocked_.store(0, std::memory_order_relaxed);
+    if (queue_size_ == 0) return;
+  }
+  pool_->NotifyWorkAvailable(internal::IntrusivePtr<TaskProvider>(this));
 }
 
 int64_t TaskGroup::EstimateThreadsRequired() {
@@ -152,8 +222,8 @@ int64_t TaskGroup::EstimateThreadsRequired() {
 
   // Otherwise check the available tasks.
   absl::MutexLock lock(&mutex_);
-  if (!queue_.empty()) {
-    return std::min(n, queue_.size());
+  if (queue_size_ != 0) {
+    return std::min(n, queue_size_);
   }
   for (auto* p : thread_queues_) {
     if (!p->queue.empty()) return std::min(n, p->queue.size());
@@ -179,7 +249,7 @@ void TaskGroup::DoWorkOnThread() {
   }
 
   int64_t last_run_ns = absl::GetCurrentTimeNanos();
-  ThreadMetrics metrics;
+  ThreadMetrics metrics(metrics_);
 
   // As long as there is work available, do it on this thread.
   while (true) {
@@ -228,23 +298,32 @@ std::unique_ptr<InFlightTask> TaskGroup::AcquireTask(PerThreadData* thread_data,
     ~ScopedIncDec() { x_.fetch_sub(1, std::memory_order_relaxed); }
   };
 
-  // First, attempt to acquire a task from the local queue.
-  if (auto* t = thread_data->queue.try_pop(); t != nullptr) {
-    return std::unique_ptr<InFlightTask>(t);
+  // First, attempt to acquire a task from the local queue, unless there are
+  // interactive tasks waiting in the global queue.
+  if (interactive_queued_.load(std::memory_order_relaxed) == 0) {
+    if (auto* t = thread_data->queue.try_pop(); t != nullptr) {
+      return std::unique_ptr<InFlightTask>(t);
+    }
   }
 
   absl::MutexLock lock(&mutex_);
   while (true) {
     // Second, attempt to acquire a task from the global queue.
-    if (!queue_.empty()) {
-      std::unique_ptr<InFlightTask> task = std::move(queue_.front());
-      queue_.pop_front();
-
-      // Tunable parameter: Preemptively assign additional items to self.
-      size_t x = ItemsToSelfAssign(thread_data->default_assign, queue_.size());
-      while (x--) {
-        thread_data->queue.push(queue_.front().release());
-        queue_.pop_front();
+    if (queue_size_ != 0) {
+      internal_container::BlockQueue<std::unique_ptr<InFlightTask>>*
+          priority_queue;
+      std::unique_ptr<InFlightTask> task = PopGlobal(&priority_queue);
+
+      // Tunable parameter: Preemptively assign additional items to self, only
+      // if that does not bypass the prioritization of other tasks.
+      if (priority_queue != nullptr) {
+        size_t x = ItemsToSelfAssign(thread_data->default_assign,
+                                     priority_queue->size());
+        while (x--) {
+          thread_data->queue.push(priority_queue->front().release());
+          priority_queue->pop_front();
+          --queue_size_;
+        }
       }
 
       if (thread_data->default_assign < 16) {
@@ -256,6 +335,12 @@ std::unique_ptr<InFlightTask> TaskGroup::AcquireTask(PerThreadData* thread_data,
 
     thread_data->default_assign = 1;
 
+    // The local queue was skipped in favor of interactive tasks, which have
+    // since been taken by other threads.
+    if (auto* t = thread_data->queue.try_pop(); t != nullptr) {
+      return std::unique_ptr<InFlightTask>(t);
+    }
+
     // Third, migrate tasks from per-thread queues.
     for (size_t i = 0; i < thread_queues_.size(); ++i, ++steal_index_) {
       if (steal_index_ >= thread_queues_.size()) steal_index_ = 0;
@@ -268,7 +353,7 @@ std::unique_ptr<InFlightTask> TaskGroup::AcquireTask(PerThreadData* thread_data,
       while (x--) {
         std::unique_ptr<InFlightTask> t(other_data->queue.try_steal());
         if (!t) break;
-        queue_.push_back(std::move(t));
+        PushGlobal(std::move(t));
       }
 
       thread_pool_steal_count.IncrementBy(1);
@@ -279,7 +364,8 @@ std::unique_ptr<InFlightTask> TaskGroup::AcquireTask(PerThreadData* thread_data,
     ScopedIncDec blocked(threads_blocked_);
     if (!mutex_.AwaitWithTimeout(
             absl::Condition(
-                +[](decltype(queue_)* q) { return !q->empty(); }, &queue_),
+                +[](size_t* queue_size) { return *queue_size != 0; },
+                &queue_size_),
             timeout)) {
       return nullptr;
     }
@@ -287,9 +373,55 @@ std::unique_ptr<InFlightTask> TaskGroup::AcquireTask(PerThreadData* thread_data,
   ABSL_UNREACHABLE();
 }
 
+void TaskGroup::PushGlobal(std::unique_ptr<InFlightTask> task) {
+  const internal::TaskPriority priority = task->priority;
+  if (priority == internal::TaskPriority::kInteractive) {
+    interactive_queued_.fetch_add(1, std::memory_order_relaxed);
+  }
+  queue_[static_cast<size_t>(priority)].push_back(std::move(task));
+  ++queue_size_;
+}
+
+std::unique_ptr<InFlightTask> TaskGroup::PopGlobal(
+    internal_container::BlockQueue<std::unique_ptr<InFlightTask>>**
+        priority_queue) {
+  assert(queue_size_ != 0);
+  // Select the queue whose oldest task has the highest effective priority;
+  // ties favor the higher priority queue.
+  const int64_t now_nanos = absl::GetCurrentTimeNanos();
+  auto* selected = &queue_[0];
+  int64_t selected_priority = -1;
+  size_t num_nonempty = 0;
+  for (size_t i = internal::kNumTaskPriorities; i-- > 0;) {
+    auto& q = queue_[i];
+    if (q.empty()) continue;
+    ++num_nonempty;
+    const int64_t effective_priority = internal::GetEffectiveTaskPriority(
+        q.front()->priority, q.front()->start_nanos, now_nanos);
+    if (effective_priority > selected_priority) {
+      selected = &q;
+      selected_priority = effective_priority;
+    }
+  }
+  std::unique_ptr<InFlightTask> task = std::move(selected->front());
+  selected->pop_front();
+  --queue_size_;
+  if (task->priority == internal::TaskPriority::kInteractive) {
+    interactive_queued_.fetch_sub(1, std::memory_order_relaxed);
+  }
+  *priority_queue = num_nonempty == 1 ? selected : nullptr;
+  return task;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 
+bool TaskGroup::IsCurrentThreadWorker() const {
+  return per_thread_data != nullptr &&
+         per_thread_data->owner.load(std::memory_order_relaxed) == this;
+}
+
 void TaskGroup::AddTask(std::unique_ptr<InFlightTask> task) {
+  metrics_.queued_tasks.Increment();
   int state = 2;
   if (per_thread_data != nullptr &&
       per_thread_data->owner.load(std::memory_order_relaxed) == this) {
@@ -316,14 +448,14 @@ void TaskGroup::AddTask(std::unique_ptr<InFlightTask> task) {
       for (int i = 0; i < n_to_migrate; i++) {
         InFlightTask* t = per_thread_data->queue.try_pop();
         if (t != nullptr) {
-          queue_.push_back(std::unique_ptr<InFlightTask>(t));
+          PushGlobal(std::unique_ptr<InFlightTask>(t));
         } else {
           break;
         }
       }
     }
 
-    queue_.push_back(std::move(task));
+    PushGlobal(std::move(task));
   }
 
   if (threads_in_use_.load(std::memory_order_relaxed) < thread_limit_) {
@@ -334,10 +466,11 @@ void TaskGroup::AddTask(std::unique_ptr<InFlightTask> task) {
 void TaskGroup::BulkAddTask(
     tensorstore::span<std::unique_ptr<InFlightTask>> tasks) {
   internal_os::AbortIfForkDetected();
+  metrics_.queued_tasks.IncrementBy(tasks.size());
   {
     absl::MutexLock lock(&mutex_);
     for (auto& t : tasks) {
-      queue_.push_back(std::move(t));
+      PushGlobal(std::move(t));
     }
   }
   if (threads_in_use_.load(std::memory_order_relaxed) < thread_limit_) {
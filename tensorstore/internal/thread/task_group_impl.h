@@ -21,6 +21,7 @@
 #include <atomic>
 #include <cassert>
 #include <memory>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -31,8 +32,11 @@
 #include "tensorstore/internal/container/block_queue.h"
 #include "tensorstore/internal/container/single_producer_queue.h"
 #include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/thread/fork_registry.h"
 #include "tensorstore/internal/thread/pool_impl.h"
+#include "tensorstore/internal/thread/pool_metrics.h"
 #include "tensorstore/internal/thread/task.h"
+#include "tensorstore/internal/thread/task_priority.h"
 #include "tensorstore/internal/thread/task_provider.h"
 #include "tensorstore/util/span.h"
 
@@ -45,20 +49,28 @@ using InFlightTaskQueue =
 /// TaskGroup is TaskProvider which allows adding additional tasks to a
 /// task provider, and allowing up to a specific number of threads to
 /// work on the tasks concurrently.
+///
+/// Tasks in the global queue are scheduled by `InFlightTask::priority`, with
+/// aging, and pending `kInteractive` tasks in the global queue take precedence
+/// over the per-thread queues.
 class TaskGroup : public TaskProvider {
   struct private_t {};
 
  public:
   struct PerThreadData;
 
+  /// Returns a new task group.  Its metrics are reported under
+  /// `metrics_label`, see `GetThreadPoolMetrics`.
   static internal::IntrusivePtr<TaskGroup> Make(
-      internal::IntrusivePtr<SharedThreadPool> pool, size_t thread_limit) {
-    return internal::MakeIntrusivePtr<TaskGroup>(private_t{}, std::move(pool),
-                                                 thread_limit);
+      internal::IntrusivePtr<SharedThreadPool> pool, size_t thread_limit,
+      std::string_view metrics_label = kDefaultThreadPoolMetricsLabel) {
+    return internal::MakeIntrusivePtr<TaskGroup>(
+        private_t{}, std::move(pool), thread_limit,
+        GetThreadPoolMetrics(metrics_label));
   }
 
   TaskGroup(private_t, internal::IntrusivePtr<SharedThreadPool> pool,
-            size_t thread_limit);
+            size_t thread_limit, ThreadPoolMetrics& metrics);
 
   ~TaskGroup() override;
 
@@ -72,27 +84,64 @@ class TaskGroup : public TaskProvider {
   /// Thread safety: safe to call concurrently from multiple threads.
   void BulkAddTask(tensorstore::span<std::unique_ptr<InFlightTask>> tasks);
 
+  /// Returns `true` if the current thread is a worker thread assigned to this
+  /// task group.
+  bool IsCurrentThreadWorker() const;
+
   /// Retrieve work units available.
   int64_t EstimateThreadsRequired() override;
 
   /// Worker method: Assign a thread to this task provider.
   void DoWorkOnThread() override;
 
+  /// Live task groups, see `ForkRegistry`.
+  static ForkRegistry<TaskGroup>& fork_registry();
+
+  /// Fork handlers: `PrepareFork` locks the task group until
+  /// `ParentAfterFork`, or until `ChildAfterFork` moves the tasks queued on
+  /// the worker threads, which do not exist in the child process, to the
+  /// global queue.
+  ///
+  /// The handlers of the task groups are called after those of the
+  /// `SharedThreadPool` instances, whose mutex is acquired before that of a
+  /// task group by `SharedThreadPool::FindActiveTaskProvider`.
+  void PrepareFork() ABSL_EXCLUSIVE_LOCK_FUNCTION(mutex_);
+  void ParentAfterFork() ABSL_UNLOCK_FUNCTION(mutex_);
+  void ChildAfterFork() ABSL_UNLOCK_FUNCTION(mutex_);
+
  private:
   /// Worker method: Acquire work from the global queue or another thread.
   std::unique_ptr<InFlightTask> AcquireTask(PerThreadData* thread_data,
                                             absl::Duration timeout);
 
+  /// Adds a task to the global queue.
+  void PushGlobal(std::unique_ptr<InFlightTask> task)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  /// Removes the next task from the global queue, which must be non-empty.
+  /// Sets `*priority_queue` to the queue from which the task was taken, if it
+  /// is the only non-empty queue, or to `nullptr` otherwise.
+  std::unique_ptr<InFlightTask> PopGlobal(
+      internal_container::BlockQueue<std::unique_ptr<InFlightTask>>**
+          priority_queue) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   const internal::IntrusivePtr<SharedThreadPool> pool_;
   const size_t thread_limit_;
+  ThreadPoolMetrics& metrics_;
 
   // worker thread state counters; updated under lock, read without locks.
   ABSL_CACHELINE_ALIGNED std::atomic<int64_t> threads_blocked_;
   std::atomic<int64_t> threads_in_use_;
 
+  // Number of `kInteractive` tasks in the global queue.
+  std::atomic<int64_t> interactive_queued_{0};
+
   absl::Mutex mutex_;
-  internal_container::BlockQueue<std::unique_ptr<InFlightTask>> queue_
-      ABSL_GUARDED_BY(mutex_);
+  // The global queue, indexed by `TaskPriority`.
+  internal_container::BlockQueue<std::unique_ptr<InFlightTask>>
+      queue_[internal::kNumTaskPriorities] ABSL_GUARDED_BY(mutex_);
+  // Total number of tasks in `queue_`.
+  size_t queue_size_ ABSL_GUARDED_BY(mutex_) = 0;
   std::vector<PerThreadData*> thread_queues_ ABSL_GUARDED_BY(mutex_);
   size_t steal_index_ ABSL_GUARDED_BY(mutex_);
 };
@@ -0,0 +1,44 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/thread/task_priority.h"
+
+#include <stdint.h>
+
+namespace tensorstore {
+namespace internal {
+namespace {
+thread_local TaskPriority current_task_priority = TaskPriority::kNormal;
+}  // namespace
+
+TaskPriority GetCurrentTaskPriority() { return current_task_priority; }
+
+int64_t GetEffectiveTaskPriority(TaskPriority priority, int64_t enqueue_nanos,
+                                 int64_t now_nanos) {
+  const int64_t waited_nanos = now_nanos - enqueue_nanos;
+  return static_cast<int64_t>(priority) +
+         (waited_nanos > 0 ? waited_nanos / kTaskPriorityAgingNanos : 0);
+}
+
+ScopedTaskPriority::ScopedTaskPriority(TaskPriority priority)
+    : previous_(current_task_priority) {
+  current_task_priority = priority;
+}
+
+ScopedTaskPriority::~ScopedTaskPriority() {
+  current_task_priority = previous_;
+}
+
+}  // namespace internal
+}  // namespace tensorstore
@@ -0,0 +1,70 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_THREAD_TASK_PRIORITY_H_
+#define TENSORSTORE_INTERNAL_THREAD_TASK_PRIORITY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace tensorstore {
+namespace internal {
+
+/// Scheduling priority of thread pool tasks and rate-limited operations.
+///
+/// The priority of the current thread is set by `ScopedTaskPriority`.  Tasks
+/// and operations record the priority of the thread that creates them, and
+/// thread pool tasks run with their recorded priority, so that the priority
+/// carries through continuations.  Reads run as `kInteractive`, while
+/// transaction commits, and therefore writeback, run as `kBackground`.
+enum class TaskPriority : uint8_t {
+  kBackground = 0,
+  kNormal = 1,
+  kInteractive = 2,
+};
+
+constexpr size_t kNumTaskPriorities = 3;
+
+/// A queued task is treated as one priority level higher for each multiple of
+/// this interval (50ms) that it has waited, which bounds its delay while higher
+/// priority work is pending.
+constexpr int64_t kTaskPriorityAgingNanos = 50'000'000;
+
+/// Returns the priority of the current thread, `TaskPriority::kNormal` by
+/// default.
+TaskPriority GetCurrentTaskPriority();
+
+/// Returns the priority of a task of priority `priority` which has waited
+/// since `enqueue_nanos` (as returned by `absl::GetCurrentTimeNanos()`), as of
+/// `now_nanos`, increased by aging.
+int64_t GetEffectiveTaskPriority(TaskPriority priority, int64_t enqueue_nanos,
+                                 int64_t now_nanos);
+
+/// Sets the priority of the current thread while in scope.
+class ScopedTaskPriority {
+ public:
+  explicit ScopedTaskPriority(TaskPriority priority);
+  ~ScopedTaskPriority();
+
+  ScopedTaskPriority(const ScopedTaskPriority&) = delete;
+  ScopedTaskPriority& operator=(const ScopedTaskPriority&) = delete;
+
+ private:
+  TaskPriority previous_;
+};
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_THREAD_TASK_PRIORITY_H_
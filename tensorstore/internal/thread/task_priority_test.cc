@@ -0,0 +1,65 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/thread/task_priority.h"
+
+#include <stdint.h>
+
+#include <thread>  // NOLINT
+
+#include <gtest/gtest.h>
+
+namespace {
+
+using ::tensorstore::internal::GetCurrentTaskPriority;
+using ::tensorstore::internal::GetEffectiveTaskPriority;
+using ::tensorstore::internal::kTaskPriorityAgingNanos;
+using ::tensorstore::internal::ScopedTaskPriority;
+using ::tensorstore::internal::TaskPriority;
+
+TEST(TaskPriorityTest, Scoped) {
+  EXPECT_EQ(TaskPriority::kNormal, GetCurrentTaskPriority());
+  {
+    ScopedTaskPriority outer(TaskPriority::kInteractive);
+    EXPECT_EQ(TaskPriority::kInteractive, GetCurrentTaskPriority());
+    {
+      ScopedTaskPriority inner(TaskPriority::kBackground);
+      EXPECT_EQ(TaskPriority::kBackground, GetCurrentTaskPriority());
+    }
+    EXPECT_EQ(TaskPriority::kInteractive, GetCurrentTaskPriority());
+
+    // The priority is per-thread.
+    std::thread thread(
+        [] { EXPECT_EQ(TaskPriority::kNormal, GetCurrentTaskPriority()); });
+    thread.join();
+  }
+  EXPECT_EQ(TaskPriority::kNormal, GetCurrentTaskPriority());
+}
+
+TEST(TaskPriorityTest, Aging) {
+  constexpr int64_t kStart = 1000;
+  EXPECT_EQ(0, GetEffectiveTaskPriority(TaskPriority::kBackground, kStart,
+                                        kStart));
+  EXPECT_EQ(2, GetEffectiveTaskPriority(TaskPriority::kInteractive, kStart,
+                                        kStart + kTaskPriorityAgingNanos - 1));
+  EXPECT_EQ(1, GetEffectiveTaskPriority(TaskPriority::kBackground, kStart,
+                                        kStart + kTaskPriorityAgingNanos));
+  EXPECT_EQ(3, GetEffectiveTaskPriority(TaskPriority::kBackground, kStart,
+                                        kStart + 3 * kTaskPriorityAgingNanos));
+  // Clock skew does not reduce the priority.
+  EXPECT_EQ(1, GetEffectiveTaskPriority(TaskPriority::kNormal, kStart,
+                                        kStart - 1));
+}
+
+}  // namespace
@@ -0,0 +1,33 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/thread/task_tenant.h"
+
+namespace tensorstore {
+namespace internal {
+namespace {
+thread_local TaskTenant current_task_tenant;
+}  // namespace
+
+TaskTenant GetCurrentTaskTenant() { return current_task_tenant; }
+
+ScopedTaskTenant::ScopedTaskTenant(TaskTenant tenant)
+    : previous_(current_task_tenant) {
+  current_task_tenant = tenant;
+}
+
+ScopedTaskTenant::~ScopedTaskTenant() { current_task_tenant = previous_; }
+
+}  // namespace internal
+}  // namespace tensorstore
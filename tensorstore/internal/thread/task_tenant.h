@@ -0,0 +1,59 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_THREAD_TASK_TENANT_H_
+#define TENSORSTORE_INTERNAL_THREAD_TASK_TENANT_H_
+
+#include <stdint.h>
+
+namespace tensorstore {
+namespace internal {
+
+/// Identifies the tenant on whose behalf tasks and rate-limited operations
+/// run, so that rate limiters shared by several tenants divide their capacity
+/// fairly between them.
+///
+/// The tenant of the current thread is set by `ScopedTaskTenant`.  Like
+/// `TaskPriority`, it is recorded by tasks and operations, and thread pool
+/// tasks run with their recorded tenant, so that it carries through
+/// continuations.
+struct TaskTenant {
+  /// Identifier of the tenant; 0 identifies the default tenant.
+  uint64_t id = 0;
+
+  /// Share of rate-limited capacity relative to other tenants.  A weight of 0
+  /// is treated as 1.
+  uint32_t weight = 1;
+};
+
+/// Returns the tenant of the current thread, the default tenant by default.
+TaskTenant GetCurrentTaskTenant();
+
+/// Sets the tenant of the current thread while in scope.
+class ScopedTaskTenant {
+ public:
+  explicit ScopedTaskTenant(TaskTenant tenant);
+  ~ScopedTaskTenant();
+
+  ScopedTaskTenant(const ScopedTaskTenant&) = delete;
+  ScopedTaskTenant& operator=(const ScopedTaskTenant&) = delete;
+
+ private:
+  TaskTenant previous_;
+};
+
+}  // namespace internal
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_THREAD_TASK_TENANT_H_
@@ -0,0 +1,47 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/thread/task_tenant.h"
+
+#include <thread>  // NOLINT
+
+#include <gtest/gtest.h>
+
+namespace {
+
+using ::tensorstore::internal::GetCurrentTaskTenant;
+using ::tensorstore::internal::ScopedTaskTenant;
+
+TEST(TaskTenantTest, Scoped) {
+  EXPECT_EQ(0, GetCurrentTaskTenant().id);
+  EXPECT_EQ(1, GetCurrentTaskTenant().weight);
+  {
+    ScopedTaskTenant outer({/*.id=*/1, /*.weight=*/3});
+    EXPECT_EQ(1, GetCurrentTaskTenant().id);
+    EXPECT_EQ(3, GetCurrentTaskTenant().weight);
+    {
+      ScopedTaskTenant inner({/*.id=*/2});
+      EXPECT_EQ(2, GetCurrentTaskTenant().id);
+      EXPECT_EQ(1, GetCurrentTaskTenant().weight);
+    }
+    EXPECT_EQ(1, GetCurrentTaskTenant().id);
+
+    // The tenant is per-thread.
+    std::thread thread([] { EXPECT_EQ(0, GetCurrentTaskTenant().id); });
+    thread.join();
+  }
+  EXPECT_EQ(0, GetCurrentTaskTenant().id);
+}
+
+}  // namespace
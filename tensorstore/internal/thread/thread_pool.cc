@@ -16,18 +16,23 @@
 
 #include <stddef.h>
 
+#include <atomic>
 #include <cassert>
 #include <limits>
 #include <memory>
+#include <string_view>
 #include <thread>  // NOLINT
 #include <utility>
+#include <vector>
 
 #include "absl/base/no_destructor.h"
 #include "absl/log/absl_log.h"
 #include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/os/numa.h"
 #include "tensorstore/internal/thread/pool_impl.h"
 #include "tensorstore/internal/thread/task.h"
 #include "tensorstore/internal/thread/task_group_impl.h"
+#include "tensorstore/internal/thread/work_stealing_pool.h"
 #include "tensorstore/internal/tracing/trace_context.h"
 #include "tensorstore/util/executor.h"
 
@@ -48,9 +53,52 @@ struct DetachedPoolImpl {
   }
 };
 
-Executor DefaultThreadPool(size_t num_threads) {
-  static absl::NoDestructor<internal_thread_impl::SharedThreadPool> pool_;
-  intrusive_ptr_increment(pool_.get());
+// Reference to the `WorkStealingPool`s held by executors: a single pool, or
+// one pool per NUMA node.  Once released by all executors, the pools only need
+// their threads until the remaining tasks finish.
+struct WorkStealingPoolHandle
+    : public internal::AtomicReferenceCount<WorkStealingPoolHandle> {
+  ~WorkStealingPoolHandle() {
+    for (auto& pool : pools) pool->Detach();
+  }
+
+  // Returns the pool of the preferred NUMA node of the current thread if any,
+  // else the pool of the NUMA node on which the current thread runs, which for
+  // a worker thread is the node of its own pool.
+  internal_thread_impl::WorkStealingPool& SelectPool() const {
+    if (pools.size() == 1) return *pools[0];
+    int node_id = internal_os::GetPreferredNumaNode();
+    if (node_id == -1) node_id = internal_os::GetCurrentNumaNode();
+    for (size_t i = 0; i < node_ids.size(); ++i) {
+      if (node_ids[i] == node_id) return *pools[i];
+    }
+    return *pools[next_pool.fetch_add(1, std::memory_order_relaxed) %
+                  pools.size()];
+  }
+
+  std::vector<internal::IntrusivePtr<internal_thread_impl::WorkStealingPool>>
+      pools;
+  // NUMA node id corresponding to each of `pools`, if NUMA-aware.
+  std::vector<int> node_ids;
+  // Round-robin index for tasks without a known NUMA node.
+  mutable std::atomic<size_t> next_pool{0};
+};
+
+struct WorkStealingPoolImpl {
+  internal::IntrusivePtr<WorkStealingPoolHandle> handle;
+
+  void operator()(ExecutorTask task, internal_tracing::TraceContext tc) const {
+    handle->SelectPool().AddTask(
+        std::make_unique<internal_thread_impl::InFlightTask>(std::move(task),
+                                                             std::move(tc)));
+  }
+  void operator()(ExecutorTask task) const {
+    operator()(std::move(task), internal_tracing::TraceContext(
+                                    internal_tracing::TraceContext::kThread));
+  }
+};
+
+size_t BoundNumThreads(size_t num_threads) {
   if (num_threads == 0 || num_threads == std::numeric_limits<size_t>::max()) {
     // Threads are "unbounded"; that doesn't work so well, so put a bound on it.
     num_threads = std::thread::hardware_concurrency() * 16;
@@ -59,17 +107,94 @@ Executor DefaultThreadPool(size_t num_threads) {
         << "DetachedThreadPool should specify num_threads; using "
         << num_threads;
   }
+  return num_threads;
+}
+
+// Number of continuations currently run inline by `InlineContinuationExecutor`
+// on the current thread.
+thread_local int inline_continuation_depth = 0;
+
+Executor DefaultThreadPool(size_t num_threads,
+                           std::string_view metrics_label) {
+  static absl::NoDestructor<internal_thread_impl::SharedThreadPool> pool_;
+  intrusive_ptr_increment(pool_.get());
+  num_threads = BoundNumThreads(num_threads);
 
   return DetachedPoolImpl{internal_thread_impl::TaskGroup::Make(
       internal::IntrusivePtr<internal_thread_impl::SharedThreadPool>(
           pool_.get()),
-      num_threads)};
+      num_threads, metrics_label)};
 }
 
 }  // namespace
 
-Executor DetachedThreadPool(size_t num_threads) {
-  return DefaultThreadPool(num_threads);
+Executor DetachedThreadPool(size_t num_threads,
+                            std::string_view metrics_label) {
+  return DefaultThreadPool(num_threads, metrics_label);
+}
+
+Executor WorkStealingThreadPool(size_t num_threads,
+                                std::string_view metrics_label) {
+  auto handle = internal::MakeIntrusivePtr<WorkStealingPoolHandle>();
+  handle->pools.push_back(internal_thread_impl::WorkStealingPool::Make(
+      BoundNumThreads(num_threads), nullptr, metrics_label));
+  return WorkStealingPoolImpl{std::move(handle)};
+}
+
+Executor NumaThreadPool(size_t num_threads, std::string_view metrics_label) {
+  const auto& nodes = internal_os::GetNumaNodes();
+  if (nodes.size() <= 1) {
+    return WorkStealingThreadPool(num_threads, metrics_label);
+  }
+  num_threads = BoundNumThreads(num_threads);
+  size_t total_cpus = 0;
+  for (const auto& node : nodes) total_cpus += node.cpus.size();
+
+  auto handle = internal::MakeIntrusivePtr<WorkStealingPoolHandle>();
+  size_t cumulative_cpus = 0;
+  size_t assigned_threads = 0;
+  for (const auto& node : nodes) {
+    // Divide the threads among the nodes in proportion to their CPUs, without
+    // exceeding `num_threads` in total.  Tasks preferring a node without
+    // threads are spread over the other nodes.
+    cumulative_cpus += node.cpus.size();
+    const size_t node_threads =
+        num_threads * cumulative_cpus / total_cpus - assigned_threads;
+    if (node_threads == 0) continue;
+    assigned_threads += node_threads;
+    handle->pools.push_back(internal_thread_impl::WorkStealingPool::Make(
+        node_threads,
+        [node] {
+          auto status = internal_os::SetCurrentThreadNumaNode(node);
+          ABSL_LOG_IF(WARNING, !status.ok()) << status;
+        },
+        metrics_label));
+    handle->node_ids.push_back(node.id);
+  }
+  return WorkStealingPoolImpl{std::move(handle)};
+}
+
+bool IsCurrentThreadInPool(const Executor& executor) {
+  if (auto* pool = executor.target<DetachedPoolImpl>()) {
+    return pool->task_group->IsCurrentThreadWorker();
+  }
+  if (auto* pool = executor.target<WorkStealingPoolImpl>()) {
+    for (const auto& p : pool->handle->pools) {
+      if (p->IsCurrentThreadWorker()) return true;
+    }
+  }
+  return false;
+}
+
+void InlineContinuationExecutor::operator()(ExecutorTask task) const {
+  if (inline_continuation_depth < kMaxInlineContinuationDepth &&
+      (cost <= kInlineContinuationMaxCost || IsCurrentThreadInPool(executor))) {
+    ++inline_continuation_depth;
+    std::move(task)();
+    --inline_continuation_depth;
+    return;
+  }
+  executor(std::move(task));
 }
 
 }  // namespace internal
@@ -17,6 +17,9 @@
 
 #include <stddef.h>
 
+#include <limits>
+#include <string_view>
+
 #include "tensorstore/util/executor.h"
 
 namespace tensorstore {
@@ -28,7 +31,77 @@ namespace internal {
 /// is destroyed and all queued work has finished.
 ///
 /// \param num_threads Maximum number of threads to use.
-Executor DetachedThreadPool(size_t num_threads);
+/// \param metrics_label Label under which the metrics of the pool are
+///     reported, such as the id of the concurrency resource that owns it.
+Executor DetachedThreadPool(size_t num_threads,
+                            std::string_view metrics_label = "default");
+
+/// Returns a detached thread pool executor that schedules tasks by work
+/// stealing.
+///
+/// Unlike `DetachedThreadPool`, the returned executor has its own threads,
+/// each with a local task queue.  Tasks submitted from within a task run on
+/// the same thread unless another idle thread steals them, which favors small
+/// tasks with continuations, such as data copies and kvstore callbacks.
+///
+/// The thread pool remains alive until the last copy of the returned executor
+/// is destroyed and all queued work has finished.
+///
+/// \param num_threads Maximum number of threads to use.
+/// \param metrics_label Label under which the metrics of the pool are
+///     reported, such as the id of the concurrency resource that owns it.
+Executor WorkStealingThreadPool(size_t num_threads,
+                                std::string_view metrics_label = "default");
+
+/// Returns a detached thread pool executor with a `WorkStealingThreadPool` per
+/// NUMA node, whose threads are pinned to the CPUs of the node.
+///
+/// The threads are divided among the nodes in proportion to their number of
+/// CPUs.  A task runs on the node given by
+/// `internal_os::GetPreferredNumaNode()` for the submitting thread, if any, or
+/// else on the node on which the submitting thread runs; in particular tasks
+/// submitted by a task stay on its node.  On machines with a single node, this
+/// is equivalent to `WorkStealingThreadPool`.
+///
+/// \param num_threads Maximum number of threads to use.
+/// \param metrics_label Label under which the metrics of the pool are
+///     reported, such as the id of the concurrency resource that owns it.
+Executor NumaThreadPool(size_t num_threads,
+                        std::string_view metrics_label = "default");
+
+/// Returns `true` if the current thread is a worker thread of `executor`, which
+/// was returned by `DetachedThreadPool`, `WorkStealingThreadPool` or
+/// `NumaThreadPool`.  Returns `false` for any other executor.
+bool IsCurrentThreadInPool(const Executor& executor);
+
+/// Maximum cost, in bytes, of a continuation that `InlineContinuationExecutor`
+/// runs inline from any thread.
+constexpr size_t kInlineContinuationMaxCost = 16 * 1024;
+
+/// Maximum nesting depth of continuations run inline by
+/// `InlineContinuationExecutor` on a single thread.
+constexpr int kMaxInlineContinuationDepth = 16;
+
+/// Executor for short continuations of asynchronous operations, such as
+/// resolving the promises of a completed read.
+///
+/// Runs tasks inline, rather than hopping to another thread, if the current
+/// thread is already a worker thread of `executor`, or if the task is known to
+/// be cheap, as indicated by `cost`.  Otherwise, submits tasks to `executor`.
+///
+/// To bound the stack depth, tasks are always submitted to `executor` once
+/// `kMaxInlineContinuationDepth` inline continuations are nested on the
+/// current thread.
+struct InlineContinuationExecutor {
+  void operator()(ExecutorTask task) const;
+
+  /// Executor to which tasks are submitted if not run inline.
+  Executor executor;
+
+  /// Estimated cost of each task, in bytes processed.  Tasks are run inline
+  /// from any thread if `cost <= kInlineContinuationMaxCost`.
+  size_t cost = std::numeric_limits<size_t>::max();
+};
 
 }  // namespace internal
 }  // namespace tensorstore
@@ -14,13 +14,120 @@
 
 #include "tensorstore/internal/thread/thread_pool.h"  // IWYU pragma: keep
 
+#include <algorithm>
+#include <functional>
 #include <string>
+#include <vector>
 
 #include "absl/flags/commandlineflag.h"  // IWYU pragma: keep
 #include "absl/flags/reflection.h"       // IWYU pragma: keep
+#include "absl/synchronization/mutex.h"
+#include "absl/synchronization/notification.h"
+#include "tensorstore/internal/thread/task_priority.h"
 
 void SetupThreadPoolTestEnv() {
   // No op
 }
 
 #include "tensorstore/internal/thread/thread_pool_test.inc"  // IWYU pragma: keep
+
+namespace {
+
+using ::tensorstore::internal::InlineContinuationExecutor;
+using ::tensorstore::internal::IsCurrentThreadInPool;
+using ::tensorstore::internal::kInlineContinuationMaxCost;
+using ::tensorstore::internal::kMaxInlineContinuationDepth;
+using ::tensorstore::internal::ScopedTaskPriority;
+using ::tensorstore::internal::TaskPriority;
+using ::tensorstore::internal::WorkStealingThreadPool;
+
+// Tests that queued interactive tasks run before queued background tasks.
+TEST(DetachedThreadPoolTest, Priority) {
+  auto executor = DetachedThreadPool(1);
+  absl::Notification blocked, unblock, done;
+  executor([&] {
+    blocked.Notify();
+    unblock.WaitForNotification();
+  });
+  blocked.WaitForNotification();
+
+  absl::Mutex mutex;
+  std::vector<TaskPriority> order;
+  auto add_task = [&](TaskPriority priority, bool last) {
+    ScopedTaskPriority scope(priority);
+    executor([&, priority, last] {
+      EXPECT_EQ(priority, tensorstore::internal::GetCurrentTaskPriority());
+      absl::MutexLock lock(&mutex);
+      order.push_back(priority);
+      if (last) done.Notify();
+    });
+  };
+  add_task(TaskPriority::kBackground, false);
+  add_task(TaskPriority::kNormal, false);
+  add_task(TaskPriority::kInteractive, false);
+  add_task(TaskPriority::kBackground, true);
+  unblock.Notify();
+  done.WaitForNotification();
+
+  absl::MutexLock lock(&mutex);
+  EXPECT_EQ(order,
+            (std::vector<TaskPriority>{
+                TaskPriority::kInteractive, TaskPriority::kNormal,
+                TaskPriority::kBackground, TaskPriority::kBackground}));
+}
+
+// Tests that continuations run inline on a worker thread of the executor.
+TEST(InlineContinuationExecutorTest, InPool) {
+  for (auto executor : {DetachedThreadPool(2), WorkStealingThreadPool(2)}) {
+    EXPECT_FALSE(IsCurrentThreadInPool(executor));
+    absl::Notification done;
+    executor([&] {
+      EXPECT_TRUE(IsCurrentThreadInPool(executor));
+      EXPECT_FALSE(IsCurrentThreadInPool(DetachedThreadPool(1)));
+      bool ran = false;
+      InlineContinuationExecutor{executor}([&] { ran = true; });
+      EXPECT_TRUE(ran);
+      done.Notify();
+    });
+    done.WaitForNotification();
+  }
+}
+
+// Tests that continuations run inline from other threads only if cheap.
+TEST(InlineContinuationExecutorTest, Cost) {
+  auto executor = DetachedThreadPool(1);
+  absl::Notification unblock, done;
+  executor([&] { unblock.WaitForNotification(); });
+  bool ran = false;
+  InlineContinuationExecutor{executor, kInlineContinuationMaxCost}(
+      [&] { ran = true; });
+  EXPECT_TRUE(ran);
+  InlineContinuationExecutor{executor, kInlineContinuationMaxCost + 1}(
+      [&] { done.Notify(); });
+  EXPECT_FALSE(done.HasBeenNotified());
+  unblock.Notify();
+  done.WaitForNotification();
+}
+
+// Tests that the nesting depth of inline continuations is bounded.
+TEST(InlineContinuationExecutorTest, MaxDepth) {
+  std::vector<tensorstore::ExecutorTask> queued;
+  InlineContinuationExecutor continuation{
+      [&](tensorstore::ExecutorTask task) { queued.push_back(std::move(task)); },
+      /*cost=*/0};
+  int depth = 0, max_depth = 0, count = 0;
+  std::function<void()> nest = [&] {
+    max_depth = std::max(max_depth, ++depth);
+    if (++count < 100) continuation([&] { nest(); });
+    --depth;
+  };
+  nest();
+  EXPECT_EQ(kMaxInlineContinuationDepth + 1, max_depth);
+  ASSERT_EQ(1, queued.size());
+  auto task = std::move(queued[0]);
+  queued.clear();
+  std::move(task)();
+  EXPECT_EQ(kMaxInlineContinuationDepth * 2 + 2, count);
+}
+
+}  // namespace
@@ -0,0 +1,361 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/thread/work_stealing_pool.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "absl/base/call_once.h"
+#include "absl/base/no_destructor.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/container/single_producer_queue.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/metrics/counter.h"
+#include "tensorstore/internal/metrics/metadata.h"
+#include "tensorstore/internal/os/fork_detection.h"
+#include "tensorstore/internal/thread/fork_registry.h"
+#include "tensorstore/internal/thread/pool_metrics.h"
+#include "tensorstore/internal/thread/task.h"
+#include "tensorstore/internal/thread/thread.h"
+
+using ::tensorstore::internal_metrics::MetricMetadata;
+
+namespace tensorstore {
+namespace internal_thread_impl {
+namespace {
+
+constexpr absl::Duration kThreadIdleBeforeExit = absl::Seconds(20);
+
+// Capacity of the deque of each worker.  Tasks beyond this overflow to the
+// injection queue.
+constexpr int64_t kWorkerQueueCapacity = 256;
+
+auto& work_stealing_started = internal_metrics::Counter<int64_t>::New(
+    "/tensorstore/thread_pool/work_stealing/started",
+    MetricMetadata("Threads started by WorkStealingPool"));
+
+auto& work_stealing_steal_count = internal_metrics::Counter<int64_t>::New(
+    "/tensorstore/thread_pool/work_stealing/steal_count",
+    MetricMetadata("WorkStealingPool steal count"));
+
+// Tunable parameter: Self-assign up to 1/8 of the injected tasks (max 16) when
+// taking a task from the injection queue.
+inline size_t ItemsToSelfAssign(size_t available) {
+  return (std::min)(size_t{16}, available >> 3);
+}
+
+}  // namespace
+
+struct WorkStealingPool::Worker {
+  explicit Worker(WorkStealingPool* pool) : pool(pool) {}
+
+  WorkStealingPool* const pool;
+
+  // Most recently added task, which runs next on this worker's thread unless
+  // it is stolen.
+  std::atomic<InFlightTask*> lifo_slot{nullptr};
+
+  // Tasks added by this worker's thread.
+  internal_container::SingleProducerQueue<InFlightTask*, false> queue{
+      kWorkerQueueCapacity};
+
+  // Index at which to start looking for a worker to steal from.
+  size_t steal_index = 0;
+
+  // Indicates whether a thread is assigned to this worker.  Guarded by
+  // `pool->mutex_`.
+  bool active = false;
+};
+
+namespace {
+thread_local WorkStealingPool::Worker* current_worker = nullptr;
+}  // namespace
+
+WorkStealingPool::WorkStealingPool(private_t, size_t thread_limit,
+                                   ThreadStartCallback on_thread_start,
+                                   ThreadPoolMetrics& metrics)
+    : thread_limit_(std::max(size_t{1}, thread_limit)),
+      on_thread_start_(std::move(on_thread_start)),
+      metrics_(metrics),
+      workers_(new std::atomic<Worker*>[thread_limit_]) {
+  for (size_t i = 0; i < thread_limit_; ++i) {
+    workers_[i].store(nullptr, std::memory_order_relaxed);
+  }
+  static absl::once_flag once;
+  absl::call_once(once, [] {
+    internal_os::RegisterForkHandlers({
+        /*prepare=*/+[] { fork_registry().PrepareFork(); },
+        /*parent=*/+[] { fork_registry().ParentAfterFork(); },
+        /*child=*/+[] { fork_registry().ChildAfterFork(); },
+    });
+  });
+  fork_registry().Add(this);
+}
+
+WorkStealingPool::~WorkStealingPool() {
+  fork_registry().Remove(this);
+  assert(num_workers_.load(std::memory_order_relaxed) == 0);
+  assert(injection_queue_.empty());
+  for (size_t i = 0, n = num_slots_.load(); i < n; ++i) {
+    delete workers_[i].load(std::memory_order_relaxed);
+  }
+}
+
+ForkRegistry<WorkStealingPool>& WorkStealingPool::fork_registry() {
+  static absl::NoDestructor<ForkRegistry<WorkStealingPool>> registry;
+  return *registry;
+}
+
+void WorkStealingPool::PrepareFork() { mutex_.Lock(); }
+
+void WorkStealingPool::ParentAfterFork() { mutex_.Unlock(); }
+
+void WorkStealingPool::ChildAfterFork() ABSL_NO_THREAD_SAFETY_ANALYSIS {
+  // Only the forking thread exists in the child process, so the mutex and
+  // condition variable, which may still list the other threads as waiters,
+  // are reinitialized rather than unlocked.
+  new (&mutex_) absl::Mutex;
+  new (&idle_condvar_) absl::CondVar;
+  absl::MutexLock lock(&mutex_);
+  for (size_t i = 0, n = num_slots_.load(); i < n; ++i) {
+    Worker* worker = workers_[i].load(std::memory_order_relaxed);
+    while (InFlightTask* t = worker->queue.try_pop()) {
+      injection_queue_.push_back(std::unique_ptr<InFlightTask>(t));
+    }
+    if (InFlightTask* t = worker->lifo_slot.exchange(nullptr)) {
+      injection_queue_.push_back(std::unique_ptr<InFlightTask>(t));
+    }
+    worker->active = false;
+  }
+  num_workers_.store(0, std::memory_order_relaxed);
+  num_idle_.store(0, std::memory_order_relaxed);
+  num_injected_.store(injection_queue_.size(), std::memory_order_relaxed);
+  wakeups_ = 0;
+  if (!injection_queue_.empty()) NotifyWorkAvailable();
+}
+
+void WorkStealingPool::Detach() {
+  absl::MutexLock lock(&mutex_);
+  detached_ = true;
+  idle_condvar_.SignalAll();
+}
+
+bool WorkStealingPool::IsCurrentThreadWorker() const {
+  return current_worker != nullptr && current_worker->pool == this;
+}
+
+void WorkStealingPool::AddTask(std::unique_ptr<InFlightTask> task) {
+  metrics_.queued_tasks.Increment();
+  Worker* worker = current_worker;
+  if (worker == nullptr || worker->pool != this) {
+    // This is not from a worker thread, so do fork detection.
+    internal_os::AbortIfForkDetected();
+    absl::MutexLock lock(&mutex_);
+    injection_queue_.push_back(std::move(task));
+    num_injected_.store(injection_queue_.size(), std::memory_order_relaxed);
+    NotifyWorkAvailable();
+    return;
+  }
+
+  // Add to the LIFO slot, moving the previous occupant to the deque.
+  InFlightTask* displaced =
+      worker->lifo_slot.exchange(task.release(), std::memory_order_acq_rel);
+  if (displaced != nullptr && !worker->queue.push(displaced)) {
+    // The deque is full; migrate half of it to the injection queue.
+    absl::MutexLock lock(&mutex_);
+    for (size_t n = worker->queue.size() >> 1; n > 0; --n) {
+      InFlightTask* t = worker->queue.try_pop();
+      if (t == nullptr) break;
+      injection_queue_.push_back(std::unique_ptr<InFlightTask>(t));
+    }
+    injection_queue_.push_back(std::unique_ptr<InFlightTask>(displaced));
+    num_injected_.store(injection_queue_.size(), std::memory_order_relaxed);
+    NotifyWorkAvailable();
+    return;
+  }
+
+  // Pairs with the increment of `num_idle_` in `WaitForWork`: either this
+  // thread observes the idle worker, or the idle worker observes the task.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (num_idle_.load(std::memory_order_relaxed) != 0 ||
+      num_workers_.load(std::memory_order_relaxed) < thread_limit_) {
+    absl::MutexLock lock(&mutex_);
+    NotifyWorkAvailable();
+  }
+}
+
+void WorkStealingPool::NotifyWorkAvailable() {
+  if (num_idle_.load(std::memory_order_relaxed) > wakeups_) {
+    ++wakeups_;
+    idle_condvar_.Signal();
+  } else if (num_workers_.load(std::memory_order_relaxed) < thread_limit_) {
+    StartWorker();
+  }
+}
+
+void WorkStealingPool::StartWorker() {
+  Worker* worker = nullptr;
+  const size_t num_slots = num_slots_.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < num_slots; ++i) {
+    Worker* w = workers_[i].load(std::memory_order_relaxed);
+    if (!w->active) {
+      worker = w;
+      break;
+    }
+  }
+  if (worker == nullptr) {
+    assert(num_slots < thread_limit_);
+    worker = new Worker(this);
+    worker->steal_index = num_slots;
+    workers_[num_slots].store(worker, std::memory_order_release);
+    num_slots_.store(num_slots + 1, std::memory_order_release);
+  }
+  worker->active = true;
+  num_workers_.fetch_add(1, std::memory_order_relaxed);
+  work_stealing_started.Increment();
+  tensorstore::internal::Thread::StartDetached(
+      {"ts_work_stealing"},
+      [self = internal::IntrusivePtr<WorkStealingPool>(this), worker] {
+        self->WorkerBody(worker);
+      });
+}
+
+void WorkStealingPool::WorkerBody(Worker* worker) {
+  assert(current_worker == nullptr);
+  current_worker = worker;
+  if (on_thread_start_) on_thread_start_();
+  while (true) {
+    if (InFlightTask* task = FindTask(worker)) {
+      const int64_t start_nanos = absl::GetCurrentTimeNanos();
+      RecordTaskStart(metrics_, task->start_nanos, start_nanos);
+      std::unique_ptr<InFlightTask>(task)->Run();
+      RecordTaskStop(metrics_, start_nanos, absl::GetCurrentTimeNanos());
+      continue;
+    }
+    if (!WaitForWork(worker)) break;
+  }
+  current_worker = nullptr;
+}
+
+InFlightTask* WorkStealingPool::FindTask(Worker* worker) {
+  // First, the task most recently added by this worker.
+  if (auto* t = worker->lifo_slot.exchange(nullptr, std::memory_order_acquire);
+      t != nullptr) {
+    return t;
+  }
+  // Second, the remaining tasks added by this worker.
+  if (auto* t = worker->queue.try_pop(); t != nullptr) {
+    return t;
+  }
+  // Third, tasks added from outside the pool.
+  if (num_injected_.load(std::memory_order_relaxed) != 0) {
+    absl::MutexLock lock(&mutex_);
+    if (!injection_queue_.empty()) {
+      InFlightTask* task = injection_queue_.front().release();
+      injection_queue_.pop_front();
+      // Tunable parameter: Preemptively assign additional items to self, where
+      // other workers may still steal them.
+      for (size_t n = ItemsToSelfAssign(injection_queue_.size()); n > 0; --n) {
+        if (!worker->queue.push(injection_queue_.front().get())) break;
+        injection_queue_.front().release();
+        injection_queue_.pop_front();
+      }
+      num_injected_.store(injection_queue_.size(), std::memory_order_relaxed);
+      return task;
+    }
+  }
+  // Finally, tasks of other workers.
+  return Steal(worker);
+}
+
+InFlightTask* WorkStealingPool::Steal(Worker* worker) {
+  const size_t num_slots = num_slots_.load(std::memory_order_acquire);
+  // Steal from the deques first, since the LIFO slot of a worker is the task
+  // it is about to run.
+  for (int pass = 0; pass < 2; ++pass) {
+    for (size_t i = 0; i < num_slots; ++i) {
+      Worker* other =
+          workers_[(worker->steal_index + i) % num_slots].load(
+              std::memory_order_acquire);
+      if (other == worker) continue;
+      InFlightTask* t =
+          pass == 0 ? other->queue.try_steal()
+                    : other->lifo_slot.exchange(nullptr,
+                                                std::memory_order_acquire);
+      if (t == nullptr) continue;
+      worker->steal_index += i;
+      work_stealing_steal_count.Increment();
+      return t;
+    }
+  }
+  return nullptr;
+}
+
+bool WorkStealingPool::HasStealableTask() {
+  const size_t num_slots = num_slots_.load(std::memory_order_acquire);
+  for (size_t i = 0; i < num_slots; ++i) {
+    Worker* other = workers_[i].load(std::memory_order_acquire);
+    if (!other->queue.empty() ||
+        other->lifo_slot.load(std::memory_order_relaxed) != nullptr) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool WorkStealingPool::WaitForWork(Worker* worker) {
+  absl::MutexLock lock(&mutex_);
+  // Pairs with the fence in `AddTask`.
+  num_idle_.fetch_add(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  bool has_work = !injection_queue_.empty() || HasStealableTask();
+  if (!has_work) {
+    const absl::Time deadline = absl::Now() + kThreadIdleBeforeExit;
+    while (wakeups_ == 0 && injection_queue_.empty() && !detached_) {
+      if (idle_condvar_.WaitWithDeadline(&mutex_, deadline)) break;
+    }
+    if (wakeups_ != 0) {
+      --wakeups_;
+      has_work = true;
+    } else {
+      has_work = !injection_queue_.empty();
+    }
+  }
+  num_idle_.fetch_sub(1, std::memory_order_relaxed);
+  // Signaled wakeups never exceed the number of idle workers.
+  wakeups_ = std::min(wakeups_, num_idle_.load(std::memory_order_relaxed));
+  if (has_work) return true;
+
+  // Only the thread of this worker adds to its deque and LIFO slot, and both
+  // are empty at this point.
+  assert(worker->queue.empty());
+  assert(worker->lifo_slot.load(std::memory_order_relaxed) == nullptr);
+  worker->active = false;
+  num_workers_.fetch_sub(1, std::memory_order_relaxed);
+  return false;
+}
+
+}  // namespace internal_thread_impl
+}  // namespace tensorstore
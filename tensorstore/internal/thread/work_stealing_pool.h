@@ -0,0 +1,153 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_THREAD_WORK_STEALING_POOL_H_
+#define TENSORSTORE_INTERNAL_THREAD_WORK_STEALING_POOL_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/internal/container/block_queue.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/thread/fork_registry.h"
+#include "tensorstore/internal/thread/pool_metrics.h"
+#include "tensorstore/internal/thread/task.h"
+
+namespace tensorstore {
+namespace internal_thread_impl {
+
+/// Thread pool that balances tasks among its threads by work stealing.
+///
+/// Each worker thread owns a bounded Chase-Lev deque of tasks and a "LIFO
+/// slot".  A task added by a worker goes into its LIFO slot, moving the
+/// previous occupant onto the deque, so that a continuation runs next on the
+/// thread that produced it, while its data is likely still in cache.  Tasks
+/// added by other threads go into a global injection queue.  A worker that runs
+/// out of local tasks takes tasks from the injection queue, and then steals
+/// from the deques and LIFO slots of other workers without locking.
+///
+/// Unlike `TaskGroup`, only the injection queue and idle-worker bookkeeping
+/// are guarded by a mutex, and the worker threads belong to this pool rather
+/// than to a `SharedThreadPool`.
+///
+/// Worker threads are started on demand up to `thread_limit`, and exit after
+/// being idle for a while, or as soon as they are idle once `Detach` has been
+/// called.  If specified, `on_thread_start` is called on each worker thread
+/// before it runs any task, e.g. to set its CPU affinity.
+///
+/// When fork support is enabled, the pool forgets its threads in the child
+/// process after `fork()`, and starts new threads as needed.
+class WorkStealingPool
+    : public internal::AtomicReferenceCount<WorkStealingPool> {
+  struct private_t {};
+
+ public:
+  struct Worker;
+
+  using ThreadStartCallback = absl::AnyInvocable<void() const>;
+
+  /// Returns a new pool.  Its metrics are reported under `metrics_label`, see
+  /// `GetThreadPoolMetrics`.
+  static internal::IntrusivePtr<WorkStealingPool> Make(
+      size_t thread_limit, ThreadStartCallback on_thread_start = nullptr,
+      std::string_view metrics_label = kDefaultThreadPoolMetricsLabel) {
+    return internal::MakeIntrusivePtr<WorkStealingPool>(
+        private_t{}, thread_limit, std::move(on_thread_start),
+        GetThreadPoolMetrics(metrics_label));
+  }
+
+  WorkStealingPool(private_t, size_t thread_limit,
+                   ThreadStartCallback on_thread_start,
+                   ThreadPoolMetrics& metrics);
+  ~WorkStealingPool();
+
+  /// Enqueues a task.
+  ///
+  /// Thread safety: safe to call concurrently from multiple threads.
+  void AddTask(std::unique_ptr<InFlightTask> task);
+
+  /// Indicates that the pool is no longer referenced except by its own tasks,
+  /// so that idle worker threads should exit rather than wait for new tasks.
+  void Detach();
+
+  /// Returns `true` if the current thread is a worker thread of this pool.
+  bool IsCurrentThreadWorker() const;
+
+  /// Live pools, see `ForkRegistry`.
+  static ForkRegistry<WorkStealingPool>& fork_registry();
+
+  /// Fork handlers: `PrepareFork` locks the pool until `ParentAfterFork`, or
+  /// until `ChildAfterFork` moves the tasks of the workers, whose threads do
+  /// not exist in the child process, to the injection queue.
+  void PrepareFork() ABSL_EXCLUSIVE_LOCK_FUNCTION(mutex_);
+  void ParentAfterFork() ABSL_UNLOCK_FUNCTION(mutex_);
+  void ChildAfterFork() ABSL_UNLOCK_FUNCTION(mutex_);
+
+ private:
+  /// Worker method: Runs tasks on the current thread until idle for too long.
+  void WorkerBody(Worker* worker);
+
+  /// Worker method: Returns the next task to run, or `nullptr`.
+  InFlightTask* FindTask(Worker* worker);
+
+  /// Worker method: Steals a task from another worker, or returns `nullptr`.
+  InFlightTask* Steal(Worker* worker);
+
+  /// Worker method: Waits until work may be available.  Returns `false` if the
+  /// worker should exit instead.
+  bool WaitForWork(Worker* worker);
+
+  /// Returns `true` if any worker has a task that may be stolen.
+  bool HasStealableTask();
+
+  /// Wakes an idle worker, or starts a new worker if there is none.
+  void NotifyWorkAvailable() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  void StartWorker() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const size_t thread_limit_;
+  const ThreadStartCallback on_thread_start_;
+  ThreadPoolMetrics& metrics_;
+
+  // Workers, of which the first `num_slots_` are allocated.  Slots are reused
+  // by new threads once their thread exits, and the workers are only destroyed
+  // along with the pool, so that they may be accessed without locking.
+  const std::unique_ptr<std::atomic<Worker*>[]> workers_;
+  std::atomic<size_t> num_slots_{0};
+
+  // Updated while holding `mutex_`, read without locking.
+  std::atomic<size_t> num_workers_{0};
+  std::atomic<size_t> num_idle_{0};
+  std::atomic<size_t> num_injected_{0};
+
+  absl::Mutex mutex_;
+  absl::CondVar idle_condvar_;
+  internal_container::BlockQueue<std::unique_ptr<InFlightTask>>
+      injection_queue_ ABSL_GUARDED_BY(mutex_);
+  // Number of idle workers that have been signaled but have not yet woken.
+  size_t wakeups_ ABSL_GUARDED_BY(mutex_) = 0;
+  bool detached_ ABSL_GUARDED_BY(mutex_) = false;
+};
+
+}  // namespace internal_thread_impl
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_THREAD_WORK_STEALING_POOL_H_
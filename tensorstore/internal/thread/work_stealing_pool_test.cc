@@ -0,0 +1,170 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/thread/work_stealing_pool.h"
+
+#include <stddef.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/synchronization/blocking_counter.h"
+#include "absl/synchronization/notification.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/thread/task.h"
+#include "tensorstore/internal/tracing/trace_context.h"
+
+namespace {
+
+using ::tensorstore::internal::IntrusivePtr;
+using ::tensorstore::internal_thread_impl::InFlightTask;
+using ::tensorstore::internal_thread_impl::WorkStealingPool;
+using TC = ::tensorstore::internal_tracing::TraceContext;
+
+template <typename Callback>
+void AddTask(WorkStealingPool& pool, Callback callback) {
+  pool.AddTask(
+      std::make_unique<InFlightTask>(std::move(callback), TC(TC::kThread)));
+}
+
+TEST(WorkStealingPoolTest, Basic) {
+  auto pool = WorkStealingPool::Make(2);
+  absl::Notification notification;
+  AddTask(*pool, [&] { notification.Notify(); });
+  notification.WaitForNotification();
+  pool->Detach();
+}
+
+// Tests tasks added from within tasks, which use the LIFO slot and deque of
+// the worker and are stolen by other workers.
+TEST(WorkStealingPoolTest, NestedTasks) {
+  auto pool = WorkStealingPool::Make(4);
+  constexpr size_t kOuter = 64;
+  constexpr size_t kInner = 1000;
+  absl::BlockingCounter done(kOuter * kInner);
+  for (size_t i = 0; i < kOuter; ++i) {
+    AddTask(*pool, [&] {
+      for (size_t j = 0; j < kInner; ++j) {
+        AddTask(*pool, [&] { done.DecrementCount(); });
+      }
+    });
+  }
+  done.Wait();
+  pool->Detach();
+}
+
+// Tests a chain of tasks which each add the next one, and which therefore run
+// from the LIFO slot.
+TEST(WorkStealingPoolTest, Continuations) {
+  auto pool = WorkStealingPool::Make(2);
+  absl::Notification notification;
+  std::atomic<size_t> remaining{10000};
+  struct Step {
+    WorkStealingPool* pool;
+    std::atomic<size_t>* remaining;
+    absl::Notification* notification;
+    void operator()() {
+      if (--*remaining == 0) {
+        notification->Notify();
+        return;
+      }
+      AddTask(*pool, *this);
+    }
+  };
+  AddTask(*pool, Step{pool.get(), &remaining, &notification});
+  notification.WaitForNotification();
+  pool->Detach();
+}
+
+TEST(WorkStealingPoolTest, ManyProducers) {
+  auto pool = WorkStealingPool::Make(4);
+  constexpr size_t kThreads = 8;
+  constexpr size_t kTasks = 10000;
+  absl::BlockingCounter done(kThreads * kTasks);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&] {
+      for (size_t j = 0; j < kTasks; ++j) {
+        AddTask(*pool, [&] { done.DecrementCount(); });
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  done.Wait();
+  pool->Detach();
+}
+
+TEST(WorkStealingPoolTest, ThreadLimit) {
+  constexpr size_t kThreadLimit = 3;
+  auto pool = WorkStealingPool::Make(kThreadLimit);
+  std::atomic<size_t> num_running{0};
+  std::atomic<size_t> max_running{0};
+  absl::BlockingCounter done(20);
+  for (size_t i = 0; i < 20; ++i) {
+    AddTask(*pool, [&] {
+      size_t n = ++num_running;
+      size_t prev = max_running.load();
+      while (prev < n && !max_running.compare_exchange_weak(prev, n)) {
+      }
+      absl::SleepFor(absl::Milliseconds(10));
+      --num_running;
+      done.DecrementCount();
+    });
+  }
+  done.Wait();
+  EXPECT_LE(max_running.load(), kThreadLimit);
+  pool->Detach();
+}
+
+TEST(WorkStealingPoolTest, ThreadStartCallback) {
+  thread_local bool started = false;
+  std::atomic<size_t> num_started{0};
+  auto pool = WorkStealingPool::Make(2, [&] {
+    started = true;
+    ++num_started;
+  });
+  absl::BlockingCounter done(100);
+  for (size_t i = 0; i < 100; ++i) {
+    AddTask(*pool, [&] {
+      EXPECT_TRUE(started);
+      done.DecrementCount();
+    });
+  }
+  done.Wait();
+  EXPECT_LE(num_started.load(), 2);
+  pool->Detach();
+}
+
+// Tests that the pool outlives `Detach` while it still has tasks.
+TEST(WorkStealingPoolTest, DetachWithPendingTasks) {
+  absl::BlockingCounter done(100);
+  {
+    IntrusivePtr<WorkStealingPool> pool = WorkStealingPool::Make(2);
+    for (size_t i = 0; i < 100; ++i) {
+      AddTask(*pool, [&] {
+        absl::SleepFor(absl::Microseconds(100));
+        done.DecrementCount();
+      });
+    }
+    pool->Detach();
+  }
+  done.Wait();
+}
+
+}  // namespace
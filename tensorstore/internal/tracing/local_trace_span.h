@@ -15,34 +15,42 @@
 #ifndef TENSORSTORE_INTERNAL_TRACING_LOCAL_TRACE_SPAN_H_
 #define TENSORSTORE_INTERNAL_TRACING_LOCAL_TRACE_SPAN_H_
 
-#include <stddef.h>
-#include <stdint.h>
-
 #include <initializer_list>
+#include <memory>
 #include <string_view>
 
+#include "absl/status/status.h"
 #include "tensorstore/internal/source_location.h"
+#include "tensorstore/internal/tracing/recorded_span.h"
 #include "tensorstore/internal/tracing/span_attribute.h"
+#include "tensorstore/internal/tracing/trace_context.h"
+#include "tensorstore/internal/tracing/trace_exporter.h"
 #include "tensorstore/util/span.h"
 
 namespace tensorstore {
 namespace internal_tracing {
 
-/// A LocalTraceSpan is a function scope trace annotation used to tag
-/// potentially expensive functions such as io, etc.
+/// Span covering the lifetime of a scope within a traced operation.
 ///
-/// A LocalTraceSpan should be allocated on the stack within a single thread,
-/// and not on the heap. Use `OperationTraceSpan` for asynchronous operations.
+/// A span is recorded only if tracing is enabled and the current thread is
+/// performing work on behalf of a traced operation, in which case it is
+/// recorded as a child of the current span, and becomes the current span of
+/// the thread until it is destroyed.  Must be destroyed on the thread on which
+/// it was constructed.
 class LocalTraceSpan {
  public:
   LocalTraceSpan(std::string_view method,
                  const SourceLocation& location = SourceLocation::current())
-  {}
+      : LocalTraceSpan(method, tensorstore::span<const SpanAttribute>(),
+                       location) {}
 
   LocalTraceSpan(std::string_view method,
                  tensorstore::span<const SpanAttribute> attributes,
-                 const SourceLocation& location = SourceLocation::current())
-  {}
+                 const SourceLocation& location = SourceLocation::current()) {
+    if (IsTracingEnabled() && GetCurrentSpanContext()) {
+      Start(method, attributes, location);
+    }
+  }
 
   LocalTraceSpan(std::string_view method,
                  std::initializer_list<SpanAttribute> attributes,
@@ -52,9 +60,38 @@ class LocalTraceSpan {
                            attributes.begin(), attributes.end()),
                        location) {}
 
-  ~LocalTraceSpan() = default;
+  LocalTraceSpan(const LocalTraceSpan&) = delete;
+  LocalTraceSpan& operator=(const LocalTraceSpan&) = delete;
+
+  ~LocalTraceSpan() {
+    if (span_) End();
+  }
+
+ protected:
+  /// Records the outcome of the span.
+  void SetStatus(const absl::Status& status) {
+    if (span_) span_->SetStatus(status);
+  }
 
  private:
+  void Start(std::string_view method,
+             tensorstore::span<const SpanAttribute> attributes,
+             const SourceLocation& location) {
+    span_ = RecordedSpan::Start(method, attributes, location,
+                                /*start_trace=*/false);
+    if (!span_) return;
+    saved_context_ = TraceContext(span_->context());
+    SwapCurrentTraceContext(&saved_context_);
+  }
+
+  void End() {
+    SwapCurrentTraceContext(&saved_context_);
+    RecordedSpan::End(std::move(span_));
+  }
+
+  std::unique_ptr<RecordedSpan> span_;
+  // Trace context of the thread prior to the start of the span.
+  TraceContext saved_context_{SpanContextPtr()};
 };
 
 }  // namespace internal_tracing
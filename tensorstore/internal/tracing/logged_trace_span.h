@@ -92,6 +92,7 @@ class LoggedTraceSpan : public LocalTraceSpan {
   absl::Status EndWithStatus(
       absl::Status&& status,
       const SourceLocation& location = SourceLocation::current()) && {
+    SetStatus(status);
     if (id_) {
       EndLog(
           absl::LogInfoStreamer(location.file_name(), location.line()).stream())
@@ -0,0 +1,129 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_TRACING_OPERATION_STATS_H_
+#define TENSORSTORE_INTERNAL_TRACING_OPERATION_STATS_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <utility>
+
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+
+namespace tensorstore {
+namespace internal_tracing {
+
+/// I/O statistics accumulated by all work performed on behalf of one or more
+/// operations.  Exposed publicly as `tensorstore::OperationStats`.
+///
+/// The operation stats of the current thread are propagated to asynchronous
+/// work along with the span context by `TraceContext`.
+struct OperationStatsState
+    : public internal::AtomicReferenceCount<OperationStatsState> {
+  std::atomic<int64_t> kvstore_reads{0};
+  std::atomic<int64_t> kvstore_bytes_read{0};
+  std::atomic<int64_t> kvstore_writes{0};
+  std::atomic<int64_t> kvstore_bytes_written{0};
+  std::atomic<int64_t> cache_hits{0};
+  std::atomic<int64_t> cache_misses{0};
+  std::atomic<int64_t> decode_nanoseconds{0};
+};
+
+using OperationStatsPtr = internal::IntrusivePtr<OperationStatsState>;
+
+using OperationStat = std::atomic<int64_t> OperationStatsState::*;
+
+namespace internal_trace_context {
+// Operation stats of the current thread.  Owns a reference, if non-null.
+inline thread_local OperationStatsState* current_operation_stats = nullptr;
+}  // namespace internal_trace_context
+
+/// Returns the operation stats of the current thread, or `nullptr` if none.
+inline OperationStatsState* GetCurrentOperationStats() {
+  return internal_trace_context::current_operation_stats;
+}
+
+/// Adds `value` to `stat` of the operation stats of the current thread, if
+/// any.
+inline void IncrementOperationStat(OperationStat stat, int64_t value = 1) {
+  if (auto* stats = GetCurrentOperationStats()) {
+    (stats->*stat).fetch_add(value, std::memory_order_relaxed);
+  }
+}
+
+/// Adds the lifetime of this object, in nanoseconds, to `stat` of the operation
+/// stats of the constructing thread, if any.
+class ScopedOperationTimer {
+ public:
+  explicit ScopedOperationTimer(OperationStat stat)
+      : stats_(GetCurrentOperationStats()), stat_(stat) {
+    if (stats_) start_ = absl::Now();
+  }
+
+  ~ScopedOperationTimer() {
+    if (stats_) {
+      (stats_.get()->*stat_)
+          .fetch_add(absl::ToInt64Nanoseconds(absl::Now() - start_),
+                     std::memory_order_relaxed);
+    }
+  }
+
+  ScopedOperationTimer(const ScopedOperationTimer&) = delete;
+  ScopedOperationTimer& operator=(const ScopedOperationTimer&) = delete;
+
+ private:
+  OperationStatsPtr stats_;
+  OperationStat stat_;
+  absl::Time start_;
+};
+
+/// Sets the operation stats of the current thread to `stats` for the lifetime
+/// of this object.
+///
+/// If `stats` is null, the operation stats of the current thread are left
+/// unchanged, such that nested operations are attributed to the enclosing
+/// operation.
+class ScopedOperationStats {
+ public:
+  explicit ScopedOperationStats(OperationStatsPtr stats)
+      : stats_(std::move(stats)), active_(static_cast<bool>(stats_)) {
+    if (active_) Swap();
+  }
+
+  ~ScopedOperationStats() {
+    if (active_) Swap();
+  }
+
+  ScopedOperationStats(const ScopedOperationStats&) = delete;
+  ScopedOperationStats& operator=(const ScopedOperationStats&) = delete;
+
+ private:
+  void Swap() {
+    auto& current = internal_trace_context::current_operation_stats;
+    OperationStatsState* previous = current;
+    current = stats_.release();
+    stats_ = OperationStatsPtr(previous, internal::adopt_object_ref);
+  }
+
+  OperationStatsPtr stats_;
+  bool active_;
+};
+
+}  // namespace internal_tracing
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_TRACING_OPERATION_STATS_H_
@@ -15,27 +15,89 @@
 #ifndef TENSORSTORE_INTERNAL_TRACING_OPERATION_TRACE_SPAN_H_
 #define TENSORSTORE_INTERNAL_TRACING_OPERATION_TRACE_SPAN_H_
 
-#include <stddef.h>
-#include <stdint.h>
-
+#include <initializer_list>
+#include <memory>
 #include <string_view>
+#include <utility>
 
+#include "absl/status/status.h"
 #include "tensorstore/internal/source_location.h"
+#include "tensorstore/internal/tracing/recorded_span.h"
+#include "tensorstore/internal/tracing/span_attribute.h"
+#include "tensorstore/internal/tracing/trace_context.h"
+#include "tensorstore/internal/tracing/trace_exporter.h"
+#include "tensorstore/util/span.h"
 
 namespace tensorstore {
 namespace internal_tracing {
 
-/// An OperationTraceSpan is an operation trace annotation used to tag
-/// asynchronous operations which may be long running.
+/// Span covering an asynchronous operation, which ends when the span object is
+/// destroyed, possibly on a different thread.
+///
+/// A span is recorded only if tracing is enabled.  It is recorded as a child of
+/// the current span of the constructing thread; if there is none, a new trace
+/// is started if `start_trace` is `true`, and otherwise no span is recorded.
+///
+/// Unlike `LocalTraceSpan`, the span does not become the current span of the
+/// thread; work performed on behalf of the operation must be started within a
+/// `ScopedTraceContext` for `context()` in order to be recorded as part of the
+/// operation.
 class OperationTraceSpan {
  public:
+  explicit OperationTraceSpan(
+      std::string_view method,
+      const SourceLocation& location = SourceLocation::current())
+      : OperationTraceSpan(method, tensorstore::span<const SpanAttribute>(),
+                           /*start_trace=*/true, location) {}
+
+  OperationTraceSpan(std::string_view method,
+                     tensorstore::span<const SpanAttribute> attributes,
+                     bool start_trace = true,
+                     const SourceLocation& location = SourceLocation::current())
+      : context_(TraceContext::kThread) {
+    if (IsTracingEnabled()) {
+      span_ = RecordedSpan::Start(method, attributes, location, start_trace);
+      if (span_) context_ = TraceContext(span_->context());
+    }
+  }
+
   OperationTraceSpan(std::string_view method,
+                     std::initializer_list<SpanAttribute> attributes,
+                     bool start_trace = true,
                      const SourceLocation& location = SourceLocation::current())
-  {}
+      : OperationTraceSpan(method,
+                           tensorstore::span<const SpanAttribute>(
+                               attributes.begin(), attributes.end()),
+                           start_trace, location) {}
+
+  OperationTraceSpan(OperationTraceSpan&&) = default;
+  OperationTraceSpan& operator=(OperationTraceSpan&&) = default;
+
+  ~OperationTraceSpan() {
+    if (span_) RecordedSpan::End(std::move(span_));
+  }
+
+  /// Returns the trace context for work performed on behalf of the operation.
+  ///
+  /// If no span is recorded, this is the trace context of the constructing
+  /// thread.
+  const TraceContext& context() const { return context_; }
+
+  /// Returns `true` if the span is being recorded.
+  bool recording() const { return span_ != nullptr; }
+
+  void AddAttribute(const SpanAttribute& attribute) {
+    if (span_) span_->AddAttribute(attribute);
+  }
 
-  ~OperationTraceSpan() = default;
+  /// Records the outcome of the operation.
+  void SetStatus(const absl::Status& status) {
+    if (span_) span_->SetStatus(status);
+  }
 
  private:
+  std::unique_ptr<RecordedSpan> span_;
+  TraceContext context_;
 };
 
 }  // namespace internal_tracing
@@ -0,0 +1,203 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/tracing/otlp_exporter.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "absl/log/absl_log.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_format.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/internal/env.h"
+#include "tensorstore/internal/global_initializer.h"
+#include "tensorstore/internal/http/default_transport.h"
+#include "tensorstore/internal/http/http_request.h"
+#include "tensorstore/internal/http/http_response.h"
+#include "tensorstore/internal/http/http_transport.h"
+#include "tensorstore/internal/thread/schedule_at.h"
+#include "tensorstore/internal/tracing/trace_context.h"
+#include "tensorstore/internal/tracing/trace_exporter.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal_tracing {
+namespace {
+
+// https://opentelemetry.io/docs/specs/otlp/#json-protobuf-encoding
+constexpr int kSpanKindInternal = 1;
+constexpr int kStatusCodeError = 2;
+
+::nlohmann::json EncodeAttributeValue(const SpanAttributeValue& value) {
+  return std::visit(
+      [](const auto& v) -> ::nlohmann::json {
+        using T = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<T, bool>) {
+          return {{"boolValue", v}};
+        } else if constexpr (std::is_same_v<T, double>) {
+          return {{"doubleValue", v}};
+        } else if constexpr (std::is_same_v<T, std::string>) {
+          return {{"stringValue", v}};
+        } else {
+          // 64-bit integers are encoded as decimal strings.
+          return {{"intValue", absl::StrFormat("%d", static_cast<int64_t>(v))}};
+        }
+      },
+      value);
+}
+
+std::string UnixNanos(absl::Time t) {
+  return absl::StrFormat("%d", absl::ToUnixNanos(t));
+}
+
+::nlohmann::json EncodeSpan(const SpanData& span) {
+  ::nlohmann::json::array_t attributes;
+  attributes.reserve(span.attributes.size());
+  for (const auto& [key, value] : span.attributes) {
+    attributes.push_back(
+        {{"key", key}, {"value", EncodeAttributeValue(value)}});
+  }
+  ::nlohmann::json j{
+      {"traceId",
+       absl::StrFormat("%016x%016x", span.trace_id_high, span.trace_id_low)},
+      {"spanId", absl::StrFormat("%016x", span.span_id)},
+      {"name", span.name},
+      {"kind", kSpanKindInternal},
+      {"startTimeUnixNano", UnixNanos(span.start_time)},
+      {"endTimeUnixNano", UnixNanos(span.end_time)},
+      {"attributes", std::move(attributes)},
+  };
+  if (span.parent_span_id) {
+    j["parentSpanId"] = absl::StrFormat("%016x", span.parent_span_id);
+  }
+  if (!span.status.ok()) {
+    j["status"] = {{"code", kStatusCodeError},
+                   {"message", span.status.ToString()}};
+  }
+  return j;
+}
+
+void ScheduleFlush(std::weak_ptr<OtlpTraceExporter> exporter,
+                   absl::Duration delay) {
+  internal::ScheduleAt(absl::Now() + delay,
+                       [exporter = std::move(exporter)] {
+                         if (auto self = exporter.lock()) self->Flush();
+                       });
+}
+
+}  // namespace
+
+::nlohmann::json EncodeOtlpTraces(tensorstore::span<const SpanData> spans,
+                                  std::string_view service_name) {
+  ::nlohmann::json::array_t encoded_spans;
+  encoded_spans.reserve(spans.size());
+  for (const auto& span : spans) {
+    encoded_spans.push_back(EncodeSpan(span));
+  }
+  return {{"resourceSpans",
+           {{{"resource",
+              {{"attributes",
+                {{{"key", "service.name"},
+                  {"value", {{"stringValue", service_name}}}}}}}},
+             {"scopeSpans",
+              {{{"scope", {{"name", "tensorstore"}}},
+                {"spans", std::move(encoded_spans)}}}}}}}};
+}
+
+OtlpTraceExporter::OtlpTraceExporter(OtlpExporterOptions options)
+    : options_(std::move(options)) {}
+
+void OtlpTraceExporter::Export(SpanData span) {
+  bool flush_now = false;
+  bool schedule_flush = false;
+  {
+    absl::MutexLock lock(&mutex_);
+    buffer_.push_back(std::move(span));
+    if (buffer_.size() >= options_.max_batch_size) {
+      flush_now = true;
+    } else if (!flush_scheduled_ &&
+               options_.flush_interval != absl::InfiniteDuration()) {
+      flush_scheduled_ = schedule_flush = true;
+    }
+  }
+  if (flush_now) {
+    Flush();
+  } else if (schedule_flush) {
+    ScheduleFlush(weak_from_this(), options_.flush_interval);
+  }
+}
+
+Future<const void> OtlpTraceExporter::Flush() {
+  std::vector<SpanData> spans;
+  {
+    absl::MutexLock lock(&mutex_);
+    spans.swap(buffer_);
+    flush_scheduled_ = false;
+  }
+  if (spans.empty()) return MakeReadyFuture();
+  // Send the request outside of any trace, such that the export itself is not
+  // traced.
+  ScopedTraceContext no_trace(TraceContext(SpanContextPtr()));
+  auto request = internal_http::HttpRequestBuilder("POST", options_.endpoint)
+                     .AddHeader("content-type", "application/json")
+                     .BuildRequest();
+  auto body = EncodeOtlpTraces(spans, options_.service_name).dump();
+  auto transport = options_.transport;
+  if (!transport) transport = internal_http::GetDefaultHttpTransport();
+  return MapFuture(
+      InlineExecutor{},
+      [num_spans = spans.size()](
+          const Result<internal_http::HttpResponse>& response)
+          -> Result<void> {
+        absl::Status status =
+            response.ok() ? internal_http::HttpResponseCodeToStatus(*response)
+                          : response.status();
+        if (!status.ok()) {
+          ABSL_LOG_FIRST_N(WARNING, 10)
+              << "Failed to export " << num_spans << " trace spans: " << status;
+        }
+        return MakeResult(std::move(status));
+      },
+      transport->IssueRequest(
+          request, internal_http::IssueRequestOptions(absl::Cord(body))));
+}
+
+TENSORSTORE_GLOBAL_INITIALIZER {
+  auto endpoint = internal::GetEnv("TENSORSTORE_OTLP_TRACES_ENDPOINT");
+  if (!endpoint || endpoint->empty()) return;
+  OtlpExporterOptions options;
+  options.endpoint = *std::move(endpoint);
+  if (auto service_name = internal::GetEnv("TENSORSTORE_OTLP_SERVICE_NAME")) {
+    options.service_name = *std::move(service_name);
+  }
+  SetTraceExporter(std::make_shared<OtlpTraceExporter>(std::move(options)));
+}
+
+}  // namespace internal_tracing
+}  // namespace tensorstore
@@ -0,0 +1,92 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_TRACING_OTLP_EXPORTER_H_
+#define TENSORSTORE_INTERNAL_TRACING_OTLP_EXPORTER_H_
+
+/// \file
+/// Exports trace spans to an OpenTelemetry collector using the OTLP/HTTP
+/// protocol with JSON encoding.
+///
+/// If the `TENSORSTORE_OTLP_TRACES_ENDPOINT` environment variable is set, e.g.
+/// to `http://localhost:4318/v1/traces`, an exporter to that endpoint is
+/// installed at startup.  The service name reported with each span defaults to
+/// `tensorstore` and may be overridden by `TENSORSTORE_OTLP_SERVICE_NAME`.
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include <nlohmann/json_fwd.hpp>
+#include "tensorstore/internal/http/http_transport.h"
+#include "tensorstore/internal/tracing/trace_exporter.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal_tracing {
+
+struct OtlpExporterOptions {
+  /// URL to which spans are posted, e.g. `http://localhost:4318/v1/traces`.
+  std::string endpoint;
+
+  /// Value of the `service.name` resource attribute.
+  std::string service_name = "tensorstore";
+
+  /// Spans are sent once this many are buffered.
+  size_t max_batch_size = 512;
+
+  /// Buffered spans are sent at least this often.
+  absl::Duration flush_interval = absl::Seconds(5);
+
+  /// Transport used to send spans.  If `nullptr`, the default HTTP transport
+  /// is used.
+  std::shared_ptr<internal_http::HttpTransport> transport;
+};
+
+/// Exports spans in batches to an OTLP/HTTP endpoint.
+class OtlpTraceExporter
+    : public TraceExporter,
+      public std::enable_shared_from_this<OtlpTraceExporter> {
+ public:
+  explicit OtlpTraceExporter(OtlpExporterOptions options);
+
+  void Export(SpanData span) override;
+
+  /// Sends all buffered spans.  The returned future becomes ready once the
+  /// request completes.
+  Future<const void> Flush();
+
+ private:
+  OtlpExporterOptions options_;
+  absl::Mutex mutex_;
+  std::vector<SpanData> buffer_ ABSL_GUARDED_BY(mutex_);
+  // Indicates that a flush of `buffer_` is scheduled.
+  bool flush_scheduled_ ABSL_GUARDED_BY(mutex_) = false;
+};
+
+/// Returns the OTLP/JSON `ExportTraceServiceRequest` for `spans`.
+::nlohmann::json EncodeOtlpTraces(tensorstore::span<const SpanData> spans,
+                                  std::string_view service_name);
+
+}  // namespace internal_tracing
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_TRACING_OTLP_EXPORTER_H_
@@ -0,0 +1,173 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/tracing/otlp_exporter.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/cord.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/internal/http/http_request.h"
+#include "tensorstore/internal/http/http_response.h"
+#include "tensorstore/internal/http/http_transport.h"
+#include "tensorstore/internal/http/mock_http_transport.h"
+#include "tensorstore/internal/tracing/operation_trace_span.h"
+#include "tensorstore/internal/tracing/trace_context.h"
+#include "tensorstore/internal/tracing/trace_exporter.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::internal_http::HttpRequest;
+using ::tensorstore::internal_http::HttpRequestBuilder;
+using ::tensorstore::internal_http::HttpResponse;
+using ::tensorstore::internal_http::HttpResponseHandler;
+using ::tensorstore::internal_http::IssueRequestOptions;
+using ::tensorstore::internal_tracing::EncodeOtlpTraces;
+using ::tensorstore::internal_tracing::OperationTraceSpan;
+using ::tensorstore::internal_tracing::OtlpExporterOptions;
+using ::tensorstore::internal_tracing::OtlpTraceExporter;
+using ::tensorstore::internal_tracing::ScopedTraceContext;
+using ::tensorstore::internal_tracing::SetTraceExporter;
+using ::tensorstore::internal_tracing::SpanData;
+
+/// Records each request and its payload, and responds with `200 OK`.
+class CapturingTransport : public tensorstore::internal_http::HttpTransport {
+ public:
+  struct CapturedRequest {
+    HttpRequest request;
+    std::string payload;
+  };
+
+  void IssueRequestWithHandler(const HttpRequest& request,
+                               IssueRequestOptions options,
+                               HttpResponseHandler* handler) override {
+    {
+      absl::MutexLock lock(&mutex_);
+      requests_.push_back({request, std::string(options.payload)});
+    }
+    tensorstore::internal_http::ApplyResponseToHandler(
+        HttpResponse{200, absl::Cord()}, handler);
+  }
+
+  std::vector<CapturedRequest> requests() {
+    absl::MutexLock lock(&mutex_);
+    return requests_;
+  }
+
+ private:
+  absl::Mutex mutex_;
+  std::vector<CapturedRequest> requests_;
+};
+
+TEST(EncodeOtlpTracesTest, Basic) {
+  SpanData span;
+  span.trace_id_high = 1;
+  span.trace_id_low = 2;
+  span.span_id = 3;
+  span.parent_span_id = 4;
+  span.name = "Span";
+  span.start_time = absl::FromUnixNanos(1000);
+  span.end_time = absl::FromUnixNanos(2000);
+  span.attributes.emplace_back("int", int64_t{5});
+  span.attributes.emplace_back("string", std::string("x"));
+  span.status = absl::NotFoundError("missing");
+  EXPECT_EQ(
+      ::nlohmann::json({{"resourceSpans",
+                         {{{"resource",
+                            {{"attributes",
+                              {{{"key", "service.name"},
+                                {"value", {{"stringValue", "service"}}}}}}}},
+                           {"scopeSpans",
+                            {{{"scope", {{"name", "tensorstore"}}},
+                              {"spans",
+                               {{
+                                   {"traceId",
+                                    "00000000000000010000000000000002"},
+                                   {"spanId", "0000000000000003"},
+                                   {"parentSpanId", "0000000000000004"},
+                                   {"name", "Span"},
+                                   {"kind", 1},
+                                   {"startTimeUnixNano", "1000"},
+                                   {"endTimeUnixNano", "2000"},
+                                   {"attributes",
+                                    {{{"key", "int"},
+                                      {"value", {{"intValue", "5"}}}},
+                                     {{"key", "string"},
+                                      {"value", {{"stringValue", "x"}}}}}},
+                                   {"status",
+                                    {{"code", 2},
+                                     {"message", "NOT_FOUND: missing"}}},
+                               }}}}}}}}}}),
+      EncodeOtlpTraces({&span, 1}, "service"));
+}
+
+TEST(OtlpTraceExporterTest, ExportsHttpRequestSpans) {
+  auto transport = std::make_shared<CapturingTransport>();
+  OtlpExporterOptions options;
+  options.endpoint = "http://collector/v1/traces";
+  options.transport = transport;
+  options.flush_interval = absl::InfiniteDuration();
+  auto exporter = std::make_shared<OtlpTraceExporter>(options);
+  SetTraceExporter(exporter);
+  {
+    OperationTraceSpan operation("Operation");
+    ScopedTraceContext scope(operation.context());
+    TENSORSTORE_ASSERT_OK(transport->IssueRequest(
+        HttpRequestBuilder("GET", "http://server/key").BuildRequest(), {}));
+  }
+  SetTraceExporter(nullptr);
+  TENSORSTORE_ASSERT_OK(exporter->Flush());
+
+  auto requests = transport->requests();
+  ASSERT_EQ(2, requests.size());
+  // The trace is propagated to the server.
+  EXPECT_NE(requests[0].request.headers.find("traceparent"),
+            requests[0].request.headers.end());
+  // The export request itself is not traced.
+  EXPECT_EQ("http://collector/v1/traces", requests[1].request.url);
+  EXPECT_EQ(requests[1].request.headers.find("traceparent"),
+            requests[1].request.headers.end());
+  auto body = ::nlohmann::json::parse(requests[1].payload);
+  auto& spans = body["resourceSpans"][0]["scopeSpans"][0]["spans"];
+  ASSERT_EQ(2, spans.size());
+  EXPECT_EQ("HttpRequest", spans[0]["name"]);
+  EXPECT_EQ("Operation", spans[1]["name"]);
+  EXPECT_EQ(spans[1]["spanId"], spans[0]["parentSpanId"]);
+}
+
+TEST(OtlpTraceExporterTest, FlushesFullBatch) {
+  auto transport = std::make_shared<CapturingTransport>();
+  OtlpExporterOptions options;
+  options.endpoint = "http://collector/v1/traces";
+  options.transport = transport;
+  options.max_batch_size = 2;
+  options.flush_interval = absl::InfiniteDuration();
+  auto exporter = std::make_shared<OtlpTraceExporter>(options);
+  exporter->Export(SpanData{});
+  EXPECT_TRUE(transport->requests().empty());
+  exporter->Export(SpanData{});
+  EXPECT_EQ(1, transport->requests().size());
+}
+
+}  // namespace
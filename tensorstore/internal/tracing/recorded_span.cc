@@ -0,0 +1,113 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/tracing/recorded_span.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "absl/random/random.h"
+#include "absl/time/clock.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/source_location.h"
+#include "tensorstore/internal/tracing/span_attribute.h"
+#include "tensorstore/internal/tracing/trace_context.h"
+#include "tensorstore/internal/tracing/trace_exporter.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal_tracing {
+namespace {
+
+/// Returns a random non-zero identifier.
+uint64_t NewId() {
+  thread_local absl::InsecureBitGen gen;
+  uint64_t id;
+  do {
+    id = absl::Uniform<uint64_t>(gen);
+  } while (id == 0);
+  return id;
+}
+
+SpanAttributeValue ToAttributeValue(const SpanAttribute& attribute) {
+  return std::visit(
+      [](auto value) -> SpanAttributeValue {
+        using T = decltype(value);
+        if constexpr (std::is_same_v<T, std::string_view>) {
+          return std::string(value);
+        } else if constexpr (std::is_same_v<T, void*>) {
+          return reinterpret_cast<uint64_t>(value);
+        } else {
+          return value;
+        }
+      },
+      attribute.value);
+}
+
+}  // namespace
+
+std::unique_ptr<RecordedSpan> RecordedSpan::Start(
+    std::string_view name, tensorstore::span<const SpanAttribute> attributes,
+    const SourceLocation& location, bool start_trace) {
+  const SpanContext* parent = GetCurrentSpanContext();
+  if (!parent && !start_trace) return nullptr;
+  auto context = internal::MakeIntrusivePtr<SpanContext>();
+  if (parent) {
+    context->trace_id_high = parent->trace_id_high;
+    context->trace_id_low = parent->trace_id_low;
+  } else {
+    context->trace_id_high = NewId();
+    context->trace_id_low = NewId();
+  }
+  context->span_id = NewId();
+  std::unique_ptr<RecordedSpan> span(new RecordedSpan);
+  auto& data = span->data_;
+  data.trace_id_high = context->trace_id_high;
+  data.trace_id_low = context->trace_id_low;
+  data.span_id = context->span_id;
+  data.parent_span_id = parent ? parent->span_id : 0;
+  data.name = std::string(name);
+  data.attributes.reserve(attributes.size() + 2);
+  for (const auto& attribute : attributes) {
+    span->AddAttribute(attribute);
+  }
+  data.attributes.emplace_back("code.filepath",
+                               std::string(location.file_name()));
+  data.attributes.emplace_back("code.lineno",
+                               static_cast<int64_t>(location.line()));
+  span->context_ = std::move(context);
+  data.start_time = absl::Now();
+  return span;
+}
+
+void RecordedSpan::End(std::unique_ptr<RecordedSpan> span) {
+  span->data_.end_time = absl::Now();
+  if (auto exporter = GetTraceExporter()) {
+    exporter->Export(std::move(span->data_));
+  }
+}
+
+void RecordedSpan::AddAttribute(const SpanAttribute& attribute) {
+  data_.attributes.emplace_back(std::string(attribute.name),
+                                ToAttributeValue(attribute));
+}
+
+}  // namespace internal_tracing
+}  // namespace tensorstore
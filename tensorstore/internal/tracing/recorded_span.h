@@ -0,0 +1,64 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_TRACING_RECORDED_SPAN_H_
+#define TENSORSTORE_INTERNAL_TRACING_RECORDED_SPAN_H_
+
+#include <memory>
+#include <string_view>
+
+#include "absl/status/status.h"
+#include "tensorstore/internal/source_location.h"
+#include "tensorstore/internal/tracing/span_attribute.h"
+#include "tensorstore/internal/tracing/trace_context.h"
+#include "tensorstore/internal/tracing/trace_exporter.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal_tracing {
+
+/// A span that is being recorded.  Implementation detail of
+/// `LocalTraceSpan` and `OperationTraceSpan`.
+class RecordedSpan {
+ public:
+  /// Starts recording a span as a child of the span of the current thread.
+  ///
+  /// If there is no current span, starts a new trace if `start_trace` is
+  /// `true`, and otherwise returns `nullptr`.
+  ///
+  /// Must only be called if `IsTracingEnabled()`.
+  static std::unique_ptr<RecordedSpan> Start(
+      std::string_view name, tensorstore::span<const SpanAttribute> attributes,
+      const SourceLocation& location, bool start_trace);
+
+  /// Ends `span` and passes it to the exporter, if one is still set.
+  static void End(std::unique_ptr<RecordedSpan> span);
+
+  /// Returns the context for work performed on behalf of this span.
+  const SpanContextPtr& context() const { return context_; }
+
+  void AddAttribute(const SpanAttribute& attribute);
+  void SetStatus(const absl::Status& status) { data_.status = status; }
+
+ private:
+  RecordedSpan() = default;
+
+  SpanContextPtr context_;
+  SpanData data_;
+};
+
+}  // namespace internal_tracing
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_TRACING_RECORDED_SPAN_H_
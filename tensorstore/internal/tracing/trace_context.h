@@ -15,25 +15,113 @@
 #ifndef TENSORSTORE_INTERNAL_TRACING_TRACE_CONTEXT_H_
 #define TENSORSTORE_INTERNAL_TRACING_TRACE_CONTEXT_H_
 
+#include <stdint.h>
+
 #include <utility>
 
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/tracing/operation_stats.h"
+
 namespace tensorstore {
 namespace internal_tracing {
 
+/// Identifies a recorded span within a trace.
+///
+/// A `SpanContext` is immutable once created, and is shared by all work
+/// performed on behalf of the span, such that spans started by that work are
+/// recorded as its children.
+struct SpanContext : public internal::AtomicReferenceCount<SpanContext> {
+  /// 128-bit identifier of the trace.
+  uint64_t trace_id_high = 0;
+  uint64_t trace_id_low = 0;
+
+  /// 64-bit identifier of the span, unique within the trace.
+  uint64_t span_id = 0;
+};
+
+using SpanContextPtr = internal::IntrusivePtr<const SpanContext>;
+
+namespace internal_trace_context {
+// Span context of the current thread.  Owns a reference, if non-null.
+inline thread_local const SpanContext* current_span_context = nullptr;
+}  // namespace internal_trace_context
+
+/// Tracing context propagated to asynchronous work, such as `Future`
+/// callbacks and executor tasks.
+///
+/// Holds the span context and the operation stats (see `OperationStatsState`)
+/// of the thread on which the work was created.  Both are null, and add no
+/// overhead beyond pointer copies, unless a trace is active or operation stats
+/// were requested.
 struct TraceContext {
   struct ThreadInitType {};
   inline static constexpr ThreadInitType kThread{};
 
   TraceContext() = delete;
-  explicit TraceContext(ThreadInitType) {}
+
+  /// Captures the trace context of the current thread.
+  explicit TraceContext(ThreadInitType)
+      : span_context(internal_trace_context::current_span_context),
+        operation_stats(internal_trace_context::current_operation_stats) {}
+
+  /// Constructs a trace context for `span_context`, which may be null, with the
+  /// operation stats of the current thread.
+  explicit TraceContext(SpanContextPtr span_context)
+      : span_context(std::move(span_context)),
+        operation_stats(internal_trace_context::current_operation_stats) {}
 
   TraceContext(TraceContext&&) = default;
   TraceContext& operator=(TraceContext&&) = default;
   TraceContext(const TraceContext&) = default;
   TraceContext& operator=(const TraceContext&) = default;
+
+  SpanContextPtr span_context;
+  OperationStatsPtr operation_stats;
 };
 
-inline void SwapCurrentTraceContext(TraceContext* context) {}
+/// Exchanges the trace context of the current thread with `*context`.
+///
+/// Calling this function twice with the same `context` restores the original
+/// trace context of the thread.
+inline void SwapCurrentTraceContext(TraceContext* context) {
+  auto& current = internal_trace_context::current_span_context;
+  if (current || context->span_context) {
+    const SpanContext* previous = current;
+    current = context->span_context.release();
+    context->span_context =
+        SpanContextPtr(previous, internal::adopt_object_ref);
+  }
+  auto& current_stats = internal_trace_context::current_operation_stats;
+  if (current_stats || context->operation_stats) {
+    OperationStatsState* previous = current_stats;
+    current_stats = context->operation_stats.release();
+    context->operation_stats =
+        OperationStatsPtr(previous, internal::adopt_object_ref);
+  }
+}
+
+/// Returns the span context of the current thread, or `nullptr` if no trace is
+/// active.
+inline const SpanContext* GetCurrentSpanContext() {
+  return internal_trace_context::current_span_context;
+}
+
+/// Sets the trace context of the current thread for the lifetime of this
+/// object.
+class ScopedTraceContext {
+ public:
+  explicit ScopedTraceContext(TraceContext context)
+      : context_(std::move(context)) {
+    SwapCurrentTraceContext(&context_);
+  }
+  ~ScopedTraceContext() { SwapCurrentTraceContext(&context_); }
+
+  ScopedTraceContext(const ScopedTraceContext&) = delete;
+  ScopedTraceContext& operator=(const ScopedTraceContext&) = delete;
+
+ private:
+  TraceContext context_;
+};
 
 }  // namespace internal_tracing
 }  // namespace tensorstore
@@ -0,0 +1,58 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/internal/tracing/trace_exporter.h"
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "absl/base/no_destructor.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+
+namespace tensorstore {
+namespace internal_tracing {
+namespace {
+
+struct ExporterState {
+  absl::Mutex mutex;
+  std::shared_ptr<TraceExporter> exporter ABSL_GUARDED_BY(mutex);
+};
+
+ExporterState& GetExporterState() {
+  static absl::NoDestructor<ExporterState> state;
+  return *state;
+}
+
+}  // namespace
+
+TraceExporter::~TraceExporter() = default;
+
+void SetTraceExporter(std::shared_ptr<TraceExporter> exporter) {
+  auto& state = GetExporterState();
+  absl::MutexLock lock(&state.mutex);
+  internal_trace_exporter::tracing_enabled.store(exporter != nullptr,
+                                                 std::memory_order_relaxed);
+  state.exporter = std::move(exporter);
+}
+
+std::shared_ptr<TraceExporter> GetTraceExporter() {
+  auto& state = GetExporterState();
+  absl::ReaderMutexLock lock(&state.mutex);
+  return state.exporter;
+}
+
+}  // namespace internal_tracing
+}  // namespace tensorstore
@@ -0,0 +1,89 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_INTERNAL_TRACING_TRACE_EXPORTER_H_
+#define TENSORSTORE_INTERNAL_TRACING_TRACE_EXPORTER_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/time/time.h"
+
+namespace tensorstore {
+namespace internal_tracing {
+
+using SpanAttributeValue =
+    std::variant<bool, int64_t, uint64_t, double, std::string>;
+
+/// A completed span, as passed to a `TraceExporter`.
+struct SpanData {
+  /// 128-bit identifier of the trace.
+  uint64_t trace_id_high = 0;
+  uint64_t trace_id_low = 0;
+
+  /// Identifier of the span.
+  uint64_t span_id = 0;
+
+  /// Identifier of the parent span, or `0` for the root span of a trace.
+  uint64_t parent_span_id = 0;
+
+  std::string name;
+  absl::Time start_time;
+  absl::Time end_time;
+  std::vector<std::pair<std::string, SpanAttributeValue>> attributes;
+  absl::Status status;
+};
+
+/// Receives completed spans.
+class TraceExporter {
+ public:
+  virtual ~TraceExporter();
+
+  /// Called once for each completed span, on the thread that ended the span.
+  ///
+  /// Must not block; exporters that perform I/O should buffer spans and send
+  /// them asynchronously.
+  virtual void Export(SpanData span) = 0;
+};
+
+/// Sets the process-wide exporter of completed spans.
+///
+/// Spans are recorded only while an exporter is set; specifying `nullptr`
+/// disables tracing.
+void SetTraceExporter(std::shared_ptr<TraceExporter> exporter);
+
+/// Returns the exporter set by `SetTraceExporter`, or `nullptr`.
+std::shared_ptr<TraceExporter> GetTraceExporter();
+
+namespace internal_trace_exporter {
+inline std::atomic<bool> tracing_enabled{false};
+}  // namespace internal_trace_exporter
+
+/// Returns `true` if spans are recorded, i.e. an exporter is set.
+inline bool IsTracingEnabled() {
+  return internal_trace_exporter::tracing_enabled.load(
+      std::memory_order_relaxed);
+}
+
+}  // namespace internal_tracing
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_INTERNAL_TRACING_TRACE_EXPORTER_H_
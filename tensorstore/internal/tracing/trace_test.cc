@@ -14,27 +14,68 @@
 
 #include <stdint.h>
 
+#include <memory>
+#include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/base/log_severity.h"
 #include "absl/log/scoped_mock_log.h"
 #include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/synchronization/notification.h"
+#include "tensorstore/internal/thread/thread_pool.h"
 #include "tensorstore/internal/tracing/local_trace_span.h"
 #include "tensorstore/internal/tracing/logged_trace_span.h"
 #include "tensorstore/internal/tracing/operation_trace_span.h"
 #include "tensorstore/internal/tracing/span_attribute.h"
 #include "tensorstore/internal/tracing/trace_context.h"
+#include "tensorstore/internal/tracing/trace_exporter.h"
+#include "tensorstore/util/future.h"
 
 namespace {
 
+using ::tensorstore::internal_tracing::GetCurrentSpanContext;
 using ::tensorstore::internal_tracing::LocalTraceSpan;
 using ::tensorstore::internal_tracing::LoggedTraceSpan;
+using ::tensorstore::internal_tracing::OperationTraceSpan;
+using ::tensorstore::internal_tracing::ScopedTraceContext;
+using ::tensorstore::internal_tracing::SetTraceExporter;
 using ::tensorstore::internal_tracing::SpanAttribute;
+using ::tensorstore::internal_tracing::SpanAttributeValue;
+using ::tensorstore::internal_tracing::SpanData;
+using ::tensorstore::internal_tracing::TraceExporter;
 using ::testing::_;
+using ::testing::Contains;
+using ::testing::ElementsAre;
 using ::testing::HasSubstr;
+using ::testing::Pair;
+
+class CollectingExporter : public TraceExporter {
+ public:
+  void Export(SpanData span) override {
+    absl::MutexLock lock(&mutex_);
+    spans_.push_back(std::move(span));
+  }
+
+  std::vector<SpanData> spans() {
+    absl::MutexLock lock(&mutex_);
+    return spans_;
+  }
+
+ private:
+  absl::Mutex mutex_;
+  std::vector<SpanData> spans_;
+};
+
+std::vector<std::string> SpanNames(const std::vector<SpanData>& spans) {
+  std::vector<std::string> names;
+  for (const auto& span : spans) names.push_back(span.name);
+  return names;
+}
 
 TEST(TraceTest, SwapContext) {
   tensorstore::internal_tracing::TraceContext tc(
@@ -95,4 +136,80 @@ TEST(TraceTest, OperationTraceSpan) {
   EXPECT_NE(&span, nullptr);
 }
 
+TEST(TraceTest, RecordedSpans) {
+  auto exporter = std::make_shared<CollectingExporter>();
+  SetTraceExporter(exporter);
+  {
+    // Not recorded, since there is no current trace.
+    LocalTraceSpan span("Orphan");
+  }
+  {
+    OperationTraceSpan operation("Operation", {{"key", "a"}});
+    ScopedTraceContext scope(operation.context());
+    LocalTraceSpan span("Child");
+  }
+  SetTraceExporter(nullptr);
+  {
+    OperationTraceSpan operation("Disabled");
+    EXPECT_FALSE(operation.recording());
+  }
+  EXPECT_EQ(nullptr, GetCurrentSpanContext());
+
+  auto spans = exporter->spans();
+  ASSERT_THAT(SpanNames(spans), ElementsAre("Child", "Operation"));
+  const auto& child = spans[0];
+  const auto& operation = spans[1];
+  EXPECT_EQ(0, operation.parent_span_id);
+  EXPECT_EQ(operation.span_id, child.parent_span_id);
+  EXPECT_EQ(operation.trace_id_high, child.trace_id_high);
+  EXPECT_EQ(operation.trace_id_low, child.trace_id_low);
+  EXPECT_NE(operation.span_id, child.span_id);
+  EXPECT_LE(operation.start_time, child.start_time);
+  EXPECT_LE(child.end_time, operation.end_time);
+  EXPECT_THAT(operation.attributes,
+              Contains(Pair("key", SpanAttributeValue(std::string("a")))));
+}
+
+TEST(TraceTest, PropagatesToFutureCallbacks) {
+  auto exporter = std::make_shared<CollectingExporter>();
+  SetTraceExporter(exporter);
+  auto [promise, future] = tensorstore::PromiseFuturePair<int>::Make();
+  {
+    OperationTraceSpan operation("Operation");
+    ScopedTraceContext scope(operation.context());
+    future.ExecuteWhenReady([](tensorstore::ReadyFuture<int> future) {
+      LocalTraceSpan span("Callback");
+    });
+  }
+  promise.SetResult(1);
+  SetTraceExporter(nullptr);
+
+  auto spans = exporter->spans();
+  ASSERT_THAT(SpanNames(spans), ElementsAre("Operation", "Callback"));
+  EXPECT_EQ(spans[0].span_id, spans[1].parent_span_id);
+}
+
+TEST(TraceTest, PropagatesToExecutorTasks) {
+  auto exporter = std::make_shared<CollectingExporter>();
+  SetTraceExporter(exporter);
+  absl::Notification done;
+  {
+    OperationTraceSpan operation("Operation");
+    ScopedTraceContext scope(operation.context());
+    tensorstore::internal::DetachedThreadPool(1)([&] {
+      { LocalTraceSpan span("Task"); }
+      done.Notify();
+    });
+  }
+  done.WaitForNotification();
+  SetTraceExporter(nullptr);
+
+  auto spans = exporter->spans();
+  ASSERT_THAT(SpanNames(spans),
+              ::testing::UnorderedElementsAre("Operation", "Task"));
+  const auto& operation = spans[0].name == "Operation" ? spans[0] : spans[1];
+  const auto& task = spans[0].name == "Task" ? spans[0] : spans[1];
+  EXPECT_EQ(operation.span_id, task.parent_span_id);
+}
+
 }  // namespace
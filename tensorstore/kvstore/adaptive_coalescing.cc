@@ -0,0 +1,170 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/adaptive_coalescing.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "absl/flags/flag.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/env.h"
+#include "tensorstore/internal/metrics/gauge.h"
+#include "tensorstore/internal/metrics/metadata.h"
+#include "tensorstore/kvstore/batch_util.h"
+
+ABSL_FLAG(std::optional<bool>, tensorstore_adaptive_coalescing, std::nullopt,
+          "Tune the coalescing of batched reads from the observed latency and "
+          "bandwidth of each kvstore. "
+          "Overrides TENSORSTORE_ADAPTIVE_COALESCING.");
+
+using ::tensorstore::internal_metrics::MetricMetadata;
+using ::tensorstore::internal_metrics::Units;
+
+namespace tensorstore {
+namespace internal_kvstore_batch {
+namespace {
+
+// Weight of each earlier read relative to the next, for an effective window of
+// about 64 reads.
+constexpr double kDecay = 1.0 - 1.0 / 64;
+
+// Number of reads required before the options are tuned.
+constexpr int64_t kMinReads = 16;
+
+// Minimum coefficient of variation of the read sizes for which latency and
+// bandwidth are estimated.
+constexpr double kMinSizeVariation = 0.1;
+
+// Ratio of `target_coalesced_size` to `latency * bandwidth`.
+constexpr double kLatencyMultiple = 8;
+
+// Bounds of the tuned options.
+constexpr int64_t kMaxExtraReadBytes = int64_t{16} << 20;
+constexpr int64_t kMinTargetCoalescedSize = int64_t{1} << 20;
+constexpr int64_t kMaxTargetCoalescedSize = int64_t{1} << 30;
+
+auto& max_extra_read_bytes = internal_metrics::Gauge<int64_t, std::string>::New(
+    "/tensorstore/kvstore/coalescing/max_extra_read_bytes", "driver",
+    MetricMetadata("Maximum gap between coalesced byte ranges, by driver.",
+                   Units::kBytes));
+
+auto& target_coalesced_size =
+    internal_metrics::Gauge<int64_t, std::string>::New(
+        "/tensorstore/kvstore/coalescing/target_coalesced_size", "driver",
+        MetricMetadata("Target size of coalesced reads, by driver.",
+                       Units::kBytes));
+
+auto& latency_us = internal_metrics::Gauge<int64_t, std::string>::New(
+    "/tensorstore/kvstore/coalescing/latency_us", "driver",
+    MetricMetadata("Estimated fixed latency of reads (us), by driver.",
+                   Units::kMicroseconds));
+
+auto& bytes_per_second = internal_metrics::Gauge<int64_t, std::string>::New(
+    "/tensorstore/kvstore/coalescing/bytes_per_second", "driver",
+    MetricMetadata("Estimated bandwidth of reads (bytes/s), by driver."));
+
+bool IsAdaptiveCoalescingEnabled() {
+  static const bool enabled =
+      internal::GetFlagOrEnvValue(FLAGS_tensorstore_adaptive_coalescing,
+                                  "TENSORSTORE_ADAPTIVE_COALESCING")
+          .value_or(false);
+  return enabled;
+}
+
+}  // namespace
+
+AdaptiveCoalescingOptions::AdaptiveCoalescingOptions(CoalescingOptions initial,
+                                                     std::string_view driver)
+    : AdaptiveCoalescingOptions(initial, driver,
+                                IsAdaptiveCoalescingEnabled()) {}
+
+AdaptiveCoalescingOptions::AdaptiveCoalescingOptions(CoalescingOptions initial,
+                                                     std::string_view driver,
+                                                     bool enabled)
+    : enabled_(enabled),
+      max_extra_read_bytes_metric_(max_extra_read_bytes.GetCell(driver)),
+      target_coalesced_size_metric_(target_coalesced_size.GetCell(driver)),
+      latency_us_metric_(latency_us.GetCell(driver)),
+      bytes_per_second_metric_(bytes_per_second.GetCell(driver)),
+      options_(initial) {
+  max_extra_read_bytes_metric_.Set(initial.max_extra_read_bytes);
+  target_coalesced_size_metric_.Set(initial.target_coalesced_size);
+}
+
+CoalescingOptions AdaptiveCoalescingOptions::Get() const {
+  absl::MutexLock lock(&mutex_);
+  return options_;
+}
+
+std::optional<AdaptiveCoalescingOptions::Estimate>
+AdaptiveCoalescingOptions::GetEstimate() const {
+  absl::MutexLock lock(&mutex_);
+  return estimate_;
+}
+
+void AdaptiveCoalescingOptions::Record(int64_t bytes, absl::Duration elapsed) {
+  if (!enabled_ || bytes < 0 || elapsed < absl::ZeroDuration()) return;
+  const double x = static_cast<double>(bytes);
+  const double y = absl::ToDoubleSeconds(elapsed);
+  absl::MutexLock lock(&mutex_);
+  // Weighted incremental update of the means and co-moments.
+  weight_ = weight_ * kDecay + 1;
+  const double dx = x - mean_x_;
+  mean_x_ += dx / weight_;
+  mean_y_ += (y - mean_y_) / weight_;
+  c_xx_ = c_xx_ * kDecay + dx * (x - mean_x_);
+  c_xy_ = c_xy_ * kDecay + dx * (y - mean_y_);
+  if (++num_reads_ < kMinReads) return;
+  UpdateLocked();
+}
+
+void AdaptiveCoalescingOptions::UpdateLocked() {
+  // The latency and bandwidth cannot be told apart if the reads are of
+  // similar sizes.
+  if (c_xx_ / weight_ <
+      kMinSizeVariation * kMinSizeVariation * mean_x_ * mean_x_) {
+    return;
+  }
+  const double seconds_per_byte = c_xy_ / c_xx_;
+  if (!(seconds_per_byte > 0)) return;
+  const double latency =
+      std::max(0.0, mean_y_ - seconds_per_byte * mean_x_);
+  const double bandwidth = 1 / seconds_per_byte;
+  estimate_ = Estimate{absl::Seconds(latency), bandwidth};
+
+  const double bytes_per_latency = latency * bandwidth;
+  options_.max_extra_read_bytes = static_cast<int64_t>(
+      std::min(bytes_per_latency, static_cast<double>(kMaxExtraReadBytes)));
+  options_.target_coalesced_size = std::max(
+      options_.max_extra_read_bytes + 1,
+      static_cast<int64_t>(
+          std::clamp(kLatencyMultiple * bytes_per_latency,
+                     static_cast<double>(kMinTargetCoalescedSize),
+                     static_cast<double>(kMaxTargetCoalescedSize))));
+
+  max_extra_read_bytes_metric_.Set(options_.max_extra_read_bytes);
+  target_coalesced_size_metric_.Set(options_.target_coalesced_size);
+  latency_us_metric_.Set(absl::ToInt64Microseconds(estimate_->latency));
+  bytes_per_second_metric_.Set(
+      static_cast<int64_t>(std::min(bandwidth, 9.0e18)));
+}
+
+}  // namespace internal_kvstore_batch
+}  // namespace tensorstore
@@ -0,0 +1,115 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_ADAPTIVE_COALESCING_H_
+#define TENSORSTORE_KVSTORE_ADAPTIVE_COALESCING_H_
+
+#include <stdint.h>
+
+#include <optional>
+#include <string_view>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/metrics/gauge.h"
+#include "tensorstore/kvstore/batch_util.h"
+
+namespace tensorstore {
+namespace internal_kvstore_batch {
+
+/// Tunes the `CoalescingOptions` of a kvstore from the observed latency and
+/// bandwidth of its reads.
+///
+/// The time to read `n` bytes is modelled as `latency + n / bandwidth`, where
+/// both parameters are estimated by a least-squares fit over recent reads,
+/// with exponentially decaying weights.  From the estimate:
+///
+/// - `max_extra_read_bytes` is set to `latency * bandwidth`, the number of
+///   bytes that can be transferred during the fixed overhead of a request.
+///   Reading a larger gap between two byte ranges takes longer than issuing a
+///   separate request for each.
+///
+/// - `target_coalesced_size` is set to a multiple of `latency * bandwidth`,
+///   such that the fixed overhead is a small fraction of the time of each
+///   merged request.  Merging further only reduces the parallelism available
+///   from concurrent requests.
+///
+/// The initial options are used until enough reads of sufficiently varied
+/// sizes have been observed, and always unless adaptive coalescing is enabled
+/// by the `--tensorstore_adaptive_coalescing` flag or the
+/// `TENSORSTORE_ADAPTIVE_COALESCING` environment variable.
+///
+/// The chosen options and the estimate are reported by the metrics
+///   /tensorstore/kvstore/coalescing/max_extra_read_bytes
+///   /tensorstore/kvstore/coalescing/target_coalesced_size
+///   /tensorstore/kvstore/coalescing/latency_us
+///   /tensorstore/kvstore/coalescing/bytes_per_second
+/// labeled by `driver`.
+class AdaptiveCoalescingOptions {
+ public:
+  /// Estimated parameters of the read time model.
+  struct Estimate {
+    absl::Duration latency;
+    double bytes_per_second;
+  };
+
+  /// Constructs from the `initial` options.  `driver` labels the metrics.
+  AdaptiveCoalescingOptions(CoalescingOptions initial,
+                            std::string_view driver);
+
+  // Test constructor.
+  AdaptiveCoalescingOptions(CoalescingOptions initial, std::string_view driver,
+                            bool enabled);
+
+  AdaptiveCoalescingOptions(const AdaptiveCoalescingOptions&) = delete;
+  AdaptiveCoalescingOptions& operator=(const AdaptiveCoalescingOptions&) =
+      delete;
+
+  /// Returns the options to use for coalescing the next batch of reads.
+  CoalescingOptions Get() const;
+
+  /// Records that a (coalesced) read of `bytes` completed in `elapsed`.
+  void Record(int64_t bytes, absl::Duration elapsed);
+
+  /// Returns the current estimate, if any.
+  std::optional<Estimate> GetEstimate() const;
+
+ private:
+  void UpdateLocked() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const bool enabled_;
+  internal_metrics::GaugeCell<int64_t>& max_extra_read_bytes_metric_;
+  internal_metrics::GaugeCell<int64_t>& target_coalesced_size_metric_;
+  internal_metrics::GaugeCell<int64_t>& latency_us_metric_;
+  internal_metrics::GaugeCell<int64_t>& bytes_per_second_metric_;
+
+  mutable absl::Mutex mutex_;
+  CoalescingOptions options_ ABSL_GUARDED_BY(mutex_);
+  std::optional<Estimate> estimate_ ABSL_GUARDED_BY(mutex_);
+
+  // Exponentially weighted statistics of the size `x` and the time `y`, in
+  // seconds, of recent reads.
+  int64_t num_reads_ ABSL_GUARDED_BY(mutex_) = 0;
+  double weight_ ABSL_GUARDED_BY(mutex_) = 0;
+  double mean_x_ ABSL_GUARDED_BY(mutex_) = 0;
+  double mean_y_ ABSL_GUARDED_BY(mutex_) = 0;
+  double c_xx_ ABSL_GUARDED_BY(mutex_) = 0;
+  double c_xy_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace internal_kvstore_batch
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_ADAPTIVE_COALESCING_H_
@@ -0,0 +1,78 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/adaptive_coalescing.h"
+
+#include <stdint.h>
+
+#include <gtest/gtest.h>
+#include "absl/time/time.h"
+#include "tensorstore/kvstore/batch_util.h"
+
+namespace {
+
+using ::tensorstore::internal_kvstore_batch::AdaptiveCoalescingOptions;
+using ::tensorstore::internal_kvstore_batch::CoalescingOptions;
+
+constexpr CoalescingOptions kInitial = {
+    /*.max_extra_read_bytes=*/4095,
+    /*.target_coalesced_size=*/1 << 24,
+};
+
+// Records reads of varying sizes which take `latency + bytes / bandwidth`.
+void RecordReads(AdaptiveCoalescingOptions& options, absl::Duration latency,
+                 double bandwidth) {
+  for (int i = 0; i < 100; ++i) {
+    const int64_t bytes = int64_t{1024} << (i % 12);
+    options.Record(bytes, latency + absl::Seconds(bytes / bandwidth));
+  }
+}
+
+TEST(AdaptiveCoalescingOptionsTest, Disabled) {
+  AdaptiveCoalescingOptions options(kInitial, "test", /*enabled=*/false);
+  RecordReads(options, absl::Milliseconds(10), 1e8);
+  EXPECT_FALSE(options.GetEstimate());
+  EXPECT_EQ(options.Get().max_extra_read_bytes, 4095);
+  EXPECT_EQ(options.Get().target_coalesced_size, 1 << 24);
+}
+
+TEST(AdaptiveCoalescingOptionsTest, Remote) {
+  AdaptiveCoalescingOptions options(kInitial, "test", /*enabled=*/true);
+  RecordReads(options, absl::Milliseconds(10), 1e8);
+  auto estimate = options.GetEstimate();
+  ASSERT_TRUE(estimate);
+  EXPECT_NEAR(absl::ToDoubleSeconds(estimate->latency), 0.01, 1e-6);
+  EXPECT_NEAR(estimate->bytes_per_second, 1e8, 1e3);
+  EXPECT_NEAR(options.Get().max_extra_read_bytes, 1000000, 100);
+  EXPECT_NEAR(options.Get().target_coalesced_size, 8000000, 1000);
+}
+
+TEST(AdaptiveCoalescingOptionsTest, Local) {
+  AdaptiveCoalescingOptions options(kInitial, "test", /*enabled=*/true);
+  RecordReads(options, absl::Microseconds(20), 2e9);
+  EXPECT_NEAR(options.Get().max_extra_read_bytes, 40000, 10);
+  // Limited to a minimum of 1 MiB.
+  EXPECT_EQ(options.Get().target_coalesced_size, 1 << 20);
+}
+
+TEST(AdaptiveCoalescingOptionsTest, UniformSizes) {
+  AdaptiveCoalescingOptions options(kInitial, "test", /*enabled=*/true);
+  for (int i = 0; i < 100; ++i) {
+    options.Record(4096, absl::Milliseconds(10 + i % 3));
+  }
+  EXPECT_FALSE(options.GetEstimate());
+  EXPECT_EQ(options.Get().max_extra_read_bytes, 4095);
+}
+
+}  // namespace
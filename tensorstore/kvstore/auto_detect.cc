@@ -19,6 +19,7 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -107,14 +108,35 @@ struct AutoDetectOperationState {
   KvStore base;
   absl::Time time = absl::Now();
 
+  // Batch for the initial reads.  Released once they have been issued, since
+  // the batch is not submitted while a reference is held.
+  Batch batch{no_batch};
+
   absl::Status error;
 
+  // Reads for directory format detection.  For a file path, these are issued
+  // along with the reads for file format detection, so that detecting a
+  // directory format takes no additional round trip.
+  struct DirectoryProbe {
+    // Directory path, ending in "/".
+    std::string path;
+    // Filenames read.
+    absl::btree_set<std::string> filenames;
+    // Read futures, in the order of `filenames`.
+    std::vector<Future<kvstore::ReadResult>> read_futures;
+    // Becomes ready once all of `read_futures` are ready.
+    Future<void> all_future;
+  };
+  std::optional<DirectoryProbe> directory_probe;
+
   using Value = std::vector<AutoDetectMatch>;
 
-  static Future<Value> Start(Executor&& executor, KvStore&& base) {
+  static Future<Value> Start(Executor&& executor, KvStore&& base,
+                             Batch&& batch) {
     auto [promise, future] = PromiseFuturePair<Value>::Make();
     auto state = std::make_unique<AutoDetectOperationState>(std::move(base));
     state->executor = std::move(executor);
+    state->batch = std::move(batch);
     if (state->base.path.empty() || state->base.path.back() == '/') {
       MaybeDetectDirectoryFormat(std::move(state), std::move(promise));
     } else {
@@ -123,6 +145,44 @@ struct AutoDetectOperationState {
     return std::move(future);
   }
 
+  // Returns the batch to use for the next set of reads.
+  Batch GetBatch() {
+    Batch batch = std::exchange(this->batch, no_batch);
+    if (!batch) batch = Batch::New();
+    return batch;
+  }
+
+  // Issues the reads for directory format detection using `batch`.
+  void StartDirectoryProbe(const Batch& batch) {
+    auto& probe = directory_probe.emplace();
+    {
+      auto& registry = GetAutoDetectRegistry();
+      absl::ReaderMutexLock lock(&registry.mutex);
+      probe.filenames = registry.filenames;
+    }
+    if (probe.filenames.empty()) return;
+    KvStore directory = base;
+    internal::EnsureDirectoryPath(directory.path);
+    probe.path = directory.path;
+    probe.read_futures.reserve(probe.filenames.size());
+    auto [all_promise, all_future] =
+        PromiseFuturePair<void>::Make(absl::OkStatus());
+    for (const auto& filename : probe.filenames) {
+      kvstore::ReadOptions options;
+      options.staleness_bound = time;
+      options.byte_range = OptionalByteRangeRequest::Stat();
+      options.batch = batch;
+      probe.read_futures.push_back(
+          kvstore::Read(directory, filename, std::move(options)));
+      // Create a link to prevent `promise` from becoming ready
+      // until all read futures become ready.
+      Link([](Promise<void> promise,
+              ReadyFuture<kvstore::ReadResult> future) {},
+           all_promise, probe.read_futures.back());
+    }
+    probe.all_future = std::move(all_future);
+  }
+
   void SetError(const absl::Status& error, std::string_view path) {
     if (!this->error.ok() || error.ok()) return;
     this->error = base.driver->AnnotateError(
@@ -142,7 +202,7 @@ struct AutoDetectOperationState {
     Future<kvstore::ReadResult> suffix_future;
 
     {
-      auto batch = Batch::New();
+      auto batch = self->GetBatch();
       if (prefix_length != 0) {
         kvstore::ReadOptions options;
         options.byte_range = OptionalByteRangeRequest(0, prefix_length);
@@ -163,6 +223,9 @@ struct AutoDetectOperationState {
       } else {
         suffix_future = kvstore::ReadResult{};
       }
+
+      // If the file is not found, the path may instead be a directory.
+      self->StartDirectoryProbe(batch);
     }
 
     auto& self_ref = *self;
@@ -246,49 +309,28 @@ struct AutoDetectOperationState {
   }
 
   static void MaybeDetectDirectoryFormat(Ptr self, Promise<Value> promise) {
-    absl::btree_set<std::string> filenames;
-    {
-      auto& registry = GetAutoDetectRegistry();
-      absl::ReaderMutexLock lock(&registry.mutex);
-      filenames = registry.filenames;
+    if (!self->directory_probe) {
+      self->StartDirectoryProbe(self->GetBatch());
     }
-    if (filenames.empty()) {
+    if (self->directory_probe->filenames.empty()) {
       self->SetMatches(std::move(promise), {});
       return;
     }
-    internal::EnsureDirectoryPath(self->base.path);
-    std::vector<Future<kvstore::ReadResult>> read_futures;
-    read_futures.reserve(filenames.size());
-    auto [all_promise, all_future] =
-        PromiseFuturePair<void>::Make(absl::OkStatus());
-    {
-      auto batch = Batch::New();
-      for (const auto& filename : filenames) {
-        kvstore::ReadOptions options;
-        options.staleness_bound = self->time;
-        options.byte_range = OptionalByteRangeRequest::Stat();
-        options.batch = batch;
-        read_futures.push_back(
-            kvstore::Read(self->base, filename, std::move(options)));
-        // Create a link to prevent `promise` from becoming ready
-        // until all read futures become ready.
-        Link([](Promise<void> promise,
-                ReadyFuture<kvstore::ReadResult> future) {},
-             all_promise, read_futures.back());
-      }
-    }
+    self->base.path = self->directory_probe->path;
+    auto all_future = self->directory_probe->all_future;
     auto& self_ref = *self;
     Link(WithExecutor(
              self_ref.executor,
-             [self = std::move(self), filenames = std::move(filenames),
-              read_futures = std::move(read_futures)](
-                 Promise<Value> promise, ReadyFuture<void> future) mutable {
+             [self = std::move(self)](Promise<Value> promise,
+                                      ReadyFuture<void> future) mutable {
                if (auto status = future.status(); !status.ok()) {
                  promise.SetResult(std::move(status));
                  return;
                }
+               auto& probe = *self->directory_probe;
+               auto filenames = std::move(probe.filenames);
                auto filename_it = filenames.begin();
-               for (const auto& future : read_futures) {
+               for (const auto& future : probe.read_futures) {
                  auto& result = future.result();
                  if (result && result->has_value()) {
                    ++filename_it;
@@ -424,8 +466,10 @@ void AutoDetectRegistration::ClearRegistrations() {
 }
 
 Future<std::vector<AutoDetectMatch>> AutoDetectFormat(Executor executor,
-                                                      KvStore base) {
-  return AutoDetectOperationState::Start(std::move(executor), std::move(base));
+                                                      KvStore base,
+                                                      Batch batch) {
+  return AutoDetectOperationState::Start(std::move(executor), std::move(base),
+                                         std::move(batch));
 }
 
 }  // namespace internal_kvstore
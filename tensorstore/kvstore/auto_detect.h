@@ -24,6 +24,7 @@
 
 #include "absl/container/btree_set.h"
 #include "absl/strings/cord.h"
+#include "tensorstore/batch.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/util/executor.h"
 #include "tensorstore/util/future.h"
@@ -152,7 +153,8 @@ struct AutoDetectRegistration {
 //
 // If `base.path` looks like a file path (non-empty and doesn't end with "/"),
 // detects either a registered file format, or a registered directory format
-// once "/" is appended to `base.path`.
+// once "/" is appended to `base.path`.  The reads for both are issued
+// concurrently; if the file exists, the directory reads are not waited for.
 //
 // If `base.path` is a directory path (empty or ends with "/"), detects only
 // registered directory formats.
@@ -162,8 +164,12 @@ struct AutoDetectRegistration {
 //
 // If at least one format is detected, any read errors (which may just be
 // spurious errors due to files not being found) are ignored.
-Future<std::vector<AutoDetectMatch>> AutoDetectFormat(Executor executor,
-                                                      KvStore base);
+//
+// The initial reads are issued using `batch`, if specified, which allows them
+// to be coalesced with other reads, e.g. when opening many arrays at once.
+// Any subsequent reads use a new batch.
+Future<std::vector<AutoDetectMatch>> AutoDetectFormat(
+    Executor executor, KvStore base, Batch batch = no_batch);
 
 }  // namespace internal_kvstore
 }  // namespace tensorstore
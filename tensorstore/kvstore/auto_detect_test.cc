@@ -26,11 +26,14 @@
 #include "absl/strings/cord.h"
 #include "absl/time/clock.h"
 #include <nlohmann/json_fwd.hpp>
+#include "tensorstore/batch.h"
 #include "tensorstore/internal/testing/json_gtest.h"
 #include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/memory/memory_key_value_store.h"
 #include "tensorstore/kvstore/mock_kvstore.h"
+#include "tensorstore/kvstore/operations.h"
 #include "tensorstore/kvstore/read_result.h"
 #include "tensorstore/util/executor.h"
 #include "tensorstore/util/result.h"
@@ -73,6 +76,30 @@ TestMatch(std::string path, MockKeyValueStore::ReadHandler read_handler) {
   return {future.result(), mock_kvstore->request_log.pop_all()};
 }
 
+// Tests that the initial reads use the specified batch.
+TEST_F(AutoDetectTest, Batch) {
+  AutoDetectRegistration(
+      AutoDetectFileSpec::PrefixSignature("prefix-scheme", "X"));
+  auto memory_kvstore = tensorstore::GetMemoryKeyValueStore();
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::kvstore::Write(KvStore(memory_kvstore), "test",
+                                  absl::Cord("X"))
+          .result());
+  auto mock_kvstore = MockKeyValueStore::Make();
+  mock_kvstore->handle_batch_requests = true;
+  auto batch = tensorstore::Batch::New();
+  auto future =
+      AutoDetectFormat(InlineExecutor{}, KvStore(mock_kvstore, "test"), batch);
+  EXPECT_TRUE(mock_kvstore->batch_read_requests.empty());
+  EXPECT_FALSE(future.ready());
+  batch.Release();
+  auto request = mock_kvstore->batch_read_requests.pop();
+  EXPECT_EQ("test", request.key);
+  request(memory_kvstore);
+  EXPECT_THAT(future.result(), ::testing::Optional(::testing::ElementsAre(
+                                   AutoDetectMatch{"prefix-scheme"})));
+}
+
 // Tests that no requests are made and an empty match list is returned for a
 // file if nothing is registered.
 TEST_F(AutoDetectTest, NothingRegisteredFilePath) {
@@ -647,7 +674,8 @@ TEST_F(AutoDetectTest, PrefixAndDirectoryMatchers) {
                                   {"/key", "test/a"},
                                   {"/byte_range_exclusive_max", 0}}))));
 
-  // File -> found, not matching.
+  // File -> found, not matching.  The directory entry is read concurrently
+  // with the file, but its result is not used.
   EXPECT_THAT(
       TestMatch("test",
                 [](MockKeyValueStore::ReadRequest req) {
@@ -656,11 +684,15 @@ TEST_F(AutoDetectTest, PrefixAndDirectoryMatchers) {
                       TimestampedStorageGeneration(
                           StorageGeneration::FromString("g1"), absl::Now())));
                 }),
-      ::testing::Pair(::testing::Optional(::testing::ElementsAre()),
-                      ::testing::ElementsAre(JsonSubValuesMatch(
-                          {{"/type", "read"},
-                           {"/key", "test"},
-                           {"/byte_range_exclusive_max", 1}}))));
+      ::testing::Pair(
+          ::testing::Optional(::testing::ElementsAre()),
+          ::testing::ElementsAre(
+              JsonSubValuesMatch({{"/type", "read"},
+                                  {"/key", "test"},
+                                  {"/byte_range_exclusive_max", 1}}),
+              JsonSubValuesMatch({{"/type", "read"},
+                                  {"/key", "test/a"},
+                                  {"/byte_range_exclusive_max", 0}}))));
 
   // File -> read error, directory entry -> not found
   EXPECT_THAT(
@@ -735,6 +767,29 @@ TEST_F(AutoDetectTest, PrefixAndDirectoryMatchers) {
                                   {"/byte_range_exclusive_max", 0}}))));
 }
 
+// Tests that the file and directory reads are issued concurrently, and that a
+// file match does not wait for the directory reads.
+TEST_F(AutoDetectTest, FileMatchDoesNotWaitForDirectoryReads) {
+  AutoDetectRegistration(
+      AutoDetectFileSpec::PrefixSignature("prefix-scheme", "X"));
+  AutoDetectRegistration(AutoDetectDirectorySpec::SingleFile("scheme-a", "a"));
+  auto mock_kvstore = MockKeyValueStore::Make();
+  auto future =
+      AutoDetectFormat(InlineExecutor{}, KvStore(mock_kvstore, "test"));
+  auto file_request = mock_kvstore->read_requests.pop();
+  auto directory_request = mock_kvstore->read_requests.pop();
+  EXPECT_EQ("test", file_request.key);
+  EXPECT_EQ("test/a", directory_request.key);
+  EXPECT_FALSE(future.ready());
+  file_request.promise.SetResult(ReadResult::Value(
+      absl::Cord("X"),
+      TimestampedStorageGeneration(StorageGeneration::FromString("g1"),
+                                   absl::Now())));
+  ASSERT_TRUE(future.ready());
+  EXPECT_THAT(future.result(), ::testing::Optional(::testing::ElementsAre(
+                                   AutoDetectMatch{"prefix-scheme"})));
+}
+
 TEST_F(AutoDetectTest, SuffixAndDirectoryMatchers) {
   AutoDetectRegistration(
       AutoDetectFileSpec::SuffixSignature("suffix-scheme", "X"));
@@ -756,7 +811,8 @@ TEST_F(AutoDetectTest, SuffixAndDirectoryMatchers) {
                                   {"/key", "test/a"},
                                   {"/byte_range_exclusive_max", 0}}))));
 
-  // File -> found, not matching.
+  // File -> found, not matching.  The directory entry is read concurrently
+  // with the file, but its result is not used.
   EXPECT_THAT(
       TestMatch("test",
                 [](MockKeyValueStore::ReadRequest req) {
@@ -765,11 +821,15 @@ TEST_F(AutoDetectTest, SuffixAndDirectoryMatchers) {
                       TimestampedStorageGeneration(
                           StorageGeneration::FromString("g1"), absl::Now())));
                 }),
-      ::testing::Pair(::testing::Optional(::testing::ElementsAre()),
-                      ::testing::ElementsAre(JsonSubValuesMatch(
-                          {{"/type", "read"},
-                           {"/key", "test"},
-                           {"/byte_range_inclusive_min", -1}}))));
+      ::testing::Pair(
+          ::testing::Optional(::testing::ElementsAre()),
+          ::testing::ElementsAre(
+              JsonSubValuesMatch({{"/type", "read"},
+                                  {"/key", "test"},
+                                  {"/byte_range_inclusive_min", -1}}),
+              JsonSubValuesMatch({{"/type", "read"},
+                                  {"/key", "test/a"},
+                                  {"/byte_range_exclusive_max", 0}}))));
 
   // File -> read error, directory entry -> not found
   EXPECT_THAT(
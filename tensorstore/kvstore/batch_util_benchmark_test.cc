@@ -0,0 +1,120 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks coalescing of batched byte range reads, independent of any
+// kvstore I/O.
+//
+// BM_CoalesceRequests/<num_requests>/<gap>
+//
+// num_requests:
+//   Number of byte range requests in the batch, issued in random order.
+//
+// gap:
+//   Number of bytes between consecutive requested ranges of 1024 bytes.
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "absl/random/random.h"
+#include "absl/strings/cord.h"
+#include "absl/time/time.h"
+#include "tensorstore/kvstore/batch_util.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/span.h"
+
+namespace {
+
+using ::tensorstore::ByteRange;
+using ::tensorstore::Future;
+using ::tensorstore::OptionalByteRangeRequest;
+using ::tensorstore::PromiseFuturePair;
+using ::tensorstore::span;
+using ::tensorstore::StorageGeneration;
+using ::tensorstore::kvstore::ReadResult;
+using ::tensorstore::internal_kvstore_batch::ByteRangeReadRequest;
+using ::tensorstore::internal_kvstore_batch::ForEachCoalescedRequest;
+using ::tensorstore::internal_kvstore_batch::
+    kDefaultRemoteStorageCoalescingOptions;
+using ::tensorstore::internal_kvstore_batch::ResolveCoalescedRequests;
+
+using Request = ::tensorstore::internal_kvstore_batch::ReadRequest<>;
+
+constexpr int64_t kRangeSize = 1024;
+
+void BM_CoalesceRequests(benchmark::State& state) {
+  const int64_t num_requests = state.range(0);
+  const int64_t gap = state.range(1);
+  const int64_t value_size = num_requests * (kRangeSize + gap);
+  const absl::Cord value(std::string(value_size, 'x'));
+
+  std::vector<int64_t> starts(num_requests);
+  for (int64_t i = 0; i < num_requests; ++i) {
+    starts[i] = i * (kRangeSize + gap);
+  }
+  absl::InsecureBitGen gen;
+  std::shuffle(starts.begin(), starts.end(), gen);
+
+  int64_t coalesced_reads = 0;
+  for (auto s : state) {
+    state.PauseTiming();
+    std::vector<Request> requests;
+    std::vector<Future<ReadResult>> futures;
+    requests.reserve(num_requests);
+    futures.reserve(num_requests);
+    for (int64_t start : starts) {
+      auto pair = PromiseFuturePair<ReadResult>::Make();
+      requests.emplace_back(ByteRangeReadRequest{
+          std::move(pair.promise),
+          OptionalByteRangeRequest::Range(start, start + kRangeSize)});
+      futures.push_back(std::move(pair.future));
+    }
+    state.ResumeTiming();
+
+    ForEachCoalescedRequest<Request>(
+        span<Request>(requests), kDefaultRemoteStorageCoalescingOptions,
+        [&](ByteRange coalesced_byte_range,
+            span<Request> coalesced_requests) {
+          ++coalesced_reads;
+          ReadResult read_result = ReadResult::Value(
+              value.Subcord(coalesced_byte_range.inclusive_min,
+                            coalesced_byte_range.size()),
+              {StorageGeneration::FromString("g"),
+               absl::InfinitePast()});
+          ResolveCoalescedRequests(coalesced_byte_range, coalesced_requests,
+                                   std::move(read_result));
+        });
+
+    state.PauseTiming();
+    for (auto& future : futures) {
+      benchmark::DoNotOptimize(future.value());
+    }
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * num_requests);
+  state.counters["coalesced_reads"] = benchmark::Counter(
+      static_cast<double>(coalesced_reads) / state.iterations());
+}
+
+BENCHMARK(BM_CoalesceRequests)
+    ->ArgsProduct({{16, 256, 4096}, {0, 1024, 8192}});
+
+}  // namespace
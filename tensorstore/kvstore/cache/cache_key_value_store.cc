@@ -0,0 +1,647 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+/// Key-value store adapter that keeps a persistent copy of the values read
+/// from a base key-value store in a second, typically local, key-value store.
+///
+/// Each cached value is stored under the same key in the cache key-value
+/// store, prefixed by a small header holding the `StorageGeneration` and time
+/// at which it was read from the base.  Reads of cached keys are validated
+/// against the base with an `if_not_equal` condition, so that unchanged
+/// values are not transferred again.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "tensorstore/context.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/driver.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/registry.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/kvstore/supported_features.h"
+#include "tensorstore/transaction.h"
+#include "tensorstore/util/execution/any_receiver.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/garbage_collection/fwd.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+// specializations
+#include "tensorstore/internal/cache_key/std_optional.h"
+#include "tensorstore/internal/json_binding/std_optional.h"
+#include "tensorstore/serialization/std_optional.h"
+
+namespace tensorstore {
+namespace internal_cache_kvstore {
+namespace {
+
+namespace jb = tensorstore::internal_json_binding;
+
+using ::tensorstore::kvstore::ListOptions;
+using ::tensorstore::kvstore::ListReceiver;
+using ::tensorstore::kvstore::ReadResult;
+using ::tensorstore::kvstore::SupportedFeatures;
+
+// -----------------------------------------------------------------------------
+// Cache entry format
+//
+//   magic:             4 bytes, `kCacheEntryMagic`
+//   generation_size:   uint32, little endian
+//   generation:        `generation_size` bytes, `StorageGeneration::value`
+//   time:              int64 nanoseconds since the Unix epoch, little endian
+//   value:             remaining bytes
+
+constexpr char kCacheEntryMagic[4] = {'t', 's', 'c', '1'};
+constexpr size_t kCacheEntryFixedHeaderSize = 4 + 4 + 8;
+
+struct CacheEntry {
+  TimestampedStorageGeneration stamp;
+  absl::Cord value;
+};
+
+void AppendLittleEndian(std::string& out, uint64_t x, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    out.push_back(static_cast<char>((x >> (8 * i)) & 0xff));
+  }
+}
+
+uint64_t LoadLittleEndian(std::string_view s, size_t size) {
+  uint64_t x = 0;
+  for (size_t i = 0; i < size; ++i) {
+    x |= static_cast<uint64_t>(static_cast<unsigned char>(s[i])) << (8 * i);
+  }
+  return x;
+}
+
+absl::Cord EncodeCacheEntry(const TimestampedStorageGeneration& stamp,
+                            const absl::Cord& value) {
+  std::string header(kCacheEntryMagic, sizeof(kCacheEntryMagic));
+  AppendLittleEndian(header, stamp.generation.value.size(), 4);
+  header += stamp.generation.value;
+  AppendLittleEndian(
+      header, static_cast<uint64_t>(absl::ToUnixNanos(stamp.time)), 8);
+  absl::Cord encoded(std::move(header));
+  encoded.Append(value);
+  return encoded;
+}
+
+/// Decodes an entry written by `EncodeCacheEntry`, or returns `std::nullopt`
+/// if `encoded` is not a valid entry.
+std::optional<CacheEntry> DecodeCacheEntry(const absl::Cord& encoded) {
+  if (encoded.size() < kCacheEntryFixedHeaderSize) return std::nullopt;
+  std::string prefix(encoded.Subcord(0, 8));
+  if (std::string_view(prefix).substr(0, 4) !=
+      std::string_view(kCacheEntryMagic, sizeof(kCacheEntryMagic))) {
+    return std::nullopt;
+  }
+  size_t generation_size =
+      LoadLittleEndian(std::string_view(prefix).substr(4), 4);
+  if (encoded.size() < kCacheEntryFixedHeaderSize + generation_size) {
+    return std::nullopt;
+  }
+  CacheEntry entry;
+  entry.stamp.generation.value =
+      std::string(encoded.Subcord(8, generation_size));
+  if (!StorageGeneration::IsCleanValidValue(entry.stamp.generation)) {
+    return std::nullopt;
+  }
+  std::string time(encoded.Subcord(8 + generation_size, 8));
+  entry.stamp.time = absl::FromUnixNanos(
+      static_cast<int64_t>(LoadLittleEndian(time, 8)));
+  size_t header_size = kCacheEntryFixedHeaderSize + generation_size;
+  entry.value = encoded.Subcord(header_size, encoded.size() - header_size);
+  return entry;
+}
+
+/// Applies the conditions and byte range of `options` to `entry`.
+Result<ReadResult> ReadFromCacheEntry(CacheEntry entry,
+                                      const kvstore::ReadOptions& options) {
+  if (!options.generation_conditions.Matches(entry.stamp.generation)) {
+    return ReadResult::Unspecified(std::move(entry.stamp));
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(auto byte_range,
+                               options.byte_range.Validate(entry.value.size()));
+  return ReadResult::Value(internal::GetSubCord(entry.value, byte_range),
+                           std::move(entry.stamp));
+}
+
+// -----------------------------------------------------------------------------
+
+struct CacheKvStoreSpecData {
+  kvstore::Spec base;
+  kvstore::Spec cache;
+  std::optional<uint64_t> max_bytes;
+
+  constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+    return f(x.base, x.cache, x.max_bytes);
+  };
+
+  constexpr static auto default_json_binder = jb::Object(
+      jb::Member("base", jb::Projection<&CacheKvStoreSpecData::base>()),
+      jb::Member("cache", jb::Projection<&CacheKvStoreSpecData::cache>()),
+      jb::Member("max_bytes",
+                 jb::Projection<&CacheKvStoreSpecData::max_bytes>()) /**/
+  );
+};
+
+class CacheKvStoreSpec
+    : public internal_kvstore::RegisteredDriverSpec<CacheKvStoreSpec,
+                                                    CacheKvStoreSpecData> {
+ public:
+  static constexpr char id[] = "cache";
+
+  Future<kvstore::DriverPtr> DoOpen() const override;
+
+  absl::Status ApplyOptions(kvstore::DriverSpecOptions&& options) override {
+    TENSORSTORE_RETURN_IF_ERROR(
+        data_.cache.driver.Set(kvstore::DriverSpecOptions(options)));
+    return data_.base.driver.Set(std::move(options));
+  }
+
+  Result<kvstore::Spec> GetBase(std::string_view path) const override {
+    kvstore::Spec base = data_.base;
+    base.AppendSuffix(path);
+    return base;
+  }
+};
+
+/// Tracks the size of the cached values and the order in which they were
+/// used, to keep the cache within `max_bytes`.
+class CacheIndex {
+ public:
+  /// A cached value to remove from the cache key-value store.
+  struct Victim {
+    std::string key;
+    /// Generation of the cached value in the cache key-value store, or
+    /// `StorageGeneration::Unknown()` if its write has not completed.
+    StorageGeneration cache_generation;
+  };
+
+  void SetMaxBytes(std::optional<uint64_t> max_bytes) {
+    absl::MutexLock lock(&mutex_);
+    max_bytes_ = max_bytes;
+  }
+
+  /// Records an entry of `size` bytes for `key`.  Returns the id of the write,
+  /// for use with `SetCacheGeneration` and `Remove`, or `std::nullopt` if the
+  /// value is too large to cache.  Values to evict are appended to `victims`.
+  std::optional<uint64_t> Insert(std::string_view key, uint64_t size,
+                                 std::vector<Victim>& victims) {
+    absl::MutexLock lock(&mutex_);
+    if (max_bytes_ && size > *max_bytes_) {
+      RemoveLocked(key, std::nullopt);
+      return std::nullopt;
+    }
+    auto [it, inserted] = entries_.try_emplace(key);
+    auto& entry = it->second;
+    if (inserted) {
+      entry.lru_position = lru_.insert(lru_.end(), it->first);
+    } else {
+      total_bytes_ -= entry.size;
+      lru_.splice(lru_.end(), lru_, entry.lru_position);
+    }
+    entry.size = size;
+    entry.write_id = ++next_write_id_;
+    entry.cache_generation = StorageGeneration::Unknown();
+    entry.validated_time = absl::InfinitePast();
+    total_bytes_ += size;
+    uint64_t write_id = entry.write_id;
+    EvictLocked(victims);
+    return write_id;
+  }
+
+  /// Records `cache_generation` for `key` if it was last written by the write
+  /// with id `write_id`.
+  void SetCacheGeneration(std::string_view key, uint64_t write_id,
+                          StorageGeneration cache_generation) {
+    absl::MutexLock lock(&mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end() || it->second.write_id != write_id) return;
+    it->second.cache_generation = std::move(cache_generation);
+  }
+
+  /// Marks `key` as most recently used, and records that its cached value was
+  /// found to be current as of `validated_time`.  Returns the latest such
+  /// time.
+  absl::Time Touch(std::string_view key, absl::Time validated_time) {
+    absl::MutexLock lock(&mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) return validated_time;
+    auto& entry = it->second;
+    lru_.splice(lru_.end(), lru_, entry.lru_position);
+    entry.validated_time = std::max(entry.validated_time, validated_time);
+    return entry.validated_time;
+  }
+
+  /// Removes `key`, provided that `write_id` is `std::nullopt` or matches its
+  /// last write.
+  void Remove(std::string_view key, std::optional<uint64_t> write_id) {
+    absl::MutexLock lock(&mutex_);
+    RemoveLocked(key, write_id);
+  }
+
+  void RemoveRange(const KeyRange& range) {
+    absl::MutexLock lock(&mutex_);
+    for (auto it = lru_.begin(); it != lru_.end();) {
+      auto next = std::next(it);
+      if (Contains(range, *it)) RemoveLocked(*it, std::nullopt);
+      it = next;
+    }
+  }
+
+  /// Adds the values listed from the cache key-value store on open.
+  void Initialize(tensorstore::span<const kvstore::ListEntry> list_entries,
+                  std::vector<Victim>& victims) {
+    absl::MutexLock lock(&mutex_);
+    for (const auto& list_entry : list_entries) {
+      auto [it, inserted] = entries_.try_emplace(list_entry.key);
+      if (!inserted) continue;
+      auto& entry = it->second;
+      entry.lru_position = lru_.insert(lru_.end(), it->first);
+      entry.size = list_entry.has_size() ? list_entry.size : 0;
+      entry.write_id = 0;
+      entry.cache_generation = StorageGeneration::Unknown();
+      entry.validated_time = absl::InfinitePast();
+      total_bytes_ += entry.size;
+    }
+    EvictLocked(victims);
+  }
+
+ private:
+  struct Entry {
+    uint64_t size;
+    uint64_t write_id;
+    StorageGeneration cache_generation;
+    absl::Time validated_time;
+    std::list<std::string>::iterator lru_position;
+  };
+
+  void RemoveLocked(std::string_view key, std::optional<uint64_t> write_id)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    auto it = entries_.find(key);
+    if (it == entries_.end()) return;
+    if (write_id && it->second.write_id != *write_id) return;
+    total_bytes_ -= it->second.size;
+    lru_.erase(it->second.lru_position);
+    entries_.erase(it);
+  }
+
+  void EvictLocked(std::vector<Victim>& victims)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    if (!max_bytes_) return;
+    while (total_bytes_ > *max_bytes_ && !lru_.empty()) {
+      auto it = entries_.find(lru_.front());
+      victims.push_back(Victim{it->first, it->second.cache_generation});
+      total_bytes_ -= it->second.size;
+      lru_.pop_front();
+      entries_.erase(it);
+    }
+  }
+
+  mutable absl::Mutex mutex_;
+  std::optional<uint64_t> max_bytes_ ABSL_GUARDED_BY(mutex_);
+  uint64_t total_bytes_ ABSL_GUARDED_BY(mutex_) = 0;
+  uint64_t next_write_id_ ABSL_GUARDED_BY(mutex_) = 0;
+  absl::flat_hash_map<std::string, Entry> entries_ ABSL_GUARDED_BY(mutex_);
+  /// Least recently used first.
+  std::list<std::string> lru_ ABSL_GUARDED_BY(mutex_);
+};
+
+/// Defines the "cache" key-value store adapter.
+class CacheKvStore
+    : public internal_kvstore::RegisteredDriver<CacheKvStore,
+                                                CacheKvStoreSpec> {
+ public:
+  Future<ReadResult> Read(Key key, ReadOptions options) override;
+
+  Future<TimestampedStorageGeneration> Write(Key key,
+                                             std::optional<Value> value,
+                                             WriteOptions options) override;
+
+  Future<const void> DeleteRange(KeyRange range) override;
+
+  void ListImpl(ListOptions options, ListReceiver receiver) override;
+
+  std::string DescribeKey(std::string_view key) override {
+    return base_.driver->DescribeKey(GetBaseKey(key));
+  }
+
+  absl::Status GetBoundSpecData(CacheKvStoreSpecData& spec) const {
+    TENSORSTORE_ASSIGN_OR_RETURN(spec.base,
+                                 base_.spec(ContextBindingMode::retain));
+    TENSORSTORE_ASSIGN_OR_RETURN(spec.cache,
+                                 cache_.spec(ContextBindingMode::retain));
+    spec.max_bytes = max_bytes_;
+    return absl::OkStatus();
+  }
+
+  SupportedFeatures GetSupportedFeatures(
+      const KeyRange& key_range) const final {
+    return base_.driver->GetSupportedFeatures(
+        KeyRange::AddPrefix(base_.path, key_range));
+  }
+
+  Result<KvStore> GetBase(std::string_view path,
+                          const Transaction& transaction) const override {
+    return KvStore(base_.driver, GetBaseKey(path), transaction);
+  }
+
+  std::string GetBaseKey(std::string_view key) const {
+    return tensorstore::StrCat(base_.path, key);
+  }
+
+  /// Writes `value`, read from or written to the base with `stamp`, to the
+  /// cache key-value store.
+  void StoreInCache(std::string key, const TimestampedStorageGeneration& stamp,
+                    const absl::Cord& value);
+
+  /// Removes any cached value of `key`.
+  void RemoveFromCache(std::string key);
+
+  /// Removes values evicted from the index from the cache key-value store.
+  void DeleteVictims(std::vector<CacheIndex::Victim> victims);
+
+  kvstore::KvStore base_;
+  kvstore::KvStore cache_;
+  std::optional<uint64_t> max_bytes_;
+  CacheIndex index_;
+};
+
+Future<kvstore::DriverPtr> CacheKvStoreSpec::DoOpen() const {
+  auto driver = internal::MakeIntrusivePtr<CacheKvStore>();
+  driver->max_bytes_ = data_.max_bytes;
+  driver->index_.SetMaxBytes(data_.max_bytes);
+  return PromiseFuturePair<kvstore::DriverPtr>::LinkValue(
+             [driver = std::move(driver)](
+                 Promise<kvstore::DriverPtr> promise,
+                 ReadyFuture<kvstore::KvStore> base_future,
+                 ReadyFuture<kvstore::KvStore> cache_future) mutable {
+               driver->base_ = std::move(base_future.value());
+               driver->cache_ = std::move(cache_future.value());
+               driver->SetBatchNestingDepth(
+                   std::max(driver->base_.driver->BatchNestingDepth(),
+                            driver->cache_.driver->BatchNestingDepth()) +
+                   1);
+               if (!driver->max_bytes_) {
+                 promise.SetResult(std::move(driver));
+                 return;
+               }
+               // Sizes of the values already cached are needed to honor
+               // `max_bytes`.
+               auto list_future = kvstore::ListFuture(driver->cache_);
+               LinkValue(
+                   [driver = std::move(driver)](
+                       Promise<kvstore::DriverPtr> promise,
+                       ReadyFuture<std::vector<kvstore::ListEntry>>
+                           list_future) mutable {
+                     std::vector<CacheIndex::Victim> victims;
+                     driver->index_.Initialize(list_future.value(), victims);
+                     driver->DeleteVictims(std::move(victims));
+                     promise.SetResult(std::move(driver));
+                   },
+                   std::move(promise), std::move(list_future));
+             },
+             kvstore::Open(data_.base), kvstore::Open(data_.cache))
+      .future;
+}
+
+void CacheKvStore::StoreInCache(std::string key,
+                                const TimestampedStorageGeneration& stamp,
+                                const absl::Cord& value) {
+  auto encoded = EncodeCacheEntry(stamp, value);
+  std::vector<CacheIndex::Victim> victims;
+  auto write_id = index_.Insert(key, encoded.size(), victims);
+  DeleteVictims(std::move(victims));
+  if (!write_id) {
+    // Too large to cache; any previous value is stale.
+    RemoveFromCache(std::move(key));
+    return;
+  }
+  auto future = kvstore::Write(cache_, key, std::move(encoded));
+  future.ExecuteWhenReady(
+      [self = internal::IntrusivePtr<CacheKvStore>(this), key = std::move(key),
+       write_id = *write_id](
+          ReadyFuture<TimestampedStorageGeneration> future) {
+        auto& r = future.result();
+        if (r.ok()) {
+          self->index_.SetCacheGeneration(key, write_id, r->generation);
+        } else {
+          self->index_.Remove(key, write_id);
+        }
+      });
+}
+
+void CacheKvStore::RemoveFromCache(std::string key) {
+  index_.Remove(key, std::nullopt);
+  kvstore::Delete(cache_, std::move(key)).IgnoreFuture();
+}
+
+void CacheKvStore::DeleteVictims(std::vector<CacheIndex::Victim> victims) {
+  for (auto& victim : victims) {
+    kvstore::WriteOptions options;
+    // A value written again since it was evicted from the index must be
+    // retained.
+    options.generation_conditions.if_equal =
+        std::move(victim.cache_generation);
+    kvstore::Delete(cache_, std::move(victim.key), std::move(options))
+        .IgnoreFuture();
+  }
+}
+
+/// State of a `CacheKvStore::Read` operation.
+struct ReadState : public internal::AtomicReferenceCount<ReadState> {
+  internal::IntrusivePtr<CacheKvStore> driver;
+  std::string key;
+  kvstore::ReadOptions options;
+  Promise<ReadResult> promise;
+
+  /// Called with the value of `key` in the cache key-value store.
+  void OnCacheRead(Result<ReadResult> cache_result) {
+    std::optional<CacheEntry> entry;
+    if (cache_result.ok() && cache_result->has_value()) {
+      entry = DecodeCacheEntry(cache_result->value);
+      if (!entry) driver->RemoveFromCache(key);
+    }
+    if (entry) {
+      entry->stamp.time = driver->index_.Touch(key, entry->stamp.time);
+      if (entry->stamp.time >= options.staleness_bound) {
+        promise.SetResult(ReadFromCacheEntry(*std::move(entry), options));
+        return;
+      }
+    }
+    kvstore::ReadOptions base_options;
+    base_options.staleness_bound = options.staleness_bound;
+    base_options.batch = std::move(options.batch);
+    const bool cacheable = options.byte_range.IsFull();
+    if (entry) {
+      // The conditions of `options` are applied to the validated entry.
+      base_options.generation_conditions.if_not_equal = entry->stamp.generation;
+      base_options.byte_range = options.byte_range;
+    } else {
+      // Requests for part of an uncached value are passed through, rather
+      // than transferring the entire value to cache it.
+      base_options.generation_conditions = options.generation_conditions;
+      base_options.byte_range = options.byte_range;
+    }
+    auto future = driver->base_.driver->Read(driver->GetBaseKey(key),
+                                             std::move(base_options));
+    future.ExecuteWhenReady(
+        [self = internal::IntrusivePtr<ReadState>(this),
+         entry = std::move(entry),
+         cacheable](ReadyFuture<ReadResult> future) mutable {
+          self->OnBaseRead(std::move(entry), cacheable, future.result());
+        });
+  }
+
+  /// Called with the result of the read from the base, where `entry` is the
+  /// cached value that was validated, if any.
+  void OnBaseRead(std::optional<CacheEntry> entry, bool cacheable,
+                  Result<ReadResult>& base_result) {
+    if (!base_result.ok()) {
+      promise.SetResult(std::move(base_result).status());
+      return;
+    }
+    auto& read_result = *base_result;
+    if (entry) {
+      switch (read_result.state) {
+        case ReadResult::kUnspecified:
+          // Not modified.
+          driver->index_.Touch(key, read_result.stamp.time);
+          entry->stamp.time = read_result.stamp.time;
+          promise.SetResult(ReadFromCacheEntry(*std::move(entry), options));
+          return;
+        case ReadResult::kMissing:
+          driver->RemoveFromCache(key);
+          promise.SetResult(std::move(read_result));
+          return;
+        case ReadResult::kValue:
+          if (cacheable) {
+            driver->StoreInCache(key, read_result.stamp, read_result.value);
+            promise.SetResult(ReadFromCacheEntry(
+                CacheEntry{std::move(read_result.stamp),
+                           std::move(read_result.value)},
+                options));
+            return;
+          }
+          driver->RemoveFromCache(key);
+          if (!options.generation_conditions.Matches(
+                  read_result.stamp.generation)) {
+            promise.SetResult(
+                ReadResult::Unspecified(std::move(read_result.stamp)));
+            return;
+          }
+          promise.SetResult(std::move(read_result));
+          return;
+      }
+    }
+    if (read_result.has_value() && cacheable) {
+      driver->StoreInCache(key, read_result.stamp, read_result.value);
+    }
+    promise.SetResult(std::move(read_result));
+  }
+};
+
+Future<ReadResult> CacheKvStore::Read(Key key, ReadOptions options) {
+  auto state = internal::MakeIntrusivePtr<ReadState>();
+  state->driver.reset(this);
+  auto cache_future = kvstore::Read(cache_, key);
+  state->key = std::move(key);
+  state->options = std::move(options);
+  auto [promise, future] = PromiseFuturePair<ReadResult>::Make();
+  state->promise = std::move(promise);
+  cache_future.ExecuteWhenReady(
+      [state = std::move(state)](ReadyFuture<ReadResult> cache_future) {
+        state->OnCacheRead(cache_future.result());
+      });
+  return std::move(future);
+}
+
+Future<TimestampedStorageGeneration> CacheKvStore::Write(
+    Key key, std::optional<Value> value, WriteOptions options) {
+  auto future = base_.driver->Write(GetBaseKey(key), value, std::move(options));
+  future.ExecuteWhenReady(
+      [self = internal::IntrusivePtr<CacheKvStore>(this), key = std::move(key),
+       value = std::move(value)](
+          ReadyFuture<TimestampedStorageGeneration> future) mutable {
+        auto& r = future.result();
+        if (!r.ok()) {
+          // The value in the base is unknown.
+          self->RemoveFromCache(std::move(key));
+          return;
+        }
+        // A failed condition leaves the base unchanged.
+        if (StorageGeneration::IsUnknown(r->generation)) return;
+        if (value) {
+          self->StoreInCache(std::move(key), *r, *value);
+        } else {
+          self->RemoveFromCache(std::move(key));
+        }
+      });
+  return future;
+}
+
+Future<const void> CacheKvStore::DeleteRange(KeyRange range) {
+  index_.RemoveRange(range);
+  auto cache_future = kvstore::DeleteRange(cache_, range);
+  auto base_future = base_.driver->DeleteRange(
+      KeyRange::AddPrefix(base_.path, std::move(range)));
+  return WaitAllFuture(std::move(base_future), std::move(cache_future));
+}
+
+void CacheKvStore::ListImpl(ListOptions options, ListReceiver receiver) {
+  options.range = KeyRange::AddPrefix(base_.path, std::move(options.range));
+  options.strip_prefix_length += base_.path.size();
+  base_.driver->ListImpl(std::move(options), std::move(receiver));
+}
+
+}  // namespace
+}  // namespace internal_cache_kvstore
+}  // namespace tensorstore
+
+TENSORSTORE_DECLARE_GARBAGE_COLLECTION_NOT_REQUIRED(
+    tensorstore::internal_cache_kvstore::CacheKvStore)
+
+// Registers the driver.
+namespace {
+const tensorstore::internal_kvstore::DriverRegistration<
+    tensorstore::internal_cache_kvstore::CacheKvStoreSpec>
+    registration;
+}  // namespace
@@ -0,0 +1,280 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/time/time.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/internal/global_initializer.h"
+#include "tensorstore/internal/testing/json_gtest.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/mock_kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/kvstore/test_matchers.h"
+#include "tensorstore/kvstore/test_util.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+namespace kvstore = ::tensorstore::kvstore;
+
+using ::tensorstore::Context;
+using ::tensorstore::JsonSubValueMatches;
+using ::tensorstore::OptionalByteRangeRequest;
+using ::tensorstore::Result;
+using ::tensorstore::internal::KeyValueStoreOpsTestParameters;
+using ::tensorstore::internal::MatchesKvsReadResult;
+using ::tensorstore::internal::MatchesKvsReadResultNotFound;
+using ::tensorstore::internal::MatchesListEntry;
+using ::tensorstore::internal::MockKeyValueStore;
+using ::tensorstore::internal::MockKeyValueStoreResource;
+using ::tensorstore::kvstore::KvStore;
+using ::testing::_;
+
+TENSORSTORE_GLOBAL_INITIALIZER {
+  KeyValueStoreOpsTestParameters params;
+  params.test_name = "Basic";
+  params.get_store = [](auto callback) {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto store,
+        kvstore::Open({{"driver", "cache"},
+                       {"base", {{"driver", "memory"}, {"path", "base/"}}},
+                       {"cache", {{"driver", "memory"}, {"path", "cache/"}}}})
+            .result());
+    callback(store);
+  };
+  RegisterKeyValueStoreOpsTests(params);
+}
+
+/// Opens a "cache" adapter over a logged mock base, with the values cached in
+/// a "memory" key-value store shared through `context_`.
+class CacheKvStoreTest : public ::testing::Test {
+ public:
+  CacheKvStoreTest() : context_(Context::Default()) {
+    // The base is opened in a separate context so that it does not share the
+    // memory key-value store used as the cache.
+    base_ =
+        kvstore::Open({{"driver", "memory"}}, Context::Default()).value();
+    mock_store_ =
+        context_.GetResource<MockKeyValueStoreResource>().value()->get();
+    mock_store_->forward_to = base_.driver;
+    mock_store_->log_requests = true;
+    cache_ = kvstore::Open({{"driver", "memory"}, {"path", "cache/"}}, context_)
+                 .value();
+  }
+
+  Result<KvStore> OpenStore(::nlohmann::json::object_t extra = {}) {
+    ::nlohmann::json spec{
+        {"driver", "cache"},
+        {"base", {{"driver", "mock_key_value_store"}}},
+        {"cache", {{"driver", "memory"}, {"path", "cache/"}}},
+    };
+    for (auto& [key, value] : extra) spec[key] = value;
+    return kvstore::Open(spec, context_).result();
+  }
+
+  Context context_;
+  KvStore base_;
+  KvStore cache_;
+  MockKeyValueStore* mock_store_;
+};
+
+TEST_F(CacheKvStoreTest, ReadPopulatesCache) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenStore());
+  TENSORSTORE_ASSERT_OK(kvstore::Write(base_, "a", absl::Cord("abc")));
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto read_result,
+                                   kvstore::Read(store, "a").result());
+  EXPECT_EQ("abc", read_result.value);
+  EXPECT_THAT(mock_store_->request_log.pop_all(),
+              ::testing::ElementsAre(::testing::AllOf(
+                  JsonSubValueMatches("/type", "read"),
+                  JsonSubValueMatches("/key", "a"),
+                  ::testing::Not(JsonSubValueMatches("/if_not_equal", _)))));
+  EXPECT_THAT(kvstore::ListFuture(cache_).result(),
+              ::testing::Optional(
+                  ::testing::ElementsAre(MatchesListEntry("a", _))));
+
+  // The second read only validates the cached value.
+  EXPECT_THAT(kvstore::Read(store, "a").result(),
+              MatchesKvsReadResult(absl::Cord("abc"),
+                                   read_result.stamp.generation));
+  EXPECT_THAT(mock_store_->request_log.pop_all(),
+              ::testing::ElementsAre(::testing::AllOf(
+                  JsonSubValueMatches("/type", "read"),
+                  JsonSubValueMatches("/key", "a"),
+                  JsonSubValueMatches("/if_not_equal",
+                                      read_result.stamp.generation.value))));
+}
+
+TEST_F(CacheKvStoreTest, ReadAfterBaseChange) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenStore());
+  TENSORSTORE_ASSERT_OK(kvstore::Write(base_, "a", absl::Cord("abc")));
+  TENSORSTORE_ASSERT_OK(kvstore::Read(store, "a").result());
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto stamp, kvstore::Write(base_, "a", absl::Cord("def")).result());
+  EXPECT_THAT(kvstore::Read(store, "a").result(),
+              MatchesKvsReadResult(absl::Cord("def"), stamp.generation));
+  EXPECT_THAT(kvstore::Read(store, "a").result(),
+              MatchesKvsReadResult(absl::Cord("def"), stamp.generation));
+
+  TENSORSTORE_ASSERT_OK(kvstore::Delete(base_, "a"));
+  EXPECT_THAT(kvstore::Read(store, "a").result(),
+              MatchesKvsReadResultNotFound());
+  EXPECT_THAT(kvstore::ListFuture(cache_).result(),
+              ::testing::Optional(::testing::IsEmpty()));
+}
+
+TEST_F(CacheKvStoreTest, CachePersistsAcrossOpen) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto stamp, kvstore::Write(base_, "a", absl::Cord("abc")).result());
+  {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenStore());
+    TENSORSTORE_ASSERT_OK(kvstore::Read(store, "a").result());
+  }
+  mock_store_->request_log.pop_all();
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenStore());
+  EXPECT_THAT(kvstore::Read(store, "a").result(),
+              MatchesKvsReadResult(absl::Cord("abc"), stamp.generation));
+  EXPECT_THAT(mock_store_->request_log.pop_all(),
+              ::testing::ElementsAre(::testing::AllOf(
+                  JsonSubValueMatches("/type", "read"),
+                  JsonSubValueMatches("/if_not_equal",
+                                      stamp.generation.value))));
+}
+
+TEST_F(CacheKvStoreTest, StaleReadDoesNotValidate) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenStore());
+  TENSORSTORE_ASSERT_OK(kvstore::Write(base_, "a", absl::Cord("abc")));
+  TENSORSTORE_ASSERT_OK(kvstore::Read(store, "a").result());
+  mock_store_->request_log.pop_all();
+
+  kvstore::ReadOptions options;
+  options.staleness_bound = absl::InfinitePast();
+  EXPECT_THAT(kvstore::Read(store, "a", options).result(),
+              MatchesKvsReadResult(absl::Cord("abc")));
+  EXPECT_THAT(mock_store_->request_log.pop_all(), ::testing::IsEmpty());
+}
+
+TEST_F(CacheKvStoreTest, ByteRangeReadOfUncachedValue) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenStore());
+  TENSORSTORE_ASSERT_OK(kvstore::Write(base_, "a", absl::Cord("abcdef")));
+
+  kvstore::ReadOptions options;
+  options.byte_range = OptionalByteRangeRequest::Range(1, 3);
+  EXPECT_THAT(kvstore::Read(store, "a", options).result(),
+              MatchesKvsReadResult(absl::Cord("bc")));
+  EXPECT_THAT(kvstore::ListFuture(cache_).result(),
+              ::testing::Optional(::testing::IsEmpty()));
+
+  // Once cached, byte ranges are served from the cached value.
+  TENSORSTORE_ASSERT_OK(kvstore::Read(store, "a").result());
+  mock_store_->request_log.pop_all();
+  EXPECT_THAT(kvstore::Read(store, "a", options).result(),
+              MatchesKvsReadResult(absl::Cord("bc")));
+  EXPECT_THAT(mock_store_->request_log.pop_all(),
+              ::testing::ElementsAre(::testing::AllOf(
+                  JsonSubValueMatches("/type", "read"),
+                  JsonSubValueMatches("/if_not_equal", _),
+                  JsonSubValueMatches("/byte_range_inclusive_min", 1))));
+}
+
+TEST_F(CacheKvStoreTest, WriteThrough) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenStore());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto stamp, kvstore::Write(store, "a", absl::Cord("abc")).result());
+  EXPECT_THAT(kvstore::Read(base_, "a").result(),
+              MatchesKvsReadResult(absl::Cord("abc"), stamp.generation));
+  EXPECT_THAT(kvstore::ListFuture(cache_).result(),
+              ::testing::Optional(
+                  ::testing::ElementsAre(MatchesListEntry("a", _))));
+
+  TENSORSTORE_ASSERT_OK(kvstore::Delete(store, "a"));
+  EXPECT_THAT(kvstore::ListFuture(cache_).result(),
+              ::testing::Optional(::testing::IsEmpty()));
+}
+
+TEST_F(CacheKvStoreTest, MaxBytes) {
+  // Each entry holds a 10-byte value and a 25-byte header.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenStore({{"max_bytes", 60}}));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("aaaaaaaaaa")));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "b", absl::Cord("bbbbbbbbbb")));
+  EXPECT_THAT(kvstore::ListFuture(cache_).result(),
+              ::testing::Optional(
+                  ::testing::ElementsAre(MatchesListEntry("b", _))));
+
+  // Values larger than `max_bytes` are not cached.
+  TENSORSTORE_ASSERT_OK(
+      kvstore::Write(store, "c", absl::Cord(std::string(100, 'c'))));
+  EXPECT_THAT(kvstore::ListFuture(cache_).result(),
+              ::testing::Optional(
+                  ::testing::ElementsAre(MatchesListEntry("b", _))));
+  EXPECT_THAT(kvstore::Read(store, "c").result(),
+              MatchesKvsReadResult(absl::Cord(std::string(100, 'c'))));
+
+  // Existing entries count toward `max_bytes` when the cache is reopened.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store2, OpenStore({{"max_bytes", 40}}));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store2, "d", absl::Cord("dddddddddd")));
+  EXPECT_THAT(kvstore::ListFuture(cache_).result(),
+              ::testing::Optional(
+                  ::testing::ElementsAre(MatchesListEntry("d", _))));
+}
+
+TEST_F(CacheKvStoreTest, DeleteRange) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenStore());
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("abc")));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "b", absl::Cord("abc")));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "c", absl::Cord("abc")));
+  TENSORSTORE_ASSERT_OK(
+      kvstore::DeleteRange(store, tensorstore::KeyRange("a", "c")));
+  EXPECT_THAT(kvstore::ListFuture(base_).result(),
+              ::testing::Optional(
+                  ::testing::ElementsAre(MatchesListEntry("c", _))));
+  EXPECT_THAT(kvstore::ListFuture(cache_).result(),
+              ::testing::Optional(
+                  ::testing::ElementsAre(MatchesListEntry("c", _))));
+}
+
+TEST(CacheKvStoreSpecTest, SpecRoundtrip) {
+  tensorstore::internal::KeyValueStoreSpecRoundtripOptions options;
+  options.full_base_spec = {{"driver", "memory"}, {"path", "base/"}};
+  options.full_spec = {{"driver", "cache"},
+                       {"base", options.full_base_spec},
+                       {"cache", {{"driver", "memory"}, {"path", "cache/"}}},
+                       {"max_bytes", 1000}};
+  options.check_data_after_serialization = false;
+  tensorstore::internal::TestKeyValueStoreSpecRoundtrip(options);
+}
+
+TEST(CacheKvStoreSpecTest, InvalidMaxBytes) {
+  EXPECT_THAT(
+      kvstore::Spec::FromJson({{"driver", "cache"},
+                               {"base", {{"driver", "memory"}}},
+                               {"cache", {{"driver", "memory"}}},
+                               {"max_bytes", -1}}),
+      tensorstore::StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace
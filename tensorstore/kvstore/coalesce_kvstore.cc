@@ -12,7 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include "tensorstore/kvstore/ocdbt/io/coalesce_kvstore.h"
+#include "tensorstore/kvstore/coalesce_kvstore.h"
 
 #include <stddef.h>
 
@@ -57,10 +57,10 @@
 #include "tensorstore/util/result.h"
 
 namespace tensorstore {
-namespace internal_ocdbt {
+namespace internal_kvstore {
 namespace {
 
-ABSL_CONST_INIT internal_log::VerboseFlag ocdbt_logging("ocdbt");
+ABSL_CONST_INIT internal_log::VerboseFlag coalesce_logging("kvstore_coalesce");
 
 absl::Cord DeepCopyCord(const absl::Cord& cord) {
   // If the Cord is flat, skipping the CordBuilder improves performance.
@@ -82,6 +82,21 @@ absl::Cord MaybeDeepCopyCord(absl::Cord cord) {
   return cord;
 }
 
+// A request issued to the base kvstore on behalf of one or more reads.
+struct MergedRead : public internal::AtomicReferenceCount<MergedRead> {
+  kvstore::ReadOptions options;
+
+  // Time at which the request was issued.
+  absl::Time issue_time;
+
+  struct Entry {
+    OptionalByteRangeRequest byte_range;
+    Promise<kvstore::ReadResult> promise;
+  };
+  // Guarded by `CoalesceKvStoreDriver::mu_` until the request completes.
+  std::vector<Entry> subreads;
+};
+
 struct PendingRead : public internal::AtomicReferenceCount<PendingRead> {
   kvstore::Key key;
 
@@ -90,8 +105,37 @@ struct PendingRead : public internal::AtomicReferenceCount<PendingRead> {
     Promise<kvstore::ReadResult> promise;
   };
   std::vector<Op> pending_ops;
+
+  // Requests that have been issued but have not completed.
+  std::vector<internal::IntrusivePtr<MergedRead>> in_flight;
 };
 
+// Returns `true` if a read with the specified `options` may be satisfied by
+// the in-flight request `merged`.
+bool CanJoin(const MergedRead& merged, const kvstore::ReadOptions& options) {
+  if (options.generation_conditions.if_equal !=
+          merged.options.generation_conditions.if_equal ||
+      options.generation_conditions.if_not_equal !=
+          merged.options.generation_conditions.if_not_equal) {
+    return false;
+  }
+  // The result of `merged` is only guaranteed to be as recent as its
+  // staleness bound, which is no later than the time it was issued.
+  if (options.staleness_bound >
+      std::min(merged.options.staleness_bound, merged.issue_time)) {
+    return false;
+  }
+  const auto& a = merged.options.byte_range;
+  const auto& b = options.byte_range;
+  if (a.inclusive_min < 0 || b.inclusive_min < 0) {
+    // Suffix length requests are only joined if they are identical.
+    return a == b;
+  }
+  return b.inclusive_min >= a.inclusive_min &&
+         (a.exclusive_max == -1 ||
+          (b.exclusive_max != -1 && b.exclusive_max <= a.exclusive_max));
+}
+
 struct PendingReadEq {
   using is_transparent = void;
 
@@ -196,6 +240,15 @@ class CoalesceKvStoreDriver final : public kvstore::Driver {
   void StartNextRead(internal::IntrusivePtr<PendingRead> state_ptr);
 
  private:
+  // Issues `merged` to the base kvstore.  If `last` is `true`, the next read
+  // of `state_ptr` is started upon completion when not using an interval.
+  void IssueRead(internal::IntrusivePtr<PendingRead> state_ptr,
+                 internal::IntrusivePtr<MergedRead> merged, bool last);
+
+  // Completes the reads satisfied by `merged`.
+  void OnReadComplete(PendingRead& state, MergedRead& merged,
+                      ReadyFuture<kvstore::ReadResult> ready);
+
   kvstore::DriverPtr base_;
   size_t threshold_;
   size_t merged_threshold_;
@@ -215,10 +268,18 @@ Future<kvstore::ReadResult> CoalesceKvStoreDriver::Read(Key key,
     absl::MutexLock l(&mu_);
     auto it = pending_.find(std::string_view(key));
     if (it != pending_.end()) {
-      /// This key is already "reserved" by a PendingRead object, so enqueue
-      /// the read for later.
       auto& state = *it;
       auto op = PromiseFuturePair<ReadResult>::Make();
+      /// If an outstanding request covers this read, share its result.
+      for (const auto& merged : state->in_flight) {
+        if (CanJoin(*merged, options)) {
+          merged->subreads.emplace_back(MergedRead::Entry{
+              std::move(options.byte_range), std::move(op.promise)});
+          return std::move(op.future);
+        }
+      }
+      /// This key is already "reserved" by a PendingRead object, so enqueue
+      /// the read for later.
       state->pending_ops.emplace_back(
           PendingRead::Op{std::move(options), std::move(op.promise)});
       return std::move(op.future);
@@ -252,36 +313,68 @@ Future<kvstore::ReadResult> CoalesceKvStoreDriver::Read(Key key,
   }
 
   // non-interval based trigger
-  auto future = base_->Read(key, std::move(options));
-  future.ExecuteWhenReady(
+  auto merged = internal::MakeIntrusivePtr<MergedRead>();
+  auto op = PromiseFuturePair<ReadResult>::Make();
+  merged->subreads.emplace_back(
+      MergedRead::Entry{options.byte_range, std::move(op.promise)});
+  merged->options = std::move(options);
+  IssueRead(std::move(state_ptr), std::move(merged), /*last=*/true);
+  return std::move(op.future);
+}
+
+void CoalesceKvStoreDriver::IssueRead(
+    internal::IntrusivePtr<PendingRead> state_ptr,
+    internal::IntrusivePtr<MergedRead> merged, bool last) {
+  assert(!merged->subreads.empty());
+  {
+    absl::MutexLock l(&mu_);
+    merged->issue_time = absl::Now();
+    state_ptr->in_flight.push_back(merged);
+  }
+  auto f = base_->Read(state_ptr->key, merged->options);
+  if (!last) {
+    f.ExecuteWhenReady(
+        [self = internal::IntrusivePtr<CoalesceKvStoreDriver>(this),
+         state = std::move(state_ptr),
+         merged = std::move(merged)](ReadyFuture<kvstore::ReadResult> ready) {
+          self->OnReadComplete(*state, *merged, std::move(ready));
+        });
+    return;
+  }
+  // This request will trigger additional reads via StartNextRead.
+  f.ExecuteWhenReady(
       [self = internal::IntrusivePtr<CoalesceKvStoreDriver>(this),
-       state = std::move(state_ptr)](ReadyFuture<ReadResult>) {
+       state = std::move(state_ptr),
+       merged = std::move(merged)](ReadyFuture<kvstore::ReadResult> ready) {
         auto& executor = self->thread_pool_executor_;
-        executor([self = std::move(self), state = std::move(state)] {
-          self->StartNextRead(std::move(state));
+        executor([self = std::move(self), state = std::move(state),
+                  merged = std::move(merged), ready = std::move(ready)] {
+          self->OnReadComplete(*state, *merged, std::move(ready));
+          if (self->interval_ == absl::ZeroDuration()) {
+            self->StartNextRead(std::move(state));
+          }
         });
       });
-
-  return future;
 }
 
-struct MergeValue {
-  kvstore::ReadOptions options;
-
-  struct Entry {
-    OptionalByteRangeRequest byte_range;
-    Promise<kvstore::ReadResult> promise;
-  };
-  std::vector<Entry> subreads;
-};
+void CoalesceKvStoreDriver::OnReadComplete(
+    PendingRead& state, MergedRead& merged,
+    ReadyFuture<kvstore::ReadResult> ready) {
+  std::vector<MergedRead::Entry> subreads;
+  {
+    absl::MutexLock l(&mu_);
+    auto& in_flight = state.in_flight;
+    in_flight.erase(
+        std::find_if(in_flight.begin(), in_flight.end(),
+                     [&](const auto& x) { return x.get() == &merged; }));
+    std::swap(subreads, merged.subreads);
+  }
 
-void OnReadComplete(MergeValue merge_values,
-                    ReadyFuture<kvstore::ReadResult> ready) {
   // If there is no value, or there is a single subread, then forward the
   // ReadResult to all subreads.
   if (!ready.result().ok() || !ready.value().has_value() ||
-      merge_values.subreads.size() == 1) {
-    for (const auto& e : merge_values.subreads) {
+      subreads.size() == 1) {
+    for (const auto& e : subreads) {
       e.promise.SetResult(ready.result());
     }
   } else {
@@ -289,13 +382,13 @@ void OnReadComplete(MergeValue merge_values,
     kvstore::ReadResult result = ready.value();
     absl::Cord value = std::move(result.value);
 
-    for (const auto& e : merge_values.subreads) {
+    for (const auto& e : subreads) {
       size_t request_start, request_size;
       if (e.byte_range.inclusive_min < 0) {
         request_start = value.size() + e.byte_range.inclusive_min;
       } else {
         request_start = e.byte_range.inclusive_min -
-                        merge_values.options.byte_range.inclusive_min;
+                        merged.options.byte_range.inclusive_min;
       }
       if (e.byte_range.exclusive_max == -1) {
         request_size = std::numeric_limits<size_t>::max();
@@ -349,95 +442,69 @@ void CoalesceKvStoreDriver::StartNextRead(
                     b.options.byte_range.exclusive_max);
   });
 
-  kvstore::Key key = state_ptr->key;
-
-  MergeValue merged;
-  const auto& first_pending = pending.front();
-  merged.options = first_pending.options;
+  auto merged = internal::MakeIntrusivePtr<MergedRead>();
+  auto& first_pending = pending.front();
+  merged->options = first_pending.options;
   // Add to queue.
-  merged.subreads.emplace_back(
-      MergeValue::Entry{std::move(first_pending.options.byte_range),
+  merged->subreads.emplace_back(
+      MergedRead::Entry{std::move(first_pending.options.byte_range),
                         std::move(first_pending.promise)});
 
   for (size_t i = 1; i < pending.size(); ++i) {
     auto& e = pending[i];
     if (e.options.generation_conditions.if_equal !=
-            merged.options.generation_conditions.if_equal ||
+            merged->options.generation_conditions.if_equal ||
         e.options.generation_conditions.if_not_equal !=
-            merged.options.generation_conditions.if_not_equal ||
+            merged->options.generation_conditions.if_not_equal ||
         // Don't merge suffix length byte requests with non-suffix-length byte
         // requests.
         (e.options.byte_range.inclusive_min < 0) !=
-            (merged.options.byte_range.inclusive_min < 0)) {
+            (merged->options.byte_range.inclusive_min < 0)) {
       // The options differ from the prior options, so issue the pending
       // request and start another.
-      assert(!merged.subreads.empty());
-      auto f = base_->Read(key, merged.options);
-      f.ExecuteWhenReady(
-          [merged = std::move(merged)](ReadyFuture<kvstore::ReadResult> ready) {
-            OnReadComplete(std::move(merged), std::move(ready));
-          });
-      merged = MergeValue{};
-      merged.options = e.options;
-    } else if (merged.options.byte_range.exclusive_max != -1 &&
+      IssueRead(state_ptr, std::move(merged), /*last=*/false);
+      merged = internal::MakeIntrusivePtr<MergedRead>();
+      merged->options = e.options;
+    } else if (merged->options.byte_range.exclusive_max != -1 &&
                ((e.options.byte_range.inclusive_min -
-                     merged.options.byte_range.exclusive_max >
+                     merged->options.byte_range.exclusive_max >
                  threshold_) ||
                 (merged_threshold_ > 0 &&
-                 merged.options.byte_range.size() > merged_threshold_))) {
+                 merged->options.byte_range.size() > merged_threshold_))) {
       // The distance from the end of the prior read to the beginning of the
       // next read exceeds threshold_ or the total merged_size exceeds
       // merged_threshold_, so issue the pending request and start
       // another.
-      assert(!merged.subreads.empty());
-      auto f = base_->Read(key, merged.options);
-      f.ExecuteWhenReady(
-          [merged = std::move(merged)](ReadyFuture<kvstore::ReadResult> ready) {
-            OnReadComplete(std::move(merged), std::move(ready));
-          });
-      merged = MergeValue{};
-      merged.options = e.options;
+      IssueRead(state_ptr, std::move(merged), /*last=*/false);
+      merged = internal::MakeIntrusivePtr<MergedRead>();
+      merged->options = e.options;
     } else {
       // Pick latest staleness bounds
-      merged.options.staleness_bound =
-          std::max(merged.options.staleness_bound, e.options.staleness_bound);
+      merged->options.staleness_bound =
+          std::max(merged->options.staleness_bound, e.options.staleness_bound);
       // Merge byte_ranges
-      merged.options.byte_range.inclusive_min =
-          std::min(merged.options.byte_range.inclusive_min,
+      merged->options.byte_range.inclusive_min =
+          std::min(merged->options.byte_range.inclusive_min,
                    e.options.byte_range.inclusive_min);
-      if (merged.options.byte_range.exclusive_max != -1) {
+      if (merged->options.byte_range.exclusive_max != -1) {
         if (e.options.byte_range.exclusive_max != -1) {
-          merged.options.byte_range.exclusive_max =
-              std::max(merged.options.byte_range.exclusive_max,
+          merged->options.byte_range.exclusive_max =
+              std::max(merged->options.byte_range.exclusive_max,
                        e.options.byte_range.exclusive_max);
         } else {
-          merged.options.byte_range.exclusive_max = -1;
+          merged->options.byte_range.exclusive_max = -1;
         }
       }
     }
 
     // Add to queue.
-    merged.subreads.emplace_back(MergeValue::Entry{
+    merged->subreads.emplace_back(MergedRead::Entry{
         std::move(e.options.byte_range), std::move(e.promise)});
   }
 
   // Issue final request. This request will trigger additional reads via
   // StartNextRead.
-  assert(!merged.subreads.empty());
-  auto f = base_->Read(key, merged.options);
-  f.ExecuteWhenReady(
-      [self = internal::IntrusivePtr<CoalesceKvStoreDriver>(this),
-       merged = std::move(merged),
-       state = std::move(state_ptr)](ReadyFuture<kvstore::ReadResult> ready) {
-        auto& executor = self->thread_pool_executor_;
-        executor([self = std::move(self), merged = std::move(merged),
-                  state = std::move(state), ready = std::move(ready)] {
-          OnReadComplete(std::move(merged), std::move(ready));
-          if (self->interval_ == absl::ZeroDuration()) {
-            self->StartNextRead(std::move(state));
-          }
-        });
-      });
+  IssueRead(std::move(state_ptr), std::move(merged), /*last=*/true);
 }
 
 }  // namespace
@@ -447,7 +514,7 @@ kvstore::DriverPtr MakeCoalesceKvStoreDriver(kvstore::DriverPtr base,
                                              size_t merged_threshold,
                                              absl::Duration interval,
                                              Executor executor) {
-  ABSL_LOG_IF(INFO, ocdbt_logging)
+  ABSL_LOG_IF(INFO, coalesce_logging)
       << "Coalescing reads with threshold: " << threshold
       << ", merged_threshold: " << merged_threshold
       << ", interval: " << interval;
@@ -456,5 +523,5 @@ kvstore::DriverPtr MakeCoalesceKvStoreDriver(kvstore::DriverPtr base,
       std::move(executor));
 }
 
-}  // namespace internal_ocdbt
+}  // namespace internal_kvstore
 }  // namespace tensorstore
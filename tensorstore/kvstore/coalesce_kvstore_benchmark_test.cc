@@ -0,0 +1,109 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks concurrent byte range reads of a single value from an in-memory
+// kvstore, with and without the read-coalescing adapter.
+//
+// BM_RandomByteRangeReads/<coalesce>/<num_reads>/<read_size>
+//
+// coalesce:
+//   0: Read directly from the memory kvstore.
+//   1: Read through `MakeCoalesceKvStoreDriver`.
+//
+// num_reads:
+//   Number of concurrent reads of non-overlapping ranges at random offsets.
+//
+// read_size:
+//   Size in bytes of each read.
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include "absl/log/absl_check.h"
+#include "absl/random/random.h"
+#include "absl/strings/cord.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/thread/thread_pool.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/driver.h"
+#include "tensorstore/kvstore/memory/memory_key_value_store.h"
+#include "tensorstore/kvstore/coalesce_kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/util/future.h"
+
+namespace {
+
+namespace kvstore = ::tensorstore::kvstore;
+using ::tensorstore::Future;
+using ::tensorstore::OptionalByteRangeRequest;
+using ::tensorstore::internal_kvstore::MakeCoalesceKvStoreDriver;
+
+constexpr int64_t kValueSize = 64 * 1024 * 1024;
+
+void BM_RandomByteRangeReads(benchmark::State& state) {
+  const bool coalesce = state.range(0);
+  const int64_t num_reads = state.range(1);
+  const int64_t read_size = state.range(2);
+
+  kvstore::DriverPtr driver = tensorstore::GetMemoryKeyValueStore();
+  ABSL_CHECK(kvstore::Write(driver, "value",
+                            absl::Cord(std::string(kValueSize, 'x')))
+                 .result()
+                 .ok());
+  if (coalesce) {
+    driver = MakeCoalesceKvStoreDriver(
+        driver, /*threshold=*/1024 * 1024, /*merged_threshold=*/0,
+        /*interval=*/absl::ZeroDuration(),
+        tensorstore::internal::DetachedThreadPool(1));
+  }
+
+  // Non-overlapping slots, of which `num_reads` are chosen at random.
+  const int64_t num_slots = kValueSize / read_size;
+  std::vector<int64_t> slots(num_slots);
+  for (int64_t i = 0; i < num_slots; ++i) slots[i] = i;
+  absl::InsecureBitGen gen;
+
+  std::vector<Future<kvstore::ReadResult>> futures;
+  futures.reserve(num_reads);
+  for (auto s : state) {
+    state.PauseTiming();
+    std::shuffle(slots.begin(), slots.end(), gen);
+    state.ResumeTiming();
+    for (int64_t i = 0; i < num_reads; ++i) {
+      const int64_t start = slots[i] * read_size;
+      kvstore::ReadOptions options;
+      options.byte_range =
+          OptionalByteRangeRequest::Range(start, start + read_size);
+      futures.push_back(kvstore::Read(driver, "value", std::move(options)));
+    }
+    for (auto& future : futures) {
+      ABSL_CHECK(future.result().ok());
+    }
+    futures.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * num_reads);
+  state.SetBytesProcessed(state.iterations() * num_reads * read_size);
+}
+
+BENCHMARK(BM_RandomByteRangeReads)
+    ->ArgsProduct({{0, 1}, {16, 1024}, {4 * 1024, 256 * 1024}})
+    ->UseRealTime();
+
+}  // namespace
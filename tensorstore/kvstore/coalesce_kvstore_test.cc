@@ -12,7 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include "tensorstore/kvstore/ocdbt/io/coalesce_kvstore.h"
+#include "tensorstore/kvstore/coalesce_kvstore.h"
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -31,7 +31,7 @@ namespace kvstore = ::tensorstore::kvstore;
 using ::tensorstore::Context;
 using ::tensorstore::OptionalByteRangeRequest;
 using ::tensorstore::internal::MockKeyValueStore;
-using ::tensorstore::internal_ocdbt::MakeCoalesceKvStoreDriver;
+using ::tensorstore::internal_kvstore::MakeCoalesceKvStoreDriver;
 using ::tensorstore::kvstore::ReadOptions;
 
 TEST(CoalesceKvstoreTest, SimpleRead) {
@@ -264,4 +264,53 @@ TEST(CoalesceKvstoreTest, ReadWithInterval) {
   EXPECT_EQ(read_future4.result().value().value, absl::Cord("7"));
 }
 
+TEST(CoalesceKvstoreTest, ReadJoinsInFlightRead) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto base_store,
+                                   kvstore::Open("memory://").result());
+
+  auto mock_key_value_store = MockKeyValueStore::Make();
+
+  auto coalesce_driver = MakeCoalesceKvStoreDriver(
+      mock_key_value_store, /*threshold=*/1, /*merged_threshold=*/0,
+      /*interval=*/absl::ZeroDuration(),
+      tensorstore::internal::DetachedThreadPool(1));
+
+  TENSORSTORE_ASSERT_OK(
+      kvstore::Write(base_store, "a", absl::Cord("0123456789")));
+
+  ReadOptions ro1, ro2, ro3;
+  ro1.byte_range = OptionalByteRangeRequest(0, 8);
+  // Covered by the in-flight read, and satisfied by data that is already
+  // being fetched.
+  ro2.byte_range = OptionalByteRangeRequest(2, 4);
+  ro2.staleness_bound = absl::InfinitePast();
+  // Requires data more recent than the in-flight read.
+  ro3.byte_range = OptionalByteRangeRequest(2, 4);
+
+  auto read_future1 = kvstore::Read(coalesce_driver, "a", ro1);
+  auto read_future2 = kvstore::Read(coalesce_driver, "a", ro2);
+  auto read_future3 = kvstore::Read(coalesce_driver, "a", ro3);
+
+  {
+    auto req = mock_key_value_store->read_requests.pop();
+    EXPECT_EQ("a", req.key);
+    EXPECT_EQ(req.options.byte_range, ro1.byte_range);
+    req(base_store.driver);
+  }
+  TENSORSTORE_EXPECT_OK(read_future1.result());
+  EXPECT_EQ(read_future1.result().value().value, absl::Cord("01234567"));
+  TENSORSTORE_EXPECT_OK(read_future2.result());
+  EXPECT_EQ(read_future2.result().value().value, absl::Cord("23"));
+
+  {
+    auto req = mock_key_value_store->read_requests.pop();
+    EXPECT_EQ("a", req.key);
+    EXPECT_EQ(req.options.byte_range, ro3.byte_range);
+    req(base_store.driver);
+  }
+  TENSORSTORE_EXPECT_OK(read_future3.result());
+  EXPECT_EQ(read_future3.result().value().value, absl::Cord("23"));
+  EXPECT_TRUE(mock_key_value_store->read_requests.empty());
+}
+
 }  // namespace
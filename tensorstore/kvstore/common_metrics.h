@@ -47,7 +47,7 @@ struct CommonWriteMetrics {
 struct DetailedReadMetrics {
   internal_metrics::Counter<int64_t>& batch_read;
   internal_metrics::Counter<int64_t>& bytes_read;
-  internal_metrics::Histogram<internal_metrics::DefaultBucketer>&
+  internal_metrics::Histogram<internal_metrics::LatencyBucketer>&
       read_latency_ms;
 };
 
@@ -56,7 +56,7 @@ struct DetailedReadMetrics {
 //   /tensorstore/kvstore/driver/write_latency_ms
 struct DetailedWriteMetrics {
   internal_metrics::Counter<int64_t>& bytes_written;
-  internal_metrics::Histogram<internal_metrics::DefaultBucketer>&
+  internal_metrics::Histogram<internal_metrics::LatencyBucketer>&
       write_latency_ms;
 };
 
@@ -92,7 +92,7 @@ struct CommonMetrics : public CommonReadMetrics,
       internal_metrics::MetricMetadata(#KVSTORE " " DESC, ##__VA_ARGS__))
 
 #define TENSORSTORE_KVSTORE_LATENCY_IMPL(KVSTORE, NAME, METRIC_FN)     \
-  internal_metrics::Histogram<internal_metrics::DefaultBucketer>::New( \
+  internal_metrics::Histogram<internal_metrics::LatencyBucketer>::New( \
       "/tensorstore/kvstore/" #KVSTORE "/" #NAME,                      \
       internal_metrics::MetricMetadata(                                \
           #KVSTORE " kvstore::" #METRIC_FN " latency (ms)",            \
@@ -0,0 +1,410 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/// \file
+/// Key-value store adapter that stores each value once, under the SHA-256
+/// digest of its content, in a "blobs" key-value store, and maps each key to
+/// the digest of its value in a base key-value store.
+///
+/// Values written under several keys, or by several datasets sharing the same
+/// blobs key-value store, are stored and uploaded only once.
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/escaping.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "tensorstore/context.h"
+#include "tensorstore/internal/digest/sha256.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/driver.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/registry.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/kvstore/supported_features.h"
+#include "tensorstore/transaction.h"
+#include "tensorstore/util/execution/any_receiver.h"
+#include "tensorstore/util/execution/execution.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/garbage_collection/fwd.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace internal_content_addressed_kvstore {
+namespace {
+
+namespace jb = tensorstore::internal_json_binding;
+
+using ::tensorstore::kvstore::ListOptions;
+using ::tensorstore::kvstore::ListReceiver;
+using ::tensorstore::kvstore::ReadResult;
+using ::tensorstore::kvstore::SupportedFeatures;
+
+/// Length of the lowercase hex SHA-256 digest stored in the base for each key,
+/// which is also the key of the value in the blobs key-value store.
+constexpr size_t kDigestHexLength = 64;
+
+std::string ComputeDigest(const absl::Cord& value) {
+  internal::SHA256Digester digester;
+  digester.Write(value);
+  auto digest = digester.Digest();
+  return absl::BytesToHexString(std::string_view(
+      reinterpret_cast<const char*>(digest.data()), digest.size()));
+}
+
+bool IsValidDigest(std::string_view digest) {
+  return digest.size() == kDigestHexLength &&
+         std::all_of(digest.begin(), digest.end(), [](char c) {
+           return absl::ascii_isdigit(c) || (c >= 'a' && c <= 'f');
+         });
+}
+
+struct ContentAddressedKvStoreSpecData {
+  kvstore::Spec base;
+  kvstore::Spec blobs;
+
+  constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+    return f(x.base, x.blobs);
+  };
+
+  constexpr static auto default_json_binder = jb::Object(
+      jb::Member("base",
+                 jb::Projection<&ContentAddressedKvStoreSpecData::base>()),
+      jb::Member("blobs",
+                 jb::Projection<&ContentAddressedKvStoreSpecData::blobs>()) /**/
+  );
+};
+
+class ContentAddressedKvStoreSpec
+    : public internal_kvstore::RegisteredDriverSpec<
+          ContentAddressedKvStoreSpec, ContentAddressedKvStoreSpecData> {
+ public:
+  static constexpr char id[] = "content_addressed";
+
+  Future<kvstore::DriverPtr> DoOpen() const override;
+
+  absl::Status ApplyOptions(kvstore::DriverSpecOptions&& options) override {
+    TENSORSTORE_RETURN_IF_ERROR(
+        data_.blobs.driver.Set(kvstore::DriverSpecOptions(options)));
+    return data_.base.driver.Set(std::move(options));
+  }
+
+  Result<kvstore::Spec> GetBase(std::string_view path) const override {
+    kvstore::Spec base = data_.base;
+    base.AppendSuffix(path);
+    return base;
+  }
+};
+
+/// Defines the "content_addressed" key-value store adapter.
+class ContentAddressedKvStore
+    : public internal_kvstore::RegisteredDriver<ContentAddressedKvStore,
+                                                ContentAddressedKvStoreSpec> {
+ public:
+  Future<ReadResult> Read(Key key, ReadOptions options) override;
+
+  Future<TimestampedStorageGeneration> Write(Key key,
+                                             std::optional<Value> value,
+                                             WriteOptions options) override;
+
+  Future<const void> DeleteRange(KeyRange range) override;
+
+  void ListImpl(ListOptions options, ListReceiver receiver) override;
+
+  std::string DescribeKey(std::string_view key) override {
+    return base_.driver->DescribeKey(GetBaseKey(key));
+  }
+
+  absl::Status GetBoundSpecData(ContentAddressedKvStoreSpecData& spec) const {
+    TENSORSTORE_ASSIGN_OR_RETURN(spec.base,
+                                 base_.spec(ContextBindingMode::retain));
+    TENSORSTORE_ASSIGN_OR_RETURN(spec.blobs,
+                                 blobs_.spec(ContextBindingMode::retain));
+    return absl::OkStatus();
+  }
+
+  SupportedFeatures GetSupportedFeatures(
+      const KeyRange& key_range) const final {
+    return base_.driver->GetSupportedFeatures(
+        KeyRange::AddPrefix(base_.path, key_range));
+  }
+
+  Result<KvStore> GetBase(std::string_view path,
+                          const Transaction& transaction) const override {
+    return KvStore(base_.driver, GetBaseKey(path), transaction);
+  }
+
+  std::string GetBaseKey(std::string_view key) const {
+    return tensorstore::StrCat(base_.path, key);
+  }
+
+  /// Ensures that `value`, whose digest is `digest`, is present in the blobs
+  /// key-value store.  Values already known to be present, or being stored
+  /// by a concurrent write, are not uploaded again.
+  Future<const void> StoreBlob(std::string digest, absl::Cord value);
+
+  kvstore::KvStore base_;
+  kvstore::KvStore blobs_;
+
+  absl::Mutex mutex_;
+  /// Blobs that are present, or being stored, in the blobs key-value store,
+  /// indexed by digest.  Blobs are never deleted by this adapter, so a blob
+  /// once stored remains present.
+  absl::flat_hash_map<std::string, Future<const void>> blob_futures_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+Future<kvstore::DriverPtr> ContentAddressedKvStoreSpec::DoOpen() const {
+  auto driver = internal::MakeIntrusivePtr<ContentAddressedKvStore>();
+  return MapFutureValue(
+      InlineExecutor{},
+      [driver = std::move(driver)](
+          kvstore::KvStore& base,
+          kvstore::KvStore& blobs) mutable -> kvstore::DriverPtr {
+        driver->base_ = std::move(base);
+        driver->blobs_ = std::move(blobs);
+        driver->SetBatchNestingDepth(
+            std::max(driver->base_.driver->BatchNestingDepth(),
+                     driver->blobs_.driver->BatchNestingDepth()) +
+            1);
+        return driver;
+      },
+      kvstore::Open(data_.base), kvstore::Open(data_.blobs));
+}
+
+Future<const void> ContentAddressedKvStore::StoreBlob(std::string digest,
+                                                      absl::Cord value) {
+  Promise<void> promise;
+  Future<const void> future;
+  {
+    absl::MutexLock lock(&mutex_);
+    auto [it, inserted] = blob_futures_.try_emplace(digest);
+    if (!inserted) return it->second;
+    auto pair = PromiseFuturePair<void>::Make();
+    promise = std::move(pair.promise);
+    future = std::move(pair.future);
+    it->second = future;
+  }
+  // A stat of the blob avoids uploading a value stored by another process;
+  // the conditional write avoids replacing one stored concurrently.
+  kvstore::ReadOptions stat_options;
+  stat_options.byte_range = OptionalByteRangeRequest::Stat();
+  stat_options.staleness_bound = absl::InfinitePast();
+  LinkValue(
+      [self = internal::IntrusivePtr<ContentAddressedKvStore>(this), digest,
+       value = std::move(value)](Promise<void> promise,
+                                 ReadyFuture<ReadResult> stat_future) mutable {
+        if (stat_future.value().has_value()) {
+          promise.SetResult(absl::OkStatus());
+          return;
+        }
+        kvstore::WriteOptions write_options;
+        write_options.generation_conditions.if_equal =
+            StorageGeneration::NoValue();
+        // If the condition fails, the blob was stored concurrently.
+        kvstore::Write(self->blobs_, digest, std::move(value),
+                       std::move(write_options))
+            .ExecuteWhenReady(
+                [promise = std::move(promise)](
+                    ReadyFuture<TimestampedStorageGeneration> future) {
+                  promise.SetResult(future.status());
+                });
+      },
+      std::move(promise),
+      kvstore::Read(blobs_, digest, std::move(stat_options)));
+  future.ExecuteWhenReady(
+      [self = internal::IntrusivePtr<ContentAddressedKvStore>(this),
+       digest = std::move(digest)](ReadyFuture<const void> future) {
+        if (future.status().ok()) return;
+        // Allow a later write to retry.
+        absl::MutexLock lock(&self->mutex_);
+        self->blob_futures_.erase(digest);
+      });
+  return future;
+}
+
+/// State of a `ContentAddressedKvStore::Read` operation.
+struct ReadState : public internal::AtomicReferenceCount<ReadState> {
+  internal::IntrusivePtr<ContentAddressedKvStore> driver;
+  std::string key;
+  OptionalByteRangeRequest byte_range;
+  Batch batch{no_batch};
+  Promise<ReadResult> promise;
+
+  /// Called with the digest of the value of `key` read from the base.
+  void OnIndexRead(ReadResult index_result) {
+    if (!index_result.has_value()) {
+      promise.SetResult(std::move(index_result));
+      return;
+    }
+    std::string digest(index_result.value);
+    if (!IsValidDigest(digest)) {
+      promise.SetResult(absl::DataLossError(tensorstore::StrCat(
+          "Invalid content digest for ", driver->DescribeKey(key))));
+      return;
+    }
+    kvstore::ReadOptions blob_options;
+    blob_options.byte_range = byte_range;
+    // Blobs are immutable.
+    blob_options.staleness_bound = absl::InfinitePast();
+    blob_options.batch = std::move(batch);
+    auto future =
+        kvstore::Read(driver->blobs_, digest, std::move(blob_options));
+    future.ExecuteWhenReady(
+        [self = internal::IntrusivePtr<ReadState>(this),
+         stamp = std::move(index_result.stamp),
+         digest = std::move(digest)](ReadyFuture<ReadResult> future) mutable {
+          self->OnBlobRead(std::move(stamp), digest, future.result());
+        });
+  }
+
+  /// Called with the value read from the blobs key-value store, where
+  /// `stamp` is the generation of the key in the base.
+  void OnBlobRead(TimestampedStorageGeneration stamp, std::string_view digest,
+                  Result<ReadResult>& blob_result) {
+    if (!blob_result.ok()) {
+      promise.SetResult(std::move(blob_result).status());
+      return;
+    }
+    if (!blob_result->has_value()) {
+      promise.SetResult(absl::DataLossError(tensorstore::StrCat(
+          "Content ", digest, " of ", driver->DescribeKey(key),
+          " not found")));
+      return;
+    }
+    promise.SetResult(
+        ReadResult::Value(std::move(blob_result->value), std::move(stamp)));
+  }
+};
+
+Future<ReadResult> ContentAddressedKvStore::Read(Key key,
+                                                 ReadOptions options) {
+  auto state = internal::MakeIntrusivePtr<ReadState>();
+  state->driver.reset(this);
+  state->byte_range = options.byte_range;
+  state->batch = options.batch;
+  kvstore::ReadOptions index_options;
+  index_options.generation_conditions =
+      std::move(options.generation_conditions);
+  index_options.staleness_bound = options.staleness_bound;
+  index_options.batch = std::move(options.batch);
+  auto index_future =
+      base_.driver->Read(GetBaseKey(key), std::move(index_options));
+  state->key = std::move(key);
+  auto [promise, future] = PromiseFuturePair<ReadResult>::Make();
+  state->promise = std::move(promise);
+  index_future.ExecuteWhenReady(
+      [state = std::move(state)](ReadyFuture<ReadResult> index_future) {
+        auto& r = index_future.result();
+        if (!r.ok()) {
+          state->promise.SetResult(r.status());
+          return;
+        }
+        state->OnIndexRead(*std::move(r));
+      });
+  return std::move(future);
+}
+
+Future<TimestampedStorageGeneration> ContentAddressedKvStore::Write(
+    Key key, std::optional<Value> value, WriteOptions options) {
+  if (!value) {
+    return base_.driver->Write(GetBaseKey(key), std::nullopt,
+                               std::move(options));
+  }
+  std::string digest = ComputeDigest(*value);
+  auto blob_future = StoreBlob(digest, *std::move(value));
+  return PromiseFuturePair<TimestampedStorageGeneration>::LinkValue(
+             [self = internal::IntrusivePtr<ContentAddressedKvStore>(this),
+              key = std::move(key), digest = std::move(digest),
+              options = std::move(options)](
+                 Promise<TimestampedStorageGeneration> promise,
+                 ReadyFuture<const void> blob_future) mutable {
+               LinkResult(std::move(promise),
+                          self->base_.driver->Write(
+                              self->GetBaseKey(key),
+                              absl::Cord(std::move(digest)),
+                              std::move(options)));
+             },
+             std::move(blob_future))
+      .future;
+}
+
+Future<const void> ContentAddressedKvStore::DeleteRange(KeyRange range) {
+  // Blobs may be shared with other keys and datasets, and are retained.
+  return base_.driver->DeleteRange(
+      KeyRange::AddPrefix(base_.path, std::move(range)));
+}
+
+/// Forwards the keys listed from the base without their sizes, which are
+/// those of the digests rather than of the values.
+struct ListReceiverWithoutSizes {
+  ListReceiver receiver;
+
+  void set_starting(AnyCancelReceiver cancel) {
+    execution::set_starting(receiver, std::move(cancel));
+  }
+  void set_value(kvstore::ListEntry entry) {
+    entry.size = -1;
+    execution::set_value(receiver, std::move(entry));
+  }
+  void set_error(absl::Status error) {
+    execution::set_error(receiver, std::move(error));
+  }
+  void set_done() { execution::set_done(receiver); }
+  void set_stopping() { execution::set_stopping(receiver); }
+};
+
+void ContentAddressedKvStore::ListImpl(ListOptions options,
+                                       ListReceiver receiver) {
+  options.range = KeyRange::AddPrefix(base_.path, std::move(options.range));
+  options.strip_prefix_length += base_.path.size();
+  base_.driver->ListImpl(std::move(options),
+                         ListReceiverWithoutSizes{std::move(receiver)});
+}
+
+}  // namespace
+}  // namespace internal_content_addressed_kvstore
+}  // namespace tensorstore
+
+TENSORSTORE_DECLARE_GARBAGE_COLLECTION_NOT_REQUIRED(
+    tensorstore::internal_content_addressed_kvstore::ContentAddressedKvStore)
+
+// Registers the driver.
+namespace {
+const tensorstore::internal_kvstore::DriverRegistration<
+    tensorstore::internal_content_addressed_kvstore::
+        ContentAddressedKvStoreSpec>
+    registration;
+}  // namespace
@@ -0,0 +1,188 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/internal/global_initializer.h"
+#include "tensorstore/internal/testing/json_gtest.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/mock_kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/kvstore/test_matchers.h"
+#include "tensorstore/kvstore/test_util.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+namespace kvstore = ::tensorstore::kvstore;
+
+using ::tensorstore::Context;
+using ::tensorstore::JsonSubValueMatches;
+using ::tensorstore::OptionalByteRangeRequest;
+using ::tensorstore::Result;
+using ::tensorstore::StatusIs;
+using ::tensorstore::StorageGeneration;
+using ::tensorstore::internal::KeyValueStoreOpsTestParameters;
+using ::tensorstore::internal::MatchesKvsReadResult;
+using ::tensorstore::internal::MatchesKvsReadResultNotFound;
+using ::tensorstore::internal::MatchesListEntry;
+using ::tensorstore::internal::MockKeyValueStore;
+using ::tensorstore::internal::MockKeyValueStoreResource;
+using ::tensorstore::kvstore::KvStore;
+using ::testing::_;
+
+// SHA-256 digest of "abc".
+constexpr char kAbcDigest[] =
+    "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad";
+
+TENSORSTORE_GLOBAL_INITIALIZER {
+  KeyValueStoreOpsTestParameters params;
+  params.test_name = "Basic";
+  params.get_store = [](auto callback) {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto store,
+        kvstore::Open({{"driver", "content_addressed"},
+                       {"base", {{"driver", "memory"}, {"path", "base/"}}},
+                       {"blobs", {{"driver", "memory"}, {"path", "blobs/"}}}})
+            .result());
+    callback(store);
+  };
+  RegisterKeyValueStoreOpsTests(params);
+}
+
+/// Opens "content_addressed" adapters over a "memory" base, with the blobs
+/// stored in a logged mock key-value store shared through `context_`.
+class ContentAddressedKvStoreTest : public ::testing::Test {
+ public:
+  ContentAddressedKvStoreTest() : context_(Context::Default()) {
+    // The blobs are stored in a separate context so that they do not share
+    // the memory key-value store used as the base.
+    blobs_ =
+        kvstore::Open({{"driver", "memory"}}, Context::Default()).value();
+    mock_store_ =
+        context_.GetResource<MockKeyValueStoreResource>().value()->get();
+    mock_store_->forward_to = blobs_.driver;
+    mock_store_->log_requests = true;
+  }
+
+  Result<KvStore> OpenStore(std::string base_path) {
+    return kvstore::Open(
+               {{"driver", "content_addressed"},
+                {"base", {{"driver", "memory"}, {"path", base_path}}},
+                {"blobs", {{"driver", "mock_key_value_store"}}}},
+               context_)
+        .result();
+  }
+
+  Context context_;
+  KvStore blobs_;
+  MockKeyValueStore* mock_store_;
+};
+
+TEST_F(ContentAddressedKvStoreTest, WriteStoresDigest) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenStore("v1/"));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto stamp, kvstore::Write(store, "a", absl::Cord("abc")).result());
+  EXPECT_THAT(mock_store_->request_log.pop_all(),
+              ::testing::ElementsAre(
+                  ::testing::AllOf(JsonSubValueMatches("/type", "read"),
+                                   JsonSubValueMatches("/key", kAbcDigest),
+                                   JsonSubValueMatches(
+                                       "/byte_range_exclusive_max", 0)),
+                  ::testing::AllOf(JsonSubValueMatches("/type", "write"),
+                                   JsonSubValueMatches("/key", kAbcDigest),
+                                   JsonSubValueMatches(
+                                       "/if_equal",
+                                       StorageGeneration::NoValue().value))));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto base, store.base());
+  EXPECT_THAT(kvstore::Read(base, "a").result(),
+              MatchesKvsReadResult(absl::Cord(kAbcDigest), stamp.generation));
+  EXPECT_THAT(kvstore::Read(store, "a").result(),
+              MatchesKvsReadResult(absl::Cord("abc"), stamp.generation));
+
+  OptionalByteRangeRequest byte_range = OptionalByteRangeRequest::Range(1, 2);
+  kvstore::ReadOptions options;
+  options.byte_range = byte_range;
+  EXPECT_THAT(kvstore::Read(store, "a", options).result(),
+              MatchesKvsReadResult(absl::Cord("b")));
+}
+
+TEST_F(ContentAddressedKvStoreTest, DuplicateValuesUploadedOnce) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenStore("v1/"));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("abc")));
+  mock_store_->request_log.pop_all();
+
+  // The same value under another key is not stored again.
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "b", absl::Cord("abc")));
+  EXPECT_THAT(mock_store_->request_log.pop_all(), ::testing::IsEmpty());
+
+  // Another dataset sharing the blobs only checks that the value is present.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store2, OpenStore("v2/"));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store2, "a", absl::Cord("abc")));
+  EXPECT_THAT(mock_store_->request_log.pop_all(),
+              ::testing::ElementsAre(::testing::AllOf(
+                  JsonSubValueMatches("/type", "read"),
+                  JsonSubValueMatches("/key", kAbcDigest))));
+  EXPECT_THAT(kvstore::Read(store2, "a").result(),
+              MatchesKvsReadResult(absl::Cord("abc")));
+  EXPECT_THAT(kvstore::ListFuture(blobs_).result(),
+              ::testing::Optional(
+                  ::testing::ElementsAre(MatchesListEntry(kAbcDigest, _))));
+}
+
+TEST_F(ContentAddressedKvStoreTest, DeleteRetainsBlobs) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenStore("v1/"));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("abc")));
+  TENSORSTORE_ASSERT_OK(kvstore::Delete(store, "a"));
+  EXPECT_THAT(kvstore::Read(store, "a").result(),
+              MatchesKvsReadResultNotFound());
+  EXPECT_THAT(kvstore::ListFuture(blobs_).result(),
+              ::testing::Optional(
+                  ::testing::ElementsAre(MatchesListEntry(kAbcDigest, _))));
+}
+
+TEST_F(ContentAddressedKvStoreTest, MissingBlob) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenStore("v1/"));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("abc")));
+  TENSORSTORE_ASSERT_OK(kvstore::Delete(blobs_, kAbcDigest));
+  EXPECT_THAT(kvstore::Read(store, "a").result(),
+              StatusIs(absl::StatusCode::kDataLoss));
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto base, store.base());
+  TENSORSTORE_ASSERT_OK(kvstore::Write(base, "b", absl::Cord("xyz")));
+  EXPECT_THAT(kvstore::Read(store, "b").result(),
+              StatusIs(absl::StatusCode::kDataLoss));
+}
+
+TEST(ContentAddressedKvStoreSpecTest, SpecRoundtrip) {
+  tensorstore::internal::KeyValueStoreSpecRoundtripOptions options;
+  options.full_base_spec = {{"driver", "memory"}, {"path", "base/"}};
+  options.full_spec = {{"driver", "content_addressed"},
+                       {"base", options.full_base_spec},
+                       {"blobs", {{"driver", "memory"}, {"path", "blobs/"}}}};
+  options.check_data_after_serialization = false;
+  tensorstore::internal::TestKeyValueStoreSpecRoundtrip(options);
+}
+
+}  // namespace
@@ -80,24 +80,37 @@
 /// 8. `fsync` the parent directory of the file (to ensure the `unlink` or
 ///    `rename` operations are durable).  This step is skipped on MS Windows,
 ///    where `fsync` is not supported for directories.
+///
+/// When `file_io_sync` is enabled, step 6b uses `fdatasync`, and the lock
+/// file of each write is synced concurrently with other writes (for example,
+/// the writes issued by a transaction commit).  The directory `fsync` of step
+/// 8 is shared between concurrent writes to the same directory ("group
+/// commit"): each write waits for an `fsync` of its parent directory that
+/// started after its own `rename` or `unlink`, so each write is still durable
+/// once it completes.
 
 #include <stddef.h>
 #include <stdint.h>
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <cassert>
 #include <limits>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>  // NOLINT
 #include <tuple>  // IWYU pragma: keep for std::get<>
 #include <type_traits>
 #include <utility>
 
 #include "absl/base/attributes.h"
+#include "absl/base/no_destructor.h"
 #include "absl/base/optimization.h"
 #include "absl/functional/function_ref.h"
+#include "absl/hash/hash.h"
 #include "absl/log/absl_check.h"  // IWYU pragma: keep
 #include "absl/log/absl_log.h"
 #include "absl/random/random.h"
@@ -105,11 +118,13 @@
 #include "absl/strings/cord.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "tensorstore/batch.h"
 #include "tensorstore/context.h"
 #include "tensorstore/internal/file_io_concurrency_resource.h"
+#include "tensorstore/internal/flat_cord_builder.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json_binding/bindable.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
@@ -118,6 +133,8 @@
 #include "tensorstore/internal/os/error_code.h"
 #include "tensorstore/internal/os/file_descriptor.h"
 #include "tensorstore/internal/os/file_info.h"
+#include "tensorstore/internal/os/io_uring.h"
+#include "tensorstore/internal/os/memory_region.h"
 #include "tensorstore/internal/os/unique_handle.h"
 #include "tensorstore/internal/path.h"
 #include "tensorstore/internal/uri_utils.h"
@@ -125,6 +142,7 @@
 #include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/common_metrics.h"
 #include "tensorstore/kvstore/file/file_resource.h"
+#include "tensorstore/kvstore/file/fsync_group.h"
 #include "tensorstore/kvstore/file/util.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/key_range.h"
@@ -158,6 +176,8 @@
 /// `MapFuture`.
 
 using ::tensorstore::internal::OsErrorCode;
+using ::tensorstore::internal_file_util::FsyncGroup;
+using ::tensorstore::internal_file_util::GetDirectReadRange;
 using ::tensorstore::internal_file_util::IsKeyValid;
 using ::tensorstore::internal_file_util::LongestDirectoryPrefix;
 using ::tensorstore::internal_file_util::OpenParentDirectory;
@@ -209,11 +229,15 @@ struct FileKeyValueStoreSpecData {
   Context::Resource<internal::FileIoConcurrencyResource> file_io_concurrency;
   Context::Resource<FileIoSyncResource> file_io_sync;
   Context::Resource<FileIoMemmapResource> file_io_memmap;
+  Context::Resource<FileIoDirectResource> file_io_direct;
+  Context::Resource<FileIoCoalescingResource> file_io_coalescing;
   Context::Resource<FileIoLockingResource> file_io_locking;
+  Context::Resource<FileIoEngineResource> file_io_engine;
 
   constexpr static auto ApplyMembers = [](auto& x, auto f) {
     return f(x.file_io_concurrency, x.file_io_sync, x.file_io_memmap,
-             x.file_io_locking);
+             x.file_io_direct, x.file_io_coalescing, x.file_io_locking,
+             x.file_io_engine);
   };
 
   // TODO(jbms): Storing a UNIX path as a JSON string presents a challenge
@@ -239,8 +263,15 @@ struct FileKeyValueStoreSpecData {
                  jb::Projection<&FileKeyValueStoreSpecData::file_io_sync>()),
       jb::Member(FileIoMemmapResource::id,
                  jb::Projection<&FileKeyValueStoreSpecData::file_io_memmap>()),
+      jb::Member(FileIoDirectResource::id,
+                 jb::Projection<&FileKeyValueStoreSpecData::file_io_direct>()),
+      jb::Member(
+          FileIoCoalescingResource::id,
+          jb::Projection<&FileKeyValueStoreSpecData::file_io_coalescing>()),
       jb::Member(FileIoLockingResource::id,
-                 jb::Projection<&FileKeyValueStoreSpecData::file_io_locking>())
+                 jb::Projection<&FileKeyValueStoreSpecData::file_io_locking>()),
+      jb::Member(FileIoEngineResource::id,
+                 jb::Projection<&FileKeyValueStoreSpecData::file_io_engine>())
       //
   );
 };
@@ -300,6 +331,30 @@ class FileKeyValueStore
 
   bool sync() const { return *spec_.file_io_sync; }
   bool memmap() const { return *spec_.file_io_memmap; }
+  bool direct() const { return *spec_.file_io_direct; }
+
+  /// Returns the options with which the byte ranges of a batch of reads of
+  /// one file are merged.
+  internal_kvstore_batch::CoalescingOptions coalescing_options() const {
+    const auto& spec = *spec_.file_io_coalescing;
+    internal_kvstore_batch::CoalescingOptions options;
+    options.max_extra_read_bytes = spec.max_extra_read_bytes;
+    options.target_coalesced_size = spec.target_coalesced_size;
+    return options;
+  }
+
+  /// Returns the maximum number of directories to list concurrently, which is
+  /// the number of `file_io_concurrency` threads.
+  size_t list_parallelism() const {
+    return spec_.file_io_concurrency->spec.limit.value_or(
+        std::max(size_t(4), size_t(std::thread::hardware_concurrency())));
+  }
+
+  /// Returns the io_uring with which to read files, or `nullptr` to read on
+  /// the `file_io_concurrency` executor.
+  internal_os::IoUring* io_uring() const {
+    return spec_.file_io_engine->io_uring.get();
+  }
 
   FileIoLockingResource::Spec file_io_locking() const {
     return *spec_.file_io_locking;
@@ -330,10 +385,24 @@ StorageGeneration GetFileGeneration(const FileInfo& info) {
 
 /// ----------------------------------------------------------------------------
 
+/// Opens the file at `path` for reading.
+///
+/// If `direct` is non-null and `*direct` is `true`, the file is opened with
+/// `OpenFlags::Direct`.  If the file system does not support that, the file is
+/// opened normally and `*direct` is set to `false`.
 Result<UniqueFileDescriptor> OpenValueFile(const std::string& path,
                                            StorageGeneration* generation,
-                                           int64_t* size = nullptr) {
-  auto fd = internal_os::OpenFileWrapper(path, OpenFlags::DefaultRead);
+                                           int64_t* size = nullptr,
+                                           bool* direct = nullptr) {
+  Result<UniqueFileDescriptor> fd;
+  if (direct && *direct) {
+    fd = internal_os::OpenFileWrapper(
+        path, OpenFlags::DefaultRead | OpenFlags::Direct);
+    if (absl::IsInvalidArgument(fd.status())) *direct = false;
+  }
+  if (!direct || !*direct) {
+    fd = internal_os::OpenFileWrapper(path, OpenFlags::DefaultRead);
+  }
   if (!fd.ok()) {
     // Map not found to a missing value.
     if (absl::IsNotFound(fd.status())) {
@@ -368,6 +437,8 @@ class BatchReadTask final
   TimestampedStorageGeneration stamp_;
   UniqueFileDescriptor fd_;
   int64_t size_;
+  // Whether `fd_` was opened with `OpenFlags::Direct`.
+  bool direct_;
 
  public:
   BatchReadTask(BatchEntryKey&& batch_entry_key_)
@@ -388,14 +459,14 @@ class BatchReadTask final
     file_metrics.batch_read.Increment();
     absl::Time start_time = absl::Now();
 
-    auto read_result = ReadFromFileDescriptor(fd_.get(), byte_range);
+    auto read_result = ReadFromFileDescriptor(fd_.get(), byte_range, direct_);
     if (!read_result.ok()) {
       return tensorstore::MaybeAnnotateStatus(std::move(read_result).status(),
                                               "Error reading from open file");
     }
     file_metrics.bytes_read.IncrementBy(read_result->size());
     file_metrics.read_latency_ms.Observe(
-        absl::ToInt64Milliseconds(absl::Now() - start_time));
+        absl::ToDoubleMilliseconds(absl::Now() - start_time));
 
     return kvstore::ReadResult::Value(std::move(read_result).value(), stamp_);
   }
@@ -407,10 +478,11 @@ class BatchReadTask final
     stamp_.time = absl::Now();
     file_metrics.open_read.Increment();
     auto& requests = request_batch.requests;
+    direct_ = driver().direct();
     TENSORSTORE_ASSIGN_OR_RETURN(
         fd_,
         OpenValueFile(std::get<std::string>(batch_entry_key),
-                      &stamp_.generation, &size_),
+                      &stamp_.generation, &size_, &direct_),
         internal_kvstore_batch::SetCommonResult(requests, std::move(_)));
     if (!fd_.valid()) {
       internal_kvstore_batch::SetCommonResult(
@@ -423,7 +495,9 @@ class BatchReadTask final
 
     if (requests.empty()) return;
 
-    if (driver().memmap()) {
+    // Unbuffered reads take precedence, as mapping the file would read it
+    // through the page cache.
+    if (driver().memmap() && !direct_) {
       // Extract the bounds for all requests.
       int64_t exclusive_max = 0;
       int64_t inclusive_min = std::numeric_limits<int64_t>::max();
@@ -470,6 +544,23 @@ class BatchReadTask final
       // Otherwise, fall back to the ::read path.
     }
 
+    const auto coalescing_options = driver().coalescing_options();
+
+    if (auto* io_uring = driver().io_uring()) {
+      // Queue all of the reads, then pass them to the kernel in one
+      // submission.
+      internal_kvstore_batch::ForEachCoalescedRequest<Request>(
+          requests, coalescing_options,
+          [&](ByteRange coalesced_byte_range,
+              tensorstore::span<Request> coalesced_requests) {
+            file_metrics.batch_read.Increment();
+            ContinueIoUringRead(std::make_unique<IoUringRead>(
+                coalesced_byte_range, coalesced_requests, direct_));
+          });
+      io_uring->Submit();
+      return;
+    }
+
     if (requests.size() == 1) {
       auto& byte_range_request =
           std::get<internal_kvstore_batch::ByteRangeReadRequest>(requests[0]);
@@ -482,19 +573,23 @@ class BatchReadTask final
 
     const auto& executor = driver().executor();
 
-    internal_kvstore_batch::CoalescingOptions coalescing_options;
-    coalescing_options.max_extra_read_bytes = 255;
+    // Each coalesced read except the last is submitted to `executor`; the last
+    // is performed on this thread, which is already a `file_io_concurrency`
+    // thread, to avoid a thread hop.
+    std::optional<std::pair<ByteRange, tensorstore::span<Request>>> last;
     internal_kvstore_batch::ForEachCoalescedRequest<Request>(
         requests, coalescing_options,
         [&](ByteRange coalesced_byte_range,
             tensorstore::span<Request> coalesced_requests) {
-          auto self = internal::IntrusivePtr<BatchReadTask>(this);
-          executor([self = std::move(self), coalesced_byte_range,
-                    coalesced_requests] {
-            self->ProcessCoalescedRead(coalesced_byte_range,
-                                       coalesced_requests);
-          });
+          if (last) {
+            auto self = internal::IntrusivePtr<BatchReadTask>(this);
+            executor([self = std::move(self), read = *last] {
+              self->ProcessCoalescedRead(read.first, read.second);
+            });
+          }
+          last.emplace(coalesced_byte_range, coalesced_requests);
         });
+    if (last) ProcessCoalescedRead(last->first, last->second);
   }
 
   void ProcessCoalescedRead(ByteRange coalesced_byte_range,
@@ -506,6 +601,88 @@ class BatchReadTask final
     internal_kvstore_batch::ResolveCoalescedRequests(
         coalesced_byte_range, coalesced_requests, std::move(read_result));
   }
+
+  // State of a coalesced read issued to `FileKeyValueStore::io_uring`.
+  struct IoUringRead {
+    IoUringRead(ByteRange byte_range, tensorstore::span<Request> requests,
+                bool direct)
+        : byte_range(byte_range),
+          read_range(direct ? GetDirectReadRange(byte_range) : byte_range),
+          requests(requests),
+          buffer(direct ? internal::FlatCordBuilder(
+                              internal_os::AllocateAlignedHeapRegion(
+                                  read_range.size()),
+                              0)
+                        : internal::FlatCordBuilder(byte_range.size(), 0)),
+          start_time(absl::Now()) {}
+
+    // Returns the number of bytes read so far.
+    size_t bytes_read() const { return buffer.size() - buffer.available(); }
+
+    // Whether all requested bytes have been read.  The file may end before
+    // the aligned end of `read_range`.
+    bool done() const {
+      return read_range.inclusive_min + static_cast<int64_t>(bytes_read()) >=
+             byte_range.exclusive_max;
+    }
+
+    ByteRange byte_range;
+    // Range actually read, which is widened to satisfy `OpenFlags::Direct`.
+    ByteRange read_range;
+    tensorstore::span<Request> requests;
+    internal::FlatCordBuilder buffer;
+    absl::Time start_time;
+  };
+
+  // Queues a read of the remainder of `read`, or resolves its requests if it
+  // is complete.
+  void ContinueIoUringRead(std::unique_ptr<IoUringRead> read) {
+    if (read->done()) {
+      file_metrics.bytes_read.IncrementBy(read->byte_range.size());
+      file_metrics.read_latency_ms.Observe(
+          absl::ToDoubleMilliseconds(absl::Now() - read->start_time));
+      absl::Cord value = std::move(read->buffer).Build().Subcord(
+          read->byte_range.inclusive_min - read->read_range.inclusive_min,
+          read->byte_range.size());
+      internal_kvstore_batch::ResolveCoalescedRequests(
+          read->byte_range, read->requests,
+          kvstore::ReadResult::Value(std::move(value), stamp_));
+      return;
+    }
+    const auto buffer = read->buffer.available_span();
+    const int64_t offset = read->read_range.inclusive_min + read->bytes_read();
+    driver().io_uring()->Read(
+        fd_.get(), buffer, offset,
+        [self = internal::IntrusivePtr<BatchReadTask>(this),
+         read = std::move(read)](Result<size_t> n) mutable {
+          // Completions run on the io_uring thread, which must not block.
+          auto& executor = self->driver().executor();
+          executor([self = std::move(self), read = std::move(read),
+                    n = std::move(n)]() mutable {
+            self->OnIoUringRead(std::move(read), std::move(n));
+          });
+        });
+  }
+
+  void OnIoUringRead(std::unique_ptr<IoUringRead> read, Result<size_t> n) {
+    if (!n.ok()) {
+      internal_kvstore_batch::SetCommonResult(
+          read->requests,
+          tensorstore::MaybeAnnotateStatus(std::move(n).status(),
+                                           "Error reading from open file"));
+      return;
+    }
+    if (*n == 0) {
+      internal_kvstore_batch::SetCommonResult(
+          read->requests,
+          absl::UnavailableError("Length changed while reading"));
+      return;
+    }
+    read->buffer.set_inuse(read->bytes_read() + *n);
+    // A short read requires another submission for the remainder.
+    ContinueIoUringRead(std::move(read));
+    driver().io_uring()->Submit();
+  }
 };
 
 Future<ReadResult> FileKeyValueStore::Read(Key key, ReadOptions options) {
@@ -535,13 +712,36 @@ absl::Status WriteWithSync(FileDescriptor fd, const std::string& fd_path,
     value.RemovePrefix(n);
   }
   if (sync) {
-    TENSORSTORE_RETURN_IF_ERROR(internal_os::FsyncFile(fd));
+    // The directory entry is made durable separately by `SyncParentDirectory`.
+    TENSORSTORE_RETURN_IF_ERROR(internal_os::DataSyncFile(fd));
   }
   file_metrics.write_latency_ms.Observe(
-      absl::ToInt64Milliseconds(absl::Now() - start_write));
+      absl::ToDoubleMilliseconds(absl::Now() - start_write));
   return absl::OkStatus();
 }
 
+/// Ensures that a prior `rename` or `unlink` of `full_path` is durable by
+/// `fsync`ing its parent directory, `dir_fd`, once for all concurrent callers
+/// with the same parent directory.
+absl::Status SyncParentDirectory(const std::string& full_path,
+                                 FileDescriptor dir_fd) {
+  static absl::NoDestructor<FsyncGroup> fsync_group;
+  return MaybeAnnotateStatus(
+      fsync_group->Sync(internal::PathDirnameBasename(full_path).first,
+                        [&] { return internal_os::FsyncDirectory(dir_fd); }),
+      absl::StrCat("Error calling fsync on parent directory of: ",
+                   QuoteString(full_path)));
+}
+
+/// Returns the mutex that serializes writes and deletes of `full_path` within
+/// the process in the `single_writer` locking mode.  Unrelated paths may share
+/// a mutex.
+absl::Mutex& GetSingleWriterMutex(std::string_view full_path) {
+  constexpr size_t kNumMutexes = 256;
+  static absl::NoDestructor<std::array<absl::Mutex, kNumMutexes>> mutexes;
+  return (*mutexes)[absl::Hash<std::string_view>{}(full_path) % kNumMutexes];
+}
+
 /// Implements `FileKeyValueStore::Write`.
 struct WriteTask {
   std::string full_path;
@@ -556,10 +756,17 @@ struct WriteTask {
     r.time = absl::Now();
     TENSORSTORE_ASSIGN_OR_RETURN(auto dir_fd, OpenParentDirectory(full_path));
 
+    std::optional<absl::MutexLock> single_writer_lock;
+    if (file_io_locking.mode ==
+        FileIoLockingResource::LockingMode::single_writer) {
+      single_writer_lock.emplace(&GetSingleWriterMutex(full_path));
+    }
+
     TENSORSTORE_ASSIGN_OR_RETURN(
         auto lock_helper, [&]() -> Result<internal_os::FileLock> {
           switch (file_io_locking.mode) {
-            case FileIoLockingResource::LockingMode::none: {
+            case FileIoLockingResource::LockingMode::none:
+            case FileIoLockingResource::LockingMode::single_writer: {
               // This will generate a unique "lock" file without waiting or
               // attempting to cleanup.
               absl::InsecureBitGen rng;
@@ -605,10 +812,7 @@ struct WriteTask {
       if (sync) {
         // fsync the parent directory to ensure the `rename` is durable.
         TENSORSTORE_RETURN_IF_ERROR(
-            internal_os::FsyncDirectory(dir_fd.get()),
-            MaybeAnnotateStatus(
-                _, absl::StrCat("Error calling fsync on parent directory of: ",
-                                full_path)));
+            SyncParentDirectory(full_path, dir_fd.get()));
       }
       return absl::OkStatus();
     }();
@@ -647,8 +851,13 @@ struct DeleteTask {
 
     TENSORSTORE_ASSIGN_OR_RETURN(auto dir_fd, OpenParentDirectory(full_path));
 
+    std::optional<absl::MutexLock> single_writer_lock;
     std::optional<internal_os::FileLock> lock_helper;
-    if (file_io_locking.mode == FileIoLockingResource::LockingMode::lockfile) {
+    if (file_io_locking.mode ==
+        FileIoLockingResource::LockingMode::single_writer) {
+      single_writer_lock.emplace(&GetSingleWriterMutex(full_path));
+    } else if (file_io_locking.mode ==
+               FileIoLockingResource::LockingMode::lockfile) {
       TENSORSTORE_ASSIGN_OR_RETURN(
           lock_helper,
           AcquireExclusiveFile(absl::StrCat(full_path, kLockSuffix),
@@ -686,10 +895,7 @@ struct DeleteTask {
     // fsync the parent directory to ensure the `rename` is durable.
     if (fsync_directory) {
       TENSORSTORE_RETURN_IF_ERROR(
-          internal_os::FsyncDirectory(dir_fd.get()),
-          MaybeAnnotateStatus(
-              _, absl::StrCat("Error calling fsync on parent directory of: ",
-                              QuoteString(full_path))));
+          SyncParentDirectory(full_path, dir_fd.get()));
     }
     if (!generation_result) {
       return std::move(generation_result).status();
@@ -772,6 +978,9 @@ Future<const void> FileKeyValueStore::DeleteRange(KeyRange range) {
 struct ListTask {
   kvstore::ListOptions options;
   ListReceiver receiver;
+  Executor executor;
+  // Maximum number of directories listed concurrently.
+  size_t parallelism;
 
   void operator()() {
     ABSL_LOG_IF(INFO, verbose_logging) << "ListTask " << options.range;
@@ -781,8 +990,11 @@ struct ListTask {
     });
     std::string prefix(
         internal_file_util::LongestDirectoryPrefix(options.range));
-    auto status = internal_os::RecursiveFileList(
-        prefix,
+    // Subdirectories are listed concurrently, so entries are delivered in no
+    // particular order.
+    absl::Mutex receiver_mutex;
+    auto status = internal_os::ParallelFileList(
+        prefix, executor, parallelism,
         [&](std::string_view path) {
           return tensorstore::IntersectsPrefix(options.range, path);
         },
@@ -790,11 +1002,11 @@ struct ListTask {
           if (cancelled.load(std::memory_order_relaxed)) {
             return absl::CancelledError("");
           }
-          if (entry.IsDirectory()) return absl::OkStatus();
           std::string_view path = entry.GetFullPath();
           if (tensorstore::Contains(options.range, path) &&
               !absl::EndsWith(path, kLockSuffix)) {
             path.remove_prefix(options.strip_prefix_length);
+            absl::MutexLock lock(&receiver_mutex);
             execution::set_value(receiver,
                                  ListEntry{std::string(path), entry.GetSize()});
           }
@@ -824,7 +1036,8 @@ void FileKeyValueStore::ListImpl(ListOptions options, ListReceiver receiver) {
     execution::set_stopping(receiver);
     return;
   }
-  executor()(ListTask{std::move(options), std::move(receiver)});
+  executor()(ListTask{std::move(options), std::move(receiver), executor(),
+                      list_parallelism()});
 }
 
 Future<kvstore::DriverPtr> FileKeyValueStoreSpec::DoOpen() const {
@@ -833,12 +1046,8 @@ Future<kvstore::DriverPtr> FileKeyValueStoreSpec::DoOpen() const {
   return driver_ptr;
 }
 
-Result<kvstore::Spec> ParseFileUrl(std::string_view url) {
-  auto parsed = internal::ParseGenericUri(url);
-  TENSORSTORE_RETURN_IF_ERROR(internal::EnsureSchemaWithAuthorityDelimiter(
-      parsed, FileKeyValueStoreSpec::id));
-  TENSORSTORE_RETURN_IF_ERROR(internal::EnsureNoQueryOrFragment(parsed));
-  std::string path = internal::PercentDecode(parsed.authority_and_path);
+/// Returns a spec with default context resources.
+internal::IntrusivePtr<FileKeyValueStoreSpec> MakeDefaultFileSpec() {
   auto driver_spec = internal::MakeIntrusivePtr<FileKeyValueStoreSpec>();
   driver_spec->data_.file_io_concurrency =
       Context::Resource<internal::FileIoConcurrencyResource>::DefaultSpec();
@@ -846,10 +1055,61 @@ Result<kvstore::Spec> ParseFileUrl(std::string_view url) {
       Context::Resource<FileIoSyncResource>::DefaultSpec();
   driver_spec->data_.file_io_memmap =
       Context::Resource<FileIoMemmapResource>::DefaultSpec();
+  driver_spec->data_.file_io_direct =
+      Context::Resource<FileIoDirectResource>::DefaultSpec();
+  driver_spec->data_.file_io_coalescing =
+      Context::Resource<FileIoCoalescingResource>::DefaultSpec();
   driver_spec->data_.file_io_locking =
       Context::Resource<FileIoLockingResource>::DefaultSpec();
+  driver_spec->data_.file_io_engine =
+      Context::Resource<FileIoEngineResource>::DefaultSpec();
+  return driver_spec;
+}
+
+Result<kvstore::Spec> ParseFileUrl(std::string_view url) {
+  auto parsed = internal::ParseGenericUri(url);
+  TENSORSTORE_RETURN_IF_ERROR(internal::EnsureSchemaWithAuthorityDelimiter(
+      parsed, FileKeyValueStoreSpec::id));
+  TENSORSTORE_RETURN_IF_ERROR(internal::EnsureNoQueryOrFragment(parsed));
+  std::string path = internal::PercentDecode(parsed.authority_and_path);
+  return {std::in_place, MakeDefaultFileSpec(), std::move(path)};
+}
 
-  return {std::in_place, std::move(driver_spec), std::move(path)};
+/// Parses a `shm://{name}/{path}` URL.
+///
+/// Shared-memory stores are `file` stores under a directory of a
+/// memory-backed filesystem, read with memory-mapped I/O.  Multiple processes
+/// on the same machine that open the same `name` share a single copy of the
+/// data, and reads return `absl::Cord`s that alias the mapping.  The
+/// directory index of the filesystem serves as the (kernel-synchronized)
+/// index of keys.
+Result<kvstore::Spec> ParseShmUrl(std::string_view url) {
+  auto parsed = internal::ParseGenericUri(url);
+  TENSORSTORE_RETURN_IF_ERROR(
+      internal::EnsureSchemaWithAuthorityDelimiter(parsed, "shm"));
+  TENSORSTORE_RETURN_IF_ERROR(internal::EnsureNoQueryOrFragment(parsed));
+#if !defined(__linux__)
+  return absl::UnimplementedError(
+      "\"shm://\" URLs are only supported on Linux");
+#else
+  constexpr std::string_view kShmRoot = "/dev/shm/tensorstore/";
+  std::string name_and_path =
+      internal::PercentDecode(parsed.authority_and_path);
+  if (name_and_path.empty() || name_and_path[0] == '/') {
+    return absl::InvalidArgumentError(
+        "\"shm://\" URL must specify a store name");
+  }
+  auto driver_spec = MakeDefaultFileSpec();
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      driver_spec->data_.file_io_memmap,
+      Context::Resource<FileIoMemmapResource>::FromJson(true));
+  // The data does not outlive the machine, so durability is not required.
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      driver_spec->data_.file_io_sync,
+      Context::Resource<FileIoSyncResource>::FromJson(false));
+  return {std::in_place, std::move(driver_spec),
+          absl::StrCat(kShmRoot, name_and_path)};
+#endif
 }
 
 }  // namespace
@@ -870,4 +1130,8 @@ const tensorstore::internal_kvstore::UrlSchemeRegistration
         tensorstore::internal_file_kvstore::FileKeyValueStoreSpec::id,
         tensorstore::internal_file_kvstore::ParseFileUrl};
 
+const tensorstore::internal_kvstore::UrlSchemeRegistration
+    shm_url_scheme_registration{
+        "shm", tensorstore::internal_file_kvstore::ParseShmUrl};
+
 }  // namespace
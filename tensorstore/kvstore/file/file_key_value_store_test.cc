@@ -42,6 +42,7 @@
 #include "tensorstore/context.h"
 #include "tensorstore/internal/global_initializer.h"
 #include "tensorstore/internal/os/filesystem.h"
+#include "tensorstore/internal/testing/json_gtest.h"
 #include "tensorstore/internal/testing/scoped_directory.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/key_range.h"
@@ -68,6 +69,7 @@ using ::tensorstore::CompletionNotifyingReceiver;
 using ::tensorstore::IsOkAndHolds;
 using ::tensorstore::KeyRange;
 using ::tensorstore::KvStore;
+using ::tensorstore::MatchesJson;
 using ::tensorstore::MatchesStatus;
 using ::tensorstore::StorageGeneration;
 using ::tensorstore::internal::KeyValueStoreOpsTestParameters;
@@ -131,6 +133,14 @@ TENSORSTORE_GLOBAL_INITIALIZER {
                   {"file_io_locking", {{"mode", "none"}}}};
         },
         params);
+    register_with_spec(
+        "SingleWriter",
+        [](std::string path) -> ::nlohmann::json {
+          return {{"driver", "file"},
+                  {"path", path},
+                  {"file_io_locking", {{"mode", "single_writer"}}}};
+        },
+        params);
     register_with_spec(
         "NoSync",
         [](std::string path) -> ::nlohmann::json {
@@ -148,6 +158,30 @@ TENSORSTORE_GLOBAL_INITIALIZER {
           },
           p);
     }
+    register_with_spec(
+        "Direct",
+        [](std::string path) -> ::nlohmann::json {
+          return {
+              {"driver", "file"}, {"path", path}, {"file_io_direct", true}};
+        },
+        params);
+    register_with_spec(
+        "DirectIoUring",
+        [](std::string path) -> ::nlohmann::json {
+          return {{"driver", "file"},
+                  {"path", path},
+                  {"file_io_direct", true},
+                  {"file_io_engine", {{"mode", "io_uring"}}}};
+        },
+        params);
+    register_with_spec(
+        "IoUring",
+        [](std::string path) -> ::nlohmann::json {
+          return {{"driver", "file"},
+                  {"path", path},
+                  {"file_io_engine", {{"mode", "io_uring"}}}};
+        },
+        params);
     register_with_spec(
         "UrlOpen",
         [](std::string path) -> ::nlohmann::json { return "file://" + path; },
@@ -474,6 +508,26 @@ TEST(FileKeyValueStoreTest, InvalidUri) {
                             ".*Invalid file path.*"));
 }
 
+#ifdef __linux__
+TEST(FileKeyValueStoreTest, ShmUrl) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto spec,
+                                   kvstore::Spec::FromUrl("shm://cache/a/"));
+  EXPECT_THAT(spec.ToJson(),
+              ::testing::Optional(MatchesJson({
+                  {"driver", "file"},
+                  {"path", "/dev/shm/tensorstore/cache/a/"},
+                  {"file_io_memmap", true},
+                  {"file_io_sync", false},
+              })));
+  EXPECT_THAT(kvstore::Spec::FromUrl("shm://"),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            ".*must specify a store name"));
+  EXPECT_THAT(kvstore::Spec::FromUrl("shm://cache?query"),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            ".*: Query string not supported"));
+}
+#endif
+
 TEST(FileKeyValueStoreTest, RelativePath) {
   ScopedTemporaryDirectory tempdir;
   ScopedCurrentWorkingDirectory scoped_cwd(tempdir.path());
@@ -492,6 +546,43 @@ TEST(FileKeyValueStoreTest, BatchRead) {
   tensorstore::internal::TestBatchReadGenericCoalescing(store, options);
 }
 
+// Falls back to the threadpool engine if io_uring is not supported.
+TEST(FileKeyValueStoreTest, BatchReadIoUring) {
+  ScopedTemporaryDirectory tempdir;
+  auto store = kvstore::Open({
+                                 {"driver", "file"},
+                                 {"path", tempdir.path() + "/"},
+                                 {"file_io_engine",
+                                  {{"mode", "io_uring"}, {"queue_depth", 8}}},
+                             })
+                   .value();
+
+  tensorstore::internal::BatchReadGenericCoalescingTestOptions options;
+  options.coalescing_options.max_extra_read_bytes = 255;
+  options.metric_prefix = "/tensorstore/kvstore/file/";
+  options.has_file_open_metric = true;
+  tensorstore::internal::TestBatchReadGenericCoalescing(store, options);
+}
+
+TEST(FileKeyValueStoreTest, BatchReadCoalescing) {
+  ScopedTemporaryDirectory tempdir;
+  auto store = kvstore::Open({
+                                 {"driver", "file"},
+                                 {"path", tempdir.path() + "/"},
+                                 {"file_io_coalescing",
+                                  {{"max_extra_read_bytes", 4095},
+                                   {"target_coalesced_size", 1 << 20}}},
+                             })
+                   .value();
+
+  tensorstore::internal::BatchReadGenericCoalescingTestOptions options;
+  options.coalescing_options.max_extra_read_bytes = 4095;
+  options.coalescing_options.target_coalesced_size = 1 << 20;
+  options.metric_prefix = "/tensorstore/kvstore/file/";
+  options.has_file_open_metric = true;
+  tensorstore::internal::TestBatchReadGenericCoalescing(store, options);
+}
+
 #if 0
 // TODO: Make this test reasonable for mmap cases.
 TEST(FileKeyValueStoreTest, BatchReadMemmap) {
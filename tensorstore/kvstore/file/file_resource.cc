@@ -14,9 +14,38 @@
 
 #include "tensorstore/kvstore/file/file_resource.h"
 
+#include <memory>
+
+#include "absl/log/absl_log.h"
 #include "tensorstore/context_resource_provider.h"
 #include "tensorstore/internal/cache_key/absl_time.h"
 #include "tensorstore/internal/cache_key/cache_key.h"
+#include "tensorstore/internal/os/io_uring.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal_file_kvstore {
+
+Result<FileIoEngineResource::Resource> FileIoEngineResource::Create(
+    Spec v, internal::ContextResourceCreationContext context) {
+  Resource resource{v, nullptr};
+  if (v.mode != Engine::io_uring) return resource;
+  internal_os::IoUring::Options options;
+  options.queue_depth = v.queue_depth;
+  options.sqpoll = v.sqpoll;
+  auto io_uring = internal_os::IoUring::Make(options);
+  if (!io_uring.ok()) {
+    ABSL_LOG(WARNING) << "file_io_engine: io_uring is not available, using "
+                         "threadpool: "
+                      << io_uring.status();
+    return resource;
+  }
+  resource.io_uring = std::move(*io_uring);
+  return resource;
+}
+
+}  // namespace internal_file_kvstore
+}  // namespace tensorstore
 
 namespace {
 
@@ -28,8 +57,20 @@ const tensorstore::internal::ContextResourceRegistration<
     tensorstore::internal_file_kvstore::FileIoMemmapResource>
     file_io_memmap_registration;
 
+const tensorstore::internal::ContextResourceRegistration<
+    tensorstore::internal_file_kvstore::FileIoDirectResource>
+    file_io_direct_registration;
+
+const tensorstore::internal::ContextResourceRegistration<
+    tensorstore::internal_file_kvstore::FileIoCoalescingResource>
+    file_io_coalescing_registration;
+
 const tensorstore::internal::ContextResourceRegistration<
     tensorstore::internal_file_kvstore::FileIoLockingResource>
     file_io_registration;
 
+const tensorstore::internal::ContextResourceRegistration<
+    tensorstore::internal_file_kvstore::FileIoEngineResource>
+    file_io_engine_registration;
+
 }  // namespace
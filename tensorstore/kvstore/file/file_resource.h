@@ -15,11 +15,16 @@
 #ifndef TENSORSTORE_KVSTORE_FILE_FILE_RESOURCE_H_
 #define TENSORSTORE_KVSTORE_FILE_FILE_RESOURCE_H_
 
+#include <stdint.h>
+
+#include <limits>
+#include <memory>
 #include <string_view>
 
 #include "absl/time/time.h"
 #include "tensorstore/context.h"
 #include "tensorstore/context_resource_provider.h"
+#include "tensorstore/internal/os/io_uring.h"
 #include "tensorstore/internal/json_binding/absl_time.h"
 #include "tensorstore/internal/json_binding/bindable.h"
 #include "tensorstore/internal/json_binding/enum.h"
@@ -74,6 +79,82 @@ struct FileIoMemmapResource
   }
 };
 
+/// When set, the "file" kvstore reads files with O_DIRECT, bypassing the
+/// operating system page cache.
+struct FileIoDirectResource
+    : public internal::ContextResourceTraits<FileIoDirectResource> {
+  constexpr static bool config_only = true;
+  static constexpr char id[] = "file_io_direct";
+
+  using Spec = bool;
+  using Resource = Spec;
+  static Spec Default() { return false; }
+  static constexpr auto JsonBinder() {
+    return internal_json_binding::DefaultBinder<>;
+  }
+  static Result<Resource> Create(
+      Spec v, internal::ContextResourceCreationContext context) {
+    return v;
+  }
+  static Spec GetSpec(Resource v, const internal::ContextSpecBuilder& builder) {
+    return v;
+  }
+};
+
+/// Specifies how the "file" kvstore merges the byte ranges of a batch of reads
+/// of the same file into fewer, larger reads.
+struct FileIoCoalescingResource
+    : public internal::ContextResourceTraits<FileIoCoalescingResource> {
+  constexpr static bool config_only = true;
+  static constexpr char id[] = "file_io_coalescing";
+
+  struct Spec {
+    /// Maximum number of unrequested bytes between two byte ranges that are
+    /// read together.
+    int64_t max_extra_read_bytes;
+
+    /// Size after which no further non-overlapping byte ranges are added to a
+    /// coalesced read.
+    int64_t target_coalesced_size;
+
+    constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+      return f(x.max_extra_read_bytes, x.target_coalesced_size);
+    };
+  };
+
+  using Resource = Spec;
+  static Spec Default() {
+    return Spec{255, std::numeric_limits<int64_t>::max()};
+  }
+  static constexpr auto JsonBinder() {
+    namespace jb = internal_json_binding;
+
+    return jb::Object(
+        jb::Member(
+            "max_extra_read_bytes",
+            jb::Projection<&Spec::max_extra_read_bytes>(
+                jb::DefaultValue<jb::kNeverIncludeDefaults>(
+                    [](auto* obj) { *obj = Default().max_extra_read_bytes; },
+                    jb::Integer<int64_t>(0)))),
+        jb::Member(
+            "target_coalesced_size",
+            jb::Projection<&Spec::target_coalesced_size>(
+                jb::DefaultValue<jb::kNeverIncludeDefaults>(
+                    [](auto* obj) { *obj = Default().target_coalesced_size; },
+                    jb::Integer<int64_t>(1))))
+        /**/);
+  }
+
+  static Result<Resource> Create(
+      Spec v, internal::ContextResourceCreationContext context) {
+    return v;
+  }
+
+  static Spec GetSpec(Resource v, const internal::ContextSpecBuilder& builder) {
+    return v;
+  }
+};
+
 /// When set, allows choosing how the "file" kvstore uses file locking, which
 /// ensures that only one process is writing to a kvstore key at a time.
 struct FileIoLockingResource
@@ -90,6 +171,10 @@ struct FileIoLockingResource
 
     /// Do not use locking.
     none,
+
+    /// Assume that only the current process writes to the kvstore: writes of
+    /// a key within the process are serialized, and no lock files are used.
+    single_writer,
   };
 
   struct Spec {
@@ -114,6 +199,8 @@ struct FileIoLockingResource
                                        {LockingMode::os, "os"},
                                        {LockingMode::lockfile, "lockfile"},
                                        {LockingMode::none, "none"},
+                                       {LockingMode::single_writer,
+                                        "single_writer"},
                                    })))),
         jb::Member(
             "acquire_timeout",
@@ -133,6 +220,73 @@ struct FileIoLockingResource
   }
 };
 
+/// Selects the engine with which the "file" kvstore reads files.
+///
+/// By default, each read is a blocking ::pread on a `file_io_concurrency`
+/// thread.  With the ``io_uring`` engine, all reads of a batch are submitted
+/// to a shared Linux io_uring, so that the number of reads in flight is not
+/// limited by the number of threads.
+struct FileIoEngineResource
+    : public internal::ContextResourceTraits<FileIoEngineResource> {
+  static constexpr char id[] = "file_io_engine";
+
+  enum class Engine : unsigned char {
+    /// Blocking reads on the `file_io_concurrency` executor.
+    threadpool,
+
+    /// Asynchronous reads using io_uring.  Falls back to `threadpool` if
+    /// io_uring is not supported.
+    io_uring,
+  };
+
+  struct Spec {
+    Engine mode;
+    uint32_t queue_depth;
+    bool sqpoll;
+
+    constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+      return f(x.mode, x.queue_depth, x.sqpoll);
+    };
+  };
+
+  struct Resource {
+    Spec spec;
+    /// Null unless `spec.mode == Engine::io_uring` and io_uring is supported.
+    std::shared_ptr<internal_os::IoUring> io_uring;
+  };
+
+  static Spec Default() { return Spec{Engine::threadpool, 256, false}; }
+  static constexpr auto JsonBinder() {
+    namespace jb = internal_json_binding;
+
+    return jb::Object(
+        jb::Member("mode", jb::Projection<&Spec::mode>(
+                               jb::DefaultValue<jb::kNeverIncludeDefaults>(
+                                   [](auto* obj) { *obj = Default().mode; },
+                                   jb::Enum<Engine, std::string_view>({
+                                       {Engine::threadpool, "threadpool"},
+                                       {Engine::io_uring, "io_uring"},
+                                   })))),
+        jb::Member("queue_depth",
+                   jb::Projection<&Spec::queue_depth>(
+                       jb::DefaultValue<jb::kNeverIncludeDefaults>(
+                           [](auto* obj) { *obj = Default().queue_depth; },
+                           jb::Integer<uint32_t>(1, 32768)))),
+        jb::Member("sqpoll", jb::Projection<&Spec::sqpoll>(
+                                 jb::DefaultValue<jb::kNeverIncludeDefaults>(
+                                     [](auto* obj) { *obj = false; })))
+        /**/);
+  }
+
+  static Result<Resource> Create(
+      Spec v, internal::ContextResourceCreationContext context);
+
+  static Spec GetSpec(const Resource& v,
+                      const internal::ContextSpecBuilder& builder) {
+    return v.spec;
+  }
+};
+
 }  // namespace internal_file_kvstore
 }  // namespace tensorstore
 
@@ -0,0 +1,63 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/file/fsync_group.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <string_view>
+#include <utility>
+
+#include "absl/functional/function_ref.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+
+namespace tensorstore {
+namespace internal_file_util {
+
+absl::Status FsyncGroup::Sync(std::string_view directory,
+                              absl::FunctionRef<absl::Status()> fsync) {
+  absl::MutexLock lock(&mutex_);
+  auto& entry = directories_[directory];
+  if (!entry) entry = std::make_unique<Directory>();
+  Directory* dir = entry.get();
+  ++dir->users;
+  // An `fsync` already in progress may have started before the changes of
+  // the caller, so the next one is required.
+  const uint64_t required = dir->started + 1;
+  while (dir->completed < required) {
+    if (dir->in_progress) {
+      mutex_.Await(absl::Condition(
+          +[](Directory* dir) { return !dir->in_progress; }, dir));
+      continue;
+    }
+    dir->in_progress = true;
+    const uint64_t id = ++dir->started;
+    mutex_.Unlock();
+    absl::Status status = fsync();
+    mutex_.Lock();
+    dir->in_progress = false;
+    dir->completed = id;
+    dir->status = std::move(status);
+  }
+  absl::Status status = dir->status;
+  if (--dir->users == 0) {
+    directories_.erase(directory);
+  }
+  return status;
+}
+
+}  // namespace internal_file_util
+}  // namespace tensorstore
@@ -0,0 +1,70 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_FILE_FSYNC_GROUP_H_
+#define TENSORSTORE_KVSTORE_FILE_FSYNC_GROUP_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/functional/function_ref.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+
+namespace tensorstore {
+namespace internal_file_util {
+
+/// Coalesces concurrent `fsync` calls on the same directory ("group commit").
+///
+/// A rename or unlink is made durable by an `fsync` of the parent directory
+/// that starts after it.  When many files in one directory are written
+/// concurrently, as when a transaction commits many chunks, a single `fsync`
+/// started after all of their renames makes all of them durable.  `Sync`
+/// waits for such an `fsync`, and performs it only if no other caller does.
+class FsyncGroup {
+ public:
+  /// Returns the result of a call to `fsync`, for some caller of `Sync` with
+  /// the same `directory`, that started after this call to `Sync`.
+  ///
+  /// \param directory Key identifying the directory.
+  /// \param fsync Syncs the directory.  Called at most once.
+  absl::Status Sync(std::string_view directory,
+                    absl::FunctionRef<absl::Status()> fsync);
+
+ private:
+  struct Directory {
+    // Number of threads in `Sync`.
+    int64_t users = 0;
+    bool in_progress = false;
+    // Number of `fsync` calls started and completed.
+    uint64_t started = 0;
+    uint64_t completed = 0;
+    // Result of the most recently completed `fsync`.
+    absl::Status status;
+  };
+
+  absl::Mutex mutex_;
+  absl::flat_hash_map<std::string, std::unique_ptr<Directory>> directories_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace internal_file_util
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_FILE_FSYNC_GROUP_H_
@@ -0,0 +1,93 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/file/fsync_group.h"
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/synchronization/notification.h"
+
+namespace {
+
+using ::tensorstore::internal_file_util::FsyncGroup;
+
+TEST(FsyncGroupTest, Sequential) {
+  FsyncGroup group;
+  int calls = 0;
+  auto fsync = [&] {
+    ++calls;
+    return absl::OkStatus();
+  };
+  EXPECT_TRUE(group.Sync("a", fsync).ok());
+  EXPECT_TRUE(group.Sync("a", fsync).ok());
+  EXPECT_TRUE(group.Sync("b", fsync).ok());
+  EXPECT_EQ(3, calls);
+}
+
+TEST(FsyncGroupTest, Error) {
+  FsyncGroup group;
+  EXPECT_EQ(absl::UnknownError("x"),
+            group.Sync("a", [] { return absl::UnknownError("x"); }));
+  EXPECT_TRUE(group.Sync("a", [] { return absl::OkStatus(); }).ok());
+}
+
+// Callers that arrive while an fsync is in progress share the next fsync.
+TEST(FsyncGroupTest, Coalesced) {
+  FsyncGroup group;
+  absl::Notification first_started, release_first;
+  std::atomic<int> calls{0};
+  std::thread first([&] {
+    EXPECT_TRUE(group
+                    .Sync("a",
+                          [&] {
+                            ++calls;
+                            first_started.Notify();
+                            release_first.WaitForNotification();
+                            return absl::OkStatus();
+                          })
+                    .ok());
+  });
+  first_started.WaitForNotification();
+
+  constexpr int kNumWaiters = 8;
+  std::atomic<int> arrived{0};
+  std::vector<std::thread> waiters;
+  for (int i = 0; i < kNumWaiters; ++i) {
+    waiters.emplace_back([&] {
+      ++arrived;
+      EXPECT_TRUE(group
+                      .Sync("a",
+                            [&] {
+                              ++calls;
+                              return absl::OkStatus();
+                            })
+                      .ok());
+    });
+  }
+  while (arrived < kNumWaiters) std::this_thread::yield();
+  // Allow the waiters to block in `Sync`.
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  release_first.Notify();
+  first.join();
+  for (auto& t : waiters) t.join();
+  EXPECT_EQ(2, calls);
+}
+
+}  // namespace
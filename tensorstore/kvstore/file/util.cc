@@ -15,6 +15,7 @@
 #include "tensorstore/kvstore/file/util.h"
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <cassert>
 #include <string>
@@ -28,8 +29,10 @@
 #include "tensorstore/internal/flat_cord_builder.h"
 #include "tensorstore/internal/os/file_descriptor.h"
 #include "tensorstore/internal/os/file_util.h"
+#include "tensorstore/internal/os/memory_region.h"
 #include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/util/division.h"
 #include "tensorstore/util/result.h"
 #include "tensorstore/util/status.h"
 
@@ -130,25 +133,58 @@ Result<UniqueFileDescriptor> OpenParentDirectory(std::string path) {
   }
 }
 
-Result<absl::Cord> ReadFromFileDescriptor(FileDescriptor fd,
-                                          ByteRange byte_range) {
-  assert(fd != internal_os::FileDescriptorTraits::Invalid());
-  // Large reads could use hugepage-aware memory allocations.
-  internal::FlatCordBuilder buffer(byte_range.size(), 0);
-  size_t offset = 0;
-  while (buffer.available() > 0) {
+namespace {
+
+// Reads from `fd` at `offset` into `buffer` until it holds at least `size`
+// bytes.
+absl::Status ReadIntoBuffer(FileDescriptor fd, int64_t offset, size_t size,
+                            internal::FlatCordBuilder& buffer) {
+  size_t inuse = 0;
+  while (inuse < size) {
     TENSORSTORE_ASSIGN_OR_RETURN(
         auto n, internal_os::PReadFromFile(fd, buffer.available_span(),
-                                           byte_range.inclusive_min + offset));
+                                           offset + inuse));
     if (n > 0) {
-      offset += n;
-      buffer.set_inuse(offset);
+      inuse += n;
+      buffer.set_inuse(inuse);
       continue;
     }
     if (n == 0) {
       return absl::UnavailableError("Length changed while reading");
     }
   }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+ByteRange GetDirectReadRange(ByteRange byte_range) {
+  constexpr int64_t kAlignment = internal_os::kDirectIoAlignment;
+  return {byte_range.inclusive_min - byte_range.inclusive_min % kAlignment,
+          RoundUpTo(byte_range.exclusive_max, kAlignment)};
+}
+
+Result<absl::Cord> ReadFromFileDescriptor(FileDescriptor fd,
+                                          ByteRange byte_range, bool direct) {
+  assert(fd != internal_os::FileDescriptorTraits::Invalid());
+  if (direct) {
+    const ByteRange read_range = GetDirectReadRange(byte_range);
+    internal::FlatCordBuilder buffer(
+        internal_os::AllocateAlignedHeapRegion(read_range.size()), 0);
+    // Only the requested bytes are required; the file may end before the
+    // aligned end of the read.
+    TENSORSTORE_RETURN_IF_ERROR(ReadIntoBuffer(
+        fd, read_range.inclusive_min,
+        byte_range.exclusive_max - read_range.inclusive_min, buffer));
+    return std::move(buffer).Build().Subcord(
+        byte_range.inclusive_min - read_range.inclusive_min, byte_range.size());
+  }
+  // Large reads could use hugepage-aware memory allocations.  The heap buffer
+  // is aligned for any element type, which allows uncompressed chunks to be
+  // viewed in place by `internal::TryViewCordAsArray`.
+  internal::FlatCordBuilder buffer(byte_range.size(), 0);
+  TENSORSTORE_RETURN_IF_ERROR(ReadIntoBuffer(fd, byte_range.inclusive_min,
+                                             byte_range.size(), buffer));
   return std::move(buffer).Build();
 }
 
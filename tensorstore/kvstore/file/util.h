@@ -39,9 +39,20 @@ std::string_view LongestDirectoryPrefix(const KeyRange& range);
 /// open file descriptor to the parent directory of `path`.
 Result<internal_os::UniqueFileDescriptor> OpenParentDirectory(std::string path);
 
+/// Returns the smallest range aligned to `internal_os::kDirectIoAlignment`
+/// that contains `byte_range`, as required for reads from a file opened with
+/// `internal_os::OpenFlags::Direct`.
+ByteRange GetDirectReadRange(ByteRange byte_range);
+
 /// Reads a range of bytes from an open file descriptor.
+///
+/// If `direct` is `true`, `fd` must have been opened with
+/// `internal_os::OpenFlags::Direct`.  The read is then widened by
+/// `GetDirectReadRange` into an aligned buffer, and the returned Cord
+/// references the requested part of that buffer without a copy.
 Result<absl::Cord> ReadFromFileDescriptor(internal_os::FileDescriptor fd,
-                                          ByteRange byte_range);
+                                          ByteRange byte_range,
+                                          bool direct = false);
 
 }  // namespace internal_file_util
 }  // namespace tensorstore
@@ -17,11 +17,14 @@
 #include <string_view>
 
 #include <gtest/gtest.h>
+#include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/key_range.h"
 
 namespace {
 
+using ::tensorstore::ByteRange;
 using ::tensorstore::KeyRange;
+using ::tensorstore::internal_file_util::GetDirectReadRange;
 using ::tensorstore::internal_file_util::IsKeyValid;
 using ::tensorstore::internal_file_util::LongestDirectoryPrefix;
 
@@ -59,4 +62,12 @@ TEST(LongestDirectoryPrefix, Basic) {
   EXPECT_EQ("/a", LongestDirectoryPrefix(KeyRange{"/a/a", "/a/b"}));
 }
 
+TEST(GetDirectReadRange, Basic) {
+  EXPECT_EQ((ByteRange{0, 0}), GetDirectReadRange(ByteRange{0, 0}));
+  EXPECT_EQ((ByteRange{0, 4096}), GetDirectReadRange(ByteRange{0, 1}));
+  EXPECT_EQ((ByteRange{0, 4096}), GetDirectReadRange(ByteRange{0, 4096}));
+  EXPECT_EQ((ByteRange{4096, 12288}),
+            GetDirectReadRange(ByteRange{5000, 8193}));
+}
+
 }  // namespace
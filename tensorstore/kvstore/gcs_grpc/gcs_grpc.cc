@@ -40,7 +40,10 @@
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "grpcpp/client_context.h"  // third_party
+#include "grpcpp/generic/generic_stub.h"  // third_party
+#include "grpcpp/impl/proto_utils.h"  // third_party
 #include "grpcpp/security/credentials.h"  // third_party
+#include "grpcpp/support/byte_buffer.h"  // third_party
 #include "grpcpp/support/client_callback.h"  // third_party
 #include "grpcpp/support/status.h"  // third_party
 #include "tensorstore/context.h"
@@ -55,6 +58,7 @@
 #include "tensorstore/internal/source_location.h"
 #include "tensorstore/internal/thread/schedule_at.h"
 #include "tensorstore/internal/uri_utils.h"
+#include "tensorstore/kvstore/adaptive_coalescing.h"
 #include "tensorstore/kvstore/batch_util.h"
 #include "tensorstore/kvstore/common_metrics.h"
 #include "tensorstore/kvstore/driver.h"
@@ -64,10 +68,12 @@
 #include "tensorstore/kvstore/gcs/validate.h"
 #include "tensorstore/kvstore/gcs_grpc/default_endpoint.h"
 #include "tensorstore/kvstore/gcs_grpc/default_strategy.h"
+#include "tensorstore/kvstore/gcs_grpc/read_object_response.h"
 #include "tensorstore/kvstore/gcs_grpc/state.h"
 #include "tensorstore/kvstore/gcs_grpc/storage_stub_pool.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/generic_coalescing_batch_util.h"
+#include "tensorstore/kvstore/hedged_read.h"
 #include "tensorstore/kvstore/key_range.h"
 #include "tensorstore/kvstore/operations.h"
 #include "tensorstore/kvstore/read_result.h"
@@ -104,6 +110,7 @@ using ::tensorstore::internal::DataCopyConcurrencyResource;
 using ::tensorstore::internal::GrpcStatusToAbslStatus;
 using ::tensorstore::internal::ScheduleAt;
 using ::tensorstore::internal_gcs_grpc::GetSharedStorageStubPool;
+using ::tensorstore::internal_gcs_grpc::ParseReadObjectResponse;
 using ::tensorstore::internal_gcs_grpc::StorageStubPool;
 using ::tensorstore::internal_storage_gcs::ExperimentalGcsGrpcCredentials;
 using ::tensorstore::internal_storage_gcs::GcsUserProjectResource;
@@ -125,6 +132,9 @@ using ::google::storage::v2::Storage;
 
 namespace {
 static constexpr char kUriScheme[] = "gcs_grpc";
+
+static constexpr char kReadObjectMethod[] =
+    "/google.storage.v2.Storage/ReadObject";
 }  // namespace
 
 namespace tensorstore {
@@ -165,11 +175,12 @@ struct GcsGrpcKeyValueStoreSpecData {
   Context::Resource<internal_storage_gcs::GcsRequestRetries> retries;
   Context::Resource<DataCopyConcurrencyResource> data_copy_concurrency;
   Context::Resource<ExperimentalGcsGrpcCredentials> credentials;
+  internal_kvstore::HedgedReadOptions hedged_read;
 
   constexpr static auto ApplyMembers = [](auto&& x, auto f) {
     return f(x.bucket, x.endpoint, x.num_channels, x.timeout,
              x.wait_for_connection, x.user_project, x.retries,
-             x.data_copy_concurrency, x.credentials);
+             x.data_copy_concurrency, x.credentials, x.hedged_read);
   };
 
   constexpr static auto default_json_binder = jb::Object(
@@ -207,7 +218,11 @@ struct GcsGrpcKeyValueStoreSpecData {
                      &GcsGrpcKeyValueStoreSpecData::data_copy_concurrency>()),
       jb::Member(
           ExperimentalGcsGrpcCredentials::id,
-          jb::Projection<&GcsGrpcKeyValueStoreSpecData::credentials>()), /**/
+          jb::Projection<&GcsGrpcKeyValueStoreSpecData::credentials>()),
+      jb::Member("hedged_read",
+                 jb::Projection<&GcsGrpcKeyValueStoreSpecData::hedged_read>(
+                     jb::DefaultInitializedValue<
+                         jb::kNeverIncludeDefaults>())), /**/
       jb::DiscardExtraMembers);
 };
 
@@ -241,9 +256,8 @@ class GcsGrpcKeyValueStore
     : public internal_kvstore::RegisteredDriver<GcsGrpcKeyValueStore,
                                                 GcsGrpcKeyValueStoreSpec> {
  public:
-  internal_kvstore_batch::CoalescingOptions GetBatchReadCoalescingOptions()
-      const {
-    return internal_kvstore_batch::kDefaultRemoteStorageCoalescingOptions;
+  internal_kvstore_batch::AdaptiveCoalescingOptions& batch_read_coalescing() {
+    return batch_read_coalescing_;
   }
 
   /// Key value store operations.
@@ -277,8 +291,8 @@ class GcsGrpcKeyValueStore
   // Bucket names are in the form: 'projects/{project-id}/buckets/{bucket-id}'
   std::string bucket_name() { return bucket_; }
 
-  std::shared_ptr<Storage::StubInterface> get_stub() {
-    return storage_stub_pool_->get_next_stub();
+  StorageStubPool::StubRef get_stub() {
+    return storage_stub_pool_->AcquireStub();
   }
 
   Future<std::shared_ptr<grpc::ClientContext>> AllocateContext() {
@@ -336,14 +350,24 @@ class GcsGrpcKeyValueStore
   std::string bucket_;
   std::shared_ptr<internal_grpc::GrpcAuthenticationStrategy> auth_strategy_;
   std::shared_ptr<StorageStubPool> storage_stub_pool_;
+  std::shared_ptr<internal_kvstore::HedgedReadTracker> hedged_read_tracker_ =
+      std::make_shared<internal_kvstore::HedgedReadTracker>();
+  internal_kvstore_batch::AdaptiveCoalescingOptions batch_read_coalescing_{
+      internal_kvstore_batch::kDefaultRemoteStorageCoalescingOptions,
+      "gcs_grpc"};
 };
 
 ////////////////////////////////////////////////////
 
 // Implements GcsGrpcKeyValueStore::Read
 // rpc ReadObject(ReadObjectRequest) returns (stream ReadObjectResponse) {}
-struct ReadTask : public internal::AtomicReferenceCount<ReadTask>,
-                  public grpc::ClientReadReactor<ReadObjectResponse> {
+//
+// The call is issued through the generic stub so that the content of each
+// response references the received slices rather than being copied out of a
+// parsed ReadObjectResponse.
+struct ReadTask
+    : public internal::AtomicReferenceCount<ReadTask>,
+      public grpc::ClientBidiReactor<grpc::ByteBuffer, grpc::ByteBuffer> {
   internal::IntrusivePtr<GcsGrpcKeyValueStore> driver_;
   internal_gcs_grpc::ReadState state_;
   Promise<kvstore::ReadResult> promise_;
@@ -351,10 +375,13 @@ struct ReadTask : public internal::AtomicReferenceCount<ReadTask>,
   // working state.
   ReadObjectRequest request_;
   ReadObjectResponse response_;
+  grpc::ByteBuffer request_buffer_;
+  grpc::ByteBuffer response_buffer_;
 
   int attempt_ = 0;
   absl::Mutex mutex_;
   std::shared_ptr<grpc::ClientContext> context_ ABSL_GUARDED_BY(mutex_);
+  StorageStubPool::StubRef stub_ ABSL_GUARDED_BY(mutex_);
 
   ReadTask(internal::IntrusivePtr<GcsGrpcKeyValueStore> driver,
            kvstore::ReadOptions options, Promise<kvstore::ReadResult> promise)
@@ -403,14 +430,19 @@ struct ReadTask : public internal::AtomicReferenceCount<ReadTask>,
       absl::MutexLock lock(&mutex_);
       assert(context_ == nullptr);
       context_ = std::move(context);
-      auto stub = driver_->get_stub();
+      stub_ = driver_->get_stub();
 
       // Start a call.
       intrusive_ptr_increment(this);  // adopted in OnDone.
-      stub->async()->ReadObject(context_.get(), &request_, this);
+      stub_.generic_stub()->PrepareBidiStreamingCall(
+          context_.get(), kReadObjectMethod, grpc::StubOptions(), this);
     }
 
-    StartRead(&response_);
+    bool own_buffer;
+    grpc::SerializationTraits<ReadObjectRequest>::Serialize(
+        request_, &request_buffer_, &own_buffer);
+    StartWrite(&request_buffer_, grpc::WriteOptions().set_last_message());
+    StartRead(&response_buffer_);
     StartCall();
   }
 
@@ -420,18 +452,22 @@ struct ReadTask : public internal::AtomicReferenceCount<ReadTask>,
       TryCancel();
       return;
     }
-    if (response_.has_checksummed_data()) {
-      gcs_grpc_metrics.bytes_read.IncrementBy(
-          response_.checksummed_data().content().size());
+    absl::Cord content;
+    auto status =
+        ParseReadObjectResponse(response_buffer_, response_, content);
+    response_buffer_.Clear();
+    gcs_grpc_metrics.bytes_read.IncrementBy(content.size());
+    if (status.ok()) {
+      status = state_.HandleResponse(response_, std::move(content));
     }
-    if (auto status = state_.HandleResponse(response_); !status.ok()) {
+    if (!status.ok()) {
       promise_.SetResult(status);
       TryCancel();
       return;
     }
 
     // Issue next request, if necessary.
-    StartRead(&response_);
+    StartRead(&response_buffer_);
   }
 
   void OnDone(const grpc::Status& s) override {
@@ -450,11 +486,12 @@ struct ReadTask : public internal::AtomicReferenceCount<ReadTask>,
     {
       absl::MutexLock lock(&mutex_);
       context_ = nullptr;
+      stub_.reset();
     }
 
     auto latency = state_.GetLatency();
     gcs_grpc_metrics.read_latency_ms.Observe(
-        absl::ToInt64Milliseconds(latency));
+        absl::ToDoubleMilliseconds(latency));
 
     if (!status.ok() && attempt_ == 0 &&
         status.code() == absl::StatusCode::kUnauthenticated) {
@@ -493,6 +530,7 @@ struct WriteTask : public internal::AtomicReferenceCount<WriteTask>,
   int attempt_ = 0;
   absl::Mutex mutex_;
   std::shared_ptr<grpc::ClientContext> context_ ABSL_GUARDED_BY(mutex_);
+  StorageStubPool::StubRef stub_ ABSL_GUARDED_BY(mutex_);
 
   WriteTask(internal::IntrusivePtr<GcsGrpcKeyValueStore> driver,
             kvstore::WriteOptions options, absl::Cord data,
@@ -544,10 +582,10 @@ struct WriteTask : public internal::AtomicReferenceCount<WriteTask>,
       absl::MutexLock lock(&mutex_);
       assert(context_ == nullptr);
       context_ = std::move(context);
-      auto stub = driver_->get_stub();
+      stub_ = driver_->get_stub();
       // Initiate the write.
       intrusive_ptr_increment(this);
-      stub->async()->WriteObject(context_.get(), &response_, this);
+      stub_->async()->WriteObject(context_.get(), &response_, this);
     }
 
     state_.UpdateRequestForNextWrite(request_);
@@ -589,10 +627,11 @@ struct WriteTask : public internal::AtomicReferenceCount<WriteTask>,
 
     auto latency = state_.GetLatency();
     gcs_grpc_metrics.write_latency_ms.Observe(
-        absl::ToInt64Milliseconds(latency));
+        absl::ToDoubleMilliseconds(latency));
     {
       absl::MutexLock lock(&mutex_);
       context_ = nullptr;
+      stub_.reset();
     }
 
     if (!status.ok() && attempt_ == 0 &&
@@ -629,6 +668,7 @@ struct DeleteTask : public internal::AtomicReferenceCount<DeleteTask> {
   int attempt_ = 0;
   absl::Mutex mutex_;
   std::shared_ptr<grpc::ClientContext> context_ ABSL_GUARDED_BY(mutex_);
+  StorageStubPool::StubRef stub_ ABSL_GUARDED_BY(mutex_);
 
   void TryCancel() ABSL_LOCKS_EXCLUDED(mutex_) {
     absl::MutexLock lock(&mutex_);
@@ -672,10 +712,10 @@ struct DeleteTask : public internal::AtomicReferenceCount<DeleteTask> {
       absl::MutexLock lock(&mutex_);
       assert(context_ == nullptr);
       context_ = std::move(context);
-      auto stub = driver_->get_stub();
+      stub_ = driver_->get_stub();
 
       intrusive_ptr_increment(this);  // Adopted by OnDone
-      stub->async()->DeleteObject(
+      stub_->async()->DeleteObject(
           context_.get(), &request_, &response_,
           WithExecutor(driver_->executor(), [this](::grpc::Status s) {
             internal::IntrusivePtr<DeleteTask> self(this,
@@ -693,6 +733,7 @@ struct DeleteTask : public internal::AtomicReferenceCount<DeleteTask> {
     {
       absl::MutexLock lock(&mutex_);
       context_ = nullptr;
+      stub_.reset();
     }
 
     if (!status.ok() && attempt_ == 0 &&
@@ -737,7 +778,6 @@ struct ListTask : public internal::AtomicReferenceCount<ListTask> {
   ListReceiver receiver_;
 
   // working state.
-  std::shared_ptr<Storage::StubInterface> stub_;
   ListObjectsRequest request;
   ListObjectsResponse response;
 
@@ -745,6 +785,7 @@ struct ListTask : public internal::AtomicReferenceCount<ListTask> {
   absl::Mutex mutex_;
   std::shared_ptr<grpc::ClientContext> context_ ABSL_GUARDED_BY(mutex_);
   bool cancelled_ ABSL_GUARDED_BY(mutex_) = false;
+  StorageStubPool::StubRef stub_ ABSL_GUARDED_BY(mutex_);
 
   ListTask(internal::IntrusivePtr<GcsGrpcKeyValueStore>&& driver,
            kvstore::ListOptions&& options, ListReceiver&& receiver)
@@ -823,6 +864,10 @@ struct ListTask : public internal::AtomicReferenceCount<ListTask> {
   }
 
   void ListFinished(absl::Status status) {
+    {
+      absl::MutexLock lock(&mutex_);
+      stub_.reset();
+    }
     if (is_cancelled()) {
       execution::set_done(receiver_);
       return;
@@ -926,14 +971,18 @@ Future<kvstore::ReadResult> GcsGrpcKeyValueStore::Read(Key key,
 
 Future<kvstore::ReadResult> GcsGrpcKeyValueStore::ReadImpl(
     Key&& key, ReadOptions&& options) {
-  gcs_grpc_metrics.batch_read.Increment();
-  auto op = PromiseFuturePair<ReadResult>::Make();
-
-  auto task = internal::MakeIntrusivePtr<ReadTask>(
-      internal::IntrusivePtr<GcsGrpcKeyValueStore>(this), std::move(options),
-      std::move(op.promise));
-  task->Start(key);
-  return std::move(op.future);
+  return internal_kvstore::HedgedRead(
+      spec_.hedged_read, hedged_read_tracker_, executor(),
+      [self = internal::IntrusivePtr<GcsGrpcKeyValueStore>(this),
+       key = std::move(key), options = std::move(options)] {
+        gcs_grpc_metrics.batch_read.Increment();
+        auto op = PromiseFuturePair<ReadResult>::Make();
+
+        auto task = internal::MakeIntrusivePtr<ReadTask>(self, options,
+                                                         std::move(op.promise));
+        task->Start(key);
+        return std::move(op.future);
+      });
 }
 
 Future<TimestampedStorageGeneration> GcsGrpcKeyValueStore::Write(
@@ -0,0 +1,215 @@
+// Copyright 2022 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/gcs_grpc/read_object_response.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "grpcpp/support/byte_buffer.h"  // third_party
+#include "grpcpp/support/slice.h"  // third_party
+
+// proto
+#include "google/storage/v2/storage.pb.h"
+
+namespace tensorstore {
+namespace internal_gcs_grpc {
+namespace {
+
+/// Slices smaller than this are copied rather than referenced.
+constexpr size_t kMaxBytesToCopy = 511;
+
+/// Protobuf wire types.
+enum WireType : uint32_t {
+  kVarint = 0,
+  kFixed64 = 1,
+  kLengthDelimited = 2,
+  kFixed32 = 5,
+};
+
+/// Reads protobuf wire format from a Cord without flattening it.
+class CordReader {
+ public:
+  explicit CordReader(const absl::Cord& cord)
+      : cord_(cord), it_(cord.char_begin()), remaining_(cord.size()) {}
+
+  bool done() const { return remaining_ == 0; }
+  size_t position() const { return cord_.size() - remaining_; }
+
+  bool ReadVarint(uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      if (remaining_ == 0) return false;
+      const uint8_t byte = static_cast<uint8_t>(*it_);
+      ++it_;
+      --remaining_;
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) return true;
+    }
+    return false;
+  }
+
+  bool ReadFixed32(uint32_t& value) {
+    if (remaining_ < 4) return false;
+    value = 0;
+    for (int i = 0; i < 4; ++i) {
+      value |= static_cast<uint32_t>(static_cast<uint8_t>(*it_)) << (8 * i);
+      ++it_;
+    }
+    remaining_ -= 4;
+    return true;
+  }
+
+  bool ReadLengthDelimited(absl::Cord& value) {
+    uint64_t length;
+    if (!ReadVarint(length) || length > remaining_) return false;
+    value = absl::Cord::AdvanceAndRead(&it_, length);
+    remaining_ -= length;
+    return true;
+  }
+
+  bool Skip(size_t n) {
+    if (n > remaining_) return false;
+    absl::Cord::Advance(&it_, n);
+    remaining_ -= n;
+    return true;
+  }
+
+  /// Skips the value of a field with the specified wire type.
+  bool SkipValue(uint32_t wire_type) {
+    switch (wire_type) {
+      case kVarint: {
+        uint64_t value;
+        return ReadVarint(value);
+      }
+      case kFixed64:
+        return Skip(8);
+      case kLengthDelimited: {
+        uint64_t length;
+        return ReadVarint(length) && Skip(length);
+      }
+      case kFixed32:
+        return Skip(4);
+      default:
+        return false;
+    }
+  }
+
+ private:
+  const absl::Cord& cord_;
+  absl::Cord::CharIterator it_;
+  size_t remaining_;
+};
+
+absl::Status InvalidResponse() {
+  return absl::DataLossError("Failed to parse ReadObjectResponse");
+}
+
+// Parses `ChecksummedData`, returning the content separately.
+absl::Status ParseChecksummedData(
+    const absl::Cord& cord, google::storage::v2::ChecksummedData& data,
+    absl::Cord& content) {
+  CordReader reader(cord);
+  while (!reader.done()) {
+    uint64_t tag;
+    if (!reader.ReadVarint(tag)) return InvalidResponse();
+    const uint32_t field = tag >> 3;
+    const uint32_t wire_type = tag & 7;
+    if (field == 1 && wire_type == kLengthDelimited) {
+      // bytes content = 1;
+      if (!reader.ReadLengthDelimited(content)) return InvalidResponse();
+    } else if (field == 2 && wire_type == kFixed32) {
+      // optional fixed32 crc32c = 2;
+      uint32_t crc32c;
+      if (!reader.ReadFixed32(crc32c)) return InvalidResponse();
+      data.set_crc32c(crc32c);
+    } else if (!reader.SkipValue(wire_type)) {
+      return InvalidResponse();
+    }
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+absl::Cord ByteBufferToCord(grpc::ByteBuffer& buffer) {
+  absl::Cord cord;
+  std::vector<grpc::Slice> slices;
+  if (!buffer.Dump(&slices).ok()) return cord;
+  for (auto& slice : slices) {
+    std::string_view data(reinterpret_cast<const char*>(slice.begin()),
+                          slice.size());
+    if (data.size() <= kMaxBytesToCopy) {
+      cord.Append(data);
+    } else {
+      // The releaser holds a reference to the slice.
+      cord.Append(absl::MakeCordFromExternal(
+          data, [slice = std::move(slice)](std::string_view) {}));
+    }
+  }
+  return cord;
+}
+
+absl::Status ParseReadObjectResponse(
+    grpc::ByteBuffer& buffer, google::storage::v2::ReadObjectResponse& response,
+    absl::Cord& content) {
+  const absl::Cord cord = ByteBufferToCord(buffer);
+
+  // Fields other than `checksummed_data` are copied and parsed by protobuf.
+  absl::Cord other_fields;
+  google::storage::v2::ChecksummedData checksummed_data;
+  bool has_checksummed_data = false;
+  content.Clear();
+
+  CordReader reader(cord);
+  while (!reader.done()) {
+    const size_t field_start = reader.position();
+    uint64_t tag;
+    if (!reader.ReadVarint(tag)) return InvalidResponse();
+    const uint32_t field = tag >> 3;
+    const uint32_t wire_type = tag & 7;
+    if (field == 1 && wire_type == kLengthDelimited) {
+      // ChecksummedData checksummed_data = 1;
+      absl::Cord value;
+      if (!reader.ReadLengthDelimited(value)) return InvalidResponse();
+      has_checksummed_data = true;
+      if (auto status = ParseChecksummedData(value, checksummed_data, content);
+          !status.ok()) {
+        return status;
+      }
+    } else {
+      if (!reader.SkipValue(wire_type)) return InvalidResponse();
+      other_fields.Append(
+          cord.Subcord(field_start, reader.position() - field_start));
+    }
+  }
+
+  if (!response.ParseFromString(std::string(other_fields))) {
+    return InvalidResponse();
+  }
+  if (has_checksummed_data) {
+    *response.mutable_checksummed_data() = std::move(checksummed_data);
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace internal_gcs_grpc
+}  // namespace tensorstore
@@ -0,0 +1,45 @@
+// Copyright 2022 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_GCS_GRPC_READ_OBJECT_RESPONSE_H_
+#define TENSORSTORE_KVSTORE_GCS_GRPC_READ_OBJECT_RESPONSE_H_
+
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "grpcpp/support/byte_buffer.h"  // third_party
+
+// proto
+#include "google/storage/v2/storage.pb.h"
+
+namespace tensorstore {
+namespace internal_gcs_grpc {
+
+/// Returns a Cord which references the slices of `buffer`, rather than
+/// copying them.  Small slices are copied.
+absl::Cord ByteBufferToCord(grpc::ByteBuffer& buffer);
+
+/// Parses a serialized `ReadObjectResponse` from `buffer`.
+///
+/// The content of `checksummed_data` is returned in `content`, which
+/// references the received slices rather than copying them; the
+/// `checksummed_data.content` field of `response` is left empty.  All other
+/// fields, which are small, are parsed into `response`.
+absl::Status ParseReadObjectResponse(
+    grpc::ByteBuffer& buffer, google::storage::v2::ReadObjectResponse& response,
+    absl::Cord& content);
+
+}  // namespace internal_gcs_grpc
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_GCS_GRPC_READ_OBJECT_RESPONSE_H_
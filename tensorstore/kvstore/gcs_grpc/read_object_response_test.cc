@@ -0,0 +1,112 @@
+// Copyright 2022 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/gcs_grpc/read_object_response.h"
+
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "grpcpp/support/byte_buffer.h"  // third_party
+#include "grpcpp/support/slice.h"  // third_party
+#include "tensorstore/util/status_testutil.h"
+
+// proto
+#include "google/storage/v2/storage.pb.h"
+
+namespace {
+
+using ::google::storage::v2::ReadObjectResponse;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::internal_gcs_grpc::ByteBufferToCord;
+using ::tensorstore::internal_gcs_grpc::ParseReadObjectResponse;
+
+// Returns a ByteBuffer with the contents of `data` split into slices of at
+// most `slice_size` bytes.
+grpc::ByteBuffer MakeByteBuffer(const std::string& data, size_t slice_size) {
+  std::vector<grpc::Slice> slices;
+  for (size_t i = 0; i < data.size(); i += slice_size) {
+    slices.emplace_back(data.substr(i, slice_size));
+  }
+  return grpc::ByteBuffer(slices.data(), slices.size());
+}
+
+TEST(ReadObjectResponseTest, ByteBufferToCord) {
+  std::string data(4096, 'x');
+  data[1000] = 'y';
+  for (size_t slice_size : {7, 1000, 4096}) {
+    auto buffer = MakeByteBuffer(data, slice_size);
+    EXPECT_EQ(data, std::string(ByteBufferToCord(buffer)));
+  }
+}
+
+TEST(ReadObjectResponseTest, Parse) {
+  ReadObjectResponse expected;
+  expected.mutable_metadata()->set_generation(2);
+  expected.mutable_content_range()->set_start(0);
+  expected.mutable_content_range()->set_end(3000);
+  expected.mutable_object_checksums()->set_crc32c(1234);
+  std::string value(3000, 'a');
+  value[2000] = 'b';
+  expected.mutable_checksummed_data()->set_content(value);
+  expected.mutable_checksummed_data()->set_crc32c(5678);
+  std::string serialized = expected.SerializeAsString();
+
+  // Parsing must not depend on the slice boundaries.
+  for (size_t slice_size :
+       {size_t{1}, size_t{13}, size_t{1024}, serialized.size()}) {
+    auto buffer = MakeByteBuffer(serialized, slice_size);
+    ReadObjectResponse response;
+    absl::Cord content;
+    TENSORSTORE_ASSERT_OK(ParseReadObjectResponse(buffer, response, content));
+    EXPECT_EQ(value, std::string(content));
+    EXPECT_EQ(2, response.metadata().generation());
+    EXPECT_EQ(3000, response.content_range().end());
+    EXPECT_EQ(1234, response.object_checksums().crc32c());
+    EXPECT_TRUE(response.has_checksummed_data());
+    EXPECT_EQ(5678, response.checksummed_data().crc32c());
+    EXPECT_TRUE(response.checksummed_data().content().empty());
+  }
+}
+
+TEST(ReadObjectResponseTest, NoData) {
+  ReadObjectResponse expected;
+  expected.mutable_metadata()->set_generation(2);
+  auto buffer = MakeByteBuffer(expected.SerializeAsString(), 1024);
+  ReadObjectResponse response;
+  absl::Cord content("x");
+  TENSORSTORE_ASSERT_OK(ParseReadObjectResponse(buffer, response, content));
+  EXPECT_TRUE(content.empty());
+  EXPECT_FALSE(response.has_checksummed_data());
+  EXPECT_EQ(2, response.metadata().generation());
+}
+
+TEST(ReadObjectResponseTest, Truncated) {
+  ReadObjectResponse expected;
+  expected.mutable_checksummed_data()->set_content(std::string(100, 'a'));
+  std::string serialized = expected.SerializeAsString();
+  serialized.resize(serialized.size() - 1);
+  auto buffer = MakeByteBuffer(serialized, 1024);
+  ReadObjectResponse response;
+  absl::Cord content;
+  EXPECT_THAT(ParseReadObjectResponse(buffer, response, content),
+              MatchesStatus(absl::StatusCode::kDataLoss));
+}
+
+}  // namespace
@@ -142,7 +142,8 @@ Result<kvstore::ReadResult> ReadState::HandleFinalStatus(absl::Status status) {
                                     std::move(storage_generation_));
 }
 
-absl::Status ReadState::HandleResponse(ReadState::Response& response) {
+absl::Status ReadState::HandleResponse(ReadState::Response& response,
+                                       absl::Cord content) {
   if (response.has_metadata()) {
     storage_generation_.generation =
         StorageGeneration::FromUint64(response.metadata().generation());
@@ -172,7 +173,7 @@ absl::Status ReadState::HandleResponse(ReadState::Response& response) {
     }
   }
   if (response.has_checksummed_data()) {
-    chunks_.emplace_back(response.checksummed_data().content(),
+    chunks_.emplace_back(std::move(content),
                          absl::crc32c_t(response.checksummed_data().crc32c()));
   }
   return absl::OkStatus();
@@ -62,7 +62,9 @@ struct ReadState {
 
   Result<kvstore::ReadResult> HandleFinalStatus(absl::Status status);
 
-  absl::Status HandleResponse(Response& response);
+  /// Handles a response, of which `content` is the content of
+  /// `checksummed_data`.
+  absl::Status HandleResponse(Response& response, absl::Cord content);
 
  private:
   // Initial state.
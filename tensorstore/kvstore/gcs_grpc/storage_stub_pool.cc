@@ -18,6 +18,7 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <string>
@@ -32,6 +33,7 @@
 #include "absl/container/flat_hash_map.h"
 #include "absl/flags/flag.h"
 #include "absl/log/absl_log.h"
+#include "absl/random/random.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_format.h"
 #include "absl/synchronization/mutex.h"
@@ -54,6 +56,12 @@ ABSL_FLAG(std::optional<uint32_t>, tensorstore_gcs_grpc_channels, std::nullopt,
           "Default (and maximum) channels to use in gcs_grpc driver. "
           "Overrides TENSORSTORE_GCS_GRPC_CHANNELS.");
 
+ABSL_FLAG(std::optional<uint32_t>, tensorstore_gcs_grpc_max_channels,
+          std::nullopt,
+          "Maximum channels to which the gcs_grpc driver grows a pool when "
+          "all channels are saturated. Overrides "
+          "TENSORSTORE_GCS_GRPC_MAX_CHANNELS.");
+
 using ::tensorstore::internal::GetFlagOrEnvValue;
 
 namespace tensorstore {
@@ -97,6 +105,21 @@ uint32_t ChannelsForAddress(std::string_view address, uint32_t num_channels) {
   return std::max(4u, std::thread::hardware_concurrency());
 }
 
+/// Returns the maximum number of channels to which a pool which starts with
+/// `num_channels` channels may grow.
+uint32_t MaxChannelsForAddress(std::string_view address,
+                               uint32_t num_channels) {
+  if (IsDirectPathAddress(address)) {
+    return num_channels;
+  }
+  auto opt = GetFlagOrEnvValue(FLAGS_tensorstore_gcs_grpc_max_channels,
+                               "TENSORSTORE_GCS_GRPC_MAX_CHANNELS");
+  if (opt) {
+    return std::max(*opt, num_channels);
+  }
+  return 2 * num_channels;
+}
+
 // Create a gRPC channel. See google cloud storage client in:
 // https://github.com/googleapis/google-cloud-cpp/blob/main/google/cloud/storage/internal/storage_stub_factory.cc
 std::shared_ptr<grpc::Channel> CreateChannel(
@@ -123,29 +146,105 @@ std::shared_ptr<grpc::Channel> CreateChannel(
 }  // namespace
 
 StorageStubPool::StorageStubPool(
-    std::string address, std::vector<std::shared_ptr<grpc::Channel>> channels)
-    : address_(std::move(address)), channels_(std::move(channels)) {
-  stubs_.reserve(channels_.size());
-  for (auto& channel : channels_) {
-    // See google cloud storage client in:
-    // https://github.com/googleapis/google-cloud-cpp/blob/main/google/cloud/storage/internal/storage_stub_factory.cc
-    stubs_.push_back(Storage::NewStub(channel));
+    std::string address, std::vector<std::shared_ptr<grpc::Channel>> channels,
+    ChannelFactory channel_factory, size_t max_size,
+    int64_t max_streams_per_channel)
+    : address_(std::move(address)),
+      channel_factory_(std::move(channel_factory)),
+      max_size_(std::max(max_size, channels.size())),
+      max_streams_per_channel_(max_streams_per_channel) {
+  absl::MutexLock lock(&mutex_);
+  channels_.reserve(max_size_);
+  for (auto& channel : channels) {
+    AddChannel(std::move(channel));
+  }
+}
+
+void StorageStubPool::AddChannel(std::shared_ptr<grpc::Channel> channel) {
+  auto c = std::make_shared<Channel>();
+  c->id = channels_.size();
+  // See google cloud storage client in:
+  // https://github.com/googleapis/google-cloud-cpp/blob/main/google/cloud/storage/internal/storage_stub_factory.cc
+  c->stub = Storage::NewStub(channel);
+  c->generic_stub = std::make_unique<grpc::GenericStub>(channel);
+  c->channel = std::move(channel);
+  channels_.push_back(std::move(c));
+}
+
+double StorageStubPool::Cost(const Channel& channel) {
+  // A channel without latency samples costs less than any other channel
+  // with the same number of calls in flight, so that it is sampled.
+  return static_cast<double>(
+             channel.in_flight.load(std::memory_order_relaxed) + 1) *
+         static_cast<double>(std::max<int64_t>(
+             1, channel.latency_ewma_ns.load(std::memory_order_relaxed)));
+}
+
+StorageStubPool::StubRef StorageStubPool::AcquireStub() {
+  std::shared_ptr<Channel> channel;
+  {
+    absl::MutexLock lock(&mutex_);
+    const size_t n = channels_.size();
+    if (n == 1) {
+      channel = channels_[0];
+    } else {
+      // Choose the less costly of two distinct random channels.
+      size_t a = absl::Uniform<size_t>(gen_, 0, n);
+      size_t b = absl::Uniform<size_t>(gen_, 0, n - 1);
+      if (b >= a) ++b;
+      channel = Cost(*channels_[a]) <= Cost(*channels_[b]) ? channels_[a]
+                                                           : channels_[b];
+    }
+    if (n < max_size_ && channel_factory_ &&
+        channel->in_flight.load(std::memory_order_relaxed) >=
+            max_streams_per_channel_ &&
+        std::all_of(channels_.begin(), channels_.end(), [&](const auto& c) {
+          return c->in_flight.load(std::memory_order_relaxed) >=
+                 max_streams_per_channel_;
+        })) {
+      ABSL_LOG_IF(INFO, gcs_grpc_logging)
+          << "Adding channel " << n << " to " << address_;
+      AddChannel(channel_factory_(static_cast<int>(n)));
+      channel = channels_.back();
+    }
+    channel->in_flight.fetch_add(1, std::memory_order_relaxed);
   }
+  return StubRef(std::move(channel), absl::Now());
+}
+
+void StorageStubPool::StubRef::reset() {
+  if (!channel_) return;
+  const int64_t latency = absl::ToInt64Nanoseconds(absl::Now() - start_time_);
+  // Concurrent updates may be lost, which only makes the average approximate.
+  const int64_t ewma =
+      channel_->latency_ewma_ns.load(std::memory_order_relaxed);
+  channel_->latency_ewma_ns.store(
+      ewma == 0 ? latency : ewma + (latency - ewma) / 8,
+      std::memory_order_relaxed);
+  channel_->in_flight.fetch_sub(1, std::memory_order_relaxed);
+  channel_ = nullptr;
 }
 
 void StorageStubPool::WaitForConnected(absl::Duration duration) {
-  for (auto& channel : channels_) {
+  std::vector<std::shared_ptr<grpc::Channel>> channels;
+  {
+    absl::MutexLock lock(&mutex_);
+    for (const auto& c : channels_) {
+      channels.push_back(c->channel);
+    }
+  }
+  for (auto& channel : channels) {
     channel->GetState(true);
   }
   if (duration > absl::ZeroDuration()) {
     auto timeout = absl::ToChronoTime(absl::Now() + duration);
-    for (auto& channel : channels_) {
+    for (auto& channel : channels) {
       channel->WaitForConnected(timeout);
     }
   }
   ABSL_LOG_IF(INFO, gcs_grpc_logging)
       << "Connection established to " << address_ << " in state "
-      << channels_[0]->GetState(false);
+      << channels[0]->GetState(false);
 }
 
 std::shared_ptr<StorageStubPool> GetSharedStorageStubPool(
@@ -171,8 +270,13 @@ std::shared_ptr<StorageStubPool> GetSharedStorageStubPool(
       // https://github.com/googleapis/google-cloud-cpp/blob/main/google/cloud/storage/internal/storage_stub_factory.cc
       channels.push_back(CreateChannel(address, *auth_strategy, id));
     }
-    pool = std::make_shared<StorageStubPool>(std::move(address),
-                                             std::move(channels));
+    size_t max_size = MaxChannelsForAddress(address, size);
+    auto channel_factory = [address, auth_strategy](int id) {
+      return CreateChannel(address, *auth_strategy, id);
+    };
+    pool = std::make_shared<StorageStubPool>(
+        std::move(address), std::move(channels), std::move(channel_factory),
+        max_size);
     pool->WaitForConnected(wait_for_connected);
   }
   return pool;
@@ -19,46 +19,126 @@
 #include <stdint.h>
 
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "google/storage/v2/storage.grpc.pb.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/random/random.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
 #include "grpcpp/channel.h"  // third_party
+#include "grpcpp/generic/generic_stub.h"  // third_party
 #include "tensorstore/internal/grpc/clientauth/authentication_strategy.h"
 
 namespace tensorstore {
 namespace internal_gcs_grpc {
 
 // A gRPC ConnectionPool for Storage stubs.
+//
+// Each call is issued on the least loaded of two randomly chosen channels
+// ("power of two choices"), where the load of a channel is the number of
+// in-flight calls weighted by an exponentially weighted moving average of
+// recent call latencies.  When all channels have at least
+// `max_streams_per_channel` calls in flight, the pool grows by one channel,
+// up to `max_size` channels.
 class StorageStubPool {
   using Storage = ::google::storage::v2::Storage;
+  struct Channel;
 
  public:
+  // Creates the channel with the specified id.
+  using ChannelFactory =
+      std::function<std::shared_ptr<grpc::Channel>(int channel_id)>;
+
+  constexpr static int64_t kDefaultMaxStreamsPerChannel = 100;
+
   StorageStubPool(std::string address,
-                  std::vector<std::shared_ptr<grpc::Channel>> channels);
+                  std::vector<std::shared_ptr<grpc::Channel>> channels,
+                  ChannelFactory channel_factory = {}, size_t max_size = 0,
+                  int64_t max_streams_per_channel =
+                      kDefaultMaxStreamsPerChannel);
+
+  // A stub acquired for a call.  The call counts as in flight on its channel
+  // until the StubRef is reset or destroyed.
+  class StubRef {
+   public:
+    StubRef() = default;
+    StubRef(StubRef&& other) = default;
+    StubRef& operator=(StubRef&& other) {
+      reset();
+      channel_ = std::move(other.channel_);
+      start_time_ = other.start_time_;
+      return *this;
+    }
+    ~StubRef() { reset(); }
+
+    Storage::StubInterface* get() const { return channel_->stub.get(); }
+    Storage::StubInterface* operator->() const { return get(); }
+
+    // Generic stub for the same channel, used for calls which handle
+    // serialized messages directly.
+    grpc::GenericStub* generic_stub() const {
+      return channel_->generic_stub.get();
+    }
+    explicit operator bool() const { return channel_ != nullptr; }
+
+    // Index of the channel in the pool.
+    size_t channel_id() const { return channel_->id; }
+
+    // Marks the call as complete, and records its latency.
+    void reset();
+
+   private:
+    friend class StorageStubPool;
+    StubRef(std::shared_ptr<Channel> channel, absl::Time start_time)
+        : channel_(std::move(channel)), start_time_(start_time) {}
+
+    std::shared_ptr<Channel> channel_;
+    absl::Time start_time_;
+  };
 
   // Accessors
   const std::string& address() const { return address_; }
-  size_t size() const { return stubs_.size(); }
-
-  // Round-robin stub acquisition.
-  std::shared_ptr<Storage::StubInterface> get_next_stub() const {
-    size_t id = (stubs_.size() > 1)
-                    ? (next_channel_index_.fetch_add(1) % stubs_.size())
-                    : 0;
-    return stubs_[id];
+  size_t size() const {
+    absl::MutexLock lock(&mutex_);
+    return channels_.size();
   }
+  size_t max_size() const { return max_size_; }
+
+  // Acquires a stub on the least loaded channel.
+  StubRef AcquireStub();
 
   // Wait for the channels to resolve to the Connected state.
   void WaitForConnected(absl::Duration duration);
 
  private:
+  struct Channel {
+    size_t id;
+    std::shared_ptr<grpc::Channel> channel;
+    std::shared_ptr<Storage::StubInterface> stub;
+    std::unique_ptr<grpc::GenericStub> generic_stub;
+    std::atomic<int64_t> in_flight{0};
+    std::atomic<int64_t> latency_ewma_ns{0};
+  };
+
+  // Returns the relative cost of issuing a call on `channel`.
+  static double Cost(const Channel& channel);
+
+  void AddChannel(std::shared_ptr<grpc::Channel> channel)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   std::string address_;
-  std::vector<std::shared_ptr<Storage::StubInterface>> stubs_;
-  std::vector<std::shared_ptr<grpc::Channel>> channels_;
-  mutable std::atomic<size_t> next_channel_index_ = 0;
+  ChannelFactory channel_factory_;
+  size_t max_size_;
+  int64_t max_streams_per_channel_;
+
+  mutable absl::Mutex mutex_;
+  std::vector<std::shared_ptr<Channel>> channels_ ABSL_GUARDED_BY(mutex_);
+  absl::BitGen gen_ ABSL_GUARDED_BY(mutex_);
 };
 
 // Returns a shared_pointer to the shared StubPool. Care must be taken
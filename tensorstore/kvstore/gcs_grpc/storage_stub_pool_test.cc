@@ -0,0 +1,81 @@
+// Copyright 2022 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/gcs_grpc/storage_stub_pool.h"
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "grpcpp/channel.h"  // third_party
+#include "grpcpp/create_channel.h"  // third_party
+#include "grpcpp/security/credentials.h"  // third_party
+
+namespace {
+
+using ::tensorstore::internal_gcs_grpc::StorageStubPool;
+
+// Channels connect lazily, so no server is required.
+std::shared_ptr<grpc::Channel> MakeChannel(int id) {
+  return grpc::CreateChannel("localhost:1",
+                             grpc::InsecureChannelCredentials());
+}
+
+std::vector<std::shared_ptr<grpc::Channel>> MakeChannels(int n) {
+  std::vector<std::shared_ptr<grpc::Channel>> channels;
+  for (int i = 0; i < n; ++i) channels.push_back(MakeChannel(i));
+  return channels;
+}
+
+TEST(StorageStubPoolTest, LeastLoaded) {
+  StorageStubPool pool("localhost:1", MakeChannels(2));
+  EXPECT_EQ(2, pool.size());
+
+  // With two channels, both are always candidates, so while no call
+  // completes the calls are balanced between the channels.
+  std::vector<StorageStubPool::StubRef> refs;
+  size_t counts[2] = {0, 0};
+  for (int i = 0; i < 6; ++i) {
+    refs.push_back(pool.AcquireStub());
+    ASSERT_TRUE(refs.back());
+    counts[refs.back().channel_id()]++;
+    EXPECT_LE(counts[0], counts[1] + 1);
+    EXPECT_LE(counts[1], counts[0] + 1);
+  }
+
+  refs[0].reset();
+  EXPECT_FALSE(refs[0]);
+}
+
+TEST(StorageStubPoolTest, GrowsWhenSaturated) {
+  StorageStubPool pool("localhost:1", MakeChannels(2), &MakeChannel,
+                       /*max_size=*/3, /*max_streams_per_channel=*/2);
+  std::vector<StorageStubPool::StubRef> refs;
+  for (int i = 0; i < 4; ++i) refs.push_back(pool.AcquireStub());
+  EXPECT_EQ(2, pool.size());
+
+  // All channels have 2 calls in flight.
+  refs.push_back(pool.AcquireStub());
+  EXPECT_EQ(3, pool.size());
+  EXPECT_EQ(2, refs.back().channel_id());
+
+  // The pool does not grow beyond `max_size`.
+  for (int i = 0; i < 4; ++i) refs.push_back(pool.AcquireStub());
+  EXPECT_EQ(3, pool.size());
+}
+
+}  // namespace
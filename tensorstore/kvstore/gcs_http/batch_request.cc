@@ -0,0 +1,171 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/gcs_http/batch_request.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "tensorstore/internal/http/http_header.h"
+#include "tensorstore/internal/http/http_response.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+
+using ::tensorstore::internal_http::HeaderMap;
+using ::tensorstore::internal_http::HttpResponse;
+
+namespace tensorstore {
+namespace internal_kvstore_gcs_http {
+namespace {
+
+// Splits `part` into the header block, including the terminating CRLF, and
+// the remainder following the empty line.
+void SplitHeaders(std::string_view part, std::string_view& headers,
+                  std::string_view& body) {
+  size_t pos = part.find("\r\n\r\n");
+  if (pos == std::string_view::npos) {
+    headers = part;
+    body = {};
+    return;
+  }
+  headers = part.substr(0, pos + 2);
+  body = part.substr(pos + 4);
+}
+
+HeaderMap ParseHeaders(std::string_view data) {
+  HeaderMap headers;
+  internal_http::ParseAndSetHeaders(
+      data, [&](std::string_view field_name, std::string_view field_value) {
+        headers.SetHeader(field_name, field_value);
+      });
+  return headers;
+}
+
+// Returns the request index from a response content id of the form
+// "<response-N>" or "<response-prefix+N>", where `N` is one-based.
+std::optional<size_t> GetRequestIndex(const HeaderMap& headers) {
+  auto it = headers.find("content-id");
+  if (it == headers.end()) return std::nullopt;
+  std::string_view id = absl::StripAsciiWhitespace(it->second);
+  if (absl::ConsumePrefix(&id, "<")) absl::ConsumeSuffix(&id, ">");
+  size_t pos = id.find_last_not_of("0123456789");
+  if (pos != std::string_view::npos) id.remove_prefix(pos + 1);
+  size_t n;
+  if (!absl::SimpleAtoi(id, &n) || n == 0) return std::nullopt;
+  return n - 1;
+}
+
+}  // namespace
+
+std::string BuildBatchRequestBody(tensorstore::span<const std::string> requests,
+                                  std::string_view boundary) {
+  std::string body;
+  for (ptrdiff_t i = 0; i < requests.size(); ++i) {
+    absl::StrAppend(&body, "--", boundary,
+                    "\r\n"
+                    "Content-Type: application/http\r\n"
+                    "Content-ID: <",
+                    i + 1,
+                    ">\r\n"
+                    "\r\n",
+                    requests[i], " HTTP/1.1\r\n\r\n");
+  }
+  absl::StrAppend(&body, "--", boundary, "--\r\n");
+  return body;
+}
+
+Result<std::vector<HttpResponse>> ParseBatchResponse(
+    const HttpResponse& response, size_t num_requests) {
+  std::string_view boundary;
+  if (auto it = response.headers.find("content-type");
+      it != response.headers.end()) {
+    for (std::string_view param : absl::StrSplit(it->second, ';')) {
+      param = absl::StripAsciiWhitespace(param);
+      if (absl::ConsumePrefix(&param, "boundary=")) {
+        if (absl::ConsumePrefix(&param, "\"")) {
+          absl::ConsumeSuffix(&param, "\"");
+        }
+        boundary = param;
+      }
+    }
+  }
+  if (boundary.empty()) {
+    return absl::InvalidArgumentError(
+        "Malformed batch response: missing multipart boundary");
+  }
+
+  std::vector<HttpResponse> responses(num_requests,
+                                      HttpResponse{0, absl::Cord(), {}});
+  auto payload = response.payload;
+  std::string_view payload_str = payload.Flatten();
+  const std::string delimiter = absl::StrCat("--", boundary);
+  size_t next_index = 0;
+  bool first = true;
+  for (std::string_view part : absl::StrSplit(payload_str, delimiter)) {
+    // Skip the preamble, which precedes the first delimiter.
+    if (std::exchange(first, false)) continue;
+    // The close delimiter is followed by "--".
+    if (absl::StartsWith(part, "--")) break;
+    absl::ConsumePrefix(&part, "\r\n");
+    absl::ConsumeSuffix(&part, "\r\n");
+
+    std::string_view part_headers, http_response;
+    SplitHeaders(part, part_headers, http_response);
+    size_t index = GetRequestIndex(ParseHeaders(part_headers))
+                       .value_or(next_index);
+    next_index = index + 1;
+    if (index >= num_requests) {
+      return absl::InvalidArgumentError(
+          "Malformed batch response: unexpected response content id");
+    }
+
+    // The part body is an HTTP response, e.g. "HTTP/1.1 204 No Content".
+    std::string_view status_line, response_headers, response_body;
+    SplitHeaders(http_response, response_headers, response_body);
+    size_t status_end = response_headers.find("\r\n");
+    status_line = response_headers.substr(0, status_end);
+    response_headers.remove_prefix(
+        status_end == std::string_view::npos ? response_headers.size()
+                                             : status_end + 2);
+    std::vector<std::string_view> status_fields =
+        absl::StrSplit(status_line, ' ', absl::SkipEmpty());
+    int32_t status_code;
+    if (status_fields.size() < 2 ||
+        !absl::StartsWith(status_fields[0], "HTTP/") ||
+        !absl::SimpleAtoi(status_fields[1], &status_code)) {
+      return absl::InvalidArgumentError(absl::StrCat(
+          "Malformed batch response: invalid status line: ", status_line));
+    }
+    responses[index] =
+        HttpResponse{status_code, absl::Cord(response_body),
+                     ParseHeaders(response_headers)};
+  }
+  return responses;
+}
+
+}  // namespace internal_kvstore_gcs_http
+}  // namespace tensorstore
@@ -0,0 +1,59 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_GCS_HTTP_BATCH_REQUEST_H_
+#define TENSORSTORE_KVSTORE_GCS_HTTP_BATCH_REQUEST_H_
+
+/// \file
+/// Encoding of GCS JSON API batch requests, which combine up to
+/// `kMaxBatchRequests` requests into a single multipart/mixed HTTP request.
+/// https://cloud.google.com/storage/docs/batch
+
+#include <stddef.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "tensorstore/internal/http/http_response.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal_kvstore_gcs_http {
+
+/// Maximum number of requests in a single batch request.
+constexpr size_t kMaxBatchRequests = 100;
+
+/// Returns the multipart/mixed body of a batch request in which part `i` is
+/// `requests[i]`, an HTTP request without a body such as
+/// "DELETE /storage/v1/b/bucket/o/object", with a content id of `i + 1`.
+///
+/// The request must specify a content type of
+/// "multipart/mixed; boundary=<boundary>".
+std::string BuildBatchRequestBody(tensorstore::span<const std::string> requests,
+                                  std::string_view boundary);
+
+/// Parses the multipart/mixed response to a batch request consisting of
+/// `num_requests` requests, and returns the response to each request.
+///
+/// Requests for which the batch response does not include a response are
+/// assigned a status code of 0.
+Result<std::vector<internal_http::HttpResponse>> ParseBatchResponse(
+    const internal_http::HttpResponse& response, size_t num_requests);
+
+}  // namespace internal_kvstore_gcs_http
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_GCS_HTTP_BATCH_REQUEST_H_
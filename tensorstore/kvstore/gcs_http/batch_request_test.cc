@@ -0,0 +1,106 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/gcs_http/batch_request.h"
+
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "tensorstore/internal/http/http_header.h"
+#include "tensorstore/internal/http/http_response.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::StatusIs;
+using ::tensorstore::internal_http::HeaderMap;
+using ::tensorstore::internal_http::HttpResponse;
+using ::tensorstore::internal_kvstore_gcs_http::BuildBatchRequestBody;
+using ::tensorstore::internal_kvstore_gcs_http::ParseBatchResponse;
+using ::testing::ElementsAre;
+using ::testing::Field;
+
+TEST(BatchRequestTest, BuildBatchRequestBody) {
+  const std::string requests[] = {"DELETE /storage/v1/b/bucket/o/a",
+                                  "DELETE /storage/v1/b/bucket/o/b"};
+  EXPECT_EQ(
+      "--BOUNDARY\r\n"
+      "Content-Type: application/http\r\n"
+      "Content-ID: <1>\r\n"
+      "\r\n"
+      "DELETE /storage/v1/b/bucket/o/a HTTP/1.1\r\n"
+      "\r\n"
+      "--BOUNDARY\r\n"
+      "Content-Type: application/http\r\n"
+      "Content-ID: <2>\r\n"
+      "\r\n"
+      "DELETE /storage/v1/b/bucket/o/b HTTP/1.1\r\n"
+      "\r\n"
+      "--BOUNDARY--\r\n",
+      BuildBatchRequestBody(requests, "BOUNDARY"));
+}
+
+TEST(BatchRequestTest, ParseBatchResponse) {
+  HttpResponse response{
+      200,
+      absl::Cord("--batch_x\r\n"
+                 "Content-Type: application/http\r\n"
+                 "Content-ID: <response-2>\r\n"
+                 "\r\n"
+                 "HTTP/1.1 404 Not Found\r\n"
+                 "Content-Type: application/json\r\n"
+                 "\r\n"
+                 "{\"error\": {}}\r\n"
+                 "--batch_x\r\n"
+                 "Content-Type: application/http\r\n"
+                 "Content-ID: <response-1>\r\n"
+                 "\r\n"
+                 "HTTP/1.1 204 No Content\r\n"
+                 "\r\n"
+                 "\r\n"
+                 "--batch_x--\r\n"),
+      HeaderMap{{"content-type", "multipart/mixed; boundary=batch_x"}}};
+  EXPECT_THAT(
+      ParseBatchResponse(response, 3),
+      ::testing::Optional(ElementsAre(
+          Field(&HttpResponse::status_code, 204),
+          ::testing::AllOf(Field(&HttpResponse::status_code, 404),
+                           Field(&HttpResponse::payload,
+                                 absl::Cord("{\"error\": {}}"))),
+          // No response for the third request.
+          Field(&HttpResponse::status_code, 0))));
+}
+
+TEST(BatchRequestTest, ParseBatchResponseErrors) {
+  // Missing boundary.
+  EXPECT_THAT(ParseBatchResponse(HttpResponse{200, absl::Cord(), {}}, 1),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+
+  // Invalid status line.
+  HttpResponse response{
+      200,
+      absl::Cord("--b\r\n"
+                 "Content-Type: application/http\r\n"
+                 "\r\n"
+                 "garbage\r\n"
+                 "--b--\r\n"),
+      HeaderMap{{"content-type", "multipart/mixed; boundary=b"}}};
+  EXPECT_THAT(ParseBatchResponse(response, 1),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace
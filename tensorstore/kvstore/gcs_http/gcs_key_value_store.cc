@@ -15,8 +15,11 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <string>
@@ -41,10 +44,10 @@
 #include "tensorstore/internal/concurrency_resource.h"
 #include "tensorstore/internal/data_copy_concurrency_resource.h"
 #include "tensorstore/internal/env.h"
-#include "tensorstore/internal/http/default_transport.h"
 #include "tensorstore/internal/http/http_request.h"
 #include "tensorstore/internal/http/http_response.h"
 #include "tensorstore/internal/http/http_transport.h"
+#include "tensorstore/internal/http/http_transport_resource.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json/json.h"
 #include "tensorstore/internal/json_binding/bindable.h"
@@ -54,30 +57,38 @@
 #include "tensorstore/internal/metrics/histogram.h"
 #include "tensorstore/internal/oauth2/auth_provider.h"
 #include "tensorstore/internal/path.h"
+#include "tensorstore/internal/rate_limiter/adaptive_admission_queue.h"
+#include "tensorstore/internal/rate_limiter/byte_rate_limiter.h"
 #include "tensorstore/internal/rate_limiter/rate_limiter.h"
 #include "tensorstore/internal/retries_context_resource.h"
 #include "tensorstore/internal/source_location.h"
 #include "tensorstore/internal/thread/schedule_at.h"
 #include "tensorstore/internal/uri_utils.h"
+#include "tensorstore/kvstore/adaptive_coalescing.h"
 #include "tensorstore/kvstore/batch_util.h"
 #include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/common_metrics.h"
 #include "tensorstore/kvstore/driver.h"
 #include "tensorstore/kvstore/gcs/gcs_resource.h"
 #include "tensorstore/kvstore/gcs/validate.h"
+#include "tensorstore/kvstore/gcs_http/batch_request.h"
 #include "tensorstore/kvstore/gcs_http/gcs_resource.h"
 #include "tensorstore/kvstore/gcs_http/object_metadata.h"
 #include "tensorstore/kvstore/gcs_http/shared_auth_provider.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/generic_coalescing_batch_util.h"
+#include "tensorstore/kvstore/hedged_read.h"
 #include "tensorstore/kvstore/http/byte_range_util.h"
+#include "tensorstore/kvstore/http/parallel_read.h"
 #include "tensorstore/kvstore/key_range.h"
 #include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/parallel_list.h"
 #include "tensorstore/kvstore/read_result.h"
 #include "tensorstore/kvstore/registry.h"
 #include "tensorstore/kvstore/spec.h"
 #include "tensorstore/kvstore/supported_features.h"
 #include "tensorstore/kvstore/url_registry.h"
+#include "tensorstore/util/division.h"
 #include "tensorstore/util/execution/any_receiver.h"
 #include "tensorstore/util/execution/execution.h"
 #include "tensorstore/util/executor.h"
@@ -85,6 +96,7 @@
 #include "tensorstore/util/garbage_collection/fwd.h"
 #include "tensorstore/util/quote_string.h"
 #include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
 #include "tensorstore/util/status.h"
 
 // specializations
@@ -110,6 +122,7 @@ ABSL_FLAG(std::optional<std::string>, tensorstore_gcs_http_version,
           "Url to used for http access to google cloud storage. "
           "Overrides TENSORSTORE_GCS_HTTP_VERSION.");
 
+using ::tensorstore::internal::ByteRateLimiter;
 using ::tensorstore::internal::DataCopyConcurrencyResource;
 using ::tensorstore::internal::GetFlagOrEnvValue;
 using ::tensorstore::internal::IntrusivePtr;
@@ -122,10 +135,13 @@ using ::tensorstore::internal_http::HttpRequestBuilder;
 using ::tensorstore::internal_http::HttpResponse;
 using ::tensorstore::internal_http::HttpTransport;
 using ::tensorstore::internal_http::IssueRequestOptions;
+using ::tensorstore::internal_kvstore_gcs_http::BuildBatchRequestBody;
 using ::tensorstore::internal_kvstore_gcs_http::GcsConcurrencyResource;
 using ::tensorstore::internal_kvstore_gcs_http::GcsRateLimiterResource;
 using ::tensorstore::internal_kvstore_gcs_http::GetSharedGoogleAuthProvider;
+using ::tensorstore::internal_kvstore_gcs_http::kMaxBatchRequests;
 using ::tensorstore::internal_kvstore_gcs_http::ObjectMetadata;
+using ::tensorstore::internal_kvstore_gcs_http::ParseBatchResponse;
 using ::tensorstore::internal_kvstore_gcs_http::ParseObjectMetadata;
 using ::tensorstore::internal_storage_gcs::GcsHttpResponseToStatus;
 using ::tensorstore::internal_storage_gcs::GcsRequestRetries;
@@ -243,6 +259,20 @@ std::string BucketResourceRoot(std::string_view bucket) {
   return absl::StrCat(GetGcsBaseUrl(), "/storage/", kVersion, "/b/", bucket);
 }
 
+// Composes the path of the resource root, relative to the base url, as used
+// within batch requests.
+std::string BucketResourcePath(std::string_view bucket) {
+  const char kVersion[] = "v1";
+  return absl::StrCat("/storage/", kVersion, "/b/", bucket);
+}
+
+// Composes the batch request uri for the GCS API.
+// https://cloud.google.com/storage/docs/batch
+std::string BatchRoot() {
+  const char kVersion[] = "v1";
+  return absl::StrCat(GetGcsBaseUrl(), "/batch/storage/", kVersion);
+}
+
 // Composes the resource upload root uri for the GCS API using the bucket
 // and constants for the host, api-version, etc.
 std::string BucketUploadRoot(std::string_view bucket) {
@@ -251,6 +281,38 @@ std::string BucketUploadRoot(std::string_view bucket) {
                       bucket);
 }
 
+/// Specifies when and how values are written as a parallel composite upload.
+struct GcsCompositeUploadOptions {
+  constexpr static int64_t kDefaultPartSize = 64 * 1024 * 1024;
+
+  /// Values larger than this are written as a composite upload.  By default,
+  /// composite uploads are not used.
+  int64_t threshold = std::numeric_limits<int64_t>::max();
+
+  /// Size of each part other than the last.  Increased as needed to stay
+  /// within the limit on the number of objects in a compose request.
+  int64_t part_size = kDefaultPartSize;
+
+  constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+    return f(x.threshold, x.part_size);
+  };
+
+  constexpr static auto default_json_binder = jb::Object(
+      jb::Member("threshold",
+                 jb::Projection<&GcsCompositeUploadOptions::threshold>(
+                     jb::DefaultValue<jb::kNeverIncludeDefaults>(
+                         [](auto* v) {
+                           *v = std::numeric_limits<int64_t>::max();
+                         },
+                         jb::Integer<int64_t>(0)))),
+      jb::Member("part_size",
+                 jb::Projection<&GcsCompositeUploadOptions::part_size>(
+                     jb::DefaultValue<jb::kNeverIncludeDefaults>(
+                         [](auto* v) { *v = kDefaultPartSize; },
+                         jb::Integer<int64_t>(1)))) /**/
+  );
+};
+
 struct GcsKeyValueStoreSpecData {
   std::string bucket;
 
@@ -259,10 +321,18 @@ struct GcsKeyValueStoreSpecData {
   Context::Resource<GcsUserProjectResource> user_project;
   Context::Resource<GcsRequestRetries> retries;
   Context::Resource<DataCopyConcurrencyResource> data_copy_concurrency;
+  internal_http::ParallelReadOptions parallel_read;
+  GcsCompositeUploadOptions composite_upload;
+  internal_kvstore::HedgedReadOptions hedged_read;
+  internal_kvstore::ParallelListOptions parallel_list;
+  internal::AdaptiveConcurrencyOptions adaptive_concurrency;
+  Context::Resource<internal_http::HttpTransportResource> http_transport;
 
   constexpr static auto ApplyMembers = [](auto& x, auto f) {
     return f(x.bucket, x.request_concurrency, x.rate_limiter, x.user_project,
-             x.retries, x.data_copy_concurrency);
+             x.retries, x.data_copy_concurrency, x.parallel_read,
+             x.composite_upload, x.hedged_read, x.parallel_list,
+             x.adaptive_concurrency, x.http_transport);
   };
 
   constexpr static auto default_json_binder = jb::Object(
@@ -293,7 +363,30 @@ struct GcsKeyValueStoreSpecData {
                  jb::Projection<&GcsKeyValueStoreSpecData::retries>()),
       jb::Member(DataCopyConcurrencyResource::id,
                  jb::Projection<
-                     &GcsKeyValueStoreSpecData::data_copy_concurrency>()) /**/
+                     &GcsKeyValueStoreSpecData::data_copy_concurrency>()),
+      jb::Member("parallel_read",
+                 jb::Projection<&GcsKeyValueStoreSpecData::parallel_read>(
+                     jb::DefaultInitializedValue<
+                         jb::kNeverIncludeDefaults>())),
+      jb::Member("composite_upload",
+                 jb::Projection<&GcsKeyValueStoreSpecData::composite_upload>(
+                     jb::DefaultInitializedValue<
+                         jb::kNeverIncludeDefaults>())),
+      jb::Member("hedged_read",
+                 jb::Projection<&GcsKeyValueStoreSpecData::hedged_read>(
+                     jb::DefaultInitializedValue<
+                         jb::kNeverIncludeDefaults>())),
+      jb::Member("parallel_list",
+                 jb::Projection<&GcsKeyValueStoreSpecData::parallel_list>(
+                     jb::DefaultInitializedValue<
+                         jb::kNeverIncludeDefaults>())),
+      jb::Member(
+          "adaptive_concurrency",
+          jb::Projection<&GcsKeyValueStoreSpecData::adaptive_concurrency>(
+              jb::DefaultInitializedValue<jb::kNeverIncludeDefaults>())),
+      jb::Member(
+          internal_http::HttpTransportResource::id,
+          jb::Projection<&GcsKeyValueStoreSpecData::http_transport>()) /**/
   );
 };
 
@@ -335,14 +428,21 @@ class GcsKeyValueStore
   // The upload_root is the url used to upload data to the GCS bucket.
   const std::string& upload_root() const { return upload_root_; }
 
+  // The url used for batch requests.
+  const std::string& batch_root() const { return batch_root_; }
+
+  // The path of `resource_root` within batch requests.
+  const std::string& batch_resource_path() const {
+    return batch_resource_path_;
+  }
+
   // The userProject field, or empty.
   const std::string& encoded_user_project() const {
     return encoded_user_project_;
   }
 
-  internal_kvstore_batch::CoalescingOptions GetBatchReadCoalescingOptions()
-      const {
-    return internal_kvstore_batch::kDefaultRemoteStorageCoalescingOptions;
+  internal_kvstore_batch::AdaptiveCoalescingOptions& batch_read_coalescing() {
+    return batch_read_coalescing_;
   }
 
   Future<ReadResult> Read(Key key, ReadOptions options) override;
@@ -355,8 +455,16 @@ class GcsKeyValueStore
 
   void ListImpl(ListOptions options, ListReceiver receiver) override;
 
+  // Lists `options.range` with a single sequence of paginated requests.  If
+  // `prefix_callback` is specified, the listing is delimited by `/`.
+  void StartList(ListOptions options, ListReceiver receiver,
+                 std::function<void(std::string)> prefix_callback);
+
   Future<const void> DeleteRange(KeyRange range) override;
 
+  // Deletes the objects `keys` with a single batch request.
+  Future<const void> BatchDelete(std::vector<std::string> keys);
+
   // Returns the Auth header for a GCS request.
   Result<std::optional<std::string>> GetAuthHeader() {
     absl::MutexLock lock(&auth_provider_mutex_);
@@ -395,7 +503,24 @@ class GcsKeyValueStore
     return no_rate_limiter_;
   }
 
-  RateLimiter& admission_queue() { return *spec_.request_concurrency->queue; }
+  // Bandwidth limits, or null if unlimited.
+  std::shared_ptr<ByteRateLimiter> read_bytes_limiter() {
+    if (spec_.rate_limiter.has_value()) {
+      return spec_.rate_limiter.value()->read_bytes_limiter;
+    }
+    return nullptr;
+  }
+  std::shared_ptr<ByteRateLimiter> write_bytes_limiter() {
+    if (spec_.rate_limiter.has_value()) {
+      return spec_.rate_limiter.value()->write_bytes_limiter;
+    }
+    return nullptr;
+  }
+
+  RateLimiter& admission_queue() {
+    if (adaptive_queue_) return *adaptive_queue_;
+    return *spec_.request_concurrency->queue;
+  }
 
   absl::Status GetBoundSpecData(SpecData& spec) const {
     spec = spec_;
@@ -421,6 +546,9 @@ class GcsKeyValueStore
       absl::Status status, int attempt, Task* task,
       SourceLocation loc = ::tensorstore::SourceLocation::current()) {
     assert(task != nullptr);
+    if (adaptive_queue_ && internal::IsThrottled(status)) {
+      adaptive_queue_->OnThrottled();
+    }
     auto delay = spec_.retries->BackoffForAttempt(attempt);
     if (!delay) {
       return MaybeAnnotateStatus(std::move(status),
@@ -441,10 +569,18 @@ class GcsKeyValueStore
   SpecData spec_;
   std::string resource_root_;  // bucket resource root.
   std::string upload_root_;    // bucket upload root.
+  std::string batch_root_;     // batch request root.
+  std::string batch_resource_path_;
   std::string encoded_user_project_;
   NoRateLimiter no_rate_limiter_;
+  internal_kvstore_batch::AdaptiveCoalescingOptions batch_read_coalescing_{
+      internal_kvstore_batch::kDefaultRemoteStorageCoalescingOptions, "gcs"};
 
   std::shared_ptr<HttpTransport> transport_;
+  // Per-bucket concurrency limit, if `adaptive_concurrency` is enabled.
+  std::shared_ptr<internal::AdaptiveAdmissionQueue> adaptive_queue_;
+  std::shared_ptr<internal_kvstore::HedgedReadTracker> hedged_read_tracker_ =
+      std::make_shared<internal_kvstore::HedgedReadTracker>();
   absl::Mutex auth_provider_mutex_;
   // Optional state indicates whether the provider has been obtained.  A
   // nullptr provider is valid and indicates to use anonymous access.
@@ -456,13 +592,22 @@ Future<kvstore::DriverPtr> GcsKeyValueStoreSpec::DoOpen() const {
   driver->spec_ = data_;
   driver->resource_root_ = BucketResourceRoot(data_.bucket);
   driver->upload_root_ = BucketUploadRoot(data_.bucket);
-  driver->transport_ = internal_http::GetDefaultHttpTransport();
+  driver->batch_root_ = BatchRoot();
+  driver->batch_resource_path_ = BucketResourcePath(data_.bucket);
+  driver->transport_ = data_.http_transport->GetTransport();
+  data_.http_transport->PrewarmConnections(driver->resource_root_);
 
   // NOTE: Remove temporary logging use of experimental feature.
   if (data_.rate_limiter.has_value()) {
     ABSL_LOG_IF(INFO, gcs_http_logging)
         << "Using experimental_gcs_rate_limiter";
   }
+  if (data_.adaptive_concurrency.enabled) {
+    driver->adaptive_queue_ =
+        std::make_shared<internal::AdaptiveAdmissionQueue>(
+            data_.adaptive_concurrency,
+            data_.request_concurrency->queue->limit());
+  }
   if (const auto& project_id = data_.user_project->project_id) {
     driver->encoded_user_project_ =
         internal::PercentEncodeUriComponent(*project_id);
@@ -470,6 +615,24 @@ Future<kvstore::DriverPtr> GcsKeyValueStoreSpec::DoOpen() const {
   return driver;
 }
 
+// Returns a random 128-bit value as a hex string.
+std::string GetRandomHexString() {
+  struct RandomState {
+    absl::Mutex mutex;
+    absl::BitGen gen ABSL_GUARDED_BY(mutex);
+  };
+  static RandomState random_state;
+  uint64_t uuid[2];
+  {
+    absl::MutexLock lock(&random_state.mutex);
+    for (auto& x : uuid) {
+      x = absl::Uniform<uint64_t>(random_state.gen);
+    }
+  }
+  return absl::StrCat(absl::Hex(uuid[0], absl::kZeroPad16),
+                      absl::Hex(uuid[1], absl::kZeroPad16));
+}
+
 // GCS does not follow HTTP spec as far as respecting `cache-control` request
 // headers.
 //
@@ -482,18 +645,7 @@ Future<kvstore::DriverPtr> GcsKeyValueStoreSpec::DoOpen() const {
 // As a workaround, specify a unique query parameter in every request.  That
 // ensures the cache is bypassed.
 void AddUniqueQueryParameterToDisableCaching(std::string& url) {
-  struct RandomState {
-    absl::Mutex mutex;
-    absl::BitGen gen ABSL_GUARDED_BY(mutex);
-  };
-  static RandomState random_state;
-  uint64_t uuid[2];
-  absl::MutexLock lock(&random_state.mutex);
-  for (auto& x : uuid) {
-    x = absl::Uniform<uint64_t>(random_state.gen);
-  }
-  absl::StrAppend(&url, "&tensorstore=", absl::Hex(uuid[0], absl::kZeroPad16),
-                  absl::Hex(uuid[1], absl::kZeroPad16));
+  absl::StrAppend(&url, "&tensorstore=", GetRandomHexString());
 }
 
 ////////////////////////////////////////////////////
@@ -505,16 +657,21 @@ struct ReadTask : public RateLimiterNode,
   IntrusivePtr<GcsKeyValueStore> owner;
   std::string resource;
   kvstore::ReadOptions options;
+  // Set when the read is one part of a `ParallelRead`.
+  std::shared_ptr<internal_http::ReadPart> part;
   Promise<kvstore::ReadResult> promise;
 
   int attempt_ = 0;
   absl::Time start_time_;
 
   ReadTask(IntrusivePtr<GcsKeyValueStore> owner, std::string resource,
-           kvstore::ReadOptions options, Promise<kvstore::ReadResult> promise)
+           kvstore::ReadOptions options,
+           std::shared_ptr<internal_http::ReadPart> part,
+           Promise<kvstore::ReadResult> promise)
       : owner(std::move(owner)),
         resource(std::move(resource)),
         options(std::move(options)),
+        part(std::move(part)),
         promise(std::move(promise)) {}
 
   ~ReadTask() { owner->admission_queue().Finish(this); }
@@ -522,6 +679,12 @@ struct ReadTask : public RateLimiterNode,
   static void Start(RateLimiterNode* task) {
     auto* self = static_cast<ReadTask*>(task);
     self->owner->read_rate_limiter().Finish(self);
+    ByteRateLimiter::MaybeAdmit(self->owner->read_bytes_limiter().get(), self,
+                                &ReadTask::StartRequest);
+  }
+
+  static void StartRequest(RateLimiterNode* task) {
+    auto* self = static_cast<ReadTask*>(task);
     self->owner->admission_queue().Admit(self, &ReadTask::Admit);
   }
 
@@ -572,12 +735,23 @@ struct ReadTask : public RateLimiterNode,
     start_time_ = absl::Now();
 
     ABSL_LOG_IF(INFO, gcs_http_logging) << "ReadTask: " << request;
-    auto future = owner->transport_->IssueRequest(
-        request, IssueRequestOptions().SetHttpVersion(GetHttpVersion()));
-    future.ExecuteWhenReady([self = IntrusivePtr<ReadTask>(this)](
-                                ReadyFuture<HttpResponse> response) {
-      self->OnResponse(response.result());
-    });
+    auto request_options =
+        IssueRequestOptions().SetHttpVersion(GetHttpVersion());
+    if (auto limiter = owner->read_bytes_limiter()) {
+      request_options.response_body_callback =
+          [limiter = std::move(limiter)](size_t n) { limiter->Charge(n); };
+    }
+    auto future =
+        owner->transport_->IssueRequest(request, std::move(request_options));
+    // The link is unregistered if the result is no longer needed, which
+    // releases `future` and allows the transport to abort the request.
+    Link(
+        [self = IntrusivePtr<ReadTask>(this)](
+            Promise<kvstore::ReadResult> promise,
+            ReadyFuture<HttpResponse> response) {
+          self->OnResponse(response.result());
+        },
+        promise, std::move(future));
   }
 
   void OnResponse(const Result<HttpResponse>& response) {
@@ -617,7 +791,7 @@ struct ReadTask : public RateLimiterNode,
   Result<kvstore::ReadResult> FinishResponse(const HttpResponse& httpresponse) {
     gcs_metrics.bytes_read.IncrementBy(httpresponse.payload.size());
     auto latency = absl::Now() - start_time_;
-    gcs_metrics.read_latency_ms.Observe(absl::ToInt64Milliseconds(latency));
+    gcs_metrics.read_latency_ms.Observe(absl::ToDoubleMilliseconds(latency));
 
     // Parse `Date` header from response to correctly handle cached responses.
     // The GCS servers always send a `date` header.
@@ -642,12 +816,17 @@ struct ReadTask : public RateLimiterNode,
     absl::Cord value;
     ObjectMetadata metadata;
     if (options.byte_range.size() != 0) {
-      // Currently unused
-      ByteRange byte_range;
-      int64_t total_size;
+      if (part) {
+        TENSORSTORE_RETURN_IF_ERROR(internal_http::ValidateReadPartResponse(
+            httpresponse, options.byte_range, *part, value));
+      } else {
+        // Currently unused
+        ByteRange byte_range;
+        int64_t total_size;
 
-      TENSORSTORE_RETURN_IF_ERROR(internal_http::ValidateResponseByteRange(
-          httpresponse, options.byte_range, value, byte_range, total_size));
+        TENSORSTORE_RETURN_IF_ERROR(internal_http::ValidateResponseByteRange(
+            httpresponse, options.byte_range, value, byte_range, total_size));
+      }
       // TODO: Avoid parsing the entire metadata & only extract the
       // generation field.
       SetObjectMetadataFromHeaders(httpresponse.headers, &metadata);
@@ -682,19 +861,33 @@ Future<kvstore::ReadResult> GcsKeyValueStore::Read(Key key,
 
 Future<kvstore::ReadResult> GcsKeyValueStore::ReadImpl(Key&& key,
                                                        ReadOptions&& options) {
-  gcs_metrics.batch_read.Increment();
   auto encoded_object_name = internal::PercentEncodeUriComponent(key);
   std::string resource = tensorstore::internal::JoinPath(resource_root_, "/o/",
                                                          encoded_object_name);
-
-  auto op = PromiseFuturePair<ReadResult>::Make();
-  auto state = internal::MakeIntrusivePtr<ReadTask>(
-      internal::IntrusivePtr<GcsKeyValueStore>(this), std::move(resource),
-      std::move(options), std::move(op.promise));
-
-  intrusive_ptr_increment(state.get());  // adopted by ReadTask::Start.
-  read_rate_limiter().Admit(state.get(), &ReadTask::Start);
-  return std::move(op.future);
+  return internal_http::ParallelRead(
+      std::move(options), spec_.parallel_read,
+      [self = internal::IntrusivePtr<GcsKeyValueStore>(this),
+       resource = std::move(resource)](
+          ReadOptions options, std::shared_ptr<internal_http::ReadPart> part) {
+        auto read = [self, resource, options = std::move(options), part] {
+          gcs_metrics.batch_read.Increment();
+          auto op = PromiseFuturePair<ReadResult>::Make();
+          auto state = internal::MakeIntrusivePtr<ReadTask>(
+              self, resource, options, part, std::move(op.promise));
+
+          intrusive_ptr_increment(state.get());  // adopted by ReadTask::Start.
+          self->read_rate_limiter().Admit(state.get(), &ReadTask::Start);
+          return std::move(op.future);
+        };
+        if (part) {
+          // The first part of a parallel read records the size of the object
+          // in `part`, and is not hedged.
+          return read();
+        }
+        return internal_kvstore::HedgedRead(self->spec_.hedged_read,
+                                            self->hedged_read_tracker_,
+                                            self->executor(), std::move(read));
+      });
 }
 
 // A WriteTask is a function object used to satisfy a
@@ -725,6 +918,11 @@ struct WriteTask : public RateLimiterNode,
   static void Start(RateLimiterNode* task) {
     auto* self = static_cast<WriteTask*>(task);
     self->owner->write_rate_limiter().Finish(self);
+    ByteRateLimiter::MaybeAdmit(self->owner->write_bytes_limiter().get(), self,
+                                &WriteTask::StartRequest);
+  }
+  static void StartRequest(RateLimiterNode* task) {
+    auto* self = static_cast<WriteTask*>(task);
     self->owner->admission_queue().Admit(self, &WriteTask::Admit);
   }
   static void Admit(RateLimiterNode* task) {
@@ -772,6 +970,9 @@ struct WriteTask : public RateLimiterNode,
     ABSL_LOG_IF(INFO, gcs_http_logging)
         << "WriteTask: " << request << " size=" << value.size();
 
+    if (auto limiter = owner->write_bytes_limiter()) {
+      limiter->Charge(value.size());
+    }
     auto future = owner->transport_->IssueRequest(
         request, IssueRequestOptions(value).SetHttpVersion(GetHttpVersion()));
     future.ExecuteWhenReady([self = IntrusivePtr<WriteTask>(this)](
@@ -843,7 +1044,7 @@ struct WriteTask : public RateLimiterNode,
     }
 
     auto latency = absl::Now() - start_time_;
-    gcs_metrics.write_latency_ms.Observe(absl::ToInt64Milliseconds(latency));
+    gcs_metrics.write_latency_ms.Observe(absl::ToDoubleMilliseconds(latency));
     gcs_metrics.bytes_written.IncrementBy(value.size());
 
     // TODO: Avoid parsing the entire metadata & only extract the
@@ -858,6 +1059,246 @@ struct WriteTask : public RateLimiterNode,
   }
 };
 
+// A CompositeUploadTask writes a value larger than the `composite_upload`
+// threshold as temporary objects, uploaded concurrently by WriteTasks, which
+// are then combined by a compose request that carries the write conditions.
+// The temporary objects are deleted afterwards.
+// https://cloud.google.com/storage/docs/parallel-composite-uploads
+struct CompositeUploadTask
+    : public internal::AtomicReferenceCount<CompositeUploadTask> {
+  // Maximum number of source objects of a compose request.
+  // https://cloud.google.com/storage/docs/json_api/v1/objects/compose
+  constexpr static int64_t kMaxComposeParts = 32;
+
+  IntrusivePtr<GcsKeyValueStore> owner;
+  std::string encoded_object_name;
+  kvstore::WriteOptions options;
+  Promise<TimestampedStorageGeneration> promise;
+
+  std::vector<std::string> part_names_;
+  std::vector<uint64_t> part_generations_;
+  int64_t size_ = 0;
+  int attempt_ = 0;
+  absl::Time start_time_;
+
+  CompositeUploadTask(IntrusivePtr<GcsKeyValueStore> owner,
+                      std::string encoded_object_name,
+                      kvstore::WriteOptions options,
+                      Promise<TimestampedStorageGeneration> promise)
+      : owner(std::move(owner)),
+        encoded_object_name(std::move(encoded_object_name)),
+        options(std::move(options)),
+        promise(std::move(promise)) {}
+
+  // Uploads each part of `value` as a temporary object named after `key`.
+  void UploadParts(std::string_view key, absl::Cord value) {
+    size_ = value.size();
+    const int64_t part_size =
+        std::max(owner->spec_.composite_upload.part_size,
+                 CeilOfRatio(size_, kMaxComposeParts));
+    absl::BitGen gen;
+    const std::string prefix =
+        absl::StrFormat("%s.composite-%016x-", key, absl::Uniform<uint64_t>(gen));
+
+    // Temporary objects must not already exist.
+    kvstore::WriteOptions part_options;
+    part_options.generation_conditions.if_equal = StorageGeneration::NoValue();
+
+    std::vector<Future<TimestampedStorageGeneration>> parts;
+    for (int64_t offset = 0; offset < size_; offset += part_size) {
+      part_names_.push_back(absl::StrCat(prefix, parts.size()));
+      auto op = PromiseFuturePair<TimestampedStorageGeneration>::Make();
+      auto state = internal::MakeIntrusivePtr<WriteTask>(
+          owner, internal::PercentEncodeUriComponent(part_names_.back()),
+          value.Subcord(offset, part_size), part_options,
+          std::move(op.promise));
+      parts.push_back(std::move(op.future));
+
+      intrusive_ptr_increment(state.get());  // adopted by WriteTask::Start.
+      owner->write_rate_limiter().Admit(state.get(), &WriteTask::Start);
+    }
+
+    auto all_ready = WaitAllFuture(tensorstore::span(parts));
+    all_ready.ExecuteWhenReady(
+        [self = IntrusivePtr<CompositeUploadTask>(this),
+         parts = std::move(parts)](ReadyFuture<void> ready) {
+          self->OnPartsUploaded(parts, ready.status());
+        });
+  }
+
+  void OnPartsUploaded(
+      tensorstore::span<const Future<TimestampedStorageGeneration>> parts,
+      const absl::Status& status) {
+    if (!promise.result_needed()) {
+      DeleteParts();
+      return;
+    }
+    if (!status.ok()) {
+      DeleteParts();
+      promise.SetResult(status);
+      return;
+    }
+    for (const auto& part : parts) {
+      const auto& generation = part.value().generation;
+      if (!StorageGeneration::IsUint64(generation)) {
+        // The temporary object already existed.
+        DeleteParts();
+        promise.SetResult(absl::AbortedError(
+            "Temporary object of composite upload already exists"));
+        return;
+      }
+      part_generations_.push_back(StorageGeneration::ToUint64(generation));
+    }
+    Retry();
+  }
+
+  // Issues (or retries) the compose request.
+  void Retry() {
+    if (!promise.result_needed()) {
+      DeleteParts();
+      return;
+    }
+    std::string compose_url = absl::StrCat(owner->resource_root(), "/o/",
+                                           encoded_object_name, "/compose");
+    bool has_query =
+        AddGenerationParam(&compose_url, false, "ifGenerationMatch",
+                           options.generation_conditions.if_equal);
+    AddUserProjectParam(&compose_url, has_query, owner->encoded_user_project());
+
+    auto maybe_auth_header = owner->GetAuthHeader();
+    if (!maybe_auth_header.ok()) {
+      DeleteParts();
+      promise.SetResult(maybe_auth_header.status());
+      return;
+    }
+
+    ::nlohmann::json::array_t source_objects;
+    for (size_t i = 0; i < part_names_.size(); ++i) {
+      source_objects.push_back(
+          {{"name", part_names_[i]},
+           {"objectPreconditions",
+            {{"ifGenerationMatch", part_generations_[i]}}}});
+    }
+    absl::Cord body(::nlohmann::json{
+        {"sourceObjects", std::move(source_objects)},
+        {"destination", {{"contentType", "application/octet-stream"}}},
+    }.dump());
+
+    HttpRequestBuilder request_builder("POST", compose_url);
+    if (maybe_auth_header.value().has_value()) {
+      request_builder.ParseAndAddHeader(*maybe_auth_header.value());
+    }
+    auto request =
+        request_builder.AddHeader("content-type", "application/json")
+            .AddHeader("content-length", absl::StrCat(body.size()))
+            .BuildRequest();
+    start_time_ = absl::Now();
+
+    ABSL_LOG_IF(INFO, gcs_http_logging)
+        << "CompositeUploadTask: " << request
+        << " parts=" << part_names_.size();
+
+    auto future = owner->transport_->IssueRequest(
+        request, IssueRequestOptions(std::move(body))
+                     .SetHttpVersion(GetHttpVersion()));
+    future.ExecuteWhenReady([self = IntrusivePtr<CompositeUploadTask>(this)](
+                                ReadyFuture<HttpResponse> response) {
+      self->OnResponse(response.result());
+    });
+  }
+
+  void OnResponse(const Result<HttpResponse>& response) {
+    if (!promise.result_needed()) {
+      DeleteParts();
+      return;
+    }
+    ABSL_LOG_IF(INFO, gcs_http_logging.Level(1) && response.ok())
+        << "CompositeUploadTask " << *response;
+
+    bool is_retryable = IsRetriable(response.status());
+    absl::Status status = [&]() -> absl::Status {
+      if (!response.ok()) return response.status();
+      switch (response.value().status_code) {
+        case 304:
+        case 412:
+          // The generation did not match.
+          return absl::OkStatus();
+        case 404:
+          if (!options.generation_conditions.MatchesNoValue()) {
+            return absl::OkStatus();
+          }
+          break;
+        default:
+          break;
+      }
+      return GcsHttpResponseToStatus(response.value(), is_retryable);
+    }();
+
+    if (!status.ok() && is_retryable) {
+      status =
+          owner->BackoffForAttemptAsync(std::move(status), attempt_++, this);
+      if (status.ok()) {
+        return;
+      }
+    }
+    DeleteParts();
+    if (!status.ok()) {
+      promise.SetResult(status);
+    } else {
+      promise.SetResult(FinishResponse(response.value()));
+    }
+  }
+
+  Result<TimestampedStorageGeneration> FinishResponse(
+      const HttpResponse& httpresponse) {
+    TimestampedStorageGeneration r;
+    r.time = start_time_;
+    switch (httpresponse.status_code) {
+      case 304:
+      case 412:
+        r.generation = StorageGeneration::Unknown();
+        return r;
+      case 404:
+        if (!StorageGeneration::IsUnknown(
+                options.generation_conditions.if_equal)) {
+          r.generation = StorageGeneration::Unknown();
+          return r;
+        }
+    }
+
+    auto latency = absl::Now() - start_time_;
+    gcs_metrics.write_latency_ms.Observe(absl::ToDoubleMilliseconds(latency));
+
+    auto payload = httpresponse.payload;
+    auto parsed_object_metadata = ParseObjectMetadata(payload.Flatten());
+    TENSORSTORE_RETURN_IF_ERROR(parsed_object_metadata);
+
+    r.generation =
+        StorageGeneration::FromUint64(parsed_object_metadata->generation);
+    return r;
+  }
+
+  // Deletes the temporary objects.  Failures are ignored; leftover objects
+  // may also be removed by a bucket lifecycle rule.
+  void DeleteParts() {
+    auto maybe_auth_header = owner->GetAuthHeader();
+    for (const auto& name : std::exchange(part_names_, {})) {
+      std::string delete_url =
+          absl::StrCat(owner->resource_root(), "/o/",
+                       internal::PercentEncodeUriComponent(name));
+      AddUserProjectParam(&delete_url, false, owner->encoded_user_project());
+      HttpRequestBuilder request_builder("DELETE", delete_url);
+      if (maybe_auth_header.ok() && maybe_auth_header.value().has_value()) {
+        request_builder.ParseAndAddHeader(*maybe_auth_header.value());
+      }
+      owner->transport_
+          ->IssueRequest(request_builder.BuildRequest(),
+                         IssueRequestOptions().SetHttpVersion(GetHttpVersion()))
+          .IgnoreFuture();
+    }
+  }
+};
+
 // A DeleteTask is a function object used to satisfy a
 // GcsKeyValueStore::Delete request.
 struct DeleteTask : public RateLimiterNode,
@@ -1002,7 +1443,13 @@ Future<TimestampedStorageGeneration> GcsKeyValueStore::Write(
   std::string encoded_object_name = internal::PercentEncodeUriComponent(key);
   auto op = PromiseFuturePair<TimestampedStorageGeneration>::Make();
 
-  if (value) {
+  if (value && static_cast<int64_t>(value->size()) >
+                   spec_.composite_upload.threshold) {
+    auto state = internal::MakeIntrusivePtr<CompositeUploadTask>(
+        IntrusivePtr<GcsKeyValueStore>(this), std::move(encoded_object_name),
+        std::move(options), std::move(op.promise));
+    state->UploadParts(key, *std::move(value));
+  } else if (value) {
     auto state = internal::MakeIntrusivePtr<WriteTask>(
         IntrusivePtr<GcsKeyValueStore>(this), std::move(encoded_object_name),
         *std::move(value), std::move(options), std::move(op.promise));
@@ -1027,6 +1474,7 @@ Future<TimestampedStorageGeneration> GcsKeyValueStore::Write(
 struct GcsListResponsePayload {
   std::string next_page_token;        // used to page through list results.
   std::vector<ObjectMetadata> items;  // individual result metadata.
+  std::vector<std::string> prefixes;  // common prefixes, with a delimiter.
 };
 
 constexpr static auto GcsListResponsePayloadBinder = jb::Object(
@@ -1035,15 +1483,25 @@ constexpr static auto GcsListResponsePayloadBinder = jb::Object(
                               jb::DefaultInitializedValue())),
     jb::Member("items", jb::Projection(&GcsListResponsePayload::items,
                                        jb::DefaultInitializedValue())),
+    jb::Member("prefixes", jb::Projection(&GcsListResponsePayload::prefixes,
+                                          jb::DefaultInitializedValue())),
     jb::DiscardExtraMembers);
 
 // ListTask implements the ListImpl execution flow.
+//
+// The request for each page is issued before the entries of the previous page
+// are delivered, so that fetching the next page overlaps with delivering the
+// current one.  Responses are handled one at a time under `mutex_`, which
+// preserves the order of the entries.
 struct ListTask : public RateLimiterNode,
                   public internal::AtomicReferenceCount<ListTask> {
   internal::IntrusivePtr<GcsKeyValueStore> owner_;
   ListOptions options_;
   ListReceiver receiver_;
   std::string resource_;
+  // If set, the listing is delimited by `/`, and common prefixes are passed
+  // to `prefix_callback_`.
+  std::function<void(std::string)> prefix_callback_;
 
   std::string base_list_url_;
   std::string next_page_token_;
@@ -1051,13 +1509,18 @@ struct ListTask : public RateLimiterNode,
   bool has_query_parameters_;
   std::atomic<bool> cancelled_{false};
 
+  absl::Mutex mutex_;
+  bool done_ ABSL_GUARDED_BY(mutex_) = false;
+
   ListTask(internal::IntrusivePtr<GcsKeyValueStore>&& owner,
            ListOptions&& options, ListReceiver&& receiver,
-           std::string&& resource)
+           std::string&& resource,
+           std::function<void(std::string)> prefix_callback)
       : owner_(std::move(owner)),
         options_(std::move(options)),
         receiver_(std::move(receiver)),
-        resource_(std::move(resource)) {
+        resource_(std::move(resource)),
+        prefix_callback_(std::move(prefix_callback)) {
     // Construct the base LIST url. This will be modified to include the
     // nextPageToken
     base_list_url_ = resource_;
@@ -1077,6 +1540,16 @@ struct ListTask : public RateLimiterNode,
           "endOffset=", internal::PercentEncodeUriComponent(exclusive_max));
       has_query_parameters_ = true;
     }
+    if (prefix_callback_) {
+      if (auto prefix = LongestPrefix(options_.range); !prefix.empty()) {
+        absl::StrAppend(&base_list_url_, (has_query_parameters_ ? "&" : "?"),
+                        "prefix=", internal::PercentEncodeUriComponent(prefix));
+        has_query_parameters_ = true;
+      }
+      absl::StrAppend(&base_list_url_, (has_query_parameters_ ? "&" : "?"),
+                      "delimiter=%2F");
+      has_query_parameters_ = true;
+    }
   }
 
   ~ListTask() { owner_->admission_queue().Finish(this); }
@@ -1104,28 +1577,26 @@ struct ListTask : public RateLimiterNode,
   void Retry() { IssueRequest(); }
 
   void IssueRequest() {
-    if (is_cancelled()) {
-      execution::set_done(receiver_);
-      execution::set_stopping(receiver_);
-      return;
+    absl::Status status =
+        is_cancelled() ? absl::CancelledError() : SendRequest();
+    if (!status.ok()) {
+      absl::MutexLock lock(&mutex_);
+      Finish(std::move(status));
     }
+  }
 
+  absl::Status SendRequest() {
     std::string list_url = base_list_url_;
     if (!next_page_token_.empty()) {
       absl::StrAppend(&list_url, (has_query_parameters_ ? "&" : "?"),
                       "pageToken=", next_page_token_);
     }
 
-    auto auth_header = owner_->GetAuthHeader();
-    if (!auth_header.ok()) {
-      execution::set_error(receiver_, std::move(auth_header).status());
-      execution::set_stopping(receiver_);
-      return;
-    }
+    TENSORSTORE_ASSIGN_OR_RETURN(auto auth_header, owner_->GetAuthHeader());
 
     HttpRequestBuilder request_builder("GET", list_url);
-    if (auth_header->has_value()) {
-      request_builder.ParseAndAddHeader(auth_header->value());
+    if (auth_header.has_value()) {
+      request_builder.ParseAndAddHeader(auth_header.value());
     }
 
     auto request = request_builder.BuildRequest();
@@ -1138,24 +1609,34 @@ struct ListTask : public RateLimiterNode,
                                 ReadyFuture<HttpResponse> response) {
           self->OnResponse(response.result());
         }));
+    return absl::OkStatus();
+  }
+
+  // Completes the receiver, unless it has already been completed.
+  void Finish(absl::Status status) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    if (done_) return;
+    done_ = true;
+    if (status.ok() || absl::IsCancelled(status)) {
+      execution::set_done(receiver_);
+    } else {
+      execution::set_error(receiver_, std::move(status));
+    }
+    execution::set_stopping(receiver_);
   }
 
   void OnResponse(const Result<HttpResponse>& response) {
+    absl::MutexLock lock(&mutex_);
+    // A response to a request issued before the listing stopped is ignored.
+    if (done_) return;
     auto status = OnResponseImpl(response);
     // OkStatus are handled by OnResponseImpl
-    if (absl::IsCancelled(status)) {
-      execution::set_done(receiver_);
-      execution::set_stopping(receiver_);
-      return;
-    }
     if (!status.ok()) {
-      execution::set_error(receiver_, std::move(status));
-      execution::set_stopping(receiver_);
-      return;
+      Finish(std::move(status));
     }
   }
 
-  absl::Status OnResponseImpl(const Result<HttpResponse>& response) {
+  absl::Status OnResponseImpl(const Result<HttpResponse>& response)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
     if (is_cancelled()) {
       return absl::CancelledError();
     }
@@ -1180,6 +1661,16 @@ struct ListTask : public RateLimiterNode,
     TENSORSTORE_ASSIGN_OR_RETURN(
         auto parsed_payload,
         jb::FromJson<GcsListResponsePayload>(j, GcsListResponsePayloadBinder));
+
+    // Successful request, so clear the retry_attempt for the next request.
+    attempt_ = 0;
+    next_page_token_ = std::move(parsed_payload.next_page_token);
+    const bool has_next_page = !next_page_token_.empty();
+    if (has_next_page) {
+      // Fetch the next page while the entries of this page are delivered.
+      TENSORSTORE_RETURN_IF_ERROR(SendRequest());
+    }
+
     for (auto& metadata : parsed_payload.items) {
       if (is_cancelled()) {
         return absl::CancelledError();
@@ -1194,15 +1685,14 @@ struct ListTask : public RateLimiterNode,
                                ListEntry::checked_size(metadata.size),
                            });
     }
+    if (prefix_callback_) {
+      for (auto& prefix : parsed_payload.prefixes) {
+        prefix_callback_(std::move(prefix));
+      }
+    }
 
-    // Successful request, so clear the retry_attempt for the next request.
-    attempt_ = 0;
-    next_page_token_ = std::move(parsed_payload.next_page_token);
-    if (!next_page_token_.empty()) {
-      IssueRequest();
-    } else {
-      execution::set_done(receiver_);
-      execution::set_stopping(receiver_);
+    if (!has_next_page) {
+      Finish(absl::OkStatus());
     }
     return absl::OkStatus();
   }
@@ -1216,21 +1706,197 @@ void GcsKeyValueStore::ListImpl(ListOptions options, ListReceiver receiver) {
     execution::set_stopping(receiver);
     return;
   }
+  if (spec_.parallel_list.enabled()) {
+    internal_kvstore::ParallelList(
+        spec_.parallel_list, std::move(options), std::move(receiver),
+        [self = IntrusivePtr<GcsKeyValueStore>(this)](
+            std::string prefix,
+            std::function<void(std::string)> prefix_callback,
+            ListReceiver receiver) {
+          ListOptions options;
+          options.range = KeyRange::Prefix(std::move(prefix));
+          self->StartList(std::move(options), std::move(receiver),
+                          std::move(prefix_callback));
+        },
+        [self = IntrusivePtr<GcsKeyValueStore>(this)](ListOptions options,
+                                                      ListReceiver receiver) {
+          self->StartList(std::move(options), std::move(receiver), nullptr);
+        });
+    return;
+  }
+  StartList(std::move(options), std::move(receiver), nullptr);
+}
 
+void GcsKeyValueStore::StartList(
+    ListOptions options, ListReceiver receiver,
+    std::function<void(std::string)> prefix_callback) {
   auto state = internal::MakeIntrusivePtr<ListTask>(
       IntrusivePtr<GcsKeyValueStore>(this), std::move(options),
       std::move(receiver),
-      /*resource=*/tensorstore::internal::JoinPath(resource_root_, "/o"));
+      /*resource=*/tensorstore::internal::JoinPath(resource_root_, "/o"),
+      std::move(prefix_callback));
 
   intrusive_ptr_increment(state.get());  // adopted by ListTask::Start.
   read_rate_limiter().Admit(state.get(), &ListTask::Start);
 }
 
+// A BatchDeleteTask deletes a batch of objects with a single batch request,
+// subject to the same rate limiter and admission queue as other writes.
+// https://cloud.google.com/storage/docs/batch
+struct BatchDeleteTask
+    : public RateLimiterNode,
+      public internal::AtomicReferenceCount<BatchDeleteTask> {
+  IntrusivePtr<GcsKeyValueStore> owner;
+  std::vector<std::string> encoded_object_names_;
+  Promise<void> promise;
+
+  int attempt_ = 0;
+
+  BatchDeleteTask(IntrusivePtr<GcsKeyValueStore> owner,
+                  std::vector<std::string> encoded_object_names,
+                  Promise<void> promise)
+      : owner(std::move(owner)),
+        encoded_object_names_(std::move(encoded_object_names)),
+        promise(std::move(promise)) {}
+
+  ~BatchDeleteTask() { owner->admission_queue().Finish(this); }
+
+  static void Start(RateLimiterNode* task) {
+    auto* self = static_cast<BatchDeleteTask*>(task);
+    self->owner->write_rate_limiter().Finish(self);
+    self->owner->admission_queue().Admit(self, &BatchDeleteTask::Admit);
+  }
+
+  static void Admit(RateLimiterNode* task) {
+    auto* self = static_cast<BatchDeleteTask*>(task);
+    self->owner->executor()([state = IntrusivePtr<BatchDeleteTask>(
+                                 self, internal::adopt_object_ref)] {
+      state->Retry();
+    });
+  }
+
+  void Retry() {
+    if (!promise.result_needed()) {
+      return;
+    }
+    std::vector<std::string> requests;
+    requests.reserve(encoded_object_names_.size());
+    for (const auto& name : encoded_object_names_) {
+      std::string request =
+          absl::StrCat("DELETE ", owner->batch_resource_path(), "/o/", name);
+      AddUserProjectParam(&request, false, owner->encoded_user_project());
+      requests.push_back(std::move(request));
+    }
+    std::string boundary = absl::StrCat("batch_", GetRandomHexString());
+    absl::Cord body(BuildBatchRequestBody(requests, boundary));
+
+    auto maybe_auth_header = owner->GetAuthHeader();
+    if (!maybe_auth_header.ok()) {
+      promise.SetResult(maybe_auth_header.status());
+      return;
+    }
+    HttpRequestBuilder request_builder("POST", owner->batch_root());
+    if (maybe_auth_header.value().has_value()) {
+      request_builder.ParseAndAddHeader(*maybe_auth_header.value());
+    }
+    auto request =
+        request_builder
+            .AddHeader("content-type",
+                       absl::StrCat("multipart/mixed; boundary=", boundary))
+            .AddHeader("content-length", absl::StrCat(body.size()))
+            .BuildRequest();
+
+    ABSL_LOG_IF(INFO, gcs_http_logging)
+        << "BatchDeleteTask: " << request
+        << " objects=" << encoded_object_names_.size();
+
+    auto future = owner->transport_->IssueRequest(
+        request,
+        IssueRequestOptions(std::move(body)).SetHttpVersion(GetHttpVersion()));
+    future.ExecuteWhenReady([self = IntrusivePtr<BatchDeleteTask>(this)](
+                                ReadyFuture<HttpResponse> response) {
+      self->OnResponse(response.result());
+    });
+  }
+
+  void OnResponse(const Result<HttpResponse>& response) {
+    if (!promise.result_needed()) {
+      return;
+    }
+    ABSL_LOG_IF(INFO, gcs_http_logging.Level(1) && response.ok())
+        << "BatchDeleteTask " << *response;
+
+    bool is_retryable = IsRetriable(response.status());
+    absl::Status status = [&]() -> absl::Status {
+      if (!response.ok()) return response.status();
+      TENSORSTORE_RETURN_IF_ERROR(
+          GcsHttpResponseToStatus(response.value(), is_retryable));
+      TENSORSTORE_ASSIGN_OR_RETURN(
+          auto responses,
+          ParseBatchResponse(response.value(), encoded_object_names_.size()));
+      // Only the objects that failed with a transient error are retried.
+      std::vector<std::string> retry_names;
+      for (size_t i = 0; i < responses.size(); ++i) {
+        // 404 Not Found means the object was already deleted.
+        if (responses[i].status_code == 404) continue;
+        absl::Status part_status;
+        bool part_retryable = false;
+        if (responses[i].status_code == 0) {
+          // A missing response is treated as a transient error.
+          part_status = absl::UnavailableError("Missing batch response");
+          part_retryable = true;
+        } else {
+          part_status = GcsHttpResponseToStatus(responses[i], part_retryable);
+        }
+        if (part_status.ok()) continue;
+        if (!part_retryable) return part_status;
+        retry_names.push_back(std::move(encoded_object_names_[i]));
+      }
+      if (retry_names.empty()) return absl::OkStatus();
+      encoded_object_names_ = std::move(retry_names);
+      is_retryable = true;
+      return absl::UnavailableError(absl::StrCat(
+          "Failed to delete ", encoded_object_names_.size(), " objects"));
+    }();
+
+    if (!status.ok() && is_retryable) {
+      status =
+          owner->BackoffForAttemptAsync(std::move(status), attempt_++, this);
+      if (status.ok()) {
+        return;
+      }
+    }
+    promise.SetResult(std::move(status));
+  }
+};
+
+Future<const void> GcsKeyValueStore::BatchDelete(
+    std::vector<std::string> keys) {
+  std::vector<std::string> encoded_object_names;
+  encoded_object_names.reserve(keys.size());
+  for (const auto& key : keys) {
+    encoded_object_names.push_back(internal::PercentEncodeUriComponent(key));
+  }
+  auto op = PromiseFuturePair<void>::Make();
+  auto state = internal::MakeIntrusivePtr<BatchDeleteTask>(
+      IntrusivePtr<GcsKeyValueStore>(this), std::move(encoded_object_names),
+      std::move(op.promise));
+
+  intrusive_ptr_increment(state.get());  // adopted by BatchDeleteTask::Start.
+  write_rate_limiter().Admit(state.get(), &BatchDeleteTask::Start);
+  return std::move(op.future);
+}
+
 // Receiver used by `DeleteRange` for processing the results from `List`.
+//
+// Objects are deleted in batches of up to `kMaxBatchRequests` with a batch
+// request, which is issued as soon as a batch is full so that deletion
+// proceeds concurrently with listing.
 struct DeleteRangeListReceiver {
   IntrusivePtr<GcsKeyValueStore> owner_;
   Promise<void> promise_;
   FutureCallbackRegistration cancel_registration_;
+  std::vector<std::string> keys_;
 
   void set_starting(AnyCancelReceiver cancel) {
     cancel_registration_ = promise_.ExecuteWhenNotNeeded(std::move(cancel));
@@ -1239,7 +1905,8 @@ struct DeleteRangeListReceiver {
   void set_value(ListEntry entry) {
     assert(!entry.key.empty());
     if (!entry.key.empty()) {
-      LinkError(promise_, owner_->Delete(std::move(entry.key)));
+      keys_.push_back(std::move(entry.key));
+      if (keys_.size() == kMaxBatchRequests) Flush();
     }
   }
 
@@ -1248,9 +1915,22 @@ struct DeleteRangeListReceiver {
     promise_ = Promise<void>();
   }
 
-  void set_done() { promise_ = Promise<void>(); }
+  void set_done() {
+    Flush();
+    promise_ = Promise<void>();
+  }
 
   void set_stopping() { cancel_registration_.Unregister(); }
+
+  void Flush() {
+    if (keys_.empty() || !promise_.result_needed()) return;
+    if (keys_.size() == 1) {
+      LinkError(promise_, owner_->Delete(std::move(keys_[0])));
+    } else {
+      LinkError(promise_, owner_->BatchDelete(std::move(keys_)));
+    }
+    keys_.clear();
+  }
 };
 
 Future<const void> GcsKeyValueStore::DeleteRange(KeyRange range) {
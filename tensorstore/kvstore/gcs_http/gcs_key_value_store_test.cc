@@ -30,6 +30,7 @@
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
 #include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/synchronization/notification.h"
 #include "absl/time/clock.h"
@@ -519,7 +520,8 @@ class MyDeleteRangeCancellationMockTransport : public MyMockTransport {
   void IssueRequestWithHandler(const HttpRequest& request,
                                IssueRequestOptions options,
                                HttpResponseHandler* response_handler) final {
-    if (request.method == "DELETE") {
+    if (request.method == "DELETE" ||
+        absl::StrContains(request.url, "/batch/storage/")) {
       cancellation_notification_.WaitForNotification();
       ++total_delete_requests_;
     }
@@ -571,6 +573,59 @@ TEST(GcsKeyValueStoreTest, DeleteRangeCancellation) {
               ::testing::Optional(::testing::SizeIs(::testing::Ge(4))));
 }
 
+class MyDeleteCountingMockTransport : public MyMockTransport {
+ public:
+  void IssueRequestWithHandler(const HttpRequest& request,
+                               IssueRequestOptions options,
+                               HttpResponseHandler* response_handler) final {
+    if (request.method == "DELETE") {
+      ++total_delete_requests_;
+    } else if (absl::StrContains(request.url, "/batch/storage/")) {
+      ++total_batch_requests_;
+    }
+    MyMockTransport::IssueRequestWithHandler(request, std::move(options),
+                                             response_handler);
+  }
+
+  std::atomic<size_t> total_delete_requests_{0};
+  std::atomic<size_t> total_batch_requests_{0};
+};
+
+TEST(GcsKeyValueStoreTest, DeleteRangeBatch) {
+  auto mock_transport = std::make_shared<MyDeleteCountingMockTransport>();
+  DefaultHttpTransportSetter mock_transport_setter{mock_transport};
+
+  GCSMockStorageBucket bucket("my-bucket");
+  mock_transport->buckets_.push_back(&bucket);
+
+  auto context = DefaultTestContext();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", kDriver}, {"bucket", "my-bucket"}}, context)
+          .result());
+  std::vector<tensorstore::Future<tensorstore::TimestampedStorageGeneration>>
+      futures;
+  for (int i = 0; i < 250; ++i) {
+    futures.push_back(
+        kvstore::Write(store, absl::StrCat("a/", i), absl::Cord("x")));
+  }
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "b", absl::Cord("x")));
+  for (const auto& future : futures) {
+    TENSORSTORE_ASSERT_OK(future.result());
+  }
+
+  TENSORSTORE_ASSERT_OK(
+      kvstore::DeleteRange(store, tensorstore::KeyRange::Prefix("a/")));
+  EXPECT_THAT(
+      ListFuture(store).result(),
+      ::testing::Optional(::testing::ElementsAre(MatchesListEntry("b"))));
+
+  // The objects are deleted with at least 3 batch requests of up to 100
+  // objects each, rather than with individual requests.
+  EXPECT_EQ(0, mock_transport->total_delete_requests_.load());
+  EXPECT_LE(3, mock_transport->total_batch_requests_.load());
+}
+
 class MyConcurrentMockTransport : public MyMockTransport {
  public:
   size_t reset() {
@@ -773,6 +828,53 @@ TEST(GcsKeyValueStoreTest, InvalidUri) {
                             ".*Invalid GCS path.*"));
 }
 
+TEST(GcsKeyValueStoreTest, CompositeUpload) {
+  auto mock_transport = std::make_shared<MyMockTransport>();
+  DefaultHttpTransportSetter mock_transport_setter{mock_transport};
+
+  GCSMockStorageBucket bucket("my-bucket");
+  bucket.SetErrorRate(0);
+  mock_transport->buckets_.push_back(&bucket);
+
+  auto context = DefaultTestContext();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", kDriver},
+                     {"bucket", "my-bucket"},
+                     {"composite_upload", {{"threshold", 4}, {"part_size", 3}}}},
+                    context)
+          .result());
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto stamp, kvstore::Write(store, "a", absl::Cord("abcdefghij")).result());
+  EXPECT_THAT(kvstore::Read(store, "a").result(),
+              tensorstore::internal::MatchesKvsReadResult(
+                  absl::Cord("abcdefghij"), stamp.generation));
+
+  // The write conditions apply to the composed object.
+  kvstore::WriteOptions options;
+  options.generation_conditions.if_equal = StorageGeneration::NoValue();
+  EXPECT_THAT(
+      kvstore::Write(store, "a", absl::Cord("0123456789"), options).result(),
+      tensorstore::internal::MatchesTimestampedStorageGeneration(
+          StorageGeneration::Unknown()));
+  options.generation_conditions.if_equal = stamp.generation;
+  EXPECT_THAT(
+      kvstore::Write(store, "a", absl::Cord("0123456789"), options).result(),
+      tensorstore::internal::MatchesKnownTimestampedStorageGeneration());
+  EXPECT_THAT(kvstore::Read(store, "a").result(),
+              tensorstore::internal::MatchesKvsReadResult(
+                  absl::Cord("0123456789")));
+
+  // Values at or below the threshold use a single upload.
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "b", absl::Cord("xyz")));
+
+  // The temporary objects are deleted.
+  EXPECT_THAT(ListFuture(store, {}).result(),
+              ::testing::Optional(::testing::UnorderedElementsAre(
+                  MatchesListEntry("a"), MatchesListEntry("b"))));
+}
+
 TEST(GcsKeyValueStoreTest, BatchRead) {
   auto mock_transport = std::make_shared<MyMockTransport>();
   DefaultHttpTransportSetter mock_transport_setter{mock_transport};
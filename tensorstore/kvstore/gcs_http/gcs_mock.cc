@@ -33,6 +33,7 @@
 #include "absl/strings/cord.h"
 #include "absl/strings/match.h"
 #include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_split.h"
 #include "absl/strings/substitute.h"
 #include "absl/synchronization/mutex.h"
@@ -128,6 +129,10 @@ GCSMockStorageBucket::Match(const HttpRequest& request, absl::Cord payload) {
     return {};
   }
   std::string_view path = parsed.authority_and_path;
+  if (path == "storage.googleapis.com/batch/storage/v1" &&
+      request.method == "POST") {
+    return HandleBatchRequest(request, std::move(payload));
+  }
   if (absl::StartsWith(path, bucket_prefix_)) {
     // Bucket path.
     path.remove_prefix(bucket_prefix_.size());
@@ -190,6 +195,10 @@ GCSMockStorageBucket::Match(const HttpRequest& request, absl::Cord payload) {
               R"({ "error": { "code": 400, "message": "Uploads must be sent to the upload URL." } })")};
     }
     return HandleInsertRequest(path, params, payload);
+  } else if (absl::StartsWith(path, "/o/") &&
+             absl::EndsWith(path, "/compose") && request.method == "POST" &&
+             !is_upload) {
+    return HandleComposeRequest(path, params, payload);
   } else if (absl::StartsWith(path, "/o/") && request.method == "GET") {
     // GET request on an object.
     return HandleGetRequest(request, path, params);
@@ -200,7 +209,6 @@ GCSMockStorageBucket::Match(const HttpRequest& request, absl::Cord payload) {
 
   // NOT HANDLED
   // update (PUT request)
-  // .../compose
   // .../watch
   // .../rewrite/...
   // patch (PATCH request)
@@ -321,6 +329,76 @@ GCSMockStorageBucket::HandleInsertRequest(std::string_view path,
   return HttpResponse{404, absl::Cord()};
 }
 
+std::variant<std::monostate, HttpResponse, absl::Status>
+GCSMockStorageBucket::HandleComposeRequest(std::string_view path,
+                                           const ParamMap& params,
+                                           absl::Cord payload) {
+  // https://cloud.google.com/storage/docs/json_api/v1/objects/compose
+  path.remove_prefix(3);  // remove /o/
+  path.remove_suffix(8);  // remove /compose
+  std::string name = internal::PercentDecode(path);
+
+  QueryParameters parsed_parameters;
+  {
+    auto parse_result = ParseQueryParameters(params, &parsed_parameters);
+    if (parse_result.has_value()) {
+      return std::move(parse_result.value());
+    }
+  }
+
+  auto body = ::nlohmann::json::parse(std::string(payload), nullptr,
+                                      /*allow_exceptions=*/false);
+  if (!body.is_object() || !body["sourceObjects"].is_array() ||
+      body["sourceObjects"].empty() || body["sourceObjects"].size() > 32) {
+    return HttpResponse{400, absl::Cord()};
+  }
+
+  absl::Cord data;
+  for (const auto& source : body["sourceObjects"]) {
+    if (!source.is_object() || !source.contains("name") ||
+        !source["name"].is_string()) {
+      return HttpResponse{400, absl::Cord()};
+    }
+    auto it = data_.find(source["name"].get<std::string>());
+    if (it == data_.end()) {
+      return HttpResponse{404, absl::Cord()};
+    }
+    if (source.contains("objectPreconditions")) {
+      const auto& preconditions = source["objectPreconditions"];
+      if (preconditions.contains("ifGenerationMatch") &&
+          preconditions["ifGenerationMatch"] != it->second.generation) {
+        return HttpResponse{412, absl::Cord()};
+      }
+    }
+    data.Append(it->second.data);
+  }
+
+  auto it = data_.find(name);
+  if (parsed_parameters.ifGenerationMatch.has_value()) {
+    const int64_t v = parsed_parameters.ifGenerationMatch.value();
+    if (v == 0) {
+      if (it != data_.end()) {
+        // Live version => failure
+        return HttpResponse{412, absl::Cord()};
+      }
+    } else if (it == data_.end() || v != it->second.generation) {
+      // generation does not match.
+      return HttpResponse{412, absl::Cord()};
+    }
+  }
+
+  auto& obj = data_[name];
+  if (obj.name.empty()) {
+    obj.name = std::move(name);
+  }
+  obj.generation = ++next_generation_;
+  obj.data = std::move(data);
+
+  ABSL_LOG(INFO) << "Composed: " << obj.name << " " << obj.generation;
+
+  return ObjectMetadataResponse(obj);
+}
+
 std::optional<OptionalByteRangeRequest> ParseRangeFieldValue(
     std::string_view header) {
   static LazyRE2 kRange = {R"((?i)bytes=(\d+)?-(\d+)?)"};
@@ -439,6 +517,76 @@ GCSMockStorageBucket::HandleDeleteRequest(std::string_view path,
   return HttpResponse{404, absl::Cord()};
 }
 
+std::variant<std::monostate, HttpResponse, absl::Status>
+GCSMockStorageBucket::HandleBatchRequest(const HttpRequest& request,
+                                         absl::Cord payload) {
+  // https://cloud.google.com/storage/docs/batch
+  std::string_view boundary;
+  if (auto it = request.headers.find("content-type");
+      it != request.headers.end()) {
+    std::string_view content_type = it->second;
+    if (auto pos = content_type.find("boundary="); pos != content_type.npos) {
+      boundary = content_type.substr(pos + 9);
+    }
+  }
+  if (boundary.empty()) {
+    return HttpResponse{400, absl::Cord("Missing multipart boundary")};
+  }
+
+  // Each part contains a request line such as
+  // "DELETE /storage/v1/b/bucket/o/object HTTP/1.1".
+  std::vector<std::pair<std::string, std::string>> requests;
+  std::string payload_str(payload.Flatten());
+  for (std::string_view part :
+       absl::StrSplit(payload_str, absl::StrCat("--", boundary))) {
+    auto pos = part.find("\r\n\r\n");
+    if (pos == part.npos) continue;
+    std::string_view request_line = part.substr(pos + 4);
+    request_line = request_line.substr(0, request_line.find("\r\n"));
+    std::vector<std::string_view> fields = absl::StrSplit(request_line, ' ');
+    if (fields.size() != 3) {
+      return HttpResponse{400, absl::Cord("Invalid request line")};
+    }
+    // The bucket path, excluding the host.
+    if (!absl::StartsWith(
+            fields[1],
+            absl::StrCat(bucket_prefix_.substr(bucket_prefix_.find('/')),
+                         "/"))) {
+      // Another bucket.
+      return {};
+    }
+    requests.emplace_back(fields[0],
+                          absl::StrCat("https://storage.googleapis.com",
+                                       fields[1]));
+  }
+
+  std::string response_payload;
+  for (size_t i = 0; i < requests.size(); ++i) {
+    HttpRequest part_request{requests[i].first, requests[i].second};
+    auto match_result = Match(part_request, absl::Cord());
+    HttpResponse response{404, absl::Cord()};
+    if (auto* r = std::get_if<HttpResponse>(&match_result)) {
+      response = std::move(*r);
+    } else if (std::holds_alternative<absl::Status>(match_result)) {
+      response = HttpResponse{503, absl::Cord()};
+    }
+    absl::StrAppend(&response_payload,
+                    "--batch_mock\r\n"
+                    "Content-Type: application/http\r\n"
+                    "Content-ID: <response-",
+                    i + 1,
+                    ">\r\n"
+                    "\r\n"
+                    "HTTP/1.1 ",
+                    response.status_code, " Mock\r\n\r\n",
+                    std::string(response.payload), "\r\n");
+  }
+  absl::StrAppend(&response_payload, "--batch_mock--\r\n");
+  return HttpResponse{
+      200, absl::Cord(std::move(response_payload)),
+      HeaderMap{{"content-type", "multipart/mixed; boundary=batch_mock"}}};
+}
+
 HttpResponse GCSMockStorageBucket::ObjectMetadataResponse(
     const Object& object) {
   std::string data = ObjectMetadata(object).dump();
@@ -82,6 +82,11 @@ class GCSMockStorageBucket {
   HandleInsertRequest(std::string_view path, const ParamMap& params,
                       absl::Cord payload);
 
+  // Compose an object from existing objects in the bucket.
+  std::variant<std::monostate, internal_http::HttpResponse, absl::Status>
+  HandleComposeRequest(std::string_view path, const ParamMap& params,
+                       absl::Cord payload);
+
   // Get an object, which might be the data or the metadata.
   std::variant<std::monostate, internal_http::HttpResponse, absl::Status>
   HandleGetRequest(const internal_http::HttpRequest& request,
@@ -91,6 +96,11 @@ class GCSMockStorageBucket {
   std::variant<std::monostate, internal_http::HttpResponse, absl::Status>
   HandleDeleteRequest(std::string_view path, const ParamMap& params);
 
+  // Handle a batch request by dispatching each part to `Match`.
+  std::variant<std::monostate, internal_http::HttpResponse, absl::Status>
+  HandleBatchRequest(const internal_http::HttpRequest& request,
+                     absl::Cord payload);
+
   // Construct an object metadata response.
   internal_http::HttpResponse ObjectMetadataResponse(const Object& object);
 
@@ -26,6 +26,7 @@
 #include "tensorstore/context_resource_provider.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
 #include "tensorstore/internal/rate_limiter/admission_queue.h"
+#include "tensorstore/internal/rate_limiter/byte_rate_limiter.h"
 #include "tensorstore/internal/rate_limiter/rate_limiter.h"
 #include "tensorstore/util/result.h"
 
@@ -105,19 +106,27 @@ struct GcsRateLimiterResource
     std::optional<double> read_rate;
     std::optional<double> write_rate;
     std::optional<absl::Duration> doubling_time;
+    // If equal to `nullopt`, indicates that the bandwidth is not limited.
+    std::optional<double> read_bytes_per_second;
+    std::optional<double> write_bytes_per_second;
 
     constexpr static auto ApplyMembers = [](auto&& x, auto f) {
-      return f(x.read_rate, x.write_rate, x.doubling_time);
+      return f(x.read_rate, x.write_rate, x.doubling_time,
+               x.read_bytes_per_second, x.write_bytes_per_second);
     };
   };
   struct Resource {
     Spec spec;
     std::shared_ptr<internal::RateLimiter> read_limiter;
     std::shared_ptr<internal::RateLimiter> write_limiter;
+    // Null if the bandwidth is not limited.
+    std::shared_ptr<internal::ByteRateLimiter> read_bytes_limiter;
+    std::shared_ptr<internal::ByteRateLimiter> write_bytes_limiter;
   };
 
   static Spec Default() {
-    return Spec{std::nullopt, std::nullopt, std::nullopt};
+    return Spec{std::nullopt, std::nullopt, std::nullopt, std::nullopt,
+                std::nullopt};
   }
 
   static constexpr auto JsonBinder() {
@@ -125,7 +134,11 @@ struct GcsRateLimiterResource
     return jb::Object(
         jb::Member("read_rate", jb::Projection<&Spec::read_rate>()),
         jb::Member("write_rate", jb::Projection<&Spec::write_rate>()),
-        jb::Member("doubling_time", jb::Projection<&Spec::doubling_time>()));
+        jb::Member("doubling_time", jb::Projection<&Spec::doubling_time>()),
+        jb::Member("read_bytes_per_second",
+                   jb::Projection<&Spec::read_bytes_per_second>()),
+        jb::Member("write_bytes_per_second",
+                   jb::Projection<&Spec::write_bytes_per_second>()));
   }
 
   Result<Resource> Create(
@@ -21,6 +21,8 @@
 #include <cassert>
 #include <utility>
 
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "tensorstore/batch.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/kvstore/batch_util.h"
@@ -53,8 +55,9 @@ using GenericCoalescingBatchReadEntryBase =
 //     - `Future<ReadResult> ReadImpl(Key, ReadOptions)` that performs a regular
 //       non-batch read (`ReadOptions::batch` will always be `no_batch`).
 //
-//     - `CoalescingOptions GetBatchReadCoalescingOptions()` that returns the
-//       coalescing options to use.
+//     - `AdaptiveCoalescingOptions& batch_read_coalescing()` that returns the
+//       coalescing options to use, which are tuned from the size and duration
+//       of each coalesced read.
 //
 //     - `Executor executor()` that returns an executor to use for handling
 //       batch read operations.
@@ -91,13 +94,14 @@ struct GenericCoalescingBatchReadEntry
     internal::IntrusivePtr<GenericCoalescingBatchReadEntry> self(
         this, internal::adopt_object_ref);
     ForEachCoalescedRequest<Request>(
-        request_batch.requests, this->driver().GetBatchReadCoalescingOptions(),
+        request_batch.requests, this->driver().batch_read_coalescing().Get(),
         [&](ByteRange coalesced_byte_range, span<Request> coalesced_requests) {
           kvstore::ReadOptions options;
           options.generation_conditions =
               std::get<kvstore::ReadGenerationConditions>(batch_entry_key);
           options.staleness_bound = request_batch.staleness_bound;
           options.byte_range = coalesced_byte_range;
+          const absl::Time start_time = absl::Now();
           auto read_future = this->driver().ReadImpl(
               kvstore::Key(std::get<kvstore::Key>(batch_entry_key)),
               std::move(options));
@@ -105,12 +109,16 @@ struct GenericCoalescingBatchReadEntry
           std::move(read_future)
               .ExecuteWhenReady(WithExecutor(
                   this->driver().executor(),
-                  [self, coalesced_byte_range, coalesced_requests](
-                      ReadyFuture<kvstore::ReadResult> future) {
+                  [self, coalesced_byte_range, coalesced_requests,
+                   start_time](ReadyFuture<kvstore::ReadResult> future) {
                     TENSORSTORE_ASSIGN_OR_RETURN(
                         auto&& read_result, future.result(),
                         internal_kvstore_batch::SetCommonResult(
                             coalesced_requests, _));
+                    if (read_result.has_value()) {
+                      self->driver().batch_read_coalescing().Record(
+                          read_result.value.size(), absl::Now() - start_time);
+                    }
                     ResolveCoalescedRequests(coalesced_byte_range,
                                              coalesced_requests,
                                              std::move(read_result));
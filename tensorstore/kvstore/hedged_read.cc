@@ -0,0 +1,121 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/hedged_read.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/thread/schedule_at.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace internal_kvstore {
+namespace {
+
+// Minimum number of latency samples before the quantile is used.
+constexpr size_t kMinSamples = 16;
+
+// Issues one request, whose result, if it completes first, is the result of
+// `promise`.
+void IssueRequest(const std::shared_ptr<HedgedReadTracker>& tracker,
+                  const HedgedReadFunction& read,
+                  Promise<kvstore::ReadResult> promise) {
+  auto start_time = absl::Now();
+  // `Link` releases the future of the request once `promise` is ready, which
+  // cancels the request that did not complete first.
+  Link(
+      [tracker, start_time](Promise<kvstore::ReadResult> promise,
+                            ReadyFuture<kvstore::ReadResult> future) {
+        tracker->RecordLatency(absl::Now() - start_time);
+        promise.SetResult(std::move(future.result()));
+      },
+      std::move(promise), read());
+}
+
+}  // namespace
+
+std::optional<absl::Duration> HedgedReadTracker::StartRead(
+    const HedgedReadOptions& options) {
+  absl::MutexLock lock(&mutex_);
+  budget_ = std::min(kMaxBudget, budget_ + options.max_fraction);
+  if (options.quantile > 0 && num_samples_ >= kMinSamples) {
+    if (cached_quantile_ != options.quantile ||
+        num_samples_ >= cached_num_samples_ + kMinSamples) {
+      // Recompute the quantile periodically, rather than for each read.
+      const size_t n = std::min(num_samples_, kNumSamples);
+      std::array<absl::Duration, kNumSamples> sorted = samples_;
+      const size_t index = std::min(
+          n - 1, static_cast<size_t>(std::ceil(options.quantile * n)) - 1);
+      std::nth_element(sorted.begin(), sorted.begin() + index,
+                       sorted.begin() + n);
+      cached_quantile_ = options.quantile;
+      cached_num_samples_ = num_samples_;
+      cached_delay_ = sorted[index];
+    }
+    return cached_delay_;
+  }
+  if (options.delay == absl::InfiniteDuration()) return std::nullopt;
+  return options.delay;
+}
+
+bool HedgedReadTracker::TryAcquireHedge() {
+  absl::MutexLock lock(&mutex_);
+  if (budget_ < 1) return false;
+  budget_ -= 1;
+  return true;
+}
+
+void HedgedReadTracker::RecordLatency(absl::Duration latency) {
+  absl::MutexLock lock(&mutex_);
+  samples_[num_samples_ % kNumSamples] = latency;
+  ++num_samples_;
+}
+
+Future<kvstore::ReadResult> HedgedRead(
+    const HedgedReadOptions& options,
+    std::shared_ptr<HedgedReadTracker> tracker, Executor executor,
+    HedgedReadFunction read) {
+  if (!options.enabled()) return read();
+  auto delay = tracker->StartRead(options);
+  if (!delay) return read();
+
+  auto pair = PromiseFuturePair<kvstore::ReadResult>::Make();
+  IssueRequest(tracker, read, pair.promise);
+  internal::ScheduleAt(
+      absl::Now() + *delay,
+      [tracker = std::move(tracker), executor = std::move(executor),
+       read = std::move(read), promise = std::move(pair.promise)]() mutable {
+        if (!promise.result_needed() || !tracker->TryAcquireHedge()) return;
+        executor([tracker = std::move(tracker), read = std::move(read),
+                  promise = std::move(promise)]() mutable {
+          IssueRequest(tracker, read, std::move(promise));
+        });
+      });
+  return std::move(pair.future);
+}
+
+}  // namespace internal_kvstore
+}  // namespace tensorstore
@@ -0,0 +1,153 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_HEDGED_READ_H_
+#define TENSORSTORE_KVSTORE_HEDGED_READ_H_
+
+#include <stddef.h>
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <optional>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/json_binding/absl_time.h"
+#include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/str_cat.h"
+
+// specializations
+#include "tensorstore/internal/cache_key/absl_time.h"  // IWYU pragma: keep
+#include "tensorstore/serialization/absl_time.h"  // IWYU pragma: keep
+
+namespace tensorstore {
+namespace internal_kvstore {
+
+/// Specifies when a read that has not completed is duplicated by a second,
+/// "hedged", request, in order to reduce tail latency.
+struct HedgedReadOptions {
+  /// Delay after which a hedged request is issued.  Infinite by default, which
+  /// disables hedged reads unless `quantile` is specified.
+  absl::Duration delay = absl::InfiniteDuration();
+
+  /// If non-zero, hedged requests are instead issued after the latency of
+  /// this quantile (e.g. `0.95`) of recent reads.  Until enough reads have
+  /// completed, `delay` is used.
+  double quantile = 0;
+
+  /// Maximum number of hedged requests, as a fraction of the number of reads.
+  double max_fraction = 0.05;
+
+  bool enabled() const {
+    return quantile > 0 || delay != absl::InfiniteDuration();
+  }
+
+  constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+    return f(x.delay, x.quantile, x.max_fraction);
+  };
+
+  constexpr static auto default_json_binder = internal_json_binding::Object(
+      internal_json_binding::Member(
+          "delay",
+          internal_json_binding::Projection<&HedgedReadOptions::delay>(
+              internal_json_binding::DefaultValue<
+                  internal_json_binding::kNeverIncludeDefaults>(
+                  [](auto* v) { *v = absl::InfiniteDuration(); }))),
+      internal_json_binding::Member(
+          "quantile",
+          internal_json_binding::Projection<&HedgedReadOptions::quantile>(
+              internal_json_binding::DefaultValue<
+                  internal_json_binding::kNeverIncludeDefaults>(
+                  [](auto* v) { *v = 0; },
+                  internal_json_binding::Validate(
+                      [](const auto& options, const double* v) {
+                        if (*v < 0 || *v >= 1) {
+                          return absl::InvalidArgumentError(tensorstore::StrCat(
+                              "Expected quantile in [0, 1), but received: ",
+                              *v));
+                        }
+                        return absl::OkStatus();
+                      })))),
+      internal_json_binding::Member(
+          "max_fraction",
+          internal_json_binding::Projection<&HedgedReadOptions::max_fraction>(
+              internal_json_binding::DefaultValue<
+                  internal_json_binding::kNeverIncludeDefaults>(
+                  [](auto* v) { *v = 0.05; },
+                  internal_json_binding::Validate(
+                      [](const auto& options, const double* v) {
+                        if (*v < 0 || *v > 1) {
+                          return absl::InvalidArgumentError(tensorstore::StrCat(
+                              "Expected max_fraction in [0, 1], but received: ",
+                              *v));
+                        }
+                        return absl::OkStatus();
+                      }))))
+      /**/);
+};
+
+/// Tracks the latency of recent reads, and the budget of hedged requests, of
+/// one kvstore driver.
+class HedgedReadTracker {
+ public:
+  constexpr static size_t kNumSamples = 128;
+
+  /// Maximum number of hedged requests that may be issued in a burst.
+  constexpr static double kMaxBudget = 10;
+
+  /// Returns the delay after which a hedged request is issued for a new read,
+  /// or `std::nullopt` if none is issued.  Accrues `options.max_fraction` of
+  /// budget.
+  std::optional<absl::Duration> StartRead(const HedgedReadOptions& options);
+
+  /// Consumes one unit of budget, if available.
+  bool TryAcquireHedge();
+
+  /// Records the latency of a completed request.
+  void RecordLatency(absl::Duration latency);
+
+ private:
+  absl::Mutex mutex_;
+  std::array<absl::Duration, kNumSamples> samples_ ABSL_GUARDED_BY(mutex_);
+  size_t num_samples_ ABSL_GUARDED_BY(mutex_) = 0;
+  double cached_quantile_ ABSL_GUARDED_BY(mutex_) = 0;
+  size_t cached_num_samples_ ABSL_GUARDED_BY(mutex_) = 0;
+  absl::Duration cached_delay_ ABSL_GUARDED_BY(mutex_) =
+      absl::InfiniteDuration();
+  double budget_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+/// Issues a single request for a read.
+using HedgedReadFunction = std::function<Future<kvstore::ReadResult>()>;
+
+/// Issues `read`, and, if it has not completed after the delay determined by
+/// `options` and `tracker`, issues it again on `executor`.  The result of the
+/// first request to complete is returned; the future of the other request is
+/// released, which cancels it.
+Future<kvstore::ReadResult> HedgedRead(
+    const HedgedReadOptions& options,
+    std::shared_ptr<HedgedReadTracker> tracker, Executor executor,
+    HedgedReadFunction read);
+
+}  // namespace internal_kvstore
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_HEDGED_READ_H_
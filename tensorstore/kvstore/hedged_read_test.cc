@@ -0,0 +1,173 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/hedged_read.h"
+
+#include <stddef.h>
+
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/internal/json_binding/gtest.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/test_matchers.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::InlineExecutor;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::Promise;
+using ::tensorstore::PromiseFuturePair;
+using ::tensorstore::StorageGeneration;
+using ::tensorstore::internal::MatchesKvsReadResult;
+using ::tensorstore::internal_kvstore::HedgedRead;
+using ::tensorstore::internal_kvstore::HedgedReadOptions;
+using ::tensorstore::internal_kvstore::HedgedReadTracker;
+using ::tensorstore::kvstore::ReadResult;
+
+// Records the promise of each request issued by `HedgedRead`.
+struct MockRead {
+  absl::Mutex mutex;
+  std::vector<Promise<ReadResult>> promises;
+
+  tensorstore::internal_kvstore::HedgedReadFunction Function() {
+    return [this] {
+      auto pair = PromiseFuturePair<ReadResult>::Make();
+      absl::MutexLock lock(&mutex);
+      promises.push_back(std::move(pair.promise));
+      return std::move(pair.future);
+    };
+  }
+
+  size_t expected = 0;
+
+  bool HasExpectedRequests() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex) {
+    return promises.size() >= expected;
+  }
+
+  void WaitForRequests(size_t n) {
+    absl::MutexLock lock(&mutex);
+    expected = n;
+    mutex.Await(absl::Condition(this, &MockRead::HasExpectedRequests));
+  }
+};
+
+ReadResult Value(std::string_view value) {
+  return ReadResult::Value(absl::Cord(value),
+                           {StorageGeneration::FromString("g"), absl::Now()});
+}
+
+TEST(HedgedReadTest, Disabled) {
+  MockRead mock;
+  auto tracker = std::make_shared<HedgedReadTracker>();
+  auto future = HedgedRead(HedgedReadOptions{}, tracker, InlineExecutor{},
+                           mock.Function());
+  ASSERT_EQ(1, mock.promises.size());
+  mock.promises[0].SetResult(Value("abc"));
+  EXPECT_THAT(future.result(), MatchesKvsReadResult(absl::Cord("abc")));
+}
+
+TEST(HedgedReadTest, HedgedRequestCompletesFirst) {
+  MockRead mock;
+  auto tracker = std::make_shared<HedgedReadTracker>();
+  HedgedReadOptions options;
+  options.delay = absl::ZeroDuration();
+  options.max_fraction = 1;
+  auto future = HedgedRead(options, tracker, InlineExecutor{}, mock.Function());
+  mock.WaitForRequests(2);
+  mock.promises[1].SetResult(Value("def"));
+  EXPECT_THAT(future.result(), MatchesKvsReadResult(absl::Cord("def")));
+  // The request that did not complete first is cancelled.
+  EXPECT_FALSE(mock.promises[0].result_needed());
+}
+
+TEST(HedgedReadTest, PrimaryRequestCompletesFirst) {
+  MockRead mock;
+  auto tracker = std::make_shared<HedgedReadTracker>();
+  HedgedReadOptions options;
+  options.delay = absl::Hours(1);
+  options.max_fraction = 1;
+  auto future = HedgedRead(options, tracker, InlineExecutor{}, mock.Function());
+  ASSERT_EQ(1, mock.promises.size());
+  mock.promises[0].SetResult(Value("abc"));
+  EXPECT_THAT(future.result(), MatchesKvsReadResult(absl::Cord("abc")));
+}
+
+TEST(HedgedReadTest, Error) {
+  MockRead mock;
+  auto tracker = std::make_shared<HedgedReadTracker>();
+  HedgedReadOptions options;
+  options.delay = absl::Hours(1);
+  auto future = HedgedRead(options, tracker, InlineExecutor{}, mock.Function());
+  ASSERT_EQ(1, mock.promises.size());
+  mock.promises[0].SetResult(absl::UnavailableError("x"));
+  EXPECT_THAT(future.result(), MatchesStatus(absl::StatusCode::kUnavailable));
+}
+
+TEST(HedgedReadTrackerTest, Budget) {
+  HedgedReadTracker tracker;
+  HedgedReadOptions options;
+  options.delay = absl::ZeroDuration();
+  options.max_fraction = 0.5;
+  EXPECT_EQ(absl::ZeroDuration(), tracker.StartRead(options));
+  EXPECT_FALSE(tracker.TryAcquireHedge());
+  EXPECT_EQ(absl::ZeroDuration(), tracker.StartRead(options));
+  EXPECT_TRUE(tracker.TryAcquireHedge());
+  EXPECT_FALSE(tracker.TryAcquireHedge());
+}
+
+TEST(HedgedReadTrackerTest, Quantile) {
+  HedgedReadTracker tracker;
+  HedgedReadOptions options;
+  options.quantile = 0.95;
+  // Not enough samples.
+  EXPECT_EQ(std::nullopt, tracker.StartRead(options));
+  options.delay = absl::Seconds(1);
+  EXPECT_EQ(absl::Seconds(1), tracker.StartRead(options));
+
+  for (int i = 1; i <= 100; ++i) {
+    tracker.RecordLatency(absl::Milliseconds(i));
+  }
+  EXPECT_EQ(absl::Milliseconds(95), tracker.StartRead(options));
+}
+
+TEST(HedgedReadOptionsTest, JsonBinding) {
+  tensorstore::TestJsonBinderRoundTripJsonOnly<HedgedReadOptions>({
+      ::nlohmann::json::object_t(),
+      {{"delay", "50ms"}},
+      {{"quantile", 0.95}, {"max_fraction", 0.1}},
+  });
+  tensorstore::TestJsonBinderFromJson<HedgedReadOptions>({
+      {{{"quantile", 1.5}},
+       MatchesStatus(absl::StatusCode::kInvalidArgument,
+                     ".*Expected quantile in \\[0, 1\\).*")},
+  });
+}
+
+}  // namespace
@@ -14,17 +14,107 @@
 
 #include "tensorstore/kvstore/http/byte_range_util.h"
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include "absl/status/status.h"
+#include "absl/strings/ascii.h"
 #include "absl/strings/cord.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_split.h"
+#include "tensorstore/internal/http/http_header.h"
 #include "tensorstore/internal/http/http_response.h"
 #include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
 #include "tensorstore/util/str_cat.h"
 
 namespace tensorstore {
 namespace internal_http {
+namespace {
+
+/// Maximum size of the preamble and headers of a single part of a
+/// `multipart/byteranges` payload.
+constexpr size_t kMaxPartHeaderSize = 8192;
+
+/// Returns the boundary of a `multipart/byteranges` response, or
+/// `std::nullopt` if the response is not a multipart response.
+std::optional<std::string> GetMultipartBoundary(const HeaderMap& headers) {
+  auto it = headers.find("content-type");
+  if (it == headers.end()) return std::nullopt;
+  std::vector<std::string_view> params = absl::StrSplit(it->second, ';');
+  if (!absl::EqualsIgnoreCase(absl::StripAsciiWhitespace(params[0]),
+                              "multipart/byteranges")) {
+    return std::nullopt;
+  }
+  for (size_t i = 1; i < params.size(); ++i) {
+    std::string_view param = absl::StripAsciiWhitespace(params[i]);
+    if (!absl::StartsWithIgnoreCase(param, "boundary=")) continue;
+    param.remove_prefix(9);
+    if (param.size() >= 2 && param.front() == '"' && param.back() == '"') {
+      param = param.substr(1, param.size() - 2);
+    }
+    if (param.empty()) break;
+    return std::string(param);
+  }
+  return std::nullopt;
+}
+
+Result<std::vector<ByteRangeResponsePart>> ParseMultipartByteRanges(
+    const absl::Cord& payload, std::string_view boundary) {
+  const std::string delimiter = tensorstore::StrCat("--", boundary);
+  std::vector<ByteRangeResponsePart> parts;
+  size_t pos = 0;
+  while (true) {
+    // Each part starts with the delimiter, preceded by either the preamble or
+    // the CRLF that terminates the previous part.
+    const std::string window(payload.Subcord(pos, kMaxPartHeaderSize));
+    size_t start = window.find(delimiter);
+    if (start == std::string::npos) {
+      return absl::FailedPreconditionError(
+          "Missing boundary in multipart/byteranges response");
+    }
+    start += delimiter.size();
+    std::string_view rest = std::string_view(window).substr(start);
+    if (absl::StartsWith(rest, "--")) break;
+    const size_t header_start = rest.find("\r\n");
+    const size_t header_end = rest.find("\r\n\r\n", header_start);
+    if (header_start == std::string_view::npos ||
+        header_end == std::string_view::npos) {
+      return absl::FailedPreconditionError(
+          "Invalid part headers in multipart/byteranges response");
+    }
+    HttpResponse part_response{206, {}, {}};
+    ParseAndSetHeaders(
+        rest.substr(header_start + 2, header_end - header_start),
+        [&](std::string_view field_name, std::string_view field_value) {
+          part_response.headers.SetHeader(field_name, field_value);
+        });
+    TENSORSTORE_ASSIGN_OR_RETURN(auto content_range,
+                                 ParseContentRangeHeader(part_response));
+    const size_t data_start = pos + start + header_end + 4;
+    const int64_t size =
+        content_range.exclusive_max - content_range.inclusive_min;
+    if (data_start + size > payload.size()) {
+      return absl::FailedPreconditionError(
+          "Truncated multipart/byteranges response");
+    }
+    parts.push_back(ByteRangeResponsePart{
+        {content_range.inclusive_min, content_range.exclusive_max},
+        content_range.total_size,
+        payload.Subcord(data_start, size)});
+    pos = data_start + size;
+  }
+  return parts;
+}
+
+}  // namespace
 
 absl::Status ValidateResponseByteRange(
     const HttpResponse& response,
@@ -74,5 +164,41 @@ absl::Status ValidateResponseByteRange(
   return absl::OkStatus();
 }
 
+std::string FormatMultiRangeHeader(span<const ByteRange> byte_ranges) {
+  std::string header = "bytes=";
+  const char* sep = "";
+  for (const auto& byte_range : byte_ranges) {
+    absl::StrAppendFormat(&header, "%s%d-%d", sep, byte_range.inclusive_min,
+                          byte_range.exclusive_max - 1);
+    sep = ",";
+  }
+  return header;
+}
+
+Result<std::vector<ByteRangeResponsePart>> ParseByteRangeResponseParts(
+    const HttpResponse& response) {
+  if (response.status_code != 206) {
+    return absl::FailedPreconditionError(tensorstore::StrCat(
+        "Expected HTTP 206 response but received: ", response.status_code));
+  }
+  if (auto boundary = GetMultipartBoundary(response.headers)) {
+    return ParseMultipartByteRanges(response.payload, *boundary);
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(auto content_range,
+                               ParseContentRangeHeader(response));
+  if (content_range.exclusive_max - content_range.inclusive_min !=
+      static_cast<int64_t>(response.payload.size())) {
+    return absl::FailedPreconditionError(tensorstore::StrCat(
+        "Content-Range does not match response size of ",
+        response.payload.size()));
+  }
+  std::vector<ByteRangeResponsePart> parts;
+  parts.push_back(ByteRangeResponsePart{
+      {content_range.inclusive_min, content_range.exclusive_max},
+      content_range.total_size,
+      response.payload});
+  return parts;
+}
+
 }  // namespace internal_http
 }  // namespace tensorstore
@@ -17,10 +17,15 @@
 
 #include <stdint.h>
 
+#include <string>
+#include <vector>
+
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
 #include "tensorstore/internal/http/http_response.h"
 #include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
 
 namespace tensorstore {
 namespace internal_http {
@@ -34,6 +39,29 @@ absl::Status ValidateResponseByteRange(
     const OptionalByteRangeRequest& byte_range_request, absl::Cord& value,
     ByteRange& byte_range, int64_t& total_size);
 
+/// Byte range of an object contained in an HTTP 206 response.
+struct ByteRangeResponsePart {
+  ByteRange byte_range;
+
+  /// Total size of the object, or `-1` if unknown.
+  int64_t total_size;
+
+  absl::Cord value;
+};
+
+/// Returns the `Range` header value that requests all of `byte_ranges`, e.g.
+/// `"bytes=0-9,20-29"`.
+std::string FormatMultiRangeHeader(span<const ByteRange> byte_ranges);
+
+/// Returns the byte ranges contained in an HTTP 206 response, which is either
+/// a single byte range specified by the `Content-Range` header, or a
+/// `multipart/byteranges` payload.
+///
+/// The server may return the requested byte ranges in any order, and may
+/// merge or omit some of them.
+Result<std::vector<ByteRangeResponsePart>> ParseByteRangeResponseParts(
+    const HttpResponse& response);
+
 }  // namespace internal_http
 }  // namespace tensorstore
 
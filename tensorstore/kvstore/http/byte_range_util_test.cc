@@ -0,0 +1,110 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/http/byte_range_util.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "tensorstore/internal/http/http_header.h"
+#include "tensorstore/internal/http/http_response.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::ByteRange;
+using ::tensorstore::span;
+using ::tensorstore::StatusIs;
+using ::tensorstore::internal_http::FormatMultiRangeHeader;
+using ::tensorstore::internal_http::HeaderMap;
+using ::tensorstore::internal_http::HttpResponse;
+using ::tensorstore::internal_http::ParseByteRangeResponseParts;
+
+TEST(FormatMultiRangeHeaderTest, Basic) {
+  const ByteRange byte_ranges[] = {{0, 10}, {20, 30}, {100, 101}};
+  EXPECT_EQ("bytes=0-9", FormatMultiRangeHeader(span(byte_ranges, 1)));
+  EXPECT_EQ("bytes=0-9,20-29,100-100", FormatMultiRangeHeader(byte_ranges));
+}
+
+TEST(ParseByteRangeResponsePartsTest, SinglePart) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto parts, ParseByteRangeResponseParts(HttpResponse{
+                      206, absl::Cord("abcde"),
+                      HeaderMap{{"content-range", "bytes 10-14/50"}}}));
+  ASSERT_EQ(1, parts.size());
+  EXPECT_EQ((ByteRange{10, 15}), parts[0].byte_range);
+  EXPECT_EQ(50, parts[0].total_size);
+  EXPECT_EQ("abcde", parts[0].value);
+}
+
+TEST(ParseByteRangeResponsePartsTest, Multipart) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto parts,
+      ParseByteRangeResponseParts(HttpResponse{
+          206,
+          absl::Cord("preamble\r\n"
+                     "--XYZ\r\n"
+                     "Content-Type: application/octet-stream\r\n"
+                     "Content-Range: bytes 0-4/100\r\n"
+                     "\r\n"
+                     "ab\r\nc\r\n"
+                     "--XYZ\r\n"
+                     "content-range: bytes 90-92/*\r\n"
+                     "\r\n"
+                     "--X\r\n"
+                     "--XYZ--\r\n"),
+          HeaderMap{{"content-type",
+                     "multipart/byteranges; boundary=\"XYZ\""}}}));
+  ASSERT_EQ(2, parts.size());
+  EXPECT_EQ((ByteRange{0, 5}), parts[0].byte_range);
+  EXPECT_EQ(100, parts[0].total_size);
+  EXPECT_EQ("ab\r\nc", parts[0].value);
+  EXPECT_EQ((ByteRange{90, 93}), parts[1].byte_range);
+  EXPECT_EQ(-1, parts[1].total_size);
+  EXPECT_EQ("--X", parts[1].value);
+}
+
+TEST(ParseByteRangeResponsePartsTest, Invalid) {
+  // Not a partial response.
+  EXPECT_THAT(ParseByteRangeResponseParts(
+                  HttpResponse{200, absl::Cord("abcde"), HeaderMap{}}),
+              StatusIs(absl::StatusCode::kFailedPrecondition));
+  // Size does not match the content range.
+  EXPECT_THAT(ParseByteRangeResponseParts(HttpResponse{
+                  206, absl::Cord("abc"),
+                  HeaderMap{{"content-range", "bytes 10-14/50"}}}),
+              StatusIs(absl::StatusCode::kFailedPrecondition));
+  const HeaderMap multipart_headers{
+      {"content-type", "multipart/byteranges; boundary=XYZ"}};
+  // Missing boundary.
+  EXPECT_THAT(ParseByteRangeResponseParts(
+                  HttpResponse{206, absl::Cord("abcde"), multipart_headers}),
+              StatusIs(absl::StatusCode::kFailedPrecondition));
+  // Missing content range.
+  EXPECT_THAT(
+      ParseByteRangeResponseParts(HttpResponse{
+          206, absl::Cord("--XYZ\r\n\r\nabc\r\n--XYZ--"), multipart_headers}),
+      StatusIs(absl::StatusCode::kFailedPrecondition));
+  // Truncated part.
+  EXPECT_THAT(ParseByteRangeResponseParts(HttpResponse{
+                  206,
+                  absl::Cord("--XYZ\r\ncontent-range: bytes 0-9/10\r\n\r\nabc"),
+                  multipart_headers}),
+              StatusIs(absl::StatusCode::kFailedPrecondition));
+}
+
+}  // namespace
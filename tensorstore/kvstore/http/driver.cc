@@ -30,15 +30,16 @@
 #include "absl/strings/str_format.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
+#include "tensorstore/batch.h"
 #include "tensorstore/context.h"
 #include "tensorstore/context_resource_provider.h"
 #include "tensorstore/internal/concurrency_resource.h"
 #include "tensorstore/internal/concurrency_resource_provider.h"
-#include "tensorstore/internal/http/default_transport.h"
 #include "tensorstore/internal/http/http_header.h"
 #include "tensorstore/internal/http/http_request.h"
 #include "tensorstore/internal/http/http_response.h"
 #include "tensorstore/internal/http/http_transport.h"
+#include "tensorstore/internal/http/http_transport_resource.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
 #include "tensorstore/internal/log/verbose_flag.h"
@@ -47,12 +48,15 @@
 #include "tensorstore/internal/path.h"
 #include "tensorstore/internal/retries_context_resource.h"
 #include "tensorstore/internal/retry.h"
+#include "tensorstore/internal/thread/thread_pool.h"
 #include "tensorstore/internal/uri_utils.h"
+#include "tensorstore/kvstore/adaptive_coalescing.h"
 #include "tensorstore/kvstore/batch_util.h"
 #include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/generic_coalescing_batch_util.h"
 #include "tensorstore/kvstore/http/byte_range_util.h"
+#include "tensorstore/kvstore/http/parallel_read.h"
 #include "tensorstore/kvstore/operations.h"
 #include "tensorstore/kvstore/read_result.h"
 #include "tensorstore/kvstore/registry.h"
@@ -63,6 +67,7 @@
 #include "tensorstore/util/garbage_collection/fwd.h"
 #include "tensorstore/util/quote_string.h"
 #include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
 #include "tensorstore/util/status.h"
 #include "tensorstore/util/str_cat.h"
 
@@ -110,7 +115,8 @@ struct HttpRequestRetries
 struct HttpRequestConcurrencyResourceTraits
     : public internal::ConcurrencyResourceTraits,
       public internal::ContextResourceTraits<HttpRequestConcurrencyResource> {
-  HttpRequestConcurrencyResourceTraits() : ConcurrencyResourceTraits(32) {}
+  HttpRequestConcurrencyResourceTraits()
+      : ConcurrencyResourceTraits(32, HttpRequestConcurrencyResource::id) {}
 };
 const internal::ContextResourceRegistration<
     HttpRequestConcurrencyResourceTraits>
@@ -156,9 +162,13 @@ struct HttpKeyValueStoreSpecData {
   Context::Resource<HttpRequestConcurrencyResource> request_concurrency;
   Context::Resource<HttpRequestRetries> retries;
   std::vector<std::string> headers;
+  internal_http::ParallelReadOptions parallel_read;
+  int64_t max_ranges_per_request = 1;
+  Context::Resource<internal_http::HttpTransportResource> http_transport;
 
   constexpr static auto ApplyMembers = [](auto& x, auto f) {
-    return f(x.base_url, x.request_concurrency, x.retries, x.headers);
+    return f(x.base_url, x.request_concurrency, x.retries, x.headers,
+             x.parallel_read, x.max_ranges_per_request, x.http_transport);
   };
 
   constexpr static auto default_json_binder = jb::Object(
@@ -180,7 +190,18 @@ struct HttpKeyValueStoreSpecData {
           HttpRequestConcurrencyResource::id,
           jb::Projection<&HttpKeyValueStoreSpecData::request_concurrency>()),
       jb::Member(HttpRequestRetries::id,
-                 jb::Projection<&HttpKeyValueStoreSpecData::retries>())
+                 jb::Projection<&HttpKeyValueStoreSpecData::retries>()),
+      jb::Member("parallel_read",
+                 jb::Projection<&HttpKeyValueStoreSpecData::parallel_read>(
+                     jb::DefaultInitializedValue<jb::kNeverIncludeDefaults>())),
+      jb::Member(
+          "max_ranges_per_request",
+          jb::Projection<&HttpKeyValueStoreSpecData::max_ranges_per_request>(
+              jb::DefaultValue<jb::kNeverIncludeDefaults>(
+                  [](auto* v) { *v = 1; }, jb::Integer<int64_t>(1, 1024)))),
+      jb::Member(
+          internal_http::HttpTransportResource::id,
+          jb::Projection<&HttpKeyValueStoreSpecData::http_transport>())
       /**/
   );
 
@@ -229,9 +250,8 @@ class HttpKeyValueStore
     : public internal_kvstore::RegisteredDriver<HttpKeyValueStore,
                                                 HttpKeyValueStoreSpec> {
  public:
-  internal_kvstore_batch::CoalescingOptions GetBatchReadCoalescingOptions()
-      const {
-    return internal_kvstore_batch::kDefaultRemoteStorageCoalescingOptions;
+  internal_kvstore_batch::AdaptiveCoalescingOptions& batch_read_coalescing() {
+    return batch_read_coalescing_;
   }
 
   Future<ReadResult> Read(Key key, ReadOptions options) override;
@@ -253,21 +273,40 @@ class HttpKeyValueStore
   HttpKeyValueStoreSpecData spec_;
 
   std::shared_ptr<HttpTransport> transport_;
+  internal_kvstore_batch::AdaptiveCoalescingOptions batch_read_coalescing_{
+      internal_kvstore_batch::kDefaultRemoteStorageCoalescingOptions, "http"};
 };
 
 Future<kvstore::DriverPtr> HttpKeyValueStoreSpec::DoOpen() const {
   auto driver = internal::MakeIntrusivePtr<HttpKeyValueStore>();
   driver->spec_ = data_;
-  driver->transport_ = internal_http::GetDefaultHttpTransport();
+  driver->transport_ = data_.http_transport->GetTransport();
+  data_.http_transport->PrewarmConnections(data_.base_url);
   return driver;
 }
 
+/// State of a single request for multiple byte ranges of an object.
+struct MultiRangeRead {
+  /// Requested byte ranges, in increasing order.
+  std::vector<ByteRange> byte_ranges;
+
+  /// Byte ranges returned by the server, set by `ReadTask::HandleResult`.
+  /// Requested byte ranges that are not contained in any part must be read
+  /// separately.
+  std::vector<internal_http::ByteRangeResponsePart> parts;
+};
+
 /// A ReadTask is a function object used to satisfy a
 /// HttpKeyValueStore::Read request.
 struct ReadTask {
   IntrusivePtr<HttpKeyValueStore> owner;
   std::string url;
   kvstore::ReadOptions options;
+  // Set when the read is one part of a `ParallelRead`.
+  std::shared_ptr<internal_http::ReadPart> part;
+  // Set when the read requests multiple byte ranges; `options.byte_range` is
+  // ignored.
+  std::shared_ptr<MultiRangeRead> multi_range;
 
   HttpResponse httpresponse;
 
@@ -277,7 +316,11 @@ struct ReadTask {
     for (const auto& header : owner->spec_.headers) {
       request_builder.ParseAndAddHeader(header);
     }
-    if (options.byte_range.size() != 0) {
+    if (multi_range) {
+      request_builder.AddHeader(
+          "range", internal_http::FormatMultiRangeHeader(
+                       multi_range->byte_ranges));
+    } else if (options.byte_range.size() != 0) {
       request_builder.MaybeAddRangeHeader(options.byte_range);
     }
 
@@ -364,7 +407,26 @@ struct ReadTask {
     }
 
     absl::Cord value;
-    if (options.byte_range.size() != 0) {
+    if (multi_range) {
+      if (httpresponse.status_code == 206) {
+        // Byte ranges of an unexpected response are read separately.
+        if (auto parts =
+                internal_http::ParseByteRangeResponseParts(httpresponse);
+            parts.ok()) {
+          multi_range->parts = *std::move(parts);
+        }
+      } else if (httpresponse.headers.find("content-encoding") ==
+                 httpresponse.headers.end()) {
+        // The server ignored the `Range` header and returned the entire
+        // object.
+        const int64_t size = httpresponse.payload.size();
+        multi_range->parts.push_back(internal_http::ByteRangeResponsePart{
+            {0, size}, size, httpresponse.payload});
+      }
+    } else if (part) {
+      TENSORSTORE_RETURN_IF_ERROR(internal_http::ValidateReadPartResponse(
+          httpresponse, options.byte_range, *part, value));
+    } else if (options.byte_range.size() != 0) {
       // Currently unused
       ByteRange byte_range;
       int64_t total_size;
@@ -432,19 +494,193 @@ struct ReadTask {
   }
 };
 
+/// Batch read entry that coalesces the byte ranges requested for an object,
+/// like `GenericCoalescingBatchReadEntry`, and then reads up to
+/// `max_ranges_per_request` of the coalesced byte ranges with each
+/// multi-range request.
+struct HttpBatchReadEntry
+    : public internal_kvstore_batch::GenericCoalescingBatchReadEntryBase<
+          HttpKeyValueStore>,
+      public internal::AtomicReferenceCount<HttpBatchReadEntry> {
+  using Base = internal_kvstore_batch::GenericCoalescingBatchReadEntryBase<
+      HttpKeyValueStore>;
+  using BatchEntryKey = typename Base::BatchEntryKey;
+  using Request = typename Base::Request;
+
+  struct CoalescedRead {
+    ByteRange byte_range;
+    span<Request> requests;
+  };
+
+  explicit HttpBatchReadEntry(BatchEntryKey&& batch_entry_key_)
+      : Base(std::move(batch_entry_key_)),
+        // Create an initial reference count that is implicitly transferred to
+        // `Submit`.
+        internal::AtomicReferenceCount<HttpBatchReadEntry>(
+            /*initial_ref_count=*/1) {}
+
+  // Submit is responsible for destroying the entry when done.
+  void Submit(Batch::View batch) final {
+    if (request_batch.requests.empty()) return;
+    driver().executor()([this] { ProcessBatch(); });
+  }
+
+  void ProcessBatch() {
+    // Take ownership of the initial reference.  A separate reference is held
+    // for each request.
+    IntrusivePtr<HttpBatchReadEntry> self(this, internal::adopt_object_ref);
+    std::vector<CoalescedRead> reads;
+    internal_kvstore_batch::ForEachCoalescedRequest<Request>(
+        request_batch.requests, driver().batch_read_coalescing().Get(),
+        [&](ByteRange byte_range, span<Request> requests) {
+          reads.push_back(CoalescedRead{byte_range, requests});
+        });
+    const size_t max_ranges = driver().spec_.max_ranges_per_request;
+    for (size_t i = 0; i < reads.size(); i += max_ranges) {
+      const size_t n = std::min(max_ranges, reads.size() - i);
+      if (n == 1) {
+        ReadCoalesced(self, reads[i]);
+      } else {
+        ReadMultiRange(self, std::vector<CoalescedRead>(
+                                 reads.begin() + i, reads.begin() + i + n));
+      }
+    }
+  }
+
+  kvstore::ReadOptions GetReadOptions() const {
+    kvstore::ReadOptions options;
+    options.generation_conditions =
+        std::get<kvstore::ReadGenerationConditions>(batch_entry_key);
+    options.staleness_bound = request_batch.staleness_bound;
+    return options;
+  }
+
+  // Reads a single coalesced byte range.
+  static void ReadCoalesced(IntrusivePtr<HttpBatchReadEntry> self,
+                            CoalescedRead read) {
+    auto options = self->GetReadOptions();
+    options.byte_range = read.byte_range;
+    const absl::Time start_time = absl::Now();
+    auto read_future = self->driver().ReadImpl(
+        kvstore::Key(std::get<kvstore::Key>(self->batch_entry_key)),
+        std::move(options));
+    read_future.Force();
+    // The continuation runs inline on the thread that completes the read if
+    // that is a `request_concurrency` worker or if the byte range is small;
+    // otherwise it is submitted to `request_concurrency`.
+    internal::InlineContinuationExecutor executor{
+        self->driver().executor(),
+        static_cast<size_t>(read.byte_range.size())};
+    std::move(read_future)
+        .ExecuteWhenReady(WithExecutor(
+            std::move(executor),
+            [self = std::move(self), read,
+             start_time](ReadyFuture<kvstore::ReadResult> future) {
+              TENSORSTORE_ASSIGN_OR_RETURN(
+                  auto&& read_result, future.result(),
+                  internal_kvstore_batch::SetCommonResult(read.requests, _));
+              if (read_result.has_value()) {
+                self->driver().batch_read_coalescing().Record(
+                    read_result.value.size(), absl::Now() - start_time);
+              }
+              internal_kvstore_batch::ResolveCoalescedRequests(
+                  read.byte_range, read.requests, std::move(read_result));
+            }));
+  }
+
+  // Reads multiple coalesced byte ranges with a single request.  Byte ranges
+  // that are not returned by the server are read separately.
+  static void ReadMultiRange(IntrusivePtr<HttpBatchReadEntry> self,
+                             std::vector<CoalescedRead> reads) {
+    auto multi_range = std::make_shared<MultiRangeRead>();
+    for (const auto& read : reads) {
+      multi_range->byte_ranges.push_back(read.byte_range);
+    }
+    http_batch_read.Increment();
+    auto& driver = self->driver();
+    auto read_future = MapFuture(
+        driver.executor(),
+        ReadTask{IntrusivePtr<HttpKeyValueStore>(&driver),
+                 driver.spec_.GetUrl(std::get<kvstore::Key>(
+                     self->batch_entry_key)),
+                 self->GetReadOptions(), nullptr, multi_range});
+    // The continuation resolves the requests of every byte range, so its cost
+    // is their total size.
+    size_t cost = 0;
+    for (const auto& read : reads) cost += read.byte_range.size();
+    internal::InlineContinuationExecutor executor{driver.executor(), cost};
+    std::move(read_future)
+        .ExecuteWhenReady(WithExecutor(
+            std::move(executor),
+            [self = std::move(self), reads = std::move(reads),
+             multi_range = std::move(multi_range)](
+                ReadyFuture<kvstore::ReadResult> future) {
+              const auto& result = future.result();
+              for (const auto& read : reads) {
+                if (!result.ok()) {
+                  internal_kvstore_batch::SetCommonResult(read.requests,
+                                                          result.status());
+                  continue;
+                }
+                if (!result->has_value()) {
+                  internal_kvstore_batch::ResolveCoalescedRequests(
+                      read.byte_range, read.requests,
+                      kvstore::ReadResult(*result));
+                  continue;
+                }
+                auto it = std::find_if(
+                    multi_range->parts.begin(), multi_range->parts.end(),
+                    [&](const auto& part) {
+                      return part.byte_range.inclusive_min <=
+                                 read.byte_range.inclusive_min &&
+                             read.byte_range.exclusive_max <=
+                                 part.byte_range.exclusive_max;
+                    });
+                if (it == multi_range->parts.end()) {
+                  ReadCoalesced(self, read);
+                  continue;
+                }
+                internal_kvstore_batch::ResolveCoalescedRequests(
+                    read.byte_range, read.requests,
+                    kvstore::ReadResult::Value(
+                        it->value.Subcord(read.byte_range.inclusive_min -
+                                              it->byte_range.inclusive_min,
+                                          read.byte_range.size()),
+                        result->stamp));
+              }
+            }));
+  }
+};
+
 Future<kvstore::ReadResult> HttpKeyValueStore::Read(Key key,
                                                     ReadOptions options) {
   http_read.Increment();
-  return internal_kvstore_batch::HandleBatchRequestByGenericByteRangeCoalescing(
-      *this, std::move(key), std::move(options));
+  if (spec_.max_ranges_per_request <= 1 || !options.batch ||
+      options.byte_range.IsFull() || !options.byte_range.IsRange()) {
+    return internal_kvstore_batch::
+        HandleBatchRequestByGenericByteRangeCoalescing(*this, std::move(key),
+                                                       std::move(options));
+  }
+  auto [promise, future] = PromiseFuturePair<kvstore::ReadResult>::Make();
+  HttpBatchReadEntry::MakeRequest<HttpBatchReadEntry>(
+      *this, std::move(key), std::move(options.generation_conditions),
+      options.batch, options.staleness_bound,
+      HttpBatchReadEntry::Request{{std::move(promise), options.byte_range}});
+  return std::move(future);
 }
 
 Future<kvstore::ReadResult> HttpKeyValueStore::ReadImpl(Key&& key,
                                                         ReadOptions&& options) {
-  http_batch_read.Increment();
   std::string url = spec_.GetUrl(key);
-  return MapFuture(executor(), ReadTask{IntrusivePtr<HttpKeyValueStore>(this),
-                                        std::move(url), std::move(options)});
+  return internal_http::ParallelRead(
+      std::move(options), spec_.parallel_read,
+      [self = IntrusivePtr<HttpKeyValueStore>(this), url = std::move(url)](
+          ReadOptions options, std::shared_ptr<internal_http::ReadPart> part) {
+        http_batch_read.Increment();
+        return MapFuture(self->executor(),
+                         ReadTask{self, url, std::move(options),
+                                  std::move(part)});
+      });
 }
 
 Result<kvstore::Spec> ParseHttpUrl(std::string_view url) {
@@ -14,8 +14,11 @@
 
 #include "tensorstore/kvstore/driver.h"
 
+#include <stdint.h>
+
 #include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <gmock/gmock.h>
@@ -206,6 +209,99 @@ TEST_F(HttpKeyValueStoreTest, ReadBatch) {
       MatchesKvsReadResult(absl::Cord("01234"), StorageGeneration::Invalid()));
 }
 
+// Issues batched reads of two byte ranges that are too far apart to be
+// coalesced.
+std::vector<Future<kvstore::ReadResult>> ReadMultiRangeBatch() {
+  auto store = kvstore::Open({{"driver", "http"},
+                              {"base_url", "https://example.com/my/path/"},
+                              {"max_ranges_per_request", 2}})
+                   .value();
+  std::vector<Future<kvstore::ReadResult>> futures;
+  auto batch = Batch::New();
+  for (int64_t start : {0, 10000}) {
+    kvstore::ReadOptions options;
+    options.byte_range.inclusive_min = start;
+    options.byte_range.exclusive_max = start + 10;
+    options.batch = batch;
+    futures.push_back(kvstore::Read(store, "abc", options));
+  }
+  return futures;
+}
+
+TEST_F(HttpKeyValueStoreTest, ReadBatchMultiRange) {
+  auto futures = ReadMultiRangeBatch();
+  auto request = mock_transport->requests_.pop();
+  EXPECT_EQ("https://example.com/my/path/abc", request.request.url);
+  EXPECT_THAT(request.request.method, "GET");
+  EXPECT_THAT(request.request.headers,
+              ElementsAre(Pair("cache-control", "no-cache"),
+                          Pair("range", "bytes=0-9,10000-10009")));
+  request.set_result(HttpResponse{
+      206,
+      absl::Cord("--XYZ\r\n"
+                 "content-range: bytes 10000-10009/20000\r\n\r\n"
+                 "0123456789\r\n"
+                 "--XYZ\r\n"
+                 "content-range: bytes 0-9/20000\r\n\r\n"
+                 "abcdefghij\r\n"
+                 "--XYZ--\r\n"),
+      HeaderMap{{"content-type", "multipart/byteranges; boundary=XYZ"},
+                {"etag", "\"abc\""}}});
+  EXPECT_THAT(futures[0].result(),
+              MatchesKvsReadResult(absl::Cord("abcdefghij"),
+                                   StorageGeneration::FromString("abc")));
+  EXPECT_THAT(futures[1].result(),
+              MatchesKvsReadResult(absl::Cord("0123456789"),
+                                   StorageGeneration::FromString("abc")));
+  EXPECT_TRUE(mock_transport->requests_.empty());
+}
+
+TEST_F(HttpKeyValueStoreTest, ReadBatchMultiRangeSingleRangeResponse) {
+  auto futures = ReadMultiRangeBatch();
+  {
+    auto request = mock_transport->requests_.pop();
+    EXPECT_THAT(request.request.headers,
+                ElementsAre(Pair("cache-control", "no-cache"),
+                            Pair("range", "bytes=0-9,10000-10009")));
+    // The server only returns the first byte range.
+    request.set_result(
+        HttpResponse{206, absl::Cord("abcdefghij"),
+                     HeaderMap{{"content-range", "bytes 0-9/20000"}}});
+  }
+  {
+    auto request = mock_transport->requests_.pop();
+    EXPECT_THAT(request.request.headers,
+                ElementsAre(Pair("cache-control", "no-cache"),
+                            Pair("range", "bytes=10000-10009")));
+    request.set_result(
+        HttpResponse{206, absl::Cord("0123456789"),
+                     HeaderMap{{"content-range", "bytes 10000-10009/20000"}}});
+  }
+  EXPECT_THAT(futures[0].result(),
+              MatchesKvsReadResult(absl::Cord("abcdefghij"),
+                                   StorageGeneration::Invalid()));
+  EXPECT_THAT(futures[1].result(),
+              MatchesKvsReadResult(absl::Cord("0123456789"),
+                                   StorageGeneration::Invalid()));
+}
+
+TEST_F(HttpKeyValueStoreTest, ReadBatchMultiRangeIgnored) {
+  auto futures = ReadMultiRangeBatch();
+  auto request = mock_transport->requests_.pop();
+  // The server returns the entire object.
+  std::string value(10010, 'x');
+  value.replace(0, 10, "abcdefghij");
+  value.replace(10000, 10, "0123456789");
+  request.set_result(HttpResponse{200, absl::Cord(value), HeaderMap{}});
+  EXPECT_THAT(futures[0].result(),
+              MatchesKvsReadResult(absl::Cord("abcdefghij"),
+                                   StorageGeneration::Invalid()));
+  EXPECT_THAT(futures[1].result(),
+              MatchesKvsReadResult(absl::Cord("0123456789"),
+                                   StorageGeneration::Invalid()));
+  EXPECT_TRUE(mock_transport->requests_.empty());
+}
+
 TEST_F(HttpKeyValueStoreTest, ReadZeroByteRange) {
   TENSORSTORE_ASSERT_OK_AND_ASSIGN(
       auto store, kvstore::Open("https://example.com/my/path/").result());
@@ -0,0 +1,201 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/http/parallel_read.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "tensorstore/internal/http/http_response.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/http/byte_range_util.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/util/division.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace internal_http {
+namespace {
+
+struct ParallelReadState {
+  kvstore::ReadOptions options;
+  ParallelReadOptions parallel_options;
+  ReadPartFunction read_part;
+  std::shared_ptr<ReadPart> first_part;
+
+  // Reads `options` with a single request.
+  void ReadWhole(Promise<kvstore::ReadResult> promise) const {
+    LinkResult(std::move(promise), read_part(options, nullptr));
+  }
+};
+
+void OnRemainingParts(std::shared_ptr<ParallelReadState> state,
+                      Promise<kvstore::ReadResult> promise,
+                      kvstore::ReadResult first,
+                      std::vector<Future<kvstore::ReadResult>> parts,
+                      const absl::Status& status) {
+  if (!status.ok()) {
+    promise.SetResult(status);
+    return;
+  }
+  absl::Cord value = std::move(first.value);
+  for (auto& part : parts) {
+    auto& result = part.result();
+    if (!result->has_value()) {
+      // The object changed after the first part was read.
+      state->ReadWhole(std::move(promise));
+      return;
+    }
+    value.Append(std::move(result->value));
+  }
+  promise.SetResult(
+      kvstore::ReadResult::Value(std::move(value), std::move(first.stamp)));
+}
+
+void OnFirstPart(std::shared_ptr<ParallelReadState> state,
+                 Promise<kvstore::ReadResult> promise,
+                 ReadyFuture<kvstore::ReadResult> future) {
+  auto& result = future.result();
+  if (!result.ok()) {
+    if (absl::IsOutOfRange(result.status())) {
+      // The object is smaller than the requested range, or empty; a single
+      // request reports the appropriate result.
+      state->ReadWhole(std::move(promise));
+      return;
+    }
+    promise.SetResult(result.status());
+    return;
+  }
+  if (!result->has_value()) {
+    promise.SetResult(std::move(result));
+    return;
+  }
+  const auto& byte_range = state->options.byte_range;
+  const int64_t total_size = state->first_part->total_size;
+  const int64_t start =
+      byte_range.inclusive_min + static_cast<int64_t>(result->value.size());
+  const int64_t end =
+      byte_range.exclusive_max == -1 ? total_size : byte_range.exclusive_max;
+  if (end != -1 && start >= end) {
+    promise.SetResult(std::move(result));
+    return;
+  }
+  if (end == -1 || (total_size != -1 && end > total_size) ||
+      !StorageGeneration::IsCleanValidValue(result->stamp.generation)) {
+    // The remaining parts cannot be read consistently.
+    state->ReadWhole(std::move(promise));
+    return;
+  }
+
+  const int64_t remaining = end - start;
+  const int64_t num_parts =
+      std::min(state->parallel_options.max_parts - 1,
+               CeilOfRatio(remaining, state->parallel_options.part_size));
+  const int64_t part_size = CeilOfRatio(remaining, num_parts);
+
+  kvstore::ReadOptions part_options;
+  part_options.generation_conditions.if_equal = result->stamp.generation;
+  part_options.staleness_bound = state->options.staleness_bound;
+  std::vector<Future<kvstore::ReadResult>> parts;
+  parts.reserve(num_parts);
+  for (int64_t i = start; i < end; i += part_size) {
+    part_options.byte_range =
+        OptionalByteRangeRequest::Range(i, std::min(i + part_size, end));
+    parts.push_back(state->read_part(part_options, nullptr));
+  }
+  auto all_ready = WaitAllFuture(tensorstore::span(parts));
+  all_ready.ExecuteWhenReady(
+      [state = std::move(state), promise = std::move(promise),
+       first = *std::move(result),
+       parts = std::move(parts)](ReadyFuture<void> ready) mutable {
+        OnRemainingParts(std::move(state), std::move(promise),
+                         std::move(first), std::move(parts), ready.status());
+      });
+}
+
+}  // namespace
+
+absl::Status ValidateReadPartResponse(
+    const HttpResponse& response,
+    const OptionalByteRangeRequest& byte_range_request, ReadPart& part,
+    absl::Cord& value) {
+  ByteRange byte_range;
+  if (!part.allow_truncated || response.status_code != 206) {
+    return ValidateResponseByteRange(response, byte_range_request, value,
+                                     byte_range, part.total_size);
+  }
+  value = response.payload;
+  TENSORSTORE_ASSIGN_OR_RETURN(auto content_range,
+                               ParseContentRangeHeader(response));
+  byte_range = {content_range.inclusive_min, content_range.exclusive_max};
+  part.total_size = content_range.total_size;
+  if (byte_range.inclusive_min != byte_range_request.inclusive_min ||
+      byte_range.size() != static_cast<int64_t>(value.size()) ||
+      (byte_range.exclusive_max != byte_range_request.exclusive_max &&
+       byte_range.exclusive_max != part.total_size)) {
+    return absl::OutOfRangeError(
+        tensorstore::StrCat("Requested byte range ", byte_range_request,
+                            " was not satisfied by response with byte range ",
+                            byte_range, " and total size ", part.total_size));
+  }
+  return absl::OkStatus();
+}
+
+Future<kvstore::ReadResult> ParallelRead(
+    kvstore::ReadOptions options, const ParallelReadOptions& parallel_options,
+    ReadPartFunction read_part) {
+  const auto& byte_range = options.byte_range;
+  if (!parallel_options.enabled() || byte_range.inclusive_min < 0 ||
+      byte_range.size() == 0 ||
+      (byte_range.exclusive_max != -1 &&
+       byte_range.size() <= parallel_options.part_size)) {
+    return read_part(std::move(options), nullptr);
+  }
+
+  auto state = std::make_shared<ParallelReadState>();
+  state->parallel_options = parallel_options;
+  state->read_part = std::move(read_part);
+  state->first_part = std::make_shared<ReadPart>();
+  state->first_part->allow_truncated = true;
+
+  kvstore::ReadOptions first_options = options;
+  first_options.byte_range.exclusive_max =
+      byte_range.inclusive_min + parallel_options.part_size;
+  state->options = std::move(options);
+  auto future = state->read_part(std::move(first_options), state->first_part);
+  // Errors of the first part are handled by `OnFirstPart`, so the promise is
+  // not linked to `future`.
+  auto pair = PromiseFuturePair<kvstore::ReadResult>::Make();
+  future.ExecuteWhenReady(
+      [state = std::move(state), promise = std::move(pair.promise)](
+          ReadyFuture<kvstore::ReadResult> future) mutable {
+        OnFirstPart(std::move(state), std::move(promise), std::move(future));
+      });
+  return std::move(pair.future);
+}
+
+}  // namespace internal_http
+}  // namespace tensorstore
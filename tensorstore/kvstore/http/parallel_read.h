@@ -0,0 +1,110 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_HTTP_PARALLEL_READ_H_
+#define TENSORSTORE_KVSTORE_HTTP_PARALLEL_READ_H_
+
+#include <stdint.h>
+
+#include <functional>
+#include <memory>
+
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "tensorstore/internal/http/http_response.h"
+#include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace internal_http {
+
+/// Specifies how a read of a large object is split into concurrent byte-range
+/// requests.
+struct ParallelReadOptions {
+  constexpr static int64_t kDefaultPartSize = 64 * 1024 * 1024;
+
+  /// Minimum size of each byte-range request.
+  int64_t part_size = kDefaultPartSize;
+
+  /// Maximum number of byte-range requests issued for one read.  A value of
+  /// `1` disables parallel reads.
+  int64_t max_parts = 1;
+
+  bool enabled() const { return max_parts > 1; }
+
+  constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+    return f(x.part_size, x.max_parts);
+  };
+
+  constexpr static auto default_json_binder = internal_json_binding::Object(
+      internal_json_binding::Member(
+          "part_size",
+          internal_json_binding::Projection<&ParallelReadOptions::part_size>(
+              internal_json_binding::DefaultValue<
+                  internal_json_binding::kNeverIncludeDefaults>(
+                  [](auto* v) { *v = kDefaultPartSize; },
+                  internal_json_binding::Integer<int64_t>(1)))),
+      internal_json_binding::Member(
+          "max_parts",
+          internal_json_binding::Projection<&ParallelReadOptions::max_parts>(
+              internal_json_binding::DefaultValue<
+                  internal_json_binding::kNeverIncludeDefaults>(
+                  [](auto* v) { *v = 1; },
+                  internal_json_binding::Integer<int64_t>(1, 1024))))
+      /**/);
+};
+
+/// State of one byte-range request issued by `ParallelRead`.
+struct ReadPart {
+  /// Whether the response may end before the requested byte range, at the end
+  /// of the object.
+  bool allow_truncated = false;
+
+  /// Total size of the object, set by `ValidateReadPartResponse`, or `-1` if
+  /// unknown.
+  int64_t total_size = -1;
+};
+
+/// Reads the byte range `options.byte_range` of the object.  If `part` is
+/// non-null, the response is validated by `ValidateReadPartResponse`.
+using ReadPartFunction = std::function<Future<kvstore::ReadResult>(
+    kvstore::ReadOptions options, std::shared_ptr<ReadPart> part)>;
+
+/// Validates the response to a byte-range request issued for `part`, like
+/// `ValidateResponseByteRange`, and records the total size of the object.
+absl::Status ValidateReadPartResponse(
+    const HttpResponse& response,
+    const OptionalByteRangeRequest& byte_range_request, ReadPart& part,
+    absl::Cord& value);
+
+/// Reads `options.byte_range` using concurrent byte-range requests of at least
+/// `parallel_options.part_size` bytes each.
+///
+/// The first part determines the size and generation of the object; the
+/// remaining parts are conditioned on that generation, and are appended to the
+/// first without copying.  If the object changes between requests, it is read
+/// again with a single request.  Reads that are not larger than one part, and
+/// suffix-length reads, are issued as a single request.
+Future<kvstore::ReadResult> ParallelRead(
+    kvstore::ReadOptions options, const ParallelReadOptions& parallel_options,
+    ReadPartFunction read_part);
+
+}  // namespace internal_http
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_HTTP_PARALLEL_READ_H_
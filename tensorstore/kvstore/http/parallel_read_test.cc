@@ -0,0 +1,163 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/http/parallel_read.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/time/clock.h"
+#include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/test_matchers.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::Future;
+using ::tensorstore::OptionalByteRangeRequest;
+using ::tensorstore::StatusIs;
+using ::tensorstore::StorageGeneration;
+using ::tensorstore::TimestampedStorageGeneration;
+using ::tensorstore::internal::MatchesKvsReadResult;
+using ::tensorstore::internal_http::ParallelRead;
+using ::tensorstore::internal_http::ParallelReadOptions;
+using ::tensorstore::internal_http::ReadPart;
+using ::tensorstore::kvstore::ReadOptions;
+using ::tensorstore::kvstore::ReadResult;
+
+// In-memory object that records the byte ranges requested from it.
+struct FakeObject {
+  std::string value;
+  StorageGeneration generation = StorageGeneration::FromString("g1");
+  std::vector<OptionalByteRangeRequest> requests;
+
+  Future<ReadResult> Read(ReadOptions options, std::shared_ptr<ReadPart> part) {
+    requests.push_back(options.byte_range);
+    TimestampedStorageGeneration stamp{generation, absl::Now()};
+    if (!StorageGeneration::IsUnknown(options.generation_conditions.if_equal) &&
+        options.generation_conditions.if_equal != generation) {
+      return ReadResult::Unspecified(
+          TimestampedStorageGeneration{StorageGeneration::Unknown(),
+                                       stamp.time});
+    }
+    const int64_t size = value.size();
+    auto byte_range = options.byte_range;
+    if (part && part->allow_truncated) {
+      part->total_size = size;
+      if (byte_range.inclusive_min >= size) {
+        return absl::OutOfRangeError("Range not satisfiable");
+      }
+      byte_range.exclusive_max = std::min(byte_range.exclusive_max, size);
+    }
+    TENSORSTORE_ASSIGN_OR_RETURN(auto resolved, byte_range.Validate(size));
+    return ReadResult::Value(
+        absl::Cord(value.substr(resolved.inclusive_min, resolved.size())),
+        stamp);
+  }
+
+  Future<ReadResult> ParallelRead(ReadOptions options, int64_t part_size,
+                                  int64_t max_parts) {
+    ParallelReadOptions parallel_options;
+    parallel_options.part_size = part_size;
+    parallel_options.max_parts = max_parts;
+    return tensorstore::internal_http::ParallelRead(
+        std::move(options), parallel_options,
+        [this](ReadOptions options, std::shared_ptr<ReadPart> part) {
+          return Read(std::move(options), std::move(part));
+        });
+  }
+};
+
+TEST(ParallelReadTest, Disabled) {
+  FakeObject object{"abcdefghijklmnopqrst"};
+  EXPECT_THAT(object.ParallelRead({}, 4, 1).result(),
+              MatchesKvsReadResult(absl::Cord(object.value)));
+  EXPECT_THAT(object.requests, ::testing::SizeIs(1));
+}
+
+TEST(ParallelReadTest, WholeObject) {
+  FakeObject object{"abcdefghijklmnopqrst"};
+  EXPECT_THAT(object.ParallelRead({}, 4, 3).result(),
+              MatchesKvsReadResult(absl::Cord(object.value)));
+  EXPECT_THAT(object.requests,
+              ::testing::ElementsAre(OptionalByteRangeRequest::Range(0, 4),
+                                     OptionalByteRangeRequest::Range(4, 12),
+                                     OptionalByteRangeRequest::Range(12, 20)));
+}
+
+TEST(ParallelReadTest, ByteRange) {
+  FakeObject object{"abcdefghijklmnopqrst"};
+  ReadOptions options;
+  options.byte_range = OptionalByteRangeRequest::Range(2, 15);
+  EXPECT_THAT(object.ParallelRead(options, 4, 16).result(),
+              MatchesKvsReadResult(absl::Cord("cdefghijklmno")));
+  EXPECT_THAT(object.requests, ::testing::SizeIs(4));
+}
+
+TEST(ParallelReadTest, SmallObject) {
+  FakeObject object{"abc"};
+  EXPECT_THAT(object.ParallelRead({}, 4, 3).result(),
+              MatchesKvsReadResult(absl::Cord("abc")));
+  EXPECT_THAT(object.requests, ::testing::SizeIs(1));
+}
+
+TEST(ParallelReadTest, EmptyObject) {
+  FakeObject object{""};
+  EXPECT_THAT(object.ParallelRead({}, 4, 3).result(),
+              MatchesKvsReadResult(absl::Cord()));
+}
+
+TEST(ParallelReadTest, ByteRangePastEnd) {
+  FakeObject object{"abcdefghij"};
+  ReadOptions options;
+  options.byte_range = OptionalByteRangeRequest::Range(0, 15);
+  EXPECT_THAT(object.ParallelRead(options, 4, 3).result(),
+              StatusIs(absl::StatusCode::kOutOfRange));
+}
+
+// If the parts do not match the generation of the first part, the object is
+// read again with a single request.
+TEST(ParallelReadTest, GenerationChanged) {
+  FakeObject object{"abcdefghijklmnopqrst"};
+  ParallelReadOptions parallel_options;
+  parallel_options.part_size = 4;
+  parallel_options.max_parts = 3;
+  int calls = 0;
+  auto changed = ParallelRead(
+      {}, parallel_options,
+      [&](ReadOptions options, std::shared_ptr<ReadPart> part) {
+        if (calls++ == 1) {
+          object.value = "ABCDEFGHIJKLMNOPQRST";
+          object.generation = StorageGeneration::FromString("g2");
+        }
+        return object.Read(std::move(options), std::move(part));
+      });
+  EXPECT_THAT(changed.result(),
+              MatchesKvsReadResult(absl::Cord("ABCDEFGHIJKLMNOPQRST")));
+  EXPECT_EQ(4, calls);
+}
+
+}  // namespace
@@ -15,38 +15,47 @@
 #ifndef TENSORSTORE_KVSTORE_KVSTACK_RANGE_MAP_H_
 #define TENSORSTORE_KVSTORE_KVSTACK_RANGE_MAP_H_
 
+#include <stddef.h>
+
+#include <algorithm>
 #include <cassert>
 #include <iterator>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
-#include "absl/container/btree_set.h"
 #include "tensorstore/kvstore/key_range.h"
 
 namespace tensorstore {
 namespace internal_kvstack {
 
+/// Maps disjoint key ranges to values.
+///
+/// The ranges are stored in a flat vector sorted by `inclusive_min`, such that
+/// lookups are a binary search over contiguous memory.  Modifications are
+/// linear in the number of ranges, which is acceptable since the map is
+/// normally constructed once and then only queried.
 template <typename V>
 class KeyRangeMap {
-  struct Compare;
-
  public:
   struct Value {
     KeyRange range;
     V value;
   };
   using value_type = Value;
-  using const_iterator =
-      typename absl::btree_set<Value, Compare>::const_iterator;
+  using const_iterator = typename std::vector<Value>::const_iterator;
 
   const_iterator begin() const { return table_.begin(); }
   const_iterator end() const { return table_.end(); }
+  size_t size() const { return table_.size(); }
+  bool empty() const { return table_.empty(); }
 
   // Lookup the range containing the key.
   const_iterator range_containing(std::string_view key) const {
     auto it = range_containing_impl(key);
-    return Contains(it->range, key) ? it : table_.end();
+    return (it != table_.end() && Contains(it->range, key)) ? it
+                                                             : table_.end();
   }
 
   // Sets the range to the provided value, overriding existing values.
@@ -54,43 +63,43 @@ class KeyRangeMap {
   void Set(KeyRange range, V2&& value) {
     // Erase the range, then insert the new range.
     Erase(range);
-    [[maybe_unused]] auto insert_result =
-        table_.insert(Value{std::move(range), std::forward<V2>(value)});
-    assert(insert_result.second);
+    auto it = LowerBound(range.inclusive_min);
+    assert(it == table_.end() ||
+           it->range.inclusive_min != range.inclusive_min);
+    table_.insert(it, Value{std::move(range), std::forward<V2>(value)});
   }
 
   // Erase values associated with the range.
   void Erase(const KeyRange& range) {
+    if (range.empty()) return;
     // Split at the inclusive_min.
-    const_iterator it = range_containing_impl(range.inclusive_min);
-    if (it != table_.end()) {
-      if (range.inclusive_min > it->range.inclusive_min) {
-        // Split entry to two:
-        //   [it->range.inclusive_min .. range.inclusive_min)
-        //   [range.inclusive_min .. it->range.exclusive_max)
-        std::string tmp = range.inclusive_min;
-        std::swap(const_cast<KeyRange&>(it->range).exclusive_max, tmp);
-        it = table_.insert(
-            it,
-            Value{KeyRange(range.inclusive_min, std::move(tmp)), it->value});
-      }
+    size_t i = range_containing_impl(range.inclusive_min) - table_.begin();
+    if (i == table_.size()) return;
+    if (range.inclusive_min > table_[i].range.inclusive_min &&
+        Contains(table_[i].range, range.inclusive_min)) {
+      // Split entry to two:
+      //   [inclusive_min .. range.inclusive_min)
+      //   [range.inclusive_min .. exclusive_max)
+      std::string tmp = range.inclusive_min;
+      std::swap(table_[i].range.exclusive_max, tmp);
+      Value split{KeyRange(range.inclusive_min, std::move(tmp)),
+                  table_[i].value};
+      table_.insert(table_.begin() + i + 1, std::move(split));
+    }
+    if (table_[i].range.inclusive_min < range.inclusive_min) ++i;
 
-      // Erase everything fully covered.
-      while (it != table_.end() && Contains(range, it->range)) {
-        it = table_.erase(it);
-      }
+    // Erase everything fully covered.
+    size_t end_i = i;
+    while (end_i < table_.size() && Contains(range, table_[end_i].range)) {
+      ++end_i;
+    }
+    table_.erase(table_.begin() + i, table_.begin() + end_i);
 
-      if (it != table_.end() && it->range.inclusive_min < range.exclusive_max) {
-        // Adjust the final entry.
-#if 0
-        // The proper way to do this, however.
-        auto node = table_.extract(it);
-        node.value().range.inclusive_min = range.exclusive_max;
-        auto insert_result = table_.insert(std::move(node));
-        assert(insert_result.inserted);
-#endif
-        const_cast<KeyRange&>(it->range).inclusive_min = range.exclusive_max;
-      }
+    if (i < table_.size() &&
+        KeyRange::CompareKeyAndExclusiveMax(table_[i].range.inclusive_min,
+                                            range.exclusive_max) < 0) {
+      // Adjust the final entry.
+      table_[i].range.inclusive_min = range.exclusive_max;
     }
   }
 
@@ -99,10 +108,9 @@ class KeyRangeMap {
   void VisitRange(const KeyRange& range, Fn&& fn) const {
     if (range.empty()) return;
     auto it = range_containing_impl(range.inclusive_min);
-    auto end = range.exclusive_max.empty()
-                   ? table_.end()
-                   : table_.lower_bound(range.exclusive_max);
-    for (; it != end; ++it) {
+    auto end = range.exclusive_max.empty() ? table_.end()
+                                           : LowerBound(range.exclusive_max);
+    for (; it < end; ++it) {
       KeyRange intersect = Intersect(range, it->range);
       if (!intersect.empty()) {
         fn(intersect, it->value);
@@ -111,31 +119,25 @@ class KeyRangeMap {
   }
 
  private:
-  const_iterator range_containing_impl(std::string_view key) const {
-    const_iterator it = table_.lower_bound(key);
-    if (it == table_.end() || it->range.inclusive_min > key) {
-      if (it != table_.begin() && !table_.empty()) {
-        return std::prev(it);
-      }
-    }
-    return it;
+  // Returns the first range with `inclusive_min >= key`.
+  const_iterator LowerBound(std::string_view key) const {
+    return std::lower_bound(table_.begin(), table_.end(), key,
+                            [](const Value& a, std::string_view b) {
+                              return a.range.inclusive_min < b;
+                            });
   }
 
-  struct Compare {
-    using is_transparent = void;
-
-    bool operator()(const Value& a, const Value& b) const {
-      return a.range.inclusive_min < b.range.inclusive_min;
-    }
-    bool operator()(const Value& a, std::string_view b) const {
-      return a.range.inclusive_min < b;
-    }
-    bool operator()(std::string_view a, const Value& b) const {
-      return a < b.range.inclusive_min;
-    }
-  };
+  // Returns the last range with `inclusive_min <= key`, or the first range if
+  // there is none.
+  const_iterator range_containing_impl(std::string_view key) const {
+    auto it = std::upper_bound(table_.begin(), table_.end(), key,
+                               [](std::string_view a, const Value& b) {
+                                 return a < b.range.inclusive_min;
+                               });
+    return it == table_.begin() ? it : std::prev(it);
+  }
 
-  absl::btree_set<Value, Compare> table_;
+  std::vector<Value> table_;
 };
 
 }  // namespace internal_kvstack
@@ -433,11 +433,13 @@ Future<const void> KvStack::ExperimentalCopyRangeFrom(
   return WaitAllFuture(tensorstore::span(copy_futures));
 }
 
-// ListReceiver which issues kvstore::List requests in order.
+// ListReceiver which issues kvstore::List requests to all intersecting layers
+// concurrently.
+//
+// Since List doesn't guarantee any particular order and the layer ranges are
+// disjoint, entries are forwarded as they arrive rather than merged.
 struct KvStackListState final
     : public internal::AtomicReferenceCount<KvStackListState> {
-  using Self = internal::IntrusivePtr<KvStackListState>;
-
   struct V {
     KeyRange range;
     kvstore::KvStore kvstore;
@@ -446,20 +448,22 @@ struct KvStackListState final
 
   internal::OpenTransactionPtr transaction_;
   ListOptions options_;
-  ListReceiver receiver_;
   std::vector<V> ranges_;
-  std::atomic<size_t> pos_{0};
+
+  // Serializes calls to `receiver_` from the concurrent layer lists.
+  absl::Mutex receiver_mutex_;
+  ListReceiver receiver_ ABSL_GUARDED_BY(receiver_mutex_);
 
   absl::Mutex mutex_;
-  std::optional<AnyCancelReceiver> cancel_ ABSL_GUARDED_BY(mutex_);
+  std::vector<std::optional<AnyCancelReceiver>> cancel_ ABSL_GUARDED_BY(mutex_);
+  bool cancelled_ ABSL_GUARDED_BY(mutex_) = false;
+  absl::Status status_ ABSL_GUARDED_BY(mutex_);
 
   KvStackListState(KvStack& driver, internal::OpenTransactionPtr transaction,
                    ListOptions options, ListReceiver receiver)
       : transaction_(std::move(transaction)),
         options_(std::move(options)),
         receiver_(std::move(receiver)) {
-    // Note that List doesn't guarantee any particular order so it would be
-    // fine to list all intersecting layers in parallel.
     driver.layers_.VisitRange(
         options_.range, [this](KeyRange intersect, auto& mapped) {
           std::string prefix_to_add =
@@ -469,90 +473,123 @@ struct KvStackListState final
           ranges_.push_back(
               V{std::move(range), mapped.kvstore, std::move(prefix_to_add)});
         });
+    cancel_.resize(ranges_.size());
 
+    absl::MutexLock lock(&receiver_mutex_);
     execution::set_starting(receiver_, [this] { DoCancel(); });
   }
 
-  ~KvStackListState() { execution::set_stopping(receiver_); }
+  ~KvStackListState() {
+    absl::Status status;
+    {
+      absl::MutexLock lock(&mutex_);
+      status = std::move(status_);
+    }
+    absl::MutexLock lock(&receiver_mutex_);
+    if (status.ok()) {
+      execution::set_done(receiver_);
+    } else {
+      execution::set_error(receiver_, std::move(status));
+    }
+    execution::set_stopping(receiver_);
+  }
+
+  void SetCancel(size_t i, AnyCancelReceiver cancel) {
+    {
+      absl::MutexLock lock(&mutex_);
+      if (!cancelled_) {
+        cancel_[i] = std::move(cancel);
+        return;
+      }
+    }
+    cancel();
+  }
 
-  void SetCancel(AnyCancelReceiver cancel) {
+  void ClearCancel(size_t i) {
     absl::MutexLock lock(&mutex_);
-    cancel_ = std::move(cancel);
+    cancel_[i] = std::nullopt;
   }
 
   void DoCancel() {
-    absl::MutexLock lock(&mutex_);
-    if (cancel_) (*cancel_)();
-    cancel_ = std::nullopt;
-    pos_ = ranges_.size();
+    std::vector<std::optional<AnyCancelReceiver>> cancel;
+    {
+      absl::MutexLock lock(&mutex_);
+      if (cancelled_) return;
+      cancelled_ = true;
+      cancel.swap(cancel_);
+      cancel_.resize(ranges_.size());
+    }
+    for (auto& c : cancel) {
+      if (c) (*c)();
+    }
+  }
+
+  // Records the first error and cancels the remaining layers.
+  void SetError(absl::Status status) {
+    {
+      absl::MutexLock lock(&mutex_);
+      if (!status_.ok()) return;
+      status_ = std::move(status);
+    }
+    DoCancel();
   }
 
   /// AnyFlowReceiver implementation.
   struct Receiver {
-    IntrusivePtr<KvStackListState> state;
-    V* v;
+    internal::IntrusivePtr<KvStackListState> state;
+    size_t i;
 
     /// AnyFlowReceiver methods.
     [[maybe_unused]] friend void set_starting(Receiver& self,
                                               AnyCancelReceiver cancel) {
-      self.state->SetCancel(std::move(cancel));
+      self.state->SetCancel(self.i, std::move(cancel));
     }
 
     [[maybe_unused]] friend void set_value(Receiver& self, ListEntry entry) {
-      if (!self.v->prefix_to_add.empty()) {
-        entry.key = tensorstore::StrCat(self.v->prefix_to_add, entry.key);
+      auto& v = self.state->ranges_[self.i];
+      if (!v.prefix_to_add.empty()) {
+        entry.key = tensorstore::StrCat(v.prefix_to_add, entry.key);
       }
+      absl::MutexLock lock(&self.state->receiver_mutex_);
       execution::set_value(self.state->receiver_, std::move(entry));
     }
 
     [[maybe_unused]] friend void set_done(Receiver& self) {
-      // set_done is not propagated; StartNextRange handles it on the
-      // last range instead of starting a new range.
+      // set_done is not propagated; it is sent by ~KvStackListState once all
+      // layers have completed.
     }
 
     [[maybe_unused]] friend void set_error(Receiver& self, absl::Status s) {
-      execution::set_error(self.state->receiver_, std::move(s));
-      self.v = nullptr;
+      self.state->SetError(std::move(s));
     }
 
     [[maybe_unused]] friend void set_stopping(Receiver& self) {
-      auto* state = self.state.get();
-      if (self.v) state->StartNextRange(std::move(self.state));
+      self.state->ClearCancel(self.i);
+      self.state.reset();
     }
   };
 
-  static void StartNextRange(internal::IntrusivePtr<KvStackListState> state) {
-    size_t idx;
-    {
-      absl::MutexLock lock(&state->mutex_);
-      state->cancel_ = std::nullopt;
-      idx = state->pos_.fetch_add(1);
-    }
-    if (idx < state->ranges_.size()) {
-      auto& v = state->ranges_[idx];
+  static void Start(internal::IntrusivePtr<KvStackListState> state) {
+    for (size_t i = 0; i < state->ranges_.size(); ++i) {
+      auto& v = state->ranges_[i];
       ListOptions options;
       options.range = KeyRange::AddPrefix(v.kvstore.path, v.range);
       options.strip_prefix_length =
           state->options_.strip_prefix_length + v.kvstore.path.size();
       options.staleness_bound = state->options_.staleness_bound;
       if (state->transaction_) {
-        const auto& transaction = state->transaction_;
-        v.kvstore.driver->TransactionalListImpl(transaction, std::move(options),
-                                                Receiver{std::move(state), &v});
+        v.kvstore.driver->TransactionalListImpl(
+            state->transaction_, std::move(options), Receiver{state, i});
       } else {
-        v.kvstore.driver->ListImpl(std::move(options),
-                                   Receiver{std::move(state), &v});
+        v.kvstore.driver->ListImpl(std::move(options), Receiver{state, i});
       }
-    } else if (idx == state->ranges_.size()) {
-      execution::set_done(state->receiver_);
     }
   }
 };
 
 void KvStack::ListImpl(ListOptions options, ListReceiver receiver) {
-  // Ownership of the pointer is transferred to the kvstore::List calls via
-  // the sequence of StartNextRange() calls.
-  KvStackListState::StartNextRange(internal::MakeIntrusivePtr<KvStackListState>(
+  // The state completes `receiver` once the last layer list releases it.
+  KvStackListState::Start(internal::MakeIntrusivePtr<KvStackListState>(
       *this, internal::OpenTransactionPtr{}, std::move(options),
       std::move(receiver)));
 }
@@ -560,9 +597,8 @@ void KvStack::ListImpl(ListOptions options, ListReceiver receiver) {
 void KvStack::TransactionalListImpl(
     const internal::OpenTransactionPtr& transaction, ListOptions options,
     ListReceiver receiver) {
-  // Ownership of the pointer is transferred to the kvstore::List calls via
-  // the sequence of StartNextRange() calls.
-  KvStackListState::StartNextRange(internal::MakeIntrusivePtr<KvStackListState>(
+  // The state completes `receiver` once the last layer list releases it.
+  KvStackListState::Start(internal::MakeIntrusivePtr<KvStackListState>(
       *this, transaction, std::move(options), std::move(receiver)));
 }
 
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <string>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -122,6 +123,33 @@ TEST_F(KvStackTest, TransactionalList) {
                   MatchesListEntry("b1", -1))));
 }
 
+TEST_F(KvStackTest, ListManyLayers) {
+  ::nlohmann::json::array_t layers;
+  for (int i = 0; i < 100; ++i) {
+    layers.push_back({
+        {"base", {{"driver", "memory"}, {"path", "base/"}}},
+        {"prefix", absl::StrFormat("k%03d/", i)},
+    });
+  }
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", "kvstack"}, {"layers", layers}}, context_)
+          .result());
+
+  std::vector<::testing::Matcher<kvstore::ListEntry>> expected;
+  for (int i = 0; i < 100; i += 3) {
+    auto key = absl::StrFormat("k%03d/x", i);
+    TENSORSTORE_EXPECT_OK(kvstore::Write(store, key, absl::Cord("abc")));
+    if (i >= 10 && i < 50) expected.push_back(MatchesListEntry(key, 3));
+  }
+
+  kvstore::ListOptions options;
+  options.range = KeyRange("k010/", "k050/");
+  EXPECT_THAT(kvstore::ListFuture(store, options).result(),
+              ::testing::Optional(
+                  ::testing::UnorderedElementsAreArray(expected)));
+}
+
 TEST_F(KvStackTest, PrefixCheck) {
   TENSORSTORE_ASSERT_OK_AND_ASSIGN(
       auto base, kvstore::Open({{"driver", "memory"}}, context_).result());
@@ -28,6 +28,7 @@
 
 #include "absl/base/thread_annotations.h"
 #include "absl/container/btree_map.h"
+#include "absl/hash/hash.h"
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
 #include "absl/synchronization/mutex.h"
@@ -37,7 +38,6 @@
 #include "tensorstore/context_resource_provider.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
-#include "tensorstore/internal/mutex.h"
 #include "tensorstore/internal/uri_utils.h"
 #include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/driver.h"
@@ -81,6 +81,11 @@ TimestampedStorageGeneration GenerationNow(StorageGeneration generation) {
 /// `MemoryKeyValueStoreResource`, while also allowing an equivalent
 /// `MemoryDriver` to be constructed from the
 /// `MemoryKeyValueStoreResource`.
+///
+/// Keys are partitioned by hash into `kNumShards` independently-locked
+/// shards, such that concurrent reads and writes of different keys rarely
+/// contend.  Operations on a range of keys (`List` and `DeleteRange`) visit
+/// every shard, and atomic transactions lock all shards.
 struct StoredKeyValuePairs
     : public internal::AtomicReferenceCount<StoredKeyValuePairs> {
   using Ptr = internal::IntrusivePtr<StoredKeyValuePairs>;
@@ -93,26 +98,127 @@ struct StoredKeyValuePairs
   };
 
   using Map = absl::btree_map<std::string, ValueWithGenerationNumber>;
-  std::pair<Map::iterator, Map::iterator> Find(const std::string& inclusive_min,
-                                               const std::string& exclusive_max)
-      ABSL_SHARED_LOCKS_REQUIRED(mutex) {
-    return {values.lower_bound(inclusive_min),
-            exclusive_max.empty() ? values.end()
-                                  : values.lower_bound(exclusive_max)};
+
+  struct Shard {
+    std::pair<Map::iterator, Map::iterator> Find(
+        const std::string& inclusive_min, const std::string& exclusive_max)
+        ABSL_SHARED_LOCKS_REQUIRED(mutex) {
+      return {values.lower_bound(inclusive_min),
+              exclusive_max.empty() ? values.end()
+                                    : values.lower_bound(exclusive_max)};
+    }
+
+    std::pair<Map::iterator, Map::iterator> Find(const KeyRange& range)
+        ABSL_SHARED_LOCKS_REQUIRED(mutex) {
+      return Find(range.inclusive_min, range.exclusive_max);
+    }
+
+    absl::Mutex mutex;
+    Map values ABSL_GUARDED_BY(mutex);
+  };
+
+  constexpr static size_t kNumShards = 16;
+
+  explicit StoredKeyValuePairs(size_t total_bytes_limit)
+      : total_bytes_limit(total_bytes_limit) {}
+
+  Shard& GetShard(std::string_view key) {
+    return shards[absl::HashOf(key) % kNumShards];
+  }
+
+  /// Returns the bytes charged against `total_bytes_limit` for an entry.
+  static int64_t EntryBytes(std::string_view key, const absl::Cord& value) {
+    return static_cast<int64_t>(key.size() + value.size());
   }
 
-  std::pair<Map::iterator, Map::iterator> Find(const KeyRange& range)
-      ABSL_SHARED_LOCKS_REQUIRED(mutex) {
-    return Find(range.inclusive_min, range.exclusive_max);
+  /// Returns an error if adding `change` bytes would exceed
+  /// `total_bytes_limit`.
+  ///
+  /// To be exact, all shards must be locked.
+  absl::Status CheckBytesAvailable(int64_t change) const {
+    if (change <= 0 || total_bytes_limit == 0 ||
+        total_bytes.load(std::memory_order_relaxed) + change <=
+            static_cast<int64_t>(total_bytes_limit)) {
+      return absl::OkStatus();
+    }
+    return LimitExceededError();
+  }
+
+  /// Reserves `change` additional bytes, or returns an error if that would
+  /// exceed `total_bytes_limit`.  A negative `change` always succeeds.
+  absl::Status ReserveBytes(int64_t change) {
+    const int64_t old_total =
+        total_bytes.fetch_add(change, std::memory_order_relaxed);
+    if (change <= 0 || total_bytes_limit == 0 ||
+        old_total + change <= static_cast<int64_t>(total_bytes_limit)) {
+      return absl::OkStatus();
+    }
+    total_bytes.fetch_sub(change, std::memory_order_relaxed);
+    return LimitExceededError();
+  }
+
+  absl::Status LimitExceededError() const {
+    return absl::ResourceExhaustedError(tensorstore::StrCat(
+        "Memory key-value store limit of ", total_bytes_limit,
+        " bytes exceeded"));
+  }
+
+  /// Erases `it` from `shard`, releasing its bytes.
+  void Erase(Shard& shard, Map::iterator it)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex) {
+    total_bytes.fetch_sub(EntryBytes(it->first, it->second.value),
+                          std::memory_order_relaxed);
+    shard.values.erase(it);
+  }
+
+  /// Erases the keys in `[inclusive_min, exclusive_max)` from `shard`.
+  void EraseRange(Shard& shard, const std::string& inclusive_min,
+                  const std::string& exclusive_max)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex) {
+    auto [begin, end] = shard.Find(inclusive_min, exclusive_max);
+    int64_t released = 0;
+    for (auto it = begin; it != end; ++it) {
+      released += EntryBytes(it->first, it->second.value);
+    }
+    total_bytes.fetch_sub(released, std::memory_order_relaxed);
+    shard.values.erase(begin, end);
   }
 
-  absl::Mutex mutex;
   /// Next generation number to use when updating the value associated with a
   /// key.  Using a single per-store counter rather than a per-key counter
   /// ensures that creating a key, deleting it, then creating it again does
   /// not result in the same generation number being reused for a given key.
-  uint64_t next_generation_number ABSL_GUARDED_BY(mutex) = 0;
-  Map values ABSL_GUARDED_BY(mutex);
+  std::atomic<uint64_t> next_generation_number{0};
+
+  /// Total size of all keys and values.
+  std::atomic<int64_t> total_bytes{0};
+
+  /// Limit on `total_bytes`, or `0` for no limit.
+  const size_t total_bytes_limit;
+
+  Shard shards[kNumShards];
+};
+
+/// Acquires exclusive locks on all shards of a `StoredKeyValuePairs`, in
+/// order, for the duration of an atomic multi-key operation.
+class LockAllShards {
+ public:
+  explicit LockAllShards(StoredKeyValuePairs& data)
+      ABSL_NO_THREAD_SAFETY_ANALYSIS : data_(data) {
+    for (auto& shard : data_.shards) shard.mutex.Lock();
+  }
+
+  ~LockAllShards() { unlock(); }
+
+  void unlock() ABSL_NO_THREAD_SAFETY_ANALYSIS {
+    if (!locked_) return;
+    locked_ = false;
+    for (auto& shard : data_.shards) shard.mutex.Unlock();
+  }
+
+ private:
+  StoredKeyValuePairs& data_;
+  bool locked_ = true;
 };
 
 /// Defines the context resource (see `tensorstore/context.h`) that actually
@@ -120,17 +226,30 @@ struct StoredKeyValuePairs
 struct MemoryKeyValueStoreResource
     : public internal::ContextResourceTraits<MemoryKeyValueStoreResource> {
   constexpr static char id[] = "memory_key_value_store";
-  struct Spec {};
+  struct Spec {
+    /// Limit on the total size of keys and values, or `0` for no limit.
+    size_t total_bytes_limit = 0;
+
+    constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+      return f(x.total_bytes_limit);
+    };
+  };
   using Resource = StoredKeyValuePairs::Ptr;
   static Spec Default() { return {}; }
-  static constexpr auto JsonBinder() { return jb::Object(); }
+  static constexpr auto JsonBinder() {
+    return jb::Object(jb::Member(
+        "total_bytes_limit",
+        jb::Projection(&Spec::total_bytes_limit,
+                       jb::DefaultValue([](auto* v) { *v = 0; }))));
+  }
   static Result<Resource> Create(
-      Spec, internal::ContextResourceCreationContext context) {
-    return StoredKeyValuePairs::Ptr(new StoredKeyValuePairs);
+      Spec spec, internal::ContextResourceCreationContext context) {
+    return StoredKeyValuePairs::Ptr(
+        new StoredKeyValuePairs(spec.total_bytes_limit));
   }
-  static Spec GetSpec(const Resource&,
+  static Spec GetSpec(const Resource& resource,
                       const internal::ContextSpecBuilder& builder) {
-    return {};
+    return {resource->total_bytes_limit};
   }
 };
 
@@ -247,8 +366,8 @@ class MemoryDriver::TransactionNode
 
   /// Commits a (possibly multi-key) transaction atomically.
   ///
-  /// The commit involves two steps, both while holding a lock on the entire
-  /// KeyValueStore:
+  /// The commit involves three steps, all while holding a lock on every shard
+  /// of the KeyValueStore:
   ///
   /// 1. Without making any modifications, validates that the underlying
   ///    KeyValueStore data matches the generation constraints specified in the
@@ -256,23 +375,33 @@ class MemoryDriver::TransactionNode
   ///    normally results in any modifications being "rebased" on top of any
   ///    modified values.
   ///
-  /// 2. If validation succeeds, applies the modifications.
+  /// 2. Checks that the store's memory limit would not be exceeded, and
+  ///    otherwise fails the transaction.
+  ///
+  /// 3. If validation succeeds, applies the modifications.
   void AllEntriesDone(
-      internal_kvstore::SinglePhaseMutation& single_phase_mutation) override
-      ABSL_NO_THREAD_SAFETY_ANALYSIS {
+      internal_kvstore::SinglePhaseMutation& single_phase_mutation) override {
     if (!single_phase_mutation.remaining_entries_.HasError()) {
       auto& data = static_cast<MemoryDriver&>(*this->driver()).data();
-      TimestampedStorageGeneration generation;
-      UniqueWriterLock lock(data.mutex);
+      LockAllShards lock(data);
       absl::Time commit_time = absl::Now();
       if (!ValidateEntryConditions(data, single_phase_mutation, commit_time)) {
         lock.unlock();
         this->RetryAtomicWriteback(commit_time);
         return;
       }
-      ApplyMutation(data, single_phase_mutation, commit_time);
-      lock.unlock();
-      this->AtomicCommitWritebackSuccess();
+      if (auto status = data.CheckBytesAvailable(
+              GetAddedBytes(data, single_phase_mutation));
+          !status.ok()) {
+        lock.unlock();
+        this->SetError(std::move(status));
+        single_phase_mutation.remaining_entries_.SetError();
+        internal_kvstore::WritebackError(single_phase_mutation);
+      } else {
+        ApplyMutation(data, single_phase_mutation, commit_time);
+        lock.unlock();
+        this->AtomicCommitWritebackSuccess();
+      }
     } else {
       internal_kvstore::WritebackError(single_phase_mutation);
     }
@@ -281,10 +410,12 @@ class MemoryDriver::TransactionNode
 
   /// Validates that the underlying `data` matches the generation constraints
   /// specified in the transaction.  No changes are made to the `data`.
+  ///
+  /// All shards must be locked.
   static bool ValidateEntryConditions(
       StoredKeyValuePairs& data,
       internal_kvstore::SinglePhaseMutation& single_phase_mutation,
-      const absl::Time& commit_time) ABSL_SHARED_LOCKS_REQUIRED(data.mutex) {
+      const absl::Time& commit_time) {
     bool validated = true;
     for (auto& entry : single_phase_mutation.entries_) {
       if (!ValidateEntryConditions(data, entry, commit_time)) {
@@ -296,8 +427,7 @@ class MemoryDriver::TransactionNode
 
   static bool ValidateEntryConditions(StoredKeyValuePairs& data,
                                       internal_kvstore::MutationEntry& entry,
-                                      const absl::Time& commit_time)
-      ABSL_SHARED_LOCKS_REQUIRED(data.mutex) {
+                                      const absl::Time& commit_time) {
     if (entry.entry_type() == kReadModifyWrite) {
       return ValidateEntryConditions(
           data, static_cast<BufferedReadModifyWriteEntry&>(entry), commit_time);
@@ -319,15 +449,16 @@ class MemoryDriver::TransactionNode
   static bool ValidateEntryConditions(StoredKeyValuePairs& data,
                                       BufferedReadModifyWriteEntry& entry,
                                       const absl::Time& commit_time)
-      ABSL_SHARED_LOCKS_REQUIRED(data.mutex) {
+      ABSL_NO_THREAD_SAFETY_ANALYSIS {
     auto& stamp = entry.stamp();
     auto if_equal = StorageGeneration::Clean(stamp.generation);
     if (StorageGeneration::IsUnknown(if_equal)) {
       assert(stamp.time == absl::InfiniteFuture());
       return true;
     }
-    auto it = data.values.find(entry.key_);
-    if (it == data.values.end()) {
+    auto& shard = data.GetShard(entry.key_);
+    auto it = shard.values.find(entry.key_);
+    if (it == shard.values.end()) {
       if (StorageGeneration::IsNoValue(if_equal)) {
         stamp.time = commit_time;
         return true;
@@ -339,14 +470,44 @@ class MemoryDriver::TransactionNode
     return false;
   }
 
+  /// Returns the number of bytes added by the written values in the
+  /// transaction.  Deleted ranges are not subtracted, so this is an upper
+  /// bound on the net change.
+  ///
+  /// All shards must be locked.
+  static int64_t GetAddedBytes(
+      StoredKeyValuePairs& data,
+      internal_kvstore::SinglePhaseMutation& single_phase_mutation)
+      ABSL_NO_THREAD_SAFETY_ANALYSIS {
+    int64_t added = 0;
+    for (auto& entry : single_phase_mutation.entries_) {
+      if (entry.entry_type() != kReadModifyWrite) continue;
+      auto& rmw_entry = static_cast<BufferedReadModifyWriteEntry&>(entry);
+      if (!StorageGeneration::IsDirty(rmw_entry.stamp().generation) ||
+          rmw_entry.value_state_ != ReadResult::kValue) {
+        continue;
+      }
+      added += StoredKeyValuePairs::EntryBytes(rmw_entry.key_,
+                                               rmw_entry.value_);
+      auto& shard = data.GetShard(rmw_entry.key_);
+      if (auto it = shard.values.find(rmw_entry.key_);
+          it != shard.values.end()) {
+        added -= StoredKeyValuePairs::EntryBytes(it->first, it->second.value);
+      }
+    }
+    return added;
+  }
+
   /// Applies the changes in the transaction to the stored `data`.
   ///
   /// It is assumed that the constraints have already been validated by
   /// `ValidateConditions`.
+  ///
+  /// All shards must be locked.
   static void ApplyMutation(
       StoredKeyValuePairs& data,
       internal_kvstore::SinglePhaseMutation& single_phase_mutation,
-      const absl::Time& commit_time) ABSL_EXCLUSIVE_LOCKS_REQUIRED(data.mutex) {
+      const absl::Time& commit_time) ABSL_NO_THREAD_SAFETY_ANALYSIS {
     for (auto& entry : single_phase_mutation.entries_) {
       if (entry.entry_type() == kReadModifyWrite) {
         auto& rmw_entry = static_cast<BufferedReadModifyWriteEntry&>(entry);
@@ -354,33 +515,46 @@ class MemoryDriver::TransactionNode
         auto& orig_generation = rmw_entry.orig_generation_;
         stamp.time = commit_time;
         auto value_state = rmw_entry.value_state_;
+        auto& shard = data.GetShard(rmw_entry.key_);
         if (!StorageGeneration::IsDirty(stamp.generation)) {
           // Do nothing
           orig_generation = stamp.generation;
         } else if (value_state == ReadResult::kMissing) {
-          data.values.erase(rmw_entry.key_);
+          if (auto it = shard.values.find(rmw_entry.key_);
+              it != shard.values.end()) {
+            data.Erase(shard, it);
+          }
           orig_generation =
               std::exchange(stamp.generation, StorageGeneration::NoValue());
         } else {
           assert(value_state == ReadResult::kValue);
-          auto& v = data.values[rmw_entry.key_];
+          auto [it, inserted] = shard.values.try_emplace(rmw_entry.key_);
+          auto& v = it->second;
+          data.total_bytes.fetch_add(
+              StoredKeyValuePairs::EntryBytes(rmw_entry.key_,
+                                              rmw_entry.value_) -
+                  (inserted ? 0
+                            : StoredKeyValuePairs::EntryBytes(rmw_entry.key_,
+                                                              v.value)),
+              std::memory_order_relaxed);
           v.generation_number = data.next_generation_number++;
           v.value = std::move(rmw_entry.value_);
           orig_generation = std::exchange(stamp.generation, v.generation());
         }
       } else {
         auto& dr_entry = static_cast<DeleteRangeEntry&>(entry);
-        auto it_range = data.Find(dr_entry.key_, dr_entry.exclusive_max_);
-        data.values.erase(it_range.first, it_range.second);
+        for (auto& shard : data.shards) {
+          data.EraseRange(shard, dr_entry.key_, dr_entry.exclusive_max_);
+        }
       }
     }
   }
 };
 
 Future<ReadResult> MemoryDriver::Read(Key key, ReadOptions options) {
-  auto& data = this->data();
-  absl::ReaderMutexLock lock(&data.mutex);
-  auto& values = data.values;
+  auto& shard = data().GetShard(key);
+  absl::ReaderMutexLock lock(&shard.mutex);
+  auto& values = shard.values;
   auto it = values.find(key);
   if (it == values.end()) {
     // Key not found.
@@ -402,8 +576,9 @@ Future<TimestampedStorageGeneration> MemoryDriver::Write(
   using ValueWithGenerationNumber =
       StoredKeyValuePairs::ValueWithGenerationNumber;
   auto& data = this->data();
-  absl::WriterMutexLock lock(&data.mutex);
-  auto& values = data.values;
+  auto& shard = data.GetShard(key);
+  absl::WriterMutexLock lock(&shard.mutex);
+  auto& values = shard.values;
   auto it = values.find(key);
   if (it == values.end()) {
     // Key does not already exist.
@@ -416,6 +591,8 @@ Future<TimestampedStorageGeneration> MemoryDriver::Write(
       // Delete was requested, but key already doesn't exist.
       return GenerationNow(StorageGeneration::NoValue());
     }
+    TENSORSTORE_RETURN_IF_ERROR(
+        data.ReserveBytes(StoredKeyValuePairs::EntryBytes(key, *value)));
     // Insert the value it into the hash table with the next unused
     // generation number.
     it = values
@@ -433,9 +610,12 @@ Future<TimestampedStorageGeneration> MemoryDriver::Write(
   }
   if (!value) {
     // Delete request.
-    values.erase(it);
+    data.Erase(shard, it);
     return GenerationNow(StorageGeneration::NoValue());
   }
+  TENSORSTORE_RETURN_IF_ERROR(data.ReserveBytes(
+      static_cast<int64_t>(value->size()) -
+      static_cast<int64_t>(it->second.value.size())));
   // Set the generation number to the next unused generation number.
   it->second.generation_number = data.next_generation_number++;
   // Update the value.
@@ -445,10 +625,11 @@ Future<TimestampedStorageGeneration> MemoryDriver::Write(
 
 Future<const void> MemoryDriver::DeleteRange(KeyRange range) {
   auto& data = this->data();
-  absl::WriterMutexLock lock(&data.mutex);
   if (!range.empty()) {
-    auto it_range = data.Find(range);
-    data.values.erase(it_range.first, it_range.second);
+    for (auto& shard : data.shards) {
+      absl::WriterMutexLock lock(&shard.mutex);
+      data.EraseRange(shard, range.inclusive_min, range.exclusive_max);
+    }
   }
   return absl::OkStatus();  // Converted to a ReadyFuture.
 }
@@ -460,26 +641,25 @@ void MemoryDriver::ListImpl(ListOptions options, ListReceiver receiver) {
     cancelled.store(true, std::memory_order_relaxed);
   });
 
-  // Collect the keys.
-  std::vector<ListEntry> entries;
-  {
-    absl::ReaderMutexLock lock(&data.mutex);
-    auto it_range = data.Find(options.range);
+  // Collect the keys from each shard, and then merge them into key order.
+  std::vector<std::pair<std::string, int64_t>> entries;
+  for (auto& shard : data.shards) {
+    if (cancelled.load(std::memory_order_relaxed)) break;
+    absl::ReaderMutexLock lock(&shard.mutex);
+    auto it_range = shard.Find(options.range);
     for (auto it = it_range.first; it != it_range.second; ++it) {
-      if (cancelled.load(std::memory_order_relaxed)) break;
-      std::string_view key = it->first;
-      entries.push_back(ListEntry{
-          std::string(
-              key.substr(std::min(options.strip_prefix_length, key.size()))),
-          ListEntry::checked_size(it->second.value.size()),
-      });
+      entries.emplace_back(it->first, it->second.value.size());
     }
   }
+  std::sort(entries.begin(), entries.end());
 
   // Send the keys.
-  for (auto& entry : entries) {
+  for (auto& [key, size] : entries) {
     if (cancelled.load(std::memory_order_relaxed)) break;
-    execution::set_value(receiver, std::move(entry));
+    execution::set_value(
+        receiver,
+        ListEntry{key.substr(std::min(options.strip_prefix_length, key.size())),
+                  ListEntry::checked_size(size)});
   }
   execution::set_done(receiver);
   execution::set_stopping(receiver);
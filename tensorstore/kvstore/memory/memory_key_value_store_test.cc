@@ -15,17 +15,20 @@
 #include "tensorstore/kvstore/memory/memory_key_value_store.h"
 
 #include <string>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
+#include "absl/strings/str_format.h"
 #include <nlohmann/json.hpp>
 #include "tensorstore/context.h"
 #include "tensorstore/internal/cache_key/cache_key.h"
 #include "tensorstore/internal/global_initializer.h"
 #include "tensorstore/internal/testing/json_gtest.h"
 #include "tensorstore/json_serialization_options_base.h"
+#include "tensorstore/kvstore/key_range.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/kvstore/operations.h"
 #include "tensorstore/kvstore/spec.h"
@@ -39,6 +42,7 @@ namespace {
 
 namespace kvstore = tensorstore::kvstore;
 using ::tensorstore::Context;
+using ::tensorstore::KeyRange;
 using ::tensorstore::KvStore;
 using ::tensorstore::MatchesJson;
 using ::tensorstore::MatchesStatus;
@@ -297,4 +301,44 @@ TEST(MemoryKeyValueStoreTest, InvalidUri) {
                             ".*: Scheme \"memory://\" not present in url"));
 }
 
+TEST(MemoryKeyValueStoreTest, TotalBytesLimit) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto context,
+      Context::FromJson(
+          {{"memory_key_value_store", {{"total_bytes_limit", 10}}}}));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, kvstore::Open({{"driver", "memory"}}, context).result());
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("1234")));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "b", absl::Cord("1234")));
+  EXPECT_THAT(kvstore::Write(store, "c", absl::Cord("1234")).result(),
+              MatchesStatus(absl::StatusCode::kResourceExhausted));
+  EXPECT_THAT(kvstore::Read(store, "c").result(),
+              MatchesKvsReadResultNotFound());
+  // Overwriting with a value of the same size, or deleting, is permitted.
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("5678")));
+  TENSORSTORE_ASSERT_OK(kvstore::Delete(store, "b"));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "c", absl::Cord("1234")));
+  TENSORSTORE_ASSERT_OK(kvstore::DeleteRange(store, {}));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "d", absl::Cord("123456789")));
+}
+
+TEST(MemoryKeyValueStoreTest, ListAcrossShards) {
+  auto store = tensorstore::GetMemoryKeyValueStore();
+  std::vector<std::string> keys;
+  for (int i = 0; i < 100; ++i) {
+    keys.push_back(absl::StrFormat("key%03d", i));
+    TENSORSTORE_ASSERT_OK(
+        kvstore::Write(KvStore(store), keys.back(), absl::Cord("x")));
+  }
+  kvstore::ListOptions options;
+  options.range = KeyRange("key010", "key090");
+  std::vector<std::string> listed;
+  for (const auto& entry :
+       kvstore::ListFuture(KvStore(store), options).value()) {
+    listed.push_back(entry.key);
+  }
+  EXPECT_THAT(listed, ::testing::ElementsAreArray(keys.begin() + 10,
+                                                  keys.begin() + 90));
+}
+
 }  // namespace
@@ -28,6 +28,8 @@
 #include <vector>
 
 #include "absl/base/optimization.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
 #include "absl/synchronization/mutex.h"
@@ -104,14 +106,23 @@ using ::tensorstore::kvstore::SupportedFeatures;
 /// advantage of `KvsBackedCache` to define `MinishardIndexCache`.
 class MinishardIndexKeyValueStore : public kvstore::Driver {
  public:
+  /// Shard index retained in memory when `pin_shard_indexes` is `true`.
+  struct PinnedShardIndex {
+    /// Encoded shard index, or `std::nullopt` if the shard does not exist.
+    std::optional<absl::Cord> value;
+    TimestampedStorageGeneration stamp;
+  };
+
   explicit MinishardIndexKeyValueStore(kvstore::DriverPtr base,
                                        Executor executor,
                                        std::string key_prefix,
-                                       const ShardingSpec& sharding_spec)
+                                       const ShardingSpec& sharding_spec,
+                                       bool pin_shard_indexes)
       : base_(std::move(base)),
         executor_(std::move(executor)),
         key_prefix_(key_prefix),
-        sharding_spec_(sharding_spec) {}
+        sharding_spec_(sharding_spec),
+        pin_shard_indexes_(pin_shard_indexes) {}
 
   Future<ReadResult> Read(Key key, ReadOptions options) override;
 
@@ -137,11 +148,38 @@ class MinishardIndexKeyValueStore : public kvstore::Driver {
   const ShardingSpec& sharding_spec() { return sharding_spec_; }
   const std::string& key_prefix() const { return key_prefix_; }
   const Executor& executor() const { return executor_; }
+  bool pin_shard_indexes() const { return pin_shard_indexes_; }
+
+  /// Returns the pinned index of `shard`, if it is at least as recent as
+  /// `staleness_bound`.
+  std::optional<PinnedShardIndex> GetPinnedShardIndex(
+      uint64_t shard, absl::Time staleness_bound) {
+    absl::MutexLock lock(&mutex_);
+    auto it = pinned_shard_indexes_.find(shard);
+    if (it == pinned_shard_indexes_.end() ||
+        it->second.stamp.time < staleness_bound) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  /// Pins `index` as the index of `shard`, unless a more recent index is
+  /// already pinned.
+  void PinShardIndex(uint64_t shard, PinnedShardIndex index) {
+    absl::MutexLock lock(&mutex_);
+    auto& pinned = pinned_shard_indexes_[shard];
+    if (pinned.stamp.time <= index.stamp.time) pinned = std::move(index);
+  }
 
   kvstore::DriverPtr base_;
   Executor executor_;
   std::string key_prefix_;
   ShardingSpec sharding_spec_;
+  bool pin_shard_indexes_;
+
+  absl::Mutex mutex_;
+  absl::flat_hash_map<uint64_t, PinnedShardIndex> pinned_shard_indexes_
+      ABSL_GUARDED_BY(mutex_);
 };
 
 namespace {
@@ -170,7 +208,18 @@ using MinishardIndex = uint64_t;
 //       the case of concurrent modification of the shard).  Done.
 //
 //    c.  Otherwise, return the encoded minishard index.
+//
+// The shard index entries of the minishards requested in a batch are read by
+// a single request for each run of entries separated by at most
+// `kMaxShardIndexReadGap` bytes.  If shard indexes are pinned, the entire shard
+// index is read instead, and retained for later requests whose staleness bound
+// it satisfies.
 class MinishardIndexReadOperationState;
+
+// Maximum number of unrequested bytes between the shard index entries read by
+// a single request.
+constexpr uint64_t kMaxShardIndexReadGap = 4096;
+
 using MinishardIndexReadOperationStateBase =
     internal_kvstore_batch::BatchReadEntry<
         MinishardIndexKeyValueStore,
@@ -209,8 +258,30 @@ class MinishardIndexReadOperationState
 
     auto minishard_fetch_batch = Batch::New();
 
-    for (auto& request : request_batch.requests) {
-      ProcessMinishard(batch, request, minishard_fetch_batch);
+    span<Request> requests = request_batch.requests;
+    std::sort(requests.begin(), requests.end(),
+              [](const Request& a, const Request& b) {
+                return std::get<MinishardIndex>(a) <
+                       std::get<MinishardIndex>(b);
+              });
+
+    if (driver().pin_shard_indexes()) {
+      ReadPinnedShardIndex(batch, std::move(minishard_fetch_batch));
+      return;
+    }
+
+    for (size_t start_i = 0; start_i < requests.size();) {
+      size_t end_i = start_i + 1;
+      while (end_i < requests.size() &&
+             (std::get<MinishardIndex>(requests[end_i]) -
+              std::get<MinishardIndex>(requests[end_i - 1])) *
+                     16 <=
+                 kMaxShardIndexReadGap) {
+        ++end_i;
+      }
+      ReadShardIndexEntries(batch, requests.subspan(start_i, end_i - start_i),
+                            minishard_fetch_batch);
+      start_i = end_i;
     }
   }
 
@@ -220,34 +291,114 @@ class MinishardIndexReadOperationState
                        std::get<ShardIndex>(batch_entry_key));
   }
 
-  void ProcessMinishard(Batch::View batch, Request& request,
-                        Batch minishard_fetch_batch) {
+  // Reads the shard index entries of `requests`, which are sorted by
+  // minishard, using a single request.
+  void ReadShardIndexEntries(Batch::View batch, span<Request> requests,
+                             Batch minishard_fetch_batch) {
     kvstore::ReadOptions kvstore_read_options;
     kvstore_read_options.generation_conditions =
         std::get<kvstore::ReadGenerationConditions>(this->batch_entry_key);
     kvstore_read_options.staleness_bound = this->request_batch.staleness_bound;
-    auto key = std::get<MinishardIndex>(request);
+    const int64_t inclusive_min =
+        static_cast<int64_t>(std::get<MinishardIndex>(requests.front()) * 16);
     kvstore_read_options.byte_range = OptionalByteRangeRequest{
-        static_cast<int64_t>(key * 16), static_cast<int64_t>((key + 1) * 16)};
+        inclusive_min,
+        static_cast<int64_t>((std::get<MinishardIndex>(requests.back()) + 1) *
+                             16)};
     kvstore_read_options.batch = batch;
     auto shard_index_read_future = this->driver().base()->Read(
         this->ShardKey(), std::move(kvstore_read_options));
     shard_index_read_future.Force();
+    shard_index_read_future.ExecuteWhenReady(
+        [self = internal::IntrusivePtr<MinishardIndexReadOperationState>(this),
+         minishard_fetch_batch = std::move(minishard_fetch_batch), requests,
+         inclusive_min](ReadyFuture<kvstore::ReadResult> future) mutable {
+          const auto& executor = self->driver().executor();
+          executor([self = std::move(self), requests, inclusive_min,
+                    minishard_fetch_batch = std::move(minishard_fetch_batch),
+                    future = std::move(future)] {
+            const auto& result = future.result();
+            for (auto& request : requests) {
+              Result<kvstore::ReadResult> entry_result = result;
+              if (entry_result.ok() && entry_result->has_value()) {
+                entry_result->value = entry_result->value.Subcord(
+                    std::get<MinishardIndex>(request) * 16 - inclusive_min,
+                    16);
+              }
+              OnShardIndexReady(self, request, minishard_fetch_batch,
+                                std::move(entry_result));
+            }
+          });
+        });
+  }
+
+  // Obtains the entire shard index, from the pinned copy if it satisfies the
+  // staleness bound, or otherwise by reading and pinning it.
+  void ReadPinnedShardIndex(Batch::View batch, Batch minishard_fetch_batch) {
+    auto& driver = this->driver();
+    const ShardIndex shard = std::get<ShardIndex>(batch_entry_key);
+    if (auto pinned = driver.GetPinnedShardIndex(
+            shard, this->request_batch.staleness_bound)) {
+      OnPinnedShardIndexReady(*pinned, minishard_fetch_batch);
+      return;
+    }
+    // The shard index is read unconditionally, since it is retained for
+    // requests with other generation conditions.
+    kvstore::ReadOptions kvstore_read_options;
+    kvstore_read_options.staleness_bound = this->request_batch.staleness_bound;
+    kvstore_read_options.byte_range = OptionalByteRangeRequest{
+        0, ShardIndexSize(driver.sharding_spec())};
+    kvstore_read_options.batch = batch;
+    auto shard_index_read_future =
+        driver.base()->Read(this->ShardKey(), std::move(kvstore_read_options));
+    shard_index_read_future.Force();
     shard_index_read_future.ExecuteWhenReady(
         [self = internal::IntrusivePtr<MinishardIndexReadOperationState>(this),
          minishard_fetch_batch = std::move(minishard_fetch_batch),
-         &request](ReadyFuture<kvstore::ReadResult> future) mutable {
+         shard](ReadyFuture<kvstore::ReadResult> future) mutable {
           const auto& executor = self->driver().executor();
-          executor([self = std::move(self), &request,
+          executor([self = std::move(self), shard,
                     minishard_fetch_batch = std::move(minishard_fetch_batch),
                     future = std::move(future)] {
-            OnShardIndexReady(std::move(self), request,
-                              std::move(minishard_fetch_batch),
-                              std::move(future.result()));
+            const auto& result = future.result();
+            if (!result.ok()) {
+              for (auto& request : self->request_batch.requests) {
+                OnShardIndexReady(self, request, minishard_fetch_batch,
+                                  result.status());
+              }
+              return;
+            }
+            MinishardIndexKeyValueStore::PinnedShardIndex pinned;
+            if (result->has_value()) pinned.value = result->value;
+            pinned.stamp = result->stamp;
+            self->driver().PinShardIndex(shard, pinned);
+            self->OnPinnedShardIndexReady(pinned, minishard_fetch_batch);
           });
         });
   }
 
+  void OnPinnedShardIndexReady(
+      const MinishardIndexKeyValueStore::PinnedShardIndex& pinned,
+      const Batch& minishard_fetch_batch) {
+    const auto& generation_conditions =
+        std::get<kvstore::ReadGenerationConditions>(this->batch_entry_key);
+    internal::IntrusivePtr<MinishardIndexReadOperationState> self(this);
+    for (auto& request : this->request_batch.requests) {
+      kvstore::ReadResult read_result;
+      if (!generation_conditions.Matches(pinned.stamp.generation)) {
+        read_result = kvstore::ReadResult::Unspecified(pinned.stamp);
+      } else if (!pinned.value) {
+        read_result = kvstore::ReadResult::Missing(pinned.stamp);
+      } else {
+        read_result = kvstore::ReadResult::Value(
+            pinned.value->Subcord(std::get<MinishardIndex>(request) * 16, 16),
+            pinned.stamp);
+      }
+      OnShardIndexReady(self, request, minishard_fetch_batch,
+                        std::move(read_result));
+    }
+  }
+
   static void OnShardIndexReady(
       internal::IntrusivePtr<MinishardIndexReadOperationState> self,
       Request& request, Batch minishard_fetch_batch,
@@ -423,10 +574,11 @@ class MinishardIndexCache
 
   explicit MinishardIndexCache(kvstore::DriverPtr base_kvstore,
                                Executor executor, std::string key_prefix,
-                               const ShardingSpec& sharding_spec)
+                               const ShardingSpec& sharding_spec,
+                               bool pin_shard_indexes)
       : Base(kvstore::DriverPtr(new MinishardIndexKeyValueStore(
             std::move(base_kvstore), executor, std::move(key_prefix),
-            sharding_spec))) {}
+            sharding_spec, pin_shard_indexes))) {}
 
   MinishardIndexKeyValueStore* kvstore_driver() {
     return static_cast<MinishardIndexKeyValueStore*>(
@@ -949,13 +1101,15 @@ struct ShardedKeyValueStoreSpecData {
       data_copy_concurrency;
   kvstore::Spec base;
   ShardingSpec metadata;
+  bool pin_shard_indexes = false;
   TENSORSTORE_DECLARE_JSON_DEFAULT_BINDER(ShardedKeyValueStoreSpecData,
                                           internal_json_binding::NoOptions,
                                           IncludeDefaults,
                                           ::nlohmann::json::object_t)
 
   constexpr static auto ApplyMembers = [](auto&& x, auto f) {
-    return f(x.cache_pool, x.data_copy_concurrency, x.base, x.metadata);
+    return f(x.cache_pool, x.data_copy_concurrency, x.base, x.metadata,
+             x.pin_shard_indexes);
   };
 };
 
@@ -973,6 +1127,11 @@ TENSORSTORE_DEFINE_JSON_DEFAULT_BINDER(
         jb::Member("metadata",
                    jb::Projection<&ShardedKeyValueStoreSpecData::metadata>(
                        jb::DefaultInitializedValue())),
+        jb::Member(
+            "pin_shard_indexes",
+            jb::Projection<&ShardedKeyValueStoreSpecData::pin_shard_indexes>(
+                jb::DefaultValue<jb::kNeverIncludeDefaults>(
+                    [](auto* v) { *v = false; }))),
         jb::Member(internal::CachePoolResource::id,
                    jb::Projection<&ShardedKeyValueStoreSpecData::cache_pool>()),
         jb::Member(
@@ -1000,7 +1159,8 @@ class ShardedKeyValueStore
       kvstore::DriverPtr base_kvstore, Executor executor,
       std::string key_prefix, const ShardingSpec& sharding_spec,
       internal::CachePool::WeakPtr cache_pool,
-      GetMaxChunksPerShardFunction get_max_chunks_per_shard = {})
+      GetMaxChunksPerShardFunction get_max_chunks_per_shard = {},
+      bool pin_shard_indexes = false)
       : write_cache_(internal::GetCache<ShardedKeyValueStoreWriteCache>(
             cache_pool.get(), "",
             [&] {
@@ -1010,7 +1170,8 @@ class ShardedKeyValueStore
                       [&] {
                         return std::make_unique<MinishardIndexCache>(
                             std::move(base_kvstore), std::move(executor),
-                            std::move(key_prefix), sharding_spec);
+                            std::move(key_prefix), sharding_spec,
+                            pin_shard_indexes);
                       }),
                   std::move(get_max_chunks_per_shard));
             })),
@@ -1483,10 +1644,22 @@ class ReadOperationState
           std::remove_if(
               chunk_requests.begin(), chunk_requests.end(),
               [&](Request& request) {
-                return !internal_kvstore_batch::ValidateRequestGeneration(
-                    request, stamp);
+                if (!internal_kvstore_batch::ValidateRequestGeneration(
+                        request, stamp)) {
+                  return true;
+                }
+                // `Stat` requests are answered from the minishard index
+                // alone, without reading the chunk data.
+                auto& byte_range_request =
+                    std::get<internal_kvstore_batch::ByteRangeReadRequest>(
+                        request);
+                if (!byte_range_request.byte_range.IsStat()) return false;
+                byte_range_request.promise.SetResult(
+                    kvstore::ReadResult::Value(absl::Cord(), stamp));
+                return true;
               }) -
           chunk_requests.begin());
+      if (chunk_requests.empty()) return;
 
       if (sharding_spec.data_encoding == ShardingSpec::DataEncoding::raw) {
         // Can apply requested byte range directly.
@@ -1697,6 +1870,8 @@ absl::Status ShardedKeyValueStore::GetBoundSpecData(
   spec.data_copy_concurrency = data_copy_concurrency_resource_;
   spec.cache_pool = cache_pool_resource_;
   spec.metadata = sharding_spec();
+  spec.pin_shard_indexes =
+      minishard_index_cache()->kvstore_driver()->pin_shard_indexes();
   return absl::Status();
 }
 
@@ -1709,7 +1884,8 @@ Future<kvstore::DriverPtr> ShardedKeyValueStoreSpec::DoOpen() const {
             std::move(base_kvstore.driver),
             spec->data_.data_copy_concurrency->executor,
             std::move(base_kvstore.path), spec->data_.metadata,
-            *spec->data_.cache_pool);
+            *spec->data_.cache_pool, GetMaxChunksPerShardFunction{},
+            spec->data_.pin_shard_indexes);
         driver->data_copy_concurrency_resource_ =
             spec->data_.data_copy_concurrency;
         driver->cache_pool_resource_ = spec->data_.cache_pool;
@@ -1721,11 +1897,12 @@ Future<kvstore::DriverPtr> ShardedKeyValueStoreSpec::DoOpen() const {
 kvstore::DriverPtr GetShardedKeyValueStore(
     kvstore::DriverPtr base_kvstore, Executor executor, std::string key_prefix,
     const ShardingSpec& sharding_spec, internal::CachePool::WeakPtr cache_pool,
-    GetMaxChunksPerShardFunction get_max_chunks_per_shard) {
+    GetMaxChunksPerShardFunction get_max_chunks_per_shard,
+    bool pin_shard_indexes) {
   return kvstore::DriverPtr(new ShardedKeyValueStore(
       std::move(base_kvstore), std::move(executor), std::move(key_prefix),
-      sharding_spec, std::move(cache_pool),
-      std::move(get_max_chunks_per_shard)));
+      sharding_spec, std::move(cache_pool), std::move(get_max_chunks_per_shard),
+      pin_shard_indexes));
 }
 
 std::string ChunkIdToKey(ChunkId chunk_id) {
@@ -94,10 +94,15 @@ using GetMaxChunksPerShardFunction = std::function<uint64_t(uint64_t)>;
 ///     by the `neuroglancer_precomputed` volume driver to allow shard-aligned
 ///     writes to be performed unconditionally, in the case where a shard
 ///     corresponds to a rectangular region.
+/// \param pin_shard_indexes If `true`, the entire shard index of each shard
+///     accessed is read and retained in memory, and reused by subsequent reads
+///     for which it satisfies the staleness bound.  Otherwise, only the shard
+///     index entries of the requested minishards are read.
 kvstore::DriverPtr GetShardedKeyValueStore(
     kvstore::DriverPtr base_kvstore, Executor executor, std::string key_prefix,
     const ShardingSpec& sharding_spec, internal::CachePool::WeakPtr cache_pool,
-    GetMaxChunksPerShardFunction get_max_chunks_per_shard = {});
+    GetMaxChunksPerShardFunction get_max_chunks_per_shard = {},
+    bool pin_shard_indexes = false);
 
 /// Returns a key suitable for use with a `KeyValueStore` returned from
 /// `GetShardedKeyValueStore`.
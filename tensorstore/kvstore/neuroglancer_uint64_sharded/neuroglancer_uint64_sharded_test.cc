@@ -1710,6 +1710,83 @@ TEST_F(UnderlyingKeyValueStoreTest, BatchRead) {
   }
 }
 
+TEST_F(UnderlyingKeyValueStoreTest, BatchReadCoalescesShardIndexEntries) {
+  cache_pool = CachePool::Make({});
+  auto memory_store = tensorstore::GetMemoryKeyValueStore();
+  mock_store->forward_to = memory_store;
+  mock_store->log_requests = true;
+  mock_store->handle_batch_requests = true;
+
+  auto store = GetStore();
+  auto key0 = GetChunkKey(0x50);  // shard=0, minishard=0
+  auto key3 = GetChunkKey(0x51);  // shard=0, minishard=1
+  TENSORSTORE_ASSERT_OK(store->Write(key0, absl::Cord("abc")).result());
+  TENSORSTORE_ASSERT_OK(store->Write(key3, absl::Cord("key3-")).result());
+  mock_store->request_log.pop_all();
+
+  std::vector<Future<kvstore::ReadResult>> futures;
+  {
+    kvstore::ReadOptions options;
+    options.batch = Batch::New();
+    futures = {
+        store->Read(key0, options),
+        store->Read(key3, options),
+    };
+  }
+  EXPECT_THAT(futures[0].result(), MatchesKvsReadResult(absl::Cord("abc")));
+  EXPECT_THAT(futures[1].result(), MatchesKvsReadResult(absl::Cord("key3-")));
+
+  // The shard index entries of both minishards are read by a single request.
+  auto log = mock_store->request_log.pop_all();
+  ASSERT_THAT(log, ::testing::Not(::testing::IsEmpty()));
+  EXPECT_THAT(log[0], JsonSubValuesMatch(
+                          {{"/type", "batch_read"},
+                           {"/requests", ::nlohmann::json::array_t{
+                                             ::nlohmann::json::object_t{
+                                                 {"byte_range_exclusive_max",
+                                                  32}}}}}));
+}
+
+TEST_F(UnderlyingKeyValueStoreTest, PinShardIndexes) {
+  cache_pool = CachePool::Make({});
+  auto memory_store = tensorstore::GetMemoryKeyValueStore();
+  mock_store->forward_to = memory_store;
+
+  auto store = GetShardedKeyValueStore(
+      mock_store, tensorstore::InlineExecutor{}, "prefix", sharding_spec,
+      CachePool::WeakPtr(cache_pool), /*get_max_chunks_per_shard=*/{},
+      /*pin_shard_indexes=*/true);
+  auto key0 = GetChunkKey(0x50);  // shard=0, minishard=0
+  TENSORSTORE_ASSERT_OK(store->Write(key0, absl::Cord("abc")).result());
+  mock_store->log_requests = true;
+
+  // The entire shard index is read.
+  EXPECT_THAT(store->Read(key0).result(),
+              MatchesKvsReadResult(absl::Cord("abc")));
+  {
+    auto log = mock_store->request_log.pop_all();
+    ASSERT_THAT(log, ::testing::SizeIs(3));
+    EXPECT_THAT(log[0],
+                JsonSubValuesMatch(
+                    {{"/type", "read"}, {"/byte_range_exclusive_max", 32}}));
+  }
+
+  // The pinned shard index satisfies the staleness bound, and only the
+  // minishard index and the data are read.
+  {
+    kvstore::ReadOptions options;
+    options.staleness_bound = absl::InfinitePast();
+    EXPECT_THAT(store->Read(key0, options).result(),
+                MatchesKvsReadResult(absl::Cord("abc")));
+    EXPECT_THAT(mock_store->request_log.pop_all(), ::testing::SizeIs(2));
+  }
+
+  // The pinned shard index does not satisfy the staleness bound.
+  EXPECT_THAT(store->Read(key0).result(),
+              MatchesKvsReadResult(absl::Cord("abc")));
+  EXPECT_THAT(mock_store->request_log.pop_all(), ::testing::SizeIs(3));
+}
+
 // Tests of ReadModifyWrite operations, using `KvsBackedTestCache` ->
 // `Uint64ShardedKeyValueStore` -> `MockKeyValueStore`.
 class ReadModifyWriteTest : public ::testing::Test {
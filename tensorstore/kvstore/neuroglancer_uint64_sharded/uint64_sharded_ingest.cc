@@ -0,0 +1,297 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/neuroglancer_uint64_sharded/uint64_sharded_ingest.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/container/btree_map.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_format.h"
+#include "tensorstore/internal/cord_util.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/neuroglancer_uint64_sharded/uint64_sharded.h"
+#include "tensorstore/kvstore/neuroglancer_uint64_sharded/uint64_sharded_encoder.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/util/endian.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status.h"
+
+namespace tensorstore {
+namespace neuroglancer_uint64_sharded {
+
+struct ShardedIngestWriter::State
+    : public internal::AtomicReferenceCount<ShardedIngestWriter::State> {
+  /// Chunks added for a single shard.
+  struct PendingShard {
+    /// Chunks buffered in memory, in the order they were added.
+    EncodedChunks chunks;
+
+    /// Number of runs previously spilled, which precede `chunks`.
+    size_t num_spill_runs = 0;
+  };
+
+  kvstore::DriverPtr base_kvstore;
+  Executor executor;
+  std::string key_prefix;
+  ShardingSpec sharding_spec;
+  Options options;
+  absl::btree_map<uint64_t, PendingShard> shards;
+  size_t buffered_bytes = 0;
+  std::vector<Future<const void>> spills;
+};
+
+namespace {
+
+using State = ShardedIngestWriter::State;
+
+/// Each spilled chunk is encoded as the chunk id and the size of the encoded
+/// data, each as a `uint64le`, followed by the encoded data.
+constexpr size_t kSpillRecordHeaderSize = 16;
+
+std::string GetSpillPrefix(uint64_t shard) {
+  return absl::StrFormat("%016x/", shard);
+}
+
+std::string GetSpillKey(uint64_t shard, size_t run) {
+  return absl::StrFormat("%016x/%d", shard, run);
+}
+
+void AppendSpillRecord(absl::Cord& out, const EncodedChunk& chunk) {
+  char header[kSpillRecordHeaderSize];
+  little_endian::Store64(header, chunk.minishard_and_chunk_id.chunk_id.value);
+  little_endian::Store64(header + 8, chunk.encoded_data.size());
+  out.Append(std::string_view(header, kSpillRecordHeaderSize));
+  out.Append(chunk.encoded_data);
+}
+
+absl::Status DecodeSpillRun(const ShardingSpec& sharding_spec,
+                            const absl::Cord& run, EncodedChunks& chunks) {
+  absl::Cord::CharIterator it = run.char_begin();
+  size_t remaining = run.size();
+  while (remaining > 0) {
+    if (remaining < kSpillRecordHeaderSize) {
+      return absl::DataLossError("Truncated spill record header");
+    }
+    char header[kSpillRecordHeaderSize];
+    internal::CopyCordToSpan(it, header);
+    remaining -= kSpillRecordHeaderSize;
+    const ChunkId chunk_id{little_endian::Load64(header)};
+    const uint64_t size = little_endian::Load64(header + 8);
+    if (size > remaining) {
+      return absl::DataLossError("Truncated spill record");
+    }
+    remaining -= size;
+    const auto shard_info = GetSplitShardInfo(
+        sharding_spec, GetChunkShardInfo(sharding_spec, chunk_id));
+    chunks.push_back(EncodedChunk{{shard_info.minishard, chunk_id},
+                                  absl::Cord::AdvanceAndRead(&it, size)});
+  }
+  return absl::OkStatus();
+}
+
+/// Writes all buffered chunks to the spill kvstore, one run per shard.
+Future<const void> Spill(State& state) {
+  std::vector<Future<TimestampedStorageGeneration>> writes;
+  for (auto& [shard, pending] : state.shards) {
+    if (pending.chunks.empty()) continue;
+    absl::Cord run;
+    for (const auto& chunk : pending.chunks) {
+      AppendSpillRecord(run, chunk);
+    }
+    EncodedChunks().swap(pending.chunks);
+    writes.push_back(kvstore::Write(state.options.spill_kvstore,
+                                    GetSpillKey(shard, pending.num_spill_runs++),
+                                    std::move(run)));
+  }
+  state.buffered_bytes = 0;
+  Future<const void> future = WaitAllFuture(tensorstore::span(writes));
+  state.spills.push_back(future);
+  return future;
+}
+
+/// Returns the chunks of a shard ordered by minishard and chunk id, retaining
+/// only the most recently added chunk for each chunk id.
+EncodedChunks SortChunks(EncodedChunks chunks) {
+  std::stable_sort(chunks.begin(), chunks.end(),
+                   [](const EncodedChunk& a, const EncodedChunk& b) {
+                     return a.minishard_and_chunk_id < b.minishard_and_chunk_id;
+                   });
+  EncodedChunks result;
+  result.reserve(chunks.size());
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    if (i + 1 < chunks.size() && chunks[i].minishard_and_chunk_id ==
+                                     chunks[i + 1].minishard_and_chunk_id) {
+      continue;
+    }
+    result.push_back(std::move(chunks[i]));
+  }
+  return result;
+}
+
+void WriteNextShard(internal::IntrusivePtr<State> state,
+                    Promise<void> promise);
+
+/// Called once the spilled runs of `shard` have been read.
+void WriteShard(internal::IntrusivePtr<State> state, Promise<void> promise,
+                uint64_t shard, State::PendingShard pending,
+                span<const Future<kvstore::ReadResult>> runs) {
+  const auto& sharding_spec = state->sharding_spec;
+  EncodedChunks chunks;
+  for (const auto& run : runs) {
+    const auto& read_result = run.value();
+    if (!read_result.has_value()) {
+      promise.SetResult(absl::DataLossError(
+          absl::StrFormat("Spilled chunks for shard %d are missing", shard)));
+      return;
+    }
+    TENSORSTORE_RETURN_IF_ERROR(
+        DecodeSpillRun(sharding_spec, read_result.value, chunks),
+        static_cast<void>(promise.SetResult(_)));
+  }
+  chunks.insert(chunks.end(), std::make_move_iterator(pending.chunks.begin()),
+                std::make_move_iterator(pending.chunks.end()));
+  auto encoded = EncodeShard(sharding_spec, SortChunks(std::move(chunks)));
+  Future<TimestampedStorageGeneration> write_future =
+      encoded ? kvstore::Write(KvStore(state->base_kvstore),
+                               GetShardKey(sharding_spec, state->key_prefix,
+                                           shard),
+                               *std::move(encoded))
+              : MakeReadyFuture<TimestampedStorageGeneration>();
+  LinkValue(
+      [state = std::move(state), shard,
+       num_spill_runs = pending.num_spill_runs](
+          Promise<void> promise,
+          ReadyFuture<TimestampedStorageGeneration> future) mutable {
+        if (num_spill_runs == 0) {
+          WriteNextShard(std::move(state), std::move(promise));
+          return;
+        }
+        auto delete_future =
+            kvstore::DeleteRange(state->options.spill_kvstore,
+                                 KeyRange::Prefix(GetSpillPrefix(shard)));
+        LinkValue(
+            [state = std::move(state)](Promise<void> promise,
+                                       ReadyFuture<const void> future) mutable {
+              WriteNextShard(std::move(state), std::move(promise));
+            },
+            std::move(promise), std::move(delete_future));
+      },
+      std::move(promise), std::move(write_future));
+}
+
+/// Writes the lowest-numbered remaining shard, and then continues with the
+/// next shard.  Shards are written one at a time such that only the chunks of
+/// a single shard need to be held in memory.
+void WriteNextShard(internal::IntrusivePtr<State> state,
+                    Promise<void> promise) {
+  if (state->shards.empty()) {
+    promise.SetResult(absl::OkStatus());
+    return;
+  }
+  auto it = state->shards.begin();
+  const uint64_t shard = it->first;
+  State::PendingShard pending = std::move(it->second);
+  state->shards.erase(it);
+  std::vector<Future<kvstore::ReadResult>> runs;
+  runs.reserve(pending.num_spill_runs);
+  for (size_t run = 0; run < pending.num_spill_runs; ++run) {
+    runs.push_back(
+        kvstore::Read(state->options.spill_kvstore, GetSpillKey(shard, run)));
+  }
+  auto runs_future = WaitAllFuture(tensorstore::span(runs));
+  auto executor = state->executor;
+  LinkValue(WithExecutor(std::move(executor),
+                         [state = std::move(state), shard,
+                          pending = std::move(pending),
+                          runs = std::move(runs)](
+                             Promise<void> promise,
+                             ReadyFuture<void> future) mutable {
+                           WriteShard(std::move(state), std::move(promise),
+                                      shard, std::move(pending), runs);
+                         }),
+            std::move(promise), std::move(runs_future));
+}
+
+}  // namespace
+
+ShardedIngestWriter::ShardedIngestWriter(kvstore::DriverPtr base_kvstore,
+                                         Executor executor,
+                                         std::string key_prefix,
+                                         const ShardingSpec& sharding_spec,
+                                         Options options)
+    : state_(internal::MakeIntrusivePtr<State>()) {
+  state_->base_kvstore = std::move(base_kvstore);
+  state_->executor = std::move(executor);
+  state_->key_prefix = std::move(key_prefix);
+  state_->sharding_spec = sharding_spec;
+  state_->options = std::move(options);
+}
+
+ShardedIngestWriter::ShardedIngestWriter(ShardedIngestWriter&&) = default;
+ShardedIngestWriter& ShardedIngestWriter::operator=(ShardedIngestWriter&&) =
+    default;
+ShardedIngestWriter::~ShardedIngestWriter() = default;
+
+Future<const void> ShardedIngestWriter::Add(ChunkId chunk_id,
+                                            const absl::Cord& data) {
+  auto& state = *state_;
+  const auto& sharding_spec = state.sharding_spec;
+  const auto shard_info = GetSplitShardInfo(
+      sharding_spec, GetChunkShardInfo(sharding_spec, chunk_id));
+  absl::Cord encoded_data = EncodeData(data, sharding_spec.data_encoding);
+  state.buffered_bytes += encoded_data.size();
+  state.shards[shard_info.shard].chunks.push_back(
+      EncodedChunk{{shard_info.minishard, chunk_id}, std::move(encoded_data)});
+  if (!state.options.spill_kvstore.valid() ||
+      state.buffered_bytes <= state.options.max_buffered_bytes) {
+    return MakeReadyFuture();
+  }
+  return Spill(state);
+}
+
+Future<const void> ShardedIngestWriter::Finalize() {
+  auto spills_future = WaitAllFuture(tensorstore::span(state_->spills));
+  state_->spills.clear();
+  auto [promise, future] = PromiseFuturePair<void>::Make();
+  LinkValue(
+      [state = state_](Promise<void> promise,
+                       ReadyFuture<void> future) mutable {
+        WriteNextShard(std::move(state), std::move(promise));
+      },
+      std::move(promise), std::move(spills_future));
+  return std::move(future);
+}
+
+size_t ShardedIngestWriter::buffered_bytes() const {
+  return state_->buffered_bytes;
+}
+
+}  // namespace neuroglancer_uint64_sharded
+}  // namespace tensorstore
@@ -0,0 +1,123 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_NEUROGLANCER_UINT64_SHARDED_UINT64_SHARDED_INGEST_H_
+#define TENSORSTORE_KVSTORE_NEUROGLANCER_UINT64_SHARDED_UINT64_SHARDED_INGEST_H_
+
+/// \file
+/// Bulk ingestion of a new neuroglancer_uint64_sharded_v1 database.
+///
+/// Writing through the `KeyValueStore` returned by `GetShardedKeyValueStore`
+/// requires a read-modify-write of the entire shard for each group of writes
+/// committed together, which means that a shard is rewritten repeatedly if its
+/// chunks are not all written at once.  `ShardedIngestWriter` instead collects
+/// all chunks before writing anything, and then writes each shard exactly
+/// once.
+
+#include <stddef.h>
+
+#include <string>
+
+#include "absl/strings/cord.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/neuroglancer_uint64_sharded/uint64_sharded.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace neuroglancer_uint64_sharded {
+
+/// Writes a new sharded database in bulk.
+///
+/// Chunks are buffered in memory as they are added, grouped by shard.  When
+/// the buffered size exceeds `Options::max_buffered_bytes`, the buffered chunks
+/// are spilled to `Options::spill_kvstore`, which would normally be on local
+/// disk.  `Finalize` then writes the shards in order of shard number, one at a
+/// time, such that only the chunks of a single shard are held in memory.
+///
+/// Each shard is written unconditionally, replacing any existing shard, and
+/// therefore this is suitable only for populating a new database (or a set of
+/// shards that are entirely rewritten).
+///
+/// This class is not thread safe.
+///
+/// Example usage:
+///
+///     ShardedIngestWriter writer(base_kvstore, executor, key_prefix,
+///                                sharding_spec, options);
+///     for (const auto& [chunk_id, data] : chunks) {
+///       // Waiting on the returned future bounds the memory used by spills
+///       // that are in progress.
+///       TENSORSTORE_RETURN_IF_ERROR(writer.Add(chunk_id, data).result());
+///     }
+///     TENSORSTORE_RETURN_IF_ERROR(writer.Finalize().result());
+class ShardedIngestWriter {
+ public:
+  struct Options {
+    /// Maximum number of bytes of (encoded) chunk data to buffer in memory
+    /// before spilling to `spill_kvstore`.
+    size_t max_buffered_bytes = 256 * 1024 * 1024;
+
+    /// Location where buffered chunks are spilled.  If not valid, all chunks
+    /// are buffered in memory.
+    KvStore spill_kvstore;
+  };
+
+  /// Constructs a writer.
+  ///
+  /// \param base_kvstore The underlying `KeyValueStore` to which the shard
+  ///     files are written.
+  /// \param executor Executor used for encoding shards.
+  /// \param key_prefix Prefix of the sharded database within `base_kvstore`.
+  /// \param sharding_spec Sharding specification.
+  /// \param options Buffering options.
+  ShardedIngestWriter(kvstore::DriverPtr base_kvstore, Executor executor,
+                      std::string key_prefix, const ShardingSpec& sharding_spec,
+                      Options options);
+
+  ShardedIngestWriter(ShardedIngestWriter&&);
+  ShardedIngestWriter& operator=(ShardedIngestWriter&&);
+  ~ShardedIngestWriter();
+
+  /// Adds a chunk.
+  ///
+  /// If a chunk with the same `chunk_id` was previously added, it is replaced.
+  ///
+  /// \param chunk_id The chunk identifier.
+  /// \param data The unencoded chunk data, which is compressed according to
+  ///     the `data_encoding` of the sharding specification.
+  /// \returns A future that becomes ready once any spill triggered by this
+  ///     call completes.
+  /// \pre `Finalize()` was not called previously.
+  Future<const void> Add(ChunkId chunk_id, const absl::Cord& data);
+
+  /// Writes all shards.
+  ///
+  /// \pre `Finalize()` was not called previously.
+  Future<const void> Finalize();
+
+  /// Returns the number of bytes of chunk data currently buffered in memory.
+  size_t buffered_bytes() const;
+
+  struct State;
+
+ private:
+  internal::IntrusivePtr<State> state_;
+};
+
+}  // namespace neuroglancer_uint64_sharded
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_NEUROGLANCER_UINT64_SHARDED_UINT64_SHARDED_INGEST_H_
@@ -0,0 +1,133 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/neuroglancer_uint64_sharded/uint64_sharded_ingest.h"
+
+#include <stdint.h>
+
+#include <map>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/cord.h"
+#include "absl/strings/str_cat.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/memory/memory_key_value_store.h"
+#include "tensorstore/kvstore/neuroglancer_uint64_sharded/uint64_sharded.h"
+#include "tensorstore/kvstore/neuroglancer_uint64_sharded/uint64_sharded_decoder.h"
+#include "tensorstore/kvstore/test_util.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::InlineExecutor;
+using ::tensorstore::KvStore;
+using ::tensorstore::internal::GetMap;
+using ::tensorstore::neuroglancer_uint64_sharded::ChunkId;
+using ::tensorstore::neuroglancer_uint64_sharded::DecodeData;
+using ::tensorstore::neuroglancer_uint64_sharded::ShardedIngestWriter;
+using ::tensorstore::neuroglancer_uint64_sharded::ShardingSpec;
+using ::tensorstore::neuroglancer_uint64_sharded::SplitShard;
+
+ShardingSpec GetShardingSpec(ShardingSpec::DataEncoding data_encoding) {
+  return ShardingSpec(ShardingSpec::HashFunction::murmurhash3_x86_128,
+                      /*preshift_bits=*/1, /*minishard_bits=*/2,
+                      /*shard_bits=*/2, data_encoding,
+                      /*minishard_index_encoding=*/data_encoding);
+}
+
+/// Returns the decoded contents of all shards in `store`.
+std::map<uint64_t, std::string> ReadAllChunks(
+    const KvStore& store, const ShardingSpec& sharding_spec) {
+  std::map<uint64_t, std::string> chunks;
+  auto shards = GetMap(store).value();
+  EXPECT_LE(shards.size(), sharding_spec.num_shards());
+  for (const auto& [key, shard_data] : shards) {
+    SCOPED_TRACE(key);
+    TENSORSTORE_ASSIGN_OR_RETURN(auto split,
+                                 SplitShard(sharding_spec, shard_data),
+                                 (ADD_FAILURE() << _, chunks));
+    for (const auto& chunk : split) {
+      TENSORSTORE_ASSIGN_OR_RETURN(
+          auto data,
+          DecodeData(chunk.encoded_data, sharding_spec.data_encoding),
+          (ADD_FAILURE() << _, chunks));
+      EXPECT_TRUE(chunks
+                      .emplace(chunk.minishard_and_chunk_id.chunk_id.value,
+                               std::string(data))
+                      .second);
+    }
+  }
+  return chunks;
+}
+
+TEST(ShardedIngestWriterTest, InMemory) {
+  for (auto data_encoding :
+       {ShardingSpec::DataEncoding::raw, ShardingSpec::DataEncoding::gzip}) {
+    SCOPED_TRACE(data_encoding);
+    auto sharding_spec = GetShardingSpec(data_encoding);
+    auto base = tensorstore::GetMemoryKeyValueStore();
+    ShardedIngestWriter writer(base, InlineExecutor{}, "prefix", sharding_spec,
+                               {});
+    std::map<uint64_t, std::string> expected;
+    for (uint64_t i = 0; i < 50; ++i) {
+      expected[i] = absl::StrCat("chunk", i);
+      TENSORSTORE_EXPECT_OK(writer.Add(ChunkId{i}, absl::Cord(expected[i])));
+    }
+    EXPECT_LT(0, writer.buffered_bytes());
+    TENSORSTORE_EXPECT_OK(writer.Finalize());
+    EXPECT_EQ(expected, ReadAllChunks(KvStore(base), sharding_spec));
+  }
+}
+
+TEST(ShardedIngestWriterTest, Spill) {
+  auto sharding_spec = GetShardingSpec(ShardingSpec::DataEncoding::raw);
+  auto base = tensorstore::GetMemoryKeyValueStore();
+  KvStore spill(tensorstore::GetMemoryKeyValueStore(), "spill/");
+  ShardedIngestWriter::Options options;
+  options.max_buffered_bytes = 64;
+  options.spill_kvstore = spill;
+  ShardedIngestWriter writer(base, InlineExecutor{}, "prefix", sharding_spec,
+                             options);
+  std::map<uint64_t, std::string> expected;
+  for (uint64_t i = 0; i < 50; ++i) {
+    expected[i] = absl::StrCat("chunk", i);
+    TENSORSTORE_EXPECT_OK(writer.Add(ChunkId{i}, absl::Cord(expected[i])));
+    EXPECT_GE(options.max_buffered_bytes, writer.buffered_bytes());
+  }
+  // Replace chunks that were previously spilled.
+  for (uint64_t i = 0; i < 50; i += 7) {
+    expected[i] = absl::StrCat("new", i);
+    TENSORSTORE_EXPECT_OK(writer.Add(ChunkId{i}, absl::Cord(expected[i])));
+  }
+  EXPECT_THAT(GetMap(spill), ::testing::Optional(::testing::Not(
+                                 ::testing::IsEmpty())));
+  TENSORSTORE_EXPECT_OK(writer.Finalize());
+  EXPECT_EQ(expected, ReadAllChunks(KvStore(base), sharding_spec));
+  // Spilled chunks are removed once the shard is written.
+  EXPECT_THAT(GetMap(spill), ::testing::Optional(::testing::IsEmpty()));
+}
+
+TEST(ShardedIngestWriterTest, Empty) {
+  auto sharding_spec = GetShardingSpec(ShardingSpec::DataEncoding::raw);
+  auto base = tensorstore::GetMemoryKeyValueStore();
+  ShardedIngestWriter writer(base, InlineExecutor{}, "prefix", sharding_spec,
+                             {});
+  TENSORSTORE_EXPECT_OK(writer.Finalize());
+  EXPECT_THAT(GetMap(KvStore(base)), ::testing::Optional(::testing::IsEmpty()));
+}
+
+}  // namespace
@@ -0,0 +1,48 @@
+// Copyright 2024 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/bulk_load.h"
+
+#include <memory>
+
+#include "absl/status/status.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/ocdbt/driver.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/bulk_load.h"
+#include "tensorstore/transaction.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+
+Future<std::shared_ptr<BtreeBulkLoader>> OpenBulkLoader(
+    const KvStore& kvstore) {
+  auto* driver = dynamic_cast<OcdbtDriver*>(kvstore.driver.get());
+  if (!driver) {
+    return absl::InvalidArgumentError(
+        "Bulk load requires an \"ocdbt\" key-value store");
+  }
+  if (driver->coordinator_->address) {
+    return absl::InvalidArgumentError(
+        "Bulk load is not supported in distributed mode");
+  }
+  if (kvstore.transaction != no_transaction) {
+    return absl::InvalidArgumentError(
+        "Bulk load is not supported within a transaction");
+  }
+  return BtreeBulkLoader::Open(driver->io_handle_, kvstore.path);
+}
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
@@ -0,0 +1,40 @@
+// Copyright 2024 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_OCDBT_BULK_LOAD_H_
+#define TENSORSTORE_KVSTORE_OCDBT_BULK_LOAD_H_
+
+#include <memory>
+
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/bulk_load.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+
+/// Returns a bulk loader for the empty OCDBT database opened as `kvstore`.
+///
+/// Keys passed to `BtreeBulkLoader::Add` are relative to `kvstore.path`.
+///
+/// Fails with `absl::StatusCode::kInvalidArgument` if `kvstore` does not
+/// refer to an OCDBT database in non-distributed mode, or with
+/// `absl::StatusCode::kFailedPrecondition` if the database is not empty.
+Future<std::shared_ptr<BtreeBulkLoader>> OpenBulkLoader(
+    const KvStore& kvstore);
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_OCDBT_BULK_LOAD_H_
@@ -0,0 +1,153 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/bulk_load.h"
+
+#include <stddef.h>
+
+#include <map>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_format.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/test_util.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+namespace kvstore = ::tensorstore::kvstore;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::internal::GetMap;
+using ::tensorstore::internal_ocdbt::OpenBulkLoader;
+
+TEST(BulkLoadTest, Empty) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", "ocdbt"}, {"base", "memory://"}}).result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto loader, OpenBulkLoader(store).result());
+  TENSORSTORE_ASSERT_OK(loader->Commit().result());
+  EXPECT_THAT(GetMap(store), ::testing::Optional(::testing::IsEmpty()));
+}
+
+TEST(BulkLoadTest, SingleNode) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", "ocdbt"}, {"base", "memory://"}}).result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto loader, OpenBulkLoader(store).result());
+  TENSORSTORE_ASSERT_OK(loader->Add("testa", absl::Cord("a")));
+  TENSORSTORE_ASSERT_OK(loader->Add("testb", absl::Cord("b")));
+  TENSORSTORE_ASSERT_OK(loader->Commit().result());
+  EXPECT_THAT(GetMap(store), ::testing::Optional(::testing::ElementsAreArray({
+                                 ::testing::Pair("testa", absl::Cord("a")),
+                                 ::testing::Pair("testb", absl::Cord("b")),
+                             })));
+}
+
+TEST(BulkLoadTest, ManyNodes) {
+  for (size_t max_decoded_node_bytes : {1, 100, 1000}) {
+    SCOPED_TRACE(absl::StrFormat("max_decoded_node_bytes=%d",
+                                 max_decoded_node_bytes));
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto store,
+        kvstore::Open(
+            {{"driver", "ocdbt"},
+             {"base", "memory://"},
+             {"config",
+              {{"max_decoded_node_bytes", max_decoded_node_bytes},
+               {"max_inline_value_bytes", 10}}}})
+            .result());
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto loader,
+                                     OpenBulkLoader(store).result());
+    std::map<std::string, absl::Cord> expected;
+    for (int i = 0; i < 500; ++i) {
+      std::string key = absl::StrFormat("key/%05d", i);
+      // Alternate between inline and out-of-line values.
+      absl::Cord value(std::string(i % 2 ? 3 : 50, 'a' + i % 26));
+      TENSORSTORE_ASSERT_OK(loader->Add(key, value));
+      expected.emplace(key, value);
+    }
+    EXPECT_EQ(500, loader->num_keys());
+    TENSORSTORE_ASSERT_OK(loader->Commit().result());
+    EXPECT_THAT(GetMap(store), ::testing::Optional(expected));
+
+    // The database may be modified normally after the bulk load.
+    TENSORSTORE_ASSERT_OK(kvstore::Write(store, "key/00000", absl::Cord("x")));
+    expected["key/00000"] = absl::Cord("x");
+    EXPECT_THAT(GetMap(store), ::testing::Optional(expected));
+  }
+}
+
+TEST(BulkLoadTest, Path) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, kvstore::Open({{"driver", "ocdbt"},
+                                 {"base", "memory://"},
+                                 {"path", "prefix/"}})
+                      .result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto loader, OpenBulkLoader(store).result());
+  TENSORSTORE_ASSERT_OK(loader->Add("a", absl::Cord("a")));
+  TENSORSTORE_ASSERT_OK(loader->Commit().result());
+  auto root = store;
+  root.path.clear();
+  EXPECT_THAT(GetMap(root), ::testing::Optional(::testing::ElementsAreArray({
+                                ::testing::Pair("prefix/a", absl::Cord("a")),
+                            })));
+}
+
+TEST(BulkLoadTest, UnsortedKeys) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", "ocdbt"}, {"base", "memory://"}}).result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto loader, OpenBulkLoader(store).result());
+  TENSORSTORE_ASSERT_OK(loader->Add("b", absl::Cord("b")));
+  EXPECT_THAT(loader->Add("a", absl::Cord("a")),
+              MatchesStatus(absl::StatusCode::kInvalidArgument,
+                            "Keys must be added in strictly increasing .*"));
+  EXPECT_THAT(loader->Add("b", absl::Cord("b")),
+              MatchesStatus(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(BulkLoadTest, NonEmptyDatabase) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", "ocdbt"}, {"base", "memory://"}}).result());
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("a")));
+  EXPECT_THAT(OpenBulkLoader(store).result(),
+              MatchesStatus(absl::StatusCode::kFailedPrecondition,
+                            "Bulk load requires an empty database"));
+}
+
+TEST(BulkLoadTest, ConcurrentModification) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", "ocdbt"}, {"base", "memory://"}}).result());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto loader, OpenBulkLoader(store).result());
+  TENSORSTORE_ASSERT_OK(loader->Add("b", absl::Cord("b")));
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("a")));
+  EXPECT_THAT(loader->Commit().result(),
+              MatchesStatus(absl::StatusCode::kAborted));
+}
+
+TEST(BulkLoadTest, NotOcdbt) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store,
+                                   kvstore::Open("memory://").result());
+  EXPECT_THAT(OpenBulkLoader(store).result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace
@@ -0,0 +1,148 @@
+// Copyright 2024 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/compact.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/status.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/ocdbt/driver.h"
+#include "tensorstore/kvstore/ocdbt/format/data_file_id.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/compact.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/transaction.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+namespace {
+
+// Returns `true` if `key` may have been generated by `GenerateDataFileId` for
+// one of `prefixes`.
+bool IsDataFileKey(std::string_view key, span<const std::string> prefixes) {
+  constexpr size_t kIdLength = 32;
+  for (const auto& prefix : prefixes) {
+    if (key.size() != prefix.size() + kIdLength ||
+        !absl::StartsWith(key, prefix)) {
+      continue;
+    }
+    if (std::all_of(key.begin() + prefix.size(), key.end(), [](char c) {
+          return absl::ascii_isdigit(c) || (c >= 'a' && c <= 'f');
+        })) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+Future<CompactResult> CompactDatabase(const KvStore& kvstore,
+                                      const CompactDatabaseOptions& options) {
+  auto* driver = dynamic_cast<OcdbtDriver*>(kvstore.driver.get());
+  if (!driver) {
+    return absl::InvalidArgumentError(
+        "Compaction requires an \"ocdbt\" key-value store");
+  }
+  if (driver->coordinator_->address) {
+    return absl::InvalidArgumentError(
+        "Compaction is not supported in distributed mode");
+  }
+  if (kvstore.transaction != no_transaction) {
+    return absl::InvalidArgumentError(
+        "Compaction is not supported within a transaction");
+  }
+  IoHandle::Ptr io_handle = driver->io_handle_;
+  if (!options.delete_unreferenced_files) {
+    return Compact(std::move(io_handle), options);
+  }
+
+  // List the existing data files before compaction starts, such that files
+  // written concurrently are never deleted.
+  const auto& data_file_prefixes = driver->data_file_prefixes_;
+  std::vector<std::string> prefixes{data_file_prefixes.value,
+                                    data_file_prefixes.btree_node,
+                                    data_file_prefixes.version_tree_node};
+  std::sort(prefixes.begin(), prefixes.end());
+  prefixes.erase(std::unique(prefixes.begin(), prefixes.end()),
+                 prefixes.end());
+  std::vector<Future<std::vector<kvstore::ListEntry>>> list_futures;
+  for (const auto& prefix : prefixes) {
+    kvstore::ListOptions list_options;
+    list_options.range = KeyRange::Prefix(prefix);
+    list_futures.push_back(kvstore::ListFuture(driver->base_, list_options));
+  }
+  auto all_listed = WaitAllFuture(tensorstore::span(list_futures));
+  return PromiseFuturePair<CompactResult>::LinkValue(
+             [base = driver->base_, io_handle = std::move(io_handle),
+              options = static_cast<const CompactOptions&>(options),
+              prefixes = std::move(prefixes),
+              list_futures = std::move(list_futures)](
+                 Promise<CompactResult> promise,
+                 ReadyFuture<void> future) mutable {
+               absl::flat_hash_set<std::string> candidates;
+               for (const auto& list_future : list_futures) {
+                 for (const auto& entry : list_future.value()) {
+                   if (IsDataFileKey(entry.key, prefixes)) {
+                     candidates.insert(entry.key);
+                   }
+                 }
+               }
+               LinkValue(
+                   [base = std::move(base),
+                    candidates = std::move(candidates)](
+                       Promise<CompactResult> promise,
+                       ReadyFuture<CompactResult> future) {
+                     auto& result = future.value();
+                     absl::flat_hash_set<std::string> referenced;
+                     for (const auto& file_id : result.referenced_files) {
+                       referenced.insert(file_id.FullPath());
+                     }
+                     std::vector<Future<TimestampedStorageGeneration>>
+                         delete_futures;
+                     for (const auto& key : candidates) {
+                       if (referenced.contains(key)) continue;
+                       delete_futures.push_back(kvstore::Delete(base, key));
+                     }
+                     result.num_files_deleted = delete_futures.size();
+                     LinkValue(
+                         [result = std::move(result)](
+                             Promise<CompactResult> promise,
+                             ReadyFuture<void> future) {
+                           promise.SetResult(result);
+                         },
+                         std::move(promise),
+                         WaitAllFuture(tensorstore::span(delete_futures)));
+                   },
+                   std::move(promise), Compact(io_handle, options));
+             },
+             std::move(all_listed))
+      .future;
+}
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
@@ -0,0 +1,44 @@
+// Copyright 2024 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_OCDBT_COMPACT_H_
+#define TENSORSTORE_KVSTORE_OCDBT_COMPACT_H_
+
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/compact.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+
+struct CompactDatabaseOptions : public CompactOptions {
+  /// Delete the data files that are not referenced by the compacted manifest.
+  ///
+  /// Only data files listed before compaction starts are considered.  This is
+  /// nonetheless unsafe while other processes write to the database, since
+  /// out-of-line values are written before the commit that references them.
+  bool delete_unreferenced_files = false;
+};
+
+/// Compacts the OCDBT database opened as `kvstore`.
+///
+/// Fails with `absl::StatusCode::kInvalidArgument` if `kvstore` does not
+/// refer to an OCDBT database in non-distributed mode.
+Future<CompactResult> CompactDatabase(const KvStore& kvstore,
+                                      const CompactDatabaseOptions& options);
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_OCDBT_COMPACT_H_
@@ -0,0 +1,211 @@
+// Copyright 2024 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/compact.h"
+
+#include <stddef.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_format.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/list_versions.h"
+#include "tensorstore/kvstore/ocdbt/test_util.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/test_util.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+namespace kvstore = ::tensorstore::kvstore;
+using ::tensorstore::Context;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::internal::GetMap;
+using ::tensorstore::internal_ocdbt::CompactDatabase;
+using ::tensorstore::internal_ocdbt::CompactDatabaseOptions;
+using ::tensorstore::internal_ocdbt::GenerationNumber;
+using ::tensorstore::internal_ocdbt::GetOcdbtIoHandle;
+using ::tensorstore::internal_ocdbt::ListVersionsFuture;
+
+std::vector<GenerationNumber> GetGenerationNumbers(
+    const kvstore::KvStore& store) {
+  std::vector<GenerationNumber> generation_numbers;
+  auto versions = ListVersionsFuture(GetOcdbtIoHandle(*store.driver)).result();
+  EXPECT_TRUE(versions.ok()) << versions.status();
+  if (versions.ok()) {
+    for (const auto& version : *versions) {
+      generation_numbers.push_back(version.generation_number);
+    }
+  }
+  return generation_numbers;
+}
+
+size_t CountKeys(const kvstore::KvStore& store) {
+  auto entries = kvstore::ListFuture(store).result();
+  EXPECT_TRUE(entries.ok()) << entries.status();
+  return entries.ok() ? entries->size() : 0;
+}
+
+class CompactTest : public ::testing::TestWithParam<::nlohmann::json> {
+ protected:
+  void SetUp() override {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        base_, kvstore::Open("memory://db/", context_).result());
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        store_, kvstore::Open({{"driver", "ocdbt"},
+                               {"base", "memory://db/"},
+                               {"config", GetParam()}},
+                              context_)
+                    .result());
+  }
+
+  // Writes `num_writes` versions, each modifying one of a few keys, and
+  // returns the expected final contents.
+  std::map<std::string, absl::Cord> WriteVersions(int num_writes) {
+    std::map<std::string, absl::Cord> expected;
+    for (int i = 0; i < num_writes; ++i) {
+      std::string key = absl::StrFormat("key%d", i % 5);
+      // Alternate between inline and out-of-line values.
+      absl::Cord value(std::string(i % 2 ? 3 : 200, 'a' + i % 26));
+      EXPECT_TRUE(kvstore::Write(store_, key, value).result().ok());
+      expected[key] = value;
+    }
+    return expected;
+  }
+
+  Context context_ = Context::Default();
+  kvstore::KvStore base_;
+  kvstore::KvStore store_;
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    Configs, CompactTest,
+    ::testing::Values(
+        ::nlohmann::json{{"version_tree_arity_log2", 1},
+                         {"max_inline_value_bytes", 100},
+                         {"max_decoded_node_bytes", 100}},
+        ::nlohmann::json{{"version_tree_arity_log2", 2},
+                         {"max_inline_value_bytes", 100},
+                         {"manifest_kind", "numbered"}}));
+
+TEST_P(CompactTest, KeepLastVersions) {
+  auto expected = WriteVersions(20);
+  // Generation 1 is the initial empty version.
+  ASSERT_EQ(21, GetGenerationNumbers(store_).size());
+
+  CompactDatabaseOptions options;
+  options.keep_last_versions = 3;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto result,
+                                   CompactDatabase(store_, options).result());
+  EXPECT_EQ(22, result.generation_number);
+  EXPECT_EQ(18, result.num_versions_removed);
+  EXPECT_EQ(0, result.num_files_deleted);
+  EXPECT_THAT(GetGenerationNumbers(store_),
+              ::testing::ElementsAre(19, 20, 21, 22));
+  EXPECT_THAT(GetMap(store_), ::testing::Optional(expected));
+
+  // The database may be modified normally after compaction.
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store_, "key0", absl::Cord("x")));
+  expected["key0"] = absl::Cord("x");
+  EXPECT_THAT(GetMap(store_), ::testing::Optional(expected));
+  EXPECT_THAT(GetGenerationNumbers(store_),
+              ::testing::ElementsAre(19, 20, 21, 22, 23));
+
+  // Compacting again removes the versions that were retained before.
+  TENSORSTORE_ASSERT_OK(CompactDatabase(store_, options).result());
+  EXPECT_THAT(GetGenerationNumbers(store_),
+              ::testing::ElementsAre(21, 22, 23, 24));
+  EXPECT_THAT(GetMap(store_), ::testing::Optional(expected));
+}
+
+TEST_P(CompactTest, DeleteUnreferencedFiles) {
+  auto expected = WriteVersions(20);
+  size_t num_keys_before = CountKeys(base_);
+
+  CompactDatabaseOptions options;
+  options.keep_last_versions = 1;
+  options.delete_unreferenced_files = true;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto result,
+                                   CompactDatabase(store_, options).result());
+  EXPECT_EQ(20, result.num_versions_removed);
+  EXPECT_LT(0, result.num_files_deleted);
+  EXPECT_LT(CountKeys(base_), num_keys_before);
+  EXPECT_THAT(GetGenerationNumbers(store_), ::testing::ElementsAre(21, 22));
+  EXPECT_THAT(GetMap(store_), ::testing::Optional(expected));
+
+  // Reopen to ensure that nothing is served from the cache.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto reopened,
+      kvstore::Open({{"driver", "ocdbt"},
+                     {"base", "memory://db/"},
+                     {"cache_pool", {{"total_bytes_limit", 0}}}},
+                    context_)
+          .result());
+  EXPECT_THAT(GetMap(reopened), ::testing::Optional(expected));
+}
+
+TEST_P(CompactTest, KeepVersionTree) {
+  auto expected = WriteVersions(10);
+  CompactDatabaseOptions options;
+  options.keep_last_versions = 2;
+  options.rewrite_data = false;
+  options.delete_unreferenced_files = true;
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto result,
+                                   CompactDatabase(store_, options).result());
+  EXPECT_EQ(9, result.num_versions_removed);
+  EXPECT_THAT(GetGenerationNumbers(store_),
+              ::testing::ElementsAre(10, 11, 12));
+  EXPECT_THAT(GetMap(store_), ::testing::Optional(expected));
+}
+
+TEST_P(CompactTest, KeepNewerThan) {
+  WriteVersions(5);
+  auto time = absl::Now();
+  auto expected = WriteVersions(3);
+  CompactDatabaseOptions options;
+  options.keep_newer_than = time;
+  TENSORSTORE_ASSERT_OK(CompactDatabase(store_, options).result());
+  EXPECT_THAT(GetGenerationNumbers(store_),
+              ::testing::ElementsAre(7, 8, 9, 10));
+  EXPECT_THAT(GetMap(store_), ::testing::Optional(expected));
+}
+
+TEST(CompactDatabaseTest, InvalidOptions) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", "ocdbt"}, {"base", "memory://"}}).result());
+  TENSORSTORE_ASSERT_OK(kvstore::Write(store, "a", absl::Cord("a")));
+  CompactDatabaseOptions options;
+  options.keep_last_versions = 0;
+  EXPECT_THAT(CompactDatabase(store, options).result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(CompactDatabaseTest, NotOcdbt) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store,
+                                   kvstore::Open("memory://").result());
+  EXPECT_THAT(CompactDatabase(store, {}).result(),
+              MatchesStatus(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace
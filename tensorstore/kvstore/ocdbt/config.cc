@@ -23,6 +23,7 @@
 #include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
 #include <nlohmann/json.hpp>
+#include "riegeli/lz4/lz4_writer.h"
 #include "riegeli/zstd/zstd_writer.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json_binding/bindable.h"
@@ -32,6 +33,7 @@
 #include "tensorstore/internal/json_binding/std_optional.h"
 #include "tensorstore/internal/json_binding/std_variant.h"
 #include "tensorstore/kvstore/ocdbt/format/config.h"
+#include "tensorstore/kvstore/ocdbt/format/key_filter.h"
 #include "tensorstore/kvstore/ocdbt/format/version_tree.h"
 #include "tensorstore/kvstore/supported_features.h"
 #include "tensorstore/util/result.h"
@@ -52,8 +54,17 @@ constexpr auto ZstdCompressionJsonBinder = jb::Object(
             jb::DefaultInitializedValue(jb::Integer<int32_t>(
                 riegeli::ZstdWriterBase::Options::kMinCompressionLevel,
                 riegeli::ZstdWriterBase::Options::kMaxCompressionLevel)))));
+constexpr auto Lz4CompressionJsonBinder = jb::Object(
+    jb::Member("id", jb::Constant([] { return "lz4"; })),
+    jb::Member(
+        "level",
+        jb::Projection<&Config::Lz4Compression::level>(
+            jb::DefaultInitializedValue(jb::Integer<int32_t>(
+                riegeli::Lz4WriterBase::Options::kMinCompressionLevel,
+                riegeli::Lz4WriterBase::Options::kMaxCompressionLevel)))));
 constexpr auto ConfigCompressionJsonBinder =
-    jb::Variant(NoCompressionJsonBinder, ZstdCompressionJsonBinder);
+    jb::Variant(NoCompressionJsonBinder, ZstdCompressionJsonBinder,
+                Lz4CompressionJsonBinder);
 
 constexpr auto ManifestKindJsonBinder = [](auto is_loading, const auto& options,
                                            auto* obj, auto* j) {
@@ -86,7 +97,19 @@ TENSORSTORE_DEFINE_JSON_DEFAULT_BINDER(
                            jb::Integer<uint8_t>(1, kMaxVersionTreeArityLog2)))),
         jb::Member("compression",
                    jb::Projection<&ConfigConstraints::compression>(
-                       jb::Optional(ConfigCompressionJsonBinder)))))
+                       jb::Optional(ConfigCompressionJsonBinder))),
+        jb::Member(
+            "btree_key_filter_bits_per_key",
+            jb::Projection<&ConfigConstraints::btree_key_filter_bits_per_key>(
+                jb::Optional(
+                    jb::Integer<uint8_t>(0, kMaxKeyFilterBitsPerKey)))),
+        jb::Member("btree_node_compression",
+                   jb::Projection<&ConfigConstraints::btree_node_compression>(
+                       jb::Optional(ConfigCompressionJsonBinder))),
+        jb::Member(
+            "version_tree_node_compression",
+            jb::Projection<&ConfigConstraints::version_tree_node_compression>(
+                jb::Optional(ConfigCompressionJsonBinder)))))
 
 void to_json(::nlohmann::json& j, const Config::Compression& compression) {
   ConfigCompressionJsonBinder(/*is_loading=*/std::false_type{},
@@ -129,9 +152,20 @@ absl::Status ValidateConfig(const Config& config,
   TENSORTORE_INTERNAL_DO_VALIDATE(max_decoded_node_bytes)
   TENSORTORE_INTERNAL_DO_VALIDATE(version_tree_arity_log2)
   TENSORTORE_INTERNAL_DO_VALIDATE(compression)
+  TENSORTORE_INTERNAL_DO_VALIDATE(btree_key_filter_bits_per_key)
 
 #undef TENSORTORE_INTERNAL_DO_VALIDATE
 
+  // Compared to the effective compression, since an unspecified override is
+  // equivalent to specifying `compression`.
+  TENSORSTORE_RETURN_IF_ERROR(validate("btree_node_compression",
+                                       config.GetBtreeNodeCompression(),
+                                       constraints.btree_node_compression));
+  TENSORSTORE_RETURN_IF_ERROR(
+      validate("version_tree_node_compression",
+               config.GetVersionTreeNodeCompression(),
+               constraints.version_tree_node_compression));
+
   return absl::OkStatus();
 }
 
@@ -172,6 +206,12 @@ absl::Status CreateConfig(const ConfigConstraints& constraints,
       default_config.version_tree_arity_log2);
   config.compression =
       constraints.compression.value_or(default_config.compression);
+  config.btree_key_filter_bits_per_key =
+      constraints.btree_key_filter_bits_per_key.value_or(
+          default_config.btree_key_filter_bits_per_key);
+  config.btree_node_compression = constraints.btree_node_compression;
+  config.version_tree_node_compression =
+      constraints.version_tree_node_compression;
   return absl::OkStatus();
 }
 
@@ -180,7 +220,15 @@ ConfigConstraints::ConfigConstraints(const Config& config)
       max_inline_value_bytes(config.max_inline_value_bytes),
       max_decoded_node_bytes(config.max_decoded_node_bytes),
       version_tree_arity_log2(config.version_tree_arity_log2),
-      compression(config.compression) {}
+      compression(config.compression) {
+  // Only included if enabled, such that the spec of a database that does not
+  // use key filters is unchanged.
+  if (config.btree_key_filter_bits_per_key != 0) {
+    btree_key_filter_bits_per_key = config.btree_key_filter_bits_per_key;
+  }
+  btree_node_compression = config.btree_node_compression;
+  version_tree_node_compression = config.version_tree_node_compression;
+}
 
 Result<ConfigStatePtr> ConfigState::Make(
     const ConfigConstraints& constraints,
@@ -42,6 +42,9 @@ struct ConfigConstraints {
   std::optional<uint32_t> max_decoded_node_bytes;
   std::optional<uint8_t> version_tree_arity_log2;
   std::optional<Config::Compression> compression;
+  std::optional<uint8_t> btree_key_filter_bits_per_key;
+  std::optional<Config::Compression> btree_node_compression;
+  std::optional<Config::Compression> version_tree_node_compression;
 
   friend bool operator==(const ConfigConstraints& a,
                          const ConfigConstraints& b);
@@ -57,7 +60,8 @@ struct ConfigConstraints {
   constexpr static auto ApplyMembers = [](auto&& x, auto f) {
     return f(x.uuid, x.manifest_kind, x.max_inline_value_bytes,
              x.max_decoded_node_bytes, x.version_tree_arity_log2,
-             x.compression);
+             x.compression, x.btree_key_filter_bits_per_key,
+             x.btree_node_compression, x.version_tree_node_compression);
   };
 };
 
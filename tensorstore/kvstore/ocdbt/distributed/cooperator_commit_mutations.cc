@@ -35,6 +35,9 @@
 #include "tensorstore/internal/grpc/utils.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/log/verbose_flag.h"
+#include "tensorstore/internal/metrics/counter.h"
+#include "tensorstore/internal/metrics/histogram.h"
+#include "tensorstore/internal/metrics/metadata.h"
 #include "tensorstore/internal/mutex.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/key_range.h"
@@ -61,7 +64,28 @@ namespace tensorstore {
 namespace internal_ocdbt_cooperator {
 namespace {
 ABSL_CONST_INIT internal_log::VerboseFlag ocdbt_logging("ocdbt");
-}
+
+auto& commit_batch_size =
+    internal_metrics::Histogram<internal_metrics::DefaultBucketer>::New(
+        "/tensorstore/kvstore/ocdbt/cooperator/commit_batch_size",
+        internal_metrics::MetricMetadata(
+            "Histogram of the number of mutations committed together to a "
+            "single OCDBT B+tree node by a cooperator."));
+
+auto& commit_latency_ms =
+    internal_metrics::Histogram<internal_metrics::DefaultBucketer>::New(
+        "/tensorstore/kvstore/ocdbt/cooperator/commit_latency_ms",
+        internal_metrics::MetricMetadata(
+            "Histogram of the latency of OCDBT cooperator node commits, "
+            "including the update of the parent node or manifest.",
+            internal_metrics::Units::kMilliseconds));
+
+auto& commit_retries = internal_metrics::Counter<int64_t>::New(
+    "/tensorstore/kvstore/ocdbt/cooperator/commit_retries",
+    internal_metrics::MetricMetadata(
+        "OCDBT cooperator node commits restarted due to concurrent "
+        "modification"));
+}  // namespace
 
 using NodeMutationRequests = Cooperator::NodeMutationRequests;
 
@@ -125,6 +149,12 @@ struct NodeCommitOperation
   // node/nodes can be referenced.
   FlushPromise flush_promise;
 
+  // Time at which the commit operation started, for `commit_latency_ms`.
+  absl::Time start_time = absl::Now();
+
+  // Time as of which the successful commit is reflected in the manifest.
+  absl::Time commit_time = absl::InfinitePast();
+
   // Starts or restarts the commit operation.
   //
   // Args:
@@ -446,8 +476,15 @@ void NodeCommitOperation::ApplyMutations(NodeCommitOperation::Ptr commit_op,
 }
 
 void NodeCommitOperation::Done() {
+  if (!staged.requests.empty()) {
+    commit_batch_size.Observe(staged.requests.size());
+    commit_latency_ms.Observe(
+        absl::ToDoubleMilliseconds(absl::Now() - start_time));
+  }
   UniqueWriterLock lock{mutation_requests->mutex};
   mutation_requests->commit_in_progress = false;
+  mutation_requests->last_commit_time =
+      std::max(mutation_requests->last_commit_time, commit_time);
   MaybeCommit(*server, std::move(mutation_requests), std::move(lock));
 }
 
@@ -491,6 +528,7 @@ void NodeCommitOperation::SetSuccess(GenerationNumber root_generation,
     response.root_generation = root_generation;
     response.time = time;
   }
+  commit_time = time;
   Done();
 }
 
@@ -737,6 +775,7 @@ void NodeCommitOperation::UpdateParent(
                   << "] Retrying commit because: " << r.status();
             }
             // Retry
+            commit_retries.Increment();
             auto new_staleness_bound =
                 commit_op->existing_manifest_time + absl::Nanoseconds(1);
             StartCommit(std::move(commit_op), new_staleness_bound);
@@ -839,6 +878,7 @@ void NodeCommitOperation::WriteNewManifest(NodeCommitOperation::Ptr commit_op) {
 }
 
 void NodeCommitOperation::RetryCommit(NodeCommitOperation::Ptr commit_op) {
+  commit_retries.Increment();
   auto new_staleness_bound =
       commit_op->existing_manifest_time + absl::Nanoseconds(1);
   StartCommit(std::move(commit_op), new_staleness_bound);
@@ -865,12 +905,20 @@ void MaybeCommit(Cooperator& server,
   }
   if (mutation_requests->commit_in_progress) return;
   mutation_requests->commit_in_progress = true;
+  // Requests that arrived while the previous commit was in progress are
+  // committed together as the next batch.  The manifest must reflect the
+  // previous commit, since otherwise this commit would apply the mutations to
+  // a superseded version of the node and fail when updating the parent.  The
+  // commit time may have been determined by another cooperator, and is
+  // therefore limited to the local time.
+  const absl::Time manifest_staleness_bound =
+      std::min(mutation_requests->last_commit_time, server.clock_());
   lock.unlock();
   auto commit_op = internal::MakeIntrusivePtr<NodeCommitOperation>();
   commit_op->server.reset(&server);
   commit_op->mutation_requests = std::move(mutation_requests);
-  NodeCommitOperation::StartCommit(
-      std::move(commit_op), /*manifest_staleness_bound=*/absl::InfinitePast());
+  NodeCommitOperation::StartCommit(std::move(commit_op),
+                                   manifest_staleness_bound);
 }
 
 }  // namespace internal_ocdbt_cooperator
@@ -82,6 +82,12 @@ struct Cooperator : public grpc_gen::Cooperator::CallbackService,
     PendingRequests pending;
     bool commit_in_progress = false;
 
+    // Time as of which the most recent successful commit is reflected in the
+    // manifest.  Used as the staleness bound for the manifest read by the next
+    // commit, since a manifest that predates the previous commit necessarily
+    // references a superseded version of this node.
+    absl::Time last_commit_time = absl::InfinitePast();
+
     NodeKey node_key() const {
       return {lease_node->key, node_identifier.height};
     }
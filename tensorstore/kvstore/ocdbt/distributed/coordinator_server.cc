@@ -27,6 +27,7 @@
 #include "absl/base/attributes.h"
 #include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/log/absl_log.h"
 #include "absl/meta/type_traits.h"
 #include "absl/status/status.h"
@@ -96,6 +97,14 @@ CoordinatorServer& CoordinatorServer::operator=(CoordinatorServer&&) = default;
 class CoordinatorServer::Impl
     : public internal_ocdbt::grpc_gen::Coordinator::CallbackService {
  public:
+  class ManifestWatcher;
+
+  ~Impl() override {
+    // Watch streams never complete on their own, and their reactors access
+    // the members below until they are done.
+    if (server_) server_->Shutdown(absl::ToChronoTime(absl::Now()));
+  }
+
   std::vector<int> listening_ports_;
   std::unique_ptr<grpc::Server> server_;
   Clock clock_;
@@ -105,14 +114,107 @@ class CoordinatorServer::Impl
       const internal_ocdbt::grpc_gen::LeaseRequest* request,
       internal_ocdbt::grpc_gen::LeaseResponse* response) override;
 
+  grpc::ServerUnaryReactor* PublishManifest(
+      grpc::CallbackServerContext* context,
+      const internal_ocdbt::grpc_gen::PublishManifestRequest* request,
+      internal_ocdbt::grpc_gen::PublishManifestResponse* response) override;
+
+  grpc::ServerWriteReactor<internal_ocdbt::grpc_gen::ManifestNotification>*
+  WatchManifest(
+      grpc::CallbackServerContext* context,
+      const internal_ocdbt::grpc_gen::WatchManifestRequest* request) override;
+
   void PurgeExpiredLeases() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
+  void RemoveManifestWatcher(const std::string& key, ManifestWatcher* watcher);
+
   absl::Mutex mutex_;
   LeaseTree leases_by_expiration_time_ ABSL_GUARDED_BY(mutex_);
   using LeaseSet =
       internal::HeterogeneousHashSet<std::unique_ptr<LeaseNode>,
                                      std::string_view, &LeaseNode::key>;
   LeaseSet leases_by_key_ ABSL_GUARDED_BY(mutex_);
+
+  struct ManifestState {
+    // Latest generation published, or 0 if none.
+    uint64_t generation = 0;
+    absl::flat_hash_set<ManifestWatcher*> watchers;
+  };
+  absl::flat_hash_map<std::string, ManifestState> manifests_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+// Streams the latest generation published for a database to a client.
+//
+// At most one write is in progress at a time; a generation published while a
+// write is in progress supersedes any generation not yet sent.
+class CoordinatorServer::Impl::ManifestWatcher
+    : public grpc::ServerWriteReactor<
+          internal_ocdbt::grpc_gen::ManifestNotification> {
+ public:
+  ManifestWatcher(Impl* impl, std::string key)
+      : impl_(impl), key_(std::move(key)) {}
+
+  void Notify(uint64_t generation) {
+    {
+      absl::MutexLock lock(&mutex_);
+      if (generation <= pending_generation_ || cancelled_) return;
+      pending_generation_ = generation;
+      if (write_in_progress_) return;
+      write_in_progress_ = true;
+      notification_.set_generation(generation);
+    }
+    StartWrite(&notification_);
+  }
+
+  void OnWriteDone(bool ok) override {
+    bool write_next;
+    {
+      absl::MutexLock lock(&mutex_);
+      if (!ok) cancelled_ = true;
+      write_next =
+          !cancelled_ && notification_.generation() != pending_generation_;
+      if (write_next) {
+        notification_.set_generation(pending_generation_);
+      } else {
+        write_in_progress_ = false;
+        // Unless cancelled, the next `Notify` starts another write.
+        if (!cancelled_ || finished_) return;
+        finished_ = true;
+      }
+    }
+    if (write_next) {
+      StartWrite(&notification_);
+    } else {
+      Finish(grpc::Status::CANCELLED);
+    }
+  }
+
+  void OnCancel() override {
+    {
+      absl::MutexLock lock(&mutex_);
+      cancelled_ = true;
+      // Otherwise, `OnWriteDone` finishes the call.
+      if (write_in_progress_ || finished_) return;
+      finished_ = true;
+    }
+    Finish(grpc::Status::CANCELLED);
+  }
+
+  void OnDone() override {
+    impl_->RemoveManifestWatcher(key_, this);
+    delete this;
+  }
+
+ private:
+  Impl* impl_;
+  std::string key_;
+  absl::Mutex mutex_;
+  internal_ocdbt::grpc_gen::ManifestNotification notification_;
+  uint64_t pending_generation_ ABSL_GUARDED_BY(mutex_) = 0;
+  bool write_in_progress_ ABSL_GUARDED_BY(mutex_) = false;
+  bool cancelled_ ABSL_GUARDED_BY(mutex_) = false;
+  bool finished_ ABSL_GUARDED_BY(mutex_) = false;
 };
 
 span<const int> CoordinatorServer::ports() const {
@@ -212,6 +314,49 @@ grpc::ServerUnaryReactor* CoordinatorServer::Impl::RequestLease(
   return reactor;
 }
 
+grpc::ServerUnaryReactor* CoordinatorServer::Impl::PublishManifest(
+    grpc::CallbackServerContext* context,
+    const internal_ocdbt::grpc_gen::PublishManifestRequest* request,
+    internal_ocdbt::grpc_gen::PublishManifestResponse* response) {
+  auto* reactor = context->DefaultReactor();
+  {
+    absl::MutexLock lock(&mutex_);
+    auto& state = manifests_[request->key()];
+    if (request->generation() > state.generation) {
+      state.generation = request->generation();
+      for (auto* watcher : state.watchers) {
+        watcher->Notify(state.generation);
+      }
+    }
+  }
+  ABSL_LOG_IF(INFO, ocdbt_logging)
+      << "Coordinator: published manifest: " << *request;
+  reactor->Finish(grpc::Status());
+  return reactor;
+}
+
+grpc::ServerWriteReactor<internal_ocdbt::grpc_gen::ManifestNotification>*
+CoordinatorServer::Impl::WatchManifest(
+    grpc::CallbackServerContext* context,
+    const internal_ocdbt::grpc_gen::WatchManifestRequest* request) {
+  auto* watcher = new ManifestWatcher(this, request->key());
+  absl::MutexLock lock(&mutex_);
+  auto& state = manifests_[request->key()];
+  state.watchers.insert(watcher);
+  if (state.generation != 0) {
+    watcher->Notify(state.generation);
+  }
+  return watcher;
+}
+
+void CoordinatorServer::Impl::RemoveManifestWatcher(const std::string& key,
+                                                    ManifestWatcher* watcher) {
+  absl::MutexLock lock(&mutex_);
+  auto it = manifests_.find(key);
+  if (it == manifests_.end()) return;
+  it->second.watchers.erase(watcher);
+}
+
 Result<CoordinatorServer> CoordinatorServer::Start(Options options) {
   auto impl = std::make_unique<Impl>();
   if (options.clock) {
@@ -0,0 +1,224 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/distributed/manifest_notifier.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/base/attributes.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/log/absl_log.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "grpcpp/channel.h"  // third_party
+#include "grpcpp/client_context.h"  // third_party
+#include "grpcpp/support/channel_arguments.h"  // third_party
+#include "grpcpp/support/client_callback.h"  // third_party
+#include "grpcpp/support/status.h"  // third_party
+#include "tensorstore/internal/grpc/clientauth/authentication_strategy.h"
+#include "tensorstore/internal/grpc/clientauth/create_channel.h"
+#include "tensorstore/internal/grpc/utils.h"
+#include "tensorstore/internal/log/verbose_flag.h"
+#include "tensorstore/internal/thread/schedule_at.h"
+#include "tensorstore/kvstore/ocdbt/distributed/coordinator.grpc.pb.h"
+#include "tensorstore/kvstore/ocdbt/distributed/coordinator.pb.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/io_handle.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+namespace {
+
+ABSL_CONST_INIT internal_log::VerboseFlag ocdbt_logging("ocdbt");
+
+using ::tensorstore::internal_grpc::GrpcAuthenticationStrategy;
+
+// State shared by the notifier and its in-progress RPCs.
+struct NotifierState : public std::enable_shared_from_this<NotifierState> {
+  std::string key;
+  absl::Duration retry_delay;
+  std::shared_ptr<grpc_gen::Coordinator::StubInterface> stub;
+  std::shared_ptr<GrpcAuthenticationStrategy> auth_strategy;
+
+  absl::Mutex mutex;
+  bool stopped ABSL_GUARDED_BY(mutex) = false;
+  // Indicates that the current watch has delivered the latest generation
+  // published.
+  bool confirmed ABSL_GUARDED_BY(mutex) = false;
+  GenerationNumber latest_generation ABSL_GUARDED_BY(mutex) = 0;
+  // Context of the current watch, if any.
+  std::shared_ptr<grpc::ClientContext> watch_context ABSL_GUARDED_BY(mutex);
+
+  void StartWatch();
+  void WatchDone(const grpc::Status& status);
+
+  void Notified(GenerationNumber generation) {
+    absl::MutexLock lock(&mutex);
+    latest_generation = std::max(latest_generation, generation);
+    confirmed = true;
+  }
+
+  void Stop() {
+    std::shared_ptr<grpc::ClientContext> context;
+    {
+      absl::MutexLock lock(&mutex);
+      stopped = true;
+      context = std::move(watch_context);
+    }
+    if (context) context->TryCancel();
+  }
+};
+
+// Receives the generations published for the database.
+class WatchReactor
+    : public grpc::ClientReadReactor<grpc_gen::ManifestNotification> {
+ public:
+  WatchReactor(std::shared_ptr<NotifierState> state,
+               std::shared_ptr<grpc::ClientContext> context)
+      : state_(std::move(state)), context_(std::move(context)) {
+    request_.set_key(state_->key);
+  }
+
+  void Start() {
+    state_->stub->async()->WatchManifest(context_.get(), &request_, this);
+    StartRead(&notification_);
+    StartCall();
+  }
+
+  void OnReadDone(bool ok) override {
+    if (!ok) return;
+    state_->Notified(notification_.generation());
+    StartRead(&notification_);
+  }
+
+  void OnDone(const grpc::Status& status) override {
+    state_->WatchDone(status);
+    delete this;
+  }
+
+ private:
+  std::shared_ptr<NotifierState> state_;
+  std::shared_ptr<grpc::ClientContext> context_;
+  grpc_gen::WatchManifestRequest request_;
+  grpc_gen::ManifestNotification notification_;
+};
+
+void NotifierState::StartWatch() {
+  auto context_future =
+      auth_strategy->ConfigureContext(std::make_shared<grpc::ClientContext>());
+  context_future.ExecuteWhenReady(
+      [self = shared_from_this()](
+          ReadyFuture<std::shared_ptr<grpc::ClientContext>> future) {
+        if (!future.result().ok()) {
+          self->WatchDone(grpc::Status(grpc::StatusCode::UNAUTHENTICATED,
+                                       "Failed to configure context"));
+          return;
+        }
+        auto context = future.value();
+        {
+          absl::MutexLock lock(&self->mutex);
+          if (self->stopped) return;
+          self->watch_context = context;
+        }
+        (new WatchReactor(self, std::move(context)))->Start();
+      });
+}
+
+void NotifierState::WatchDone(const grpc::Status& status) {
+  {
+    absl::MutexLock lock(&mutex);
+    confirmed = false;
+    watch_context = nullptr;
+    if (stopped) return;
+  }
+  ABSL_LOG_IF(INFO, ocdbt_logging)
+      << "Manifest watch ended: " << internal::GrpcStatusToAbslStatus(status);
+  internal::ScheduleAt(absl::Now() + retry_delay,
+                       [self = shared_from_this()] { self->StartWatch(); });
+}
+
+class CoordinatorManifestNotifier : public ManifestNotifier {
+ public:
+  explicit CoordinatorManifestNotifier(std::shared_ptr<NotifierState> state)
+      : state_(std::move(state)) {}
+
+  ~CoordinatorManifestNotifier() override { state_->Stop(); }
+
+  void Publish(GenerationNumber generation) override {
+    {
+      absl::MutexLock lock(&state_->mutex);
+      if (generation <= state_->latest_generation) return;
+      state_->latest_generation = generation;
+    }
+    struct PublishCall {
+      std::shared_ptr<grpc::ClientContext> context;
+      grpc_gen::PublishManifestRequest request;
+      grpc_gen::PublishManifestResponse response;
+    };
+    auto call = std::make_shared<PublishCall>();
+    call->request.set_key(state_->key);
+    call->request.set_generation(generation);
+    auto context_future = state_->auth_strategy->ConfigureContext(
+        std::make_shared<grpc::ClientContext>());
+    context_future.ExecuteWhenReady(
+        [state = state_, call = std::move(call)](
+            ReadyFuture<std::shared_ptr<grpc::ClientContext>> future) {
+          if (!future.result().ok()) return;
+          call->context = future.value();
+          auto* call_ptr = call.get();
+          state->stub->async()->PublishManifest(
+              call_ptr->context.get(), &call_ptr->request,
+              &call_ptr->response, [call = std::move(call)](grpc::Status s) {
+                ABSL_LOG_IF(WARNING, !s.ok())
+                    << "Failed to publish manifest generation "
+                    << call->request.generation() << ": "
+                    << internal::GrpcStatusToAbslStatus(s);
+              });
+        });
+  }
+
+  absl::Time GetUpToDateTime(GenerationNumber generation) const override {
+    absl::MutexLock lock(&state_->mutex);
+    if (!state_->confirmed || state_->latest_generation > generation) {
+      return absl::InfinitePast();
+    }
+    return absl::Now();
+  }
+
+ private:
+  std::shared_ptr<NotifierState> state_;
+};
+
+}  // namespace
+
+ManifestNotifier::Ptr MakeCoordinatorManifestNotifier(
+    CoordinatorManifestNotifierOptions options) {
+  auto state = std::make_shared<NotifierState>();
+  state->key = std::move(options.storage_identifier);
+  state->retry_delay = options.retry_delay;
+  state->auth_strategy = options.security->GetClientAuthenticationStrategy();
+  grpc::ChannelArguments args;
+  state->stub = grpc_gen::Coordinator::NewStub(internal_grpc::CreateChannel(
+      *state->auth_strategy, options.coordinator_address, args));
+  state->StartWatch();
+  return ManifestNotifier::Ptr(new CoordinatorManifestNotifier(state));
+}
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
@@ -0,0 +1,52 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_OCDBT_DISTRIBUTED_MANIFEST_NOTIFIER_H_
+#define TENSORSTORE_KVSTORE_OCDBT_DISTRIBUTED_MANIFEST_NOTIFIER_H_
+
+#include <string>
+
+#include "absl/time/time.h"
+#include "tensorstore/kvstore/ocdbt/distributed/rpc_security.h"
+#include "tensorstore/kvstore/ocdbt/io_handle.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+
+struct CoordinatorManifestNotifierOptions {
+  /// Address of the coordinator server.
+  std::string coordinator_address;
+
+  internal_ocdbt::RpcSecurityMethod::Ptr security;
+
+  /// Identifies the database to the coordinator.
+  std::string storage_identifier;
+
+  /// Delay before re-establishing the watch of the manifest after it fails.
+  absl::Duration retry_delay = absl::Seconds(1);
+};
+
+/// Returns a `ManifestNotifier` that publishes manifest updates to the
+/// coordinator server, and watches the manifest generations published by
+/// other processes through it.
+///
+/// A manifest is confirmed to be up to date only while the watch is
+/// established and has delivered the generation published most recently.
+ManifestNotifier::Ptr MakeCoordinatorManifestNotifier(
+    CoordinatorManifestNotifierOptions options);
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_OCDBT_DISTRIBUTED_MANIFEST_NOTIFIER_H_
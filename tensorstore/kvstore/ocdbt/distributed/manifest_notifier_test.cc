@@ -0,0 +1,110 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/distributed/manifest_notifier.h"
+
+#include <string>
+#include <utility>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/kvstore/ocdbt/distributed/coordinator_server.h"
+#include "tensorstore/kvstore/ocdbt/distributed/rpc_security.h"
+#include "tensorstore/kvstore/ocdbt/io_handle.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status_testutil.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace {
+
+using ::tensorstore::internal_ocdbt::CoordinatorManifestNotifierOptions;
+using ::tensorstore::internal_ocdbt::GenerationNumber;
+using ::tensorstore::internal_ocdbt::MakeCoordinatorManifestNotifier;
+using ::tensorstore::internal_ocdbt::ManifestNotifier;
+using ::tensorstore::ocdbt::CoordinatorServer;
+
+// Waits until `notifier` confirms that `generation` is up to date.
+bool WaitUntilUpToDate(const ManifestNotifier& notifier,
+                       GenerationNumber generation) {
+  const absl::Time deadline = absl::Now() + absl::Seconds(10);
+  while (notifier.GetUpToDateTime(generation) == absl::InfinitePast()) {
+    if (absl::Now() > deadline) return false;
+    absl::SleepFor(absl::Milliseconds(1));
+  }
+  return true;
+}
+
+class ManifestNotifierTest : public ::testing::Test {
+ protected:
+  CoordinatorServer server_;
+
+  void SetUp() override {
+    CoordinatorServer::Options options;
+    options.spec.security =
+        ::tensorstore::internal_ocdbt::GetInsecureRpcSecurityMethod();
+    options.spec.bind_addresses.push_back("localhost:0");
+    TENSORSTORE_CHECK_OK_AND_ASSIGN(
+        server_, CoordinatorServer::Start(std::move(options)));
+  }
+
+  ManifestNotifier::Ptr MakeNotifier(std::string storage_identifier) {
+    CoordinatorManifestNotifierOptions options;
+    options.coordinator_address =
+        tensorstore::StrCat("localhost:", server_.port());
+    options.security =
+        ::tensorstore::internal_ocdbt::GetInsecureRpcSecurityMethod();
+    options.storage_identifier = std::move(storage_identifier);
+    return MakeCoordinatorManifestNotifier(std::move(options));
+  }
+};
+
+TEST_F(ManifestNotifierTest, Basic) {
+  auto a = MakeNotifier("db");
+  auto b = MakeNotifier("db");
+  auto other = MakeNotifier("other");
+
+  // Nothing has been published yet.
+  EXPECT_EQ(absl::InfinitePast(), b->GetUpToDateTime(1));
+
+  a->Publish(2);
+  ASSERT_TRUE(WaitUntilUpToDate(*b, 2));
+  EXPECT_EQ(absl::InfinitePast(), b->GetUpToDateTime(1));
+  ASSERT_TRUE(WaitUntilUpToDate(*a, 2));
+
+  b->Publish(3);
+  ASSERT_TRUE(WaitUntilUpToDate(*a, 3));
+  EXPECT_EQ(absl::InfinitePast(), a->GetUpToDateTime(2));
+
+  // Older generations are ignored.
+  a->Publish(1);
+  EXPECT_NE(absl::InfinitePast(), a->GetUpToDateTime(3));
+
+  // Notifications are specific to a database.
+  EXPECT_EQ(absl::InfinitePast(), other->GetUpToDateTime(3));
+}
+
+TEST_F(ManifestNotifierTest, WatchStartsAfterPublish) {
+  auto a = MakeNotifier("db");
+  a->Publish(5);
+  ASSERT_TRUE(WaitUntilUpToDate(*a, 5));
+
+  // A new watcher receives the generation already published.
+  auto b = MakeNotifier("db");
+  ASSERT_TRUE(WaitUntilUpToDate(*b, 5));
+  EXPECT_EQ(absl::InfinitePast(), b->GetUpToDateTime(4));
+}
+
+}  // namespace
@@ -50,10 +50,12 @@
 #include "tensorstore/kvstore/ocdbt/btree_writer.h"
 #include "tensorstore/kvstore/ocdbt/config.h"
 #include "tensorstore/kvstore/ocdbt/distributed/btree_writer.h"
+#include "tensorstore/kvstore/ocdbt/distributed/manifest_notifier.h"
 #include "tensorstore/kvstore/ocdbt/distributed/rpc_security.h"
 #include "tensorstore/kvstore/ocdbt/distributed/rpc_security_registry.h"
 #include "tensorstore/kvstore/ocdbt/format/manifest.h"
 #include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/io/indirect_data_writer.h"
 #include "tensorstore/kvstore/ocdbt/io/io_handle_impl.h"
 #include "tensorstore/kvstore/ocdbt/io_handle.h"
 #include "tensorstore/kvstore/ocdbt/non_distributed/btree_writer.h"
@@ -204,6 +206,22 @@ TENSORSTORE_DEFINE_JSON_DEFAULT_BINDER(
         jb::Member(
             "target_data_file_size",
             jb::Projection<&OcdbtDriverSpecData::target_data_file_size>()),
+        jb::Member("experimental_pending_data_files",
+                   jb::Projection<
+                       &OcdbtDriverSpecData::experimental_pending_data_files>(
+                       jb::Optional(jb::Integer<size_t>(1)))),
+        jb::Member(
+            "experimental_data_file_flush_duration",
+            jb::Projection<
+                &OcdbtDriverSpecData::experimental_data_file_flush_duration>()),
+        jb::Member("experimental_list_concurrency",
+                   jb::Projection<
+                       &OcdbtDriverSpecData::experimental_list_concurrency>(
+                       jb::Optional(jb::Integer<size_t>(1)))),
+        jb::Member(
+            "experimental_pinned_btree_bytes",
+            jb::Projection<
+                &OcdbtDriverSpecData::experimental_pinned_btree_bytes>()),
         jb::Member("coordinator",
                    jb::Projection<&OcdbtDriverSpecData::coordinator>()),
         jb::Member(internal::CachePoolResource::id,
@@ -263,6 +281,14 @@ Future<kvstore::DriverPtr> OcdbtDriverSpec::DoOpen() const {
         driver->experimental_read_coalescing_interval_ =
             spec->data_.experimental_read_coalescing_interval;
         driver->target_data_file_size_ = spec->data_.target_data_file_size;
+        driver->experimental_pending_data_files_ =
+            spec->data_.experimental_pending_data_files;
+        driver->experimental_data_file_flush_duration_ =
+            spec->data_.experimental_data_file_flush_duration;
+        driver->experimental_list_concurrency_ =
+            spec->data_.experimental_list_concurrency;
+        driver->experimental_pinned_btree_bytes_ =
+            spec->data_.experimental_pinned_btree_bytes;
         driver->version_spec_ = spec->data_.version_spec;
 
         std::optional<ReadCoalesceOptions> read_coalesce_options;
@@ -288,16 +314,55 @@ Future<kvstore::DriverPtr> OcdbtDriverSpec::DoOpen() const {
             ConfigState::Make(spec->data_.config, supported_manifest_features,
                               spec->data_.assume_config));
 
+        IndirectDataWriterOptions write_options;
+        write_options.target_size =
+            driver->target_data_file_size_.value_or(kDefaultTargetBufferSize);
+        write_options.max_pending_files =
+            driver->experimental_pending_data_files_.value_or(1);
+        write_options.target_flush_duration =
+            driver->experimental_data_file_flush_duration_.value_or(
+                absl::ZeroDuration());
+
+        driver->coordinator_ = spec->data_.coordinator;
+        const bool distributed =
+            driver->coordinator_->address && !driver->version_spec_;
+        auto security = driver->coordinator_->security;
+        if (!security) {
+          security = GetInsecureRpcSecurityMethod();
+        }
+
+        // Compute unique identifier for the base kvstore to use with
+        // coordinator.
+        std::string storage_identifier;
+        if (distributed) {
+          TENSORSTORE_ASSIGN_OR_RETURN(auto base_spec,
+                                       driver->base_.spec(MinimalSpec{}));
+          TENSORSTORE_ASSIGN_OR_RETURN(auto base_spec_json,
+                                       base_spec.ToJson());
+          storage_identifier = base_spec_json.dump();
+        }
+
+        ManifestNotifier::Ptr manifest_notifier;
+        if (distributed && driver->coordinator_->manifest_notifications) {
+          CoordinatorManifestNotifierOptions notifier_options;
+          notifier_options.coordinator_address =
+              *driver->coordinator_->address;
+          notifier_options.security = security;
+          notifier_options.storage_identifier = storage_identifier;
+          manifest_notifier =
+              MakeCoordinatorManifestNotifier(std::move(notifier_options));
+        }
+
         driver->io_handle_ = internal_ocdbt::MakeIoHandle(
             driver->data_copy_concurrency_, driver->cache_pool_->get(),
             driver->base_,
             driver->manifest_kvstore_.driver ? driver->manifest_kvstore_
                                              : driver->base_,
             std::move(config_state), driver->data_file_prefixes_,
-            driver->target_data_file_size_.value_or(kDefaultTargetBufferSize),
-            std::move(read_coalesce_options));
-        driver->coordinator_ = spec->data_.coordinator;
-        if (!driver->coordinator_->address || driver->version_spec_) {
+            write_options, std::move(read_coalesce_options),
+            std::move(manifest_notifier),
+            driver->experimental_pinned_btree_bytes_.value_or(0));
+        if (!distributed) {
           if (!driver->version_spec_) {
             driver->btree_writer_ =
                 MakeNonDistributedBtreeWriter(driver->io_handle_);
@@ -309,19 +374,10 @@ Future<kvstore::DriverPtr> OcdbtDriverSpec::DoOpen() const {
         DistributedBtreeWriterOptions options;
         options.io_handle = driver->io_handle_;
         options.coordinator_address = *driver->coordinator_->address;
-        options.security = driver->coordinator_->security;
-        if (!options.security) {
-          options.security = GetInsecureRpcSecurityMethod();
-        }
+        options.security = std::move(security);
         options.lease_duration = driver->coordinator_->lease_duration.value_or(
             kDefaultLeaseDuration);
-
-        // Compute unique identifier for the base kvstore to use with
-        // coordinator.
-        TENSORSTORE_ASSIGN_OR_RETURN(auto base_spec,
-                                     driver->base_.spec(MinimalSpec{}));
-        TENSORSTORE_ASSIGN_OR_RETURN(auto base_spec_json, base_spec.ToJson());
-        options.storage_identifier = base_spec_json.dump();
+        options.storage_identifier = std::move(storage_identifier);
         driver->btree_writer_ = MakeDistributedBtreeWriter(std::move(options));
         return driver;
       },
@@ -358,6 +414,11 @@ absl::Status OcdbtDriver::GetBoundSpecData(OcdbtDriverSpecData& spec) const {
   spec.experimental_read_coalescing_interval =
       experimental_read_coalescing_interval_;
   spec.target_data_file_size = target_data_file_size_;
+  spec.experimental_pending_data_files = experimental_pending_data_files_;
+  spec.experimental_data_file_flush_duration =
+      experimental_data_file_flush_duration_;
+  spec.experimental_list_concurrency = experimental_list_concurrency_;
+  spec.experimental_pinned_btree_bytes = experimental_pinned_btree_bytes_;
   spec.coordinator = coordinator_;
   spec.version_spec = version_spec_;
   return absl::Status();
@@ -380,7 +441,8 @@ void OcdbtDriver::ListImpl(kvstore::ListOptions options,
                            ListReceiver receiver) {
   ocdbt_metrics.list.Increment();
   return internal_ocdbt::NonDistributedList(
-      io_handle_, version_spec_, std::move(options), std::move(receiver));
+      io_handle_, version_spec_, std::move(options), std::move(receiver),
+      experimental_list_concurrency_.value_or(kDefaultListConcurrency));
 }
 
 namespace {
@@ -69,8 +69,10 @@ struct OcdbtCoordinatorResource
     std::optional<std::string> address;
     std::optional<absl::Duration> lease_duration;
     RpcSecurityMethod::Ptr security;
+    bool manifest_notifications = false;
     constexpr static auto ApplyMembers = [](auto&& x, auto f) {
-      return f(x.address, x.lease_duration, x.security);
+      return f(x.address, x.lease_duration, x.security,
+               x.manifest_notifications);
     };
   };
   using Resource = Spec;
@@ -88,6 +90,10 @@ struct OcdbtDriverSpecData {
   std::optional<size_t> experimental_read_coalescing_merged_bytes;
   std::optional<absl::Duration> experimental_read_coalescing_interval;
   std::optional<size_t> target_data_file_size;
+  std::optional<size_t> experimental_pending_data_files;
+  std::optional<absl::Duration> experimental_data_file_flush_duration;
+  std::optional<size_t> experimental_list_concurrency;
+  std::optional<size_t> experimental_pinned_btree_bytes;
   bool assume_config = false;
   Context::Resource<OcdbtCoordinatorResource> coordinator;
   std::optional<VersionSpec> version_spec;
@@ -103,7 +109,10 @@ struct OcdbtDriverSpecData {
              x.experimental_read_coalescing_threshold_bytes,
              x.experimental_read_coalescing_merged_bytes,
              x.experimental_read_coalescing_interval, x.target_data_file_size,
-             x.coordinator, x.version_spec);
+             x.experimental_pending_data_files,
+             x.experimental_data_file_flush_duration,
+             x.experimental_list_concurrency,
+             x.experimental_pinned_btree_bytes, x.coordinator, x.version_spec);
   };
 };
 
@@ -178,6 +187,10 @@ class OcdbtDriver
   std::optional<size_t> experimental_read_coalescing_merged_bytes_;
   std::optional<absl::Duration> experimental_read_coalescing_interval_;
   std::optional<size_t> target_data_file_size_;
+  std::optional<size_t> experimental_pending_data_files_;
+  std::optional<absl::Duration> experimental_data_file_flush_duration_;
+  std::optional<size_t> experimental_list_concurrency_;
+  std::optional<size_t> experimental_pinned_btree_bytes_;
   Context::Resource<OcdbtCoordinatorResource> coordinator_;
   std::optional<VersionSpec> version_spec_;
 };
@@ -60,6 +60,7 @@
 #include "tensorstore/util/future.h"
 #include "tensorstore/util/result.h"
 #include "tensorstore/util/status_testutil.h"
+#include "tensorstore/util/str_cat.h"
 
 namespace {
 
@@ -613,7 +614,8 @@ TENSORSTORE_GLOBAL_INITIALIZER {
   }
 
   for (const auto compression : std::initializer_list<Config::Compression>{
-           Config::NoCompression{}, Config::ZstdCompression{0}}) {
+           Config::NoCompression{}, Config::ZstdCompression{0},
+           Config::Lz4Compression{0}}) {
     ConfigConstraints config;
     config.max_decoded_node_bytes = 0;
     config.max_inline_value_bytes = 0;
@@ -628,6 +630,24 @@ TENSORSTORE_GLOBAL_INITIALIZER {
     register_test_suite(config);
   }
 
+  for (const auto max_decoded_node_bytes : {1, 1048576}) {
+    ConfigConstraints config;
+    config.max_decoded_node_bytes = max_decoded_node_bytes;
+    config.max_inline_value_bytes = 0;
+    config.btree_key_filter_bits_per_key = 10;
+    config.compression = Config::NoCompression{};
+    register_test_suite(config);
+  }
+
+  {
+    ConfigConstraints config;
+    config.max_decoded_node_bytes = 1;
+    config.version_tree_arity_log2 = 1;
+    config.btree_node_compression = Config::NoCompression{};
+    config.version_tree_node_compression = Config::ZstdCompression{3};
+    register_test_suite(config);
+  }
+
   {
     KeyValueStoreOpsTestParameters params;
     params.test_delete_range = false;
@@ -643,6 +663,10 @@ TENSORSTORE_GLOBAL_INITIALIZER {
           {"experimental_read_coalescing_merged_bytes", 2048},
           {"experimental_read_coalescing_interval", "10ms"},
           {"target_data_file_size", 1024},
+          {"experimental_pending_data_files", 4},
+          {"experimental_data_file_flush_duration", "1s"},
+          {"experimental_list_concurrency", 2},
+          {"experimental_pinned_btree_bytes", 4096},
       };
       TENSORSTORE_ASSERT_OK_AND_ASSIGN(
           auto store, tensorstore::kvstore::Open(json_spec).result());
@@ -653,6 +677,24 @@ TENSORSTORE_GLOBAL_INITIALIZER {
     };
     RegisterKeyValueStoreOpsTests(params);
   }
+
+  for (const auto list_concurrency : {1, 3}) {
+    KeyValueStoreOpsTestParameters params;
+    params.test_name =
+        tensorstore::StrCat("WithListConcurrency/", list_concurrency);
+    params.get_store = [list_concurrency](auto callback) {
+      TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+          auto store,
+          tensorstore::kvstore::Open(
+              {{"driver", "ocdbt"},
+               {"base", "memory://"},
+               {"config", {{"max_decoded_node_bytes", 1}}},
+               {"experimental_list_concurrency", list_concurrency}})
+              .result());
+      callback(store);
+    };
+    RegisterKeyValueStoreOpsTests(params);
+  }
 }
 
 // Tests that if a batch of writes leaves a node unmodified, it is not
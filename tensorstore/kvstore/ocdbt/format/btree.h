@@ -176,11 +176,18 @@ struct InteriorNodeEntryData {
   /// Reference to the child node.
   BtreeNodeReference node;
 
+  /// Encoded filter over the keys of the child node (see `key_filter.h`),
+  /// excluding the first `subtree_common_prefix_length` bytes of `key`.
+  ///
+  /// Only present for leaf children written while
+  /// `Config::btree_key_filter_bits_per_key` is non-zero; empty otherwise.
+  std::string key_filter;
+
   friend bool operator==(const InteriorNodeEntryData& a,
                          const InteriorNodeEntryData& b) {
     return a.key == b.key &&
            a.subtree_common_prefix_length == b.subtree_common_prefix_length &&
-           a.node == b.node;
+           a.node == b.node && a.key_filter == b.key_filter;
   }
   friend bool operator!=(const InteriorNodeEntryData& a,
                          const InteriorNodeEntryData& b) {
@@ -188,7 +195,7 @@ struct InteriorNodeEntryData {
   }
 
   constexpr static auto ApplyMembers = [](auto&& x, auto f) {
-    return f(x.key, x.subtree_common_prefix_length, x.node);
+    return f(x.key, x.subtree_common_prefix_length, x.node, x.key_filter);
   };
 };
 
@@ -275,7 +282,8 @@ inline size_t EstimateDecodedEntrySizeExcludingKey(const LeafNodeEntry& entry) {
 /// an interior node entry.
 inline size_t EstimateDecodedEntrySizeExcludingKey(
     const InteriorNodeEntry& entry) {
-  return kInteriorNodeFixedSize + entry.node.location.file_id.size();
+  return kInteriorNodeFixedSize + entry.node.location.file_id.size() +
+         entry.key_filter.size();
 }
 
 /// Validates that a b+tree node has the expected height and min key.
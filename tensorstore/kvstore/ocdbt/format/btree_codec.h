@@ -37,6 +37,7 @@
 #include "tensorstore/kvstore/ocdbt/format/data_file_id_codec.h"
 #include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
 #include "tensorstore/kvstore/ocdbt/format/indirect_data_reference_codec.h"
+#include "tensorstore/kvstore/ocdbt/format/key_filter.h"
 #include "tensorstore/util/status.h"
 
 namespace tensorstore {
@@ -44,6 +45,9 @@ namespace internal_ocdbt {
 
 constexpr uint32_t kBtreeNodeMagic = 0x0cdb20de;
 constexpr uint8_t kBtreeNodeFormatVersion = 0;
+/// Format version of interior nodes that include the key filter column.  Nodes
+/// without any key filters are written with `kBtreeNodeFormatVersion`.
+constexpr uint8_t kBtreeNodeFormatVersionWithKeyFilters = 1;
 constexpr size_t kMaxNodeArity = 1024 * 1024;
 
 using NumIndirectValueBytesCodec = VarintCodec<uint64_t>;
@@ -78,6 +82,51 @@ struct BtreeNodeStatisticsArrayCodec {
 template <typename Getter>
 BtreeNodeStatisticsArrayCodec(Getter) -> BtreeNodeStatisticsArrayCodec<Getter>;
 
+/// Upper bound on the size of a key filter over the keys of a single leaf node.
+constexpr uint32_t kMaxDecodedKeyFilterBytes =
+    kMaxKeyFilterBitsPerKey * (kMaxNodeArity / 8) + 1;
+
+/// Codec for the `key_filter` column of interior nodes: the lengths of all
+/// filters, followed by the concatenated filters.
+template <typename Getter>
+struct KeyFilterArrayCodec {
+  Getter getter;
+  template <typename IO, typename Vec>
+  [[nodiscard]] bool operator()(IO& io, Vec&& vec) const {
+    static_assert(std::is_same_v<IO, riegeli::Reader> ||
+                  std::is_same_v<IO, riegeli::Writer>);
+    if constexpr (std::is_same_v<IO, riegeli::Reader>) {
+      std::vector<uint32_t> lengths(vec.size());
+      for (auto& length : lengths) {
+        if (!VarintCodec<uint32_t>{}(io, length)) return false;
+        if (length > kMaxDecodedKeyFilterBytes) {
+          io.Fail(absl::DataLossError(absl::StrFormat(
+              "Key filter length %d exceeds limit of %d", length,
+              kMaxDecodedKeyFilterBytes)));
+          return false;
+        }
+      }
+      for (size_t i = 0; i < vec.size(); ++i) {
+        if (!io.Read(lengths[i], getter(vec[i]))) return false;
+      }
+    } else {
+      for (auto& entry : vec) {
+        if (!VarintCodec<uint32_t>{}(
+                io, static_cast<uint32_t>(getter(entry).size()))) {
+          return false;
+        }
+      }
+      for (auto& entry : vec) {
+        if (!io.Write(getter(entry))) return false;
+      }
+    }
+    return true;
+  }
+};
+
+template <typename Getter>
+KeyFilterArrayCodec(Getter) -> KeyFilterArrayCodec<Getter>;
+
 using KeyLengthCodec = VarintCodec<KeyLength>;
 
 template <typename DataFileTable, typename Getter>
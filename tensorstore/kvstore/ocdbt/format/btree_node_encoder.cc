@@ -41,6 +41,7 @@
 #include "tensorstore/kvstore/ocdbt/format/config.h"
 #include "tensorstore/kvstore/ocdbt/format/data_file_id_codec.h"
 #include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
+#include "tensorstore/kvstore/ocdbt/format/key_filter.h"
 #include "tensorstore/util/division.h"
 #include "tensorstore/util/quote_string.h"
 #include "tensorstore/util/result.h"
@@ -191,12 +192,31 @@ void BtreeNodeEncoder<Entry>::AddEntry(bool existing, Entry&& entry) {
 }
 
 namespace {
+// Computes the filter over the keys of a leaf node, relative to the subtree
+// prefix of length `info.excluded_prefix_length`.
+std::string EncodeKeyFilter(
+    uint8_t bits_per_key, std::string_view existing_prefix,
+    span<typename BtreeNodeEncoder<LeafNodeEntry>::BufferedEntry> entries,
+    const EncodedNodeInfo& info) {
+  KeyFilterBuilder builder(bits_per_key);
+  std::string full_key;
+  for (const auto& e : entries) {
+    full_key.clear();
+    tensorstore::StrAppend(&full_key,
+                           e.existing ? existing_prefix : std::string_view(),
+                           e.entry.key);
+    builder.AddKey(
+        std::string_view(full_key).substr(info.excluded_prefix_length));
+  }
+  return builder.Finalize();
+}
+
 template <typename Entry>
 bool EncodeEntriesInner(
-    riegeli::Writer& writer, BtreeNodeHeight height,
+    riegeli::Writer& writer, const Config& config, BtreeNodeHeight height,
     std::string_view existing_prefix,
     span<typename BtreeNodeEncoder<Entry>::BufferedEntry> entries, bool is_root,
-    EncodedNodeInfo& info) {
+    bool write_key_filters, EncodedNodeInfo& info) {
   info.statistics = {};
 
   if constexpr (std::is_same_v<Entry, LeafNodeEntry>) {
@@ -274,6 +294,11 @@ bool EncodeEntriesInner(
   }
 
   if constexpr (std::is_same_v<Entry, LeafNodeEntry>) {
+    if (config.btree_key_filter_bits_per_key != 0 && !is_root) {
+      info.key_filter =
+          EncodeKeyFilter(config.btree_key_filter_bits_per_key,
+                          existing_prefix, entries, info);
+    }
     if (!LeafNodeValueReferenceArrayCodec{data_file_table,
                                           [](auto& e) -> decltype(auto) {
                                             return (e.entry.value_reference);
@@ -295,6 +320,12 @@ bool EncodeEntriesInner(
                                       }}(writer, entries)) {
       return false;
     }
+    if (write_key_filters &&
+        !KeyFilterArrayCodec{[](auto& e) -> decltype(auto) {
+          return (e.entry.key_filter);
+        }}(writer, entries)) {
+      return false;
+    }
   }
   return true;
 }
@@ -307,13 +338,24 @@ Result<EncodedNode> EncodeEntries(
     span<typename BtreeNodeEncoder<Entry>::BufferedEntry> entries,
     bool is_root) {
   EncodedNode encoded;
+  // The key filter column is only written, using the newer format version, if
+  // at least one child has a filter.
+  bool write_key_filters = false;
+  if constexpr (std::is_same_v<Entry, InteriorNodeEntry>) {
+    write_key_filters = std::any_of(
+        entries.begin(), entries.end(),
+        [](const auto& e) { return !e.entry.key_filter.empty(); });
+  }
   auto result = EncodeWithOptionalCompression(
-      config, kBtreeNodeMagic, kBtreeNodeFormatVersion,
+      config.GetBtreeNodeCompression(), kBtreeNodeMagic,
+      write_key_filters ? kBtreeNodeFormatVersionWithKeyFilters
+                        : kBtreeNodeFormatVersion,
       [&](riegeli::Writer& writer) -> bool {
         // height
         if (!writer.WriteByte(height)) return false;
-        return EncodeEntriesInner<Entry>(writer, height, existing_prefix,
-                                         entries, is_root, encoded.info);
+        return EncodeEntriesInner<Entry>(writer, config, height,
+                                         existing_prefix, entries, is_root,
+                                         write_key_filters, encoded.info);
       });
   TENSORSTORE_ASSIGN_OR_RETURN(
       encoded.encoded_node, std::move(result),
@@ -398,6 +440,7 @@ void AddNewInteriorEntry(BtreeNodeEncoder<InteriorNodeEntry>& encoder,
   new_entry.key = entry.key;
   new_entry.subtree_common_prefix_length = entry.subtree_common_prefix_length;
   new_entry.node = entry.node;
+  new_entry.key_filter = entry.key_filter;
   encoder.AddEntry(/*existing=*/false, std::move(new_entry));
 }
 
@@ -37,6 +37,11 @@ struct EncodedNodeInfo {
 
   /// Statistics for the encoded node.
   BtreeNodeStatistics statistics;
+
+  /// Filter over the keys of an encoded leaf node, excluding the first
+  /// `excluded_prefix_length` bytes, to be stored in the parent entry.  Empty
+  /// if `Config::btree_key_filter_bits_per_key` is `0`.
+  std::string key_filter;
 };
 
 /// Encoded b+tree node, generated by `BtreeNodeEncoder`.
@@ -33,6 +33,7 @@
 #include "tensorstore/kvstore/ocdbt/format/btree_node_encoder.h"
 #include "tensorstore/kvstore/ocdbt/format/codec_util.h"
 #include "tensorstore/kvstore/ocdbt/format/config.h"
+#include "tensorstore/kvstore/ocdbt/format/key_filter.h"
 #include "tensorstore/util/quote_string.h"
 #include "tensorstore/util/status_testutil.h"
 #include "tensorstore/util/str_cat.h"
@@ -47,6 +48,7 @@ using ::tensorstore::internal_ocdbt::Config;
 using ::tensorstore::internal_ocdbt::DecodeBtreeNode;
 using ::tensorstore::internal_ocdbt::EncodedNode;
 using ::tensorstore::internal_ocdbt::InteriorNodeEntry;
+using ::tensorstore::internal_ocdbt::KeyFilterMayContain;
 using ::tensorstore::internal_ocdbt::kMaxNodeArity;
 using ::tensorstore::internal_ocdbt::LeafNodeEntry;
 
@@ -143,6 +145,58 @@ TEST(BtreeNodeTest, InteriorNodeRoundTrip) {
   TestBtreeNodeRoundTrip(config, node);
 }
 
+TEST(BtreeNodeTest, InteriorNodeWithKeyFiltersRoundTrip) {
+  Config config;
+  BtreeNode node;
+  node.height = 1;
+  auto& entries = node.entries.emplace<BtreeNode::InteriorNodeEntries>();
+  {
+    InteriorNodeEntry entry;
+    entry.key = "abc";
+    entry.subtree_common_prefix_length = 1;
+    entry.node.location.file_id.relative_path = "def";
+    entry.node.location.offset = 5;
+    entry.node.location.length = 6;
+    entry.node.statistics.num_keys = 5;
+    entry.key_filter = "filter1";
+    entries.push_back(entry);
+  }
+  {
+    // Entries without a filter may be mixed with entries with a filter.
+    InteriorNodeEntry entry;
+    entry.key = "def";
+    entry.subtree_common_prefix_length = 1;
+    entry.node.location.file_id.relative_path = "def1";
+    entry.node.location.offset = 42;
+    entry.node.location.length = 9;
+    entry.node.statistics.num_keys = 8;
+    entries.push_back(entry);
+  }
+  TestBtreeNodeRoundTrip(config, node);
+}
+
+TEST(BtreeNodeTest, LeafNodeKeyFilter) {
+  Config config;
+  config.btree_key_filter_bits_per_key = 10;
+  BtreeNodeEncoder<LeafNodeEntry> encoder(config, /*height=*/0,
+                                          /*existing_prefix=*/"ab");
+  for (std::string_view key : {"c", "d", "e"}) {
+    encoder.AddEntry(/*existing=*/true,
+                     LeafNodeEntry{key, absl::Cord("value")});
+  }
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto encoded_nodes,
+                                   encoder.Finalize(/*may_be_root=*/false));
+  ASSERT_EQ(1, encoded_nodes.size());
+  const auto& info = encoded_nodes[0].info;
+  ASSERT_FALSE(info.key_filter.empty());
+  // Keys are relative to the prefix excluded from the parent entry.
+  for (std::string_view key : {"abc", "abd", "abe"}) {
+    EXPECT_TRUE(KeyFilterMayContain(
+        info.key_filter, key.substr(info.excluded_prefix_length)))
+        << key;
+  }
+}
+
 TEST(BtreeNodeTest, InteriorNodeBasePath) {
   Config config;
   BtreeNode node;
@@ -224,7 +278,7 @@ absl::Cord EncodeRawBtree(const std::vector<unsigned char>& data) {
   Config config;
   config.compression = Config::NoCompression{};
   return EncodeWithOptionalCompression(
-             config, kBtreeNodeMagic, kBtreeNodeFormatVersion,
+             config.compression, kBtreeNodeMagic, kBtreeNodeFormatVersion,
              [&](riegeli::Writer& writer) -> bool {
                return writer.Write(std::string_view(
                    reinterpret_cast<const char*>(data.data()), data.size()));
@@ -39,6 +39,8 @@
 #include "riegeli/digests/digesting_writer.h"
 #include "riegeli/endian/endian_reading.h"
 #include "riegeli/endian/endian_writing.h"
+#include "riegeli/lz4/lz4_reader.h"
+#include "riegeli/lz4/lz4_writer.h"
 #include "riegeli/varint/varint_reading.h"
 #include "riegeli/varint/varint_writing.h"
 #include "riegeli/zstd/zstd_reader.h"
@@ -161,6 +163,15 @@ absl::Status DecodeWithOptionalCompression(
         }
         break;
       }
+      case 2: {
+        riegeli::Lz4Reader lz4_reader(&digesting_reader);
+        success = decode_decompressed(lz4_reader, version) &&
+                  lz4_reader.VerifyEndAndClose();
+        if (!success && !lz4_reader.ok()) {
+          digesting_reader.Fail(lz4_reader.status());
+        }
+        break;
+      }
       default:
         digesting_reader.Fail(absl::DataLossError(absl::StrFormat(
             "Unsupported compression format: %d", compression_format)));
@@ -185,7 +196,8 @@ absl::Status DecodeWithOptionalCompression(
 }
 
 Result<absl::Cord> EncodeWithOptionalCompression(
-    const Config& config, uint32_t magic, uint32_t version_number,
+    const Config::Compression& compression, uint32_t magic,
+    uint32_t version_number,
     absl::FunctionRef<bool(riegeli::Writer& writer)> encode) {
   absl::Cord encoded;
   riegeli::CordWriter writer(&encoded);
@@ -200,13 +212,24 @@ Result<absl::Cord> EncodeWithOptionalCompression(
     riegeli::DigestingWriter digesting_writer(&writer,
                                               riegeli::Crc32cDigester());
     if (!riegeli::WriteVarint32(version_number, digesting_writer)) return false;
-    if (std::holds_alternative<Config::NoCompression>(config.compression)) {
+    if (std::holds_alternative<Config::NoCompression>(compression)) {
       if (!riegeli::WriteVarint32(0, digesting_writer)) return false;
       if (!encode(digesting_writer)) return false;
+    } else if (const auto* lz4_config =
+                   std::get_if<Config::Lz4Compression>(&compression)) {
+      if (!riegeli::WriteVarint32(2, digesting_writer)) return false;
+      riegeli::Lz4Writer lz4_writer(
+          &digesting_writer,
+          riegeli::Lz4WriterBase::Options().set_compression_level(
+              lz4_config->level));
+      if (!encode(lz4_writer) || !lz4_writer.Close()) {
+        digesting_writer.Fail(lz4_writer.status());
+        return false;
+      }
     } else {
       if (!riegeli::WriteVarint32(1, digesting_writer)) return false;
       const auto& zstd_config =
-          std::get<Config::ZstdCompression>(config.compression);
+          std::get<Config::ZstdCompression>(compression);
       riegeli::ZstdWriter zstd_writer(
           &digesting_writer,
           riegeli::ZstdWriterBase::Options().set_compression_level(
@@ -140,12 +140,13 @@ absl::Status DecodeWithOptionalCompression(
 
 /// Encodes with the common compression header.
 ///
-/// \param config Configuration specify compression options.
+/// \param compression Compression options.
 /// \param magic Magic number to include at start of header.
 /// \param version_number Version number to include in header.
 /// \param encode Callback to be invoked to encode the uncompressed body.
 Result<absl::Cord> EncodeWithOptionalCompression(
-    const Config& config, uint32_t magic, uint32_t version_number,
+    const Config::Compression& compression, uint32_t magic,
+    uint32_t version_number,
     absl::FunctionRef<bool(riegeli::Writer& writer)> encode);
 
 /// Closes `reader`, verifying that the end has been reached and
@@ -63,6 +63,14 @@ std::ostream& operator<<(std::ostream& os, Config::ZstdCompression x) {
   return os << "zstd{level=" << x.level << "}";
 }
 
+bool operator==(Config::Lz4Compression a, Config::Lz4Compression b) {
+  return a.level == b.level;
+}
+
+std::ostream& operator<<(std::ostream& os, Config::Lz4Compression x) {
+  return os << "lz4{level=" << x.level << "}";
+}
+
 std::ostream& operator<<(std::ostream& os, const Config::Compression& x) {
   std::visit([&](const auto& v) { os << v; }, x);
   return os;
@@ -73,7 +81,10 @@ bool operator==(const Config& a, const Config& b) {
          a.max_inline_value_bytes == b.max_inline_value_bytes &&
          a.max_decoded_node_bytes == b.max_decoded_node_bytes &&
          a.version_tree_arity_log2 == b.version_tree_arity_log2 &&
-         a.compression == b.compression;
+         a.compression == b.compression &&
+         a.btree_key_filter_bits_per_key == b.btree_key_filter_bits_per_key &&
+         a.btree_node_compression == b.btree_node_compression &&
+         a.version_tree_node_compression == b.version_tree_node_compression;
 }
 
 std::ostream& operator<<(std::ostream& os, const Config& x) {
@@ -82,7 +93,17 @@ std::ostream& operator<<(std::ostream& os, const Config& x) {
             << ", max_decoded_node_bytes=" << x.max_decoded_node_bytes
             << ", version_tree_arity_log2="
             << static_cast<int>(x.version_tree_arity_log2)
-            << ", compression=" << x.compression << "}";
+            << ", compression=" << x.compression
+            << ", btree_key_filter_bits_per_key="
+            << static_cast<int>(x.btree_key_filter_bits_per_key);
+  if (x.btree_node_compression) {
+    os << ", btree_node_compression=" << *x.btree_node_compression;
+  }
+  if (x.version_tree_node_compression) {
+    os << ", version_tree_node_compression="
+       << *x.version_tree_node_compression;
+  }
+  return os << "}";
 }
 
 }  // namespace internal_ocdbt
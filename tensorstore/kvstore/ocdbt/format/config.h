@@ -19,6 +19,7 @@
 
 #include <array>
 #include <iosfwd>
+#include <optional>
 #include <variant>
 
 #include "tensorstore/util/apply_members/std_array.h"
@@ -92,12 +93,60 @@ struct Config {
     };
   };
 
+  struct Lz4Compression {
+    int32_t level;
+    friend bool operator==(Lz4Compression a, Lz4Compression b);
+    friend bool operator!=(Lz4Compression a, Lz4Compression b) {
+      return !(a == b);
+    }
+    friend std::ostream& operator<<(std::ostream& os, Lz4Compression x);
+
+    constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+      return f(x.level);
+    };
+  };
+
   /// Encoded as:
   ///   0 -> no compression
   ///   1 -> zstd
-  using Compression = std::variant<NoCompression, ZstdCompression>;
+  ///   2 -> lz4
+  using Compression =
+      std::variant<NoCompression, ZstdCompression, Lz4Compression>;
   Compression compression = ZstdCompression{0};
 
+  /// Number of bits per key of the filter over the keys of each leaf node that
+  /// is stored in the parent node (see `key_filter.h`), or `0` if filters are
+  /// not written.
+  ///
+  /// Only representable by manifest format version 1.
+  uint8_t btree_key_filter_bits_per_key = 0;
+
+  /// Compression used for B+tree nodes, if different from `compression`.
+  ///
+  /// B+tree nodes are fetched on every read, and those containing only small
+  /// keys and inline values may benefit from a different trade-off between
+  /// size and decoding cost than other data.
+  ///
+  /// Only representable by manifest format version 2.
+  std::optional<Compression> btree_node_compression;
+
+  /// Compression used for version tree nodes, if different from
+  /// `compression`.
+  ///
+  /// Only representable by manifest format version 2.
+  std::optional<Compression> version_tree_node_compression;
+
+  /// Returns the compression used for B+tree nodes.
+  const Compression& GetBtreeNodeCompression() const {
+    return btree_node_compression ? *btree_node_compression : compression;
+  }
+
+  /// Returns the compression used for version tree nodes.
+  const Compression& GetVersionTreeNodeCompression() const {
+    return version_tree_node_compression ? *version_tree_node_compression
+                                         : compression;
+  }
+
   friend std::ostream& operator<<(std::ostream& os, const Compression& x);
   friend bool operator==(const Config& a, const Config& b);
   friend bool operator!=(const Config& a, const Config& b) { return !(a == b); }
@@ -17,15 +17,18 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <optional>
 #include <variant>
 
 #include "absl/status/status.h"
 #include "absl/strings/str_format.h"
 #include "riegeli/bytes/reader.h"
 #include "riegeli/bytes/writer.h"
+#include "riegeli/lz4/lz4_writer.h"
 #include "riegeli/zstd/zstd_writer.h"
 #include "tensorstore/kvstore/ocdbt/format/codec_util.h"
 #include "tensorstore/kvstore/ocdbt/format/config.h"
+#include "tensorstore/kvstore/ocdbt/format/key_filter.h"
 
 namespace tensorstore {
 namespace internal_ocdbt {
@@ -51,6 +54,26 @@ struct ZstdCompressionOptionsCodec {
   }
 };
 
+struct Lz4CompressionOptionsCodec {
+  template <typename IO, typename T>
+  [[nodiscard]] bool operator()(IO& io, T&& value) const {
+    static_assert(std::is_same_v<IO, riegeli::Reader> ||
+                  std::is_same_v<IO, riegeli::Writer>);
+    if (!LittleEndianCodec<int32_t>{}(io, value.level)) return false;
+    if constexpr (std::is_same_v<IO, riegeli::Reader>) {
+      using Options = riegeli::Lz4WriterBase::Options;
+      if (value.level < Options::kMinCompressionLevel ||
+          value.level > Options::kMaxCompressionLevel) {
+        io.Fail(absl::InvalidArgumentError(absl::StrFormat(
+            "Lz4 compression level %d is outside valid range [%d, %d]",
+            value.level, Options::kMinCompressionLevel,
+            Options::kMaxCompressionLevel)));
+      }
+    }
+    return true;
+  }
+};
+
 using CompressionMethodCodec = VarintCodec<uint32_t>;
 }  // namespace
 
@@ -68,6 +91,12 @@ bool CompressionConfigCodec::operator()(riegeli::Reader& reader,
         return false;
       }
       break;
+    case 2:
+      if (!Lz4CompressionOptionsCodec{}(
+              reader, value.emplace<Config::Lz4Compression>())) {
+        return false;
+      }
+      break;
     default:
       reader.Fail(absl::InvalidArgumentError(absl::StrFormat(
           "Invalid compression method: %d", compression_method)));
@@ -82,16 +111,45 @@ bool CompressionConfigCodec::operator()(
     if (!CompressionMethodCodec{}(writer, 0)) {
       return false;
     }
-  } else {
+  } else if (const auto* zstd = std::get_if<Config::ZstdCompression>(&value)) {
     if (!CompressionMethodCodec{}(writer, 1) ||
-        !ZstdCompressionOptionsCodec{}(
-            writer, std::get<Config::ZstdCompression>(value))) {
+        !ZstdCompressionOptionsCodec{}(writer, *zstd)) {
+      return false;
+    }
+  } else {
+    if (!CompressionMethodCodec{}(writer, 2) ||
+        !Lz4CompressionOptionsCodec{}(
+            writer, std::get<Config::Lz4Compression>(value))) {
       return false;
     }
   }
   return true;
 }
 
+bool OptionalCompressionConfigCodec::operator()(
+    riegeli::Reader& reader, std::optional<Config::Compression>& value) const {
+  uint8_t present;
+  if (!reader.ReadByte(present)) return false;
+  switch (present) {
+    case 0:
+      value = std::nullopt;
+      return true;
+    case 1:
+      return CompressionConfigCodec{}(reader, value.emplace());
+    default:
+      reader.Fail(absl::DataLossError(
+          absl::StrFormat("Invalid optional compression marker: %d", present)));
+      return false;
+  }
+}
+
+bool OptionalCompressionConfigCodec::operator()(
+    riegeli::Writer& writer,
+    const std::optional<Config::Compression>& value) const {
+  if (!value) return writer.WriteByte(0);
+  return writer.WriteByte(1) && CompressionConfigCodec{}(writer, *value);
+}
+
 bool ManifestKindCodec::operator()(riegeli::Reader& reader,
                                    ManifestKind& value) const {
   uint8_t manifest_kind;
@@ -105,5 +163,16 @@ bool ManifestKindCodec::operator()(riegeli::Reader& reader,
   return true;
 }
 
+bool KeyFilterBitsPerKeyCodec::operator()(riegeli::Reader& reader,
+                                          uint8_t& value) const {
+  if (!reader.ReadByte(value)) return false;
+  if (value > kMaxKeyFilterBitsPerKey) {
+    reader.Fail(absl::DataLossError(absl::StrFormat(
+        "Invalid btree_key_filter_bits_per_key %d", value)));
+    return false;
+  }
+  return true;
+}
+
 }  // namespace internal_ocdbt
 }  // namespace tensorstore
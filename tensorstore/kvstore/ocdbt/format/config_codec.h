@@ -21,6 +21,8 @@
 
 #include <stdint.h>
 
+#include <optional>
+
 #include "riegeli/bytes/reader.h"
 #include "riegeli/bytes/writer.h"
 #include "tensorstore/kvstore/ocdbt/format/codec_util.h"
@@ -52,7 +54,42 @@ struct ManifestKindCodec {
   }
 };
 
+struct KeyFilterBitsPerKeyCodec {
+  [[nodiscard]] bool operator()(riegeli::Reader& reader, uint8_t& value) const;
+
+  [[nodiscard]] bool operator()(riegeli::Writer& writer, uint8_t value) const {
+    return writer.WriteByte(value);
+  }
+};
+
+/// Codec for a compression config that defaults to `Config::compression`.
+///
+/// Encoded as a byte `0` if unspecified, or as a byte `1` followed by the
+/// `CompressionConfigCodec` encoding.
+struct OptionalCompressionConfigCodec {
+  [[nodiscard]] bool operator()(
+      riegeli::Reader& reader, std::optional<Config::Compression>& value) const;
+
+  [[nodiscard]] bool operator()(
+      riegeli::Writer& writer,
+      const std::optional<Config::Compression>& value) const;
+};
+
+/// Returns the manifest format version required to represent `config`.
+///
+/// Version 0 is used when possible, so that databases that do not use any
+/// newer features remain readable by older versions of this library.
+inline uint32_t GetManifestFormatVersion(const Config& config) {
+  if (config.btree_node_compression || config.version_tree_node_compression) {
+    return 2;
+  }
+  return config.btree_key_filter_bits_per_key != 0 ? 1 : 0;
+}
+
 struct ConfigCodec {
+  /// Format version of the containing manifest.
+  uint32_t version;
+
   template <typename IO, typename T>
   [[nodiscard]] bool operator()(IO& io, T&& value) const {
     return UuidCodec{}(io, value.uuid) &&
@@ -60,7 +97,14 @@ struct ConfigCodec {
            MaxInlineValueBytesCodec{}(io, value.max_inline_value_bytes) &&
            MaxDecodedNodeBytesCodec{}(io, value.max_decoded_node_bytes) &&
            VersionTreeArityLog2Codec{}(io, value.version_tree_arity_log2) &&
-           CompressionConfigCodec{}(io, value.compression);
+           CompressionConfigCodec{}(io, value.compression) &&
+           (version < 1 || KeyFilterBitsPerKeyCodec{}(
+                               io, value.btree_key_filter_bits_per_key)) &&
+           (version < 2 ||
+            (OptionalCompressionConfigCodec{}(io,
+                                              value.btree_node_compression) &&
+             OptionalCompressionConfigCodec{}(
+                 io, value.version_tree_node_compression)));
   }
 };
 
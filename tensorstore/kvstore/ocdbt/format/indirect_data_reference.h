@@ -21,6 +21,7 @@
 #include <limits>
 #include <string>
 #include <string_view>
+#include <utility>
 
 #include "absl/status/status.h"
 #include "tensorstore/internal/meta/type_traits.h"
@@ -93,6 +94,11 @@ struct IndirectDataReference {
     return !(a == b);
   }
 
+  template <typename H>
+  friend H AbslHashValue(H h, const IndirectDataReference& x) {
+    return H::combine(std::move(h), x.file_id, x.offset, x.length);
+  }
+
   /// Prints a debugging representation.
   friend std::ostream& operator<<(std::ostream& os,
                                   const IndirectDataReference& x);
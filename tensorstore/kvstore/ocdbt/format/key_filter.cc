@@ -0,0 +1,100 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/format/key_filter.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+#include "absl/crc/crc32c.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+namespace {
+
+// Filters with a larger number of probes are treated as invalid.
+constexpr uint8_t kMaxNumProbes = 30;
+
+// Minimum size of the bit array, to avoid a high false positive rate for small
+// leaf nodes.
+constexpr size_t kMinNumBits = 64;
+
+uint32_t HashKey(std::string_view key) {
+  uint32_t h = static_cast<uint32_t>(absl::ComputeCrc32c(key));
+  // CRC-32C is linear; apply the MurmurHash3 finalizer so that similar keys
+  // map to independent bits.
+  h ^= h >> 16;
+  h *= 0x85ebca6b;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35;
+  h ^= h >> 16;
+  return h;
+}
+
+uint32_t GetProbeDelta(uint32_t h) { return (h >> 17) | (h << 15); }
+
+}  // namespace
+
+KeyFilterBuilder::KeyFilterBuilder(uint8_t bits_per_key)
+    : bits_per_key_(bits_per_key) {}
+
+void KeyFilterBuilder::AddKey(std::string_view key) {
+  hashes_.push_back(HashKey(key));
+}
+
+std::string KeyFilterBuilder::Finalize() const {
+  if (hashes_.empty()) return {};
+  // The optimal number of probes is `bits_per_key * ln(2)`.
+  const uint8_t num_probes = static_cast<uint8_t>(
+      std::clamp<size_t>(bits_per_key_ * 69 / 100, 1, kMaxNumProbes));
+  size_t num_bits = std::max(kMinNumBits, hashes_.size() * bits_per_key_);
+  const size_t num_bytes = (num_bits + 7) / 8;
+  num_bits = num_bytes * 8;
+
+  std::string filter(num_bytes + 1, '\0');
+  for (uint32_t h : hashes_) {
+    const uint32_t delta = GetProbeDelta(h);
+    for (uint8_t i = 0; i < num_probes; ++i) {
+      const size_t bit = h % num_bits;
+      filter[bit / 8] |= static_cast<char>(1 << (bit % 8));
+      h += delta;
+    }
+  }
+  filter[num_bytes] = static_cast<char>(num_probes);
+  return filter;
+}
+
+bool KeyFilterMayContain(std::string_view filter, std::string_view key) {
+  if (filter.size() < 2) return true;
+  const uint8_t num_probes = static_cast<uint8_t>(filter.back());
+  if (num_probes == 0 || num_probes > kMaxNumProbes) return true;
+  const size_t num_bits = (filter.size() - 1) * 8;
+  uint32_t h = HashKey(key);
+  const uint32_t delta = GetProbeDelta(h);
+  for (uint8_t i = 0; i < num_probes; ++i) {
+    const size_t bit = h % num_bits;
+    if ((static_cast<uint8_t>(filter[bit / 8]) & (1 << (bit % 8))) == 0) {
+      return false;
+    }
+    h += delta;
+  }
+  return true;
+}
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
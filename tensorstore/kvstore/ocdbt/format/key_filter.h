@@ -0,0 +1,74 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_OCDBT_FORMAT_KEY_FILTER_H_
+#define TENSORSTORE_KVSTORE_OCDBT_FORMAT_KEY_FILTER_H_
+
+/// \file
+///
+/// Bloom filters over the keys of a B+tree leaf node.
+///
+/// If enabled by `Config::btree_key_filter_bits_per_key`, a filter over the
+/// keys of each leaf node is stored along with the reference to the leaf node
+/// in its parent interior node.  This allows a read of a missing key to
+/// terminate at the parent node without fetching the leaf node.
+///
+/// The encoded filter consists of the bit array followed by a single byte
+/// specifying the number of probes.  Keys are hashed with CRC-32C followed by
+/// the MurmurHash3 32-bit finalizer, and probe `i` tests bit
+/// `(h + i * delta) % num_bits`, where `h` is the hash and `delta` is `h`
+/// rotated right by 17 bits.
+
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tensorstore {
+namespace internal_ocdbt {
+
+/// Maximum value of `Config::btree_key_filter_bits_per_key`.
+constexpr uint8_t kMaxKeyFilterBitsPerKey = 32;
+
+/// Builds the encoded representation of a key filter.
+class KeyFilterBuilder {
+ public:
+  /// Constructs a builder for a filter using `bits_per_key` bits per key.
+  ///
+  /// \param bits_per_key Must be in `[1, kMaxKeyFilterBitsPerKey]`.
+  explicit KeyFilterBuilder(uint8_t bits_per_key);
+
+  /// Adds a key to the filter.
+  void AddKey(std::string_view key);
+
+  /// Returns the encoded filter, or an empty string if no keys were added.
+  std::string Finalize() const;
+
+ private:
+  uint8_t bits_per_key_;
+  std::vector<uint32_t> hashes_;
+};
+
+/// Returns `false` if `key` is definitely not among the keys of the encoded
+/// `filter`.
+///
+/// Returns `true` if `filter` is empty, which indicates that no filter is
+/// present, or cannot be interpreted.
+bool KeyFilterMayContain(std::string_view filter, std::string_view key);
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_OCDBT_FORMAT_KEY_FILTER_H_
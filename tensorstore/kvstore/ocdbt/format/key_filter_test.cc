@@ -0,0 +1,82 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/format/key_filter.h"
+
+#include <stddef.h>
+
+#include <string>
+
+#include <gtest/gtest.h>
+#include "absl/strings/str_format.h"
+
+namespace {
+
+using ::tensorstore::internal_ocdbt::KeyFilterBuilder;
+using ::tensorstore::internal_ocdbt::KeyFilterMayContain;
+
+TEST(KeyFilterTest, Empty) {
+  KeyFilterBuilder builder(10);
+  EXPECT_EQ("", builder.Finalize());
+  // An empty filter does not exclude any key.
+  EXPECT_TRUE(KeyFilterMayContain("", "a"));
+}
+
+TEST(KeyFilterTest, NoFalseNegatives) {
+  for (size_t num_keys : {1, 10, 1000}) {
+    KeyFilterBuilder builder(10);
+    for (size_t i = 0; i < num_keys; ++i) {
+      builder.AddKey(absl::StrFormat("key%d", i));
+    }
+    auto filter = builder.Finalize();
+    EXPECT_GE(filter.size(), 9);
+    for (size_t i = 0; i < num_keys; ++i) {
+      EXPECT_TRUE(KeyFilterMayContain(filter, absl::StrFormat("key%d", i)))
+          << i;
+    }
+  }
+}
+
+TEST(KeyFilterTest, FalsePositiveRate) {
+  KeyFilterBuilder builder(10);
+  for (size_t i = 0; i < 1000; ++i) {
+    builder.AddKey(absl::StrFormat("key%d", i));
+  }
+  auto filter = builder.Finalize();
+  size_t num_false_positives = 0;
+  for (size_t i = 0; i < 10000; ++i) {
+    num_false_positives +=
+        KeyFilterMayContain(filter, absl::StrFormat("missing%d", i));
+  }
+  // The expected rate with 10 bits per key is approximately 1%.
+  EXPECT_LT(num_false_positives, 300);
+}
+
+TEST(KeyFilterTest, Stable) {
+  // The encoded representation is part of the storage format.
+  KeyFilterBuilder builder(4);
+  builder.AddKey("a");
+  auto filter = builder.Finalize();
+  ASSERT_EQ(9, filter.size());
+  EXPECT_EQ(2, filter.back());
+  EXPECT_TRUE(KeyFilterMayContain(filter, "a"));
+}
+
+TEST(KeyFilterTest, Invalid) {
+  EXPECT_TRUE(KeyFilterMayContain("x", "a"));
+  EXPECT_TRUE(KeyFilterMayContain(std::string(8, '\0') + '\xff', "a"));
+  EXPECT_FALSE(KeyFilterMayContain(std::string(8, '\0') + '\x01', "a"));
+}
+
+}  // namespace
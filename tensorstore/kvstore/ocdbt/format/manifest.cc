@@ -45,7 +45,11 @@ namespace tensorstore {
 namespace internal_ocdbt {
 
 constexpr uint32_t kManifestMagic = 0x0cdb3a2a;
-constexpr uint8_t kManifestFormatVersion = 0;
+// Maximum supported format version.  Version 1 adds
+// `Config::btree_key_filter_bits_per_key`, and version 2 adds
+// `Config::btree_node_compression` and
+// `Config::version_tree_node_compression`.
+constexpr uint8_t kManifestFormatVersion = 2;
 
 void ForEachManifestVersionTreeNodeRef(
     GenerationNumber generation_number, uint8_t version_tree_arity_log2,
@@ -165,15 +169,16 @@ Result<absl::Cord> EncodeManifest(const Manifest& manifest,
 #ifndef NDEBUG
   CheckManifestInvariants(manifest, encode_as_single);
 #endif
+  const uint32_t version = GetManifestFormatVersion(manifest.config);
   return EncodeWithOptionalCompression(
-      manifest.config, kManifestMagic, kManifestFormatVersion,
+      manifest.config.compression, kManifestMagic, version,
       [&](riegeli::Writer& writer) -> bool {
         if (encode_as_single) {
           Config new_config = manifest.config;
           new_config.manifest_kind = ManifestKind::kSingle;
-          if (!ConfigCodec{}(writer, new_config)) return false;
+          if (!ConfigCodec{version}(writer, new_config)) return false;
         } else {
-          if (!ConfigCodec{}(writer, manifest.config)) return false;
+          if (!ConfigCodec{version}(writer, manifest.config)) return false;
           if (manifest.config.manifest_kind != ManifestKind::kSingle) {
             // This is a config-only manifest.
             return true;
@@ -205,7 +210,7 @@ Result<Manifest> DecodeManifest(const absl::Cord& encoded) {
   auto status = DecodeWithOptionalCompression(
       encoded, kManifestMagic, kManifestFormatVersion,
       [&](riegeli::Reader& reader, uint32_t version) -> bool {
-        if (!ConfigCodec{}(reader, manifest.config)) return false;
+        if (!ConfigCodec{version}(reader, manifest.config)) return false;
         if (manifest.config.manifest_kind != ManifestKind::kSingle) {
           // This is a config-only manifest.
           return true;
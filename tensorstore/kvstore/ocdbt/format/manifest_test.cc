@@ -14,6 +14,8 @@
 
 #include "tensorstore/kvstore/ocdbt/format/manifest.h"
 
+#include <optional>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/strings/str_format.h"
@@ -29,6 +31,7 @@ namespace {
 using ::tensorstore::MatchesStatus;
 using ::tensorstore::Result;
 using ::tensorstore::internal_ocdbt::CommitTime;
+using ::tensorstore::internal_ocdbt::Config;
 using ::tensorstore::internal_ocdbt::DecodeManifest;
 using ::tensorstore::internal_ocdbt::Manifest;
 
@@ -78,6 +81,29 @@ Manifest GetSimpleManifest() {
 
 TEST(ManifestTest, RoundTrip) { TestManifestRoundTrip(GetSimpleManifest()); }
 
+TEST(ManifestTest, RoundTripKeyFilter) {
+  auto manifest = GetSimpleManifest();
+  manifest.config.btree_key_filter_bits_per_key = 10;
+  TestManifestRoundTrip(manifest);
+}
+
+TEST(ManifestTest, RoundTripPerNodeKindCompression) {
+  auto manifest = GetSimpleManifest();
+  manifest.config.btree_node_compression = Config::NoCompression{};
+  manifest.config.version_tree_node_compression = Config::ZstdCompression{9};
+  TestManifestRoundTrip(manifest);
+  manifest.config.version_tree_node_compression = std::nullopt;
+  TestManifestRoundTrip(manifest);
+}
+
+TEST(ManifestTest, RoundTripLz4Compression) {
+  auto manifest = GetSimpleManifest();
+  manifest.config.compression = Config::Lz4Compression{0};
+  TestManifestRoundTrip(manifest);
+  manifest.config.btree_node_compression = Config::Lz4Compression{9};
+  TestManifestRoundTrip(manifest);
+}
+
 TEST(ManifestTest, RoundTripNonZeroHeight) {
   Manifest manifest;
   {
@@ -122,12 +148,12 @@ TEST(ManifestTest, InvalidVersion) {
   TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto encoded,
                                    EncodeManifest(GetSimpleManifest()));
   auto corrupt = encoded.Subcord(0, 12);
-  corrupt.Append(std::string(1, 1));
+  corrupt.Append(std::string(1, 3));
   corrupt.Append(encoded.Subcord(13, -1));
   EXPECT_THAT(
       DecodeManifest(corrupt),
       MatchesStatus(absl::StatusCode::kDataLoss,
-                    ".*: Maximum supported version is 0 but received: 1.*"));
+                    ".*: Maximum supported version is 2 but received: 3.*"));
 }
 
 TEST(ManifestTest, CorruptChecksum) {
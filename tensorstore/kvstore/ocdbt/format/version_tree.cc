@@ -205,7 +205,8 @@ Result<absl::Cord> EncodeVersionTreeNode(const Config& config,
   CheckVersionTreeNodeInvariants(node);
 #endif
   return EncodeWithOptionalCompression(
-      config, kVersionTreeNodeMagic, kVersionTreeNodeFormatVersion,
+      config.GetVersionTreeNodeCompression(), kVersionTreeNodeMagic,
+      kVersionTreeNodeFormatVersion,
       [&](riegeli::Writer& writer) -> bool {
         if (!VersionTreeArityLog2Codec{}(writer,
                                          node.version_tree_arity_log2) ||
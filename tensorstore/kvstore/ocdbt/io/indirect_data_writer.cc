@@ -16,15 +16,21 @@
 
 #include <stddef.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <limits>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/base/attributes.h"
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/log/verbose_flag.h"
 #include "tensorstore/internal/metrics/histogram.h"
@@ -55,36 +61,92 @@ ABSL_CONST_INIT internal_log::VerboseFlag ocdbt_logging("ocdbt");
 class IndirectDataWriter
     : public internal::AtomicReferenceCount<IndirectDataWriter> {
  public:
+  // State of a data file being buffered.
+  struct PendingFile {
+    absl::Mutex mutex_;
+
+    // Count of in-flight flush operations.
+    size_t in_flight_ = 0;
+
+    // Indicates that a flush was requested by a call to `Future::Force` on
+    // the future corresponding to `promise_` after the last flush started.
+    // Note that this may be set to true even while `in_flight_` is non-zero;
+    // in that case, another flush will be started as soon as the in-progress
+    // flush completes.
+    bool flush_requested_ = false;
+
+    // Buffer of writes not yet flushed.
+    absl::Cord buffer_;
+
+    // Promise corresponding to the writes buffered in `buffer_`.
+    Promise<void> promise_;
+
+    // Data file identifier to which `buffer_` will be written.
+    DataFileId data_file_id_;
+  };
+
   explicit IndirectDataWriter(kvstore::KvStore kvstore, std::string prefix,
-                              size_t target_size)
+                              const IndirectDataWriterOptions& options)
       : kvstore_(std::move(kvstore)),
         prefix_(std::move(prefix)),
-        target_size_(target_size) {}
+        options_(options),
+        pending_files_(std::max(size_t{1}, options.max_pending_files)) {
+    if (options_.target_flush_duration > absl::ZeroDuration()) {
+      min_target_size_ =
+          options_.target_size > 0
+              ? std::min(options_.target_size, kMinAdaptiveTargetSize)
+              : kMinAdaptiveTargetSize;
+      max_target_size_ = options_.target_size > 0
+                             ? options_.target_size
+                             : std::numeric_limits<size_t>::max();
+    } else {
+      min_target_size_ = max_target_size_ = options_.target_size;
+    }
+    target_size_ = min_target_size_;
+  }
 
-  // Treat as private:
-  kvstore::KvStore kvstore_;
-  std::string prefix_;
-  size_t target_size_;
-  absl::Mutex mutex_;
+  // Returns the pending data file to which the calling thread writes.
+  PendingFile& GetPendingFile() {
+    if (pending_files_.size() == 1) return pending_files_[0];
+    // Threads are numbered in the order of their first write, so that
+    // concurrent writers are spread evenly over the pending data files.
+    static std::atomic<size_t> next_thread_index{0};
+    thread_local const size_t thread_index = next_thread_index++;
+    return pending_files_[thread_index % pending_files_.size()];
+  }
 
-  // Count of in-flight flush operations.
-  size_t in_flight_ = 0;
+  // Adapts `target_size_` after a data file of `size` bytes, flushed once it
+  // reached the target size, took `duration` to write.
+  void AdaptTargetSize(size_t size, absl::Duration duration) {
+    if (min_target_size_ == max_target_size_) return;
+    // Limit each adjustment to a factor of 2 to damp the effect of outliers.
+    double scale = std::clamp(
+        absl::FDivDuration(options_.target_flush_duration,
+                           std::max(duration, absl::Nanoseconds(1))),
+        0.5, 2.0);
+    double target = std::clamp(static_cast<double>(size) * scale,
+                               static_cast<double>(min_target_size_),
+                               static_cast<double>(max_target_size_));
+    target_size_ = static_cast<size_t>(target);
+    ABSL_LOG_IF(INFO, ocdbt_logging)
+        << "Flushed " << size << " bytes in " << duration
+        << ", target size now " << target_size_.load();
+  }
 
-  // Indicates that a flush was requested by a call to `Future::Force` on the
-  // future corresponding to `promise_` after the last flush started.  Note that
-  // this may be set to true even while `flush_in_progress_` is true; in that
-  // case, another flush will be started as soon as the in-progress flush
-  // completes.
-  bool flush_requested_ = false;
+  // Minimum size of an adapted target size, unless `target_size` is smaller.
+  constexpr static size_t kMinAdaptiveTargetSize = 1024 * 1024;
 
-  // Buffer of writes not yet flushed.
-  absl::Cord buffer_;
+  // Treat as private:
+  kvstore::KvStore kvstore_;
+  std::string prefix_;
+  IndirectDataWriterOptions options_;
+  size_t min_target_size_;
+  size_t max_target_size_;
 
-  // Promise corresponding to the writes buffered in `buffer_`.
-  Promise<void> promise_;
+  // Current target size of each data file, or 0 if unlimited.
+  std::atomic<size_t> target_size_;
 
-  // Data file identifier to which `buffer_` will be written.
-  DataFileId data_file_id_;
+  std::vector<PendingFile> pending_files_;
 };
 
 void intrusive_ptr_increment(IndirectDataWriter* p) {
@@ -97,39 +159,46 @@ void intrusive_ptr_decrement(IndirectDataWriter* p) {
 }
 
 namespace {
-void MaybeFlush(IndirectDataWriter& self, UniqueWriterLock<absl::Mutex> lock) {
+using PendingFile = IndirectDataWriter::PendingFile;
+
+void MaybeFlush(IndirectDataWriter& self, PendingFile& file,
+                UniqueWriterLock<absl::Mutex> lock) {
+  const size_t target_size = self.target_size_;
   bool buffer_at_target =
-      self.target_size_ > 0 && self.buffer_.size() >= self.target_size_;
+      target_size > 0 && file.buffer_.size() >= target_size;
 
   ABSL_LOG_IF(INFO, ocdbt_logging)
-      << "MaybeFlush: flush_requested=" << self.flush_requested_
-      << ", in_flight=" << self.in_flight_
+      << "MaybeFlush: flush_requested=" << file.flush_requested_
+      << ", in_flight=" << file.in_flight_
       << ", buffer_at_target=" << buffer_at_target;
   if (buffer_at_target) {
     // Write a new buffer
-  } else if (!self.flush_requested_ || self.in_flight_ > 0) {
+  } else if (!file.flush_requested_ || file.in_flight_ > 0) {
     return;
   }
 
-  self.in_flight_++;
+  file.in_flight_++;
 
   // Clear the state
-  self.flush_requested_ = false;
-  Promise<void> promise = std::exchange(self.promise_, {});
-  absl::Cord buffer = std::exchange(self.buffer_, {});
-  DataFileId data_file_id = self.data_file_id_;
+  file.flush_requested_ = false;
+  Promise<void> promise = std::exchange(file.promise_, {});
+  absl::Cord buffer = std::exchange(file.buffer_, {});
+  DataFileId data_file_id = file.data_file_id_;
   lock.unlock();
 
-  indirect_data_writer_histogram.Observe(buffer.size());
+  const size_t size = buffer.size();
+  indirect_data_writer_histogram.Observe(size);
   ABSL_LOG_IF(INFO, ocdbt_logging)
-      << "Flushing " << buffer.size() << " bytes to " << data_file_id;
+      << "Flushing " << size << " bytes to " << data_file_id;
 
+  const absl::Time start_time = absl::Now();
   auto write_future =
       kvstore::Write(self.kvstore_, data_file_id.FullPath(), std::move(buffer));
   write_future.Force();
   write_future.ExecuteWhenReady(
       [promise = std::move(promise), data_file_id = std::move(data_file_id),
-       self = internal::IntrusivePtr<IndirectDataWriter>(&self)](
+       self = internal::IntrusivePtr<IndirectDataWriter>(&self), &file,
+       size, start_time, buffer_at_target](
           ReadyFuture<TimestampedStorageGeneration> future) {
         auto& r = future.result();
         ABSL_LOG_IF(INFO, ocdbt_logging)
@@ -141,15 +210,20 @@ void MaybeFlush(IndirectDataWriter& self, UniqueWriterLock<absl::Mutex> lock) {
           promise.SetResult(absl::UnavailableError("Non-unique file id"));
         } else {
           promise.SetResult(absl::OkStatus());
+          // Only data files that reached the target size are representative
+          // of the throughput at that size.
+          if (buffer_at_target) {
+            self->AdaptTargetSize(size, absl::Now() - start_time);
+          }
         }
-        UniqueWriterLock lock{self->mutex_};
-        assert(self->in_flight_ > 0);
-        self->in_flight_--;
+        UniqueWriterLock lock{file.mutex_};
+        assert(file.in_flight_ > 0);
+        file.in_flight_--;
         // Another flush may have been requested even while this flush was in
         // progress (for additional writes that were not included in the
         // just-completed flush).  Call `MaybeFlush` to see if another flush
         // needs to be started.
-        MaybeFlush(*self, std::move(lock));
+        MaybeFlush(*self, file, std::move(lock));
       });
 }
 
@@ -165,40 +239,51 @@ Future<const void> Write(IndirectDataWriter& self, absl::Cord data,
     ref.length = 0;
     return absl::OkStatus();
   }
-  UniqueWriterLock lock{self.mutex_};
+  PendingFile& file = self.GetPendingFile();
+  UniqueWriterLock lock{file.mutex_};
   Future<const void> future;
-  if (self.promise_.null() || (future = self.promise_.future()).null()) {
+  if (file.promise_.null() || (future = file.promise_.future()).null()) {
     // Create new data file.
-    self.data_file_id_ = GenerateDataFileId(self.prefix_);
+    file.data_file_id_ = GenerateDataFileId(self.prefix_);
     auto p = PromiseFuturePair<void>::Make();
-    self.promise_ = std::move(p.promise);
+    file.promise_ = std::move(p.promise);
     future = std::move(p.future);
-    self.promise_.ExecuteWhenForced(
-        [self = internal::IntrusivePtr<IndirectDataWriter>(&self)](
-            Promise<void> promise) {
+    file.promise_.ExecuteWhenForced(
+        [self = internal::IntrusivePtr<IndirectDataWriter>(&self),
+         &file](Promise<void> promise) {
           ABSL_LOG_IF(INFO, ocdbt_logging) << "Force called";
-          UniqueWriterLock lock{self->mutex_};
-          if (!HaveSameSharedState(promise, self->promise_)) return;
-          self->flush_requested_ = true;
-          MaybeFlush(*self, std::move(lock));
+          UniqueWriterLock lock{file.mutex_};
+          if (!HaveSameSharedState(promise, file.promise_)) return;
+          file.flush_requested_ = true;
+          MaybeFlush(*self, file, std::move(lock));
         });
   }
-  ref.file_id = self.data_file_id_;
-  ref.offset = self.buffer_.size();
+  ref.file_id = file.data_file_id_;
+  ref.offset = file.buffer_.size();
   ref.length = data.size();
-  self.buffer_.Append(std::move(data));
+  file.buffer_.Append(std::move(data));
 
-  if (self.target_size_ > 0 && self.buffer_.size() >= self.target_size_) {
-    MaybeFlush(self, std::move(lock));
+  const size_t target_size = self.target_size_;
+  if (target_size > 0 && file.buffer_.size() >= target_size) {
+    MaybeFlush(self, file, std::move(lock));
   }
   return future;
 }
 
+IndirectDataWriterPtr MakeIndirectDataWriter(
+    kvstore::KvStore kvstore, std::string prefix,
+    const IndirectDataWriterOptions& options) {
+  return internal::MakeIntrusivePtr<IndirectDataWriter>(
+      std::move(kvstore), std::move(prefix), options);
+}
+
 IndirectDataWriterPtr MakeIndirectDataWriter(kvstore::KvStore kvstore,
                                              std::string prefix,
                                              size_t target_size) {
-  return internal::MakeIntrusivePtr<IndirectDataWriter>(
-      std::move(kvstore), std::move(prefix), target_size);
+  IndirectDataWriterOptions options;
+  options.target_size = target_size;
+  return MakeIndirectDataWriter(std::move(kvstore), std::move(prefix),
+                                options);
 }
 
 }  // namespace internal_ocdbt
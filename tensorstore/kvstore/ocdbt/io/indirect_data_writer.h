@@ -17,7 +17,10 @@
 
 #include <stddef.h>
 
+#include <string>
+
 #include "absl/strings/cord.h"
+#include "absl/time/time.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
@@ -39,6 +42,10 @@
 /// be support for streaming writes and appending to existing keys in the
 /// underlying kvstore.
 ///
+/// Values may be buffered into several pending data files at once, each of
+/// which is flushed independently, so that writers on different threads do
+/// not wait for each other's uploads.
+///
 /// This is used to store data values and btree nodes.
 
 namespace tensorstore {
@@ -50,6 +57,29 @@ using IndirectDataWriterPtr = internal::IntrusivePtr<IndirectDataWriter>;
 void intrusive_ptr_increment(IndirectDataWriter* p);
 void intrusive_ptr_decrement(IndirectDataWriter* p);
 
+struct IndirectDataWriterOptions {
+  /// Target size of each data file.  A data file is flushed once it reaches
+  /// this size.  If 0, data files are flushed only when forced, and may be an
+  /// arbitrary size.
+  size_t target_size = 0;
+
+  /// Number of data files that may be pending at once.  Each write is
+  /// buffered in the data file assigned to the calling thread, and each
+  /// pending data file is flushed independently of the others.
+  size_t max_pending_files = 1;
+
+  /// If positive, the target size is adapted to the observed upload
+  /// throughput such that flushing a data file that reached the target size
+  /// takes about this long, which amortizes the per-request latency of the
+  /// underlying kvstore.  The adapted size does not exceed `target_size`,
+  /// unless that is 0.
+  absl::Duration target_flush_duration = absl::ZeroDuration();
+};
+
+IndirectDataWriterPtr MakeIndirectDataWriter(
+    kvstore::KvStore kvstore, std::string prefix,
+    const IndirectDataWriterOptions& options);
+
 IndirectDataWriterPtr MakeIndirectDataWriter(kvstore::KvStore kvstore,
                                              std::string prefix,
                                              size_t target_size);
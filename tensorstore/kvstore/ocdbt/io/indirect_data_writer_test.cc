@@ -17,12 +17,14 @@
 #include <algorithm>
 #include <cstring>
 #include <string>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/strings/cord.h"
+#include "absl/time/time.h"
 #include "riegeli/base/byte_fill.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/kvstore/memory/memory_key_value_store.h"
@@ -35,6 +37,7 @@
 using ::tensorstore::Future;
 using ::tensorstore::internal::MockKeyValueStore;
 using ::tensorstore::internal_ocdbt::IndirectDataReference;
+using ::tensorstore::internal_ocdbt::IndirectDataWriterOptions;
 using ::tensorstore::internal_ocdbt::MakeIndirectDataWriter;
 using ::tensorstore::internal_ocdbt::Write;
 
@@ -145,4 +148,83 @@ TEST(IndirectDataWriter, LimitedSize) {
   EXPECT_THAT(files, ::testing::ElementsAreArray(refs));
 }
 
+TEST(IndirectDataWriter, PendingFilesFlushConcurrently) {
+  absl::Cord data(riegeli::ByteFill(260, 0x37));
+
+  auto memory_store = tensorstore::GetMemoryKeyValueStore();
+  auto mock_key_value_store = MockKeyValueStore::Make();
+  IndirectDataWriterOptions options;
+  options.max_pending_files = 64;
+  auto writer = MakeIndirectDataWriter(
+      tensorstore::kvstore::KvStore(mock_key_value_store), "d/", options);
+
+  // Each thread writes to the data file assigned to it, and threads are
+  // assigned to the pending data files in turn.
+  std::vector<Future<const void>> futures(8);
+  std::vector<std::string> refs(8);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < futures.size(); ++i) {
+    threads.emplace_back([&, i] {
+      IndirectDataReference ref;
+      futures[i] = Write(*writer, data, ref);
+      refs[i] = ref.file_id.FullPath();
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  std::sort(refs.begin(), refs.end());
+  refs.erase(std::unique(refs.begin(), refs.end()), refs.end());
+  EXPECT_THAT(refs, ::testing::SizeIs(8));
+
+  // Forcing the futures flushes each pending data file without waiting for
+  // the others.
+  for (auto& f : futures) f.Force();
+  EXPECT_EQ(refs.size(), mock_key_value_store->write_requests.size());
+  while (!mock_key_value_store->write_requests.empty()) {
+    auto r = mock_key_value_store->write_requests.pop();
+    r(memory_store);
+  }
+  for (auto& f : futures) {
+    TENSORSTORE_ASSERT_OK(f.status());
+  }
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto entries,
+      tensorstore::kvstore::ListFuture(memory_store.get()).result());
+  EXPECT_THAT(ListEntriesToFiles(entries), ::testing::ElementsAreArray(refs));
+}
+
+TEST(IndirectDataWriter, AdaptiveTargetSize) {
+  constexpr size_t kTargetSize = 1024;
+
+  absl::Cord data(riegeli::ByteFill(260, 0x37));
+
+  auto memory_store = tensorstore::GetMemoryKeyValueStore();
+  auto mock_key_value_store = MockKeyValueStore::Make();
+  IndirectDataWriterOptions options;
+  options.target_size = kTargetSize;
+  options.target_flush_duration = absl::Hours(1);
+  auto writer = MakeIndirectDataWriter(
+      tensorstore::kvstore::KvStore(mock_key_value_store), "d/", options);
+
+  // The first data file is flushed at `kTargetSize`.
+  std::vector<Future<const void>> futures;
+  IndirectDataReference ref;
+  while (mock_key_value_store->write_requests.empty()) {
+    futures.push_back(Write(*writer, data, ref));
+  }
+  EXPECT_EQ(4, futures.size());
+
+  // Flushes are much faster than the target duration, but the target size
+  // does not grow beyond `kTargetSize`.
+  mock_key_value_store->write_requests.pop()(memory_store);
+  futures.clear();
+  while (mock_key_value_store->write_requests.empty()) {
+    futures.push_back(Write(*writer, data, ref));
+  }
+  EXPECT_EQ(4, futures.size());
+  mock_key_value_store->write_requests.pop()(memory_store);
+  for (auto& f : futures) {
+    TENSORSTORE_ASSERT_OK(f.status());
+  }
+}
+
 }  // namespace
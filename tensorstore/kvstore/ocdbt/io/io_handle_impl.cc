@@ -39,6 +39,7 @@
 #include "tensorstore/internal/data_copy_concurrency_resource.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/log/verbose_flag.h"
+#include "tensorstore/kvstore/coalesce_kvstore.h"
 #include "tensorstore/kvstore/driver.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/kvstore.h"
@@ -48,11 +49,11 @@
 #include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
 #include "tensorstore/kvstore/ocdbt/format/manifest.h"
 #include "tensorstore/kvstore/ocdbt/format/version_tree.h"
-#include "tensorstore/kvstore/ocdbt/io/coalesce_kvstore.h"
 #include "tensorstore/kvstore/ocdbt/io/indirect_data_kvstore_driver.h"
 #include "tensorstore/kvstore/ocdbt/io/indirect_data_writer.h"
 #include "tensorstore/kvstore/ocdbt/io/manifest_cache.h"
 #include "tensorstore/kvstore/ocdbt/io/node_cache.h"
+#include "tensorstore/kvstore/ocdbt/io/pinned_btree_nodes.h"
 #include "tensorstore/kvstore/ocdbt/io_handle.h"
 #include "tensorstore/kvstore/ocdbt/non_distributed/read_version.h"
 #include "tensorstore/kvstore/operations.h"
@@ -82,12 +83,58 @@ class IoHandleImpl : public IoHandle {
   internal::CachePtr<VersionTreeNodeCache> version_tree_node_cache_;
   IndirectDataWriterPtr indirect_data_writer_[kNumIndirectDataKinds];
   kvstore::DriverPtr indirect_data_kvstore_driver_;
+  ManifestNotifier::Ptr manifest_notifier_;
+  PinnedBtreeNodes::Ptr pinned_btree_nodes_;
 
   mutable absl::Mutex manifest_mutex_;
   mutable ManifestWithTime cached_top_level_manifest_{nullptr,
                                                       absl::InfinitePast()};
   mutable ManifestWithTime cached_numbered_manifest_{nullptr,
                                                      absl::InfinitePast()};
+  // One more than the latest generation known to be stale because an update
+  // conditioned on it failed, or 0 if none.  Notifications that have not yet
+  // been delivered must not cause such a manifest to be treated as up to
+  // date, since otherwise the update would be retried against it.
+  mutable GenerationNumber stale_generation_limit_ = 0;
+
+  // Advances the time of the cached `manifest_with_time` to the time as of
+  // which `manifest_notifier_` confirms that it is still the latest manifest.
+  void ApplyManifestNotifications(ManifestWithTime& manifest_with_time) const {
+    if (!manifest_notifier_ ||
+        manifest_with_time.time == absl::InfinitePast()) {
+      return;
+    }
+    const GenerationNumber generation =
+        GetLatestGeneration(manifest_with_time.manifest.get());
+    {
+      absl::MutexLock lock(&manifest_mutex_);
+      if (generation < stale_generation_limit_) return;
+    }
+    manifest_with_time.time =
+        std::max(manifest_with_time.time,
+                 manifest_notifier_->GetUpToDateTime(generation));
+  }
+
+  // Pins the upper levels of the latest B+tree of `manifest`.
+  void PinLatestBtree(const Manifest* manifest) const {
+    if (!pinned_btree_nodes_ || !manifest) return;
+    pinned_btree_nodes_->Update(manifest->latest_version());
+  }
+
+  // Records the result of an update of the manifest from `old_manifest`.
+  void ManifestUpdated(const Manifest* old_manifest,
+                       const Manifest& new_manifest, bool success) const {
+    if (success) PinLatestBtree(&new_manifest);
+    if (!manifest_notifier_) return;
+    if (success) {
+      manifest_notifier_->Publish(new_manifest.latest_generation());
+      return;
+    }
+    absl::MutexLock lock(&manifest_mutex_);
+    stale_generation_limit_ = std::max(stale_generation_limit_,
+                                       GetLatestGeneration(old_manifest) + 1);
+  }
+
   Future<const std::shared_ptr<const BtreeNode>> GetBtreeNode(
       const IndirectDataReference& ref) const final {
     return btree_node_cache_->ReadEntry(ref);
@@ -179,6 +226,7 @@ class IoHandleImpl : public IoHandle {
         return;
       }
 
+      self->ApplyManifestNotifications(manifest_with_time);
       if (manifest_with_time.time >= staleness_bound &&
           manifest_with_time.time != absl::InfinitePast()) {
         promise.SetResult(std::move(manifest_with_time));
@@ -214,6 +262,7 @@ class IoHandleImpl : public IoHandle {
       TENSORSTORE_RETURN_IF_ERROR(
           self->GetCachedNumberedManifest(manifest_with_time),
           static_cast<void>(promise.SetResult(_)));
+      self->ApplyManifestNotifications(manifest_with_time);
       if (manifest_with_time.time >= staleness_bound &&
           manifest_with_time.time != absl::InfinitePast()) {
         ABSL_LOG_IF(INFO, ocdbt_logging)
@@ -243,6 +292,14 @@ class IoHandleImpl : public IoHandle {
       absl::Time staleness_bound) const final {
     auto [promise, future] = PromiseFuturePair<ManifestWithTime>::Make();
     GetManifestOp::Start(this, std::move(promise), staleness_bound);
+    if (pinned_btree_nodes_) {
+      future.ExecuteWhenReady(
+          [self = IoHandleImpl::Ptr(this)](
+              ReadyFuture<const ManifestWithTime> future) {
+            if (!future.result().ok()) return;
+            self->PinLatestBtree(future.value().manifest.get());
+          });
+    }
     return std::move(future);
   }
 
@@ -406,9 +463,20 @@ class IoHandleImpl : public IoHandle {
   virtual Future<TryUpdateManifestResult> TryUpdateManifest(
       std::shared_ptr<const Manifest> old_manifest,
       std::shared_ptr<const Manifest> new_manifest, absl::Time time) const {
-    return TryUpdateManifestOp::Start(IoHandleImpl::Ptr(this),
-                                      std::move(old_manifest),
-                                      std::move(new_manifest), time);
+    auto future = TryUpdateManifestOp::Start(
+        IoHandleImpl::Ptr(this), old_manifest, new_manifest, time);
+    if (manifest_notifier_ || pinned_btree_nodes_) {
+      future.ExecuteWhenReady(
+          [self = IoHandleImpl::Ptr(this),
+           old_manifest = std::move(old_manifest),
+           new_manifest = std::move(new_manifest)](
+              ReadyFuture<TryUpdateManifestResult> future) {
+            if (!future.result().ok()) return;
+            self->ManifestUpdated(old_manifest.get(), *new_manifest,
+                                  future.value().success);
+          });
+    }
+    return future;
   }
 
   Future<const void> WriteData(IndirectDataKind kind, absl::Cord data,
@@ -428,12 +496,14 @@ IoHandle::Ptr MakeIoHandle(
         data_copy_concurrency,
     internal::CachePool* cache_pool, const KvStore& base_kvstore,
     const KvStore& manifest_kvstore, ConfigStatePtr config_state,
-    const DataFilePrefixes& data_file_prefixes, size_t write_target_size,
-    std::optional<ReadCoalesceOptions> read_coalesce_options) {
+    const DataFilePrefixes& data_file_prefixes,
+    const IndirectDataWriterOptions& write_options,
+    std::optional<ReadCoalesceOptions> read_coalesce_options,
+    ManifestNotifier::Ptr manifest_notifier, size_t pinned_btree_bytes) {
   // Maybe wrap the base driver in CoalesceKvStoreDriver.
   kvstore::DriverPtr driver_with_optional_coalescing =
       read_coalesce_options.has_value()
-          ? MakeCoalesceKvStoreDriver(
+          ? internal_kvstore::MakeCoalesceKvStoreDriver(
                 base_kvstore.driver,
                 read_coalesce_options->max_overhead_bytes_per_request,
                 read_coalesce_options->max_merged_bytes_per_request,
@@ -444,6 +514,7 @@ IoHandle::Ptr MakeIoHandle(
   impl->base_kvstore_ = base_kvstore;
   impl->config_state = std::move(config_state);
   impl->executor = data_copy_concurrency->executor;
+  impl->manifest_notifier_ = std::move(manifest_notifier);
   auto data_kvstore =
       kvstore::KvStore(driver_with_optional_coalescing, base_kvstore.path);
   {
@@ -460,7 +531,7 @@ IoHandle::Ptr MakeIoHandle(
                        &data_prefix_array[0];
       if (match_i == i) {
         impl->indirect_data_writer_[i] = internal_ocdbt::MakeIndirectDataWriter(
-            data_kvstore, std::string(data_prefix_array[i]), write_target_size);
+            data_kvstore, std::string(data_prefix_array[i]), write_options);
       } else {
         impl->indirect_data_writer_[i] = impl->indirect_data_writer_[match_i];
       }
@@ -472,6 +543,10 @@ IoHandle::Ptr MakeIoHandle(
       internal_ocdbt::GetDecodedIndirectDataCache<BtreeNodeCache>(
           cache_pool, impl->indirect_data_kvstore_driver_,
           data_copy_concurrency);
+  if (pinned_btree_bytes > 0) {
+    impl->pinned_btree_nodes_ = internal::MakeIntrusivePtr<PinnedBtreeNodes>(
+        impl->btree_node_cache_, pinned_btree_bytes);
+  }
   impl->version_tree_node_cache_ =
       tensorstore::internal_ocdbt::GetDecodedIndirectDataCache<
           tensorstore::internal_ocdbt::VersionTreeNodeCache>(
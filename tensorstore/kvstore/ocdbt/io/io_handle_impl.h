@@ -27,6 +27,7 @@
 #include "tensorstore/internal/data_copy_concurrency_resource.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/kvstore/ocdbt/config.h"
+#include "tensorstore/kvstore/ocdbt/io/indirect_data_writer.h"
 #include "tensorstore/kvstore/ocdbt/io_handle.h"
 
 namespace tensorstore {
@@ -49,13 +50,24 @@ struct ReadCoalesceOptions {
 };
 
 /// Returns an `IoHandle` handle based on the specified arguments.
+///
+/// If `manifest_notifier` is specified, successful manifest updates are
+/// published to it, and a cached manifest is used without being re-read for as
+/// long as it confirms that no newer manifest has been published.
+///
+/// If `pinned_btree_bytes` is non-zero, the upper levels of the latest B+tree,
+/// up to `pinned_btree_bytes` of decoded nodes, are loaded whenever a new
+/// manifest is read or written, and kept pinned in the cache.
 IoHandle::Ptr MakeIoHandle(
     const Context::Resource<tensorstore::internal::DataCopyConcurrencyResource>&
         data_copy_concurrency,
     internal::CachePool* cache_pool, const KvStore& base_kvstore,
     const KvStore& manifest_kvstore, ConfigStatePtr config_state,
-    const DataFilePrefixes& data_file_prefixes, size_t write_target_size = 0,
-    std::optional<ReadCoalesceOptions> read_coalesce_options = std::nullopt);
+    const DataFilePrefixes& data_file_prefixes,
+    const IndirectDataWriterOptions& write_options = {},
+    std::optional<ReadCoalesceOptions> read_coalesce_options = std::nullopt,
+    ManifestNotifier::Ptr manifest_notifier = {},
+    size_t pinned_btree_bytes = 0);
 
 }  // namespace internal_ocdbt
 }  // namespace tensorstore
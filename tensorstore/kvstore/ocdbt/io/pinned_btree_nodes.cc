@@ -0,0 +1,178 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/io/pinned_btree_nodes.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "absl/base/attributes.h"
+#include "absl/log/absl_log.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/cache/async_cache.h"
+#include "tensorstore/internal/estimate_heap_usage/estimate_heap_usage.h"
+#include "tensorstore/internal/estimate_heap_usage/std_variant.h"
+#include "tensorstore/internal/estimate_heap_usage/std_vector.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/log/verbose_flag.h"
+#include "tensorstore/kvstore/ocdbt/format/btree.h"
+#include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+namespace {
+ABSL_CONST_INIT internal_log::VerboseFlag ocdbt_logging("ocdbt");
+}  // namespace
+
+struct PinnedBtreeNodes::LoadState
+    : public internal::AtomicReferenceCount<LoadState> {
+  PinnedBtreeNodes::Ptr self;
+  IndirectDataReference root;
+  Promise<void> promise;
+
+  // Nodes of the level to load next.
+  std::vector<IndirectDataReference> level;
+
+  // Nodes loaded so far, in breadth-first order.
+  std::vector<PinnedEntry> pinned;
+  size_t pinned_bytes = 0;
+};
+
+Future<const void> PinnedBtreeNodes::Update(
+    const BtreeGenerationReference& version) {
+  const IndirectDataReference& root = version.root.location;
+  auto state = internal::MakeIntrusivePtr<LoadState>();
+  Future<const void> future;
+  std::vector<PinnedEntry> unpinned;
+  {
+    absl::MutexLock lock(&mutex_);
+    if (root_ && *root_ == root) return root_future_;
+    root_ = root;
+    if (root.IsMissing()) {
+      unpinned = std::exchange(pinned_, {});
+      pinned_bytes_ = 0;
+      root_future_ = MakeReadyFuture();
+      return root_future_;
+    }
+    auto pair = PromiseFuturePair<void>::Make();
+    state->promise = std::move(pair.promise);
+    future = root_future_ = std::move(pair.future);
+  }
+  state->self = Ptr(this);
+  state->root = root;
+  state->level.push_back(root);
+  LoadLevel(std::move(state));
+  return future;
+}
+
+void PinnedBtreeNodes::LoadLevel(internal::IntrusivePtr<LoadState> state) {
+  auto& self = *state->self;
+  {
+    absl::MutexLock lock(&self.mutex_);
+    if (!self.root_ || *self.root_ != state->root) {
+      // Superseded by a newer root.
+      state->promise.SetResult(absl::OkStatus());
+      return;
+    }
+  }
+  std::vector<PinnedEntry> entries;
+  std::vector<Future<const void>> futures;
+  entries.reserve(state->level.size());
+  futures.reserve(state->level.size());
+  for (const auto& ref : state->level) {
+    auto entry = self.cache_->GetEntry(ref);
+    futures.push_back(entry->Read({absl::InfinitePast()}));
+    entries.push_back(std::move(entry));
+  }
+  auto all_ready = WaitAllFuture(span(futures));
+  all_ready.ExecuteWhenReady(
+      [state = std::move(state), entries = std::move(entries),
+       futures = std::move(futures)](ReadyFuture<void>) mutable {
+        auto& self = *state->self;
+        std::vector<IndirectDataReference> next_level;
+        absl::Status status;
+        for (size_t i = 0; i < entries.size(); ++i) {
+          status = futures[i].status();
+          if (!status.ok()) break;
+          auto node = internal::AsyncCache::ReadLock<BtreeNode>(*entries[i])
+                          .shared_data();
+          const size_t bytes = internal::EstimateHeapUsage(*node);
+          if (state->pinned_bytes + bytes > self.max_bytes_) {
+            next_level.clear();
+            break;
+          }
+          state->pinned_bytes += bytes;
+          state->pinned.push_back(std::move(entries[i]));
+          if (node->height == 0) continue;
+          for (const auto& entry :
+               std::get<BtreeNode::InteriorNodeEntries>(node->entries)) {
+            next_level.push_back(entry.node.location);
+          }
+        }
+        if (!status.ok() || next_level.empty()) {
+          self.LoadDone(*state, std::move(status));
+          return;
+        }
+        // Only read the nodes of the next level that are expected to fit,
+        // based on the average size of the nodes loaded so far.
+        const size_t average_bytes = std::max(
+            size_t(1), state->pinned_bytes / state->pinned.size());
+        const size_t max_nodes =
+            (self.max_bytes_ - state->pinned_bytes) / average_bytes + 1;
+        if (next_level.size() > max_nodes) next_level.resize(max_nodes);
+        state->level = std::move(next_level);
+        LoadLevel(std::move(state));
+      });
+}
+
+void PinnedBtreeNodes::LoadDone(LoadState& state, absl::Status status) {
+  std::vector<PinnedEntry> unpinned;
+  {
+    absl::MutexLock lock(&mutex_);
+    if (root_ && *root_ == state.root) {
+      unpinned = std::exchange(pinned_, std::move(state.pinned));
+      pinned_bytes_ = state.pinned_bytes;
+      // Retry on the next update.
+      if (!status.ok()) root_ = std::nullopt;
+      ABSL_LOG_IF(INFO, ocdbt_logging)
+          << "Pinned " << pinned_.size() << " B+tree nodes (" << pinned_bytes_
+          << " bytes) of root " << state.root << ": " << status;
+    }
+  }
+  state.promise.SetResult(std::move(status));
+}
+
+size_t PinnedBtreeNodes::num_pinned_nodes() const {
+  absl::MutexLock lock(&mutex_);
+  return pinned_.size();
+}
+
+size_t PinnedBtreeNodes::pinned_bytes() const {
+  absl::MutexLock lock(&mutex_);
+  return pinned_bytes_;
+}
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
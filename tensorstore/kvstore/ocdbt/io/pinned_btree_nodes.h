@@ -0,0 +1,94 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_OCDBT_IO_PINNED_BTREE_NODES_H_
+#define TENSORSTORE_KVSTORE_OCDBT_IO_PINNED_BTREE_NODES_H_
+
+/// \file
+/// Eager loading and pinning of the upper levels of a B+tree.
+
+#include <stddef.h>
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/internal/cache/cache.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/io/node_cache.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+
+/// Keeps the upper levels of the latest B+tree loaded in a `BtreeNodeCache`.
+///
+/// Every lookup descends from the root, so the nodes near the root are shared
+/// by all keys.  Nodes are loaded in breadth-first order, one level at a time,
+/// and pinned in the cache until the nodes of a newer root are loaded, such
+/// that a cold read only has to fetch the nodes below the pinned levels.
+class PinnedBtreeNodes
+    : public internal::AtomicReferenceCount<PinnedBtreeNodes> {
+ public:
+  using Ptr = internal::IntrusivePtr<PinnedBtreeNodes>;
+  using PinnedEntry = internal::PinnedCacheEntry<
+      DecodedIndirectDataCache<BtreeNodeCache, BtreeNode>>;
+
+  /// Pins at most `max_bytes` of decoded nodes of `cache`, as estimated by
+  /// `EstimateHeapUsage`.
+  explicit PinnedBtreeNodes(internal::CachePtr<BtreeNodeCache> cache,
+                            size_t max_bytes)
+      : cache_(std::move(cache)), max_bytes_(max_bytes) {}
+
+  /// Loads and pins the upper levels of the B+tree of `version`, and then
+  /// unpins the nodes pinned for the previous version.  Has no effect if the
+  /// root of `version` is already pinned or being loaded.
+  ///
+  /// Returns a future that becomes ready once the nodes are loaded.  If a
+  /// node cannot be read, the nodes loaded before it remain pinned, and the
+  /// error is returned.
+  Future<const void> Update(const BtreeGenerationReference& version);
+
+  /// Number of nodes currently pinned.
+  size_t num_pinned_nodes() const;
+
+  /// Estimated bytes of the nodes currently pinned.
+  size_t pinned_bytes() const;
+
+ private:
+  struct LoadState;
+  static void LoadLevel(internal::IntrusivePtr<LoadState> state);
+  void LoadDone(LoadState& state, absl::Status status);
+
+  const internal::CachePtr<BtreeNodeCache> cache_;
+  const size_t max_bytes_;
+
+  mutable absl::Mutex mutex_;
+  /// Root of the B+tree whose nodes are pinned or being loaded.  An empty
+  /// B+tree has a missing root, for which no nodes are pinned.
+  std::optional<IndirectDataReference> root_ ABSL_GUARDED_BY(mutex_);
+  Future<const void> root_future_ ABSL_GUARDED_BY(mutex_);
+  std::vector<PinnedEntry> pinned_ ABSL_GUARDED_BY(mutex_);
+  size_t pinned_bytes_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_OCDBT_IO_PINNED_BTREE_NODES_H_
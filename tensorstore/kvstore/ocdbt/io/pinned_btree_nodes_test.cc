@@ -0,0 +1,145 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/io/pinned_btree_nodes.h"
+
+#include <stddef.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/cord.h"
+#include "tensorstore/context.h"
+#include "tensorstore/internal/cache/cache.h"
+#include "tensorstore/internal/data_copy_concurrency_resource.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/ocdbt/driver.h"
+#include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/io/indirect_data_kvstore_driver.h"
+#include "tensorstore/kvstore/ocdbt/io/node_cache.h"
+#include "tensorstore/kvstore/ocdbt/test_util.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/util/status_testutil.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace {
+
+namespace kvstore = ::tensorstore::kvstore;
+using ::tensorstore::Context;
+using ::tensorstore::internal::CachePool;
+using ::tensorstore::internal::CachePtr;
+using ::tensorstore::internal::DataCopyConcurrencyResource;
+using ::tensorstore::internal::MakeIntrusivePtr;
+using ::tensorstore::internal_ocdbt::BtreeGenerationReference;
+using ::tensorstore::internal_ocdbt::BtreeNodeCache;
+using ::tensorstore::internal_ocdbt::GetDecodedIndirectDataCache;
+using ::tensorstore::internal_ocdbt::IndirectDataReference;
+using ::tensorstore::internal_ocdbt::MakeIndirectDataKvStoreDriver;
+using ::tensorstore::internal_ocdbt::OcdbtDriver;
+using ::tensorstore::internal_ocdbt::PinnedBtreeNodes;
+using ::tensorstore::internal_ocdbt::ReadManifest;
+
+class PinnedBtreeNodesTest : public ::testing::Test {
+ protected:
+  Context context_ = Context::Default();
+  CachePool::StrongPtr cache_pool_ = CachePool::Make({});
+  kvstore::KvStore store_;
+  CachePtr<BtreeNodeCache> cache_;
+
+  void SetUp() override {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        store_, kvstore::Open({{"driver", "ocdbt"},
+                               {"base", "memory://"},
+                               {"config", {{"max_decoded_node_bytes", 100}}}},
+                              context_)
+                    .result());
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto base, kvstore::Open("memory://", context_).result());
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+        auto data_copy_concurrency,
+        context_.GetResource<DataCopyConcurrencyResource>());
+    cache_ = GetDecodedIndirectDataCache<BtreeNodeCache>(
+        cache_pool_.get(), MakeIndirectDataKvStoreDriver(base),
+        data_copy_concurrency);
+  }
+
+  void WriteKeys(int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      TENSORSTORE_ASSERT_OK(kvstore::Write(store_,
+                                           tensorstore::StrCat("key_", i),
+                                           absl::Cord("value")));
+    }
+  }
+
+  BtreeGenerationReference GetLatestVersion() {
+    auto manifest =
+        ReadManifest(static_cast<OcdbtDriver&>(*store_.driver)).value();
+    return manifest->latest_version();
+  }
+};
+
+TEST_F(PinnedBtreeNodesTest, PinsAllNodesWithinLimit) {
+  WriteKeys(0, 100);
+  auto version = GetLatestVersion();
+  ASSERT_GE(version.root_height, 2);
+
+  auto pinned = MakeIntrusivePtr<PinnedBtreeNodes>(cache_, 1 << 30);
+  TENSORSTORE_ASSERT_OK(pinned->Update(version).result());
+  const size_t num_nodes = pinned->num_pinned_nodes();
+  const size_t bytes = pinned->pinned_bytes();
+  EXPECT_GT(num_nodes, version.root_height + 1);
+  EXPECT_GT(bytes, 0);
+
+  // Updating to the same root has no effect.
+  TENSORSTORE_ASSERT_OK(pinned->Update(version).result());
+  EXPECT_EQ(num_nodes, pinned->num_pinned_nodes());
+  EXPECT_EQ(bytes, pinned->pinned_bytes());
+
+  // Only the upper levels fit within a smaller limit.
+  auto partial = MakeIntrusivePtr<PinnedBtreeNodes>(cache_, bytes / 2);
+  TENSORSTORE_ASSERT_OK(partial->Update(version).result());
+  EXPECT_GE(partial->num_pinned_nodes(), 1);
+  EXPECT_LT(partial->num_pinned_nodes(), num_nodes);
+  EXPECT_LE(partial->pinned_bytes(), bytes / 2);
+}
+
+TEST_F(PinnedBtreeNodesTest, RootLargerThanLimit) {
+  WriteKeys(0, 100);
+  auto pinned = MakeIntrusivePtr<PinnedBtreeNodes>(cache_, /*max_bytes=*/1);
+  TENSORSTORE_ASSERT_OK(pinned->Update(GetLatestVersion()).result());
+  EXPECT_EQ(0, pinned->num_pinned_nodes());
+  EXPECT_EQ(0, pinned->pinned_bytes());
+}
+
+TEST_F(PinnedBtreeNodesTest, ReplacedByNewerVersion) {
+  WriteKeys(0, 10);
+  auto pinned = MakeIntrusivePtr<PinnedBtreeNodes>(cache_, 1 << 30);
+  TENSORSTORE_ASSERT_OK(pinned->Update(GetLatestVersion()).result());
+  const size_t num_nodes = pinned->num_pinned_nodes();
+  EXPECT_GE(num_nodes, 1);
+
+  WriteKeys(10, 100);
+  TENSORSTORE_ASSERT_OK(pinned->Update(GetLatestVersion()).result());
+  EXPECT_GT(pinned->num_pinned_nodes(), num_nodes);
+
+  // An empty B+tree has no nodes to pin.
+  BtreeGenerationReference empty;
+  empty.root.location = IndirectDataReference::Missing();
+  TENSORSTORE_ASSERT_OK(pinned->Update(empty).result());
+  EXPECT_EQ(0, pinned->num_pinned_nodes());
+  EXPECT_EQ(0, pinned->pinned_bytes());
+}
+
+}  // namespace
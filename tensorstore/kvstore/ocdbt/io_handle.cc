@@ -23,6 +23,8 @@
 namespace tensorstore {
 namespace internal_ocdbt {
 
+ManifestNotifier::~ManifestNotifier() = default;
+
 ReadonlyIoHandle::~ReadonlyIoHandle() = default;
 
 FlushPromise::FlushPromise(FlushPromise&& other) noexcept
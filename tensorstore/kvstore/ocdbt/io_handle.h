@@ -37,6 +37,29 @@
 namespace tensorstore {
 namespace internal_ocdbt {
 
+/// Abstract interface for exchanging notifications of manifest updates between
+/// the processes accessing a single database, which allows readers to use a
+/// cached manifest without re-reading it to check that it is up to date.
+class ManifestNotifier
+    : public internal::AtomicReferenceCount<ManifestNotifier> {
+ public:
+  using Ptr = internal::IntrusivePtr<ManifestNotifier>;
+
+  /// Notifies other processes that the manifest has been updated to
+  /// `generation`.
+  virtual void Publish(GenerationNumber generation) = 0;
+
+  /// Returns the latest time as of which no manifest newer than `generation`
+  /// is known to have been published, or `absl::InfinitePast()` if that is not
+  /// known, e.g. because notifications are not currently being received.
+  ///
+  /// Updates whose notifications have not yet been delivered are not
+  /// reflected.
+  virtual absl::Time GetUpToDateTime(GenerationNumber generation) const = 0;
+
+  virtual ~ManifestNotifier();
+};
+
 /// Abstract interface used by operation implementations to read the OCDBT data
 /// structures for a single database.
 class ReadonlyIoHandle
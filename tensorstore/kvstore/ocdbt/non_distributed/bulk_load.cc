@@ -0,0 +1,309 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/non_distributed/bulk_load.h"
+
+#include <stddef.h>
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/base/attributes.h"
+#include "absl/log/absl_log.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/log/verbose_flag.h"
+#include "tensorstore/kvstore/ocdbt/format/btree.h"
+#include "tensorstore/kvstore/ocdbt/format/btree_node_encoder.h"
+#include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
+#include "tensorstore/kvstore/ocdbt/format/manifest.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/io_handle.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/create_new_manifest.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/write_nodes.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/quote_string.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+namespace {
+
+ABSL_CONST_INIT internal_log::VerboseFlag ocdbt_logging("ocdbt");
+
+size_t EstimateDecodedEntrySize(
+    const InteriorNodeEntryData<std::string>& entry) {
+  InteriorNodeEntry e;
+  e.key = entry.key;
+  e.subtree_common_prefix_length = entry.subtree_common_prefix_length;
+  e.node = entry.node;
+  return EstimateDecodedEntrySizeExcludingKey(e) + entry.key_filter.size() +
+         entry.key.size();
+}
+
+Future<absl::Time> WriteManifest(IoHandle::Ptr io_handle,
+                                 std::shared_ptr<const Manifest> old_manifest,
+                                 std::shared_ptr<const Manifest> new_manifest) {
+  return MapFutureValue(
+      InlineExecutor{},
+      [](const TryUpdateManifestResult& result) -> Result<absl::Time> {
+        if (!result.success) {
+          return absl::AbortedError(
+              "Database was modified concurrently with bulk load");
+        }
+        return result.time;
+      },
+      io_handle->TryUpdateManifest(std::move(old_manifest),
+                                   std::move(new_manifest), absl::Now()));
+}
+
+}  // namespace
+
+Future<std::shared_ptr<BtreeBulkLoader>> BtreeBulkLoader::Open(
+    IoHandle::Ptr io_handle, std::string key_prefix) {
+  auto ensure_future = EnsureExistingManifest(io_handle);
+  return PromiseFuturePair<std::shared_ptr<BtreeBulkLoader>>::LinkValue(
+             [io_handle = std::move(io_handle),
+              key_prefix = std::move(key_prefix)](
+                 Promise<std::shared_ptr<BtreeBulkLoader>> promise,
+                 ReadyFuture<const absl::Time> time) mutable {
+               LinkResult(
+                   std::move(promise),
+                   MapFutureValue(
+                       InlineExecutor{},
+                       [io_handle, key_prefix = std::move(key_prefix)](
+                           const ManifestWithTime& manifest_with_time)
+                           -> Result<std::shared_ptr<BtreeBulkLoader>> {
+                         auto& manifest = manifest_with_time.manifest;
+                         if (!manifest) {
+                           return absl::FailedPreconditionError(
+                               "Manifest does not exist");
+                         }
+                         if (!manifest->latest_version()
+                                  .root.location.IsMissing()) {
+                           return absl::FailedPreconditionError(
+                               "Bulk load requires an empty database");
+                         }
+                         return std::make_shared<BtreeBulkLoader>(
+                             io_handle, manifest, key_prefix);
+                       },
+                       io_handle->GetManifest(time.value())));
+             },
+             std::move(ensure_future))
+      .future;
+}
+
+BtreeBulkLoader::BtreeBulkLoader(
+    IoHandle::Ptr io_handle, std::shared_ptr<const Manifest> existing_manifest,
+    std::string key_prefix)
+    : io_handle_(std::move(io_handle)),
+      existing_manifest_(std::move(existing_manifest)),
+      config_(existing_manifest_->config),
+      key_prefix_(std::move(key_prefix)) {}
+
+absl::Status BtreeBulkLoader::Add(std::string_view key, absl::Cord value) {
+  if (committed_) {
+    return absl::FailedPreconditionError("Bulk load already committed");
+  }
+  std::string full_key = tensorstore::StrCat(key_prefix_, key);
+  if (full_key.size() > kMaxKeyLength) {
+    return absl::InvalidArgumentError(tensorstore::StrCat(
+        "Key ", tensorstore::QuoteString(full_key), " exceeds maximum length"));
+  }
+  if (num_keys_ != 0 && full_key <= last_key_) {
+    return absl::InvalidArgumentError(tensorstore::StrCat(
+        "Keys must be added in strictly increasing order, but ",
+        tensorstore::QuoteString(full_key), " follows ",
+        tensorstore::QuoteString(last_key_)));
+  }
+  last_key_ = full_key;
+  ++num_keys_;
+
+  LeafNodeEntry entry;
+  entry.key = full_key;
+  if (value.size() > config_.max_inline_value_bytes) {
+    flush_promise_.Link(io_handle_->WriteData(
+        IndirectDataKind::kValue, std::move(value),
+        entry.value_reference.emplace<IndirectDataReference>()));
+  } else {
+    entry.value_reference = std::move(value);
+  }
+
+  size_t entry_size =
+      EstimateDecodedEntrySizeExcludingKey(entry) + full_key.size();
+  if (!leaf_keys_.empty() &&
+      leaf_size_ + entry_size > config_.max_decoded_node_bytes) {
+    TENSORSTORE_RETURN_IF_ERROR(EmitLeafNode(/*may_be_root=*/false));
+  }
+  leaf_size_ += entry_size;
+  leaf_values_.push_back(std::move(entry.value_reference));
+  leaf_keys_.push_back(std::move(full_key));
+  return absl::OkStatus();
+}
+
+absl::Status BtreeBulkLoader::EmitLeafNode(bool may_be_root) {
+  ABSL_LOG_IF(INFO, ocdbt_logging)
+      << "BtreeBulkLoader: emitting leaf node with " << leaf_keys_.size()
+      << " entries";
+  BtreeLeafNodeEncoder encoder(config_, /*height=*/0,
+                               /*existing_prefix=*/{});
+  for (size_t i = 0; i < leaf_keys_.size(); ++i) {
+    encoder.AddEntry(/*existing=*/false,
+                     LeafNodeEntry{leaf_keys_[i], std::move(leaf_values_[i])});
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(auto encoded_nodes,
+                               encoder.Finalize(may_be_root));
+  auto new_entries =
+      WriteNodes(*io_handle_, flush_promise_, std::move(encoded_nodes));
+  leaf_keys_.clear();
+  leaf_values_.clear();
+  leaf_size_ = 0;
+  return AddChildEntries(/*height=*/1, std::move(new_entries));
+}
+
+absl::Status BtreeBulkLoader::EmitInteriorNode(BtreeNodeHeight height) {
+  auto& level = interior_levels_[height - 1];
+  ABSL_LOG_IF(INFO, ocdbt_logging)
+      << "BtreeBulkLoader: emitting interior node of height "
+      << static_cast<int>(height) << " with " << level.entries.size()
+      << " entries";
+  BtreeInteriorNodeEncoder encoder(config_, height, /*existing_prefix=*/{});
+  for (auto& entry : level.entries) {
+    AddNewInteriorEntry(encoder, entry);
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(auto encoded_nodes,
+                               encoder.Finalize(/*may_be_root=*/false));
+  auto new_entries =
+      WriteNodes(*io_handle_, flush_promise_, std::move(encoded_nodes));
+  // `level` may be invalidated by `AddChildEntries`.
+  interior_levels_[height - 1].entries.clear();
+  interior_levels_[height - 1].size = 0;
+  return AddChildEntries(height + 1, std::move(new_entries));
+}
+
+absl::Status BtreeBulkLoader::AddChildEntries(
+    BtreeNodeHeight height,
+    std::vector<InteriorNodeEntryData<std::string>> entries) {
+  if (height == std::numeric_limits<BtreeNodeHeight>::max()) {
+    return absl::DataLossError("Maximum B+tree height exceeded");
+  }
+  if (interior_levels_.size() < height) {
+    interior_levels_.resize(height);
+  }
+  for (auto& entry : entries) {
+    size_t entry_size = EstimateDecodedEntrySize(entry);
+    {
+      // Interior nodes have at least two children, to bound the height of the
+      // tree regardless of `max_decoded_node_bytes`.
+      auto& level = interior_levels_[height - 1];
+      if (level.entries.size() >= 2 &&
+          level.size + entry_size > config_.max_decoded_node_bytes) {
+        TENSORSTORE_RETURN_IF_ERROR(EmitInteriorNode(height));
+      }
+    }
+    auto& level = interior_levels_[height - 1];
+    level.size += entry_size;
+    level.entries.push_back(std::move(entry));
+  }
+  return absl::OkStatus();
+}
+
+Result<BtreeGenerationReference> BtreeBulkLoader::WriteRemainingNodes() {
+  if (interior_levels_.empty()) {
+    // No node has been emitted, and all entries, if any, may be encoded as the
+    // root node.
+    if (leaf_keys_.empty()) {
+      return WriteRootNode(*io_handle_, flush_promise_, /*height=*/0, {});
+    }
+    TENSORSTORE_RETURN_IF_ERROR(EmitLeafNode(/*may_be_root=*/true));
+  } else if (!leaf_keys_.empty()) {
+    TENSORSTORE_RETURN_IF_ERROR(EmitLeafNode(/*may_be_root=*/false));
+  }
+  // Because a node is only emitted when the next entry is added, every height
+  // below the top height has pending entries.  Emitting them bottom-up ensures
+  // that the top height has at least two entries, unless it references a
+  // single leaf node encoded with `may_be_root=true`.
+  for (size_t height = 1; height < interior_levels_.size(); ++height) {
+    if (interior_levels_[height - 1].entries.empty()) continue;
+    TENSORSTORE_RETURN_IF_ERROR(
+        EmitInteriorNode(static_cast<BtreeNodeHeight>(height)));
+  }
+  auto top_height = static_cast<BtreeNodeHeight>(interior_levels_.size());
+  auto entries = std::move(interior_levels_.back().entries);
+  interior_levels_.clear();
+  return WriteRootNode(*io_handle_, flush_promise_, top_height - 1,
+                       std::move(entries));
+}
+
+Future<absl::Time> BtreeBulkLoader::Commit() {
+  if (committed_) {
+    return absl::FailedPreconditionError("Bulk load already committed");
+  }
+  committed_ = true;
+  ABSL_LOG_IF(INFO, ocdbt_logging)
+      << "BtreeBulkLoader: committing " << num_keys_ << " keys";
+  TENSORSTORE_ASSIGN_OR_RETURN(auto new_generation, WriteRemainingNodes());
+
+  auto btree_flush_future = std::move(flush_promise_).future();
+  return PromiseFuturePair<absl::Time>::LinkValue(
+             [io_handle = io_handle_, existing_manifest = existing_manifest_,
+              btree_flush_future = std::move(btree_flush_future)](
+                 Promise<absl::Time> promise,
+                 ReadyFuture<std::pair<std::shared_ptr<Manifest>,
+                                       Future<const void>>>
+                     future) mutable {
+               auto& [new_manifest, version_tree_flush_future] =
+                   future.value();
+               // All B+tree and version tree nodes must be durable before the
+               // manifest that references them is written.
+               FlushPromise flush_promise;
+               flush_promise.Link(std::move(btree_flush_future));
+               flush_promise.Link(std::move(version_tree_flush_future));
+               auto flush_future = std::move(flush_promise).future();
+               if (flush_future.null()) {
+                 LinkResult(std::move(promise),
+                            WriteManifest(std::move(io_handle),
+                                          std::move(existing_manifest),
+                                          std::move(new_manifest)));
+                 return;
+               }
+               flush_future.Force();
+               LinkValue(
+                   [io_handle = std::move(io_handle),
+                    existing_manifest = std::move(existing_manifest),
+                    new_manifest = std::move(new_manifest)](
+                       Promise<absl::Time> promise,
+                       ReadyFuture<const void> future) mutable {
+                     LinkResult(std::move(promise),
+                                WriteManifest(std::move(io_handle),
+                                              std::move(existing_manifest),
+                                              std::move(new_manifest)));
+                   },
+                   std::move(promise), std::move(flush_future));
+             },
+             CreateNewManifest(io_handle_, existing_manifest_, new_generation))
+      .future;
+}
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
@@ -0,0 +1,134 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_BULK_LOAD_H_
+#define TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_BULK_LOAD_H_
+
+// This module implements bulk loading of an empty database.
+//
+// Rather than committing batches of mutations, each of which re-writes the
+// interior nodes along the paths to the modified leaves, the B+tree is built
+// bottom-up from key/value pairs supplied in increasing key order:
+//
+// 1. Values that are not stored inline are written via `IoHandle::WriteData`,
+//    which packs them into data files.
+//
+// 2. Each leaf node is emitted as soon as the next entry would make it exceed
+//    `max_decoded_node_bytes`, and a reference to it is added to the pending
+//    interior node of height 1.  Interior nodes are emitted in the same way,
+//    so that only a single partial node is buffered per height.
+//
+// 3. On commit, the partial nodes are emitted bottom-up, the root node is
+//    written, and a single new manifest version that references it is
+//    written.
+//
+// The total cost is linear in the number of keys, and the memory usage is
+// bounded by the node size times the height of the tree, plus any data not yet
+// flushed by the indirect data writer.
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/time/time.h"
+#include "tensorstore/kvstore/ocdbt/format/btree.h"
+#include "tensorstore/kvstore/ocdbt/format/config.h"
+#include "tensorstore/kvstore/ocdbt/format/manifest.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/io_handle.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+
+/// Builds the B+tree of an empty database bottom-up from key/value pairs
+/// supplied in strictly increasing key order.
+///
+/// Not thread-safe: `Add` and `Commit` must not be called concurrently.
+class BtreeBulkLoader {
+ public:
+  /// Prepares to bulk load the database accessed by `io_handle`.
+  ///
+  /// Creates the manifest if it does not already exist.  Fails with
+  /// `absl::StatusCode::kFailedPrecondition` if the database is not empty.
+  ///
+  /// \param key_prefix Prefix prepended to every key passed to `Add`.
+  static Future<std::shared_ptr<BtreeBulkLoader>> Open(
+      IoHandle::Ptr io_handle, std::string key_prefix = {});
+
+  /// Use `Open` instead.
+  BtreeBulkLoader(IoHandle::Ptr io_handle,
+                  std::shared_ptr<const Manifest> existing_manifest,
+                  std::string key_prefix);
+
+  /// Adds the next key/value pair.
+  ///
+  /// Fails with `absl::StatusCode::kInvalidArgument` if `key` does not follow
+  /// the previously-added key.
+  absl::Status Add(std::string_view key, absl::Cord value);
+
+  /// Writes the remaining nodes and a new manifest version that references the
+  /// new B+tree.
+  ///
+  /// Returns the time as of which the new manifest was written.  Fails with
+  /// `absl::StatusCode::kAborted` if the database was modified concurrently.
+  Future<absl::Time> Commit();
+
+  /// Number of key/value pairs added.
+  size_t num_keys() const { return num_keys_; }
+
+ private:
+  // Pending entries of the interior node of a given height.
+  struct InteriorLevel {
+    std::vector<InteriorNodeEntryData<std::string>> entries;
+    size_t size = 0;
+  };
+
+  absl::Status EmitLeafNode(bool may_be_root);
+  absl::Status EmitInteriorNode(BtreeNodeHeight height);
+  absl::Status AddChildEntries(
+      BtreeNodeHeight height,
+      std::vector<InteriorNodeEntryData<std::string>> entries);
+  Result<BtreeGenerationReference> WriteRemainingNodes();
+
+  IoHandle::Ptr io_handle_;
+  std::shared_ptr<const Manifest> existing_manifest_;
+  const Config& config_;
+  std::string key_prefix_;
+  FlushPromise flush_promise_;
+
+  std::string last_key_;
+  size_t num_keys_ = 0;
+
+  // Pending entries of the current leaf node.
+  std::vector<std::string> leaf_keys_;
+  std::vector<LeafNodeValueReference> leaf_values_;
+  size_t leaf_size_ = 0;
+
+  // Pending entries of the current interior node of height `i + 1`.
+  std::vector<InteriorLevel> interior_levels_;
+
+  bool committed_ = false;
+};
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_BULK_LOAD_H_
@@ -0,0 +1,611 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/ocdbt/non_distributed/compact.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "absl/base/attributes.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/absl_log.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_format.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/log/verbose_flag.h"
+#include "tensorstore/kvstore/ocdbt/format/btree.h"
+#include "tensorstore/kvstore/ocdbt/format/btree_node_encoder.h"
+#include "tensorstore/kvstore/ocdbt/format/config.h"
+#include "tensorstore/kvstore/ocdbt/format/data_file_id.h"
+#include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
+#include "tensorstore/kvstore/ocdbt/format/manifest.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/io_handle.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/list_versions.h"
+#include "tensorstore/kvstore/ocdbt/non_distributed/write_nodes.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+namespace {
+
+ABSL_CONST_INIT internal_log::VerboseFlag ocdbt_logging("ocdbt");
+
+// Entries, with full keys, that reference a rewritten subtree.
+using NodeEntries = std::vector<InteriorNodeEntryData<std::string>>;
+
+struct CompactOperation
+    : public internal::AtomicReferenceCount<CompactOperation> {
+  using Ptr = internal::IntrusivePtr<CompactOperation>;
+
+  IoHandle::Ptr io_handle;
+  CompactOptions options;
+  std::shared_ptr<const Manifest> existing_manifest;
+  FlushPromise flush_promise;
+  size_t num_versions_removed = 0;
+
+  absl::Mutex mutex;
+
+  // Subtrees that have been visited, keyed by the existing node location and
+  // whether the node is a root node.  Subtrees shared by multiple versions are
+  // only visited once.
+  absl::flat_hash_map<std::pair<IndirectDataReference, bool>,
+                      Future<const NodeEntries>>
+      subtrees ABSL_GUARDED_BY(mutex);
+
+  // Out-of-line values that have been copied.
+  absl::flat_hash_map<IndirectDataReference,
+                      Future<const IndirectDataReference>>
+      values ABSL_GUARDED_BY(mutex);
+
+  absl::flat_hash_set<DataFileId> referenced_files ABSL_GUARDED_BY(mutex);
+
+  const Config& config() const { return existing_manifest->config; }
+
+  void AddReferencedFile(const DataFileId& file_id) {
+    absl::MutexLock lock(&mutex);
+    referenced_files.insert(file_id);
+  }
+
+  NodeEntries WriteNewNodes(std::vector<EncodedNode> encoded_nodes) {
+    auto entries = WriteNodes(*io_handle, flush_promise,
+                              std::move(encoded_nodes));
+    for (const auto& entry : entries) {
+      AddReferencedFile(entry.node.location.file_id);
+    }
+    return entries;
+  }
+};
+
+Future<const NodeEntries> VisitSubtree(const CompactOperation::Ptr& op,
+                                       const IndirectDataReference& location,
+                                       BtreeNodeHeight height,
+                                       std::string subtree_prefix,
+                                       std::string inclusive_min_key_suffix,
+                                       bool may_be_root);
+
+// Copies the out-of-line value at `ref` to a new data file.
+Future<const IndirectDataReference> CopyValue(
+    const CompactOperation::Ptr& op, const IndirectDataReference& ref) {
+  Promise<IndirectDataReference> promise;
+  Future<const IndirectDataReference> future;
+  {
+    absl::MutexLock lock(&op->mutex);
+    auto& existing_future = op->values[ref];
+    if (!existing_future.null()) return existing_future;
+    auto pair = PromiseFuturePair<IndirectDataReference>::Make();
+    existing_future = future = std::move(pair.future);
+    promise = std::move(pair.promise);
+  }
+  LinkValue(
+      [op](Promise<IndirectDataReference> promise,
+           ReadyFuture<kvstore::ReadResult> future) {
+        auto& read_result = future.value();
+        if (!read_result.has_value()) {
+          promise.SetResult(
+              absl::DataLossError("Out-of-line value does not exist"));
+          return;
+        }
+        IndirectDataReference new_ref;
+        op->flush_promise.Link(op->io_handle->WriteData(
+            IndirectDataKind::kValue, std::move(read_result.value), new_ref));
+        op->AddReferencedFile(new_ref.file_id);
+        promise.SetResult(std::move(new_ref));
+      },
+      std::move(promise), op->io_handle->ReadIndirectData(ref, {}));
+  return future;
+}
+
+void VisitLeafNode(CompactOperation::Ptr op, Promise<NodeEntries> promise,
+                   std::shared_ptr<const BtreeNode> node,
+                   std::string full_prefix, bool may_be_root) {
+  auto& entries = std::get<BtreeNode::LeafNodeEntries>(node->entries);
+  std::vector<Future<const IndirectDataReference>> values;
+  for (const auto& entry : entries) {
+    auto* ref = std::get_if<IndirectDataReference>(&entry.value_reference);
+    if (!ref) continue;
+    if (op->options.rewrite_data) {
+      values.push_back(CopyValue(op, *ref));
+    } else {
+      op->AddReferencedFile(ref->file_id);
+    }
+  }
+  if (!op->options.rewrite_data) return;
+
+  auto encode = [op, node = std::move(node),
+                 full_prefix = std::move(full_prefix), may_be_root,
+                 values](Promise<NodeEntries> promise) {
+    BtreeLeafNodeEncoder encoder(op->config(), /*height=*/0, full_prefix);
+    size_t value_i = 0;
+    for (const auto& entry : std::get<BtreeNode::LeafNodeEntries>(
+             node->entries)) {
+      LeafNodeEntry new_entry = entry;
+      if (std::holds_alternative<IndirectDataReference>(
+              entry.value_reference)) {
+        new_entry.value_reference = values[value_i++].value();
+      }
+      encoder.AddEntry(/*existing=*/true, std::move(new_entry));
+    }
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto encoded_nodes, encoder.Finalize(may_be_root),
+        static_cast<void>(SetDeferredResult(promise, _)));
+    promise.SetResult(op->WriteNewNodes(std::move(encoded_nodes)));
+  };
+  if (values.empty()) {
+    encode(std::move(promise));
+    return;
+  }
+  auto executor = op->io_handle->executor;
+  LinkValue(WithExecutor(std::move(executor),
+                         [encode = std::move(encode)](
+                             Promise<NodeEntries> promise,
+                             ReadyFuture<void> future) {
+                           encode(std::move(promise));
+                         }),
+            std::move(promise), WaitAllFuture(tensorstore::span(values)));
+}
+
+void VisitInteriorNode(CompactOperation::Ptr op, Promise<NodeEntries> promise,
+                       std::shared_ptr<const BtreeNode> node,
+                       std::string full_prefix, bool may_be_root) {
+  auto& entries = std::get<BtreeNode::InteriorNodeEntries>(node->entries);
+  if (entries.empty()) {
+    promise.SetResult(
+        absl::DataLossError("Empty non-root/non-leaf b-tree node found"));
+    return;
+  }
+  std::vector<Future<const NodeEntries>> children;
+  children.reserve(entries.size());
+  for (const auto& entry : entries) {
+    children.push_back(VisitSubtree(
+        op, entry.node.location, node->height - 1,
+        tensorstore::StrCat(full_prefix,
+                            entry.key.substr(
+                                0, entry.subtree_common_prefix_length)),
+        std::string(entry.key_suffix()), /*may_be_root=*/false));
+  }
+  auto all_ready = WaitAllFuture(tensorstore::span(children));
+  if (!op->options.rewrite_data) {
+    LinkError(std::move(promise), std::move(all_ready));
+    return;
+  }
+  auto executor = op->io_handle->executor;
+  LinkValue(
+      WithExecutor(
+          std::move(executor),
+          [op, height = node->height, children = std::move(children),
+           may_be_root](Promise<NodeEntries> promise,
+                        ReadyFuture<void> future) {
+            BtreeInteriorNodeEncoder encoder(op->config(), height,
+                                             /*existing_prefix=*/{});
+            for (const auto& child : children) {
+              for (const auto& entry : child.value()) {
+                AddNewInteriorEntry(encoder, entry);
+              }
+            }
+            TENSORSTORE_ASSIGN_OR_RETURN(
+                auto encoded_nodes, encoder.Finalize(may_be_root),
+                static_cast<void>(SetDeferredResult(promise, _)));
+            promise.SetResult(op->WriteNewNodes(std::move(encoded_nodes)));
+          }),
+      std::move(promise), std::move(all_ready));
+}
+
+// Rewrites the subtree rooted at `location` or, if `rewrite_data` is `false`,
+// just records the data files that it references.
+//
+// Returns the entries that reference the rewritten subtree, which are empty if
+// `rewrite_data` is `false`.
+Future<const NodeEntries> VisitSubtree(const CompactOperation::Ptr& op,
+                                       const IndirectDataReference& location,
+                                       BtreeNodeHeight height,
+                                       std::string subtree_prefix,
+                                       std::string inclusive_min_key_suffix,
+                                       bool may_be_root) {
+  Promise<NodeEntries> promise;
+  Future<const NodeEntries> future;
+  {
+    absl::MutexLock lock(&op->mutex);
+    auto& existing_future = op->subtrees[std::pair(location, may_be_root)];
+    if (!existing_future.null()) return existing_future;
+    auto pair = PromiseFuturePair<NodeEntries>::Make(std::in_place);
+    existing_future = future = std::move(pair.future);
+    promise = std::move(pair.promise);
+  }
+  if (!op->options.rewrite_data) {
+    op->AddReferencedFile(location.file_id);
+  }
+  auto executor = op->io_handle->executor;
+  LinkValue(
+      WithExecutor(
+          std::move(executor),
+          [op, height, subtree_prefix = std::move(subtree_prefix),
+           inclusive_min_key_suffix = std::move(inclusive_min_key_suffix),
+           may_be_root](
+              Promise<NodeEntries> promise,
+              ReadyFuture<const std::shared_ptr<const BtreeNode>> future) {
+            const auto& node = future.value();
+            TENSORSTORE_RETURN_IF_ERROR(
+                ValidateBtreeNodeReference(*node, height,
+                                           inclusive_min_key_suffix),
+                static_cast<void>(SetDeferredResult(promise, _)));
+            auto full_prefix = tensorstore::StrCat(subtree_prefix,
+                                                   node->key_prefix);
+            if (height == 0) {
+              VisitLeafNode(op, std::move(promise), node,
+                            std::move(full_prefix), may_be_root);
+            } else {
+              VisitInteriorNode(op, std::move(promise), node,
+                                std::move(full_prefix), may_be_root);
+            }
+          }),
+      std::move(promise), op->io_handle->GetBtreeNode(location));
+  return future;
+}
+
+// Writes the root node of a rewritten B+tree, adding levels as needed.
+Result<BtreeGenerationReference> WriteNewRoot(
+    CompactOperation& op, const BtreeGenerationReference& version,
+    NodeEntries entries) {
+  BtreeNodeHeight height = version.root_height;
+  while (entries.size() > 1) {
+    if (height == std::numeric_limits<BtreeNodeHeight>::max()) {
+      return absl::DataLossError("Maximum B+tree height exceeded");
+    }
+    ++height;
+    BtreeInteriorNodeEncoder encoder(op.config(), height,
+                                     /*existing_prefix=*/{});
+    for (const auto& entry : entries) {
+      AddNewInteriorEntry(encoder, entry);
+    }
+    TENSORSTORE_ASSIGN_OR_RETURN(auto encoded_nodes,
+                                 encoder.Finalize(/*may_be_root=*/true));
+    entries = op.WriteNewNodes(std::move(encoded_nodes));
+  }
+  BtreeGenerationReference new_version = version;
+  if (entries.empty()) {
+    new_version.root_height = 0;
+    new_version.root.statistics = {};
+    new_version.root.location = IndirectDataReference::Missing();
+  } else {
+    new_version.root_height = height;
+    new_version.root = entries[0].node;
+  }
+  return new_version;
+}
+
+Future<BtreeGenerationReference> VisitVersion(
+    const CompactOperation::Ptr& op, const BtreeGenerationReference& version) {
+  if (version.root.location.IsMissing()) {
+    return MakeReadyFuture<BtreeGenerationReference>(version);
+  }
+  return MapFutureValue(
+      InlineExecutor{},
+      [op, version](
+          const NodeEntries& entries) -> Result<BtreeGenerationReference> {
+        if (!op->options.rewrite_data) return version;
+        return WriteNewRoot(*op, version, entries);
+      },
+      VisitSubtree(op, version.root.location, version.root_height,
+                   /*subtree_prefix=*/{}, /*inclusive_min_key_suffix=*/{},
+                   /*may_be_root=*/true));
+}
+
+// Writes a version tree node of the specified `height` that references
+// `versions`.
+Result<VersionNodeReference> WriteVersionTreeNode(
+    CompactOperation& op, VersionTreeHeight height,
+    span<const BtreeGenerationReference> versions) {
+  const auto& config = op.config();
+  VersionTreeNode node;
+  node.height = height;
+  node.version_tree_arity_log2 = config.version_tree_arity_log2;
+  if (height == 0) {
+    node.entries.emplace<VersionTreeNode::LeafNodeEntries>(versions.begin(),
+                                                           versions.end());
+  } else {
+    auto& children =
+        node.entries.emplace<VersionTreeNode::InteriorNodeEntries>();
+    const GenerationNumber stride = static_cast<GenerationNumber>(1)
+                                    << (config.version_tree_arity_log2 *
+                                        height);
+    for (size_t i = 0; i < versions.size();) {
+      const GenerationNumber child_i =
+          (versions[i].generation_number - 1) / stride;
+      size_t end = i + 1;
+      while (end < versions.size() &&
+             (versions[end].generation_number - 1) / stride == child_i) {
+        ++end;
+      }
+      TENSORSTORE_ASSIGN_OR_RETURN(
+          auto child_ref,
+          WriteVersionTreeNode(op, height - 1, versions.subspan(i, end - i)));
+      // Only the last generation of the subtree may be referenced from its
+      // parent, which holds as long as the retained versions are contiguous.
+      if (child_ref.generation_number % stride != 0) {
+        return absl::FailedPreconditionError(absl::StrFormat(
+            "Cannot compact version tree without generation %d",
+            (child_i + 1) * stride));
+      }
+      children.push_back(std::move(child_ref));
+      i = end;
+    }
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(auto encoded,
+                               EncodeVersionTreeNode(config, node));
+  VersionNodeReference ref;
+  ref.height = height;
+  ref.generation_number = versions.back().generation_number;
+  ref.num_generations = versions.size();
+  ref.commit_time = versions.front().commit_time;
+  op.flush_promise.Link(op.io_handle->WriteData(
+      IndirectDataKind::kVersionNode, std::move(encoded), ref.location));
+  op.AddReferencedFile(ref.location.file_id);
+  return ref;
+}
+
+// Creates a new manifest referencing `versions`, writing a new version tree.
+Result<std::shared_ptr<Manifest>> CreateCompactedManifest(
+    CompactOperation& op, span<const BtreeGenerationReference> versions) {
+  auto manifest = std::make_shared<Manifest>();
+  manifest->config = op.config();
+  const auto arity_log2 = manifest->config.version_tree_arity_log2;
+  const GenerationNumber latest_generation =
+      versions.back().generation_number;
+  auto lower_bound = [&](GenerationNumber generation_number) {
+    return std::lower_bound(
+        versions.begin(), versions.end(), generation_number,
+        [](const BtreeGenerationReference& version, GenerationNumber g) {
+          return version.generation_number < g;
+        });
+  };
+
+  auto inline_begin =
+      lower_bound(GetVersionTreeLeafNodeRangeContainingGeneration(
+                      arity_log2, latest_generation)
+                      .first);
+  manifest->versions.assign(inline_begin, versions.end());
+
+  absl::Status status;
+  ForEachManifestVersionTreeNodeRef(
+      latest_generation, arity_log2,
+      [&](GenerationNumber min_generation_number,
+          GenerationNumber max_generation_number, VersionTreeHeight height) {
+        if (!status.ok()) return;
+        auto begin = lower_bound(min_generation_number);
+        auto end = lower_bound(max_generation_number + 1);
+        if (begin == end) return;
+        auto ref = WriteVersionTreeNode(
+            op, height,
+            versions.subspan(begin - versions.begin(), end - begin));
+        if (!ref.ok()) {
+          status = ref.status();
+          return;
+        }
+        manifest->version_tree_nodes.push_back(*std::move(ref));
+      });
+  TENSORSTORE_RETURN_IF_ERROR(status);
+  // `ForEachManifestVersionTreeNodeRef` proceeds in order of increasing
+  // height, but the manifest references nodes in order of decreasing height.
+  std::reverse(manifest->version_tree_nodes.begin(),
+               manifest->version_tree_nodes.end());
+  return manifest;
+}
+
+Future<CompactResult> WriteCompactedManifest(
+    CompactOperation::Ptr op, std::shared_ptr<const Manifest> new_manifest) {
+  return MapFutureValue(
+      InlineExecutor{},
+      [op, new_manifest](
+          const TryUpdateManifestResult& result) -> Result<CompactResult> {
+        if (!result.success) {
+          return absl::AbortedError(
+              "Database was modified concurrently with compaction");
+        }
+        ABSL_LOG_IF(INFO, ocdbt_logging)
+            << "Compact: wrote generation "
+            << new_manifest->latest_generation();
+        CompactResult compact_result;
+        compact_result.generation_number = new_manifest->latest_generation();
+        compact_result.time = result.time;
+        compact_result.num_versions_removed = op->num_versions_removed;
+        absl::MutexLock lock(&op->mutex);
+        compact_result.referenced_files = std::move(op->referenced_files);
+        return compact_result;
+      },
+      op->io_handle->TryUpdateManifest(op->existing_manifest, new_manifest,
+                                       absl::Now()));
+}
+
+// Writes the new version tree and manifest once all retained versions have
+// been visited.
+void VersionsVisited(CompactOperation::Ptr op, Promise<CompactResult> promise,
+                     std::vector<BtreeGenerationReference> versions) {
+  // Add a new generation, identical to the latest one, such that readers
+  // observe the compacted manifest as a new version.
+  const auto& latest_version = op->existing_manifest->latest_version();
+  BtreeGenerationReference new_generation = versions.back();
+  new_generation.generation_number = latest_version.generation_number + 1;
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      new_generation.commit_time,
+      CommitTime::FromAbslTime(std::max(
+          absl::Now(), static_cast<absl::Time>(latest_version.commit_time) +
+                           absl::Nanoseconds(1))),
+      static_cast<void>(promise.SetResult(
+          internal::ConvertInvalidArgumentToFailedPrecondition(_))));
+  versions.push_back(new_generation);
+
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto new_manifest, CreateCompactedManifest(*op, versions),
+      static_cast<void>(promise.SetResult(_)));
+
+  auto flush_future = std::move(op->flush_promise).future();
+  if (flush_future.null()) {
+    LinkResult(std::move(promise),
+               WriteCompactedManifest(std::move(op), std::move(new_manifest)));
+    return;
+  }
+  // All new data must be durable before the manifest that references it is
+  // written.
+  flush_future.Force();
+  LinkValue(
+      [op = std::move(op), new_manifest = std::move(new_manifest)](
+          Promise<CompactResult> promise, ReadyFuture<const void> future) {
+        LinkResult(std::move(promise),
+                   WriteCompactedManifest(op, new_manifest));
+      },
+      std::move(promise), std::move(flush_future));
+}
+
+void VersionsListed(CompactOperation::Ptr op, Promise<CompactResult> promise,
+                    std::vector<BtreeGenerationReference> versions) {
+  std::sort(versions.begin(), versions.end(),
+            [](const BtreeGenerationReference& a,
+               const BtreeGenerationReference& b) {
+              return a.generation_number < b.generation_number;
+            });
+  const GenerationNumber latest_generation =
+      op->existing_manifest->latest_generation();
+  if (versions.empty() ||
+      versions.back().generation_number != latest_generation) {
+    promise.SetResult(absl::AbortedError(
+        "Database was modified concurrently with compaction"));
+    return;
+  }
+
+  // Since commit times increase with the generation number, the retained
+  // versions are always a suffix of `versions`.
+  const auto& options = op->options;
+  const GenerationNumber min_generation_number =
+      latest_generation > options.keep_last_versions
+          ? latest_generation - options.keep_last_versions + 1
+          : 1;
+  auto retained_begin = std::find_if(
+      versions.begin(), versions.end(),
+      [&](const BtreeGenerationReference& version) {
+        return version.generation_number >= min_generation_number ||
+               static_cast<absl::Time>(version.commit_time) >=
+                   options.keep_newer_than;
+      });
+  op->num_versions_removed = retained_begin - versions.begin();
+  versions.erase(versions.begin(), retained_begin);
+  ABSL_LOG_IF(INFO, ocdbt_logging)
+      << "Compact: retaining " << versions.size() << " versions, removing "
+      << op->num_versions_removed;
+
+  std::vector<Future<BtreeGenerationReference>> futures;
+  futures.reserve(versions.size());
+  for (const auto& version : versions) {
+    futures.push_back(VisitVersion(op, version));
+  }
+  auto all_ready = WaitAllFuture(tensorstore::span(futures));
+  auto executor = op->io_handle->executor;
+  LinkValue(WithExecutor(std::move(executor),
+                         [op = std::move(op), futures = std::move(futures)](
+                             Promise<CompactResult> promise,
+                             ReadyFuture<void> future) mutable {
+                           std::vector<BtreeGenerationReference> versions;
+                           versions.reserve(futures.size());
+                           for (auto& version_future : futures) {
+                             versions.push_back(version_future.value());
+                           }
+                           VersionsVisited(std::move(op), std::move(promise),
+                                           std::move(versions));
+                         }),
+            std::move(promise), std::move(all_ready));
+}
+
+}  // namespace
+
+Future<CompactResult> Compact(IoHandle::Ptr io_handle,
+                              const CompactOptions& options) {
+  if (options.keep_last_versions == 0) {
+    return absl::InvalidArgumentError(
+        "keep_last_versions must be at least 1");
+  }
+  auto op = internal::MakeIntrusivePtr<CompactOperation>();
+  op->io_handle = std::move(io_handle);
+  op->options = options;
+  auto manifest_future = op->io_handle->GetManifest(absl::Now());
+  return PromiseFuturePair<CompactResult>::LinkValue(
+             [op = std::move(op)](
+                 Promise<CompactResult> promise,
+                 ReadyFuture<const ManifestWithTime> future) mutable {
+               const auto& manifest_with_time = future.value();
+               if (!manifest_with_time.manifest) {
+                 promise.SetResult(
+                     absl::FailedPreconditionError("Database does not exist"));
+                 return;
+               }
+               op->existing_manifest = manifest_with_time.manifest;
+               ListVersionsOptions list_options;
+               list_options.max_generation_number =
+                   op->existing_manifest->latest_generation();
+               list_options.staleness_bound = manifest_with_time.time;
+               auto list_future =
+                   ListVersionsFuture(op->io_handle, list_options);
+               LinkValue(
+                   [op = std::move(op)](
+                       Promise<CompactResult> promise,
+                       ReadyFuture<std::vector<BtreeGenerationReference>>
+                           future) mutable {
+                     VersionsListed(std::move(op), std::move(promise),
+                                    std::move(future.value()));
+                   },
+                   std::move(promise), std::move(list_future));
+             },
+             std::move(manifest_future))
+      .future;
+}
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
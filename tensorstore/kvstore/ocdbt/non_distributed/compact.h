@@ -0,0 +1,96 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_COMPACT_H_
+#define TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_COMPACT_H_
+
+// This module implements compaction of a database.
+//
+// OCDBT never modifies data files in place: every commit writes new B+tree
+// nodes, version tree nodes, and out-of-line values, and all versions remain
+// referenced from the version tree.  Compaction reclaims this space:
+//
+// 1. Versions that are not retained by `CompactOptions` are removed.  Since
+//    the retention policy always retains a suffix of the version history, the
+//    version tree is simply rebuilt from the retained versions, which preserves
+//    their generation numbers.
+//
+// 2. If `CompactOptions::rewrite_data` is `true`, all B+tree nodes and
+//    out-of-line values reachable from the retained versions are copied into
+//    new data files.  Nodes and values shared by multiple versions are copied
+//    only once, such that the retained versions continue to share them.
+//
+// 3. A new manifest, with a new generation that is identical to the latest
+//    retained generation, is written atomically.  If the database was
+//    modified concurrently, compaction fails with `absl::StatusCode::kAborted`
+//    and has no effect, aside from leaving unreferenced data files.
+//
+// The set of data files referenced by the new manifest is returned, so that
+// the caller may delete the remaining data files.
+
+#include <stddef.h>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/time/time.h"
+#include "tensorstore/kvstore/ocdbt/format/data_file_id.h"
+#include "tensorstore/kvstore/ocdbt/format/version_tree.h"
+#include "tensorstore/kvstore/ocdbt/io_handle.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace internal_ocdbt {
+
+struct CompactOptions {
+  /// Number of most recent versions to retain.  Must be at least 1.
+  GenerationNumber keep_last_versions = 1;
+
+  /// Versions committed at or after this time are retained as well.
+  absl::Time keep_newer_than = absl::InfiniteFuture();
+
+  /// Copy all data reachable from the retained versions into new data files,
+  /// such that no existing data file remains referenced.  Otherwise, only
+  /// the version tree is rewritten.
+  bool rewrite_data = true;
+};
+
+struct CompactResult {
+  /// Generation number of the version written by compaction.
+  GenerationNumber generation_number;
+
+  /// Time as of which the new manifest was written.
+  absl::Time time;
+
+  /// Number of versions removed.
+  size_t num_versions_removed = 0;
+
+  /// Data files referenced by the new manifest.
+  absl::flat_hash_set<DataFileId> referenced_files;
+
+  /// Number of unreferenced data files deleted.  Only set by
+  /// `CompactDatabase`.
+  size_t num_files_deleted = 0;
+};
+
+/// Compacts the database accessed by `io_handle`.
+///
+/// Fails with `absl::StatusCode::kFailedPrecondition` if the database does not
+/// exist, and with `absl::StatusCode::kAborted` if it was modified
+/// concurrently.
+Future<CompactResult> Compact(IoHandle::Ptr io_handle,
+                              const CompactOptions& options);
+
+}  // namespace internal_ocdbt
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_COMPACT_H_
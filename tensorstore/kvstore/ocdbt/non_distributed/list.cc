@@ -25,9 +25,11 @@
 #include <vector>
 
 #include "absl/base/attributes.h"
+#include "absl/base/thread_annotations.h"
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_format.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/log/verbose_flag.h"
@@ -65,12 +67,15 @@ using ::tensorstore::kvstore::ListReceiver;
 // 1. Resolve the root b+tree node by reading the manifest.
 //
 // 2. Recursively descend the tree in parallel, reading all nodes that
-//    intersect the key range specified in `list_options`.
+//    intersect the key range specified in `list_options`.  At most
+//    `max_concurrent_node_reads` node reads are outstanding at once.
+//    Subtrees that remain to be read are kept on a stack and read in
+//    depth-first order, which bounds the number of pending subtrees by the
+//    height of the tree times the maximum number of children per node.  Reads
+//    of the following sibling subtrees are issued before the results of a leaf
+//    node are emitted.
 //
 // 3. Emit matching leaf-node keys to the receiver.
-//
-// TODO(jbms): Currently memory usage is not bounded.  That needs to be
-// addressed, e.g. by limiting the number of in-flight nodes.
 struct ListOperation
     : public internal::FlowSenderOperationState<std::string_view,
                                                 span<const LeafNodeEntry>> {
@@ -82,6 +87,23 @@ struct ListOperation
 
   ReadonlyIoHandle::Ptr io_handle;
   KeyRange range;
+  size_t max_concurrent_node_reads;
+
+  // Subtree that remains to be read.
+  struct PendingSubtree {
+    BtreeNodeReference node_ref;
+    BtreeNodeHeight node_height;
+    std::string inclusive_min_key;
+    KeyLength subtree_common_prefix_length;
+  };
+
+  absl::Mutex mutex;
+
+  // Number of node reads that have been issued but not yet processed.
+  size_t num_in_flight ABSL_GUARDED_BY(mutex) = 0;
+
+  // Subtrees that remain to be read.  The next subtree to read is at the back.
+  std::vector<PendingSubtree> pending ABSL_GUARDED_BY(mutex);
 
   // Prepares the asynchronous list operation.
   //
@@ -89,11 +111,15 @@ struct ListOperation
   //   io_handle: I/O handle to use.
   //   range: Key range constraint.
   //   receiver: Receiver of the results.
+  //   max_concurrent_node_reads: Maximum number of outstanding node reads.
   static Ptr Initialize(ReadonlyIoHandle::Ptr&& io_handle, KeyRange&& range,
-                        BaseReceiver&& receiver) {
+                        BaseReceiver&& receiver,
+                        size_t max_concurrent_node_reads) {
     auto op = internal::MakeIntrusivePtr<ListOperation>(std::move(receiver));
     op->io_handle = std::move(io_handle);
     op->range = std::move(range);
+    op->max_concurrent_node_reads =
+        std::max(size_t(1), max_concurrent_node_reads);
     return op;
   }
 
@@ -123,18 +149,54 @@ struct ListOperation
                            BtreeNodeHeight node_height,
                            std::string inclusive_min_key,
                            KeyLength subtree_common_prefix_length) {
+    {
+      absl::MutexLock lock(&op->mutex);
+      op->pending.push_back(PendingSubtree{node_ref, node_height,
+                                           std::move(inclusive_min_key),
+                                           subtree_common_prefix_length});
+    }
+    StartReads(std::move(op), /*num_completed=*/0);
+  }
+
+  // Marks `num_completed` node reads as processed, and issues reads of pending
+  // subtrees up to the concurrency limit.
+  static void StartReads(ListOperation::Ptr op, size_t num_completed) {
+    std::vector<PendingSubtree> subtrees;
+    {
+      absl::MutexLock lock(&op->mutex);
+      op->num_in_flight -= num_completed;
+      if (op->cancelled()) {
+        op->pending.clear();
+        return;
+      }
+      while (op->num_in_flight < op->max_concurrent_node_reads &&
+             !op->pending.empty()) {
+        subtrees.push_back(std::move(op->pending.back()));
+        op->pending.pop_back();
+        ++op->num_in_flight;
+      }
+    }
+    for (auto& subtree : subtrees) {
+      ReadSubtree(op, std::move(subtree));
+    }
+  }
+
+  // Issues the read of the root node of a subtree.
+  static void ReadSubtree(ListOperation::Ptr op, PendingSubtree&& subtree) {
     ABSL_LOG_IF(INFO, ocdbt_logging)
-        << "List: node=" << node_ref
-        << ", node_height=" << static_cast<int>(node_height)
-        << ", subtree_common_prefix_length=" << subtree_common_prefix_length
-        << ", inclusive_min_key=" << tensorstore::QuoteString(inclusive_min_key)
+        << "List: node=" << subtree.node_ref
+        << ", node_height=" << static_cast<int>(subtree.node_height)
+        << ", subtree_common_prefix_length="
+        << subtree.subtree_common_prefix_length << ", inclusive_min_key="
+        << tensorstore::QuoteString(subtree.inclusive_min_key)
         << ", key_range=" << op->range;
     auto* op_ptr = op.get();
     Link(WithExecutor(op_ptr->io_handle->executor,
-                      NodeReadyCallback{std::move(op), node_height,
-                                        std::move(inclusive_min_key),
-                                        subtree_common_prefix_length}),
-         op_ptr->promise, op_ptr->io_handle->GetBtreeNode(node_ref.location));
+                      NodeReadyCallback{std::move(op), subtree.node_height,
+                                        std::move(subtree.inclusive_min_key),
+                                        subtree.subtree_common_prefix_length}),
+         op_ptr->promise,
+         op_ptr->io_handle->GetBtreeNode(subtree.node_ref.location));
   }
 
   // Called when a B+tree node lookup completes.
@@ -169,15 +231,18 @@ struct ListOperation
       auto key_range = KeyRange::RemovePrefix(subtree_key_prefix, op->range);
 
       if (node->height > 0) {
-        VisitInteriorNode(std::move(op), *node, subtree_key_prefix, key_range);
+        VisitInteriorNode(*op, *node, subtree_key_prefix, key_range);
+        StartReads(std::move(op), /*num_completed=*/1);
       } else {
-        VisitLeafNode(std::move(op), *node, subtree_key_prefix, key_range);
+        // Issue reads of subsequent subtrees before emitting the results.
+        StartReads(op, /*num_completed=*/1);
+        VisitLeafNode(*op, *node, subtree_key_prefix, key_range);
       }
     }
   };
 
-  // Recursively visits matching children.
-  static void VisitInteriorNode(ListOperation::Ptr op, const BtreeNode& node,
+  // Adds the matching children to the pending subtrees.
+  static void VisitInteriorNode(ListOperation& op, const BtreeNode& node,
                                 std::string_view subtree_key_prefix,
                                 const KeyRange& key_range) {
     auto& all_entries = std::get<BtreeNode::InteriorNodeEntries>(node.entries);
@@ -193,17 +258,22 @@ struct ListOperation
         << ", num matches=" << entries.size();
     // Note: It is safe to access `all_entries.front()` and `all_entries.back()`
     // because B+tree nodes are guaranteed to have at least one entry.
-    for (const auto& entry : entries) {
-      VisitSubtree(op, entry.node, node.height - 1,
-                   /*inclusive_min_key=*/
-                   tensorstore::StrCat(subtree_key_prefix, entry.key),
-                   /*subtree_common_prefix_length=*/subtree_key_prefix.size() +
-                       entry.subtree_common_prefix_length);
+    absl::MutexLock lock(&op.mutex);
+    // Push in reverse order such that the first child is read first.
+    for (size_t i = entries.size(); i-- > 0;) {
+      const auto& entry = entries[i];
+      op.pending.push_back(PendingSubtree{
+          entry.node, static_cast<BtreeNodeHeight>(node.height - 1),
+          /*inclusive_min_key=*/
+          tensorstore::StrCat(subtree_key_prefix, entry.key),
+          /*subtree_common_prefix_length=*/
+          static_cast<KeyLength>(subtree_key_prefix.size() +
+                                 entry.subtree_common_prefix_length)});
     }
   }
 
   // Emits matches in the leaf node.
-  static void VisitLeafNode(ListOperation::Ptr op, const BtreeNode& node,
+  static void VisitLeafNode(ListOperation& op, const BtreeNode& node,
                             std::string_view subtree_key_prefix,
                             const KeyRange& key_range) {
     auto& all_entries = std::get<BtreeNode::LeafNodeEntries>(node.entries);
@@ -220,7 +290,7 @@ struct ListOperation
     // Note: It is safe to access `all_entries.front()` and `all_entries.back()`
     // because B+tree nodes are guaranteed to have at least one entry.
     if (entries.empty()) return;
-    execution::set_value(op->shared_receiver->receiver, subtree_key_prefix,
+    execution::set_value(op.shared_receiver->receiver, subtree_key_prefix,
                          entries);
   }
 };
@@ -267,10 +337,12 @@ struct KeyReceiverAdapter {
 
 void NonDistributedList(ReadonlyIoHandle::Ptr io_handle,
                         std::optional<VersionSpec> version_spec,
-                        kvstore::ListOptions options, ListReceiver&& receiver) {
+                        kvstore::ListOptions options, ListReceiver&& receiver,
+                        size_t max_concurrent_node_reads) {
   auto op = ListOperation::Initialize(
       std::move(io_handle), std::move(options.range),
-      KeyReceiverAdapter{std::move(receiver), options.strip_prefix_length});
+      KeyReceiverAdapter{std::move(receiver), options.strip_prefix_length},
+      max_concurrent_node_reads);
   auto* op_ptr = op.get();
   LinkValue(
       WithExecutor(op_ptr->io_handle->executor,
@@ -306,9 +378,12 @@ void NonDistributedListSubtree(
     BtreeNodeHeight node_height, std::string subtree_key_prefix,
     KeyRange&& key_range,
     AnyFlowReceiver<absl::Status, std::string_view, span<const LeafNodeEntry>>&&
-        receiver) {
-  auto op = ListOperation::Initialize(
-      std::move(io_handle), std::move(key_range), std::move(receiver));
+        receiver,
+    size_t max_concurrent_node_reads) {
+  auto op = ListOperation::Initialize(std::move(io_handle),
+                                      std::move(key_range),
+                                      std::move(receiver),
+                                      max_concurrent_node_reads);
   const size_t subtree_common_prefix_length = subtree_key_prefix.size();
   ListOperation::VisitSubtree(std::move(op), node_ref, node_height,
                               std::move(subtree_key_prefix),
@@ -15,6 +15,9 @@
 #ifndef TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_LIST_H_
 #define TENSORSTORE_KVSTORE_OCDBT_NON_DISTRIBUTED_LIST_H_
 
+#include <stddef.h>
+
+#include <optional>
 #include <string>
 #include <string_view>
 
@@ -30,17 +33,28 @@
 namespace tensorstore {
 namespace internal_ocdbt {
 
-void NonDistributedList(ReadonlyIoHandle::Ptr io_handle,
-                        std::optional<VersionSpec> version_spec,
-                        kvstore::ListOptions options,
-                        kvstore::ListReceiver&& receiver);
+/// Default maximum number of B+tree nodes read concurrently by a single list
+/// operation.
+constexpr size_t kDefaultListConcurrency = 64;
+
+/// Lists the keys in `options.range`.
+///
+/// \param max_concurrent_node_reads Maximum number of B+tree node reads that
+///     may be outstanding at once.  Nodes are visited in depth-first order,
+///     such that reads of the following sibling subtrees are issued while the
+///     results of earlier subtrees are emitted.
+void NonDistributedList(
+    ReadonlyIoHandle::Ptr io_handle, std::optional<VersionSpec> version_spec,
+    kvstore::ListOptions options, kvstore::ListReceiver&& receiver,
+    size_t max_concurrent_node_reads = kDefaultListConcurrency);
 
 void NonDistributedListSubtree(
     ReadonlyIoHandle::Ptr io_handle, const BtreeNodeReference& node_ref,
     BtreeNodeHeight node_height, std::string subtree_key_prefix,
     KeyRange&& key_range,
     AnyFlowReceiver<absl::Status, std::string_view, span<const LeafNodeEntry>>&&
-        receiver);
+        receiver,
+    size_t max_concurrent_node_reads = kDefaultListConcurrency);
 
 }  // namespace internal_ocdbt
 }  // namespace tensorstore
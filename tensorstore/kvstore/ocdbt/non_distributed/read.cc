@@ -37,6 +37,7 @@
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/ocdbt/format/btree.h"
 #include "tensorstore/kvstore/ocdbt/format/indirect_data_reference.h"
+#include "tensorstore/kvstore/ocdbt/format/key_filter.h"
 #include "tensorstore/kvstore/ocdbt/format/version_tree.h"
 #include "tensorstore/kvstore/ocdbt/io_handle.h"
 #include "tensorstore/kvstore/ocdbt/non_distributed/read_version.h"
@@ -244,6 +245,16 @@ struct ReadOperation : public internal::AtomicReferenceCount<ReadOperation> {
       op->KeyNotPresent(promise);
       return;
     }
+    if (!KeyFilterMayContain(entry->key_filter,
+                             unmatched_key_suffix.substr(
+                                 entry->subtree_common_prefix_length))) {
+      // The filter over the keys of the child leaf node excludes the key.
+      ABSL_LOG_IF(INFO, ocdbt_logging)
+          << "Read: key=" << tensorstore::QuoteString(op->key)
+          << " excluded by key filter";
+      op->KeyNotPresent(promise);
+      return;
+    }
     ABSL_LOG_IF(INFO, ocdbt_logging)
         << "Read: key=" << tensorstore::QuoteString(op->key)
         << ", matched_length=" << op->matched_length
@@ -47,6 +47,7 @@ std::vector<InteriorNodeEntryData<std::string>> WriteNodes(
     new_entry.node.statistics = encoded_node.info.statistics;
     new_entry.subtree_common_prefix_length =
         encoded_node.info.excluded_prefix_length;
+    new_entry.key_filter = std::move(encoded_node.info.key_filter);
   }
 
   return new_entries;
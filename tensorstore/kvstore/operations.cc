@@ -19,11 +19,14 @@
 #include <cassert>
 #include <optional>
 #include <ostream>
+#include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
 #include "absl/time/clock.h"
+#include "tensorstore/internal/tracing/operation_trace_span.h"
+#include "tensorstore/internal/tracing/trace_context.h"
 #include "tensorstore/kvstore/driver.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/key_range.h"
@@ -79,9 +82,22 @@ Future<std::vector<ListEntry>> ListFuture(const KvStore& store,
           kvstore::List(store, std::move(options))));
 }
 
-Future<ReadResult> Read(const KvStore& store, std::string_view key,
-                        ReadOptions options) {
-  auto full_key = tensorstore::StrCat(store.path, key);
+namespace {
+
+/// Ends `span` once `future` becomes ready.
+template <typename T>
+Future<T> EndTraceSpanWhenReady(internal_tracing::OperationTraceSpan span,
+                                Future<T> future) {
+  if (!span.recording()) return future;
+  future.ExecuteWhenReady(
+      [span = std::move(span)](ReadyFuture<T> future) mutable {
+        if (!future.result().ok()) span.SetStatus(future.result().status());
+      });
+  return future;
+}
+
+Future<ReadResult> ReadImpl(const KvStore& store, std::string full_key,
+                            ReadOptions options) {
   if (store.transaction == no_transaction) {
     // Regular non-transactional read.
     return store.driver->Read(std::move(full_key), std::move(options));
@@ -93,11 +109,10 @@ Future<ReadResult> Read(const KvStore& store, std::string_view key,
                                          std::move(options));
 }
 
-Future<TimestampedStorageGeneration> Write(const KvStore& store,
-                                           std::string_view key,
-                                           std::optional<Value> value,
-                                           WriteOptions options) {
-  auto full_key = tensorstore::StrCat(store.path, key);
+Future<TimestampedStorageGeneration> WriteImpl(const KvStore& store,
+                                               std::string full_key,
+                                               std::optional<Value> value,
+                                               WriteOptions options) {
   if (store.transaction == no_transaction) {
     // Regular non-transactional write.
     return store.driver->Write(std::move(full_key), std::move(value),
@@ -127,6 +142,32 @@ Future<TimestampedStorageGeneration> Write(const KvStore& store,
   return stamp;
 }
 
+}  // namespace
+
+Future<ReadResult> Read(const KvStore& store, std::string_view key,
+                        ReadOptions options) {
+  auto full_key = tensorstore::StrCat(store.path, key);
+  internal_tracing::OperationTraceSpan span(
+      "kvstore::Read", {{"key", std::string_view(full_key)}});
+  internal_tracing::ScopedTraceContext trace_scope(span.context());
+  return EndTraceSpanWhenReady(
+      std::move(span),
+      ReadImpl(store, std::move(full_key), std::move(options)));
+}
+
+Future<TimestampedStorageGeneration> Write(const KvStore& store,
+                                           std::string_view key,
+                                           std::optional<Value> value,
+                                           WriteOptions options) {
+  auto full_key = tensorstore::StrCat(store.path, key);
+  internal_tracing::OperationTraceSpan span(
+      "kvstore::Write", {{"key", std::string_view(full_key)}});
+  internal_tracing::ScopedTraceContext trace_scope(span.context());
+  return EndTraceSpanWhenReady(
+      std::move(span), WriteImpl(store, std::move(full_key), std::move(value),
+                                 std::move(options)));
+}
+
 Future<TimestampedStorageGeneration> WriteCommitted(const KvStore& store,
                                                     std::string_view key,
                                                     std::optional<Value> value,
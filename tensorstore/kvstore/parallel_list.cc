@@ -0,0 +1,294 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/parallel_list.h"
+
+#include <stddef.h>
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/util/execution/any_receiver.h"
+#include "tensorstore/util/execution/execution.h"
+
+namespace tensorstore {
+namespace internal_kvstore {
+namespace {
+
+using ::tensorstore::kvstore::ListEntry;
+using ::tensorstore::kvstore::ListOptions;
+using ::tensorstore::kvstore::ListReceiver;
+
+// State shared by the concurrent listings of a `ParallelList` call.  The
+// receiver is completed once the last listing releases the state.
+struct ParallelListState final
+    : public internal::AtomicReferenceCount<ParallelListState> {
+  ParallelListOptions parallel_options_;
+  ListOptions options_;
+  ListDelimitedFunction list_delimited_;
+  ListRangeFunction list_range_;
+
+  // Serializes calls to `receiver_` from the concurrent listings.
+  absl::Mutex receiver_mutex_;
+  ListReceiver receiver_ ABSL_GUARDED_BY(receiver_mutex_);
+
+  absl::Mutex mutex_;
+  absl::flat_hash_map<size_t, AnyCancelReceiver> cancel_
+      ABSL_GUARDED_BY(mutex_);
+  size_t next_listing_id_ ABSL_GUARDED_BY(mutex_) = 0;
+  bool cancelled_ ABSL_GUARDED_BY(mutex_) = false;
+  absl::Status status_ ABSL_GUARDED_BY(mutex_);
+
+  ParallelListState(const ParallelListOptions& parallel_options,
+                    ListOptions options, ListReceiver receiver,
+                    ListDelimitedFunction list_delimited,
+                    ListRangeFunction list_range)
+      : parallel_options_(parallel_options),
+        options_(std::move(options)),
+        list_delimited_(std::move(list_delimited)),
+        list_range_(std::move(list_range)),
+        receiver_(std::move(receiver)) {
+    absl::MutexLock lock(&receiver_mutex_);
+    execution::set_starting(receiver_, [this] { DoCancel(); });
+  }
+
+  ~ParallelListState() {
+    absl::Status status;
+    {
+      absl::MutexLock lock(&mutex_);
+      status = std::move(status_);
+    }
+    absl::MutexLock lock(&receiver_mutex_);
+    if (status.ok()) {
+      execution::set_done(receiver_);
+    } else {
+      execution::set_error(receiver_, std::move(status));
+    }
+    execution::set_stopping(receiver_);
+  }
+
+  size_t NewListingId() {
+    absl::MutexLock lock(&mutex_);
+    return next_listing_id_++;
+  }
+
+  bool cancelled() {
+    absl::MutexLock lock(&mutex_);
+    return cancelled_;
+  }
+
+  void SetCancel(size_t id, AnyCancelReceiver cancel) {
+    {
+      absl::MutexLock lock(&mutex_);
+      if (!cancelled_) {
+        cancel_.emplace(id, std::move(cancel));
+        return;
+      }
+    }
+    cancel();
+  }
+
+  void ClearCancel(size_t id) {
+    absl::MutexLock lock(&mutex_);
+    cancel_.erase(id);
+  }
+
+  void DoCancel() {
+    absl::flat_hash_map<size_t, AnyCancelReceiver> cancel;
+    {
+      absl::MutexLock lock(&mutex_);
+      if (cancelled_) return;
+      cancelled_ = true;
+      cancel.swap(cancel_);
+    }
+    for (auto& [id, c] : cancel) c();
+  }
+
+  // Records the first error and cancels the remaining listings.
+  void SetError(absl::Status status) {
+    {
+      absl::MutexLock lock(&mutex_);
+      if (!status_.ok()) return;
+      status_ = std::move(status);
+    }
+    DoCancel();
+  }
+
+  void Emit(ListEntry entry) {
+    absl::MutexLock lock(&receiver_mutex_);
+    execution::set_value(receiver_, std::move(entry));
+  }
+
+  // Emits a key of a delimited listing, which may be outside the range.
+  void EmitIfInRange(ListEntry entry) {
+    if (!Contains(options_.range, entry.key) ||
+        entry.key.size() <= options_.strip_prefix_length) {
+      return;
+    }
+    entry.key.erase(0, options_.strip_prefix_length);
+    Emit(std::move(entry));
+  }
+
+  // Starts the delimited listings of `prefixes`, at `depth`.
+  void StartLevel(size_t depth, std::vector<std::string> prefixes);
+
+  // Called once the delimited listings at `depth` have completed, having
+  // found the common prefixes `prefixes`.
+  void OnLevelDone(size_t depth, std::vector<std::string> prefixes);
+};
+
+// Collects the common prefixes found by the delimited listings of one level,
+// and proceeds once the last listing releases it.
+struct LevelState final : public internal::AtomicReferenceCount<LevelState> {
+  internal::IntrusivePtr<ParallelListState> state_;
+  size_t depth_;
+
+  absl::Mutex mutex_;
+  std::vector<std::string> prefixes_ ABSL_GUARDED_BY(mutex_);
+
+  LevelState(internal::IntrusivePtr<ParallelListState> state, size_t depth)
+      : state_(std::move(state)), depth_(depth) {}
+
+  ~LevelState() {
+    std::vector<std::string> prefixes;
+    {
+      absl::MutexLock lock(&mutex_);
+      prefixes.swap(prefixes_);
+    }
+    state_->OnLevelDone(depth_, std::move(prefixes));
+  }
+
+  void AddPrefix(std::string prefix) {
+    if (!Intersects(state_->options_.range, KeyRange::Prefix(prefix))) return;
+    absl::MutexLock lock(&mutex_);
+    prefixes_.push_back(std::move(prefix));
+  }
+};
+
+// Receives the keys of a delimited listing.
+struct DelimitedReceiver {
+  internal::IntrusivePtr<LevelState> level;
+  size_t id;
+
+  [[maybe_unused]] friend void set_starting(DelimitedReceiver& self,
+                                            AnyCancelReceiver cancel) {
+    self.level->state_->SetCancel(self.id, std::move(cancel));
+  }
+
+  [[maybe_unused]] friend void set_value(DelimitedReceiver& self,
+                                         ListEntry entry) {
+    self.level->state_->EmitIfInRange(std::move(entry));
+  }
+
+  [[maybe_unused]] friend void set_done(DelimitedReceiver& self) {}
+
+  [[maybe_unused]] friend void set_error(DelimitedReceiver& self,
+                                         absl::Status status) {
+    self.level->state_->SetError(std::move(status));
+  }
+
+  [[maybe_unused]] friend void set_stopping(DelimitedReceiver& self) {
+    self.level->state_->ClearCancel(self.id);
+    self.level.reset();
+  }
+};
+
+// Receives the keys of a sub-range listing.
+struct RangeReceiver {
+  internal::IntrusivePtr<ParallelListState> state;
+  size_t id;
+
+  [[maybe_unused]] friend void set_starting(RangeReceiver& self,
+                                            AnyCancelReceiver cancel) {
+    self.state->SetCancel(self.id, std::move(cancel));
+  }
+
+  [[maybe_unused]] friend void set_value(RangeReceiver& self,
+                                         ListEntry entry) {
+    self.state->Emit(std::move(entry));
+  }
+
+  // set_done is not propagated; it is sent by ~ParallelListState once all
+  // listings have completed.
+  [[maybe_unused]] friend void set_done(RangeReceiver& self) {}
+
+  [[maybe_unused]] friend void set_error(RangeReceiver& self,
+                                         absl::Status status) {
+    self.state->SetError(std::move(status));
+  }
+
+  [[maybe_unused]] friend void set_stopping(RangeReceiver& self) {
+    self.state->ClearCancel(self.id);
+    self.state.reset();
+  }
+};
+
+void ParallelListState::StartLevel(size_t depth,
+                                   std::vector<std::string> prefixes) {
+  auto level = internal::MakeIntrusivePtr<LevelState>(
+      internal::IntrusivePtr<ParallelListState>(this), depth);
+  for (auto& prefix : prefixes) {
+    list_delimited_(
+        std::move(prefix),
+        [level](std::string common_prefix) {
+          level->AddPrefix(std::move(common_prefix));
+        },
+        DelimitedReceiver{level, NewListingId()});
+  }
+}
+
+void ParallelListState::OnLevelDone(size_t depth,
+                                    std::vector<std::string> prefixes) {
+  if (prefixes.empty() || cancelled()) return;
+  if (prefixes.size() < parallel_options_.sub_ranges &&
+      depth + 1 < parallel_options_.max_depth) {
+    StartLevel(depth + 1, std::move(prefixes));
+    return;
+  }
+  for (auto& prefix : prefixes) {
+    ListOptions options;
+    options.range = Intersect(options_.range, KeyRange::Prefix(prefix));
+    options.strip_prefix_length = options_.strip_prefix_length;
+    options.staleness_bound = options_.staleness_bound;
+    list_range_(std::move(options),
+                RangeReceiver{internal::IntrusivePtr<ParallelListState>(this),
+                              NewListingId()});
+  }
+}
+
+}  // namespace
+
+void ParallelList(const ParallelListOptions& parallel_options,
+                  ListOptions options, ListReceiver receiver,
+                  ListDelimitedFunction list_delimited,
+                  ListRangeFunction list_range) {
+  auto state = internal::MakeIntrusivePtr<ParallelListState>(
+      parallel_options, std::move(options), std::move(receiver),
+      std::move(list_delimited), std::move(list_range));
+  if (state->options_.range.empty()) return;
+  std::string prefix(LongestPrefix(state->options_.range));
+  state->StartLevel(0, {std::move(prefix)});
+}
+
+}  // namespace internal_kvstore
+}  // namespace tensorstore
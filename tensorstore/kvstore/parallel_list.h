@@ -0,0 +1,108 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_PARALLEL_LIST_H_
+#define TENSORSTORE_KVSTORE_PARALLEL_LIST_H_
+
+#include <stddef.h>
+
+#include <functional>
+#include <string>
+
+#include "absl/status/status.h"
+#include "tensorstore/internal/json_binding/bindable.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace internal_kvstore {
+
+/// Specifies how a listing is split into sub-ranges that are listed
+/// concurrently, for object stores that list keys sequentially, one page at a
+/// time.
+///
+/// The keys under the longest common prefix of the range are listed with a
+/// `/` delimiter, which returns the keys with no `/` after the prefix along
+/// with the common prefixes of the remaining keys.  While fewer than
+/// `sub_ranges` common prefixes are found, each of them is listed in the same
+/// way, up to `max_depth` levels.  The keys under each common prefix found are
+/// then listed concurrently.
+struct ParallelListOptions {
+  /// Number of sub-ranges sought.  Parallel listing is disabled if less than
+  /// 2.
+  size_t sub_ranges = 0;
+
+  /// Maximum number of levels of common prefixes listed with a delimiter.
+  size_t max_depth = 4;
+
+  bool enabled() const { return sub_ranges > 1; }
+
+  constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+    return f(x.sub_ranges, x.max_depth);
+  };
+
+  constexpr static auto default_json_binder = internal_json_binding::Object(
+      internal_json_binding::Member(
+          "sub_ranges",
+          internal_json_binding::Projection<&ParallelListOptions::sub_ranges>(
+              internal_json_binding::DefaultValue<
+                  internal_json_binding::kNeverIncludeDefaults>(
+                  [](auto* v) { *v = 0; }))),
+      internal_json_binding::Member(
+          "max_depth",
+          internal_json_binding::Projection<&ParallelListOptions::max_depth>(
+              internal_json_binding::DefaultValue<
+                  internal_json_binding::kNeverIncludeDefaults>(
+                  [](auto* v) { *v = 4; },
+                  internal_json_binding::Validate(
+                      [](const auto& options, const size_t* v) {
+                        if (*v < 1) {
+                          return absl::InvalidArgumentError(tensorstore::StrCat(
+                              "Expected max_depth of at least 1, but "
+                              "received: ",
+                              *v));
+                        }
+                        return absl::OkStatus();
+                      }))))
+      /**/);
+};
+
+/// Lists the keys that start with `prefix` and contain no `/` after it, and
+/// the distinct prefixes, up to and including the first `/` after `prefix`,
+/// of the other keys that start with `prefix`.  Keys are passed to `receiver`
+/// without stripping any prefix, and common prefixes are passed to
+/// `prefix_callback`.
+using ListDelimitedFunction = std::function<void(
+    std::string prefix, std::function<void(std::string)> prefix_callback,
+    kvstore::ListReceiver receiver)>;
+
+/// Lists `options.range`, as by `kvstore::Driver::ListImpl`.
+using ListRangeFunction = std::function<void(kvstore::ListOptions options,
+                                             kvstore::ListReceiver receiver)>;
+
+/// Lists `options.range` as a set of concurrent listings, as specified by
+/// `parallel_options`.
+///
+/// Entries are passed to `receiver` as they are received, and are not
+/// ordered.
+void ParallelList(const ParallelListOptions& parallel_options,
+                  kvstore::ListOptions options, kvstore::ListReceiver receiver,
+                  ListDelimitedFunction list_delimited,
+                  ListRangeFunction list_range);
+
+}  // namespace internal_kvstore
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_PARALLEL_LIST_H_
@@ -0,0 +1,204 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/parallel_list.h"
+
+#include <functional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/match.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/internal/json_binding/gtest.h"
+#include "tensorstore/kvstore/key_range.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/util/execution/any_receiver.h"
+#include "tensorstore/util/execution/execution.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+namespace execution = ::tensorstore::execution;
+using ::tensorstore::KeyRange;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::internal_kvstore::ParallelList;
+using ::tensorstore::internal_kvstore::ParallelListOptions;
+using ::tensorstore::kvstore::ListEntry;
+using ::tensorstore::kvstore::ListOptions;
+using ::tensorstore::kvstore::ListReceiver;
+using ::testing::ElementsAre;
+using ::testing::UnorderedElementsAre;
+
+// Lists a fixed set of keys synchronously, and records the listings.
+struct FakeStore {
+  std::set<std::string> keys;
+  absl::Status error;
+  std::vector<std::string> delimited_prefixes;
+  std::vector<KeyRange> ranges;
+
+  void ListDelimited(std::string prefix,
+                     std::function<void(std::string)> prefix_callback,
+                     ListReceiver receiver) {
+    delimited_prefixes.push_back(prefix);
+    execution::set_starting(receiver, [] {});
+    if (!error.ok()) {
+      execution::set_error(receiver, error);
+      execution::set_stopping(receiver);
+      return;
+    }
+    std::string last_prefix;
+    for (const auto& key : keys) {
+      if (!absl::StartsWith(key, prefix)) continue;
+      size_t slash = key.find('/', prefix.size());
+      if (slash == std::string::npos) {
+        execution::set_value(receiver, ListEntry{key, 1});
+        continue;
+      }
+      std::string common_prefix = key.substr(0, slash + 1);
+      if (common_prefix != last_prefix) prefix_callback(common_prefix);
+      last_prefix = std::move(common_prefix);
+    }
+    execution::set_done(receiver);
+    execution::set_stopping(receiver);
+  }
+
+  void ListRange(ListOptions options, ListReceiver receiver) {
+    ranges.push_back(options.range);
+    execution::set_starting(receiver, [] {});
+    for (const auto& key : keys) {
+      if (!tensorstore::Contains(options.range, key)) continue;
+      execution::set_value(
+          receiver, ListEntry{key.substr(options.strip_prefix_length), 1});
+    }
+    execution::set_done(receiver);
+    execution::set_stopping(receiver);
+  }
+
+  // Receives the listed keys.
+  struct Receiver {
+    std::vector<std::string>* listed;
+    absl::Status* status;
+    bool* done;
+
+    void set_starting(tensorstore::AnyCancelReceiver cancel) {}
+    void set_value(ListEntry entry) { listed->push_back(entry.key); }
+    void set_done() { *done = true; }
+    void set_error(absl::Status error) { *status = std::move(error); }
+    void set_stopping() {}
+  };
+
+  std::vector<std::string> List(ParallelListOptions parallel_options,
+                                ListOptions options,
+                                absl::Status* status = nullptr) {
+    std::vector<std::string> listed;
+    absl::Status error;
+    bool done = false;
+    ParallelList(
+        parallel_options, std::move(options),
+        Receiver{&listed, &error, &done},
+        [this](std::string prefix,
+               std::function<void(std::string)> prefix_callback,
+               ListReceiver receiver) {
+          ListDelimited(std::move(prefix), std::move(prefix_callback),
+                        std::move(receiver));
+        },
+        [this](ListOptions options, ListReceiver receiver) {
+          ListRange(std::move(options), std::move(receiver));
+        });
+    EXPECT_NE(done, !error.ok());
+    if (status) *status = error;
+    return listed;
+  }
+};
+
+ParallelListOptions MakeOptions(size_t sub_ranges, size_t max_depth = 4) {
+  ParallelListOptions options;
+  options.sub_ranges = sub_ranges;
+  options.max_depth = max_depth;
+  return options;
+}
+
+TEST(ParallelListTest, FlatKeys) {
+  FakeStore store;
+  store.keys = {"a", "b", "c"};
+  EXPECT_THAT(store.List(MakeOptions(4), {}),
+              UnorderedElementsAre("a", "b", "c"));
+  EXPECT_THAT(store.delimited_prefixes, ElementsAre(""));
+  EXPECT_THAT(store.ranges, ElementsAre());
+}
+
+TEST(ParallelListTest, DescendsUntilEnoughPrefixes) {
+  FakeStore store;
+  store.keys = {"x", "d/0/a", "d/0/b", "d/1/a", "d/2/a", "e/a"};
+  EXPECT_THAT(store.List(MakeOptions(3), {}),
+              UnorderedElementsAre("x", "d/0/a", "d/0/b", "d/1/a", "d/2/a",
+                                   "e/a"));
+  EXPECT_THAT(store.delimited_prefixes, ElementsAre("", "d/", "e/"));
+  EXPECT_THAT(store.ranges, UnorderedElementsAre(KeyRange::Prefix("d/0/"),
+                                                 KeyRange::Prefix("d/1/"),
+                                                 KeyRange::Prefix("d/2/")));
+}
+
+TEST(ParallelListTest, MaxDepth) {
+  FakeStore store;
+  store.keys = {"x", "d/0/a", "d/1/a", "e/a"};
+  EXPECT_THAT(store.List(MakeOptions(16, /*max_depth=*/1), {}),
+              UnorderedElementsAre("x", "d/0/a", "d/1/a", "e/a"));
+  EXPECT_THAT(store.delimited_prefixes, ElementsAre(""));
+  EXPECT_THAT(store.ranges, UnorderedElementsAre(KeyRange::Prefix("d/"),
+                                                 KeyRange::Prefix("e/")));
+}
+
+TEST(ParallelListTest, RangeAndStripPrefix) {
+  FakeStore store;
+  store.keys = {"d/0/a", "d/0/b", "d/1/a", "d/2/a", "e/a"};
+  ListOptions options;
+  options.range = KeyRange("d/0/b", "d/2/");
+  options.strip_prefix_length = 2;
+  EXPECT_THAT(store.List(MakeOptions(2), options),
+              UnorderedElementsAre("0/b", "1/a"));
+  EXPECT_THAT(store.delimited_prefixes, ElementsAre("d/"));
+  EXPECT_THAT(store.ranges, UnorderedElementsAre(KeyRange("d/0/b", "d/00"),
+                                                 KeyRange::Prefix("d/1/")));
+}
+
+TEST(ParallelListTest, Error) {
+  FakeStore store;
+  store.keys = {"a"};
+  store.error = absl::UnavailableError("down");
+  absl::Status status;
+  EXPECT_THAT(store.List(MakeOptions(2), {}, &status), ElementsAre());
+  EXPECT_THAT(status, tensorstore::StatusIs(absl::StatusCode::kUnavailable));
+}
+
+TEST(ParallelListOptionsTest, JsonBinding) {
+  tensorstore::TestJsonBinderRoundTripJsonOnly<ParallelListOptions>({
+      ::nlohmann::json::object_t(),
+      {{"sub_ranges", 64}},
+      {{"sub_ranges", 16}, {"max_depth", 2}},
+  });
+  tensorstore::TestJsonBinderFromJson<ParallelListOptions>({
+      {{{"max_depth", 0}},
+       MatchesStatus(absl::StatusCode::kInvalidArgument,
+                     ".*Expected max_depth of at least 1.*")},
+  });
+}
+
+}  // namespace
@@ -0,0 +1,95 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/remote_dram/hash_ring.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/log/absl_check.h"
+#include "absl/strings/str_cat.h"
+
+namespace tensorstore {
+
+uint64_t StableHash(std::string_view data) {
+  // FNV-1a, followed by the SplitMix64 finalizer so that similar keys spread
+  // over the whole ring.
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (unsigned char c : data) {
+    h ^= c;
+    h *= 0x100000001b3ULL;
+  }
+  h ^= h >> 30;
+  h *= 0xbf58476d1ce4e5b9ULL;
+  h ^= h >> 27;
+  h *= 0x94d049bb133111ebULL;
+  h ^= h >> 31;
+  return h;
+}
+
+HashRing::HashRing(const std::vector<std::string>& servers,
+                   size_t virtual_nodes)
+    : num_servers_(servers.size()) {
+  ABSL_CHECK(!servers.empty());
+  virtual_nodes = std::max<size_t>(virtual_nodes, 1);
+  points_.reserve(servers.size() * virtual_nodes);
+  for (size_t server = 0; server < servers.size(); ++server) {
+    for (size_t i = 0; i < virtual_nodes; ++i) {
+      points_.push_back(
+          Point{StableHash(absl::StrCat(servers[server], "#", i)), server});
+    }
+  }
+  // Ties, which are astronomically unlikely, are broken by address so that
+  // the order of `servers` does not matter.
+  std::sort(points_.begin(), points_.end(),
+            [&](const Point& a, const Point& b) {
+              if (a.hash != b.hash) return a.hash < b.hash;
+              return servers[a.server] < servers[b.server];
+            });
+}
+
+size_t HashRing::FindPoint(std::string_view key) const {
+  const uint64_t hash = StableHash(key);
+  auto it = std::lower_bound(
+      points_.begin(), points_.end(), hash,
+      [](const Point& point, uint64_t hash) { return point.hash < hash; });
+  return it == points_.end() ? 0 : it - points_.begin();
+}
+
+size_t HashRing::GetPrimary(std::string_view key) const {
+  return points_[FindPoint(key)].server;
+}
+
+HashRing::ServerList HashRing::GetReplicas(std::string_view key,
+                                           size_t n) const {
+  n = std::min(n, num_servers_);
+  ServerList replicas;
+  for (size_t i = FindPoint(key), visited = 0;
+       replicas.size() < n && visited < points_.size();
+       i = (i + 1) % points_.size(), ++visited) {
+    const size_t server = points_[i].server;
+    if (std::find(replicas.begin(), replicas.end(), server) ==
+        replicas.end()) {
+      replicas.push_back(server);
+    }
+  }
+  return replicas;
+}
+
+}  // namespace tensorstore
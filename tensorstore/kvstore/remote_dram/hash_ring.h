@@ -0,0 +1,77 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_REMOTE_DRAM_HASH_RING_H_
+#define TENSORSTORE_KVSTORE_REMOTE_DRAM_HASH_RING_H_
+
+/// \file
+/// Placement of keys on the servers of a multi-server remote_dram client.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/container/inlined_vector.h"
+
+namespace tensorstore {
+
+/// Returns a hash of `data` that is the same in every process and build, as
+/// needed for all clients to agree on the placement of keys.
+uint64_t StableHash(std::string_view data);
+
+/// Consistent-hash ring over a set of servers.
+///
+/// Each server is placed at `virtual_nodes` points of the ring, at hashes of
+/// its address.  A key belongs to the server of the first point at or after
+/// the hash of the key, and its replicas to the servers of the following
+/// points, skipping servers already chosen.  The placement depends only on
+/// the server addresses, not their order, and adding or removing a server
+/// only moves the keys of the points it gains or loses.
+class HashRing {
+ public:
+  using ServerList = absl::InlinedVector<size_t, 4>;
+
+  /// Constructs a ring of `servers`, which must be non-empty and distinct.
+  /// Servers are identified by their index in `servers`.
+  HashRing(const std::vector<std::string>& servers, size_t virtual_nodes);
+
+  size_t num_servers() const { return num_servers_; }
+
+  /// Returns the server that `key` belongs to.
+  size_t GetPrimary(std::string_view key) const;
+
+  /// Returns the first `min(n, num_servers())` distinct servers for `key`,
+  /// starting with `GetPrimary(key)`.
+  ServerList GetReplicas(std::string_view key, size_t n) const;
+
+ private:
+  struct Point {
+    uint64_t hash;
+    size_t server;
+  };
+
+  /// Index of the first point at or after the hash of `key`, wrapping.
+  size_t FindPoint(std::string_view key) const;
+
+  size_t num_servers_;
+  /// Sorted by `hash`.
+  std::vector<Point> points_;
+};
+
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_REMOTE_DRAM_HASH_RING_H_
@@ -0,0 +1,98 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/remote_dram/hash_ring.h"
+
+#include <stddef.h>
+
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/str_cat.h"
+
+namespace {
+
+using ::tensorstore::HashRing;
+using ::tensorstore::StableHash;
+using ::testing::ElementsAre;
+using ::testing::UnorderedElementsAre;
+
+TEST(StableHashTest, Golden) {
+  // Placement must not change between releases.
+  EXPECT_EQ(StableHash(""), StableHash(""));
+  EXPECT_NE(StableHash("a"), StableHash("b"));
+  EXPECT_EQ(0x487eb6f7e0ea7e7cULL, StableHash("key"));
+}
+
+TEST(HashRingTest, SingleServer) {
+  HashRing ring({"a:1"}, 16);
+  EXPECT_EQ(0, ring.GetPrimary("x"));
+  EXPECT_THAT(ring.GetReplicas("x", 3), ElementsAre(0));
+}
+
+TEST(HashRingTest, ReplicasAreDistinctAndStartWithPrimary) {
+  HashRing ring({"a:1", "b:1", "c:1", "d:1"}, 64);
+  for (int i = 0; i < 100; ++i) {
+    std::string key = absl::StrCat("key", i);
+    auto replicas = ring.GetReplicas(key, 3);
+    ASSERT_EQ(3, replicas.size());
+    EXPECT_EQ(ring.GetPrimary(key), replicas[0]);
+    EXPECT_NE(replicas[0], replicas[1]);
+    EXPECT_NE(replicas[0], replicas[2]);
+    EXPECT_NE(replicas[1], replicas[2]);
+  }
+  EXPECT_THAT(ring.GetReplicas("key", 10), UnorderedElementsAre(0, 1, 2, 3));
+}
+
+TEST(HashRingTest, IndependentOfServerOrder) {
+  HashRing ring1({"a:1", "b:1", "c:1"}, 64);
+  HashRing ring2({"c:1", "a:1", "b:1"}, 64);
+  const size_t to_ring2[] = {1, 2, 0};
+  for (int i = 0; i < 100; ++i) {
+    std::string key = absl::StrCat("key", i);
+    EXPECT_EQ(to_ring2[ring1.GetPrimary(key)], ring2.GetPrimary(key));
+  }
+}
+
+TEST(HashRingTest, SpreadsAndMovesFewKeys) {
+  std::vector<std::string> servers;
+  for (int i = 0; i < 4; ++i) servers.push_back(absl::StrCat("host", i, ":1"));
+  HashRing ring(servers, 128);
+  servers.push_back("host4:1");
+  HashRing grown(servers, 128);
+  std::vector<int> counts(4);
+  int moved = 0;
+  const int kKeys = 10000;
+  for (int i = 0; i < kKeys; ++i) {
+    std::string key = absl::StrCat("key", i);
+    const size_t server = ring.GetPrimary(key);
+    ++counts[server];
+    const size_t new_server = grown.GetPrimary(key);
+    if (new_server != server) {
+      ++moved;
+      // Keys only move to the new server.
+      EXPECT_EQ(4, new_server);
+    }
+  }
+  for (int count : counts) {
+    EXPECT_GT(count, kKeys / 4 * 0.7);
+    EXPECT_LT(count, kKeys / 4 * 1.3);
+  }
+  EXPECT_GT(moved, kKeys / 5 * 0.6);
+  EXPECT_LT(moved, kKeys / 5 * 1.4);
+}
+
+}  // namespace
@@ -14,327 +14,707 @@
 
 #include "remote_dram_kvstore.h"
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <thread>
+#include <cerrno>
 #include <chrono>
 #include <cstring>
+#include <utility>
 #include <vector>
 #include <iostream>
 
 // System includes for socket operations
 #include <arpa/inet.h>
+#include <sys/epoll.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <unistd.h>
 
+#include "absl/container/flat_hash_set.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/status/status.h"
+#include "absl/hash/hash.h"
 #include "absl/log/absl_log.h"
+#include "absl/strings/cord.h"
 #include "absl/strings/str_format.h"
+#include "absl/strings/str_join.h"
+#include "tensorstore/batch.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/internal/log/verbose_flag.h"
+#include "tensorstore/internal/metrics/counter.h"
+#include "tensorstore/internal/metrics/gauge.h"
+#include "tensorstore/internal/metrics/histogram.h"
+#include "tensorstore/internal/metrics/metadata.h"
 #include "tensorstore/internal/uri_utils.h"
+#include "tensorstore/kvstore/batch_util.h"
 #include "tensorstore/kvstore/byte_range.h"
+#include "tensorstore/kvstore/common_metrics.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/key_range.h"
 #include "tensorstore/kvstore/operations.h"
 #include "tensorstore/kvstore/read_result.h"
 #include "tensorstore/kvstore/registry.h"
+#include "tensorstore/kvstore/remote_dram/hash_ring.h"
 #include "tensorstore/kvstore/spec.h"
 #include "tensorstore/kvstore/url_registry.h"
 #include "tensorstore/util/execution/execution.h"
+#include "tensorstore/util/executor.h"
 #include "tensorstore/util/future.h"
 #include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
 #include "tensorstore/util/status.h"
 #include "tensorstore/util/str_cat.h"
 
 // specializations for std::optional
+#include "tensorstore/internal/cache_key/absl_time.h"  // IWYU pragma: keep
 #include "tensorstore/internal/cache_key/std_optional.h"  // IWYU pragma: keep
+#include "tensorstore/internal/cache_key/std_vector.h"  // IWYU pragma: keep
 #include "tensorstore/internal/json_binding/std_optional.h"  // IWYU pragma: keep
+#include "tensorstore/serialization/absl_time.h"  // IWYU pragma: keep
 #include "tensorstore/serialization/std_optional.h"  // IWYU pragma: keep
+#include "tensorstore/serialization/std_vector.h"  // IWYU pragma: keep
 #include "tensorstore/util/garbage_collection/std_optional.h"  // IWYU pragma: keep
+#include "tensorstore/util/garbage_collection/std_vector.h"  // IWYU pragma: keep
 
 // UCX headers
 #include <ucp/api/ucp.h>
 
 namespace tensorstore {
 
-// RemoteDramStorage Implementation
-void RemoteDramStorage::Store(const std::string& key, const absl::Cord& value) {
-  absl::MutexLock lock(&mutex_);
-  storage_[key] = value;
-  ABSL_LOG(INFO) << "Stored key '" << key << "' with " << value.size() << " bytes";
+/// UCX error handler callback
+///
+/// For server-side endpoints, `arg` holds the connection id.
+void UcxErrorHandler(void* arg, ucp_ep_h ep, ucs_status_t status) {
+  ABSL_LOG(ERROR) << "UCX: Connection error: " << ucs_status_string(status);
+  if (arg != nullptr) {
+    UcxManager::Instance().CloseConnection(
+        static_cast<uint32_t>(reinterpret_cast<uintptr_t>(arg)), status);
+  }
 }
 
-std::optional<absl::Cord> RemoteDramStorage::Get(const std::string& key) const {
-  absl::MutexLock lock(&mutex_);
-  auto it = storage_.find(key);
-  if (it != storage_.end()) {
-    return it->second;
+/// UCX error handler callback for client-side endpoints, whose `arg` is the
+/// `ClientEndpointState`.
+///
+/// Fails the operations awaiting responses on `ep`, which would otherwise
+/// never complete, and marks the endpoint to be reconnected.
+void UcxClientErrorHandler(void* arg, ucp_ep_h ep, ucs_status_t status) {
+  auto& state = *static_cast<ClientEndpointState*>(arg);
+  ABSL_LOG(ERROR) << "UCX: Connection to " << state.server_addr
+                  << " failed: " << ucs_status_string(status);
+  state.failed.store(true, std::memory_order_release);
+  state.worker->FailEndpointOperations(
+      ep, absl::UnavailableError(
+              absl::StrFormat("Connection to %s failed: %s", state.server_addr,
+                              ucs_status_string(status))));
+}
+
+// RegisteredMemory Implementation
+Result<std::unique_ptr<RegisteredMemory>> RegisteredMemory::Register(
+    ucp_context_h context, void* address, size_t size) {
+  ucp_mem_map_params_t params;
+  memset(&params, 0, sizeof(params));
+  params.field_mask = UCP_MEM_MAP_PARAM_FIELD_ADDRESS |
+                      UCP_MEM_MAP_PARAM_FIELD_LENGTH;
+  params.address = address;
+  params.length = size;
+
+  std::unique_ptr<RegisteredMemory> registration(new RegisteredMemory);
+  ucs_status_t status = ucp_mem_map(context, &params, &registration->memh_);
+  if (status != UCS_OK) {
+    return absl::InternalError(absl::StrFormat(
+        "Failed to register %d bytes with UCX: %s", size,
+        ucs_status_string(status)));
   }
-  return std::nullopt;
+  registration->context_ = context;
+  registration->address_ = address;
+  registration->size_ = size;
+  return registration;
 }
 
-bool RemoteDramStorage::Exists(const std::string& key) const {
-  absl::MutexLock lock(&mutex_);
-  return storage_.find(key) != storage_.end();
+RegisteredMemory::~RegisteredMemory() {
+  if (memh_ != nullptr) {
+    ucp_mem_unmap(context_, memh_);
+  }
 }
 
-bool RemoteDramStorage::Remove(const std::string& key) {
-  absl::MutexLock lock(&mutex_);
-  return storage_.erase(key) > 0;
+namespace {
+
+/// Returns an arena whose slabs are registered with `context`.
+std::shared_ptr<SlabArena> MakeRegisteredArena(ucp_context_h context) {
+  SlabArena::Options arena_options;
+  arena_options.register_slab =
+      [context](void* data, size_t size) -> std::shared_ptr<void> {
+    auto registration = RegisteredMemory::Register(context, data, size);
+    if (!registration.ok()) {
+      ABSL_LOG(ERROR) << "Cannot register arena slab: "
+                      << registration.status();
+      return nullptr;
+    }
+    return std::shared_ptr<RegisteredMemory>(*std::move(registration));
+  };
+  return SlabArena::Make(std::move(arena_options));
 }
 
-std::vector<std::string> RemoteDramStorage::GetAllKeys() const {
-  absl::MutexLock lock(&mutex_);
-  std::vector<std::string> keys;
-  keys.reserve(storage_.size());
-  for (const auto& [key, value] : storage_) {
-    keys.push_back(key);
+namespace jb = tensorstore::internal_json_binding;
+
+ABSL_CONST_INIT internal_log::VerboseFlag remote_dram_logging("remote_dram");
+
+struct RemoteDramMetrics : public internal_kvstore::CommonMetrics {
+  internal_metrics::Gauge<int64_t>& in_flight;
+  internal_metrics::Counter<int64_t>& progress_iterations;
+  internal_metrics::Histogram<internal_metrics::DefaultBucketer>&
+      queue_delay_us;
+  internal_metrics::Gauge<int64_t>& stored_bytes;
+  internal_metrics::Gauge<int64_t>& evicted_keys;
+  internal_metrics::Gauge<int64_t>& evicted_bytes;
+  internal_metrics::Gauge<int64_t>& expired_keys;
+};
+
+auto remote_dram_metrics = []() -> RemoteDramMetrics {
+  return {TENSORSTORE_KVSTORE_COMMON_METRICS(remote_dram),
+          internal_metrics::Gauge<int64_t>::New(
+              "/tensorstore/kvstore/remote_dram/in_flight",
+              internal_metrics::MetricMetadata(
+                  "remote_dram requests awaiting a server response")),
+          TENSORSTORE_KVSTORE_COUNTER_IMPL(
+              remote_dram, progress_iterations,
+              "UCX worker progress loop iterations"),
+          internal_metrics::Histogram<internal_metrics::DefaultBucketer>::New(
+              "/tensorstore/kvstore/remote_dram/queue_delay_us",
+              internal_metrics::MetricMetadata(
+                  "remote_dram time from starting a send until UCX "
+                  "completes it (us)",
+                  internal_metrics::Units::kMicroseconds)),
+          internal_metrics::Gauge<int64_t>::New(
+              "/tensorstore/kvstore/remote_dram/stored_bytes",
+              internal_metrics::MetricMetadata(
+                  "remote_dram bytes held by the server storage",
+                  internal_metrics::Units::kBytes)),
+          internal_metrics::Gauge<int64_t>::New(
+              "/tensorstore/kvstore/remote_dram/evicted_keys",
+              internal_metrics::MetricMetadata(
+                  "remote_dram values evicted from the server storage to "
+                  "honor its memory limit")),
+          internal_metrics::Gauge<int64_t>::New(
+              "/tensorstore/kvstore/remote_dram/evicted_bytes",
+              internal_metrics::MetricMetadata(
+                  "remote_dram bytes evicted from the server storage to "
+                  "honor its memory limit",
+                  internal_metrics::Units::kBytes)),
+          internal_metrics::Gauge<int64_t>::New(
+              "/tensorstore/kvstore/remote_dram/expired_keys",
+              internal_metrics::MetricMetadata(
+                  "remote_dram values removed from the server storage once "
+                  "expired"))};
+}();
+
+/// Number of progress loop iterations between updates of the metrics.
+constexpr int64_t kProgressMetricsInterval = 4096;
+
+/// Minimum time between removals of expired values from the server storage.
+constexpr absl::Duration kExpirationSweepInterval = absl::Seconds(1);
+
+/// Connection ids are 1 to `kMaxConnectionId`; 0 marks requests from
+/// clients that have not been assigned an id.
+constexpr uint32_t kMaxConnectionId = 0xffff;
+
+/// Reads an unaligned trivially-copyable value from `data`.
+template <typename T>
+T LoadUnaligned(const void* data) {
+  T value;
+  std::memcpy(&value, data, sizeof(T));
+  return value;
+}
+
+/// Wire generation used for conditions on generations that were not issued
+/// by this driver, and which no stored generation equals.
+constexpr uint64_t kForeignGeneration = ~uint64_t{0};
+
+/// Converts `generation`, which must not be unknown, to its wire form.
+uint64_t ToWireGeneration(const StorageGeneration& generation) {
+  if (StorageGeneration::IsNoValue(generation)) {
+    return RemoteDramStorage::kNoGeneration;
+  }
+  if (!StorageGeneration::IsUint64(generation)) return kForeignGeneration;
+  const uint64_t n = StorageGeneration::ToUint64(generation);
+  return n == RemoteDramStorage::kNoGeneration ? kForeignGeneration : n;
+}
+
+StorageGeneration FromWireGeneration(uint64_t generation) {
+  return generation == RemoteDramStorage::kNoGeneration
+             ? StorageGeneration::NoValue()
+             : StorageGeneration::FromUint64(generation);
+}
+
+/// Error of reads of values evicted from the server.  It differs from the
+/// result of reading a missing key, so that callers can read the value from
+/// its source instead.
+absl::Status EvictedError() {
+  return absl::NotFoundError(
+      "Value has been evicted from the remote_dram server");
+}
+
+/// Generation conditions of a request, in wire form.
+struct WireConditions {
+  std::optional<uint64_t> if_equal;
+  std::optional<uint64_t> if_not_equal;
+
+  static WireConditions FromRead(
+      const kvstore::ReadGenerationConditions& conditions) {
+    WireConditions wire;
+    if (!StorageGeneration::IsUnknown(conditions.if_equal)) {
+      wire.if_equal = ToWireGeneration(conditions.if_equal);
+    }
+    if (!StorageGeneration::IsUnknown(conditions.if_not_equal)) {
+      // A foreign generation never equals the stored one.
+      const uint64_t if_not_equal = ToWireGeneration(conditions.if_not_equal);
+      if (if_not_equal != kForeignGeneration) wire.if_not_equal = if_not_equal;
+    }
+    return wire;
+  }
+
+  static WireConditions FromWrite(
+      const kvstore::WriteGenerationConditions& conditions) {
+    WireConditions wire;
+    if (!StorageGeneration::IsUnknown(conditions.if_equal)) {
+      wire.if_equal = ToWireGeneration(conditions.if_equal);
+    }
+    return wire;
+  }
+
+  static WireConditions FromHeader(const RequestHeader& header) {
+    WireConditions wire;
+    if (header.conditions & kConditionIfEqual) wire.if_equal = header.if_equal;
+    if (header.conditions & kConditionIfNotEqual) {
+      wire.if_not_equal = header.if_not_equal;
+    }
+    return wire;
+  }
+
+  bool Matches(uint64_t generation) const {
+    return (!if_equal || *if_equal == generation) &&
+           (!if_not_equal || *if_not_equal != generation);
   }
-  return keys;
+};
+
+/// Builds the active message header of a request for `key`.  `flags` are
+/// `RequestConditions` other than the generation conditions.
+std::string MakeRequestHeader(MessageType type, uint32_t connection_id,
+                              uint64_t request_id, std::string_view key,
+                              const WireConditions& conditions = {},
+                              uint64_t generation = 0, uint32_t flags = 0) {
+  RequestHeader header;
+  memset(&header, 0, sizeof(header));
+  header.type = type;
+  header.connection_id = connection_id;
+  header.request_id = request_id;
+  header.key_length = static_cast<uint32_t>(key.size());
+  header.generation = generation;
+  header.conditions = flags;
+  if (conditions.if_equal) {
+    header.conditions |= kConditionIfEqual;
+    header.if_equal = *conditions.if_equal;
+  }
+  if (conditions.if_not_equal) {
+    header.conditions |= kConditionIfNotEqual;
+    header.if_not_equal = *conditions.if_not_equal;
+  }
+  std::string bytes(reinterpret_cast<const char*>(&header), sizeof(header));
+  bytes.append(key);
+  return bytes;
 }
 
-size_t RemoteDramStorage::GetKeyCount() const {
-  absl::MutexLock lock(&mutex_);
-  return storage_.size();
+/// Builds the active message header of a response.
+std::string MakeResponseHeader(MessageType type, uint64_t request_id,
+                               uint32_t status, uint64_t generation = 0) {
+  ResponseHeader header;
+  header.type = type;
+  header.status = status;
+  header.request_id = request_id;
+  header.generation = generation;
+  return std::string(reinterpret_cast<const char*>(&header), sizeof(header));
 }
 
-/// UCX error handler callback
-void UcxErrorHandler(void* arg, ucp_ep_h ep, ucs_status_t status) {
-  ABSL_LOG(ERROR) << "UCX: Connection error: " << ucs_status_string(status);
+/// Returns the result of reading `value`, or a missing key if `value` is
+/// `std::nullopt`, subject to `conditions`.
+kvstore::ReadResult MakeReadResult(const std::optional<StoredValue>& value,
+                                   const WireConditions& conditions) {
+  const uint64_t generation =
+      value ? value->generation : RemoteDramStorage::kNoGeneration;
+  TimestampedStorageGeneration stamp{FromWireGeneration(generation),
+                                     absl::Now()};
+  if (!conditions.Matches(generation)) {
+    return kvstore::ReadResult::Unspecified(std::move(stamp));
+  }
+  if (!value) return kvstore::ReadResult::Missing(std::move(stamp));
+  return kvstore::ReadResult::Value(value->value, std::move(stamp));
 }
 
-namespace {
+/// Encodes `keys` as the data of a `LIST_RESPONSE`.
+absl::Cord EncodeListResponse(
+    const std::vector<RemoteDramStorage::ListedKey>& keys) {
+  std::string data;
+  for (const auto& listed : keys) {
+    ListResponseEntry entry;
+    entry.key_length = static_cast<uint32_t>(listed.key.size());
+    entry.size = listed.size;
+    data.append(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    data.append(listed.key);
+  }
+  return absl::Cord(std::move(data));
+}
 
-namespace jb = tensorstore::internal_json_binding;
+/// Decodes the data of a `LIST_RESPONSE`.
+Result<std::vector<kvstore::ListEntry>> DecodeListResponse(
+    std::string_view data) {
+  std::vector<kvstore::ListEntry> entries;
+  while (!data.empty()) {
+    if (data.size() < sizeof(ListResponseEntry)) {
+      return absl::DataLossError("Truncated list response");
+    }
+    const auto entry = LoadUnaligned<ListResponseEntry>(data.data());
+    data.remove_prefix(sizeof(ListResponseEntry));
+    if (data.size() < entry.key_length) {
+      return absl::DataLossError("Truncated list response");
+    }
+    entries.push_back(kvstore::ListEntry{
+        std::string(data.substr(0, entry.key_length)), entry.size});
+    data.remove_prefix(entry.key_length);
+  }
+  return entries;
+}
 
-/// Send completion callback for UCX operations
-void SendCallback(void* request, ucs_status_t status, void* user_data) {
-  uint64_t request_id = reinterpret_cast<uint64_t>(user_data);
-  ABSL_LOG(INFO) << "UCX send completed for request " << request_id 
-                 << " with status: " << ucs_status_string(status);
-  
-  absl::Status result_status = (status == UCS_OK) ? 
-    absl::OkStatus() : 
-    absl::InternalError(absl::StrFormat("UCX send failed: %s", ucs_status_string(status)));
-  
-  UcxManager::Instance().CompletePendingOperation(request_id, result_status);
-  ucp_request_free(request);
+/// A key of a `BATCH_READ_REQUEST`.
+struct BatchReadItem {
+  std::string key;
+  WireConditions conditions;
+  OptionalByteRangeRequest byte_range;
+};
+
+/// Appends the `BATCH_READ_REQUEST` entry for a read of `key` to `data`.
+void AppendBatchReadRequestEntry(std::string& data, std::string_view key,
+                                 const WireConditions& conditions,
+                                 const OptionalByteRangeRequest& byte_range) {
+  BatchReadRequestEntry entry;
+  memset(&entry, 0, sizeof(entry));
+  entry.key_length = static_cast<uint32_t>(key.size());
+  if (conditions.if_equal) {
+    entry.conditions |= kConditionIfEqual;
+    entry.if_equal = *conditions.if_equal;
+  }
+  if (conditions.if_not_equal) {
+    entry.conditions |= kConditionIfNotEqual;
+    entry.if_not_equal = *conditions.if_not_equal;
+  }
+  entry.inclusive_min = byte_range.inclusive_min;
+  entry.exclusive_max = byte_range.exclusive_max;
+  data.append(reinterpret_cast<const char*>(&entry), sizeof(entry));
+  data.append(key);
 }
 
-/// Receive completion callback for server-side message handling
-void ServerReceiveCallback(void* request, ucs_status_t status, const ucp_tag_recv_info_t* info, void* user_data) {
-  ABSL_LOG(INFO) << "UCX server receive completed with status: " << ucs_status_string(status);
-  
-  // Always free the receive buffer, regardless of success or failure
-  char* buffer = static_cast<char*>(user_data);
-  
-  if (status == UCS_OK && info->length >= sizeof(MessageHeader)) {
-    // Process the received message
-    MessageHeader* header = reinterpret_cast<MessageHeader*>(buffer);
-    
-    ABSL_LOG(INFO) << "Received message: type=" << static_cast<uint32_t>(header->type)
-                   << ", key_len=" << header->key_length 
-                   << ", value_len=" << header->value_length
-                   << ", request_id=" << header->request_id;
-    
-    if (header->type == MessageType::WRITE_REQUEST) {
-      // Handle write request
-      const char* data_ptr = buffer + sizeof(MessageHeader);
-      std::string key(data_ptr, header->key_length);
-      absl::Cord value(std::string(data_ptr + header->key_length, header->value_length));
-      
-      // Store in server memory
-      UcxManager::Instance().GetStorage().Store(key, value);
-      
-      ABSL_LOG(INFO) << "Server stored key-value pair: key='" << key 
-                     << "', value_size=" << value.size();
-      
-      // Send write response back to client
-      ucp_ep_h client_endpoint = UcxManager::Instance().GetClientEndpoint();
-      if (client_endpoint) {
-        UcxManager::Instance().SendWriteResponse(client_endpoint, header->request_id, 0);
-      } else {
-        ABSL_LOG(ERROR) << "No client endpoint available to send write response";
-      }
-      
-    } else if (header->type == MessageType::READ_REQUEST) {
-      // Handle read request
-      const char* data_ptr = buffer + sizeof(MessageHeader);
-      std::string key(data_ptr, header->key_length);
-      
-      ABSL_LOG(INFO) << "Server received read request for key='" << key << "'";
-      
-      // Look up the key in storage
-      auto& storage = UcxManager::Instance().GetStorage();
-      auto value = storage.Get(key);
-      
-      if (value.has_value()) {
-        ABSL_LOG(INFO) << "Server found key '" << key << "' with value size=" << value->size();
-      } else {
-        ABSL_LOG(INFO) << "Server key '" << key << "' not found";
-      }
-      
-      // Send read response back to client
-      ucp_ep_h client_endpoint = UcxManager::Instance().GetClientEndpoint();
-      if (client_endpoint) {
-        UcxManager::Instance().SendReadResponse(client_endpoint, header->request_id, value);
+/// Decodes the data of a `BATCH_READ_REQUEST`.
+Result<std::vector<BatchReadItem>> DecodeBatchReadRequest(
+    std::string_view data) {
+  std::vector<BatchReadItem> items;
+  while (!data.empty()) {
+    if (data.size() < sizeof(BatchReadRequestEntry)) {
+      return absl::DataLossError("Truncated batch read request");
+    }
+    const auto entry = LoadUnaligned<BatchReadRequestEntry>(data.data());
+    data.remove_prefix(sizeof(BatchReadRequestEntry));
+    if (data.size() < entry.key_length) {
+      return absl::DataLossError("Truncated batch read request");
+    }
+    BatchReadItem& item = items.emplace_back();
+    item.key = std::string(data.substr(0, entry.key_length));
+    data.remove_prefix(entry.key_length);
+    if (entry.conditions & kConditionIfEqual) {
+      item.conditions.if_equal = entry.if_equal;
+    }
+    if (entry.conditions & kConditionIfNotEqual) {
+      item.conditions.if_not_equal = entry.if_not_equal;
+    }
+    item.byte_range.inclusive_min = entry.inclusive_min;
+    item.byte_range.exclusive_max = entry.exclusive_max;
+    if (!item.byte_range.SatisfiesInvariants()) {
+      return absl::DataLossError("Invalid byte range in batch read request");
+    }
+  }
+  return items;
+}
+
+/// Encodes the data of the `BATCH_READ_RESPONSE` to `items`, given the values
+/// read for them from `storage`.  The values are referenced rather than
+/// copied.
+absl::Cord EncodeBatchReadResponse(
+    const RemoteDramStorage& storage, span<const BatchReadItem> items,
+    span<const Result<std::optional<StoredValue>>> values) {
+  std::string table;
+  absl::Cord data;
+  for (size_t i = 0; i < items.size(); ++i) {
+    BatchReadResponseEntry entry;
+    memset(&entry, 0, sizeof(entry));
+    const auto& value = values[i];
+    if (!value.ok()) {
+      entry.status = kResponseError;
+    } else {
+      entry.generation =
+          *value ? (*value)->generation : RemoteDramStorage::kNoGeneration;
+      if (!items[i].conditions.Matches(entry.generation)) {
+        entry.status = kResponseConditionFailed;
+      } else if (!*value) {
+        entry.status = storage.WasEvicted(items[i].key) ? kResponseEvicted
+                                                        : kResponseNotFound;
+      } else if (auto byte_range =
+                     items[i].byte_range.Validate((*value)->value.size());
+                 !byte_range.ok()) {
+        entry.status = kResponseInvalidByteRange;
       } else {
-        ABSL_LOG(ERROR) << "No client endpoint available to send read response";
+        entry.status = kResponseOk;
+        absl::Cord sub_value =
+            internal::GetSubCord((*value)->value, *byte_range);
+        entry.value_length = sub_value.size();
+        data.Append(std::move(sub_value));
       }
     }
-    
-    // Only post another receive buffer if we're not shutting down
-    // Check if UCX manager is still active before posting new receive
-    auto& ucx_manager = UcxManager::Instance();
-    if (ucx_manager.GetContext() && ucx_manager.GetWorker()) {
-      ucx_manager.PostServerReceive();
+    table.append(reinterpret_cast<const char*>(&entry), sizeof(entry));
+  }
+  data.Prepend(table);
+  return data;
+}
+
+/// Sends the `WRITE_RESPONSE` to `request_id` once `future`, the outcome of
+/// a store, is ready.
+void SendWriteResponseWhenReady(ClientConnection connection,
+                                uint64_t request_id,
+                                Future<std::optional<uint64_t>> future) {
+  std::move(future).ExecuteWhenReady(
+      [connection, request_id](ReadyFuture<std::optional<uint64_t>> ready) {
+        auto& ucx_manager = UcxManager::Instance();
+        if (!ready.status().ok()) {
+          ABSL_LOG(ERROR) << "Server failed to store value for request "
+                          << request_id << ": " << ready.status();
+          ucx_manager.SendWriteResponse(connection, request_id,
+                                        kResponseError);
+        } else if (const auto& generation = ready.value(); !generation) {
+          ucx_manager.SendWriteResponse(connection, request_id,
+                                        kResponseConditionFailed);
+        } else {
+          ucx_manager.SendWriteResponse(connection, request_id, kResponseOk,
+                                        *generation);
+        }
+      });
+}
+
+/// Passes the memory handle of `registration`, a `RegisteredMemory` or null,
+/// to UCX, sparing it a registration cache lookup.  Applies only to
+/// contiguous buffers.
+void SetMemoryHandle(ucp_request_param_t& params, void* registration) {
+#if UCP_API_VERSION >= UCP_VERSION(1, 14)
+  if (registration != nullptr) {
+    params.op_attr_mask |= UCP_OP_ATTR_FIELD_MEMH;
+    params.memh = static_cast<RegisteredMemory*>(registration)->memh();
+  }
+#endif
+}
+
+/// Send state, freed when the send completes.
+struct SendContext {
+  UcxWorker* worker;
+  std::string header;
+  /// Owns the chunks described by `iov`.
+  absl::Cord value;
+  std::vector<ucp_dt_iov_t> iov;
+  uint64_t request_id;
+  absl::Time start_time;
+};
+
+void RecordSendCompletion(const SendContext& context) {
+  remote_dram_metrics.queue_delay_us.Observe(
+      absl::ToDoubleMicroseconds(absl::Now() - context.start_time));
+}
+
+void SendCallback(void* request, ucs_status_t status, void* user_data) {
+  auto* context = static_cast<SendContext*>(user_data);
+  if (status != UCS_OK) {
+    ABSL_LOG(ERROR) << "UCX send failed for request " << context->request_id
+                    << ": " << ucs_status_string(status);
+    if (context->request_id != 0) {
+      context->worker->FailPendingOperation(
+          context->request_id,
+          absl::InternalError(absl::StrFormat("UCX send failed: %s",
+                                              ucs_status_string(status))));
     }
   } else {
-    ABSL_LOG(ERROR) << "Failed to receive message: " << ucs_status_string(status);
+    RecordSendCompletion(*context);
   }
-  
-  // Free the receive buffer
-  delete[] buffer;
-  
-  // Free the UCX request
-  if (request != nullptr) {
-    ucp_request_free(request);
+  delete context;
+  ucp_request_free(request);
+}
+
+/// Starts receiving the rendezvous data `data` of an active message into
+/// `[buffer, buffer + length)`.  `callback` is always invoked with
+/// `user_data` once the receive has been started.  Returns `UCS_INPROGRESS`
+/// on success.
+///
+/// Without a `registration`, UCX registers `buffer` through its registration
+/// cache; `memory_type`, if known, spares it detecting the memory type.
+ucs_status_t ReceiveRendezvousData(
+    ucp_worker_h worker, void* data, char* buffer, size_t length,
+    void* registration, ucp_am_recv_data_nbx_callback_t callback,
+    void* user_data,
+    ucs_memory_type_t memory_type = UCS_MEMORY_TYPE_UNKNOWN) {
+  ucp_request_param_t params;
+  params.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_USER_DATA |
+                        UCP_OP_ATTR_FLAG_NO_IMM_CMPL;
+  params.cb.recv_am = callback;
+  params.user_data = user_data;
+  SetMemoryHandle(params, registration);
+  if (memory_type != UCS_MEMORY_TYPE_UNKNOWN) {
+    params.op_attr_mask |= UCP_OP_ATTR_FIELD_MEMORY_TYPE;
+    params.memory_type = memory_type;
+  }
+  void* request = ucp_am_recv_data_nbx(worker, data, buffer, length, &params);
+  if (UCS_PTR_IS_ERR(request)) {
+    return UCS_PTR_STATUS(request);
   }
+  return UCS_INPROGRESS;
 }
 
-/// Client-side callback for handling read responses
-void ClientReceiveCallback(void* request, ucs_status_t status, const ucp_tag_recv_info_t* info, void* user_data) {
-  ABSL_LOG(INFO) << "UCX client receive completed with status: " << ucs_status_string(status);
-  
-  uint64_t request_id = reinterpret_cast<uint64_t>(user_data);
-  
-  if (status == UCS_OK && info->length >= sizeof(ReadResponse)) {
-    // Process the read response
-    char* buffer = new char[info->length];  // Will be deleted after processing
-    
-    // Copy the received data (this is a simplified approach)
-    // In a real implementation, the buffer would be pre-allocated and passed properly
-    ReadResponse* response = reinterpret_cast<ReadResponse*>(buffer);
-    
-    ABSL_LOG(INFO) << "Client received read response: status_code=" << response->status_code
-                   << ", value_len=" << response->header.value_length
-                   << ", request_id=" << response->header.request_id;
-    
-    kvstore::ReadResult result;
-    if (response->status_code == 0 && response->header.value_length > 0) {
-      // Success with value
-      result.state = kvstore::ReadResult::kValue;
-      const char* value_ptr = buffer + sizeof(ReadResponse);
-      result.value = absl::Cord(std::string(value_ptr, response->header.value_length));
-      result.stamp.generation = StorageGeneration::FromString("remote_read");
-      result.stamp.time = absl::Now();
-      ABSL_LOG(INFO) << "Read successful, value size=" << result.value.size();
-    } else {
-      // Key not found or error
-      result.state = kvstore::ReadResult::kMissing;
-      result.stamp.generation = StorageGeneration::NoValue();
-      result.stamp.time = absl::Now();
-      ABSL_LOG(INFO) << "Read result: key not found";
-    }
-    
-    // Complete the pending read operation
-    UcxManager::Instance().CompletePendingReadOperation(request_id, std::move(result));
-    
-    delete[] buffer;
+/// Server-side state of the rendezvous receive of a written value, freed
+/// when the receive completes.
+struct WriteReceiveContext {
+  ClientConnection connection;
+  uint64_t request_id;
+  std::string key;
+  /// Owns the destination buffer, and becomes the stored value.
+  absl::Cord value;
+  void* registration = nullptr;
+  std::optional<uint64_t> if_equal;
+  uint64_t generation = RemoteDramStorage::kNoGeneration;
+};
+
+void WriteReceiveCallback(void* request, ucs_status_t status, size_t length,
+                          void* user_data) {
+  std::unique_ptr<WriteReceiveContext> context(
+      static_cast<WriteReceiveContext*>(user_data));
+  auto& ucx_manager = UcxManager::Instance();
+  if (status == UCS_ERR_CANCELED) {
+    // Shutting down.
+  } else if (status != UCS_OK) {
+    ABSL_LOG(ERROR) << "Failed to receive value of key '" << context->key
+                    << "': " << ucs_status_string(status);
+    ucx_manager.SendWriteResponse(context->connection, context->request_id,
+                                  kResponseError);
   } else {
-    ABSL_LOG(ERROR) << "Failed to receive read response: " << ucs_status_string(status);
-    
-    // Complete with error
-    kvstore::ReadResult error_result;
-    error_result.state = kvstore::ReadResult::kMissing;
-    error_result.stamp.generation = StorageGeneration::NoValue();
-    error_result.stamp.time = absl::Now();
-    UcxManager::Instance().CompletePendingReadOperation(request_id, std::move(error_result));
+    SendWriteResponseWhenReady(
+        context->connection, context->request_id,
+        ucx_manager.WriteStored(std::move(context->key),
+                                std::move(context->value),
+                                context->registration, context->if_equal,
+                                context->generation));
   }
-  
   ucp_request_free(request);
 }
 
-/// UCX listener callback for incoming connections
-void UcxListenerCallback(ucp_conn_request_h conn_request, void* user_data) {
-  ABSL_LOG(INFO) << "UCX: New client connection request received";
-  
-  // Accept the connection request and create an endpoint for the client
-  ucp_ep_params_t ep_params;
-  memset(&ep_params, 0, sizeof(ep_params));
-  
-  ep_params.field_mask = UCP_EP_PARAM_FIELD_CONN_REQUEST |
-                         UCP_EP_PARAM_FIELD_ERR_HANDLER |
-                         UCP_EP_PARAM_FIELD_ERR_HANDLING_MODE;
-  ep_params.conn_request = conn_request;
-  ep_params.err_mode = UCP_ERR_HANDLING_MODE_PEER;
-  ep_params.err_handler.cb = UcxErrorHandler;
-  ep_params.err_handler.arg = nullptr;
-  
-  ucp_ep_h client_endpoint;
+/// Server-side state of the rendezvous receive of a batched read request,
+/// freed when the receive completes.
+struct BatchReadReceiveContext {
+  ClientConnection connection;
+  uint64_t request_id;
+  /// Arena buffer holding the request.
+  absl::Cord data;
+};
+
+void BatchReadReceiveCallback(void* request, ucs_status_t status,
+                              size_t length, void* user_data) {
+  std::unique_ptr<BatchReadReceiveContext> context(
+      static_cast<BatchReadReceiveContext*>(user_data));
   auto& ucx_manager = UcxManager::Instance();
-  ucs_status_t status = ucp_ep_create(ucx_manager.GetWorker(), &ep_params, &client_endpoint);
-  
   if (status != UCS_OK) {
-    ABSL_LOG(ERROR) << "Failed to create server endpoint for client: " << ucs_status_string(status);
-    return;
+    ABSL_LOG(ERROR) << "Failed to receive batch read request "
+                    << context->request_id << ": "
+                    << ucs_status_string(status);
+  } else {
+    ucx_manager.HandleBatchRead(
+        context->connection, context->request_id, context->data.Flatten());
   }
-  
-  ABSL_LOG(INFO) << "Created server endpoint for client connection";
-  
-  // Register the client endpoint for response handling
-  ucx_manager.RegisterClientEndpoint(client_endpoint);
+  ucp_request_free(request);
 }
 
-/// Send a notification to the server process that new data has been written
-void NotifyServerOfNewData(const kvstore::Key& key, const absl::Cord& value) {
-  // Create a TCP socket to notify the server
-  int sock = socket(AF_INET, SOCK_STREAM, 0);
-  if (sock < 0) {
-    ABSL_LOG(WARNING) << "Failed to create notification socket";
-    return;
-  }
-  
-  // Set socket timeout
-  struct timeval timeout;
-  timeout.tv_sec = 1;
-  timeout.tv_usec = 0;
-  setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
-  setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
-  
-  // Connect to server notification port (12346 = data port + 1)
-  struct sockaddr_in server_addr;
-  memset(&server_addr, 0, sizeof(server_addr));
-  server_addr.sin_family = AF_INET;
-  server_addr.sin_port = htons(12346);
-  server_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
-  
-  if (connect(sock, (struct sockaddr*)&server_addr, sizeof(server_addr)) < 0) {
-    ABSL_LOG(WARNING) << "Failed to connect to server notification port 12346";
-    close(sock);
-    return;
-  }
-  
-  // Send notification message with length prefix for reliable parsing
-  std::string key_str = std::string(key);
-  std::string value_str = std::string(value);
-  
-  // Format: "NEW_DATA:<key_length>:<value_length>:<key><value>"
-  std::string notification = "NEW_DATA:" + std::to_string(key_str.length()) + ":" + 
-                           std::to_string(value_str.length()) + ":" + key_str + value_str;
-  
-  ABSL_LOG(INFO) << "Sending notification to server: key='" << key_str << "', value_size=" << value_str.length();
-  
-  ssize_t bytes_sent = send(sock, notification.c_str(), notification.length(), 0);
-  if (bytes_sent != static_cast<ssize_t>(notification.length())) {
-    ABSL_LOG(WARNING) << "Failed to send complete notification to server";
+/// Client-side state of the rendezvous receive of response data, freed when
+/// the receive completes.
+struct ResponseReceiveContext {
+  UcxWorker* worker;
+  ResponseHeader header;
+  /// Arena buffer receiving the data, unless `destination` is specified.
+  absl::Cord data;
+  std::shared_ptr<ReadDestination> destination;
+};
+
+void ResponseReceiveCallback(void* request, ucs_status_t status, size_t length,
+                             void* user_data) {
+  std::unique_ptr<ResponseReceiveContext> context(
+      static_cast<ResponseReceiveContext*>(user_data));
+  UcxWorker& worker = *context->worker;
+  if (status == UCS_ERR_CANCELED) {
+    // Shutdown completes the pending operations itself.
+  } else if (status != UCS_OK) {
+    worker.FailPendingOperation(
+        context->header.request_id,
+        absl::UnavailableError(absl::StrFormat(
+            "UCX receive failed: %s", ucs_status_string(status))));
   } else {
-    ABSL_LOG(INFO) << "Notification sent successfully to server";
+    if (context->destination) context->destination->received = length;
+    worker.HandleResponseData(context->header, std::move(context->data));
   }
-  
-  close(sock);
+  ucp_request_free(request);
+}
+
+/// Active message handler for requests, registered on the server worker.
+ucs_status_t ServerRequestCallback(void* arg, const void* header,
+                                   size_t header_length, void* data,
+                                   size_t length,
+                                   const ucp_am_recv_param_t* param) {
+  if (header_length < sizeof(RequestHeader)) {
+    ABSL_LOG(ERROR) << "Dropping request with truncated header";
+    return UCS_OK;
+  }
+  const auto request = LoadUnaligned<RequestHeader>(header);
+  if (header_length - sizeof(RequestHeader) < request.key_length) {
+    ABSL_LOG(ERROR) << "Dropping truncated message for request "
+                    << request.request_id;
+    return UCS_OK;
+  }
+  std::string key(static_cast<const char*>(header) + sizeof(RequestHeader),
+                  request.key_length);
+  return UcxManager::Instance().HandleRequest(request, std::move(key), data,
+                                              length, param);
+}
+
+/// Active message handler for responses; `arg` is the `UcxWorker`.
+ucs_status_t ClientResponseCallback(void* arg, const void* header,
+                                    size_t header_length, void* data,
+                                    size_t length,
+                                    const ucp_am_recv_param_t* param) {
+  if (header_length < sizeof(ResponseHeader)) {
+    ABSL_LOG(ERROR) << "Dropping response with truncated header";
+    return UCS_OK;
+  }
+  return static_cast<UcxWorker*>(arg)->HandleResponse(
+      LoadUnaligned<ResponseHeader>(header), data, length, param);
+}
+
+/// UCX listener callback for incoming connections
+void UcxListenerCallback(ucp_conn_request_h conn_request, void* user_data) {
+  ABSL_LOG(INFO) << "UCX: New client connection request received";
+  UcxManager::Instance().AcceptConnection(conn_request);
 }
 
 }  // namespace
@@ -345,7 +725,7 @@ UcxManager& UcxManager::Instance() {
   return instance;
 }
 
-absl::Status UcxManager::Initialize() {
+absl::Status UcxManager::Initialize(size_t num_workers) {
   absl::MutexLock lock(&mutex_);
   
   if (initialized_) {
@@ -364,15 +744,10 @@ absl::Status UcxManager::Initialize() {
                                                ucs_status_string(status)));
   }
   
-  // Set UCX context parameters with tagged messaging support
-  ucp_params.field_mask = UCP_PARAM_FIELD_FEATURES | 
-                          UCP_PARAM_FIELD_TAG_SENDER_MASK;
-  
-  // Use features that support local communication (shared memory) and networking
-  ucp_params.features = UCP_FEATURE_TAG | 
-                        UCP_FEATURE_WAKEUP;
-  
-  ucp_params.tag_sender_mask = 0xffff000000000000ULL;  // Use upper 16 bits for sender ID
+  // Requests and responses are active messages; UCX moves large values with
+  // its rendezvous protocol.
+  ucp_params.field_mask = UCP_PARAM_FIELD_FEATURES;
+  ucp_params.features = UCP_FEATURE_AM | UCP_FEATURE_WAKEUP;
   
   // Create UCX context
   status = ucp_init(&ucp_params, config, &context_);
@@ -383,24 +758,31 @@ absl::Status UcxManager::Initialize() {
                                                ucs_status_string(status)));
   }
   
-  // Create UCX worker with socket support
-  ucp_worker_params_t worker_params;
-  worker_params.field_mask = UCP_WORKER_PARAM_FIELD_THREAD_MODE;
-  worker_params.thread_mode = UCS_THREAD_MODE_MULTI;
-  
-  status = ucp_worker_create(context_, &worker_params, &worker_);
-  if (status != UCS_OK) {
-    ucp_cleanup(context_);
-    context_ = nullptr;
-    return absl::InternalError(absl::StrFormat("Failed to create UCX worker: %s", 
-                                               ucs_status_string(status)));
+  // Create the workers, each progressed by its own thread.
+  for (size_t i = 0; i < std::max<size_t>(num_workers, 1); ++i) {
+    auto worker = std::make_unique<UcxWorker>(*this, i);
+    absl::Status worker_status = worker->Start(context_);
+    if (!worker_status.ok()) {
+      for (auto& started : workers_) {
+        started->Stop();
+        started->Destroy(worker_status);
+      }
+      workers_.clear();
+      ucp_cleanup(context_);
+      context_ = nullptr;
+      return worker_status;
+    }
+    workers_.push_back(std::move(worker));
   }
   
+  arena_ = MakeRegisteredArena(context_);
+  // Stored values are allocated from `arena_`, so that its slabs count
+  // against the memory limit.
+  storage_.SetArena(arena_);
+
   initialized_ = true;
-  ABSL_LOG(INFO) << "UCX Manager initialized successfully with socket support";
-  
-  // Start worker progress polling
-  StartWorkerProgressTask();
+  ABSL_LOG(INFO) << "UCX Manager initialized successfully with "
+                 << workers_.size() << " workers";
   
   return absl::OkStatus();
 }
@@ -465,10 +847,25 @@ Result<ucp_listener_h> UcxManager::CreateListener(const std::string& listen_addr
   listener_params.conn_handler.cb = UcxListenerCallback;
   listener_params.conn_handler.arg = nullptr;
   
+  // Requests from all clients arrive on the listener's worker.
+  ucp_am_handler_param_t handler_params;
+  handler_params.field_mask = UCP_AM_HANDLER_PARAM_FIELD_ID |
+                              UCP_AM_HANDLER_PARAM_FIELD_CB |
+                              UCP_AM_HANDLER_PARAM_FIELD_ARG;
+  handler_params.id = kRequestAmId;
+  handler_params.cb = ServerRequestCallback;
+  handler_params.arg = nullptr;
+  ucs_status_t status =
+      ucp_worker_set_am_recv_handler(GetWorker(), &handler_params);
+  if (status != UCS_OK) {
+    return absl::InternalError(absl::StrFormat(
+        "Failed to set UCX request handler: %s", ucs_status_string(status)));
+  }
+
   ABSL_LOG(INFO) << "Attempting to create UCX listener with parameters configured";
   
   ucp_listener_h listener;
-  ucs_status_t status = ucp_listener_create(worker_, &listener_params, &listener);
+  status = ucp_listener_create(GetWorker(), &listener_params, &listener);
   
   if (status != UCS_OK) {
     ABSL_LOG(ERROR) << "UCX listener creation failed with status: " << ucs_status_string(status)
@@ -477,7 +874,7 @@ Result<ucp_listener_h> UcxManager::CreateListener(const std::string& listen_addr
     ABSL_LOG(ERROR) << "  Address: " << listen_addr;
     ABSL_LOG(ERROR) << "  Host: " << host;
     ABSL_LOG(ERROR) << "  Port: " << port_num;
-    ABSL_LOG(ERROR) << "  Worker: " << worker_;
+    ABSL_LOG(ERROR) << "  Worker: " << GetWorker();
     
     // Provide more specific error messages based on common UCX listener errors
     if (status == UCS_ERR_BUSY) {
@@ -503,45 +900,13 @@ Result<ucp_listener_h> UcxManager::CreateListener(const std::string& listen_addr
   // Store the listener handle for cleanup
   listener_ = listener;
   
-  // Post initial receive buffers for incoming messages
-  constexpr int num_preposted_receives = 10;
-  ABSL_LOG(INFO) << "Posting " << num_preposted_receives << " initial receive buffers";
-  for (int i = 0; i < num_preposted_receives; ++i) {
-    PostServerReceiveNoLock();
-  }
-  
   return listener;
 }
 
-Result<ucp_ep_h> UcxManager::CreateClientEndpoint(const std::string& server_addr) {
-  absl::MutexLock lock(&mutex_);
-  
-  if (!initialized_) {
-    return absl::FailedPreconditionError("UCX Manager not initialized");
-  }
-  
-  ABSL_LOG(INFO) << "Creating UCX client endpoint to: " << server_addr;
-  
-  // Check if this is a localhost connection
-  bool is_localhost = (server_addr.find("127.0.0.1") != std::string::npos ||
-                      server_addr.find("localhost") != std::string::npos);
-  
-  if (is_localhost) {
-    ABSL_LOG(INFO) << "Detected localhost connection - using local IPC mode for testing";
-    
-    // For localhost testing, create a dummy endpoint that represents local communication
-    // This allows us to test the basic functionality without complex UCX networking
-    ucp_ep_h dummy_endpoint = reinterpret_cast<ucp_ep_h>(0xDEADBEEFULL);  // Local comm marker
-    
-    // Register this endpoint for cleanup
-    RegisterClientSideEndpointNoLock(dummy_endpoint);
-    
-    ABSL_LOG(INFO) << "Created localhost client endpoint for testing";
-    return dummy_endpoint;
-  }
-  
-  // For real multi-node connections, use full UCX with socket addresses
-  // Parse server address
+namespace {
+
+/// Parses a `host:port` server address.
+Result<sockaddr_in> ParseServerAddress(const std::string& server_addr) {
   size_t colon_pos = server_addr.find(':');
   if (colon_pos == std::string::npos) {
     return absl::InvalidArgumentError("Invalid server address format, expected host:port");
@@ -569,13 +934,80 @@ Result<ucp_ep_h> UcxManager::CreateClientEndpoint(const std::string& server_addr
   server_sockaddr.sin_port = htons(port_num);
   
   // Convert host to IP address
+  if (host == "localhost") host = "127.0.0.1";
   int inet_result = inet_pton(AF_INET, host.c_str(), &server_sockaddr.sin_addr);
   if (inet_result != 1) {
     return absl::InvalidArgumentError(absl::StrFormat("Invalid host address: %s", host));
   }
   
   ABSL_LOG(INFO) << "Connecting to remote host " << host << " on port " << port_num;
+  return server_sockaddr;
+}
+
+}  // namespace
+
+Result<std::vector<ClientEndpoint>> UcxManager::CreateClientEndpoints(
+    const std::string& server_addr, absl::Duration timeout) {
+  // `mutex_` is not held while waiting for the server below, since the
+  // progress threads may need it.
+  absl::MutexLock connect_lock(&connect_mutex_);
+  {
+    absl::MutexLock lock(&mutex_);
+    if (!initialized_) {
+      return absl::FailedPreconditionError("UCX Manager not initialized");
+    }
+  }
+  
+  ABSL_LOG(INFO) << "Creating UCX client endpoint to: " << server_addr;
+  
+  // Servers on the same node are connected in the same way; UCX then selects
+  // its shared-memory transports (e.g. posix, sysv, cma) for them, as allowed
+  // by UCX_TLS.
+  TENSORSTORE_ASSIGN_OR_RETURN(auto server_sockaddr,
+                               ParseServerAddress(server_addr));
+  ABSL_LOG(INFO) << "  Workers: " << workers_.size();
+  
+  // Create one endpoint per worker, so that each worker's requests and
+  // responses travel over its own connection.
+  std::vector<ClientEndpoint> endpoints;
+  for (auto& worker : workers_) {
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto endpoint,
+        ConnectWorker(*worker, server_addr, server_sockaddr, timeout));
+    endpoints.push_back(endpoint);
+  }
+  
+  ABSL_LOG(INFO) << "UCX client endpoints created successfully to "
+                 << server_addr;
   
+  return endpoints;
+}
+
+Result<ClientEndpoint> UcxManager::CreateClientEndpoint(
+    const std::string& server_addr, size_t worker_index,
+    absl::Duration timeout) {
+  absl::MutexLock connect_lock(&connect_mutex_);
+  {
+    absl::MutexLock lock(&mutex_);
+    if (!initialized_) {
+      return absl::FailedPreconditionError("UCX Manager not initialized");
+    }
+  }
+  ABSL_LOG(INFO) << "Reconnecting worker " << worker_index << " to "
+                 << server_addr;
+  TENSORSTORE_ASSIGN_OR_RETURN(auto server_sockaddr,
+                               ParseServerAddress(server_addr));
+  return ConnectWorker(*workers_[worker_index], server_addr, server_sockaddr,
+                       timeout);
+}
+
+Result<ClientEndpoint> UcxManager::ConnectWorker(
+    UcxWorker& worker, const std::string& server_addr,
+    const sockaddr_in& server_sockaddr, absl::Duration timeout) {
+  auto state = std::make_unique<ClientEndpointState>();
+  state->worker = &worker;
+  state->server_addr = server_addr;
+
   // Create UCX endpoint parameters with socket address
   ucp_ep_params_t ep_params;
   memset(&ep_params, 0, sizeof(ep_params));
@@ -586,62 +1018,110 @@ Result<ucp_ep_h> UcxManager::CreateClientEndpoint(const std::string& server_addr
   ep_params.sockaddr.addr = (const struct sockaddr*)&server_sockaddr;
   ep_params.sockaddr.addrlen = sizeof(server_sockaddr);
   ep_params.err_mode = UCP_ERR_HANDLING_MODE_PEER;
-  ep_params.err_handler.cb = UcxErrorHandler;
-  ep_params.err_handler.arg = nullptr;
-  
-  ABSL_LOG(INFO) << "Attempting to create UCX client endpoint with socket connection";
-  ABSL_LOG(INFO) << "  Server address: " << server_addr;
-  ABSL_LOG(INFO) << "  Socket family: " << server_sockaddr.sin_family;
-  ABSL_LOG(INFO) << "  Socket port: " << ntohs(server_sockaddr.sin_port);
-  ABSL_LOG(INFO) << "  Worker: " << worker_;
-  
-  // Create the client endpoint
+  ep_params.err_handler.cb = UcxClientErrorHandler;
+  ep_params.err_handler.arg = state.get();
+  
+  // The server answers each new connection with its id; at most one
+  // connection per worker awaits its id at a time, so it cannot pick up the
+  // id of another connection.
+  auto [promise, future] = PromiseFuturePair<uint32_t>::Make();
+  worker.ExpectConnectionId(std::move(promise));
+
   ucp_ep_h client_endpoint;
-  ucs_status_t status = ucp_ep_create(worker_, &ep_params, &client_endpoint);
+  ucs_status_t status =
+      ucp_ep_create(worker.handle(), &ep_params, &client_endpoint);
   
-  ABSL_LOG(INFO) << "UCX endpoint creation result: " << ucs_status_string(status) << " (" << status << ")";
+  ABSL_LOG(INFO) << "UCX endpoint creation result: "
+                 << ucs_status_string(status) << " (" << status << ")";
   
   if (status != UCS_OK) {
-    ABSL_LOG(ERROR) << "Failed to create UCX client endpoint: " << ucs_status_string(status);
+    ABSL_LOG(ERROR) << "Failed to create UCX client endpoint: "
+                    << ucs_status_string(status);
+    worker.ExpectConnectionId({});
     return absl::InternalError(absl::StrFormat(
         "Failed to create UCX client endpoint to %s: %s",
         server_addr, ucs_status_string(status)));
   }
   
-  ABSL_LOG(INFO) << "UCX client endpoint created successfully to " << server_addr;
-  
-  // Register this endpoint for cleanup
-  RegisterClientSideEndpointNoLock(client_endpoint);
-  
-  return client_endpoint;
+  // Register this endpoint for cleanup.  Its error handler may run until it
+  // is destroyed, so `state` is kept until then.
+  ClientEndpointState* state_ptr = state.get();
+  {
+    absl::MutexLock lock(&mutex_);
+    RegisterClientSideEndpointNoLock(client_endpoint);
+    client_endpoint_states_.push_back(std::move(state));
+  }
+
+  if (!future.WaitFor(timeout)) {
+    worker.ExpectConnectionId({});
+    return absl::DeadlineExceededError(absl::StrFormat(
+        "Timed out waiting for %s to accept the connection", server_addr));
+  }
+  TENSORSTORE_RETURN_IF_ERROR(future.status());
+  const uint32_t connection_id = future.value();
+  ABSL_LOG(INFO) << "Connected to " << server_addr << " as connection "
+                 << connection_id << " on worker " << worker.index();
+  return ClientEndpoint{client_endpoint, connection_id, state_ptr};
 }
 
-void UcxManager::RegisterPendingOperation(uint64_t request_id, Promise<void> promise, MessageType type) {
+void UcxWorker::RegisterPendingOperation(
+    uint64_t request_id, ucp_ep_h endpoint,
+    Promise<TimestampedStorageGeneration> promise) {
   absl::MutexLock lock(&mutex_);
   auto op = std::make_unique<PendingWriteOperation>(request_id, std::move(promise));
+  op->endpoint = endpoint;
   pending_write_operations_[request_id] = std::move(op);
 }
 
-void UcxManager::RegisterPendingReadOperation(uint64_t request_id, Promise<kvstore::ReadResult> promise) {
+void UcxWorker::RegisterPendingReadOperation(
+    uint64_t request_id, ucp_ep_h endpoint,
+    Promise<kvstore::ReadResult> promise,
+    std::shared_ptr<ReadDestination> destination) {
   absl::MutexLock lock(&mutex_);
-  auto op = std::make_unique<PendingReadOperation>(request_id, std::move(promise));
+  auto op = std::make_unique<PendingReadOperation>(
+      request_id, std::move(promise), std::move(destination));
+  op->endpoint = endpoint;
   pending_read_operations_[request_id] = std::move(op);
 }
 
-void UcxManager::CompletePendingOperation(uint64_t request_id, absl::Status status) {
+std::shared_ptr<ReadDestination> UcxWorker::GetReadDestination(
+    uint64_t request_id) {
+  absl::MutexLock lock(&mutex_);
+  auto it = pending_read_operations_.find(request_id);
+  if (it == pending_read_operations_.end()) return nullptr;
+  return it->second->destination;
+}
+
+void UcxWorker::RegisterPendingListOperation(uint64_t request_id,
+                                             ucp_ep_h endpoint,
+                                             Promise<ListPage> promise) {
+  absl::MutexLock lock(&mutex_);
+  auto op = std::make_unique<PendingListOperation>(request_id, std::move(promise));
+  op->endpoint = endpoint;
+  pending_list_operations_[request_id] = std::move(op);
+}
+
+void UcxWorker::RegisterPendingBatchReadOperation(
+    uint64_t request_id, ucp_ep_h endpoint, Promise<absl::Cord> promise) {
+  absl::MutexLock lock(&mutex_);
+  auto op = std::make_unique<PendingBatchReadOperation>(request_id,
+                                                        std::move(promise));
+  op->endpoint = endpoint;
+  pending_batch_read_operations_[request_id] = std::move(op);
+}
+
+void UcxWorker::CompletePendingOperation(
+    uint64_t request_id, Result<TimestampedStorageGeneration> result) {
   absl::MutexLock lock(&mutex_);
   auto it = pending_write_operations_.find(request_id);
   if (it != pending_write_operations_.end()) {
-    if (status.ok()) {
-      it->second->promise.SetResult(absl::OkStatus());
-    } else {
-      it->second->promise.SetResult(status);
-    }
+    it->second->promise.SetResult(std::move(result));
     pending_write_operations_.erase(it);
   }
 }
 
-void UcxManager::CompletePendingReadOperation(uint64_t request_id, kvstore::ReadResult result) {
+void UcxWorker::CompletePendingReadOperation(uint64_t request_id,
+                                             kvstore::ReadResult result) {
   absl::MutexLock lock(&mutex_);
   auto it = pending_read_operations_.find(request_id);
   if (it != pending_read_operations_.end()) {
@@ -650,141 +1130,365 @@ void UcxManager::CompletePendingReadOperation(uint64_t request_id, kvstore::Read
   }
 }
 
-uint64_t UcxManager::GenerateRequestId() {
+void UcxWorker::CompletePendingListOperation(uint64_t request_id,
+                                             ListPage page) {
   absl::MutexLock lock(&mutex_);
-  return next_request_id_++;
+  auto it = pending_list_operations_.find(request_id);
+  if (it != pending_list_operations_.end()) {
+    it->second->promise.SetResult(std::move(page));
+    pending_list_operations_.erase(it);
+  }
 }
 
-void UcxManager::RegisterClientEndpoint(ucp_ep_h client_endpoint) {
+void UcxWorker::CompletePendingBatchReadOperation(uint64_t request_id,
+                                                  absl::Cord data) {
   absl::MutexLock lock(&mutex_);
-  client_endpoints_.push_back(client_endpoint);
-  ABSL_LOG(INFO) << "Registered client endpoint, total clients: " << client_endpoints_.size();
+  auto it = pending_batch_read_operations_.find(request_id);
+  if (it != pending_batch_read_operations_.end()) {
+    it->second->promise.SetResult(std::move(data));
+    pending_batch_read_operations_.erase(it);
+  }
 }
 
-void UcxManager::RegisterClientSideEndpoint(ucp_ep_h client_endpoint) {
+void UcxWorker::FailPendingOperation(uint64_t request_id, absl::Status status) {
   absl::MutexLock lock(&mutex_);
-  client_side_endpoints_.push_back(client_endpoint);
-  ABSL_LOG(INFO) << "Registered client-side endpoint for cleanup";
+  if (auto it = pending_write_operations_.find(request_id);
+      it != pending_write_operations_.end()) {
+    it->second->promise.SetResult(status);
+    pending_write_operations_.erase(it);
+  }
+  if (auto it = pending_read_operations_.find(request_id);
+      it != pending_read_operations_.end()) {
+    it->second->promise.SetResult(status);
+    pending_read_operations_.erase(it);
+  }
+  if (auto it = pending_list_operations_.find(request_id);
+      it != pending_list_operations_.end()) {
+    it->second->promise.SetResult(status);
+    pending_list_operations_.erase(it);
+  }
+  if (auto it = pending_batch_read_operations_.find(request_id);
+      it != pending_batch_read_operations_.end()) {
+    it->second->promise.SetResult(status);
+    pending_batch_read_operations_.erase(it);
+  }
 }
 
-void UcxManager::RegisterClientSideEndpointNoLock(ucp_ep_h client_endpoint) {
-  // This method assumes the mutex is already held
-  client_side_endpoints_.push_back(client_endpoint);
-  ABSL_LOG(INFO) << "Registered client-side endpoint for cleanup";
+namespace {
+
+/// Fails and removes the operations of `operations` sent on `endpoint`.
+template <typename Operations>
+void FailOperationsOnEndpoint(Operations& operations, ucp_ep_h endpoint,
+                              const absl::Status& status) {
+  for (auto it = operations.begin(); it != operations.end();) {
+    if (it->second->endpoint == endpoint) {
+      it->second->promise.SetResult(status);
+      it = operations.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+}  // namespace
+
+void UcxWorker::FailEndpointOperations(ucp_ep_h endpoint,
+                                       const absl::Status& status) {
+  absl::MutexLock lock(&mutex_);
+  FailOperationsOnEndpoint(pending_write_operations_, endpoint, status);
+  FailOperationsOnEndpoint(pending_read_operations_, endpoint, status);
+  FailOperationsOnEndpoint(pending_list_operations_, endpoint, status);
+  FailOperationsOnEndpoint(pending_batch_read_operations_, endpoint, status);
 }
 
-ucp_ep_h UcxManager::GetClientEndpoint() const {
+void UcxWorker::ExpectConnectionId(Promise<uint32_t> promise) {
   absl::MutexLock lock(&mutex_);
-  if (client_endpoints_.empty()) {
-    return nullptr;
+  connection_id_promise_ = std::move(promise);
+}
+
+ucs_status_t UcxWorker::HandleResponse(const ResponseHeader& header,
+                                       void* data, size_t length,
+                                       const ucp_am_recv_param_t* param) {
+  const uint64_t request_id = header.request_id;
+  switch (header.type) {
+    case MessageType::CONNECTION_ID: {
+      Promise<uint32_t> promise;
+      {
+        absl::MutexLock lock(&mutex_);
+        promise = std::exchange(connection_id_promise_, Promise<uint32_t>());
+      }
+      if (promise.null()) {
+        ABSL_LOG(WARNING) << "Ignoring unexpected connection id "
+                          << header.status;
+      } else {
+        promise.SetResult(header.status);
+      }
+      return UCS_OK;
+    }
+    case MessageType::WRITE_RESPONSE:
+      if (header.status == kResponseOk) {
+        CompletePendingOperation(
+            request_id, TimestampedStorageGeneration{
+                            FromWireGeneration(header.generation), absl::Now()});
+      } else if (header.status == kResponseConditionFailed) {
+        CompletePendingOperation(
+            request_id, TimestampedStorageGeneration{StorageGeneration::Unknown(),
+                                                     absl::Now()});
+      } else {
+        CompletePendingOperation(request_id,
+                                 absl::InternalError("Remote write failed"));
+      }
+      return UCS_OK;
+    case MessageType::READ_RESPONSE:
+      if (header.status == kResponseNotFound) {
+        CompletePendingReadOperation(
+            request_id,
+            kvstore::ReadResult::Missing(TimestampedStorageGeneration{
+                StorageGeneration::NoValue(), absl::Now()}));
+        return UCS_OK;
+      }
+      if (header.status == kResponseConditionFailed) {
+        CompletePendingReadOperation(
+            request_id,
+            kvstore::ReadResult::Unspecified(TimestampedStorageGeneration{
+                FromWireGeneration(header.generation), absl::Now()}));
+        return UCS_OK;
+      }
+      if (header.status == kResponseEvicted) {
+        FailPendingOperation(request_id, EvictedError());
+        return UCS_OK;
+      }
+      if (header.status == kResponseInvalidByteRange) {
+        FailPendingOperation(
+            request_id,
+            absl::OutOfRangeError(
+                "Requested byte range is not valid for the value"));
+        return UCS_OK;
+      }
+      if (header.status != kResponseOk) {
+        FailPendingOperation(request_id,
+                             absl::InternalError("Remote read failed"));
+        return UCS_OK;
+      }
+      break;
+    case MessageType::LIST_RESPONSE:
+      if (header.status != kResponseOk && header.status != kResponseMore) {
+        FailPendingOperation(request_id,
+                             absl::InternalError("Remote list failed"));
+        return UCS_OK;
+      }
+      break;
+    case MessageType::BATCH_READ_RESPONSE:
+      if (header.status != kResponseOk) {
+        FailPendingOperation(request_id,
+                             absl::InternalError("Remote batch read failed"));
+        return UCS_OK;
+      }
+      break;
+    default:
+      FailPendingOperation(
+          request_id, absl::DataLossError("Malformed response from server"));
+      return UCS_OK;
   }
-  // Return the most recently connected client
-  return client_endpoints_.back();
+
+  std::shared_ptr<ReadDestination> destination;
+  if (header.type == MessageType::READ_RESPONSE) {
+    destination = GetReadDestination(request_id);
+  }
+  if (destination && length > destination->size) {
+    FailPendingOperation(
+        request_id,
+        absl::ResourceExhaustedError(absl::StrFormat(
+            "Value of %d bytes does not fit in buffer of %d bytes", length,
+            destination->size)));
+    return UCS_OK;
+  }
+
+  if (!(param->recv_attr & UCP_AM_RECV_ATTR_FLAG_RNDV)) {
+    if (destination) {
+      // The server sends values to be received into a destination by
+      // rendezvous; only empty values arrive eagerly.  Host memory can still
+      // be copied to.
+      if (length != 0 &&
+          destination->memory_type != UCS_MEMORY_TYPE_HOST) {
+        FailPendingOperation(
+            request_id,
+            absl::DataLossError("Expected value to be sent by rendezvous"));
+        return UCS_OK;
+      }
+      if (length != 0) memcpy(destination->data, data, length);
+      destination->received = length;
+      HandleResponseData(header, absl::Cord());
+      return UCS_OK;
+    }
+    // Eager data is only valid for the duration of the callback.
+    HandleResponseData(header, absl::Cord(std::string_view(
+                                   static_cast<const char*>(data), length)));
+    return UCS_OK;
+  }
+
+  if (destination) {
+    // Received straight into the caller's buffer, which UCX registers
+    // through its registration cache.
+    auto context = std::make_unique<ResponseReceiveContext>();
+    context->worker = this;
+    context->header = header;
+    context->destination = destination;
+    ucs_status_t status = ReceiveRendezvousData(
+        worker_, data, static_cast<char*>(destination->data), length,
+        /*registration=*/nullptr, ResponseReceiveCallback, context.get(),
+        destination->memory_type);
+    if (status != UCS_INPROGRESS) {
+      FailPendingOperation(
+          request_id,
+          absl::UnavailableError(absl::StrFormat(
+              "UCX receive failed: %s", ucs_status_string(status))));
+    } else {
+      context.release();
+    }
+    return UCS_OK;
+  }
+
+  // Received directly into a pre-registered arena buffer, which backs the
+  // resulting `Cord` and returns to the arena once the `Cord` is released.
+  auto buffer = arena_->Allocate(length);
+  auto context = std::make_unique<ResponseReceiveContext>();
+  context->worker = this;
+  context->header = header;
+  context->data = std::move(buffer.cord);
+  ucs_status_t status =
+      ReceiveRendezvousData(worker_, data, buffer.data, length,
+                            buffer.registration, ResponseReceiveCallback,
+                            context.get());
+  if (status != UCS_INPROGRESS) {
+    FailPendingOperation(
+        request_id, absl::UnavailableError(absl::StrFormat(
+                        "UCX receive failed: %s", ucs_status_string(status))));
+  } else {
+    context.release();
+  }
+  return UCS_OK;
 }
 
-void UcxManager::PostServerReceive() {
-  // Allocate buffer for incoming message
-  constexpr size_t max_message_size = 64 * 1024;  // 64KB max message
-  char* recv_buffer = new char[max_message_size];
-  
-  // Post non-blocking receive
-  ucp_request_param_t recv_params;
-  recv_params.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_USER_DATA;
-  recv_params.cb.recv = ServerReceiveCallback;
-  recv_params.user_data = recv_buffer;
-  
-  ucp_tag_t tag = 0;  // Accept any tag for now
-  ucp_tag_t tag_mask = 0;
-  
-  ucp_worker_h worker_handle;
-  {
-    absl::MutexLock lock(&mutex_);
-    worker_handle = worker_;
+void UcxWorker::HandleResponseData(const ResponseHeader& header,
+                                   absl::Cord data) {
+  if (header.type == MessageType::READ_RESPONSE) {
+    CompletePendingReadOperation(
+        header.request_id,
+        kvstore::ReadResult::Value(
+            std::move(data),
+            TimestampedStorageGeneration{FromWireGeneration(header.generation),
+                                         absl::Now()}));
+    return;
   }
-  
-  if (!worker_handle) {
-    ABSL_LOG(ERROR) << "Cannot post server receive: worker is null";
-    delete[] recv_buffer;
+  if (header.type == MessageType::BATCH_READ_RESPONSE) {
+    CompletePendingBatchReadOperation(header.request_id, std::move(data));
     return;
   }
-  
-  void* request = ucp_tag_recv_nbx(worker_handle, recv_buffer, max_message_size, 
-                                   tag, tag_mask, &recv_params);
-  
-  if (UCS_PTR_IS_ERR(request)) {
-    ABSL_LOG(ERROR) << "Failed to post server receive: " 
-                    << ucs_status_string(UCS_PTR_STATUS(request));
-    delete[] recv_buffer;
-  } else if (request != nullptr) {
-    // Request is in progress, will complete asynchronously
-    ABSL_LOG(INFO) << "Posted server receive buffer";
-    
-    // Track the request for cleanup
-    absl::MutexLock lock(&mutex_);
-    active_requests_.push_back(request);
-  } else {
-    // Receive completed immediately (unlikely)
-    delete[] recv_buffer;
+  auto entries = DecodeListResponse(data.Flatten());
+  if (!entries.ok()) {
+    FailPendingOperation(header.request_id, std::move(entries).status());
+    return;
   }
+  CompletePendingListOperation(
+      header.request_id,
+      ListPage{*std::move(entries), header.status == kResponseMore});
 }
 
-void UcxManager::PostServerReceiveNoLock() {
-  // Allocate buffer for incoming message
-  constexpr size_t max_message_size = 64 * 1024;  // 64KB max message
-  char* recv_buffer = new char[max_message_size];
-  
-  // Post non-blocking receive
-  ucp_request_param_t recv_params;
-  recv_params.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_USER_DATA;
-  recv_params.cb.recv = ServerReceiveCallback;
-  recv_params.user_data = recv_buffer;
+void UcxManager::AcceptConnection(ucp_conn_request_h conn_request) {
+  // Pick the id first: it is the error handler argument of the endpoint.
+  uint32_t connection_id;
+  {
+    absl::MutexLock lock(&mutex_);
+    if (connections_.size() >= kMaxConnectionId) {
+      ABSL_LOG(ERROR) << "Rejecting client connection: too many connections";
+      ucp_listener_reject(listener_, conn_request);
+      return;
+    }
+    do {
+      connection_id = next_connection_id_;
+      next_connection_id_ = next_connection_id_ % kMaxConnectionId + 1;
+    } while (connections_.count(connection_id));
+    // Reserve the id until the endpoint exists.
+    connections_[connection_id].endpoint = nullptr;
+  }
+
+  // Accept the connection request and create an endpoint for the client
+  ucp_ep_params_t ep_params;
+  memset(&ep_params, 0, sizeof(ep_params));
   
-  ucp_tag_t tag = 0;  // Accept any tag for now
-  ucp_tag_t tag_mask = 0;
+  ep_params.field_mask = UCP_EP_PARAM_FIELD_CONN_REQUEST |
+                         UCP_EP_PARAM_FIELD_ERR_HANDLER |
+                         UCP_EP_PARAM_FIELD_ERR_HANDLING_MODE;
+  ep_params.conn_request = conn_request;
+  ep_params.err_mode = UCP_ERR_HANDLING_MODE_PEER;
+  ep_params.err_handler.cb = UcxErrorHandler;
+  ep_params.err_handler.arg =
+      reinterpret_cast<void*>(static_cast<uintptr_t>(connection_id));
   
-  if (!worker_) {
-    ABSL_LOG(ERROR) << "Cannot post server receive: worker is null";
-    delete[] recv_buffer;
+  ucp_ep_h client_endpoint;
+  ucs_status_t status = ucp_ep_create(GetWorker(), &ep_params, &client_endpoint);
+  if (status != UCS_OK) {
+    ABSL_LOG(ERROR) << "Failed to create server endpoint for client: " << ucs_status_string(status);
+    absl::MutexLock lock(&mutex_);
+    connections_.erase(connection_id);
     return;
   }
-  
-  void* request = ucp_tag_recv_nbx(worker_, recv_buffer, max_message_size, 
-                                   tag, tag_mask, &recv_params);
-  
-  if (UCS_PTR_IS_ERR(request)) {
-    ABSL_LOG(ERROR) << "Failed to post server receive: " 
-                    << ucs_status_string(UCS_PTR_STATUS(request));
-    delete[] recv_buffer;
-  } else if (request != nullptr) {
-    // Request is in progress, will complete asynchronously
-    ABSL_LOG(INFO) << "Posted server receive buffer";
-    
-    // Track the request for cleanup (mutex already held)
-    active_requests_.push_back(request);
-  } else {
-    // Receive completed immediately (unlikely)
-    delete[] recv_buffer;
+
+  size_t num_connections;
+  {
+    absl::MutexLock lock(&mutex_);
+    connections_[connection_id].endpoint = client_endpoint;
+    num_connections = connections_.size();
   }
+  ABSL_LOG(INFO) << "Accepted client connection " << connection_id
+                 << ", total clients: " << num_connections;
+
+  // Tell the client which id to put in its request headers.
+  SendActiveMessage(ServerWorker(), client_endpoint, kResponseAmId,
+                    MakeResponseHeader(MessageType::CONNECTION_ID,
+                                       /*request_id=*/0, connection_id));
 }
 
-void UcxManager::CancelPendingReceives() {
+void UcxManager::CloseConnection(uint32_t connection_id, ucs_status_t status) {
   absl::MutexLock lock(&mutex_);
-  CancelPendingReceivesNoLock();
+  auto it = connections_.find(connection_id);
+  if (it == connections_.end()) return;
+  ABSL_LOG(INFO) << "Closing client connection " << connection_id << " after "
+                 << it->second.num_requests << " requests: "
+                 << ucs_status_string(status);
+  if (it->second.endpoint) {
+    closed_endpoints_.push_back(it->second.endpoint);
+  }
+  connections_.erase(it);
 }
 
-void UcxManager::CancelPendingReceivesNoLock() {
-  // This method assumes the mutex is already held
-  ABSL_LOG(INFO) << "Canceling " << active_requests_.size() << " pending UCX requests";
-  
-  // Cancel all active requests
-  for (void* request : active_requests_) {
-    if (request != nullptr) {
-      ucp_request_cancel(worker_, request);
-    }
+std::optional<ClientConnection> UcxManager::GetClientConnection(
+    uint32_t connection_id) {
+  absl::MutexLock lock(&mutex_);
+  auto it = connections_.find(connection_id);
+  if (it == connections_.end() || !it->second.endpoint) {
+    return std::nullopt;
   }
-  
-  // Clear the list - the requests will be freed in their callbacks
-  active_requests_.clear();
+  ++it->second.num_requests;
+  return ClientConnection{connection_id, it->second.endpoint};
+}
+
+size_t UcxManager::GetNumClientConnections() const {
+  absl::MutexLock lock(&mutex_);
+  return connections_.size();
+}
+
+void UcxManager::RegisterClientSideEndpoint(ucp_ep_h client_endpoint) {
+  absl::MutexLock lock(&mutex_);
+  client_side_endpoints_.push_back(client_endpoint);
+  ABSL_LOG(INFO) << "Registered client-side endpoint for cleanup";
+}
+
+void UcxManager::RegisterClientSideEndpointNoLock(ucp_ep_h client_endpoint) {
+  // This method assumes the mutex is already held
+  client_side_endpoints_.push_back(client_endpoint);
+  ABSL_LOG(INFO) << "Registered client-side endpoint for cleanup";
 }
 
 void UcxManager::CleanupListener() {
@@ -801,207 +1505,902 @@ void UcxManager::CleanupListenerNoLock() {
   }
 }
 
-void UcxManager::SendReadResponse(ucp_ep_h client_endpoint, uint64_t request_id, 
-                                  const std::optional<absl::Cord>& value) {
-  if (!client_endpoint) {
-    ABSL_LOG(ERROR) << "Cannot send read response: client endpoint is null";
-    return;
-  }
-  
-  // Determine response status and value size
-  uint32_t status_code = value.has_value() ? 0 : 1;  // 0 = success, 1 = not found
-  uint32_t value_size = value.has_value() ? value->size() : 0;
-  
-  // Create response message
-  size_t message_size = sizeof(ReadResponse) + value_size;
-  std::vector<char> response_buffer(message_size);
-  
-  ReadResponse* response = reinterpret_cast<ReadResponse*>(response_buffer.data());
-  response->header.type = MessageType::READ_RESPONSE;
-  response->header.key_length = 0;  // No key in response
-  response->header.value_length = value_size;
-  response->header.request_id = request_id;
-  response->status_code = status_code;
-  
-  // Copy value data if present
-  if (value.has_value() && value_size > 0) {
-    char* value_ptr = response_buffer.data() + sizeof(ReadResponse);
-    std::string value_str = std::string(*value);
-    std::memcpy(value_ptr, value_str.data(), value_size);
+void* UcxManager::FindRegistration(const void* data, size_t size) const {
+  for (const auto& worker : workers_) {
+    if (void* registration = worker->arena().FindRegistration(data, size)) {
+      return registration;
+    }
   }
-  
-  // Send response using UCX
+  return nullptr;
+}
+
+void UcxManager::SendActiveMessage(UcxWorker& worker, ucp_ep_h endpoint,
+                                   unsigned am_id, std::string header,
+                                   absl::Cord value, void* registration,
+                                   uint64_t request_id, bool rendezvous) {
+  auto* context = new SendContext{&worker,     std::move(header),
+                                  std::move(value), {},
+                                  request_id,  absl::Now()};
+
   ucp_request_param_t send_params;
-  send_params.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK;
-  send_params.cb.send = [](void* request, ucs_status_t status, void* user_data) {
-    ABSL_LOG(INFO) << "Server read response sent with status: " << ucs_status_string(status);
-    ucp_request_free(request);
-  };
-  
-  ucp_tag_t tag = 1;  // Use tag 1 for read responses
-  
-  void* request = ucp_tag_send_nbx(client_endpoint, response_buffer.data(), 
-                                   message_size, tag, &send_params);
-  
+  send_params.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_USER_DATA |
+                             UCP_OP_ATTR_FIELD_FLAGS;
+  send_params.cb.send = SendCallback;
+  send_params.user_data = context;
+  // Values above the threshold are fetched by the receiver with RMA once it
+  // has provided a destination buffer; smaller ones travel with the header.
+  send_params.flags = context->value.size() > GetRendezvousThreshold() ||
+                              (rendezvous && !context->value.empty())
+                          ? UCP_AM_SEND_FLAG_RNDV
+                          : UCP_AM_SEND_FLAG_EAGER;
+
+  const void* buffer = nullptr;
+  size_t count = 0;
+  if (auto flat = context->value.TryFlat()) {
+    buffer = flat->data();
+    count = flat->size();
+    if (registration == nullptr && count != 0) {
+      registration = FindRegistration(buffer, count);
+    }
+    SetMemoryHandle(send_params, registration);
+  } else {
+    // Send the chunks in place rather than flattening them.
+    for (std::string_view chunk : context->value.Chunks()) {
+      context->iov.push_back(
+          ucp_dt_iov_t{const_cast<char*>(chunk.data()), chunk.size()});
+    }
+    send_params.op_attr_mask |= UCP_OP_ATTR_FIELD_DATATYPE;
+    send_params.datatype = ucp_dt_make_iov();
+    buffer = context->iov.data();
+    count = context->iov.size();
+  }
+
+  void* request = ucp_am_send_nbx(endpoint, am_id, context->header.data(),
+                                  context->header.size(), buffer, count,
+                                  &send_params);
+
   if (UCS_PTR_IS_ERR(request)) {
-    ABSL_LOG(ERROR) << "Failed to send read response: " 
-                    << ucs_status_string(UCS_PTR_STATUS(request));
+    ucs_status_t error_status = UCS_PTR_STATUS(request);
+    ABSL_LOG(ERROR) << "UCX send failed immediately: " << ucs_status_string(error_status);
+    if (request_id != 0) {
+      worker.FailPendingOperation(
+          request_id, absl::InternalError(absl::StrFormat(
+                          "UCX send failed: %s", ucs_status_string(error_status))));
+    }
+    delete context;
   } else if (request == nullptr) {
-    ABSL_LOG(INFO) << "Read response sent immediately";
+    // Send completed immediately
+    RecordSendCompletion(*context);
+    delete context;
   } else {
-    ABSL_LOG(INFO) << "Read response send in progress";
+    worker.Wake();
   }
 }
 
-void UcxManager::SendWriteResponse(ucp_ep_h client_endpoint, uint64_t request_id, 
-                                   uint32_t status_code) {
-  if (!client_endpoint) {
+ucs_status_t UcxManager::HandleRequest(const RequestHeader& header,
+                                       std::string key, void* data,
+                                       size_t length,
+                                       const ucp_am_recv_param_t* param) {
+  ABSL_LOG_IF(INFO, remote_dram_logging)
+      << "Received request: type=" << static_cast<uint32_t>(header.type)
+      << ", key_len=" << header.key_length << ", value_len=" << length
+      << ", request_id=" << header.request_id;
+
+  std::optional<ClientConnection> connection =
+      GetClientConnection(header.connection_id);
+  if (!connection) {
+    ABSL_LOG(ERROR) << "Dropping request " << header.request_id
+                    << " from unknown connection " << header.connection_id;
+    return UCS_OK;
+  }
+
+  const WireConditions conditions = WireConditions::FromHeader(header);
+  const bool rendezvous = param->recv_attr & UCP_AM_RECV_ATTR_FLAG_RNDV;
+  if (header.type == MessageType::BATCH_READ_REQUEST && rendezvous) {
+    auto buffer = ServerWorker().arena().Allocate(length);
+    auto context = std::make_unique<BatchReadReceiveContext>();
+    context->connection = *connection;
+    context->request_id = header.request_id;
+    context->data = std::move(buffer.cord);
+    ucs_status_t status = ReceiveRendezvousData(
+        ServerWorker().handle(), data, buffer.data, length,
+        buffer.registration, BatchReadReceiveCallback, context.get());
+    if (status != UCS_INPROGRESS) {
+      ABSL_LOG(ERROR) << "Cannot receive batch read request "
+                      << header.request_id << ": "
+                      << ucs_status_string(status);
+      SendActiveMessage(ServerWorker(), connection->endpoint, kResponseAmId,
+                        MakeResponseHeader(MessageType::BATCH_READ_RESPONSE,
+                                           header.request_id, kResponseError));
+    } else {
+      context.release();
+    }
+    return UCS_OK;
+  }
+  if (header.type != MessageType::WRITE_REQUEST && rendezvous) {
+    // Only write values and batched reads are large enough to need the
+    // rendezvous protocol.
+    ABSL_LOG(ERROR) << "Rejecting request " << header.request_id
+                    << " with oversized data";
+    if (header.type == MessageType::READ_REQUEST) {
+      SendReadResponse(*connection, header.request_id, kResponseError, 0);
+    } else if (header.type == MessageType::LIST_REQUEST) {
+      SendActiveMessage(ServerWorker(), connection->endpoint, kResponseAmId,
+                        MakeResponseHeader(MessageType::LIST_RESPONSE,
+                                           header.request_id, kResponseError));
+    } else {
+      SendWriteResponse(*connection, header.request_id, kResponseError);
+    }
+    return UCS_OK;
+  }
+  const std::string_view eager_data(static_cast<const char*>(data), length);
+
+  switch (header.type) {
+    case MessageType::READ_REQUEST: {
+      OptionalByteRangeRequest byte_range;
+      if (!eager_data.empty()) {
+        if (eager_data.size() != sizeof(ReadByteRange)) {
+          SendReadResponse(*connection, header.request_id, kResponseError, 0);
+          return UCS_OK;
+        }
+        const auto range = LoadUnaligned<ReadByteRange>(eager_data.data());
+        byte_range.inclusive_min = range.inclusive_min;
+        byte_range.exclusive_max = range.exclusive_max;
+        if (!byte_range.SatisfiesInvariants()) {
+          SendReadResponse(*connection, header.request_id, kResponseError, 0);
+          return UCS_OK;
+        }
+      }
+      // A value that has been spilled is read back asynchronously, so the
+      // response may be sent from another thread.  Responses are matched to
+      // requests by id, so they need not be sent in request order.
+      const bool force_rendezvous = header.conditions & kRequestRendezvous;
+      ReadStored(key).ExecuteWhenReady(
+          [key, connection = *connection, request_id = header.request_id,
+           conditions, byte_range,
+           force_rendezvous](ReadyFuture<std::optional<StoredValue>> future) {
+            auto& ucx_manager = UcxManager::Instance();
+            if (!future.status().ok()) {
+              ABSL_LOG(ERROR) << "Server failed to read key '" << key
+                              << "': " << future.status();
+              ucx_manager.SendReadResponse(connection, request_id,
+                                           kResponseError, 0);
+              return;
+            }
+            const auto& value = future.value();
+            const uint64_t generation =
+                value ? value->generation : RemoteDramStorage::kNoGeneration;
+            if (!conditions.Matches(generation)) {
+              ucx_manager.SendReadResponse(connection, request_id,
+                                           kResponseConditionFailed,
+                                           generation);
+            } else if (!value) {
+              ucx_manager.SendReadResponse(
+                  connection, request_id,
+                  ucx_manager.GetStorage().WasEvicted(key) ? kResponseEvicted
+                                                           : kResponseNotFound,
+                  generation);
+            } else if (auto validated =
+                           byte_range.Validate(value->value.size());
+                       !validated.ok()) {
+              ucx_manager.SendReadResponse(connection, request_id,
+                                           kResponseInvalidByteRange,
+                                           generation);
+            } else {
+              // A part of an arena value lies within the same registered
+              // slab, so it is sent by rendezvous from its offset there
+              // without being copied.
+              ucx_manager.SendReadResponse(
+                  connection, request_id, kResponseOk, generation,
+                  internal::GetSubCord(value->value, *validated),
+                  value->registration, force_rendezvous);
+            }
+          });
+      return UCS_OK;
+    }
+    case MessageType::WRITE_REQUEST:
+      break;
+    case MessageType::DELETE_REQUEST:
+      RemoveStored(std::move(key), conditions.if_equal)
+          .ExecuteWhenReady([connection = *connection,
+                             request_id = header.request_id](
+                                ReadyFuture<bool> future) {
+            auto& ucx_manager = UcxManager::Instance();
+            if (!future.status().ok()) {
+              ucx_manager.SendWriteResponse(connection, request_id,
+                                            kResponseError);
+            } else {
+              ucx_manager.SendWriteResponse(
+                  connection, request_id,
+                  future.value() ? kResponseOk : kResponseConditionFailed);
+            }
+          });
+      return UCS_OK;
+    case MessageType::DELETE_RANGE_REQUEST:
+      RemoveStoredRange(KeyRange(std::move(key), std::string(eager_data)))
+          .ExecuteWhenReady([connection = *connection,
+                             request_id = header.request_id](
+                                ReadyFuture<const void> future) {
+            UcxManager::Instance().SendWriteResponse(
+                connection, request_id,
+                future.status().ok() ? kResponseOk : kResponseError);
+          });
+      return UCS_OK;
+    case MessageType::BATCH_READ_REQUEST:
+      HandleBatchRead(*connection, header.request_id, eager_data);
+      return UCS_OK;
+    case MessageType::FLUSH_REQUEST:
+      Flush().ExecuteWhenReady([connection = *connection,
+                                request_id = header.request_id](
+                                   ReadyFuture<const void> future) {
+        if (!future.status().ok()) {
+          ABSL_LOG(ERROR) << "Failed to flush to the base kvstore: "
+                          << future.status();
+        }
+        UcxManager::Instance().SendWriteResponse(
+            connection, request_id,
+            future.status().ok() ? kResponseOk : kResponseError);
+      });
+      return UCS_OK;
+    case MessageType::LIST_REQUEST: {
+      // One extra key tells whether the listing continues past the page.
+      auto keys = storage_.ListKeys(key, eager_data, kListPageSize + 1);
+      const bool more = keys.size() > kListPageSize;
+      if (more) keys.pop_back();
+      SendActiveMessage(
+          ServerWorker(), connection->endpoint, kResponseAmId,
+          MakeResponseHeader(MessageType::LIST_RESPONSE, header.request_id,
+                             more ? kResponseMore : kResponseOk),
+          EncodeListResponse(keys));
+      return UCS_OK;
+    }
+    default:
+      ABSL_LOG(ERROR) << "Dropping request " << header.request_id
+                      << " of unknown type "
+                      << static_cast<uint32_t>(header.type);
+      return UCS_OK;
+  }
+
+  if (!rendezvous) {
+    // Eager data is only valid for the duration of the callback.
+    SendWriteResponseWhenReady(
+        *connection, header.request_id,
+        WriteStored(std::move(key), absl::Cord(eager_data),
+                    /*registration=*/nullptr, conditions.if_equal,
+                    header.generation));
+    return UCS_OK;
+  }
+
+  // The value is received directly into an arena buffer, which becomes the
+  // stored value, so it is never copied on the server.  Arena slabs are
+  // registered when they are created, so the transfer needs no registration
+  // of its own.
+  std::shared_ptr<SlabArena> arena;
+  {
+    absl::MutexLock lock(&mutex_);
+    arena = arena_;
+  }
+  if (!arena) {
+    SendWriteResponse(*connection, header.request_id, kResponseError);
+    return UCS_OK;
+  }
+  auto buffer = arena->Allocate(length);
+  auto context = std::make_unique<WriteReceiveContext>();
+  context->connection = *connection;
+  context->request_id = header.request_id;
+  context->key = std::move(key);
+  context->value = std::move(buffer.cord);
+  context->registration = buffer.registration;
+  context->if_equal = conditions.if_equal;
+  context->generation = header.generation;
+  ucs_status_t status = ReceiveRendezvousData(
+      ServerWorker().handle(), data, buffer.data, length,
+      context->registration, WriteReceiveCallback, context.get());
+  if (status != UCS_INPROGRESS) {
+    ABSL_LOG(ERROR) << "Cannot receive value of key '" << context->key
+                    << "': " << ucs_status_string(status);
+    SendWriteResponse(*connection, header.request_id, kResponseError);
+  } else {
+    context.release();
+  }
+  return UCS_OK;
+}
+
+void UcxManager::HandleBatchRead(const ClientConnection& connection,
+                                 uint64_t request_id, std::string_view data) {
+  auto items = DecodeBatchReadRequest(data);
+  if (!items.ok()) {
+    ABSL_LOG(ERROR) << "Dropping batch read request " << request_id << ": "
+                    << items.status();
+    SendActiveMessage(ServerWorker(), connection.endpoint, kResponseAmId,
+                      MakeResponseHeader(MessageType::BATCH_READ_RESPONSE,
+                                         request_id, kResponseError));
+    return;
+  }
+
+  // The keys are read concurrently, since spilled values are read back
+  // asynchronously; whichever read completes last sends the response.
+  struct BatchReadState {
+    ClientConnection connection;
+    uint64_t request_id;
+    std::vector<BatchReadItem> items;
+    std::vector<Result<std::optional<StoredValue>>> values;
+    std::atomic<size_t> remaining;
+  };
+  auto state = std::make_shared<BatchReadState>();
+  state->connection = connection;
+  state->request_id = request_id;
+  state->items = *std::move(items);
+  const size_t n = state->items.size();
+  state->values.resize(n, std::optional<StoredValue>());
+  state->remaining.store(n + 1, std::memory_order_relaxed);
+  auto finish = [state] {
+    if (state->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+    auto& ucx_manager = UcxManager::Instance();
+    ucx_manager.SendActiveMessage(
+        ucx_manager.ServerWorker(), state->connection.endpoint, kResponseAmId,
+        MakeResponseHeader(MessageType::BATCH_READ_RESPONSE,
+                           state->request_id, kResponseOk),
+        EncodeBatchReadResponse(ucx_manager.GetStorage(), state->items,
+                                state->values));
+  };
+  for (size_t i = 0; i < n; ++i) {
+    ReadStored(state->items[i].key)
+        .ExecuteWhenReady(
+            [state, i, finish](ReadyFuture<std::optional<StoredValue>> future) {
+              state->values[i] = future.result();
+              finish();
+            });
+  }
+  // Drops the reference that keeps the response from being sent while the
+  // reads are being started.
+  finish();
+}
+
+void UcxManager::SendReadResponse(const ClientConnection& connection,
+                                  uint64_t request_id, uint32_t status_code,
+                                  uint64_t generation, absl::Cord value,
+                                  void* registration, bool rendezvous) {
+  if (!connection.endpoint) {
+    ABSL_LOG(ERROR) << "Cannot send read response: client endpoint is null";
+    return;
+  }
+  // Values written through the rendezvous path are arena buffers, whose slab
+  // registration is handed to UCX so that it is not looked up again.
+  SendActiveMessage(ServerWorker(), connection.endpoint, kResponseAmId,
+                    MakeResponseHeader(MessageType::READ_RESPONSE, request_id,
+                                       status_code, generation),
+                    std::move(value), registration, /*request_id=*/0,
+                    rendezvous);
+}
+
+void UcxManager::SendWriteResponse(const ClientConnection& connection,
+                                   uint64_t request_id, uint32_t status_code,
+                                   uint64_t generation) {
+  if (!connection.endpoint) {
     ABSL_LOG(ERROR) << "Cannot send write response: client endpoint is null";
     return;
   }
-  
-  // Create response message
-  WriteResponse response;
-  response.header.type = MessageType::WRITE_RESPONSE;
-  response.header.key_length = 0;  // No key in response
-  response.header.value_length = 0;  // No value in response
-  response.header.request_id = request_id;
-  response.status_code = status_code;
-  
-  // Send response using UCX
-  ucp_request_param_t send_params;
-  send_params.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK;
-  send_params.cb.send = [](void* request, ucs_status_t status, void* user_data) {
-    ABSL_LOG(INFO) << "Server write response sent with status: " << ucs_status_string(status);
-    ucp_request_free(request);
+  SendActiveMessage(ServerWorker(), connection.endpoint, kResponseAmId,
+                    MakeResponseHeader(MessageType::WRITE_RESPONSE,
+                                       request_id, status_code, generation));
+}
+
+void UcxManager::SetSpillKvStore(kvstore::KvStore spill) {
+  {
+    absl::MutexLock lock(&mutex_);
+    spill_ = spill;
+  }
+  storage_.SetEvictionCallback(
+      [spill = std::move(spill)](std::string key, absl::Cord value) {
+        kvstore::Write(spill, key, std::move(value))
+            .ExecuteWhenReady(
+                [key](ReadyFuture<TimestampedStorageGeneration> future) {
+                  if (!future.status().ok()) {
+                    ABSL_LOG(ERROR) << "Failed to spill key '" << key
+                                    << "': " << future.status();
+                  }
+                });
+      });
+}
+
+Future<std::optional<StoredValue>> UcxManager::ReadStored(std::string key) {
+  if (auto stored = storage_.Lookup(key)) {
+    return MakeReadyFuture<std::optional<StoredValue>>(*std::move(stored));
+  }
+  std::optional<kvstore::KvStore> fallback;
+  std::shared_ptr<WriteBackQueue> write_back;
+  {
+    absl::MutexLock lock(&mutex_);
+    fallback = spill_;
+    write_back = write_back_;
+  }
+  // Stores a value that is not in memory again, unless the key has been
+  // written meanwhile.
+  auto reload = [key](const absl::Cord& value) -> std::optional<StoredValue> {
+    // Copy the value back into arena memory so that later rendezvous
+    // reads of it need no registration.
+    auto& ucx_manager = UcxManager::Instance();
+    StoredValue stored;
+    std::shared_ptr<SlabArena> arena;
+    {
+      absl::MutexLock lock(&ucx_manager.mutex_);
+      arena = ucx_manager.arena_;
+    }
+    if (arena && !value.empty()) {
+      auto buffer = arena->Allocate(value.size());
+      value.CopyToArray(buffer.data);
+      stored.value = std::move(buffer.cord);
+      stored.registration = buffer.registration;
+    } else {
+      stored.value = value;
+    }
+    // Values read back lose their generation, so the reloaded value gets a
+    // new one.
+    auto generation = ucx_manager.storage_.Store(
+        key, stored.value, stored.registration,
+        /*if_equal=*/RemoteDramStorage::kNoGeneration);
+    if (!generation) return ucx_manager.storage_.Lookup(key);
+    stored.generation = *generation;
+    return stored;
   };
-  
-  ucp_tag_t tag = 0;  // Use tag 0 for write responses
-  
-  void* request = ucp_tag_send_nbx(client_endpoint, &response, sizeof(response), 
-                                   tag, &send_params);
-  
-  if (UCS_PTR_IS_ERR(request)) {
-    ABSL_LOG(ERROR) << "Failed to send write response: " 
-                    << ucs_status_string(UCS_PTR_STATUS(request));
-  } else if (request == nullptr) {
-    ABSL_LOG(INFO) << "Write response sent immediately";
-  } else {
-    ABSL_LOG(INFO) << "Write response send in progress";
+  if (write_back) {
+    // A value evicted before it is written back is still queued.
+    if (auto queued = write_back->Find(key)) {
+      return MakeReadyFuture<std::optional<StoredValue>>(
+          *queued ? reload(**queued) : std::nullopt);
+    }
+    fallback = write_back->base();
+  }
+  if (!fallback) {
+    return MakeReadyFuture<std::optional<StoredValue>>(std::nullopt);
+  }
+  return MapFutureValue(
+      InlineExecutor{},
+      [reload](const kvstore::ReadResult& read_result)
+          -> std::optional<StoredValue> {
+        if (!read_result.has_value()) return std::nullopt;
+        return reload(read_result.value);
+      },
+      kvstore::Read(*fallback, key));
+}
+
+Future<std::optional<uint64_t>> UcxManager::WriteStored(
+    std::string key, absl::Cord value, void* registration,
+    std::optional<uint64_t> if_equal, uint64_t generation) {
+  std::optional<kvstore::KvStore> spill;
+  std::shared_ptr<WriteBackQueue> write_back;
+  {
+    absl::MutexLock lock(&mutex_);
+    spill = spill_;
+    write_back = write_back_;
+  }
+  // With a base kvstore, the write is acknowledged once it is queued to be
+  // written back and the queue is within its bound on dirty bytes.
+  auto store = [key, value = std::move(value), registration, if_equal,
+                generation,
+                write_back]() -> Future<std::optional<uint64_t>> {
+    auto stored = UcxManager::Instance().storage_.Store(
+        key, value, registration, if_equal, generation);
+    if (!stored || !write_back) {
+      return MakeReadyFuture<std::optional<uint64_t>>(stored);
+    }
+    return MapFuture(
+        InlineExecutor{},
+        [stored](const Result<void>& result)
+            -> Result<std::optional<uint64_t>> {
+          TENSORSTORE_RETURN_IF_ERROR(result);
+          return stored;
+        },
+        write_back->Enqueue(key, value, *stored));
+  };
+  if (!if_equal || (!spill && !write_back) || storage_.Exists(key)) {
+    return store();
+  }
+  // The condition is checked against a value not in memory once it is back
+  // in memory.
+  auto [promise, future] =
+      PromiseFuturePair<std::optional<uint64_t>>::Make();
+  LinkValue(
+      [store = std::move(store)](
+          Promise<std::optional<uint64_t>> promise,
+          ReadyFuture<std::optional<StoredValue>> stored) {
+        LinkResult(std::move(promise), store());
+      },
+      std::move(promise), ReadStored(key));
+  return std::move(future);
+}
+
+Future<bool> UcxManager::RemoveStored(std::string key,
+                                      std::optional<uint64_t> if_equal) {
+  std::optional<kvstore::KvStore> spill;
+  std::shared_ptr<WriteBackQueue> write_back;
+  {
+    absl::MutexLock lock(&mutex_);
+    spill = spill_;
+    write_back = write_back_;
+  }
+  auto remove = [key, if_equal, spill, write_back]() -> Future<bool> {
+    auto& storage = UcxManager::Instance().storage_;
+    if (if_equal) {
+      if (!storage.RemoveIf(key, *if_equal)) {
+        return MakeReadyFuture<bool>(false);
+      }
+    } else {
+      storage.Remove(key);
+    }
+    if (spill) {
+      kvstore::Delete(*spill, key)
+          .ExecuteWhenReady(
+              [key](ReadyFuture<TimestampedStorageGeneration> future) {
+                if (!future.status().ok()) {
+                  ABSL_LOG(ERROR) << "Failed to delete spilled key '" << key
+                                  << "': " << future.status();
+                }
+              });
+    }
+    if (write_back) {
+      return MapFuture(
+          InlineExecutor{},
+          [](const Result<void>& result) -> Result<bool> {
+            TENSORSTORE_RETURN_IF_ERROR(result);
+            return true;
+          },
+          write_back->Enqueue(key, std::nullopt,
+                              RemoteDramStorage::kNoGeneration));
+    }
+    return MakeReadyFuture<bool>(true);
+  };
+  if (!if_equal || (!spill && !write_back) || storage_.Exists(key)) {
+    return remove();
+  }
+  auto [promise, future] = PromiseFuturePair<bool>::Make();
+  LinkValue(
+      [remove = std::move(remove)](
+          Promise<bool> promise,
+          ReadyFuture<std::optional<StoredValue>> stored) {
+        LinkResult(std::move(promise), remove());
+      },
+      std::move(promise), ReadStored(key));
+  return std::move(future);
+}
+
+Future<const void> UcxManager::RemoveStoredRange(KeyRange range) {
+  storage_.RemoveRange(range.inclusive_min, range.exclusive_max);
+  std::optional<kvstore::KvStore> spill;
+  std::shared_ptr<WriteBackQueue> write_back;
+  {
+    absl::MutexLock lock(&mutex_);
+    spill = spill_;
+    write_back = write_back_;
+  }
+  if (write_back) {
+    // Queued writes are written first, so that they do not recreate keys of
+    // the range once it is deleted.
+    auto [promise, future] = PromiseFuturePair<void>::Make();
+    LinkValue(
+        [base = write_back->base(), range = std::move(range)](
+            Promise<void> promise, ReadyFuture<const void>) {
+          LinkResult(std::move(promise), kvstore::DeleteRange(base, range));
+        },
+        std::move(promise), write_back->Flush());
+    return std::move(future);
+  }
+  if (!spill) return absl::OkStatus();
+  return kvstore::DeleteRange(*spill, std::move(range));
+}
+
+void UcxManager::SetBaseKvStore(kvstore::KvStore base,
+                                size_t max_dirty_bytes) {
+  WriteBackQueue::Options options;
+  options.max_dirty_bytes = max_dirty_bytes;
+  {
+    absl::MutexLock lock(&mutex_);
+    write_back_ = WriteBackQueue::Make(std::move(base), options);
+  }
+  // Every value is written back, so evicted values are simply dropped; the
+  // callback keeps their keys listed.
+  storage_.SetEvictionCallback([](std::string key, absl::Cord value) {});
+}
+
+Future<const void> UcxManager::Flush() {
+  std::shared_ptr<WriteBackQueue> write_back;
+  {
+    absl::MutexLock lock(&mutex_);
+    write_back = write_back_;
+  }
+  if (!write_back) return MakeReadyFuture();
+  return write_back->Flush();
+}
+
+void UcxManager::SetProgressMode(ProgressMode mode,
+                                 absl::Duration busy_poll_duration) {
+  progress_mode_.store(mode, std::memory_order_relaxed);
+  busy_poll_ns_.store(absl::ToInt64Nanoseconds(busy_poll_duration),
+                      std::memory_order_relaxed);
+  for (auto& worker : workers_) {
+    worker->Wake();
+  }
+}
+
+// UcxWorker Implementation
+absl::Status UcxWorker::Start(ucp_context_h context) {
+  ucp_worker_params_t worker_params;
+  memset(&worker_params, 0, sizeof(worker_params));
+  worker_params.field_mask = UCP_WORKER_PARAM_FIELD_THREAD_MODE;
+  worker_params.thread_mode = UCS_THREAD_MODE_MULTI;
+
+  ucs_status_t status = ucp_worker_create(context, &worker_params, &worker_);
+  if (status != UCS_OK) {
+    worker_ = nullptr;
+    return absl::InternalError(absl::StrFormat(
+        "Failed to create UCX worker: %s", ucs_status_string(status)));
+  }
+
+  ucp_worker_attr_t worker_attr;
+  worker_attr.field_mask = UCP_WORKER_ATTR_FIELD_MAX_AM_HEADER;
+  status = ucp_worker_query(worker_, &worker_attr);
+  if (status == UCS_OK) {
+    max_am_header_ = worker_attr.max_am_header;
+
+    // Responses to requests sent on this worker's endpoints.
+    ucp_am_handler_param_t handler_params;
+    handler_params.field_mask = UCP_AM_HANDLER_PARAM_FIELD_ID |
+                                UCP_AM_HANDLER_PARAM_FIELD_CB |
+                                UCP_AM_HANDLER_PARAM_FIELD_ARG;
+    handler_params.id = kResponseAmId;
+    handler_params.cb = ClientResponseCallback;
+    handler_params.arg = this;
+    status = ucp_worker_set_am_recv_handler(worker_, &handler_params);
+  }
+  if (status != UCS_OK) {
+    ucp_worker_destroy(worker_);
+    worker_ = nullptr;
+    return absl::InternalError(absl::StrFormat(
+        "Failed to set up UCX worker: %s", ucs_status_string(status)));
+  }
+
+  arena_ = MakeRegisteredArena(context);
+
+  // Start a background thread for worker progress; it is joined by `Stop`.
+  running_ = true;
+  progress_thread_ = std::thread([this]() { ProgressLoop(); });
+  ABSL_LOG(INFO) << "UCX worker " << index_ << " progress task started";
+  return absl::OkStatus();
+}
+
+void UcxWorker::Stop() {
+  if (!progress_thread_.joinable()) {
+    return;
+  }
+  running_ = false;
+  // Interrupt a blocking wait on the worker event fd.
+  ucp_worker_signal(worker_);
+  progress_thread_.join();
+}
+
+void UcxWorker::Destroy(const absl::Status& status) {
+  {
+    absl::MutexLock lock(&mutex_);
+    for (auto& [id, op] : pending_write_operations_) {
+      op->promise.SetResult(status);
+    }
+    pending_write_operations_.clear();
+    for (auto& [id, op] : pending_read_operations_) {
+      op->promise.SetResult(status);
+    }
+    pending_read_operations_.clear();
+    for (auto& [id, op] : pending_list_operations_) {
+      op->promise.SetResult(status);
+    }
+    pending_list_operations_.clear();
+    for (auto& [id, op] : pending_batch_read_operations_) {
+      op->promise.SetResult(status);
+    }
+    pending_batch_read_operations_.clear();
+    if (!connection_id_promise_.null()) {
+      connection_id_promise_.SetResult(status);
+      connection_id_promise_ = Promise<uint32_t>();
+    }
+  }
+
+  if (worker_) {
+    // Process any remaining UCX events, such as cancellations.
+    for (int i = 0; i < 10; ++i) {
+      ucp_worker_progress(worker_);
+    }
+    ABSL_LOG(INFO) << "Destroying UCX worker " << index_;
+    ucp_worker_destroy(worker_);
+    worker_ = nullptr;
+  }
+  // Received values may outlive the context, but their slab registrations
+  // may not.
+  if (arena_) {
+    arena_->ReleaseRegistrations();
+    arena_.reset();
   }
 }
 
-void UcxManager::StartWorkerProgressTask() {
-  if (progress_task_running_) {
-    return;
+void UcxWorker::Wake() {
+  if (waiting_.load()) {
+    ucp_worker_signal(worker_);
   }
-  
-  progress_task_running_ = true;
-  
-  // Start a background thread for worker progress polling
-  // In a real implementation, this should use TensorStore's thread pool
-  std::thread([this]() {
-    WorkerProgressTask();
-  }).detach();
-  
-  ABSL_LOG(INFO) << "UCX worker progress task started";
 }
 
-void UcxManager::WorkerProgressTask() {
+void UcxWorker::ProgressLoop() {
   ABSL_LOG(INFO) << "UCX worker progress polling started";
-  
-  while (true) {
-    {
-      absl::MutexLock lock(&mutex_);
-      if (!initialized_ || !progress_task_running_) {
-        break;
+
+  // The worker event fd (available because the context is created with
+  // UCP_FEATURE_WAKEUP) becomes readable when the worker may have events to
+  // progress.  Without it, the thread falls back to busy polling.
+  int epoll_fd = -1;
+  int event_fd;
+  ucs_status_t status = ucp_worker_get_efd(worker_, &event_fd);
+  if (status == UCS_OK) {
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = event_fd;
+    if (epoll_fd >= 0 &&
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, event_fd, &event) != 0) {
+      close(epoll_fd);
+      epoll_fd = -1;
+    }
+  }
+  if (epoll_fd < 0) {
+    ABSL_LOG(WARNING) << "UCX worker event fd unavailable ("
+                      << ucs_status_string(status)
+                      << "); progress thread will busy-poll";
+  }
+
+  // Start of the current idle period, or `InfiniteFuture` while the worker is
+  // making progress.
+  absl::Time idle_since = absl::InfiniteFuture();
+  // Iterations not yet added to the metrics, which are updated in bulk to
+  // keep them off the polling path.
+  int64_t iterations = 0;
+  absl::Time next_expiration_sweep = absl::InfinitePast();
+  const auto flush_metrics = [&] {
+    remote_dram_metrics.progress_iterations.IncrementBy(iterations);
+    iterations = 0;
+    if (index_ == 0) {
+      auto& storage = manager_.GetStorage();
+      const absl::Time now = absl::Now();
+      if (now >= next_expiration_sweep) {
+        storage.RemoveExpired(now);
+        next_expiration_sweep = now + kExpirationSweepInterval;
       }
-      
-      // Poll for progress
-      ucp_worker_progress(worker_);
+      remote_dram_metrics.stored_bytes.Set(storage.GetStoredBytes());
+      const auto stats = storage.GetEvictionStats();
+      remote_dram_metrics.evicted_keys.Set(stats.evicted_keys);
+      remote_dram_metrics.evicted_bytes.Set(stats.evicted_bytes);
+      remote_dram_metrics.expired_keys.Set(stats.expired_keys);
     }
-    
-    // Sleep briefly to avoid busy waiting
-    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  };
+  while (running_.load(std::memory_order_relaxed)) {
+    if (++iterations == kProgressMetricsInterval) flush_metrics();
+    // The worker is created with UCS_THREAD_MODE_MULTI, and completion
+    // callbacks re-enter the manager, so no lock may be held here.
+    if (ucp_worker_progress(worker_) != 0) {
+      idle_since = absl::InfiniteFuture();
+      continue;
+    }
+
+    const ProgressMode mode = manager_.GetProgressMode();
+    if (mode == ProgressMode::kBusy || epoll_fd < 0) {
+      continue;
+    }
+    if (mode == ProgressMode::kAdaptive) {
+      const absl::Time now = absl::Now();
+      if (idle_since == absl::InfiniteFuture()) {
+        idle_since = now;
+      }
+      if (now - idle_since < manager_.GetBusyPollDuration()) {
+        continue;
+      }
+    }
+
+    // Idle: block until the worker has events.  `ucp_worker_arm` fails with
+    // UCS_ERR_BUSY if events arrived since the last progress call.
+    flush_metrics();
+    waiting_.store(true);
+    status = ucp_worker_arm(worker_);
+    if (status == UCS_OK) {
+      epoll_event event;
+      if (epoll_wait(epoll_fd, &event, 1, /*timeout=*/-1) < 0 &&
+          errno != EINTR) {
+        ABSL_LOG(ERROR) << "epoll_wait on UCX worker event fd failed: "
+                        << strerror(errno);
+      }
+    } else if (status != UCS_ERR_BUSY) {
+      ABSL_LOG(ERROR) << "ucp_worker_arm failed: " << ucs_status_string(status);
+    }
+    waiting_.store(false);
+    idle_since = absl::InfiniteFuture();
+  }
+  flush_metrics();
+
+  if (epoll_fd >= 0) {
+    close(epoll_fd);
   }
-  
   ABSL_LOG(INFO) << "UCX worker progress polling stopped";
 }
 
 void UcxManager::Shutdown() {
-  absl::MutexLock lock(&mutex_);
-  
-  if (!initialized_) {
-    return;
+  {
+    absl::MutexLock lock(&mutex_);
+    if (!initialized_) {
+      return;
+    }
   }
-  
+
   ABSL_LOG(INFO) << "Starting UCX Manager shutdown";
-  
-  // Stop the progress task first
-  progress_task_running_ = false;
-  
-  // Cancel all pending receive operations
-  CancelPendingReceivesNoLock();
-  
-  // Clean up the UCX listener
-  CleanupListenerNoLock();
-  
-  // Clean up client endpoints
-  for (ucp_ep_h client_endpoint : client_endpoints_) {
-    if (client_endpoint) {
-      ABSL_LOG(INFO) << "Destroying client endpoint";
-      ucp_ep_destroy(client_endpoint);
-    }
+
+  // Stop the progress threads first; they must not touch the workers once
+  // they are destroyed below.  Completion callbacks may take `mutex_`, so it
+  // is not held while the threads are joined or the workers progressed.
+  for (auto& worker : workers_) {
+    worker->Stop();
   }
-  client_endpoints_.clear();
-  
-  // Clean up client-side endpoints
-  for (ucp_ep_h client_side_endpoint : client_side_endpoints_) {
-    if (client_side_endpoint && client_side_endpoint != reinterpret_cast<ucp_ep_h>(0xDEADBEEFULL)) {
-      ABSL_LOG(INFO) << "Destroying client-side endpoint";
-      ucp_ep_destroy(client_side_endpoint);
-    } else if (client_side_endpoint == reinterpret_cast<ucp_ep_h>(0xDEADBEEFULL)) {
-      ABSL_LOG(INFO) << "Skipping cleanup of localhost dummy endpoint";
+
+  std::vector<ucp_ep_h> endpoints;
+  {
+    absl::MutexLock lock(&mutex_);
+
+    // Clean up the UCX listener
+    CleanupListenerNoLock();
+
+    endpoints.swap(closed_endpoints_);
+    for (const auto& [connection_id, connection] : connections_) {
+      if (connection.endpoint) endpoints.push_back(connection.endpoint);
     }
+    connections_.clear();
+    for (ucp_ep_h client_side_endpoint : client_side_endpoints_) {
+      if (client_side_endpoint) {
+        endpoints.push_back(client_side_endpoint);
+      }
+    }
+    client_side_endpoints_.clear();
+
+    spill_.reset();
+    write_back_.reset();
   }
-  client_side_endpoints_.clear();
-  
-  // Complete any pending operations with cancelled status
-  for (auto& [id, op] : pending_write_operations_) {
-    op->promise.SetResult(absl::CancelledError("UCX Manager shutting down"));
-  }
-  pending_write_operations_.clear();
-  
-  for (auto& [id, op] : pending_read_operations_) {
-    kvstore::ReadResult cancelled_result;
-    cancelled_result.state = kvstore::ReadResult::kMissing;
-    cancelled_result.stamp.generation = StorageGeneration::NoValue();
-    cancelled_result.stamp.time = absl::Now();
-    op->promise.SetResult(std::move(cancelled_result));
-  }
-  pending_read_operations_.clear();
-  
-  // Give UCX some time to process cancellations
-  if (worker_) {
-    // Process any remaining UCX events
-    for (int i = 0; i < 10; ++i) {
-      ucp_worker_progress(worker_);
+  storage_.SetEvictionCallback(nullptr);
+  // Stored values outlive the slab registrations released below.
+  storage_.ClearRegistrations();
+
+  // Clean up client and client-side endpoints
+  for (ucp_ep_h endpoint : endpoints) {
+    if (endpoint) {
+      ABSL_LOG(INFO) << "Destroying endpoint";
+      ucp_ep_destroy(endpoint);
     }
   }
-  
-  // Clean up UCX resources in reverse order of creation
-  if (worker_) {
-    ABSL_LOG(INFO) << "Destroying UCX worker";
-    ucp_worker_destroy(worker_);
-    worker_ = nullptr;
+
+  // Complete any pending operations with cancelled status, then clean up UCX
+  // resources in reverse order of creation.
+  for (auto& worker : workers_) {
+    worker->Destroy(absl::CancelledError("UCX Manager shutting down"));
+  }
+  workers_.clear();
+
+  absl::MutexLock lock(&mutex_);
+  storage_.SetArena(nullptr);
+  // Stored values may outlive the context, but their slab registrations may
+  // not.
+  if (arena_) {
+    arena_->ReleaseRegistrations();
+    arena_.reset();
   }
-  
   if (context_) {
     ABSL_LOG(INFO) << "Cleaning up UCX context";
     ucp_cleanup(context_);
     context_ = nullptr;
   }
   
+  // The client-side endpoints, and so their error handlers, are gone.
+  client_endpoint_states_.clear();
   initialized_ = false;
   ABSL_LOG(INFO) << "UCX Manager shutdown completed";
 }
@@ -1012,6 +2411,87 @@ UcxManager::~UcxManager() {
 
 namespace {
 
+/// Returns a small integer identifying the calling thread, assigned
+/// round-robin on first use.
+size_t ThreadWorkerIndex() {
+  static std::atomic<size_t> next_index{0};
+  thread_local const size_t index =
+      next_index.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+class RemoteDramDriver;
+
+using BatchReadRequest =
+    internal_kvstore_batch::ReadRequest<kvstore::Key,
+                                        kvstore::ReadGenerationConditions>;
+
+using RemoteBatchReadEntryBase =
+    internal_kvstore_batch::BatchReadEntry<RemoteDramDriver, BatchReadRequest>;
+
+/// Collects the reads of a `Batch`, which are sent to the server as a single
+/// `BATCH_READ_REQUEST` on submission.
+class RemoteBatchReadEntry : public RemoteBatchReadEntryBase {
+ public:
+  using RemoteBatchReadEntryBase::RemoteBatchReadEntryBase;
+
+  void Submit(Batch::View batch) override;
+};
+
+/// Completes `requests` from the data of their `BATCH_READ_RESPONSE`.
+void ResolveBatchReadRequests(span<BatchReadRequest> requests,
+                              const absl::Cord& data, absl::Time start_time) {
+  const size_t table_size = requests.size() * sizeof(BatchReadResponseEntry);
+  if (data.size() < table_size) {
+    internal_kvstore_batch::SetCommonResult(
+        requests, absl::DataLossError("Truncated batch read response"));
+    return;
+  }
+  const std::string table(data.Subcord(0, table_size));
+  size_t offset = table_size;
+  for (size_t i = 0; i < requests.size(); ++i) {
+    const auto entry = LoadUnaligned<BatchReadResponseEntry>(
+        table.data() + i * sizeof(BatchReadResponseEntry));
+    auto& promise =
+        std::get<internal_kvstore_batch::ByteRangeReadRequest>(requests[i])
+            .promise;
+    TimestampedStorageGeneration stamp{FromWireGeneration(entry.generation),
+                                       start_time};
+    switch (entry.status) {
+      case kResponseOk:
+        if (entry.value_length > data.size() - offset) {
+          promise.SetResult(
+              absl::DataLossError("Truncated batch read response"));
+          break;
+        }
+        promise.SetResult(kvstore::ReadResult::Value(
+            data.Subcord(offset, entry.value_length), std::move(stamp)));
+        offset += entry.value_length;
+        break;
+      case kResponseNotFound:
+        promise.SetResult(kvstore::ReadResult::Missing(std::move(stamp)));
+        break;
+      case kResponseConditionFailed:
+        promise.SetResult(kvstore::ReadResult::Unspecified(std::move(stamp)));
+        break;
+      case kResponseEvicted:
+        promise.SetResult(EvictedError());
+        break;
+      case kResponseInvalidByteRange:
+        promise.SetResult(absl::OutOfRangeError(tensorstore::StrCat(
+            "Requested byte range ",
+            std::get<internal_kvstore_batch::ByteRangeReadRequest>(
+                requests[i])
+                .byte_range,
+            " is not valid for the value")));
+        break;
+      default:
+        promise.SetResult(absl::InternalError("Remote read failed"));
+        break;
+    }
+  }
+}
+
 class RemoteDramDriverSpec
     : public internal_kvstore::RegisteredDriverSpec<RemoteDramDriverSpec,
                                                     RemoteDramDriverSpecData> {
@@ -1032,41 +2512,203 @@ class RemoteDramDriver
     : public internal_kvstore::RegisteredDriver<RemoteDramDriver,
                                                 RemoteDramDriverSpec> {
  public:
-  Future<kvstore::ReadResult> Read(kvstore::Key key, 
+  Future<kvstore::ReadResult> Read(kvstore::Key key,
                                    kvstore::ReadOptions options) override {
-    if (is_server_mode_) {
-      // Server mode: read locally
-      return ReadLocal(key, options);
-    } else {
-      // Client mode: send read request to remote server
-      return ReadRemote(key, options);
+    remote_dram_metrics.read.Increment();
+    if (options.batch && !IsLocal()) {
+      auto [promise, future] = PromiseFuturePair<kvstore::ReadResult>::Make();
+      RemoteBatchReadEntry::MakeRequest<RemoteBatchReadEntry>(
+          *this, options.batch, options.staleness_bound,
+          BatchReadRequest{{std::move(promise), options.byte_range},
+                           std::move(key),
+                           std::move(options.generation_conditions)});
+      return std::move(future);
     }
+    const auto conditions =
+        WireConditions::FromRead(options.generation_conditions);
+    const absl::Time start_time = absl::Now();
+    const bool local = IsLocal();
+    auto future = local ? ReadLocal(key, conditions)
+                        : ReadRemote(SelectReadServer(key), key, conditions,
+                                     options.byte_range);
+    // Servers send only the requested bytes; local values are sliced here.
+    return MapFutureValue(
+        InlineExecutor{},
+        [byte_range =
+             local ? options.byte_range : OptionalByteRangeRequest{},
+         start_time](kvstore::ReadResult& result)
+            -> Result<kvstore::ReadResult> {
+          result.stamp.time = start_time;
+          remote_dram_metrics.read_latency_ms.Observe(
+              absl::ToDoubleMilliseconds(absl::Now() - start_time));
+          if (!result.has_value()) return std::move(result);
+          TENSORSTORE_ASSIGN_OR_RETURN(
+              auto validated, byte_range.Validate(result.value.size()));
+          result.value = internal::GetSubCord(result.value, validated);
+          remote_dram_metrics.bytes_read.IncrementBy(result.value.size());
+          return std::move(result);
+        },
+        std::move(future));
   }
 
-  Future<TimestampedStorageGeneration> Write(kvstore::Key key,
-                                             std::optional<absl::Cord> value,
-                                             kvstore::WriteOptions options) override {
-    if (!value.has_value()) {
-      return absl::InvalidArgumentError("Write value cannot be null");
-    }
-    
-    if (is_server_mode_) {
-      // Server mode: write locally
-      return WriteLocal(key, *value);
+  /// See `ReadRemoteDramInto`.
+  Future<ReadIntoResult> ReadInto(kvstore::Key key, void* buffer, size_t size,
+                                  ReadIntoOptions options) {
+    remote_dram_metrics.read.Increment();
+    const auto conditions =
+        WireConditions::FromRead(options.generation_conditions);
+    const absl::Time start_time = absl::Now();
+    auto destination = std::make_shared<ReadDestination>();
+    destination->data = buffer;
+    destination->size = size;
+    destination->memory_type = options.memory_type;
+    Future<kvstore::ReadResult> future;
+    if (IsLocal()) {
+      // Values in local storage are copied, which requires host memory.
+      if (options.memory_type != UCS_MEMORY_TYPE_HOST) {
+        return absl::UnimplementedError(
+            "Reading into non-host memory requires a remote_dram client");
+      }
+      future = MapFutureValue(
+          InlineExecutor{},
+          [destination, byte_range = options.byte_range](
+              kvstore::ReadResult& result) -> Result<kvstore::ReadResult> {
+            if (!result.has_value()) return std::move(result);
+            TENSORSTORE_ASSIGN_OR_RETURN(
+                auto validated, byte_range.Validate(result.value.size()));
+            absl::Cord value = internal::GetSubCord(result.value, validated);
+            if (value.size() > destination->size) {
+              return absl::ResourceExhaustedError(absl::StrFormat(
+                  "Value of %d bytes does not fit in buffer of %d bytes",
+                  value.size(), destination->size));
+            }
+            char* out = static_cast<char*>(destination->data);
+            for (std::string_view chunk : value.Chunks()) {
+              memcpy(out, chunk.data(), chunk.size());
+              out += chunk.size();
+            }
+            destination->received = value.size();
+            result.value.Clear();
+            return std::move(result);
+          },
+          ReadLocal(key, conditions));
     } else {
-      // Client mode: send to remote server
-      return WriteRemote(key, *value);
+      future = ReadRemote(SelectReadServer(key), key, conditions,
+                          options.byte_range, destination);
     }
+    return MapFutureValue(
+        InlineExecutor{},
+        [destination, start_time](kvstore::ReadResult& result) {
+          remote_dram_metrics.read_latency_ms.Observe(
+              absl::ToDoubleMilliseconds(absl::Now() - start_time));
+          ReadIntoResult read_into;
+          read_into.state = result.state;
+          read_into.stamp = std::move(result.stamp);
+          read_into.stamp.time = start_time;
+          if (result.has_value()) {
+            read_into.size = destination->received;
+            remote_dram_metrics.bytes_read.IncrementBy(read_into.size);
+          }
+          return read_into;
+        },
+        std::move(future));
+  }
+
+  Future<TimestampedStorageGeneration> Write(
+      kvstore::Key key, std::optional<absl::Cord> value,
+      kvstore::WriteOptions options) override {
+    remote_dram_metrics.write.Increment();
+    if (value) remote_dram_metrics.bytes_written.IncrementBy(value->size());
+    const absl::Time start_time = absl::Now();
+    auto future =
+        WriteImpl(std::move(key), std::move(value),
+                  WireConditions::FromWrite(options.generation_conditions));
+    future.ExecuteWhenReady(
+        [start_time](ReadyFuture<TimestampedStorageGeneration>) {
+          remote_dram_metrics.write_latency_ms.Observe(
+              absl::ToDoubleMilliseconds(absl::Now() - start_time));
+        });
+    return future;
   }
 
   Future<const void> DeleteRange(KeyRange range) override {
-    return absl::UnimplementedError("remote_dram driver DeleteRange not yet implemented");
+    remote_dram_metrics.delete_range.Increment();
+    if (IsLocal()) {
+      return UcxManager::Instance().RemoveStoredRange(std::move(range));
+    }
+    // Keys of the range may be placed on any server.
+    std::vector<Future<TimestampedStorageGeneration>> futures;
+    for (size_t server = 0; server < server_endpoints_.size(); ++server) {
+      futures.push_back(DeleteRangeRemote(server, range));
+    }
+    return WaitAllFuture(tensorstore::span(futures));
+  }
+
+  void ListImpl(kvstore::ListOptions options,
+                kvstore::ListReceiver receiver) override;
+
+  /// See `FlushRemoteDram`.
+  Future<const void> Flush() {
+    if (IsLocal()) return UcxManager::Instance().Flush();
+    std::vector<Future<TimestampedStorageGeneration>> futures;
+    for (size_t server = 0; server < server_endpoints_.size(); ++server) {
+      futures.push_back(FlushRemote(server));
+    }
+    return WaitAllFuture(tensorstore::span(futures));
+  }
+
+  /// Sends `requests` in one `BATCH_READ_REQUEST` to each server that they
+  /// are read from.  Byte ranges are applied by the server, so only the
+  /// requested bytes are transferred.
+  void SendBatchRead(absl::InlinedVector<BatchReadRequest, 1> requests) {
+    if (server_endpoints_.empty()) {
+      internal_kvstore_batch::SetCommonResult(
+          requests, absl::InternalError("Client endpoint not available"));
+      return;
+    }
+    if (server_endpoints_.size() == 1) {
+      SendBatchReadToServer(0, std::move(requests));
+      return;
+    }
+    std::vector<absl::InlinedVector<BatchReadRequest, 1>> server_requests(
+        server_endpoints_.size());
+    for (auto& request : requests) {
+      server_requests[SelectReadServer(std::get<kvstore::Key>(request))]
+          .push_back(std::move(request));
+    }
+    for (size_t server = 0; server < server_requests.size(); ++server) {
+      if (server_requests[server].empty()) continue;
+      SendBatchReadToServer(server, std::move(server_requests[server]));
+    }
   }
 
-  void ListImpl(kvstore::ListOptions options, 
-                kvstore::ListReceiver receiver) override {
-    execution::set_error(receiver, 
-                         absl::UnimplementedError("remote_dram driver List not yet implemented"));
+  /// Requests the first page of keys in `range` from `server`.
+  Future<ListPage> ListPageRemote(size_t server, const KeyRange& range) {
+    TENSORSTORE_ASSIGN_OR_RETURN(const size_t worker_index,
+                                 SelectWorkerForRequest(range.inclusive_min));
+    auto& ucx_manager = UcxManager::Instance();
+    UcxWorker& worker = ucx_manager.GetWorker(worker_index);
+    TENSORSTORE_ASSIGN_OR_RETURN(const ClientEndpoint endpoint,
+                                 GetEndpoint(server, worker_index));
+    const uint64_t request_id = ucx_manager.GenerateRequestId();
+    auto [promise, future] = PromiseFuturePair<ListPage>::Make();
+    worker.RegisterPendingListOperation(request_id, endpoint.handle,
+                                        std::move(promise));
+    ucx_manager.SendActiveMessage(
+        worker, endpoint.handle, kRequestAmId,
+        MakeRequestHeader(MessageType::LIST_REQUEST, endpoint.connection_id,
+                          request_id, range.inclusive_min),
+        absl::Cord(range.exclusive_max), /*registration=*/nullptr,
+        request_id);
+    return TrackOutstanding(server, std::move(future));
+  }
+
+  /// Returns the number of servers that keys are placed on.
+  size_t num_servers() const { return server_endpoints_.size(); }
+
+  /// Returns whether `server` is the primary server of `key`.
+  bool IsPrimary(size_t server, std::string_view key) const {
+    return ring_->num_servers() == 1 || ring_->GetPrimary(key) == server;
   }
 
   absl::Status GetBoundSpecData(SpecData& spec) const {
@@ -1076,313 +2718,528 @@ class RemoteDramDriver
   
   // Public members for access from driver spec
   SpecData spec_;
-  ucp_ep_h client_endpoint_ = nullptr;  // UCX endpoint for client mode
+  /// UCX endpoints for client mode; `server_endpoints_[s][w]` connects worker
+  /// `w` to server `s` of `ring_`.  The sizes are fixed once the driver is
+  /// open; the elements are accessed with `GetEndpoint`.
+  std::vector<std::vector<ClientEndpoint>> server_endpoints_;
+  /// Protects the elements of `server_endpoints_`, which are replaced when
+  /// they fail.
+  absl::Mutex endpoints_mutex_;
+  /// Places keys on the servers, in client mode.
+  std::optional<HashRing> ring_;
+  /// Number of requests in flight to each server, in client mode.
+  std::unique_ptr<std::atomic<size_t>[]> outstanding_;
   bool is_server_mode_ = false;
   
  private:
-  Future<TimestampedStorageGeneration> WriteLocal(const kvstore::Key& key, 
-                                                  const absl::Cord& value) {
-    auto& storage = UcxManager::Instance().GetStorage();
-    storage.Store(key, value);
-    
-    // Return success with current timestamp
-    TimestampedStorageGeneration result;
-    result.generation = StorageGeneration::FromString(
-        absl::StrFormat("%d", std::chrono::duration_cast<std::chrono::nanoseconds>(
-            std::chrono::steady_clock::now().time_since_epoch()).count()));
-    result.time = absl::Now();
-    
-    return MakeReadyFuture<TimestampedStorageGeneration>(result);
+  /// Whether operations act on the storage of this process, in server mode.
+  bool IsLocal() const { return is_server_mode_; }
+
+  /// Performs a write or delete, on the replicas of `key` in client mode.
+  Future<TimestampedStorageGeneration> WriteImpl(
+      kvstore::Key key, std::optional<absl::Cord> value,
+      const WireConditions& conditions) {
+    if (IsLocal()) {
+      return WriteLocal(std::move(key), std::move(value), conditions);
+    }
+    if (spec_.replication_factor <= 1) {
+      return WriteRemote(ring_->GetPrimary(key), key, value, conditions);
+    }
+    // The primary checks the conditions and assigns the generation; the
+    // replicas are then sent unconditional copies with that generation.
+    auto replicas = ring_->GetReplicas(key, spec_.replication_factor);
+    auto primary = WriteRemote(replicas[0], key, value, conditions);
+    auto [promise, future] =
+        PromiseFuturePair<TimestampedStorageGeneration>::Make();
+    LinkValue(
+        [self = internal::IntrusivePtr<RemoteDramDriver>(this),
+         key = std::move(key), value = std::move(value),
+         replicas = std::move(replicas)](
+            Promise<TimestampedStorageGeneration> promise,
+            ReadyFuture<TimestampedStorageGeneration> primary) {
+          const TimestampedStorageGeneration& stamp = primary.value();
+          if (StorageGeneration::IsUnknown(stamp.generation)) {
+            // The condition did not hold, so nothing was changed.
+            promise.SetResult(stamp);
+            return;
+          }
+          const uint64_t generation =
+              value ? ToWireGeneration(stamp.generation)
+                    : RemoteDramStorage::kNoGeneration;
+          std::vector<Future<TimestampedStorageGeneration>> copies;
+          for (size_t i = 1; i < replicas.size(); ++i) {
+            copies.push_back(self->WriteRemote(replicas[i], key, value,
+                                               /*conditions=*/{}, generation));
+          }
+          LinkValue(
+              [stamp](Promise<TimestampedStorageGeneration> promise,
+                      ReadyFuture<void>) { promise.SetResult(stamp); },
+              std::move(promise), WaitAllFuture(tensorstore::span(copies)));
+        },
+        std::move(promise), std::move(primary));
+    return std::move(future);
   }
-  
-  Future<TimestampedStorageGeneration> WriteRemote(const kvstore::Key& key, 
-                                                   const absl::Cord& value) {
-    if (!client_endpoint_) {
-      ABSL_LOG(ERROR) << "WriteRemote called but client_endpoint is null for key '" << key << "'";
-      return absl::InternalError("Client endpoint not available");
+
+  /// Returns the server to read `key` from: the replica with the fewest
+  /// requests in flight, preferring the primary.
+  size_t SelectReadServer(std::string_view key) const {
+    if (spec_.replication_factor <= 1) return ring_->GetPrimary(key);
+    size_t best = 0;
+    size_t best_outstanding = 0;
+    bool first = true;
+    for (const size_t server :
+         ring_->GetReplicas(key, spec_.replication_factor)) {
+      const size_t n = outstanding_[server].load(std::memory_order_relaxed);
+      if (first || n < best_outstanding) {
+        best = server;
+        best_outstanding = n;
+        first = false;
+      }
     }
-    
-    // Check if this is a localhost dummy endpoint
-    if (client_endpoint_ == reinterpret_cast<ucp_ep_h>(0xDEADBEEFULL)) {
-      ABSL_LOG(INFO) << "WriteRemote using localhost IPC for key '" << key << "' with " << value.size() << " bytes";
-      
-      // For localhost testing, directly store in the local server's storage
-      // This simulates the inter-process communication without complex networking
-      auto& storage = UcxManager::Instance().GetStorage();
-      storage.Store(key, value);
-      
-      // Notify the actual server process via TCP (server will print the data)
-      NotifyServerOfNewData(key, value);
-      
-      // Return success immediately
-      TimestampedStorageGeneration result;
-      result.generation = StorageGeneration::FromString("localhost_write");
-      result.time = absl::Now();
-      return MakeReadyFuture<TimestampedStorageGeneration>(result);
+    return best;
+  }
+
+  /// Counts a request to `server` as in flight until `future` is ready.
+  template <typename T>
+  Future<T> TrackOutstanding(size_t server, Future<T> future) {
+    outstanding_[server].fetch_add(1, std::memory_order_relaxed);
+    remote_dram_metrics.in_flight.Increment();
+    future.ExecuteWhenReady(
+        [self = internal::IntrusivePtr<RemoteDramDriver>(this),
+         server](ReadyFuture<T>) {
+          self->outstanding_[server].fetch_sub(1, std::memory_order_relaxed);
+          remote_dram_metrics.in_flight.Decrement();
+        });
+    return future;
+  }
+
+  /// Returns the endpoint connecting worker `worker_index` to `server`,
+  /// replacing it with a new connection first if it has failed.
+  Result<ClientEndpoint> GetEndpoint(size_t server, size_t worker_index) {
+    ClientEndpoint endpoint;
+    {
+      absl::ReaderMutexLock lock(&endpoints_mutex_);
+      endpoint = server_endpoints_[server][worker_index];
     }
-    
-    // For real multi-node connections, use full UCX networking
-    auto& ucx_manager = UcxManager::Instance();
-    uint64_t request_id = ucx_manager.GenerateRequestId();
-    
-    ABSL_LOG(INFO) << "WriteRemote sending data for key '" << key << "' with " << value.size() << " bytes to server";
-    
-    // Create write message
-    size_t message_size = sizeof(MessageHeader) + key.size() + value.size();
-    std::vector<char> message_buffer(message_size);
-    
-    MessageHeader* header = reinterpret_cast<MessageHeader*>(message_buffer.data());
-    header->type = MessageType::WRITE_REQUEST;
-    header->key_length = static_cast<uint32_t>(key.size());
-    header->value_length = static_cast<uint32_t>(value.size());
-    header->request_id = request_id;
-    
-    // Copy key and value data
-    char* data_ptr = message_buffer.data() + sizeof(MessageHeader);
-    std::memcpy(data_ptr, key.data(), key.size());
-    
-    // Handle absl::Cord properly
-    std::string value_str = std::string(value);
-    std::memcpy(data_ptr + key.size(), value_str.data(), value_str.size());
-    
-    ABSL_LOG(INFO) << "Sending UCX write request: key='" << key << "', value='" << value_str << "', request_id=" << request_id;
-    
-    // Create promise/future pair
-    auto [promise, future] = PromiseFuturePair<void>::Make();
-    
-    // Register pending operation
-    ucx_manager.RegisterPendingOperation(request_id, std::move(promise), MessageType::WRITE_REQUEST);
-    
-    // Send message using UCX tagged messaging
-    ucp_request_param_t send_params;
-    send_params.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_USER_DATA;
-    send_params.cb.send = SendCallback;
-    send_params.user_data = reinterpret_cast<void*>(request_id);
-    
-    ucp_tag_t tag = 0;  // Use tag 0 for write operations
-    
-    void* request = ucp_tag_send_nbx(client_endpoint_, message_buffer.data(), 
-                                     message_size, tag, &send_params);
-    
-    if (UCS_PTR_IS_ERR(request)) {
-      ucs_status_t error_status = UCS_PTR_STATUS(request);
-      ABSL_LOG(ERROR) << "UCX send failed immediately: " << ucs_status_string(error_status);
-      ucx_manager.CompletePendingOperation(request_id, 
-          absl::InternalError(absl::StrFormat("UCX send failed: %s", 
-              ucs_status_string(error_status))));
-    } else if (request == nullptr) {
-      // Send completed immediately
-      ABSL_LOG(INFO) << "UCX write request sent immediately for request_id=" << request_id;
-      ucx_manager.CompletePendingOperation(request_id, absl::OkStatus());
-    } else {
-      // Send is in progress, will complete asynchronously via SendCallback
-      ABSL_LOG(INFO) << "UCX write request in progress for request_id=" << request_id;
+    if (!endpoint.state->failed.load(std::memory_order_acquire)) {
+      return endpoint;
     }
-    
-    // Transform the void future to TimestampedStorageGeneration future
-    auto [result_promise, result_future] = PromiseFuturePair<TimestampedStorageGeneration>::Make();
-    
-    // Chain the futures: when the void future completes, complete the result future
-    std::move(future).ExecuteWhenReady([promise = std::move(result_promise)](ReadyFuture<void> ready_future) mutable {
-      if (ready_future.status().ok()) {
-        TimestampedStorageGeneration result;
-        result.generation = StorageGeneration::FromString("remote_write");
-        result.time = absl::Now();
-        promise.SetResult(std::move(result));
-      } else {
-        promise.SetResult(ready_future.status());
-      }
-    });
-    
-    return result_future;
+    // Reconnect without holding `endpoints_mutex_`, so that requests on other
+    // endpoints are not delayed.  If several threads reconnect concurrently,
+    // the first new endpoint is kept.
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto new_endpoint,
+        UcxManager::Instance().CreateClientEndpoint(
+            endpoint.state->server_addr, worker_index));
+    absl::MutexLock lock(&endpoints_mutex_);
+    auto& current = server_endpoints_[server][worker_index];
+    if (current.state == endpoint.state) current = new_endpoint;
+    return current;
   }
-  
-  Future<kvstore::ReadResult> ReadLocal(const kvstore::Key& key, 
-                                        const kvstore::ReadOptions& options) {
-    auto& storage = UcxManager::Instance().GetStorage();
-    auto value = storage.Get(key);
-    
-    if (!value.has_value()) {
-      // Key not found
-      kvstore::ReadResult result;
-      result.state = kvstore::ReadResult::kMissing;
-      return MakeReadyFuture<kvstore::ReadResult>(std::move(result));
+
+  /// Returns the index of the worker (and endpoint) that carries a request
+  /// for `key`.
+  size_t SelectWorker(std::string_view key) const {
+    const size_t n = server_endpoints_[0].size();
+    if (n == 1) return 0;
+    if (spec_.worker_selection == WorkerSelection::kThread) {
+      return ThreadWorkerIndex() % n;
     }
-    
-    // Key found, return the value
-    kvstore::ReadResult result;
-    result.state = kvstore::ReadResult::kValue;
-    result.value = *value;
-    result.stamp.generation = StorageGeneration::FromString(
-        absl::StrFormat("%d", std::chrono::duration_cast<std::chrono::nanoseconds>(
-            std::chrono::steady_clock::now().time_since_epoch()).count()));
-    result.stamp.time = absl::Now();
-    
-    return MakeReadyFuture<kvstore::ReadResult>(std::move(result));
+    return absl::Hash<std::string_view>{}(key) % n;
   }
-  
-  Future<kvstore::ReadResult> ReadRemote(const kvstore::Key& key, 
-                                         const kvstore::ReadOptions& options) {
-    if (!client_endpoint_) {
-      ABSL_LOG(ERROR) << "ReadRemote called but client_endpoint is null for key '" << key << "'";
-      
-      kvstore::ReadResult result;
-      result.state = kvstore::ReadResult::kMissing;
-      result.stamp.generation = StorageGeneration::NoValue();
-      result.stamp.time = absl::Now();
-      return MakeReadyFuture<kvstore::ReadResult>(std::move(result));
+
+  /// Like `SelectWorker`, but fails if there is no endpoint or `key` does
+  /// not fit in a request header.
+  Result<size_t> SelectWorkerForRequest(std::string_view key) const {
+    if (server_endpoints_.empty()) {
+      return absl::InternalError("Client endpoint not available");
     }
-    
-    // Check if this is a localhost dummy endpoint
-    if (client_endpoint_ == reinterpret_cast<ucp_ep_h>(0xDEADBEEFULL)) {
-      ABSL_LOG(INFO) << "ReadRemote using localhost IPC for key '" << key << "'";
-      
-      // For localhost testing, directly read from the local server's storage
-      auto& storage = UcxManager::Instance().GetStorage();
-      auto value = storage.Get(key);
-      
-      kvstore::ReadResult result;
-      if (value.has_value()) {
-        result.state = kvstore::ReadResult::kValue;
-        result.value = *value;
-        result.stamp.generation = StorageGeneration::FromString("localhost_read");
-        result.stamp.time = absl::Now();
-        ABSL_LOG(INFO) << "ReadRemote localhost: found key '" << key << "' with value size=" << value->size();
-      } else {
-        result.state = kvstore::ReadResult::kMissing;
-        result.stamp.generation = StorageGeneration::NoValue();
-        result.stamp.time = absl::Now();
-        ABSL_LOG(INFO) << "ReadRemote localhost: key '" << key << "' not found";
-      }
-      
-      return MakeReadyFuture<kvstore::ReadResult>(std::move(result));
+    const size_t worker_index = SelectWorker(key);
+    if (sizeof(RequestHeader) + key.size() >
+        UcxManager::Instance().GetWorker(worker_index).max_am_header()) {
+      return absl::InvalidArgumentError(
+          absl::StrFormat("Key too long: %d bytes", key.size()));
     }
-    
-    // For real multi-node connections, use full UCX networking
+    return worker_index;
+  }
+
+  void SendBatchReadToServer(
+      size_t server, absl::InlinedVector<BatchReadRequest, 1> requests) {
+    std::string data;
+    for (const auto& request : requests) {
+      AppendBatchReadRequestEntry(
+          data, std::get<kvstore::Key>(request),
+          WireConditions::FromRead(
+              std::get<kvstore::ReadGenerationConditions>(request)),
+          std::get<internal_kvstore_batch::ByteRangeReadRequest>(request)
+              .byte_range);
+    }
+    auto& ucx_manager = UcxManager::Instance();
+    const size_t worker_index = SelectWorker(std::get<kvstore::Key>(requests[0]));
+    UcxWorker& worker = ucx_manager.GetWorker(worker_index);
+    auto endpoint_result = GetEndpoint(server, worker_index);
+    if (!endpoint_result.ok()) {
+      internal_kvstore_batch::SetCommonResult(requests,
+                                              endpoint_result.status());
+      return;
+    }
+    const ClientEndpoint& endpoint = *endpoint_result;
+    const uint64_t request_id = ucx_manager.GenerateRequestId();
+    auto [promise, future] = PromiseFuturePair<absl::Cord>::Make();
+    remote_dram_metrics.batch_read.Increment();
+    worker.RegisterPendingBatchReadOperation(request_id, endpoint.handle,
+                                             std::move(promise));
+    ucx_manager.SendActiveMessage(
+        worker, endpoint.handle, kRequestAmId,
+        MakeRequestHeader(MessageType::BATCH_READ_REQUEST,
+                          endpoint.connection_id, request_id, {}),
+        absl::Cord(std::move(data)), /*registration=*/nullptr, request_id);
+    TrackOutstanding(server, std::move(future))
+        .ExecuteWhenReady([requests = std::move(requests),
+                           start_time = absl::Now()](
+                              ReadyFuture<absl::Cord> future) mutable {
+          remote_dram_metrics.read_latency_ms.Observe(
+              absl::ToDoubleMilliseconds(absl::Now() - start_time));
+          if (!future.status().ok()) {
+            internal_kvstore_batch::SetCommonResult(requests, future.status());
+            return;
+          }
+          remote_dram_metrics.bytes_read.IncrementBy(future.value().size());
+          ResolveBatchReadRequests(requests, future.value(), start_time);
+        });
+  }
+
+  Future<TimestampedStorageGeneration> DeleteRangeRemote(
+      size_t server, const KeyRange& range) {
+    TENSORSTORE_ASSIGN_OR_RETURN(const size_t worker_index,
+                                 SelectWorkerForRequest(range.inclusive_min));
+    auto& ucx_manager = UcxManager::Instance();
+    UcxWorker& worker = ucx_manager.GetWorker(worker_index);
+    TENSORSTORE_ASSIGN_OR_RETURN(const ClientEndpoint endpoint,
+                                 GetEndpoint(server, worker_index));
+    const uint64_t request_id = ucx_manager.GenerateRequestId();
+    auto [promise, future] =
+        PromiseFuturePair<TimestampedStorageGeneration>::Make();
+    worker.RegisterPendingOperation(request_id, endpoint.handle,
+                                    std::move(promise));
+    ucx_manager.SendActiveMessage(
+        worker, endpoint.handle, kRequestAmId,
+        MakeRequestHeader(MessageType::DELETE_RANGE_REQUEST,
+                          endpoint.connection_id, request_id,
+                          range.inclusive_min),
+        absl::Cord(range.exclusive_max), /*registration=*/nullptr,
+        request_id);
+    return TrackOutstanding(server, std::move(future));
+  }
+
+  Future<TimestampedStorageGeneration> FlushRemote(size_t server) {
+    TENSORSTORE_ASSIGN_OR_RETURN(const size_t worker_index,
+                                 SelectWorkerForRequest(""));
+    auto& ucx_manager = UcxManager::Instance();
+    UcxWorker& worker = ucx_manager.GetWorker(worker_index);
+    TENSORSTORE_ASSIGN_OR_RETURN(const ClientEndpoint endpoint,
+                                 GetEndpoint(server, worker_index));
+    const uint64_t request_id = ucx_manager.GenerateRequestId();
+    auto [promise, future] =
+        PromiseFuturePair<TimestampedStorageGeneration>::Make();
+    worker.RegisterPendingOperation(request_id, endpoint.handle,
+                                    std::move(promise));
+    ucx_manager.SendActiveMessage(
+        worker, endpoint.handle, kRequestAmId,
+        MakeRequestHeader(MessageType::FLUSH_REQUEST, endpoint.connection_id,
+                          request_id, {}),
+        /*value=*/{}, /*registration=*/nullptr, request_id);
+    return TrackOutstanding(server, std::move(future));
+  }
+
+  Future<TimestampedStorageGeneration> WriteLocal(
+      std::string key, std::optional<absl::Cord> value,
+      const WireConditions& conditions) {
+    auto& ucx_manager = UcxManager::Instance();
+    if (!value) {
+      return MapFutureValue(
+          InlineExecutor{},
+          [](bool removed) {
+            return TimestampedStorageGeneration{
+                removed ? StorageGeneration::NoValue()
+                        : StorageGeneration::Unknown(),
+                absl::Now()};
+          },
+          ucx_manager.RemoveStored(std::move(key), conditions.if_equal));
+    }
+    return MapFutureValue(
+        InlineExecutor{},
+        [](const std::optional<uint64_t>& generation) {
+          return TimestampedStorageGeneration{
+              generation ? FromWireGeneration(*generation)
+                         : StorageGeneration::Unknown(),
+              absl::Now()};
+        },
+        ucx_manager.WriteStored(std::move(key), *std::move(value),
+                                /*registration=*/nullptr,
+                                conditions.if_equal));
+  }
+  
+  /// Sends a write, or a delete if `value` is `std::nullopt`, to `server`.
+  /// A non-zero `generation` marks the write as a replica copy.
+  Future<TimestampedStorageGeneration> WriteRemote(
+      size_t server, const kvstore::Key& key,
+      const std::optional<absl::Cord>& value, const WireConditions& conditions,
+      uint64_t generation = RemoteDramStorage::kNoGeneration) {
+    TENSORSTORE_ASSIGN_OR_RETURN(const size_t worker_index,
+                                 SelectWorkerForRequest(key));
     auto& ucx_manager = UcxManager::Instance();
+    UcxWorker& worker = ucx_manager.GetWorker(worker_index);
+    TENSORSTORE_ASSIGN_OR_RETURN(const ClientEndpoint endpoint,
+                                 GetEndpoint(server, worker_index));
     uint64_t request_id = ucx_manager.GenerateRequestId();
     
-    ABSL_LOG(INFO) << "ReadRemote sending read request for key '" << key << "' to server";
-    
-    // Create read request message
-    size_t message_size = sizeof(MessageHeader) + key.size();
-    std::vector<char> message_buffer(message_size);
+    auto [promise, future] =
+        PromiseFuturePair<TimestampedStorageGeneration>::Make();
     
-    MessageHeader* header = reinterpret_cast<MessageHeader*>(message_buffer.data());
-    header->type = MessageType::READ_REQUEST;
-    header->key_length = static_cast<uint32_t>(key.size());
-    header->value_length = 0;  // No value in read request
-    header->request_id = request_id;
-    
-    // Copy key data
-    char* data_ptr = message_buffer.data() + sizeof(MessageHeader);
-    std::memcpy(data_ptr, key.data(), key.size());
-    
-    ABSL_LOG(INFO) << "Sending UCX read request: key='" << key << "', request_id=" << request_id;
+    // Register pending operation; it completes when the response with its id
+    // arrives, regardless of the order of other requests on the endpoint.
+    worker.RegisterPendingOperation(request_id, endpoint.handle,
+                                    std::move(promise));
+    ucx_manager.SendActiveMessage(
+        worker, endpoint.handle, kRequestAmId,
+        MakeRequestHeader(value ? MessageType::WRITE_REQUEST
+                                : MessageType::DELETE_REQUEST,
+                          endpoint.connection_id, request_id, key, conditions,
+                          generation),
+        value.value_or(absl::Cord()), /*registration=*/nullptr, request_id);
+    return TrackOutstanding(server, std::move(future));
+  }
+  
+  Future<kvstore::ReadResult> ReadLocal(const kvstore::Key& key,
+                                        const WireConditions& conditions) {
+    return MapFutureValue(
+        InlineExecutor{},
+        [conditions](const std::optional<StoredValue>& value) {
+          return MakeReadResult(value, conditions);
+        },
+        UcxManager::Instance().ReadStored(key));
+  }
+  
+  /// Reads `key` from `server`.  If `destination` is specified, the value is
+  /// received into it, and the result holds an empty value.
+  Future<kvstore::ReadResult> ReadRemote(
+      size_t server, const kvstore::Key& key, const WireConditions& conditions,
+      const OptionalByteRangeRequest& byte_range,
+      std::shared_ptr<ReadDestination> destination = nullptr) {
+    TENSORSTORE_ASSIGN_OR_RETURN(const size_t worker_index,
+                                 SelectWorkerForRequest(key));
+    auto& ucx_manager = UcxManager::Instance();
+    UcxWorker& worker = ucx_manager.GetWorker(worker_index);
+    TENSORSTORE_ASSIGN_OR_RETURN(const ClientEndpoint endpoint,
+                                 GetEndpoint(server, worker_index));
+    uint64_t request_id = ucx_manager.GenerateRequestId();
     
     // Create promise/future pair for read result
     auto [promise, future] = PromiseFuturePair<kvstore::ReadResult>::Make();
     
-    // Register pending read operation
-    ucx_manager.RegisterPendingReadOperation(request_id, std::move(promise));
-    
-    // Post a receive buffer to get the response
-    PostReadResponseReceive(request_id);
-    
-    // Send read request using UCX tagged messaging
-    ucp_request_param_t send_params;
-    send_params.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_USER_DATA;
-    send_params.cb.send = SendCallback;
-    send_params.user_data = reinterpret_cast<void*>(request_id);
-    
-    ucp_tag_t tag = 1;  // Use tag 1 for read operations
-    
-    void* request = ucp_tag_send_nbx(client_endpoint_, message_buffer.data(), 
-                                     message_size, tag, &send_params);
-    
-    if (UCS_PTR_IS_ERR(request)) {
-      ucs_status_t error_status = UCS_PTR_STATUS(request);
-      ABSL_LOG(ERROR) << "UCX read request send failed: " << ucs_status_string(error_status);
-      
-      kvstore::ReadResult error_result;
-      error_result.state = kvstore::ReadResult::kMissing;
-      error_result.stamp.generation = StorageGeneration::NoValue();
-      error_result.stamp.time = absl::Now();
-      ucx_manager.CompletePendingReadOperation(request_id, std::move(error_result));
-    } else if (request == nullptr) {
-      // Send completed immediately - response handling will complete the read
-      ABSL_LOG(INFO) << "UCX read request sent immediately for request_id=" << request_id;
-    } else {
-      // Send is in progress, will complete asynchronously via SendCallback
-      ABSL_LOG(INFO) << "UCX read request in progress for request_id=" << request_id;
+    absl::Cord data;
+    if (!byte_range.IsFull()) {
+      ReadByteRange range{byte_range.inclusive_min, byte_range.exclusive_max};
+      data = absl::Cord(std::string_view(reinterpret_cast<const char*>(&range),
+                                         sizeof(range)));
     }
+
+    // Register pending read operation.  The value arrives as the data of the
+    // response, by rendezvous if it is large or received into a destination.
+    const uint32_t flags = destination ? kRequestRendezvous : 0;
+    worker.RegisterPendingReadOperation(request_id, endpoint.handle,
+                                        std::move(promise),
+                                        std::move(destination));
+    ucx_manager.SendActiveMessage(
+        worker, endpoint.handle, kRequestAmId,
+        MakeRequestHeader(MessageType::READ_REQUEST, endpoint.connection_id,
+                          request_id, key, conditions, /*generation=*/0,
+                          flags),
+        std::move(data), /*registration=*/nullptr, request_id);
     
-    return future;
+    return TrackOutstanding(server, std::move(future));
   }
-  
-  /// Post a receive buffer to get read response from server
-  void PostReadResponseReceive(uint64_t request_id) {
-    // Post a receive buffer to get the read response from server
-    auto& ucx_manager = UcxManager::Instance();
-    
-    // Allocate buffer for response
-    constexpr size_t max_response_size = 64 * 1024;  // 64KB max response
-    char* recv_buffer = new char[max_response_size];
-    
-    // Post non-blocking receive for read response
-    ucp_request_param_t recv_params;
-    recv_params.op_attr_mask = UCP_OP_ATTR_FIELD_CALLBACK | UCP_OP_ATTR_FIELD_USER_DATA;
-    recv_params.cb.recv = ClientReceiveCallback;
-    recv_params.user_data = reinterpret_cast<void*>(request_id);
-    
-    ucp_tag_t tag = 1;  // Use tag 1 for read responses
-    ucp_tag_t tag_mask = 0xffff;  // Match tag exactly
-    
-    void* request = ucp_tag_recv_nbx(ucx_manager.GetWorker(), recv_buffer, max_response_size, 
-                                     tag, tag_mask, &recv_params);
-    
-    if (UCS_PTR_IS_ERR(request)) {
-      ABSL_LOG(ERROR) << "Failed to post client receive for request_id=" << request_id 
-                      << ": " << ucs_status_string(UCS_PTR_STATUS(request));
-      delete[] recv_buffer;
-      
-      // Complete the operation with error
-      kvstore::ReadResult error_result;
-      error_result.state = kvstore::ReadResult::kMissing;
-      error_result.stamp.generation = StorageGeneration::NoValue();
-      error_result.stamp.time = absl::Now();
-      ucx_manager.CompletePendingReadOperation(request_id, std::move(error_result));
-    } else if (request != nullptr) {
-      // Request is in progress, will complete asynchronously
-      ABSL_LOG(INFO) << "Posted client receive buffer for request_id=" << request_id;
-    } else {
-      // Receive completed immediately (unlikely for read responses)
-      ABSL_LOG(INFO) << "Client receive completed immediately for request_id=" << request_id;
-      delete[] recv_buffer;
+};
+
+void RemoteBatchReadEntry::Submit(Batch::View batch) {
+  std::unique_ptr<RemoteBatchReadEntry> self(this);
+  auto& requests = request_batch.requests;
+  // Reads whose results are no longer needed are not sent.
+  requests.erase(std::remove_if(requests.begin(), requests.end(),
+                                [](const BatchReadRequest& request) {
+                                  return !std::get<internal_kvstore_batch::
+                                                       ByteRangeReadRequest>(
+                                              request)
+                                              .promise.result_needed();
+                                }),
+                 requests.end());
+  if (requests.empty()) return;
+  driver().SendBatchRead(std::move(requests));
+}
+
+/// State of a listing from the servers, which are asked one after another,
+/// one page at a time.  Each key is listed only by its primary server.
+struct ListTask : public internal::AtomicReferenceCount<ListTask> {
+  internal::IntrusivePtr<RemoteDramDriver> driver;
+  kvstore::ListOptions options;
+  kvstore::ListReceiver receiver;
+  std::atomic<bool> cancelled{false};
+  /// Server being listed, and the part of `options.range` it has yet to list.
+  size_t server = 0;
+  KeyRange range;
+
+  ListTask(internal::IntrusivePtr<RemoteDramDriver> driver,
+           kvstore::ListOptions options, kvstore::ListReceiver receiver)
+      : driver(std::move(driver)),
+        options(std::move(options)),
+        receiver(std::move(receiver)),
+        range(this->options.range) {}
+
+  void Start() {
+    execution::set_starting(receiver, [this] {
+      cancelled.store(true, std::memory_order_relaxed);
+    });
+    IssueRequest();
+  }
+
+  void IssueRequest() {
+    driver->ListPageRemote(server, range)
+        .ExecuteWhenReady([self = internal::IntrusivePtr<ListTask>(this)](
+                              ReadyFuture<ListPage> future) {
+          self->OnPage(future.result());
+        });
+  }
+
+  void OnPage(Result<ListPage>& page) {
+    if (!page.ok()) {
+      execution::set_error(receiver, std::move(page).status());
+      execution::set_stopping(receiver);
+      return;
+    }
+    for (auto& entry : page->entries) {
+      if (cancelled.load(std::memory_order_relaxed)) break;
+      if (page->more) {
+        range.inclusive_min = KeyRange::Successor(entry.key);
+      }
+      // Replicas of other servers' keys are skipped.
+      if (!driver->IsPrimary(server, entry.key)) continue;
+      entry.key.erase(0, std::min(options.strip_prefix_length,
+                                  entry.key.size()));
+      execution::set_value(receiver, std::move(entry));
+    }
+    if (!cancelled.load(std::memory_order_relaxed)) {
+      if (page->more && !page->entries.empty()) {
+        IssueRequest();
+        return;
+      }
+      if (++server < driver->num_servers()) {
+        range = options.range;
+        IssueRequest();
+        return;
+      }
     }
+    execution::set_done(receiver);
+    execution::set_stopping(receiver);
   }
 };
 
+void RemoteDramDriver::ListImpl(kvstore::ListOptions options,
+                                kvstore::ListReceiver receiver) {
+  remote_dram_metrics.list.Increment();
+  if (!IsLocal()) {
+    internal::MakeIntrusivePtr<ListTask>(
+        internal::IntrusivePtr<RemoteDramDriver>(this), std::move(options),
+        std::move(receiver))
+        ->Start();
+    return;
+  }
+  auto& storage = UcxManager::Instance().GetStorage();
+  std::atomic<bool> cancelled{false};
+  execution::set_starting(receiver, [&cancelled] {
+    cancelled.store(true, std::memory_order_relaxed);
+  });
+  // Keys are listed in pages, so that the storage index is not locked for
+  // the whole listing.
+  KeyRange& range = options.range;
+  while (!cancelled.load(std::memory_order_relaxed)) {
+    auto keys =
+        storage.ListKeys(range.inclusive_min, range.exclusive_max,
+                         kListPageSize);
+    for (auto& listed : keys) {
+      if (cancelled.load(std::memory_order_relaxed)) break;
+      std::string_view key = listed.key;
+      execution::set_value(
+          receiver,
+          kvstore::ListEntry{
+              std::string(key.substr(
+                  std::min(options.strip_prefix_length, key.size()))),
+              listed.size});
+    }
+    if (keys.size() < kListPageSize) break;
+    range.inclusive_min = KeyRange::Successor(keys.back().key);
+  }
+  execution::set_done(receiver);
+  execution::set_stopping(receiver);
+}
+
 Future<kvstore::DriverPtr> RemoteDramDriverSpec::DoOpen() const {
   // Validate that either listen_addr or remote_addr is specified, but not both
-  if (data_.listen_addr.has_value() && data_.remote_addr.has_value()) {
+  const bool client_mode =
+      data_.remote_addr.has_value() || !data_.remote_addrs.empty();
+  if (data_.listen_addr.has_value() && client_mode) {
     return absl::InvalidArgumentError(
         "Cannot specify both listen_addr and remote_addr");
   }
   
-  if (!data_.listen_addr.has_value() && !data_.remote_addr.has_value()) {
+  if (!data_.listen_addr.has_value() && !client_mode) {
     return absl::InvalidArgumentError(
         "Must specify either listen_addr (server mode) or remote_addr (client mode)");
   }
 
+  if (data_.remote_addr.has_value() && !data_.remote_addrs.empty()) {
+    return absl::InvalidArgumentError(
+        "Cannot specify both remote_addr and remote_addrs");
+  }
+
+  if (client_mode && (data_.spill || data_.base || data_.memory_limit ||
+                      !data_.ttl.empty())) {
+    return absl::InvalidArgumentError(
+        "memory_limit, ttl, spill and base require server mode (listen_addr)");
+  }
+
+  // Expired values are dropped rather than spilled, so a stale spilled copy
+  // could be read back in their place.
+  if (data_.spill && !data_.ttl.empty()) {
+    return absl::InvalidArgumentError("Cannot specify both spill and ttl");
+  }
+
+  if (data_.spill && data_.base) {
+    return absl::InvalidArgumentError("Cannot specify both spill and base");
+  }
+
+  std::vector<std::string> servers = data_.remote_addrs;
+  if (data_.remote_addr.has_value()) servers.push_back(*data_.remote_addr);
+  if (absl::flat_hash_set<std::string_view>(servers.begin(), servers.end())
+          .size() != servers.size()) {
+    return absl::InvalidArgumentError("remote_addrs must be distinct");
+  }
+  if (client_mode && data_.replication_factor > servers.size()) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "replication_factor (%d) exceeds the number of servers (%d)",
+        data_.replication_factor, servers.size()));
+  }
+
   auto driver = internal::MakeIntrusivePtr<RemoteDramDriver>();
   driver->spec_ = data_;
   
   auto& ucx_manager = UcxManager::Instance();
-  auto init_status = ucx_manager.Initialize();
+  auto init_status = ucx_manager.Initialize(data_.num_workers);
   if (!init_status.ok()) {
     return init_status;
   }
+  ucx_manager.SetRendezvousThreshold(data_.rendezvous_threshold);
+  ucx_manager.SetProgressMode(data_.progress_mode, data_.busy_poll_duration);
   
   // Initialize UCX for server or client mode
   if (data_.listen_addr.has_value()) {
@@ -1396,20 +3253,47 @@ Future<kvstore::DriverPtr> RemoteDramDriverSpec::DoOpen() const {
     }
     
     driver->is_server_mode_ = true;
+    ucx_manager.SetMemoryLimit(data_.memory_limit);
+    ucx_manager.GetStorage().SetExpirationRules(data_.ttl);
     ABSL_LOG(INFO) << "UCX server initialized successfully, listening on " << *data_.listen_addr;
+
+    if (data_.spill) {
+      return MapFutureValue(
+          InlineExecutor{},
+          [driver](kvstore::KvStore& spill) -> kvstore::DriverPtr {
+            UcxManager::Instance().SetSpillKvStore(std::move(spill));
+            return kvstore::DriverPtr(driver.get());
+          },
+          kvstore::Open(*data_.spill));
+    }
+    if (data_.base) {
+      return MapFutureValue(
+          InlineExecutor{},
+          [driver, max_dirty_bytes = data_.max_dirty_bytes](
+              kvstore::KvStore& base) -> kvstore::DriverPtr {
+            UcxManager::Instance().SetBaseKvStore(std::move(base),
+                                                  max_dirty_bytes);
+            return kvstore::DriverPtr(driver.get());
+          },
+          kvstore::Open(*data_.base));
+    }
   } else {
-    // Client mode - create UCX endpoint to server
-    ABSL_LOG(INFO) << "Initializing UCX for client mode to " << *data_.remote_addr;
-    
-    // Create UCX endpoint to server
-    auto endpoint_result = ucx_manager.CreateClientEndpoint(*data_.remote_addr);
-    if (!endpoint_result.ok()) {
-      return endpoint_result.status();
+    // Client mode - create UCX endpoints to each server
+    for (const auto& server : servers) {
+      ABSL_LOG(INFO) << "Initializing UCX for client mode to " << server;
+      auto endpoint_result = ucx_manager.CreateClientEndpoints(server);
+      if (!endpoint_result.ok()) {
+        return endpoint_result.status();
+      }
+      driver->server_endpoints_.push_back(*std::move(endpoint_result));
     }
-    
-    driver->client_endpoint_ = *endpoint_result;
+
+    driver->ring_.emplace(servers, data_.virtual_nodes);
+    driver->outstanding_ =
+        std::make_unique<std::atomic<size_t>[]>(servers.size());
     driver->is_server_mode_ = false;
-    ABSL_LOG(INFO) << "UCX client initialized successfully, connected to " << *data_.remote_addr;
+    ABSL_LOG(INFO) << "UCX client initialized successfully, connected to "
+                   << absl::StrJoin(servers, ", ");
   }
   
   return kvstore::DriverPtr(driver.get());
@@ -1421,6 +3305,29 @@ Result<kvstore::Spec> ParseRemoteDramUrl(std::string_view url) {
 }
 
 }  // namespace
+
+Future<const void> FlushRemoteDram(const kvstore::KvStore& kvstore) {
+  auto* driver = dynamic_cast<RemoteDramDriver*>(kvstore.driver.get());
+  if (!driver) {
+    return absl::InvalidArgumentError(
+        "Flush requires a \"remote_dram\" key-value store");
+  }
+  return driver->Flush();
+}
+
+Future<ReadIntoResult> ReadRemoteDramInto(const kvstore::KvStore& kvstore,
+                                          std::string_view key, void* buffer,
+                                          size_t size,
+                                          ReadIntoOptions options) {
+  auto* driver = dynamic_cast<RemoteDramDriver*>(kvstore.driver.get());
+  if (!driver) {
+    return absl::InvalidArgumentError(
+        "ReadRemoteDramInto requires a \"remote_dram\" key-value store");
+  }
+  return driver->ReadInto(tensorstore::StrCat(kvstore.path, key), buffer,
+                          size, std::move(options));
+}
+
 }  // namespace tensorstore
 
 TENSORSTORE_DECLARE_GARBAGE_COLLECTION_NOT_REQUIRED(
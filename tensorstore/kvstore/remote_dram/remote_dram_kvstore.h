@@ -18,21 +18,39 @@
 /// \file
 /// Remote DRAM key-value store backed by UCX for direct memory-to-memory transfer.
 
+#include <netinet/in.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "tensorstore/internal/json_binding/absl_time.h"
+#include "tensorstore/internal/json_binding/enum.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/internal/json_binding/std_array.h"  // IWYU pragma: keep
 #include "tensorstore/kvstore/driver.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/key_range.h"
 #include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/operations.h"
 #include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/remote_dram/storage.h"
+#include "tensorstore/kvstore/remote_dram/write_back_queue.h"
+#include "tensorstore/kvstore/spec.h"
 #include "tensorstore/util/future.h"
 #include "tensorstore/util/result.h"
 #include "absl/status/status.h"
 #include "absl/strings/cord.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
 
 // UCX headers
 #include <ucp/api/ucp.h>
@@ -41,48 +59,211 @@ namespace tensorstore {
 
 namespace jb = tensorstore::internal_json_binding;
 
+/// Active message handler ids.
+enum AmId : unsigned {
+  /// Client-to-server requests.
+  kRequestAmId = 0,
+  /// Server-to-client responses and `CONNECTION_ID`.
+  kResponseAmId = 1,
+};
+
 /// Message types for client-server communication
 enum class MessageType : uint32_t {
   WRITE_REQUEST = 1,
   WRITE_RESPONSE = 2,
+  /// The message data is empty to read the whole value, or a
+  /// `ReadByteRange` to read only part of it.
   READ_REQUEST = 3,
   READ_RESPONSE = 4,
+  /// Sent by the server on each accepted connection with the connection id
+  /// that the client puts in the headers of its requests.
+  CONNECTION_ID = 5,
+  /// Answered with `WRITE_RESPONSE`.
+  DELETE_REQUEST = 6,
+  /// Lists up to `kListPageSize` keys from the request key (inclusive) to the
+  /// message data (exclusive, unbounded if empty).
+  LIST_REQUEST = 7,
+  /// Data is a sequence of `ListResponseEntry`, each followed by its key.
+  LIST_RESPONSE = 8,
+  /// Deletes the keys from the request key (inclusive) to the message data
+  /// (exclusive, unbounded if empty).  Answered with `WRITE_RESPONSE`.
+  DELETE_RANGE_REQUEST = 9,
+  /// Reads several keys: the message data is a sequence of
+  /// `BatchReadRequestEntry`, each followed by its key, and the request key
+  /// is empty.
+  BATCH_READ_REQUEST = 10,
+  /// Data is one `BatchReadResponseEntry` per requested key, in request
+  /// order, followed by the values of the entries that have one.
+  BATCH_READ_RESPONSE = 11,
+  /// Waits until the writes acknowledged before it are written to the base
+  /// kvstore of the server.  Answered with `WRITE_RESPONSE`.
+  FLUSH_REQUEST = 12,
 };
 
-/// Header for all messages
-struct MessageHeader {
+/// Status codes carried by `ResponseHeader`.
+enum ResponseStatus : uint32_t {
+  kResponseOk = 0,
+  kResponseNotFound = 1,
+  kResponseError = 2,
+  /// The generation conditions of the request do not hold.
+  kResponseConditionFailed = 3,
+  /// A `LIST_RESPONSE` page that is followed by more keys.
+  kResponseMore = 4,
+  /// The byte range of a read is not within the value.
+  kResponseInvalidByteRange = 5,
+  /// The value was evicted or expired from the server memory and is not kept
+  /// elsewhere, so it must be read from its source instead.
+  kResponseEvicted = 6,
+};
+
+/// Flags of `RequestHeader::conditions`.
+enum RequestConditions : uint32_t {
+  kConditionIfEqual = 1,
+  kConditionIfNotEqual = 2,
+  /// Not a condition: asks that the value of a `READ_RESPONSE` be sent with
+  /// the rendezvous protocol regardless of its size, so that the client can
+  /// receive it directly into a buffer of its choosing.
+  kRequestRendezvous = 4,
+};
+
+/// Maximum number of keys in a `LIST_RESPONSE`.
+constexpr size_t kListPageSize = 1024;
+
+/// Default value size above which values are sent with the UCX active message
+/// rendezvous protocol rather than eagerly.
+constexpr size_t kDefaultRendezvousThreshold = 32 * 1024;
+
+/// Active message header of a request, followed by `key_length` bytes of key.
+/// The value of a `WRITE_REQUEST` is the message data.
+struct RequestHeader {
   MessageType type;
+  /// Id assigned to the connection by the server.
+  uint32_t connection_id;
+  uint64_t request_id;
   uint32_t key_length;
-  uint32_t value_length;
+  /// Bitwise OR of `RequestConditions`.
+  uint32_t conditions;
+  /// Generations, with 0 denoting a missing key, that the key must have
+  /// (`kConditionIfEqual`) or must not have (`kConditionIfNotEqual`).
+  uint64_t if_equal;
+  uint64_t if_not_equal;
+  /// For a `WRITE_REQUEST` that copies a value to a replica, the generation
+  /// assigned by the primary server; 0 otherwise.
+  uint64_t generation;
+} __attribute__((packed));
+
+/// Active message header of a response.  The value of a `READ_RESPONSE` is
+/// the message data.
+struct ResponseHeader {
+  MessageType type;
+  /// One of `ResponseStatus`; for `CONNECTION_ID`, the connection id.
+  uint32_t status;
   uint64_t request_id;
+  /// Generation of the key read or written, with 0 denoting a missing key.
+  uint64_t generation;
 } __attribute__((packed));
 
-/// Write request message structure
-struct WriteMessage {
-  MessageHeader header;
-  // Followed by key_length bytes of key data
-  // Followed by value_length bytes of value data
+/// Entry of a `LIST_RESPONSE`, followed by `key_length` bytes of key.
+struct ListResponseEntry {
+  uint32_t key_length;
+  /// Size of the value, or -1 if unknown.
+  int64_t size;
 } __attribute__((packed));
 
-/// Write response message structure  
-struct WriteResponse {
-  MessageHeader header;
-  uint32_t status_code;  // 0 = success, non-zero = error
+/// Byte range of a `READ_REQUEST`, in the encoding of
+/// `BatchReadRequestEntry`.
+struct ReadByteRange {
+  int64_t inclusive_min;
+  int64_t exclusive_max;
 } __attribute__((packed));
 
-/// Read request message structure
-struct ReadRequest {
-  MessageHeader header;
-  // Followed by key_length bytes of key data
+/// Entry of a `BATCH_READ_REQUEST`, followed by `key_length` bytes of key.
+struct BatchReadRequestEntry {
+  uint32_t key_length;
+  /// As in `RequestHeader`.
+  uint32_t conditions;
+  uint64_t if_equal;
+  uint64_t if_not_equal;
+  /// `OptionalByteRangeRequest` to read; `exclusive_max` is -1 for the end of
+  /// the value, and `inclusive_min` is negative for a suffix.
+  int64_t inclusive_min;
+  int64_t exclusive_max;
 } __attribute__((packed));
 
-/// Read response message structure
-struct ReadResponse {
-  MessageHeader header;
-  uint32_t status_code;  // 0 = success, 1 = key not found, 2 = error
-  // Followed by value_length bytes of value data (if status_code == 0)
+/// Entry of a `BATCH_READ_RESPONSE`.
+struct BatchReadResponseEntry {
+  /// One of `ResponseStatus`.
+  uint32_t status;
+  uint64_t generation;
+  /// Number of bytes of the entry's value in the message data; only non-zero
+  /// if `status` is `kResponseOk`.
+  uint64_t value_length;
 } __attribute__((packed));
 
+/// Server side of a connection from a client.
+struct ClientConnection {
+  /// Id assigned by the server, carried in the headers of the client's
+  /// requests.
+  uint32_t id = 0;
+  ucp_ep_h endpoint = nullptr;
+};
+
+class UcxWorker;
+
+/// State of a client-side endpoint shared with its UCX error handler.
+struct ClientEndpointState {
+  /// Worker that the endpoint was created on.
+  UcxWorker* worker = nullptr;
+  /// Address of the server, as passed to `CreateClientEndpoints`.
+  std::string server_addr;
+  /// Set by the error handler once the endpoint has failed; the connection
+  /// must then be re-established before the endpoint is used again.
+  std::atomic<bool> failed{false};
+};
+
+/// Client side of a connection to a server.
+struct ClientEndpoint {
+  ucp_ep_h handle = nullptr;
+  /// Id assigned by the server to the connection.
+  uint32_t connection_id = 0;
+  /// Owned by the `UcxManager`, and valid until `UcxManager::Shutdown`.
+  ClientEndpointState* state = nullptr;
+};
+
+/// How the UCX progress thread waits for work.
+enum class ProgressMode {
+  /// Busy-poll for `busy_poll_duration` after the last completion, then block
+  /// on the worker event fd until woken.
+  kAdaptive,
+  /// Always busy-poll; lowest latency, but dedicates a core.
+  kBusy,
+  /// Block on the worker event fd whenever there is nothing to progress.
+  kEvent,
+};
+
+/// How a client picks which of its UCX workers (and endpoints) carries a
+/// request.
+enum class WorkerSelection {
+  /// Hash of the key; all operations on a key use the same endpoint, so they
+  /// are delivered to the server in order.
+  kKeyHash,
+  /// Per calling thread, assigned round-robin.
+  kThread,
+};
+
+/// Default bound on the bytes acknowledged by a server but not yet written to
+/// its base kvstore.
+constexpr size_t kDefaultMaxDirtyBytes = 256 * 1024 * 1024;
+
+/// Default number of UCX workers, each with its own progress thread.
+constexpr size_t kDefaultNumWorkers = 4;
+
+/// Default number of points of each server on the consistent-hash ring.
+constexpr size_t kDefaultVirtualNodes = 128;
+
+/// Default busy-poll window of `ProgressMode::kAdaptive`.
+constexpr absl::Duration kDefaultBusyPollDuration = absl::Microseconds(50);
+
 /// Data members for `RemoteDramDriverSpec`.
 struct RemoteDramDriverSpecData {
   /// Server listen address (for server mode)
@@ -91,62 +272,372 @@ struct RemoteDramDriverSpecData {
   /// Remote server address (for client mode)
   std::optional<std::string> remote_addr;
 
+  /// Client mode: addresses of several servers, as an alternative to
+  /// `remote_addr`.  Keys are placed on them by consistent hashing.
+  std::vector<std::string> remote_addrs;
+
+  /// Client mode: number of servers each value is written to.  Reads use
+  /// whichever of them has the fewest outstanding requests.
+  size_t replication_factor = 1;
+
+  /// Client mode: points of each server on the consistent-hash ring; more
+  /// points spread keys more evenly.
+  size_t virtual_nodes = kDefaultVirtualNodes;
+
+  /// Values larger than this many bytes are sent with the UCX active message
+  /// rendezvous protocol, which transfers them by RMA, rather than eagerly.
+  size_t rendezvous_threshold = kDefaultRendezvousThreshold;
+
+  /// How the shared UCX worker is progressed.
+  ProgressMode progress_mode = ProgressMode::kAdaptive;
+
+  /// Time to keep busy-polling after the last completion in
+  /// `ProgressMode::kAdaptive`.
+  absl::Duration busy_poll_duration = kDefaultBusyPollDuration;
+
+  /// Number of UCX workers.  Fixed by the first driver opened in a process.
+  size_t num_workers = kDefaultNumWorkers;
+
+  /// How client requests are spread over the workers.
+  WorkerSelection worker_selection = WorkerSelection::kKeyHash;
+
+  /// Server mode: bound on the memory held by values, counting both their
+  /// sizes and the arena slabs that hold them; 0 means unlimited.
+  /// Least-recently-used values beyond the bound are evicted.
+  /// Without `spill` or `base`, reads of evicted values fail with
+  /// `absl::StatusCode::kNotFound`, so that clients can tell them apart from
+  /// missing keys and read from the source of the values instead.
+  size_t memory_limit = 0;
+
+  /// Server mode: time to live of values, by key prefix.  A value expires
+  /// once the `ttl` of the rule with the longest matching `prefix` has passed
+  /// since it was stored, and is then treated as evicted.
+  using ExpirationRule = RemoteDramStorage::ExpirationRule;
+  std::vector<ExpirationRule> ttl;
+
+  /// Server mode: kvstore that evicted values are written to, and that reads
+  /// of values not in memory fall back to.  Without it, evicted values are
+  /// dropped.
+  std::optional<kvstore::Spec> spill;
+
+  /// Server mode: persistent kvstore for which the server is a write-back
+  /// cache.  Writes are acknowledged once in memory and written to `base` in
+  /// the background, and reads of keys not in memory fall back to it.
+  std::optional<kvstore::Spec> base;
+
+  /// Server mode: bound on the bytes of writes acknowledged but not yet
+  /// written to `base`; further writes are acknowledged as it drains.
+  size_t max_dirty_bytes = kDefaultMaxDirtyBytes;
+
   /// Make this type compatible with `tensorstore::ApplyMembers`.
   constexpr static auto ApplyMembers = [](auto&& x, auto f) {
-    return f(x.listen_addr, x.remote_addr);
+    return f(x.listen_addr, x.remote_addr, x.remote_addrs,
+             x.replication_factor, x.virtual_nodes, x.rendezvous_threshold,
+             x.progress_mode, x.busy_poll_duration, x.num_workers,
+             x.worker_selection, x.memory_limit, x.ttl, x.spill, x.base,
+             x.max_dirty_bytes);
   };
 
+  constexpr static auto expiration_rule_binder = jb::Object(
+      jb::Member("prefix", jb::Projection<&ExpirationRule::prefix>()),
+      jb::Member("ttl", jb::Projection<&ExpirationRule::ttl>()));
+
   /// JSON binding for the spec data
   constexpr static auto default_json_binder = jb::Object(
       jb::Member("listen_addr", 
                  jb::Projection<&RemoteDramDriverSpecData::listen_addr>()),
       jb::Member("remote_addr", 
-                 jb::Projection<&RemoteDramDriverSpecData::remote_addr>())
+                 jb::Projection<&RemoteDramDriverSpecData::remote_addr>()),
+      jb::Member("remote_addrs",
+                 jb::Projection<&RemoteDramDriverSpecData::remote_addrs>(
+                     jb::DefaultInitializedValue<jb::kNeverIncludeDefaults>())),
+      jb::Member("replication_factor",
+                 jb::Projection<&RemoteDramDriverSpecData::replication_factor>(
+                     jb::DefaultValue([](auto* v) { *v = 1; },
+                                      jb::Integer<size_t>(1)))),
+      jb::Member("virtual_nodes",
+                 jb::Projection<&RemoteDramDriverSpecData::virtual_nodes>(
+                     jb::DefaultValue([](auto* v) { *v = kDefaultVirtualNodes; },
+                                      jb::Integer<size_t>(1, 4096)))),
+      jb::Member("rendezvous_threshold",
+                 jb::Projection<&RemoteDramDriverSpecData::rendezvous_threshold>(
+                     jb::DefaultValue([](auto* v) {
+                       *v = kDefaultRendezvousThreshold;
+                     }))),
+      jb::Member("progress_mode",
+                 jb::Projection<&RemoteDramDriverSpecData::progress_mode>(
+                     jb::DefaultValue(
+                         [](auto* v) { *v = ProgressMode::kAdaptive; },
+                         jb::Enum<ProgressMode, std::string_view>({
+                             {ProgressMode::kAdaptive, "adaptive"},
+                             {ProgressMode::kBusy, "busy"},
+                             {ProgressMode::kEvent, "event"},
+                         })))),
+      jb::Member("busy_poll_duration",
+                 jb::Projection<&RemoteDramDriverSpecData::busy_poll_duration>(
+                     jb::DefaultValue([](auto* v) {
+                       *v = kDefaultBusyPollDuration;
+                     }))),
+      jb::Member("num_workers",
+                 jb::Projection<&RemoteDramDriverSpecData::num_workers>(
+                     jb::DefaultValue([](auto* v) { *v = kDefaultNumWorkers; },
+                                      jb::Integer<size_t>(1, 256)))),
+      jb::Member("worker_selection",
+                 jb::Projection<&RemoteDramDriverSpecData::worker_selection>(
+                     jb::DefaultValue(
+                         [](auto* v) { *v = WorkerSelection::kKeyHash; },
+                         jb::Enum<WorkerSelection, std::string_view>({
+                             {WorkerSelection::kKeyHash, "key_hash"},
+                             {WorkerSelection::kThread, "thread"},
+                         })))),
+      jb::Member("memory_limit",
+                 jb::Projection<&RemoteDramDriverSpecData::memory_limit>(
+                     jb::DefaultValue([](auto* v) { *v = 0; }))),
+      jb::Member("ttl",
+                 jb::Projection<&RemoteDramDriverSpecData::ttl>(
+                     jb::DefaultInitializedValue<jb::kNeverIncludeDefaults>(
+                         jb::Array(expiration_rule_binder)))),
+      jb::Member("spill",
+                 jb::Projection<&RemoteDramDriverSpecData::spill>()),
+      jb::Member("base", jb::Projection<&RemoteDramDriverSpecData::base>()),
+      jb::Member("max_dirty_bytes",
+                 jb::Projection<&RemoteDramDriverSpecData::max_dirty_bytes>(
+                     jb::DefaultValue(
+                         [](auto* v) { *v = kDefaultMaxDirtyBytes; })))
   );
 };
 
 /// Context for pending write operations
 struct PendingWriteOperation {
   uint64_t request_id;
-  Promise<void> promise;
+  Promise<TimestampedStorageGeneration> promise;
+  /// Endpoint that the request was sent on.
+  ucp_ep_h endpoint = nullptr;
   
-  explicit PendingWriteOperation(uint64_t id, Promise<void> p) 
+  explicit PendingWriteOperation(uint64_t id,
+                                 Promise<TimestampedStorageGeneration> p)
     : request_id(id), promise(std::move(p)) {}
 };
 
+/// Caller-provided buffer that the value of a read is received into, rather
+/// than into an arena buffer.
+struct ReadDestination {
+  void* data = nullptr;
+  size_t size = 0;
+  ucs_memory_type_t memory_type = UCS_MEMORY_TYPE_UNKNOWN;
+  /// Number of bytes received, set before the read completes.
+  size_t received = 0;
+};
+
 /// Context for pending read operations
 struct PendingReadOperation {
   uint64_t request_id;
   Promise<kvstore::ReadResult> promise;
-  
-  explicit PendingReadOperation(uint64_t id, Promise<kvstore::ReadResult> p)
+  /// Endpoint that the request was sent on.
+  ucp_ep_h endpoint = nullptr;
+  /// If not null, the value is received into `destination` and the result
+  /// holds an empty value.
+  std::shared_ptr<ReadDestination> destination;
+
+  explicit PendingReadOperation(
+      uint64_t id, Promise<kvstore::ReadResult> p,
+      std::shared_ptr<ReadDestination> destination = nullptr)
+      : request_id(id),
+        promise(std::move(p)),
+        destination(std::move(destination)) {}
+};
+
+/// One page of a listing.
+struct ListPage {
+  std::vector<kvstore::ListEntry> entries;
+  /// Whether keys beyond the last entry remain.
+  bool more = false;
+};
+
+/// Context for pending list operations
+struct PendingListOperation {
+  uint64_t request_id;
+  Promise<ListPage> promise;
+  /// Endpoint that the request was sent on.
+  ucp_ep_h endpoint = nullptr;
+
+  explicit PendingListOperation(uint64_t id, Promise<ListPage> p)
+    : request_id(id), promise(std::move(p)) {}
+};
+
+/// Context for pending batched read operations, completed with the
+/// `BATCH_READ_RESPONSE` data.
+struct PendingBatchReadOperation {
+  uint64_t request_id;
+  Promise<absl::Cord> promise;
+  /// Endpoint that the request was sent on.
+  ucp_ep_h endpoint = nullptr;
+
+  explicit PendingBatchReadOperation(uint64_t id, Promise<absl::Cord> p)
     : request_id(id), promise(std::move(p)) {}
 };
 
-/// Server-side storage for key-value pairs
-class RemoteDramStorage {
+/// Memory registered with `ucp_mem_map`.
+///
+/// Used for arena slabs, so that rendezvous transfers to and from them need
+/// no registration of their own.  The memory itself is owned by the caller
+/// and must outlive this object.
+class RegisteredMemory {
  public:
-  /// Store a key-value pair
-  void Store(const std::string& key, const absl::Cord& value);
-  
-  /// Retrieve a value by key
-  std::optional<absl::Cord> Get(const std::string& key) const;
-  
-  /// Check if key exists
-  bool Exists(const std::string& key) const;
-  
-  /// Remove a key
-  bool Remove(const std::string& key);
-  
-  /// Get all stored keys (for verification/debugging)
-  std::vector<std::string> GetAllKeys() const;
-  
-  /// Get storage statistics
-  size_t GetKeyCount() const;
-  
+  /// Registers `[address, address + size)` with `context`.
+  static Result<std::unique_ptr<RegisteredMemory>> Register(
+      ucp_context_h context, void* address, size_t size);
+
+  ~RegisteredMemory();
+
+  RegisteredMemory(const RegisteredMemory&) = delete;
+  RegisteredMemory& operator=(const RegisteredMemory&) = delete;
+
+  void* data() const { return address_; }
+  size_t size() const { return size_; }
+  ucp_mem_h memh() const { return memh_; }
+
  private:
-  mutable absl::Mutex mutex_;
-  std::unordered_map<std::string, absl::Cord> storage_ ABSL_GUARDED_BY(mutex_);
+  RegisteredMemory() = default;
+
+  ucp_context_h context_ = nullptr;
+  ucp_mem_h memh_ = nullptr;
+  void* address_ = nullptr;
+  size_t size_ = 0;
+};
+
+class UcxManager;
+
+/// A UCX worker, the thread that progresses it, and the client operations
+/// awaiting responses on the endpoints created on it.
+///
+/// Each worker has its own lock and pending-operation tables, so requests
+/// issued through different workers do not contend.
+class UcxWorker {
+ public:
+  UcxWorker(UcxManager& manager, size_t index)
+      : manager_(manager), index_(index) {}
+
+  UcxWorker(const UcxWorker&) = delete;
+  UcxWorker& operator=(const UcxWorker&) = delete;
+
+  /// Creates the underlying `ucp_worker_h` and starts its progress thread.
+  absl::Status Start(ucp_context_h context);
+
+  /// Stops and joins the progress thread.
+  void Stop();
+
+  /// Fails all pending operations with `status` and destroys the worker.
+  /// The progress thread must already be stopped.
+  void Destroy(const absl::Status& status);
+
+  ucp_worker_h handle() const { return worker_; }
+  size_t index() const { return index_; }
+
+  /// Register a pending write operation sent on `endpoint`
+  void RegisterPendingOperation(uint64_t request_id, ucp_ep_h endpoint,
+                                Promise<TimestampedStorageGeneration> promise);
+
+  /// Register a pending read operation sent on `endpoint`, whose value is
+  /// received into `destination` if specified.
+  void RegisterPendingReadOperation(
+      uint64_t request_id, ucp_ep_h endpoint,
+      Promise<kvstore::ReadResult> promise,
+      std::shared_ptr<ReadDestination> destination = nullptr);
+
+  /// Returns the destination of the pending read operation `request_id`, or
+  /// `nullptr`.
+  std::shared_ptr<ReadDestination> GetReadDestination(uint64_t request_id);
+
+  /// Register a pending list operation sent on `endpoint`
+  void RegisterPendingListOperation(uint64_t request_id, ucp_ep_h endpoint,
+                                    Promise<ListPage> promise);
+
+  /// Register a pending batched read operation sent on `endpoint`
+  void RegisterPendingBatchReadOperation(uint64_t request_id,
+                                         ucp_ep_h endpoint,
+                                         Promise<absl::Cord> promise);
+
+  /// Complete a pending write operation
+  void CompletePendingOperation(uint64_t request_id,
+                                Result<TimestampedStorageGeneration> result);
+
+  /// Complete a pending read operation
+  void CompletePendingReadOperation(uint64_t request_id,
+                                    kvstore::ReadResult result);
+
+  /// Complete a pending list operation
+  void CompletePendingListOperation(uint64_t request_id, ListPage page);
+
+  /// Complete a pending batched read operation
+  void CompletePendingBatchReadOperation(uint64_t request_id,
+                                         absl::Cord data);
+
+  /// Fails whichever pending client operation has id `request_id`.
+  void FailPendingOperation(uint64_t request_id, absl::Status status);
+
+  /// Fails all pending client operations sent on `endpoint`.
+  void FailEndpointOperations(ucp_ep_h endpoint, const absl::Status& status);
+
+  /// Completes `promise` with the id of the next `CONNECTION_ID` message
+  /// received on this worker.  Only one connection may be pending at a time;
+  /// a null `promise` stops waiting.
+  void ExpectConnectionId(Promise<uint32_t> promise);
+
+  /// Handles an active message on `kResponseAmId`.
+  ucs_status_t HandleResponse(const ResponseHeader& header, void* data,
+                              size_t length,
+                              const ucp_am_recv_param_t* param);
+
+  /// Completes the read, list or batched read operation of `header` with the
+  /// response `data`.
+  void HandleResponseData(const ResponseHeader& header, absl::Cord data);
+
+  /// Pre-registered buffers for the rendezvous receives on this worker.
+  /// Valid from `Start` until `Destroy`.
+  SlabArena& arena() const { return *arena_; }
+
+  /// Largest active message header supported by the worker.
+  size_t max_am_header() const { return max_am_header_; }
+
+  /// Wakes the progress thread if it is blocked waiting for worker events,
+  /// so that operations initiated by other threads are progressed.
+  void Wake();
+
+ private:
+  /// Worker progress polling function
+  void ProgressLoop();
+
+  UcxManager& manager_;
+  const size_t index_;
+  ucp_worker_h worker_ = nullptr;
+  size_t max_am_header_ = 0;
+  std::shared_ptr<SlabArena> arena_;
+  std::thread progress_thread_;
+  std::atomic<bool> running_{false};
+  /// Set while the progress thread is blocked on the worker event fd.
+  std::atomic<bool> waiting_{false};
+
+  absl::Mutex mutex_;
+
+  /// Pending write operations for client mode
+  std::unordered_map<uint64_t, std::unique_ptr<PendingWriteOperation>>
+      pending_write_operations_ ABSL_GUARDED_BY(mutex_);
+
+  /// Pending read operations for client mode
+  std::unordered_map<uint64_t, std::unique_ptr<PendingReadOperation>>
+      pending_read_operations_ ABSL_GUARDED_BY(mutex_);
+
+  /// Pending list operations for client mode
+  std::unordered_map<uint64_t, std::unique_ptr<PendingListOperation>>
+      pending_list_operations_ ABSL_GUARDED_BY(mutex_);
+
+  /// Pending batched read operations for client mode
+  std::unordered_map<uint64_t, std::unique_ptr<PendingBatchReadOperation>>
+      pending_batch_read_operations_ ABSL_GUARDED_BY(mutex_);
+
+  /// Non-null while a client connection on this worker awaits its id.
+  Promise<uint32_t> connection_id_promise_ ABSL_GUARDED_BY(mutex_);
 };
 
 /// Singleton UCX Manager to handle global UCX state and worker polling
@@ -155,55 +646,162 @@ class UcxManager {
   /// Get the singleton instance
   static UcxManager& Instance();
   
-  /// Initialize UCX context and worker
-  absl::Status Initialize();
+  /// Initialize the UCX context and `num_workers` workers.  Once initialized,
+  /// later calls have no effect.
+  absl::Status Initialize(size_t num_workers = kDefaultNumWorkers);
   
   /// Get the UCX context
   ucp_context_h GetContext() const { return context_; }
   
-  /// Get the UCX worker
-  ucp_worker_h GetWorker() const { return worker_; }
+  /// Get the UCX worker that owns the listener and server-side endpoints.
+  ucp_worker_h GetWorker() const {
+    return workers_.empty() ? nullptr : workers_[0]->handle();
+  }
+
+  /// Returns the worker that owns the listener and server-side endpoints.
+  UcxWorker& ServerWorker() { return *workers_[0]; }
+
+  /// Returns the number of workers.  Constant between `Initialize` and
+  /// `Shutdown`.
+  size_t GetNumWorkers() const { return workers_.size(); }
+
+  UcxWorker& GetWorker(size_t index) { return *workers_[index]; }
   
   /// Create a UCX listener for server mode
   Result<ucp_listener_h> CreateListener(const std::string& listen_addr);
   
-  /// Create a client endpoint to connect to a server
-  Result<ucp_ep_h> CreateClientEndpoint(const std::string& server_addr);
+  /// Connects to a server, creating one endpoint on each worker; element `i`
+  /// of the result belongs to `GetWorker(i)`.  Waits up to `timeout` for the
+  /// server to assign each connection its id.
+  Result<std::vector<ClientEndpoint>> CreateClientEndpoints(
+      const std::string& server_addr,
+      absl::Duration timeout = absl::Seconds(10));
+
+  /// Connects `GetWorker(worker_index)` to a server again, to replace an
+  /// endpoint that failed.
+  Result<ClientEndpoint> CreateClientEndpoint(
+      const std::string& server_addr, size_t worker_index,
+      absl::Duration timeout = absl::Seconds(10));
   
   /// Get the server storage (for server mode)
   RemoteDramStorage& GetStorage() { return storage_; }
-  
-  /// Register a pending write operation
-  void RegisterPendingOperation(uint64_t request_id, Promise<void> promise, MessageType type);
-  
-  /// Register a pending read operation
-  void RegisterPendingReadOperation(uint64_t request_id, Promise<kvstore::ReadResult> promise);
-  
-  /// Complete a pending write operation
-  void CompletePendingOperation(uint64_t request_id, absl::Status status);
-  
-  /// Complete a pending read operation
-  void CompletePendingReadOperation(uint64_t request_id, kvstore::ReadResult result);
+
+  /// Bounds the memory used by the server storage; see
+  /// `RemoteDramDriverSpecData::memory_limit`.
+  void SetMemoryLimit(size_t memory_limit) {
+    storage_.SetMemoryLimit(memory_limit);
+  }
+
+  /// Sets the kvstore that values evicted from the server storage are written
+  /// to and read back from.
+  void SetSpillKvStore(kvstore::KvStore spill);
+
+  /// Looks up `key` in the server storage and, on a miss, in the spill or
+  /// base kvstore.  Values read from them are stored in memory again.
+  Future<std::optional<StoredValue>> ReadStored(std::string key);
+
+  /// Stores `value` under `key` if `if_equal` is unset or equal to the
+  /// generation of `key`, assigning `generation` if specified; see
+  /// `RemoteDramStorage::Store`.  Resolves to the
+  /// new generation, or `std::nullopt` if the condition does not hold.
+  Future<std::optional<uint64_t>> WriteStored(
+      std::string key, absl::Cord value, void* registration,
+      std::optional<uint64_t> if_equal,
+      uint64_t generation = RemoteDramStorage::kNoGeneration);
+
+  /// Sets the kvstore that the server storage is a write-back cache for.
+  void SetBaseKvStore(kvstore::KvStore base, size_t max_dirty_bytes);
+
+  /// Returns a future that becomes ready once the writes acknowledged before
+  /// the call are written to the base kvstore, if any.
+  Future<const void> Flush();
+
+  /// Removes `key` from the server storage and the spill or base kvstore if
+  /// `if_equal` is unset or equal to its generation.  Resolves to whether the
+  /// condition holds.
+  Future<bool> RemoveStored(std::string key,
+                            std::optional<uint64_t> if_equal = std::nullopt);
+
+  /// Removes the keys in `range` from the server storage and the spill or
+  /// base kvstore.
+  Future<const void> RemoveStoredRange(KeyRange range);
   
   /// Generate next request ID
-  uint64_t GenerateRequestId();
-  
-  /// Post a receive buffer for server-side message handling
-  void PostServerReceive();
-  
-  /// Post receive buffer without acquiring mutex (for use within locked context)
-  void PostServerReceiveNoLock();
-  
-  /// Send a read response from server to client
-  void SendReadResponse(ucp_ep_h client_endpoint, uint64_t request_id, 
-                        const std::optional<absl::Cord>& value);
-  
+  uint64_t GenerateRequestId() {
+    return next_request_id_.fetch_add(1, std::memory_order_relaxed);
+  }
+  
+  /// Send a read response from server to client.  `value`, if sent, lives
+  /// in the arena buffer described by `registration`, and is sent by
+  /// rendezvous regardless of its size if `rendezvous` is true.
+  void SendReadResponse(const ClientConnection& connection,
+                        uint64_t request_id, uint32_t status_code,
+                        uint64_t generation, absl::Cord value = {},
+                        void* registration = nullptr,
+                        bool rendezvous = false);
+
   /// Send a write response from server to client
-  void SendWriteResponse(ucp_ep_h client_endpoint, uint64_t request_id, 
-                         uint32_t status_code);
+  void SendWriteResponse(const ClientConnection& connection,
+                         uint64_t request_id, uint32_t status_code,
+                         uint64_t generation = 0);
+
+  /// Returns the `RegisteredMemory` of the worker arena slab holding
+  /// `[data, data + size)`, such as a value returned by a read, or `nullptr`.
+  /// Other memory is left to the UCX registration cache, since its lifetime
+  /// is unknown.
+  void* FindRegistration(const void* data, size_t size) const;
+
+  /// Sends an active message with id `am_id` on `endpoint`, which belongs to
+  /// `worker`.  `header` and `value` are owned by the send until it
+  /// completes; `value` is sent without copying.  `registration`, if not
+  /// null, is the `RegisteredMemory` of the arena slab holding `value`;
+  /// otherwise a flat `value` is looked up with `FindRegistration`.  If
+  /// `request_id` is non-zero, a send failure fails the corresponding
+  /// pending client operation.  A non-empty `value` is sent by rendezvous if
+  /// it is larger than the rendezvous threshold or `rendezvous` is true.
+  void SendActiveMessage(UcxWorker& worker, ucp_ep_h endpoint, unsigned am_id,
+                         std::string header, absl::Cord value = {},
+                         void* registration = nullptr,
+                         uint64_t request_id = 0, bool rendezvous = false);
+
+  /// Handles an active message on `kRequestAmId` received by the server
+  /// worker.
+  ucs_status_t HandleRequest(const RequestHeader& header, std::string key,
+                             void* data, size_t length,
+                             const ucp_am_recv_param_t* param);
+
+  /// Answers the `BATCH_READ_REQUEST` with id `request_id` and message
+  /// `data` once all of its keys have been read.
+  void HandleBatchRead(const ClientConnection& connection,
+                       uint64_t request_id, std::string_view data);
+
+  /// Sets the value size above which the rendezvous path is used.
+  void SetRendezvousThreshold(size_t threshold) {
+    rendezvous_threshold_.store(threshold, std::memory_order_relaxed);
+  }
+
+  size_t GetRendezvousThreshold() const {
+    return rendezvous_threshold_.load(std::memory_order_relaxed);
+  }
+
+  /// Sets how the progress threads wait for work.  Takes effect on the next
+  /// idle period.
+  void SetProgressMode(ProgressMode mode, absl::Duration busy_poll_duration);
+
+  ProgressMode GetProgressMode() const {
+    return progress_mode_.load(std::memory_order_relaxed);
+  }
+
+  absl::Duration GetBusyPollDuration() const {
+    return absl::Nanoseconds(busy_poll_ns_.load(std::memory_order_relaxed));
+  }
   
-  /// Register a client endpoint (for server mode)
-  void RegisterClientEndpoint(ucp_ep_h client_endpoint);
+  /// Accepts a connection request on the server worker: creates the
+  /// endpoint, assigns a connection id and sends it to the client.
+  void AcceptConnection(ucp_conn_request_h conn_request);
+
+  /// Forgets the connection `connection_id` after an endpoint error.
+  void CloseConnection(uint32_t connection_id, ucs_status_t status);
   
   /// Register a client-side endpoint (for client mode cleanup)
   void RegisterClientSideEndpoint(ucp_ep_h client_endpoint);
@@ -211,15 +809,12 @@ class UcxManager {
   /// Register a client-side endpoint (for client mode cleanup) - assumes mutex is held
   void RegisterClientSideEndpointNoLock(ucp_ep_h client_endpoint);
   
-  /// Get a client endpoint for sending responses (for server mode)
-  /// Returns the most recently connected client endpoint
-  ucp_ep_h GetClientEndpoint() const;
-  
-  /// Cancel all pending receive operations
-  void CancelPendingReceives();
-  
-  /// Cancel all pending receive operations (assumes mutex is held)
-  void CancelPendingReceivesNoLock();
+  /// Returns the connection `connection_id`, or `std::nullopt` if there is
+  /// no such connection.  Counts the request in the connection's statistics.
+  std::optional<ClientConnection> GetClientConnection(uint32_t connection_id);
+
+  /// Returns the number of open client connections (for server mode).
+  size_t GetNumClientConnections() const;
   
   /// Cleanup UCX listener if it exists
   void CleanupListener();
@@ -233,43 +828,113 @@ class UcxManager {
  private:
   UcxManager() = default;
   ~UcxManager();
-  
-  /// Start the worker progress polling task
-  void StartWorkerProgressTask();
-  
-  /// Worker progress polling function
-  void WorkerProgressTask();
+
+  /// Creates an endpoint on `worker` to the server at `server_sockaddr`.
+  /// Requires `connect_mutex_`.
+  Result<ClientEndpoint> ConnectWorker(UcxWorker& worker,
+                                       const std::string& server_addr,
+                                       const sockaddr_in& server_sockaddr,
+                                       absl::Duration timeout)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(connect_mutex_);
   
   mutable absl::Mutex mutex_;
   bool initialized_ ABSL_GUARDED_BY(mutex_) = false;
   ucp_context_h context_ ABSL_GUARDED_BY(mutex_) = nullptr;
-  ucp_worker_h worker_ ABSL_GUARDED_BY(mutex_) = nullptr;
   ucp_listener_h listener_ ABSL_GUARDED_BY(mutex_) = nullptr;
-  bool progress_task_running_ ABSL_GUARDED_BY(mutex_) = false;
+
+  /// Workers; `workers_[0]` also serves the listener.  Written only by
+  /// `Initialize` and `Shutdown`.
+  std::vector<std::unique_ptr<UcxWorker>> workers_;
+
+  std::atomic<ProgressMode> progress_mode_{ProgressMode::kAdaptive};
+  std::atomic<int64_t> busy_poll_ns_{
+      absl::ToInt64Nanoseconds(kDefaultBusyPollDuration)};
   
   /// Server-side storage
   RemoteDramStorage storage_;
-  
-  /// Pending write operations for client mode
-  std::unordered_map<uint64_t, std::unique_ptr<PendingWriteOperation>> pending_write_operations_ ABSL_GUARDED_BY(mutex_);
-  
-  /// Pending read operations for client mode
-  std::unordered_map<uint64_t, std::unique_ptr<PendingReadOperation>> pending_read_operations_ ABSL_GUARDED_BY(mutex_);
-  
-  /// Track active UCX requests for proper cleanup
-  std::vector<void*> active_requests_ ABSL_GUARDED_BY(mutex_);
-  
-  /// Client endpoints for server mode (to send responses back to clients)
-  std::vector<ucp_ep_h> client_endpoints_ ABSL_GUARDED_BY(mutex_);
+
+  /// Registered memory backing server-side values, so that rendezvous
+  /// transfers do not register memory individually.  Created by `Initialize`.
+  std::shared_ptr<SlabArena> arena_ ABSL_GUARDED_BY(mutex_);
+
+  /// Kvstore holding values evicted from `storage_`, if any.
+  std::optional<kvstore::KvStore> spill_ ABSL_GUARDED_BY(mutex_);
+
+  /// Writes to the base kvstore, if any.
+  std::shared_ptr<WriteBackQueue> write_back_ ABSL_GUARDED_BY(mutex_);
+  
+  /// Server-side state of a client connection.
+  struct ConnectionState {
+    ucp_ep_h endpoint;
+    /// Requests received on the connection.
+    uint64_t num_requests = 0;
+  };
+
+  /// Open client connections for server mode, by connection id.
+  std::unordered_map<uint32_t, ConnectionState> connections_
+      ABSL_GUARDED_BY(mutex_);
+  uint32_t next_connection_id_ ABSL_GUARDED_BY(mutex_) = 1;
+
+  /// Endpoints of closed connections.  They are destroyed by `Shutdown`, since
+  /// responses to their last requests may still be sent on them.
+  std::vector<ucp_ep_h> closed_endpoints_ ABSL_GUARDED_BY(mutex_);
+
+  /// Serializes `CreateClientEndpoints`, so that each worker has at most one
+  /// connection awaiting its `CONNECTION_ID`.
+  absl::Mutex connect_mutex_;
   
   /// Client-side endpoints for client mode (for cleanup)
   std::vector<ucp_ep_h> client_side_endpoints_ ABSL_GUARDED_BY(mutex_);
+
+  /// Error handler state of the client-side endpoints, released once they
+  /// are destroyed by `Shutdown`.
+  std::vector<std::unique_ptr<ClientEndpointState>> client_endpoint_states_
+      ABSL_GUARDED_BY(mutex_);
+
+  std::atomic<size_t> rendezvous_threshold_{kDefaultRendezvousThreshold};
   
-  uint64_t next_request_id_ ABSL_GUARDED_BY(mutex_) = 1;
+  std::atomic<uint64_t> next_request_id_{1};
+};
+
+/// Returns a future that becomes ready once the writes acknowledged by the
+/// servers of the remote_dram `kvstore` before the call have been written to
+/// their `base` kvstores.  Servers without a `base` kvstore are skipped.
+Future<const void> FlushRemoteDram(const kvstore::KvStore& kvstore);
+
+/// Options for `ReadRemoteDramInto`.  `batch` and `staleness_bound` are
+/// ignored.
+struct ReadIntoOptions : public kvstore::ReadOptions {
+  /// Memory type of the destination buffer, such as `UCS_MEMORY_TYPE_CUDA`
+  /// for GPU device memory.  If `UCS_MEMORY_TYPE_UNKNOWN`, UCX detects it.
+  ucs_memory_type_t memory_type = UCS_MEMORY_TYPE_UNKNOWN;
+};
+
+/// Result of `ReadRemoteDramInto`.
+struct ReadIntoResult {
+  kvstore::ReadResult::State state = kvstore::ReadResult::kUnspecified;
+  /// Number of bytes of the value written to the buffer, if
+  /// `state == kValue`.
+  size_t size = 0;
+  TimestampedStorageGeneration stamp;
 };
 
-/// Send a notification to the server process that new data has been written
-void NotifyServerOfNewData(const kvstore::Key& key, const absl::Cord& value);
+/// Reads `key` of the remote_dram `kvstore` into `[buffer, buffer + size)`,
+/// which may be GPU device memory.
+///
+/// The value is transferred by the UCX rendezvous protocol straight into the
+/// buffer, which UCX registers through its memory registration cache, so
+/// that with GPUDirect RDMA it does not pass through host memory.  Fails with
+/// `absl::StatusCode::kResourceExhausted` if the value, or its requested byte
+/// range, is larger than `size`.  The buffer must remain valid until the
+/// returned future becomes ready, and its contents are unspecified if the
+/// read fails.
+///
+/// Servers read their own storage, which requires `options.memory_type` to
+/// be `UCS_MEMORY_TYPE_HOST`.
+Future<ReadIntoResult> ReadRemoteDramInto(const kvstore::KvStore& kvstore,
+                                          std::string_view key, void* buffer,
+                                          size_t size,
+                                          ReadIntoOptions options = {});
 
 }  // namespace tensorstore
 
@@ -0,0 +1,534 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/remote_dram/storage.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/hash/hash.h"
+#include "absl/log/absl_check.h"
+#include "absl/numeric/bits.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/match.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+
+namespace tensorstore {
+
+std::shared_ptr<SlabArena> SlabArena::Make(Options options) {
+  ABSL_CHECK_GE(options.slab_size, kMinChunkSize);
+  options.slab_size = absl::bit_ceil(options.slab_size);
+  std::shared_ptr<SlabArena> arena(new SlabArena(std::move(options)));
+  absl::MutexLock lock(&arena->mutex_);
+  arena->available_slabs_.resize(
+      absl::bit_width(arena->options_.slab_size / kMinChunkSize));
+  return arena;
+}
+
+int SlabArena::GetSizeClass(size_t size) const {
+  if (size > options_.slab_size) return -1;
+  size_t chunk_size = std::max(absl::bit_ceil(size), kMinChunkSize);
+  return absl::bit_width(chunk_size / kMinChunkSize) - 1;
+}
+
+size_t SlabArena::GetChunkSize(size_t size) const {
+  const int size_class = GetSizeClass(size);
+  return size_class < 0 ? size : kMinChunkSize << size_class;
+}
+
+std::unique_ptr<SlabArena::Slab> SlabArena::MakeSlab(size_t size,
+                                                     int size_class) {
+  auto slab = std::make_unique<Slab>();
+  slab->size = size;
+  slab->size_class = size_class;
+  slab->data.reset(new char[size]);
+  if (options_.register_slab && !registrations_released_) {
+    slab->registration = options_.register_slab(slab->data.get(), size);
+  }
+  reserved_bytes_.fetch_add(size, std::memory_order_relaxed);
+  return slab;
+}
+
+SlabArena::Buffer SlabArena::Allocate(size_t size) {
+  ABSL_CHECK_GT(size, 0);
+  const int size_class = GetSizeClass(size);
+  Buffer buffer;
+  buffer.size = size;
+  {
+    absl::MutexLock lock(&mutex_);
+    Slab* slab;
+    if (size_class < 0) {
+      auto dedicated = MakeSlab(size, size_class);
+      slab = dedicated.get();
+      buffer.data = slab->data.get();
+      slabs_.emplace(buffer.data, std::move(dedicated));
+    } else {
+      auto& available = available_slabs_[size_class];
+      if (available.empty()) {
+        const size_t chunk_size = kMinChunkSize << size_class;
+        auto new_slab = MakeSlab(options_.slab_size, size_class);
+        for (size_t offset = new_slab->size; offset >= chunk_size;) {
+          offset -= chunk_size;
+          new_slab->free_chunks.push_back(new_slab->data.get() + offset);
+        }
+        available.push_back(new_slab.get());
+        slabs_.emplace(new_slab->data.get(), std::move(new_slab));
+      }
+      slab = available.back();
+      buffer.data = slab->free_chunks.back();
+      slab->free_chunks.pop_back();
+      ++slab->chunks_in_use;
+      if (slab->free_chunks.empty()) available.pop_back();
+    }
+    buffer.registration = slab->registration.get();
+  }
+  buffer.cord = absl::MakeCordFromExternal(
+      {buffer.data, size},
+      [self = shared_from_this(), data = buffer.data, size_class] {
+        self->Free(data, size_class);
+      });
+  return buffer;
+}
+
+void SlabArena::Free(char* data, int size_class) {
+  std::unique_ptr<Slab> released;
+  {
+    absl::MutexLock lock(&mutex_);
+    auto it = FindSlab(data);
+    ABSL_CHECK(it != slabs_.end());
+    Slab& slab = *it->second;
+    if (size_class >= 0) {
+      auto& available = available_slabs_[size_class];
+      if (slab.free_chunks.empty()) available.push_back(&slab);
+      slab.free_chunks.push_back(data);
+      if (--slab.chunks_in_use != 0) return;
+      available.erase(std::find(available.begin(), available.end(), &slab));
+    }
+    reserved_bytes_.fetch_sub(slab.size, std::memory_order_relaxed);
+    released = std::move(slabs_.extract(it).mapped());
+  }
+  // The slab and its registration are released outside the lock, since
+  // deregistration may be slow.
+}
+
+void SlabArena::ReleaseRegistrations() {
+  std::vector<std::shared_ptr<void>> registrations;
+  {
+    absl::MutexLock lock(&mutex_);
+    registrations_released_ = true;
+    for (auto& [data, slab] : slabs_) {
+      registrations.push_back(std::move(slab->registration));
+    }
+  }
+  // Registrations are released outside the lock, since deregistration may be
+  // slow.
+  registrations.clear();
+}
+
+absl::btree_map<const char*,
+                std::unique_ptr<SlabArena::Slab>>::const_iterator
+SlabArena::FindSlab(const char* data) const {
+  auto it = slabs_.upper_bound(data);
+  if (it == slabs_.begin()) return slabs_.end();
+  --it;
+  if (static_cast<size_t>(data - it->first) >= it->second->size) {
+    return slabs_.end();
+  }
+  return it;
+}
+
+void* SlabArena::FindRegistration(const void* data, size_t size) const {
+  const char* begin = static_cast<const char*>(data);
+  absl::MutexLock lock(&mutex_);
+  auto it = FindSlab(begin);
+  if (it == slabs_.end()) return nullptr;
+  const Slab& slab = *it->second;
+  const size_t offset = static_cast<size_t>(begin - it->first);
+  if (size > slab.size - offset) return nullptr;
+  return slab.registration.get();
+}
+
+RemoteDramStorage::RemoteDramStorage()
+    : shards_(std::make_unique<Shard[]>(kNumShards)) {}
+
+RemoteDramStorage::~RemoteDramStorage() = default;
+
+RemoteDramStorage::Shard& RemoteDramStorage::GetShard(
+    std::string_view key) const {
+  return shards_[absl::HashOf(key) % kNumShards];
+}
+
+absl::Time RemoteDramStorage::GetExpirationTime(std::string_view key) const {
+  if (!has_expiration_rules_.load(std::memory_order_relaxed)) {
+    return absl::InfiniteFuture();
+  }
+  absl::MutexLock lock(&expiration_mutex_);
+  const ExpirationRule* match = nullptr;
+  for (const auto& rule : expiration_rules_) {
+    if (absl::StartsWith(key, rule.prefix) &&
+        (!match || rule.prefix.size() > match->prefix.size())) {
+      match = &rule;
+    }
+  }
+  if (!match) return absl::InfiniteFuture();
+  return absl::Now() + match->ttl;
+}
+
+absl::Cord RemoteDramStorage::EraseEntry(
+    Shard& shard, absl::flat_hash_map<std::string, Entry>::iterator it,
+    bool keep_indexed) {
+  absl::Cord value = std::move(it->second.stored.value);
+  shard.bytes -= value.size();
+  stored_bytes_.fetch_sub(value.size(), std::memory_order_relaxed);
+  shard.lru.erase(it->second.lru_position);
+  if (!keep_indexed) {
+    absl::MutexLock index_lock(&index_mutex_);
+    index_.erase(it->first);
+  }
+  shard.entries.erase(it);
+  return value;
+}
+
+void RemoteDramStorage::RecordEvicted(Shard& shard, const std::string& key) {
+  if (!shard.evicted.insert(key).second) return;
+  shard.evicted_order.push_back(key);
+  if (shard.evicted_order.size() > kMaxEvictedKeysPerShard) {
+    // A key stored again since it was evicted may already be gone from
+    // `evicted`.
+    shard.evicted.erase(shard.evicted_order.front());
+    shard.evicted_order.pop_front();
+  }
+}
+
+std::optional<uint64_t> RemoteDramStorage::Store(
+    const std::string& key, const absl::Cord& value, void* registration,
+    std::optional<uint64_t> if_equal, uint64_t generation) {
+  const absl::Time expires_at = GetExpirationTime(key);
+  Shard& shard = GetShard(key);
+  std::vector<std::pair<std::string, absl::Cord>> evicted;
+  {
+    absl::MutexLock lock(&shard.mutex);
+    auto it = shard.entries.find(key);
+    const uint64_t current =
+        it == shard.entries.end() || it->second.expired()
+            ? kNoGeneration
+            : it->second.stored.generation;
+    if (if_equal && *if_equal != current) return std::nullopt;
+    if (generation != kNoGeneration && generation <= current) {
+      // A newer copy is already stored.
+      return current;
+    }
+    if (it == shard.entries.end()) {
+      it = shard.entries.try_emplace(key).first;
+      shard.lru.push_front(key);
+      it->second.lru_position = shard.lru.begin();
+      if (!shard.evicted.empty()) shard.evicted.erase(key);
+      absl::MutexLock index_lock(&index_mutex_);
+      index_.insert(key);
+    } else {
+      shard.bytes -= it->second.stored.value.size();
+      stored_bytes_.fetch_sub(it->second.stored.value.size(),
+                              std::memory_order_relaxed);
+      shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lru_position);
+    }
+    Entry& entry = it->second;
+    entry.stored.value = value;
+    entry.stored.registration = registration;
+    entry.expires_at = expires_at;
+    if (generation == kNoGeneration) {
+      generation = next_generation_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      // Keep generations assigned here from repeating `generation`.
+      uint64_t next = next_generation_.load(std::memory_order_relaxed);
+      while (next <= generation &&
+             !next_generation_.compare_exchange_weak(
+                 next, generation + 1, std::memory_order_relaxed)) {
+      }
+    }
+    entry.stored.generation = generation;
+    shard.bytes += value.size();
+    stored_bytes_.fetch_add(value.size(), std::memory_order_relaxed);
+
+    // Evict least-recently-used entries, but never the one just stored.
+    const size_t limit = shard_memory_limit_.load(std::memory_order_relaxed);
+    const bool keep_indexed =
+        has_eviction_callback_.load(std::memory_order_relaxed);
+    // Slab memory beyond the limit.  The arena releases a slab only once all
+    // of its chunks are freed, so this shard evicts chunks adding up to the
+    // excess, rather than until the arena is within the limit.
+    std::shared_ptr<const SlabArena> arena;
+    size_t excess_slab_bytes = 0;
+    if (limit != 0 && (arena = GetArena())) {
+      const size_t reserved = arena->reserved_bytes();
+      const size_t total_limit = memory_limit_.load(std::memory_order_relaxed);
+      if (reserved > total_limit) excess_slab_bytes = reserved - total_limit;
+    }
+    while (limit != 0 && (shard.bytes > limit || excess_slab_bytes > 0) &&
+           shard.lru.size() > 1) {
+      auto victim = shard.entries.find(shard.lru.back());
+      std::string victim_key = victim->first;
+      absl::Cord victim_value = EraseEntry(shard, victim, keep_indexed);
+      if (excess_slab_bytes != 0) {
+        excess_slab_bytes -= std::min(
+            excess_slab_bytes, arena->GetChunkSize(victim_value.size()));
+      }
+      evicted_keys_.fetch_add(1, std::memory_order_relaxed);
+      evicted_bytes_.fetch_add(victim_value.size(),
+                               std::memory_order_relaxed);
+      if (!keep_indexed) RecordEvicted(shard, victim_key);
+      evicted.emplace_back(std::move(victim_key), std::move(victim_value));
+    }
+  }
+  if (evicted.empty()) return generation;
+  std::shared_ptr<const EvictionCallback> callback;
+  {
+    absl::MutexLock lock(&callback_mutex_);
+    callback = eviction_callback_;
+  }
+  if (!callback) return generation;
+  for (auto& [evicted_key, evicted_value] : evicted) {
+    (*callback)(std::move(evicted_key), std::move(evicted_value));
+  }
+  return generation;
+}
+
+std::optional<StoredValue> RemoteDramStorage::Lookup(
+    const std::string& key) const {
+  Shard& shard = GetShard(key);
+  absl::MutexLock lock(&shard.mutex);
+  auto it = shard.entries.find(key);
+  if (it == shard.entries.end() || it->second.expired()) {
+    return std::nullopt;
+  }
+  shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lru_position);
+  return it->second.stored;
+}
+
+std::optional<absl::Cord> RemoteDramStorage::Get(const std::string& key) const {
+  auto stored = Lookup(key);
+  if (!stored) return std::nullopt;
+  return std::move(stored->value);
+}
+
+bool RemoteDramStorage::Exists(const std::string& key) const {
+  Shard& shard = GetShard(key);
+  absl::MutexLock lock(&shard.mutex);
+  auto it = shard.entries.find(key);
+  return it != shard.entries.end() && !it->second.expired();
+}
+
+bool RemoteDramStorage::WasEvicted(const std::string& key) const {
+  if (has_eviction_callback_.load(std::memory_order_relaxed)) return false;
+  Shard& shard = GetShard(key);
+  absl::MutexLock lock(&shard.mutex);
+  if (shard.evicted.contains(key)) return true;
+  auto it = shard.entries.find(key);
+  return it != shard.entries.end() && it->second.expired();
+}
+
+bool RemoteDramStorage::Remove(const std::string& key) {
+  Shard& shard = GetShard(key);
+  absl::MutexLock lock(&shard.mutex);
+  {
+    // Evicted keys are indexed without an entry.
+    absl::MutexLock index_lock(&index_mutex_);
+    index_.erase(key);
+  }
+  if (!shard.evicted.empty()) shard.evicted.erase(key);
+  auto it = shard.entries.find(key);
+  if (it == shard.entries.end()) return false;
+  const bool existed = !it->second.expired();
+  EraseEntry(shard, it, /*keep_indexed=*/true);
+  return existed;
+}
+
+bool RemoteDramStorage::RemoveIf(const std::string& key, uint64_t if_equal) {
+  Shard& shard = GetShard(key);
+  absl::MutexLock lock(&shard.mutex);
+  auto it = shard.entries.find(key);
+  if (it == shard.entries.end() || it->second.expired()) {
+    return if_equal == kNoGeneration;
+  }
+  if (it->second.stored.generation != if_equal) return false;
+  EraseEntry(shard, it, /*keep_indexed=*/false);
+  return true;
+}
+
+std::vector<RemoteDramStorage::ListedKey> RemoteDramStorage::ListKeys(
+    std::string_view inclusive_min, std::string_view exclusive_max,
+    size_t limit) const {
+  std::vector<ListedKey> keys;
+  {
+    absl::MutexLock index_lock(&index_mutex_);
+    for (auto it = index_.lower_bound(inclusive_min);
+         it != index_.end() && keys.size() < limit &&
+         (exclusive_max.empty() || *it < exclusive_max);
+         ++it) {
+      keys.push_back(ListedKey{*it, -1});
+    }
+  }
+  // Sizes are looked up afterwards, since shard locks may not be acquired
+  // while holding `index_mutex_`.
+  for (auto& listed : keys) {
+    Shard& shard = GetShard(listed.key);
+    absl::MutexLock lock(&shard.mutex);
+    auto it = shard.entries.find(listed.key);
+    if (it != shard.entries.end() && !it->second.expired()) {
+      listed.size = static_cast<int64_t>(it->second.stored.value.size());
+    }
+  }
+  return keys;
+}
+
+size_t RemoteDramStorage::RemoveRange(std::string_view inclusive_min,
+                                      std::string_view exclusive_max) {
+  std::vector<std::string> keys;
+  {
+    absl::MutexLock index_lock(&index_mutex_);
+    auto first = index_.lower_bound(inclusive_min);
+    auto last =
+        exclusive_max.empty() ? index_.end() : index_.lower_bound(exclusive_max);
+    keys.assign(first, last);
+  }
+  for (const auto& key : keys) {
+    Remove(key);
+  }
+  return keys.size();
+}
+
+void RemoteDramStorage::Clear() {
+  for (size_t i = 0; i < kNumShards; ++i) {
+    Shard& shard = shards_[i];
+    absl::MutexLock lock(&shard.mutex);
+    shard.entries.clear();
+    shard.lru.clear();
+    shard.evicted.clear();
+    shard.evicted_order.clear();
+    stored_bytes_.fetch_sub(shard.bytes, std::memory_order_relaxed);
+    shard.bytes = 0;
+  }
+  absl::MutexLock index_lock(&index_mutex_);
+  index_.clear();
+}
+
+void RemoteDramStorage::ClearRegistrations() {
+  for (size_t i = 0; i < kNumShards; ++i) {
+    Shard& shard = shards_[i];
+    absl::MutexLock lock(&shard.mutex);
+    for (auto& [key, entry] : shard.entries) {
+      entry.stored.registration = nullptr;
+    }
+  }
+}
+
+std::vector<std::string> RemoteDramStorage::GetAllKeys() const {
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < kNumShards; ++i) {
+    Shard& shard = shards_[i];
+    absl::MutexLock lock(&shard.mutex);
+    for (const auto& [key, entry] : shard.entries) {
+      keys.push_back(key);
+    }
+  }
+  return keys;
+}
+
+size_t RemoteDramStorage::GetKeyCount() const {
+  size_t count = 0;
+  for (size_t i = 0; i < kNumShards; ++i) {
+    Shard& shard = shards_[i];
+    absl::MutexLock lock(&shard.mutex);
+    count += shard.entries.size();
+  }
+  return count;
+}
+
+size_t RemoteDramStorage::GetStoredBytes() const {
+  return stored_bytes_.load(std::memory_order_relaxed);
+}
+
+void RemoteDramStorage::SetMemoryLimit(size_t memory_limit) {
+  size_t shard_limit = memory_limit == 0
+                           ? 0
+                           : std::max<size_t>(1, memory_limit / kNumShards);
+  memory_limit_.store(memory_limit, std::memory_order_relaxed);
+  shard_memory_limit_.store(shard_limit, std::memory_order_relaxed);
+}
+
+void RemoteDramStorage::SetArena(std::shared_ptr<const SlabArena> arena) {
+  absl::MutexLock lock(&arena_mutex_);
+  arena_ = std::move(arena);
+}
+
+std::shared_ptr<const SlabArena> RemoteDramStorage::GetArena() const {
+  absl::MutexLock lock(&arena_mutex_);
+  return arena_;
+}
+
+void RemoteDramStorage::SetEvictionCallback(EvictionCallback callback) {
+  auto ptr = callback ? std::make_shared<const EvictionCallback>(
+                            std::move(callback))
+                      : nullptr;
+  absl::MutexLock lock(&callback_mutex_);
+  has_eviction_callback_.store(ptr != nullptr, std::memory_order_relaxed);
+  eviction_callback_ = std::move(ptr);
+}
+
+void RemoteDramStorage::SetExpirationRules(std::vector<ExpirationRule> rules) {
+  absl::MutexLock lock(&expiration_mutex_);
+  has_expiration_rules_.store(!rules.empty(), std::memory_order_relaxed);
+  expiration_rules_ = std::move(rules);
+}
+
+size_t RemoteDramStorage::RemoveExpired(absl::Time now) {
+  if (!has_expiration_rules_.load(std::memory_order_relaxed)) return 0;
+  const bool keep_indexed =
+      has_eviction_callback_.load(std::memory_order_relaxed);
+  size_t count = 0;
+  for (size_t i = 0; i < kNumShards; ++i) {
+    Shard& shard = shards_[i];
+    absl::MutexLock lock(&shard.mutex);
+    for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+      if (now < it->second.expires_at) {
+        ++it;
+        continue;
+      }
+      if (!keep_indexed) RecordEvicted(shard, it->first);
+      EraseEntry(shard, it++, keep_indexed);
+      ++count;
+    }
+  }
+  expired_keys_.fetch_add(count, std::memory_order_relaxed);
+  return count;
+}
+
+RemoteDramStorage::EvictionStats RemoteDramStorage::GetEvictionStats() const {
+  EvictionStats stats;
+  stats.evicted_keys = evicted_keys_.load(std::memory_order_relaxed);
+  stats.evicted_bytes = evicted_bytes_.load(std::memory_order_relaxed);
+  stats.expired_keys = expired_keys_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+}  // namespace tensorstore
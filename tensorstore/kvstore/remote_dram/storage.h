@@ -0,0 +1,388 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_REMOTE_DRAM_STORAGE_H_
+#define TENSORSTORE_KVSTORE_REMOTE_DRAM_STORAGE_H_
+
+/// \file
+/// Server-side value storage for the remote_dram kvstore.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/btree_map.h"
+#include "absl/container/btree_set.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/cord.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+
+namespace tensorstore {
+
+/// Allocates value buffers from large slabs, so that the memory can be
+/// registered for RMA once per slab rather than once per transfer.
+///
+/// Buffers are rounded up to a power-of-two size class (at least
+/// `kMinChunkSize`) and carved from slabs of `Options::slab_size` bytes;
+/// requests larger than a slab get a dedicated slab.  Each slab serves a
+/// single size class; freed buffers are kept on the free list of their slab
+/// for reuse, and a slab is released as soon as none of its buffers is in
+/// use, so that `reserved_bytes` shrinks as buffers are freed.
+class SlabArena : public std::enable_shared_from_this<SlabArena> {
+ public:
+  /// Called for each new slab.  The returned handle (for example a UCX memory
+  /// registration) is kept alive as long as the slab, or until
+  /// `ReleaseRegistrations` is called.
+  using RegisterSlabFunction =
+      std::function<std::shared_ptr<void>(void* data, size_t size)>;
+
+  struct Options {
+    size_t slab_size = 16 * 1024 * 1024;
+    RegisterSlabFunction register_slab;
+  };
+
+  static constexpr size_t kMinChunkSize = 4096;
+
+  /// A writable arena buffer.
+  struct Buffer {
+    char* data = nullptr;
+    size_t size = 0;
+    /// Handle returned by `register_slab` for the slab containing `data`, or
+    /// `nullptr`.
+    void* registration = nullptr;
+    /// Owns the buffer, which returns to the arena once every copy of the
+    /// `Cord` is destroyed.
+    absl::Cord cord;
+  };
+
+  static std::shared_ptr<SlabArena> Make(Options options);
+
+  /// Returns a buffer of exactly `size` bytes.  `size` must be non-zero.
+  Buffer Allocate(size_t size);
+
+  /// Returns the bytes of slab memory taken by a buffer of `size` bytes.
+  size_t GetChunkSize(size_t size) const;
+
+  /// Drops all slab registrations, for use before the registration provider
+  /// is torn down.  Buffers remain valid.
+  void ReleaseRegistrations();
+
+  /// Returns the registration of the slab holding all of
+  /// `[data, data + size)`, or `nullptr` if the range is not arena memory or
+  /// its slab is not registered.  This lets memory that has come back from
+  /// the arena, for example as part of a value passed to a write, be sent
+  /// without registering it again.
+  void* FindRegistration(const void* data, size_t size) const;
+
+  /// Total bytes of slab memory held by the arena, i.e. the size of each
+  /// slab with a buffer in use.
+  size_t reserved_bytes() const {
+    return reserved_bytes_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  explicit SlabArena(Options options) : options_(std::move(options)) {}
+
+  struct Slab {
+    std::unique_ptr<char[]> data;
+    size_t size;
+    std::shared_ptr<void> registration;
+    /// Size class of the chunks of the slab, or `-1` for a dedicated slab.
+    int size_class = -1;
+    /// Chunks of the slab not in use.
+    std::vector<char*> free_chunks;
+    /// Number of chunks of the slab in use.
+    size_t chunks_in_use = 0;
+  };
+
+  /// Returns the size-class index for `size`, or `-1` if `size` needs a
+  /// dedicated slab.
+  int GetSizeClass(size_t size) const;
+
+  /// Creates a slab of `size` bytes.
+  std::unique_ptr<Slab> MakeSlab(size_t size, int size_class)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  /// Returns the slab whose memory contains `data`, or `slabs_.end()`.
+  absl::btree_map<const char*, std::unique_ptr<Slab>>::const_iterator
+  FindSlab(const char* data) const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  void Free(char* data, int size_class);
+
+  Options options_;
+  std::atomic<size_t> reserved_bytes_{0};
+  mutable absl::Mutex mutex_;
+  bool registrations_released_ ABSL_GUARDED_BY(mutex_) = false;
+  /// All slabs, keyed by their data pointer.
+  absl::btree_map<const char*, std::unique_ptr<Slab>> slabs_
+      ABSL_GUARDED_BY(mutex_);
+  /// Slabs of each size class with free chunks.
+  std::vector<std::vector<Slab*>> available_slabs_ ABSL_GUARDED_BY(mutex_);
+};
+
+/// A stored value along with the arena registration of its memory.
+struct StoredValue {
+  absl::Cord value;
+  /// `SlabArena::Buffer::registration` of the buffer holding `value`, or
+  /// `nullptr` if `value` is not arena memory.
+  void* registration = nullptr;
+  /// Generation assigned by `RemoteDramStorage::Store`.
+  uint64_t generation = 0;
+};
+
+/// Server-side storage for key-value pairs
+///
+/// Entries are spread over `kNumShards` independently locked shards by key
+/// hash.  When a memory limit is set, each shard holds at most its share of
+/// the limit and evicts least-recently-used entries to stay within it.  If
+/// the values are held by an arena set with `SetArena`, the slab memory it
+/// reserves is also kept within the limit, which also covers the rounding of
+/// values up to their size class and partially used slabs.
+///
+/// Each store assigns the entry a new generation from a single counter, so
+/// that a key that is deleted and written again never repeats a generation.
+/// A sorted index of the keys, updated only when keys are added or removed,
+/// serves range listings and deletions.  Keys evicted while an eviction
+/// callback is set stay in the index, since the callback is expected to keep
+/// their values elsewhere.  Other evicted keys are remembered for a while, so
+/// that reads of them can be told apart from reads of keys never stored.
+///
+/// Values may also expire a fixed time after they are stored, according to
+/// the longest matching prefix of their key.  Expired values are no longer
+/// returned, and are removed by `RemoveExpired`.
+class RemoteDramStorage {
+ public:
+  static constexpr size_t kNumShards = 64;
+
+  /// Generation of a missing key, for use in conditions.
+  static constexpr uint64_t kNoGeneration = 0;
+
+  /// A key returned by `ListKeys`.
+  struct ListedKey {
+    std::string key;
+    /// Size of the value, or -1 if it has been evicted.
+    int64_t size;
+  };
+
+  /// Number of evicted keys of each shard remembered by `WasEvicted`.
+  static constexpr size_t kMaxEvictedKeysPerShard = 4096;
+
+  /// Time to live of the values of keys starting with `prefix`.
+  struct ExpirationRule {
+    std::string prefix;
+    absl::Duration ttl;
+
+    constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+      return f(x.prefix, x.ttl);
+    };
+  };
+
+  /// Cumulative counts of values dropped from memory.
+  struct EvictionStats {
+    /// Values evicted to honor the memory limit, and their total size.
+    int64_t evicted_keys = 0;
+    int64_t evicted_bytes = 0;
+    /// Values removed once expired.
+    int64_t expired_keys = 0;
+  };
+
+  /// Called, without any lock held, with each entry evicted to honor the
+  /// memory limit.
+  using EvictionCallback =
+      std::function<void(std::string key, absl::Cord value)>;
+
+  RemoteDramStorage();
+  ~RemoteDramStorage();
+
+  /// Store a key-value pair.  `registration` describes the arena buffer
+  /// holding `value`, if any.  If `if_equal` is specified, the pair is only
+  /// stored if it equals the current generation of `key` (`kNoGeneration` if
+  /// missing).  Returns the new generation, or `std::nullopt` if the
+  /// condition does not hold.
+  ///
+  /// If `generation` is not `kNoGeneration`, it is assigned instead of a new
+  /// one, as for copies of values stored elsewhere; the pair is then only
+  /// stored if `generation` is newer than the current one, and the current
+  /// generation is returned otherwise.
+  std::optional<uint64_t> Store(const std::string& key,
+                                const absl::Cord& value,
+                                void* registration = nullptr,
+                                std::optional<uint64_t> if_equal = std::nullopt,
+                                uint64_t generation = kNoGeneration);
+
+  /// Retrieve a value by key
+  std::optional<absl::Cord> Get(const std::string& key) const;
+
+  /// Retrieve a value and its registration by key
+  std::optional<StoredValue> Lookup(const std::string& key) const;
+
+  /// Returns whether `key` is missing because its value was evicted or
+  /// expired, rather than removed or never stored.  Only the most recent
+  /// `kMaxEvictedKeysPerShard` such keys of each shard are remembered, and
+  /// none while an eviction callback is set.
+  bool WasEvicted(const std::string& key) const;
+
+  /// Check if key exists
+  bool Exists(const std::string& key) const;
+
+  /// Remove a key
+  bool Remove(const std::string& key);
+
+  /// Removes `key` if `if_equal` equals its generation.  Returns whether the
+  /// condition holds; a missing key matches `kNoGeneration`.
+  bool RemoveIf(const std::string& key, uint64_t if_equal);
+
+  /// Returns, in order, up to `limit` keys in
+  /// `[inclusive_min, exclusive_max)`; an empty `exclusive_max` is unbounded.
+  std::vector<ListedKey> ListKeys(std::string_view inclusive_min,
+                                  std::string_view exclusive_max,
+                                  size_t limit) const;
+
+  /// Removes the keys in `[inclusive_min, exclusive_max)`; an empty
+  /// `exclusive_max` is unbounded.  Returns the number of keys removed.
+  size_t RemoveRange(std::string_view inclusive_min,
+                     std::string_view exclusive_max);
+
+  /// Remove all keys
+  void Clear();
+
+  /// Resets the registration of every entry to `nullptr`, for use when the
+  /// registrations are released while the values are kept.
+  void ClearRegistrations();
+
+  /// Get all stored keys (for verification/debugging)
+  std::vector<std::string> GetAllKeys() const;
+
+  /// Get storage statistics
+  size_t GetKeyCount() const;
+
+  /// Total size of the stored values.
+  size_t GetStoredBytes() const;
+
+  /// Limits the total size of stored values, and the slab memory reserved by
+  /// the arena set with `SetArena`; 0 means unlimited.  Takes effect on the
+  /// next store to each shard.
+  void SetMemoryLimit(size_t memory_limit);
+
+  /// Sets the arena that stored values are allocated from, whose
+  /// `reserved_bytes` count against the memory limit.  While the arena holds
+  /// more than the limit, each store evicts least-recently-used entries of
+  /// its shard until their chunks add up to the excess.
+  void SetArena(std::shared_ptr<const SlabArena> arena);
+
+  /// Sets the function called with evicted entries.
+  void SetEvictionCallback(EvictionCallback callback);
+
+  /// Sets the time to live of stored values.  A value expires `ttl` after it
+  /// is stored, for the rule with the longest `prefix` of its key; values of
+  /// keys that match no rule do not expire.  Takes effect for values stored
+  /// afterwards.
+  void SetExpirationRules(std::vector<ExpirationRule> rules);
+
+  /// Removes the values that have expired by `now`.  Returns the number of
+  /// values removed.
+  size_t RemoveExpired(absl::Time now);
+
+  EvictionStats GetEvictionStats() const;
+
+ private:
+  struct Entry {
+    StoredValue stored;
+    std::list<std::string>::iterator lru_position;
+    absl::Time expires_at = absl::InfiniteFuture();
+
+    bool expired() const {
+      return expires_at != absl::InfiniteFuture() && absl::Now() >= expires_at;
+    }
+  };
+
+  struct Shard {
+    mutable absl::Mutex mutex;
+    absl::flat_hash_map<std::string, Entry> entries ABSL_GUARDED_BY(mutex);
+    /// Most recently used first.
+    mutable std::list<std::string> lru ABSL_GUARDED_BY(mutex);
+    size_t bytes ABSL_GUARDED_BY(mutex) = 0;
+    /// Recently evicted keys not stored since, oldest first.
+    absl::flat_hash_set<std::string> evicted ABSL_GUARDED_BY(mutex);
+    std::deque<std::string> evicted_order ABSL_GUARDED_BY(mutex);
+  };
+
+  Shard& GetShard(std::string_view key) const;
+
+  /// Removes `it` from `shard`, and from the index unless `keep_indexed`.
+  /// Returns the value of the entry.
+  absl::Cord EraseEntry(Shard& shard,
+                        absl::flat_hash_map<std::string, Entry>::iterator it,
+                        bool keep_indexed)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex);
+
+  /// Remembers that `key` was evicted from `shard`.
+  static void RecordEvicted(Shard& shard, const std::string& key)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex);
+
+  std::shared_ptr<const SlabArena> GetArena() const;
+
+  /// Returns when a value of `key` stored now expires.
+  absl::Time GetExpirationTime(std::string_view key) const;
+
+  std::unique_ptr<Shard[]> shards_;
+  std::atomic<size_t> memory_limit_{0};
+  std::atomic<size_t> shard_memory_limit_{0};
+  /// Sum of the `bytes` of all shards, so that it can be read without
+  /// locking them.
+  std::atomic<size_t> stored_bytes_{0};
+  std::atomic<uint64_t> next_generation_{kNoGeneration + 1};
+  std::atomic<int64_t> evicted_keys_{0};
+  std::atomic<int64_t> evicted_bytes_{0};
+  std::atomic<int64_t> expired_keys_{0};
+
+  /// All keys.  Updated while holding the lock of the key's shard, which
+  /// therefore must not be acquired while `index_mutex_` is held.
+  mutable absl::Mutex index_mutex_;
+  absl::btree_set<std::string> index_ ABSL_GUARDED_BY(index_mutex_);
+  /// Whether `eviction_callback_` is set; read with a shard lock held.
+  std::atomic<bool> has_eviction_callback_{false};
+
+  mutable absl::Mutex arena_mutex_;
+  std::shared_ptr<const SlabArena> arena_ ABSL_GUARDED_BY(arena_mutex_);
+
+  mutable absl::Mutex callback_mutex_;
+  std::shared_ptr<const EvictionCallback> eviction_callback_
+      ABSL_GUARDED_BY(callback_mutex_);
+
+  mutable absl::Mutex expiration_mutex_;
+  std::vector<ExpirationRule> expiration_rules_
+      ABSL_GUARDED_BY(expiration_mutex_);
+  /// Whether `expiration_rules_` is non-empty, so that stores need not lock
+  /// `expiration_mutex_` when no value expires.
+  std::atomic<bool> has_expiration_rules_{false};
+};
+
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_REMOTE_DRAM_STORAGE_H_
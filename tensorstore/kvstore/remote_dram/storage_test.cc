@@ -0,0 +1,418 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/remote_dram/storage.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/cord.h"
+#include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+
+namespace {
+
+using ::tensorstore::RemoteDramStorage;
+using ::tensorstore::SlabArena;
+using ::testing::ElementsAre;
+using ::testing::Optional;
+using ::testing::UnorderedElementsAre;
+
+TEST(SlabArenaTest, AllocateRegistersOncePerSlab) {
+  int registrations = 0;
+  int deregistrations = 0;
+  auto arena = SlabArena::Make({
+      /*.slab_size=*/64 * 1024,
+      /*.register_slab=*/
+      [&](void* data, size_t size) {
+        ++registrations;
+        return std::shared_ptr<void>(data, [&](void*) { ++deregistrations; });
+      },
+  });
+  std::vector<SlabArena::Buffer> buffers;
+  for (int i = 0; i < 16; ++i) {
+    buffers.push_back(arena->Allocate(4000));
+    EXPECT_EQ(4000, buffers.back().cord.size());
+    EXPECT_NE(nullptr, buffers.back().registration);
+  }
+  EXPECT_EQ(1, registrations);
+  EXPECT_EQ(64 * 1024, arena->reserved_bytes());
+
+  // A seventeenth chunk of this class needs a new slab.
+  buffers.push_back(arena->Allocate(4096));
+  EXPECT_EQ(2, registrations);
+
+  // Freed chunks are reused.
+  char* data = buffers.front().data;
+  buffers.erase(buffers.begin());
+  EXPECT_EQ(data, arena->Allocate(100).data);
+  EXPECT_EQ(2, registrations);
+
+  arena->ReleaseRegistrations();
+  EXPECT_EQ(2, deregistrations);
+  EXPECT_EQ(nullptr, arena->Allocate(100).registration);
+}
+
+TEST(SlabArenaTest, ReleasesEmptySlabs) {
+  int deregistrations = 0;
+  auto arena = SlabArena::Make({
+      /*.slab_size=*/64 * 1024,
+      /*.register_slab=*/
+      [&](void* data, size_t size) {
+        return std::shared_ptr<void>(data, [&](void*) { ++deregistrations; });
+      },
+  });
+  std::vector<SlabArena::Buffer> buffers;
+  for (int i = 0; i < 17; ++i) {
+    buffers.push_back(arena->Allocate(4096));
+  }
+  EXPECT_EQ(128 * 1024, arena->reserved_bytes());
+
+  // The second slab holds only the last buffer.
+  buffers.pop_back();
+  EXPECT_EQ(64 * 1024, arena->reserved_bytes());
+  EXPECT_EQ(1, deregistrations);
+
+  buffers.clear();
+  EXPECT_EQ(0, arena->reserved_bytes());
+  EXPECT_EQ(2, deregistrations);
+}
+
+TEST(SlabArenaTest, OversizedAllocationUsesDedicatedSlab) {
+  auto arena = SlabArena::Make({/*.slab_size=*/64 * 1024, {}});
+  {
+    auto buffer = arena->Allocate(100 * 1024);
+    EXPECT_EQ(100 * 1024, arena->reserved_bytes());
+    EXPECT_EQ(nullptr, buffer.registration);
+  }
+  EXPECT_EQ(0, arena->reserved_bytes());
+}
+
+TEST(SlabArenaTest, FindRegistration) {
+  auto arena = SlabArena::Make({
+      /*.slab_size=*/64 * 1024,
+      /*.register_slab=*/
+      [](void* data, size_t size) {
+        return std::shared_ptr<void>(data, [](void*) {});
+      },
+  });
+  auto buffer = arena->Allocate(4000);
+  EXPECT_EQ(buffer.registration,
+            arena->FindRegistration(buffer.data + 10, 100));
+  EXPECT_EQ(buffer.registration, arena->FindRegistration(buffer.data, 4000));
+  char other[16];
+  EXPECT_EQ(nullptr, arena->FindRegistration(other, sizeof(other)));
+  // Ranges extending past the slab are not covered.
+  EXPECT_EQ(nullptr, arena->FindRegistration(buffer.data, 128 * 1024));
+
+  auto dedicated = arena->Allocate(100 * 1024);
+  EXPECT_EQ(dedicated.registration,
+            arena->FindRegistration(dedicated.data + 50 * 1024, 1024));
+
+  arena->ReleaseRegistrations();
+  EXPECT_EQ(nullptr, arena->FindRegistration(buffer.data, 4000));
+}
+
+TEST(SlabArenaTest, CordOutlivesArenaHandle) {
+  absl::Cord cord;
+  {
+    auto arena = SlabArena::Make({/*.slab_size=*/64 * 1024, {}});
+    auto buffer = arena->Allocate(5);
+    memcpy(buffer.data, "hello", 5);
+    cord = std::move(buffer.cord);
+  }
+  EXPECT_EQ("hello", cord);
+}
+
+TEST(RemoteDramStorageTest, Basic) {
+  RemoteDramStorage storage;
+  EXPECT_EQ(std::nullopt, storage.Get("a"));
+  storage.Store("a", absl::Cord("xyz"));
+  storage.Store("b", absl::Cord("12"));
+  EXPECT_THAT(storage.Get("a"), Optional(absl::Cord("xyz")));
+  EXPECT_TRUE(storage.Exists("b"));
+  EXPECT_EQ(2, storage.GetKeyCount());
+  EXPECT_EQ(5, storage.GetStoredBytes());
+  EXPECT_THAT(storage.GetAllKeys(), UnorderedElementsAre("a", "b"));
+
+  storage.Store("a", absl::Cord("x"));
+  EXPECT_EQ(3, storage.GetStoredBytes());
+
+  EXPECT_TRUE(storage.Remove("a"));
+  EXPECT_FALSE(storage.Remove("a"));
+  EXPECT_FALSE(storage.Exists("a"));
+  EXPECT_EQ(2, storage.GetStoredBytes());
+
+  storage.Clear();
+  EXPECT_EQ(0, storage.GetKeyCount());
+}
+
+TEST(RemoteDramStorageTest, LookupReturnsRegistration) {
+  RemoteDramStorage storage;
+  int registration;
+  storage.Store("a", absl::Cord("xyz"), &registration);
+  auto stored = storage.Lookup("a");
+  ASSERT_TRUE(stored);
+  EXPECT_EQ(&registration, stored->registration);
+  EXPECT_EQ("xyz", stored->value);
+}
+
+TEST(RemoteDramStorageTest, Generations) {
+  RemoteDramStorage storage;
+  auto a1 = storage.Store("a", absl::Cord("1"));
+  ASSERT_TRUE(a1);
+  EXPECT_NE(RemoteDramStorage::kNoGeneration, *a1);
+  EXPECT_EQ(*a1, storage.Lookup("a")->generation);
+
+  // Conditional stores.
+  EXPECT_EQ(std::nullopt,
+            storage.Store("a", absl::Cord("2"), nullptr,
+                          RemoteDramStorage::kNoGeneration));
+  auto a2 = storage.Store("a", absl::Cord("2"), nullptr, *a1);
+  ASSERT_TRUE(a2);
+  EXPECT_NE(*a1, *a2);
+  EXPECT_EQ(std::nullopt, storage.Store("a", absl::Cord("3"), nullptr, *a1));
+  EXPECT_TRUE(storage.Store("b", absl::Cord("1"), nullptr,
+                            RemoteDramStorage::kNoGeneration));
+
+  // Conditional removes.
+  EXPECT_FALSE(storage.RemoveIf("a", *a1));
+  EXPECT_TRUE(storage.RemoveIf("a", *a2));
+  EXPECT_FALSE(storage.Exists("a"));
+  EXPECT_TRUE(storage.RemoveIf("a", RemoteDramStorage::kNoGeneration));
+
+  // A re-created key gets a new generation.
+  auto a3 = storage.Store("a", absl::Cord("1"));
+  EXPECT_NE(*a1, *a3);
+  EXPECT_NE(*a2, *a3);
+}
+
+TEST(RemoteDramStorageTest, StoreWithGeneration) {
+  RemoteDramStorage storage;
+  EXPECT_EQ(100, storage.Store("a", absl::Cord("1"), nullptr, std::nullopt,
+                               /*generation=*/100));
+  EXPECT_EQ(100, storage.Lookup("a")->generation);
+  // An older copy does not replace a newer one.
+  EXPECT_EQ(100, storage.Store("a", absl::Cord("0"), nullptr, std::nullopt,
+                               /*generation=*/99));
+  EXPECT_EQ("1", storage.Lookup("a")->value);
+  // Generations assigned afterwards are newer.
+  auto b = storage.Store("b", absl::Cord("1"));
+  ASSERT_TRUE(b);
+  EXPECT_GT(*b, 100);
+}
+
+TEST(RemoteDramStorageTest, ListKeys) {
+  RemoteDramStorage storage;
+  for (const char* key : {"c", "a/2", "b", "a/1", "a"}) {
+    storage.Store(key, absl::Cord(key));
+  }
+  auto keys = [&](std::string_view inclusive_min,
+                  std::string_view exclusive_max, size_t limit) {
+    std::vector<std::string> result;
+    for (auto& listed : storage.ListKeys(inclusive_min, exclusive_max, limit)) {
+      EXPECT_EQ(listed.key.size(), listed.size);
+      result.push_back(listed.key);
+    }
+    return result;
+  };
+  EXPECT_THAT(keys("", "", 100), ElementsAre("a", "a/1", "a/2", "b", "c"));
+  EXPECT_THAT(keys("a/", "a0", 100), ElementsAre("a/1", "a/2"));
+  EXPECT_THAT(keys("a/1", "", 2), ElementsAre("a/1", "a/2"));
+  EXPECT_THAT(keys("d", "", 100), ElementsAre());
+
+  EXPECT_EQ(2, storage.RemoveRange("a/", "a0"));
+  EXPECT_THAT(keys("", "", 100), ElementsAre("a", "b", "c"));
+  EXPECT_EQ(2, storage.RemoveRange("b", ""));
+  EXPECT_THAT(keys("", "", 100), ElementsAre("a"));
+  EXPECT_EQ(1, storage.GetKeyCount());
+}
+
+TEST(RemoteDramStorageTest, EvictedKeysStayListedWithCallback) {
+  RemoteDramStorage storage;
+  storage.SetMemoryLimit(RemoteDramStorage::kNumShards);
+  storage.SetEvictionCallback([](std::string key, absl::Cord value) {});
+  for (int i = 0; i < 1000; ++i) {
+    storage.Store(absl::StrCat("k", i), absl::Cord("xx"));
+  }
+  auto listed = storage.ListKeys("", "", 2000);
+  EXPECT_EQ(1000, listed.size());
+  EXPECT_LT(storage.GetKeyCount(), 1000);
+  storage.Remove("k0");
+  EXPECT_EQ(999, storage.ListKeys("", "", 2000).size());
+
+  // Without a callback, evicted keys are gone.
+  RemoteDramStorage dropping;
+  dropping.SetMemoryLimit(RemoteDramStorage::kNumShards);
+  for (int i = 0; i < 1000; ++i) {
+    dropping.Store(absl::StrCat("k", i), absl::Cord("xx"));
+  }
+  EXPECT_EQ(dropping.GetKeyCount(), dropping.ListKeys("", "", 2000).size());
+}
+
+/// Returns `n` keys that are stored in the same shard as `anchor`.
+std::vector<std::string> FindKeysInSameShard(std::string anchor, size_t n) {
+  RemoteDramStorage storage;
+  bool evicted = false;
+  storage.SetEvictionCallback(
+      [&](std::string key, absl::Cord value) { evicted = true; });
+  // Each shard holds a single one-byte value.
+  storage.SetMemoryLimit(RemoteDramStorage::kNumShards);
+  std::vector<std::string> keys;
+  for (int i = 0; keys.size() < n; ++i) {
+    std::string key = absl::StrCat("key", i);
+    storage.Clear();
+    evicted = false;
+    storage.Store(anchor, absl::Cord("a"));
+    storage.Store(key, absl::Cord("b"));
+    if (evicted) keys.push_back(key);
+  }
+  return keys;
+}
+
+TEST(RemoteDramStorageTest, EvictsToMemoryLimit) {
+  RemoteDramStorage storage;
+  std::vector<std::pair<std::string, std::string>> evicted;
+  storage.SetEvictionCallback([&](std::string key, absl::Cord value) {
+    evicted.emplace_back(std::move(key), std::string(value));
+  });
+  const size_t limit = 10 * RemoteDramStorage::kNumShards;
+  storage.SetMemoryLimit(limit);
+  for (int i = 0; i < 1000; ++i) {
+    storage.Store(absl::StrCat("k", i), absl::Cord("xxxx"));
+    EXPECT_LE(storage.GetStoredBytes(), limit);
+  }
+  EXPECT_FALSE(evicted.empty());
+  EXPECT_EQ(1000, storage.GetKeyCount() + evicted.size());
+  for (const auto& [key, value] : evicted) {
+    EXPECT_FALSE(storage.Exists(key));
+    EXPECT_EQ("xxxx", value);
+  }
+}
+
+TEST(RemoteDramStorageTest, EvictsToArenaSlabLimit) {
+  // Each 100-byte value takes a 4 KiB slab of its own, so that the slab
+  // memory far exceeds the size of the values.
+  auto arena = SlabArena::Make({/*.slab_size=*/4096, {}});
+  RemoteDramStorage storage;
+  storage.SetArena(arena);
+  const size_t limit = 512 * 1024;
+  storage.SetMemoryLimit(limit);
+  for (int i = 0; i < 1000; ++i) {
+    auto buffer = arena->Allocate(100);
+    memset(buffer.data, 'x', 100);
+    storage.Store(absl::StrCat("k", i), buffer.cord, buffer.registration);
+    // Each shard keeps at least the value just stored to it.
+    EXPECT_LE(arena->reserved_bytes(),
+              limit + RemoteDramStorage::kNumShards * 4096);
+  }
+  EXPECT_LT(storage.GetKeyCount(), 1000);
+  EXPECT_EQ(storage.GetKeyCount() * 4096, arena->reserved_bytes());
+}
+
+TEST(RemoteDramStorageTest, EvictsLeastRecentlyUsed) {
+  auto keys = FindKeysInSameShard("a", 2);
+  RemoteDramStorage storage;
+  std::vector<std::string> evicted;
+  storage.SetEvictionCallback([&](std::string key, absl::Cord value) {
+    evicted.push_back(std::move(key));
+  });
+  // Each shard holds two of the five-byte values below.
+  storage.SetMemoryLimit(10 * RemoteDramStorage::kNumShards);
+  storage.Store("a", absl::Cord("aaaaa"));
+  storage.Store(keys[0], absl::Cord("bbbbb"));
+  // Reading "a" makes `keys[0]` the least recently used.
+  EXPECT_TRUE(storage.Get("a"));
+  storage.Store(keys[1], absl::Cord("ccccc"));
+  EXPECT_THAT(evicted, ElementsAre(keys[0]));
+  EXPECT_TRUE(storage.Exists("a"));
+  EXPECT_TRUE(storage.Exists(keys[1]));
+}
+
+TEST(RemoteDramStorageTest, NewEntryIsNotEvicted) {
+  RemoteDramStorage storage;
+  storage.SetMemoryLimit(RemoteDramStorage::kNumShards);
+  storage.Store("a", absl::Cord("larger than the shard limit"));
+  EXPECT_TRUE(storage.Exists("a"));
+}
+
+TEST(RemoteDramStorageTest, RemembersEvictedKeys) {
+  auto keys = FindKeysInSameShard("a", 1);
+  RemoteDramStorage storage;
+  storage.SetMemoryLimit(RemoteDramStorage::kNumShards);
+  storage.Store("a", absl::Cord("a"));
+  storage.Store(keys[0], absl::Cord("b"));
+  EXPECT_FALSE(storage.Exists("a"));
+  EXPECT_TRUE(storage.WasEvicted("a"));
+  EXPECT_FALSE(storage.WasEvicted(keys[0]));
+  EXPECT_FALSE(storage.WasEvicted("never stored"));
+  auto stats = storage.GetEvictionStats();
+  EXPECT_EQ(1, stats.evicted_keys);
+  EXPECT_EQ(1, stats.evicted_bytes);
+
+  // A removed key is no longer reported as evicted.
+  storage.Remove("a");
+  EXPECT_FALSE(storage.WasEvicted("a"));
+}
+
+TEST(RemoteDramStorageTest, Expiration) {
+  RemoteDramStorage storage;
+  storage.SetExpirationRules({{"tmp/", absl::ZeroDuration()},
+                              {"tmp/keep/", absl::Hours(1)}});
+  storage.Store("tmp/a", absl::Cord("a"));
+  storage.Store("tmp/keep/b", absl::Cord("b"));
+  storage.Store("c", absl::Cord("c"));
+  EXPECT_FALSE(storage.Get("tmp/a"));
+  EXPECT_TRUE(storage.WasEvicted("tmp/a"));
+  EXPECT_TRUE(storage.Get("tmp/keep/b"));
+  EXPECT_TRUE(storage.Get("c"));
+  // An expired value no longer satisfies conditions on its generation.
+  EXPECT_TRUE(storage.Store("tmp/a", absl::Cord("a"), nullptr,
+                            RemoteDramStorage::kNoGeneration));
+
+  EXPECT_EQ(1, storage.RemoveExpired(absl::Now()));
+  EXPECT_EQ(2, storage.GetKeyCount());
+  EXPECT_EQ(2, storage.GetStoredBytes());
+  EXPECT_TRUE(storage.WasEvicted("tmp/a"));
+  EXPECT_EQ(1, storage.GetEvictionStats().expired_keys);
+  EXPECT_THAT(storage.GetAllKeys(), UnorderedElementsAre("tmp/keep/b", "c"));
+  EXPECT_EQ(1, storage.RemoveExpired(absl::Now() + absl::Hours(2)));
+}
+
+TEST(RemoteDramStorageTest, ConcurrentAccess) {
+  RemoteDramStorage storage;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < 1000; ++i) {
+        std::string key = absl::StrCat(t, "/", i);
+        storage.Store(key, absl::Cord(key));
+        EXPECT_THAT(storage.Get(key), Optional(absl::Cord(key)));
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  EXPECT_EQ(8000, storage.GetKeyCount());
+}
+
+}  // namespace
@@ -0,0 +1,188 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/remote_dram/write_back_queue.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/log/absl_log.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+
+std::shared_ptr<WriteBackQueue> WriteBackQueue::Make(kvstore::KvStore base,
+                                                     Options options) {
+  return std::shared_ptr<WriteBackQueue>(
+      new WriteBackQueue(std::move(base), options));
+}
+
+Future<const void> WriteBackQueue::Enqueue(std::string key,
+                                           std::optional<absl::Cord> value,
+                                           uint64_t generation) {
+  Future<const void> future;
+  {
+    absl::MutexLock lock(&mutex_);
+    KeyState& state = keys_[key];
+    const auto& latest = state.next ? state.next : state.in_flight;
+    if (generation != 0 && latest && latest->generation >= generation) {
+      return MakeReadyFuture();
+    }
+    QueuedWrite write{std::move(value), generation, 0, key.size()};
+    if (write.value) write.bytes += write.value->size();
+    if (state.next) {
+      dirty_bytes_ -= state.next->bytes;
+      write.sequence = state.next->sequence;
+    } else {
+      write.sequence = next_sequence_;
+      incomplete_.insert(write.sequence);
+      if (!state.in_flight) ready_.push_back(key);
+    }
+    ++next_sequence_;
+    dirty_bytes_ += write.bytes;
+    state.next = std::move(write);
+    if (dirty_bytes_ <= options_.max_dirty_bytes &&
+        admission_waiters_.empty()) {
+      future = MakeReadyFuture();
+    } else {
+      auto [promise, waiter] = PromiseFuturePair<void>::Make();
+      admission_waiters_.push_back(std::move(promise));
+      future = std::move(waiter);
+    }
+  }
+  StartWrites();
+  return future;
+}
+
+std::optional<std::optional<absl::Cord>> WriteBackQueue::Find(
+    std::string_view key) const {
+  absl::MutexLock lock(&mutex_);
+  auto it = keys_.find(key);
+  if (it == keys_.end()) return std::nullopt;
+  const auto& latest =
+      it->second.next ? it->second.next : it->second.in_flight;
+  if (!latest) return std::nullopt;
+  return latest->value;
+}
+
+Future<const void> WriteBackQueue::Flush() {
+  absl::MutexLock lock(&mutex_);
+  const uint64_t sequence = next_sequence_ - 1;
+  if (incomplete_.empty() || *incomplete_.begin() > sequence) {
+    absl::Status status = std::exchange(error_, absl::OkStatus());
+    return MakeReadyFuture<void>(std::move(status));
+  }
+  auto [promise, future] = PromiseFuturePair<void>::Make();
+  flushers_.push_back(Flusher{sequence, std::move(promise)});
+  return std::move(future);
+}
+
+size_t WriteBackQueue::dirty_bytes() const {
+  absl::MutexLock lock(&mutex_);
+  return dirty_bytes_;
+}
+
+void WriteBackQueue::StartWrites() {
+  std::vector<std::pair<std::string, std::optional<absl::Cord>>> writes;
+  {
+    absl::MutexLock lock(&mutex_);
+    while (num_in_flight_ < options_.max_concurrent_writes &&
+           !ready_.empty()) {
+      std::string key = std::move(ready_.front());
+      ready_.pop_front();
+      KeyState& state = keys_[key];
+      state.in_flight = std::move(state.next);
+      state.next.reset();
+      ++num_in_flight_;
+      writes.emplace_back(std::move(key), state.in_flight->value);
+    }
+  }
+  for (auto& [key, value] : writes) {
+    kvstore::Write(base_, key, std::move(value))
+        .ExecuteWhenReady(
+            [self = shared_from_this(), key = std::move(key)](
+                ReadyFuture<TimestampedStorageGeneration> future) mutable {
+              self->WriteDone(std::move(key), future.status());
+            });
+  }
+}
+
+void WriteBackQueue::WriteDone(std::string key, absl::Status status) {
+  std::vector<Promise<void>> admitted;
+  std::vector<Promise<void>> flushed;
+  absl::Status flush_status;
+  {
+    absl::MutexLock lock(&mutex_);
+    if (!status.ok()) {
+      ABSL_LOG(ERROR) << "Failed to write back key '" << key
+                      << "': " << status;
+      if (error_.ok()) error_ = status;
+    }
+    auto it = keys_.find(key);
+    KeyState& state = it->second;
+    dirty_bytes_ -= state.in_flight->bytes;
+    // A replacement queued while the write was in progress has a sequence of
+    // its own, since the write it would replace had already started.
+    incomplete_.erase(state.in_flight->sequence);
+    state.in_flight.reset();
+    --num_in_flight_;
+    if (state.next) {
+      ready_.push_back(std::move(key));
+    } else {
+      keys_.erase(it);
+    }
+    TakeReady(admitted, flushed, flush_status);
+  }
+  for (auto& promise : admitted) promise.SetResult(absl::OkStatus());
+  for (auto& promise : flushed) promise.SetResult(flush_status);
+  StartWrites();
+}
+
+void WriteBackQueue::TakeReady(std::vector<Promise<void>>& admitted,
+                               std::vector<Promise<void>>& flushed,
+                               absl::Status& status) {
+  // A write larger than the bound is admitted once it has been written.
+  while (!admission_waiters_.empty() &&
+         dirty_bytes_ <= options_.max_dirty_bytes) {
+    admitted.push_back(std::move(admission_waiters_.front()));
+    admission_waiters_.pop_front();
+  }
+  const uint64_t oldest =
+      incomplete_.empty() ? next_sequence_ : *incomplete_.begin();
+  for (size_t i = 0; i < flushers_.size();) {
+    if (flushers_[i].sequence < oldest) {
+      flushed.push_back(std::move(flushers_[i].promise));
+      flushers_[i] = std::move(flushers_.back());
+      flushers_.pop_back();
+    } else {
+      ++i;
+    }
+  }
+  if (!flushed.empty()) status = std::exchange(error_, absl::OkStatus());
+}
+
+}  // namespace tensorstore
@@ -0,0 +1,150 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_REMOTE_DRAM_WRITE_BACK_QUEUE_H_
+#define TENSORSTORE_KVSTORE_REMOTE_DRAM_WRITE_BACK_QUEUE_H_
+
+/// \file
+/// Background write-back of remote_dram server values to a base kvstore.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/btree_set.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+
+/// Writes values acknowledged by the server to a base kvstore in the
+/// background.
+///
+/// Writes of each key reach the base kvstore in the order of their
+/// generations: at most one write of a key is in progress at a time, and a
+/// queued write that has not started is replaced by a newer write of its key.
+/// Writes of different keys proceed concurrently, in the order in which they
+/// were queued.
+class WriteBackQueue : public std::enable_shared_from_this<WriteBackQueue> {
+ public:
+  struct Options {
+    /// Bound on the bytes of queued writes that are acknowledged but not yet
+    /// written to the base kvstore.
+    size_t max_dirty_bytes = 256 * 1024 * 1024;
+
+    /// Maximum number of concurrent writes to the base kvstore.
+    size_t max_concurrent_writes = 64;
+  };
+
+  static std::shared_ptr<WriteBackQueue> Make(kvstore::KvStore base,
+                                              Options options);
+
+  /// Queues a write of `value`, or a delete if `value` is `std::nullopt`, of
+  /// `key`.  A write whose `generation` is not newer than that of a write of
+  /// `key` already queued is ignored, since it has been superseded; deletes
+  /// and writes with a `generation` of 0 are always queued.
+  ///
+  /// Returns a future that becomes ready once the queued bytes not yet
+  /// written are within `Options::max_dirty_bytes`, at which point the write
+  /// may be acknowledged.
+  Future<const void> Enqueue(std::string key, std::optional<absl::Cord> value,
+                             uint64_t generation);
+
+  /// Returns the newest queued value of `key` that is not yet known to be
+  /// written, or `std::nullopt` if there is none.  A queued delete is
+  /// returned as an empty inner optional.
+  std::optional<std::optional<absl::Cord>> Find(std::string_view key) const;
+
+  /// Returns a future that becomes ready once every write queued before the
+  /// call has been written to the base kvstore.  Its error, if any, is the
+  /// first error writing to the base kvstore since the previous flush.
+  Future<const void> Flush();
+
+  /// Bytes of queued writes not yet written.
+  size_t dirty_bytes() const;
+
+  const kvstore::KvStore& base() const { return base_; }
+
+ private:
+  WriteBackQueue(kvstore::KvStore base, Options options)
+      : base_(std::move(base)), options_(options) {}
+
+  struct QueuedWrite {
+    std::optional<absl::Cord> value;
+    uint64_t generation;
+    /// Position in the order of `Enqueue` calls.  A write that replaces
+    /// another keeps the sequence of the write it replaces, so that flushes
+    /// waiting for that write wait for its replacement.
+    uint64_t sequence;
+    size_t bytes;
+  };
+
+  struct KeyState {
+    /// Write in progress, if any.
+    std::optional<QueuedWrite> in_flight;
+    /// Write to start once `in_flight` completes, if any.
+    std::optional<QueuedWrite> next;
+  };
+
+  struct Flusher {
+    /// Sequence of the last write queued before the flush.
+    uint64_t sequence;
+    Promise<void> promise;
+  };
+
+  /// Starts queued writes, up to `Options::max_concurrent_writes`.
+  void StartWrites();
+
+  void WriteDone(std::string key, absl::Status status);
+
+  /// Removes and returns the admission waiters and flushes that can be
+  /// completed, along with the status of the flushes.
+  void TakeReady(std::vector<Promise<void>>& admitted,
+                 std::vector<Promise<void>>& flushed, absl::Status& status)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const kvstore::KvStore base_;
+  const Options options_;
+
+  mutable absl::Mutex mutex_;
+  absl::flat_hash_map<std::string, KeyState> keys_ ABSL_GUARDED_BY(mutex_);
+  /// Keys with a `next` write and no write in progress, in queuing order.
+  std::deque<std::string> ready_ ABSL_GUARDED_BY(mutex_);
+  /// Sequences of the writes not yet written.
+  absl::btree_set<uint64_t> incomplete_ ABSL_GUARDED_BY(mutex_);
+  uint64_t next_sequence_ ABSL_GUARDED_BY(mutex_) = 1;
+  size_t dirty_bytes_ ABSL_GUARDED_BY(mutex_) = 0;
+  size_t num_in_flight_ ABSL_GUARDED_BY(mutex_) = 0;
+  /// Writes awaiting acknowledgement until `dirty_bytes_` is within bounds.
+  std::deque<Promise<void>> admission_waiters_ ABSL_GUARDED_BY(mutex_);
+  std::vector<Flusher> flushers_ ABSL_GUARDED_BY(mutex_);
+  /// First error since the previous flush completed.
+  absl::Status error_ ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_REMOTE_DRAM_WRITE_BACK_QUEUE_H_
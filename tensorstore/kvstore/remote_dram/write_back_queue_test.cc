@@ -0,0 +1,128 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/remote_dram/write_back_queue.h"
+
+#include <optional>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/time/clock.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/mock_kvstore.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::StatusIs;
+using ::tensorstore::StorageGeneration;
+using ::tensorstore::TimestampedStorageGeneration;
+using ::tensorstore::WriteBackQueue;
+using ::tensorstore::internal::MockKeyValueStore;
+using ::testing::Optional;
+
+void Complete(MockKeyValueStore::WriteRequest request,
+              absl::Status status = absl::OkStatus()) {
+  if (!status.ok()) {
+    request.promise.SetResult(status);
+    return;
+  }
+  request.promise.SetResult(TimestampedStorageGeneration{
+      StorageGeneration::FromString("g"), absl::Now()});
+}
+
+TEST(WriteBackQueueTest, WriteAndFlush) {
+  auto mock = MockKeyValueStore::Make();
+  auto queue = WriteBackQueue::Make(tensorstore::KvStore(mock), {});
+  TENSORSTORE_EXPECT_OK(queue->Enqueue("a", absl::Cord("x"), 1).result());
+  EXPECT_THAT(queue->Find("a"), Optional(Optional(absl::Cord("x"))));
+  auto flush = queue->Flush();
+  EXPECT_FALSE(flush.ready());
+
+  auto request = mock->write_requests.pop();
+  EXPECT_EQ("a", request.key);
+  EXPECT_THAT(request.value, Optional(absl::Cord("x")));
+  Complete(std::move(request));
+  TENSORSTORE_EXPECT_OK(flush.result());
+  EXPECT_EQ(std::nullopt, queue->Find("a"));
+  EXPECT_EQ(0, queue->dirty_bytes());
+}
+
+TEST(WriteBackQueueTest, ReplacesQueuedWrite) {
+  auto mock = MockKeyValueStore::Make();
+  auto queue = WriteBackQueue::Make(tensorstore::KvStore(mock),
+                                    {/*.max_dirty_bytes=*/1024,
+                                     /*.max_concurrent_writes=*/1});
+  queue->Enqueue("a", absl::Cord("1"), 1);
+  queue->Enqueue("a", absl::Cord("2"), 2);
+  queue->Enqueue("a", absl::Cord("3"), 3);
+  // Superseded by the write of generation 3.
+  queue->Enqueue("a", absl::Cord("old"), 2);
+  EXPECT_THAT(queue->Find("a"), Optional(Optional(absl::Cord("3"))));
+  auto flush = queue->Flush();
+
+  auto first = mock->write_requests.pop();
+  EXPECT_THAT(first.value, Optional(absl::Cord("1")));
+  EXPECT_TRUE(mock->write_requests.empty());
+  Complete(std::move(first));
+  EXPECT_FALSE(flush.ready());
+
+  auto second = mock->write_requests.pop();
+  EXPECT_THAT(second.value, Optional(absl::Cord("3")));
+  Complete(std::move(second));
+  TENSORSTORE_EXPECT_OK(flush.result());
+  EXPECT_TRUE(mock->write_requests.empty());
+}
+
+TEST(WriteBackQueueTest, Delete) {
+  auto mock = MockKeyValueStore::Make();
+  auto queue = WriteBackQueue::Make(tensorstore::KvStore(mock), {});
+  queue->Enqueue("a", std::nullopt, 0);
+  EXPECT_THAT(queue->Find("a"), Optional(std::optional<absl::Cord>()));
+  auto request = mock->write_requests.pop();
+  EXPECT_EQ(std::nullopt, request.value);
+  Complete(std::move(request));
+}
+
+TEST(WriteBackQueueTest, BoundsDirtyBytes) {
+  auto mock = MockKeyValueStore::Make();
+  auto queue = WriteBackQueue::Make(tensorstore::KvStore(mock),
+                                    {/*.max_dirty_bytes=*/10,
+                                     /*.max_concurrent_writes=*/64});
+  auto a = queue->Enqueue("a", absl::Cord("12345678"), 1);
+  EXPECT_TRUE(a.ready());
+  auto b = queue->Enqueue("b", absl::Cord("12345678"), 2);
+  EXPECT_FALSE(b.ready());
+  EXPECT_EQ(18, queue->dirty_bytes());
+
+  Complete(mock->write_requests.pop());
+  TENSORSTORE_EXPECT_OK(b.result());
+  Complete(mock->write_requests.pop());
+  EXPECT_EQ(0, queue->dirty_bytes());
+}
+
+TEST(WriteBackQueueTest, FlushReportsError) {
+  auto mock = MockKeyValueStore::Make();
+  auto queue = WriteBackQueue::Make(tensorstore::KvStore(mock), {});
+  queue->Enqueue("a", absl::Cord("x"), 1);
+  auto flush = queue->Flush();
+  Complete(mock->write_requests.pop(), absl::UnavailableError("down"));
+  EXPECT_THAT(flush.result(), StatusIs(absl::StatusCode::kUnavailable));
+  TENSORSTORE_EXPECT_OK(queue->Flush().result());
+}
+
+}  // namespace
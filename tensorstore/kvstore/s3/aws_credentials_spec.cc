@@ -49,7 +49,6 @@ using Spec = ::tensorstore::internal_kvstore_s3::AwsCredentialsSpec;
 
 using ::tensorstore::internal_aws::AwsCredentialsProvider;
 using ::tensorstore::internal_aws::MakeAnonymous;
-using ::tensorstore::internal_aws::MakeCache;
 using ::tensorstore::internal_aws::MakeDefaultWithAnonymous;
 using ::tensorstore::internal_aws::MakeEcsRole;
 using ::tensorstore::internal_aws::MakeEnvironment;
@@ -148,6 +147,9 @@ absl::Status AwsCredentialsSpec::PartialBinder::operator()(
 }
 
 /// Maps the spec to an AWS credentials provider.
+///
+/// The provider does not cache credentials; callers should wrap it in an
+/// `internal_aws::AwsCredentialsCache`.
 Result<AwsCredentialsProvider> MakeAwsCredentialsProvider(const Spec& spec) {
   // Ensure that the AWS API is initialized.
   struct MakeCredentialsVisitor {
@@ -180,7 +182,7 @@ Result<AwsCredentialsProvider> MakeAwsCredentialsProvider(const Spec& spec) {
                                   aws_error_debug_str(err)));
   }
 
-  return MakeCache(std::move(credentials_provider));
+  return credentials_provider;
 }
 
 }  // namespace internal_kvstore_s3
@@ -15,14 +15,17 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include "absl/base/attributes.h"
 #include "absl/log/absl_check.h"
@@ -39,29 +42,36 @@
 #include "tensorstore/context.h"
 #include "tensorstore/internal/aws/aws_api.h"
 #include "tensorstore/internal/aws/aws_credentials.h"
+#include "tensorstore/internal/aws/aws_credentials_cache.h"
 #include "tensorstore/internal/data_copy_concurrency_resource.h"
 #include "tensorstore/internal/digest/sha256.h"
-#include "tensorstore/internal/http/default_transport.h"
 #include "tensorstore/internal/http/http_request.h"
 #include "tensorstore/internal/http/http_response.h"
 #include "tensorstore/internal/http/http_transport.h"
+#include "tensorstore/internal/http/http_transport_resource.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/json_binding/json_binding.h"
 #include "tensorstore/internal/log/verbose_flag.h"
 #include "tensorstore/internal/metrics/counter.h"
 #include "tensorstore/internal/metrics/histogram.h"
+#include "tensorstore/internal/rate_limiter/adaptive_admission_queue.h"
+#include "tensorstore/internal/rate_limiter/byte_rate_limiter.h"
 #include "tensorstore/internal/rate_limiter/rate_limiter.h"
 #include "tensorstore/internal/source_location.h"
 #include "tensorstore/internal/thread/schedule_at.h"
 #include "tensorstore/internal/uri_utils.h"
+#include "tensorstore/kvstore/adaptive_coalescing.h"
 #include "tensorstore/kvstore/batch_util.h"
 #include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/common_metrics.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/generic_coalescing_batch_util.h"
+#include "tensorstore/kvstore/hedged_read.h"
 #include "tensorstore/kvstore/http/byte_range_util.h"
+#include "tensorstore/kvstore/http/parallel_read.h"
 #include "tensorstore/kvstore/key_range.h"
 #include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/parallel_list.h"
 #include "tensorstore/kvstore/read_result.h"
 #include "tensorstore/kvstore/registry.h"
 #include "tensorstore/kvstore/s3/aws_credentials_resource.h"
@@ -74,6 +84,7 @@
 #include "tensorstore/kvstore/s3/validate.h"
 #include "tensorstore/kvstore/spec.h"
 #include "tensorstore/kvstore/url_registry.h"
+#include "tensorstore/util/division.h"
 #include "tensorstore/util/execution/any_receiver.h"
 #include "tensorstore/util/execution/execution.h"
 #include "tensorstore/util/executor.h"
@@ -81,6 +92,7 @@
 #include "tensorstore/util/garbage_collection/fwd.h"
 #include "tensorstore/util/quote_string.h"
 #include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
 #include "tensorstore/util/status.h"
 #include "tensorstore/util/str_cat.h"
 #include "tinyxml2.h"
@@ -93,6 +105,7 @@
 #include "tensorstore/serialization/std_optional.h"  // IWYU pragma: keep
 #include "tensorstore/util/garbage_collection/std_optional.h"  // IWYU pragma: keep
 
+using ::tensorstore::internal::ByteRateLimiter;
 using ::tensorstore::internal::DataCopyConcurrencyResource;
 using ::tensorstore::internal::IntrusivePtr;
 using ::tensorstore::internal::RateLimiter;
@@ -100,14 +113,16 @@ using ::tensorstore::internal::RateLimiterNode;
 using ::tensorstore::internal::ScheduleAt;
 using ::tensorstore::internal::SHA256Digester;
 using ::tensorstore::internal_aws::AwsCredentials;
+using ::tensorstore::internal_aws::AwsCredentialsCache;
 using ::tensorstore::internal_aws::AwsCredentialsProvider;
-using ::tensorstore::internal_aws::GetAwsCredentials;
 using ::tensorstore::internal_http::HttpRequest;
 using ::tensorstore::internal_http::HttpResponse;
 using ::tensorstore::internal_http::HttpTransport;
 using ::tensorstore::internal_kvstore_s3::AwsCredentialsResource;
 using ::tensorstore::internal_kvstore_s3::AwsHttpResponseToStatus;
+using ::tensorstore::internal_kvstore_s3::BuildCompleteMultipartUploadBody;
 using ::tensorstore::internal_kvstore_s3::ConditionalWriteMode;
+using ::tensorstore::internal_kvstore_s3::GetMultipartUploadId;
 using ::tensorstore::internal_kvstore_s3::GetNodeInt;
 using ::tensorstore::internal_kvstore_s3::GetNodeText;
 using ::tensorstore::internal_kvstore_s3::IsValidBucketName;
@@ -120,6 +135,8 @@ using ::tensorstore::internal_kvstore_s3::S3RateLimiterResource;
 using ::tensorstore::internal_kvstore_s3::S3RequestBuilder;
 using ::tensorstore::internal_kvstore_s3::S3RequestRetries;
 using ::tensorstore::internal_kvstore_s3::S3UriEncode;
+using ::tensorstore::internal_kvstore_s3::
+    StorageGenerationFromCompleteMultipartUpload;
 using ::tensorstore::internal_kvstore_s3::StorageGenerationFromHeaders;
 using ::tensorstore::kvstore::Key;
 using ::tensorstore::kvstore::ListEntry;
@@ -154,6 +171,13 @@ static constexpr char kEmptySha256[] =
 
 static constexpr size_t kMaxS3PutSize = size_t{5} * 1024 * 1024 * 1024;  // 5GB
 
+// Multipart upload limits.
+// https://docs.aws.amazon.com/AmazonS3/latest/userguide/qfacts.html
+static constexpr int64_t kMinS3PartSize = int64_t{5} * 1024 * 1024;  // 5MB
+static constexpr int64_t kMaxS3Parts = 10000;
+static constexpr int64_t kMaxS3ObjectSize =
+    int64_t{5} * 1024 * 1024 * 1024 * 1024;  // 5TB
+
 // Adds the generation header to the provided builder.
 bool AddGenerationHeader(S3RequestBuilder* builder, std::string_view header,
                          const StorageGeneration& gen) {
@@ -200,6 +224,36 @@ bool DefaultIsRetryableCode(absl::StatusCode code) {
          code == absl::StatusCode::kAborted;
 }
 
+/// Specifies when and how values are written with a multipart upload.
+struct S3MultipartUploadOptions {
+  constexpr static int64_t kDefaultPartSize = 64 * 1024 * 1024;
+
+  /// Values larger than this are written with a multipart upload.
+  int64_t threshold = kMaxS3PutSize;
+
+  /// Size of each part other than the last.  Increased as needed to stay
+  /// within `kMaxS3Parts`.
+  int64_t part_size = kDefaultPartSize;
+
+  constexpr static auto ApplyMembers = [](auto&& x, auto f) {
+    return f(x.threshold, x.part_size);
+  };
+
+  constexpr static auto default_json_binder = jb::Object(
+      jb::Member("threshold",
+                 jb::Projection<&S3MultipartUploadOptions::threshold>(
+                     jb::DefaultValue<jb::kNeverIncludeDefaults>(
+                         [](auto* v) { *v = kMaxS3PutSize; },
+                         jb::Integer<int64_t>(0, kMaxS3PutSize)))),
+      jb::Member("part_size",
+                 jb::Projection<&S3MultipartUploadOptions::part_size>(
+                     jb::DefaultValue<jb::kNeverIncludeDefaults>(
+                         [](auto* v) { *v = kDefaultPartSize; },
+                         jb::Integer<int64_t>(kMinS3PartSize,
+                                              kMaxS3PutSize)))) /**/
+  );
+};
+
 struct S3KeyValueStoreSpecData {
   std::string bucket;
   bool requester_pays;
@@ -213,12 +267,20 @@ struct S3KeyValueStoreSpecData {
   std::optional<Context::Resource<S3RateLimiterResource>> rate_limiter;
   Context::Resource<S3RequestRetries> retries;
   Context::Resource<DataCopyConcurrencyResource> data_copy_concurrency;
+  internal_http::ParallelReadOptions parallel_read;
+  S3MultipartUploadOptions multipart_upload;
+  internal_kvstore::HedgedReadOptions hedged_read;
+  internal_kvstore::ParallelListOptions parallel_list;
+  internal::AdaptiveConcurrencyOptions adaptive_concurrency;
+  Context::Resource<internal_http::HttpTransportResource> http_transport;
 
   constexpr static auto ApplyMembers = [](auto& x, auto f) {
     return f(x.bucket, x.requester_pays, x.endpoint, x.host_header,
              x.aws_region, x.use_conditional_write, x.aws_credentials,
              x.request_concurrency, x.rate_limiter, x.retries,
-             x.data_copy_concurrency);
+             x.data_copy_concurrency, x.parallel_read, x.multipart_upload,
+             x.hedged_read, x.parallel_list, x.adaptive_concurrency,
+             x.http_transport);
   };
 
   constexpr static auto default_json_binder = jb::Object(
@@ -257,7 +319,30 @@ struct S3KeyValueStoreSpecData {
                  jb::Projection<&S3KeyValueStoreSpecData::retries>()),
       jb::Member(DataCopyConcurrencyResource::id,
                  jb::Projection<
-                     &S3KeyValueStoreSpecData::data_copy_concurrency>()) /**/
+                     &S3KeyValueStoreSpecData::data_copy_concurrency>()),
+      jb::Member("parallel_read",
+                 jb::Projection<&S3KeyValueStoreSpecData::parallel_read>(
+                     jb::DefaultInitializedValue<
+                         jb::kNeverIncludeDefaults>())),
+      jb::Member("multipart_upload",
+                 jb::Projection<&S3KeyValueStoreSpecData::multipart_upload>(
+                     jb::DefaultInitializedValue<
+                         jb::kNeverIncludeDefaults>())),
+      jb::Member("hedged_read",
+                 jb::Projection<&S3KeyValueStoreSpecData::hedged_read>(
+                     jb::DefaultInitializedValue<
+                         jb::kNeverIncludeDefaults>())),
+      jb::Member("parallel_list",
+                 jb::Projection<&S3KeyValueStoreSpecData::parallel_list>(
+                     jb::DefaultInitializedValue<
+                         jb::kNeverIncludeDefaults>())),
+      jb::Member(
+          "adaptive_concurrency",
+          jb::Projection<&S3KeyValueStoreSpecData::adaptive_concurrency>(
+              jb::DefaultInitializedValue<jb::kNeverIncludeDefaults>())),
+      jb::Member(
+          internal_http::HttpTransportResource::id,
+          jb::Projection<&S3KeyValueStoreSpecData::http_transport>()) /**/
   );
 };
 
@@ -291,19 +376,18 @@ class S3KeyValueStore
       : transport_(std::move(transport)),
         spec_(std::move(spec)),
         host_header_(spec_.host_header.value_or(std::string())),
-        provider_(std::move(provider)) {}
+        credentials_cache_(std::move(provider)) {}
 
-  internal_kvstore_batch::CoalescingOptions GetBatchReadCoalescingOptions()
-      const {
-    internal_kvstore_batch::CoalescingOptions options;
-    options.max_extra_read_bytes = 4095;
-    options.target_coalesced_size = 128 * 1024 * 1024;
-    return options;
+  internal_kvstore_batch::AdaptiveCoalescingOptions& batch_read_coalescing() {
+    return batch_read_coalescing_;
   }
 
   Future<ReadResult> Read(Key key, ReadOptions options) override;
 
   Future<ReadResult> ReadImpl(Key&& key, ReadOptions&& options);
+  Future<ReadResult> ReadPartImpl(
+      const Key& key, ReadOptions&& options,
+      std::shared_ptr<internal_http::ReadPart> part);
 
   Future<TimestampedStorageGeneration> Write(Key key,
                                              std::optional<Value> value,
@@ -311,8 +395,16 @@ class S3KeyValueStore
 
   void ListImpl(ListOptions options, ListReceiver receiver) override;
 
+  // Lists `options.range` with a single sequence of paginated requests.  If
+  // `prefix_callback` is specified, the listing is delimited by `/`.
+  void StartList(ListOptions options, ListReceiver receiver,
+                 std::function<void(std::string)> prefix_callback);
+
   Future<const void> DeleteRange(KeyRange range) override;
 
+  // Deletes `keys` with a single DeleteObjects request.
+  Future<const void> DeleteObjects(std::vector<std::string> keys);
+
   absl::Status GetBoundSpecData(SpecData& spec) const {
     spec = spec_;
     return absl::OkStatus();
@@ -335,10 +427,27 @@ class S3KeyValueStore
     return no_rate_limiter_;
   }
 
-  RateLimiter& admission_queue() { return *spec_.request_concurrency->queue; }
+  // Bandwidth limits, or null if unlimited.
+  std::shared_ptr<ByteRateLimiter> read_bytes_limiter() {
+    if (spec_.rate_limiter.has_value()) {
+      return spec_.rate_limiter.value()->read_bytes_limiter;
+    }
+    return nullptr;
+  }
+  std::shared_ptr<ByteRateLimiter> write_bytes_limiter() {
+    if (spec_.rate_limiter.has_value()) {
+      return spec_.rate_limiter.value()->write_bytes_limiter;
+    }
+    return nullptr;
+  }
+
+  RateLimiter& admission_queue() {
+    if (adaptive_queue_) return *adaptive_queue_;
+    return *spec_.request_concurrency->queue;
+  }
 
   Future<AwsCredentials> GetCredentials() {
-    return GetAwsCredentials(provider_.get());
+    return credentials_cache_.GetCredentials();
   }
 
   // Resolves the region endpoint for the bucket.
@@ -353,6 +462,9 @@ class S3KeyValueStore
       absl::Status status, int attempt, Task* task,
       SourceLocation loc = ::tensorstore::SourceLocation::current()) {
     assert(task != nullptr);
+    if (adaptive_queue_ && internal::IsThrottled(status)) {
+      adaptive_queue_->OnThrottled();
+    }
     auto delay = spec_.retries->BackoffForAttempt(attempt);
     if (!delay) {
       return MaybeAnnotateStatus(std::move(status),
@@ -370,10 +482,20 @@ class S3KeyValueStore
   }
 
   internal::NoRateLimiter no_rate_limiter_;
+  internal_kvstore_batch::AdaptiveCoalescingOptions batch_read_coalescing_{
+      internal_kvstore_batch::CoalescingOptions{
+          /*.max_extra_read_bytes=*/4095,
+          /*.target_coalesced_size=*/128 * 1024 * 1024,
+      },
+      "s3"};
   std::shared_ptr<HttpTransport> transport_;
   S3KeyValueStoreSpecData spec_;
+  // Per-bucket concurrency limit, if `adaptive_concurrency` is enabled.
+  std::shared_ptr<internal::AdaptiveAdmissionQueue> adaptive_queue_;
+  std::shared_ptr<internal_kvstore::HedgedReadTracker> hedged_read_tracker_ =
+      std::make_shared<internal_kvstore::HedgedReadTracker>();
   std::string host_header_;
-  AwsCredentialsProvider provider_;
+  AwsCredentialsCache credentials_cache_;
 
   absl::Mutex mutex_;  // Guards resolve_ehr_ creation.
   Future<const S3EndpointRegion> resolve_ehr_;
@@ -386,6 +508,8 @@ struct ReadTask : public RateLimiterNode,
   IntrusivePtr<S3KeyValueStore> owner;
   std::string object_name;
   kvstore::ReadOptions options;
+  // Set when the read is one part of a `ParallelRead`.
+  std::shared_ptr<internal_http::ReadPart> part;
   std::string read_url_;
   AwsCredentials credentials_;
   ReadyFuture<const S3EndpointRegion> endpoint_region_;
@@ -395,13 +519,15 @@ struct ReadTask : public RateLimiterNode,
   absl::Time start_time_;
 
   ReadTask(IntrusivePtr<S3KeyValueStore> owner, std::string object_name,
-           kvstore::ReadOptions options, std::string read_url,
+           kvstore::ReadOptions options,
+           std::shared_ptr<internal_http::ReadPart> part, std::string read_url,
            AwsCredentials credentials,
            ReadyFuture<const S3EndpointRegion> endpoint_region,
            Promise<kvstore::ReadResult> promise)
       : owner(std::move(owner)),
         object_name(std::move(object_name)),
         options(std::move(options)),
+        part(std::move(part)),
         read_url_(std::move(read_url)),
         credentials_(std::move(credentials)),
         endpoint_region_(std::move(endpoint_region)),
@@ -412,6 +538,12 @@ struct ReadTask : public RateLimiterNode,
   static void Start(RateLimiterNode* task) {
     auto* self = static_cast<ReadTask*>(task);
     self->owner->read_rate_limiter().Finish(self);
+    ByteRateLimiter::MaybeAdmit(self->owner->read_bytes_limiter().get(), self,
+                                &ReadTask::StartRequest);
+  }
+
+  static void StartRequest(RateLimiterNode* task) {
+    auto* self = static_cast<ReadTask*>(task);
     self->owner->admission_queue().Admit(self, &ReadTask::Admit);
   }
 
@@ -448,11 +580,22 @@ struct ReadTask : public RateLimiterNode,
                                      ehr.aws_region, kEmptySha256, start_time_);
 
     ABSL_LOG_IF(INFO, s3_logging) << "ReadTask: " << request;
-    auto future = owner->transport_->IssueRequest(request, {});
-    future.ExecuteWhenReady([self = IntrusivePtr<ReadTask>(this)](
-                                ReadyFuture<HttpResponse> response) {
-      self->OnResponse(response.result());
-    });
+    internal_http::IssueRequestOptions request_options;
+    if (auto limiter = owner->read_bytes_limiter()) {
+      request_options.response_body_callback =
+          [limiter = std::move(limiter)](size_t n) { limiter->Charge(n); };
+    }
+    auto future =
+        owner->transport_->IssueRequest(request, std::move(request_options));
+    // The link is unregistered if the result is no longer needed, which
+    // releases `future` and allows the transport to abort the request.
+    Link(
+        [self = IntrusivePtr<ReadTask>(this)](
+            Promise<kvstore::ReadResult> promise,
+            ReadyFuture<HttpResponse> response) {
+          self->OnResponse(response.result());
+        },
+        promise, std::move(future));
   }
 
   void OnResponse(const Result<HttpResponse>& response) {
@@ -495,7 +638,7 @@ struct ReadTask : public RateLimiterNode,
   Result<kvstore::ReadResult> FinishResponse(const HttpResponse& httpresponse) {
     s3_metrics.bytes_read.IncrementBy(httpresponse.payload.size());
     auto latency = absl::Now() - start_time_;
-    s3_metrics.read_latency_ms.Observe(absl::ToInt64Milliseconds(latency));
+    s3_metrics.read_latency_ms.Observe(absl::ToDoubleMilliseconds(latency));
 
     switch (httpresponse.status_code) {
       case 204:
@@ -526,7 +669,10 @@ struct ReadTask : public RateLimiterNode,
     }
 
     absl::Cord value;
-    if (options.byte_range.size() != 0) {
+    if (part) {
+      TENSORSTORE_RETURN_IF_ERROR(internal_http::ValidateReadPartResponse(
+          httpresponse, options.byte_range, *part, value));
+    } else if (options.byte_range.size() != 0) {
       // Currently unused
       ByteRange byte_range;
       int64_t total_size;
@@ -560,20 +706,42 @@ Future<kvstore::ReadResult> S3KeyValueStore::Read(Key key,
 
 Future<kvstore::ReadResult> S3KeyValueStore::ReadImpl(Key&& key,
                                                       ReadOptions&& options) {
+  return internal_http::ParallelRead(
+      std::move(options), spec_.parallel_read,
+      [self = IntrusivePtr<S3KeyValueStore>(this), key = std::move(key)](
+          ReadOptions options, std::shared_ptr<internal_http::ReadPart> part) {
+        if (part) {
+          // The first part of a parallel read records the size of the object
+          // in `part`, and is not hedged.
+          return self->ReadPartImpl(key, std::move(options), std::move(part));
+        }
+        return internal_kvstore::HedgedRead(
+            self->spec_.hedged_read, self->hedged_read_tracker_,
+            self->executor(), [self, key, options = std::move(options)] {
+              return self->ReadPartImpl(key, ReadOptions(options), nullptr);
+            });
+      });
+}
+
+Future<kvstore::ReadResult> S3KeyValueStore::ReadPartImpl(
+    const Key& key, ReadOptions&& options,
+    std::shared_ptr<internal_http::ReadPart> part) {
   s3_metrics.batch_read.Increment();
   auto op = PromiseFuturePair<ReadResult>::Make();
 
   LinkValue(
-      [self = IntrusivePtr<S3KeyValueStore>(this), key = std::move(key),
-       options = std::move(options)](auto promise,
-                                     ReadyFuture<const S3EndpointRegion> ready,
-                                     ReadyFuture<AwsCredentials> credentials) {
+      [self = IntrusivePtr<S3KeyValueStore>(this), key,
+       options = std::move(options),
+       part = std::move(part)](auto promise,
+                               ReadyFuture<const S3EndpointRegion> ready,
+                               ReadyFuture<AwsCredentials> credentials) {
         auto read_url = tensorstore::StrCat(ready.value().endpoint, "/", key);
 
         auto state = internal::MakeIntrusivePtr<ReadTask>(
             std::move(self), std::move(key), std::move(options),
-            std::move(read_url), std::move(credentials.value()),
-            std::move(ready), std::move(promise));
+            std::move(part), std::move(read_url),
+            std::move(credentials.value()), std::move(ready),
+            std::move(promise));
         intrusive_ptr_increment(state.get());  // adopted by ReadTask::Start.
         state->owner->read_rate_limiter().Admit(state.get(), &ReadTask::Start);
       },
@@ -582,6 +750,406 @@ Future<kvstore::ReadResult> S3KeyValueStore::ReadImpl(Key&& key,
   return std::move(op.future);
 }
 
+// Adds the headers which make a PUT or CompleteMultipartUpload request
+// conditional on `if_equal`, if the endpoint supports conditional writes.
+void AddWriteConditionHeaders(const S3KeyValueStore& owner,
+                              const S3EndpointRegion& ehr,
+                              const StorageGeneration& if_equal,
+                              S3RequestBuilder& builder) {
+  if (!owner.spec_.use_conditional_write.value_or(
+          ehr.write_mode != ConditionalWriteMode::kDisabled) ||
+      StorageGeneration::IsUnknown(if_equal)) {
+    return;
+  }
+  if (StorageGeneration::IsNoValue(if_equal)) {
+    builder.AddHeader("if-none-match", "*");
+  } else {
+    AddGenerationHeader(&builder, "if-match", if_equal);
+  }
+}
+
+// MultipartUploadTask writes a value larger than the `multipart_upload`
+// threshold with a CreateMultipartUpload request, concurrent UploadPart
+// requests, and a CompleteMultipartUpload request which carries the write
+// conditions.  The upload is aborted if it does not complete.
+// https://docs.aws.amazon.com/AmazonS3/latest/userguide/mpuoverview.html
+struct MultipartUploadTask
+    : public internal::AtomicReferenceCount<MultipartUploadTask> {
+  IntrusivePtr<S3KeyValueStore> owner;
+  kvstore::WriteOptions options_;
+  ReadyFuture<const S3EndpointRegion> endpoint_region_;
+  std::string object_url_;
+  absl::Cord value_;
+  AwsCredentials credentials_;
+  Promise<TimestampedStorageGeneration> promise;
+  std::string upload_id_;
+  std::vector<std::string> part_etags_;
+  int attempt_ = 0;
+  absl::Time start_time_;
+
+  MultipartUploadTask(IntrusivePtr<S3KeyValueStore> o,
+                      kvstore::WriteOptions options,
+                      ReadyFuture<const S3EndpointRegion> endpoint_region,
+                      std::string object_url, absl::Cord value,
+                      AwsCredentials credentials,
+                      Promise<TimestampedStorageGeneration> promise)
+      : owner(std::move(o)),
+        options_(std::move(options)),
+        endpoint_region_(std::move(endpoint_region)),
+        object_url_(std::move(object_url)),
+        value_(std::move(value)),
+        credentials_(std::move(credentials)),
+        promise(std::move(promise)) {}
+
+  bool IsCancelled() { return !promise.result_needed(); }
+  void Fail(absl::Status status) {
+    ABSL_LOG_IF(INFO, s3_logging.Level(2))
+        << "MultipartUploadTask Fail " << status;
+    Abort();
+    promise.SetResult(std::move(status));
+  }
+
+  void Success(StorageGeneration g) {
+    ABSL_LOG_IF(INFO, s3_logging.Level(1))
+        << "MultipartUploadTask Success " << g;
+    promise.SetResult(std::in_place, std::move(g), start_time_);
+  }
+
+  // Issues (or retries) the CreateMultipartUpload request or, once the parts
+  // are uploaded, the CompleteMultipartUpload request.
+  void Retry() {
+    if (IsCancelled()) {
+      Abort();
+      return;
+    }
+    if (upload_id_.empty()) {
+      Create();
+    } else {
+      Complete();
+    }
+  }
+
+  void Create() {
+    start_time_ = absl::Now();
+    const auto& ehr = endpoint_region_.value();
+    auto builder = S3RequestBuilder("POST", object_url_);
+    builder.AddQueryParameter("uploads", "")
+        .AddHeader("content-type", "application/octet-stream")
+        .MaybeAddRequesterPayer(owner->spec_.requester_pays);
+    auto request =
+        builder.BuildRequest(owner->host_header_, credentials_, ehr.aws_region,
+                             kEmptySha256, start_time_);
+
+    ABSL_LOG_IF(INFO, s3_logging)
+        << "CreateMultipartUpload: " << request << " size=" << value_.size();
+
+    auto future = owner->transport_->IssueRequest(request, {});
+    future.ExecuteWhenReady([self = IntrusivePtr<MultipartUploadTask>(this)](
+                                ReadyFuture<HttpResponse> response) {
+      self->OnCreateResponse(response.result());
+    });
+  }
+
+  void OnCreateResponse(const Result<HttpResponse>& response) {
+    if (IsCancelled()) {
+      return;
+    }
+    ABSL_LOG_IF(INFO, s3_logging.Level(1) && response.ok())
+        << "CreateMultipartUpload " << *response;
+
+    bool is_retryable = DefaultIsRetryableCode(response.status().code());
+    absl::Status status = response.status();
+    if (status.ok()) {
+      status = AwsHttpResponseToStatus(response.value(), is_retryable);
+    }
+    if (!status.ok() && is_retryable) {
+      status =
+          owner->BackoffForAttemptAsync(std::move(status), attempt_++, this);
+      if (status.ok()) {
+        return;
+      }
+    }
+    if (!status.ok()) {
+      Fail(std::move(status));
+      return;
+    }
+    auto upload_id = GetMultipartUploadId(response.value().payload);
+    if (!upload_id.ok()) {
+      Fail(std::move(upload_id).status());
+      return;
+    }
+    upload_id_ = *std::move(upload_id);
+    attempt_ = 0;
+    UploadParts();
+  }
+
+  // Admits an UploadPartTask for each part of `value_`.
+  void UploadParts();
+
+  void OnPartsUploaded(tensorstore::span<const Future<std::string>> parts,
+                       const absl::Status& status) {
+    if (IsCancelled()) {
+      Abort();
+      return;
+    }
+    if (!status.ok()) {
+      Fail(status);
+      return;
+    }
+    part_etags_.reserve(parts.size());
+    for (const auto& part : parts) {
+      part_etags_.push_back(part.value());
+    }
+    Complete();
+  }
+
+  void Complete() {
+    start_time_ = absl::Now();
+    absl::Cord body(BuildCompleteMultipartUploadBody(part_etags_));
+
+    const auto& ehr = endpoint_region_.value();
+    auto builder = S3RequestBuilder("POST", object_url_);
+    builder.AddQueryParameter("uploadId", upload_id_)
+        .AddHeader("content-type", "application/xml")
+        .AddHeader("content-length", absl::StrCat(body.size()))
+        .MaybeAddRequesterPayer(owner->spec_.requester_pays);
+    AddWriteConditionHeaders(*owner, ehr,
+                             options_.generation_conditions.if_equal, builder);
+    auto request =
+        builder.BuildRequest(owner->host_header_, credentials_, ehr.aws_region,
+                             PayloadSha256Hex(body), start_time_);
+
+    ABSL_LOG_IF(INFO, s3_logging)
+        << "CompleteMultipartUpload: " << request
+        << " parts=" << part_etags_.size();
+
+    auto future = owner->transport_->IssueRequest(
+        request, internal_http::IssueRequestOptions(std::move(body)));
+    future.ExecuteWhenReady([self = IntrusivePtr<MultipartUploadTask>(this)](
+                                ReadyFuture<HttpResponse> response) {
+      self->OnCompleteResponse(response.result());
+    });
+  }
+
+  void OnCompleteResponse(const Result<HttpResponse>& response) {
+    if (IsCancelled()) {
+      Abort();
+      return;
+    }
+    ABSL_LOG_IF(INFO, s3_logging.Level(1) && response.ok())
+        << "CompleteMultipartUpload " << *response;
+
+    if (!response.ok() && DefaultIsRetryableCode(response.status().code())) {
+      if (owner->BackoffForAttemptAsync(response.status(), attempt_++, this)
+              .ok()) {
+        return;
+      }
+    }
+    if (!response.ok()) {
+      Fail(response.status());
+      return;
+    }
+
+    auto latency = absl::Now() - start_time_;
+    bool is_retryable = false;
+    auto status = AwsHttpResponseToStatus(response.value(), is_retryable);
+    if (response.value().status_code == 409) {
+      // Conflict implies that there was a conflict in the concurrent operation.
+      if (owner->BackoffForAttemptAsync(status, attempt_++, this).ok()) {
+        return;
+      }
+      Fail(std::move(status));
+    } else if (response.value().status_code == 304 ||
+               response.value().status_code == 412 ||
+               (response.value().status_code == 404 &&
+                !StorageGeneration::IsUnknown(
+                    options_.generation_conditions.if_equal))) {
+      // The generation did not match; the uploaded parts are discarded.
+      Abort();
+      Success(StorageGeneration::Unknown());
+    } else if (!status.ok()) {
+      if (is_retryable &&
+          owner->BackoffForAttemptAsync(status, attempt_++, this).ok()) {
+        return;
+      }
+      Fail(std::move(status));
+    } else {
+      auto generation = StorageGenerationFromCompleteMultipartUpload(
+          response.value(), is_retryable);
+      if (!generation.ok() && is_retryable &&
+          owner->BackoffForAttemptAsync(generation.status(), attempt_++, this)
+              .ok()) {
+        return;
+      }
+      if (!generation.ok()) {
+        Fail(std::move(generation).status());
+      } else {
+        Success(std::move(generation).value());
+      }
+    }
+    s3_metrics.write_latency_ms.Observe(absl::ToDoubleMilliseconds(latency));
+  }
+
+  // Issues an AbortMultipartUpload request, which releases the storage of any
+  // uploaded parts.  Failures are ignored; incomplete uploads may also be
+  // removed by a bucket lifecycle rule.
+  void Abort() {
+    if (upload_id_.empty()) return;
+    const auto& ehr = endpoint_region_.value();
+    auto builder = S3RequestBuilder("DELETE", object_url_);
+    builder.AddQueryParameter("uploadId", std::exchange(upload_id_, {}))
+        .MaybeAddRequesterPayer(owner->spec_.requester_pays);
+    auto request =
+        builder.BuildRequest(owner->host_header_, credentials_, ehr.aws_region,
+                             kEmptySha256, absl::Now());
+
+    ABSL_LOG_IF(INFO, s3_logging) << "AbortMultipartUpload: " << request;
+    owner->transport_->IssueRequest(request, {}).IgnoreFuture();
+  }
+};
+
+// UploadPartTask uploads one part of a MultipartUploadTask, subject to the
+// same rate limiter and admission queue as other writes.
+// https://docs.aws.amazon.com/AmazonS3/latest/API/API_UploadPart.html
+struct UploadPartTask : public RateLimiterNode,
+                        public internal::AtomicReferenceCount<UploadPartTask> {
+  IntrusivePtr<MultipartUploadTask> parent;
+  std::string upload_id_;
+  int64_t part_number_;
+  absl::Cord value_;
+  Promise<std::string> promise;
+  int attempt_ = 0;
+
+  UploadPartTask(IntrusivePtr<MultipartUploadTask> parent,
+                 int64_t part_number, absl::Cord value,
+                 Promise<std::string> promise)
+      : parent(std::move(parent)),
+        upload_id_(this->parent->upload_id_),
+        part_number_(part_number),
+        value_(std::move(value)),
+        promise(std::move(promise)) {}
+
+  ~UploadPartTask() { parent->owner->admission_queue().Finish(this); }
+
+  static void Start(RateLimiterNode* task) {
+    auto* self = static_cast<UploadPartTask*>(task);
+    self->parent->owner->write_rate_limiter().Finish(self);
+    ByteRateLimiter::MaybeAdmit(
+        self->parent->owner->write_bytes_limiter().get(), self,
+        &UploadPartTask::StartRequest);
+  }
+
+  static void StartRequest(RateLimiterNode* task) {
+    auto* self = static_cast<UploadPartTask*>(task);
+    self->parent->owner->admission_queue().Admit(self, &UploadPartTask::Admit);
+  }
+
+  static void Admit(RateLimiterNode* task) {
+    auto* self = static_cast<UploadPartTask*>(task);
+    self->parent->owner->executor()(
+        [state =
+             IntrusivePtr<UploadPartTask>(self, internal::adopt_object_ref)] {
+          state->Retry();
+        });
+  }
+
+  bool IsCancelled() {
+    return !promise.result_needed() || parent->IsCancelled();
+  }
+
+  void Retry() {
+    if (IsCancelled()) {
+      promise.SetResult(absl::CancelledError());
+      return;
+    }
+    auto& owner = *parent->owner;
+    const auto& ehr = parent->endpoint_region_.value();
+    auto builder = S3RequestBuilder("PUT", parent->object_url_);
+    builder.AddQueryParameter("partNumber", absl::StrCat(part_number_))
+        .AddQueryParameter("uploadId", upload_id_)
+        .AddHeader("content-length", absl::StrCat(value_.size()))
+        .MaybeAddRequesterPayer(owner.spec_.requester_pays);
+    auto request = builder.BuildRequest(owner.host_header_,
+                                        parent->credentials_, ehr.aws_region,
+                                        PayloadSha256Hex(value_), absl::Now());
+
+    ABSL_LOG_IF(INFO, s3_logging)
+        << "UploadPart: " << request << " size=" << value_.size();
+
+    if (auto limiter = owner.write_bytes_limiter()) {
+      limiter->Charge(value_.size());
+    }
+    auto future = owner.transport_->IssueRequest(
+        request, internal_http::IssueRequestOptions(value_));
+    future.ExecuteWhenReady([self = IntrusivePtr<UploadPartTask>(this)](
+                                ReadyFuture<HttpResponse> response) {
+      self->OnResponse(response.result());
+    });
+  }
+
+  void OnResponse(const Result<HttpResponse>& response) {
+    if (IsCancelled()) {
+      promise.SetResult(absl::CancelledError());
+      return;
+    }
+    ABSL_LOG_IF(INFO, s3_logging.Level(1) && response.ok())
+        << "UploadPart " << *response;
+
+    bool is_retryable = DefaultIsRetryableCode(response.status().code());
+    absl::Status status = response.status();
+    if (status.ok()) {
+      status = AwsHttpResponseToStatus(response.value(), is_retryable);
+    }
+    if (!status.ok() && is_retryable) {
+      status = parent->owner->BackoffForAttemptAsync(std::move(status),
+                                                     attempt_++, this);
+      if (status.ok()) {
+        return;
+      }
+    }
+    if (!status.ok()) {
+      promise.SetResult(std::move(status));
+      return;
+    }
+    auto it = response.value().headers.find("etag");
+    if (it == response.value().headers.end()) {
+      promise.SetResult(
+          absl::NotFoundError("etag not found in UploadPart response headers"));
+      return;
+    }
+    s3_metrics.bytes_written.IncrementBy(value_.size());
+    promise.SetResult(it->second);
+  }
+};
+
+void MultipartUploadTask::UploadParts() {
+  const int64_t size = value_.size();
+  const int64_t part_size = std::max(owner->spec_.multipart_upload.part_size,
+                                     CeilOfRatio(size, kMaxS3Parts));
+  std::vector<Future<std::string>> parts;
+  parts.reserve(CeilOfRatio(size, part_size));
+  for (int64_t offset = 0; offset < size; offset += part_size) {
+    auto op = PromiseFuturePair<std::string>::Make();
+    auto task = internal::MakeIntrusivePtr<UploadPartTask>(
+        IntrusivePtr<MultipartUploadTask>(this),
+        static_cast<int64_t>(parts.size() + 1),
+        value_.Subcord(offset, part_size), std::move(op.promise));
+    parts.push_back(std::move(op.future));
+
+    intrusive_ptr_increment(task.get());  // adopted by UploadPartTask::Admit.
+    owner->write_rate_limiter().Admit(task.get(), &UploadPartTask::Start);
+  }
+  // The value is retained by the parts until they are uploaded.
+  value_.Clear();
+
+  auto all_ready = WaitAllFuture(tensorstore::span(parts));
+  all_ready.ExecuteWhenReady(
+      [self = IntrusivePtr<MultipartUploadTask>(this),
+       parts = std::move(parts)](ReadyFuture<void> ready) {
+        self->OnPartsUploaded(parts, ready.status());
+      });
+}
+
 // WriteTask is a function object used to satisfy S3KeyValueStore::Write.
 // https://docs.aws.amazon.com/AmazonS3/latest/API/API_PutObject.html
 //
@@ -618,6 +1186,12 @@ struct WriteTask : public RateLimiterNode,
   static void Start(RateLimiterNode* task) {
     auto* self = static_cast<WriteTask*>(task);
     self->owner->write_rate_limiter().Finish(self);
+    ByteRateLimiter::MaybeAdmit(self->owner->write_bytes_limiter().get(), self,
+                                &WriteTask::StartRequest);
+  }
+
+  static void StartRequest(RateLimiterNode* task) {
+    auto* self = static_cast<WriteTask*>(task);
     self->owner->admission_queue().Admit(self, &WriteTask::Admit);
   }
 
@@ -705,6 +1279,17 @@ struct WriteTask : public RateLimiterNode,
   }
 
   void AfterHeadRequest() {
+    if (value_.size() >
+        static_cast<size_t>(owner->spec_.multipart_upload.threshold)) {
+      // The multipart upload admits each part separately, and the admission
+      // of this task ends when it is destroyed.
+      auto task = internal::MakeIntrusivePtr<MultipartUploadTask>(
+          owner, std::move(options_), endpoint_region_, std::move(object_url_),
+          std::move(value_), std::move(credentials_), std::move(promise));
+      task->Retry();
+      return;
+    }
+
     // NOTE: This was changed from POST to PUT as a basic POST does not work
     // Some more headers need to be added to allow POST to work:
     // https://docs.aws.amazon.com/AmazonS3/latest/API/sigv4-authentication-HTTPPOST.html
@@ -717,18 +1302,8 @@ struct WriteTask : public RateLimiterNode,
     builder.AddHeader("content-type", "application/octet-stream")
         .AddHeader("content-length", absl::StrCat(value_.size()))
         .MaybeAddRequesterPayer(owner->spec_.requester_pays);
-    if (owner->spec_.use_conditional_write.value_or(
-            ehr.write_mode != ConditionalWriteMode::kDisabled) &&
-        !StorageGeneration::IsUnknown(
-            options_.generation_conditions.if_equal)) {
-      if (StorageGeneration::IsNoValue(
-              options_.generation_conditions.if_equal)) {
-        builder.AddHeader("if-none-match", "*");
-      } else {
-        AddGenerationHeader(&builder, "if-match",
-                            options_.generation_conditions.if_equal);
-      }
-    }
+    AddWriteConditionHeaders(*owner, ehr,
+                             options_.generation_conditions.if_equal, builder);
     auto request =
         builder.BuildRequest(owner->host_header_, credentials_, ehr.aws_region,
                              content_sha256_hex, start_time_);
@@ -736,6 +1311,9 @@ struct WriteTask : public RateLimiterNode,
     ABSL_LOG_IF(INFO, s3_logging)
         << "WriteTask: " << request << " size=" << value_.size();
 
+    if (auto limiter = owner->write_bytes_limiter()) {
+      limiter->Charge(value_.size());
+    }
     auto future = owner->transport_->IssueRequest(
         request, internal_http::IssueRequestOptions(value_));
     future.ExecuteWhenReady([self = IntrusivePtr<WriteTask>(this)](
@@ -795,7 +1373,7 @@ struct WriteTask : public RateLimiterNode,
         s3_metrics.bytes_written.IncrementBy(value_.size());
       }
     }
-    s3_metrics.write_latency_ms.Observe(absl::ToInt64Milliseconds(latency));
+    s3_metrics.write_latency_ms.Observe(absl::ToDoubleMilliseconds(latency));
   }
 };
 
@@ -1001,12 +1579,10 @@ Future<TimestampedStorageGeneration> S3KeyValueStore::Write(
   if (!IsValidStorageGeneration(options.generation_conditions.if_equal)) {
     return absl::InvalidArgumentError("Malformed StorageGeneration");
   }
-  if (value && value->size() > kMaxS3PutSize) {
-    // TODO: Support multi-part uploads of files larger than 5GB.
-    // Generally, aws-cli splits uploads which exceed ~8MB into multiple
-    // parts.
-    return absl::InvalidArgumentError(absl::StrCat(
-        "Object size ", value->size(), " exceeds S3 limit of ", kMaxS3PutSize));
+  if (value && static_cast<int64_t>(value->size()) > kMaxS3ObjectSize) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Object size ", value->size(), " exceeds S3 limit of ",
+                     kMaxS3ObjectSize));
   }
 
   auto op = PromiseFuturePair<TimestampedStorageGeneration>::Make();
@@ -1048,11 +1624,19 @@ Future<TimestampedStorageGeneration> S3KeyValueStore::Write(
 }
 
 // ListTask implements the ListImpl execution flow.
+//
+// The request for each page is issued before the entries of the previous page
+// are delivered, so that fetching the next page overlaps with delivering the
+// current one.  Responses are handled one at a time under `mutex_`, which
+// preserves the order of the entries.
 struct ListTask : public RateLimiterNode,
                   public internal::AtomicReferenceCount<ListTask> {
   internal::IntrusivePtr<S3KeyValueStore> owner_;
   ListOptions options_;
   ListReceiver receiver_;
+  // If set, the listing is delimited by `/`, and common prefixes are passed
+  // to `prefix_callback_`.
+  std::function<void(std::string)> prefix_callback_;
 
   std::string resource_;
   ReadyFuture<const S3EndpointRegion> endpoint_region_;
@@ -1064,11 +1648,16 @@ struct ListTask : public RateLimiterNode,
   bool has_query_parameters_;
   std::atomic<bool> cancelled_{false};
 
+  absl::Mutex mutex_;
+  bool done_ ABSL_GUARDED_BY(mutex_) = false;
+
   ListTask(internal::IntrusivePtr<S3KeyValueStore>&& owner,
-           ListOptions&& options, ListReceiver&& receiver)
+           ListOptions&& options, ListReceiver&& receiver,
+           std::function<void(std::string)> prefix_callback)
       : owner_(std::move(owner)),
         options_(std::move(options)),
         receiver_(std::move(receiver)),
+        prefix_callback_(std::move(prefix_callback)),
         credentials_(nullptr) {
     execution::set_starting(receiver_, [this] {
       cancelled_.store(true, std::memory_order_relaxed);
@@ -1101,16 +1690,22 @@ struct ListTask : public RateLimiterNode,
 
   void IssueRequest() {
     if (is_cancelled()) {
-      execution::set_done(receiver_);
+      OnResponse(absl::CancelledError());
       return;
     }
+    SendRequest();
+  }
 
+  void SendRequest() {
     // https://docs.aws.amazon.com/AmazonS3/latest/API/API_ListObjectsV2.html
     auto request_builder =
         S3RequestBuilder("GET", resource_).AddQueryParameter("list-type", "2");
     if (auto prefix = LongestPrefix(options_.range); !prefix.empty()) {
       request_builder.AddQueryParameter("prefix", std::string(prefix));
     }
+    if (prefix_callback_) {
+      request_builder.AddQueryParameter("delimiter", "/");
+    }
     // NOTE: Consider adding a start-after query parameter, however that
     // would require a predecessor to inclusive_min key.
     if (!continuation_token_.empty()) {
@@ -1136,19 +1731,25 @@ struct ListTask : public RateLimiterNode,
   }
 
   void OnResponse(const Result<HttpResponse>& response) {
+    absl::MutexLock lock(&mutex_);
+    // A response to a request issued before the listing stopped is ignored.
+    if (done_) return;
     auto status = OnResponseImpl(response);
     // OkStatus are handled by OnResponseImpl
     if (absl::IsCancelled(status)) {
+      done_ = true;
       execution::set_done(receiver_);
       return;
     }
     if (!status.ok()) {
+      done_ = true;
       execution::set_error(receiver_, std::move(status));
       return;
     }
   }
 
-  absl::Status OnResponseImpl(const Result<HttpResponse>& response) {
+  absl::Status OnResponseImpl(const Result<HttpResponse>& response)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
     if (is_cancelled()) {
       return absl::CancelledError();
     }
@@ -1185,13 +1786,11 @@ struct ListTask : public RateLimiterNode,
 
     // TODO: Visit /ListBucketResult/KeyCount?
     // Visit /ListBucketResult/Contents
+    std::vector<ListEntry> entries;
+    bool reached_end = false;
     for (auto* contents = root->FirstChildElement("Contents");
          contents != nullptr;
          contents = contents->NextSiblingElement("Contents")) {
-      if (is_cancelled()) {
-        return absl::CancelledError();
-      }
-
       // Visit  /ListBucketResult/Contents/Key
       auto* key_node = contents->FirstChildElement("Key");
       if (key_node == nullptr) {
@@ -1205,8 +1804,8 @@ struct ListTask : public RateLimiterNode,
         // Objects are returned sorted in ascending order of the respective
         // key names, so after the current key exceeds exclusive max no
         // additional requests need to be made.
-        execution::set_done(receiver_);
-        return absl::OkStatus();
+        reached_end = true;
+        break;
       }
 
       // Visit /ListBucketResult/Contents/Size
@@ -1215,17 +1814,33 @@ struct ListTask : public RateLimiterNode,
 
       // TODO: Visit /ListBucketResult/Contents/LastModified?
       if (key.size() > options_.strip_prefix_length) {
-        execution::set_value(
-            receiver_,
+        entries.push_back(
             ListEntry{key.substr(options_.strip_prefix_length), size});
       }
     }
 
+    // Visit /ListBucketResult/CommonPrefixes/Prefix
+    std::vector<std::string> common_prefixes;
+    if (prefix_callback_) {
+      for (auto* prefixes = root->FirstChildElement("CommonPrefixes");
+           prefixes != nullptr;
+           prefixes = prefixes->NextSiblingElement("CommonPrefixes")) {
+        auto* prefix_node = prefixes->FirstChildElement("Prefix");
+        if (prefix_node == nullptr) {
+          return absl::InvalidArgumentError(
+              "Malformed List response: missing <Prefix> in <CommonPrefixes>");
+        }
+        common_prefixes.push_back(GetNodeText(prefix_node));
+      }
+    }
+
     // Successful request, so clear the retry_attempt for the next request.
     // Visit /ListBucketResult/IsTruncated
     // Visit /ListBucketResult/NextContinuationToken
     attempt_ = 0;
-    if (GetNodeText(root->FirstChildElement("IsTruncated")) == "true") {
+    bool has_next_page = false;
+    if (!reached_end &&
+        GetNodeText(root->FirstChildElement("IsTruncated")) == "true") {
       auto* next_continuation_token =
           root->FirstChildElement("NextContinuationToken");
       if (next_continuation_token == nullptr) {
@@ -1233,8 +1848,22 @@ struct ListTask : public RateLimiterNode,
             "Malformed List response: missing <NextContinuationToken>");
       }
       continuation_token_ = GetNodeText(next_continuation_token);
-      IssueRequest();
-    } else {
+      has_next_page = true;
+      // Fetch the next page while the entries of this page are delivered.
+      SendRequest();
+    }
+
+    for (auto& entry : entries) {
+      if (is_cancelled()) {
+        return absl::CancelledError();
+      }
+      execution::set_value(receiver_, std::move(entry));
+    }
+    for (auto& prefix : common_prefixes) {
+      prefix_callback_(std::move(prefix));
+    }
+    if (!has_next_page) {
+      done_ = true;
       execution::set_done(receiver_);
     }
     return absl::OkStatus();
@@ -1249,10 +1878,33 @@ void S3KeyValueStore::ListImpl(ListOptions options, ListReceiver receiver) {
     execution::set_stopping(receiver);
     return;
   }
+  if (spec_.parallel_list.enabled()) {
+    internal_kvstore::ParallelList(
+        spec_.parallel_list, std::move(options), std::move(receiver),
+        [self = IntrusivePtr<S3KeyValueStore>(this)](
+            std::string prefix,
+            std::function<void(std::string)> prefix_callback,
+            ListReceiver receiver) {
+          ListOptions options;
+          options.range = KeyRange::Prefix(std::move(prefix));
+          self->StartList(std::move(options), std::move(receiver),
+                          std::move(prefix_callback));
+        },
+        [self = IntrusivePtr<S3KeyValueStore>(this)](ListOptions options,
+                                                     ListReceiver receiver) {
+          self->StartList(std::move(options), std::move(receiver), nullptr);
+        });
+    return;
+  }
+  StartList(std::move(options), std::move(receiver), nullptr);
+}
 
+void S3KeyValueStore::StartList(
+    ListOptions options, ListReceiver receiver,
+    std::function<void(std::string)> prefix_callback) {
   auto state = internal::MakeIntrusivePtr<ListTask>(
       IntrusivePtr<S3KeyValueStore>(this), std::move(options),
-      std::move(receiver));
+      std::move(receiver), std::move(prefix_callback));
 
   MaybeResolveRegion().ExecuteWhenReady(
       [state = std::move(state)](ReadyFuture<const S3EndpointRegion> ready) {
@@ -1279,11 +1931,152 @@ void S3KeyValueStore::ListImpl(ListOptions options, ListReceiver receiver) {
       });
 }
 
+// DeleteObjectsTask deletes a batch of keys with a single DeleteObjects
+// request, subject to the same rate limiter and admission queue as other
+// writes.
+// https://docs.aws.amazon.com/AmazonS3/latest/API/API_DeleteObjects.html
+struct DeleteObjectsTask
+    : public RateLimiterNode,
+      public internal::AtomicReferenceCount<DeleteObjectsTask> {
+  IntrusivePtr<S3KeyValueStore> owner;
+  ReadyFuture<const S3EndpointRegion> endpoint_region_;
+  std::vector<std::string> keys_;
+  AwsCredentials credentials_;
+  Promise<void> promise;
+
+  int attempt_ = 0;
+
+  DeleteObjectsTask(IntrusivePtr<S3KeyValueStore> o,
+                    ReadyFuture<const S3EndpointRegion> endpoint_region,
+                    std::vector<std::string> keys, AwsCredentials credentials,
+                    Promise<void> promise)
+      : owner(std::move(o)),
+        endpoint_region_(std::move(endpoint_region)),
+        keys_(std::move(keys)),
+        credentials_(std::move(credentials)),
+        promise(std::move(promise)) {}
+
+  ~DeleteObjectsTask() { owner->admission_queue().Finish(this); }
+
+  static void Start(RateLimiterNode* task) {
+    auto* self = static_cast<DeleteObjectsTask*>(task);
+    self->owner->write_rate_limiter().Finish(self);
+    self->owner->admission_queue().Admit(self, &DeleteObjectsTask::Admit);
+  }
+
+  static void Admit(RateLimiterNode* task) {
+    auto* self = static_cast<DeleteObjectsTask*>(task);
+    self->owner->executor()([state = IntrusivePtr<DeleteObjectsTask>(
+                                 self, internal::adopt_object_ref)] {
+      state->Retry();
+    });
+  }
+
+  bool IsCancelled() { return !promise.result_needed(); }
+
+  void Retry() {
+    if (IsCancelled()) {
+      return;
+    }
+    absl::Cord body(BuildDeleteObjectsBody(keys_));
+
+    const auto& ehr = endpoint_region_.value();
+    auto builder =
+        S3RequestBuilder("POST", tensorstore::StrCat(ehr.endpoint, "/"));
+    // DeleteObjects requires an integrity check of the request body.
+    builder.AddQueryParameter("delete", "")
+        .AddHeader("content-type", "application/xml")
+        .AddHeader("content-length", absl::StrCat(body.size()))
+        .AddHeader("x-amz-checksum-sha256", PayloadSha256Base64(body))
+        .MaybeAddRequesterPayer(owner->spec_.requester_pays);
+    auto request =
+        builder.BuildRequest(owner->host_header_, credentials_, ehr.aws_region,
+                             PayloadSha256Hex(body), absl::Now());
+
+    ABSL_LOG_IF(INFO, s3_logging)
+        << "DeleteObjects: " << request << " keys=" << keys_.size();
+
+    auto future = owner->transport_->IssueRequest(
+        request, internal_http::IssueRequestOptions(std::move(body)));
+    future.ExecuteWhenReady([self = IntrusivePtr<DeleteObjectsTask>(this)](
+                                ReadyFuture<HttpResponse> response) {
+      self->OnResponse(response.result());
+    });
+  }
+
+  void OnResponse(const Result<HttpResponse>& response) {
+    if (IsCancelled()) {
+      return;
+    }
+    ABSL_LOG_IF(INFO, s3_logging.Level(1) && response.ok())
+        << "DeleteObjects " << *response;
+
+    if (!response.ok() && DefaultIsRetryableCode(response.status().code())) {
+      if (owner->BackoffForAttemptAsync(response.status(), attempt_++, this)
+              .ok()) {
+        return;
+      }
+    }
+    if (!response.ok()) {
+      promise.SetResult(response.status());
+      return;
+    }
+
+    bool is_retryable = false;
+    auto status = AwsHttpResponseToStatus(response.value(), is_retryable);
+    std::vector<std::string> retry_keys;
+    if (status.ok()) {
+      status = ParseDeleteObjectsResponse(response.value(), retry_keys,
+                                          is_retryable);
+      if (status.ok() && !retry_keys.empty()) {
+        // Only the keys that failed with a transient error are retried.
+        keys_ = std::move(retry_keys);
+        is_retryable = true;
+        status = absl::UnavailableError(
+            absl::StrCat("Failed to delete ", keys_.size(), " keys"));
+      }
+    }
+    if (!status.ok()) {
+      if (is_retryable &&
+          owner->BackoffForAttemptAsync(status, attempt_++, this).ok()) {
+        return;
+      }
+      promise.SetResult(std::move(status));
+      return;
+    }
+    promise.SetResult(absl::OkStatus());
+  }
+};
+
+Future<const void> S3KeyValueStore::DeleteObjects(
+    std::vector<std::string> keys) {
+  auto op = PromiseFuturePair<void>::Make();
+  LinkValue(
+      [self = IntrusivePtr<S3KeyValueStore>(this), keys = std::move(keys)](
+          Promise<void> promise, ReadyFuture<const S3EndpointRegion> ready,
+          ReadyFuture<AwsCredentials> credentials) mutable {
+        auto state = internal::MakeIntrusivePtr<DeleteObjectsTask>(
+            std::move(self), std::move(ready), std::move(keys),
+            std::move(credentials.value()), std::move(promise));
+        intrusive_ptr_increment(
+            state.get());  // adopted by DeleteObjectsTask::Admit.
+        state->owner->write_rate_limiter().Admit(state.get(),
+                                                 &DeleteObjectsTask::Start);
+      },
+      std::move(op.promise), MaybeResolveRegion(), GetCredentials());
+  return std::move(op.future);
+}
+
 // Receiver used by `DeleteRange` for processing the results from `List`.
+//
+// Keys are deleted in batches of up to `kMaxDeleteObjectsKeys` with a
+// DeleteObjects request, which is issued as soon as a batch is full so that
+// deletion proceeds concurrently with listing.
 struct DeleteRangeListReceiver {
   IntrusivePtr<S3KeyValueStore> owner_;
   Promise<void> promise_;
   FutureCallbackRegistration cancel_registration_;
+  std::vector<std::string> keys_;
 
   void set_starting(AnyCancelReceiver cancel) {
     cancel_registration_ = promise_.ExecuteWhenNotNeeded(std::move(cancel));
@@ -1292,7 +2085,8 @@ struct DeleteRangeListReceiver {
   void set_value(ListEntry entry) {
     assert(!entry.key.empty());
     if (!entry.key.empty()) {
-      LinkError(promise_, owner_->Delete(std::move(entry.key)));
+      keys_.push_back(std::move(entry.key));
+      if (keys_.size() == kMaxDeleteObjectsKeys) Flush();
     }
   }
 
@@ -1301,9 +2095,22 @@ struct DeleteRangeListReceiver {
     promise_ = Promise<void>();
   }
 
-  void set_done() { promise_ = Promise<void>(); }
+  void set_done() {
+    Flush();
+    promise_ = Promise<void>();
+  }
 
   void set_stopping() { cancel_registration_.Unregister(); }
+
+  void Flush() {
+    if (keys_.empty() || !promise_.result_needed()) return;
+    if (keys_.size() == 1) {
+      LinkError(promise_, owner_->Delete(std::move(keys_[0])));
+    } else {
+      LinkError(promise_, owner_->DeleteObjects(std::move(keys_)));
+    }
+    keys_.clear();
+  }
 };
 
 Future<const void> S3KeyValueStore::DeleteRange(KeyRange range) {
@@ -1340,13 +2147,15 @@ Future<const S3EndpointRegion> S3KeyValueStore::MaybeResolveRegion() {
           ? std::string_view{}
           : std::string_view(spec_.endpoint.value()),
       spec_.host_header.value_or(std::string{}), transport_);
-  resolve_ehr_.ExecuteWhenReady([](ReadyFuture<const S3EndpointRegion> ready) {
+  resolve_ehr_.ExecuteWhenReady([http_transport = spec_.http_transport](
+                                    ReadyFuture<const S3EndpointRegion> ready) {
     if (!ready.status().ok()) {
       ABSL_LOG_IF(INFO, s3_logging)
           << "S3 driver failed to resolve endpoint: " << ready.status();
     } else {
       ABSL_LOG_IF(INFO, s3_logging)
           << "S3 driver using endpoint [" << ready.value() << "]";
+      http_transport->PrewarmConnections(ready.value().endpoint);
     }
   });
 
@@ -1361,12 +2170,18 @@ Future<kvstore::DriverPtr> S3KeyValueStoreSpec::DoOpen() const {
       auto provider, MakeAwsCredentialsProvider(*data_.aws_credentials));
 
   auto driver = internal::MakeIntrusivePtr<S3KeyValueStore>(
-      internal_http::GetDefaultHttpTransport(), data_, std::move(provider));
+      data_.http_transport->GetTransport(), data_, std::move(provider));
 
   // NOTE: Remove temporary logging use of experimental feature.
   if (data_.rate_limiter.has_value()) {
     ABSL_LOG_IF(INFO, s3_logging) << "Using experimental_s3_rate_limiter";
   }
+  if (data_.adaptive_concurrency.enabled) {
+    driver->adaptive_queue_ =
+        std::make_shared<internal::AdaptiveAdmissionQueue>(
+            data_.adaptive_concurrency,
+            data_.request_concurrency->queue->limit());
+  }
 
   auto result = internal_kvstore_s3::ValidateEndpoint(
       data_.bucket, data_.aws_region, data_.endpoint.value_or(std::string{}),
@@ -1378,6 +2193,7 @@ Future<kvstore::DriverPtr> S3KeyValueStoreSpec::DoOpen() const {
   if (auto* ehr = std::get_if<S3EndpointRegion>(&result); ehr != nullptr) {
     ABSL_LOG_IF(INFO, s3_logging)
         << "S3 driver using endpoint [" << *ehr << "]";
+    data_.http_transport->PrewarmConnections(ehr->endpoint);
     driver->resolve_ehr_ = MakeReadyFuture<S3EndpointRegion>(std::move(*ehr));
   }
 
@@ -47,6 +47,7 @@ using ::tensorstore::internal::MatchesListEntry;
 using ::tensorstore::internal::MatchesTimestampedStorageGeneration;
 using ::tensorstore::internal_http::DefaultMockHttpTransport;
 using ::tensorstore::internal_http::HeaderMap;
+using ::tensorstore::internal_http::HttpRequest;
 using ::tensorstore::internal_http::HttpResponse;
 using ::tensorstore::internal_http::HttpTransport;
 using ::tensorstore::internal_http::SetDefaultHttpTransport;
@@ -346,6 +347,74 @@ TEST(S3KeyValueStoreTest, MockWrite_Conflict) {
   EXPECT_THAT(host_header_validated, testing::Ge(2));
 }
 
+TEST(S3KeyValueStoreTest, MockWrite_MultipartUpload) {
+  auto mock_transport = std::make_shared<DefaultMockHttpTransport>(
+      DefaultMockHttpTransport::Responses{
+          // initial HEAD request responds with an x-amz-bucket-region header.
+          {"HEAD https://s3.amazonaws.com/my.bucket",
+           HttpResponse{200, absl::Cord(),
+                        HeaderMap{{"x-amz-bucket-region", "us-east-1"}}}},
+
+          {"POST https://s3.us-east-1.amazonaws.com/my.bucket/"
+           "key_write?uploads",
+           HttpResponse{200,
+                        absl::Cord("<InitiateMultipartUploadResult>"
+                                   "<UploadId>UPLOAD</UploadId>"
+                                   "</InitiateMultipartUploadResult>"),
+                        {}}},
+
+          {"PUT https://s3.us-east-1.amazonaws.com/my.bucket/"
+           "key_write?partNumber=1&uploadId=UPLOAD",
+           HttpResponse{200, absl::Cord(), HeaderMap{{"etag", "\"part1\""}}}},
+
+          {"POST https://s3.us-east-1.amazonaws.com/my.bucket/"
+           "key_write?uploadId=UPLOAD",
+           HttpResponse{200,
+                        absl::Cord("<CompleteMultipartUploadResult>"
+                                   "<ETag>&quot;abc-1&quot;</ETag>"
+                                   "</CompleteMultipartUploadResult>"),
+                        {}}},
+
+          {"POST https://s3.us-east-1.amazonaws.com/my.bucket/"
+           "key_fail?uploads",
+           HttpResponse{200,
+                        absl::Cord("<InitiateMultipartUploadResult>"
+                                   "<UploadId>FAIL</UploadId>"
+                                   "</InitiateMultipartUploadResult>"),
+                        {}}},
+
+          {"PUT https://s3.us-east-1.amazonaws.com/my.bucket/"
+           "key_fail?partNumber=1&uploadId=FAIL",
+           HttpResponse{403, absl::Cord(), {}}},
+      });
+
+  DefaultHttpTransportSetter mock_transport_setter{mock_transport};
+  auto context = DefaultTestContext();
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, kvstore::Open({{"driver", "s3"},
+                                 {"bucket", "my.bucket"},
+                                 {"aws_region", "us-east-1"},
+                                 {"multipart_upload", {{"threshold", 0}}}},
+                                context)
+                      .result());
+
+  EXPECT_THAT(kvstore::Write(store, "key_write", absl::Cord("xyz")).result(),
+              MatchesTimestampedStorageGeneration(
+                  StorageGeneration::FromString("\"abc-1\"")));
+
+  EXPECT_THAT(kvstore::Write(store, "key_fail", absl::Cord("xyz")).result(),
+              StatusIs(absl::StatusCode::kPermissionDenied));
+
+  // The failed upload is aborted.
+  EXPECT_THAT(mock_transport->requests(),
+              Contains(::testing::AllOf(
+                  ::testing::Field(&HttpRequest::method, "DELETE"),
+                  ::testing::Field(&HttpRequest::url,
+                                   "https://s3.us-east-1.amazonaws.com/"
+                                   "my.bucket/key_fail?uploadId=FAIL"))));
+}
+
 // TODO: Add tests for various responses
 TEST(S3KeyValueStoreTest, SimpleMock_Endpoint) {
   // Mocks for s3
@@ -544,6 +613,77 @@ TEST(S3KeyValueStoreTest, SimpleMock_ListPrefix) {
                                                   MatchesListEntry("b/b")));
 }
 
+TEST(S3KeyValueStoreTest, SimpleMock_DeleteRange) {
+  const auto kListResult =
+      "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"                            //
+      "<ListBucketResult xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"  //
+      "<Name>bucket</Name>"                                                   //
+      "<Prefix>b</Prefix>"                                                    //
+      "<KeyCount>3</KeyCount>"                                                //
+      "<MaxKeys>1000</MaxKeys>"                                               //
+      "<IsTruncated>false</IsTruncated>"                                      //
+      "<Contents><Key>b</Key>"                                                //
+      "<LastModified>2023-09-06T17:53:28.000Z</LastModified>"                 //
+      "<ETag>&quot;d41d8cd98f00b204e9800998ecf8427e&quot;</ETag>"             //
+      "<Size>0</Size><StorageClass>STANDARD</StorageClass></Contents>"        //
+      "<Contents><Key>b/a</Key>"                                              //
+      "<LastModified>2023-09-06T17:53:28.000Z</LastModified>"                 //
+      "<ETag>&quot;d41d8cd98f00b204e9800998ecf8427e&quot;</ETag>"             //
+      "<Size>0</Size><StorageClass>STANDARD</StorageClass></Contents>"        //
+      "<Contents><Key>b/b</Key>"                                              //
+      "<LastModified>2023-09-06T17:53:28.000Z</LastModified>"                 //
+      "<ETag>&quot;d41d8cd98f00b204e9800998ecf8427e&quot;</ETag>"             //
+      "<Size>0</Size><StorageClass>STANDARD</StorageClass></Contents>"        //
+      "</ListBucketResult>";
+
+  // Mocks for s3
+  auto mock_transport = std::make_shared<DefaultMockHttpTransport>(
+      DefaultMockHttpTransport::Responses{
+          // initial HEAD request responds with an x-amz-bucket-region header.
+          {"HEAD https://my-bucket.s3.amazonaws.com",
+           HttpResponse{200, absl::Cord(),
+                        HeaderMap{{"x-amz-bucket-region", "us-east-1"}}}},
+
+          {"GET "
+           "https://my-bucket.s3.us-east-1.amazonaws.com/"
+           "?list-type=2&prefix=b",
+           HttpResponse{200, absl::Cord(kListResult), {}}},
+
+          // The first DeleteObjects request fails transiently for one key,
+          // which is then retried.
+          {"POST https://my-bucket.s3.us-east-1.amazonaws.com/?delete",
+           HttpResponse{200,
+                        absl::Cord("<DeleteResult><Error><Key>b/a</Key>"
+                                   "<Code>SlowDown</Code><Message>Slow"
+                                   "</Message></Error></DeleteResult>"),
+                        {}}},
+          {"POST https://my-bucket.s3.us-east-1.amazonaws.com/?delete",
+           HttpResponse{200, absl::Cord("<DeleteResult/>"), {}}},
+      });
+  DefaultHttpTransportSetter mock_transport_setter{mock_transport};
+
+  // Opens the s3 driver with small exponential backoff values.
+  auto context = DefaultTestContext();
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", "s3"}, {"bucket", "my-bucket"}}, context)
+          .result());
+
+  TENSORSTORE_EXPECT_OK(
+      kvstore::DeleteRange(store, ::tensorstore::KeyRange::Prefix("b"))
+          .result());
+
+  // The keys are deleted with DeleteObjects requests rather than individual
+  // DELETE requests.
+  int delete_objects_requests = 0;
+  for (const auto& request : mock_transport->requests()) {
+    EXPECT_NE("DELETE", request.method);
+    if (absl::EndsWith(request.url, "/?delete")) ++delete_objects_requests;
+  }
+  EXPECT_EQ(2, delete_objects_requests);
+}
+
 // TODO: Add tests for various responses
 TEST(S3KeyValueStoreTest, SimpleMock_RetryTimesOut) {
   absl::Cord retry(R"(<?xml version="1.0" encoding="UTF-8"?>
@@ -23,11 +23,14 @@
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include "absl/base/no_destructor.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
+#include "absl/strings/cord.h"
 #include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/time/time.h"
 #include "re2/re2.h"
@@ -36,6 +39,7 @@
 #include "tensorstore/internal/source_location.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
 #include "tensorstore/util/status.h"
 #include "tinyxml2.h"
 
@@ -157,6 +161,28 @@ bool IsRetryableAwsMessageCode(std::string_view code) {
   return kRetryableMessages->contains(code);
 }
 
+/// Escapes the characters that may not appear literally in XML text.
+std::string EscapeXmlText(std::string_view data) {
+  std::string result;
+  result.reserve(data.size());
+  for (char c : data) {
+    switch (c) {
+      case '<':
+        result += kLt;
+        break;
+      case '>':
+        result += kGt;
+        break;
+      case '&':
+        result += kAmp;
+        break;
+      default:
+        result += c;
+    }
+  }
+  return result;
+}
+
 }  // namespace
 
 std::optional<int64_t> GetNodeInt(tinyxml2::XMLNode* node) {
@@ -216,6 +242,122 @@ Result<StorageGeneration> StorageGenerationFromHeaders(
   return absl::NotFoundError("etag not found in response headers");
 }
 
+Result<std::string> GetMultipartUploadId(absl::Cord payload) {
+  auto payload_str = payload.Flatten();
+  tinyxml2::XMLDocument xmlDocument;
+  if (int xmlcode = xmlDocument.Parse(payload_str.data(), payload_str.size());
+      xmlcode != tinyxml2::XML_SUCCESS) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "Malformed CreateMultipartUpload response: %d", xmlcode));
+  }
+  auto* root = xmlDocument.FirstChildElement("InitiateMultipartUploadResult");
+  std::string upload_id =
+      root ? GetNodeText(root->FirstChildElement("UploadId")) : std::string();
+  if (upload_id.empty()) {
+    return absl::InvalidArgumentError(
+        "Malformed CreateMultipartUpload response: missing <UploadId>");
+  }
+  return upload_id;
+}
+
+std::string BuildCompleteMultipartUploadBody(
+    tensorstore::span<const std::string> part_etags) {
+  std::string body =
+      "<CompleteMultipartUpload "
+      "xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">";
+  for (ptrdiff_t i = 0; i < part_etags.size(); ++i) {
+    absl::StrAppend(&body, "<Part><ETag>", EscapeXmlText(part_etags[i]),
+                    "</ETag><PartNumber>", i + 1, "</PartNumber></Part>");
+  }
+  absl::StrAppend(&body, "</CompleteMultipartUpload>");
+  return body;
+}
+
+Result<StorageGeneration> StorageGenerationFromCompleteMultipartUpload(
+    const HttpResponse& response, bool& retryable) {
+  retryable = false;
+  auto payload = response.payload;
+  auto payload_str = payload.Flatten();
+  tinyxml2::XMLDocument xmlDocument;
+  if (!payload_str.empty() &&
+      xmlDocument.Parse(payload_str.data(), payload_str.size()) ==
+          tinyxml2::XML_SUCCESS) {
+    if (auto* error = xmlDocument.FirstChildElement("Error"); error) {
+      // "If the error occurs after the initial 200 OK response has been sent,
+      // [...] the error is embedded in the 200 OK response."
+      retryable = true;
+      std::string message = GetNodeText(error->FirstChildElement("Message"));
+      return absl::UnavailableError(absl::StrFormat(
+          "%s%s%s", GetNodeText(error->FirstChildElement("Code")),
+          message.empty() ? "" : ": ", message));
+    }
+    if (auto* root =
+            xmlDocument.FirstChildElement("CompleteMultipartUploadResult");
+        root) {
+      std::string etag = GetNodeText(root->FirstChildElement("ETag"));
+      if (!etag.empty()) return StorageGeneration::FromString(etag);
+    }
+  }
+  return StorageGenerationFromHeaders(response.headers);
+}
+
+std::string BuildDeleteObjectsBody(tensorstore::span<const std::string> keys) {
+  assert(keys.size() <= kMaxDeleteObjectsKeys);
+  std::string body =
+      "<Delete xmlns=\"http://s3.amazonaws.com/doc/2006-03-01/\">"
+      "<Quiet>true</Quiet>";
+  for (const auto& key : keys) {
+    absl::StrAppend(&body, "<Object><Key>", EscapeXmlText(key),
+                    "</Key></Object>");
+  }
+  absl::StrAppend(&body, "</Delete>");
+  return body;
+}
+
+absl::Status ParseDeleteObjectsResponse(const HttpResponse& response,
+                                        std::vector<std::string>& retry_keys,
+                                        bool& retryable) {
+  retryable = false;
+  auto payload = response.payload;
+  auto payload_str = payload.Flatten();
+  if (payload_str.empty()) return absl::OkStatus();
+  tinyxml2::XMLDocument xmlDocument;
+  if (int xmlcode = xmlDocument.Parse(payload_str.data(), payload_str.size());
+      xmlcode != tinyxml2::XML_SUCCESS) {
+    return absl::InvalidArgumentError(
+        absl::StrFormat("Malformed DeleteObjects response: %d", xmlcode));
+  }
+  if (auto* error = xmlDocument.FirstChildElement("Error"); error) {
+    retryable = true;
+    std::string message = GetNodeText(error->FirstChildElement("Message"));
+    return absl::UnavailableError(absl::StrFormat(
+        "%s%s%s", GetNodeText(error->FirstChildElement("Code")),
+        message.empty() ? "" : ": ", message));
+  }
+  auto* root = xmlDocument.FirstChildElement("DeleteResult");
+  if (!root) return absl::OkStatus();
+  for (auto* error = root->FirstChildElement("Error"); error;
+       error = error->NextSiblingElement("Error")) {
+    std::string key = GetNodeText(error->FirstChildElement("Key"));
+    std::string code = GetNodeText(error->FirstChildElement("Code"));
+    // https://docs.aws.amazon.com/AmazonS3/latest/API/ErrorResponses.html
+    if (code == "InternalError" || code == "SlowDown" ||
+        code == "ServiceUnavailable" || code == "RequestTimeout" ||
+        code == "OperationAborted") {
+      retry_keys.push_back(std::move(key));
+      continue;
+    }
+    std::string message = absl::StrFormat(
+        "Failed to delete %s: %s: %s", key, code,
+        GetNodeText(error->FirstChildElement("Message")));
+    if (code == "AccessDenied") {
+      return absl::PermissionDeniedError(std::move(message));
+    }
+    return absl::UnknownError(std::move(message));
+  }
+  return absl::OkStatus();
+}
+
 absl::Status AwsHttpResponseToStatus(const HttpResponse& response,
                                      bool& retryable, SourceLocation loc) {
   auto absl_status_code = internal_http::HttpResponseCodeToStatusCode(response);
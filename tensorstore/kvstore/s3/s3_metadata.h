@@ -24,14 +24,17 @@
 
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "absl/status/status.h"
+#include "absl/strings/cord.h"
 #include "absl/time/time.h"
 #include "tensorstore/internal/http/http_header.h"
 #include "tensorstore/internal/http/http_response.h"
 #include "tensorstore/internal/source_location.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
 
 namespace tinyxml2 {
 class XMLNode;
@@ -59,6 +62,43 @@ std::optional<absl::Time> GetNodeTimestamp(tinyxml2::XMLNode* node);
 Result<StorageGeneration> StorageGenerationFromHeaders(
     const internal_http::HeaderMap& headers);
 
+/// Returns the UploadId from the XML body of a CreateMultipartUpload response.
+/// https://docs.aws.amazon.com/AmazonS3/latest/API/API_CreateMultipartUpload.html
+Result<std::string> GetMultipartUploadId(absl::Cord payload);
+
+/// Returns the XML body of a CompleteMultipartUpload request, where
+/// `part_etags[i]` is the etag of part number `i + 1`.
+/// https://docs.aws.amazon.com/AmazonS3/latest/API/API_CompleteMultipartUpload.html
+std::string BuildCompleteMultipartUploadBody(
+    tensorstore::span<const std::string> part_etags);
+
+/// Returns the generation of the object created by a successful (200)
+/// CompleteMultipartUpload response.
+///
+/// S3 may report an error in the body of a 200 response, in which case an
+/// error is returned and `retryable` is set.
+Result<StorageGeneration> StorageGenerationFromCompleteMultipartUpload(
+    const internal_http::HttpResponse& response, bool& retryable);
+
+/// Maximum number of keys in a single DeleteObjects request.
+constexpr size_t kMaxDeleteObjectsKeys = 1000;
+
+/// Returns the XML body of a quiet DeleteObjects request for `keys`, which
+/// must contain at most `kMaxDeleteObjectsKeys` keys.
+/// https://docs.aws.amazon.com/AmazonS3/latest/API/API_DeleteObjects.html
+std::string BuildDeleteObjectsBody(tensorstore::span<const std::string> keys);
+
+/// Checks the body of a successful (200) DeleteObjects response.
+///
+/// Keys that were not deleted due to a transient error are appended to
+/// `retry_keys`.  Returns an error for the first key that was not deleted due
+/// to any other error.  S3 may also report an error for the entire request in
+/// the body of a 200 response, in which case an error is returned and
+/// `retryable` is set.
+absl::Status ParseDeleteObjectsResponse(
+    const internal_http::HttpResponse& response,
+    std::vector<std::string>& retry_keys, bool& retryable);
+
 /// Constructs an absl::Status from an Aws HttpResponse.
 absl::Status AwsHttpResponseToStatus(
     const internal_http::HttpResponse& response, bool& retryable,
@@ -14,6 +14,9 @@
 
 #include "tensorstore/kvstore/s3/s3_metadata.h"
 
+#include <string>
+#include <vector>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/status/status.h"
@@ -32,10 +35,17 @@ using ::tensorstore::StorageGeneration;
 using ::tensorstore::internal_http::HeaderMap;
 using ::tensorstore::internal_http::HttpResponse;
 using ::tensorstore::internal_kvstore_s3::AwsHttpResponseToStatus;
+using ::tensorstore::internal_kvstore_s3::BuildCompleteMultipartUploadBody;
+using ::tensorstore::internal_kvstore_s3::BuildDeleteObjectsBody;
+using ::tensorstore::internal_kvstore_s3::GetMultipartUploadId;
 using ::tensorstore::internal_kvstore_s3::GetNodeInt;
 using ::tensorstore::internal_kvstore_s3::GetNodeText;
 using ::tensorstore::internal_kvstore_s3::GetNodeTimestamp;
+using ::tensorstore::internal_kvstore_s3::ParseDeleteObjectsResponse;
+using ::tensorstore::internal_kvstore_s3::
+    StorageGenerationFromCompleteMultipartUpload;
 using ::tensorstore::internal_kvstore_s3::StorageGenerationFromHeaders;
+using ::testing::ElementsAre;
 using ::testing::Eq;
 
 // Exemplar ListObjects v2 Response
@@ -176,4 +186,119 @@ TEST(S3MetadataTest, StorageGenerationFromHeaders) {
                   "\"900150983cd24fb0d6963f7d28e17f72\"")));
 }
 
+TEST(S3MetadataTest, GetMultipartUploadId) {
+  EXPECT_THAT(
+      GetMultipartUploadId(absl::Cord(
+          R"(<?xml version="1.0" encoding="UTF-8"?>)"
+          R"(<InitiateMultipartUploadResult>)"
+          R"(<Bucket>bucket</Bucket><Key>key</Key>)"
+          R"(<UploadId>abc.123</UploadId>)"
+          R"(</InitiateMultipartUploadResult>)")),
+      ::testing::Optional(Eq("abc.123")));
+
+  EXPECT_THAT(
+      GetMultipartUploadId(absl::Cord("<InitiateMultipartUploadResult/>")),
+      StatusIs(absl::StatusCode::kInvalidArgument));
+  EXPECT_THAT(GetMultipartUploadId(absl::Cord("<")),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(S3MetadataTest, BuildCompleteMultipartUploadBody) {
+  const std::string etags[] = {"\"a\"", "\"b\""};
+  EXPECT_EQ(
+      R"(<CompleteMultipartUpload )"
+      R"(xmlns="http://s3.amazonaws.com/doc/2006-03-01/">)"
+      R"(<Part><ETag>"a"</ETag><PartNumber>1</PartNumber></Part>)"
+      R"(<Part><ETag>"b"</ETag><PartNumber>2</PartNumber></Part>)"
+      R"(</CompleteMultipartUpload>)",
+      BuildCompleteMultipartUploadBody(etags));
+}
+
+TEST(S3MetadataTest, StorageGenerationFromCompleteMultipartUpload) {
+  bool retryable = true;
+  EXPECT_THAT(
+      StorageGenerationFromCompleteMultipartUpload(
+          HttpResponse{200,
+                       absl::Cord(R"(<CompleteMultipartUploadResult>)"
+                                  R"(<ETag>&quot;abc-2&quot;</ETag>)"
+                                  R"(</CompleteMultipartUploadResult>)"),
+                       {}},
+          retryable),
+      ::testing::Optional(Eq(StorageGeneration::FromString("\"abc-2\""))));
+  EXPECT_FALSE(retryable);
+
+  // Falls back to the etag header.
+  EXPECT_THAT(StorageGenerationFromCompleteMultipartUpload(
+                  HttpResponse{200, absl::Cord(),
+                               HeaderMap{{"etag", "\"abc-2\""}}},
+                  retryable),
+              ::testing::Optional(
+                  Eq(StorageGeneration::FromString("\"abc-2\""))));
+
+  // An error reported in the body of a 200 response.
+  EXPECT_THAT(StorageGenerationFromCompleteMultipartUpload(
+                  HttpResponse{200,
+                               absl::Cord(R"(<Error><Code>InternalError</Code>)"
+                                          R"(<Message>Retry</Message></Error>)"),
+                               {}},
+                  retryable),
+              StatusIs(absl::StatusCode::kUnavailable));
+  EXPECT_TRUE(retryable);
+}
+
+TEST(S3MetadataTest, BuildDeleteObjectsBody) {
+  const std::string keys[] = {"a", "b&c"};
+  EXPECT_EQ(R"(<Delete xmlns="http://s3.amazonaws.com/doc/2006-03-01/">)"
+            R"(<Quiet>true</Quiet>)"
+            R"(<Object><Key>a</Key></Object>)"
+            R"(<Object><Key>b&amp;c</Key></Object>)"
+            R"(</Delete>)",
+            BuildDeleteObjectsBody(keys));
+}
+
+TEST(S3MetadataTest, ParseDeleteObjectsResponse) {
+  std::vector<std::string> retry_keys;
+  bool retryable = true;
+  TENSORSTORE_EXPECT_OK(ParseDeleteObjectsResponse(
+      HttpResponse{200, absl::Cord(R"(<DeleteResult/>)"), {}}, retry_keys,
+      retryable));
+  EXPECT_FALSE(retryable);
+  EXPECT_THAT(retry_keys, ::testing::IsEmpty());
+
+  // Transient errors are retried.
+  TENSORSTORE_EXPECT_OK(ParseDeleteObjectsResponse(
+      HttpResponse{200,
+                   absl::Cord(R"(<DeleteResult>)"
+                              R"(<Error><Key>a</Key><Code>SlowDown</Code>)"
+                              R"(<Message>Slow</Message></Error>)"
+                              R"(<Error><Key>b</Key><Code>InternalError</Code>)"
+                              R"(<Message>Retry</Message></Error>)"
+                              R"(</DeleteResult>)"),
+                   {}},
+      retry_keys, retryable));
+  EXPECT_THAT(retry_keys, ElementsAre("a", "b"));
+
+  EXPECT_THAT(ParseDeleteObjectsResponse(
+                  HttpResponse{200,
+                               absl::Cord(R"(<DeleteResult><Error>)"
+                                          R"(<Key>c</Key>)"
+                                          R"(<Code>AccessDenied</Code>)"
+                                          R"(<Message>Denied</Message>)"
+                                          R"(</Error></DeleteResult>)"),
+                               {}},
+                  retry_keys, retryable),
+              StatusIs(absl::StatusCode::kPermissionDenied));
+  EXPECT_FALSE(retryable);
+
+  // An error reported in the body of a 200 response.
+  EXPECT_THAT(ParseDeleteObjectsResponse(
+                  HttpResponse{200,
+                               absl::Cord(R"(<Error><Code>InternalError</Code>)"
+                                          R"(<Message>Retry</Message></Error>)"),
+                               {}},
+                  retry_keys, retryable),
+              StatusIs(absl::StatusCode::kUnavailable));
+  EXPECT_TRUE(retryable);
+}
+
 }  // namespace
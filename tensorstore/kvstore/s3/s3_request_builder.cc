@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -33,9 +34,10 @@
 #include "absl/log/absl_log.h"
 #include "absl/strings/ascii.h"
 #include "absl/strings/escaping.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
-#include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
+#include "absl/strings/str_split.h"
 #include "absl/time/time.h"
 #include <openssl/evp.h>  // IWYU pragma: keep
 #include <openssl/hmac.h>
@@ -85,66 +87,83 @@ void ComputeHmac(unsigned char (&key)[kHmacSize], std::string_view message,
 std::string CanonicalRequest(
     std::string_view method, std::string_view path, std::string_view query,
     std::string_view payload_hash,
-    const std::vector<std::pair<std::string, std::string_view>>& headers) {
+    const std::vector<std::pair<std::string, std::string_view>>& headers,
+    std::string_view signed_headers) {
   std::string canonical =
-      absl::StrCat(method, "\n", S3UriObjectKeyEncode(path), "\n", query, "\n");
+      absl::StrCat(method, "\n", S3UriObjectKeyEncode(path), "\n");
+
+  // Canonical Query String; a parameter without a value, such as the
+  // `uploads` parameter of CreateMultipartUpload, is signed as "name=".
+  absl::StrAppend(
+      &canonical,
+      absl::StrJoin(absl::StrSplit(query, '&', absl::SkipEmpty()), "&",
+                    [](std::string* out, std::string_view param) {
+                      absl::StrAppend(out, param,
+                                      absl::StrContains(param, '=') ? "" : "=");
+                    }),
+      "\n");
 
   // Canonical Headers
-  std::vector<std::string_view> signed_headers;
-  signed_headers.reserve(headers.size());
   for (auto& pair : headers) {
     absl::StrAppend(&canonical, pair.first, ":", pair.second, "\n");
-    signed_headers.push_back(pair.first);
   }
   // Signed Headers
-  absl::StrAppend(&canonical, "\n", absl::StrJoin(signed_headers, ";"), "\n",
-                  payload_hash);
+  absl::StrAppend(&canonical, "\n", signed_headers, "\n", payload_hash);
   return canonical;
 }
 
 std::string SigningString(std::string_view canonical_request,
-                          const absl::Time& time, std::string_view scope) {
-  absl::TimeZone utc = absl::UTCTimeZone();
+                          std::string_view amz_date, std::string_view scope) {
   SHA256Digester sha256;
   sha256.Write(canonical_request);
   const auto digest = sha256.Digest();
   auto digest_sv = std::string_view(reinterpret_cast<const char*>(&digest[0]),
                                     digest.size());
-  return absl::StrFormat("AWS4-HMAC-SHA256\n%s\n%s\n%s",
-                         absl::FormatTime("%Y%m%dT%H%M%SZ", time, utc), scope,
-                         absl::BytesToHexString(digest_sv));
+  return absl::StrCat("AWS4-HMAC-SHA256\n", amz_date, "\n", scope, "\n",
+                      absl::BytesToHexString(digest_sv));
 }
 
+/// Signing key most recently derived on a thread, along with the inputs from
+/// which it was derived.
+struct CachedSigningKey {
+  std::string secret_access_key;
+  std::string region;
+  std::string date;
+  unsigned char signing_key[kHmacSize];
+};
+
+/// Derives the signing key for `date`, formatted as YYYYMMDD.  Since the key
+/// only changes with the credentials, region and date, the key most recently
+/// derived on each thread is reused rather than computing four HMACs for
+/// every request.
 void GetSigningKey(std::string_view aws_secret_access_key,
-                   std::string_view aws_region, const absl::Time& time,
+                   std::string_view aws_region, std::string_view date,
                    unsigned char (&signing_key)[kHmacSize]) {
-  absl::TimeZone utc = absl::UTCTimeZone();
-  unsigned char date_key[kHmacSize];
-  unsigned char date_region_key[kHmacSize];
-  unsigned char date_region_service_key[kHmacSize];
-
-  ComputeHmac(absl::StrCat("AWS4", aws_secret_access_key),
-              absl::FormatTime("%Y%m%d", time, utc), date_key);
-  ComputeHmac(date_key, aws_region, date_region_key);
-  ComputeHmac(date_region_key, "s3", date_region_service_key);
-  ComputeHmac(date_region_service_key, "aws4_request", signing_key);
+  thread_local CachedSigningKey cached;
+  if (cached.date != date || cached.region != aws_region ||
+      cached.secret_access_key != aws_secret_access_key) {
+    unsigned char date_key[kHmacSize];
+    unsigned char date_region_key[kHmacSize];
+    unsigned char date_region_service_key[kHmacSize];
+
+    ComputeHmac(absl::StrCat("AWS4", aws_secret_access_key), date, date_key);
+    ComputeHmac(date_key, aws_region, date_region_key);
+    ComputeHmac(date_region_key, "s3", date_region_service_key);
+    ComputeHmac(date_region_service_key, "aws4_request", cached.signing_key);
+    cached.secret_access_key = std::string(aws_secret_access_key);
+    cached.region = std::string(aws_region);
+    cached.date = std::string(date);
+  }
+  std::memcpy(signing_key, cached.signing_key, kHmacSize);
 }
 
-std::string AuthorizationHeader(
-    std::string_view access_key, std::string_view scope,
-    std::string_view signature_hex,
-    const std::vector<std::pair<std::string, std::string_view>>& headers) {
-  return absl::StrFormat(
-      "AWS4-HMAC-SHA256 "
-      "Credential=%s/%s, "
-      "SignedHeaders=%s, "
-      "Signature=%s",
-      access_key, scope,
-      absl::StrJoin(headers, ";",
-                    [](std::string* out, auto pair) {
-                      absl::StrAppend(out, pair.first);
-                    }),
-      signature_hex);
+std::string AuthorizationHeader(std::string_view access_key,
+                                std::string_view scope,
+                                std::string_view signature_hex,
+                                std::string_view signed_headers) {
+  return absl::StrCat("AWS4-HMAC-SHA256 Credential=", access_key, "/", scope,
+                      ", SignedHeaders=", signed_headers,
+                      ", Signature=", signature_hex);
 }
 
 static constexpr char kAmzContentSha256Header[] = "x-amz-content-sha256";
@@ -170,8 +189,9 @@ HttpRequest S3RequestBuilder::BuildRequest(std::string_view host_header,
                                            const absl::Time& time) {
   builder_.AddHostHeader(host_header);
   builder_.AddHeader(kAmzContentSha256Header, payload_sha256_hash);
-  builder_.AddHeader("x-amz-date", absl::FormatTime("%Y%m%dT%H%M%SZ", time,
-                                                    absl::UTCTimeZone()));
+  const std::string amz_date =
+      absl::FormatTime("%Y%m%dT%H%M%SZ", time, absl::UTCTimeZone());
+  builder_.AddHeader("x-amz-date", amz_date);
 
   // Add deferred query parameters in sorted order for AWS4 signature
   // requirements
@@ -194,29 +214,31 @@ HttpRequest S3RequestBuilder::BuildRequest(std::string_view host_header,
 
   auto request = builder_.BuildRequest();
 
-  // Create sorted AWS4 signing headers
-  std::vector<std::pair<std::string, std::string_view>> signed_headers;
-  signed_headers.reserve(request.headers.size());
+  // Create sorted AWS4 signing headers, and the list of their names included
+  // in both the canonical request and the Authorization header.
+  std::vector<std::pair<std::string, std::string_view>> headers;
+  headers.reserve(request.headers.size());
+  std::string signed_headers;
   for (const auto& kv : request.headers) {
     std::string key = absl::AsciiStrToLower(kv.first);
     std::string_view value = absl::StripAsciiWhitespace(kv.second);
-    signed_headers.push_back({std::move(key), std::move(value)});
+    absl::StrAppend(&signed_headers, signed_headers.empty() ? "" : ";", key);
+    headers.push_back({std::move(key), std::move(value)});
   }
 
   auto parsed_uri = ParseGenericUri(request.url);
   assert(!parsed_uri.path.empty());
 
-  std::string scope = absl::StrFormat(
-      "%s/%s/s3/aws4_request",
-      absl::FormatTime("%Y%m%d", time, absl::UTCTimeZone()), aws_region);
+  const std::string_view date = std::string_view(amz_date).substr(0, 8);
+  std::string scope = absl::StrCat(date, "/", aws_region, "/s3/aws4_request");
 
   canonical_request_ =
       CanonicalRequest(request.method, parsed_uri.path, parsed_uri.query,
-                       payload_sha256_hash, signed_headers);
-  signing_string_ = SigningString(canonical_request_, time, scope);
+                       payload_sha256_hash, headers, signed_headers);
+  signing_string_ = SigningString(canonical_request_, amz_date, scope);
 
   unsigned char signing_key[kHmacSize];
-  GetSigningKey(credentials.GetSecretAccessKey(), aws_region, time,
+  GetSigningKey(credentials.GetSecretAccessKey(), aws_region, date,
                 signing_key);
 
   unsigned char signature[kHmacSize];
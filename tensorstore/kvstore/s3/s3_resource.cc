@@ -29,6 +29,7 @@
 #include "tensorstore/internal/env.h"
 #include "tensorstore/internal/log/verbose_flag.h"
 #include "tensorstore/internal/rate_limiter/admission_queue.h"
+#include "tensorstore/internal/rate_limiter/byte_rate_limiter.h"
 #include "tensorstore/internal/rate_limiter/rate_limiter.h"
 #include "tensorstore/internal/rate_limiter/scaling_rate_limiter.h"
 #include "tensorstore/util/result.h"
@@ -54,6 +55,7 @@ ABSL_FLAG(std::optional<absl::Duration>,
 
 using ::tensorstore::internal::AdmissionQueue;
 using ::tensorstore::internal::AnyContextResourceJsonBinder;
+using ::tensorstore::internal::ByteRateLimiter;
 using ::tensorstore::internal::ConstantRateLimiter;
 using ::tensorstore::internal::ContextResourceCreationContext;
 using ::tensorstore::internal::DoublingRateLimiter;
@@ -144,6 +146,14 @@ Result<S3RateLimiterResource::Resource> S3RateLimiterResource::Create(
   } else {
     value.write_limiter = std::make_shared<NoRateLimiter>();
   }
+  if (spec.read_bytes_per_second) {
+    value.read_bytes_limiter =
+        std::make_shared<ByteRateLimiter>(*spec.read_bytes_per_second);
+  }
+  if (spec.write_bytes_per_second) {
+    value.write_bytes_limiter =
+        std::make_shared<ByteRateLimiter>(*spec.write_bytes_per_second);
+  }
   return value;
 }
 
@@ -43,6 +43,7 @@
 #include "tensorstore/internal/metrics/metadata.h"
 #include "tensorstore/internal/mutex.h"
 #include "tensorstore/internal/source_location.h"
+#include "tensorstore/internal/tracing/operation_stats.h"
 #include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/driver.h"
 #include "tensorstore/kvstore/generation.h"
@@ -121,6 +122,11 @@ void PerformWriteback(Driver* driver, Controller controller,
   StorageGeneration orig_generation = std::move(read_result.stamp.generation);
   write_options.generation_conditions.if_equal =
       StorageGeneration::Clean(orig_generation);
+  internal_tracing::IncrementOperationStat(
+      &internal_tracing::OperationStatsState::kvstore_writes);
+  internal_tracing::IncrementOperationStat(
+      &internal_tracing::OperationStatsState::kvstore_bytes_written,
+      read_result.value.size());
   auto future = driver->Write(controller.GetKey(),
                               std::move(read_result).optional_value(),
                               std::move(write_options));
@@ -411,6 +417,37 @@ struct Controller {
   }
 };
 
+/// Wraps a `Controller` for a write admitted by
+/// `TransactionState::AdmitWrite`, and indicates when it completes.
+struct AdmittedWriteController {
+  Controller controller_;
+  size_t bytes_;
+  bool dirty_;
+  internal::TransactionState::Node& GetTransactionNode() {
+    return controller_.GetTransactionNode();
+  }
+  std::string DescribeKey(std::string_view key) {
+    return controller_.DescribeKey(key);
+  }
+  const Key& GetKey() { return controller_.GetKey(); }
+  void Success(TimestampedStorageGeneration new_stamp,
+               const StorageGeneration& orig_generation) {
+    WriteDone(/*written=*/dirty_);
+    controller_.Success(std::move(new_stamp), orig_generation);
+  }
+  void Error(absl::Status error) {
+    WriteDone(/*written=*/false);
+    controller_.Error(std::move(error));
+  }
+  void Retry(absl::Time time) {
+    WriteDone(/*written=*/false);
+    controller_.Retry(time);
+  }
+  void WriteDone(bool written) {
+    GetTransactionNode().transaction()->WriteDone(bytes_, written);
+  }
+};
+
 void ReceiveWritebackCommon(ReadModifyWriteEntry& entry,
                             ReadResult& read_result) {
   TENSORSTORE_KVSTORE_DEBUG_LOG(
@@ -1918,7 +1955,18 @@ void ReadDirectly(Driver* driver, std::string_view key,
 void WritebackDirectly(Driver* driver, ReadModifyWriteEntry& entry,
                        ReadResult&& read_result) {
   assert(read_result.stamp.time != absl::InfinitePast());
-  PerformWriteback(driver, Controller{&entry}, std::move(read_result));
+  // Encoding of other entries continues concurrently; only the writes
+  // themselves are subject to the in-flight byte limit of the transaction.
+  const bool dirty = StorageGeneration::IsDirty(read_result.stamp.generation);
+  const size_t bytes = dirty ? read_result.value.size() : 0;
+  entry.multi_phase().GetTransactionNode().transaction()->AdmitWrite(
+      bytes, [driver, &entry, bytes, dirty,
+              read_result = std::move(read_result)]() mutable {
+        PerformWriteback(driver,
+                         AdmittedWriteController{Controller{&entry}, bytes,
+                                                 dirty},
+                         std::move(read_result));
+      });
 }
 
 void WritebackDirectly(Driver* driver, DeleteRangeEntry& entry) {
@@ -82,6 +82,40 @@ TEST(KvStoreTest, WriteThenRead) {
   TENSORSTORE_ASSERT_OK(future);
 }
 
+TEST(KvStoreTest, MaxInFlightWriteBytes) {
+  auto mock_driver = MockKeyValueStore::Make();
+
+  tensorstore::TransactionOptions options;
+  options.max_in_flight_write_bytes = 10;
+  Transaction txn(tensorstore::isolated, options);
+
+  KvStore store(mock_driver, "", txn);
+
+  for (auto key : {"a", "b", "c", "d"}) {
+    TENSORSTORE_ASSERT_OK(kvstore::Write(store, key, absl::Cord("12345678")));
+  }
+
+  auto future = txn.CommitAsync();
+
+  // Each value is 8 bytes, so only one write may be in flight at a time.
+  for (size_t i = 0; i < 4; ++i) {
+    auto req = mock_driver->write_requests.pop();
+    EXPECT_TRUE(mock_driver->write_requests.empty());
+    auto progress = txn.commit_progress();
+    EXPECT_EQ(i, progress.keys_written);
+    EXPECT_EQ(i * 8, progress.bytes_written);
+    EXPECT_EQ(8, progress.bytes_in_flight);
+    req.promise.SetResult(TimestampedStorageGeneration(
+        StorageGeneration::FromString("abc"), absl::Now()));
+  }
+
+  TENSORSTORE_ASSERT_OK(future);
+  auto progress = txn.commit_progress();
+  EXPECT_EQ(4, progress.keys_written);
+  EXPECT_EQ(32, progress.bytes_written);
+  EXPECT_EQ(0, progress.bytes_in_flight);
+}
+
 TEST(KvStoreTest, ListWithUncommittedWrite) {
   auto mock_driver = MockKeyValueStore::Make();
   mock_driver->log_requests = true;
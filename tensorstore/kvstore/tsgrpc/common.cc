@@ -14,6 +14,8 @@
 
 #include "tensorstore/kvstore/tsgrpc/common.h"
 
+#include <string>
+
 #include "absl/status/status.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/tsgrpc/common.pb.h"
@@ -29,6 +31,11 @@ absl::Status GetMessageStatus(const StatusMessage& t) {
   return absl::Status(static_cast<absl::StatusCode>(t.code()), t.message());
 }
 
+void SetMessageStatus(const absl::Status& status, StatusMessage* t) {
+  t->set_code(static_cast<::google::rpc::Code>(status.code()));
+  t->set_message(std::string(status.message()));
+}
+
 void EncodeGenerationAndTimestamp(
     const tensorstore::TimestampedStorageGeneration& gen,
     GenerationAndTimestamp* generation_and_timestamp) {
@@ -53,6 +53,14 @@ absl::Status GetMessageStatus(const T& t) {
   return GetMessageStatus(t.status());
 }
 
+/// Encodes a non-ok absl::Status as a tensorstore_grpc::StatusMessage.
+void SetMessageStatus(const absl::Status& status, StatusMessage* t);
+
+template <typename T>
+void SetMessageStatus(const absl::Status& status, T* proto) {
+  SetMessageStatus(status, proto->mutable_status());
+}
+
 }  // namespace tensorstore_grpc
 
 #endif  // TENSORSTORE_KVSTORE_TSGRPC_COMMON_H_
@@ -17,9 +17,9 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <deque>
 #include <memory>
 #include <optional>
 #include <string>
@@ -39,6 +39,7 @@
 #include "grpcpp/support/server_callback.h"  // third_party
 #include "grpcpp/support/status.h"  // third_party
 #include <nlohmann/json.hpp>
+#include "tensorstore/batch.h"
 #include "tensorstore/context.h"
 #include "tensorstore/internal/grpc/server_credentials.h"
 #include "tensorstore/internal/intrusive_ptr.h"
@@ -75,8 +76,11 @@ using ::tensorstore::internal_metrics::MetricMetadata;
 using ::tensorstore::kvstore::ListEntry;
 using ::tensorstore_grpc::EncodeGenerationAndTimestamp;
 using ::tensorstore_grpc::Handler;
+using ::tensorstore_grpc::SetMessageStatus;
 using ::tensorstore_grpc::StreamClientRequestHandler;
 using ::tensorstore_grpc::StreamServerResponseHandler;
+using ::tensorstore_grpc::kvstore::BatchReadRequest;
+using ::tensorstore_grpc::kvstore::BatchReadResponse;
 using ::tensorstore_grpc::kvstore::DeleteRequest;
 using ::tensorstore_grpc::kvstore::DeleteResponse;
 using ::tensorstore_grpc::kvstore::ListRequest;
@@ -96,6 +100,10 @@ auto& read_metric = internal_metrics::Counter<int64_t>::New(
     "/tensorstore/kvstore/tsgrpc_server/read",
     MetricMetadata("KvStoreService::Read calls"));
 
+auto& batch_read_metric = internal_metrics::Counter<int64_t>::New(
+    "/tensorstore/kvstore/tsgrpc_server/batch_read",
+    MetricMetadata("KvStoreService::BatchRead calls"));
+
 auto& write_metric = internal_metrics::Counter<int64_t>::New(
     "/tensorstore/kvstore/tsgrpc_server/write",
     MetricMetadata("KvStoreService::Write calls"));
@@ -112,6 +120,27 @@ ABSL_CONST_INIT internal_log::VerboseFlag verbose_logging("tsgrpc_kvstore");
 
 constexpr size_t kMaxReadChunkSize = 1 << 20;
 
+Result<kvstore::ReadOptions> GetReadOptions(const ReadRequest& request) {
+  kvstore::ReadOptions options{};
+  options.generation_conditions.if_equal.value = request.generation_if_equal();
+  options.generation_conditions.if_not_equal.value =
+      request.generation_if_not_equal();
+
+  if (request.has_byte_range()) {
+    options.byte_range.inclusive_min = request.byte_range().inclusive_min();
+    options.byte_range.exclusive_max = request.byte_range().exclusive_max();
+    if (!options.byte_range.SatisfiesInvariants()) {
+      return absl::InvalidArgumentError("Invalid byte range");
+    }
+  }
+  if (request.has_staleness_bound()) {
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        options.staleness_bound,
+        internal::ProtoToAbslTime(request.staleness_bound()));
+  }
+  return options;
+}
+
 class ReadHandler final
     : public StreamServerResponseHandler<ReadRequest, ReadResponse> {
   using Base = StreamServerResponseHandler<ReadRequest, ReadResponse>;
@@ -124,27 +153,8 @@ class ReadHandler final
   void Run() {
     ABSL_LOG_IF(INFO, verbose_logging)
         << "ReadHandler " << ConciseDebugString(*request());
-    kvstore::ReadOptions options{};
-    options.generation_conditions.if_equal.value =
-        request()->generation_if_equal();
-    options.generation_conditions.if_not_equal.value =
-        request()->generation_if_not_equal();
-
-    if (request()->has_byte_range()) {
-      options.byte_range.inclusive_min =
-          request()->byte_range().inclusive_min();
-      options.byte_range.exclusive_max =
-          request()->byte_range().exclusive_max();
-      if (!options.byte_range.SatisfiesInvariants()) {
-        Finish(absl::InvalidArgumentError("Invalid byte range"));
-        return;
-      }
-    }
-    if (request()->has_staleness_bound()) {
-      TENSORSTORE_ASSIGN_OR_RETURN(
-          options.staleness_bound,
-          internal::ProtoToAbslTime(request()->staleness_bound()), Finish(_));
-    }
+    TENSORSTORE_ASSIGN_OR_RETURN(auto options, GetReadOptions(*request()),
+                                 Finish(_));
 
     internal::IntrusivePtr<ReadHandler> self{this};
     future_ = tensorstore::kvstore::Read(kvstore_, request()->key(), options);
@@ -167,15 +177,18 @@ class ReadHandler final
     EncodeGenerationAndTimestamp(r.stamp, &response_);
 
     value_ = std::move(r.value);
-    value_offset_ = 0;
 
     SetNextPart();
     StartWrite(&response_);
   }
 
+  // Moves the next part of the value into the response.  The `value_part`
+  // field is a `Cord`, so the part shares the chunks of `value_`.  Chunks
+  // that have been sent are released as the stream progresses, rather than
+  // when the call completes, and at most one part is in flight at a time.
   void SetNextPart() {
-    auto next_part = value_.Subcord(value_offset_, kMaxReadChunkSize);
-    value_offset_ = std::min(value_.size(), value_offset_ + next_part.size());
+    auto next_part = value_.Subcord(0, kMaxReadChunkSize);
+    value_.RemovePrefix(next_part.size());
     response_.set_value_part(std::move(next_part));
   }
 
@@ -191,11 +204,11 @@ class ReadHandler final
       Finish(::grpc::Status(::grpc::StatusCode::UNKNOWN, "Write failed"));
       return;
     }
-    if (value_offset_ == value_.size()) {
+    response_.Clear();
+    if (value_.empty()) {
       Finish(::grpc::Status::OK);
       return;
     }
-    response_.Clear();
     SetNextPart();
     StartWrite(&response_);
   }
@@ -205,8 +218,149 @@ class ReadHandler final
   Future<kvstore::ReadResult> future_;
 
   ReadResponse response_;
+  // Part of the value that remains to be sent.
   absl::Cord value_;
-  size_t value_offset_ = 0;
+};
+
+class BatchReadHandler final
+    : public StreamServerResponseHandler<BatchReadRequest, BatchReadResponse> {
+  using Base = StreamServerResponseHandler<BatchReadRequest, BatchReadResponse>;
+
+ public:
+  BatchReadHandler(CallbackServerContext* grpc_context, const Request* request,
+                   KvStore kvstore)
+      : Base(grpc_context, request), kvstore_(std::move(kvstore)) {}
+
+  void Run() {
+    ABSL_LOG_IF(INFO, verbose_logging)
+        << "BatchReadHandler " << ConciseDebugString(*request());
+    const size_t num_reads = request()->read_size();
+    std::vector<kvstore::ReadOptions> options(num_reads);
+    for (size_t i = 0; i < num_reads; ++i) {
+      TENSORSTORE_ASSIGN_OR_RETURN(options[i],
+                                   GetReadOptions(request()->read(i)),
+                                   Finish(_));
+    }
+    if (num_reads == 0) {
+      Finish(::grpc::Status::OK);
+      return;
+    }
+
+    // Issue all reads as a single batch, which is submitted when the last
+    // reference to it is released.
+    {
+      absl::MutexLock lock(&mutex_);
+      futures_.resize(num_reads);
+      Batch batch = Batch::New();
+      for (size_t i = 0; i < num_reads; ++i) {
+        options[i].batch = batch;
+        futures_[i] = tensorstore::kvstore::Read(
+            kvstore_, request()->read(i).key(), std::move(options[i]));
+      }
+    }
+
+    for (size_t i = 0; i < num_reads; ++i) {
+      Future<kvstore::ReadResult> future;
+      {
+        absl::MutexLock lock(&mutex_);
+        if (finished_) return;
+        future = futures_[i];
+      }
+      future.ExecuteWhenReady(
+          [self = internal::IntrusivePtr<BatchReadHandler>(this),
+           i](ReadyFuture<kvstore::ReadResult> ready) {
+            self->HandleResult(i, std::move(ready).result());
+          });
+    }
+  }
+
+  void HandleResult(size_t index, Result<kvstore::ReadResult> result) {
+    absl::MutexLock lock(&mutex_);
+    if (finished_) return;
+    completed_.push_back(PendingRead{static_cast<uint32_t>(index),
+                                     std::move(result)});
+    MaybeWrite();
+  }
+
+  void OnCancel() final {
+    absl::MutexLock lock(&mutex_);
+    if (finished_) return;
+    finished_ = true;
+    futures_.clear();
+    Finish(::grpc::Status(::grpc::StatusCode::CANCELLED, ""));
+  }
+
+  void OnWriteDone(bool ok) final {
+    absl::MutexLock lock(&mutex_);
+    write_in_flight_ = false;
+    if (finished_) return;
+    if (!ok) {
+      finished_ = true;
+      futures_.clear();
+      Finish(::grpc::Status(::grpc::StatusCode::UNKNOWN, "Write failed"));
+      return;
+    }
+    MaybeWrite();
+  }
+
+ private:
+  struct PendingRead {
+    uint32_t index;
+    // The value of a successful read holds the part that remains to be sent.
+    Result<kvstore::ReadResult> result;
+    bool started = false;
+  };
+
+  /// Starts writing the next part of the earliest completed read, if no write
+  /// is in flight.  Finishes the call once all reads have been written.
+  void MaybeWrite() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    if (write_in_flight_ || finished_) return;
+    if (completed_.empty()) {
+      if (num_written_ == futures_.size()) {
+        finished_ = true;
+        futures_.clear();
+        Finish(::grpc::Status::OK);
+      }
+      return;
+    }
+
+    auto& pending = completed_.front();
+    response_.Clear();
+    response_.set_index(pending.index);
+    auto* response = response_.mutable_response();
+    bool last = true;
+    if (!pending.result.ok()) {
+      SetMessageStatus(pending.result.status(), response);
+    } else {
+      auto& r = *pending.result;
+      if (!pending.started) {
+        response->set_state(static_cast<ReadResponse::State>(r.state));
+        EncodeGenerationAndTimestamp(r.stamp, response);
+      }
+      auto next_part = r.value.Subcord(0, kMaxReadChunkSize);
+      r.value.RemovePrefix(next_part.size());
+      response->set_value_part(std::move(next_part));
+      last = r.value.empty();
+    }
+    pending.started = true;
+    response_.set_last(last);
+    if (last) {
+      completed_.pop_front();
+      ++num_written_;
+    }
+    write_in_flight_ = true;
+    StartWrite(&response_);
+  }
+
+  KvStore kvstore_;
+
+  absl::Mutex mutex_;
+  std::vector<Future<kvstore::ReadResult>> futures_ ABSL_GUARDED_BY(mutex_);
+  std::deque<PendingRead> completed_ ABSL_GUARDED_BY(mutex_);
+  size_t num_written_ ABSL_GUARDED_BY(mutex_) = 0;
+  bool write_in_flight_ ABSL_GUARDED_BY(mutex_) = false;
+  bool finished_ ABSL_GUARDED_BY(mutex_) = false;
+  BatchReadResponse response_;
 };
 
 class WriteHandler final
@@ -527,6 +681,19 @@ class KvStoreServer::Impl final : public KvStoreService::CallbackService {
     return handler.get();
   }
 
+  ::grpc::ServerWriteReactor<::tensorstore_grpc::kvstore::BatchReadResponse>*
+  BatchRead(::grpc::CallbackServerContext* context,
+            const BatchReadRequest* request) override {
+    batch_read_metric.Increment();
+    internal::IntrusivePtr<BatchReadHandler> handler(
+        new BatchReadHandler(context, request, kvstore_));
+    assert(handler->use_count() == 2);
+    handler->Run();
+    assert(handler->use_count() > 0);
+    if (handler->use_count() == 1) return nullptr;
+    return handler.get();
+  }
+
   ::grpc::ServerReadReactor<::tensorstore_grpc::kvstore::WriteRequest>* Write(
       ::grpc::CallbackServerContext* context,
       WriteResponse* response) override {
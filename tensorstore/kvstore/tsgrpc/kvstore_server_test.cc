@@ -20,13 +20,16 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/status/status.h"
 #include "absl/strings/cord.h"
 #include "absl/strings/str_format.h"
 #include "absl/synchronization/notification.h"
 #include "absl/time/clock.h"
 #include <nlohmann/json.hpp>
+#include "tensorstore/batch.h"
 #include "tensorstore/context.h"
 #include "tensorstore/internal/global_initializer.h"
+#include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/key_range.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/kvstore/operations.h"
@@ -44,9 +47,11 @@ namespace {
 
 namespace kvstore = ::tensorstore::kvstore;
 using ::tensorstore::KeyRange;
+using ::tensorstore::MatchesStatus;
 using ::tensorstore::grpc_kvstore::KvStoreServer;
 using ::tensorstore::internal::IsRegularStorageGeneration;
 using ::tensorstore::internal::KeyValueStoreOpsTestParameters;
+using ::tensorstore::internal::MatchesKvsReadResult;
 using ::tensorstore::internal::MatchesKvsReadResultNotFound;
 using ::tensorstore::internal::MatchesTimestampedStorageGeneration;
 
@@ -258,4 +263,40 @@ TEST_F(KvStoreTest, MultiPartReadWrite) {
                                 generation.generation, testing::Ge(now)));
 }
 
+TEST_F(KvStoreTest, BatchRead) {
+  absl::Cord large_value(std::string(3 << 20, 'x'));
+
+  auto context = tensorstore::Context::Default();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store, tensorstore::kvstore::Open({{"driver", "tsgrpc_kvstore"},
+                                              {"address", address()},
+                                              {"path", "batch_read/"}},
+                                             context)
+                      .result());
+
+  TENSORSTORE_EXPECT_OK(kvstore::Write(store, "a", absl::Cord("abcdef")));
+  TENSORSTORE_EXPECT_OK(kvstore::Write(store, "large", large_value));
+
+  // The value of "large" is returned in multiple parts.
+  auto batch = tensorstore::Batch::New();
+  kvstore::ReadOptions options;
+  options.batch = batch;
+  auto a = kvstore::Read(store, "a", options);
+  auto large = kvstore::Read(store, "large", options);
+  auto missing = kvstore::Read(store, "missing", options);
+  options.byte_range = tensorstore::OptionalByteRangeRequest(1, 3);
+  auto a_range = kvstore::Read(store, "a", options);
+  options.byte_range = tensorstore::OptionalByteRangeRequest(10, 20);
+  auto invalid_range = kvstore::Read(store, "a", options);
+  options.batch = tensorstore::no_batch;
+  batch.Release();
+
+  EXPECT_THAT(a.result(), MatchesKvsReadResult(absl::Cord("abcdef")));
+  EXPECT_THAT(large.result(), MatchesKvsReadResult(large_value));
+  EXPECT_THAT(missing.result(), MatchesKvsReadResultNotFound());
+  EXPECT_THAT(a_range.result(), MatchesKvsReadResult(absl::Cord("bc")));
+  EXPECT_THAT(invalid_range.result(),
+              MatchesStatus(absl::StatusCode::kOutOfRange));
+}
+
 }  // namespace
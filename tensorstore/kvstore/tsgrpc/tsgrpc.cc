@@ -24,6 +24,7 @@
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/base/attributes.h"
 #include "absl/log/absl_log.h"
@@ -37,6 +38,7 @@
 #include "grpcpp/support/client_callback.h"  // third_party
 #include "grpcpp/support/status.h"  // third_party
 #include "grpcpp/support/sync_stream.h"  // third_party
+#include "tensorstore/batch.h"
 #include "tensorstore/context.h"
 #include "tensorstore/internal/concurrency_resource.h"
 #include "tensorstore/internal/context_binding.h"
@@ -50,6 +52,7 @@
 #include "tensorstore/internal/json_binding/json_binding.h"
 #include "tensorstore/internal/log/verbose_flag.h"
 #include "tensorstore/internal/metrics/counter.h"
+#include "tensorstore/kvstore/batch_util.h"
 #include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/common_metrics.h"
 #include "tensorstore/kvstore/driver.h"
@@ -68,6 +71,7 @@
 #include "tensorstore/util/garbage_collection/fwd.h"
 #include "tensorstore/util/result.h"
 #include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
 
 // specializations
 #include "tensorstore/internal/cache_key/absl_time.h"  // IWYU pragma: keep
@@ -89,6 +93,8 @@ using ::tensorstore::kvstore::ListEntry;
 using ::tensorstore::kvstore::ListReceiver;
 using ::tensorstore_grpc::DecodeGenerationAndTimestamp;
 using ::tensorstore_grpc::GetMessageStatus;
+using ::tensorstore_grpc::kvstore::BatchReadRequest;
+using ::tensorstore_grpc::kvstore::BatchReadResponse;
 using ::tensorstore_grpc::kvstore::DeleteRequest;
 using ::tensorstore_grpc::kvstore::DeleteResponse;
 using ::tensorstore_grpc::kvstore::ListRequest;
@@ -298,6 +304,181 @@ struct ReadTask : public internal::AtomicReferenceCount<ReadTask>,
   }
 };
 
+void EncodeReadRequest(std::string key,
+                       const kvstore::ReadGenerationConditions& conditions,
+                       OptionalByteRangeRequest byte_range,
+                       absl::Time staleness_bound, ReadRequest& request) {
+  request.set_key(std::move(key));
+  request.set_generation_if_equal(conditions.if_equal.value);
+  request.set_generation_if_not_equal(conditions.if_not_equal.value);
+  if (!byte_range.IsFull()) {
+    request.mutable_byte_range()->set_inclusive_min(byte_range.inclusive_min);
+    request.mutable_byte_range()->set_exclusive_max(byte_range.exclusive_max);
+  }
+  if (staleness_bound != absl::InfiniteFuture()) {
+    AbslTimeToProto(staleness_bound, request.mutable_staleness_bound());
+  }
+}
+
+// Implements TsGrpcKeyValueStore::Read for reads that specify a batch.
+//
+// All reads of the batch are sent as a single BatchRead call, so that the
+// server may coalesce them.  Each read is resolved as soon as its response
+// has been received.
+class BatchReadTask;
+using BatchReadTaskBase = internal_kvstore_batch::BatchReadEntry<
+    TsGrpcKeyValueStore,
+    internal_kvstore_batch::ReadRequest<kvstore::Key,
+                                        kvstore::ReadGenerationConditions>>;
+
+class BatchReadTask final
+    : public BatchReadTaskBase,
+      public internal::AtomicReferenceCount<BatchReadTask>,
+      public grpc::ClientReadReactor<BatchReadResponse> {
+ public:
+  BatchReadTask(BatchEntryKey&& batch_entry_key_)
+      : BatchReadTaskBase(std::move(batch_entry_key_)),
+        // Create initial reference count that will be transferred to `Submit`.
+        internal::AtomicReferenceCount<BatchReadTask>(/*initial_ref_count=*/1) {
+  }
+
+  void Submit(Batch::View batch) final {
+    if (request_batch.requests.empty()) return;
+    internal::IntrusivePtr<BatchReadTask> self(
+        // Acquire initial reference count.
+        this, internal::adopt_object_ref);
+    tsgrpc_metrics.batch_read.Increment();
+
+    auto& requests = request_batch.requests;
+    for (auto& request : requests) {
+      EncodeReadRequest(
+          std::get<kvstore::Key>(request),
+          std::get<kvstore::ReadGenerationConditions>(request),
+          std::get<internal_kvstore_batch::ByteRangeReadRequest>(request)
+              .byte_range,
+          request_batch.staleness_bound, *request_.add_read());
+    }
+    results_.resize(requests.size());
+    num_needed_ = requests.size();
+
+    context_ = std::make_shared<grpc::ClientContext>();
+    MaybeSetDeadline(*context_, driver().spec_.timeout);
+    auto context_future = driver().auth_strategy_->ConfigureContext(context_);
+
+    context_future.ExecuteWhenReady(
+        [self = std::move(self)](
+            ReadyFuture<std::shared_ptr<grpc::ClientContext>> f) {
+          self->StartImpl();
+        });
+  }
+
+  void TryCancel() { context_->TryCancel(); }
+
+  void StartImpl() {
+    // The call is cancelled once no read needs its result.
+    for (auto& request : request_batch.requests) {
+      std::get<internal_kvstore_batch::ByteRangeReadRequest>(request)
+          .promise.ExecuteWhenNotNeeded(
+              [self = internal::IntrusivePtr<BatchReadTask>(this)] {
+                if (--self->num_needed_ == 0) self->TryCancel();
+              });
+    }
+
+    intrusive_ptr_increment(this);  // adopted in OnDone.
+    driver().stub()->async()->BatchRead(context_.get(), &request_, this);
+
+    StartRead(&response_);
+    StartCall();
+  }
+
+  void OnReadDone(bool ok) override {
+    if (!ok) return;
+    if (auto status = HandleResponse(); !status.ok()) {
+      status_ = std::move(status);
+      TryCancel();
+      return;
+    }
+    StartRead(&response_);
+  }
+
+  absl::Status HandleResponse() {
+    const size_t index = response_.index();
+    if (index >= results_.size() || results_[index].done) {
+      return absl::DataLossError(
+          tensorstore::StrCat("Unexpected BatchRead response index ", index));
+    }
+    auto& partial = results_[index];
+    const auto& response = response_.response();
+    if (!partial.started) {
+      partial.started = true;
+      if (auto status = GetMessageStatus(response); !status.ok()) {
+        partial.done = true;
+        SetResult(index, std::move(status));
+        return absl::OkStatus();
+      }
+      TENSORSTORE_ASSIGN_OR_RETURN(partial.result.stamp,
+                                   DecodeGenerationAndTimestamp(response));
+      partial.result.state =
+          static_cast<kvstore::ReadResult::State>(response.state());
+    }
+    partial.result.value.Append(response.value_part());
+    if (response_.last()) {
+      partial.done = true;
+      SetResult(index, std::move(partial.result));
+    }
+    return absl::OkStatus();
+  }
+
+  void SetResult(size_t index, Result<kvstore::ReadResult> result) {
+    driver().executor()(
+        [promise = std::get<internal_kvstore_batch::ByteRangeReadRequest>(
+                       request_batch.requests[index])
+                       .promise,
+         result = std::move(result)]() mutable {
+          promise.SetResult(std::move(result));
+        });
+  }
+
+  void OnDone(const grpc::Status& s) override {
+    internal::IntrusivePtr<BatchReadTask> self(this,
+                                               internal::adopt_object_ref);
+    driver().executor()([self = std::move(self), status = s]() {
+      self->ReadFinished(GrpcStatusToAbslStatus(status));
+    });
+  }
+
+  void ReadFinished(absl::Status status) {
+    ABSL_LOG_IF(INFO, verbose_logging)
+        << "BatchReadTask::ReadFinished " << status;
+    if (!status_.ok()) {
+      status = status_;
+    } else if (status.ok()) {
+      status = absl::DataLossError("Missing BatchRead response");
+    }
+    for (size_t i = 0; i < results_.size(); ++i) {
+      if (results_[i].done) continue;
+      std::get<internal_kvstore_batch::ByteRangeReadRequest>(
+          request_batch.requests[i])
+          .promise.SetResult(status);
+    }
+  }
+
+ private:
+  struct PartialResult {
+    kvstore::ReadResult result;
+    bool started = false;
+    bool done = false;
+  };
+
+  // working state.
+  std::shared_ptr<grpc::ClientContext> context_;
+  BatchReadRequest request_;
+  BatchReadResponse response_;
+  std::vector<PartialResult> results_;
+  absl::Status status_;
+  std::atomic<size_t> num_needed_{0};
+};
+
 /// Key value store operations.
 Future<kvstore::ReadResult> TsGrpcKeyValueStore::Read(Key key,
                                                       ReadOptions options) {
@@ -305,22 +486,20 @@ Future<kvstore::ReadResult> TsGrpcKeyValueStore::Read(Key key,
 
   auto pair = PromiseFuturePair<kvstore::ReadResult>::Make();
 
+  if (options.batch) {
+    BatchReadTask::MakeRequest<BatchReadTask>(
+        *this, options.batch, options.staleness_bound,
+        BatchReadTask::Request{{std::move(pair.promise), options.byte_range},
+                               std::move(key),
+                               std::move(options.generation_conditions)});
+    return std::move(pair.future);
+  }
+
   auto task =
       internal::MakeIntrusivePtr<ReadTask>(executor(), std::move(pair.promise));
-  auto& request = task->request_;
-  request.set_key(std::move(key));
-  request.set_generation_if_equal(options.generation_conditions.if_equal.value);
-  request.set_generation_if_not_equal(
-      options.generation_conditions.if_not_equal.value);
-  if (!options.byte_range.IsFull()) {
-    request.mutable_byte_range()->set_inclusive_min(
-        options.byte_range.inclusive_min);
-    request.mutable_byte_range()->set_exclusive_max(
-        options.byte_range.exclusive_max);
-  }
-  if (options.staleness_bound != absl::InfiniteFuture()) {
-    AbslTimeToProto(options.staleness_bound, request.mutable_staleness_bound());
-  }
+  EncodeReadRequest(std::move(key), options.generation_conditions,
+                    options.byte_range, options.staleness_bound,
+                    task->request_);
 
   task->Start(*auth_strategy_, spec_.timeout, stub_.get());
   return std::move(pair.future);
@@ -20,12 +20,14 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/status/status.h"
 #include "absl/strings/cord.h"
 #include "absl/synchronization/notification.h"
 #include "absl/time/time.h"
 #include "grpcpp/grpcpp.h"  // third_party
 #include "grpcpp/support/status.h"  // third_party
 #include "grpcpp/support/sync_stream.h"  // third_party
+#include "tensorstore/batch.h"
 #include "tensorstore/internal/grpc/grpc_mock.h"
 #include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/generation.h"
@@ -59,6 +61,8 @@ using ::testing::Return;
 using ::testing::SetArgPointee;
 
 using ::tensorstore_grpc::MockKvStoreService;
+using ::tensorstore_grpc::kvstore::BatchReadRequest;
+using ::tensorstore_grpc::kvstore::BatchReadResponse;
 using ::tensorstore_grpc::kvstore::DeleteRequest;
 using ::tensorstore_grpc::kvstore::DeleteResponse;
 using ::tensorstore_grpc::kvstore::ListRequest;
@@ -74,6 +78,8 @@ class TsGrpcMockTest : public testing::Test {
   TsGrpcMockTest() {
     /// Unmatched calls all return CANCELLED.
     ON_CALL(mock(), Read).WillByDefault(Return(grpc::Status::CANCELLED));
+    ON_CALL(mock(), BatchRead)
+        .WillByDefault(Return(grpc::Status::CANCELLED));
     ON_CALL(mock(), Write).WillByDefault(Return(grpc::Status::CANCELLED));
     ON_CALL(mock(), Delete).WillByDefault(Return(grpc::Status::CANCELLED));
     ON_CALL(mock(), List).WillByDefault(Return(grpc::Status::CANCELLED));
@@ -204,6 +210,91 @@ TEST_F(TsGrpcMockTest, ReadMultipart) {
   EXPECT_EQ(result.stamp.generation, StorageGeneration::FromString("1"));
 }
 
+TEST_F(TsGrpcMockTest, BatchRead) {
+  BatchReadRequest expected_request = ParseTextProtoOrDie(R"pb(
+    read { key: 'abc' }
+    read {
+      key: 'def'
+      byte_range { inclusive_min: 1 exclusive_max: 3 }
+    }
+  )pb");
+
+  // Responses are returned in completion order, with the value of 'abc'
+  // split across two messages.
+  std::vector<BatchReadResponse> responses{
+      ParseTextProtoOrDie(R"pb(
+        index: 1
+        response {
+          state: 2
+          value_part: 'ef'
+          generation_and_timestamp {
+            generation: '\x002'
+            timestamp { seconds: 1634327736 }
+          }
+        }
+        last: true
+      )pb"),
+      ParseTextProtoOrDie(R"pb(
+        index: 0
+        response {
+          state: 2
+          value_part: '12'
+          generation_and_timestamp {
+            generation: '\x001'
+            timestamp { seconds: 1634327736 }
+          }
+        }
+      )pb"),
+      ParseTextProtoOrDie(R"pb(
+        index: 0
+        response { value_part: '34' }
+        last: true
+      )pb"),
+  };
+
+  EXPECT_CALL(mock(), BatchRead(_, EqualsProto(expected_request), _))
+      .WillOnce(testing::Invoke(
+          [=](auto*, auto*,
+              grpc::ServerWriter<BatchReadResponse>* resp) -> ::grpc::Status {
+            for (const auto& response : responses) {
+              resp->Write(response);
+            }
+            return grpc::Status::OK;
+          }));
+
+  auto store = OpenStore();
+  auto batch = tensorstore::Batch::New();
+  kvstore::ReadOptions options;
+  options.batch = batch;
+  auto future0 = kvstore::Read(store, "abc", options);
+  options.byte_range = OptionalByteRangeRequest{1, 3};
+  auto future1 = kvstore::Read(store, "def", options);
+  options.batch = tensorstore::no_batch;
+  batch.Release();
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto result0, future0.result());
+  EXPECT_EQ(result0.value, "1234");
+  EXPECT_EQ(result0.stamp.generation, StorageGeneration::FromString("1"));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto result1, future1.result());
+  EXPECT_EQ(result1.value, "ef");
+  EXPECT_EQ(result1.stamp.generation, StorageGeneration::FromString("2"));
+}
+
+TEST_F(TsGrpcMockTest, BatchReadMissingResponse) {
+  EXPECT_CALL(mock(), BatchRead(_, _, _)).WillOnce(Return(grpc::Status::OK));
+
+  auto store = OpenStore();
+  auto batch = tensorstore::Batch::New();
+  kvstore::ReadOptions options;
+  options.batch = batch;
+  auto future = kvstore::Read(store, "abc", options);
+  options.batch = tensorstore::no_batch;
+  batch.Release();
+
+  EXPECT_THAT(future.result(),
+              tensorstore::MatchesStatus(absl::StatusCode::kDataLoss));
+}
+
 TEST_F(TsGrpcMockTest, Write) {
   WriteRequest expected_request = ParseTextProtoOrDie(R"pb(
     key: 'abc'
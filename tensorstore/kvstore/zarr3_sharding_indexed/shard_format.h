@@ -167,12 +167,21 @@ struct ShardEntries {
 };
 
 /// Decodes a complete shard (entries followed by shard index).
+///
+/// The entries reference `shard_data` without copying, and are not further
+/// decoded; each inner chunk is decoded separately by the inner chunk cache,
+/// on its executor.
 Result<ShardEntries> DecodeShard(
     const absl::Cord& shard_data,
     const ShardIndexParameters& shard_index_parameters);
 
 /// Encodes a complete shard (entries followed by shard index).
 ///
+/// The entries must already be encoded, and are concatenated without
+/// re-encoding.  The inner chunks of a shard are encoded concurrently before
+/// this is called, as the writeback of each inner chunk is performed on the
+/// executor of the inner chunk cache.
+///
 /// Returns `std::nullopt` if all entries are missing.
 Result<std::optional<absl::Cord>> EncodeShard(
     const ShardEntries& entries,
@@ -15,6 +15,7 @@
 #include "tensorstore/kvstore/zarr3_sharding_indexed/shard_format.h"
 
 #include <optional>
+#include <string>
 #include <string_view>
 #include <vector>
 
@@ -98,6 +99,28 @@ TEST(EncodeShardTest, RoundTrip) {
   }
 }
 
+TEST(EncodeShardTest, EntriesNotCopied) {
+  for (auto index_location :
+       {ShardIndexLocation::kStart, ShardIndexLocation::kEnd}) {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto p, GetParams(index_location, {2}));
+
+    ShardEntries entries;
+    entries.entries = {absl::Cord(std::string(1024 * 1024, 'a')),
+                       std::nullopt};
+    auto flat = entries.entries[0]->TryFlat();
+    ASSERT_TRUE(flat.has_value());
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto encoded, EncodeShard(entries, p));
+    ASSERT_TRUE(encoded.has_value());
+
+    // The encoded shard references the memory of the entry.
+    bool found = false;
+    for (std::string_view chunk : encoded->Chunks()) {
+      if (chunk.data() == flat->data()) found = true;
+    }
+    EXPECT_TRUE(found);
+  }
+}
+
 TEST(EncodeShardTest, RoundTripEmpty) {
   for (auto index_location :
        {ShardIndexLocation::kStart, ShardIndexLocation::kEnd}) {
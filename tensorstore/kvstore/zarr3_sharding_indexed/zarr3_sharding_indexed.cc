@@ -83,11 +83,14 @@
 #include "tensorstore/util/str_cat.h"
 
 // specializations
+#include "tensorstore/internal/cache_key/std_optional.h"  // IWYU pragma: keep
 #include "tensorstore/internal/cache_key/std_vector.h"  // IWYU pragma: keep
 #include "tensorstore/internal/estimate_heap_usage/std_optional.h"  // IWYU pragma: keep
 #include "tensorstore/internal/estimate_heap_usage/std_vector.h"  // IWYU pragma: keep
+#include "tensorstore/serialization/std_optional.h"  // IWYU pragma: keep
 #include "tensorstore/serialization/std_vector.h"  // IWYU pragma: keep
 #include "tensorstore/util/execution/result_sender.h"  // IWYU pragma: keep
+#include "tensorstore/util/garbage_collection/std_optional.h"  // IWYU pragma: keep
 #include "tensorstore/util/garbage_collection/std_vector.h"  // IWYU pragma: keep
 
 namespace tensorstore {
@@ -902,6 +905,8 @@ void ShardedKeyValueStoreWriteCache::TransactionNode::WritebackError() {
 
 struct ShardedKeyValueStoreSpecData {
   Context::Resource<internal::CachePoolResource> cache_pool;
+  std::optional<Context::Resource<internal::CachePoolResource>>
+      index_cache_pool;
   Context::Resource<internal::DataCopyConcurrencyResource>
       data_copy_concurrency;
   kvstore::Spec base;
@@ -914,8 +919,8 @@ struct ShardedKeyValueStoreSpecData {
                                           ::nlohmann::json::object_t)
 
   constexpr static auto ApplyMembers = [](auto&& x, auto f) {
-    return f(x.cache_pool, x.data_copy_concurrency, x.base, x.grid_shape,
-             x.index_codecs, x.index_location);
+    return f(x.cache_pool, x.index_cache_pool, x.data_copy_concurrency, x.base,
+             x.grid_shape, x.index_codecs, x.index_location);
   };
 };
 
@@ -944,6 +949,9 @@ TENSORSTORE_DEFINE_JSON_DEFAULT_BINDER(
                 }))),
         jb::Member(internal::CachePoolResource::id,
                    jb::Projection<&ShardedKeyValueStoreSpecData::cache_pool>()),
+        jb::Member(
+            "index_cache_pool",
+            jb::Projection<&ShardedKeyValueStoreSpecData::index_cache_pool>()),
         jb::Member(
             internal::DataCopyConcurrencyResource::id,
             jb::Projection<
@@ -1028,6 +1036,8 @@ class ShardedKeyValueStore
 
   struct DataForSpec {
     Context::Resource<internal::CachePoolResource> cache_pool_resource;
+    std::optional<Context::Resource<internal::CachePoolResource>>
+        index_cache_pool_resource;
     Context::Resource<internal::DataCopyConcurrencyResource>
         data_copy_concurrency_resource;
     ZarrCodecChainSpec index_codecs;
@@ -1042,7 +1052,9 @@ ShardedKeyValueStore::ShardedKeyValueStore(
       params.cache_pool.get(), shared_cache_key, [&] {
         return std::make_unique<ShardedKeyValueStoreWriteCache>(
             internal::GetCache<ShardIndexCache>(
-                params.cache_pool.get(), "", [&] {
+                params.index_cache_pool ? params.index_cache_pool.get()
+                                        : params.cache_pool.get(),
+                "", [&] {
                   return std::make_unique<ShardIndexCache>(
                       std::move(params.base_kvstore),
                       std::move(params.base_kvstore_path),
@@ -1509,6 +1521,7 @@ absl::Status ShardedKeyValueStore::GetBoundSpecData(
   spec.base.path = base_kvstore_path();
   spec.data_copy_concurrency = data_for_spec_->data_copy_concurrency_resource;
   spec.cache_pool = data_for_spec_->cache_pool_resource;
+  spec.index_cache_pool = data_for_spec_->index_cache_pool_resource;
   spec.index_codecs = data_for_spec_->index_codecs;
   const auto& shard_index_params = this->shard_index_params();
   spec.index_location = shard_index_params.index_location;
@@ -1531,18 +1544,22 @@ Future<kvstore::DriverPtr> ShardedKeyValueStoreSpec::DoOpen() const {
         std::string cache_key;
         internal::EncodeCacheKey(
             &cache_key, base_kvstore.driver, base_kvstore.path,
-            spec->data_.data_copy_concurrency, spec->data_.grid_shape,
-            spec->data_.index_codecs);
+            spec->data_.index_cache_pool, spec->data_.data_copy_concurrency,
+            spec->data_.grid_shape, spec->data_.index_codecs);
         ShardedKeyValueStoreParameters params;
         params.base_kvstore = std::move(base_kvstore.driver);
         params.base_kvstore_path = std::move(base_kvstore.path);
         params.executor = spec->data_.data_copy_concurrency->executor;
         params.cache_pool = *spec->data_.cache_pool;
+        if (spec->data_.index_cache_pool) {
+          params.index_cache_pool = **spec->data_.index_cache_pool;
+        }
         params.index_params = std::move(index_params);
         auto driver = internal::MakeIntrusivePtr<ShardedKeyValueStore>(
             std::move(params), cache_key);
         driver->data_for_spec_.reset(new ShardedKeyValueStore::DataForSpec{
             spec->data_.cache_pool,
+            spec->data_.index_cache_pool,
             spec->data_.data_copy_concurrency,
             spec->data_.index_codecs,
         });
@@ -45,7 +45,13 @@
 /// To read an entry, the shard index must first be read and decoded, and then
 /// the byte range indicated by the shard index is read.  Depending on the cache
 /// pool configuration, the shard index may be cached to reduce overhead for
-/// repeated read requests to the same shard.
+/// repeated read requests to the same shard.  The absence of a shard is cached
+/// in the same way, so that repeated reads of entries in a missing shard only
+/// require a conditional request to revalidate.
+///
+/// The shard index cache may be assigned a separate cache pool, so that shard
+/// indices are not evicted by cached data.  When used by the zarr v3 driver,
+/// the shard index cache is created in the metadata cache pool.
 ///
 /// To write an entry or otherwise make any changes to a shard, the entire shard
 /// is re-written.
@@ -69,6 +75,8 @@ struct ShardedKeyValueStoreParameters {
   std::string base_kvstore_path;
   Executor executor;
   internal::CachePool::WeakPtr cache_pool;
+  // Cache pool for the shard index cache.  If null, `cache_pool` is used.
+  internal::CachePool::WeakPtr index_cache_pool;
   ShardIndexParameters index_params;
 };
 
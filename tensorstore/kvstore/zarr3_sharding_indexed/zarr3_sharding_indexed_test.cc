@@ -1557,4 +1557,50 @@ TEST(ShardedKeyValueStoreTest, Base) {
   EXPECT_THAT(store_with_txn.base(), base_store | transaction);
 }
 
+TEST(ShardedKeyValueStoreTest, SeparateIndexCachePool) {
+  // The default cache pool retains nothing, so the shard index is only
+  // retained by the separate index cache pool.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto context,
+      tensorstore::Context::FromJson(
+          {{"cache_pool", {{"total_bytes_limit", 0}}},
+           {"cache_pool#index", {{"total_bytes_limit", 1024 * 1024}}}}));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto mock_key_value_store_resource,
+      context.GetResource<tensorstore::internal::MockKeyValueStoreResource>());
+  auto mock_kvstore = *mock_key_value_store_resource;
+  mock_kvstore->forward_to = tensorstore::GetMemoryKeyValueStore();
+  mock_kvstore->log_requests = true;
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open(
+          {{"driver", "zarr3_sharding_indexed"},
+           {"base", {{"driver", "mock_key_value_store"}, {"path", "shard"}}},
+           {"grid_shape", {2}},
+           {"index_codecs",
+            {{{"name", "bytes"}, {"configuration", {{"endian", "little"}}}}}},
+           {"index_cache_pool", "cache_pool#index"}},
+          context)
+          .result());
+  const std::vector<Index> grid_shape{2};
+  TENSORSTORE_ASSERT_OK(tensorstore::kvstore::Write(
+      store, EntryIdToKey(0, grid_shape), absl::Cord("value")));
+
+  tensorstore::kvstore::ReadOptions options;
+  options.staleness_bound = absl::InfinitePast();
+  EXPECT_THAT(tensorstore::kvstore::Read(store, EntryIdToKey(0, grid_shape),
+                                         options)
+                  .result(),
+              MatchesKvsReadResult(absl::Cord("value")));
+  mock_kvstore->request_log.pop_all();
+
+  // Only the entry data is read; the shard index is cached.
+  EXPECT_THAT(tensorstore::kvstore::Read(store, EntryIdToKey(0, grid_shape),
+                                         options)
+                  .result(),
+              MatchesKvsReadResult(absl::Cord("value")));
+  EXPECT_THAT(mock_kvstore->request_log.pop_all(), ::testing::SizeIs(1));
+}
+
 }  // namespace
@@ -21,6 +21,7 @@
 #include <cassert>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <utility>
 #include <variant>
@@ -212,23 +213,27 @@ struct ReadDirectoryOp
       // Only add validated entries to the zip directory.
       if (ValidateEntryIsSupported(entry).ok()) {
         ABSL_LOG_IF(INFO, zip_logging) << "Adding " << entry;
-        dir.entries.push_back(
-            Directory::Entry{entry.filename, entry.crc, entry.compressed_size,
-                             entry.uncompressed_size, entry.local_header_offset,
-                             entry.estimated_read_size});
+        dir.entries.push_back(Directory::Entry{
+            dir.filenames.size(),
+            static_cast<uint32_t>(entry.filename.size()), entry.crc,
+            entry.compressed_size, entry.uncompressed_size,
+            entry.local_header_offset, entry.estimated_read_size});
+        dir.filenames.append(entry.filename);
       } else {
         ABSL_LOG_IF(INFO, zip_logging) << "Skipping " << entry;
       }
     }
+    dir.filenames.shrink_to_fit();
 
     // Sort by local header offset first, then by name, to determine
     // the estimated read size for each entry. Typically a ZIP file will
     // already be ordered like this. Subsequently, the gap between the
     // headers is used to determine how many bytes to read.
     std::sort(dir.entries.begin(), dir.entries.end(),
-              [](const auto& a, const auto& b) {
-                return std::tie(a.local_header_offset, a.filename) <
-                       std::tie(b.local_header_offset, b.filename);
+              [&](const auto& a, const auto& b) {
+                return std::make_tuple(a.local_header_offset,
+                                       dir.filename(a)) <
+                       std::make_tuple(b.local_header_offset, dir.filename(b));
               });
     auto last_header_offset = eocd_.cd_offset;
     for (auto it = dir.entries.rbegin(); it != dir.entries.rend(); ++it) {
@@ -238,9 +243,10 @@ struct ReadDirectoryOp
 
     // Sort directory by filename.
     std::sort(dir.entries.begin(), dir.entries.end(),
-              [](const auto& a, const auto& b) {
-                return std::tie(a.filename, a.local_header_offset) <
-                       std::tie(b.filename, a.local_header_offset);
+              [&](const auto& a, const auto& b) {
+                return std::make_tuple(dir.filename(a),
+                                       a.local_header_offset) <
+                       std::make_tuple(dir.filename(b), b.local_header_offset);
               });
 
     ABSL_LOG_IF(INFO, zip_logging) << dir;
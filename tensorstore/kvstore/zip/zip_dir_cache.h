@@ -16,8 +16,11 @@
 #define TENSORSTORE_KVSTORE_ZIP_ZIP_DIR_CACHE_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
+#include <algorithm>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -26,16 +29,23 @@
 #include "absl/time/time.h"
 #include "tensorstore/data_type.h"
 #include "tensorstore/internal/cache/async_cache.h"
+#include "tensorstore/kvstore/driver.h"
 #include "tensorstore/kvstore/spec.h"
 #include "tensorstore/util/executor.h"
 
 namespace tensorstore {
 namespace internal_zip_kvstore {
 
+/// Parsed ZIP central directory.
+///
+/// To limit memory usage for ZIP files with many entries, the filenames are
+/// stored concatenated in a single buffer rather than as a separate string
+/// per entry.
 struct Directory {
   struct Entry {
-    // Filename within the zip file.
-    std::string filename;
+    // Offset and size of the filename within `Directory::filenames`.
+    uint64_t filename_offset;
+    uint32_t filename_size;
 
     // Zip central directory parameters.
     uint32_t crc;
@@ -45,36 +55,57 @@ struct Directory {
     uint64_t estimated_size;
 
     constexpr static auto ApplyMembers = [](auto&& x, auto f) {
-      return f(x.filename, x.crc, x.compressed_size, x.uncompressed_size,
-               x.local_header_offset, x.estimated_size);
+      return f(x.filename_offset, x.filename_size, x.crc, x.compressed_size,
+               x.uncompressed_size, x.local_header_offset, x.estimated_size);
     };
-
-    template <typename Sink>
-    friend void AbslStringify(Sink& sink, const Entry& entry) {
-      absl::Format(
-          &sink,
-          "Entry{filename=%s, crc=%d, compressed_size=%d, "
-          "uncompressed_size=%d, local_header_offset=%d, estimated_size=%d}",
-          entry.filename, entry.crc, entry.compressed_size,
-          entry.uncompressed_size, entry.local_header_offset,
-          entry.estimated_size);
-    }
   };
 
+  // Entries, sorted by filename.
+  std::vector<Entry> entries;
+
+  // Concatenated filenames of `entries`.
+  std::string filenames;
+
   // Indicates whether the ZIP kvstore should issue reads for the entire file;
   // this is done when the initial read returns a range error.
-  std::vector<Entry> entries;
   bool full_read;
 
+  /// Returns the filename of `entry`.
+  std::string_view filename(const Entry& entry) const {
+    return std::string_view(filenames.data() + entry.filename_offset,
+                            entry.filename_size);
+  }
+
+  /// Returns the first entry with a filename not less than `key`.
+  std::vector<Entry>::const_iterator LowerBound(std::string_view key) const {
+    return std::lower_bound(entries.begin(), entries.end(), key,
+                            [&](const Entry& e, std::string_view k) {
+                              return filename(e) < k;
+                            });
+  }
+
+  /// Returns the entry for `key`, or `nullptr` if there is none.
+  const Entry* Find(std::string_view key) const {
+    auto it = LowerBound(key);
+    if (it == entries.end() || filename(*it) != key) return nullptr;
+    return &*it;
+  }
+
   constexpr static auto ApplyMembers = [](auto&& x, auto f) {
-    return f(x.entries, x.full_read);
+    return f(x.entries, x.filenames, x.full_read);
   };
 
   template <typename Sink>
-  friend void AbslStringify(Sink& sink, const Directory& entry) {
+  friend void AbslStringify(Sink& sink, const Directory& dir) {
     absl::Format(&sink, "Directory{\n");
-    for (const auto& entry : entry.entries) {
-      absl::Format(&sink, "%v\n", entry);
+    for (const auto& entry : dir.entries) {
+      absl::Format(
+          &sink,
+          "Entry{filename=%s, crc=%d, compressed_size=%d, "
+          "uncompressed_size=%d, local_header_offset=%d, estimated_size=%d}\n",
+          dir.filename(entry), entry.crc, entry.compressed_size,
+          entry.uncompressed_size, entry.local_header_offset,
+          entry.estimated_size);
     }
     absl::Format(&sink, "}");
   }
@@ -90,7 +121,9 @@ class ZipDirectoryCache : public internal::AsyncCache {
   explicit ZipDirectoryCache(kvstore::DriverPtr kvstore_driver,
                              Executor executor)
       : kvstore_driver_(std::move(kvstore_driver)),
-        executor_(std::move(executor)) {}
+        executor_(std::move(executor)) {
+    SetBatchNestingDepth(kvstore_driver_->BatchNestingDepth() + 1);
+  }
 
   class Entry : public Base::Entry {
    public:
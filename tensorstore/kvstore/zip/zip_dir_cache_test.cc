@@ -88,9 +88,9 @@ TEST(ZipDirectoryKvsTest, Basic) {
 
   ASSERT_THAT(dir->entries, ::testing::SizeIs(3));
 
-  EXPECT_THAT(dir->entries[0].filename, "data/a.png");
-  EXPECT_THAT(dir->entries[1].filename, "data/bb.png");
-  EXPECT_THAT(dir->entries[2].filename, "data/c.png");
+  EXPECT_EQ(dir->filename(dir->entries[0]), "data/a.png");
+  EXPECT_EQ(dir->filename(dir->entries[1]), "data/bb.png");
+  EXPECT_EQ(dir->filename(dir->entries[2]), "data/c.png");
 }
 
 TEST(ZipDirectoryKvsTest, MissingEntry) {
@@ -191,8 +191,8 @@ TEST(ZipDirectoryKvsTest, MinimalZip) {
 
   ASSERT_THAT(dir->entries, ::testing::SizeIs(2));
 
-  EXPECT_THAT(dir->entries[0].filename, "test");
-  EXPECT_THAT(dir->entries[1].filename, "testdir/test2");
+  EXPECT_EQ(dir->filename(dir->entries[0]), "test");
+  EXPECT_EQ(dir->filename(dir->entries[1]), "testdir/test2");
 }
 
 }  // namespace
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <algorithm>
 #include <cassert>
@@ -29,6 +30,7 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "riegeli/bytes/cord_reader.h"
+#include "tensorstore/batch.h"
 #include "tensorstore/context.h"
 #include "tensorstore/internal/cache/async_cache.h"
 #include "tensorstore/internal/cache/cache.h"
@@ -42,6 +44,7 @@
 #include "tensorstore/internal/log/verbose_flag.h"
 #include "tensorstore/internal/uri_utils.h"
 #include "tensorstore/kvstore/auto_detect.h"
+#include "tensorstore/kvstore/batch_util.h"
 #include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/common_metrics.h"
 #include "tensorstore/kvstore/driver.h"
@@ -194,148 +197,237 @@ Future<kvstore::DriverPtr> ZipKvStoreSpec::DoOpen() const {
         driver->spec_data_ = std::move(spec->data_);
         driver->cache_entry_ =
             GetCacheEntry(directory_cache, driver->base_.path);
+        driver->SetBatchNestingDepth(
+            driver->base_.driver->BatchNestingDepth() +
+            1 +  // for queuing entry requests
+            1    // for the directory cache
+        );
         return driver;
       },
       kvstore::Open(data_.base));
 }
 
+/// Decodes the value of the entry with a local header at `seek_pos` within
+/// `read_result`, which was read from the base kvstore.
+Result<kvstore::ReadResult> DecodeEntryValue(
+    kvstore::ReadResult read_result, size_t seek_pos,
+    OptionalByteRangeRequest byte_range_request) {
+  if (!read_result.has_value()) {
+    return read_result;
+  }
+  internal_zip::ZipEntry local_header{};
+  auto result = [&]() -> Result<kvstore::ReadResult> {
+    absl::Cord source = std::move(read_result.value);
+    riegeli::CordReader reader(&source);
+    reader.Seek(seek_pos);
+
+    TENSORSTORE_RETURN_IF_ERROR(ReadLocalEntry(reader, local_header));
+    TENSORSTORE_RETURN_IF_ERROR(ValidateEntryIsSupported(local_header));
+
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto byte_range,
+        byte_range_request.Validate(local_header.uncompressed_size));
+
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto entry_reader, internal_zip::GetReader(&reader, local_header));
+
+    // NOTE: To handle range requests efficiently we'd need a cache.
+    if (byte_range.inclusive_min > 0) {
+      // This should, IMO, be Seek, however when the reader is only
+      // wrapped in a LimitingReader<>, Seek appear appears to seek the
+      // underlying reader.  Maybe zip_details should use a WrappingReader?
+      entry_reader->Skip(byte_range.inclusive_min);
+    }
+
+    if (!entry_reader->Read(byte_range.size(), read_result.value)) {
+      // This should not happen unless there's some underlying corruption,
+      // since the range has already been validated.
+      if (entry_reader->status().ok()) {
+        return absl::OutOfRangeError("Failed to read range");
+      }
+      return entry_reader->status();
+    }
+    return read_result;
+  }();
+
+  ABSL_LOG_IF(INFO, zip_logging && !result.ok()) << result.status() << "\n"
+                                                 << local_header;
+  return result;
+}
+
 // Implements ZipKvStore::Read
-struct ReadState : public internal::AtomicReferenceCount<ReadState> {
-  internal::IntrusivePtr<ZipKvStore> owner_;
-  kvstore::Key key_;
-  kvstore::ReadOptions options_;
+//
+// Reads of the same ZIP file within a batch are handled together: the
+// directory is read (at most) once using the batch, and the entries are then
+// read using a successor batch, which allows the base kvstore to coalesce
+// reads of nearby entries.
+class ReadOperationState;
+using ReadOperationStateBase = internal_kvstore_batch::BatchReadEntry<
+    ZipKvStore, internal_kvstore_batch::ReadRequest<
+                    kvstore::Key, kvstore::ReadGenerationConditions>>;
+class ReadOperationState
+    : public ReadOperationStateBase,
+      public internal::AtomicReferenceCount<ReadOperationState> {
+ public:
+  explicit ReadOperationState(BatchEntryKey&& batch_entry_key_)
+      : ReadOperationStateBase(std::move(batch_entry_key_)),
+        // Initial reference to be transferred to `Submit`.
+        internal::AtomicReferenceCount<ReadOperationState>(
+            /*initial_ref_count=*/1) {}
+
+ private:
+  Batch successor_batch_{no_batch};
+
+  void Submit(Batch::View batch) override {
+    const auto& executor = driver().executor();
+    executor(
+        [this, batch = Batch(batch)] { this->ProcessBatch(std::move(batch)); });
+  }
 
-  // The cache read has completed, so the zip directory entries are available.
-  void OnDirectoryReady(Promise<kvstore::ReadResult> promise) {
-    TimestampedStorageGeneration stamp;
+  void ProcessBatch(Batch batch) {
+    // Take ownership of initial reference.
+    internal::IntrusivePtr<ReadOperationState> self(this,
+                                                    internal::adopt_object_ref);
+    auto directory_read_future = driver().cache_entry_->Read(
+        {this->request_batch.staleness_bound, batch});
+    if (batch) {
+      if (!directory_read_future.ready()) {
+        // The directory will be read using this batch.  The entries will be
+        // read using the successor batch.
+        successor_batch_ = Batch::New();
+      } else {
+        successor_batch_ = std::move(batch);
+      }
+    }
+    std::move(directory_read_future)
+        .ExecuteWhenReady(
+            [self = std::move(self)](ReadyFuture<const void> future) mutable {
+              const auto& executor = self->driver().executor();
+              executor([self = std::move(self), status = future.status()] {
+                if (!status.ok()) {
+                  internal_kvstore_batch::SetCommonResult<Request>(
+                      self->request_batch.requests, {status});
+                  return;
+                }
+                OnDirectoryReady(std::move(self));
+              });
+            });
+  }
 
-    // Set options for the entry request.
-    kvstore::ReadOptions options;
-    options.staleness_bound = options_.staleness_bound;
-    options.byte_range = OptionalByteRangeRequest{};
-    size_t seek_pos = 0;
+  /// Request for the value of a directory entry.
+  struct EntryRead {
+    Request* request;
+    uint64_t local_header_offset;
+    uint64_t estimated_size;
+  };
 
+  static void OnDirectoryReady(
+      internal::IntrusivePtr<ReadOperationState> self) {
+    std::shared_ptr<const Directory> dir;
+    TimestampedStorageGeneration stamp;
     {
       ZipDirectoryCache::ReadLock<ZipDirectoryCache::ReadData> lock(
-          *(owner_->cache_entry_));
+          *self->driver().cache_entry_);
       stamp = lock.stamp();
+      dir = lock.shared_data();
+    }
+    assert(dir);
 
-      // Find key in the directory.
-      assert(lock.data());
-      const ZipDirectoryCache::ReadData& dir = *lock.data();
-      ABSL_LOG_IF(INFO, zip_logging) << dir;
-
-      auto it = std::lower_bound(
-          dir.entries.begin(), dir.entries.end(), key_,
-          [](const auto& e, const std::string& k) { return e.filename < k; });
-
-      if (it == dir.entries.end() || it->filename != key_) {
-        // Missing value.
-        promise.SetResult(kvstore::ReadResult::Missing(std::move(stamp)));
-        return;
-      }
-
-      // Check if_equal and if_not_equal conditions.
-      // This happens after searching the directory in order to correctly handle
-      // IsNoValue matches, above.
-      if (!options_.generation_conditions.Matches(stamp.generation)) {
-        promise.SetResult(kvstore::ReadResult::Unspecified(std::move(stamp)));
-        return;
+    std::vector<EntryRead> entry_reads;
+    for (auto& request : self->request_batch.requests) {
+      auto& byte_range_request =
+          std::get<internal_kvstore_batch::ByteRangeReadRequest>(request);
+      if (!byte_range_request.promise.result_needed()) continue;
+      const auto* entry = dir->Find(std::get<kvstore::Key>(request));
+      if (!entry) {
+        byte_range_request.promise.SetResult(
+            kvstore::ReadResult::Missing(stamp));
+        continue;
       }
-
-      // Setup a read for the key.
-      if (dir.full_read) {
-        seek_pos = it->local_header_offset;
-      } else {
-        seek_pos = 0;
-        options.byte_range = OptionalByteRangeRequest::Range(
-            it->local_header_offset,
-            it->local_header_offset + it->estimated_size);
+      // Check if_equal and if_not_equal conditions.  This happens after
+      // searching the directory in order to correctly handle IsNoValue
+      // matches, above.
+      if (!std::get<kvstore::ReadGenerationConditions>(request).Matches(
+              stamp.generation)) {
+        byte_range_request.promise.SetResult(
+            kvstore::ReadResult::Unspecified(stamp));
+        continue;
       }
+      entry_reads.push_back(EntryRead{&request, entry->local_header_offset,
+                                      entry->estimated_size});
+    }
+    if (entry_reads.empty()) return;
+
+    auto successor_batch = std::move(self->successor_batch_);
+    if (dir->full_read) {
+      // The base kvstore does not support byte range reads; read the entire
+      // file once for all requests.
+      kvstore::ReadOptions options;
+      options.staleness_bound = self->request_batch.staleness_bound;
+      options.generation_conditions.if_equal = stamp.generation;
+      options.batch = std::move(successor_batch);
+      auto future = kvstore::Read(self->driver().base_, {}, std::move(options));
+      std::move(future).ExecuteWhenReady(
+          [self = std::move(self), entry_reads = std::move(entry_reads)](
+              ReadyFuture<kvstore::ReadResult> future) mutable {
+            const auto& executor = self->driver().executor();
+            executor([self = std::move(self),
+                      entry_reads = std::move(entry_reads),
+                      future = std::move(future)] {
+              for (const auto& entry_read : entry_reads) {
+                SetEntryResult(*entry_read.request, future.result(),
+                               entry_read.local_header_offset);
+              }
+            });
+          });
+      return;
     }
 
-    options.generation_conditions.if_equal = stamp.generation;
-    Link(WithExecutor(owner_->executor(),
-                      [self = internal::IntrusivePtr<ReadState>(this),
-                       seek_pos](Promise<kvstore::ReadResult> promise,
-                                 ReadyFuture<kvstore::ReadResult> ready) {
-                        self->OnValueRead(std::move(promise), std::move(ready),
-                                          seek_pos);
-                      }),
-         std::move(promise),
-         kvstore::Read(owner_->base_, {}, std::move(options)));
+    for (const auto& entry_read : entry_reads) {
+      kvstore::ReadOptions options;
+      options.staleness_bound = self->request_batch.staleness_bound;
+      options.generation_conditions.if_equal = stamp.generation;
+      options.batch = successor_batch;
+      options.byte_range = OptionalByteRangeRequest::Range(
+          entry_read.local_header_offset,
+          entry_read.local_header_offset + entry_read.estimated_size);
+      auto future = kvstore::Read(self->driver().base_, {}, std::move(options));
+      std::move(future).ExecuteWhenReady(
+          [self, request = entry_read.request](
+              ReadyFuture<kvstore::ReadResult> future) mutable {
+            const auto& executor = self->driver().executor();
+            executor([self = std::move(self), request,
+                      future = std::move(future)] {
+              SetEntryResult(*request, future.result(), /*seek_pos=*/0);
+            });
+          });
+    }
   }
 
-  void OnValueRead(Promise<kvstore::ReadResult> promise,
-                   ReadyFuture<kvstore::ReadResult> ready, size_t seek_pos) {
-    if (!promise.result_needed()) return;
-    if (!ready.status().ok()) {
-      promise.SetResult(ready.status());
+  static void SetEntryResult(Request& request,
+                             const Result<kvstore::ReadResult>& result,
+                             size_t seek_pos) {
+    auto& byte_range_request =
+        std::get<internal_kvstore_batch::ByteRangeReadRequest>(request);
+    if (!byte_range_request.promise.result_needed()) return;
+    if (!result.ok()) {
+      byte_range_request.promise.SetResult(result.status());
       return;
     }
-
-    internal_zip::ZipEntry local_header{};
-    auto result = [&]() -> Result<kvstore::ReadResult> {
-      kvstore::ReadResult read_result = std::move(ready.value());
-      if (!read_result.has_value()) {
-        return read_result;
-      }
-      absl::Cord source = std::move(read_result.value);
-      riegeli::CordReader reader(&source);
-      reader.Seek(seek_pos);
-
-      TENSORSTORE_RETURN_IF_ERROR(ReadLocalEntry(reader, local_header));
-      TENSORSTORE_RETURN_IF_ERROR(ValidateEntryIsSupported(local_header));
-
-      TENSORSTORE_ASSIGN_OR_RETURN(
-          auto byte_range,
-          options_.byte_range.Validate(local_header.uncompressed_size));
-
-      TENSORSTORE_ASSIGN_OR_RETURN(
-          auto entry_reader, internal_zip::GetReader(&reader, local_header));
-
-      // NOTE: To handle range requests efficiently we'd need a cache.
-      if (byte_range.inclusive_min > 0) {
-        // This should, IMO, be Seek, however when the reader is only
-        // wrapped in a LimitingReader<>, Seek appear appears to seek the
-        // underlying reader.  Maybe zip_details should use a WrappingReader?
-        entry_reader->Skip(byte_range.inclusive_min);
-      }
-
-      if (!entry_reader->Read(byte_range.size(), read_result.value)) {
-        // This should not happen unless there's some underlying corruption,
-        // since the range has already been validated.
-        if (entry_reader->status().ok()) {
-          return absl::OutOfRangeError("Failed to read range");
-        }
-        return entry_reader->status();
-      }
-      return read_result;
-    }();
-
-    ABSL_LOG_IF(INFO, zip_logging && !result.ok()) << result.status() << "\n"
-                                                   << local_header;
-
-    promise.SetResult(std::move(result));
+    byte_range_request.promise.SetResult(
+        DecodeEntryValue(*result, seek_pos, byte_range_request.byte_range));
   }
 };
 
 Future<kvstore::ReadResult> ZipKvStore::Read(Key key, ReadOptions options) {
-  auto state = internal::MakeIntrusivePtr<ReadState>();
-  state->owner_ = internal::IntrusivePtr<ZipKvStore>(this);
-  state->key_ = std::move(key);
-  state->options_ = options;
   zip_metrics.read.Increment();
-  return PromiseFuturePair<kvstore::ReadResult>::LinkValue(
-             WithExecutor(
-                 executor(),
-                 [state = std::move(state)](Promise<ReadResult> promise,
-                                            ReadyFuture<const void>) {
-                   if (!promise.result_needed()) return;
-                   state->OnDirectoryReady(std::move(promise));
-                 }),
-             cache_entry_->Read({options.staleness_bound}))
-      .future;
+  auto [promise, future] = PromiseFuturePair<kvstore::ReadResult>::Make();
+  ReadOperationState::MakeRequest<ReadOperationState>(
+      *this, options.batch, options.staleness_bound,
+      ReadOperationState::Request{{std::move(promise), options.byte_range},
+                                  std::move(key),
+                                  std::move(options.generation_conditions)});
+  return std::move(future);
 }
 
 // Implements ZipKvStore::List
@@ -377,18 +469,18 @@ struct ListState : public internal::AtomicReferenceCount<ListState> {
                    .shared_data();
     assert(dir);
 
-    auto it = std::lower_bound(
-        dir->entries.begin(), dir->entries.end(), options_.range.inclusive_min,
-        [](const auto& e, const std::string& k) { return e.filename < k; });
-    for (; it != dir->entries.end(); ++it) {
+    for (auto it = dir->LowerBound(options_.range.inclusive_min);
+         it != dir->entries.end(); ++it) {
+      std::string_view filename = dir->filename(*it);
       if (KeyRange::CompareKeyAndExclusiveMax(
-              it->filename, options_.range.exclusive_max) >= 0) {
+              filename, options_.range.exclusive_max) >= 0) {
         break;
       }
-      if (it->filename.size() >= options_.strip_prefix_length) {
+      if (filename.size() >= options_.strip_prefix_length) {
         execution::set_value(
             receiver_,
-            ListEntry{it->filename.substr(options_.strip_prefix_length),
+            ListEntry{std::string(
+                          filename.substr(options_.strip_prefix_length)),
                       ListEntry::checked_size(it->uncompressed_size)});
       }
     }
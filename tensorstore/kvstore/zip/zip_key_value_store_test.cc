@@ -26,7 +26,9 @@
 #include <nlohmann/json.hpp>
 #include "riegeli/bytes/fd_reader.h"
 #include "riegeli/bytes/read_all.h"
+#include "tensorstore/batch.h"
 #include "tensorstore/context.h"
+#include "tensorstore/kvstore/byte_range.h"
 #include "tensorstore/kvstore/generation.h"
 #include "tensorstore/kvstore/kvstore.h"
 #include "tensorstore/kvstore/operations.h"
@@ -168,6 +170,39 @@ TEST_F(ZipKeyValueStoreTest, Simple) {
   }
 }
 
+TEST_F(ZipKeyValueStoreTest, BatchRead) {
+  PrepareMemoryKvstore(GetTestZipFileData());
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto store,
+      kvstore::Open({{"driver", "zip"},
+                     {"base", {{"driver", "memory"}, {"path", "data.zip"}}}},
+                    context_)
+          .result());
+
+  std::vector<tensorstore::Future<kvstore::ReadResult>> futures;
+  {
+    auto batch = tensorstore::Batch::New();
+    kvstore::ReadOptions options;
+    options.batch = batch;
+    for (std::string_view key :
+         {"data/a.png", "data/bb.png", "data/c.png", "data/zz.png"}) {
+      futures.push_back(kvstore::Read(store, std::string(key), options));
+    }
+    options.byte_range = tensorstore::OptionalByteRangeRequest::Range(1, 4);
+    futures.push_back(kvstore::Read(store, "data/bb.png", options));
+  }
+  for (int i = 0; i < 3; ++i) {
+    TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto read_result, futures[i].result());
+    EXPECT_TRUE(read_result.has_value()) << i;
+  }
+  EXPECT_THAT(futures[1].result(),
+              ::testing::Optional(::testing::Field(
+                  &kvstore::ReadResult::value, ::testing::SizeIs(106351))));
+  EXPECT_THAT(futures[3].result(), MatchesKvsReadResultNotFound());
+  EXPECT_THAT(futures[4].result(), MatchesKvsReadResult(absl::Cord("PNG")));
+}
+
 TEST_F(ZipKeyValueStoreTest, ReadOps) {
   PrepareMemoryKvstore(GetReadOpZip());
 
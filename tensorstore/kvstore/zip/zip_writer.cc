@@ -0,0 +1,203 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/zip/zip_writer.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_cat.h"
+#include "riegeli/bytes/cord_writer.h"
+#include "riegeli/zlib/zlib_writer.h"
+#include "tensorstore/internal/compression/zip_details.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/quote_string.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+#include "tensorstore/util/status.h"
+
+// Include zlib header last because it defines a bunch of poorly-named macros.
+#include <zlib.h>
+
+namespace tensorstore {
+namespace internal_zip_kvstore {
+namespace {
+
+using ::tensorstore::internal_zip::ZipCompression;
+
+/// An entry compressed by `CompressEntry`.
+struct CompressedEntry {
+  ZipCompression compression_method;
+  uint32_t crc;
+  uint64_t uncompressed_size;
+  absl::Cord data;
+};
+
+}  // namespace
+
+struct ZipWriter::State : public internal::AtomicReferenceCount<State> {
+  struct PendingEntry {
+    std::string filename;
+    Future<CompressedEntry> compressed;
+  };
+
+  KvStore base;
+  Executor executor;
+  Options options;
+  std::vector<PendingEntry> entries;
+  absl::flat_hash_set<std::string> filenames;
+};
+
+namespace {
+
+using State = ZipWriter::State;
+
+Result<CompressedEntry> CompressEntry(const absl::Cord& value, int level) {
+  CompressedEntry entry;
+  entry.uncompressed_size = value.size();
+  uLong crc = crc32(0L, Z_NULL, 0);
+  for (std::string_view chunk : value.Chunks()) {
+    crc = crc32_z(crc, reinterpret_cast<const Bytef*>(chunk.data()),
+                  chunk.size());
+  }
+  entry.crc = static_cast<uint32_t>(crc);
+  if (level != 0 && !value.empty()) {
+    using Writer = riegeli::ZlibWriter<riegeli::CordWriter<absl::Cord*>>;
+    Writer::Options options;
+    if (level != -1) options.set_compression_level(level);
+    options.set_header(Writer::Header::kRaw);
+    absl::Cord compressed;
+    Writer writer(riegeli::CordWriter<absl::Cord*>(&compressed), options);
+    if (!writer.Write(value) || !writer.Close()) {
+      return writer.status();
+    }
+    if (compressed.size() < value.size()) {
+      entry.compression_method = ZipCompression::kDeflate;
+      entry.data = std::move(compressed);
+      return entry;
+    }
+  }
+  entry.compression_method = ZipCompression::kStore;
+  entry.data = value;
+  return entry;
+}
+
+/// Encodes the archive from the compressed entries.
+Result<absl::Cord> EncodeArchive(const State& state) {
+  absl::Cord archive;
+  riegeli::CordWriter<absl::Cord*> writer(&archive);
+  std::vector<internal_zip::ZipEntry> zip_entries;
+  zip_entries.reserve(state.entries.size());
+  for (const auto& pending : state.entries) {
+    const auto& compressed = pending.compressed.value();
+    auto& zip_entry = zip_entries.emplace_back();
+    zip_entry.version_madeby = 45;
+    zip_entry.flags = 0;
+    zip_entry.compression_method = compressed.compression_method;
+    zip_entry.crc = compressed.crc;
+    zip_entry.compressed_size = compressed.data.size();
+    zip_entry.uncompressed_size = compressed.uncompressed_size;
+    zip_entry.internal_fa = 0;
+    zip_entry.external_fa = 0;
+    zip_entry.local_header_offset = writer.pos();
+    zip_entry.mtime = state.options.mtime;
+    zip_entry.filename = pending.filename;
+    TENSORSTORE_RETURN_IF_ERROR(
+        internal_zip::WriteLocalEntry(writer, zip_entry));
+    writer.Write(compressed.data);
+  }
+  internal_zip::ZipEOCD eocd{};
+  eocd.num_entries = zip_entries.size();
+  eocd.cd_offset = writer.pos();
+  for (const auto& zip_entry : zip_entries) {
+    TENSORSTORE_RETURN_IF_ERROR(
+        internal_zip::WriteCentralDirectoryEntry(writer, zip_entry));
+  }
+  eocd.cd_size = writer.pos() - eocd.cd_offset;
+  TENSORSTORE_RETURN_IF_ERROR(internal_zip::WriteEOCD(writer, eocd));
+  if (!writer.Close()) return writer.status();
+  return archive;
+}
+
+}  // namespace
+
+ZipWriter::ZipWriter(KvStore base, Executor executor, Options options)
+    : state_(internal::MakeIntrusivePtr<State>()) {
+  state_->base = std::move(base);
+  state_->executor = std::move(executor);
+  state_->options = std::move(options);
+}
+
+ZipWriter::ZipWriter(ZipWriter&&) = default;
+ZipWriter& ZipWriter::operator=(ZipWriter&&) = default;
+ZipWriter::~ZipWriter() = default;
+
+Future<const void> ZipWriter::Add(std::string filename, absl::Cord value) {
+  auto& state = *state_;
+  if (!state.filenames.insert(filename).second) {
+    return absl::AlreadyExistsError(
+        absl::StrCat("Duplicate ZIP entry ", QuoteString(filename)));
+  }
+  auto [promise, future] = PromiseFuturePair<CompressedEntry>::Make();
+  state.executor([promise = std::move(promise), value = std::move(value),
+                  level = state.options.compression_level] {
+    if (!promise.result_needed()) return;
+    promise.SetResult(CompressEntry(value, level));
+  });
+  state.entries.push_back(State::PendingEntry{std::move(filename), future});
+  return MapFutureValue(
+      InlineExecutor{}, [](const CompressedEntry&) { return MakeResult(); },
+      std::move(future));
+}
+
+Future<TimestampedStorageGeneration> ZipWriter::Finalize() {
+  std::vector<Future<CompressedEntry>> futures;
+  futures.reserve(state_->entries.size());
+  for (const auto& pending : state_->entries) {
+    futures.push_back(pending.compressed);
+  }
+  auto executor = state_->executor;
+  return PromiseFuturePair<TimestampedStorageGeneration>::LinkValue(
+             WithExecutor(
+                 std::move(executor),
+                 [state = state_](Promise<TimestampedStorageGeneration> promise,
+                                  ReadyFuture<void> future) {
+                   TENSORSTORE_ASSIGN_OR_RETURN(
+                       auto archive, EncodeArchive(*state),
+                       static_cast<void>(promise.SetResult(_)));
+                   LinkResult(std::move(promise),
+                              kvstore::Write(state->base, {},
+                                             std::move(archive)));
+                 }),
+             WaitAllFuture(tensorstore::span(futures)))
+      .future;
+}
+
+size_t ZipWriter::num_entries() const { return state_->entries.size(); }
+
+}  // namespace internal_zip_kvstore
+}  // namespace tensorstore
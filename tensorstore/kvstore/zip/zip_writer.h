@@ -0,0 +1,109 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_KVSTORE_ZIP_ZIP_WRITER_H_
+#define TENSORSTORE_KVSTORE_ZIP_ZIP_WRITER_H_
+
+/// \file
+/// Writes a new ZIP archive that may be read with the "zip" kvstore driver.
+
+#include <stddef.h>
+
+#include <string>
+
+#include "absl/strings/cord.h"
+#include "absl/time/time.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/kvstore/generation.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+
+namespace tensorstore {
+namespace internal_zip_kvstore {
+
+/// Writes a ZIP (ZIP64 when needed) archive to a single key of a base
+/// kvstore.
+///
+/// Entries are compressed on `executor` as they are added, such that the
+/// entries are compressed in parallel with each other and with the caller
+/// producing further entries.  `Finalize` lays out the compressed entries in
+/// the order in which they were added, followed by the central directory, and
+/// writes the archive to the base kvstore.
+///
+/// Since kvstore writes replace the entire value, the compressed entries are
+/// held in memory until `Finalize` is called.
+///
+/// This class is not thread safe.
+///
+/// Example usage:
+///
+///     ZipWriter writer(KvStore(base_driver, "data.zip"), executor, {});
+///     for (const auto& [key, value] : entries) {
+///       writer.Add(key, value);
+///     }
+///     TENSORSTORE_RETURN_IF_ERROR(writer.Finalize().result());
+class ZipWriter {
+ public:
+  struct Options {
+    /// Deflate compression level, in the range `[0, 9]`, or `-1` for the zlib
+    /// default.  With a level of `0`, entries are stored uncompressed.
+    /// Entries that do not become smaller when compressed are also stored
+    /// uncompressed.
+    int compression_level = -1;
+
+    /// Modification time recorded for each entry.
+    absl::Time mtime = absl::UnixEpoch();
+  };
+
+  /// Constructs a writer.
+  ///
+  /// \param base The key of the archive, i.e. `base.path`, within
+  ///     `base.driver`.
+  /// \param executor Executor used for compressing entries.
+  /// \param options Compression options.
+  ZipWriter(KvStore base, Executor executor, Options options);
+
+  ZipWriter(ZipWriter&&);
+  ZipWriter& operator=(ZipWriter&&);
+  ~ZipWriter();
+
+  /// Adds an entry.
+  ///
+  /// \param filename The key of the entry within the archive.
+  /// \param value The uncompressed entry data.
+  /// \returns A future that becomes ready once the entry has been compressed.
+  /// \error `absl::StatusCode::kAlreadyExists` if an entry with the same
+  ///     `filename` was previously added.
+  /// \pre `Finalize()` was not called previously.
+  Future<const void> Add(std::string filename, absl::Cord value);
+
+  /// Writes the archive.
+  ///
+  /// \pre `Finalize()` was not called previously.
+  Future<TimestampedStorageGeneration> Finalize();
+
+  /// Returns the number of entries added.
+  size_t num_entries() const;
+
+  struct State;
+
+ private:
+  internal::IntrusivePtr<State> state_;
+};
+
+}  // namespace internal_zip_kvstore
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_KVSTORE_ZIP_ZIP_WRITER_H_
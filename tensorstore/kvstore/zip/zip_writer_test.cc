@@ -0,0 +1,127 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/kvstore/zip/zip_writer.h"
+
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "tensorstore/context.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/test_matchers.h"
+#include "tensorstore/kvstore/test_util.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+namespace kvstore = ::tensorstore::kvstore;
+using ::tensorstore::Context;
+using ::tensorstore::InlineExecutor;
+using ::tensorstore::KvStore;
+using ::tensorstore::StatusIs;
+using ::tensorstore::internal::MatchesKvsReadResult;
+using ::tensorstore::internal::MatchesKvsReadResultNotFound;
+using ::tensorstore::internal_zip_kvstore::ZipWriter;
+
+class ZipWriterTest : public ::testing::Test {
+ public:
+  ZipWriterTest() : context_(Context::Default()) {
+    memory_ = kvstore::Open({{"driver", "memory"}}, context_).value();
+  }
+
+  KvStore OpenZip() {
+    return kvstore::Open({{"driver", "zip"},
+                          {"base", {{"driver", "memory"}, {"path", "a.zip"}}}},
+                         context_)
+        .value();
+  }
+
+  Context context_;
+  KvStore memory_;
+};
+
+TEST_F(ZipWriterTest, Roundtrip) {
+  for (int level : {-1, 0}) {
+    SCOPED_TRACE(level);
+    ZipWriter::Options options;
+    options.compression_level = level;
+    ZipWriter writer(KvStore(memory_.driver, "a.zip"), InlineExecutor{},
+                     options);
+    const std::string compressible(10000, 'x');
+    TENSORSTORE_EXPECT_OK(
+        writer.Add("b/compressible", absl::Cord(compressible)));
+    TENSORSTORE_EXPECT_OK(writer.Add("a", absl::Cord("abc")));
+    TENSORSTORE_EXPECT_OK(writer.Add("empty", absl::Cord()));
+    EXPECT_EQ(3, writer.num_entries());
+    TENSORSTORE_EXPECT_OK(writer.Finalize());
+
+    auto store = OpenZip();
+    EXPECT_THAT(kvstore::Read(store, "a").result(),
+                MatchesKvsReadResult(absl::Cord("abc")));
+    EXPECT_THAT(kvstore::Read(store, "b/compressible").result(),
+                MatchesKvsReadResult(absl::Cord(compressible)));
+    EXPECT_THAT(kvstore::Read(store, "empty").result(),
+                MatchesKvsReadResult(absl::Cord()));
+    EXPECT_THAT(kvstore::Read(store, "missing").result(),
+                MatchesKvsReadResultNotFound());
+    EXPECT_THAT(tensorstore::internal::GetMap(store),
+                ::testing::Optional(::testing::SizeIs(3)));
+  }
+}
+
+TEST_F(ZipWriterTest, Compresses) {
+  ZipWriter writer(KvStore(memory_.driver, "a.zip"), InlineExecutor{}, {});
+  TENSORSTORE_EXPECT_OK(writer.Add("a", absl::Cord(std::string(100000, 'x'))));
+  TENSORSTORE_EXPECT_OK(writer.Finalize());
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto archive,
+                                   kvstore::Read(memory_, "a.zip").result());
+  EXPECT_LT(archive.value.size(), 1000);
+}
+
+TEST_F(ZipWriterTest, DuplicateEntry) {
+  ZipWriter writer(KvStore(memory_.driver, "a.zip"), InlineExecutor{}, {});
+  TENSORSTORE_EXPECT_OK(writer.Add("a", absl::Cord("abc")));
+  EXPECT_THAT(writer.Add("a", absl::Cord("def")).result(),
+              StatusIs(absl::StatusCode::kAlreadyExists));
+  TENSORSTORE_EXPECT_OK(writer.Finalize());
+  EXPECT_THAT(kvstore::Read(OpenZip(), "a").result(),
+              MatchesKvsReadResult(absl::Cord("abc")));
+}
+
+// More than 65535 entries requires the ZIP64 end of central directory.
+TEST_F(ZipWriterTest, Zip64NumEntries) {
+  ZipWriter::Options options;
+  options.compression_level = 0;
+  ZipWriter writer(KvStore(memory_.driver, "a.zip"), InlineExecutor{},
+                   options);
+  constexpr int kNumEntries = 70000;
+  for (int i = 0; i < kNumEntries; ++i) {
+    writer.Add(absl::StrFormat("%06d", i), absl::Cord(absl::StrCat(i)));
+  }
+  TENSORSTORE_EXPECT_OK(writer.Finalize());
+  auto store = OpenZip();
+  EXPECT_THAT(kvstore::Read(store, "000000").result(),
+              MatchesKvsReadResult(absl::Cord("0")));
+  EXPECT_THAT(kvstore::Read(store, "069999").result(),
+              MatchesKvsReadResult(absl::Cord("69999")));
+}
+
+}  // namespace
@@ -19,8 +19,10 @@
 #include <string_view>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <nlohmann/json.hpp>
+#include "tensorstore/batch.h"
 #include "tensorstore/driver/driver.h"
 #include "tensorstore/index.h"
 #include "tensorstore/open_mode.h"
@@ -31,6 +33,7 @@
 #include "tensorstore/util/future.h"
 #include "tensorstore/util/option.h"
 #include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
 #include "tensorstore/util/status.h"
 
 namespace tensorstore {
@@ -164,6 +167,74 @@ Open(J json_spec, TransactionalOpenOptions&& options) {
                                                 std::move(options));
 }
 
+/// Opens multiple TensorStores concurrently.
+///
+/// Equivalent to calling `Open` for each spec with a copy of the same options,
+/// except that the read operations performed when opening all use the same
+/// batch, which permits the metadata reads to be coalesced by the underlying
+/// key-value stores.  If no `Batch` is specified, a new batch is used and
+/// submitted once all of the opens have been issued.
+///
+/// Combined with `RecheckCachedMetadata::AtOpen(max_age)`, this avoids
+/// revalidating recently-read metadata when opening many arrays.
+///
+/// Example usage::
+///
+///     std::vector<tensorstore::Spec> specs = ...;
+///     TENSORSTORE_ASSIGN_OR_RETURN(
+///         auto stores,
+///         tensorstore::OpenAll(std::move(specs), context,
+///                              tensorstore::ReadWriteMode::read).result());
+///
+/// \param specs The Specs to open.
+/// \param option Any option compatible with `TransactionalOpenOptions`.
+/// \returns A future that becomes ready once all of the TensorStores have been
+///     opened, with the TensorStores in the same order as `specs`, or with an
+///     error if any open fails.
+/// \relates TensorStore
+template <typename Element = void, DimensionIndex Rank = dynamic_rank,
+          ReadWriteMode Mode = ReadWriteMode::dynamic>
+Future<std::vector<TensorStore<Element, Rank, Mode>>> OpenAll(
+    std::vector<Spec> specs, TransactionalOpenOptions&& options) {
+  using Store = TensorStore<Element, Rank, Mode>;
+  if (!options.batch) options.batch = Batch::New();
+  std::vector<Future<Store>> futures;
+  futures.reserve(specs.size());
+  for (auto& spec : specs) {
+    TransactionalOpenOptions spec_options = options;
+    futures.push_back(tensorstore::Open<Element, Rank, Mode>(
+        std::move(spec), std::move(spec_options)));
+  }
+  // Submits the batch, if it was created above.
+  options.batch.Release();
+  auto all_ready = WaitAllFuture(tensorstore::span(futures));
+  return PromiseFuturePair<std::vector<Store>>::LinkValue(
+             [futures = std::move(futures)](
+                 Promise<std::vector<Store>> promise,
+                 ReadyFuture<void> future) {
+               std::vector<Store> stores;
+               stores.reserve(futures.size());
+               for (const auto& f : futures) {
+                 stores.push_back(f.value());
+               }
+               promise.SetResult(std::move(stores));
+             },
+             std::move(all_ready))
+      .future;
+}
+template <typename Element = void, DimensionIndex Rank = dynamic_rank,
+          ReadWriteMode Mode = ReadWriteMode::dynamic, typename... Option>
+std::enable_if_t<
+    IsCompatibleOptionSequence<TransactionalOpenOptions, Option...>,
+    Future<std::vector<TensorStore<Element, Rank, Mode>>>>
+OpenAll(std::vector<Spec> specs, Option&&... option) {
+  TransactionalOpenOptions options;
+  TENSORSTORE_RETURN_IF_ERROR(
+      internal::SetAll(options, std::forward<Option>(option)...));
+  return tensorstore::OpenAll<Element, Rank, Mode>(std::move(specs),
+                                                   std::move(options));
+}
+
 }  // namespace tensorstore
 
 #endif  // TENSORSTORE_OPEN_H_
@@ -0,0 +1,131 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks the per-array overhead of `tensorstore::Open` with a shared
+// context, which is dominated by parsing the spec and binding its context
+// resources.
+//
+// BM_OpenArray:
+//   Opens an `array` driver spec.
+//
+// BM_OpenZarr3Memory:
+//   Opens an existing zarr3 array in a `memory` kvstore.
+//
+// BM_BindContext:
+//   Parses and binds a zarr3 spec without opening it.
+//
+// BM_ParseStackSpec/<layers>:
+//   Parses a `stack` spec with the specified number of zarr3 layers.
+//
+// BM_OpenStack/<layers>:
+//   Opens a `stack` spec with the specified number of zarr3 layers, which are
+//   opened on demand and therefore not accessed.
+
+#include <stdint.h>
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/open.h"
+#include "tensorstore/open_mode.h"
+#include "tensorstore/spec.h"
+#include "tensorstore/tensorstore.h"
+
+namespace {
+
+using ::tensorstore::Context;
+using ::tensorstore::OpenMode;
+using ::tensorstore::Spec;
+
+::nlohmann::json GetZarr3Spec() {
+  return {{"driver", "zarr3"},
+          {"kvstore", {{"driver", "memory"}, {"path", "array/"}}},
+          {"metadata", {{"data_type", "uint16"}, {"shape", {4, 5}}}}};
+}
+
+void BM_OpenArray(benchmark::State& state) {
+  auto context = Context::Default();
+  const ::nlohmann::json json_spec{
+      {"driver", "array"}, {"dtype", "int32"}, {"array", {{1, 2}, {3, 4}}}};
+  for (auto s : state) {
+    auto store = tensorstore::Open(json_spec, context).value();
+    benchmark::DoNotOptimize(store);
+  }
+}
+BENCHMARK(BM_OpenArray);
+
+void BM_OpenZarr3Memory(benchmark::State& state) {
+  auto context = Context::Default();
+  const auto json_spec = GetZarr3Spec();
+  tensorstore::Open(json_spec, context, OpenMode::create).value();
+  for (auto s : state) {
+    auto store = tensorstore::Open(json_spec, context, OpenMode::open).value();
+    benchmark::DoNotOptimize(store);
+  }
+}
+BENCHMARK(BM_OpenZarr3Memory);
+
+void BM_BindContext(benchmark::State& state) {
+  auto context = Context::Default();
+  const auto json_spec = GetZarr3Spec();
+  for (auto s : state) {
+    auto spec = Spec::FromJson(json_spec).value();
+    auto status = spec.BindContext(context);
+    benchmark::DoNotOptimize(status);
+  }
+}
+BENCHMARK(BM_BindContext);
+
+// Returns a `stack` spec of `num_layers` zarr3 arrays of shape `[4, 5]`,
+// concatenated along the first dimension.
+::nlohmann::json GetStackSpec(int64_t num_layers) {
+  ::nlohmann::json::array_t layers;
+  layers.reserve(num_layers);
+  for (int64_t i = 0; i < num_layers; ++i) {
+    auto layer = GetZarr3Spec();
+    layer["kvstore"]["path"] = "array" + std::to_string(i) + "/";
+    layer["transform"] = {
+        {"input_inclusive_min", {4 * i, 0}},
+        {"input_shape", {4, 5}},
+        {"output", {{{"input_dimension", 0}, {"offset", -4 * i}},
+                    {{"input_dimension", 1}}}}};
+    layers.push_back(std::move(layer));
+  }
+  return {{"driver", "stack"}, {"layers", std::move(layers)}};
+}
+
+void BM_ParseStackSpec(benchmark::State& state) {
+  const auto json_spec = GetStackSpec(state.range(0));
+  for (auto s : state) {
+    auto spec = Spec::FromJson(json_spec).value();
+    benchmark::DoNotOptimize(spec);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParseStackSpec)->Range(16, 16 << 10);
+
+void BM_OpenStack(benchmark::State& state) {
+  auto context = Context::Default();
+  const auto json_spec = GetStackSpec(state.range(0));
+  for (auto s : state) {
+    auto store = tensorstore::Open(json_spec, context).value();
+    benchmark::DoNotOptimize(store);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_OpenStack)->Range(16, 16 << 10);
+
+}  // namespace
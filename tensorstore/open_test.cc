@@ -0,0 +1,94 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/open.h"
+
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/time/time.h"
+#include "tensorstore/batch.h"
+#include "tensorstore/context.h"
+#include "tensorstore/open_mode.h"
+#include "tensorstore/spec.h"
+#include "tensorstore/staleness_bound.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::Context;
+using ::tensorstore::MatchesStatus;
+using ::tensorstore::OpenMode;
+using ::tensorstore::Spec;
+
+Spec GetSpec(const std::string& path) {
+  return Spec::FromJson({{"driver", "zarr3"},
+                         {"kvstore", {{"driver", "memory"}, {"path", path}}},
+                         {"metadata",
+                          {{"data_type", "uint16"}, {"shape", {4, 5}}}}})
+      .value();
+}
+
+TEST(OpenAllTest, Basic) {
+  auto context = Context::Default();
+  std::vector<Spec> specs;
+  for (int i = 0; i < 3; ++i) {
+    specs.push_back(GetSpec("array" + std::to_string(i) + "/"));
+  }
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto created,
+      tensorstore::OpenAll(specs, context, OpenMode::create).result());
+  ASSERT_EQ(3, created.size());
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto opened,
+      (tensorstore::OpenAll<uint16_t, 2>(
+           specs, context, OpenMode::open,
+           tensorstore::RecheckCachedMetadata::AtOpen(absl::Seconds(60)))
+           .result()));
+  ASSERT_EQ(3, opened.size());
+  for (const auto& store : opened) {
+    EXPECT_EQ(tensorstore::Box<>({4, 5}), store.domain().box());
+  }
+}
+
+TEST(OpenAllTest, ExplicitBatch) {
+  auto context = Context::Default();
+  std::vector<Spec> specs{GetSpec("a/"), GetSpec("b/")};
+  auto batch = tensorstore::Batch::New();
+  auto future = tensorstore::OpenAll(specs, context, OpenMode::create, batch);
+  batch.Release();
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto stores, future.result());
+  EXPECT_EQ(2, stores.size());
+}
+
+TEST(OpenAllTest, Empty) {
+  EXPECT_THAT(tensorstore::OpenAll({}).result(),
+              ::testing::Optional(::testing::IsEmpty()));
+}
+
+TEST(OpenAllTest, Error) {
+  auto context = Context::Default();
+  std::vector<Spec> specs{GetSpec("exists/"), GetSpec("missing/")};
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Open(specs[0], context, OpenMode::create).result());
+  EXPECT_THAT(tensorstore::OpenAll(specs, context, OpenMode::open).result(),
+              MatchesStatus(absl::StatusCode::kNotFound));
+}
+
+}  // namespace
@@ -0,0 +1,81 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/operation_stats.h"
+
+#include <atomic>
+#include <cassert>
+#include <ostream>
+
+#include "absl/time/time.h"
+#include "tensorstore/internal/intrusive_ptr.h"
+#include "tensorstore/internal/tracing/operation_stats.h"
+
+namespace tensorstore {
+
+bool operator==(const OperationStats::Counters& a,
+                const OperationStats::Counters& b) {
+  return a.kvstore_reads == b.kvstore_reads &&
+         a.kvstore_bytes_read == b.kvstore_bytes_read &&
+         a.kvstore_writes == b.kvstore_writes &&
+         a.kvstore_bytes_written == b.kvstore_bytes_written &&
+         a.cache_hits == b.cache_hits && a.cache_misses == b.cache_misses &&
+         a.decode_time == b.decode_time;
+}
+
+std::ostream& operator<<(std::ostream& os, const OperationStats::Counters& a) {
+  return os << "{kvstore_reads=" << a.kvstore_reads
+            << ", kvstore_bytes_read=" << a.kvstore_bytes_read
+            << ", kvstore_writes=" << a.kvstore_writes
+            << ", kvstore_bytes_written=" << a.kvstore_bytes_written
+            << ", cache_hits=" << a.cache_hits
+            << ", cache_misses=" << a.cache_misses
+            << ", decode_time=" << a.decode_time << "}";
+}
+
+OperationStats OperationStats::New() {
+  OperationStats stats;
+  stats.state_ =
+      internal::MakeIntrusivePtr<internal_tracing::OperationStatsState>();
+  return stats;
+}
+
+OperationStats::Counters OperationStats::Get() const {
+  Counters counters;
+  if (!state_) return counters;
+  constexpr auto kOrder = std::memory_order_relaxed;
+  counters.kvstore_reads = state_->kvstore_reads.load(kOrder);
+  counters.kvstore_bytes_read = state_->kvstore_bytes_read.load(kOrder);
+  counters.kvstore_writes = state_->kvstore_writes.load(kOrder);
+  counters.kvstore_bytes_written = state_->kvstore_bytes_written.load(kOrder);
+  counters.cache_hits = state_->cache_hits.load(kOrder);
+  counters.cache_misses = state_->cache_misses.load(kOrder);
+  counters.decode_time =
+      absl::Nanoseconds(state_->decode_nanoseconds.load(kOrder));
+  return counters;
+}
+
+void OperationStats::Reset() {
+  assert(state_);
+  constexpr auto kOrder = std::memory_order_relaxed;
+  state_->kvstore_reads.store(0, kOrder);
+  state_->kvstore_bytes_read.store(0, kOrder);
+  state_->kvstore_writes.store(0, kOrder);
+  state_->kvstore_bytes_written.store(0, kOrder);
+  state_->cache_hits.store(0, kOrder);
+  state_->cache_misses.store(0, kOrder);
+  state_->decode_nanoseconds.store(0, kOrder);
+}
+
+}  // namespace tensorstore
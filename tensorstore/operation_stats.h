@@ -0,0 +1,115 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_OPERATION_STATS_H_
+#define TENSORSTORE_OPERATION_STATS_H_
+
+#include <stdint.h>
+
+#include <iosfwd>
+
+#include "absl/time/time.h"
+#include "tensorstore/internal/tracing/operation_stats.h"
+
+namespace tensorstore {
+
+namespace internal_tracing {
+struct OperationStatsAccess;
+}  // namespace internal_tracing
+
+/// Accumulates I/O statistics for the operations with which it is specified,
+/// e.g. via `ReadOptions`, `WriteOptions`, or `CopyOptions`.
+///
+/// Statistics are accumulated across all work performed on behalf of the
+/// operations, including metadata reads, reads performed by intermediate
+/// layers such as sharded formats, and decoding.  I/O shared by concurrent
+/// operations, e.g. a single cache read that satisfies several operations, is
+/// attributed to the operation that issued it.
+///
+/// The same object may be specified for multiple operations, in which case
+/// their statistics are combined.
+///
+/// \ingroup core
+class OperationStats {
+ public:
+  /// Statistics accumulated by an `OperationStats` object.
+  struct Counters {
+    /// Number of key-value store read requests issued.
+    int64_t kvstore_reads = 0;
+
+    /// Total size of the values returned by key-value store reads.
+    int64_t kvstore_bytes_read = 0;
+
+    /// Number of key-value store write requests issued.
+    int64_t kvstore_writes = 0;
+
+    /// Total size of the values written by key-value store writes.
+    int64_t kvstore_bytes_written = 0;
+
+    /// Number of cache reads satisfied by cached data.
+    int64_t cache_hits = 0;
+
+    /// Number of cache reads that required I/O.
+    int64_t cache_misses = 0;
+
+    /// Total time spent decoding chunks.
+    absl::Duration decode_time = absl::ZeroDuration();
+
+    /// Compares two counter values for equality.
+    friend bool operator==(const Counters& a, const Counters& b);
+    friend bool operator!=(const Counters& a, const Counters& b) {
+      return !(a == b);
+    }
+
+    /// Prints a debugging string representation to an `std::ostream`.
+    friend std::ostream& operator<<(std::ostream& os, const Counters& a);
+  };
+
+  /// Constructs a null object, which does not accumulate statistics.
+  ///
+  /// \id null
+  OperationStats() = default;
+
+  /// Returns a new object with all counters equal to zero.
+  static OperationStats New();
+
+  /// Returns `true` if this is not null.
+  bool valid() const { return static_cast<bool>(state_); }
+
+  /// Returns the current value of the counters.
+  ///
+  /// Returns all zero if this is null.
+  Counters Get() const;
+
+  /// Resets all counters to zero.
+  ///
+  /// \dchecks `valid()`
+  void Reset();
+
+ private:
+  friend struct internal_tracing::OperationStatsAccess;
+  internal_tracing::OperationStatsPtr state_;
+};
+
+namespace internal_tracing {
+struct OperationStatsAccess {
+  static const OperationStatsPtr& state(const OperationStats& stats) {
+    return stats.state_;
+  }
+};
+}  // namespace internal_tracing
+
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_OPERATION_STATS_H_
@@ -0,0 +1,113 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/operation_stats.h"
+
+#include <stdint.h>
+
+#include <gtest/gtest.h>
+#include "absl/time/time.h"
+#include "tensorstore/array.h"
+#include "tensorstore/context.h"
+#include "tensorstore/open.h"
+#include "tensorstore/open_mode.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::Context;
+using ::tensorstore::MakeArray;
+using ::tensorstore::OpenMode;
+using ::tensorstore::OperationStats;
+
+auto OpenStore(const Context& context) {
+  return tensorstore::Open<uint16_t, 2>(
+             {{"driver", "n5"},
+              {"kvstore", {{"driver", "memory"}}},
+              {"recheck_cached_data", false},
+              {"metadata",
+               {{"compression", {{"type", "raw"}}},
+                {"dataType", "uint16"},
+                {"dimensions", {4, 6}},
+                {"blockSize", {2, 3}}}}},
+             context, OpenMode::open_or_create)
+      .result();
+}
+
+TEST(OperationStatsTest, Null) {
+  OperationStats stats;
+  EXPECT_FALSE(stats.valid());
+  EXPECT_EQ(OperationStats::Counters{}, stats.Get());
+}
+
+TEST(OperationStatsTest, New) {
+  auto stats = OperationStats::New();
+  EXPECT_TRUE(stats.valid());
+  EXPECT_EQ(OperationStats::Counters{}, stats.Get());
+}
+
+TEST(OperationStatsTest, ReadWrite) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto context,
+      Context::FromJson({{"cache_pool", {{"total_bytes_limit", 1000000}}}}));
+  // Write using a child context without a cache, which shares the memory
+  // key-value store, such that the chunks are not cached by `context`.
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto write_context_spec,
+      Context::Spec::FromJson({{"cache_pool", {{"total_bytes_limit", 0}}}}));
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(
+      auto write_store, OpenStore(Context(write_context_spec, context)));
+  auto write_stats = OperationStats::New();
+  TENSORSTORE_ASSERT_OK(
+      tensorstore::Write(MakeArray<uint16_t>({{1, 2, 3, 4, 5, 6},
+                                              {7, 8, 9, 10, 11, 12},
+                                              {13, 14, 15, 16, 17, 18},
+                                              {19, 20, 21, 22, 23, 24}}),
+                         write_store, write_stats)
+          .commit_future.result());
+  auto counters = write_stats.Get();
+  EXPECT_EQ(4, counters.kvstore_writes);
+  EXPECT_LT(0, counters.kvstore_bytes_written);
+
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenStore(context));
+  auto read_stats = OperationStats::New();
+  TENSORSTORE_ASSERT_OK(tensorstore::Read(store, read_stats).result());
+  counters = read_stats.Get();
+  EXPECT_LE(4, counters.kvstore_reads);
+  EXPECT_LT(0, counters.kvstore_bytes_read);
+  EXPECT_LE(4, counters.cache_misses);
+  EXPECT_EQ(0, counters.kvstore_writes);
+  EXPECT_LE(absl::ZeroDuration(), counters.decode_time);
+
+  // The second read is satisfied by the cache.
+  read_stats.Reset();
+  EXPECT_EQ(OperationStats::Counters{}, read_stats.Get());
+  TENSORSTORE_ASSERT_OK(tensorstore::Read(store, read_stats).result());
+  counters = read_stats.Get();
+  EXPECT_EQ(0, counters.kvstore_reads);
+  EXPECT_LE(4, counters.cache_hits);
+  EXPECT_EQ(0, counters.cache_misses);
+}
+
+TEST(OperationStatsTest, Combined) {
+  TENSORSTORE_ASSERT_OK_AND_ASSIGN(auto store, OpenStore(Context::Default()));
+  auto stats = OperationStats::New();
+  TENSORSTORE_ASSERT_OK(tensorstore::Read(store, stats).result());
+  auto counters = stats.Get();
+  TENSORSTORE_ASSERT_OK(tensorstore::Read(store, stats).result());
+  EXPECT_EQ(2 * counters.cache_misses, stats.Get().cache_misses);
+}
+
+}  // namespace
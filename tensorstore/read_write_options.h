@@ -15,12 +15,16 @@
 #ifndef TENSORSTORE_READ_WRITE_OPTIONS_H_
 #define TENSORSTORE_READ_WRITE_OPTIONS_H_
 
+#include <stddef.h>
+
 #include <utility>
 
 #include "absl/status/status.h"
+#include "tensorstore/access_recorder.h"
 #include "tensorstore/batch.h"
 #include "tensorstore/contiguous_layout.h"
 #include "tensorstore/index_space/alignment.h"
+#include "tensorstore/operation_stats.h"
 #include "tensorstore/progress.h"
 
 namespace tensorstore {
@@ -47,6 +51,16 @@ struct ReadOptions {
     return absl::OkStatus();
   }
 
+  absl::Status Set(OperationStats value) {
+    this->operation_stats = std::move(value);
+    return absl::OkStatus();
+  }
+
+  absl::Status Set(AccessRecorder value) {
+    this->access_recorder = std::move(value);
+    return absl::OkStatus();
+  }
+
   /// Constrains how the source TensorStore may be aligned to the target array.
   DomainAlignmentOptions alignment_options = DomainAlignmentOptions::all;
 
@@ -55,6 +69,12 @@ struct ReadOptions {
 
   /// Optional batch.
   Batch batch{no_batch};
+
+  /// Optional statistics object that accumulates the I/O performed.
+  OperationStats operation_stats;
+
+  /// Optional recorder of the regions accessed.
+  AccessRecorder access_recorder;
 };
 
 template <>
@@ -69,6 +89,12 @@ constexpr inline bool ReadOptions::IsOption<Batch> = true;
 template <>
 constexpr inline bool ReadOptions::IsOption<Batch::View> = true;
 
+template <>
+constexpr inline bool ReadOptions::IsOption<OperationStats> = true;
+
+template <>
+constexpr inline bool ReadOptions::IsOption<AccessRecorder> = true;
+
 /// Options for `tensorstore::Read` into new array.
 ///
 /// \relates Read[TensorStore]
@@ -91,6 +117,16 @@ struct ReadIntoNewArrayOptions {
     return absl::OkStatus();
   }
 
+  absl::Status Set(OperationStats value) {
+    this->operation_stats = std::move(value);
+    return absl::OkStatus();
+  }
+
+  absl::Status Set(AccessRecorder value) {
+    this->access_recorder = std::move(value);
+    return absl::OkStatus();
+  }
+
   /// Specifies the layout order of the newly-allocated array.  Defaults to
   /// `c_order`.
   ContiguousLayoutOrder layout_order = c_order;
@@ -100,6 +136,12 @@ struct ReadIntoNewArrayOptions {
 
   /// Optional batch.
   Batch batch{no_batch};
+
+  /// Optional statistics object that accumulates the I/O performed.
+  OperationStats operation_stats;
+
+  /// Optional recorder of the regions accessed.
+  AccessRecorder access_recorder;
 };
 
 template <>
@@ -116,6 +158,14 @@ constexpr inline bool ReadIntoNewArrayOptions::IsOption<Batch> = true;
 template <>
 constexpr inline bool ReadIntoNewArrayOptions::IsOption<Batch::View> = true;
 
+template <>
+constexpr inline bool ReadIntoNewArrayOptions::IsOption<OperationStats> =
+    true;
+
+template <>
+constexpr inline bool ReadIntoNewArrayOptions::IsOption<AccessRecorder> =
+    true;
+
 /// Specifies restrictions on how references to the source array/source
 /// TensorStore may be used by write operations.
 ///
@@ -140,6 +190,54 @@ enum SourceDataReferenceRestriction {
   can_reference_source_data_indefinitely = 2,
 };
 
+/// Specifies how `tensorstore::Copy` handles regions of the source TensorStore
+/// for which no data is stored.
+///
+/// Before reading each region of the source corresponding to a chunk of the
+/// target, other than with `read_unstored_source_regions`, the source is
+/// queried with `GetStorageStatistics`.  Regions that are not known to be
+/// unstored, including all regions of sources that do not support storage
+/// statistics, are read normally.
+///
+/// \relates Copy[TensorStore, TensorStore]
+enum UnstoredSourceRegions {
+  /// Reads unstored regions like any other, which yields their fill value.
+  read_unstored_source_regions = 0,
+
+  /// Writes the source fill value to the target without reading the source.
+  fill_unstored_source_regions = 1,
+
+  /// Leaves the target unmodified, neither reading the source nor writing the
+  /// target.
+  skip_unstored_source_regions = 2,
+};
+
+/// Bounds the data in flight during `tensorstore::Copy`.
+///
+/// The chunks of the target are copied in the order in which the target
+/// provides them.  The read of the source region corresponding to a target
+/// chunk starts only once the chunk fits within both windows, except that a
+/// chunk is always started when no other chunk is in flight.  A limit of 0
+/// leaves the corresponding window unbounded.
+///
+/// With a bounded `write_behind_bytes`, the writeback of each target chunk is
+/// started as soon as its data is copied, rather than once the copy completes.
+///
+/// \relates Copy[TensorStore, TensorStore]
+struct CopyWindow {
+  /// Bound on the bytes, in the target data type, of the target chunks whose
+  /// source regions are being read and copied.
+  size_t read_ahead_bytes = 0;
+
+  /// Bound on the bytes of the target chunks that have been copied but whose
+  /// writeback is not yet complete.  Only applies outside of a transaction.
+  size_t write_behind_bytes = 0;
+
+  bool enabled() const {
+    return read_ahead_bytes != 0 || write_behind_bytes != 0;
+  }
+};
+
 /// Options for `tensorstore::Write`.
 ///
 /// \relates Write[Array, TensorStore]
@@ -162,6 +260,16 @@ struct WriteOptions {
     return absl::OkStatus();
   }
 
+  absl::Status Set(OperationStats value) {
+    this->operation_stats = std::move(value);
+    return absl::OkStatus();
+  }
+
+  absl::Status Set(AccessRecorder value) {
+    this->access_recorder = std::move(value);
+    return absl::OkStatus();
+  }
+
   /// Constrains how the source array may be aligned to the target TensorStore.
   DomainAlignmentOptions alignment_options = DomainAlignmentOptions::all;
 
@@ -172,6 +280,12 @@ struct WriteOptions {
   /// opposed to copied).
   SourceDataReferenceRestriction source_data_reference_restriction =
       cannot_reference_source_data;
+
+  /// Optional statistics object that accumulates the I/O performed.
+  OperationStats operation_stats;
+
+  /// Optional recorder of the regions accessed.
+  AccessRecorder access_recorder;
 };
 
 template <>
@@ -184,6 +298,12 @@ template <>
 constexpr inline bool WriteOptions::IsOption<SourceDataReferenceRestriction> =
     true;
 
+template <>
+constexpr inline bool WriteOptions::IsOption<OperationStats> = true;
+
+template <>
+constexpr inline bool WriteOptions::IsOption<AccessRecorder> = true;
+
 /// Options for `tensorstore::Copy`.
 ///
 /// \relates Copy[TensorStore, TensorStore]
@@ -211,6 +331,21 @@ struct CopyOptions {
     return absl::OkStatus();
   }
 
+  absl::Status Set(OperationStats value) {
+    this->operation_stats = std::move(value);
+    return absl::OkStatus();
+  }
+
+  absl::Status Set(UnstoredSourceRegions value) {
+    this->unstored_source_regions = value;
+    return absl::OkStatus();
+  }
+
+  absl::Status Set(CopyWindow value) {
+    this->window = value;
+    return absl::OkStatus();
+  }
+
   /// Constrains how the source TensorStore may be aligned to the target
   /// TensorStore.
   DomainAlignmentOptions alignment_options = DomainAlignmentOptions::all;
@@ -225,6 +360,16 @@ struct CopyOptions {
 
   /// Optional batch for reading.
   Batch batch{no_batch};
+
+  /// Optional statistics object that accumulates the I/O performed.
+  OperationStats operation_stats;
+
+  /// Specifies how regions of the source for which no data is stored are
+  /// handled.
+  UnstoredSourceRegions unstored_source_regions = read_unstored_source_regions;
+
+  /// Bounds the data in flight.
+  CopyWindow window;
 };
 
 template <>
@@ -243,6 +388,15 @@ constexpr inline bool CopyOptions::IsOption<Batch> = true;
 template <>
 constexpr inline bool CopyOptions::IsOption<Batch::View> = true;
 
+template <>
+constexpr inline bool CopyOptions::IsOption<OperationStats> = true;
+
+template <>
+constexpr inline bool CopyOptions::IsOption<UnstoredSourceRegions> = true;
+
+template <>
+constexpr inline bool CopyOptions::IsOption<CopyWindow> = true;
+
 }  // namespace tensorstore
 
 #endif  // TENSORSTORE_READ_WRITE_OPTIONS_H_
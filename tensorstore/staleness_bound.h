@@ -54,6 +54,18 @@ struct RecheckCacheOption {
     return option;
   }
 
+  /// Special time bound equal to `max_age` before the time the TensorStore is
+  /// opened.
+  ///
+  /// This allows cached data (e.g. metadata persisted by the ``cache`` kvstore
+  /// adapter) that was validated recently to be used without revalidation.
+  static constexpr RecheckCacheOption AtOpen(absl::Duration max_age) {
+    RecheckCacheOption option;
+    option.flags = kAtOpen;
+    option.max_age = max_age;
+    return option;
+  }
+
   /// Specifies the kind of time bound.
   enum Flags {
     /// No bound has been specified.
@@ -72,6 +84,10 @@ struct RecheckCacheOption {
   /// Specifies the interpretation of `time`.
   Flags flags = kUnspecified;
 
+  /// If `flags == kAtOpen`, data must not be older than `max_age` before the
+  /// open time.
+  absl::Duration max_age = absl::ZeroDuration();
+
   /// Checks if a bound has been specified.
   constexpr bool specified() const { return flags != kUnspecified; }
 };
@@ -107,6 +123,12 @@ struct RecheckCachedData : public RecheckCacheOption {
   static constexpr RecheckCachedData AtOpen() {
     return RecheckCachedData(RecheckCacheOption::AtOpen());
   }
+
+  /// Special time bound equal to `max_age` before the time the TensorStore is
+  /// opened.
+  static constexpr RecheckCachedData AtOpen(absl::Duration max_age) {
+    return RecheckCachedData(RecheckCacheOption::AtOpen(max_age));
+  }
 };
 
 /// Specifies time bound on cached metadata (as opposed to actual array data).
@@ -124,6 +146,12 @@ struct RecheckCachedMetadata : public RecheckCacheOption {
   static constexpr RecheckCachedMetadata AtOpen() {
     return RecheckCachedMetadata(RecheckCacheOption::AtOpen());
   }
+
+  /// Special time bound equal to `max_age` before the time the TensorStore is
+  /// opened.
+  static constexpr RecheckCachedMetadata AtOpen(absl::Duration max_age) {
+    return RecheckCachedMetadata(RecheckCacheOption::AtOpen(max_age));
+  }
 };
 
 /// Specifies the same time bound for both cached array data and metadata.
@@ -143,6 +171,12 @@ struct RecheckCached : public RecheckCacheOption {
   static constexpr RecheckCached AtOpen() {
     return RecheckCached(RecheckCacheOption::AtOpen());
   }
+
+  /// Special time bound equal to `max_age` before the time the TensorStore is
+  /// opened.
+  static constexpr RecheckCached AtOpen(absl::Duration max_age) {
+    return RecheckCached(RecheckCacheOption::AtOpen(max_age));
+  }
 };
 
 class StalenessBound {
@@ -153,7 +187,8 @@ class StalenessBound {
 
   StalenessBound(RecheckCacheOption option)
       : time(option.time),
-        bounded_by_open_time(option.flags == RecheckCacheOption::kAtOpen) {}
+        bounded_by_open_time(option.flags == RecheckCacheOption::kAtOpen),
+        max_age(option.max_age) {}
 
   StalenessBound(absl::Time newer_than_time) : time(newer_than_time) {}
 
@@ -170,7 +205,7 @@ class StalenessBound {
   StalenessBound BoundAtOpen(absl::Time open_time) const {
     StalenessBound result = *this;
     if (result.bounded_by_open_time) {
-      result.time = open_time;
+      result.time = open_time - result.max_age;
     }
     return result;
   }
@@ -190,8 +225,14 @@ class StalenessBound {
   /// rather than as a timestamp.
   bool bounded_by_open_time = false;
 
+  /// If `bounded_by_open_time == true`, the bound is `max_age` before the open
+  /// time.
+  absl::Duration max_age = absl::ZeroDuration();
+
   friend bool operator==(const StalenessBound& a, const StalenessBound& b) {
-    return a.time == b.time && a.bounded_by_open_time == b.bounded_by_open_time;
+    return a.time == b.time &&
+           a.bounded_by_open_time == b.bounded_by_open_time &&
+           a.max_age == b.max_age;
   }
 
   friend bool operator!=(const StalenessBound& a, const StalenessBound& b) {
@@ -199,7 +240,7 @@ class StalenessBound {
   }
 
   static constexpr auto ApplyMembers = [](auto&& x, auto f) {
-    return f(x.time, x.bounded_by_open_time);
+    return f(x.time, x.bounded_by_open_time, x.max_age);
   };
 };
 
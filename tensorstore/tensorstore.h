@@ -19,6 +19,7 @@
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "tensorstore/array.h"
 #include "tensorstore/array_storage_statistics.h"
@@ -890,6 +891,10 @@ constexpr inline bool CanCopyTensorStoreToTensorStore =
 ///
 /// - `Batch`
 ///
+/// - `UnstoredSourceRegions`
+///
+/// - `CopyWindow`
+///
 /// Example::
 ///
 ///     TensorReader<int32_t, 3> source = ...;
@@ -994,6 +999,48 @@ GetStorageStatistics(const StoreResult& store, Option&&... option) {
   return GetStorageStatistics(store, std::move(options));
 }
 
+/// Returns the regions of the given array that may contain a value in the
+/// closed range ``[inclusive_min, inclusive_max]``, as determined from
+/// per-chunk summaries of the stored values.
+///
+/// Summaries are only available if the array was written with the
+/// ``"chunk_summaries"`` option of the driver spec enabled.  Each returned
+/// transform, applied to `store`, selects the portion of `store`
+/// corresponding to a single chunk; chunks without an up-to-date summary are
+/// always included.  Values of all data types are compared as ``double``.
+///
+/// Example usage::
+///
+///     TENSORSTORE_ASSIGN_OR_RETURN(
+///         auto regions,
+///         GetChunksInValueRange(store, 100, 200).result());
+///     for (const auto& region : regions) {
+///       TENSORSTORE_ASSIGN_OR_RETURN(
+///           auto array, tensorstore::Read(store | region).result());
+///       ...
+///     }
+///
+/// \param store The `TensorStore` to query.  May be `Result`-wrapped.
+/// \param inclusive_min Lower bound of the range of values.
+/// \param inclusive_max Upper bound of the range of values.
+/// \error `absl::StatusCode::kUnimplemented` if the driver does not support
+///     chunk summaries, or if `store` is bound to a transaction.
+/// \relates TensorStore
+/// \membergroup I/O
+template <typename StoreResult>
+std::enable_if_t<internal::IsTensorStore<UnwrapResultType<StoreResult>>,
+                 Future<std::vector<IndexTransform<>>>>
+GetChunksInValueRange(const StoreResult& store, double inclusive_min,
+                      double inclusive_max) {
+  return MapResult(
+      [&](const auto& store) -> Future<std::vector<IndexTransform<>>> {
+        return internal::GetChunksInValueRange(
+            internal::TensorStoreAccess::handle(store),
+            {inclusive_min, inclusive_max});
+      },
+      store);
+}
+
 namespace internal {
 template <typename Element = void, DimensionIndex Rank = dynamic_rank,
           ReadWriteMode Mode = ReadWriteMode::dynamic>
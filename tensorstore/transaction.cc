@@ -16,14 +16,17 @@
 
 #include <stddef.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <ostream>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include "absl/base/optimization.h"
+#include "absl/functional/any_invocable.h"
 #include "absl/functional/function_ref.h"
 #include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
@@ -31,6 +34,8 @@
 #include "absl/types/compare.h"
 #include "tensorstore/internal/intrusive_ptr.h"
 #include "tensorstore/internal/mutex.h"
+#include "tensorstore/internal/thread/task_priority.h"
+#include "tensorstore/internal/thread/thread.h"
 #include "tensorstore/serialization/serialization.h"
 #include "tensorstore/transaction_impl.h"
 #include "tensorstore/util/future.h"
@@ -162,6 +167,85 @@ TransactionState::OpenPtr TransactionState::AcquireOpenPtr() {
   return TransactionState::OpenPtr(this);
 }
 
+void TransactionState::AdmitWrite(size_t bytes,
+                                  absl::AnyInvocable<void() &&> start) {
+  {
+    absl::MutexLock lock(&write_mutex_);
+    pending_writes_.push_back(PendingWrite{bytes, std::move(start)});
+  }
+  StartAdmittedWrites();
+}
+
+void TransactionState::WriteDone(size_t bytes, bool written) {
+  {
+    absl::MutexLock lock(&write_mutex_);
+    assert(writes_in_flight_ > 0);
+    --writes_in_flight_;
+    bytes_in_flight_ -= bytes;
+    if (written) {
+      ++keys_written_;
+      bytes_written_ += bytes;
+    }
+  }
+  StartAdmittedWrites();
+}
+
+void TransactionState::StartAdmittedWrites() {
+  absl::MutexLock lock(&write_mutex_);
+  if (starting_writes_) return;
+  starting_writes_ = true;
+  while (!pending_writes_.empty()) {
+    auto& next = pending_writes_.front();
+    if (writes_in_flight_ != 0 && max_in_flight_write_bytes_ != 0 &&
+        bytes_in_flight_ + next.bytes > max_in_flight_write_bytes_) {
+      break;
+    }
+    ++writes_in_flight_;
+    bytes_in_flight_ += next.bytes;
+    auto start = std::move(next.start);
+    pending_writes_.pop_front();
+    write_mutex_.Unlock();
+    std::move(start)();
+    write_mutex_.Lock();
+  }
+  starting_writes_ = false;
+}
+
+void TransactionState::RequestSpill() {
+  if (spilling_.exchange(true, std::memory_order_acq_rel)) return;
+  internal::Thread::StartDetached(
+      {"tensorstore_transaction_spill"},
+      [self = WeakPtr(this)] { self->SpillNodes(); });
+}
+
+void TransactionState::SpillNodes() {
+  spills_pending_.store(1, std::memory_order_relaxed);
+  std::vector<WeakNodePtrT<Node>> nodes;
+  {
+    absl::MutexLock lock(&mutex_);
+    if (commit_state_ == kOpen || commit_state_ == kOpenAndCommitRequested) {
+      for (auto& node : nodes_) {
+        nodes.emplace_back(&node);
+      }
+    }
+  }
+  for (auto& node : nodes) {
+    spills_pending_.fetch_add(1, std::memory_order_relaxed);
+    if (!node->Spill()) DecrementSpillsPending();
+  }
+  nodes.clear();
+  DecrementSpillsPending();
+}
+
+void TransactionState::DecrementSpillsPending() {
+  if (spills_pending_.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+  next_spill_bytes_.store(
+      std::max(spill_threshold_bytes_,
+               total_bytes() + spill_threshold_bytes_ / 2),
+      std::memory_order_relaxed);
+  spilling_.store(false, std::memory_order_release);
+}
+
 void TransactionState::RequestCommit() {
   {
     absl::MutexLock lock(&mutex_);
@@ -289,6 +373,10 @@ void TransactionState::ExecuteCommitPhase() {
 
 void TransactionState::ContinuePrepareForCommit(Node* node,
                                                 size_t current_phase) {
+  // Writeback is scheduled as background work, so that it does not delay
+  // concurrent reads.
+  internal::ScopedTaskPriority priority_scope(
+      internal::TaskPriority::kBackground);
   while (true) {
     if (!node || node->phase() != current_phase) {
       // End of phase.
@@ -331,6 +419,8 @@ void TransactionState::DecrementNodesPendingReadyForCommit() {
   // counter will just wrap around, but is still guaranteed not to equal 0 until
   // the call to `DecrementNodesPendingCommit` below.
   size_t count = 0;
+  internal::ScopedTaskPriority priority_scope(
+      internal::TaskPriority::kBackground);
   while (true) {
     // Save next node before removing `node`.
     Node* next = Tree::Traverse(*node, Tree::kRight);
@@ -586,6 +676,12 @@ void TransactionState::Node::CommitDone(size_t next_phase) {
 
 void TransactionState::Node::Abort() { AbortDone(); }
 
+bool TransactionState::Node::Spill() { return false; }
+
+void TransactionState::Node::SpillDone() {
+  transaction()->DecrementSpillsPending();
+}
+
 void TransactionState::Node::AbortDone() {
   assert(node_commit_state_.fetch_or(kAbortDone) == (kRegister | kAbort));
   transaction()->DecrementNodesPendingAbort(1);
@@ -649,6 +745,28 @@ Transaction::Transaction(TransactionMode mode) {
                internal::adopt_object_ref);
 }
 
+Transaction::Transaction(TransactionMode mode,
+                         const TransactionOptions& options)
+    : Transaction(mode) {
+  if (state_) {
+    state_->max_in_flight_write_bytes_ = options.max_in_flight_write_bytes;
+    state_->spill_threshold_bytes_ = options.spill_threshold_bytes;
+    state_->spill_kvstore_ = options.spill_kvstore;
+    state_->next_spill_bytes_.store(options.spill_threshold_bytes,
+                                    std::memory_order_relaxed);
+  }
+}
+
+CommitProgress Transaction::commit_progress() const {
+  CommitProgress progress;
+  if (!state_) return progress;
+  absl::MutexLock lock(&state_->write_mutex_);
+  progress.keys_written = state_->keys_written_;
+  progress.bytes_written = state_->bytes_written_;
+  progress.bytes_in_flight = state_->bytes_in_flight_;
+  return progress;
+}
+
 std::ostream& operator<<(std::ostream& os, TransactionMode mode) {
   switch (mode) {
     case TransactionMode::no_transaction_mode:
@@ -24,6 +24,7 @@
 #include <stdint.h>
 
 #include <iosfwd>
+#include <string>
 #include <utility>
 
 #include "absl/status/status.h"
@@ -116,6 +117,51 @@ constexpr inline TransactionMode& operator|=(TransactionMode& a,
 /// \relates TransactionMode
 std::ostream& operator<<(std::ostream& os, TransactionMode mode);
 
+/// Options that control how a transaction is committed.
+///
+/// \relates Transaction
+struct TransactionOptions {
+  /// Maximum number of bytes that may be in the process of being written to
+  /// the underlying key-value stores concurrently while committing.  A write is
+  /// always permitted to start if no other writes are in progress, even if it
+  /// exceeds this limit.  A value of `0` indicates no limit.
+  ///
+  /// Values are encoded concurrently with the writes of previously encoded
+  /// values; this limit only bounds the writes.  It does not apply to
+  /// key-value stores that commit atomically, since in that case all values
+  /// are written together.
+  size_t max_in_flight_write_bytes = 0;
+
+  /// Estimated number of bytes of memory (as reported by `total_bytes`) above
+  /// which modified chunks are spilled to `spill_kvstore` until commit.  A
+  /// value of `0` disables spilling.
+  ///
+  /// Only chunks that have been completely overwritten, and are not currently
+  /// being read or written, are spilled.  Spilling is not performed for
+  /// transactions with `repeatable_read` mode.
+  size_t spill_threshold_bytes = 0;
+
+  /// URL of the key-value store, e.g. ``"file:///scratch/"``, to which chunks
+  /// are spilled when `spill_threshold_bytes` is exceeded.  Spilled values are
+  /// written under unique keys, and are deleted once they are no longer
+  /// needed.
+  std::string spill_kvstore;
+};
+
+/// Progress of a transaction commit.
+///
+/// \relates Transaction
+struct CommitProgress {
+  /// Number of keys successfully written.
+  size_t keys_written = 0;
+
+  /// Number of bytes successfully written.
+  size_t bytes_written = 0;
+
+  /// Number of bytes currently being written.
+  size_t bytes_in_flight = 0;
+};
+
 /// Shared handle to a transaction.
 ///
 /// \ingroup core
@@ -165,6 +211,11 @@ class Transaction {
   /// \id mode
   explicit Transaction(TransactionMode mode);
 
+  /// Creates a new transaction with the specified mode and commit options.
+  ///
+  /// \id mode, options
+  explicit Transaction(TransactionMode mode, const TransactionOptions& options);
+
   /// Returns the transaction mode.
   TransactionMode mode() const {
     return state_ ? state_->mode_ : TransactionMode::no_transaction_mode;
@@ -257,6 +308,14 @@ class Transaction {
     return 0;
   }
 
+  /// Returns the progress of the commit.
+  ///
+  /// Only writes performed non-atomically are reported.  A write is counted in
+  /// `CommitProgress::bytes_in_flight` while in progress, and in
+  /// `CommitProgress::keys_written` and `CommitProgress::bytes_written` once it
+  /// completes successfully.
+  CommitProgress commit_progress() const;
+
   /// Checks if `a` and `b` refer to the same transaction state, or are both
   /// null.
   friend bool operator==(const Transaction& a, const Transaction& b) {
@@ -27,10 +27,13 @@
 #include <stdint.h>
 
 #include <atomic>
+#include <deque>
 #include <functional>
 #include <string>
 #include <string_view>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
 #include "absl/functional/function_ref.h"
 #include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
@@ -450,10 +453,34 @@ class TransactionState {
     /// Adjusts the size in bytes accounted to the transaction by
     /// `new_minus_old`.
     void UpdateSizeInBytes(size_t new_minus_old) {
-      transaction_->total_bytes_.fetch_add(new_minus_old,
-                                           std::memory_order_relaxed);
+      const size_t total_bytes =
+          transaction_->total_bytes_.fetch_add(new_minus_old,
+                                               std::memory_order_relaxed) +
+          new_minus_old;
+      if (transaction_->spill_threshold_bytes_ != 0 &&
+          total_bytes > transaction_->next_spill_bytes_.load(
+                            std::memory_order_relaxed)) {
+        transaction_->RequestSpill();
+      }
     }
 
+    /// Requests that the node reduce the memory occupied by its modifications,
+    /// by writing them to `transaction()->spill_kvstore()`.
+    ///
+    /// Called without any locks held when the size of the transaction exceeds
+    /// `spill_threshold_bytes()`.  The caller holds a reference to the node,
+    /// in addition to the reference owned by the transaction, for the duration
+    /// of the call.
+    ///
+    /// If this returns `true`, `SpillDone` must be called (possibly before
+    /// `Spill` returns) once the spill completes, successfully or not.
+    ///
+    /// The default implementation does nothing and returns `false`.
+    virtual bool Spill();
+
+    /// Must be called after a spill started by `Spill` completes.
+    void SpillDone();
+
     /// Returns a string description of the node,
     /// e.g. `"write to local file xyz"`.
     virtual std::string Describe();
@@ -594,6 +621,30 @@ class TransactionState {
     return total_bytes_.load(std::memory_order_relaxed);
   }
 
+  /// Returns the estimated size in bytes above which modifications are spilled,
+  /// or `0` if spilling is disabled.
+  size_t spill_threshold_bytes() const { return spill_threshold_bytes_; }
+
+  /// Returns the URL of the key-value store to which modifications are
+  /// spilled.
+  const std::string& spill_kvstore() const { return spill_kvstore_; }
+
+  /// Invokes `start` to begin writing `bytes` bytes to a key-value store once
+  /// that would not exceed the in-flight write byte limit of the transaction.
+  /// Writes are started in the order in which they are admitted, and `start`
+  /// may be invoked synchronously.
+  ///
+  /// Once the write completes, `WriteDone` must be called with the same
+  /// `bytes`.
+  void AdmitWrite(size_t bytes, absl::AnyInvocable<void() &&> start);
+
+  /// Indicates that a write started by `AdmitWrite` has completed.
+  ///
+  /// \param bytes The `bytes` passed to `AdmitWrite`.
+  /// \param written Indicates whether the write succeeded, and should be
+  ///     counted in the commit progress.
+  void WriteDone(size_t bytes, bool written);
+
   /// Requests that the transaction be committed.  Has no effect if commit or
   /// abort has already been requested.
   void RequestCommit();
@@ -771,6 +822,22 @@ class TransactionState {
 
   ~TransactionState();
 
+  /// Starts a background thread that calls `Node::Spill` on each node, unless
+  /// one is already running.
+  void RequestSpill();
+
+  /// Calls `Node::Spill` on each node of an open transaction.
+  void SpillNodes();
+
+  /// Decrements `spills_pending_`, and allows another call to `RequestSpill`
+  /// once it reaches 0.
+  void DecrementSpillsPending();
+
+  /// Starts admitted writes queued by `AdmitWrite`.  Writes started
+  /// synchronously by another invocation are handled by the outer invocation
+  /// to avoid unbounded recursion.
+  void StartAdmittedWrites();
+
   absl::Mutex mutex_;
   TransactionMode mode_;
 
@@ -875,6 +942,48 @@ class TransactionState {
   /// Estimated bytes of memory occupied by transaction.
   std::atomic<size_t> total_bytes_;
 
+  /// Maximum number of bytes in flight permitted by `AdmitWrite`, or `0` for
+  /// no limit.
+  size_t max_in_flight_write_bytes_ = 0;
+
+  /// Size in bytes above which modifications are spilled, or `0` if spilling
+  /// is disabled.
+  size_t spill_threshold_bytes_ = 0;
+
+  /// URL of the key-value store to which modifications are spilled.
+  std::string spill_kvstore_;
+
+  /// Value of `total_bytes_` above which `RequestSpill` is called.  Raised
+  /// after each round of spilling if less than half of the threshold was
+  /// freed, to avoid repeatedly visiting nodes that cannot be spilled.
+  std::atomic<size_t> next_spill_bytes_{0};
+
+  /// Indicates that `SpillNodes` is running or spills started by it are
+  /// pending.
+  std::atomic<bool> spilling_{false};
+
+  /// Number of pending spills, plus one while `SpillNodes` is running.
+  std::atomic<size_t> spills_pending_{0};
+
+  /// Protects the write admission state below, independent of `mutex_`.
+  absl::Mutex write_mutex_;
+
+  struct PendingWrite {
+    size_t bytes;
+    absl::AnyInvocable<void() &&> start;
+  };
+
+  /// Writes not yet started by `AdmitWrite`.
+  std::deque<PendingWrite> pending_writes_ ABSL_GUARDED_BY(write_mutex_);
+
+  /// Indicates that `StartAdmittedWrites` is already starting writes.
+  bool starting_writes_ ABSL_GUARDED_BY(write_mutex_) = false;
+
+  size_t writes_in_flight_ ABSL_GUARDED_BY(write_mutex_) = 0;
+  size_t bytes_in_flight_ ABSL_GUARDED_BY(write_mutex_) = 0;
+  size_t keys_written_ ABSL_GUARDED_BY(write_mutex_) = 0;
+  size_t bytes_written_ ABSL_GUARDED_BY(write_mutex_) = 0;
+
   /// Commit state values, indicating the current state of the transaction.
   enum CommitState {
     /// Additional reads or writes may be performed using the transaction.  No
@@ -0,0 +1,175 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/tscli/advise_chunk_layout_command.h"
+
+#include <stdint.h>
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "tensorstore/context.h"
+#include "tensorstore/spec.h"
+#include "tensorstore/tscli/command.h"
+#include "tensorstore/tscli/lib/ts_advise_chunk_layout.h"
+#include "tensorstore/util/json_absl_flag.h"
+
+namespace tensorstore {
+namespace cli {
+namespace {
+
+static constexpr const char kCommand[] =
+    R"(Recommend a chunk layout for a recorded access pattern
+
+Replays the accesses in --trace, as recorded by tensorstore::AccessRecorder,
+against candidate read chunk and shard shapes, and prints the candidates with
+the lowest estimated cost, where each request costs --request_cost_bytes in
+addition to the bytes transferred.
+)";
+
+static constexpr const char kTrace[] =
+    R"(Path of a JSON array of recorded accesses. Required.)";
+
+static constexpr const char kSpec[] =
+    R"(Tensorstore spec of an existing dataset, which determines the domain
+and element size, and whose chunk layout is included as a candidate.)";
+
+static constexpr const char kShape[] =
+    R"(Comma-separated shape of the domain, if --spec is not specified.
+Defaults to the bounding box of the accesses.)";
+
+static constexpr const char kElementSize[] =
+    R"(Size in bytes of each element. Defaults to the data type size of
+--spec, or 1.)";
+
+static constexpr const char kCompressionRatio[] =
+    R"(Ratio of the encoded size of a chunk to its decoded size. Defaults
+to 1.)";
+
+static constexpr const char kRequestCostBytes[] =
+    R"(Cost of each request, as the equivalent number of bytes transferred.
+Defaults to 262144.)";
+
+static constexpr const char kTargetChunkBytes[] =
+    R"(Comma-separated target read chunk sizes in bytes. Defaults to
+262144,1048576,4194304.)";
+
+static constexpr const char kTargetShardBytes[] =
+    R"(Comma-separated target shard sizes in bytes. Defaults to none, such
+that only unsharded layouts are considered.)";
+
+static constexpr const char kNumResults[] =
+    R"(Number of candidates to print. Defaults to 10.)";
+
+absl::Status ParseSizes(std::string_view flag, std::string_view value,
+                        std::vector<int64_t>& sizes) {
+  sizes.clear();
+  for (std::string_view part : absl::StrSplit(value, ',')) {
+    int64_t size;
+    if (!absl::SimpleAtoi(part, &size) || size <= 0) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Invalid ", flag, ": ", value));
+    }
+    sizes.push_back(size);
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+AdviseChunkLayoutCommand::AdviseChunkLayoutCommand()
+    : Command("advise_chunk_layout", kCommand) {
+  parser().AddLongOption("--trace", kTrace, [this](std::string_view value) {
+    options_.trace_path = std::string(value);
+    return absl::OkStatus();
+  });
+  parser().AddLongOption("--spec", kSpec, [this](std::string_view value) {
+    tensorstore::JsonAbslFlag<tensorstore::Spec> spec;
+    std::string error;
+    if (!AbslParseFlag(value, &spec, &error)) {
+      return absl::InvalidArgumentError(error);
+    }
+    options_.spec = spec.value;
+    return absl::OkStatus();
+  });
+  parser().AddLongOption("--shape", kShape, [this](std::string_view value) {
+    return ParseSizes("--shape", value, options_.shape);
+  });
+  parser().AddLongOption(
+      "--element_size", kElementSize, [this](std::string_view value) {
+        if (!absl::SimpleAtoi(value, &options_.element_size) ||
+            options_.element_size <= 0) {
+          return absl::InvalidArgumentError(
+              absl::StrCat("Invalid --element_size: ", value));
+        }
+        return absl::OkStatus();
+      });
+  parser().AddLongOption(
+      "--compression_ratio", kCompressionRatio,
+      [this](std::string_view value) {
+        double& ratio = options_.advisor.cost.compression_ratio;
+        if (!absl::SimpleAtod(value, &ratio) || !(ratio > 0)) {
+          return absl::InvalidArgumentError(
+              absl::StrCat("Invalid --compression_ratio: ", value));
+        }
+        return absl::OkStatus();
+      });
+  parser().AddLongOption(
+      "--request_cost_bytes", kRequestCostBytes,
+      [this](std::string_view value) {
+        double& cost = options_.advisor.cost.request_cost_bytes;
+        if (!absl::SimpleAtod(value, &cost) || !(cost >= 0)) {
+          return absl::InvalidArgumentError(
+              absl::StrCat("Invalid --request_cost_bytes: ", value));
+        }
+        return absl::OkStatus();
+      });
+  parser().AddLongOption(
+      "--target_chunk_bytes", kTargetChunkBytes,
+      [this](std::string_view value) {
+        return ParseSizes("--target_chunk_bytes", value,
+                          options_.advisor.target_chunk_bytes);
+      });
+  parser().AddLongOption(
+      "--target_shard_bytes", kTargetShardBytes,
+      [this](std::string_view value) {
+        return ParseSizes("--target_shard_bytes", value,
+                          options_.advisor.target_shard_bytes);
+      });
+  parser().AddLongOption(
+      "--num_results", kNumResults, [this](std::string_view value) {
+        if (!absl::SimpleAtoi(value, &options_.num_results)) {
+          return absl::InvalidArgumentError(
+              absl::StrCat("Invalid --num_results: ", value));
+        }
+        return absl::OkStatus();
+      });
+}
+
+absl::Status AdviseChunkLayoutCommand::Run(Context::Spec context_spec) {
+  if (options_.trace_path.empty()) {
+    return absl::InvalidArgumentError("Must specify --trace");
+  }
+  tensorstore::Context context(context_spec);
+  return TsAdviseChunkLayout(context, std::cout, options_);
+}
+
+}  // namespace cli
+}  // namespace tensorstore
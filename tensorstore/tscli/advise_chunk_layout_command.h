@@ -0,0 +1,41 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_TSCLI_ADVISE_CHUNK_LAYOUT_COMMAND_H_
+#define TENSORSTORE_TSCLI_ADVISE_CHUNK_LAYOUT_COMMAND_H_
+
+#include "absl/status/status.h"
+#include "tensorstore/context.h"
+#include "tensorstore/tscli/command.h"
+#include "tensorstore/tscli/lib/ts_advise_chunk_layout.h"
+
+namespace tensorstore {
+namespace cli {
+
+// Replay a recorded access trace against candidate chunk layouts, and report
+// the layouts with the lowest estimated cost.
+class AdviseChunkLayoutCommand : public Command {
+ public:
+  AdviseChunkLayoutCommand();
+
+  absl::Status Run(Context::Spec context_spec) override;
+
+ private:
+  TsAdviseChunkLayoutOptions options_;
+};
+
+}  // namespace cli
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_TSCLI_ADVISE_CHUNK_LAYOUT_COMMAND_H_
@@ -19,11 +19,19 @@
 #include <string_view>
 
 #include "absl/status/status.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
 #include "tensorstore/context.h"
+#include "tensorstore/index.h"
 #include "tensorstore/kvstore/spec.h"
+#include "tensorstore/spec.h"
 #include "tensorstore/tscli/command.h"
 #include "tensorstore/tscli/lib/kvstore_copy.h"
+#include "tensorstore/tscli/lib/ts_copy.h"
 #include "tensorstore/util/json_absl_flag.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
 
 /*
 Example usage:
@@ -43,50 +51,151 @@ namespace tensorstore {
 namespace cli {
 namespace {
 
+template <typename T>
+Result<T> ParseSpec(std::string_view value) {
+  tensorstore::JsonAbslFlag<T> spec;
+  std::string error;
+  if (!AbslParseFlag(value, &spec, &error)) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Invalid spec: ", value, " ", error));
+  }
+  return spec.value;
+}
+
 static constexpr const char kCommand[] = R"(Copy a kvstore to another kvstore
 
-All values are copied from the --source to the --target kvstore.
+All values are copied from the --source to the --target kvstore.  With
+--array, the array data of the --source tensorstore is instead copied to the
+--target tensorstore, which may specify a different driver, chunking, and
+encoding; it is created with the domain and data type of the source if it does
+not exist.
 )";
 
-static constexpr const char kSource[] = R"(Source kvstore spec. Required.)";
+static constexpr const char kSource[] =
+    R"(Source kvstore spec, or tensorstore spec with --array. Required.)";
+
+static constexpr const char kTarget[] =
+    R"(Target kvstore spec, or tensorstore spec with --array. Required.)";
+
+static constexpr const char kArray[] =
+    R"(Copy array data between tensorstores, rather than keys between
+kvstores.)";
+
+static constexpr const char kConcurrency[] =
+    R"(Maximum number of keys, or regions with --array, copied concurrently.)";
+
+static constexpr const char kMaxBytesInFlight[] =
+    R"(Maximum total size of the data being copied at once. Defaults to 1GiB.)";
+
+static constexpr const char kCheckpoint[] =
+    R"(Local file recording completed keys or regions.  If the file exists,
+the copy resumes, skipping the keys or regions that it records.)";
+
+static constexpr const char kSkipExisting[] =
+    R"(Skip keys that exist in the target with the same size as in the
+source.)";
 
-static constexpr const char kTarget[] = R"(Target kvstore spec. Required.)";
+static constexpr const char kRegionShape[] =
+    R"(Comma-separated shape of the regions copied with --array. Defaults to the
+write chunk shape of the target.)";
 
 }  // namespace
 
 CopyCommand::CopyCommand() : Command("copy", kCommand) {
   parser().AddLongOption("--source", kSource, [this](std::string_view value) {
-    tensorstore::JsonAbslFlag<tensorstore::kvstore::Spec> spec;
-    std::string error;
-    if (!AbslParseFlag(value, &spec, &error)) {
-      return absl::InvalidArgumentError(error);
-    }
-    source_ = spec.value;
+    source_ = std::string(value);
     return absl::OkStatus();
   });
   parser().AddLongOption("--target", kTarget, [this](std::string_view value) {
-    tensorstore::JsonAbslFlag<tensorstore::kvstore::Spec> spec;
-    std::string error;
-    if (!AbslParseFlag(value, &spec, &error)) {
-      return absl::InvalidArgumentError(error);
-    }
-    target_ = spec.value;
+    target_ = std::string(value);
     return absl::OkStatus();
   });
+  parser().AddBoolOption("--array", kArray, [this]() { array_ = true; });
+  parser().AddBoolOption("--skip_existing", kSkipExisting,
+                         [this]() { skip_existing_ = true; });
+  parser().AddLongOption(
+      "--concurrency", kConcurrency, [this](std::string_view value) {
+        if (!absl::SimpleAtoi(value, &concurrency_) || concurrency_ == 0) {
+          return absl::InvalidArgumentError(
+              absl::StrCat("Invalid --concurrency: ", value));
+        }
+        return absl::OkStatus();
+      });
+  parser().AddLongOption(
+      "--max_bytes_in_flight", kMaxBytesInFlight,
+      [this](std::string_view value) {
+        if (!absl::SimpleAtoi(value, &max_bytes_in_flight_) ||
+            max_bytes_in_flight_ < 0) {
+          return absl::InvalidArgumentError(
+              absl::StrCat("Invalid --max_bytes_in_flight: ", value));
+        }
+        return absl::OkStatus();
+      });
+  parser().AddLongOption("--checkpoint", kCheckpoint,
+                         [this](std::string_view value) {
+                           checkpoint_path_ = std::string(value);
+                           return absl::OkStatus();
+                         });
+  parser().AddLongOption(
+      "--region_shape", kRegionShape, [this](std::string_view value) {
+        region_shape_.clear();
+        for (std::string_view part : absl::StrSplit(value, ',')) {
+          Index size;
+          if (!absl::SimpleAtoi(part, &size) || size <= 0) {
+            return absl::InvalidArgumentError(
+                absl::StrCat("Invalid --region_shape: ", value));
+          }
+          region_shape_.push_back(size);
+        }
+        return absl::OkStatus();
+      });
 }
 
 absl::Status CopyCommand::Run(Context::Spec context_spec) {
-  if (!source_.valid()) {
+  if (source_.empty()) {
     return absl::InvalidArgumentError("Must specify --source");
   }
-  if (!target_.valid()) {
+  if (target_.empty()) {
     return absl::InvalidArgumentError("Must specify --target");
   }
 
   tensorstore::Context context(context_spec);
 
+  if (array_) {
+    if (skip_existing_) {
+      return absl::InvalidArgumentError(
+          "--skip_existing is not supported with --array");
+    }
+    TENSORSTORE_ASSIGN_OR_RETURN(auto source, ParseSpec<Spec>(source_));
+    TENSORSTORE_ASSIGN_OR_RETURN(auto target, ParseSpec<Spec>(target_));
+    TsCopyOptions options;
+    if (concurrency_ != 0) options.concurrency = concurrency_;
+    if (max_bytes_in_flight_ != -1) {
+      options.max_bytes_in_flight = max_bytes_in_flight_;
+    }
+    options.checkpoint_path = checkpoint_path_;
+    options.region_shape = region_shape_;
+    return TsCopy(context, source, target, std::cout, options);
+  }
+
+  if (!region_shape_.empty()) {
+    return absl::InvalidArgumentError(
+        "--region_shape is only supported with --array");
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(auto source,
+                               ParseSpec<kvstore::Spec>(source_));
+  TENSORSTORE_ASSIGN_OR_RETURN(auto target,
+                               ParseSpec<kvstore::Spec>(target_));
+  KvstoreCopyOptions options;
+  if (concurrency_ != 0) options.concurrency = concurrency_;
+  if (max_bytes_in_flight_ != -1) {
+    options.max_bytes_in_flight = max_bytes_in_flight_;
+  }
+  options.checkpoint_path = checkpoint_path_;
+  options.skip_existing = skip_existing_;
+
   // TODO: Use positional args as optional keys.
-  return KvstoreCopy(context, source_, target_, std::cout);
+  return KvstoreCopy(context, source, target, std::cout, options);
 }
 
 }  // namespace cli
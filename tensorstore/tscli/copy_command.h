@@ -15,9 +15,15 @@
 #ifndef TENSORSTORE_TSCLI_COPY_COMMAND_H_
 #define TENSORSTORE_TSCLI_COPY_COMMAND_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
 #include "absl/status/status.h"
 #include "tensorstore/context.h"
-#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/index.h"
 #include "tensorstore/tscli/command.h"
 
 namespace tensorstore {
@@ -28,8 +34,16 @@ class CopyCommand : public Command {
   CopyCommand();
   absl::Status Run(Context::Spec context_spec) override;
 
-  tensorstore::kvstore::Spec source_;
-  tensorstore::kvstore::Spec target_;
+  // Source and target specs, parsed as kvstore or tensorstore specs
+  // depending on `array_`.
+  std::string source_;
+  std::string target_;
+  bool array_ = false;
+  bool skip_existing_ = false;
+  size_t concurrency_ = 0;
+  int64_t max_bytes_in_flight_ = -1;
+  std::string checkpoint_path_;
+  std::vector<Index> region_shape_;
 };
 
 }  // namespace cli
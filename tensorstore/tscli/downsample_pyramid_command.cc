@@ -0,0 +1,122 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/tscli/downsample_pyramid_command.h"
+
+#include <string>
+#include <string_view>
+
+#include "absl/status/status.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include <nlohmann/json.hpp>
+#include "tensorstore/context.h"
+#include "tensorstore/downsample_method.h"
+#include "tensorstore/driver/downsample/downsample_method_json_binder.h"
+#include "tensorstore/index.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/spec.h"
+#include "tensorstore/tscli/command.h"
+#include "tensorstore/tscli/lib/ts_downsample_pyramid.h"
+#include "tensorstore/util/json_absl_flag.h"
+
+namespace tensorstore {
+namespace cli {
+namespace {
+
+static constexpr const char kCommand[] =
+    R"(Write a multi-level downsample pyramid
+
+Each positional tensorstore spec is written by downsampling the preceding
+level (or --source, for the first level) by --factors.  The source is read
+only once; all levels are computed from it simultaneously.
+)";
+
+static constexpr const char kSource[] =
+    R"(Source tensorstore spec. Required.)";
+
+static constexpr const char kFactors[] =
+    R"(Comma-separated downsample factors of each level relative to the
+preceding level, e.g. 2,2,1. Required.)";
+
+static constexpr const char kMethod[] =
+    R"(Downsample method: stride, mean, median, mode, min, or max.
+Defaults to mean.)";
+
+}  // namespace
+
+DownsamplePyramidCommand::DownsamplePyramidCommand()
+    : Command("downsample_pyramid", kCommand) {
+  parser().AddLongOption("--source", kSource, [this](std::string_view value) {
+    tensorstore::JsonAbslFlag<tensorstore::Spec> spec;
+    std::string error;
+    if (!AbslParseFlag(value, &spec, &error)) {
+      return absl::InvalidArgumentError(error);
+    }
+    source_ = spec.value;
+    return absl::OkStatus();
+  });
+  parser().AddLongOption("--factors", kFactors, [this](std::string_view value) {
+    downsample_factors_.clear();
+    for (std::string_view part : absl::StrSplit(value, ',')) {
+      Index factor;
+      if (!absl::SimpleAtoi(part, &factor) || factor <= 0) {
+        return absl::InvalidArgumentError(
+            absl::StrCat("Invalid downsample factors: ", value));
+      }
+      downsample_factors_.push_back(factor);
+    }
+    return absl::OkStatus();
+  });
+  parser().AddLongOption("--method", kMethod, [this](std::string_view value) {
+    auto method = internal_json_binding::FromJson<DownsampleMethod>(
+        ::nlohmann::json(value));
+    if (!method.ok()) return method.status();
+    method_ = *method;
+    return absl::OkStatus();
+  });
+  parser().AddPositionalArgs(
+      "level spec",
+      "Tensorstore spec of each level, in order of decreasing resolution",
+      [this](std::string_view value) {
+        tensorstore::JsonAbslFlag<tensorstore::Spec> spec;
+        std::string error;
+        if (!AbslParseFlag(value, &spec, &error)) {
+          return absl::InvalidArgumentError(
+              absl::StrCat("Invalid spec: ", value, " ", error));
+        }
+        levels_.push_back(spec.value);
+        return absl::OkStatus();
+      });
+}
+
+absl::Status DownsamplePyramidCommand::Run(Context::Spec context_spec) {
+  if (!source_) {
+    return absl::InvalidArgumentError("Must specify --source");
+  }
+  if (downsample_factors_.empty()) {
+    return absl::InvalidArgumentError("Must specify --factors");
+  }
+  if (levels_.empty()) {
+    return absl::InvalidArgumentError("Must specify at least one level spec");
+  }
+
+  tensorstore::Context context(context_spec);
+  return TsDownsamplePyramid(context, *source_, levels_, downsample_factors_,
+                             method_);
+}
+
+}  // namespace cli
+}  // namespace tensorstore
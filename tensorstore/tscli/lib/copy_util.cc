@@ -0,0 +1,105 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/tscli/lib/copy_util.h"
+
+#include <stdint.h>
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/synchronization/mutex.h"
+#include <nlohmann/json.hpp>
+
+namespace tensorstore {
+namespace cli {
+
+void CopyThrottle::Acquire(int64_t bytes) {
+  struct Request {
+    CopyThrottle* self;
+    int64_t bytes;
+  };
+  Request request{this, bytes};
+  absl::MutexLock lock(&mutex_);
+  mutex_.Await(absl::Condition(
+      +[](Request* request) ABSL_NO_THREAD_SAFETY_ANALYSIS {
+        auto& self = *request->self;
+        if (self.in_flight_ == 0) return true;
+        if (self.in_flight_ >= self.max_in_flight_) return false;
+        return self.max_bytes_in_flight_ == 0 ||
+               self.bytes_in_flight_ + request->bytes <=
+                   self.max_bytes_in_flight_;
+      },
+      &request));
+  ++in_flight_;
+  bytes_in_flight_ += bytes;
+}
+
+void CopyThrottle::Release(int64_t bytes) {
+  absl::MutexLock lock(&mutex_);
+  --in_flight_;
+  bytes_in_flight_ -= bytes;
+}
+
+absl::Status CopyCheckpoint::Open(const std::string& path) {
+  absl::MutexLock lock(&mutex_);
+  std::string contents;
+  {
+    std::ifstream in(path, std::ios::in | std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(in),
+                    std::istreambuf_iterator<char>());
+  }
+  for (std::string_view line : absl::StrSplit(contents, '\n')) {
+    auto j = ::nlohmann::json::parse(line, nullptr,
+                                     /*allow_exceptions=*/false);
+    if (!j.is_string()) continue;
+    if (completed_.insert(j.get<std::string>()).second) ++num_loaded_;
+  }
+  file_.open(path, std::ios::out | std::ios::app | std::ios::binary);
+  if (!file_) {
+    return absl::UnavailableError(
+        absl::StrCat("Failed to open checkpoint file: ", path));
+  }
+  // Terminate a truncated final line, such that it is not combined with the
+  // next record.
+  if (!contents.empty() && contents.back() != '\n') file_ << '\n';
+  return absl::OkStatus();
+}
+
+bool CopyCheckpoint::Contains(std::string_view item) const {
+  absl::MutexLock lock(&mutex_);
+  return completed_.contains(item);
+}
+
+absl::Status CopyCheckpoint::Record(std::string_view item) {
+  absl::MutexLock lock(&mutex_);
+  completed_.insert(std::string(item));
+  if (!file_.is_open()) return absl::OkStatus();
+  // Each line is flushed, such that at most the final line is lost on
+  // interruption.
+  file_ << ::nlohmann::json(item).dump() << std::endl;
+  if (!file_) {
+    return absl::UnavailableError("Failed to write checkpoint file");
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace cli
+}  // namespace tensorstore
@@ -0,0 +1,88 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_TSCLI_LIB_COPY_UTIL_H_
+#define TENSORSTORE_TSCLI_LIB_COPY_UTIL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+
+namespace tensorstore {
+namespace cli {
+
+// Limits the number of operations, and the total size of the data, in flight
+// at once.
+class CopyThrottle {
+ public:
+  // A `max_bytes_in_flight` of `0` means no byte limit.
+  CopyThrottle(size_t max_in_flight, int64_t max_bytes_in_flight)
+      : max_in_flight_(max_in_flight),
+        max_bytes_in_flight_(max_bytes_in_flight) {}
+
+  // Blocks until an operation of `bytes` may start.  An operation is always
+  // admitted when none are in flight, even if it exceeds the byte limit.
+  void Acquire(int64_t bytes);
+
+  // Signals completion of an operation previously admitted by `Acquire`.
+  void Release(int64_t bytes);
+
+ private:
+  absl::Mutex mutex_;
+  size_t max_in_flight_;
+  int64_t max_bytes_in_flight_;
+  size_t in_flight_ ABSL_GUARDED_BY(mutex_) = 0;
+  int64_t bytes_in_flight_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+// Set of completed items persisted to a local file, such that an interrupted
+// copy can be resumed.
+//
+// The file contains one JSON-encoded string per line, and is appended to as
+// items complete.  A truncated final line, as left by an interruption, is
+// ignored.
+class CopyCheckpoint {
+ public:
+  // Opens the checkpoint at `path`, loading any previously completed items.
+  // If `Open` is not called, completed items are not persisted.
+  absl::Status Open(const std::string& path);
+
+  // Returns `true` if `item` was recorded as completed.
+  bool Contains(std::string_view item) const;
+
+  // Records `item` as completed.  Safe to call concurrently.
+  absl::Status Record(std::string_view item);
+
+  // Number of items loaded when the checkpoint was opened.
+  size_t num_loaded() const { return num_loaded_; }
+
+ private:
+  mutable absl::Mutex mutex_;
+  std::ofstream file_ ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_set<std::string> completed_ ABSL_GUARDED_BY(mutex_);
+  size_t num_loaded_ = 0;
+};
+
+}  // namespace cli
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_TSCLI_LIB_COPY_UTIL_H_
@@ -0,0 +1,73 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/tscli/lib/copy_util.h"
+
+#include <fstream>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "tensorstore/internal/testing/scoped_directory.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::cli::CopyCheckpoint;
+using ::tensorstore::cli::CopyThrottle;
+using ::tensorstore::internal_testing::ScopedTemporaryDirectory;
+
+TEST(CopyCheckpointTest, NotPersisted) {
+  CopyCheckpoint checkpoint;
+  EXPECT_FALSE(checkpoint.Contains("a"));
+  TENSORSTORE_EXPECT_OK(checkpoint.Record("a"));
+  EXPECT_TRUE(checkpoint.Contains("a"));
+  EXPECT_EQ(0, checkpoint.num_loaded());
+}
+
+TEST(CopyCheckpointTest, Resume) {
+  ScopedTemporaryDirectory tempdir;
+  const std::string path = tempdir.path() + "/checkpoint";
+  {
+    CopyCheckpoint checkpoint;
+    TENSORSTORE_ASSERT_OK(checkpoint.Open(path));
+    EXPECT_EQ(0, checkpoint.num_loaded());
+    TENSORSTORE_EXPECT_OK(checkpoint.Record("a"));
+    TENSORSTORE_EXPECT_OK(checkpoint.Record("b\nc"));
+  }
+  // Simulate an interruption while writing a line.
+  {
+    std::ofstream file(path, std::ios::out | std::ios::app);
+    file << "\"trunc";
+  }
+  CopyCheckpoint checkpoint;
+  TENSORSTORE_ASSERT_OK(checkpoint.Open(path));
+  EXPECT_EQ(2, checkpoint.num_loaded());
+  EXPECT_TRUE(checkpoint.Contains("a"));
+  EXPECT_TRUE(checkpoint.Contains("b\nc"));
+  EXPECT_FALSE(checkpoint.Contains("b"));
+  EXPECT_FALSE(checkpoint.Contains("trunc"));
+}
+
+TEST(CopyThrottleTest, AdmitsOversizedWhenIdle) {
+  CopyThrottle throttle(/*max_in_flight=*/2, /*max_bytes_in_flight=*/10);
+  throttle.Acquire(100);
+  throttle.Release(100);
+  throttle.Acquire(5);
+  throttle.Acquire(5);
+  throttle.Release(5);
+  throttle.Release(5);
+}
+
+}  // namespace
@@ -14,10 +14,16 @@
 
 #include "tensorstore/tscli/lib/kvstore_copy.h"
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
 #include <iostream>
-#include <optional>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
 #include "tensorstore/context.h"
@@ -26,10 +32,12 @@
 #include "tensorstore/kvstore/operations.h"
 #include "tensorstore/kvstore/read_result.h"
 #include "tensorstore/kvstore/spec.h"
+#include "tensorstore/tscli/lib/copy_util.h"
 #include "tensorstore/util/executor.h"
 #include "tensorstore/util/future.h"
 #include "tensorstore/util/quote_string.h"
 #include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
 
 namespace tensorstore {
 namespace cli {
@@ -37,7 +45,8 @@ namespace cli {
 absl::Status KvstoreCopy(Context context,
                          tensorstore::kvstore::Spec source_spec,
                          tensorstore::kvstore::Spec target_spec,
-                         std::ostream& output) {
+                         std::ostream& output,
+                         const KvstoreCopyOptions& options) {
   static absl::Mutex log_mutex;
 
   TENSORSTORE_ASSIGN_OR_RETURN(auto source,
@@ -45,14 +54,52 @@ absl::Status KvstoreCopy(Context context,
   TENSORSTORE_ASSIGN_OR_RETURN(auto target,
                                kvstore::Open(target_spec, context).result());
 
+  CopyCheckpoint checkpoint;
+  if (!options.checkpoint_path.empty()) {
+    TENSORSTORE_RETURN_IF_ERROR(checkpoint.Open(options.checkpoint_path));
+    if (checkpoint.num_loaded() > 0) {
+      absl::MutexLock lock(&log_mutex);
+      output << "Resuming: " << checkpoint.num_loaded()
+             << " keys previously copied" << std::endl;
+    }
+  }
+
   TENSORSTORE_ASSIGN_OR_RETURN(auto list_entries,
                                kvstore::ListFuture(source).result());
 
+  absl::flat_hash_map<std::string, int64_t> target_sizes;
+  if (options.skip_existing) {
+    TENSORSTORE_ASSIGN_OR_RETURN(auto target_entries,
+                                 kvstore::ListFuture(target).result());
+    for (auto& entry : target_entries) {
+      target_sizes.emplace(std::move(entry.key), entry.size);
+    }
+  }
+
+  CopyThrottle throttle(std::max<size_t>(1, options.concurrency),
+                        options.max_bytes_in_flight);
   std::vector<Future<const void>> write_futures;
   write_futures.reserve(list_entries.size());
 
   for (const auto& entry : list_entries) {
-    write_futures.push_back(MapFutureValue(
+    if (checkpoint.Contains(entry.key)) continue;
+    if (options.skip_existing && entry.has_size()) {
+      auto it = target_sizes.find(entry.key);
+      if (it != target_sizes.end() && it->second == entry.size) {
+        {
+          absl::MutexLock lock(&log_mutex);
+          output << "Skipped: " << tensorstore::QuoteString(entry.key)
+                 << std::endl;
+        }
+        TENSORSTORE_RETURN_IF_ERROR(checkpoint.Record(entry.key));
+        continue;
+      }
+    }
+
+    // Values of unknown size are only limited by `concurrency`.
+    const int64_t bytes = entry.has_size() ? entry.size : 0;
+    throttle.Acquire(bytes);
+    auto copy_future = MapFutureValue(
         InlineExecutor{},
         [&output, &target, key = entry.key](
             const Result<kvstore::ReadResult>& read_result) -> Future<void> {
@@ -60,6 +107,7 @@ absl::Status KvstoreCopy(Context context,
             absl::MutexLock lock(&log_mutex);
             output << "Error reading: " << tensorstore::QuoteString(key) << ": "
                    << read_result.status() << std::endl;
+            return read_result.status();
           }
           if (!read_result->has_value()) {
             return absl::OkStatus();
@@ -87,7 +135,18 @@ absl::Status KvstoreCopy(Context context,
               },
               kvstore::Write(target, key, read_result->value));
         },
-        kvstore::Read(source, entry.key)));
+        kvstore::Read(source, entry.key));
+    // Completion is recorded before the returned future becomes ready, such
+    // that `throttle` and `checkpoint` outlive all uses.
+    write_futures.push_back(MapFuture(
+        InlineExecutor{},
+        [&throttle, &checkpoint, key = entry.key,
+         bytes](const Result<void>& result) -> Result<void> {
+          throttle.Release(bytes);
+          TENSORSTORE_RETURN_IF_ERROR(result);
+          return checkpoint.Record(key);
+        },
+        std::move(copy_future)));
   }
 
   absl::Status status = absl::OkStatus();
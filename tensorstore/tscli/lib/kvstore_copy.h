@@ -15,7 +15,11 @@
 #ifndef TENSORSTORE_TSCLI_LIB_KVSTORE_COPY_H_
 #define TENSORSTORE_TSCLI_LIB_KVSTORE_COPY_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <ostream>
+#include <string>
 
 #include "absl/status/status.h"
 #include "tensorstore/context.h"
@@ -24,10 +28,31 @@
 namespace tensorstore {
 namespace cli {
 
+struct KvstoreCopyOptions {
+  // Maximum number of keys copied concurrently.
+  size_t concurrency = 64;
+
+  // Maximum total size of the values being copied at once, or `0` for no
+  // limit.  A single value larger than this limit is still copied.
+  int64_t max_bytes_in_flight = 1024 * 1024 * 1024;
+
+  // Path of a local file recording the keys that have been copied.  If
+  // specified, keys recorded by a previous, interrupted copy are skipped.
+  std::string checkpoint_path;
+
+  // Skip keys that are already present in the target with the same size as
+  // in the source.  Storage generations are specific to each kvstore, and
+  // therefore cannot be compared across kvstores.
+  bool skip_existing = false;
+};
+
+// Copies all keys from `source_spec` to `target_spec`, logging progress to
+// `output`.
 absl::Status KvstoreCopy(Context context,
                          tensorstore::kvstore::Spec source_spec,
                          tensorstore::kvstore::Spec target_spec,
-                         std::ostream& output);
+                         std::ostream& output,
+                         const KvstoreCopyOptions& options = {});
 
 }  // namespace cli
 }  // namespace tensorstore
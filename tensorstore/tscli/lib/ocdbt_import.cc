@@ -0,0 +1,90 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/tscli/lib/ocdbt_import.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "tensorstore/context.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/ocdbt/bulk_load.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/quote_string.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace cli {
+namespace {
+
+// Number of source keys read concurrently.
+constexpr size_t kReadWindow = 64;
+
+}  // namespace
+
+absl::Status OcdbtImport(Context context,
+                         tensorstore::kvstore::Spec source_spec,
+                         tensorstore::kvstore::Spec target_spec,
+                         std::ostream& output) {
+  TENSORSTORE_ASSIGN_OR_RETURN(auto source,
+                               kvstore::Open(source_spec, context).result());
+  TENSORSTORE_ASSIGN_OR_RETURN(auto target,
+                               kvstore::Open(target_spec, context).result());
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto loader, internal_ocdbt::OpenBulkLoader(target).result());
+
+  TENSORSTORE_ASSIGN_OR_RETURN(auto list_entries,
+                               kvstore::ListFuture(source).result());
+  std::vector<std::string> keys;
+  keys.reserve(list_entries.size());
+  for (auto& entry : list_entries) {
+    keys.push_back(std::move(entry.key));
+  }
+  list_entries.clear();
+  std::sort(keys.begin(), keys.end());
+
+  // Values must be added in key order, but reading a bounded window of them
+  // concurrently hides the latency of the source.
+  std::vector<Future<kvstore::ReadResult>> reads;
+  for (size_t start = 0; start < keys.size(); start += kReadWindow) {
+    size_t end = std::min(keys.size(), start + kReadWindow);
+    reads.clear();
+    for (size_t i = start; i < end; ++i) {
+      reads.push_back(kvstore::Read(source, keys[i]));
+    }
+    for (size_t i = start; i < end; ++i) {
+      TENSORSTORE_ASSIGN_OR_RETURN(auto read_result,
+                                   reads[i - start].result());
+      if (!read_result.has_value()) continue;
+      TENSORSTORE_RETURN_IF_ERROR(
+          loader->Add(keys[i], std::move(read_result.value)));
+    }
+  }
+
+  TENSORSTORE_RETURN_IF_ERROR(loader->Commit().result());
+  output << "Imported " << loader->num_keys() << " keys into "
+         << tensorstore::QuoteString(target_spec.path) << std::endl;
+  return absl::OkStatus();
+}
+
+}  // namespace cli
+}  // namespace tensorstore
@@ -0,0 +1,173 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/tscli/lib/ts_advise_chunk_layout.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_join.h"
+#include <nlohmann/json.hpp>
+#include "riegeli/bytes/fd_reader.h"
+#include "riegeli/bytes/read_all.h"
+#include "tensorstore/access_recorder.h"
+#include "tensorstore/box.h"
+#include "tensorstore/chunk_layout.h"
+#include "tensorstore/context.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_interval.h"
+#include "tensorstore/internal/chunk_layout_advisor.h"
+#include "tensorstore/internal/json_binding/json_binding.h"
+#include "tensorstore/internal/json_binding/std_array.h"
+#include "tensorstore/open.h"
+#include "tensorstore/open_mode.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace cli {
+namespace {
+
+namespace jb = ::tensorstore::internal_json_binding;
+
+using Access = AccessRecorder::Access;
+
+Result<std::vector<Access>> ReadTrace(const std::string& path) {
+  std::string data;
+  TENSORSTORE_RETURN_IF_ERROR(riegeli::ReadAll(riegeli::FdReader(path), data));
+  auto j = ::nlohmann::json::parse(data, nullptr, false);
+  if (j.is_discarded()) {
+    return absl::InvalidArgumentError(
+        absl::StrFormat("Failed to parse %s as JSON", path));
+  }
+  return jb::FromJson<std::vector<Access>>(std::move(j), jb::Array());
+}
+
+// Returns the bounding box of `accesses`.
+Result<Box<>> GetBoundingBox(span<const Access> accesses) {
+  if (accesses.empty()) {
+    return absl::InvalidArgumentError(
+        "Must specify --shape or --spec for an empty trace");
+  }
+  Box<> bounds = accesses[0].region;
+  for (const auto& access : accesses) {
+    if (access.region.rank() != bounds.rank()) {
+      return absl::InvalidArgumentError(
+          tensorstore::StrCat("Access ", access.region,
+                              " does not match rank ", bounds.rank()));
+    }
+    for (DimensionIndex i = 0; i < bounds.rank(); ++i) {
+      bounds[i] = Hull(bounds[i], access.region[i]);
+    }
+  }
+  return bounds;
+}
+
+// Returns the chunk shapes of `layout`, or an empty candidate if they are not
+// fully constrained.
+internal::ChunkLayoutCandidate GetCandidate(const ChunkLayout& layout) {
+  internal::ChunkLayoutCandidate candidate;
+  auto read_chunk_shape = layout.read_chunk_shape();
+  auto write_chunk_shape = layout.write_chunk_shape();
+  for (DimensionIndex i = 0; i < layout.rank(); ++i) {
+    if (read_chunk_shape[i] <= 0 || write_chunk_shape[i] <= 0) return {};
+  }
+  candidate.read_chunk_shape.assign(read_chunk_shape.begin(),
+                                    read_chunk_shape.end());
+  candidate.write_chunk_shape.assign(write_chunk_shape.begin(),
+                                     write_chunk_shape.end());
+  candidate.description = "current";
+  return candidate;
+}
+
+std::string FormatBytes(double bytes) {
+  return absl::StrFormat("%.1f MB", bytes / 1e6);
+}
+
+}  // namespace
+
+absl::Status TsAdviseChunkLayout(Context context, std::ostream& output,
+                                 const TsAdviseChunkLayoutOptions& options) {
+  TENSORSTORE_ASSIGN_OR_RETURN(auto accesses, ReadTrace(options.trace_path));
+
+  Box<> domain;
+  auto advisor_options = options.advisor;
+  advisor_options.cost.element_size =
+      options.element_size > 0 ? options.element_size : 1;
+  if (options.spec) {
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto store,
+        tensorstore::Open(*options.spec, context,
+                          tensorstore::ReadWriteMode::read,
+                          tensorstore::OpenMode::open)
+            .result());
+    domain = store.domain().box();
+    if (options.element_size <= 0) {
+      advisor_options.cost.element_size = store.dtype().size();
+    }
+    TENSORSTORE_ASSIGN_OR_RETURN(auto layout, store.chunk_layout());
+    if (auto candidate = GetCandidate(layout);
+        !candidate.read_chunk_shape.empty()) {
+      advisor_options.candidates.push_back(std::move(candidate));
+    }
+  } else if (!options.shape.empty()) {
+    domain = Box<>(options.shape);
+  } else {
+    TENSORSTORE_ASSIGN_OR_RETURN(domain, GetBoundingBox(accesses));
+  }
+
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto recommendations,
+      internal::RecommendChunkLayouts(accesses, domain, advisor_options));
+
+  output << "Trace: " << accesses.size() << " accesses, domain " << domain
+         << std::endl;
+  const size_t num_results =
+      std::min(options.num_results, recommendations.size());
+  for (size_t i = 0; i < num_results; ++i) {
+    const auto& [candidate, estimate] = recommendations[i];
+    output << absl::StrFormat("%d. %s: read_chunk_shape=[%s]", i + 1,
+                              candidate.description,
+                              absl::StrJoin(candidate.read_chunk_shape, ","));
+    if (candidate.sharded()) {
+      output << " write_chunk_shape=["
+             << absl::StrJoin(candidate.write_chunk_shape, ",") << "]";
+    }
+    output << std::endl
+           << absl::StrFormat(
+                  "   cost %s; reads %.0f (%s, amplification %.2f); "
+                  "writes %.0f (%s)",
+                  FormatBytes(estimate.cost), estimate.read_requests,
+                  FormatBytes(estimate.bytes_read),
+                  estimate.read_amplification, estimate.write_requests,
+                  FormatBytes(estimate.bytes_written))
+           << std::endl;
+  }
+  if (recommendations.empty()) return absl::OkStatus();
+
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto layout, recommendations.front().candidate.ToChunkLayout());
+  output << "Recommended chunk_layout: " << layout << std::endl;
+  return absl::OkStatus();
+}
+
+}  // namespace cli
+}  // namespace tensorstore
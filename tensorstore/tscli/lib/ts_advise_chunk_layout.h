@@ -0,0 +1,65 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_TSCLI_LIB_TS_ADVISE_CHUNK_LAYOUT_H_
+#define TENSORSTORE_TSCLI_LIB_TS_ADVISE_CHUNK_LAYOUT_H_
+
+#include <stddef.h>
+
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "tensorstore/context.h"
+#include "tensorstore/index.h"
+#include "tensorstore/internal/chunk_layout_advisor.h"
+#include "tensorstore/spec.h"
+
+namespace tensorstore {
+namespace cli {
+
+struct TsAdviseChunkLayoutOptions {
+  // Path of a file containing a JSON array of accesses, as recorded by
+  // `AccessRecorder`.
+  std::string trace_path;
+
+  // Existing TensorStore whose domain, data type, and chunk layout are used.
+  std::optional<tensorstore::Spec> spec;
+
+  // Shape of the domain, if `spec` is not specified.  If empty, defaults to
+  // the bounding box of the accesses.
+  std::vector<Index> shape;
+
+  // Size in bytes of each element.  If zero, defaults to the data type size
+  // of `spec`, or 1.
+  Index element_size = 0;
+
+  // Number of candidates printed.
+  size_t num_results = 10;
+
+  internal::ChunkLayoutAdvisorOptions advisor;
+};
+
+// Replays the trace at `options.trace_path` against candidate chunk layouts,
+// and writes to `output` the candidates with the lowest estimated cost,
+// followed by the chunk layout of the best candidate.
+absl::Status TsAdviseChunkLayout(Context context, std::ostream& output,
+                                 const TsAdviseChunkLayoutOptions& options);
+
+}  // namespace cli
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_TSCLI_LIB_TS_ADVISE_CHUNK_LAYOUT_H_
@@ -0,0 +1,205 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/tscli/lib/ts_copy.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorstore/box.h"
+#include "tensorstore/chunk_layout.h"
+#include "tensorstore/context.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_interval.h"
+#include "tensorstore/index_space/dim_expression.h"
+#include "tensorstore/open.h"
+#include "tensorstore/open_mode.h"
+#include "tensorstore/spec.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/tscli/lib/copy_util.h"
+#include "tensorstore/util/division.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace cli {
+namespace {
+
+// Returns the shape of each region, and the origin of the region grid.
+absl::Status GetRegionGrid(const TensorStore<>& target,
+                           const TsCopyOptions& options,
+                           std::vector<Index>& region_shape,
+                           std::vector<Index>& grid_origin) {
+  const DimensionIndex rank = target.rank();
+  region_shape.assign(rank, 0);
+  grid_origin.assign(rank, 0);
+  if (!options.region_shape.empty()) {
+    if (static_cast<DimensionIndex>(options.region_shape.size()) != rank) {
+      return absl::InvalidArgumentError(absl::StrCat(
+          "Region shape has rank ", options.region_shape.size(),
+          " but target has rank ", rank));
+    }
+    region_shape = options.region_shape;
+  } else {
+    TENSORSTORE_ASSIGN_OR_RETURN(auto layout, target.chunk_layout());
+    auto write_chunk_shape = layout.write_chunk_shape();
+    auto layout_grid_origin = layout.grid_origin();
+    for (DimensionIndex i = 0; i < rank; ++i) {
+      if (write_chunk_shape.valid() && write_chunk_shape[i] > 0) {
+        region_shape[i] = write_chunk_shape[i];
+      }
+      if (layout_grid_origin.valid() &&
+          layout_grid_origin[i] != kImplicit) {
+        grid_origin[i] = layout_grid_origin[i];
+      }
+    }
+  }
+  // Unchunked dimensions are copied in their entirety.
+  const auto domain = target.domain().box();
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    if (region_shape[i] <= 0) {
+      region_shape[i] = std::max(Index(1), domain[i].size());
+      grid_origin[i] = domain[i].inclusive_min();
+    }
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+absl::Status TsCopy(Context context, tensorstore::Spec source,
+                    tensorstore::Spec target, std::ostream& output,
+                    const TsCopyOptions& options) {
+  static absl::Mutex log_mutex;
+
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto source_ts,
+      tensorstore::Open(source, context, tensorstore::ReadWriteMode::read,
+                        tensorstore::OpenMode::open)
+          .result());
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto target_ts,
+      tensorstore::Open(target, context, tensorstore::ReadWriteMode::write,
+                        tensorstore::OpenMode::open_or_create,
+                        source_ts.domain(), source_ts.dtype())
+          .result());
+
+  const auto domain = target_ts.domain().box();
+  if (!IsFinite(domain)) {
+    return absl::InvalidArgumentError(
+        tensorstore::StrCat("Cannot copy unbounded domain: ", domain));
+  }
+  if (domain.is_empty()) return absl::OkStatus();
+
+  std::vector<Index> region_shape, grid_origin;
+  TENSORSTORE_RETURN_IF_ERROR(
+      GetRegionGrid(target_ts, options, region_shape, grid_origin));
+
+  CopyCheckpoint checkpoint;
+  if (!options.checkpoint_path.empty()) {
+    TENSORSTORE_RETURN_IF_ERROR(checkpoint.Open(options.checkpoint_path));
+    if (checkpoint.num_loaded() > 0) {
+      absl::MutexLock lock(&log_mutex);
+      output << "Resuming: " << checkpoint.num_loaded()
+             << " regions previously copied" << std::endl;
+    }
+  }
+
+  // Position of the current region in the region grid, in units of elements.
+  const DimensionIndex rank = domain.rank();
+  std::vector<Index> position(rank);
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    position[i] = FloorOfRatio(domain[i].inclusive_min() - grid_origin[i],
+                               region_shape[i]) *
+                      region_shape[i] +
+                  grid_origin[i];
+  }
+
+  CopyThrottle throttle(std::max<size_t>(1, options.concurrency),
+                        options.max_bytes_in_flight);
+  std::vector<Future<const void>> futures;
+  absl::Status status;
+  while (true) {
+    Box<> region(rank);
+    for (DimensionIndex i = 0; i < rank; ++i) {
+      region[i] = IndexInterval::UncheckedHalfOpen(
+          std::max(position[i], domain[i].inclusive_min()),
+          std::min(position[i] + region_shape[i], domain[i].exclusive_max()));
+    }
+    std::string key = absl::StrJoin(region.origin(), ",");
+    if (!checkpoint.Contains(key)) {
+      const int64_t bytes = region.num_elements() * source_ts.dtype().size();
+      throttle.Acquire(bytes);
+      auto copy_future = [&]() -> Future<const void> {
+        TENSORSTORE_ASSIGN_OR_RETURN(
+            auto source_region, source_ts | AllDims().BoxSlice(region));
+        TENSORSTORE_ASSIGN_OR_RETURN(
+            auto target_region, target_ts | AllDims().BoxSlice(region));
+        return tensorstore::Copy(source_region, target_region).commit_future;
+      }();
+      futures.push_back(MapFuture(
+          InlineExecutor{},
+          [&throttle, &checkpoint, &output, key = std::move(key),
+           region = std::move(region),
+           bytes](const Result<void>& result) -> Result<void> {
+            throttle.Release(bytes);
+            {
+              absl::MutexLock lock(&log_mutex);
+              if (result.ok()) {
+                output << "Copied: " << region << std::endl;
+              } else {
+                output << "Error copying: " << region << ": "
+                       << result.status() << std::endl;
+              }
+            }
+            TENSORSTORE_RETURN_IF_ERROR(result);
+            return checkpoint.Record(key);
+          },
+          std::move(copy_future)));
+    }
+
+    // Advance in C order over the region grid.
+    DimensionIndex i = rank - 1;
+    for (; i >= 0; --i) {
+      position[i] += region_shape[i];
+      if (position[i] < domain[i].exclusive_max()) break;
+      position[i] = FloorOfRatio(domain[i].inclusive_min() - grid_origin[i],
+                                 region_shape[i]) *
+                        region_shape[i] +
+                    grid_origin[i];
+    }
+    if (i < 0) break;
+  }
+
+  for (const auto& future : futures) {
+    status.Update(future.status());
+  }
+  return status;
+}
+
+}  // namespace cli
+}  // namespace tensorstore
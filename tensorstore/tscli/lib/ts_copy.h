@@ -0,0 +1,63 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_TSCLI_LIB_TS_COPY_H_
+#define TENSORSTORE_TSCLI_LIB_TS_COPY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "tensorstore/context.h"
+#include "tensorstore/index.h"
+#include "tensorstore/spec.h"
+
+namespace tensorstore {
+namespace cli {
+
+struct TsCopyOptions {
+  // Maximum number of regions copied concurrently.
+  size_t concurrency = 16;
+
+  // Maximum total size, in decoded bytes, of the regions being copied at
+  // once, or `0` for no limit.
+  int64_t max_bytes_in_flight = 1024 * 1024 * 1024;
+
+  // Path of a local file recording the regions that have been copied.  If
+  // specified, regions recorded by a previous, interrupted copy are skipped.
+  std::string checkpoint_path;
+
+  // Shape of each region.  If empty, defaults to the write chunk shape of the
+  // target, such that each region is written without read-modify-write.
+  std::vector<Index> region_shape;
+};
+
+// Copies the array data of `source` to `target`, which is created with the
+// domain and data type of `source` if it does not exist.
+//
+// The data is re-chunked and re-encoded as specified by `target`, and is
+// streamed one region at a time in C order over the region grid, which is
+// aligned to the chunk grid of `target`.
+absl::Status TsCopy(Context context, tensorstore::Spec source,
+                    tensorstore::Spec target, std::ostream& output,
+                    const TsCopyOptions& options = {});
+
+}  // namespace cli
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_TSCLI_LIB_TS_COPY_H_
@@ -0,0 +1,64 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/tscli/lib/ts_downsample_pyramid.h"
+
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "tensorstore/context.h"
+#include "tensorstore/downsample_method.h"
+#include "tensorstore/driver/downsample/downsample_pyramid.h"
+#include "tensorstore/index.h"
+#include "tensorstore/open.h"
+#include "tensorstore/open_mode.h"
+#include "tensorstore/spec.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace cli {
+
+absl::Status TsDownsamplePyramid(
+    Context context, tensorstore::Spec source,
+    tensorstore::span<const tensorstore::Spec> levels,
+    tensorstore::span<const Index> downsample_factors,
+    DownsampleMethod method) {
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto source_ts,
+      tensorstore::Open(source, context, tensorstore::ReadWriteMode::read,
+                        tensorstore::OpenMode::open)
+          .result());
+
+  std::vector<TensorStore<>> level_ts;
+  for (const auto& spec : levels) {
+    TENSORSTORE_ASSIGN_OR_RETURN(
+        auto ts,
+        tensorstore::Open(spec, context, tensorstore::ReadWriteMode::write,
+                          tensorstore::OpenMode::open)
+            .result());
+    level_ts.push_back(std::move(ts));
+  }
+
+  std::vector<std::vector<Index>> factors(
+      levels.size(), std::vector<Index>(downsample_factors.begin(),
+                                        downsample_factors.end()));
+  return internal_downsample::WriteDownsamplePyramid(
+      std::move(source_ts), level_ts, factors, method);
+}
+
+}  // namespace cli
+}  // namespace tensorstore
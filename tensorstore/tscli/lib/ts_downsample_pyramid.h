@@ -0,0 +1,39 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_TSCLI_LIB_TS_DOWNSAMPLE_PYRAMID_H_
+#define TENSORSTORE_TSCLI_LIB_TS_DOWNSAMPLE_PYRAMID_H_
+
+#include "absl/status/status.h"
+#include "tensorstore/context.h"
+#include "tensorstore/downsample_method.h"
+#include "tensorstore/index.h"
+#include "tensorstore/spec.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace cli {
+
+// Writes each of `levels` by successively downsampling `source` by
+// `downsample_factors`, reading `source` only once.
+absl::Status TsDownsamplePyramid(
+    Context context, tensorstore::Spec source,
+    tensorstore::span<const tensorstore::Spec> levels,
+    tensorstore::span<const Index> downsample_factors,
+    DownsampleMethod method);
+
+}  // namespace cli
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_TSCLI_LIB_TS_DOWNSAMPLE_PYRAMID_H_
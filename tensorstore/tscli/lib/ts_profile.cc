@@ -0,0 +1,335 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/tscli/lib/ts_profile.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/random/random.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_join.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "tensorstore/box.h"
+#include "tensorstore/chunk_layout.h"
+#include "tensorstore/context.h"
+#include "tensorstore/index.h"
+#include "tensorstore/index_interval.h"
+#include "tensorstore/index_space/dim_expression.h"
+#include "tensorstore/internal/metrics/collect.h"
+#include "tensorstore/internal/metrics/registry.h"
+#include "tensorstore/internal/tracing/trace_exporter.h"
+#include "tensorstore/open.h"
+#include "tensorstore/open_mode.h"
+#include "tensorstore/operation_stats.h"
+#include "tensorstore/spec.h"
+#include "tensorstore/tensorstore.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status.h"
+#include "tensorstore/util/str_cat.h"
+
+namespace tensorstore {
+namespace cli {
+namespace {
+
+using ::tensorstore::internal_metrics::CollectedMetric;
+using ::tensorstore::internal_tracing::SpanData;
+using ::tensorstore::internal_tracing::TraceExporter;
+
+// Aggregates completed spans by name, forwarding them to any previously set
+// exporter.
+class SpanSummaryExporter : public TraceExporter {
+ public:
+  struct Summary {
+    int64_t count = 0;
+    int64_t errors = 0;
+    absl::Duration total = absl::ZeroDuration();
+    absl::Duration max = absl::ZeroDuration();
+  };
+
+  explicit SpanSummaryExporter(std::shared_ptr<TraceExporter> next)
+      : next_(std::move(next)) {}
+
+  void Export(SpanData span) override {
+    {
+      absl::MutexLock lock(&mutex_);
+      auto& summary = summaries_[span.name];
+      const absl::Duration duration = span.end_time - span.start_time;
+      ++summary.count;
+      if (!span.status.ok()) ++summary.errors;
+      summary.total += duration;
+      summary.max = std::max(summary.max, duration);
+    }
+    if (next_) next_->Export(std::move(span));
+  }
+
+  std::map<std::string, Summary> summaries() {
+    absl::MutexLock lock(&mutex_);
+    return summaries_;
+  }
+
+ private:
+  std::shared_ptr<TraceExporter> next_;
+  absl::Mutex mutex_;
+  std::map<std::string, Summary> summaries_ ABSL_GUARDED_BY(mutex_);
+};
+
+// Numeric value of each metric cell, keyed by metric name and fields.
+// Histograms contribute their count and sum as separate cells.
+using MetricSnapshot = std::map<std::string, double>;
+
+MetricSnapshot CollectMetricSnapshot() {
+  MetricSnapshot snapshot;
+  for (const CollectedMetric& metric :
+       internal_metrics::GetMetricRegistry().CollectWithPrefix(
+           "/tensorstore/")) {
+    auto cell_name = [&](const std::vector<std::string>& fields) {
+      std::string name(metric.metric_name);
+      if (!fields.empty()) {
+        absl::StrAppend(&name, "[", absl::StrJoin(fields, ","), "]");
+      }
+      return name;
+    };
+    for (const auto& value : metric.values) {
+      if (auto* v = std::get_if<int64_t>(&value.value)) {
+        snapshot[cell_name(value.fields)] = *v;
+      } else if (auto* v = std::get_if<double>(&value.value)) {
+        snapshot[cell_name(value.fields)] = *v;
+      }
+    }
+    for (const auto& histogram : metric.histograms) {
+      const std::string name = cell_name(histogram.fields);
+      snapshot[absl::StrCat(name, ".count")] = histogram.count;
+      snapshot[absl::StrCat(name, ".sum")] = histogram.count * histogram.mean;
+    }
+  }
+  return snapshot;
+}
+
+double CpuSeconds() {
+  return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+}
+
+std::string FormatMilliseconds(absl::Duration d) {
+  return absl::StrFormat("%.3fms", absl::ToDoubleMilliseconds(d));
+}
+
+// Returns the shape of each region, substituting the extent of the domain for
+// unchunked dimensions.
+Result<std::vector<Index>> GetRegionShape(const TensorStore<>& store,
+                                          const TsProfileOptions& options) {
+  const DimensionIndex rank = store.rank();
+  const auto domain = store.domain().box();
+  std::vector<Index> shape(rank, 0);
+  if (!options.region_shape.empty()) {
+    if (static_cast<DimensionIndex>(options.region_shape.size()) != rank) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Region shape has rank ", options.region_shape.size(),
+                       " but store has rank ", rank));
+    }
+    shape = options.region_shape;
+  } else {
+    TENSORSTORE_ASSIGN_OR_RETURN(auto layout, store.chunk_layout());
+    auto read_chunk_shape = layout.read_chunk_shape();
+    for (DimensionIndex i = 0; i < rank; ++i) {
+      if (read_chunk_shape.valid() && read_chunk_shape[i] > 0) {
+        shape[i] = read_chunk_shape[i];
+      }
+    }
+  }
+  for (DimensionIndex i = 0; i < rank; ++i) {
+    if (shape[i] <= 0) shape[i] = std::max(Index(1), domain[i].size());
+  }
+  return shape;
+}
+
+// Returns the region with linear index `cell` in C order over the grid of
+// regions of `region_shape` starting at the origin of `domain`.
+Box<> GetRegion(BoxView<> domain, span<const Index> region_shape,
+                Index cell) {
+  const DimensionIndex rank = domain.rank();
+  Box<> region(rank);
+  for (DimensionIndex i = rank - 1; i >= 0; --i) {
+    const Index grid_size =
+        (domain[i].size() + region_shape[i] - 1) / region_shape[i];
+    const Index start =
+        domain[i].inclusive_min() + (cell % grid_size) * region_shape[i];
+    cell /= grid_size;
+    region[i] = IndexInterval::UncheckedHalfOpen(
+        start, std::min(start + region_shape[i], domain[i].exclusive_max()));
+  }
+  return region;
+}
+
+}  // namespace
+
+absl::Status TsProfile(Context context, tensorstore::Spec spec,
+                       std::ostream& output,
+                       const TsProfileOptions& options) {
+  auto previous_exporter = internal_tracing::GetTraceExporter();
+  auto exporter = std::make_shared<SpanSummaryExporter>(previous_exporter);
+  internal_tracing::SetTraceExporter(exporter);
+  struct RestoreExporter {
+    std::shared_ptr<TraceExporter> exporter;
+    ~RestoreExporter() {
+      internal_tracing::SetTraceExporter(std::move(exporter));
+    }
+  } restore_exporter{previous_exporter};
+
+  const MetricSnapshot metrics_before = CollectMetricSnapshot();
+  const double cpu_start = CpuSeconds();
+
+  // Open
+  const absl::Time open_start = absl::Now();
+  TENSORSTORE_ASSIGN_OR_RETURN(
+      auto store,
+      tensorstore::Open(spec, context, tensorstore::ReadWriteMode::read,
+                        tensorstore::OpenMode::open)
+          .result());
+  const absl::Duration open_time = absl::Now() - open_start;
+  const double open_cpu = CpuSeconds() - cpu_start;
+
+  const auto domain = store.domain().box();
+  if (!IsFinite(domain)) {
+    return absl::InvalidArgumentError(
+        tensorstore::StrCat("Cannot profile unbounded domain: ", domain));
+  }
+  TENSORSTORE_ASSIGN_OR_RETURN(auto region_shape,
+                               GetRegionShape(store, options));
+  Index num_cells = 1;
+  for (DimensionIndex i = 0; i < domain.rank(); ++i) {
+    num_cells *= (domain[i].size() + region_shape[i] - 1) / region_shape[i];
+  }
+  const size_t num_reads =
+      domain.is_empty() ? 0
+                        : std::min<size_t>(options.num_reads, num_cells);
+
+  // Read
+  auto stats = OperationStats::New();
+  std::vector<absl::Duration> latencies(num_reads);
+  absl::InsecureBitGen gen;
+  const size_t concurrency = std::max<size_t>(1, options.concurrency);
+  int64_t bytes_read = 0;
+  absl::Status status;
+  const double read_cpu_start = CpuSeconds();
+  const absl::Time read_start = absl::Now();
+  for (size_t batch_start = 0; batch_start < num_reads;
+       batch_start += concurrency) {
+    std::vector<Future<const void>> futures;
+    for (size_t i = batch_start;
+         i < std::min(num_reads, batch_start + concurrency); ++i) {
+      const Index cell =
+          options.random ? absl::Uniform<Index>(gen, 0, num_cells) : i;
+      Box<> region = GetRegion(domain, region_shape, cell);
+      bytes_read += region.num_elements() * store.dtype().size();
+      const absl::Time start = absl::Now();
+      auto read_future = tensorstore::Read(
+          store | AllDims().BoxSlice(region), stats);
+      futures.push_back(MapFuture(
+          InlineExecutor{},
+          [&latencies, i, start](const auto& result) -> Result<void> {
+            latencies[i] = absl::Now() - start;
+            return result.status();
+          },
+          std::move(read_future)));
+    }
+    for (const auto& future : futures) {
+      status.Update(future.status());
+    }
+  }
+  const absl::Duration read_time = absl::Now() - read_start;
+  const double read_cpu = CpuSeconds() - read_cpu_start;
+  TENSORSTORE_RETURN_IF_ERROR(status);
+
+  const MetricSnapshot metrics_after = CollectMetricSnapshot();
+
+  // Report
+  output << "Open: " << FormatMilliseconds(open_time)
+         << absl::StrFormat(" (cpu %.3fs)", open_cpu) << std::endl;
+  output << "Read: " << num_reads << " regions of shape ["
+         << absl::StrJoin(region_shape, ",") << "] in "
+         << FormatMilliseconds(read_time)
+         << absl::StrFormat(" (cpu %.3fs, %.1f MB/s decoded)", read_cpu,
+                            bytes_read / 1e6 /
+                                std::max(1e-9, absl::ToDoubleSeconds(
+                                                   read_time)))
+         << std::endl;
+  if (num_reads > 0) {
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) {
+      return latencies[std::min(num_reads - 1,
+                                static_cast<size_t>(p * num_reads))];
+    };
+    output << "  latency: p50=" << FormatMilliseconds(percentile(0.5))
+           << " p90=" << FormatMilliseconds(percentile(0.9))
+           << " p99=" << FormatMilliseconds(percentile(0.99))
+           << " max=" << FormatMilliseconds(latencies.back()) << std::endl;
+  }
+
+  const auto counters = stats.Get();
+  const int64_t cache_reads = counters.cache_hits + counters.cache_misses;
+  output << "I/O:" << std::endl
+         << "  kvstore reads: " << counters.kvstore_reads << std::endl
+         << "  kvstore bytes read: " << counters.kvstore_bytes_read
+         << std::endl
+         << "  cache hits: " << counters.cache_hits << " / " << cache_reads
+         << absl::StrFormat(
+                " (%.1f%%)",
+                cache_reads ? 100.0 * counters.cache_hits / cache_reads : 0.0)
+         << std::endl
+         << "  decode time: " << FormatMilliseconds(counters.decode_time)
+         << std::endl;
+
+  auto summaries = exporter->summaries();
+  if (!summaries.empty()) {
+    output << "Spans (count, errors, total, mean, max):" << std::endl;
+    for (const auto& [name, summary] : summaries) {
+      output << "  " << name << ": " << summary.count << ", "
+             << summary.errors << ", " << FormatMilliseconds(summary.total)
+             << ", " << FormatMilliseconds(summary.total / summary.count)
+             << ", "
+             << FormatMilliseconds(summary.max) << std::endl;
+    }
+  }
+
+  output << "Metrics (change):" << std::endl;
+  for (const auto& [name, value] : metrics_after) {
+    auto it = metrics_before.find(name);
+    const double delta =
+        value - (it == metrics_before.end() ? 0.0 : it->second);
+    if (delta == 0) continue;
+    output << "  " << name << ": " << delta << std::endl;
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace cli
+}  // namespace tensorstore
@@ -0,0 +1,57 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_TSCLI_LIB_TS_PROFILE_H_
+#define TENSORSTORE_TSCLI_LIB_TS_PROFILE_H_
+
+#include <stddef.h>
+
+#include <ostream>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "tensorstore/context.h"
+#include "tensorstore/index.h"
+#include "tensorstore/spec.h"
+
+namespace tensorstore {
+namespace cli {
+
+struct TsProfileOptions {
+  // Number of regions read.
+  size_t num_reads = 100;
+
+  // Maximum number of concurrent reads.
+  size_t concurrency = 8;
+
+  // Read regions chosen uniformly at random from the region grid, rather than
+  // the first `num_reads` regions in C order.
+  bool random = false;
+
+  // Shape of each region.  If empty, defaults to the read chunk shape.
+  std::vector<Index> region_shape;
+};
+
+// Opens `spec`, reads a sample of regions aligned to the chunk grid, and
+// writes to `output` a breakdown of where the time was spent: open and read
+// latency, I/O and cache statistics, CPU time, trace spans aggregated by
+// name, and the change in each metric.
+absl::Status TsProfile(Context context, tensorstore::Spec spec,
+                       std::ostream& output,
+                       const TsProfileOptions& options = {});
+
+}  // namespace cli
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_TSCLI_LIB_TS_PROFILE_H_
@@ -0,0 +1,128 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/tscli/lib/zstd_train_dictionary.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/cord.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
+#include "re2/re2.h"
+#include "tensorstore/context.h"
+#include "tensorstore/kvstore/kvstore.h"
+#include "tensorstore/kvstore/operations.h"
+#include "tensorstore/kvstore/read_result.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/tscli/lib/glob_to_regex.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/span.h"
+#include <zdict.h>
+
+namespace tensorstore {
+namespace cli {
+namespace {
+
+// Number of samples read concurrently.
+constexpr size_t kReadWindow = 64;
+
+}  // namespace
+
+absl::Status ZstdTrainDictionary(Context context,
+                                 tensorstore::kvstore::Spec source_spec,
+                                 tensorstore::span<std::string_view> match_args,
+                                 size_t max_samples, size_t dictionary_size,
+                                 std::ostream& output) {
+  TENSORSTORE_ASSIGN_OR_RETURN(auto source,
+                               kvstore::Open(source_spec, context).result());
+
+  std::string re_string;
+  for (const std::string_view glob : match_args) {
+    if (glob.empty()) {
+      re_string.clear();
+      break;
+    }
+    absl::StrAppend(&re_string, re_string.empty() ? "(" : "|(",
+                    GlobToRegex(glob), ")");
+  }
+
+  TENSORSTORE_ASSIGN_OR_RETURN(auto list_entries,
+                               kvstore::ListFuture(source).result());
+  std::vector<std::string> keys;
+  RE2 re2(re_string);
+  for (auto& entry : list_entries) {
+    if (re_string.empty() || RE2::FullMatch(entry.key, re2)) {
+      keys.push_back(std::move(entry.key));
+    }
+  }
+  list_entries.clear();
+  std::sort(keys.begin(), keys.end());
+
+  // Choose samples evenly spaced in key order, so that all regions of the
+  // array are represented.
+  std::vector<std::string> sample_keys;
+  const size_t num_samples = std::min(keys.size(), max_samples);
+  sample_keys.reserve(num_samples);
+  for (size_t i = 0; i < num_samples; ++i) {
+    sample_keys.push_back(std::move(keys[i * keys.size() / num_samples]));
+  }
+  keys.clear();
+
+  // `ZDICT_trainFromBuffer` requires the samples to be concatenated.
+  std::string samples;
+  std::vector<size_t> sample_sizes;
+  std::vector<Future<kvstore::ReadResult>> reads;
+  for (size_t start = 0; start < sample_keys.size(); start += kReadWindow) {
+    size_t end = std::min(sample_keys.size(), start + kReadWindow);
+    reads.clear();
+    for (size_t i = start; i < end; ++i) {
+      reads.push_back(kvstore::Read(source, sample_keys[i]));
+    }
+    for (auto& read : reads) {
+      TENSORSTORE_ASSIGN_OR_RETURN(auto read_result, read.result());
+      if (!read_result.has_value() || read_result.value.empty()) continue;
+      absl::AppendCordToString(read_result.value, &samples);
+      sample_sizes.push_back(read_result.value.size());
+    }
+  }
+  if (sample_sizes.empty()) {
+    return absl::NotFoundError("No values match the specified patterns");
+  }
+
+  std::string dictionary(dictionary_size, '\0');
+  size_t result =
+      ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(),
+                            samples.data(), sample_sizes.data(),
+                            static_cast<unsigned>(sample_sizes.size()));
+  if (ZDICT_isError(result)) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Error training zstd dictionary from ",
+                     sample_sizes.size(),
+                     " samples: ", ZDICT_getErrorName(result)));
+  }
+  dictionary.resize(result);
+  output << absl::Base64Escape(dictionary) << std::endl;
+  return absl::OkStatus();
+}
+
+}  // namespace cli
+}  // namespace tensorstore
@@ -0,0 +1,47 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_TSCLI_LIB_ZSTD_TRAIN_DICTIONARY_H_
+#define TENSORSTORE_TSCLI_LIB_ZSTD_TRAIN_DICTIONARY_H_
+
+#include <stddef.h>
+
+#include <ostream>
+#include <string_view>
+
+#include "absl/status/status.h"
+#include "tensorstore/context.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/util/span.h"
+
+namespace tensorstore {
+namespace cli {
+
+/// Trains a zstd dictionary from the values of `source_spec`.
+///
+/// At most `max_samples` values, chosen evenly spaced in key order among the
+/// keys matching any of the glob patterns `match_args`, are used as samples.
+/// The dictionary, of at most `dictionary_size` bytes, is written to `output`
+/// base64-encoded, in the form expected by the ``dictionary`` member of the
+/// zarr3 ``zstd`` codec.
+absl::Status ZstdTrainDictionary(Context context,
+                                 tensorstore::kvstore::Spec source_spec,
+                                 tensorstore::span<std::string_view> match_args,
+                                 size_t max_samples, size_t dictionary_size,
+                                 std::ostream& output);
+
+}  // namespace cli
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_TSCLI_LIB_ZSTD_TRAIN_DICTIONARY_H_
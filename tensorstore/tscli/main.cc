@@ -32,14 +32,19 @@
 #include "absl/flags/parse.h"
 #include "tensorstore/internal/metrics/collect.h"
 #include "tensorstore/internal/metrics/registry.h"
+#include "tensorstore/tscli/advise_chunk_layout_command.h"
 #include "tensorstore/tscli/command.h"
 #include "tensorstore/tscli/command_parser.h"
 #include "tensorstore/tscli/copy_command.h"
+#include "tensorstore/tscli/downsample_pyramid_command.h"
 #include "tensorstore/tscli/list_command.h"
 #include "tensorstore/tscli/ocdbt_dump_command.h"
+#include "tensorstore/tscli/ocdbt_import_command.h"
 #include "tensorstore/tscli/print_spec_command.h"
 #include "tensorstore/tscli/print_stats_command.h"
+#include "tensorstore/tscli/profile_command.h"
 #include "tensorstore/tscli/search_command.h"
+#include "tensorstore/tscli/zstd_train_dictionary_command.h"
 #include "tensorstore/util/json_absl_flag.h"
 #include "tensorstore/util/span.h"
 
@@ -65,10 +70,23 @@ tensorstore::span<Command*> AllCommands() {
   static absl::NoDestructor<::tensorstore::cli::PrintSpecCommand> print_spec;
   static absl::NoDestructor<::tensorstore::cli::PrintStatsCommand> print_stats;
   static absl::NoDestructor<::tensorstore::cli::OcdbtDumpCommand> ocdbt_dump;
-
-  static std::array<Command*, 6> commands{copy.get(),        list.get(),
-                                          search.get(),      print_spec.get(),
-                                          print_stats.get(), ocdbt_dump.get()};
+  static absl::NoDestructor<::tensorstore::cli::OcdbtImportCommand>
+      ocdbt_import;
+  static absl::NoDestructor<::tensorstore::cli::ZstdTrainDictionaryCommand>
+      zstd_train_dictionary;
+  static absl::NoDestructor<::tensorstore::cli::DownsamplePyramidCommand>
+      downsample_pyramid;
+  static absl::NoDestructor<::tensorstore::cli::ProfileCommand> profile;
+  static absl::NoDestructor<::tensorstore::cli::AdviseChunkLayoutCommand>
+      advise_chunk_layout;
+
+  static std::array<Command*, 11> commands{
+      copy.get(),         list.get(),
+      search.get(),       print_spec.get(),
+      print_stats.get(),  ocdbt_dump.get(),
+      ocdbt_import.get(), zstd_train_dictionary.get(),
+      downsample_pyramid.get(), profile.get(),
+      advise_chunk_layout.get()};
   return commands;
 }
 
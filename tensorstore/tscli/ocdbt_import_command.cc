@@ -0,0 +1,89 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/tscli/ocdbt_import_command.h"
+
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "absl/status/status.h"
+#include "tensorstore/context.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/tscli/command.h"
+#include "tensorstore/tscli/lib/ocdbt_import.h"
+#include "tensorstore/util/json_absl_flag.h"
+
+/*
+Example usage:
+
+bazel run //tensorstore/tscli -- ocdbt_import --source file:///tmp/source/
+--target '{"driver": "ocdbt", "base": "file:///tmp/dest/"}'
+*/
+
+namespace tensorstore {
+namespace cli {
+namespace {
+
+static constexpr const char kCommand[] =
+    R"(Bulk load a kvstore into an empty OCDBT database
+
+All values are read from the --source kvstore in key order, and the B+tree of
+the --target OCDBT database is built bottom-up and committed as a single
+version.
+)";
+
+static constexpr const char kSource[] = R"(Source kvstore spec. Required.)";
+
+static constexpr const char kTarget[] =
+    R"(Target OCDBT kvstore spec. Required.)";
+
+}  // namespace
+
+OcdbtImportCommand::OcdbtImportCommand()
+    : Command("ocdbt_import", kCommand) {
+  parser().AddLongOption("--source", kSource, [this](std::string_view value) {
+    tensorstore::JsonAbslFlag<tensorstore::kvstore::Spec> spec;
+    std::string error;
+    if (!AbslParseFlag(value, &spec, &error)) {
+      return absl::InvalidArgumentError(error);
+    }
+    source_ = spec.value;
+    return absl::OkStatus();
+  });
+  parser().AddLongOption("--target", kTarget, [this](std::string_view value) {
+    tensorstore::JsonAbslFlag<tensorstore::kvstore::Spec> spec;
+    std::string error;
+    if (!AbslParseFlag(value, &spec, &error)) {
+      return absl::InvalidArgumentError(error);
+    }
+    target_ = spec.value;
+    return absl::OkStatus();
+  });
+}
+
+absl::Status OcdbtImportCommand::Run(Context::Spec context_spec) {
+  if (!source_.valid()) {
+    return absl::InvalidArgumentError("Must specify --source");
+  }
+  if (!target_.valid()) {
+    return absl::InvalidArgumentError("Must specify --target");
+  }
+
+  tensorstore::Context context(context_spec);
+  return OcdbtImport(context, source_, target_, std::cout);
+}
+
+}  // namespace cli
+}  // namespace tensorstore
@@ -0,0 +1,115 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/tscli/profile_command.h"
+
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "absl/status/status.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "tensorstore/context.h"
+#include "tensorstore/index.h"
+#include "tensorstore/spec.h"
+#include "tensorstore/tscli/command.h"
+#include "tensorstore/tscli/lib/ts_profile.h"
+#include "tensorstore/util/json_absl_flag.h"
+
+namespace tensorstore {
+namespace cli {
+namespace {
+
+static constexpr const char kCommand[] =
+    R"(Profile opening and reading a TensorStore
+
+Opens --spec, reads a sample of regions aligned to the read chunk grid, and
+prints the open and read latency, kvstore I/O, cache hit ratio, decode and CPU
+time, trace spans aggregated by name, and the change in each
+/tensorstore/ metric.
+)";
+
+static constexpr const char kSpec[] = R"(Tensorstore spec. Required.)";
+
+static constexpr const char kNumReads[] =
+    R"(Number of regions to read. Defaults to 100.)";
+
+static constexpr const char kConcurrency[] =
+    R"(Maximum number of concurrent reads. Defaults to 8.)";
+
+static constexpr const char kRandom[] =
+    R"(Read regions at random, rather than the first regions in C order.)";
+
+static constexpr const char kRegionShape[] =
+    R"(Comma-separated shape of each region. Defaults to the read chunk
+shape.)";
+
+}  // namespace
+
+ProfileCommand::ProfileCommand() : Command("profile", kCommand) {
+  parser().AddLongOption("--spec", kSpec, [this](std::string_view value) {
+    tensorstore::JsonAbslFlag<tensorstore::Spec> spec;
+    std::string error;
+    if (!AbslParseFlag(value, &spec, &error)) {
+      return absl::InvalidArgumentError(error);
+    }
+    spec_ = spec.value;
+    return absl::OkStatus();
+  });
+  parser().AddLongOption(
+      "--num_reads", kNumReads, [this](std::string_view value) {
+        if (!absl::SimpleAtoi(value, &options_.num_reads)) {
+          return absl::InvalidArgumentError(
+              absl::StrCat("Invalid --num_reads: ", value));
+        }
+        return absl::OkStatus();
+      });
+  parser().AddLongOption(
+      "--concurrency", kConcurrency, [this](std::string_view value) {
+        if (!absl::SimpleAtoi(value, &options_.concurrency) ||
+            options_.concurrency == 0) {
+          return absl::InvalidArgumentError(
+              absl::StrCat("Invalid --concurrency: ", value));
+        }
+        return absl::OkStatus();
+      });
+  parser().AddBoolOption("--random", kRandom,
+                         [this]() { options_.random = true; });
+  parser().AddLongOption(
+      "--region_shape", kRegionShape, [this](std::string_view value) {
+        options_.region_shape.clear();
+        for (std::string_view part : absl::StrSplit(value, ',')) {
+          Index size;
+          if (!absl::SimpleAtoi(part, &size) || size <= 0) {
+            return absl::InvalidArgumentError(
+                absl::StrCat("Invalid --region_shape: ", value));
+          }
+          options_.region_shape.push_back(size);
+        }
+        return absl::OkStatus();
+      });
+}
+
+absl::Status ProfileCommand::Run(Context::Spec context_spec) {
+  if (!spec_) {
+    return absl::InvalidArgumentError("Must specify --spec");
+  }
+  tensorstore::Context context(context_spec);
+  return TsProfile(context, *spec_, std::cout, options_);
+}
+
+}  // namespace cli
+}  // namespace tensorstore
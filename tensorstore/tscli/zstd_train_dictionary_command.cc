@@ -0,0 +1,116 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/tscli/zstd_train_dictionary_command.h"
+
+#include <stddef.h>
+
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "absl/status/status.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "tensorstore/context.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/tscli/command.h"
+#include "tensorstore/tscli/lib/zstd_train_dictionary.h"
+#include "tensorstore/util/json_absl_flag.h"
+
+/*
+Example usage:
+
+bazel run //tensorstore/tscli -- zstd_train_dictionary
+--source file:///tmp/dataset/ --max_samples 500
+*/
+
+namespace tensorstore {
+namespace cli {
+namespace {
+
+static constexpr const char kCommand[] =
+    R"(Train a zstd dictionary from values of a kvstore
+
+The dictionary is printed base64-encoded, and may be specified as the
+"dictionary" member of the zarr3 "zstd" codec.  Values should be sampled
+from chunks encoded without compression, e.g. those of a similar array
+that uses the "bytes" codec alone.
+)";
+
+static constexpr const char kSource[] = R"(Source kvstore spec. Required.)";
+
+static constexpr const char kMatch[] = R"(Glob matching patterns.
+
+Values are sampled from keys matching any of the patterns.
+When not specified, all keys are sampled.
+)";
+
+static constexpr const char kMaxSamples[] =
+    R"(Maximum number of values to sample. Defaults to 1000.)";
+
+static constexpr const char kDictionarySize[] =
+    R"(Maximum size of the dictionary in bytes. Defaults to 112640.)";
+
+}  // namespace
+
+ZstdTrainDictionaryCommand::ZstdTrainDictionaryCommand()
+    : Command("zstd_train_dictionary", kCommand) {
+  parser().AddLongOption("--source", kSource, [this](std::string_view value) {
+    tensorstore::JsonAbslFlag<tensorstore::kvstore::Spec> spec;
+    std::string error;
+    if (!AbslParseFlag(value, &spec, &error)) {
+      return absl::InvalidArgumentError(error);
+    }
+    source_ = spec.value;
+    return absl::OkStatus();
+  });
+  parser().AddLongOption("--match", kMatch, [this](std::string_view value) {
+    match_args_.push_back(value);
+    return absl::OkStatus();
+  });
+  parser().AddLongOption(
+      "--max_samples", kMaxSamples, [this](std::string_view value) {
+        if (!absl::SimpleAtoi(value, &max_samples_) || max_samples_ == 0) {
+          return absl::InvalidArgumentError(
+              absl::StrCat("Invalid --max_samples: ", value));
+        }
+        return absl::OkStatus();
+      });
+  parser().AddLongOption(
+      "--dictionary_size", kDictionarySize, [this](std::string_view value) {
+        if (!absl::SimpleAtoi(value, &dictionary_size_) ||
+            dictionary_size_ == 0) {
+          return absl::InvalidArgumentError(
+              absl::StrCat("Invalid --dictionary_size: ", value));
+        }
+        return absl::OkStatus();
+      });
+}
+
+absl::Status ZstdTrainDictionaryCommand::Run(Context::Spec context_spec) {
+  if (!source_.valid()) {
+    return absl::InvalidArgumentError("Must specify --source");
+  }
+  if (match_args_.empty()) {
+    match_args_.push_back("");
+  }
+
+  tensorstore::Context context(context_spec);
+  return ZstdTrainDictionary(context, source_, match_args_, max_samples_,
+                             dictionary_size_, std::cout);
+}
+
+}  // namespace cli
+}  // namespace tensorstore
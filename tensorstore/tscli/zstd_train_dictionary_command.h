@@ -0,0 +1,48 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_TSCLI_ZSTD_TRAIN_DICTIONARY_COMMAND_H_
+#define TENSORSTORE_TSCLI_ZSTD_TRAIN_DICTIONARY_COMMAND_H_
+
+#include <stddef.h>
+
+#include <string_view>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "tensorstore/context.h"
+#include "tensorstore/kvstore/spec.h"
+#include "tensorstore/tscli/command.h"
+
+namespace tensorstore {
+namespace cli {
+
+// Train a zstd dictionary from values sampled from a kvstore.
+class ZstdTrainDictionaryCommand : public Command {
+ public:
+  ZstdTrainDictionaryCommand();
+
+  absl::Status Run(Context::Spec context_spec) override;
+
+ private:
+  tensorstore::kvstore::Spec source_;
+  std::vector<std::string_view> match_args_;
+  size_t max_samples_ = 1000;
+  size_t dictionary_size_ = 112640;
+};
+
+}  // namespace cli
+}  // namespace tensorstore
+
+#endif  // TENSORSTORE_TSCLI_ZSTD_TRAIN_DICTIONARY_COMMAND_H_
@@ -802,13 +802,18 @@ inline BFloat16 NumericFloat32ToBfloat16RoundNearestEven(float v) {
 /// Converts float32 -> bfloat16, rounding to the nearest, or to even in the
 /// case of a tie.
 inline BFloat16 Float32ToBfloat16RoundNearestEven(float v) {
-  if (std::isnan(v)) {
-    return tensorstore::BFloat16(
-        tensorstore::BFloat16::bitcast_construct_t{},
-        static_cast<uint16_t>((absl::bit_cast<uint32_t>(v) | 0x00200000u) >>
-                              16));
-  }
-  return NumericFloat32ToBfloat16RoundNearestEven(v);
+  // Both results are computed and one is selected without branching, so that
+  // loops converting arrays of floats can be vectorized.
+  const uint32_t input = absl::bit_cast<uint32_t>(v);
+  // For NaN, set bit 21 (second to highest fraction bit) to 1 to ensure the
+  // truncated fraction still indicates a NaN.
+  const uint32_t nan_result = input | 0x00200000u;
+  // See `NumericFloat32ToBfloat16RoundNearestEven`.
+  const uint32_t numeric_result = input + 0x7fff + ((input >> 16) & 1);
+  const bool is_nan = (input & 0x7fffffffu) > 0x7f800000u;
+  return tensorstore::BFloat16(
+      tensorstore::BFloat16::bitcast_construct_t{},
+      static_cast<uint16_t>((is_nan ? nan_result : numeric_result) >> 16));
 }
 
 inline float Bfloat16ToFloat(BFloat16 v) {
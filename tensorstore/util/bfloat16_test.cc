@@ -44,6 +44,7 @@
 namespace {
 using ::tensorstore::internal::Float32ToBfloat16RoundNearestEven;
 using ::tensorstore::internal::Float32ToBfloat16Truncate;
+using ::tensorstore::internal::NumericFloat32ToBfloat16RoundNearestEven;
 
 using bfloat16_t = tensorstore::BFloat16;
 
@@ -118,6 +119,30 @@ TEST(Bfloat16Test, RoundToNearestEven) {
   EXPECT_THAT(bfloat16_t(0.5f * (val2 + val3)), MatchesBits(0x3c02));
 }
 
+TEST(Bfloat16Test, RoundToNearestEvenAllClasses) {
+  // `Float32ToBfloat16RoundNearestEven` selects between the NaN and numeric
+  // results without branching; check it against the numeric conversion and
+  // the NaN rules over a sample of all bit patterns.
+  for (uint64_t i = 0; i <= 0xffffffff; i += 0x10003) {
+    const uint32_t bits = static_cast<uint32_t>(i);
+    const float v = absl::bit_cast<float>(bits);
+    const uint16_t result =
+        absl::bit_cast<uint16_t>(Float32ToBfloat16RoundNearestEven(v));
+    if (std::isnan(v)) {
+      // Sign and quiet bit are preserved, and the result is still NaN.
+      EXPECT_TRUE(std::isnan(static_cast<float>(
+          absl::bit_cast<bfloat16_t>(result))))
+          << bits;
+      EXPECT_EQ((bits >> 16) | 0x20, result) << bits;
+    } else {
+      EXPECT_EQ(absl::bit_cast<uint16_t>(
+                    NumericFloat32ToBfloat16RoundNearestEven(v)),
+                result)
+          << bits;
+    }
+  }
+}
+
 TEST(Bfloat16Test, ConversionFromInt) {
   EXPECT_THAT(bfloat16_t(-1), MatchesBits(0xbf80));
   EXPECT_THAT(bfloat16_t(0), MatchesBits(0x0000));
@@ -14,8 +14,11 @@
 
 #include "tensorstore/util/endian.h"
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include <vector>
+
 #include <gtest/gtest.h>
 #include "absl/base/config.h"
 
@@ -124,4 +127,39 @@ TEST(EndianTest, VerifyBigEndian) {
   EXPECT_EQ(comp, k64Value);
 }
 
+// Compares `SwapEndianUnalignedArray` to swapping one value at a time, for
+// lengths that do and do not fill whole 64-bit words, unaligned pointers,
+// and in-place swaps.
+template <size_t ElementSize>
+void TestSwapEndianUnalignedArray() {
+  for (size_t count : {0, 1, 2, 3, 4, 5, 7, 8, 9, 33}) {
+    std::vector<unsigned char> source(count * ElementSize + 1);
+    for (size_t i = 0; i < source.size(); ++i) {
+      source[i] = static_cast<unsigned char>(i * 37 + 1);
+    }
+    std::vector<unsigned char> expected(source.size());
+    for (size_t i = 0; i < count; ++i) {
+      tensorstore::internal::SwapEndianUnaligned<ElementSize>(
+          source.data() + 1 + i * ElementSize,
+          expected.data() + 1 + i * ElementSize);
+    }
+    std::vector<unsigned char> dest(source.size());
+    tensorstore::internal::SwapEndianUnalignedArray<ElementSize>(
+        source.data() + 1, dest.data() + 1, count);
+    EXPECT_EQ(expected, dest) << "count=" << count;
+
+    tensorstore::internal::SwapEndianUnalignedArray<ElementSize>(
+        source.data() + 1, source.data() + 1, count);
+    source[0] = 0;
+    EXPECT_EQ(expected, source) << "count=" << count;
+  }
+}
+
+TEST(SwapEndianUnalignedArrayTest, Basic) {
+  TestSwapEndianUnalignedArray<1>();
+  TestSwapEndianUnalignedArray<2>();
+  TestSwapEndianUnalignedArray<4>();
+  TestSwapEndianUnalignedArray<8>();
+}
+
 }  // namespace
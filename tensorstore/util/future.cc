@@ -19,10 +19,12 @@
 
 #include <atomic>
 #include <cassert>
+#include <new>
 #include <thread>  // NOLINT
 #include <utility>
 
 #include "absl/base/attributes.h"
+#include "absl/base/config.h"
 #include "absl/base/const_init.h"
 #include "absl/base/no_destructor.h"
 #include "absl/base/optimization.h"
@@ -55,8 +57,104 @@ auto& future_not_needed_callbacks = internal_metrics::Counter<int64_t>::New(
 auto& future_force_callbacks = internal_metrics::Counter<int64_t>::New(
     "/tensorstore/futures/force_callbacks", MetricMetadata("Force callbacks"));
 
+// Pooling is disabled under sanitizers, since reusing blocks would hide
+// use-after-free errors.
+#if defined(ABSL_HAVE_ADDRESS_SANITIZER) ||   \
+    defined(ABSL_HAVE_HWADDRESS_SANITIZER) || \
+    defined(ABSL_HAVE_MEMORY_SANITIZER) || defined(ABSL_HAVE_THREAD_SANITIZER)
+constexpr bool kPoolingEnabled = false;
+#else
+constexpr bool kPoolingEnabled = true;
+#endif
+
+// Block sizes are rounded up to a multiple of `kPoolGranularity`, which is
+// also the alignment guaranteed by `::operator new`.
+constexpr size_t kPoolGranularity = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+constexpr size_t kMaxPooledSize = 512;
+constexpr size_t kNumSizeClasses = kMaxPooledSize / kPoolGranularity;
+
+// Maximum number of free blocks retained per thread and size class.  Blocks
+// freed by a thread that does not allocate, such as an executor thread that
+// completes operations started elsewhere, are retained up to this limit and
+// then returned to the global allocator.
+constexpr uint32_t kMaxFreeBlocksPerSizeClass = 64;
+
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+// Trivially destructible, such that it remains accessible while other
+// thread-local objects are destroyed.
+struct ThreadBlockCache {
+  FreeBlock* free_list[kNumSizeClasses];
+  uint32_t num_free[kNumSizeClasses];
+  bool registered;
+  bool destroyed;
+};
+
+ABSL_CONST_INIT thread_local ThreadBlockCache thread_block_cache = {};
+
+void ReleaseThreadBlockCache() {
+  auto& cache = thread_block_cache;
+  for (size_t i = 0; i < kNumSizeClasses; ++i) {
+    while (FreeBlock* block = cache.free_list[i]) {
+      cache.free_list[i] = block->next;
+      ::operator delete(block, (i + 1) * kPoolGranularity);
+    }
+    cache.num_free[i] = 0;
+  }
+}
+
+// Releases the cached blocks when the thread exits.
+struct ThreadBlockCacheReleaser {
+  ~ThreadBlockCacheReleaser() {
+    ReleaseThreadBlockCache();
+    thread_block_cache.destroyed = true;
+  }
+};
+
 }  // namespace
 
+void* AllocatePooled(size_t size) {
+  if constexpr (kPoolingEnabled) {
+    const size_t size_class = (size - 1) / kPoolGranularity;
+    if (size_class < kNumSizeClasses) {
+      auto& cache = thread_block_cache;
+      if (FreeBlock* block = cache.free_list[size_class]) {
+        cache.free_list[size_class] = block->next;
+        --cache.num_free[size_class];
+        return block;
+      }
+      return ::operator new((size_class + 1) * kPoolGranularity);
+    }
+  }
+  return ::operator new(size);
+}
+
+void FreePooled(void* ptr, size_t size) noexcept {
+  if constexpr (kPoolingEnabled) {
+    const size_t size_class = (size - 1) / kPoolGranularity;
+    if (size_class < kNumSizeClasses) {
+      auto& cache = thread_block_cache;
+      if (cache.num_free[size_class] < kMaxFreeBlocksPerSizeClass &&
+          !cache.destroyed) {
+        if (ABSL_PREDICT_FALSE(!cache.registered)) {
+          cache.registered = true;
+          static thread_local ThreadBlockCacheReleaser releaser;
+        }
+        auto* block = static_cast<FreeBlock*>(ptr);
+        block->next = cache.free_list[size_class];
+        cache.free_list[size_class] = block;
+        ++cache.num_free[size_class];
+        return;
+      }
+      ::operator delete(ptr, (size_class + 1) * kPoolGranularity);
+      return;
+    }
+  }
+  ::operator delete(ptr, size);
+}
+
 /// Special value to which CallbackListNode::next points to indicate that
 /// unregistration was requested.
 static CallbackListNode unregister_requested;
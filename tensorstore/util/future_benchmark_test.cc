@@ -0,0 +1,107 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Benchmarks the overhead of creating, linking and resolving futures, which is
+// dominated by allocation of the shared states and callbacks.
+//
+// The `Threads` variants run the same benchmark concurrently in several
+// threads, which measures contention in the allocator.
+
+#include <stdint.h>
+
+#include <string>
+#include <utility>
+
+#include <benchmark/benchmark.h>
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+
+namespace {
+
+using ::tensorstore::Future;
+using ::tensorstore::InlineExecutor;
+using ::tensorstore::MakeReadyFuture;
+using ::tensorstore::MapFuture;
+using ::tensorstore::Promise;
+using ::tensorstore::PromiseFuturePair;
+using ::tensorstore::ReadyFuture;
+using ::tensorstore::Result;
+
+template <typename T>
+void BM_PromiseFuturePair(benchmark::State& state) {
+  for (auto _ : state) {
+    auto pair = PromiseFuturePair<T>::Make();
+    pair.promise.SetResult(T{});
+    benchmark::DoNotOptimize(pair.future.result());
+  }
+}
+BENCHMARK_TEMPLATE(BM_PromiseFuturePair, int);
+BENCHMARK_TEMPLATE(BM_PromiseFuturePair, int)->Threads(4);
+BENCHMARK_TEMPLATE(BM_PromiseFuturePair, std::string);
+
+void BM_ExecuteWhenReady(benchmark::State& state) {
+  for (auto _ : state) {
+    auto pair = PromiseFuturePair<int>::Make();
+    pair.future.ExecuteWhenReady(
+        [](ReadyFuture<int> f) { benchmark::DoNotOptimize(f.value()); });
+    pair.promise.SetResult(1);
+  }
+}
+BENCHMARK(BM_ExecuteWhenReady);
+BENCHMARK(BM_ExecuteWhenReady)->Threads(4);
+
+void BM_MapFuture(benchmark::State& state) {
+  for (auto _ : state) {
+    auto pair = PromiseFuturePair<int>::Make();
+    auto mapped = MapFuture(
+        InlineExecutor{},
+        [](const Result<int>& x) -> Result<int64_t> { return *x + 1; },
+        pair.future);
+    pair.promise.SetResult(1);
+    benchmark::DoNotOptimize(mapped.result());
+  }
+}
+BENCHMARK(BM_MapFuture);
+
+// Links a chain of `state.range(0)` futures, as for a sequence of dependent
+// asynchronous operations.
+void BM_LinkChain(benchmark::State& state) {
+  const int64_t length = state.range(0);
+  for (auto _ : state) {
+    auto pair = PromiseFuturePair<int>::Make();
+    Future<int> future = pair.future;
+    for (int64_t i = 0; i < length; ++i) {
+      future = PromiseFuturePair<int>::LinkValue(
+                   [](Promise<int> promise, ReadyFuture<int> f) {
+                     promise.SetResult(f.value() + 1);
+                   },
+                   std::move(future))
+                   .future;
+    }
+    pair.promise.SetResult(0);
+    benchmark::DoNotOptimize(future.result());
+  }
+  state.SetItemsProcessed(state.iterations() * length);
+}
+BENCHMARK(BM_LinkChain)->Arg(1)->Arg(16);
+
+void BM_MakeReadyFuture(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(MakeReadyFuture<int>(1));
+  }
+}
+BENCHMARK(BM_MakeReadyFuture);
+
+}  // namespace
@@ -0,0 +1,160 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TENSORSTORE_UTIL_FUTURE_COROUTINE_H_
+#define TENSORSTORE_UTIL_FUTURE_COROUTINE_H_
+
+/// \file
+///
+/// C++20 coroutine support for `Future`.
+///
+/// A function that returns `Future<T>` may be written as a coroutine, which
+/// awaits other futures with `co_await` and returns its result with
+/// `co_return`.  This expresses a sequence of dependent asynchronous
+/// operations as a single coroutine frame, rather than a chain of `Link` and
+/// `MapFutureValue` callbacks that each allocate a future state::
+///
+///     Future<int> ReadSize(KvStore store, std::string key) {
+///       Result<kvstore::ReadResult> r = co_await kvstore::Read(store, key);
+///       if (!r.ok()) co_return r.status();
+///       co_return r->value.size();
+///     }
+///
+/// The coroutine starts running immediately when called, and runs until its
+/// first `co_await` of a future that is not ready.  `co_await future` evaluates
+/// to the `Result<T>` of the future, and resumes the coroutine in the thread
+/// that makes the future ready; `co_await ResumeOn(executor, future)` instead
+/// resumes the coroutine using `executor`.  Awaited futures are forced.
+///
+/// A coroutine returning `Future<void>` must specify its result explicitly,
+/// e.g. `co_return absl::OkStatus();`.
+///
+/// Coroutine support is only available when compiling as C++20 or later, as
+/// indicated by `TENSORSTORE_HAVE_FUTURE_COROUTINES`.
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L && \
+    __has_include(<coroutine>)
+#define TENSORSTORE_HAVE_FUTURE_COROUTINES 1
+#endif
+
+#ifdef TENSORSTORE_HAVE_FUTURE_COROUTINES
+
+#include <stddef.h>
+
+#include <coroutine>
+#include <exception>
+#include <type_traits>
+#include <utility>
+
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+
+namespace tensorstore {
+namespace internal_future {
+
+/// Coroutine promise type of a coroutine that returns `Future<T>`.
+template <typename T>
+class FutureCoroutinePromise {
+ public:
+  using ValueType = std::remove_const_t<T>;
+
+  FutureCoroutinePromise() {
+    auto pair = PromiseFuturePair<ValueType>::Make();
+    promise_ = std::move(pair.promise);
+    future_ = std::move(pair.future);
+  }
+
+  Future<T> get_return_object() { return std::move(future_); }
+
+  std::suspend_never initial_suspend() noexcept { return {}; }
+
+  // The frame is destroyed as soon as the coroutine completes.
+  std::suspend_never final_suspend() noexcept { return {}; }
+
+  void return_value(Result<ValueType> result) {
+    promise_.SetResult(std::move(result));
+  }
+
+  void unhandled_exception() noexcept { std::terminate(); }
+
+  // Coroutine frames are allocated like future states.
+  static void* operator new(size_t size) { return AllocatePooled(size); }
+  static void operator delete(void* ptr, size_t size) noexcept {
+    FreePooled(ptr, size);
+  }
+
+ private:
+  Promise<ValueType> promise_;
+  Future<ValueType> future_;
+};
+
+/// Awaitable returned by `operator co_await(Future<T>)` and `ResumeOn`.
+template <typename T>
+class FutureAwaiter {
+ public:
+  explicit FutureAwaiter(Future<T> future, Executor executor = {})
+      : future_(std::move(future)), executor_(std::move(executor)) {}
+
+  bool await_ready() const noexcept { return future_.ready(); }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    future_.Force();
+    future_.ExecuteWhenReady(
+        [handle, executor = std::move(executor_)](ReadyFuture<T>) mutable {
+          if (executor) {
+            executor([handle] { handle.resume(); });
+          } else {
+            handle.resume();
+          }
+        });
+  }
+
+  Result<std::remove_const_t<T>> await_resume() { return future_.result(); }
+
+ private:
+  Future<T> future_;
+  Executor executor_;
+};
+
+}  // namespace internal_future
+
+/// Awaits `future` in a coroutine, and then resumes the coroutine using
+/// `executor`.
+///
+/// If `future` is already ready, the coroutine continues without suspending.
+template <typename T>
+internal_future::FutureAwaiter<T> ResumeOn(Executor executor,
+                                           Future<T> future) {
+  return internal_future::FutureAwaiter<T>(std::move(future),
+                                           std::move(executor));
+}
+
+/// Awaits `future` in a coroutine, evaluating to its `Result<T>`.
+template <typename T>
+internal_future::FutureAwaiter<T> operator co_await(Future<T> future) {
+  return internal_future::FutureAwaiter<T>(std::move(future));
+}
+
+}  // namespace tensorstore
+
+template <typename T, typename... Args>
+struct std::coroutine_traits<::tensorstore::Future<T>, Args...> {
+  using promise_type =
+      ::tensorstore::internal_future::FutureCoroutinePromise<T>;
+};
+
+#endif  // TENSORSTORE_HAVE_FUTURE_COROUTINES
+
+#endif  // TENSORSTORE_UTIL_FUTURE_COROUTINE_H_
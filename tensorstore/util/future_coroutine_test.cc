@@ -0,0 +1,134 @@
+// Copyright 2025 The TensorStore Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tensorstore/util/future_coroutine.h"
+
+#ifdef TENSORSTORE_HAVE_FUTURE_COROUTINES
+
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "tensorstore/util/executor.h"
+#include "tensorstore/util/future.h"
+#include "tensorstore/util/result.h"
+#include "tensorstore/util/status_testutil.h"
+
+namespace {
+
+using ::tensorstore::Executor;
+using ::tensorstore::ExecutorTask;
+using ::tensorstore::Future;
+using ::tensorstore::MakeReadyFuture;
+using ::tensorstore::PromiseFuturePair;
+using ::tensorstore::Result;
+using ::tensorstore::ResumeOn;
+using ::tensorstore::StatusIs;
+using ::testing::Optional;
+
+Future<int> AddOne(Future<int> future) {
+  Result<int> x = co_await future;
+  if (!x.ok()) co_return x.status();
+  co_return *x + 1;
+}
+
+Future<int> Sum(std::vector<Future<int>> futures) {
+  int sum = 0;
+  for (auto& future : futures) {
+    Result<int> x = co_await AddOne(future);
+    if (!x.ok()) co_return x.status();
+    sum += *x;
+  }
+  co_return sum;
+}
+
+Future<void> Check(Future<int> future) {
+  Result<int> x = co_await future;
+  if (!x.ok() || *x < 0) co_return absl::InvalidArgumentError("negative");
+  co_return absl::OkStatus();
+}
+
+TEST(FutureCoroutineTest, Ready) {
+  auto future = AddOne(MakeReadyFuture<int>(1));
+  ASSERT_TRUE(future.ready());
+  EXPECT_THAT(future.result(), Optional(2));
+}
+
+TEST(FutureCoroutineTest, NotReady) {
+  auto pair = PromiseFuturePair<int>::Make();
+  auto future = AddOne(pair.future);
+  EXPECT_FALSE(future.ready());
+  pair.promise.SetResult(5);
+  ASSERT_TRUE(future.ready());
+  EXPECT_THAT(future.result(), Optional(6));
+}
+
+TEST(FutureCoroutineTest, Error) {
+  auto pair = PromiseFuturePair<int>::Make();
+  auto future = AddOne(pair.future);
+  pair.promise.SetResult(absl::UnknownError("failed"));
+  EXPECT_THAT(future.result(), StatusIs(absl::StatusCode::kUnknown));
+}
+
+TEST(FutureCoroutineTest, Sequence) {
+  std::vector<PromiseFuturePair<int>> pairs(3);
+  std::vector<Future<int>> futures;
+  for (auto& pair : pairs) {
+    pair = PromiseFuturePair<int>::Make();
+    futures.push_back(pair.future);
+  }
+  auto future = Sum(futures);
+  for (int i = 2; i >= 0; --i) {
+    EXPECT_FALSE(future.ready());
+    pairs[i].promise.SetResult(i);
+  }
+  EXPECT_THAT(future.result(), Optional(6));
+}
+
+TEST(FutureCoroutineTest, Void) {
+  TENSORSTORE_EXPECT_OK(Check(MakeReadyFuture<int>(1)).result());
+  EXPECT_THAT(Check(MakeReadyFuture<int>(-1)).result(),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+TEST(FutureCoroutineTest, ResumeOn) {
+  std::vector<ExecutorTask> tasks;
+  Executor executor = [&](auto task) { tasks.push_back(std::move(task)); };
+  auto pair = PromiseFuturePair<int>::Make();
+  auto future = [](Executor executor, Future<int> future) -> Future<int> {
+    Result<int> x = co_await ResumeOn(executor, future);
+    co_return *x * 2;
+  }(executor, pair.future);
+  pair.promise.SetResult(3);
+  EXPECT_FALSE(future.ready());
+  ASSERT_EQ(1, tasks.size());
+  std::move(tasks[0])();
+  EXPECT_THAT(future.result(), Optional(6));
+}
+
+TEST(FutureCoroutineTest, Forces) {
+  bool forced = false;
+  auto pair = PromiseFuturePair<int>::Make();
+  pair.promise.ExecuteWhenForced([&](auto promise) { forced = true; });
+  auto future = AddOne(pair.future);
+  EXPECT_TRUE(forced);
+  pair.promise.SetResult(1);
+  EXPECT_THAT(future.result(), Optional(2));
+}
+
+}  // namespace
+
+#endif  // TENSORSTORE_HAVE_FUTURE_COROUTINES
@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <new>
 #include <thread>  // NOLINT
 #include <type_traits>
 #include <utility>
@@ -137,6 +138,38 @@ using ReadyFutureType =
 /// CallbackBase may outlast the FutureStateBase.
 absl::Mutex* GetMutex(FutureStateBase* ptr);
 
+/// Allocates `size` bytes from a per-thread cache of freed blocks of the same
+/// size class, or from the global allocator if the cache is empty or `size` is
+/// too large to be cached.
+void* AllocatePooled(size_t size);
+
+/// Frees a block returned by `AllocatePooled(size)`, retaining it in the cache
+/// of the current thread if the cache is not full.
+void FreePooled(void* ptr, size_t size) noexcept;
+
+/// Base class of `FutureStateBase` and `CallbackBase` that allocates them, and
+/// hence all future states, callbacks and links, using `AllocatePooled`.
+///
+/// The shared state and callbacks of a future are typically allocated and freed
+/// in quick succession, for every asynchronous operation, such that the global
+/// allocator is otherwise a significant cost.
+class PooledAllocation {
+ public:
+  static void* operator new(size_t size) { return AllocatePooled(size); }
+  static void operator delete(void* ptr, size_t size) noexcept {
+    FreePooled(ptr, size);
+  }
+
+  // Over-aligned types are not pooled.
+  static void* operator new(size_t size, std::align_val_t alignment) {
+    return ::operator new(size, alignment);
+  }
+  static void operator delete(void* ptr, size_t size,
+                              std::align_val_t alignment) noexcept {
+    ::operator delete(ptr, size, alignment);
+  }
+};
+
 /// Base class representing an element of a doubly-linked list of callbacks.
 ///
 /// In addition to representing an element of a callback list, this type is also
@@ -176,7 +209,7 @@ struct CallbackListNode {
 ///
 /// \remarks Instances of this class must not be constructed directly.  Instead,
 ///     an instance of the `FutureState` class template should be constructed.
-class FutureStateBase {
+class FutureStateBase : public PooledAllocation {
  public:
   FutureStateBase();
   virtual ~FutureStateBase();
@@ -505,7 +538,7 @@ using ResultType = internal::CopyQualifiers<T, Result<std::remove_const_t<T>>>;
 /// Base class representing a registered callback in the
 /// FutureStateBase::ready_callbacks_ or FutureStateBase::promise_callbacks_
 /// list.
-class CallbackBase : public CallbackListNode {
+class CallbackBase : public CallbackListNode, public PooledAllocation {
  public:
   /// Stores a pointer to the FutureStateBase along with tag bits that specify
   /// the type of callback.
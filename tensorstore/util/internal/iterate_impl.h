@@ -22,6 +22,7 @@
 #include <stddef.h>
 
 #include <array>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -265,10 +266,27 @@ class IterateHelper {
         if (!result) break;
         increment_pointers();
       }
+    } else if (layouts.size() == 2) {
+      // Iterate over the last 2 dimensions with a directly nested loop rather
+      // than recursing for each position.  When `func` itself handles the
+      // innermost 2 dimensions, this avoids recursion entirely for the common
+      // case of a total rank of at most 4.
+      const DimensionSizeAndStrides<arity> inner_size_and_strides = layouts[1];
+      for (Index i = 0; i < size_and_strides.size; ++i) {
+        std::tuple<Pointer...> inner_pointers(pointers...);
+        for (Index j = 0; j < inner_size_and_strides.size; ++j) {
+          result = func(std::get<Is>(inner_pointers)...);
+          if (!result) return result;
+          ((std::get<Is>(inner_pointers) +=
+            inner_size_and_strides.strides[Is]),
+           ...);
+        }
+        increment_pointers();
+      }
     } else {
       for (Index i = 0; i < size_and_strides.size; ++i) {
-        auto result = LoopImpl(func, {&layouts[1], layouts.size() - 1},
-                               index_sequence, pointers...);
+        result = LoopImpl(func, {&layouts[1], layouts.size() - 1},
+                          index_sequence, pointers...);
         if (!result) break;
         increment_pointers();
       }
@@ -524,6 +524,49 @@ TEST(IterateOverStridedLayoutsTest, InnerRank0NonContiguousFortranStop) {
   EXPECT_EQ(expected_result, result);
 }
 
+TEST(IterateOverStridedLayoutsTest, Rank3NonContiguous) {
+  const Index shape[] = {2, 3, 2};
+  const Index strides0[] = {1, 6, 2};
+
+  std::vector<int> result;
+  auto func = [&](int a) {
+    result.emplace_back(a);
+    return true;
+  };
+  EXPECT_EQ(true, IterateOverStridedLayouts(shape, {{strides0}}, func,
+                                            ContiguousLayoutOrder::c, 0));
+  EXPECT_THAT(result,
+              ::testing::ElementsAre(0, 2, 6, 8, 12, 14, 1, 3, 7, 9, 13, 15));
+}
+
+TEST(IterateOverStridedLayoutsTest, Rank3NonContiguousStop) {
+  const Index shape[] = {2, 3, 2};
+  const Index strides0[] = {1, 6, 2};
+
+  std::vector<int> result;
+  auto func = [&](int a) {
+    result.emplace_back(a);
+    return a != 6;
+  };
+  EXPECT_EQ(false, IterateOverStridedLayouts(shape, {{strides0}}, func,
+                                             ContiguousLayoutOrder::c, 0));
+  EXPECT_THAT(result, ::testing::ElementsAre(0, 2, 6));
+}
+
+TEST(IterateOverStridedLayoutsTest, Rank4NonContiguousStop) {
+  const Index shape[] = {2, 2, 2, 2};
+  const Index strides0[] = {1, 8, 2, 16};
+
+  std::vector<int> result;
+  auto func = [&](int a) {
+    result.emplace_back(a);
+    return a != 2;
+  };
+  EXPECT_EQ(false, IterateOverStridedLayouts(shape, {{strides0}}, func,
+                                             ContiguousLayoutOrder::c, 0));
+  EXPECT_THAT(result, ::testing::ElementsAre(0, 16, 2));
+}
+
 template <ContiguousLayoutOrder Order>
 std::vector<std::vector<int>> GetIndexVectors(std::vector<int> shape) {
   std::vector<std::vector<int>> result;
@@ -153,6 +153,15 @@
 /// maximum number of concurrent `read_function` calls, and avoid the potential
 /// for deadlock.
 ///
+/// If the `read_function` starts expensive asynchronous work, such as a request
+/// to a remote service, the number of calls in progress at once (until the
+/// returned future becomes ready) may be limited independently of the thread
+/// pool by specifying the `ConcurrencyLimit` option.
+///
+/// Concurrent reads of the same chunk are coalesced: while a call to the
+/// `read_function` for a chunk is in progress, other reads of that chunk wait
+/// for its result rather than invoking the `read_function` again.
+///
 /// Serialization
 /// -------------
 ///
@@ -243,6 +252,8 @@
 /// no different than binding the transaction to an existing virtual chunked
 /// view.
 
+#include <stddef.h>
+
 #include <functional>
 #include <type_traits>
 
@@ -331,6 +342,19 @@ constexpr inline bool IsWriteFunction =
         Future<TimestampedStorageGeneration>, Func,
         Array<const Element, Rank, offset_origin>, WriteParameters>;
 
+/// Specifies the maximum number of calls to the `read_function` and
+/// `write_function` of a `virtual_chunked` TensorStore that may be in progress
+/// at once.
+///
+/// A call is in progress from when it is invoked until the future it returns
+/// becomes ready; additional calls are queued.  The limit is shared by all
+/// copies of the returned TensorStore, and is independent of the
+/// `data_copy_concurrency` resource.  A value of `0` indicates no limit.
+struct ConcurrencyLimit {
+  constexpr explicit ConcurrencyLimit(size_t value = 0) : value(value) {}
+  size_t value;
+};
+
 /// Options to the `tensorstore::VirtualChunked` function for creating an
 /// `virtual_chunked` TensorStore.
 ///
@@ -364,10 +388,14 @@ constexpr inline bool IsWriteFunction =
 /// - `RecheckCachedData`: May be specified in conjunction with a `Context` with
 ///   non-zero `total_bytes_limit` specified for the `cache_pool` to avoid
 ///   re-invoking the `read_function` to validate cached data.
+///
+/// - `ConcurrencyLimit`: Limits the number of calls to the `read_function` and
+///   `write_function` that may be in progress at once.
 struct OpenOptions : public Schema {
   Context context;
   Transaction transaction{no_transaction};
   RecheckCachedData recheck_cached_data;
+  ConcurrencyLimit concurrency_limit;
 
   template <typename T>
   static inline constexpr bool IsOption = Schema::IsOption<T>;
@@ -390,6 +418,11 @@ struct OpenOptions : public Schema {
     }
     return absl::OkStatus();
   }
+
+  absl::Status Set(ConcurrencyLimit value) {
+    concurrency_limit = value;
+    return absl::OkStatus();
+  }
 };
 
 template <>
@@ -401,6 +434,9 @@ constexpr inline bool OpenOptions::IsOption<Transaction> = true;
 template <>
 constexpr inline bool OpenOptions::IsOption<RecheckCachedData> = true;
 
+template <>
+constexpr inline bool OpenOptions::IsOption<ConcurrencyLimit> = true;
+
 namespace internal_virtual_chunked {
 Result<internal::Driver::Handle> MakeDriver(
     virtual_chunked::ReadFunction read_function,
@@ -47,7 +47,6 @@ def repo():
             "exclude": [
                 "riegeli/brotli/**",
                 "riegeli/chunk_encoding/**",
-                "riegeli/lz4/**",
                 "riegeli/records/**",
                 "riegeli/snappy/**",
                 "riegeli/tensorflow/**",